@@ -47,8 +47,11 @@
 /* Section where include file can be added */
 #define INCLUDE_xQueueGetMutexHolder            1
 #define INCLUDE_uxTaskGetStackHighWaterMark     1
+#define INCLUDE_xTaskGetIdleTaskHandle          1
 #define configCHECK_FOR_STACK_OVERFLOW          2
 #define configUSE_MALLOC_FAILED_HOOK            1
+#define configUSE_TRACE_FACILITY                 1
+#define configGENERATE_RUN_TIME_STATS            1
 /* USER CODE END Includes */
 
 /* Ensure definitions are only used by the compiler, and not by the assembler. */
@@ -68,7 +71,7 @@
 #define configTICK_RATE_HZ                       ((TickType_t)1000)
 #define configMAX_PRIORITIES                     ( 7 )
 #define configMINIMAL_STACK_SIZE                 ((uint16_t)128)
-#define configTOTAL_HEAP_SIZE                    ((size_t)15360)
+#define configTOTAL_HEAP_SIZE                    ((size_t)4096)
 #define configMAX_TASK_NAME_LEN                  ( 16 )
 #define configUSE_16_BIT_TICKS                   0
 #define configUSE_MUTEXES                        1
@@ -91,7 +94,7 @@ to exclude the API function. */
 #define INCLUDE_vTaskDelete                  1
 #define INCLUDE_vTaskCleanUpResources        0
 #define INCLUDE_vTaskSuspend                 1
-#define INCLUDE_vTaskDelayUntil              0
+#define INCLUDE_vTaskDelayUntil              1
 #define INCLUDE_vTaskDelay                   1
 #define INCLUDE_xTaskGetSchedulerState       1
 
@@ -134,10 +137,63 @@ standard names. */
 /* IMPORTANT: This define is commented when used with STM32Cube firmware, when the timebase source is SysTick,
               to prevent overwriting SysTick_Handler defined within STM32Cube HAL */
 
-#define xPortSysTickHandler SysTick_Handler
+/* The RTOS tick is driven from the TIM6 HAL timebase interrupt (see sys_clock.c), SysTick is unused. */
+/* #define xPortSysTickHandler SysTick_Handler */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Run-time stats clock: DWT cycle counter (SystemCoreClock, wraps every ~25 s at 168 MHz),
+   the monitor samples well inside one wrap period so 32-bit deltas stay valid. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+#endif
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS configureTimerForRunTimeStats
+#define portGET_RUN_TIME_COUNTER_VALUE         getRunTimeCounterValue
+/* Single timebase: TIM6 generates both the HAL tick and the RTOS tick, vPortSetupTimerInterrupt()
+   is provided by sys_clock.c and aligns xTaskGetTickCount() with HAL_GetTick() at scheduler start. */
+#define configOVERRIDE_DEFAULT_TICK_CONFIGURATION 1
+/* Tickless idle (custom): the idle task stops the TIM6 timebase interrupt (HAL + RTOS tick),
+   sleeps in WFI timed by TIM7 and steps the tick counts on wakeup (see power_manager.c). */
+#define configUSE_TICKLESS_IDLE                2
+#define configEXPECTED_IDLE_TIME_BEFORE_SLEEP  3
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void Power_SuppressTicksAndSleep(uint32_t expected_idle_ticks);
+#endif
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) Power_SuppressTicksAndSleep( xExpectedIdleTime )
+/* Mutex hold-time check (see task_plan.h): these hooks expand inside queue.c only, where
+   uxQueueType/u.xSemaphore are visible; non-mutex queues and semaphores are filtered out. */
+/* The same hooks also feed the event trace recorder (see rtos_trace.h), which additionally
+   records task switches, ready transitions and ordinary queue/semaphore traffic. */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+void TaskPlan_TraceMutexTake(void *mutex);
+void TaskPlan_TraceMutexGive(void *mutex);
+void TaskPlan_TraceMutexBlock(void *mutex, void *holder);
+void TaskPlan_TraceMutexTimeout(void *mutex);
+void RtosTrace_TaskSwitchedIn(void *tcb);
+void RtosTrace_TaskReady(void *tcb);
+void RtosTrace_QueueSend(void *queue, int is_mutex);
+void RtosTrace_QueueReceive(void *queue, int is_mutex);
+void RtosTrace_QueueBlock(void *queue, int is_mutex, int sending, void *holder);
+#endif
+#define traceQUEUE_RECEIVE( pxQueue ) \
+  do { if( ( pxQueue )->uxQueueType == NULL ) { TaskPlan_TraceMutexTake( pxQueue ); } \
+    RtosTrace_QueueReceive( pxQueue, ( pxQueue )->uxQueueType == NULL ); } while( 0 )
+#define traceQUEUE_SEND( pxQueue ) \
+  do { if( ( pxQueue )->uxQueueType == NULL ) { TaskPlan_TraceMutexGive( pxQueue ); } \
+    RtosTrace_QueueSend( pxQueue, ( pxQueue )->uxQueueType == NULL ); } while( 0 )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue ) \
+  do { if( ( pxQueue )->uxQueueType == NULL ) { \
+    TaskPlan_TraceMutexBlock( pxQueue, ( pxQueue )->u.xSemaphore.xMutexHolder ); \
+    RtosTrace_QueueBlock( pxQueue, 1, 0, ( pxQueue )->u.xSemaphore.xMutexHolder ); } \
+    else { RtosTrace_QueueBlock( pxQueue, 0, 0, NULL ); } } while( 0 )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue ) \
+  do { if( ( pxQueue )->uxQueueType == NULL ) { TaskPlan_TraceMutexTimeout( pxQueue ); } } while( 0 )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue ) RtosTrace_QueueBlock( pxQueue, 0, 1, NULL )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue ) RtosTrace_QueueSend( pxQueue, 0 )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue ) RtosTrace_QueueReceive( pxQueue, 0 )
+#define traceTASK_SWITCHED_IN() RtosTrace_TaskSwitchedIn( pxCurrentTCB )
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB ) RtosTrace_TaskReady( pxTCB )
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -38,6 +38,35 @@
 #include "devices_manager.h"
 
 #include "adc.h"
+#include "adc_manager.h"
+#include "usart.h"
+#include "shell.h"
+#include "config_store.h"
+#include "sensor_log.h"
+#include "log_flash.h"
+#include "telemetry.h"
+#include "modbus_gateway.h"
+#include "modbus_slave.h"
+#include "ota_update.h"
+#include "rtc_clock.h"
+#include "sys_monitor.h"
+#include "energy_meter.h"
+#include "profiler.h"
+#include "frame_stats.h"
+#include "mem_section.h"
+#include "power_manager.h"
+#include "boot_graph.h"
+#include "boot_console.h"
+#include "crash_dump.h"
+#include "norflash.h"
+#include "task_wdt.h"
+#include "task_plan.h"
+#include "sensor_probe.h"
+#include "test.h"
+#include "usb_cdc.h"
+#include "sd_archive.h"
+#include "can_net.h"
+#include "touch_bus.h"
 
 // others
 #define LOG_MODULE "FREERTOS"
@@ -47,7 +76,7 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
-uint16_t adc_dma_buffer[2] = {0};
+
 /* USER CODE END PTD */
 
 /* Private define ------------------------------------------------------------*/
@@ -62,13 +91,30 @@ uint16_t adc_dma_buffer[2] = {0};
 
 /* Private variables ---------------------------------------------------------*/
 /* USER CODE BEGIN Variables */
-osSemaphoreId sysInitSemaphoreHandle;
+// 系统任务全部静态分配，heap_4 只留给运行时动态创建的对象
+#define SYS_INIT_TASK_STACK_SIZE 512
+#define SYS_MONITOR_TASK_STACK_SIZE 384 // 含配置存储写入 (约 300 字节缓冲区)
+uint32_t sysInitTaskBuffer[SYS_INIT_TASK_STACK_SIZE];
+osStaticThreadDef_t sysInitTaskControlBlock;
+// 第二个启动工作任务：RTC 冷启动等待 LSE 起振时其余阶段不被阻塞
+// (启动阶段的栈上没有 DMA 缓冲区，放在 CCM)
+static CCM_RAM uint32_t sysInitHelperBuffer[SYS_INIT_TASK_STACK_SIZE];
+osStaticThreadDef_t sysInitHelperControlBlock;
+uint32_t sysMonitorTaskBuffer[SYS_MONITOR_TASK_STACK_SIZE];
+osStaticThreadDef_t sysMonitorTaskControlBlock;
+osThreadId sysMonitorTaskHandle;
+
+// 掉电预警：VDD 低于 PVD 阈值 (2.9V) 时唤醒监控任务写入未保存的设置
+#define SYS_POWER_FAIL_SIGNAL 0x01
 /* USER CODE END Variables */
 osThreadId defaultTaskHandle;
+uint32_t defaultTaskBuffer[ 1024 ];
+osStaticThreadDef_t defaultTaskControlBlock;
 
 /* Private function prototypes -----------------------------------------------*/
 /* USER CODE BEGIN FunctionPrototypes */
 void SystemAppInitTask(void const* argument);
+static void SystemBootGraph_Init(void);
 void SystemMonitorTask(void const* argument);
 void VerificationTask_Entry(void const * argument);
 /* USER CODE END FunctionPrototypes */
@@ -77,12 +123,32 @@ void StartDefaultTask(void const * argument);
 
 void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
 
+/* Hook prototypes */
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+
+/* USER CODE BEGIN 1 */
+/* Functions needed when configGENERATE_RUN_TIME_STATS is on */
+// 运行时统计时钟：DWT 周期计数器，由 vTaskStartScheduler 调用一次
+void configureTimerForRunTimeStats(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+unsigned long getRunTimeCounterValue(void)
+{
+  return DWT->CYCCNT;
+}
+/* USER CODE END 1 */
+
 /* GetIdleTaskMemory prototype (linked to static allocation support) */
 void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize );
 
 /* USER CODE BEGIN GET_IDLE_TASK_MEMORY */
 static StaticTask_t xIdleTaskTCBBuffer;
-static StackType_t xIdleStack[configMINIMAL_STACK_SIZE];
+static CCM_RAM StackType_t xIdleStack[configMINIMAL_STACK_SIZE];
 
 void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize )
 {
@@ -100,6 +166,11 @@ void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackTy
   */
 void MX_FREERTOS_Init(void) {
   /* USER CODE BEGIN Init */
+  // 无节拍空闲的睡眠定时器 (调度器启动后空闲任务即可睡眠)
+  Power_Init();
+
+  // 启动阶段表，由 LVGL 任务与启动工作任务按依赖并发执行
+  SystemBootGraph_Init();
 
   /* USER CODE END Init */
 
@@ -109,11 +180,6 @@ void MX_FREERTOS_Init(void) {
 
   /* USER CODE BEGIN RTOS_SEMAPHORES */
   /* add semaphores, ... */
-  osSemaphoreDef(sysInitSem); // 定义信号量
-  sysInitSemaphoreHandle = osSemaphoreCreate(osSemaphore(sysInitSem), 1); // 创建二进制信号量
-  
-  // 创建后立即等待一次，使其初始状态为“不可用”或“已被拿走”
-  osSemaphoreWait(sysInitSemaphoreHandle, 0); 
   /* USER CODE END RTOS_SEMAPHORES */
 
   /* USER CODE BEGIN RTOS_TIMERS */
@@ -126,15 +192,22 @@ void MX_FREERTOS_Init(void) {
 
   /* Create the thread(s) */
   /* definition and creation of defaultTask */
-  osThreadDef(defaultTask, StartDefaultTask, osPriorityNormal, 0, 1024);
+  osThreadStaticDef(defaultTask, StartDefaultTask, osPriorityBelowNormal, 0, 1024, defaultTaskBuffer, &defaultTaskControlBlock);
   defaultTaskHandle = osThreadCreate(osThread(defaultTask), NULL);
 
   /* USER CODE BEGIN RTOS_THREADS */
-  osThreadDef(SystemAppInitTask, SystemAppInitTask, osPriorityNormal, 0, 512);
+  // 优先级见 task_plan.h (defaultTask 即 LVGL 任务，TASK_PRIO_UI)
+  osThreadStaticDef(SystemAppInitTask, SystemAppInitTask, TASK_PLAN_OS_PRIO(TASK_PRIO_BOOT), 0,
+                    SYS_INIT_TASK_STACK_SIZE, sysInitTaskBuffer, &sysInitTaskControlBlock);
   osThreadCreate(osThread(SystemAppInitTask), NULL);
 
-  osThreadDef(SystemMonitorTask, SystemMonitorTask, osPriorityIdle, 0, 128);
-  osThreadCreate(osThread(SystemMonitorTask), NULL);
+  osThreadStaticDef(SystemAppInitHelper, SystemAppInitTask, TASK_PLAN_OS_PRIO(TASK_PRIO_BOOT), 0,
+                    SYS_INIT_TASK_STACK_SIZE, sysInitHelperBuffer, &sysInitHelperControlBlock);
+  osThreadCreate(osThread(SystemAppInitHelper), NULL);
+
+  osThreadStaticDef(SystemMonitorTask, SystemMonitorTask, TASK_PLAN_OS_PRIO(TASK_PRIO_MONITOR), 0,
+                    SYS_MONITOR_TASK_STACK_SIZE, sysMonitorTaskBuffer, &sysMonitorTaskControlBlock);
+  sysMonitorTaskHandle = osThreadCreate(osThread(SystemMonitorTask), NULL);
 
   /* USER CODE END RTOS_THREADS */
 
@@ -152,23 +225,24 @@ void StartDefaultTask(void const * argument)
   /* USER CODE BEGIN StartDefaultTask */
     /* Infinite loop */
 
-    // 开启日志
-    log_init();
-    log_set_level(LOG_LEVEL_INFO);  // 设置日志级别
-
-    lv_init();                // 初始化lvgl
-    lv_port_disp_init();      // 初始化显示驱动
-    lv_port_indev_init();     // 初始化输入设备驱动
-
-    ui_init();                // 初始化UI管理器
-
-    // [MODIFIED] 所有初始化已完成，释放信号量，通知其他任务可以继续
-    osSemaphoreRelease(sysInitSemaphoreHandle);
+    // 执行 LVGL 相关的启动阶段 (LCD 延时期间其余阶段在启动工作任务中继续)
+    BootGraph_RunWorker(BOOT_WORKER_UI);
+    TaskWdt_Register(TASK_WDT_DEADLINE_UI_MS);
 
     for(;;)
     {
-        lv_task_handler();
-        osDelay(4);
+        uint32_t loop_start = prof_now();
+        TaskWdt_CheckIn();
+        uint32_t wait_ms = lv_task_handler();
+        uint32_t idle_start = prof_now();
+        PROF_RECORD(PROF_ZONE_LV_HANDLER, loop_start);
+        // 命令行请求的 lcd/lvgl 基准在两次 lv_task_handler 之间执行
+        Bench_UiPoll();
+
+        // 休眠到下一个 LVGL 定时器到期，触摸中断或传感器快照会提前唤醒
+        ui_sleep(wait_ms);
+        // 帧统计: 处理耗时与休眠空闲耗时
+        FrameStats_LoopDone(idle_start - loop_start, prof_now() - idle_start);
     }
   /* USER CODE END StartDefaultTask */
 }
@@ -176,51 +250,286 @@ void StartDefaultTask(void const * argument)
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
 
-void SystemAppInitTask(void const* argument) {
-    // 等待信号量被释放
-    osSemaphoreWait(sysInitSemaphoreHandle, osWaitForever); 
+/* ---------------------------- 启动阶段 ---------------------------- */
+enum {
+    BOOT_LOG = 0,
+    BOOT_LVGL,
+    BOOT_CONFIG,
+    BOOT_RTC,
+    BOOT_ADC,
+    BOOT_FLASH,
+    BOOT_DEVICES,
+    BOOT_SENSORS,
+    BOOT_INDEV,
+    BOOT_UI,
+    BOOT_DATALOG,
+    BOOT_SHELL,
+    BOOT_TELEMETRY,
+    BOOT_MODBUS,
+    BOOT_OTA,
+    BOOT_USB,
+    BOOT_ARCHIVE,
+    BOOT_CAN,
+    BOOT_STAGE_COUNT
+};
+
+// 开启日志
+static bool boot_log(void) {
+    log_init();
+    log_set_level(LOG_LEVEL_INFO);  // 设置日志级别
+    LogFlash_Init();                // 告警与错误同时写入备份 SRAM (挂载 Flash 后持久化)
+    LOG_INFO("复位原因: %s", SysMonitor_ResetCauseName(SysMonitor_GetResetCause()));
+    TaskWdt_ReportLastReset();
+    CrashDump_Report();
+    return true;
+}
 
-    HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_dma_buffer, 2);
+// 初始化lvgl与显示驱动 (含 LCD 寄存器初始化序列)，随后在 LCD 上直接显示
+// 启动进度，直到 UI 创建第一个屏幕
+static bool boot_lvgl(void) {
+    lv_init();
+    lv_port_disp_init();
+    BootConsole_Init();
+    return true;
+}
 
-    // 初始化传感器系统
-    Sensor_System_Init();
+// 读取保存的配置 (传感器系统与设备管理器初始化时使用)，并尽早恢复串口波特率
+static bool boot_config(void) {
+    ConfigStore_Init();
+    Shell_RestoreBaudRate();
+    return true;
+}
+
+// 启动 RTC 墙上时钟与每秒事件 (顶部栏时钟)
+static bool boot_rtc(void) {
+    return RtcClock_Init();
+}
+
+// 启动ADC连续采样 (MQ-2 与电位器共用)
+static bool boot_adc(void) {
+    ADC_Manager_Init();
+    return true;
+}
 
-    // 初始化设备管理器
+// 识别 SPI Flash (图片资源、传感器记录与运行日志共用，先于三者完成)，挂载运行日志区
+static bool boot_flash(void) {
+    if (norflash_init() != 0) {
+        return false;
+    }
+    LogFlash_Mount();
+    return true;
+}
+
+// 初始化设备管理器 (传感器事件会驱动 LED 与电机，须先于传感器系统)
+static bool boot_devices(void) {
     Drivers_Manager_Init();
+    return true;
+}
+
+// 初始化传感器系统 (传感器探测与采样在传感器任务中进行)
+static bool boot_sensors(void) {
+    Sensor_System_Init();
+    return true;
+}
+
+// 初始化输入设备驱动 (触摸校准数据存放在 EEPROM)
+static bool boot_indev(void) {
+    lv_port_indev_init();
+    return true;
+}
+
+// 初始化UI管理器
+static bool boot_ui(void) {
+    BootConsole_Stop();
+    ui_init();
+    return true;
+}
+
+// 启动传感器数据记录 (外部 Flash 不存在时跳过；镜像与 LCD 帧缓冲共用外部 SRAM，排在 LVGL 初始化之后)
+static bool boot_datalog(void) {
+    SensorLog_Init();
+    return true;
+}
 
-    LOG_INFO("系统初始化任务完成，删除本任务");
+// 启动遥测上行 (未配置 Wi-Fi 时跳过；模块连接在上行任务中进行，离线缓存依赖数据记录)
+static bool boot_telemetry(void) {
+    Telemetry_Init();
+    return true;
+}
+
+// 启动 Modbus RTU 从站 (寄存器映像引用传感器与输出设备)；配置了节点时改为网关主站
+static bool boot_modbus(void) {
+    if (MODBUS_GATEWAY_NODE_COUNT > 0) {
+        ModbusGateway_Init();
+    } else {
+        ModbusSlave_Init();
+    }
+    return true;
+}
+
+// 读取在线升级状态 (试运行的新固件在启动完成后由监控任务确认)
+static bool boot_ota(void) {
+    return OtaUpdate_Init();
+}
+
+// 启动串口命令行 (依赖传感器系统与设备管理器)
+static bool boot_shell(void) {
+    Shell_Init(&huart1);
+    return true;
+}
+
+// 启动 USB 虚拟串口 (主机打开端口后日志、导出与命令行改走 USB)
+static bool boot_usb(void) {
+    return UsbCdc_Init(Shell_Input);
+}
+
+// 启动 SD 卡归档 (卡座与 Wi-Fi 的 UART5、硬件 I2C3 触摸共用引脚，二者启用时跳过)
+static bool boot_archive(void) {
+    if (TELEMETRY_WIFI_SSID[0] != '\0' || TOUCH_BUS_USE_HW_I2C) {
+        return true;
+    }
+    SdArchive_Init();
+    return true;
+}
+
+// 启动 CAN 传感器网络 (未配置节点号时跳过)
+static bool boot_can(void) {
+    if (CAN_NET_NODE_ID == 0) {
+        return true;
+    }
+    CanNet_Init();
+    return true;
+}
+
+// 启动阶段表：下标即阶段编号，所有阶段都在日志之后执行
+static const BootStage_t g_boot_stages[] = {
+    [BOOT_LOG]     = {"log",     boot_log,     0,                                    BOOT_WORKER_ANY},
+    [BOOT_LVGL]    = {"lvgl",    boot_lvgl,    BOOT_BIT(BOOT_LOG),                   BOOT_WORKER_UI},
+    [BOOT_CONFIG]  = {"config",  boot_config,  BOOT_BIT(BOOT_LOG),                   BOOT_WORKER_ANY},
+    [BOOT_RTC]     = {"rtc",     boot_rtc,     BOOT_BIT(BOOT_LOG),                   BOOT_WORKER_ANY},
+    [BOOT_ADC]     = {"adc",     boot_adc,     BOOT_BIT(BOOT_LOG),                   BOOT_WORKER_ANY},
+    [BOOT_FLASH]   = {"flash",   boot_flash,   BOOT_BIT(BOOT_LOG),                   BOOT_WORKER_ANY},
+    [BOOT_DEVICES] = {"devices", boot_devices, BOOT_BIT(BOOT_CONFIG),                BOOT_WORKER_ANY},
+    [BOOT_SENSORS] = {"sensors", boot_sensors, BOOT_BIT(BOOT_CONFIG) | BOOT_BIT(BOOT_ADC) |
+                                               BOOT_BIT(BOOT_DEVICES),               BOOT_WORKER_ANY},
+    [BOOT_INDEV]   = {"indev",   boot_indev,   BOOT_BIT(BOOT_LVGL) | BOOT_BIT(BOOT_CONFIG), BOOT_WORKER_UI},
+    [BOOT_UI]      = {"ui",      boot_ui,      BOOT_BIT(BOOT_INDEV) | BOOT_BIT(BOOT_FLASH) |
+                                               BOOT_BIT(BOOT_DEVICES),               BOOT_WORKER_UI},
+    [BOOT_DATALOG] = {"datalog", boot_datalog, BOOT_BIT(BOOT_FLASH) | BOOT_BIT(BOOT_RTC) |
+                                               BOOT_BIT(BOOT_SENSORS) | BOOT_BIT(BOOT_LVGL), BOOT_WORKER_ANY},
+    [BOOT_SHELL]   = {"shell",   boot_shell,   BOOT_BIT(BOOT_SENSORS) | BOOT_BIT(BOOT_DEVICES) |
+                                               BOOT_BIT(BOOT_DATALOG),               BOOT_WORKER_ANY},
+    [BOOT_TELEMETRY] = {"telemetry", boot_telemetry, BOOT_BIT(BOOT_SENSORS) | BOOT_BIT(BOOT_RTC) |
+                                                     BOOT_BIT(BOOT_DATALOG),         BOOT_WORKER_ANY},
+    [BOOT_MODBUS]  = {"modbus",  boot_modbus,  BOOT_BIT(BOOT_SENSORS) | BOOT_BIT(BOOT_DEVICES), BOOT_WORKER_ANY},
+    [BOOT_OTA]     = {"ota",     boot_ota,     BOOT_BIT(BOOT_FLASH),                 BOOT_WORKER_ANY},
+    [BOOT_USB]     = {"usb",     boot_usb,     BOOT_BIT(BOOT_SHELL),                 BOOT_WORKER_ANY},
+    [BOOT_ARCHIVE] = {"archive", boot_archive, BOOT_BIT(BOOT_RTC),                   BOOT_WORKER_ANY},
+    [BOOT_CAN]     = {"can",     boot_can,     BOOT_BIT(BOOT_SENSORS),               BOOT_WORKER_ANY},
+};
+
+static void SystemBootGraph_Init(void) {
+    BootGraph_Init(g_boot_stages, BOOT_STAGE_COUNT);
+}
+
+// 启动工作任务：执行通用启动阶段，全部领取完后删除本任务
+void SystemAppInitTask(void const* argument) {
+    BootGraph_RunWorker(BOOT_WORKER_ANY);
     osThreadTerminate(osThreadGetId());
 }
 
-// 监控任务的函数,LED0闪烁表示系统正在运行
+// 配置 PVD 掉电预警中断 (EXTI16，VDD 下降穿越阈值时触发)
+static void SystemPowerFail_Init(void)
+{
+    PWR_PVDTypeDef pvd = {
+        .PVDLevel = PWR_PVDLEVEL_7,   // 2.9V
+        .Mode = PWR_PVD_MODE_IT_RISING // PVDO 上升沿 = VDD 下降
+    };
+
+    __HAL_RCC_PWR_CLK_ENABLE();
+    HAL_PWR_ConfigPVD(&pvd);
+    HAL_PWR_EnablePVD();
+    // 优先级不高于 configMAX_SYSCALL_INTERRUPT_PRIORITY，回调中可发送信号
+    HAL_NVIC_SetPriority(PVD_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(PVD_IRQn);
+}
+
+// PVD 中断回调：只置标志并唤醒监控任务，EEPROM 写入在任务中完成
+void HAL_PWR_PVDCallback(void)
+{
+    Drivers_Settings_OnPowerFail();
+    if (sysMonitorTaskHandle != NULL) {
+        osSignalSet(sysMonitorTaskHandle, SYS_POWER_FAIL_SIGNAL);
+    }
+}
+
+// 掉电预警处理：临时提升到最高优先级，在电压跌落前写完设置
+static void SystemMonitor_OnPowerFail(void)
+{
+    osPriority prio = osThreadGetPriority(osThreadGetId());
+
+    osThreadSetPriority(osThreadGetId(), TASK_PLAN_OS_PRIO(TASK_PRIO_POWER_FAIL));
+    Drivers_Settings_Process();
+    SensorLog_Flush();
+    LogFlash_Flush();
+    osThreadSetPriority(osThreadGetId(), prio);
+    LOG_WARN("掉电预警，设置与传感器记录已写入");
+}
+
+// 监控任务的函数,LED0闪烁表示系统正在运行，并周期采样任务/堆资源占用，
+// 各任务都按时报到时喂独立看门狗
 void SystemMonitorTask(void const* argument)
 {
-    // UBaseType_t hwm_words; // 用于存储返回值（单位：字）
     uint8_t n = 0;
-    
+    uint8_t boot_done, boot_total;
+#if PROF_ENABLE
+    uint32_t last_prof_dump = HAL_GetTick();
+#endif
+
+    SysMonitor_Update(); // 建立运行时统计基准
+    SystemPowerFail_Init();
+
     for(;;)
     {
-        // 每5秒检查一次
-        if (n == 20) {
+        // 启动阶段可能长时间忙等外设 (LSE 起振)，全部完成后才启动看门狗
+        BootGraph_GetProgress(&boot_done, &boot_total);
+        if (boot_done == boot_total) {
+            TaskWdt_Start();
+        }
+        TaskWdt_Supervise();
+
+        // 每5秒采样一次，结果同时供诊断页面读取
+        if (n == SYS_MONITOR_PERIOD_MS / 500) {
             n = 0;
-            // // 检查 LVGL 任务的堆栈
-            // hwm_words = uxTaskGetStackHighWaterMark(defaultTaskHandle);
-            // // 将“字”转换为“字节”并打印
-            // LOG_INFO("LVGL Task Stack HWM: %u bytes remaining", hwm_words * 4);
-
-            // // 检查传感器任务的堆栈
-            // hwm_words = uxTaskGetStackHighWaterMark(SensorTask_GetHandle());
-            // LOG_INFO("Sensor Task Stack HWM: %u bytes remaining", hwm_words * 4);
-
-            // // 检查监控任务自身的堆栈
-            // hwm_words = uxTaskGetStackHighWaterMark(NULL); // 传入NULL检查自身
-            // LOG_INFO("Monitor Task Stack HWM: %u bytes remaining", hwm_words * 4);
-            
-            // LOG_INFO("---------------------------------");
+            SysMonitor_Update();
+            Energy_Update();
+            SysMonitor_LogReport();
+            TaskPlan_LogReport();
+        }
+#if PROF_ENABLE
+        // 定期输出热点区段耗时，并开始新的统计窗口
+        if (HAL_GetTick() - last_prof_dump >= PROF_DUMP_PERIOD_MS) {
+            last_prof_dump = HAL_GetTick();
+            prof_dump(true);
         }
+#endif
+        // 页面设置的写回与合并后的配置修改在这里写入 EEPROM
+        // (本任务优先级最低，阻塞无影响)
+        Drivers_Settings_Process();
+        ConfigStore_Process();
+        LogFlash_Process();
+
+        // 试运行的新固件全部启动阶段完成并稳定运行后确认 (否则引导程序回滚)
+        OtaUpdate_Process(boot_done == boot_total);
+
+        // 按退避间隔重新探测启动时未应答的 I2C 传感器 (热插拔)
+        SensorProbe_Poll();
+
         HAL_GPIO_TogglePin(LED0_GPIO_Port, LED0_Pin);
         n++;
-        osDelay(500);
+        if (osSignalWait(SYS_POWER_FAIL_SIGNAL, 500).status == osEventSignal) {
+            SystemMonitor_OnPowerFail();
+        }
     }
 }
 /* USER CODE END Application */
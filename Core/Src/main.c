@@ -31,6 +31,15 @@
 /* USER CODE BEGIN Includes */
 #include <stdio.h>
 #include "printf_redirect.h"
+#include "shell.h"
+#include "esp_at.h"
+#include "rs485.h"
+#include "lv_port_indev.h"
+#include "sys_clock.h"
+#include "buzzer.h"
+#include "sys_monitor.h"
+#include "warm_start.h"
+#include "crash_dump.h"
 
 #define LOG_MODULE "MAIN"
 #include "log.h"
@@ -84,7 +93,8 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-
+  SysMonitor_CaptureResetCause(); // 复位标志在外设初始化之前读取并清除
+  WarmStart_Init();               // 按复位原因校验热启动记录
   /* USER CODE END Init */
 
   /* Configure the system clock */
@@ -149,7 +159,7 @@ void SystemClock_Config(void)
   RCC_OscInitStruct.PLL.PLLM = 4;
   RCC_OscInitStruct.PLL.PLLN = 168;
   RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
-  RCC_OscInitStruct.PLL.PLLQ = 4;
+  RCC_OscInitStruct.PLL.PLLQ = 7;
   if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
   {
     Error_Handler();
@@ -174,6 +184,10 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
 {
   if (huart->Instance == USART1) {
     printf_uart_tx_complete_callback(huart);
+  } else if (huart->Instance == UART5) {
+    EspAt_TxCpltCallback(huart);
+  } else if (huart->Instance == USART3) {
+    RS485_TxCpltCallback(huart);
   }
  
 }
@@ -182,11 +196,37 @@ void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
   if (huart->Instance == USART1) {
     printf_uart_error_callback(huart);
+    Shell_ErrorCallback(huart);
+  } else if (huart->Instance == UART5) {
+    EspAt_ErrorCallback(huart);
+  } else if (huart->Instance == USART3) {
+    RS485_ErrorCallback(huart);
+  }
+}
+
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+  if (huart->Instance == USART1) {
+    Shell_RxEventCallback(huart, Size);
+  } else if (huart->Instance == UART5) {
+    EspAt_RxEventCallback(huart, Size);
+  } else if (huart->Instance == USART3) {
+    RS485_RxEventCallback(huart, Size);
+  }
+}
+
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  if (GPIO_Pin == GPIO_PIN_1) {
+    // 触摸屏 INT / T_PEN (PB1)
+    lv_port_indev_touch_irq();
   }
 }
 
 void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
 {
+   // 记录溢出的任务后复位 (不返回)
+   CrashDump_StackOverflow(pcTaskName);
    while(1)
    {
       HAL_GPIO_WritePin(LED1_GPIO_Port, LED1_Pin, GPIO_PIN_SET);
@@ -226,7 +266,29 @@ void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim)
     HAL_IncTick();
   }
   /* USER CODE BEGIN Callback 1 */
-
+  if (htim->Instance == TIM6) {
+    SysClock_IncTick();
+    Buzzer_Tick();
+  }
+#if LOG_ISR_TRACE
+  if (htim->Instance == TIM6) {
+    // 统计时基中断间隔的抖动，每 1000 次输出一次最小/最大间隔 (周期数)
+    static uint32_t last, min_gap = UINT32_MAX, max_gap, count;
+    uint32_t now = log_cycles();
+    uint32_t gap = now - last;
+    last = now;
+    if (count > 0) {
+      if (gap < min_gap) min_gap = gap;
+      if (gap > max_gap) max_gap = gap;
+    }
+    if (++count > 1000) {
+      LOG_ISR("TIM6 tick gap min %lu max %lu cycles", min_gap, max_gap, 0);
+      count = 1;
+      min_gap = UINT32_MAX;
+      max_gap = 0;
+    }
+  }
+#endif
   /* USER CODE END Callback 1 */
 }
 
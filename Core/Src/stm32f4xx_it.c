@@ -22,6 +22,17 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "touch_bus.h"
+#include "rtc_clock.h"
+#include "motor.h"
+#include "power_manager.h"
+#include "mydelay.h"
+#include "rtos_trace.h"
+#include "usb_cdc.h"
+#include "sdcard.h"
+#include "eth_mac.h"
+#include "rs485.h"
+#include "can_bus.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -56,11 +67,20 @@
 
 /* External variables --------------------------------------------------------*/
 extern DMA_HandleTypeDef hdma_adc1;
+extern DMA_HandleTypeDef hdma_usart1_rx;
 extern DMA_HandleTypeDef hdma_usart1_tx;
 extern UART_HandleTypeDef huart1;
 extern TIM_HandleTypeDef htim6;
 
 /* USER CODE BEGIN EV */
+extern DMA_HandleTypeDef hdma_lcd;
+extern DMA_HandleTypeDef hdma_draw;
+extern DMA_HandleTypeDef hdma_rgbled;
+extern I2C_HandleTypeDef hi2c1;
+extern UART_HandleTypeDef huart5;
+extern DMA_HandleTypeDef hdma_uart5_rx;
+extern DMA_HandleTypeDef hdma_uart5_tx;
+extern UART_HandleTypeDef huart3;
 
 /* USER CODE END EV */
 
@@ -82,21 +102,6 @@ void NMI_Handler(void)
   /* USER CODE END NonMaskableInt_IRQn 1 */
 }
 
-/**
-  * @brief This function handles Hard fault interrupt.
-  */
-void HardFault_Handler(void)
-{
-  /* USER CODE BEGIN HardFault_IRQn 0 */
-
-  /* USER CODE END HardFault_IRQn 0 */
-  while (1)
-  {
-    /* USER CODE BEGIN W1_HardFault_IRQn 0 */
-    /* USER CODE END W1_HardFault_IRQn 0 */
-  }
-}
-
 /**
   * @brief This function handles Memory management fault.
   */
@@ -168,11 +173,11 @@ void DebugMon_Handler(void)
 void USART1_IRQHandler(void)
 {
   /* USER CODE BEGIN USART1_IRQn 0 */
-
+  RtosTrace_IsrEnter();
   /* USER CODE END USART1_IRQn 0 */
   HAL_UART_IRQHandler(&huart1);
   /* USER CODE BEGIN USART1_IRQn 1 */
-
+  RtosTrace_IsrExit();
   /* USER CODE END USART1_IRQn 1 */
 }
 
@@ -196,29 +201,284 @@ void TIM6_DAC_IRQHandler(void)
 void DMA2_Stream0_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream0_IRQn 0 */
-
+  RtosTrace_IsrEnter();
   /* USER CODE END DMA2_Stream0_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_adc1);
   /* USER CODE BEGIN DMA2_Stream0_IRQn 1 */
-
+  RtosTrace_IsrExit();
   /* USER CODE END DMA2_Stream0_IRQn 1 */
 }
 
+/**
+  * @brief This function handles DMA2 stream5 global interrupt.
+  */
+void DMA2_Stream5_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA2_Stream5_IRQn 0 */
+  RtosTrace_IsrEnter();
+  /* USER CODE END DMA2_Stream5_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart1_rx);
+  /* USER CODE BEGIN DMA2_Stream5_IRQn 1 */
+  RtosTrace_IsrExit();
+  /* USER CODE END DMA2_Stream5_IRQn 1 */
+}
+
 /**
   * @brief This function handles DMA2 stream7 global interrupt.
   */
 void DMA2_Stream7_IRQHandler(void)
 {
   /* USER CODE BEGIN DMA2_Stream7_IRQn 0 */
-
+  RtosTrace_IsrEnter();
   /* USER CODE END DMA2_Stream7_IRQn 0 */
   HAL_DMA_IRQHandler(&hdma_usart1_tx);
   /* USER CODE BEGIN DMA2_Stream7_IRQn 1 */
-
+  RtosTrace_IsrExit();
   /* USER CODE END DMA2_Stream7_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles PVD interrupt through EXTI line 16 (power-fail warning).
+  */
+void PVD_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_PWR_PVD_IRQHandler();
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles RTC wakeup interrupt through EXTI line 22 (1 Hz clock tick).
+  */
+void RTC_WKUP_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  RtcClock_IRQHandler();
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles DMA2 stream1 global interrupt (LCD flush).
+  */
+void DMA2_Stream1_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_DMA_IRQHandler(&hdma_lcd);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles DMA2 stream2 global interrupt (LVGL draw accelerator).
+  */
+void DMA2_Stream2_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_DMA_IRQHandler(&hdma_draw);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles TIM4 global interrupt (fan tach input capture).
+  */
+void TIM4_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  Motor_TachIRQHandler();
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles TIM7 global interrupt (tickless idle wakeup timer).
+  */
+void TIM7_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  Power_TimerIRQHandler();
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles TIM5 global interrupt (delay_us one-shot timer).
+  */
+void TIM5_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  delay_timer_irq_handler();
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles DMA1 stream1 global interrupt (RGB LED fade, TIM2_UP).
+  */
+void DMA1_Stream1_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_DMA_IRQHandler(&hdma_rgbled);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles I2C1 event interrupt.
+  */
+void I2C1_EV_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_I2C_EV_IRQHandler(&hi2c1);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles I2C1 error interrupt.
+  */
+void I2C1_ER_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_I2C_ER_IRQHandler(&hi2c1);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles EXTI line1 interrupt (touch panel INT / T_PEN on PB1).
+  */
+void EXTI1_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_1);
+  RtosTrace_IsrExit();
+}
+
+#if TOUCH_BUS_USE_HW_I2C
+/**
+  * @brief This function handles DMA1 stream2 global interrupt (touch I2C3 RX).
+  */
+void DMA1_Stream2_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_DMA_IRQHandler(&hdma_i2c3_rx);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles I2C3 event interrupt (touch controller).
+  */
+void I2C3_EV_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_I2C_EV_IRQHandler(&hi2c3);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles I2C3 error interrupt (touch controller).
+  */
+void I2C3_ER_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_I2C_ER_IRQHandler(&hi2c3);
+  RtosTrace_IsrExit();
+}
+#endif
+
+/**
+  * @brief This function handles DMA1 stream0 global interrupt (Wi-Fi module UART5 RX).
+  */
+void DMA1_Stream0_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_DMA_IRQHandler(&hdma_uart5_rx);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles DMA1 stream7 global interrupt (Wi-Fi module UART5 TX).
+  */
+void DMA1_Stream7_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_DMA_IRQHandler(&hdma_uart5_tx);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles UART5 global interrupt (Wi-Fi module).
+  */
+void UART5_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_UART_IRQHandler(&huart5);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles DMA1 stream3 global interrupt (RS-485 USART3 TX).
+  */
+void DMA1_Stream3_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  RS485_TxDmaIRQHandler();
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles CAN1 RX0 interrupts.
+  */
+void CAN1_RX0_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  CanBus_RxIRQHandler(0);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles CAN1 RX1 interrupts.
+  */
+void CAN1_RX1_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  CanBus_RxIRQHandler(1);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles USART3 global interrupt (RS-485 / Modbus).
+  */
+void USART3_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  HAL_UART_IRQHandler(&huart3);
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles USB On The Go FS global interrupt (virtual COM port).
+  */
+void OTG_FS_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  UsbCdc_IRQHandler();
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles SDIO global interrupt (microSD archive).
+  */
+void SDIO_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  SdCard_IRQHandler();
+  RtosTrace_IsrExit();
+}
+
+/**
+  * @brief This function handles Ethernet global interrupt (wired telemetry).
+  */
+void ETH_IRQHandler(void)
+{
+  RtosTrace_IsrEnter();
+  EthMac_IRQHandler();
+  RtosTrace_IsrExit();
+}
 
 /* USER CODE END 1 */
 
@@ -0,0 +1,268 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+按模块统计 armlink .map 中的 Flash / RAM 占用并与预算比较。
+
+数据来源:
+  - "Image component sizes" 表: 每个 .o / 库成员的 Code、RO、RW、ZI 大小
+  - 工程文件 (.uvprojx) 的分组: 决定每个 .o 属于哪个模块
+  - "Image Symbol Table": 最大的符号；ucHeap、work_mem_int 等大块内存
+    从所在 .o 中拆出，单独计为一个模块
+  - "Memory Map of the image": 每个执行区 (Flash / SRAM / CCM) 的填充率
+
+Flash = Code + RO + RW (RW 初值存放在 Flash 中，未计 armlink 的压缩)
+RAM   = RW + ZI
+
+资源文件与字体逐个列出。需要把数据挪到 CCM、SRAM2 或外部 Flash 时，
+先看 "Largest RAM/Flash symbols" 与各执行区的剩余空间。
+
+用法:
+    python map_report.py                       # 报告 (默认读取工程输出目录的 .map)
+    python map_report.py --check               # 有模块超出预算时返回 1
+    python map_report.py --top 40 -o 10-EnviroSense_zgt6\\mem_report.txt
+
+作为 Keil "After Build" 用户命令运行时，报告写入输出目录，与 .map 一起归档。
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+PROJECT = os.path.join(HERE, "10-EnviroSense_zgt6.uvprojx")
+MAP = os.path.join(HERE, "10-EnviroSense_zgt6", "10-EnviroSense_zgt6.map")
+
+# 模块划分，按顺序匹配，第一条命中的规则生效
+#   group: 工程分组名前缀; obj: .o 文件名正则
+#   symbol: RAM 符号名正则，命中的符号从所在 .o 中拆出归入该模块
+#   detail: 报告中逐个列出该模块的 .o / 符号
+MODULES = [
+    {"name": "FreeRTOS heap", "symbol": r"^ucHeap$"},
+    {"name": "LVGL pool", "symbol": r"^work_mem_int$"},
+    {"name": "MSP stack", "symbol": r"^(STACK|HEAP)$"},
+    # 静态分配的任务栈 (osThreadStaticDef 的缓冲区与空闲/定时器任务栈)
+    {"name": "task stacks", "symbol": r"(TaskBuffer|HelperBuffer|_stack|^x\w*Stack)$", "detail": True},
+    {"name": "fonts", "obj": r"^(my_font_|lv_font_(montserrat|dejavu|simsun|unscii))", "detail": True},
+    {"name": "assets", "group": "Middlewares/lvgl/LVGL/GUI_Assets", "detail": True},
+    {"name": "UI", "group": "Middlewares/lvgl/LVGL/GUI_APP"},
+    {"name": "LVGL port", "group": "Middlewares/lvgl/examples/porting"},
+    {"name": "LVGL core", "group": "Middlewares/lvgl/"},
+    {"name": "FreeRTOS", "group": "Middlewares/FreeRTOS"},
+    {"name": "HAL/CMSIS", "group": "Drivers/"},
+    {"name": "Core", "group": "Application/User/Core"},
+    {"name": "startup", "group": "Application/MDK-ARM"},
+    {"name": "drivers", "group": "Application/MyDrivers/Bus"},
+    {"name": "drivers", "group": "Application/MyDrivers/Peripherals"},
+    {"name": "drivers", "group": "Application/MyDrivers/Common"},
+    {"name": "services", "group": "Application/MyDrivers/Services"},
+    {"name": "app", "group": "Application/MyApp"},
+    {"name": "C library", "library": True},
+]
+
+# 预算 (字节): 模块 -> (Flash, RAM)，None 表示不检查
+# 以当前映像为基准留出余量；调整布局 (如缓冲区移入 CCM) 后同步修改
+BUDGETS = {
+    "FreeRTOS heap": (None, 4 * 1024),
+    "LVGL pool": (None, 48 * 1024),
+    "MSP stack": (None, 1024),
+    "task stacks": (None, 24 * 1024),
+    "fonts": (200 * 1024, None),
+    "assets": (240 * 1024, 0),
+    "UI": (48 * 1024, 2 * 1024),
+    "LVGL port": (4 * 1024, 20 * 1024),
+    "LVGL core": (200 * 1024, 2 * 1024),
+    "FreeRTOS": (12 * 1024, 1024),
+    "HAL/CMSIS": (24 * 1024, 512),
+    "Core": (8 * 1024, 1024),
+    "drivers": (48 * 1024, 2 * 1024),
+    "services": (48 * 1024, 8 * 1024),
+    "app": (4 * 1024, 512),
+    "C library": (12 * 1024, 64),
+}
+
+OBJ_LINE = re.compile(r"^\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\S+\.o)\s*$")
+SYM_LINE = re.compile(r"^\s{4}(\S+)\s+0x([0-9a-fA-F]{8})\s+(Thumb Code|ARM Code|Data|Section)\s+(\d+)\s+(\S+?)\((\S+)\)")
+REGION_LINE = re.compile(r"Execution Region (\S+) \(Exec base: 0x([0-9a-fA-F]+),.*?Size: 0x([0-9a-fA-F]+), Max: 0x([0-9a-fA-F]+)")
+
+
+def load_groups(path):
+    """返回 {xxx.o: 工程分组名}"""
+    groups = {}
+    if not os.path.exists(path):
+        return groups
+    text = open(path, encoding="utf-8", errors="replace").read()
+    for g in re.finditer(r"<GroupName>([^<]*)</GroupName>(.*?)</Group>", text, re.S):
+        for name in re.findall(r"<FileName>([^<]*)</FileName>", g.group(2)):
+            groups[os.path.splitext(name)[0] + ".o"] = g.group(1)
+    return groups
+
+
+def parse_map(path):
+    objects = []   # (name, code, ro, rw, zi, is_library)
+    symbols = []   # (name, addr, kind, size, obj, section)
+    regions = []   # (name, base, size, max)
+    section = None
+    for line in open(path, encoding="latin-1"):
+        if line.startswith("Image Symbol Table"):
+            section = "symbols"
+        elif line.startswith("Memory Map of the image"):
+            section = "memory"
+        elif line.startswith("Image component sizes"):
+            section = "sizes"
+        elif "Library Member Name" in line:
+            section = "library"
+        elif "Library Name" in line or "Grand Totals" in line:
+            section = None
+
+        if section == "symbols":
+            m = SYM_LINE.match(line)
+            if m:
+                symbols.append((m.group(1), int(m.group(2), 16), m.group(3), int(m.group(4)),
+                                m.group(5), m.group(6)))
+        elif section == "memory":
+            m = REGION_LINE.search(line)
+            if m:
+                regions.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16), int(m.group(4), 16)))
+        elif section in ("sizes", "library"):
+            m = OBJ_LINE.match(line)
+            if m:
+                code, _inc, ro, rw, zi, _debug = (int(v) for v in m.groups()[:6])
+                objects.append((m.group(7), code, ro, rw, zi, section == "library"))
+    return objects, symbols, regions
+
+
+def classify(obj, groups, is_library):
+    group = groups.get(obj, "")
+    for rule in MODULES:
+        if "symbol" in rule:
+            continue
+        if rule.get("library") and is_library:
+            return rule["name"], rule.get("detail", False)
+        if "obj" in rule and re.search(rule["obj"], obj):
+            return rule["name"], rule.get("detail", False)
+        if "group" in rule and group and group.startswith(rule["group"]):
+            return rule["name"], rule.get("detail", False)
+    return "other", False
+
+
+def region_of(addr):
+    if 0x08000000 <= addr < 0x08100000:
+        return "Flash"
+    if 0x10000000 <= addr < 0x10010000:
+        return "CCM"
+    if 0x2001C000 <= addr < 0x20020000:
+        return "SRAM2"
+    if 0x20000000 <= addr < 0x2001C000:
+        return "SRAM1"
+    return "-"
+
+
+def build_report(objects, symbols, regions, groups, top):
+    modules = {}   # name -> [flash, ram]
+    details = {}   # name -> [(obj, flash, ram)]
+    obj_module = {}
+    for obj, code, ro, rw, zi, is_lib in objects:
+        name, detail = classify(obj, groups, is_lib)
+        obj_module[obj] = name
+        m = modules.setdefault(name, [0, 0])
+        m[0] += code + ro + rw
+        m[1] += rw + zi
+        if detail:
+            details.setdefault(name, []).append((obj, code + ro + rw, rw + zi))
+
+    # 大块内存从所在 .o 中拆出 (同一地址只拆一次，STACK/HEAP 只以 Section 出现)
+    taken = set()
+    for rule in MODULES:
+        if "symbol" not in rule:
+            continue
+        for name, addr, kind, size, obj, _sec in symbols:
+            if (addr in taken or size == 0 or region_of(addr) == "Flash" or
+                    not re.search(rule["symbol"], name) or
+                    (kind == "Section" and name not in ("STACK", "HEAP"))):
+                continue
+            taken.add(addr)
+            src = obj_module.get(obj, "other")
+            modules.setdefault(src, [0, 0])[1] -= size
+            modules.setdefault(rule["name"], [0, 0])[1] += size
+            if rule.get("detail"):
+                details.setdefault(rule["name"], []).append((name, 0, size))
+
+    lines = []
+    over = []
+    lines.append("%-16s %10s %10s %8s %10s %10s %8s" % ("Module", "Flash", "budget", "%", "RAM", "budget", "%"))
+
+    def pct(used, budget):
+        return "%7.1f%%" % (used * 100.0 / budget) if budget else ("   over" if used and budget == 0 else "       -")
+
+    order = [r["name"] for r in MODULES] + ["other"]
+    seen = set()
+    for name in order:
+        if name in seen or name not in modules:
+            continue
+        seen.add(name)
+        flash, ram = modules[name]
+        fb, rb = BUDGETS.get(name, (None, None))
+        lines.append("%-16s %10d %10s %8s %10d %10s %8s" % (
+            name, flash, "-" if fb is None else fb, pct(flash, fb),
+            ram, "-" if rb is None else rb, pct(ram, rb)))
+        if fb is not None and flash > fb:
+            over.append("%s flash %d > %d" % (name, flash, fb))
+        if rb is not None and ram > rb:
+            over.append("%s RAM %d > %d" % (name, ram, rb))
+        for obj, f, r in sorted(details.get(name, []), key=lambda d: (-d[1], -d[2])):
+            if f or r:
+                lines.append("  %-34s %10d %10d" % (obj, f, r))
+    total_flash = sum(m[0] for m in modules.values())
+    total_ram = sum(m[1] for m in modules.values())
+    lines.append("%-16s %10d %10s %8s %10d" % ("total", total_flash, "", "", total_ram))
+
+    lines.append("")
+    lines.append("%-10s %10s %10s %10s %8s" % ("Region", "Base", "Used", "Max", "Free"))
+    for name, base, size, limit in regions:
+        lines.append("%-10s 0x%08x %10d %10d %8d" % (name, base, size, limit, limit - size))
+
+    data = {}
+    for s in symbols:
+        if s[2] == "Section" and s[0] not in ("STACK", "HEAP"):
+            continue
+        data.setdefault((s[1], s[4]), s)   # 同一地址同一 .o 只计一次
+    ram_syms = sorted((s for s in data.values() if region_of(s[1]) != "Flash"), key=lambda s: -s[3])
+    rom_syms = sorted((s for s in data.values() if region_of(s[1]) == "Flash"), key=lambda s: -s[3])
+    for title, syms in (("Largest RAM symbols", ram_syms), ("Largest Flash symbols", rom_syms)):
+        lines.append("")
+        lines.append(title)
+        for name, addr, kind, size, obj, _sec in syms[:top]:
+            lines.append("  %-40s %8d  %-6s %-10s %s" % (name, size, region_of(addr), kind, obj))
+    return lines, over
+
+
+def main():
+    ap = argparse.ArgumentParser(description="armlink map 模块占用与预算")
+    ap.add_argument("map", nargs="?", default=MAP)
+    ap.add_argument("--project", default=PROJECT)
+    ap.add_argument("--top", type=int, default=20, help="列出的最大符号数")
+    ap.add_argument("--check", action="store_true", help="超出预算时返回 1")
+    ap.add_argument("-o", "--output", help="同时把报告写入文件")
+    opts = ap.parse_args()
+
+    if not os.path.exists(opts.map):
+        sys.exit("map file not found: %s" % opts.map)
+    objects, symbols, regions = parse_map(opts.map)
+    if not objects:
+        sys.exit("no 'Image component sizes' table in %s (enable the linker size info)" % opts.map)
+    lines, over = build_report(objects, symbols, regions, load_groups(opts.project), opts.top)
+    if over:
+        lines.append("")
+        lines.extend("OVER BUDGET: " + o for o in over)
+
+    text = "\n".join(lines) + "\n"
+    sys.stdout.write(text)
+    if opts.output:
+        with open(opts.output, "w", encoding="utf-8") as f:
+            f.write(text)
+    return 1 if opts.check and over else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+任务栈最坏用量估算与栈大小建议。
+
+静态部分来自 armlink 的静态调用图 (--callgraph 生成的 10-EnviroSense_zgt6.htm)：
+每个函数的 "Max Depth" 是沿已知调用链的最大栈深，但经函数指针的调用
+(LVGL 事件回调、传感器驱动回调、命令表) 在调用图中断开。
+为此每个任务除入口函数外还列出间接调用的根函数 (正则)，按
+    入口深度 + 间接根函数中的最大深度
+估算上界 (偏保守：间接调用实际发生在入口调用链的较浅处)。
+
+另加上下文开销 CONTEXT_BYTES：任务被中断时硬件压栈 (含惰性 FPU 保存区 26 字)
+与 PendSV 保存的 r4-r11/lr 及 s16-s31。中断服务程序使用 MSP，不计入任务栈。
+
+运行时部分来自命令行 stacks 命令 (每行 "STACK <任务> free=<字节>")，
+或 SysMonitor_LogReport 的日志行 ("stack free <字节> B")。
+两者取大，乘以余量后按 32 字向上取整给出建议值。
+递归 (In Cycle) 与无法追踪的函数标记为 "?"，这类任务以运行时数据为准。
+
+用法:
+    python stack_report.py                          # 静态估算与当前配置对比
+    python stack_report.py --hwm stacks.txt         # 结合板上 "stacks" 命令的输出
+    python stack_report.py --task shell --top 5     # 列出某任务最深的间接调用
+"""
+
+import argparse
+import html
+import math
+import os
+import re
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ROOT = os.path.dirname(HERE)
+CALLGRAPH = os.path.join(HERE, "10-EnviroSense_zgt6", "10-EnviroSense_zgt6.htm")
+
+CONTEXT_BYTES = (8 + 18) * 4 + (9 + 16) * 4  # 异常压栈 (含 FPU) + PendSV 保存
+MARGIN = 1.25                                # 建议值相对最坏用量的余量
+ROUND_WORDS = 32
+MIN_WORDS = 128                              # configMINIMAL_STACK_SIZE
+
+
+def define(path, name):
+    return (path, r"#define\s+%s\s+\(?\s*(?:\(\w+\))?\s*(\d+)" % name)
+
+
+# 任务名 (与 FreeRTOS 中的名字一致) -> 入口函数、栈大小来源 (字)、间接调用的根函数
+TASKS = [
+    {"name": "defaultTask", "entry": "StartDefaultTask",
+     "size": ("Core/Src/freertos.c", r"defaultTaskBuffer\[\s*(\d+)\s*\]"),
+     "indirect": r"(_event_cb|_timer_cb|_anim_cb)$|^ui_screen_\w+_(init|deinit|on_show|on_hide)$"
+                 r"|^(disp_flush|disp_refr_timer_cb|touchpad_read)$"},
+    {"name": "SystemAppInitTask", "entry": "SystemAppInitTask",
+     "size": define("Core/Src/freertos.c", "SYS_INIT_TASK_STACK_SIZE")},
+    {"name": "SystemAppInitHelper", "entry": "SystemAppInitTask",
+     "size": define("Core/Src/freertos.c", "SYS_INIT_TASK_STACK_SIZE")},
+    {"name": "SystemMonitorTask", "entry": "SystemMonitorTask",
+     "size": define("Core/Src/freertos.c", "SYS_MONITOR_TASK_STACK_SIZE")},
+    {"name": "sensorTask", "entry": "SensorTask_MainLoop",
+     "size": define("MyDrivers/Services/sensor_manager/sensor_task.h", "SENSOR_TASK_STACK_SIZE"),
+     "indirect": r"^(GY30|SHT30|MQ2)_Sensor_(Init|Read|Deinit|Start|Collect)$|^sensor_replay_(init|read)$"},
+    {"name": "i2cBusTask", "entry": "I2C_Bus_ServerTask",
+     "size": define("MyDrivers/Bus/i2c_bus_manager/i2c_bus_manager.h", "I2C_BUS_TASK_STACK_SIZE")},
+    {"name": "log", "entry": "log_task",
+     "size": define("MyDrivers/Services/log/log.h", "LOG_TASK_STACK_SIZE")},
+    {"name": "touch", "entry": "touch_service_task",
+     "size": define("MyDrivers/Services/touch_service/touch_service.h", "TOUCH_SERVICE_TASK_STACK_SIZE")},
+    {"name": "shell", "entry": "shell_task",
+     "size": define("MyDrivers/Services/shell/shell.h", "SHELL_TASK_STACK_SIZE"),
+     "indirect": r"^shell_cmd_\w+$"},
+    {"name": "slog", "entry": "sensor_log_task",
+     "size": define("MyDrivers/Services/sensor_log/sensor_log.h", "SENSOR_LOG_TASK_STACK_SIZE")},
+    {"name": "telemetry", "entry": "telemetry_task",
+     "size": define("MyDrivers/Services/telemetry/telemetry.h", "TELEMETRY_TASK_STACK_SIZE")},
+    {"name": "modbus", "entry": "modbus_task",
+     "size": define("MyDrivers/Services/modbus_slave/modbus_slave.h", "MODBUS_TASK_STACK_SIZE")},
+    {"name": "output", "entry": "Drivers_Control_Task",
+     "size": define("MyDrivers/Services/devices_manager/devices_manager.h", "DRIVERS_CONTROL_TASK_STACK_SIZE")},
+    {"name": "IDLE", "entry": "prvIdleTask",
+     "size": define("Core/Inc/FreeRTOSConfig.h", "configMINIMAL_STACK_SIZE")},
+]
+
+FUNC_LINE = re.compile(r'<STRONG><a name="\[\w+\]"></a>([^<]+)</STRONG> \(\w+, \d+ bytes, '
+                       r'Stack size (\d+|unknown) bytes')
+DEPTH_LINE = re.compile(r"Max Depth = (\d+)( \+ [^<]+)?")
+
+
+def parse_callgraph(path):
+    """返回 {函数名: (最大栈深, 是否不确定)}"""
+    funcs = {}
+    current = None
+    for line in open(path, encoding="latin-1"):
+        m = FUNC_LINE.search(line)
+        if m:
+            name = html.unescape(m.group(1))
+            own = m.group(2)
+            current = name
+            funcs[name] = (0 if own == "unknown" else int(own), own == "unknown")
+            continue
+        if current:
+            m = DEPTH_LINE.search(line)
+            if m:
+                funcs[current] = (int(m.group(1)), funcs[current][1] or bool(m.group(2)))
+                current = None
+    return funcs
+
+
+def read_size(spec):
+    path, pattern = spec
+    try:
+        text = open(os.path.join(ROOT, path), encoding="utf-8", errors="replace").read()
+    except OSError:
+        return None
+    m = re.search(pattern, text)
+    return int(m.group(1)) if m else None
+
+
+def parse_hwm(path):
+    """返回 {任务名: 历史最小剩余字节}"""
+    free = {}
+    for line in open(path, encoding="utf-8", errors="replace"):
+        m = re.search(r"STACK (\S+) free=(\d+)", line)
+        if not m:
+            m = re.search(r"\s(\S+)\s+\S P\d+\s+cpu.*stack free (\d+) B", line)
+        if m:
+            name, value = m.group(1), int(m.group(2))
+            free[name] = min(value, free.get(name, value))
+    return free
+
+
+def task_depth(task, funcs, top):
+    entry = funcs.get(task["entry"])
+    if entry is None:
+        return None, True, []
+    depth, unsure = entry
+    roots = []
+    if task.get("indirect"):
+        roots = sorted(((n, d) for n, d in funcs.items() if re.search(task["indirect"], n)),
+                       key=lambda r: -r[1][0])
+        if roots:
+            depth += roots[0][1][0]
+            unsure = unsure or any(d[1] for _n, d in roots)
+    return depth, unsure, roots[:top]
+
+
+def main():
+    ap = argparse.ArgumentParser(description="任务栈最坏用量估算")
+    ap.add_argument("callgraph", nargs="?", default=CALLGRAPH)
+    ap.add_argument("--hwm", help="板上 stacks 命令或监控日志的输出")
+    ap.add_argument("--task", help="只报告一个任务并列出其间接调用")
+    ap.add_argument("--top", type=int, default=3, help="--task 时列出的间接调用数")
+    opts = ap.parse_args()
+
+    if not os.path.exists(opts.callgraph):
+        sys.exit("call graph not found: %s (enable Linker > Callgraph)" % opts.callgraph)
+    funcs = parse_callgraph(opts.callgraph)
+    free = parse_hwm(opts.hwm) if opts.hwm else {}
+
+    print("%-20s %7s %8s %8s %8s %9s  %s" % ("Task", "size B", "static B", "+ctx B", "used B", "suggest", "note"))
+    for task in TASKS:
+        if opts.task and task["name"] != opts.task:
+            continue
+        words = read_size(task["size"])
+        size = words * 4 if words else None
+        depth, unsure, roots = task_depth(task, funcs, opts.top)
+        static = depth + CONTEXT_BYTES if depth is not None else None
+        used = size - free[task["name"]] if size and task["name"] in free else None
+
+        # 静态估算不确定且没有运行时数据时不给建议
+        known = [v for v in (static if not unsure else None, used) if v is not None]
+        suggest = None
+        if known:
+            suggest = max(MIN_WORDS, int(math.ceil(max(known) * MARGIN / 4 / ROUND_WORDS)) * ROUND_WORDS)
+        notes = []
+        if depth is None:
+            notes.append("entry not in call graph")
+        elif unsure:
+            notes.append("static ? (recursion/unknown)")
+        elif roots:
+            notes.append("upper bound via %s" % roots[0][0])
+        if size and used is not None and used > size * 0.9:
+            notes.append("HWM > 90%")
+        if size and suggest and suggest * 4 < size:
+            notes.append("can shrink %d B" % (size - suggest * 4))
+        elif size and suggest and suggest * 4 > size:
+            notes.append("raise")
+        print("%-20s %7s %8s %8s %8s %7s w  %s" % (
+            task["name"], size if size else "?", depth if depth is not None else "?",
+            static if static is not None else "?", used if used is not None else "-",
+            suggest if suggest else "-", ", ".join(notes)))
+        if opts.task:
+            for name, (d, u) in roots:
+                print("    via %-40s %6d%s" % (name, d, " ?" if u else ""))
+
+
+if __name__ == "__main__":
+    main()
@@ -10,21 +10,73 @@
  *      INCLUDES
  *********************/
 #include "lv_port_disp.h"
+#include "lv_port_draw.h"
 #include "lvgl.h"
 /* lcdͷļ */
 #include "lcd.h"
+#include "lcd_orient.h"
+#include "profiler.h"
+#include "frame_stats.h"
+#include "sensor_latency.h"
+#include "ui_coalesce.h"
+#include "mem_section.h"
+#include "sram.h"
 
 /*********************
  *      DEFINES
  *********************/
-#define USE_SRAM        0       /* ʹⲿsramΪ1Ϊ0 */
-#ifdef USE_SRAM
-// #include "./MALLOC/malloc.h"
-#endif
-
 #define MY_DISP_HOR_RES (800)   /* Ļ */
 #define MY_DISP_VER_RES (480)   /* Ļ߶ */
 
+/* ͼ */
+#define LV_DISP_BUF_DOUBLE      1       /* 1: ˫(Ⱦ DMA ˢ²), 0:  */
+#define LV_DISP_BUF_LINES       10      /* ÿ(߶),  RAM ռ֡ */
+
+/* λ */
+#define LV_DISP_BUF_IN_SRAM     0       /* ڲ SRAM(Ĭ) */
+#define LV_DISP_BUF_IN_CCM      1       /* CCM RAM(RW_CCM ִ), DMA ޷,  CPU ˢ */
+#define LV_DISP_BUF_IN_EXSRAM   2       /* ⲿ SRAM(FSMC_NE3, 0x68000000), ȳʼ FSMC Bank1 NE3 */
+#define LV_DISP_BUF_PLACE       LV_DISP_BUF_IN_SRAM
+
+#define LV_DISP_BUF_SIZE        (MY_DISP_HOR_RES * LV_DISP_BUF_LINES)   /*  */
+
+/* ȫ֡: 1 ⲿ SRAM зһ, LVGL  direct_mode Ļֱ
+ * , ٰظؼ; һֻ֡ѸʧЧ֡ DMA
+ *  LCDⲿ SRAM Լʧʱ˻ڲ SRAM еĵ
+ * 1 MB ֻŵһ, һ֡ʼǰҪһ֡ (ֻʧЧ)  */
+#define LV_DISP_FB_EXSRAM       0
+
+/* ˢ·ʽѡ: 1 ʹ DMA2 洢洢ģʽд LCD_RAM, 0 ʹ CPU ѭд */
+#define LCD_USE_DMA_FLUSH       1
+
+ /* ʧЧϲĴģ(λ: д): ÿˢһĹ̶Ϊ
+  * LVGL һ + DMA /ж, ӿļĴд */
+#define DISP_FLUSH_OVERHEAD_PX  256     /* ÿ뿪޹صĹ̶ */
+#define DISP_REG_WRITE_PX       8       /* һμĴ/д( + ) */
+
+#if LCD_USE_DMA_FLUSH
+#define LCD_DMA_STREAM          DMA2_Stream1        /* ֻ DMA2 ִ֧洢洢, Stream0/7 ѱ ADC1/USART1 ռ */
+#define LCD_DMA_IRQn            DMA2_Stream1_IRQn
+#define LCD_DMA_MAX_XFER        (0xFFFF)            /* NDTR Ϊ 16 λ, ഫ 65535  */
+#endif
+
+#if (LCD_USE_DMA_FLUSH || (LV_PORT_DRAW_ACCEL != LV_PORT_DRAW_ACCEL_NONE)) && (LV_DISP_BUF_PLACE == LV_DISP_BUF_IN_CCM)
+#error "CCM RAM  DMA ߾, ʹ DMA ˢ»ͼʱܷ CCM"
+#endif
+
+#if (LV_DISP_BUF_PLACE == LV_DISP_BUF_IN_EXSRAM)
+#define LV_DISP_BUF_ADDR        SRAM_BASE_ADDR
+#endif
+
+#if LV_DISP_FB_EXSRAM
+#if !LCD_USE_DMA_FLUSH
+#error "ȫ֡ģʽʧЧ DMA ˢ, Ҫ LCD_USE_DMA_FLUSH"
+#endif
+#if (MY_DISP_HOR_RES * MY_DISP_VER_RES * 2) > SRAM_SIZE
+#error "ⲿ SRAM Ųһ"
+#endif
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,16 +86,63 @@
  **********************/
 /* ʾ豸ʼ */
 static void disp_init(void);
+static void disp_resize_layer(lv_obj_t *layer);
+static lv_obj_tree_walk_res_t disp_layout_dirty_cb(lv_obj_t *obj, void *user_data);
+static bool disp_flush_slide_clip(lv_disp_drv_t * disp_drv, const lv_area_t * area, const lv_color_t * color_p);
+static void disp_scroll_apply(void);
+static void disp_rounder(lv_disp_drv_t * disp_drv, lv_area_t * area);
+static uint32_t disp_area_cost(const lv_area_t * area);
+static void disp_join_areas(lv_disp_t * disp);
+
+#if LCD_USE_DMA_FLUSH
+/* ˢ DMA ʼɻص */
+static void lcd_dma_init(void);
+static void lcd_dma_start_next(void);
+static void lcd_dma_xfer_cplt_cb(DMA_HandleTypeDef *hdma);
+#endif
+#if LV_DISP_FB_EXSRAM
+static void disp_flush_fb(lv_disp_drv_t * disp_drv, const lv_color_t * fb);
+static bool lcd_fb_start_next(void);
+#endif
 
 /* ʾ豸ˢº */
 static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p);
-/* GPU 亯(ʹGPUʱҪʵ) */
-//static void gpu_fill(lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, lv_coord_t dest_width,
-//        const lv_area_t * fill_area, lv_color_t color);
+
+/* ֡ͳƹ */
+static void disp_refr_timer_cb(lv_timer_t * timer);
+static void disp_monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px);
+static void disp_wait_cb(lv_disp_drv_t * disp_drv);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LCD_USE_DMA_FLUSH
+DMA_HandleTypeDef hdma_lcd;                         /* LCD ˢ DMA , жϷ stm32f4xx_it.c */
+
+static lv_disp_drv_t *s_flush_drv = NULL;           /* ǰˢµʾ豸 */
+static const uint16_t *s_dma_src = NULL;            /* һδݵʼַ */
+static uint32_t s_dma_remain = 0;                   /* ʣ */
+#endif
+#if LV_DISP_FB_EXSRAM
+static bool s_fb_mode = false;                      /* ⲿ SRAM ȫ֡ */
+static const uint16_t *s_fb = NULL;                 /* ֡ */
+static lv_coord_t s_fb_stride = 0;                  /* ֡ÿ(ǰˮƽֱ) */
+static lv_area_t s_fb_rects[LV_INV_BUF_SIZE];       /* ֡ʧЧ */
+static uint16_t s_fb_rect_cnt = 0;
+static uint16_t s_fb_rect_idx = 0;                  /* ڴ */
+static lv_coord_t s_fb_row = 0;                     /* һεʼ */
+#endif
+static uint32_t s_flush_start = 0;                  /* ˢµʼڼ() */
+static lv_disp_drv_t s_disp_drv;                    /* ʾ豸(лʱ·ֱ) */
+static lv_disp_t * s_disp = NULL;                   /* עʾ豸 */
+
+/* Ӳҳ滬 */
+static int8_t s_slide_dir = 0;                      /* 0: δ, 1: ҳҲ, -1:  */
+static lv_coord_t s_slide_px = 0;                   /* ҳѻĿ */
+static lv_area_t s_slide_clip;                      /* ҳѻ벿ֵ߼, ֮ˢ¶ */
+static uint16_t s_scroll_pending = 0;               /* ˢɺҪдƽ */
+static uint16_t s_scroll_applied = 0;               /* ǰƽ */
+static uint32_t s_flush_setup_px = DISP_FLUSH_OVERHEAD_PX; /* ÿĹ̶() */
 
 /**********************
  *      MACROS
@@ -64,13 +163,8 @@ void lcd_draw_fast_rgb_color(int16_t sx, int16_t sy,int16_t ex, int16_t ey, uint
     uint16_t h = ey-sy+1;
 
     lcd_set_window(sx, sy, w, h);
-    uint32_t draw_size = w * h;
     lcd_write_ram_prepare();
-
-    for(uint32_t i = 0; i < draw_size; i++)
-    {
-        lcd_wr_data(color[i]);
-    }
+    lcd_stream_pixels(color, (uint32_t)w * h);     /* 32 λд, ÿ */
 }
 
 /**
@@ -109,21 +203,49 @@ void lv_port_disp_init(void)
      *      LVGLʼ 'flush_cb' ʽṩȾĻֻ֡ĵַ
      */
 
-    /* ʾ) */
-    static lv_disp_draw_buf_t draw_buf_dsc_1;
-#if USE_SRAM
-    static lv_color_t buf_1 = mymalloc(SRAMEX, MY_DISP_HOR_RES * MY_DISP_VER_RES);              /* ûĴСΪĻȫߴС */
-    lv_disp_draw_buf_init(&draw_buf_dsc_1, buf_1, NULL, MY_DISP_HOR_RES * MY_DISP_VER_RES);     /* ʼʾ */
+    static lv_disp_draw_buf_t draw_buf_dsc;
+#if LV_DISP_FB_EXSRAM
+    static lv_color_t buf_fallback[LV_DISP_BUF_SIZE];                                           /* ⲿ SRAM ʱ */
+
+    if (sram_init() == 0)
+    {
+        s_fb_mode = true;
+        lv_disp_draw_buf_init(&draw_buf_dsc, (lv_color_t *)SRAM_BASE_ADDR, NULL, MY_DISP_HOR_RES * MY_DISP_VER_RES);
+    }
+    else
+    {
+        lv_disp_draw_buf_init(&draw_buf_dsc, buf_fallback, NULL, LV_DISP_BUF_SIZE);
+    }
 #else
-    static lv_color_t buf_1[MY_DISP_HOR_RES * 10];                                              /* ûĴСΪ 10 ĻĴС */
-    lv_disp_draw_buf_init(&draw_buf_dsc_1, buf_1, NULL, MY_DISP_HOR_RES * 10);                  /* ʼʾ */
+#if (LV_DISP_BUF_PLACE == LV_DISP_BUF_IN_SRAM)
+    static lv_color_t buf_1[LV_DISP_BUF_SIZE];                                                  /* ûĴСΪ LV_DISP_BUF_LINES ĻĴС */
+#if LV_DISP_BUF_DOUBLE
+    static lv_color_t buf_2[LV_DISP_BUF_SIZE];                                                  /* һͬСĻ */
+#endif
+#elif (LV_DISP_BUF_PLACE == LV_DISP_BUF_IN_CCM)
+    /*  lv_mem ڴع 64 KB CCM,  */
+    static CCM_RAM lv_color_t buf_1[LV_DISP_BUF_SIZE];
+#if LV_DISP_BUF_DOUBLE
+    static CCM_RAM lv_color_t buf_2[LV_DISP_BUF_SIZE];
+#endif
+#else
+    /* ⲿ SRAM δڷɢļл, ֱʹù̶ַ */
+    if (sram_init() != 0)
+    {
+        Error_Handler();
+    }
+    lv_color_t *buf_1 = (lv_color_t *)LV_DISP_BUF_ADDR;
+#if LV_DISP_BUF_DOUBLE
+    lv_color_t *buf_2 = (lv_color_t *)LV_DISP_BUF_ADDR + LV_DISP_BUF_SIZE;
+#endif
 #endif
 
-    /* ˫ʾ) */
-//    static lv_disp_draw_buf_t draw_buf_dsc_2;
-//    static lv_color_t buf_2_1[MY_DISP_HOR_RES * 10];                                            /* ûĴСΪ 10 ĻĴС */
-//    static lv_color_t buf_2_2[MY_DISP_HOR_RES * 10];                                            /* һĴСΪ 10 ĻĴС */
-//    lv_disp_draw_buf_init(&draw_buf_dsc_2, buf_2_1, buf_2_2, MY_DISP_HOR_RES * 10);             /* ʼʾ */
+#if LV_DISP_BUF_DOUBLE
+    lv_disp_draw_buf_init(&draw_buf_dsc, buf_1, buf_2, LV_DISP_BUF_SIZE);                      /* ˫: Ⱦһͬʱˢһ */
+#else
+    lv_disp_draw_buf_init(&draw_buf_dsc, buf_1, NULL, LV_DISP_BUF_SIZE);                       /*  */
+#endif
+#endif /* LV_DISP_FB_EXSRAM */
 
     /* ȫߴ˫ʾ)  disp_drv.full_refresh = 1 */
 //    static lv_disp_draw_buf_t draw_buf_dsc_3;
@@ -135,39 +257,206 @@ void lv_port_disp_init(void)
      *  LVGL עʾ豸
      *----------------------------------*/
 
-    static lv_disp_drv_t disp_drv;                  /* ʾ豸 */
-    lv_disp_drv_init(&disp_drv);                    /* ʼΪĬֵ */
+    lv_disp_drv_t * disp_drv = &s_disp_drv;
+    lv_disp_drv_init(disp_drv);                     /* ʼΪĬֵ */
 
     /* ʾ豸ĺ  */
 
     /* ʾ豸ķֱ
      * ΪԭӵĶĻ˶̬ȡķʽ
      * ʵĿУͨʹõĻСǹ̶ģ˿ֱΪĻĴС */
-    disp_drv.hor_res = lcddev.width;
-    disp_drv.ver_res = lcddev.height;
+    disp_drv->hor_res = lcddev.width;
+    disp_drv->ver_res = lcddev.height;
 
     /* ݸƵʾ豸 */
-    disp_drv.flush_cb = disp_flush;
+    disp_drv->flush_cb = disp_flush;
+
+    /* ʧЧ x  2 ض: ÿж, 32 λд벻 */
+    disp_drv->rounder_cb = disp_rounder;
 
     /* ʾ */
-    disp_drv.draw_buf = &draw_buf_dsc_1;
+    disp_drv->draw_buf = &draw_buf_dsc;
 
     /* ȫߴ˫ʾ)*/
-    //disp_drv.full_refresh = 1
+    //disp_drv->full_refresh = 1
+
+#if LV_DISP_FB_EXSRAM
+    /* ȫ֡: ĻֱӻʧЧ, رһ֡ */
+    disp_drv->direct_mode = s_fb_mode;
+#endif
+
+    /* ҽӻͼٲ: F407 ʹ DMA 洢洢,  DMA2D оƬʹ Chrom-ART
+     *  lv_port_draw.c */
+    lv_port_draw_init(disp_drv);
+
+    /* ֡ͳ: ػȴˢʱ */
+    disp_drv->monitor_cb = disp_monitor_cb;
+    disp_drv->wait_cb = disp_wait_cb;
+
+    /* עʾ豸, üʱװ滻ˢ¶ʱص */
+    s_disp = lv_disp_drv_register(disp_drv);
+    lv_timer_set_cb(s_disp->refr_timer, disp_refr_timer_cb);
+}
+
+/**
+ * @brief       лĻ( LVGL е)
+ *   @note      ɿɨ跽ת, ˢ·; ֻȴڽе
+ *              DMA ˢ½, дһ MADCTL, ٰµķֱʽ LVGL,
+ *              Ļյ LV_EVENT_SIZE_CHANGED ػ, 
+ * @param       rot         : 
+ * @retval      
+ */
+void lv_port_disp_set_rotation(lcd_rotation_t rot)
+{
+    if (s_disp == NULL || rot >= LCD_ROT_COUNT || rot == lcd_orient_get())
+    {
+        return;
+    }
+
+    while (s_disp_drv.draw_buf->flushing)
+    {
+    }
+
+    /* лǰ, lcd_orient_set ͬʱѹλ */
+    s_slide_dir = 0;
+    s_scroll_pending = 0;
+    s_scroll_applied = 0;
+    lcd_orient_set(rot);
+    s_disp_drv.hor_res = lcddev.width;
+    s_disp_drv.ver_res = lcddev.height;
+    lv_disp_drv_update(s_disp, &s_disp_drv);
+
+    /* lv_disp_drv_update ֻĻ, /ϵͳϵĳפؼҪֶ */
+    disp_resize_layer(lv_disp_get_layer_top(s_disp));
+    disp_resize_layer(lv_disp_get_layer_sys(s_disp));
+}
+
+/**
+ * @brief       ʼһӲҳ滬(LVGL , ҳ洴֮)
+ *   @note      ҳ水ԭ: 󻬶ʱѻΪ n ʱ, ߼ [0, n)
+ *              ҳ, [n, ) Ǿҳ GRAM е, ƽ n
+ *              ƴɻеĻ档ÿһֻػ¶һ,
+ *              ҳÿֻдһ; ҳ治ٻơ
+ *              ʼʱлҳʧЧ, ڼؼδ¶
+ *              ֵˢ±, ֮¶ʱػ油
+ * @param       dir         : 1 ҳҲ, -1 
+ * @retval      false: ǰ/֧Ӳ, ÷ֱʾҳ
+ */
+bool lv_port_disp_slide_begin(int8_t dir)
+{
+    if (s_disp == NULL || dir == 0 || lcd_orient_hscroll_dir() == 0)
+    {
+        return false;
+    }
+
+    s_slide_dir = (dir > 0) ? 1 : -1;
+    s_slide_px = 0;
+    s_slide_clip.x1 = 0;
+    s_slide_clip.x2 = -1;                           /*  */
+    s_slide_clip.y1 = 0;
+    s_slide_clip.y2 = lv_disp_get_ver_res(s_disp) - 1;
+    _lv_inv_area(s_disp, NULL);
+    return true;
+}
 
-    /* GPUʹɫڴ
-     * ע⣬ lv_conf.h ʹ LVGL ֵ֧ GPUs
-     * вͬ GPUôʹص */
-    //disp_drv.gpu_fill_cb = gpu_fill;
+/**
+ * @brief       ƽ
+ * @param       px          : ҳѻĿ (0 ~ ˮƽֱ, ֻ)
+ * @retval      
+ */
+void lv_port_disp_slide_step(lv_coord_t px)
+{
+    lv_coord_t w;
+    lv_area_t strip;
+
+    if (s_slide_dir == 0)
+    {
+        return;
+    }
+
+    w = lv_disp_get_hor_res(s_disp);
+    if (px > w)
+    {
+        px = w;
+    }
+    if (px <= s_slide_px)
+    {
+        return;
+    }
+
+    strip.y1 = s_slide_clip.y1;
+    strip.y2 = s_slide_clip.y2;
+    if (s_slide_dir > 0)
+    {
+        strip.x1 = s_slide_px;
+        strip.x2 = px - 1;
+        s_slide_clip.x1 = 0;
+        s_slide_clip.x2 = px - 1;
+        s_scroll_pending = (uint16_t)(px % w);
+    }
+    else
+    {
+        strip.x1 = w - px;
+        strip.x2 = w - s_slide_px - 1;
+        s_slide_clip.x1 = w - px;
+        s_slide_clip.x2 = w - 1;
+        s_scroll_pending = (uint16_t)((w - px) % w);
+    }
+    s_slide_px = px;
+    _lv_inv_area(s_disp, &strip);
+}
+
+/**
+ * @brief        (δʱػ沢λ)
+ * @param       
+ * @retval      
+ */
+void lv_port_disp_slide_end(void)
+{
+    if (s_slide_dir == 0)
+    {
+        return;
+    }
 
-    /* עʾ豸 */
-    lv_disp_drv_register(&disp_drv);
+    s_slide_dir = 0;
+    if (s_slide_px < lv_disp_get_hor_res(s_disp))
+    {
+        s_scroll_pending = 0;
+        lv_obj_invalidate(lv_disp_get_scr_act(s_disp));
+        lv_obj_invalidate(lv_disp_get_layer_top(s_disp));
+    }
 }
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * @brief       ͼ (޸,  lv_obj_set_size) Ϊǰֱ
+ * @param       layer   : lv_layer_top() / lv_layer_sys()
+ * @retval      
+ */
+static void disp_resize_layer(lv_obj_t *layer)
+{
+    lv_area_t prev_coords;
+
+    lv_obj_get_coords(layer, &prev_coords);
+    lv_area_set_width(&layer->coords, lv_disp_get_hor_res(s_disp));
+    lv_area_set_height(&layer->coords, lv_disp_get_ver_res(s_disp));
+    lv_event_send(layer, LV_EVENT_SIZE_CHANGED, &prev_coords);
+    lv_obj_tree_walk(layer, disp_layout_dirty_cb, NULL);
+}
+
+/**
+ * @brief       ¼Ĳ (ٷֱ/뷽ʽλӶͼߴ仯)
+ */
+static lv_obj_tree_walk_res_t disp_layout_dirty_cb(lv_obj_t *obj, void *user_data)
+{
+    LV_UNUSED(user_data);
+    lv_obj_mark_layout_as_dirty(obj);
+    return LV_OBJ_TREE_WALK_NEXT;
+}
+
 /**
  * @brief       ʼʾ豸ͱҪΧ豸
  * @param       
@@ -177,9 +466,227 @@ static void disp_init(void)
 {
     /*You code here*/
     lcd_init();                 /* ʼLCD */
-    lcd_display_dir(1);         /* ú */
-    lcd_scan_dir(R2L_D2U);      /* ת180 */
+    lcd_orient_init(LCD_ORIENT_DEFAULT);    /* , 嵹װ(ķ ui_init лָ) */
+
+    /* ļĴд: 5510  16 λַ, ÿһ
+     * (8 + 8),  4  (2 + 8); д GRAM  */
+    s_flush_setup_px = DISP_FLUSH_OVERHEAD_PX + DISP_REG_WRITE_PX * (LCD_ID_IS(0x5510) ? 17 : 11);
+
+#if LCD_USE_DMA_FLUSH
+    lcd_dma_init();             /* ʼˢ DMA */
+#endif
+}
+
+#if LCD_USE_DMA_FLUSH
+/**
+ * @brief       ʼ LCD ˢõ DMA ͨ
+ *   @note      洢洢ģʽ, ""ΪԴַ(Դ滺, ),
+ *              "洢"ΪĿĵַ(LCD->LCD_RAM, ̶), ģʽ뿪 FIFO
+ * @param       
+ * @retval      
+ */
+static void lcd_dma_init(void)
+{
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    hdma_lcd.Instance = LCD_DMA_STREAM;
+    hdma_lcd.Init.Channel = DMA_CHANNEL_0;
+    hdma_lcd.Init.Direction = DMA_MEMORY_TO_MEMORY;
+    hdma_lcd.Init.PeriphInc = DMA_PINC_ENABLE;
+    hdma_lcd.Init.MemInc = DMA_MINC_DISABLE;
+    hdma_lcd.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_lcd.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_lcd.Init.Mode = DMA_NORMAL;
+    hdma_lcd.Init.Priority = DMA_PRIORITY_HIGH;
+    hdma_lcd.Init.FIFOMode = DMA_FIFOMODE_ENABLE;
+    hdma_lcd.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
+    hdma_lcd.Init.MemBurst = DMA_MBURST_SINGLE;
+    hdma_lcd.Init.PeriphBurst = DMA_PBURST_SINGLE;
+    if (HAL_DMA_Init(&hdma_lcd) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
+    HAL_DMA_RegisterCallback(&hdma_lcd, HAL_DMA_XFER_CPLT_CB_ID, lcd_dma_xfer_cplt_cb);
+
+    /* ȼ費 configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY */
+    HAL_NVIC_SetPriority(LCD_DMA_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(LCD_DMA_IRQn);
+}
+
+/**
+ * @brief       һ DMA ( 65535 صֶ)
+ * @param       
+ * @retval      
+ */
+static void lcd_dma_start_next(void)
+{
+    uint32_t len = (s_dma_remain > LCD_DMA_MAX_XFER) ? LCD_DMA_MAX_XFER : s_dma_remain;
+
+    const uint16_t *src = s_dma_src;
+    s_dma_src += len;
+    s_dma_remain -= len;
+
+    HAL_DMA_Start_IT(&hdma_lcd, (uint32_t)src, (uint32_t)&LCD->LCD_RAM, len);
+}
+
+/**
+ * @brief       DMA ɻص(ж)
+ *   @note      ʣʱһ, ֪ͨ LVGL ˢ
+ * @param       hdma        : DMA 
+ * @retval      
+ */
+static void lcd_dma_xfer_cplt_cb(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+
+    if (s_dma_remain > 0)
+    {
+        lcd_dma_start_next();
+        return;
+    }
+#if LV_DISP_FB_EXSRAM
+    if (lcd_fb_start_next())
+    {
+        return;
+    }
+#endif
+
+    if (s_flush_drv != NULL)
+    {
+        lv_disp_drv_t *drv = s_flush_drv;
+        s_flush_drv = NULL;
+        PROF_RECORD(PROF_ZONE_DISP_FLUSH, s_flush_start);
+        FrameStats_FlushDone(prof_now() - s_flush_start);
+        if (drv->draw_buf->flushing_last)
+        {
+            SensorLatency_FrameFlushed();
+        }
+        lv_disp_flush_ready(drv);
+    }
+}
+
+/**
+ * @brief       ʹ DMA ɫд LCD ָ
+ *   @note      , ɺ DMA же lv_disp_flush_ready()
+ * @param       disp_drv    : ʾ豸
+ * @param       (sx,sy),(ex,ey):ζԽ
+ * @param       color       : ɫ
+ * @retval      
+ */
+static void lcd_draw_dma_rgb_color(lv_disp_drv_t *disp_drv, int16_t sx, int16_t sy, int16_t ex, int16_t ey, const uint16_t *color)
+{
+    uint16_t w = ex - sx + 1;
+    uint16_t h = ey - sy + 1;
+
+    lcd_set_window(sx, sy, w, h);
+    lcd_write_ram_prepare();
+
+    s_flush_drv = disp_drv;
+    s_dma_src = color;
+    s_dma_remain = (uint32_t)w * h;
+
+    lcd_dma_start_next();
 }
+#endif
+
+#if LV_DISP_FB_EXSRAM
+/**
+ * @brief       ȫ֡ģʽˢ
+ *   @note      direct_mode  LVGL ÿһʧЧһ, 
+ *              Ѿ֡, ֻһβ: ռ֡
+ *              δϲʧЧ (ڼüѻ벿),  DMA
+ *              п֡, һδ; д
+ * @param       disp_drv    : ʾ豸
+ * @param       fb          : ֡
+ * @retval      
+ */
+static void disp_flush_fb(lv_disp_drv_t * disp_drv, const lv_color_t * fb)
+{
+    lv_area_t area;
+    uint16_t i;
+
+    if (!lv_disp_flush_is_last(disp_drv))
+    {
+        lv_disp_flush_ready(disp_drv);
+        return;
+    }
+
+    s_flush_start = prof_now();
+    s_fb_rect_cnt = 0;
+    for (i = 0; i < s_disp->inv_p; i++)
+    {
+        if (s_disp->inv_area_joined[i])
+        {
+            continue;
+        }
+        lv_area_copy(&area, &s_disp->inv_areas[i]);
+        if (s_slide_dir != 0 && !_lv_area_intersect(&area, &area, &s_slide_clip))
+        {
+            continue;
+        }
+        lv_area_copy(&s_fb_rects[s_fb_rect_cnt++], &area);
+    }
+
+    s_fb = (const uint16_t *)fb;
+    s_fb_stride = disp_drv->hor_res;
+    s_fb_rect_idx = 0;
+    s_fb_row = (s_fb_rect_cnt > 0) ? s_fb_rects[0].y1 : 0;
+    s_flush_drv = disp_drv;
+    if (!lcd_fb_start_next())
+    {
+        s_flush_drv = NULL;
+        lv_disp_flush_ready(disp_drv);
+    }
+}
+
+/**
+ * @brief       ֡һεĴ(ˢ» DMA же)
+ * @param       
+ * @retval      false: ֡ȫ
+ */
+static bool lcd_fb_start_next(void)
+{
+    const lv_area_t *area;
+    lv_coord_t w;
+
+    while (s_fb_rect_idx < s_fb_rect_cnt)
+    {
+        area = &s_fb_rects[s_fb_rect_idx];
+        if (s_fb_row > area->y2)
+        {
+            s_fb_rect_idx++;
+            if (s_fb_rect_idx < s_fb_rect_cnt)
+            {
+                s_fb_row = s_fb_rects[s_fb_rect_idx].y1;
+            }
+            continue;
+        }
+
+        w = lv_area_get_width(area);
+        if (s_fb_row == area->y1)
+        {
+            lcd_set_window(area->x1, area->y1, w, lv_area_get_height(area));
+            lcd_write_ram_prepare();
+        }
+
+        s_dma_src = s_fb + (int32_t)s_fb_row * s_fb_stride + area->x1;
+        if (w == s_fb_stride)
+        {
+            s_dma_remain = (uint32_t)w * (area->y2 - s_fb_row + 1);
+            s_fb_row = area->y2 + 1;
+        }
+        else
+        {
+            s_dma_remain = (uint32_t)w;
+            s_fb_row++;
+        }
+        lcd_dma_start_next();
+        return true;
+    }
+    return false;
+}
+#endif
 
 /**
  * @brief       ڲˢµʾϵض
@@ -192,7 +699,7 @@ static void disp_init(void)
  *
  * @retval      
  */
-static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
+RAM_FUNC static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_color_t * color_p)
 {
     /* LVGL ٷһˢĻӣЧЧ */
 
@@ -208,43 +715,242 @@ static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_colo
 
 //    /* ָָɫ */
 //    lcd_color_fill(area->x1, area->y1, area->x2, area->y2, (uint16_t *)color_p);
+#if LV_DISP_FB_EXSRAM
+    if (s_fb_mode)
+    {
+        disp_flush_fb(disp_drv, color_p);
+        return;
+    }
+#endif
+    s_flush_start = prof_now();
+    if (s_slide_dir != 0 && disp_flush_slide_clip(disp_drv, area, color_p))
+    {
+        return;
+    }
+#if LCD_USE_DMA_FLUSH
+    /* DMA ̨, lv_disp_flush_ready() ڴже */
+    lcd_draw_dma_rgb_color(disp_drv, area->x1, area->y1, area->x2, area->y2, (const uint16_t *)color_p);
+#else
     lcd_draw_fast_rgb_color(area->x1,area->y1,area->x2,area->y2,(uint16_t*)color_p);
+    PROF_RECORD(PROF_ZONE_DISP_FLUSH, s_flush_start);
+    FrameStats_FlushDone(prof_now() - s_flush_start);
 
     /* Ҫ!!!
      * ֪ͨͼο⣬Ѿˢ */
     lv_disp_flush_ready(disp_drv);
+#endif
+}
+
+/**
+ * @brief       ڼ䰴ѻüˢ
+ *   @note      ֻԽѻ벿ֵı߽ʱд뽻, ȫڵ
+ *              ·
+ * @param       disp_drv    : ʾ豸
+ * @param       area        : Ҫˢµ
+ * @param       color_p     : ɫ
+ * @retval      true: Ѵ (嶪), false: ·ˢ
+ */
+static bool disp_flush_slide_clip(lv_disp_drv_t * disp_drv, const lv_area_t * area, const lv_color_t * color_p)
+{
+    lv_area_t clip;
+    lv_coord_t stride;
+    lv_coord_t w;
+    lv_coord_t y;
+    const uint16_t *src;
+
+    if (_lv_area_is_in(area, &s_slide_clip, 0))
+    {
+        return false;
+    }
+
+    if (_lv_area_intersect(&clip, area, &s_slide_clip))
+    {
+        stride = lv_area_get_width(area);
+        w = lv_area_get_width(&clip);
+        src = (const uint16_t *)color_p + (int32_t)(clip.y1 - area->y1) * stride + (clip.x1 - area->x1);
+
+        lcd_set_window(clip.x1, clip.y1, w, lv_area_get_height(&clip));
+        lcd_write_ram_prepare();
+        for (y = clip.y1; y <= clip.y2; y++)
+        {
+            lcd_stream_pixels(src, (uint32_t)w);
+            src += stride;
+        }
+        PROF_RECORD(PROF_ZONE_DISP_FLUSH, s_flush_start);
+        FrameStats_FlushDone(prof_now() - s_flush_start);
+    }
+
+    lv_disp_flush_ready(disp_drv);
+    return true;
 }
 
-/* ѡ: GPU ӿ */
+/**
+ * @brief       ˢɺд뻬ƽ, ʹ¶һƽͬʱЧ
+ * @param       
+ * @retval      
+ */
+static void disp_scroll_apply(void)
+{
+    if (s_scroll_pending == s_scroll_applied)
+    {
+        return;
+    }
+
+    while (s_disp_drv.draw_buf->flushing)
+    {
+    }
+    lcd_orient_hscroll_set(s_scroll_pending);
+    s_scroll_applied = s_scroll_pending;
+}
 
-/*  MCU Ӳ (GPU) ôʹΪڴɫ */
 /**
- * @brief       ʹ GPU ɫ
- *   @note       MCU Ӳ (GPU),ôΪڴɫ
- *
+ * @brief       ʧЧ
  * @param       disp_drv    : ʾ豸
- *   @arg       dest_buf    : Ŀ껺
- *   @arg       dest_width  : Ŀ껺Ŀ
- *   @arg       fill_area   : 
- *   @arg       color       : ɫ
- *
+ * @param       area        : ʧЧ(ѲüĻ), ԭ޸
  * @retval      
  */
-//static void gpu_fill(lv_disp_drv_t * disp_drv, lv_color_t * dest_buf, lv_coord_t dest_width,
-//                    const lv_area_t * fill_area, lv_color_t color)
-//{
-//    /*It's an example code which should be done by your GPU*/
-//    int32_t x, y;
-//    dest_buf += dest_width * fill_area->y1; /*Go to the first line*/
+static void disp_rounder(lv_disp_drv_t * disp_drv, lv_area_t * area)
+{
+    area->x1 &= ~1;
+    area->x2 |= 1;
+    if (area->x2 >= disp_drv->hor_res)
+    {
+        area->x2 = disp_drv->hor_res - 1;
+    }
+}
 
-//    for(y = fill_area->y1; y <= fill_area->y2; y++) {
-//        for(x = fill_area->x1; x <= fill_area->x2; x++) {
-//            dest_buf[x] = color;
-//        }
-//        dest_buf+=dest_width;    /*Go to the next line*/
-//    }
-//}
+/**
+ * @brief       ˢһĴ
+ *   @note      LVGL СгֱȾˢ, Խ
+ *              ÿεԽ, ̶
+ * @param       area        : 
+ * @retval      (д)
+ */
+static uint32_t disp_area_cost(const lv_area_t * area)
+{
+    uint32_t w = lv_area_get_width(area);
+    uint32_t h = lv_area_get_height(area);
+    uint32_t rows = s_disp_drv.draw_buf->size / w;  /* ȫ֡ʱ */
+    uint32_t parts = (h + rows - 1) / rows;
 
+    return parts * s_flush_setup_px + w * h;
+}
+
+/**
+ * @brief       ģͺϲʧЧ
+ *   @note      LVGL ֻϲཻҺϲС; ϲཻ
+ *              , ֻҪϲƵʡµĹ̶ͬһſƬ
+ *              ļСǩһνϳд롣Ѻϲ inv_area_joined
+ *              б, LVGL ĺϲˢ
+ * @param       disp        : ʾ豸
+ * @retval      
+ */
+static void disp_join_areas(lv_disp_t * disp)
+{
+    uint16_t join_in;
+    uint16_t join_from;
+    lv_area_t joined;
+    uint32_t cost_in;
+    bool merged;
+
+    do
+    {
+        merged = false;
+        for (join_in = 0; join_in < disp->inv_p; join_in++)
+        {
+            if (disp->inv_area_joined[join_in])
+            {
+                continue;
+            }
+            cost_in = disp_area_cost(&disp->inv_areas[join_in]);
+
+            for (join_from = join_in + 1; join_from < disp->inv_p; join_from++)
+            {
+                if (disp->inv_area_joined[join_from])
+                {
+                    continue;
+                }
+
+                _lv_area_join(&joined, &disp->inv_areas[join_in], &disp->inv_areas[join_from]);
+                if (disp_area_cost(&joined) <= cost_in + disp_area_cost(&disp->inv_areas[join_from]))
+                {
+                    lv_area_copy(&disp->inv_areas[join_in], &joined);
+                    disp->inv_area_joined[join_from] = 1;
+                    cost_in = disp_area_cost(&joined);
+                    merged = true;  /* ǰѱȽϹֵúϲ */
+                }
+            }
+        }
+    } while (merged);
+}
+
+/**
+ * @brief       ˢ¶ʱصװ: ¼ÿˢµֹʱ̼ϲǰʧЧ
+ * @param       timer       : LVGL ˢ¶ʱ
+ * @retval      
+ */
+static void disp_refr_timer_cb(lv_timer_t * timer)
+{
+    lv_disp_t * disp = (lv_disp_t *)timer->user_data;
+    uint32_t inv_px = 0;
+    uint16_t i;
+
+    FrameStats_RefreshBegin();
+
+    /* ɲ(ʧЧҲϲ), ֮ LVGL еͬһֱӷ */
+    lv_obj_update_layout(disp->act_scr);
+    lv_obj_update_layout(disp->top_layer);
+    lv_obj_update_layout(disp->sys_layer);
+
+    for (i = 0; i < disp->inv_p; i++)
+    {
+        inv_px += lv_area_get_size(&disp->inv_areas[i]);
+    }
+    FrameStats_RefreshAreas((uint8_t)disp->inv_p, inv_px);
+    disp_join_areas(disp);
+    _lv_disp_refr_timer(timer);
+    disp_scroll_apply();
+    FrameStats_RefreshEnd();
+}
+
+/**
+ * @brief       ˢɻص(ȷػʱ)
+ * @param       disp_drv    : ʾ豸
+ * @param       time        : ˢºʱ(ms, Ȳ, δʹ)
+ * @param       px          : ػ
+ * @retval      
+ */
+static void disp_monitor_cb(lv_disp_drv_t * disp_drv, uint32_t time, uint32_t px)
+{
+    (void)time;
+    FrameStats_RefreshPixels(px);
+
+    /* һ DMA ʱжϼ¼ӳ, Ѵ (ͬˢ) ڴ˼¼ */
+    SensorLatency_FrameRendered();
+    ui_coalesce_frame_done();               /* ϲ¼ڱִ֮֡ */
+    if (!disp_drv->draw_buf->flushing)
+    {
+        SensorLatency_FrameFlushed();
+    }
+}
+
+/**
+ * @brief       ȴˢɻص
+ *   @note      LVGL  flushing λڼѭñ, ֱӵȵ DMA ,
+ *              Աһβĵȴʱ
+ * @param       disp_drv    : ʾ豸
+ * @retval      
+ */
+static void disp_wait_cb(lv_disp_drv_t * disp_drv)
+{
+    uint32_t start = prof_now();
+
+    while (disp_drv->draw_buf->flushing)
+    {
+    }
+
+    FrameStats_AddWait(prof_now() - start);
+}
 
 #else /*Enable this file at the top*/
 
@@ -17,6 +17,7 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lvgl.h"
+#include "lcd_orient.h"
 
 /*********************
  *      DEFINES
@@ -31,6 +32,14 @@ extern "C" {
  **********************/
 void lv_port_disp_init(void);
 
+/* 切换屏幕方向并更新 LVGL 分辨率(LVGL 任务中调用) */
+void lv_port_disp_set_rotation(lcd_rotation_t rot);
+
+/* 硬件滚动页面滑动: 新页面创建后 begin, 逐步 step(已滑入宽度), 最后 end */
+bool lv_port_disp_slide_begin(int8_t dir);
+void lv_port_disp_slide_step(lv_coord_t px);
+void lv_port_disp_slide_end(void);
+
 /**********************
  *      MACROS
  **********************/
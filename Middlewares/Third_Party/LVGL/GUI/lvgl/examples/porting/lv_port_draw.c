@@ -0,0 +1,353 @@
+/**
+ * @file lv_port_draw.c
+ *
+ * ͼٲ: 滻 LVGL ȾеĻ(blend),
+ * ɫͲ͸ͼ񿽱Ӳ,  CPU 
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_port_draw.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "main.h"
+#include "mem_section.h"
+
+#if LV_PORT_DRAW_ACCEL == LV_PORT_DRAW_ACCEL_DMA2D
+#include "src/draw/stm32_dma2d/lv_gpu_stm32_dma2d.h"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_PORT_DRAW_ACCEL == LV_PORT_DRAW_ACCEL_DMA
+
+#if LV_COLOR_DEPTH != 16
+#error "DMA ͼٽ֧ LV_COLOR_DEPTH 16"
+#endif
+
+#define DRAW_DMA_STREAM         DMA2_Stream2        /* Stream0: ADC1, Stream1: LCD ˢ, Stream7: USART1_TX */
+#define DRAW_DMA_IRQn           DMA2_Stream2_IRQn
+#define DRAW_DMA_MAX_XFER       (0xFFFF)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/* һ DMA ͼ(вִ) */
+typedef struct {
+    volatile bool busy;         /*  */
+    uint16_t * dest;            /* ǰĿĵַ */
+    const uint16_t * src;       /* ǰԴַ, NULL ʾɫ */
+    lv_coord_t dest_stride;     /* ĿĻп() */
+    lv_coord_t src_stride;      /* Դͼп() */
+    uint32_t row_len;           /* ÿ */
+    uint32_t rows_left;         /* ʣ */
+} draw_dma_job_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void draw_dma_init(void);
+static void draw_dma_start_row(void);
+static void draw_dma_xfer_cplt_cb(DMA_HandleTypeDef * hdma);
+static void draw_dma_submit(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src, lv_coord_t src_stride,
+                            lv_coord_t w, lv_coord_t h);
+static void lv_port_draw_dma_ctx_init(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+static void lv_port_draw_dma_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+static void lv_port_draw_dma_wait_for_finish(lv_draw_ctx_t * draw_ctx);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+DMA_HandleTypeDef hdma_draw;                        /* ͼ DMA , жϷ stm32f4xx_it.c */
+
+static draw_dma_job_t s_job;
+static uint16_t s_fill_color;                       /* ɫʱĹ̶Դ */
+
+#endif /* LV_PORT_DRAW_ACCEL == LV_PORT_DRAW_ACCEL_DMA */
+
+/* Ⱦλ: ͼĵľλ (ٺ޹) */
+typedef void (*draw_ctx_init_cb_t)(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+typedef void (*draw_rect_cb_t)(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+
+static void lv_port_draw_ctx_init(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+static void lv_port_draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+
+static draw_ctx_init_cb_t s_base_ctx_init;          /* ٺ˵ĳʼ */
+static draw_rect_cb_t s_base_draw_rect;             /* ٺ˵ľλ */
+static bool s_flat;                                 /* ȾλѴ */
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+/**
+ * @brief       Ϊʾҽӻͼٺ,  lv_disp_drv_register() ֮ǰ
+ * @param       disp_drv    : ʾ豸
+ * @retval      
+ */
+void lv_port_draw_init(lv_disp_drv_t * disp_drv)
+{
+#if LV_PORT_DRAW_ACCEL == LV_PORT_DRAW_ACCEL_DMA2D
+    /* lv_disp_drv_init() ĬϹҽ DMA2D ͼ, ֻ */
+    LV_UNUSED(disp_drv);
+    lv_draw_stm32_dma2d_init();
+#elif LV_PORT_DRAW_ACCEL == LV_PORT_DRAW_ACCEL_DMA
+    draw_dma_init();
+    disp_drv->draw_ctx_init = lv_port_draw_dma_ctx_init;
+    disp_drv->draw_ctx_deinit = lv_draw_sw_deinit_ctx;
+    disp_drv->draw_ctx_size = sizeof(lv_draw_sw_ctx_t);
+#else
+    LV_UNUSED(disp_drv);
+#endif
+
+    s_base_ctx_init = disp_drv->draw_ctx_init;
+    disp_drv->draw_ctx_init = lv_port_draw_ctx_init;
+}
+
+/**
+ * @brief       /رռȾ: ȥԲǡӰ뽥, ͸ȡΪ͸͸
+ *   @note      ֲ; ÷ʹĻʧЧػ
+ * @param       flat    : true , false Ч
+ * @retval      
+ */
+void lv_port_draw_set_flat(bool flat)
+{
+    s_flat = flat;
+}
+
+/**
+ * @brief       ȾǷ
+ * @param       
+ * @retval      true Ѵ
+ */
+bool lv_port_draw_get_flat(void)
+{
+    return s_flat;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+/**
+ * @brief       ʼͼ: ɼٺ˳ʼ, ٰλ
+ */
+static void lv_port_draw_ctx_init(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
+{
+    s_base_ctx_init(drv, draw_ctx);
+    s_base_draw_rect = draw_ctx->draw_rect;
+    draw_ctx->draw_rect = lv_port_draw_rect;
+}
+
+/**
+ * @brief       ͸ȡ: һΪ͸, Ϊ͸, ʡȥػ
+ */
+static lv_opa_t draw_flat_opa(lv_opa_t opa)
+{
+    return opa >= LV_OPA_50 ? LV_OPA_COVER : LV_OPA_TRANSP;
+}
+
+/**
+ * @brief       λ: 򻯵λȥԲ֡Ӱͽ
+ *   @note      ԲΪ 0 ʱͱ߿,  DMA ɫ;
+ *              ӰȾĲ, ֱ
+ */
+static void lv_port_draw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    lv_draw_rect_dsc_t flat;
+
+    if(!s_flat) {
+        s_base_draw_rect(draw_ctx, dsc, coords);
+        return;
+    }
+
+    flat = *dsc;
+    flat.radius = 0;
+    if(flat.bg_grad.dir != LV_GRAD_DIR_NONE) {
+        flat.bg_color = flat.bg_grad.stops[0].color;
+        flat.bg_grad.dir = LV_GRAD_DIR_NONE;
+    }
+    flat.bg_opa = draw_flat_opa(dsc->bg_opa);
+    flat.bg_img_opa = draw_flat_opa(dsc->bg_img_opa);
+    flat.border_opa = draw_flat_opa(dsc->border_opa);
+    flat.outline_opa = draw_flat_opa(dsc->outline_opa);
+    flat.shadow_opa = LV_OPA_TRANSP;
+    s_base_draw_rect(draw_ctx, &flat, coords);
+}
+
+#if LV_PORT_DRAW_ACCEL == LV_PORT_DRAW_ACCEL_DMA
+
+/**
+ * @brief       ʼͼ DMA ͨ(洢洢, )
+ * @param       
+ * @retval      
+ */
+static void draw_dma_init(void)
+{
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    hdma_draw.Instance = DRAW_DMA_STREAM;
+    hdma_draw.Init.Channel = DMA_CHANNEL_0;
+    hdma_draw.Init.Direction = DMA_MEMORY_TO_MEMORY;
+    hdma_draw.Init.PeriphInc = DMA_PINC_ENABLE;
+    hdma_draw.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_draw.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_draw.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_draw.Init.Mode = DMA_NORMAL;
+    hdma_draw.Init.Priority = DMA_PRIORITY_MEDIUM;
+    hdma_draw.Init.FIFOMode = DMA_FIFOMODE_ENABLE;
+    hdma_draw.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
+    hdma_draw.Init.MemBurst = DMA_MBURST_SINGLE;
+    hdma_draw.Init.PeriphBurst = DMA_PBURST_SINGLE;
+    if (HAL_DMA_Init(&hdma_draw) != HAL_OK)
+    {
+        Error_Handler();
+    }
+
+    HAL_DMA_RegisterCallback(&hdma_draw, HAL_DMA_XFER_CPLT_CB_ID, draw_dma_xfer_cplt_cb);
+
+    HAL_NVIC_SetPriority(DRAW_DMA_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DRAW_DMA_IRQn);
+}
+
+/**
+ * @brief       ǰе DMA 
+ *   @note      ɫʱرԴַ, ʱ; ͨʱ޸ PINC
+ * @param       
+ * @retval      
+ */
+static void draw_dma_start_row(void)
+{
+    if (s_job.src == NULL)
+    {
+        CLEAR_BIT(hdma_draw.Instance->CR, DMA_SxCR_PINC);
+        HAL_DMA_Start_IT(&hdma_draw, (uint32_t)&s_fill_color, (uint32_t)s_job.dest, s_job.row_len);
+    }
+    else
+    {
+        SET_BIT(hdma_draw.Instance->CR, DMA_SxCR_PINC);
+        HAL_DMA_Start_IT(&hdma_draw, (uint32_t)s_job.src, (uint32_t)s_job.dest, s_job.row_len);
+    }
+}
+
+/**
+ * @brief       DMA ɻص(ж), һл
+ * @param       hdma        : DMA 
+ * @retval      
+ */
+static void draw_dma_xfer_cplt_cb(DMA_HandleTypeDef * hdma)
+{
+    LV_UNUSED(hdma);
+
+    if (--s_job.rows_left == 0)
+    {
+        s_job.busy = false;
+        return;
+    }
+
+    s_job.dest += s_job.dest_stride;
+    if (s_job.src != NULL)
+    {
+        s_job.src += s_job.src_stride;
+    }
+    draw_dma_start_row();
+}
+
+/**
+ * @brief       ύһξ/
+ *   @note      ĿԴʱϲΪһδ, д
+ * @param       dest        : ĿϽ
+ * @param       dest_stride : ĿĻп
+ * @param       src         : ԴϽ, NULL ʾ s_fill_color 
+ * @param       src_stride  : Դͼп
+ * @param       w, h        : 
+ * @retval      
+ */
+static void draw_dma_submit(uint16_t * dest, lv_coord_t dest_stride, const uint16_t * src, lv_coord_t src_stride,
+                            lv_coord_t w, lv_coord_t h)
+{
+    uint32_t total = (uint32_t)w * h;
+    bool contiguous = (dest_stride == w) && (src == NULL || src_stride == w);
+
+    s_job.dest = dest;
+    s_job.src = src;
+    s_job.dest_stride = dest_stride;
+    s_job.src_stride = src_stride;
+
+    if (contiguous && total <= DRAW_DMA_MAX_XFER)
+    {
+        s_job.row_len = total;
+        s_job.rows_left = 1;
+    }
+    else
+    {
+        s_job.row_len = w;
+        s_job.rows_left = h;
+    }
+
+    s_job.busy = true;
+    draw_dma_start_row();
+}
+
+/**
+ * @brief       ʼͼ: ȾΪ, 滻ȴ
+ */
+static void lv_port_draw_dma_ctx_init(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+
+    lv_draw_sw_ctx_t * sw_ctx = (lv_draw_sw_ctx_t *)draw_ctx;
+    sw_ctx->blend = lv_port_draw_dma_blend;
+    sw_ctx->base_draw.wait_for_finish = lv_port_draw_dma_wait_for_finish;
+}
+
+/**
+ * @brief       Ϻ: ɰ桢͸ͨģʽĴ򽻸 DMA
+ *   @note      DMA ںִ̨, LVGL һλϻˢǰ wait_for_finish
+ *              lv_mem ڴ CCM RAM, Դͼ lv_mem (뻺) ʱ DMA ʲ, 
+ *               set_px_cb Ŀ (lv_snapshot Ĵ͸Ȼ)  RGB565 , ͬ
+ */
+static void lv_port_draw_dma_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_area_t blend_area;
+    if(!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver->set_px_cb == NULL &&
+       dsc->mask_buf == NULL && dsc->blend_mode == LV_BLEND_MODE_NORMAL && dsc->opa >= LV_OPA_MAX &&
+       lv_area_get_size(&blend_area) >= LV_PORT_DRAW_DMA_MIN_PX &&
+       (dsc->src_buf == NULL || MEM_IS_DMA_REACHABLE(dsc->src_buf))) {
+        lv_coord_t w = lv_area_get_width(&blend_area);
+        lv_coord_t h = lv_area_get_height(&blend_area);
+        lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+
+        lv_color_t * dest_buf = draw_ctx->buf;
+        dest_buf += dest_stride * (blend_area.y1 - draw_ctx->buf_area->y1) + (blend_area.x1 - draw_ctx->buf_area->x1);
+
+        if(dsc->src_buf) {
+            /* ͸ͼ񿽱 */
+            lv_coord_t src_stride = lv_area_get_width(dsc->blend_area);
+            const lv_color_t * src_buf = dsc->src_buf;
+            src_buf += src_stride * (blend_area.y1 - dsc->blend_area->y1) + (blend_area.x1 - dsc->blend_area->x1);
+            draw_dma_submit((uint16_t *)dest_buf, dest_stride, (const uint16_t *)src_buf, src_stride, w, h);
+        }
+        else {
+            /* ɫ */
+            s_fill_color = dsc->color.full;
+            draw_dma_submit((uint16_t *)dest_buf, dest_stride, NULL, 0, w, h);
+        }
+        return;
+    }
+
+    lv_draw_sw_blend_basic(draw_ctx, dsc);
+}
+
+/**
+ * @brief       ȴ DMA ͼ
+ */
+static void lv_port_draw_dma_wait_for_finish(lv_draw_ctx_t * draw_ctx)
+{
+    while(s_job.busy);
+    lv_draw_sw_wait_for_finish(draw_ctx);
+}
+
+#endif /* LV_PORT_DRAW_ACCEL == LV_PORT_DRAW_ACCEL_DMA */
@@ -0,0 +1,75 @@
+/**
+ * @file lv_port_draw.h
+ *
+ */
+
+#ifndef LV_PORT_DRAW_H
+#define LV_PORT_DRAW_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/* ͼٺ */
+#define LV_PORT_DRAW_ACCEL_NONE     0   /* Ⱦ */
+#define LV_PORT_DRAW_ACCEL_DMA      1   /* DMA2 洢洢: ɫ䡢͸ͼ񿽱(F405/F407) */
+#define LV_PORT_DRAW_ACCEL_DMA2D    2   /* Chrom-ART DMA2D(F429/F469/F7), ʹ LVGL Դʵ */
+
+/* оƬԶѡ, Ҳǿָ */
+#ifndef LV_PORT_DRAW_ACCEL
+#if LV_USE_GPU_STM32_DMA2D
+#define LV_PORT_DRAW_ACCEL          LV_PORT_DRAW_ACCEL_DMA2D
+#else
+#define LV_PORT_DRAW_ACCEL          LV_PORT_DRAW_ACCEL_DMA
+#endif
+#endif
+
+/* Сڸ򽻸 CPU ,  DMA Ŀòʧ */
+#define LV_PORT_DRAW_DMA_MIN_PX     256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+/**
+ * @brief       Ϊʾҽӻͼٺ,  lv_disp_drv_register() ֮ǰ
+ * @param       disp_drv    : ʾ豸
+ * @retval      
+ */
+void lv_port_draw_init(lv_disp_drv_t * disp_drv);
+
+/**
+ * @brief       /رռȾ: ȥԲǡӰ뽥, ͸ȡΪ͸͸
+ *   @note      ֲ; ÷ʹĻʧЧػ
+ * @param       flat    : true , false Ч
+ * @retval      
+ */
+void lv_port_draw_set_flat(bool flat);
+
+/**
+ * @brief       ȾǷ
+ * @param       
+ * @retval      true Ѵ
+ */
+bool lv_port_draw_get_flat(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PORT_DRAW_H*/
@@ -14,17 +14,43 @@
 
 /* ͷļ */
 #include "touch.h"
-#include "lcd.h"
+#include "touch_service.h"
+#include "touch_gesture.h"
+#include "lcd_orient.h"
+#include "profiler.h"
+#include "ui_manager.h"
 #include <stdio.h>
 
 /*********************
  *      DEFINES
  *********************/
-extern uint8_t g_lcd_scan_dir;    // 豸ṹ
+/* ɿ TOUCH_IDLE_DELAY_MS Ѵѯ TOUCH_IDLE_READ_PERIOD_MS,
+ * ; ȡصֻ, ѯ޿ */
+#define TOUCH_IDLE_DELAY_MS         200
+#define TOUCH_IDLE_READ_PERIOD_MS   100
+
+/* ˲: 3 ֵȥ -> Ӧһ IIR ƽ -> ƾֹ,
+ * ȫΪ; ʶʹδ˲ԭʼ, Ӱ */
+#define TOUCH_FILTER_ENABLE         1
+#define TOUCH_FILTER_IIR_SHIFT      2   /* ƶʱƽϵ 1/2^N */
+#define TOUCH_FILTER_FAST_PX        12  /* ƽֵֵΪƶ, IIR ֱͨӰ */
+#define TOUCH_FILTER_DEADBAND_PX    3   /* 仯Сڸֵʱֲ */
 /**********************
  *      TYPEDEFS
  **********************/
 
+/* ˲״̬ */
+typedef struct
+{
+    lv_coord_t hist_x[3];   /*  3 ԭʼ(ֵ˲) */
+    lv_coord_t hist_y[3];
+    uint8_t hist_idx;
+    int32_t iir_x;          /* IIR , Q4  */
+    int32_t iir_y;
+    lv_coord_t out_x;       /* ϱ LVGL  */
+    lv_coord_t out_y;
+} touch_filter_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -34,12 +60,27 @@ static void touchpad_init(void);
 static void touchpad_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data);
 static bool touchpad_is_pressed(void);
 static void touchpad_get_xy(lv_coord_t * x, lv_coord_t * y);
+static void touchpad_sample_notify(void);
+static void touchpad_map_point(lv_coord_t * x, lv_coord_t * y);
+static void touchpad_map_gesture(TouchGesture_t * gesture);
+static void touchpad_update_gesture(void);
+#if TOUCH_FILTER_ENABLE
+static void touchpad_filter(lv_coord_t * x, lv_coord_t * y, bool first, bool fresh);
+#endif
 
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 lv_indev_t * indev_touchpad;    // 
+static uint32_t s_last_touch_tick = 0;  // һΰµʱ(lv_tick)
+static bool s_touch_irq_ready = false;  // ж, ѯƵ
+static bool s_touch_service_ready = false;  // , ȡصֻ
+static TouchSample_t s_touch_sample;    // ζȡصʹõ
+static TouchGestureEngine_t s_gesture;  // ʶ(ʹȫ)
+#if TOUCH_FILTER_ENABLE
+static touch_filter_t s_filter;         // ˲
+#endif
 
 /**********************
  *      MACROS
@@ -85,6 +126,40 @@ void lv_port_indev_init(void)
     indev_touchpad = lv_indev_drv_register(&indev_drv);
 
 }
+
+/**
+ * @brief       жϴ(ж),  HAL_GPIO_EXTI_Callback е
+ * @param       
+ * @retval      
+ */
+void lv_port_indev_touch_irq(void)
+{
+    if (s_touch_service_ready)
+    {
+        TouchService_IrqHandler();          /* ɴȡٻ LVGL */
+    }
+    else
+    {
+        ui_wake_from_isr(UI_WAKE_TOUCH);    /* ޴ʱ˻ LVGL ɨ */
+    }
+}
+
+/**
+ * @brief       ָѯ(LVGL е), ȡһ
+ * @param       
+ * @retval      
+ */
+void lv_port_indev_resume(void)
+{
+    if (indev_touchpad == NULL || indev_touchpad->driver->read_timer == NULL)
+    {
+        return;
+    }
+
+    s_last_touch_tick = lv_tick_get();
+    lv_timer_set_period(indev_touchpad->driver->read_timer, LV_INDEV_DEF_READ_PERIOD);
+    lv_timer_ready(indev_touchpad->driver->read_timer);
+}
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -102,6 +177,24 @@ static void touchpad_init(void)
 {
     /*Your code comes here*/
     tp_dev.init();
+
+    /* INT/T_PEN (PB1)ʼΪ˫ж, ڿʱ LVGL ;
+     * ƽԿͨ HAL_GPIO_ReadPin ȡ, Ӱԭɨ߼ */
+    GPIO_InitTypeDef gpio_init_struct = {0};
+    gpio_init_struct.Pin = T_PEN_GPIO_PIN;
+    gpio_init_struct.Mode = GPIO_MODE_IT_RISING_FALLING;
+    gpio_init_struct.Pull = GPIO_PULLUP;
+    gpio_init_struct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(T_PEN_GPIO_PORT, &gpio_init_struct);
+    __HAL_GPIO_EXTI_CLEAR_IT(T_PEN_GPIO_PIN);
+    HAL_NVIC_SetPriority(EXTI1_IRQn, 5, 0);  /* 費 configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY */
+    HAL_NVIC_EnableIRQ(EXTI1_IRQn);
+    s_touch_irq_ready = true;
+
+    /* ɴ INT ¼ʱȡ; ʧԭеѯɨ */
+    TouchService_RegisterNotify(touchpad_sample_notify);
+    s_touch_service_ready = TouchService_Init();
+    TouchGesture_Init(&s_gesture);
     
     // /*  */
     // if (key_scan(0) == KEY0_PRES)           /* KEY0,ִУ׼ */
@@ -122,30 +215,42 @@ static void touchpad_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
 {
     static lv_coord_t last_x = 0;
     static lv_coord_t last_y = 0;
+    static bool was_pressed = false;
+    static uint32_t last_seq = 0;
 
     /* 水µ״̬ */
     if(touchpad_is_pressed())
     {
-        lv_coord_t raw_x, raw_y;
-        touchpad_get_xy(&raw_x, &raw_y);
-        
-        // תĻĬΪL2R_U2DҪ
-        if (g_lcd_scan_dir == R2L_D2U) 
-        {
-            last_x = lcddev.width - 1 - raw_x;
-            last_y = lcddev.height - 1 - raw_y;
-        } 
-        else 
-        {
-            last_x = raw_x;
-            last_y = raw_y;
-        }
+        touchpad_get_xy(&last_x, &last_y);
+        touchpad_map_point(&last_x, &last_y);
+#if TOUCH_FILTER_ENABLE
+        /* ģʽδʱֻظϱ, ٴֵ */
+        touchpad_filter(&last_x, &last_y, !was_pressed,
+                        !s_touch_service_ready || s_touch_sample.seq != last_seq);
+#endif
+        last_seq = s_touch_sample.seq;
+        was_pressed = true;
 
         data->state = LV_INDEV_STATE_PR;
+        s_last_touch_tick = lv_tick_get();
+        lv_timer_set_period(indev_drv->read_timer, LV_INDEV_DEF_READ_PERIOD);
     } 
     else
     {
         data->state = LV_INDEV_STATE_REL;
+        was_pressed = false;
+
+        /* ʱ޴ʱѯƵ,  LVGL 񰴶ʱҪ */
+        if (s_touch_irq_ready && lv_tick_elaps(s_last_touch_tick) > TOUCH_IDLE_DELAY_MS)
+        {
+            lv_timer_set_period(indev_drv->read_timer, TOUCH_IDLE_READ_PERIOD_MS);
+        }
+    }
+
+    /* ʶ״̬ȷ֮, ȡʱ LVGL 漴ǵȴɿ */
+    if (s_touch_service_ready)
+    {
+        touchpad_update_gesture();
     }
 
     /* µ */
@@ -161,7 +266,15 @@ static void touchpad_read(lv_indev_drv_t * indev_drv, lv_indev_data_t * data)
 static bool touchpad_is_pressed(void)
 {
     /*Your code comes here*/
+    if (s_touch_service_ready)
+    {
+        TouchService_GetSample(&s_touch_sample);
+        return s_touch_sample.pressed;
+    }
+
+    PROF_BEGIN(PROF_ZONE_TOUCH_READ);
     tp_dev.scan(0);
+    PROF_END(PROF_ZONE_TOUCH_READ);
 
     if (tp_dev.sta & TP_PRES_DOWN)
     {
@@ -180,10 +293,215 @@ static bool touchpad_is_pressed(void)
 static void touchpad_get_xy(lv_coord_t * x, lv_coord_t * y)
 {
     /*Your code comes here*/
+    if (s_touch_service_ready)
+    {
+        (*x) = s_touch_sample.x[0];
+        (*y) = s_touch_sample.y[0];
+        return;
+    }
+
     (*x) = tp_dev.x[0];
     (*y) = tp_dev.y[0];
 }
 
+/**
+ * @brief       (׼)任ΪǰĻ
+ *   @note      任лʱ lcd_orient , ֻһγ˼
+ * @param       x   : xָ(ԭʼ, Ļ)
+ *   @arg       y   : yָ
+ * @retval      
+ */
+static void touchpad_map_point(lv_coord_t * x, lv_coord_t * y)
+{
+    const lcd_touch_xform_t * t = lcd_orient_touch_xform();
+    lv_coord_t tx = *x;
+    lv_coord_t ty = *y;
+
+    *x = (lv_coord_t)LCD_XFORM_X(t, tx, ty);
+    *y = (lv_coord_t)LCD_XFORM_Y(t, tx, ty);
+}
+
+/**
+ * @brief       Ƶλáٶ뻬任Ϊǰ
+ *   @note      ٶ뷽ֻ任Բ(ƽ)
+ * @param       gesture : (ԭ޸)
+ * @retval      
+ */
+static void touchpad_map_gesture(TouchGesture_t * gesture)
+{
+    const lcd_touch_xform_t * t = lcd_orient_touch_xform();
+    lv_coord_t x = gesture->x;
+    lv_coord_t y = gesture->y;
+    int32_t vx = gesture->vx;
+    int32_t vy = gesture->vy;
+    int32_t dx = 0;
+    int32_t dy = 0;
+
+    touchpad_map_point(&x, &y);
+    gesture->x = x;
+    gesture->y = y;
+    gesture->vx = t->xx * vx + t->xy * vy;
+    gesture->vy = t->yx * vx + t->yy * vy;
+
+    if (!TOUCH_GESTURE_IS_SWIPE(gesture->type))
+    {
+        return;
+    }
+
+    switch (gesture->type)
+    {
+        case TOUCH_GESTURE_SWIPE_LEFT:  dx = -1; break;
+        case TOUCH_GESTURE_SWIPE_RIGHT: dx = 1;  break;
+        case TOUCH_GESTURE_SWIPE_UP:    dy = -1; break;
+        default:                        dy = 1;  break;
+    }
+
+    vx = t->xx * dx + t->xy * dy;
+    vy = t->yx * dx + t->yy * dy;
+    if (vx != 0)
+    {
+        gesture->type = (vx < 0) ? TOUCH_GESTURE_SWIPE_LEFT : TOUCH_GESTURE_SWIPE_RIGHT;
+    }
+    else
+    {
+        gesture->type = (vy < 0) ? TOUCH_GESTURE_SWIPE_UP : TOUCH_GESTURE_SWIPE_DOWN;
+    }
+}
+
+#if TOUCH_FILTER_ENABLE
+/**
+ * @brief       ȡֵ
+ */
+static lv_coord_t touchpad_median3(lv_coord_t a, lv_coord_t b, lv_coord_t c)
+{
+    if (a > b) { lv_coord_t t = a; a = b; b = t; }
+    if (b > c) { b = c; }
+    return (a > b) ? a : b;
+}
+
+/**
+ * @brief       Ӧ IIR: ƶʱֱͨ, ʱ 1/2^N ƽ
+ * @param       iir_q4  : IIR ״̬(Q4)
+ *   @arg       target  : ֵ˲
+ * @retval      
+ */
+static void touchpad_iir_step(int32_t * iir_q4, lv_coord_t target)
+{
+    int32_t diff = ((int32_t)target << 4) - *iir_q4;
+
+    if (LV_ABS(diff) >= (TOUCH_FILTER_FAST_PX << 4))
+    {
+        *iir_q4 = (int32_t)target << 4;
+    }
+    else
+    {
+        *iir_q4 += diff / (1 << TOUCH_FILTER_IIR_SHIFT);
+    }
+}
+
+/**
+ * @brief       ˲(ֵ + IIR + )
+ * @param       x       : xָ(Ļ, ˲)
+ *   @arg       y       : yָ
+ *   @arg       first   : ΰµĵһ, λ˲
+ *   @arg       fresh   : µԭʼ(ֻһε)
+ * @retval      
+ */
+static void touchpad_filter(lv_coord_t * x, lv_coord_t * y, bool first, bool fresh)
+{
+    touch_filter_t * f = &s_filter;
+    uint8_t i;
+
+    if (first)
+    {
+        for (i = 0; i < 3; i++)
+        {
+            f->hist_x[i] = *x;
+            f->hist_y[i] = *y;
+        }
+        f->hist_idx = 0;
+        f->iir_x = (int32_t)*x << 4;
+        f->iir_y = (int32_t)*y << 4;
+        f->out_x = *x;
+        f->out_y = *y;
+        return;
+    }
+
+    if (fresh)
+    {
+        f->hist_x[f->hist_idx] = *x;
+        f->hist_y[f->hist_idx] = *y;
+        f->hist_idx = (f->hist_idx + 1) % 3;
+
+        touchpad_iir_step(&f->iir_x, touchpad_median3(f->hist_x[0], f->hist_x[1], f->hist_x[2]));
+        touchpad_iir_step(&f->iir_y, touchpad_median3(f->hist_y[0], f->hist_y[1], f->hist_y[2]));
+
+        /* һᳬŸ, ָֹʱ LVGL ȫ */
+        lv_coord_t fx = (lv_coord_t)((f->iir_x + 8) >> 4);
+        lv_coord_t fy = (lv_coord_t)((f->iir_y + 8) >> 4);
+
+        if (LV_ABS(fx - f->out_x) >= TOUCH_FILTER_DEADBAND_PX ||
+            LV_ABS(fy - f->out_y) >= TOUCH_FILTER_DEADBAND_PX)
+        {
+            f->out_x = fx;
+            f->out_y = fy;
+        }
+    }
+
+    *x = f->out_x;
+    *y = f->out_y;
+}
+#endif
+
+/**
+ * @brief       ƽʶ𲢽洦
+ * @note        ˫ָűʹú, ǰµĿؼ PRESS_LOST
+ *               LVGL ȴɿ, ͬһδٴ
+ * @param       
+ * @retval      
+ */
+static void touchpad_update_gesture(void)
+{
+    TouchGesture_t gesture;
+
+    if (!TouchGesture_Feed(&s_gesture, &s_touch_sample, HAL_GetTick(), &gesture))
+    {
+        return;
+    }
+
+    /* LVGL ڹĳʱ, ڹǷҳ */
+    if (TOUCH_GESTURE_IS_SWIPE(gesture.type) && lv_indev_get_scroll_obj(indev_touchpad) != NULL)
+    {
+        return;
+    }
+
+    touchpad_map_gesture(&gesture);
+
+    if (ui_handle_gesture(&gesture) &&
+        (TOUCH_GESTURE_IS_SWIPE(gesture.type) || gesture.type == TOUCH_GESTURE_PINCH_BEGIN))
+    {
+        lv_obj_t * obj = indev_touchpad->proc.types.pointer.act_obj;
+
+        if (obj != NULL)
+        {
+            lv_event_send(obj, LV_EVENT_PRESS_LOST, indev_touchpad);
+        }
+
+        lv_indev_reset(indev_touchpad, NULL);
+        lv_indev_wait_release(indev_touchpad);
+    }
+}
+
+/**
+ * @brief       ֪ͨ(),  LVGL ȡ
+ * @param       
+ * @retval      
+ */
+static void touchpad_sample_notify(void)
+{
+    ui_wake(UI_WAKE_TOUCH);
+}
+
 
 #else /*Enable this file at the top*/
 
@@ -31,6 +31,8 @@ extern "C" {
  * GLOBAL PROTOTYPES
  **********************/
 void lv_port_indev_init(void);
+void lv_port_indev_touch_irq(void);     /* 触摸中断处理(中断上下文) */
+void lv_port_indev_resume(void);        /* 恢复正常触摸轮询(LVGL 任务上下文) */
 
 /**********************
  *      MACROS
@@ -18,6 +18,7 @@
 #define LV_CONF_H
 
 #include <stdint.h>
+#include "mem_section.h"
 
 /*********************************************************************************
 
@@ -97,8 +98,8 @@
 /* ʹԶtickԴԺΪλʱ䡣Ҫֶ `lv_tick_inc()` */
 #define LV_TICK_CUSTOM                      1
 #if LV_TICK_CUSTOM
-    #define LV_TICK_CUSTOM_INCLUDE          "FreeRTOS.h"                /* ϵͳʱ亯ͷ */
-    #define LV_TICK_CUSTOM_SYS_TIME_EXPR    (xTaskGetTickCount())       /* ϵͳǰʱıʽ(ԺΪλ) */
+    #define LV_TICK_CUSTOM_INCLUDE          "stm32f4xx_hal.h"           /* ϵͳʱ亯ͷ */
+    #define LV_TICK_CUSTOM_SYS_TIME_EXPR    (HAL_GetTick())             /* ϵͳǰʱıʽ(ԺΪλ), RTOSͬԴֵͬ */
 #endif   /*LV_TICK_CUSTOM*/
 
 
@@ -125,8 +126,14 @@
 
     /* һЩӰ
      * LV_SHADOW_CACHE_SIZEΪĻССΪ `Ӱ + 뾶`
-     *  LV_SHADOW_CACHE_SIZE^2 ڴ濪 */
-    #define LV_SHADOW_CACHE_SIZE            0
+     *  LV_SHADOW_CACHE_SIZE^2 ڴ濪
+     * ̽еӰ: ⰴť ( 2 + Բ 13 = 15)ť (2 + 8 = 10)
+     * ǰť (10 + 8 = 18)С 20LED ȱ仯ҳߴ󣬲 */
+    #define LV_SHADOW_CACHE_SIZE            20
+
+    /* ӰĿ (̶ lv_draw_sw_rect.c չԭֻ 1 )
+     * ͬһĻϵļӰƣụ༷ÿռ LV_SHADOW_CACHE_SIZE^2 ֽ */
+    #define LV_SHADOW_CACHE_SLOTS           4
 
     /* 󻺴ѭݵ
      * 1/4Բܳڿ
@@ -140,7 +147,13 @@
  * ֻʹõͼʽûơ(ûµͼ)
  * ӵͼ(PNGJPG)Ա/ͼȻ򿪵ͼܻĶRAM
  * 0:û */
-#define LV_IMG_CACHE_DEF_SIZE               0
+#define LV_IMG_CACHE_DEF_SIZE               4     /* ҳ led_symbol/beep_symbol/mygif  1  1 лĻ */
+
+/* ͼ/Ӱͳƹ ( lv_img_cache.clv_draw_sw_rect.c е)
+ * ֡ͳƴڻܣʾҳ */
+#define LV_CACHE_STATS_INCLUDE              "frame_stats.h"
+#define LV_IMG_CACHE_STATS(hit)             FrameStats_CacheEvent(FRAME_STATS_CACHE_IMG, (hit))
+#define LV_SHADOW_CACHE_STATS(hit)          FrameStats_CacheEvent(FRAME_STATS_CACHE_SHADOW, (hit))
 
 /* ÿ¶ͣĿֵͣվ
  * ÿֹͣ(sizeof(lv_color_t) + 1)ֽ */
@@ -171,11 +184,23 @@
  *-----------*/
 
 /* ʹSTM32DMA2D(Chrom Art) GPU */
-#define LV_USE_GPU_STM32_DMA2D              0
+/* ڴ DMA2D оƬϿ, F407 û DMA2D,  lv_port_draw.c ʹ DMA  */
+#if defined(STM32F427xx) || defined(STM32F429xx) || defined(STM32F437xx) || defined(STM32F439xx) || \
+    defined(STM32F469xx) || defined(STM32F479xx)
+    #define LV_USE_GPU_STM32_DMA2D          1
+#elif defined(STM32F7)
+    #define LV_USE_GPU_STM32_DMA2D          1
+#else
+    #define LV_USE_GPU_STM32_DMA2D          0
+#endif
 #if LV_USE_GPU_STM32_DMA2D
     /* 붨Ŀ괦CMSISͷ·
        硣stm32f769xx.hstm32f429xx.h*/
-    #define LV_GPU_DMA2D_CMSIS_INCLUDE
+    #if defined(STM32F7)
+        #define LV_GPU_DMA2D_CMSIS_INCLUDE  "stm32f7xx.h"
+    #else
+        #define LV_GPU_DMA2D_CMSIS_INCLUDE  "stm32f4xx.h"
+    #endif
 #endif
 
 /* ʹNXPPXP GPU iMX RTxxxƽ̨ */
@@ -319,11 +344,13 @@
 /* Ǵͳ飬λͼ */
 #define LV_ATTRIBUTE_LARGE_CONST
 
-/* RAMдıǰ׺ */
-#define LV_ATTRIBUTE_LARGE_RAM_ARRAY
+/* RAMдıǰ׺
+ * lv_mem ڴ (work_mem_int) ŵ CCM RAM lv_mem Ļֱӽ DMA */
+#define LV_ATTRIBUTE_LARGE_RAM_ARRAY CCM_RAM
 
-/* ܹؼܷڴ(RAM) */
-#define LV_ATTRIBUTE_FAST_MEM
+/* ܹؼܷڴ(RAM)
+ * ϡ֡lv_memcpy  SRAM ִУ mem_section.h  MEM_RAMFUNC_ENABLE  */
+#define LV_ATTRIBUTE_FAST_MEM RAM_FUNC
 
 /* GPUٲʹõǰ׺ͨҪDMAɷʵRAM */
 #define LV_ATTRIBUTE_DMA
@@ -560,7 +587,8 @@
  *----------*/
 
 /* һ򵥣ӡ̺ͷǳ e*/
-#define LV_USE_THEME_DEFAULT                1
+/* رգӦʹ GUI_APP/ui_theme.c еĳʽ */
+#define LV_USE_THEME_DEFAULT                0
 #if LV_USE_THEME_DEFAULT
 
     /* 0:ģʽ;1:ڰģʽ */
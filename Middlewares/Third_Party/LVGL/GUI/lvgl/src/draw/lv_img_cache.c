@@ -13,6 +13,10 @@
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
 
+#ifdef LV_CACHE_STATS_INCLUDE
+    #include LV_CACHE_STATS_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -26,6 +30,11 @@
  * "die" from very high values*/
 #define LV_IMG_CACHE_LIFE_LIMIT 1000
 
+/*Called with `true` on an image cache hit and `false` on a miss*/
+#ifndef LV_IMG_CACHE_STATS
+    #define LV_IMG_CACHE_STATS(hit)
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -97,6 +106,7 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
     }
 
     /*The image is not cached then cache it now*/
+    LV_IMG_CACHE_STATS(cached_src != NULL);
     if(cached_src) return cached_src;
 
     /*Find an entry to reuse. Select the entry with the least life*/
@@ -223,6 +223,27 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     blend_dsc.opa = dsc->opa;
     blend_dsc.blend_mode = dsc->blend_mode;
 
+    /*Fast path: an unclipped 8 bpp glyph (e.g. from a pre-rendered atlas) already is an opa map.
+     *Use it as the mask directly instead of unpacking it row by row.*/
+    if(bpp == 8 && opa >= LV_OPA_MAX && col_start == 0 && col_end == box_w && row_start < row_end) {
+        lv_area_t map_area;
+        map_area.x1 = pos->x;
+        map_area.x2 = pos->x + box_w - 1;
+        map_area.y1 = pos->y + row_start;
+        map_area.y2 = pos->y + row_end - 1;
+#if LV_DRAW_COMPLEX
+        if(!lv_draw_mask_is_any(&map_area))
+#endif
+        {
+            blend_dsc.blend_area = &map_area;
+            blend_dsc.mask_area = &map_area;
+            blend_dsc.mask_buf = (lv_opa_t *)map_p;
+            blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            return;
+        }
+    }
+
     lv_coord_t hor_res = lv_disp_get_hor_res(_lv_refr_get_disp_refreshing());
     uint32_t mask_buf_size = box_w * box_h > hor_res ? hor_res : box_w * box_h;
     lv_opa_t * mask_buf = lv_mem_buf_get(mask_buf_size);
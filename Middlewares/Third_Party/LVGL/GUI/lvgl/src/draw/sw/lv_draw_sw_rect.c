@@ -13,6 +13,10 @@
 #include "../../misc/lv_assert.h"
 #include "lv_draw_sw_dither.h"
 
+#ifdef LV_CACHE_STATS_INCLUDE
+    #include LV_CACHE_STATS_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -20,10 +24,27 @@
 #define SHADOW_ENHANCE          1
 #define SPLIT_LIMIT             50
 
+#ifndef LV_SHADOW_CACHE_SLOTS
+    #define LV_SHADOW_CACHE_SLOTS   1
+#endif
+
+/*Called with `true` on a shadow cache hit and `false` on a miss*/
+#ifndef LV_SHADOW_CACHE_STATS
+    #define LV_SHADOW_CACHE_STATS(hit)
+#endif
+
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
+typedef struct {
+    int32_t size;       /*Corner size of the cached shadow, 0: empty slot*/
+    int32_t r;
+    uint32_t last_use;
+    uint8_t buf[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
+} sh_cache_slot_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -53,9 +74,8 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
  *  STATIC VARIABLES
  **********************/
 #if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+    static sh_cache_slot_t sh_cache[LV_SHADOW_CACHE_SLOTS];
+    static uint32_t sh_cache_tick;
 #endif
 
 /**********************
@@ -477,21 +497,38 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
     lv_opa_t * sh_buf;
 
 #if LV_SHADOW_CACHE_SIZE
-    if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
+    sh_cache_slot_t * sh_slot = NULL;
+    uint32_t sh_i;
+    for(sh_i = 0; sh_i < LV_SHADOW_CACHE_SLOTS; sh_i++) {
+        if(sh_cache[sh_i].size == corner_size && sh_cache[sh_i].r == r_sh) {
+            sh_slot = &sh_cache[sh_i];
+            break;
+        }
+    }
+
+    if(sh_slot) {
         /*Use the cache if available*/
+        LV_SHADOW_CACHE_STATS(true);
+        sh_slot->last_use = ++sh_cache_tick;
         sh_buf = lv_mem_buf_get(corner_size * corner_size);
-        lv_memcpy(sh_buf, sh_cache, corner_size * corner_size);
+        lv_memcpy(sh_buf, sh_slot->buf, corner_size * corner_size);
     }
     else {
+        LV_SHADOW_CACHE_STATS(false);
         /*A larger buffer is required for calculation*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size * sizeof(uint16_t));
         shadow_draw_corner_buf(&core_area, (uint16_t *)sh_buf, dsc->shadow_width, r_sh);
 
-        /*Cache the corner if it fits into the cache size*/
-        if((uint32_t)corner_size * corner_size < sizeof(sh_cache)) {
-            lv_memcpy(sh_cache, sh_buf, corner_size * corner_size);
-            sh_cache_size = corner_size;
-            sh_cache_r = r_sh;
+        /*Cache the corner if it fits into the cache size, replacing the least recently used slot*/
+        if((uint32_t)corner_size * corner_size < sizeof(sh_cache[0].buf)) {
+            sh_slot = &sh_cache[0];
+            for(sh_i = 1; sh_i < LV_SHADOW_CACHE_SLOTS; sh_i++) {
+                if(sh_cache[sh_i].last_use < sh_slot->last_use) sh_slot = &sh_cache[sh_i];
+            }
+            lv_memcpy(sh_slot->buf, sh_buf, corner_size * corner_size);
+            sh_slot->size = corner_size;
+            sh_slot->r = r_sh;
+            sh_slot->last_use = ++sh_cache_tick;
         }
     }
 #else
@@ -55,6 +55,8 @@
  **********************/
 #if LV_MEM_CUSTOM == 0
     static lv_tlsf_t tlsf;
+    static uint32_t cur_used; /*Bytes in allocated blocks (TLSF block sizes)*/
+    static uint32_t max_used; /*Peak of `cur_used` since lv_mem_init*/
 #endif
 
 static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variable if 0 byte should be allocated*/
@@ -96,6 +98,8 @@ void lv_mem_init(void)
 #else
     tlsf = lv_tlsf_create_with_pool((void *)LV_MEM_ADR, LV_MEM_SIZE);
 #endif
+    cur_used = 0;
+    max_used = 0;
 #endif
 
 #if LV_MEM_ADD_JUNK
@@ -130,6 +134,10 @@ void * lv_mem_alloc(size_t size)
 
 #if LV_MEM_CUSTOM == 0
     void * alloc = lv_tlsf_malloc(tlsf, size);
+    if(alloc) {
+        cur_used += lv_tlsf_block_size(alloc);
+        if(cur_used > max_used) max_used = cur_used;
+    }
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
 #endif
@@ -163,9 +171,11 @@ void lv_mem_free(void * data)
     if(data == NULL) return;
 
 #if LV_MEM_CUSTOM == 0
+    size_t size = lv_tlsf_block_size(data);
 #  if LV_MEM_ADD_JUNK
-    lv_memset(data, 0xbb, lv_tlsf_block_size(data));
+    lv_memset(data, 0xbb, size);
 #  endif
+    cur_used = cur_used > size ? cur_used - size : 0;
     lv_tlsf_free(tlsf, data);
 #else
     LV_MEM_CUSTOM_FREE(data);
@@ -191,7 +201,13 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
 #if LV_MEM_CUSTOM == 0
+    size_t old_size = data_p ? lv_tlsf_block_size(data_p) : 0;
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    if(new_p) {
+        cur_used = cur_used > old_size ? cur_used - old_size : 0;
+        cur_used += lv_tlsf_block_size(new_p);
+        if(cur_used > max_used) max_used = cur_used;
+    }
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
@@ -241,6 +257,7 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
 
     mon_p->total_size = LV_MEM_SIZE;
+    mon_p->max_used = max_used;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
     if(mon_p->free_size > 0) {
         mon_p->frag_pct = mon_p->free_biggest_size * 100U / mon_p->free_size;
@@ -0,0 +1,305 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+把 LVGL 图片 C 数组打包成外部 SPI Flash 资源包 (格式见 ui_assets.h)。
+
+从 LVGL 在线转换器生成的 .c 文件中取出 LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0
+分支的像素数据和 .header 字段，按行做 RLE 压缩 (格式见 ui_img_rle.h)；压缩后
+不到原始大小 RLE_MAX_RATIO 的图片输出 .rle，否则输出 LVGL 原始 .bin
+(4 字节头 + 像素)。再把所有文件连同目录表写成一个资源包。
+可选通过串口命令行 (flash 命令) 直接烧写到板子，或输出 RLE 图片的 C 数组。
+字体 (--font) 把 glyph_bitmap 数组原样打包为 <字体名>.fnt，配合
+--emit-font-index 生成的索引字体由 ui_font_stream 按需读取字形 (见 ui_font_stream.h)。
+
+用法:
+    python asset_pack.py                         # 打包默认图片，输出 assets.pack
+    python asset_pack.py -o out.pack a.c b.c     # 打包指定文件
+    python asset_pack.py --port COM5             # 打包并通过串口烧写 (需要 pyserial)
+    python asset_pack.py --raw                   # 不压缩，全部输出 .bin
+    python asset_pack.py --emit-c out_dir        # 另外输出 <名称>_rle.c，供片内使用
+    python asset_pack.py --font my_font_yahei_24.c --emit-font-index out_dir
+                                                 # 打包字体位图，并输出只含索引的 my_font_yahei_24.c
+
+烧写完成后复位板子，启动时 ui_assets_init() 会校验并挂载资源包。
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+MAGIC = 0x50534145          # "EASP"，与 UI_ASSETS_MAGIC 一致
+VERSION = 1
+NAME_MAX = 24               # 含结束符
+HEADER_FMT = "<IHHII"       # magic, version, count, size, crc
+ENTRY_FMT = "<%dsII" % NAME_MAX
+FLASH_ADDR = 0x000000       # UI_ASSETS_FLASH_ADDR
+PACK_MAX = 0x600000         # OTA_FLASH_ADDR 起为固件升级区
+SECTOR_SIZE = 4096
+WRITE_CHUNK = 16            # 命令行一行最多 64 字符，每行写 16 字节
+
+# 默认打包的图片 (需要旋转/缩放的图片不能放进资源包)
+DEFAULT_ASSETS = ["author_photo.c", "bilbil.c", "led_symbol.c"]
+
+# RLE 格式 (与 ui_img_rle.h 一致)
+CF_USER_ENCODED_0 = 24      # LV_IMG_CF_USER_ENCODED_0
+RLE_RUN_FLAG = 0x80
+RLE_MAX_COUNT = 128
+RLE_MAX_RATIO = 0.9
+
+# 字体位图数组 (lv_font_conv 输出)
+FONT_BITMAP_RE = r"static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap\[\] = \{(.*?)\};\n"
+
+CF_VALUES = {
+    "LV_IMG_CF_TRUE_COLOR": (4, 2),
+    "LV_IMG_CF_TRUE_COLOR_ALPHA": (5, 3),
+    "LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED": (6, 2),
+}
+
+
+def convert_c_image(path):
+    """解析一个图片 .c 文件，返回 (名称, LVGL .bin 内容)"""
+    with open(path, "r", encoding="utf-8", errors="ignore") as f:
+        text = f.read()
+
+    name = os.path.splitext(os.path.basename(path))[0]
+    block = re.search(r"#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0\n(.*?)#endif",
+                      text, re.S)
+    w = re.search(r"\.header\.w\s*=\s*(\d+)", text)
+    h = re.search(r"\.header\.h\s*=\s*(\d+)", text)
+    cf = re.search(r"\.header\.cf\s*=\s*(LV_IMG_CF_\w+)", text)
+    if not (block and w and h and cf) or cf.group(1) not in CF_VALUES:
+        raise ValueError("%s: 不是支持的 16 位真彩色图片" % path)
+
+    body = re.sub(r"/\*.*?\*/", "", block.group(1), flags=re.S)
+    pixels = bytes(int(v, 16) for v in re.findall(r"0x([0-9a-fA-F]{2})", body))
+    w, h = int(w.group(1)), int(h.group(1))
+    cf_value, px_size = CF_VALUES[cf.group(1)]
+    if len(pixels) != w * h * px_size:
+        raise ValueError("%s: 像素数据长度 %d 与 %dx%d 不符" % (path, len(pixels), w, h))
+
+    # lv_img_header_t: cf:5 always_zero:3 reserved:2 w:11 h:11
+    header = struct.pack("<I", cf_value | (w << 10) | (h << 21))
+    return name, header + pixels
+
+
+def convert_c_font(path):
+    """解析 lv_font_conv 生成的字体 .c，返回 (名称, 位图字节串, 源码)"""
+    with open(path, "r", encoding="utf-8", errors="ignore") as f:
+        text = f.read()
+
+    name = os.path.splitext(os.path.basename(path))[0]
+    block = re.search(FONT_BITMAP_RE, text, re.S)
+    fmt = re.search(r"\.bitmap_format\s*=\s*(\d+)", text)
+    if not block or not fmt:
+        raise ValueError("%s: 不是 lv_font_conv 生成的字体" % path)
+    if fmt.group(1) != "0":
+        raise ValueError("%s: 流式字体只支持未压缩位图 (bitmap_format = 0)" % path)
+
+    body = re.sub(r"/\*.*?\*/", "", block.group(1), flags=re.S)
+    bitmap = bytes(int(v, 16) for v in re.findall(r"0x([0-9a-fA-F]{2})", body))
+    return name, bitmap, text
+
+
+def emit_font_index(name, text, out_dir):
+    """输出只含索引的同名字体：位图数组删除，位图改由 ui_font_stream 从资源包读取"""
+    file_name = name + ".fnt"
+    replaces = [
+        (FONT_BITMAP_RE, "/* 位图在资源包 %s 中 (asset_pack.py --font) */\n" % file_name),
+        (r"\.glyph_bitmap\s*=\s*glyph_bitmap,", ".glyph_bitmap = NULL,"),
+        (r"\.get_glyph_bitmap\s*=\s*lv_font_get_bitmap_fmt_txt,",
+         ".get_glyph_bitmap = ui_font_stream_get_bitmap,"),
+        (r"\.user_data\s*=\s*NULL,", ".user_data = (void *)\"%s\"," % file_name),
+        (r"(#if %s\n)" % name.upper(), "\\1\n#include \"ui_font_stream.h\"\n"),
+    ]
+    for pattern, repl in replaces:
+        text, n = re.subn(pattern, repl, text, count=1, flags=re.S)
+        if n != 1:
+            raise ValueError("%s: 找不到 %s" % (name, pattern))
+
+    path = os.path.join(out_dir, name + ".c")
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+    return path
+
+
+def rle_encode_row(row, px_size):
+    """按像素编码一行：重复 >= 2 个的像素输出行程，其余合并为原样段"""
+    pixels = [row[i:i + px_size] for i in range(0, len(row), px_size)]
+    out = bytearray()
+    i, n = 0, len(pixels)
+    while i < n:
+        j = i + 1
+        while j < n and j - i < RLE_MAX_COUNT and pixels[j] == pixels[i]:
+            j += 1
+        if j - i >= 2:
+            out.append(RLE_RUN_FLAG | (j - i - 1))
+            out += pixels[i]
+            i = j
+            continue
+        start = i
+        i += 1
+        while i < n and i - start < RLE_MAX_COUNT and not (i + 1 < n and pixels[i] == pixels[i + 1]):
+            i += 1
+        out.append(i - start - 1)
+        for p in pixels[start:i]:
+            out += p
+    return bytes(out)
+
+
+def rle_encode_image(content):
+    """LVGL .bin 内容 -> .rle 内容"""
+    header = struct.unpack("<I", content[:4])[0]
+    cf, w, h = header & 0x1F, (header >> 10) & 0x7FF, header >> 21
+    px_size = 3 if cf == CF_VALUES["LV_IMG_CF_TRUE_COLOR_ALPHA"][0] else 2
+    pixels = content[4:]
+
+    rows, data = [], b""
+    for y in range(h):
+        rows.append(len(data))
+        data += rle_encode_row(pixels[y * w * px_size:(y + 1) * w * px_size], px_size)
+    rows.append(len(data))
+
+    rle_header = struct.pack("<I", CF_USER_ENCODED_0 | (w << 10) | (h << 21))
+    info = struct.pack("<B3x", cf)
+    return rle_header + info + struct.pack("<%dI" % len(rows), *rows) + data
+
+
+def emit_c(name, content, out_dir):
+    """把 .rle 内容写成 lv_img_dsc_t C 数组 (去掉 4 字节文件头，头部放在描述符里)"""
+    header = struct.unpack("<I", content[:4])[0]
+    body = content[4:]
+    lines = ["  " + ", ".join("0x%02x" % b for b in body[i:i + 16]) + ","
+             for i in range(0, len(body), 16)]
+    text = (
+        "/* 由 asset_pack.py 生成的 RLE 图片，解码器见 ui_img_rle.c */\n"
+        "#include \"lvgl.h\"\n\n"
+        "static const uint8_t %s_rle_map[] = {\n%s\n};\n\n"
+        "const lv_img_dsc_t %s_rle = {\n"
+        "  .header.cf = LV_IMG_CF_USER_ENCODED_0,\n"
+        "  .header.always_zero = 0,\n"
+        "  .header.reserved = 0,\n"
+        "  .header.w = %d,\n"
+        "  .header.h = %d,\n"
+        "  .data_size = %d,\n"
+        "  .data = %s_rle_map,\n"
+        "};\n" % (name, "\n".join(lines), name, (header >> 10) & 0x7FF, header >> 21,
+                  len(body), name))
+    path = os.path.join(out_dir, name + "_rle.c")
+    with open(path, "w", encoding="utf-8") as f:
+        f.write(text)
+    return path
+
+
+def build_pack(images):
+    """images: [(文件名, 内容)]，返回资源包字节串"""
+    header_size = struct.calcsize(HEADER_FMT)
+    entry_size = struct.calcsize(ENTRY_FMT)
+    offset = header_size + entry_size * len(images)
+
+    entries = b""
+    data = b""
+    for name, content in images:
+        file_name = name.encode("ascii")
+        if len(file_name) >= NAME_MAX:
+            raise ValueError("%s: 文件名超过 %d 字符" % (name, NAME_MAX - 1))
+        entries += struct.pack(ENTRY_FMT, file_name, offset + len(data), len(content))
+        data += content
+        data += b"\0" * (-len(data) % 4)
+
+    body = entries + data
+    size = header_size + len(body)
+    return struct.pack(HEADER_FMT, MAGIC, VERSION, len(images), size,
+                       zlib.crc32(body) & 0xFFFFFFFF) + body
+
+
+def shell_command(port, line, timeout_lines=50):
+    """发送一条命令并返回第一行 ok/error/crc 应答"""
+    port.write((line + "\r\n").encode("ascii"))
+    for _ in range(timeout_lines):
+        reply = port.readline().decode("ascii", "ignore").strip()
+        if reply.startswith(("ok", "error", "crc=", "invalid", "usage", "flash not")):
+            return reply
+    raise RuntimeError("命令无应答: %s" % line)
+
+
+def flash_pack(pack, port_name, baud):
+    import serial  # pyserial
+
+    with serial.Serial(port_name, baud, timeout=2) as port:
+        port.reset_input_buffer()
+        erase_len = (len(pack) + SECTOR_SIZE - 1) // SECTOR_SIZE * SECTOR_SIZE
+        print("擦除 %d 字节..." % erase_len)
+        port.timeout = 1 + erase_len // SECTOR_SIZE // 2
+        if shell_command(port, "flash erase 0x%X %d" % (FLASH_ADDR, erase_len)) != "ok":
+            raise RuntimeError("擦除失败")
+
+        port.timeout = 2
+        for off in range(0, len(pack), WRITE_CHUNK):
+            chunk = pack[off:off + WRITE_CHUNK]
+            reply = shell_command(port, "flash write 0x%X %s" % (FLASH_ADDR + off, chunk.hex()))
+            if reply != "ok":
+                raise RuntimeError("写入 0x%X 失败: %s" % (FLASH_ADDR + off, reply))
+            if off % 4096 == 0:
+                print("\r写入 %d / %d" % (off, len(pack)), end="")
+        print()
+
+        expect = "crc=0x%08X" % (zlib.crc32(pack) & 0xFFFFFFFF)
+        reply = shell_command(port, "flash crc 0x%X %d" % (FLASH_ADDR, len(pack)))
+        if reply != expect:
+            raise RuntimeError("校验失败: %s, 期望 %s" % (reply, expect))
+        print("烧写完成 (%s)，复位后生效" % expect)
+
+
+def main():
+    here = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description="生成外部 SPI Flash 图片资源包")
+    parser.add_argument("images", nargs="*", help="图片 .c 文件 (默认: %s)" % " ".join(DEFAULT_ASSETS))
+    parser.add_argument("-o", "--output", default=os.path.join(here, "assets.pack"))
+    parser.add_argument("--port", help="通过该串口烧写到板子")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--raw", action="store_true", help="不做 RLE 压缩")
+    parser.add_argument("--emit-c", metavar="DIR", help="把 RLE 图片另外输出为 C 数组")
+    parser.add_argument("--font", action="append", default=[], metavar="FONT.c",
+                        help="打包字体位图 (可重复)")
+    parser.add_argument("--emit-font-index", metavar="DIR",
+                        help="为 --font 输出只含索引的字体 .c (目录不能是字体所在目录)")
+    args = parser.parse_args()
+
+    paths = args.images or [os.path.join(here, n) for n in DEFAULT_ASSETS]
+    images = []
+    for path in paths:
+        name, raw = convert_c_image(path)
+        rle = rle_encode_image(raw)
+        if args.emit_c:
+            print("  生成 %s" % emit_c(name, rle, args.emit_c))
+        if not args.raw and len(rle) <= len(raw) * RLE_MAX_RATIO:
+            images.append((name + ".rle", rle))
+        else:
+            images.append((name + ".bin", raw))
+        print("  %-20s %7d 字节 (原始 %d)" % (images[-1][0], len(images[-1][1]), len(raw)))
+    for path in args.font:
+        name, bitmap, text = convert_c_font(path)
+        images.append((name + ".fnt", bitmap))
+        print("  %-20s %7d 字节" % (images[-1][0], len(bitmap)))
+        if args.emit_font_index:
+            if os.path.samefile(args.emit_font_index, os.path.dirname(os.path.abspath(path))):
+                raise SystemExit("--emit-font-index 不能覆盖原字体")
+            print("  生成 %s" % emit_font_index(name, text, args.emit_font_index))
+    pack = build_pack(images)
+    if FLASH_ADDR + len(pack) > PACK_MAX:
+        raise SystemExit("资源包 %d 字节，超出固件升级区之前的空间" % len(pack))
+
+    with open(args.output, "wb") as f:
+        f.write(pack)
+    print("资源包 %s: %d 字节" % (args.output, len(pack)))
+
+    if args.port:
+        flash_pack(pack, args.port, args.baud)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
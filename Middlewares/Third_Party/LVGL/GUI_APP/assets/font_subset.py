@@ -0,0 +1,590 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+按界面实际用到的字符裁剪 LVGL 中文字体 (my_font_yahei_*.c)。
+
+扫描 GUI_APP 下引用某个字体的源文件，收集其中的字符串字面量 (跳过注释、预处理行
+以及 LOG_xxx / printf / strcmp 等不会显示的调用)，得到每个字体需要的字形集合，
+与字体 .c 中已有的字形比较：
+  - 缺失: 界面用到但字体里没有，运行时显示为空白，需要用 --ttf 重新生成
+  - 多余: 字体里有但界面没用到，占用片内 Flash
+
+动作:
+    python font_subset.py                   # 只报告 (默认)
+    python font_subset.py --check           # 有缺失字形时返回 1，可作为编译前检查
+    python font_subset.py --trim            # 直接从现有 .c 中删去多余字形 (无需字体文件)
+    python font_subset.py --trim --compress # 同时把位图改为 LVGL 压缩格式
+    python font_subset.py --ttf msyh.ttf    # 调用 lv_font_conv 按字形集合重新生成
+
+--compress 生成 bitmap_format = 1 (RLE + 行异或预滤波)，需要在 lv_conf.h 中打开
+LV_USE_FONT_COMPRESSED；压缩字形每次绘制都要先解压，用 CPU 换 Flash。
+每次写出后都会重新解析并逐字形解码，确认与原字形完全一致。
+"""
+
+import argparse
+import glob
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+GUI_DIR = os.path.dirname(HERE)
+LV_CONF = os.path.join(GUI_DIR, "..", "GUI", "lvgl", "lv_conf.h")
+
+# ascii: "full"    保留全部可打印 ASCII (用于显示运行时数字/文字的字体)
+#        "literal" 只保留字面量中出现的 ASCII
+# scope: "file"    引用该字体的源文件中的字面量都计入，明确属于其它字体的语句除外
+#                  (文字经由辅助函数参数传入时只能按文件统计)
+#        "object"  只计入提到该字体对象的语句中的字面量，对象由
+#                  lv_obj_set_style_text_font(obj, &字体, ...) 得到；names 中的
+#                  标识符所在语句也计入 (用于先存进变量再显示的文字)
+# via:   通过这些组件函数或共享样式 (ui_styles.h) 间接使用该字体 (所在处的字符串也计入)
+# ignore: 扫描会误计入但实际不用该字体显示的字符
+FONTS = {
+    "my_font_yahei_18": {"size": 18, "ascii": "literal", "scope": "object", "names": [], "via": [],
+                         "ignore": ""},
+    # 传感器列表的数值标签 ("%.1f °C") 使用默认字体
+    "my_font_yahei_24": {"size": 24, "ascii": "full", "scope": "file", "names": [],
+                         "via": ["ui_comp_header_create", "UI_STYLE_TEXT_CN"], "ignore": "°"},
+    "my_font_yahei_36": {"size": 36, "ascii": "literal", "scope": "object",
+                         "names": ["full_text", "full_text1"], "via": [], "ignore": ""},
+}
+TTF_NAME = "微软雅黑.ttf"
+BPP = 4
+
+# 这些调用中的字符串不会显示在界面上
+SKIP_CALLS = re.compile(r"^(LOG_\w+|LV_LOG_\w+|printf|strcmp|strncmp|strstr)$")
+
+CMAP_FORMAT0_MIN = 4            # 连续码点不少于该数量时单独做一个 FORMAT0 区段
+
+FMT_PLAIN = 0
+FMT_COMPRESSED = 1              # LV_FONT_FMT_TXT_COMPRESSED (带预滤波)
+
+
+# ------------------------------------------------------------------
+# 源码扫描
+# ------------------------------------------------------------------
+
+TOKEN_RE = re.compile(r'"(?:[^"\\\n]|\\.)*"'
+                      r"|'(?:[^'\\\n]|\\.)*'"
+                      r"|//[^\n]*|/\*.*?\*/"
+                      r"|^[ \t]*#[^\n]*"
+                      r"|\w+\s*\(|[(){};]", re.S | re.M)
+ESCAPE_RE = re.compile(r"\\(x[0-9a-fA-F]{1,2}|[0-7]{1,3}|.)", re.S)
+SIMPLE_ESCAPES = {"n": 10, "t": 9, "r": 13, "0": 0, "\\": 92, '"': 34, "'": 39}
+
+
+def read_source(path):
+    data = open(path, "rb").read()
+    try:
+        return data.decode("utf-8")
+    except UnicodeDecodeError:
+        return data.decode("gbk")     # 部分头文件为 GBK 编码
+
+
+def unescape(body):
+    out = bytearray()
+    pos = 0
+    for m in ESCAPE_RE.finditer(body):
+        out += body[pos:m.start()].encode("utf-8")
+        esc = m.group(1)
+        if esc[0] == "x":
+            out.append(int(esc[1:], 16))
+        elif esc[0] in "01234567" and esc != "0":
+            out.append(int(esc, 8) & 0xFF)
+        else:
+            out.append(SIMPLE_ESCAPES.get(esc, ord(esc[0]) & 0xFF))
+        pos = m.end()
+    out += body[pos:].encode("utf-8")
+    return out.decode("utf-8", "ignore")
+
+
+def scan_statements(text):
+    """把源码按 ; { } 切成语句，返回 [(字面量替换为 "" 后的语句, [会显示的字面量])]"""
+    stack, statements = [], []
+    code, literals, pos = [], [], 0
+
+    def flush():
+        statements.append(("".join(code), list(literals)))
+        del code[:], literals[:]
+
+    for m in TOKEN_RE.finditer(text):
+        code.append(text[pos:m.start()])
+        pos = m.end()
+        tok = m.group(0)
+        if tok.startswith('"'):
+            code.append('""')
+            if not any(SKIP_CALLS.match(name) for name in stack):
+                literals.append(unescape(tok[1:-1]))
+        elif tok.startswith(("//", "/*", "'")) or tok.lstrip().startswith("#"):
+            code.append(" ")
+        else:
+            code.append(tok)
+            if tok in ";{}":
+                flush()
+            elif tok == "(":
+                stack.append("")
+            elif tok == ")":
+                if stack:
+                    stack.pop()
+            else:
+                stack.append(tok[:-1].strip())
+    code.append(text[pos:])
+    flush()
+    return statements
+
+
+def font_objects(statements):
+    """字体名 -> lv_obj_set_style_text_font(obj, &字体, ...) 中的 obj 表达式集合"""
+    pat = re.compile(r"lv_obj_set_style_text_font\(\s*([^,]+?)\s*,\s*&(\w+)")
+    objects = {}
+    for code, _ in statements:
+        for m in pat.finditer(code):
+            objects.setdefault(m.group(2), set()).add(re.sub(r"\s+", "", m.group(1)))
+    for name, cfg in FONTS.items():
+        objects.setdefault(name, set()).update(cfg["names"])
+    return objects
+
+
+def mentions(code, exprs):
+    code = re.sub(r"\s+", "", code)
+    return any(re.search(r"(?<![\w.>])%s(?!\w)" % re.escape(e), code) for e in exprs)
+
+
+def wanted_chars(literals, ascii_mode):
+    chars = set()
+    for s in literals:
+        for c in s:
+            cp = ord(c)
+            if cp < 0x20 or cp == 0x7F or 0xF000 <= cp <= 0xF8FF:
+                continue            # 控制字符与 LV_SYMBOL_xxx 图标 (由符号字体提供)
+            if cp < 0x80 and ascii_mode != "literal":
+                continue
+            chars.add(cp)
+    if ascii_mode == "full":
+        chars |= set(range(0x20, 0x7F))
+    return chars
+
+
+def collect_usage(src_dirs):
+    files = []
+    for d in src_dirs:
+        files += sorted(glob.glob(os.path.join(d, "*.c")) + glob.glob(os.path.join(d, "*.h")))
+
+    usage = {name: set() for name in FONTS}
+    for path in files:
+        text = read_source(path)
+        statements = objects = None
+        for name, cfg in FONTS.items():
+            refs = ["&" + name] + cfg["via"]
+            if not any(re.search(re.escape(r) + r"\b", text) for r in refs):
+                continue
+            if statements is None:
+                statements = scan_statements(text)
+                objects = font_objects(statements)
+            if cfg["scope"] == "file":
+                others = set().union(*(v for k, v in objects.items() if k != name)) - objects[name]
+                literals = [s for code, lits in statements if not mentions(code, others) for s in lits]
+            else:
+                literals = [s for code, lits in statements if mentions(code, objects[name]) for s in lits]
+            usage[name] |= wanted_chars(literals, cfg["ascii"]) - {ord(c) for c in cfg["ignore"]}
+    return usage
+
+
+# ------------------------------------------------------------------
+# 字体 .c 解析
+# ------------------------------------------------------------------
+
+class Font:
+    pass
+
+
+def _array_body(text, name):
+    m = re.search(r"\b%s\[\]\s*=\s*\{(.*?)\n\};" % name, text, re.S)
+    if not m:
+        raise ValueError("找不到数组 %s" % name)
+    return m
+
+
+def parse_font(path):
+    text = open(path, encoding="utf-8").read()
+    font = Font()
+    font.path = path
+    font.text = text
+
+    m = re.search(r"\.bpp = (\d+),", text)
+    font.bpp = int(m.group(1))
+    font.bitmap_format = int(re.search(r"\.bitmap_format = (\d+),", text).group(1))
+    if re.search(r"\.kern_dsc = NULL", text) is None:
+        raise ValueError("%s: 暂不支持带字距调整的字体" % path)
+
+    body = re.sub(r"/\*.*?\*/", "", _array_body(text, "glyph_bitmap").group(1), flags=re.S)
+    font.bitmap = bytes(int(v, 16) for v in re.findall(r"0x([0-9a-fA-F]+)", body))
+
+    font.glyphs = []
+    body = _array_body(text, "glyph_dsc").group(1)
+    for m in re.finditer(r"\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), "
+                         r"\.box_h = (\d+), \.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}", body):
+        font.glyphs.append([int(v) for v in m.groups()])
+
+    lists = {}
+    for m in re.finditer(r"static const uint16_t (unicode_list_\d+)\[\] = \{(.*?)\};", text, re.S):
+        lists[m.group(1)] = [int(v, 16) for v in re.findall(r"0x([0-9a-fA-F]+)", m.group(2))]
+
+    font.cmap = {}                  # 码点 -> 字形 id
+    cmaps = _array_body(text.replace("cmaps[] =\n{", "cmaps[] = {"), "cmaps").group(1)
+    for m in re.finditer(r"\.range_start = (\d+), \.range_length = (\d+), \.glyph_id_start = (\d+),\s*"
+                         r"\.unicode_list = (\w+), \.glyph_id_ofs_list = (\w+), "
+                         r"\.list_length = (\d+), \.type = (\w+)", cmaps):
+        start, length, gid = int(m.group(1)), int(m.group(2)), int(m.group(3))
+        if m.group(5) != "NULL":
+            raise ValueError("%s: 暂不支持 glyph_id_ofs_list" % path)
+        if m.group(7) == "LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY":
+            for i in range(length):
+                font.cmap[start + i] = gid + i
+        elif m.group(7) == "LV_FONT_FMT_TXT_CMAP_SPARSE_TINY":
+            for i, ofs in enumerate(lists[m.group(4)]):
+                font.cmap[start + ofs] = gid + i
+        else:
+            raise ValueError("%s: 不支持的 cmap 类型 %s" % (path, m.group(7)))
+    return font
+
+
+def glyph_pixels(font, gid):
+    """返回字形的像素值列表 (每像素一个值)"""
+    idx, _, w, h = font.glyphs[gid][:4]
+    if font.bitmap_format == FMT_PLAIN:
+        return [read_bits(font.bitmap, idx * 8 + i * font.bpp, font.bpp) for i in range(w * h)]
+    return rle_decode(font.bitmap[idx:] + b"\0", w, h, font.bpp,
+                      font.bitmap_format == FMT_COMPRESSED)
+
+
+# ------------------------------------------------------------------
+# 位图编码 (与 lv_font_fmt_txt.c 的 decompress() 对应)
+# ------------------------------------------------------------------
+
+def read_bits(data, bit_pos, n):
+    v = 0
+    for i in range(n):
+        pos = bit_pos + i
+        v = (v << 1) | ((data[pos >> 3] >> (7 - (pos & 7))) & 1)
+    return v
+
+
+class BitWriter:
+    def __init__(self):
+        self.bits = []
+
+    def put(self, value, n):
+        self.bits += [(value >> (n - 1 - i)) & 1 for i in range(n)]
+
+    def to_bytes(self):
+        bits = self.bits + [0] * (-len(self.bits) % 8)
+        return bytes(int("".join(map(str, bits[i:i + 8])), 2) for i in range(0, len(bits), 8))
+
+
+def pack_plain(pixels, bpp):
+    w = BitWriter()
+    for p in pixels:
+        w.put(p, bpp)
+    return w.to_bytes()
+
+
+def rle_encode(pixels, bpp):
+    """与前一个值相同的单值之后进入重复态：每个 1 位再重复一次，0 位后跟新值；
+    连续 11 个 1 之后跟 6 位计数。见 lv_font_fmt_txt.c rle_next()"""
+    w = BitWriter()
+    i, n, prev = 0, len(pixels), None
+    while i < n:
+        v = pixels[i]
+        w.put(v, bpp)
+        i += 1
+        if prev is None or v != prev:
+            prev = v
+            continue
+
+        # 重复态，结束时都会显式写出一个值并回到单值态
+        run = 0
+        while i + run < n and pixels[i + run] == prev:
+            run += 1
+        if run < 11:
+            if run:
+                w.put((1 << run) - 1, run)
+            i += run
+            if i < n:
+                w.put(0, 1)
+                prev = pixels[i]
+                w.put(prev, bpp)
+                i += 1
+            continue
+
+        # 计数 c 表示再重复 c - 1 次后读入新值，最大 63；更长的行程把同一个值
+        # 作为新值写出，下一轮单值态会再次进入重复态
+        w.put(0x7FF, 11)
+        rest = min(run - 11, 62)
+        w.put(rest + 1, 6)
+        i += 11 + rest
+        if i < n:
+            prev = pixels[i]
+            w.put(prev, bpp)
+            i += 1
+    return w.to_bytes()
+
+
+def rle_decode(data, w, h, bpp, prefilter):
+    """lv_font_fmt_txt.c decompress() 的 Python 版本，用于校验"""
+    pos = 0
+    state, prev, cnt = "single", 0, 0
+
+    def get(n):
+        nonlocal pos
+        v = read_bits(data, pos, n)
+        pos += n
+        return v
+
+    out = []
+    for _ in range(w * h):
+        if state == "single":
+            first = pos == 0
+            ret = get(bpp)
+            if not first and prev == ret:
+                cnt, state = 0, "repeat"
+            prev = ret
+        elif state == "repeat":
+            cnt += 1
+            if get(1):
+                ret = prev
+                if cnt == 11:
+                    cnt = get(6)
+                    if cnt:
+                        state = "counter"
+                    else:
+                        ret = prev = get(bpp)
+                        state = "single"
+            else:
+                ret = prev = get(bpp)
+                state = "single"
+        else:
+            ret = prev
+            cnt -= 1
+            if cnt == 0:
+                ret = prev = get(bpp)
+                state = "single"
+        out.append(ret)
+
+    if prefilter:
+        for y in range(1, h):
+            for x in range(w):
+                out[y * w + x] ^= out[(y - 1) * w + x]
+    return out
+
+
+def encode_glyph(pixels, w, h, bpp, fmt):
+    if fmt == FMT_PLAIN:
+        return pack_plain(pixels, bpp)
+    filtered = list(pixels)
+    for y in range(h - 1, 0, -1):
+        for x in range(w):
+            filtered[y * w + x] ^= pixels[(y - 1) * w + x]
+    return rle_encode(filtered, bpp)
+
+
+# ------------------------------------------------------------------
+# 字体 .c 输出 (保持 lv_font_conv 的排版)
+# ------------------------------------------------------------------
+
+def build_cmaps(codepoints):
+    """连续码点做 FORMAT0_TINY，其余合并为 SPARSE_TINY (偏移不超过 16 位)"""
+    cps = sorted(codepoints)
+    runs, i = [], 0
+    while i < len(cps):
+        j = i
+        while j + 1 < len(cps) and cps[j + 1] == cps[j] + 1:
+            j += 1
+        runs.append(cps[i:j + 1])
+        i = j + 1
+
+    cmaps = []
+    for run in runs:
+        if len(run) >= CMAP_FORMAT0_MIN:
+            cmaps.append(("format0", run))
+        elif cmaps and cmaps[-1][0] == "sparse" and run[-1] - cmaps[-1][1][0] <= 0xFFFF:
+            cmaps[-1][1].extend(run)
+        else:
+            cmaps.append(("sparse", list(run)))
+    return cmaps
+
+
+def fmt_rows(values, per_line=8):
+    return ",\n".join("    " + ", ".join(values[i:i + per_line])
+                      for i in range(0, len(values), per_line))
+
+
+def char_comment(cp):
+    c = chr(cp)
+    return "/* U+%04X \"%s\" */" % (cp, "\\\"" if c == '"' else "\\\\" if c == "\\" else c)
+
+
+def render_font(font, keep, fmt, opts_line):
+    cmaps = build_cmaps(keep)
+    order = [cp for _, cps in cmaps for cp in cps]
+
+    parts, dsc_lines, index = [], [], 0
+    for cp in order:
+        gid = font.cmap[cp]
+        _, adv, w, h, ox, oy = font.glyphs[gid]
+        data = encode_glyph(glyph_pixels(font, gid), w, h, font.bpp, fmt) if w * h else b""
+        parts.append((char_comment(cp), data))
+        dsc_lines.append("    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, "
+                         ".ofs_x = %d, .ofs_y = %d}" % (index, adv, w, h, ox, oy))
+        index += len(data)
+    if fmt != FMT_PLAIN:
+        parts.append(("/* 解码时可能多读 1 字节 */", b"\0"))
+
+    # 每个字形前是注释，数据行之间用逗号连接，最后一个数据行不带逗号
+    last = max((k for k, (_, data) in enumerate(parts) if data), default=-1)
+    bitmap = []
+    for k, (comment, data) in enumerate(parts):
+        block = "    " + comment
+        if data:
+            block += "\n" + fmt_rows(["0x%x" % b for b in data]) + ("," if k < last else "")
+        bitmap.append(block)
+
+    lists, cmap_entries, gid = [], [], 1
+    for n, (kind, cps) in enumerate(cmaps):
+        if kind == "format0":
+            cmap_entries.append(
+                "    {\n        .range_start = %d, .range_length = %d, .glyph_id_start = %d,\n"
+                "        .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, "
+                ".type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY\n    }" % (cps[0], len(cps), gid))
+        else:
+            lists.append("static const uint16_t unicode_list_%d[] = {\n%s\n};\n"
+                         % (n, fmt_rows(["0x%x" % (cp - cps[0]) for cp in cps])))
+            cmap_entries.append(
+                "    {\n        .range_start = %d, .range_length = %d, .glyph_id_start = %d,\n"
+                "        .unicode_list = unicode_list_%d, .glyph_id_ofs_list = NULL, .list_length = %d, "
+                ".type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY\n    }"
+                % (cps[0], cps[-1] - cps[0] + 1, gid, n, len(cps)))
+        gid += len(cps)
+
+    text = font.text
+    head = text[:_array_body(text, "glyph_bitmap").start()]
+    tail = text[text.index("/*--------------------\n *  ALL CUSTOM DATA"):]
+    head = re.sub(r"^ \* Opts: .*$", lambda _: " * Opts: " + opts_line, head, count=1, flags=re.M)
+    tail = re.sub(r"\.cmap_num = \d+,", ".cmap_num = %d," % len(cmaps), tail)
+    tail = re.sub(r"\.bitmap_format = \d+,", ".bitmap_format = %d," % fmt, tail)
+
+    return (head
+            + "glyph_bitmap[] = {\n" + "\n\n".join(bitmap) + "\n};\n\n\n"
+            + "/*---------------------\n *  GLYPH DESCRIPTION\n *--------------------*/\n\n"
+            + "static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {\n"
+            + "    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0}"
+            + " /* id = 0 reserved */,\n" + ",\n".join(dsc_lines) + "\n};\n\n"
+            + "/*---------------------\n *  CHARACTER MAPPING\n *--------------------*/\n\n"
+            + "\n".join(lists)
+            + "\n/*Collect the unicode lists and glyph_id offsets*/\n"
+            + "static const lv_font_fmt_txt_cmap_t cmaps[] =\n{\n" + ",\n".join(cmap_entries) + "\n};\n\n\n\n"
+            + tail)
+
+
+def verify(original, path, keep):
+    """重新解析写出的文件，逐字形比较度量与像素"""
+    new = parse_font(path)
+    if set(new.cmap) != set(keep):
+        raise RuntimeError("%s: 码点集合不一致" % path)
+    for cp in keep:
+        a, b = original.glyphs[original.cmap[cp]], new.glyphs[new.cmap[cp]]
+        if a[1:] != b[1:] or glyph_pixels(original, original.cmap[cp]) != glyph_pixels(new, new.cmap[cp]):
+            raise RuntimeError("%s: U+%04X 校验失败" % (path, cp))
+    return new
+
+
+def opts_for(name, chars, fmt):
+    cfg = FONTS[name]
+    cjk = "".join(chr(cp) for cp in sorted(chars) if cp >= 0x80 or cfg["ascii"] == "literal")
+    opts = "--bpp %d --size %d %s --font %s --symbols %s" % (
+        BPP, cfg["size"], "--compress" if fmt != FMT_PLAIN else "--no-compress", TTF_NAME, cjk)
+    if cfg["ascii"] == "full":
+        opts += " --range 32-126"
+    return opts + " --format lvgl -o %s.c (font_subset.py)" % name
+
+
+# ------------------------------------------------------------------
+# 主流程
+# ------------------------------------------------------------------
+
+def font_compressed_enabled():
+    try:
+        text = open(LV_CONF, "rb").read().decode("gbk", "ignore")
+    except OSError:
+        return None
+    m = re.search(r"^#define\s+LV_USE_FONT_COMPRESSED\s+(\d+)", text, re.M)
+    return m and m.group(1) != "0"
+
+
+def run_lv_font_conv(name, chars, ttf, fmt):
+    cfg = FONTS[name]
+    tool = shutil.which("lv_font_conv")
+    cmd = [tool] if tool else ["npx", "lv_font_conv"]
+    symbols = "".join(chr(cp) for cp in sorted(chars) if cp >= 0x80 or cfg["ascii"] == "literal")
+    cmd += ["--bpp", str(BPP), "--size", str(cfg["size"]),
+            "--compress" if fmt != FMT_PLAIN else "--no-compress",
+            "--font", ttf, "--symbols", symbols]
+    if cfg["ascii"] == "full":
+        cmd += ["--range", "32-126"]
+    cmd += ["--format", "lvgl", "-o", os.path.join(HERE, name + ".c")]
+    subprocess.check_call(cmd)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="按界面用到的字符裁剪 LVGL 字体")
+    parser.add_argument("--src", action="append", help="扫描的源码目录 (默认 GUI_APP，可重复)")
+    parser.add_argument("--check", action="store_true", help="有缺失字形时返回 1")
+    parser.add_argument("--trim", action="store_true", help="从现有 .c 中删去多余字形")
+    parser.add_argument("--compress", action="store_true", help="输出 LVGL 压缩位图")
+    parser.add_argument("--ttf", help="用 lv_font_conv 和该字体文件重新生成")
+    parser.add_argument("fonts", nargs="*", help="只处理这些字体 (默认全部)")
+    args = parser.parse_args()
+
+    fmt = FMT_COMPRESSED if args.compress else FMT_PLAIN
+    if args.compress and not font_compressed_enabled():
+        print("错误: lv_conf.h 中 LV_USE_FONT_COMPRESSED 为 0，压缩字体将无法显示")
+        return 2
+
+    usage = collect_usage(args.src or [GUI_DIR])
+    missing_total = 0
+    for name in args.fonts or sorted(FONTS):
+        path = os.path.join(HERE, name + ".c")
+        font = parse_font(path)
+        used = usage[name]
+        have = set(font.cmap)
+        missing = sorted(used - have)
+        unused = sorted(have - used)
+        keep = sorted(used & have)
+        missing_total += len(missing)
+
+        print("%s: 需要 %d, 已有 %d, 缺失 %d, 多余 %d" % (name, len(used), len(have), len(missing), len(unused)))
+        if missing:
+            print("  缺失: %s" % " ".join("%s(U+%04X)" % (chr(c), c) for c in missing))
+        if unused:
+            print("  多余: %s" % "".join(chr(c) if 0x20 < c < 0x7F or c > 0xA0 else "\\x%02x" % c for c in unused))
+
+        if args.ttf:
+            run_lv_font_conv(name, used, args.ttf, fmt)
+        elif args.trim and (unused or fmt != font.bitmap_format):
+            with open(path, "w", encoding="utf-8", newline="\n") as f:
+                f.write(render_font(font, keep, fmt, opts_for(name, keep, fmt)))
+            new = verify(font, path, keep)
+            print("  已写出: 位图 %d -> %d 字节, 字形 %d -> %d" % (
+                len(font.bitmap), len(new.bitmap), len(font.glyphs) - 1, len(new.glyphs) - 1))
+
+    if args.check and missing_total:
+        print("存在缺失字形，请用 --ttf 重新生成字体")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,7 +1,7 @@
 /*******************************************************************************
  * Size: 18 px
  * Bpp: 4
- * Opts: --bpp 4 --size 18 --no-compress --stride 1 --align 1 --font 微软雅黑.ttf --symbols 登录失败账号或密码错误请重试成功,! --format lvgl -o my_font_yahei_18.c
+ * Opts: --bpp 4 --size 18 --no-compress --font 微软雅黑.ttf --symbols !,号失密录或登码试误请败账重错 --format lvgl -o my_font_yahei_18.c (font_subset.py)
  ******************************************************************************/
 
 #ifdef __has_include
@@ -41,28 +41,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x7, 0xb0, 0xd, 0xb0, 0x1f, 0x60, 0x4f, 0x10,
     0x8c, 0x0,
 
-    /* U+529F "功" */
-    0x0, 0x0, 0x0, 0x0, 0x2, 0xd2, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x3f, 0x30, 0x0,
-    0x0, 0xcf, 0xff, 0xff, 0xf5, 0x3, 0xf2, 0x0,
-    0x0, 0x4, 0x66, 0xf9, 0x66, 0x43, 0x5f, 0x53,
-    0x33, 0x31, 0x0, 0x1f, 0x50, 0x3f, 0xff, 0xff,
-    0xff, 0xff, 0x80, 0x1, 0xf5, 0x0, 0x22, 0x6f,
-    0x42, 0x22, 0xe8, 0x0, 0x1f, 0x50, 0x0, 0x5,
-    0xf1, 0x0, 0xe, 0x70, 0x1, 0xf5, 0x0, 0x0,
-    0x6f, 0x0, 0x0, 0xf7, 0x0, 0x1f, 0x50, 0x0,
-    0x7, 0xe0, 0x0, 0xf, 0x60, 0x1, 0xf5, 0x0,
-    0x0, 0xac, 0x0, 0x0, 0xf6, 0x0, 0x1f, 0x50,
-    0x0, 0xe, 0x80, 0x0, 0xf, 0x50, 0x1, 0xf9,
-    0x9d, 0x45, 0xf3, 0x0, 0x1, 0xf5, 0x69, 0xdf,
-    0xfd, 0x92, 0xdc, 0x0, 0x0, 0x1f, 0x4c, 0xea,
-    0x61, 0x0, 0x8f, 0x40, 0x0, 0x2, 0xf3, 0x10,
-    0x0, 0x0, 0x6f, 0x90, 0x0, 0x0, 0x4f, 0x20,
-    0x0, 0x0, 0x9f, 0xa0, 0x6, 0x87, 0x7d, 0xe0,
-    0x0, 0x0, 0x7f, 0x80, 0x0, 0x8f, 0xff, 0xe4,
-    0x0, 0x0, 0x0, 0x20, 0x0, 0x0, 0x0, 0x0,
-    0x0,
-
     /* U+53F7 "号" */
     0x0, 0x1, 0x22, 0x22, 0x22, 0x22, 0x22, 0x20,
     0x0, 0x0, 0xc, 0xff, 0xff, 0xff, 0xff, 0xff,
@@ -154,30 +132,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0,
 
-    /* U+6210 "成" */
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xf6, 0xc,
-    0x50, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xf6,
-    0x6, 0xfb, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0xf7, 0x0, 0x28, 0x0, 0x0, 0xef, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xf7, 0x0, 0xea, 0x55,
-    0x55, 0x55, 0xea, 0x55, 0x55, 0x52, 0x0, 0xe7,
-    0x0, 0x0, 0x0, 0xd8, 0x0, 0x0, 0x0, 0x0,
-    0xe7, 0x0, 0x0, 0x0, 0xc9, 0x0, 0xa, 0x20,
-    0x0, 0xef, 0xff, 0xff, 0x80, 0xab, 0x0, 0x6f,
-    0x30, 0x0, 0xfa, 0x55, 0x5e, 0x70, 0x9c, 0x0,
-    0xdb, 0x0, 0x0, 0xf6, 0x0, 0xe, 0x70, 0x7f,
-    0x6, 0xf3, 0x0, 0x1, 0xf4, 0x0, 0xf, 0x60,
-    0x4f, 0x3e, 0xa0, 0x0, 0x3, 0xf3, 0x0, 0xf,
-    0x50, 0x1f, 0xee, 0x10, 0x0, 0x6, 0xf0, 0x0,
-    0x1f, 0x40, 0xc, 0xf4, 0x0, 0x55, 0xb, 0xc1,
-    0x43, 0x9f, 0x10, 0x6f, 0xf3, 0x0, 0xab, 0x1f,
-    0x61, 0xff, 0xf8, 0x8, 0xf9, 0xdd, 0x10, 0xd8,
-    0x9f, 0x10, 0x12, 0x11, 0xcf, 0x70, 0x2e, 0xda,
-    0xf4, 0x87, 0x0, 0x0, 0x0, 0x84, 0x0, 0x2,
-    0xbe, 0xb0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0,
-
     /* U+6216 "或" */
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xe, 0x80,
@@ -418,22 +372,20 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
     {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} /* id = 0 reserved */,
     {.bitmap_index = 0, .adv_w = 90, .box_w = 3, .box_h = 14, .ofs_x = 1, .ofs_y = 0},
     {.bitmap_index = 21, .adv_w = 69, .box_w = 4, .box_h = 5, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 31, .adv_w = 288, .box_w = 17, .box_h = 18, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 184, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 346, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 508, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -2},
-    {.bitmap_index = 670, .adv_w = 288, .box_w = 18, .box_h = 17, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 823, .adv_w = 288, .box_w = 18, .box_h = 19, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 994, .adv_w = 288, .box_w = 19, .box_h = 19, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 1175, .adv_w = 288, .box_w = 19, .box_h = 17, .ofs_x = 0, .ofs_y = -2},
-    {.bitmap_index = 1337, .adv_w = 288, .box_w = 18, .box_h = 17, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 31, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 193, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 355, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -2},
+    {.bitmap_index = 517, .adv_w = 288, .box_w = 18, .box_h = 17, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 670, .adv_w = 288, .box_w = 19, .box_h = 19, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 851, .adv_w = 288, .box_w = 19, .box_h = 17, .ofs_x = 0, .ofs_y = -2},
+    {.bitmap_index = 1013, .adv_w = 288, .box_w = 18, .box_h = 17, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 1166, .adv_w = 288, .box_w = 18, .box_h = 17, .ofs_x = 0, .ofs_y = -2},
+    {.bitmap_index = 1319, .adv_w = 288, .box_w = 19, .box_h = 18, .ofs_x = 0, .ofs_y = -3},
     {.bitmap_index = 1490, .adv_w = 288, .box_w = 18, .box_h = 17, .ofs_x = 0, .ofs_y = -2},
-    {.bitmap_index = 1643, .adv_w = 288, .box_w = 19, .box_h = 18, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 1814, .adv_w = 288, .box_w = 18, .box_h = 17, .ofs_x = 0, .ofs_y = -2},
-    {.bitmap_index = 1967, .adv_w = 288, .box_w = 18, .box_h = 19, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 2138, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 2300, .adv_w = 288, .box_w = 18, .box_h = 17, .ofs_x = 0, .ofs_y = -2},
-    {.bitmap_index = 2453, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -2}
+    {.bitmap_index = 1643, .adv_w = 288, .box_w = 18, .box_h = 19, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 1814, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 1976, .adv_w = 288, .box_w = 18, .box_h = 17, .ofs_x = 0, .ofs_y = -2},
+    {.bitmap_index = 2129, .adv_w = 288, .box_w = 18, .box_h = 18, .ofs_x = 0, .ofs_y = -2}
 };
 
 /*---------------------
@@ -441,9 +393,8 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
  *--------------------*/
 
 static const uint16_t unicode_list_0[] = {
-    0x0, 0xb, 0x527e, 0x53d6, 0x5910, 0x5ba5, 0x5f34, 0x61ef,
-    0x61f5, 0x765a, 0x77e0, 0x8bb4, 0x8bce, 0x8bd6, 0x8d04, 0x8d05,
-    0x91ac, 0x94f8
+    0x0, 0xb, 0x53d6, 0x5910, 0x5ba5, 0x5f34, 0x61f5, 0x765a,
+    0x77e0, 0x8bb4, 0x8bce, 0x8bd6, 0x8d04, 0x8d05, 0x91ac, 0x94f8
 };
 
 /*Collect the unicode lists and glyph_id offsets*/
@@ -451,7 +402,7 @@ static const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
         .range_start = 33, .range_length = 38137, .glyph_id_start = 1,
-        .unicode_list = unicode_list_0, .glyph_id_ofs_list = NULL, .list_length = 18, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
+        .unicode_list = unicode_list_0, .glyph_id_ofs_list = NULL, .list_length = 16, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
     }
 };
 
@@ -1,7 +1,7 @@
 /*******************************************************************************
  * Size: 24 px
  * Bpp: 4
- * Opts: --bpp 4 --size 24 --no-compress --stride 1 --align 1 --font 微软雅黑.ttf --symbols 木三鸭主页数据显示与设备控制传感器置退确定取消温湿度光照烟名称自手动打开关闭列表更新时间颜色返回重槽位亮调节℃ --range 32-127 --format lvgl -o my_font_yahei_24.c
+ * Opts: --bpp 4 --size 24 --no-compress --font 微软雅黑.ttf --symbols ℃三与主亮传光关列制动名器回度感手据控数显木温湿烟照示置自色节表设调返重闭页颜鸭 --range 32-126 --format lvgl -o my_font_yahei_24.c (font_subset.py)
  ******************************************************************************/
 
 #ifdef __has_include
@@ -1408,8 +1408,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x3, 0xcf, 0xfc, 0xff, 0x60, 0x4f, 0x80, 0x0,
     0x5, 0xcf, 0xe7, 0x0,
 
-    /* U+007F "" */
-
     /* U+2103 "℃" */
     0x0, 0x1, 0x20, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x12, 0x31, 0x0, 0x0, 0x1b, 0xff, 0xe4, 0x0,
@@ -1626,44 +1624,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x7, 0xf5, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x10, 0x0, 0x0,
 
-    /* U+4F4D "位" */
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xd, 0x80,
-    0x0, 0x0, 0x8, 0xc0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x4f, 0xa0, 0x0, 0x0, 0xd, 0xf9,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x9f, 0x50,
-    0x0, 0x0, 0x3, 0xff, 0x60, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0xef, 0x0, 0x0, 0x0, 0x0, 0x8f,
-    0x60, 0x0, 0x0, 0x0, 0x0, 0x5, 0xfa, 0x2b,
-    0xbb, 0xbb, 0xbb, 0xbd, 0xbb, 0xbb, 0xbb, 0x90,
-    0x0, 0xc, 0xf4, 0x3f, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xd0, 0x0, 0x3f, 0xf1, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0xbf, 0xf1, 0x0, 0x4, 0x0, 0x0, 0x0,
-    0x0, 0x6, 0x40, 0x0, 0x2, 0xff, 0xf1, 0x0,
-    0xaf, 0x40, 0x0, 0x0, 0x0, 0xf, 0xf4, 0x0,
-    0xb, 0xff, 0xf1, 0x0, 0x5f, 0xa0, 0x0, 0x0,
-    0x0, 0x3f, 0xe0, 0x0, 0x5f, 0xdb, 0xf1, 0x0,
-    0xf, 0xf0, 0x0, 0x0, 0x0, 0x8f, 0xa0, 0x0,
-    0xcf, 0x5b, 0xf1, 0x0, 0xa, 0xf5, 0x0, 0x0,
-    0x0, 0xcf, 0x40, 0x0, 0x6b, 0xb, 0xf1, 0x0,
-    0x5, 0xfa, 0x0, 0x0, 0x1, 0xff, 0x0, 0x0,
-    0x11, 0xb, 0xf1, 0x0, 0x0, 0xff, 0x0, 0x0,
-    0x6, 0xfa, 0x0, 0x0, 0x0, 0xb, 0xf1, 0x0,
-    0x0, 0xbf, 0x40, 0x0, 0xa, 0xf4, 0x0, 0x0,
-    0x0, 0xb, 0xf1, 0x0, 0x0, 0x6f, 0xa0, 0x0,
-    0xf, 0xf0, 0x0, 0x0, 0x0, 0xb, 0xf1, 0x0,
-    0x0, 0x2f, 0xe0, 0x0, 0x4f, 0xa0, 0x0, 0x0,
-    0x0, 0xb, 0xf1, 0x0, 0x0, 0xd, 0xf3, 0x0,
-    0x9f, 0x50, 0x0, 0x0, 0x0, 0xb, 0xf1, 0x0,
-    0x0, 0x2, 0x0, 0x0, 0xef, 0x0, 0x0, 0x0,
-    0x0, 0xb, 0xf1, 0x0, 0x0, 0x0, 0x0, 0x5,
-    0xfa, 0x0, 0x0, 0x0, 0x0, 0xb, 0xf1, 0x8c,
-    0xcc, 0xcc, 0xcc, 0xce, 0xfe, 0xcc, 0xcc, 0xc3,
-    0x0, 0xb, 0xf1, 0xaf, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xf4, 0x0, 0xb, 0xf1, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-
     /* U+5149 "光" */
     0x0, 0x0, 0x0, 0x0, 0x0, 0xa, 0xd1, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
@@ -1853,43 +1813,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0xaf, 0xff, 0xd4, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x35, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
 
-    /* U+53D6 "取" */
-    0x4d, 0xdd, 0xdd, 0xdd, 0xdd, 0xdd, 0x20, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x4d, 0xef, 0xdd, 0xdd,
-    0xdf, 0xed, 0xff, 0xff, 0xff, 0xff, 0xff, 0x60,
-    0x0, 0x8f, 0x30, 0x0, 0x3f, 0x80, 0xaf, 0xd9,
-    0x99, 0x99, 0xcf, 0x60, 0x0, 0x8f, 0x30, 0x0,
-    0x3f, 0x80, 0xf, 0xa0, 0x0, 0x0, 0x8f, 0x30,
-    0x0, 0x8f, 0x30, 0x0, 0x3f, 0x80, 0xe, 0xc0,
-    0x0, 0x0, 0xaf, 0x0, 0x0, 0x8f, 0xa8, 0x88,
-    0xaf, 0x80, 0xc, 0xd0, 0x0, 0x0, 0xed, 0x0,
-    0x0, 0x8f, 0xff, 0xff, 0xff, 0x80, 0xa, 0xf0,
-    0x0, 0x1, 0xfa, 0x0, 0x0, 0x8f, 0x30, 0x0,
-    0x3f, 0x80, 0x7, 0xf4, 0x0, 0x5, 0xf6, 0x0,
-    0x0, 0x8f, 0x30, 0x0, 0x3f, 0x80, 0x3, 0xf7,
-    0x0, 0x9, 0xf2, 0x0, 0x0, 0x8f, 0x30, 0x0,
-    0x3f, 0x80, 0x0, 0xfb, 0x0, 0xe, 0xd0, 0x0,
-    0x0, 0x8f, 0x98, 0x88, 0x9f, 0x80, 0x0, 0xbf,
-    0x10, 0x3f, 0x80, 0x0, 0x0, 0x8f, 0xff, 0xff,
-    0xff, 0x80, 0x0, 0x5f, 0x60, 0x9f, 0x30, 0x0,
-    0x0, 0x8f, 0x30, 0x0, 0x3f, 0x80, 0x0, 0xf,
-    0xd1, 0xfc, 0x0, 0x0, 0x0, 0x8f, 0x30, 0x0,
-    0x3f, 0x80, 0x0, 0x9, 0xfc, 0xf5, 0x0, 0x0,
-    0x0, 0x8f, 0x30, 0x0, 0x3f, 0x80, 0x20, 0x1,
-    0xff, 0xc0, 0x0, 0x0, 0x0, 0x8f, 0x32, 0x46,
-    0xaf, 0xff, 0xf2, 0x1, 0xef, 0xa0, 0x0, 0x0,
-    0x49, 0xdf, 0xff, 0xff, 0xff, 0xd8, 0x60, 0xb,
-    0xfe, 0xf7, 0x0, 0x0, 0x8f, 0xfc, 0xa7, 0x52,
-    0x3f, 0x80, 0x0, 0xaf, 0x91, 0xef, 0x60, 0x0,
-    0x12, 0x0, 0x0, 0x0, 0x3f, 0x80, 0xb, 0xfb,
-    0x0, 0x3f, 0xf8, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x3f, 0x83, 0xdf, 0xb0, 0x0, 0x4, 0xff, 0xb2,
-    0x0, 0x0, 0x0, 0x0, 0x3f, 0xcf, 0xf9, 0x0,
-    0x0, 0x0, 0x4f, 0xf4, 0x0, 0x0, 0x0, 0x0,
-    0x3f, 0x8a, 0x60, 0x0, 0x0, 0x0, 0x2, 0x60,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0,
-
     /* U+540D "名" */
     0x0, 0x0, 0x0, 0x0, 0x48, 0x20, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x2, 0xef,
@@ -1992,82 +1915,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0xe0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
     0xc, 0xf3,
 
-    /* U+5907 "备" */
-    0x0, 0x0, 0x0, 0x3, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5f,
-    0xb0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x1, 0xef, 0x30, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xb, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x0,
-    0x0, 0x0, 0x9f, 0xfe, 0x99, 0x99, 0x99, 0x99,
-    0x9a, 0xff, 0x70, 0x0, 0x0, 0x8, 0xfd, 0xcf,
-    0x60, 0x0, 0x0, 0x0, 0x2d, 0xfb, 0x0, 0x0,
-    0x0, 0x8f, 0xe1, 0x1e, 0xf8, 0x0, 0x0, 0x6,
-    0xff, 0xa0, 0x0, 0x0, 0xa, 0xfe, 0x20, 0x1,
-    0xdf, 0xc3, 0x3, 0xbf, 0xf7, 0x0, 0x0, 0x0,
-    0x9, 0xd1, 0x0, 0x0, 0x9, 0xff, 0xcf, 0xfc,
-    0x20, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x27, 0xef, 0xff, 0xf9, 0x40, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x14, 0x8d, 0xff, 0xfa, 0x5a, 0xff,
-    0xff, 0xda, 0x86, 0x53, 0x37, 0xad, 0xff, 0xff,
-    0xb6, 0x10, 0x0, 0x5, 0x9d, 0xff, 0xff, 0xf8,
-    0x3f, 0xff, 0xc8, 0x40, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x14, 0x79, 0xa0, 0x4, 0x22, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x80, 0x0,
-    0x0, 0x2, 0xfc, 0x77, 0x77, 0x7c, 0xf7, 0x77,
-    0x77, 0x8f, 0x90, 0x0, 0x0, 0x2, 0xf9, 0x0,
-    0x0, 0xa, 0xf1, 0x0, 0x0, 0x2f, 0x90, 0x0,
-    0x0, 0x2, 0xf9, 0x0, 0x0, 0xa, 0xf1, 0x0,
-    0x0, 0x2f, 0x90, 0x0, 0x0, 0x2, 0xfb, 0x66,
-    0x66, 0x6c, 0xf6, 0x66, 0x66, 0x7f, 0x90, 0x0,
-    0x0, 0x2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0x90, 0x0, 0x0, 0x2, 0xf9, 0x0,
-    0x0, 0xa, 0xf1, 0x0, 0x0, 0x2f, 0x90, 0x0,
-    0x0, 0x2, 0xf9, 0x0, 0x0, 0xa, 0xf1, 0x0,
-    0x0, 0x2f, 0x90, 0x0, 0x0, 0x2, 0xfb, 0x66,
-    0x66, 0x6c, 0xf6, 0x66, 0x66, 0x7f, 0x90, 0x0,
-    0x0, 0x2, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0x90, 0x0, 0x0, 0x2, 0xf9, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x2f, 0x90, 0x0,
-
-    /* U+5B9A "定" */
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x2b, 0x60, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x6f, 0xf4, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0xa, 0xfa, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x5, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x70,
-    0x5, 0xfd, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb,
-    0xbb, 0xbb, 0xdf, 0x70, 0x5, 0xf8, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x6f, 0x70,
-    0x5, 0xf8, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x6f, 0x70, 0x1, 0x63, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x26, 0x20,
-    0x1b, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb,
-    0xbb, 0xbb, 0xbb, 0xb1, 0x2f, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf1,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x7, 0xf8, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x14, 0x10,
-    0x0, 0x7, 0xf8, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x5f, 0xa0, 0x0, 0x7, 0xf8, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x8f, 0x80,
-    0x0, 0x7, 0xf8, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0xbf, 0x40, 0x0, 0x7, 0xff, 0xff,
-    0xff, 0xff, 0xfa, 0x0, 0x0, 0x0, 0xff, 0x0,
-    0x0, 0x7, 0xfd, 0xbb, 0xbb, 0xbb, 0xb7, 0x0,
-    0x0, 0x5, 0xff, 0x30, 0x0, 0x7, 0xf8, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0xc, 0xff, 0xd0,
-    0x0, 0x7, 0xf8, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x6f, 0xd7, 0xfc, 0x10, 0x7, 0xf8, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x2, 0xef, 0x40, 0xaf,
-    0xe7, 0x17, 0xf8, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x1d, 0xfb, 0x0, 0x7, 0xff, 0xff, 0xfd, 0xbb,
-    0xba, 0xab, 0xbb, 0xc6, 0x7f, 0xd1, 0x0, 0x0,
-    0x28, 0xdf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf3,
-    0xb, 0x10, 0x0, 0x0, 0x0, 0x0, 0x1, 0x12,
-    0x22, 0x22, 0x22, 0x20, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-
     /* U+5EA6 "度" */
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
@@ -2108,43 +1955,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x1, 0x0, 0x12, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0,
 
-    /* U+5F00 "开" */
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0xb, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x50,
-    0x9, 0xdd, 0xdd, 0xef, 0xdd, 0xdd, 0xdd, 0xde,
-    0xfe, 0xdd, 0xdd, 0x40, 0x0, 0x0, 0x0, 0xaf,
-    0x40, 0x0, 0x0, 0x6, 0xf8, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0xaf, 0x40, 0x0, 0x0, 0x6,
-    0xf8, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xaf,
-    0x40, 0x0, 0x0, 0x6, 0xf8, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0xaf, 0x40, 0x0, 0x0, 0x6,
-    0xf8, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xaf,
-    0x40, 0x0, 0x0, 0x6, 0xf8, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0xaf, 0x40, 0x0, 0x0, 0x6,
-    0xf8, 0x0, 0x0, 0x0, 0x9c, 0xcc, 0xcc, 0xef,
-    0xdc, 0xcc, 0xcc, 0xce, 0xfe, 0xcc, 0xcc, 0xc3,
-    0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xf5, 0x1, 0x11, 0x11, 0xbf,
-    0x41, 0x11, 0x11, 0x16, 0xf8, 0x11, 0x11, 0x10,
-    0x0, 0x0, 0x0, 0xbf, 0x30, 0x0, 0x0, 0x6,
-    0xf8, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xdf,
-    0x10, 0x0, 0x0, 0x6, 0xf8, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0xff, 0x0, 0x0, 0x0, 0x6,
-    0xf8, 0x0, 0x0, 0x0, 0x0, 0x0, 0x4, 0xfc,
-    0x0, 0x0, 0x0, 0x6, 0xf8, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0xa, 0xf7, 0x0, 0x0, 0x0, 0x6,
-    0xf8, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5f, 0xf1,
-    0x0, 0x0, 0x0, 0x6, 0xf8, 0x0, 0x0, 0x0,
-    0x0, 0x6, 0xff, 0x70, 0x0, 0x0, 0x0, 0x6,
-    0xf8, 0x0, 0x0, 0x0, 0x1, 0x9f, 0xf9, 0x0,
-    0x0, 0x0, 0x0, 0x6, 0xf8, 0x0, 0x0, 0x0,
-    0x3e, 0xff, 0x70, 0x0, 0x0, 0x0, 0x0, 0x6,
-    0xf8, 0x0, 0x0, 0x0, 0xd, 0xd3, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x6, 0xf8, 0x0, 0x0, 0x0,
-    0x1, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0,
-
     /* U+611F "感" */
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
@@ -2220,44 +2030,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x0, 0x0, 0x0, 0xcf, 0xff, 0xfc, 0x40, 0x0,
     0x0, 0x0, 0x0, 0x0,
 
-    /* U+6253 "打" */
-    0x0, 0x0, 0x38, 0x30, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x7f, 0x70,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x7f, 0x70, 0x0, 0xcf, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xfe, 0x0, 0x0, 0x7f, 0x70,
-    0x0, 0xbd, 0xdd, 0xdd, 0xdd, 0xff, 0xdd, 0xdc,
-    0x0, 0x0, 0x7f, 0x70, 0x0, 0x0, 0x0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x4f, 0xff, 0xff, 0xff,
-    0xfe, 0x0, 0x0, 0x0, 0x1, 0xfe, 0x0, 0x0,
-    0x3b, 0xbb, 0xdf, 0xdb, 0xba, 0x0, 0x0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x0, 0x0, 0x7f, 0x70,
-    0x0, 0x0, 0x0, 0x0, 0x1, 0xfe, 0x0, 0x0,
-    0x0, 0x0, 0x7f, 0x70, 0x0, 0x0, 0x0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x0, 0x0, 0x7f, 0x70,
-    0x0, 0x0, 0x0, 0x0, 0x1, 0xfe, 0x0, 0x0,
-    0x0, 0x0, 0x7f, 0x70, 0x17, 0x20, 0x0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x0, 0x0, 0x7f, 0xbc,
-    0xff, 0x40, 0x0, 0x0, 0x1, 0xfe, 0x0, 0x0,
-    0x0, 0x5, 0xcf, 0xff, 0xd7, 0x10, 0x0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x4b, 0xff, 0xff, 0xb3,
-    0x0, 0x0, 0x0, 0x0, 0x1, 0xfe, 0x0, 0x0,
-    0x6f, 0xfa, 0xaf, 0x70, 0x0, 0x0, 0x0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x16, 0x10, 0x7f, 0x70,
-    0x0, 0x0, 0x0, 0x0, 0x1, 0xfe, 0x0, 0x0,
-    0x0, 0x0, 0x7f, 0x70, 0x0, 0x0, 0x0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x0, 0x0, 0x7f, 0x70,
-    0x0, 0x0, 0x0, 0x0, 0x1, 0xfe, 0x0, 0x0,
-    0x0, 0x0, 0x7f, 0x70, 0x0, 0x0, 0x0, 0x0,
-    0x1, 0xfe, 0x0, 0x0, 0x0, 0x0, 0x7f, 0x70,
-    0x0, 0x0, 0x0, 0x0, 0x1, 0xfe, 0x0, 0x0,
-    0x0, 0x0, 0x8f, 0x60, 0x0, 0x0, 0x11, 0x0,
-    0x7, 0xfd, 0x0, 0x0, 0xc, 0xdd, 0xff, 0x40,
-    0x0, 0x0, 0x8f, 0xff, 0xff, 0xf8, 0x0, 0x0,
-    0xc, 0xff, 0xf9, 0x0, 0x0, 0x0, 0x5f, 0xff,
-    0xfe, 0x90, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-
     /* U+636E "据" */
     0x0, 0x4, 0xb4, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x6, 0xf5, 0x0,
@@ -2372,83 +2144,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x0, 0x0, 0x3, 0xd1, 0x1, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x10, 0x0, 0x0, 0x0, 0x0, 0x0,
 
-    /* U+65B0 "新" */
-    0x0, 0x0, 0x0, 0x10, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xd, 0xb0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0xa, 0xf4, 0x0, 0x0, 0x2, 0x34,
-    0x56, 0x8a, 0xdf, 0x60, 0x17, 0x77, 0x79, 0xfa,
-    0x77, 0x76, 0xb, 0xff, 0xff, 0xff, 0xfd, 0x80,
-    0x2f, 0xff, 0xff, 0xff, 0xff, 0xfd, 0xb, 0xf7,
-    0x64, 0x31, 0x0, 0x0, 0x0, 0x25, 0x0, 0x0,
-    0x7, 0x10, 0xb, 0xe0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0xbf, 0x20, 0x0, 0x5f, 0xc0, 0xb, 0xe0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x2f, 0xd0, 0x1,
-    0xef, 0x20, 0xb, 0xe0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x7, 0xa0, 0x9, 0xf5, 0x0, 0xb, 0xe0,
-    0x0, 0x0, 0x0, 0x0, 0xdf, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0x6b, 0xe0, 0x0, 0x0, 0x0, 0x0,
-    0xbc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0x5b, 0xff,
-    0xff, 0xff, 0xff, 0xf7, 0x0, 0x0, 0x2, 0x51,
-    0x0, 0x0, 0xb, 0xfa, 0xaa, 0xef, 0xaa, 0xa4,
-    0x0, 0x0, 0x7, 0xf3, 0x0, 0x0, 0xb, 0xe0,
-    0x0, 0xaf, 0x10, 0x0, 0x17, 0x77, 0x7b, 0xf9,
-    0x77, 0x76, 0xc, 0xe0, 0x0, 0xaf, 0x10, 0x0,
-    0x3f, 0xff, 0xff, 0xff, 0xff, 0xfd, 0xd, 0xd0,
-    0x0, 0xaf, 0x10, 0x0, 0x0, 0x0, 0x7, 0xf4,
-    0x0, 0x0, 0xe, 0xc0, 0x0, 0xaf, 0x10, 0x0,
-    0x0, 0x76, 0x7, 0xf3, 0x25, 0x0, 0xf, 0xa0,
-    0x0, 0xaf, 0x10, 0x0, 0x1, 0xfe, 0x7, 0xf3,
-    0xdf, 0x20, 0x3f, 0x60, 0x0, 0xaf, 0x10, 0x0,
-    0x7, 0xf6, 0x7, 0xf3, 0x4f, 0xd0, 0x7f, 0x30,
-    0x0, 0xaf, 0x10, 0x0, 0x1e, 0xe0, 0x7, 0xf3,
-    0xa, 0xf6, 0xde, 0x0, 0x0, 0xaf, 0x10, 0x0,
-    0x8f, 0x60, 0x7, 0xf3, 0x1, 0x83, 0xf8, 0x0,
-    0x0, 0xaf, 0x10, 0x0, 0x4b, 0x0, 0x8, 0xf3,
-    0x0, 0xc, 0xf2, 0x0, 0x0, 0xaf, 0x10, 0x0,
-    0x0, 0x7b, 0xaf, 0xf1, 0x0, 0x7f, 0x80, 0x0,
-    0x0, 0xaf, 0x10, 0x0, 0x0, 0x7f, 0xfe, 0x60,
-    0x0, 0x3c, 0x0, 0x0, 0x0, 0xaf, 0x10, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0,
-
-    /* U+65F6 "时" */
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x6, 0xa2, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x9f, 0x40, 0x0, 0x8b,
-    0xbb, 0xbb, 0xbb, 0x10, 0x0, 0x0, 0x0, 0x9,
-    0xf4, 0x0, 0xc, 0xff, 0xff, 0xff, 0xf1, 0x0,
-    0x0, 0x0, 0x0, 0x9f, 0x40, 0x0, 0xcf, 0x10,
-    0x0, 0xcf, 0x10, 0x0, 0x0, 0x0, 0x9, 0xf4,
-    0x0, 0xc, 0xf1, 0x0, 0xc, 0xf1, 0xbc, 0xcc,
-    0xcc, 0xcc, 0xef, 0xdc, 0xc7, 0xcf, 0x10, 0x0,
-    0xcf, 0x1e, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0x9c, 0xf1, 0x0, 0xc, 0xf1, 0x0, 0x0, 0x0,
-    0x0, 0x9f, 0x40, 0x0, 0xcf, 0x10, 0x0, 0xcf,
-    0x10, 0x0, 0x0, 0x0, 0x9, 0xf4, 0x0, 0xc,
-    0xf1, 0x0, 0xc, 0xf1, 0x2, 0x90, 0x0, 0x0,
-    0x9f, 0x40, 0x0, 0xcf, 0xff, 0xff, 0xff, 0x10,
-    0xbf, 0x60, 0x0, 0x9, 0xf4, 0x0, 0xc, 0xfa,
-    0xaa, 0xae, 0xf1, 0x4, 0xfe, 0x0, 0x0, 0x9f,
-    0x40, 0x0, 0xcf, 0x10, 0x0, 0xcf, 0x10, 0xc,
-    0xf6, 0x0, 0x9, 0xf4, 0x0, 0xc, 0xf1, 0x0,
-    0xc, 0xf1, 0x0, 0x5f, 0xe0, 0x0, 0x9f, 0x40,
-    0x0, 0xcf, 0x10, 0x0, 0xcf, 0x10, 0x0, 0xdf,
-    0x50, 0x9, 0xf4, 0x0, 0xc, 0xf1, 0x0, 0xc,
-    0xf1, 0x0, 0x5, 0x40, 0x0, 0x9f, 0x40, 0x0,
-    0xcf, 0x10, 0x0, 0xcf, 0x10, 0x0, 0x0, 0x0,
-    0x9, 0xf4, 0x0, 0xc, 0xf2, 0x11, 0x1c, 0xf1,
-    0x0, 0x0, 0x0, 0x0, 0x9f, 0x40, 0x0, 0xcf,
-    0xff, 0xff, 0xff, 0x10, 0x0, 0x0, 0x0, 0x9,
-    0xf4, 0x0, 0xc, 0xfa, 0xaa, 0xae, 0xf1, 0x0,
-    0x0, 0x0, 0x0, 0xaf, 0x40, 0x0, 0xcf, 0x10,
-    0x0, 0xcf, 0x10, 0x0, 0x0, 0x0, 0xd, 0xf2,
-    0x0, 0x8, 0xa0, 0x0, 0x4, 0x60, 0x0, 0xe,
-    0xed, 0xdf, 0xfe, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0xcf, 0xff, 0xfc, 0x30, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0,
-
     /* U+663E "显" */
     0x0, 0x7, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
     0xff, 0xff, 0xe0, 0x0, 0x0, 0x7, 0xfd, 0xbb,
@@ -2484,43 +2179,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0xff, 0xff, 0xff, 0xfa, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
 
-    /* U+66F4 "更" */
-    0x6, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb, 0xbb,
-    0xbb, 0xbb, 0xbb, 0xa0, 0x9, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xe0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x7, 0xf4, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x8, 0xf4, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0xb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xf1, 0x0, 0x0, 0xb, 0xf9, 0x99,
-    0x99, 0x9c, 0xfb, 0x99, 0x99, 0x9d, 0xf1, 0x0,
-    0x0, 0xb, 0xf0, 0x0, 0x0, 0x8, 0xf4, 0x0,
-    0x0, 0xb, 0xf1, 0x0, 0x0, 0xb, 0xf0, 0x0,
-    0x0, 0x8, 0xf4, 0x0, 0x0, 0xb, 0xf1, 0x0,
-    0x0, 0xb, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xf1, 0x0, 0x0, 0xb, 0xfa, 0xaa,
-    0xaa, 0xad, 0xfb, 0xaa, 0xaa, 0xae, 0xf1, 0x0,
-    0x0, 0xb, 0xf0, 0x0, 0x0, 0xa, 0xf2, 0x0,
-    0x0, 0xb, 0xf1, 0x0, 0x0, 0xb, 0xf0, 0x0,
-    0x0, 0xb, 0xf1, 0x0, 0x0, 0xb, 0xf1, 0x0,
-    0x0, 0xb, 0xfa, 0xaa, 0xaa, 0xae, 0xfa, 0xaa,
-    0xaa, 0xae, 0xf1, 0x0, 0x0, 0xb, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf1, 0x0,
-    0x0, 0x0, 0xa9, 0x0, 0x0, 0x3f, 0x90, 0x0,
-    0x0, 0xa, 0xf1, 0x0, 0x0, 0x0, 0x9f, 0x80,
-    0x0, 0x9f, 0x40, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0xc, 0xf9, 0x2, 0xfe, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1, 0xcf,
-    0xde, 0xf6, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0xd, 0xff, 0xf6, 0x10, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5, 0xcf,
-    0xfe, 0xff, 0xfc, 0x95, 0x31, 0x0, 0x0, 0x0,
-    0x3, 0x6a, 0xff, 0xfc, 0x30, 0x4a, 0xef, 0xff,
-    0xff, 0xfe, 0xdc, 0xc8, 0x2f, 0xff, 0xe9, 0x30,
-    0x0, 0x0, 0x2, 0x58, 0xac, 0xef, 0xff, 0xf3,
-    0x6, 0x83, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x1, 0x10,
-
     /* U+6728 "木" */
     0x0, 0x0, 0x0, 0x0, 0x0, 0x18, 0x50, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
@@ -2558,79 +2216,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x0, 0x0, 0x0, 0x0, 0x0, 0x2f, 0xb0, 0x0,
     0x0, 0x0, 0x0, 0x0,
 
-    /* U+69FD "槽" */
-    0x0, 0x3, 0xe5, 0x0, 0x0, 0x0, 0x2e, 0x30,
-    0xe, 0x60, 0x0, 0x0, 0x0, 0x4, 0xf5, 0x0,
-    0x0, 0x0, 0x3f, 0x40, 0xf, 0x60, 0x0, 0x0,
-    0x0, 0x4, 0xf5, 0x3, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xf7, 0x0, 0x4, 0xf5, 0x1,
-    0x77, 0x77, 0x8f, 0x97, 0x7f, 0xa7, 0x77, 0x73,
-    0x25, 0x57, 0xf8, 0x54, 0x0, 0x0, 0x3f, 0x40,
-    0xf, 0x60, 0x0, 0x0, 0x6f, 0xff, 0xff, 0xfe,
-    0x4e, 0xee, 0xef, 0xee, 0xef, 0xee, 0xee, 0x70,
-    0x13, 0x3a, 0xf7, 0x32, 0x5f, 0x76, 0x8f, 0x86,
-    0x6f, 0xa6, 0x6f, 0x80, 0x0, 0xd, 0xf5, 0x0,
-    0x5f, 0x20, 0x3f, 0x40, 0xf, 0x60, 0xf, 0x80,
-    0x0, 0x1f, 0xf5, 0x0, 0x5f, 0x64, 0x6f, 0x74,
-    0x5f, 0x94, 0x4f, 0x80, 0x0, 0x6f, 0xf7, 0x30,
-    0x5f, 0xee, 0xef, 0xee, 0xef, 0xee, 0xef, 0x80,
-    0x0, 0xce, 0xff, 0xe2, 0x5f, 0x20, 0x3f, 0x40,
-    0xf, 0x60, 0xf, 0x80, 0x2, 0xf9, 0xf6, 0xee,
-    0x6f, 0x65, 0x7f, 0x75, 0x5f, 0x95, 0x5f, 0x80,
-    0x9, 0xf5, 0xf5, 0x39, 0x5f, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0x80, 0x1f, 0xa4, 0xf5, 0x0,
-    0x1, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1, 0x0,
-    0x8f, 0x34, 0xf5, 0x0, 0x3, 0x66, 0x66, 0x66,
-    0x66, 0x66, 0x64, 0x0, 0x6c, 0x4, 0xf5, 0x0,
-    0x9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfa, 0x0,
-    0x13, 0x4, 0xf5, 0x0, 0x9, 0xf0, 0x0, 0x0,
-    0x0, 0x0, 0xea, 0x0, 0x0, 0x4, 0xf5, 0x0,
-    0x9, 0xf5, 0x55, 0x55, 0x55, 0x55, 0xfa, 0x0,
-    0x0, 0x4, 0xf5, 0x0, 0x9, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xfa, 0x0, 0x0, 0x4, 0xf5, 0x0,
-    0x9, 0xf0, 0x0, 0x0, 0x0, 0x0, 0xea, 0x0,
-    0x0, 0x4, 0xf5, 0x0, 0x9, 0xf3, 0x33, 0x33,
-    0x33, 0x33, 0xfa, 0x0, 0x0, 0x4, 0xf5, 0x0,
-    0x9, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfa, 0x0,
-    0x0, 0x4, 0xf5, 0x0, 0x9, 0xf2, 0x22, 0x22,
-    0x22, 0x22, 0xea, 0x0,
-
-    /* U+6D88 "消" */
-    0x0, 0x30, 0x0, 0x0, 0x0, 0x0, 0x0, 0xac,
-    0x0, 0x0, 0x0, 0x0, 0x4f, 0xb0, 0x0, 0x2d,
-    0x70, 0x0, 0xd, 0xf1, 0x0, 0x3, 0xd3, 0x1,
-    0xcf, 0xd1, 0x2, 0xef, 0x60, 0x0, 0xdf, 0x10,
-    0x1, 0xef, 0xa0, 0x0, 0xbf, 0xe3, 0x3, 0xff,
-    0x50, 0xd, 0xf1, 0x0, 0xcf, 0xb0, 0x0, 0x0,
-    0xaf, 0x30, 0x5, 0xff, 0x10, 0xdf, 0x10, 0xbf,
-    0xc0, 0x0, 0x0, 0x0, 0x20, 0x0, 0x7, 0x50,
-    0xd, 0xf1, 0x5, 0xc1, 0x0, 0x2, 0x0, 0x0,
-    0x0, 0x22, 0x22, 0x22, 0xef, 0x32, 0x22, 0x22,
-    0x1, 0xec, 0x10, 0x0, 0x3f, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xf5, 0x1b, 0xfe, 0x40, 0x3,
-    0xfd, 0x99, 0x99, 0x99, 0x99, 0x99, 0xcf, 0x50,
-    0x8, 0xff, 0x70, 0x3f, 0xa0, 0x0, 0x0, 0x0,
-    0x0, 0x8, 0xf5, 0x0, 0x5, 0xe2, 0x3, 0xfa,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x8f, 0x50, 0x0,
-    0x0, 0x0, 0x3f, 0xeb, 0xbb, 0xbb, 0xbb, 0xbb,
-    0xbd, 0xf5, 0x0, 0x0, 0x0, 0x3, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0x50, 0x0, 0x75,
-    0x0, 0x3f, 0xa0, 0x0, 0x0, 0x0, 0x0, 0x8,
-    0xf5, 0x0, 0xe, 0xf2, 0x3, 0xfa, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x8f, 0x50, 0x2, 0xfe, 0x0,
-    0x3f, 0xa0, 0x0, 0x0, 0x0, 0x0, 0x8, 0xf5,
-    0x0, 0x5f, 0xa0, 0x3, 0xff, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0x50, 0x9, 0xf6, 0x0, 0x3f,
-    0xda, 0xaa, 0xaa, 0xaa, 0xaa, 0xad, 0xf5, 0x0,
-    0xdf, 0x30, 0x3, 0xfa, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x8f, 0x50, 0x2f, 0xf0, 0x0, 0x3f, 0xa0,
-    0x0, 0x0, 0x0, 0x0, 0x8, 0xf5, 0x6, 0xfb,
-    0x0, 0x3, 0xfa, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0xcf, 0x40, 0xaf, 0x70, 0x0, 0x3f, 0xa0, 0x0,
-    0x0, 0x9f, 0xff, 0xff, 0xf1, 0x6, 0xb3, 0x0,
-    0x3, 0xfa, 0x0, 0x0, 0x5, 0xde, 0xee, 0xc5,
-    0x0,
-
     /* U+6E29 "温" */
     0x0, 0x40, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x8, 0xfa, 0x0, 0x0,
@@ -2779,44 +2364,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x0, 0x0, 0x4, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
 
-    /* U+786E "确" */
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x5, 0xe5, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0xde, 0x0, 0x0,
-    0x0, 0x0, 0x1, 0xaa, 0xaa, 0xaa, 0xaa, 0x20,
-    0x8f, 0xda, 0xaa, 0xaa, 0xa4, 0x0, 0x1f, 0xff,
-    0xff, 0xff, 0xf4, 0x3f, 0xed, 0xdd, 0xdd, 0xff,
-    0x60, 0x0, 0x0, 0x2f, 0x80, 0x0, 0xd, 0xf2,
-    0x0, 0x0, 0x4f, 0xc0, 0x0, 0x0, 0x6, 0xf4,
-    0x0, 0xb, 0xf6, 0x0, 0x0, 0x1e, 0xe1, 0x0,
-    0x0, 0x0, 0xaf, 0x0, 0x9, 0xff, 0xaa, 0xaa,
-    0xad, 0xfc, 0xaa, 0xa7, 0x0, 0xf, 0xb0, 0x0,
-    0xcd, 0xbf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb0,
-    0x5, 0xf7, 0x22, 0x21, 0x1a, 0xf0, 0x0, 0x9f,
-    0x10, 0x0, 0xeb, 0x0, 0xbf, 0xff, 0xff, 0x40,
-    0xaf, 0x0, 0x9, 0xf1, 0x0, 0xe, 0xb0, 0x3f,
-    0xf9, 0x58, 0xf4, 0xa, 0xf0, 0x0, 0x9f, 0x10,
-    0x0, 0xeb, 0xa, 0xff, 0x50, 0x4f, 0x40, 0xaf,
-    0xff, 0xff, 0xff, 0xff, 0xff, 0xb3, 0xfd, 0xf5,
-    0x4, 0xf4, 0xa, 0xf8, 0x88, 0xcf, 0x98, 0x88,
-    0xfb, 0xaf, 0x5f, 0x50, 0x4f, 0x40, 0xaf, 0x0,
-    0x9, 0xf1, 0x0, 0xe, 0xb2, 0x73, 0xf5, 0x4,
-    0xf4, 0xb, 0xe0, 0x0, 0x9f, 0x10, 0x0, 0xeb,
-    0x0, 0x3f, 0x50, 0x4f, 0x40, 0xce, 0x44, 0x4b,
-    0xf5, 0x44, 0x4f, 0xb0, 0x3, 0xf5, 0x4, 0xf4,
-    0xe, 0xff, 0xff, 0xff, 0xff, 0xff, 0xfb, 0x0,
-    0x3f, 0x50, 0x4f, 0x41, 0xfb, 0x33, 0x3a, 0xf4,
-    0x33, 0x3f, 0xb0, 0x3, 0xff, 0xff, 0xf4, 0x5f,
-    0x60, 0x0, 0x9f, 0x10, 0x0, 0xeb, 0x0, 0x3f,
-    0xa8, 0x88, 0x2b, 0xf2, 0x0, 0x9, 0xf1, 0x0,
-    0xe, 0xb0, 0x3, 0xf5, 0x0, 0x2, 0xfd, 0x0,
-    0x0, 0x9f, 0x10, 0x0, 0xfb, 0x0, 0x15, 0x10,
-    0x0, 0xcf, 0x60, 0x0, 0x9, 0xf1, 0xaa, 0xcf,
-    0x90, 0x0, 0x0, 0x0, 0xc, 0xd0, 0x0, 0x0,
-    0x7c, 0xc, 0xff, 0xc1, 0x0, 0x0, 0x0, 0x0,
-    0x13, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-
     /* U+793A "示" */
     0x0, 0x7a, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
     0xaa, 0xaa, 0xa3, 0x0, 0x0, 0xbf, 0xff, 0xff,
@@ -2852,46 +2399,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x7f,
     0xff, 0xfc, 0x40, 0x0, 0x0, 0x0, 0x0, 0x0,
 
-    /* U+79F0 "称" */
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x5f, 0x70, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x23, 0x57, 0x9b, 0xea, 0x0, 0xcf, 0x30,
-    0x0, 0x0, 0x0, 0x0, 0x4f, 0xff, 0xff, 0xff,
-    0xd9, 0x3, 0xfc, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x1b, 0x97, 0xdf, 0x20, 0x0, 0xa, 0xfc, 0xaa,
-    0xaa, 0xaa, 0xaa, 0xa0, 0x0, 0x0, 0xbf, 0x0,
-    0x0, 0x2f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xf0,
-    0x0, 0x0, 0xbf, 0x0, 0x0, 0xbf, 0x40, 0x0,
-    0x0, 0x0, 0x5f, 0xc0, 0x0, 0x0, 0xbf, 0x0,
-    0x4, 0xfc, 0x0, 0x6, 0x50, 0x0, 0xbf, 0x50,
-    0x8f, 0xff, 0xff, 0xff, 0xfe, 0xf3, 0x0, 0xf,
-    0xd0, 0x2, 0xfe, 0x0, 0x5a, 0xaa, 0xef, 0xaa,
-    0xaa, 0x90, 0x0, 0xf, 0xd0, 0x3, 0xc7, 0x0,
-    0x0, 0x1, 0xff, 0x0, 0x0, 0x0, 0x0, 0xf,
-    0xd0, 0x0, 0x0, 0x0, 0x0, 0x6, 0xff, 0x41,
-    0x0, 0x6, 0x81, 0xf, 0xd0, 0x5b, 0x0, 0x0,
-    0x0, 0xc, 0xff, 0xfd, 0x10, 0xd, 0xf2, 0xf,
-    0xd0, 0xaf, 0x60, 0x0, 0x0, 0x3f, 0xff, 0x6f,
-    0xc0, 0x2f, 0xc0, 0xf, 0xd0, 0x2f, 0xe0, 0x0,
-    0x0, 0xbf, 0xcf, 0x8, 0xf6, 0x8f, 0x60, 0xf,
-    0xd0, 0xb, 0xf6, 0x0, 0x3, 0xf9, 0xbf, 0x0,
-    0x50, 0xef, 0x10, 0xf, 0xd0, 0x3, 0xfe, 0x0,
-    0xc, 0xf2, 0xbf, 0x0, 0x5, 0xfb, 0x0, 0xf,
-    0xd0, 0x0, 0xcf, 0x50, 0x6f, 0xa0, 0xbf, 0x0,
-    0xb, 0xf4, 0x0, 0xf, 0xd0, 0x0, 0x5f, 0xd0,
-    0x6f, 0x10, 0xbf, 0x0, 0x2f, 0xd0, 0x0, 0xf,
-    0xd0, 0x0, 0xe, 0xf4, 0x5, 0x0, 0xbf, 0x0,
-    0x9f, 0x70, 0x0, 0xf, 0xd0, 0x0, 0x8, 0xf7,
-    0x0, 0x0, 0xbf, 0x0, 0x6, 0x0, 0x0, 0xf,
-    0xd0, 0x0, 0x1, 0x30, 0x0, 0x0, 0xbf, 0x0,
-    0x0, 0x0, 0x0, 0x1f, 0xc0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0xbf, 0x0, 0x0, 0xa, 0xdc, 0xef,
-    0x90, 0x0, 0x0, 0x0, 0x0, 0x0, 0xbf, 0x0,
-    0x0, 0x8, 0xff, 0xfb, 0x10, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0,
-
     /* U+7F6E "置" */
     0x0, 0xcf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
     0xff, 0xff, 0xf5, 0x0, 0x0, 0xdd, 0x55, 0x55,
@@ -3186,44 +2693,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0xff, 0xff, 0xff, 0xf4, 0x1, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x10,
 
-    /* U+9000 "退" */
-    0x0, 0x13, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x1, 0xee, 0x10, 0x0,
-    0xf, 0xff, 0xff, 0xff, 0xff, 0xff, 0xb0, 0x0,
-    0x0, 0x9f, 0xb0, 0x0, 0xf, 0xea, 0xaa, 0xaa,
-    0xaa, 0xaf, 0xc0, 0x0, 0x0, 0xd, 0xf7, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x0, 0x4, 0xff, 0x20, 0xf, 0xc0, 0x0, 0x0,
-    0x0, 0xf, 0xc0, 0x0, 0x0, 0x0, 0x9b, 0x10,
-    0xf, 0xe9, 0x99, 0x99, 0x99, 0x9f, 0xc0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0xf, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xc0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x0, 0xf, 0xc0, 0x0,
-    0x5a, 0xaa, 0xa0, 0x0, 0xf, 0xc0, 0x0, 0x0,
-    0x0, 0xf, 0xc0, 0x0, 0x8f, 0xff, 0xf1, 0x0,
-    0xf, 0xe8, 0x88, 0x88, 0x88, 0x8f, 0xc0, 0x0,
-    0x0, 0xb, 0xf1, 0x0, 0xf, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xc0, 0x0, 0x0, 0xb, 0xf1, 0x0,
-    0xf, 0xc0, 0x0, 0x0, 0x0, 0xb, 0x91, 0x0,
-    0x0, 0xb, 0xf1, 0x0, 0xf, 0xc0, 0x1d, 0x50,
-    0x0, 0x2, 0xaf, 0x40, 0x0, 0xb, 0xf1, 0x0,
-    0xf, 0xc0, 0x4f, 0xfb, 0x11, 0x9f, 0xfe, 0x60,
-    0x0, 0xb, 0xf1, 0x0, 0xf, 0xc0, 0x1, 0xbf,
-    0xff, 0xfc, 0x50, 0x0, 0x0, 0xb, 0xf1, 0x0,
-    0xf, 0xc0, 0x0, 0x19, 0xff, 0xd1, 0x0, 0x0,
-    0x0, 0xb, 0xf1, 0x0, 0xf, 0xc0, 0x29, 0xf6,
-    0x2d, 0xff, 0x60, 0x0, 0x0, 0xb, 0xf1, 0x0,
-    0x1f, 0xdb, 0xff, 0xe4, 0x0, 0x9f, 0xfb, 0x10,
-    0x0, 0xd, 0xf1, 0x0, 0x8f, 0xff, 0xd5, 0x0,
-    0x0, 0x4, 0xef, 0x60, 0x0, 0xcf, 0xfa, 0x0,
-    0x1e, 0xd5, 0x0, 0x0, 0x0, 0x0, 0x18, 0x0,
-    0xc, 0xfb, 0xaf, 0xb3, 0x3, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x9f, 0xc0, 0xb, 0xff,
-    0xec, 0xbb, 0xbb, 0xaa, 0xab, 0xbb, 0xbc, 0xc5,
-    0x3d, 0x10, 0x0, 0x4a, 0xdf, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xf2, 0x1, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x11, 0x11, 0x11, 0x0,
-
     /* U+91CD "重" */
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x12, 0x32, 0x0, 0x0, 0x7a, 0xaa, 0xbb,
@@ -3298,43 +2767,6 @@ static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {
     0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
     0x0, 0x0, 0x0,
 
-    /* U+95F4 "间" */
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0xba, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1, 0xef,
-    0xa0, 0x5, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa, 0xaa,
-    0xa1, 0x0, 0x2e, 0xfb, 0x7, 0xff, 0xff, 0xff,
-    0xff, 0xff, 0xff, 0xf1, 0x0, 0x3, 0xfd, 0x10,
-    0x11, 0x11, 0x11, 0x11, 0x11, 0x1b, 0xf1, 0x36,
-    0x10, 0x41, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0xb, 0xf1, 0xaf, 0x30, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0, 0xb, 0xf1, 0xaf, 0x30, 0x0,
-    0xaa, 0xaa, 0xaa, 0xaa, 0xa7, 0x0, 0xb, 0xf1,
-    0xaf, 0x30, 0x1, 0xff, 0xff, 0xff, 0xff, 0xfb,
-    0x0, 0xb, 0xf1, 0xaf, 0x30, 0x1, 0xf9, 0x0,
-    0x0, 0x0, 0xfb, 0x0, 0xb, 0xf1, 0xaf, 0x30,
-    0x1, 0xf9, 0x0, 0x0, 0x0, 0xfb, 0x0, 0xb,
-    0xf1, 0xaf, 0x30, 0x1, 0xf9, 0x0, 0x0, 0x0,
-    0xfb, 0x0, 0xb, 0xf1, 0xaf, 0x30, 0x1, 0xfe,
-    0xbb, 0xbb, 0xbb, 0xfb, 0x0, 0xb, 0xf1, 0xaf,
-    0x30, 0x1, 0xff, 0xff, 0xff, 0xff, 0xfb, 0x0,
-    0xb, 0xf1, 0xaf, 0x30, 0x1, 0xf9, 0x0, 0x0,
-    0x0, 0xfb, 0x0, 0xb, 0xf1, 0xaf, 0x30, 0x1,
-    0xf9, 0x0, 0x0, 0x0, 0xfb, 0x0, 0xb, 0xf1,
-    0xaf, 0x30, 0x1, 0xf9, 0x0, 0x0, 0x0, 0xfb,
-    0x0, 0xb, 0xf1, 0xaf, 0x30, 0x1, 0xfe, 0xbb,
-    0xbb, 0xbb, 0xfb, 0x0, 0xb, 0xf1, 0xaf, 0x30,
-    0x1, 0xff, 0xff, 0xff, 0xff, 0xfa, 0x0, 0xb,
-    0xf1, 0xaf, 0x30, 0x1, 0xf9, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0xb, 0xf1, 0xaf, 0x30, 0x0, 0x63,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0xb, 0xf1, 0xaf,
-    0x30, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x1e, 0xf0, 0xaf, 0x30, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0xcd, 0xdc, 0xff, 0xc0, 0xaf, 0x30, 0x0,
-    0x0, 0x0, 0x0, 0x0, 0xaf, 0xff, 0xfb, 0x20,
-    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
-    0x0, 0x0, 0x0,
-
     /* U+9875 "页" */
     0x2c, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc,
     0xcc, 0xcc, 0xcc, 0xc3, 0x2f, 0xff, 0xff, 0xff,
@@ -3551,62 +2983,46 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
     {.bitmap_index = 9032, .adv_w = 103, .box_w = 3, .box_h = 26, .ofs_x = 2, .ofs_y = -6},
     {.bitmap_index = 9071, .adv_w = 128, .box_w = 7, .box_h = 22, .ofs_x = 0, .ofs_y = -4},
     {.bitmap_index = 9148, .adv_w = 285, .box_w = 14, .box_h = 4, .ofs_x = 2, .ofs_y = 5},
-    {.bitmap_index = 9176, .adv_w = 114, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0},
     {.bitmap_index = 9176, .adv_w = 384, .box_w = 23, .box_h = 20, .ofs_x = 0, .ofs_y = -1},
     {.bitmap_index = 9406, .adv_w = 384, .box_w = 24, .box_h = 20, .ofs_x = 0, .ofs_y = -2},
     {.bitmap_index = 9646, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
     {.bitmap_index = 9934, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -2},
     {.bitmap_index = 10210, .adv_w = 384, .box_w = 24, .box_h = 25, .ofs_x = 0, .ofs_y = -4},
     {.bitmap_index = 10510, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 10798, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 11086, .adv_w = 384, .box_w = 25, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 11386, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 11674, .adv_w = 384, .box_w = 23, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 11950, .adv_w = 384, .box_w = 23, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 12215, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 12503, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 12779, .adv_w = 384, .box_w = 22, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 13032, .adv_w = 384, .box_w = 24, .box_h = 22, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 13296, .adv_w = 384, .box_w = 22, .box_h = 22, .ofs_x = 1, .ofs_y = -3},
-    {.bitmap_index = 13538, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 13826, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 14114, .adv_w = 384, .box_w = 24, .box_h = 25, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 14414, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 14690, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 14978, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 15254, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 15542, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 15830, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 16118, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 16406, .adv_w = 384, .box_w = 24, .box_h = 25, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 16706, .adv_w = 384, .box_w = 23, .box_h = 24, .ofs_x = 1, .ofs_y = -4},
-    {.bitmap_index = 16982, .adv_w = 384, .box_w = 24, .box_h = 22, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 17246, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 17522, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 17798, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 18074, .adv_w = 384, .box_w = 23, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 18339, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 18615, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 18891, .adv_w = 384, .box_w = 23, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 19156, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 19444, .adv_w = 384, .box_w = 23, .box_h = 25, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 19732, .adv_w = 384, .box_w = 24, .box_h = 22, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 19996, .adv_w = 384, .box_w = 24, .box_h = 25, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 20296, .adv_w = 384, .box_w = 24, .box_h = 22, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 20560, .adv_w = 384, .box_w = 20, .box_h = 23, .ofs_x = 2, .ofs_y = -3},
-    {.bitmap_index = 20790, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 21078, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 21354, .adv_w = 384, .box_w = 24, .box_h = 25, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 21654, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 21942, .adv_w = 384, .box_w = 23, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 22218, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 22506, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 22794, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
-    {.bitmap_index = 23070, .adv_w = 384, .box_w = 22, .box_h = 25, .ofs_x = 1, .ofs_y = -4},
-    {.bitmap_index = 23345, .adv_w = 384, .box_w = 22, .box_h = 25, .ofs_x = 1, .ofs_y = -4},
-    {.bitmap_index = 23620, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 23896, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
-    {.bitmap_index = 24184, .adv_w = 384, .box_w = 23, .box_h = 25, .ofs_x = 1, .ofs_y = -4}
+    {.bitmap_index = 10798, .adv_w = 384, .box_w = 25, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 11098, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 11386, .adv_w = 384, .box_w = 23, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 11662, .adv_w = 384, .box_w = 23, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 11927, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 12215, .adv_w = 384, .box_w = 22, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 12468, .adv_w = 384, .box_w = 24, .box_h = 22, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 12732, .adv_w = 384, .box_w = 22, .box_h = 22, .ofs_x = 1, .ofs_y = -3},
+    {.bitmap_index = 12974, .adv_w = 384, .box_w = 24, .box_h = 25, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 13274, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 13562, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 13838, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 14126, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 14414, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 14702, .adv_w = 384, .box_w = 24, .box_h = 22, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 14966, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 15242, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 15518, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 15794, .adv_w = 384, .box_w = 23, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 16059, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 16347, .adv_w = 384, .box_w = 24, .box_h = 22, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 16611, .adv_w = 384, .box_w = 24, .box_h = 22, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 16875, .adv_w = 384, .box_w = 20, .box_h = 23, .ofs_x = 2, .ofs_y = -3},
+    {.bitmap_index = 17105, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 17393, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 17669, .adv_w = 384, .box_w = 24, .box_h = 25, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 17969, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 18257, .adv_w = 384, .box_w = 23, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 18533, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 18821, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -3},
+    {.bitmap_index = 19097, .adv_w = 384, .box_w = 22, .box_h = 25, .ofs_x = 1, .ofs_y = -4},
+    {.bitmap_index = 19372, .adv_w = 384, .box_w = 24, .box_h = 23, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 19648, .adv_w = 384, .box_w = 24, .box_h = 24, .ofs_x = 0, .ofs_y = -4},
+    {.bitmap_index = 19936, .adv_w = 384, .box_w = 23, .box_h = 25, .ofs_x = 1, .ofs_y = -4}
 };
 
 /*---------------------
@@ -3614,25 +3030,23 @@ static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {
  *--------------------*/
 
 static const uint16_t unicode_list_1[] = {
-    0x0, 0x2d06, 0x2d0b, 0x2d38, 0x2dab, 0x2e1d, 0x2e4a, 0x3046,
-    0x3070, 0x3114, 0x3133, 0x31a5, 0x32d3, 0x330a, 0x3565, 0x35db,
-    0x3804, 0x3a97, 0x3da3, 0x3dfd, 0x401c, 0x4148, 0x4150, 0x426b,
-    0x42a4, 0x446d, 0x44ad, 0x44f3, 0x453b, 0x45f1, 0x4625, 0x48fa,
-    0x4c85, 0x4d26, 0x4d7c, 0x4fdc, 0x5064, 0x576b, 0x5837, 0x58ed,
-    0x5e6b, 0x60e7, 0x616f, 0x617f, 0x6765, 0x6abb, 0x6b00, 0x6ed1,
-    0x6efd, 0x70ca, 0x74ea, 0x74f1, 0x7772, 0x7799, 0x7d2a
+    0x0, 0x2d06, 0x2d0b, 0x2d38, 0x2dab, 0x2e1d, 0x3046, 0x3070,
+    0x3114, 0x3133, 0x31a5, 0x330a, 0x3565, 0x35db, 0x3da3, 0x401c,
+    0x4148, 0x426b, 0x42a4, 0x446d, 0x453b, 0x4625, 0x4d26, 0x4d7c,
+    0x4fdc, 0x5064, 0x5837, 0x5e6b, 0x60e7, 0x616f, 0x617f, 0x6765,
+    0x6abb, 0x6b00, 0x6ed1, 0x70ca, 0x74ea, 0x7772, 0x7799, 0x7d2a
 };
 
 /*Collect the unicode lists and glyph_id offsets*/
 static const lv_font_fmt_txt_cmap_t cmaps[] =
 {
     {
-        .range_start = 32, .range_length = 96, .glyph_id_start = 1,
+        .range_start = 32, .range_length = 95, .glyph_id_start = 1,
         .unicode_list = NULL, .glyph_id_ofs_list = NULL, .list_length = 0, .type = LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY
     },
     {
-        .range_start = 8451, .range_length = 32043, .glyph_id_start = 97,
-        .unicode_list = unicode_list_1, .glyph_id_ofs_list = NULL, .list_length = 55, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
+        .range_start = 8451, .range_length = 32043, .glyph_id_start = 96,
+        .unicode_list = unicode_list_1, .glyph_id_ofs_list = NULL, .list_length = 40, .type = LV_FONT_FMT_TXT_CMAP_SPARSE_TINY
     }
 };
 
@@ -0,0 +1,261 @@
+/**
+ ******************************************************************************
+ * @file    ui_assets.c
+ * @brief   外部 Flash 图片资源包
+ * @details 挂载时只把目录 (条目表) 读进 RAM，文件数据始终留在 SPI Flash 中。
+ *          解码器打开文件后由 LVGL 图像缓存 (LV_IMG_CACHE_DEF_SIZE) 保持打开，
+ *          之后每次绘制只读取当前绘制区域所需的行；缓存被挤出时会重新打开，
+ *          所以打开/定位必须足够便宜：打开是一次条目表线性查找，定位只修改
+ *          文件内偏移。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_assets.h"
+#include "checksum.h"
+#include "norflash.h"
+#include "ui_img_rle.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_MODULE "UI_ASSETS"
+#include "log.h"
+
+/* 私有类型 */
+typedef struct {
+  const ui_asset_pack_entry_t *entry;
+  uint32_t pos; /* 文件内读写位置 */
+} ui_asset_file_t;
+
+/* 私有全局变量 */
+static ui_asset_pack_entry_t g_entries[UI_ASSETS_MAX_ENTRIES];
+static uint16_t g_entry_count = 0;
+static bool g_mounted = false;
+static lv_fs_drv_t g_fs_drv;
+static char g_path_buf[UI_ASSETS_NAME_MAX + 2]; /* "F:" + 文件名 */
+
+/* ------------------ 私有函数 ------------------ */
+
+static const ui_asset_pack_entry_t *ui_assets_find(const char *file_name) {
+  for (uint16_t i = 0; i < g_entry_count; i++) {
+    if (strcmp(g_entries[i].name, file_name) == 0) {
+      return &g_entries[i];
+    }
+  }
+  return NULL;
+}
+
+#if UI_ASSETS_VERIFY_CRC
+/**
+ * @brief 分块读取并计算 [addr, addr + len) 的 CRC-32
+ */
+static bool ui_assets_crc(uint32_t addr, uint32_t len, uint32_t *crc) {
+  static uint8_t buf[256];
+  uint32_t chunk;
+
+  *crc = 0;
+  while (len > 0) {
+    chunk = (len > sizeof(buf)) ? sizeof(buf) : len;
+    if (norflash_read(addr, buf, chunk) != 0) {
+      return false;
+    }
+    *crc = CRC32_Update(*crc, buf, chunk);
+    addr += chunk;
+    len -= chunk;
+  }
+  return true;
+}
+#endif
+
+/**
+ * @brief 读取并校验资源包头部与条目表
+ */
+static bool ui_assets_mount(void) {
+  ui_asset_pack_header_t header;
+  uint32_t table_size;
+
+  if (norflash_read(UI_ASSETS_FLASH_ADDR, (uint8_t *)&header,
+                    sizeof(header)) != 0) {
+    return false;
+  }
+  if (header.magic != UI_ASSETS_MAGIC) {
+    LOG_WARN("SPI Flash 中没有资源包，请用 assets/asset_pack.py 烧写");
+    return false;
+  }
+  if (header.version != UI_ASSETS_VERSION ||
+      header.count > UI_ASSETS_MAX_ENTRIES ||
+      header.size > norflash_get_size() - UI_ASSETS_FLASH_ADDR) {
+    LOG_WARN("资源包版本或长度不支持 (v%u, %u 项, %lu 字节)", header.version,
+             header.count, (unsigned long)header.size);
+    return false;
+  }
+
+  table_size = header.count * sizeof(ui_asset_pack_entry_t);
+  if (sizeof(header) + table_size > header.size ||
+      norflash_read(UI_ASSETS_FLASH_ADDR + sizeof(header),
+                    (uint8_t *)g_entries, table_size) != 0) {
+    return false;
+  }
+
+#if UI_ASSETS_VERIFY_CRC
+  {
+    uint32_t crc;
+    if (!ui_assets_crc(UI_ASSETS_FLASH_ADDR + sizeof(header),
+                       header.size - sizeof(header), &crc) ||
+        crc != header.crc) {
+      LOG_WARN("资源包 CRC 校验失败，忽略资源包");
+      return false;
+    }
+  }
+#endif
+
+  for (uint16_t i = 0; i < header.count; i++) {
+    ui_asset_pack_entry_t *entry = &g_entries[i];
+    entry->name[UI_ASSETS_NAME_MAX - 1] = '\0';
+    if (entry->offset > header.size ||
+        entry->size > header.size - entry->offset) {
+      LOG_WARN("资源 %s 越出资源包范围", entry->name);
+      return false;
+    }
+  }
+
+  g_entry_count = header.count;
+  LOG_INFO("资源包已挂载: %u 项, %lu 字节", header.count,
+           (unsigned long)header.size);
+  return true;
+}
+
+/* ------------------ lv_fs 驱动回调 ------------------ */
+
+static void *ui_assets_fs_open(lv_fs_drv_t *drv, const char *path,
+                               lv_fs_mode_t mode) {
+  const ui_asset_pack_entry_t *entry;
+  ui_asset_file_t *file;
+
+  LV_UNUSED(drv);
+  if (mode != LV_FS_MODE_RD) {
+    return NULL;
+  }
+
+  /* LVGL 8.1 只去掉盘符和冒号，兼容 "F:/xxx.bin" 写法 */
+  if (*path == '/') {
+    path++;
+  }
+  entry = ui_assets_find(path);
+  if (entry == NULL) {
+    return NULL;
+  }
+
+  file = lv_mem_alloc(sizeof(ui_asset_file_t));
+  if (file == NULL) {
+    return NULL;
+  }
+  file->entry = entry;
+  file->pos = 0;
+  return file;
+}
+
+static lv_fs_res_t ui_assets_fs_close(lv_fs_drv_t *drv, void *file_p) {
+  LV_UNUSED(drv);
+  lv_mem_free(file_p);
+  return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t ui_assets_fs_read(lv_fs_drv_t *drv, void *file_p,
+                                     void *buf, uint32_t btr, uint32_t *br) {
+  ui_asset_file_t *file = file_p;
+  uint32_t remain = file->entry->size - file->pos;
+
+  LV_UNUSED(drv);
+  if (btr > remain) {
+    btr = remain;
+  }
+  if (norflash_read(UI_ASSETS_FLASH_ADDR + file->entry->offset + file->pos,
+                    buf, btr) != 0) {
+    *br = 0;
+    return LV_FS_RES_HW_ERR;
+  }
+  file->pos += btr;
+  *br = btr;
+  return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t ui_assets_fs_seek(lv_fs_drv_t *drv, void *file_p,
+                                     uint32_t pos, lv_fs_whence_t whence) {
+  ui_asset_file_t *file = file_p;
+
+  LV_UNUSED(drv);
+  if (whence == LV_FS_SEEK_CUR) {
+    pos += file->pos;
+  } else if (whence == LV_FS_SEEK_END) {
+    pos += file->entry->size;
+  }
+  if (pos > file->entry->size) {
+    return LV_FS_RES_INV_PARAM;
+  }
+  file->pos = pos;
+  return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t ui_assets_fs_tell(lv_fs_drv_t *drv, void *file_p,
+                                     uint32_t *pos_p) {
+  LV_UNUSED(drv);
+  *pos_p = ((ui_asset_file_t *)file_p)->pos;
+  return LV_FS_RES_OK;
+}
+
+/* ------------------ 公共函数 ------------------ */
+
+/**
+ * @brief 初始化 SPI Flash 并挂载资源包
+ */
+void ui_assets_init(void) {
+  if (g_mounted) {
+    return;
+  }
+
+  ui_img_rle_init(); /* 片内 RLE 图片不依赖资源包，先注册解码器 */
+
+  if (norflash_init() != 0 || !ui_assets_mount()) {
+    g_entry_count = 0;
+    return;
+  }
+
+  lv_fs_drv_init(&g_fs_drv);
+  g_fs_drv.letter = UI_ASSETS_LETTER;
+  g_fs_drv.open_cb = ui_assets_fs_open;
+  g_fs_drv.close_cb = ui_assets_fs_close;
+  g_fs_drv.read_cb = ui_assets_fs_read;
+  g_fs_drv.seek_cb = ui_assets_fs_seek;
+  g_fs_drv.tell_cb = ui_assets_fs_tell;
+  lv_fs_drv_register(&g_fs_drv);
+  g_mounted = true;
+}
+
+/**
+ * @brief 资源包是否已挂载
+ */
+bool ui_assets_is_mounted(void) { return g_mounted; }
+
+/**
+ * @brief 获取图片源
+ */
+const void *ui_assets_src(const char *name, const lv_img_dsc_t *builtin) {
+  static const char *const exts[] = {UI_IMG_RLE_EXT, "bin"};
+
+  /* 打包工具对压缩有效的图片输出 .rle，其余保持 .bin */
+  for (uint8_t i = 0; g_mounted && i < sizeof(exts) / sizeof(exts[0]); i++) {
+    int n = snprintf(g_path_buf, sizeof(g_path_buf), "%c:%s.%s",
+                     UI_ASSETS_LETTER, name, exts[i]);
+    if (n > 0 && n < (int)sizeof(g_path_buf) &&
+        ui_assets_find(g_path_buf + 2) != NULL) {
+      return g_path_buf;
+    }
+  }
+
+  if (builtin != NULL) {
+    return builtin;
+  }
+  return LV_SYMBOL_IMAGE;
+}
@@ -0,0 +1,79 @@
+/**
+ ******************************************************************************
+ * @file    ui_assets.h
+ * @brief   外部 Flash 图片资源包
+ * @details 大尺寸图片不再编进片内 Flash，而是由 assets/asset_pack.py 打包成
+ *          资源包烧写到板载 SPI Flash。启动时挂载资源包并注册盘符为
+ *          UI_ASSETS_LETTER 的 lv_fs 驱动，图片以 "F:<名称>.rle" (RLE 压缩，
+ *          见 ui_img_rle) 或 "F:<名称>.bin" 路径作为图片源，由解码器按行从
+ *          Flash 读取，不占用整幅图片的 RAM。
+ *          UI_ASSETS_BUILTIN 为 1 时仍引用片内 C 数组，资源包缺失时回退使用；
+ *          为 0 时不引用，链接器会把这些数组从固件中移除。
+ *          按行读取时 LVGL 不支持旋转/缩放，需要变换的图片仍应放在片内。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef UI_ASSETS_H
+#define UI_ASSETS_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* --------------------------- 系统配置 --------------------------- */
+#define UI_ASSETS_BUILTIN 0            /* 1: 保留片内图片作为回退 (约 109 KB) */
+#define UI_ASSETS_LETTER 'F'           /* lv_fs 盘符 */
+#define UI_ASSETS_FLASH_ADDR 0x000000  /* 资源包在 SPI Flash 中的起始地址 (4 KB 对齐，须在 OTA_FLASH_ADDR 之前结束) */
+#define UI_ASSETS_MAX_ENTRIES 16       /* 资源包最多条目数 */
+#define UI_ASSETS_VERIFY_CRC 1         /* 挂载时校验整个资源包的 CRC-32 */
+
+/* --------------------------- 资源包格式 --------------------------- */
+/* 小端存储，与 assets/asset_pack.py 保持一致：
+ *   ui_asset_pack_header_t
+ *   ui_asset_pack_entry_t[count]
+ *   各图片数据 (4 字节对齐)：.bin 为 LVGL 原始格式 (lv_img_header_t + 像素)，
+ *   .rle 格式见 ui_img_rle.h */
+#define UI_ASSETS_MAGIC 0x50534145UL   /* "EASP" */
+#define UI_ASSETS_VERSION 1
+#define UI_ASSETS_NAME_MAX 24          /* 含结束符 */
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t count;                 /* 条目数 */
+    uint32_t size;                  /* 资源包总长度 (含头部) */
+    uint32_t crc;                   /* 头部之后全部数据的 CRC-32 */
+} ui_asset_pack_header_t;
+
+typedef struct {
+    char name[UI_ASSETS_NAME_MAX];  /* 文件名，如 "author_photo.bin" */
+    uint32_t offset;                /* 相对资源包起始地址的偏移 */
+    uint32_t size;                  /* 文件长度 */
+} ui_asset_pack_entry_t;
+
+/* --------------------------- 图片源 --------------------------- */
+/* 只有取地址才会让链接器保留片内图片，LV_IMG_DECLARE 声明本身不占空间 */
+#if UI_ASSETS_BUILTIN
+#define UI_ASSET_SRC(name) ui_assets_src(#name, &(name))
+#else
+#define UI_ASSET_SRC(name) ui_assets_src(#name, NULL)
+#endif
+
+/* 注册图片解码器、初始化 SPI Flash 并挂载资源包 (在 lv_init 之后、加载屏幕之前调用) */
+void ui_assets_init(void);
+
+/* 资源包是否已挂载 */
+bool ui_assets_is_mounted(void);
+
+/**
+ * @brief 获取图片源
+ * @param name    资源名 (不含扩展名)
+ * @param builtin 片内回退图片，可为 NULL
+ * @return 资源包中存在时返回文件路径 (静态缓冲区，lv_img_set_src 会拷贝)，
+ *         否则返回 builtin；两者都没有时返回 LV_SYMBOL_IMAGE 占位符
+ */
+const void* ui_assets_src(const char* name, const lv_img_dsc_t* builtin);
+
+#endif /* UI_ASSETS_H */
@@ -0,0 +1,92 @@
+/**
+ ******************************************************************************
+ * @file    ui_builder.c
+ * @brief   屏幕分步构建实现
+ * @details 定时器周期为 0，每次 lv_timer_handler 都会执行。新建的定时器
+ *          排在显示刷新定时器之前，同一次 lv_timer_handler 中先构建、
+ *          后刷新，本次建好的控件当帧即可显示。无构建时定时器暂停。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_builder.h"
+
+static lv_obj_t *s_owner;
+static ui_builder_step_cb_t s_cb;
+static uint8_t s_next;
+static uint8_t s_count;
+static lv_timer_t *s_timer;
+
+/* -----------------------------------------------------------
+ * 私有函数
+ * ----------------------------------------------------------- */
+
+static void builder_end(void) {
+  s_owner = NULL;
+  s_cb = NULL;
+  s_next = 0;
+  s_count = 0;
+  if (s_timer != NULL) {
+    lv_timer_pause(s_timer);
+  }
+}
+
+/* 先推进下标再执行：步骤中结束构建 (finish / cancel) 时不会重复执行 */
+static void builder_run_step(void) {
+  ui_builder_step_cb_t cb = s_cb;
+  uint8_t step = s_next++;
+
+  cb(step);
+  if (s_cb == cb && s_next >= s_count) {
+    builder_end();
+  }
+}
+
+static void builder_timer_cb(lv_timer_t *timer) {
+  uint32_t start = lv_tick_get();
+
+  LV_UNUSED(timer);
+  do {
+    builder_run_step();
+  } while (s_cb != NULL && lv_tick_elaps(start) < UI_BUILDER_BUDGET_MS);
+}
+
+static bool builder_match(lv_obj_t *owner) {
+  return s_cb != NULL && (owner == NULL || owner == s_owner);
+}
+
+/* -----------------------------------------------------------
+ * 公共函数
+ * ----------------------------------------------------------- */
+
+void ui_builder_start(lv_obj_t *owner, ui_builder_step_cb_t cb, uint8_t count) {
+  ui_builder_finish(NULL);
+  if (cb == NULL || count == 0) {
+    return;
+  }
+
+  if (s_timer == NULL) {
+    s_timer = lv_timer_create(builder_timer_cb, 0, NULL);
+  }
+  s_owner = owner;
+  s_cb = cb;
+  s_next = 0;
+  s_count = count;
+  lv_timer_resume(s_timer);
+  lv_timer_ready(s_timer);
+}
+
+void ui_builder_finish(lv_obj_t *owner) {
+  while (builder_match(owner)) {
+    builder_run_step();
+  }
+}
+
+void ui_builder_cancel(lv_obj_t *owner) {
+  if (builder_match(owner)) {
+    builder_end();
+  }
+}
+
+bool ui_builder_busy(void) { return s_cb != NULL; }
@@ -0,0 +1,55 @@
+/**
+ * @file    ui_builder.h
+ * @brief   屏幕分步构建
+ * @details 控件多的屏幕在一次 ui_load_screen 中建完，这一帧会很长，
+ *          期间触摸也不被读取。分步构建时屏幕的 init 只同步创建骨架
+ *          (布局容器、标题等先能看到的内容)，其余控件分成若干步，由一个
+ *          LVGL 定时器在之后的 lv_timer_handler 中执行：每次执行到用完
+ *          UI_BUILDER_BUDGET_MS 为止 (至少一步)，两次之间照常读取触摸、
+ *          刷新画面，新建的控件逐步出现。
+ *          同一时刻只有当前屏幕在构建：切走时 UI 管理器对缓存的屏幕
+ *          ui_builder_finish (一次建完再隐藏)，对销毁的屏幕
+ *          ui_builder_cancel (在 deinit 之前丢弃剩余步骤)。
+ *          构建期间会用到未建控件的回调应先调用 ui_builder_finish(NULL)。
+ */
+
+#ifndef UI_BUILDER_H
+#define UI_BUILDER_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* 每次 lv_timer_handler 中用于构建的时间预算 (ms) */
+#define UI_BUILDER_BUDGET_MS 8
+
+/* 构建步骤：step 从 0 开始依次调用 */
+typedef void (*ui_builder_step_cb_t)(uint8_t step);
+
+/**
+ * @brief 开始分步构建 (在屏幕 init 中创建完骨架后调用)
+ * @param owner 屏幕根容器，用于 finish / cancel 时匹配
+ * @param cb    步骤回调
+ * @param count 步骤数
+ * @note  上一次未完成的构建先一次执行完
+ */
+void ui_builder_start(lv_obj_t *owner, ui_builder_step_cb_t cb, uint8_t count);
+
+/**
+ * @brief 立即执行剩余的全部步骤
+ * @param owner 只处理该容器的构建；NULL 表示当前的构建
+ */
+void ui_builder_finish(lv_obj_t *owner);
+
+/**
+ * @brief 丢弃剩余步骤 (屏幕销毁前调用)
+ * @param owner 只处理该容器的构建；NULL 表示当前的构建
+ */
+void ui_builder_cancel(lv_obj_t *owner);
+
+/**
+ * @brief 是否有未完成的构建
+ */
+bool ui_builder_busy(void);
+
+#endif /* UI_BUILDER_H */
@@ -0,0 +1,148 @@
+/**
+ ******************************************************************************
+ * @file    ui_coalesce.c
+ * @brief   输入事件合并实现
+ * @details 每个对象一条记录 (lv_mem，对象删除时释放)，记下上次执行时的
+ *          帧号与是否待执行。待执行的记录放在一张小表中，由一个 LVGL
+ *          定时器在帧号变化后依次执行；表为空时定时器暂停。
+ *          回调不在刷新完成回调中直接发送：刷新过程中使区域失效的结果
+ *          会被本帧的刷新清掉。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_coalesce.h"
+
+typedef struct {
+  lv_obj_t *obj;
+  uint32_t frame; /* 上次执行时的帧号 */
+  bool pending;   /* 已合并、等待下一帧后执行 */
+} coalesce_rec_t;
+
+static lv_event_code_t s_code = LV_EVENT_ALL; /* 未注册 */
+static uint32_t s_frame;
+static coalesce_rec_t *s_pending[UI_COALESCE_MAX_PENDING];
+static uint8_t s_pending_count;
+static lv_timer_t *s_timer;
+
+/* -----------------------------------------------------------
+ * 私有函数
+ * ----------------------------------------------------------- */
+
+static void coalesce_apply(coalesce_rec_t *rec) {
+  rec->pending = false;
+  rec->frame = s_frame;
+  lv_event_send(rec->obj, s_code, NULL);
+}
+
+static void coalesce_unlink(coalesce_rec_t *rec) {
+  for (uint8_t i = 0; i < s_pending_count; i++) {
+    if (s_pending[i] == rec) {
+      s_pending[i] = s_pending[--s_pending_count];
+      break;
+    }
+  }
+  rec->pending = false;
+  if (s_pending_count == 0 && s_timer != NULL) {
+    lv_timer_pause(s_timer);
+  }
+}
+
+static void coalesce_timer_cb(lv_timer_t *timer) {
+  LV_UNUSED(timer);
+
+  /* 执行时回调可能删除对象 (进而修改本表)，每次从头找下一条 */
+  for (;;) {
+    coalesce_rec_t *rec = NULL;
+
+    for (uint8_t i = 0; i < s_pending_count; i++) {
+      if (s_pending[i]->frame != s_frame) {
+        rec = s_pending[i];
+        break;
+      }
+    }
+    if (rec == NULL) {
+      break;
+    }
+    coalesce_unlink(rec);
+    coalesce_apply(rec);
+  }
+}
+
+static void coalesce_event_cb(lv_event_t *e) {
+  coalesce_rec_t *rec = (coalesce_rec_t *)lv_event_get_user_data(e);
+
+  switch (lv_event_get_code(e)) {
+  case LV_EVENT_VALUE_CHANGED:
+    if (rec->pending) {
+      break; /* 执行时读取最新的值 */
+    }
+    if (rec->frame != s_frame || s_pending_count >= UI_COALESCE_MAX_PENDING) {
+      coalesce_apply(rec);
+      break;
+    }
+    rec->pending = true;
+    s_pending[s_pending_count++] = rec;
+    lv_timer_resume(s_timer);
+    break;
+
+  case LV_EVENT_RELEASED:
+  case LV_EVENT_PRESS_LOST:
+    if (rec->pending) {
+      coalesce_unlink(rec);
+      coalesce_apply(rec);
+    }
+    break;
+
+  case LV_EVENT_DELETE:
+    if (rec->pending) {
+      coalesce_unlink(rec);
+    }
+    lv_mem_free(rec);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/* -----------------------------------------------------------
+ * 公共函数
+ * ----------------------------------------------------------- */
+
+void ui_coalesce_add_event_cb(lv_obj_t *obj, lv_event_cb_t cb,
+                              void *user_data) {
+  coalesce_rec_t *rec;
+
+  if (s_timer == NULL) {
+    s_code = (lv_event_code_t)lv_event_register_id();
+    s_timer = lv_timer_create(coalesce_timer_cb, LV_DISP_DEF_REFR_PERIOD, NULL);
+    lv_timer_pause(s_timer);
+  }
+
+  rec = lv_mem_alloc(sizeof(coalesce_rec_t));
+  if (rec == NULL) {
+    /* 内存不足时退回直接注册 */
+    lv_obj_add_event_cb(obj, cb, LV_EVENT_VALUE_CHANGED, user_data);
+    return;
+  }
+  rec->obj = obj;
+  rec->frame = s_frame - 1; /* 第一次变化立即执行 */
+  rec->pending = false;
+
+  lv_obj_add_event_cb(obj, cb, s_code, user_data);
+  lv_obj_add_event_cb(obj, coalesce_event_cb, LV_EVENT_VALUE_CHANGED, rec);
+  lv_obj_add_event_cb(obj, coalesce_event_cb, LV_EVENT_RELEASED, rec);
+  lv_obj_add_event_cb(obj, coalesce_event_cb, LV_EVENT_PRESS_LOST, rec);
+  lv_obj_add_event_cb(obj, coalesce_event_cb, LV_EVENT_DELETE, rec);
+}
+
+lv_event_code_t ui_coalesce_event_code(void) { return s_code; }
+
+void ui_coalesce_frame_done(void) {
+  s_frame++;
+  if (s_pending_count > 0) {
+    lv_timer_ready(s_timer);
+  }
+}
@@ -0,0 +1,45 @@
+/**
+ * @file    ui_coalesce.h
+ * @brief   输入事件合并 (每帧至多一次)
+ * @details 拖动滑块时 LVGL 每读一次触摸 (按下期间 LV_INDEV_DEF_READ_PERIOD)
+ *          就发送一次 LV_EVENT_VALUE_CHANGED，耗时的处理 (写驱动、改预览
+ *          颜色) 按采样频率执行，而画面每帧才更新一次。
+ *          以 ui_coalesce_add_event_cb 注册的回调按帧合并：
+ *            1. 上次执行之后已完成一帧刷新时立即执行；
+ *            2. 否则只记下待执行，下一帧刷新完成后以最新的值执行一次；
+ *            3. 松开 (RELEASED / PRESS_LOST) 时有待执行的立即执行，
+ *               最终值不会丢失。
+ *          回调以 ui_coalesce_event_code() 对应的事件调用，target 与
+ *          user_data 与直接注册时相同，回调本身无需修改。
+ *          帧计数由 lv_port_disp 的刷新完成回调调用 ui_coalesce_frame_done。
+ */
+
+#ifndef UI_COALESCE_H
+#define UI_COALESCE_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UI_COALESCE_MAX_PENDING 8 /* 同时等待执行的对象数上限 (超出时立即执行) */
+
+/**
+ * @brief 为对象注册按帧合并的 LV_EVENT_VALUE_CHANGED 回调
+ * @param obj       对象
+ * @param cb        耗时的处理回调
+ * @param user_data 回调的 user_data
+ */
+void ui_coalesce_add_event_cb(lv_obj_t *obj, lv_event_cb_t cb,
+                              void *user_data);
+
+/**
+ * @brief 合并后的回调所用的事件码
+ */
+lv_event_code_t ui_coalesce_event_code(void);
+
+/**
+ * @brief 一帧刷新完成 (刷新完成回调中调用，只计数，不发送事件)
+ */
+void ui_coalesce_frame_done(void);
+
+#endif /* UI_COALESCE_H */
@@ -0,0 +1,93 @@
+/**
+ ******************************************************************************
+ * @file    ui_comp_binding.c
+ * @brief   控件数据绑定组件实现
+ * @details 标签按格式化后的文本比较，LED 按颜色与亮灭比较，
+ *          只有变化时才调用 lv_label_set_text / lv_led_* 使区域失效。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_comp_binding.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+/* -----------------------------------------------------------
+ * 标签绑定
+ * ----------------------------------------------------------- */
+
+void ui_bind_label_init(ui_label_binding_t *binding, lv_obj_t *label) {
+  if (!binding)
+    return;
+
+  binding->label = label;
+  binding->cache[0] = '\0';
+
+  if (label) {
+    strncpy(binding->cache, lv_label_get_text(label), UI_BIND_TEXT_MAX - 1);
+    binding->cache[UI_BIND_TEXT_MAX - 1] = '\0';
+  }
+}
+
+bool ui_bind_label_set_text(ui_label_binding_t *binding, const char *text) {
+  if (!binding || !binding->label || !text)
+    return false;
+
+  if (strncmp(binding->cache, text, UI_BIND_TEXT_MAX) == 0)
+    return false;
+
+  strncpy(binding->cache, text, UI_BIND_TEXT_MAX - 1);
+  binding->cache[UI_BIND_TEXT_MAX - 1] = '\0';
+  lv_label_set_text(binding->label, text);
+  return true;
+}
+
+bool ui_bind_label_set_fmt(ui_label_binding_t *binding, const char *fmt, ...) {
+  char buf[UI_BIND_TEXT_MAX];
+  va_list args;
+
+  if (!binding || !binding->label || !fmt)
+    return false;
+
+  va_start(args, fmt);
+  vsnprintf(buf, sizeof(buf), fmt, args);
+  va_end(args);
+
+  return ui_bind_label_set_text(binding, buf);
+}
+
+/* -----------------------------------------------------------
+ * LED 绑定
+ * ----------------------------------------------------------- */
+
+void ui_bind_led_init(ui_led_binding_t *binding, lv_obj_t *led) {
+  if (!binding)
+    return;
+
+  binding->led = led;
+  binding->is_on = false;
+  binding->is_synced = false; /* 首次设置总是生效 */
+}
+
+bool ui_bind_led_set(ui_led_binding_t *binding, lv_color_t color, bool on) {
+  if (!binding || !binding->led)
+    return false;
+
+  if (binding->is_synced && binding->is_on == on &&
+      (!on || binding->color.full == color.full))
+    return false;
+
+  if (on) {
+    lv_led_set_color(binding->led, color);
+    lv_led_on(binding->led);
+    binding->color = color;
+  } else {
+    lv_led_off(binding->led);
+  }
+
+  binding->is_on = on;
+  binding->is_synced = true;
+  return true;
+}
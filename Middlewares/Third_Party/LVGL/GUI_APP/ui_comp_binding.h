@@ -0,0 +1,66 @@
+/**
+ ******************************************************************************
+ * @file    ui_comp_binding.h
+ * @brief   控件数据绑定组件
+ * @details 为标签等控件缓存上一次显示的内容，只有内容变化时才调用 LVGL
+ *          接口刷新，避免数值不变时仍然使控件区域失效并触发重绘。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef UI_COMP_BINDING_H
+#define UI_COMP_BINDING_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+
+/* 缓存文本的最大长度 (含结束符) */
+#define UI_BIND_TEXT_MAX 24
+
+/* 标签绑定 */
+typedef struct {
+    lv_obj_t* label;                /* 绑定的标签对象 */
+    char cache[UI_BIND_TEXT_MAX];   /* 当前显示的文本 */
+} ui_label_binding_t;
+
+/* LED 颜色绑定 */
+typedef struct {
+    lv_obj_t* led;                  /* 绑定的 LED 对象 */
+    lv_color_t color;               /* 当前颜色 */
+    bool is_on;                     /* 当前亮灭状态 */
+    bool is_synced;                 /* 缓存是否有效 */
+} ui_led_binding_t;
+
+/**
+ * @brief 绑定标签, 并以其当前文本作为缓存
+ * @param binding 绑定对象
+ * @param label   标签对象 (可为 NULL, 之后的更新将被忽略)
+ */
+void ui_bind_label_init(ui_label_binding_t* binding, lv_obj_t* label);
+
+/**
+ * @brief 设置标签文本, 与缓存相同则不做任何操作
+ * @return true: 文本已更新; false: 未变化
+ */
+bool ui_bind_label_set_text(ui_label_binding_t* binding, const char* text);
+
+/**
+ * @brief 格式化后设置标签文本, 与缓存相同则不做任何操作
+ * @return true: 文本已更新; false: 未变化
+ */
+bool ui_bind_label_set_fmt(ui_label_binding_t* binding, const char* fmt, ...);
+
+/**
+ * @brief 绑定 LED 对象
+ */
+void ui_bind_led_init(ui_led_binding_t* binding, lv_obj_t* led);
+
+/**
+ * @brief 设置 LED 颜色与亮灭, 与缓存相同则不做任何操作
+ * @param on false 时忽略 color, 只关闭 LED
+ * @return true: 已更新; false: 未变化
+ */
+bool ui_bind_led_set(ui_led_binding_t* binding, lv_color_t color, bool on);
+
+#endif /* UI_COMP_BINDING_H */
@@ -0,0 +1,215 @@
+/**
+ ******************************************************************************
+ * @file    ui_comp_card.c
+ * @brief   轻量数值卡片 / 仪表组件实现
+ * @details 布局在绘制时由对象内容区直接算出：标题占内容区顶部一行，
+ *          其下为数值区。普通卡片把数值区按数值个数等分，每格内"数值 + 单位"
+ *          水平居中；仪表卡片在数值区中央画 270° 的背景弧与指示弧，
+ *          数值与单位上下排列在弧心。异常标记画在内容区右上角。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_comp_card.h"
+#include <string.h>
+
+#define UI_CARD_UNIT_GAP 5         /* 数值与单位的间距 */
+#define UI_CARD_ARC_WIDTH 8        /* 仪表弧宽度 */
+#define UI_CARD_ARC_START 135      /* 仪表弧起止角度 (0° 为 3 点钟方向，顺时针) */
+#define UI_CARD_ARC_SWEEP 270
+
+/* -----------------------------------------------------------
+ * 私有函数
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 数值区 (内容区去掉标题行)
+ */
+static void card_value_area(const ui_card_t *card, lv_area_t *area) {
+  lv_obj_get_content_coords(card->obj, area);
+  area->y1 += lv_font_get_line_height(card->cfg->text_font);
+}
+
+/**
+ * @brief 以 (cx, cy) 为中心绘制一行文字
+ */
+static void card_draw_text(lv_draw_ctx_t *draw_ctx, lv_draw_label_dsc_t *dsc,
+                           const lv_font_t *font, const char *text,
+                           lv_coord_t cx, lv_coord_t cy) {
+  lv_point_t size;
+  lv_area_t area;
+
+  lv_txt_get_size(&size, text, font, 0, 0, LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+  area.x1 = cx - size.x / 2;
+  area.y1 = cy - size.y / 2;
+  area.x2 = area.x1 + size.x - 1;
+  area.y2 = area.y1 + size.y - 1;
+  dsc->font = font;
+  lv_draw_label(draw_ctx, dsc, &area, text, NULL);
+}
+
+/**
+ * @brief 普通卡片：各格内"数值 + 单位"并排居中
+ */
+static void card_draw_fields(const ui_card_t *card, lv_draw_ctx_t *draw_ctx,
+                             lv_draw_label_dsc_t *dsc, const lv_area_t *band) {
+  const ui_card_config_t *cfg = card->cfg;
+  lv_coord_t cell_w = lv_area_get_width(band) / cfg->field_count;
+  lv_coord_t cy = (band->y1 + band->y2) / 2;
+
+  for (uint8_t i = 0; i < cfg->field_count; i++) {
+    lv_point_t value_size, unit_size;
+    lv_coord_t left;
+
+    lv_txt_get_size(&value_size, card->text[i], cfg->value_font, 0, 0,
+                    LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    lv_txt_get_size(&unit_size, cfg->units[i], cfg->text_font, 0, 0,
+                    LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+    left = band->x1 + cell_w * i +
+           (cell_w - value_size.x - UI_CARD_UNIT_GAP - unit_size.x) / 2;
+    card_draw_text(draw_ctx, dsc, cfg->value_font, card->text[i],
+                   left + value_size.x / 2, cy);
+    card_draw_text(draw_ctx, dsc, cfg->text_font, cfg->units[i],
+                   left + value_size.x + UI_CARD_UNIT_GAP + unit_size.x / 2,
+                   cy);
+  }
+}
+
+/**
+ * @brief 仪表卡片：背景弧 + 指示弧，弧心为数值与单位
+ */
+static void card_draw_gauge(const ui_card_t *card, lv_draw_ctx_t *draw_ctx,
+                            lv_draw_label_dsc_t *dsc, const lv_area_t *band) {
+  const ui_card_config_t *cfg = card->cfg;
+  lv_draw_arc_dsc_t arc;
+  lv_point_t center;
+  lv_coord_t radius;
+  int32_t span = cfg->gauge_max - cfg->gauge_min;
+  int32_t value = card->gauge_value;
+  lv_coord_t value_h = lv_font_get_line_height(cfg->value_font);
+  lv_coord_t unit_h = lv_font_get_line_height(cfg->text_font);
+
+  center.x = (band->x1 + band->x2) / 2;
+  center.y = (band->y1 + band->y2) / 2;
+  radius = LV_MIN(lv_area_get_width(band), lv_area_get_height(band)) / 2;
+
+  lv_draw_arc_dsc_init(&arc);
+  arc.width = UI_CARD_ARC_WIDTH;
+  arc.rounded = 1;
+  arc.color = lv_palette_lighten(LV_PALETTE_GREY, 3);
+  lv_draw_arc(draw_ctx, &arc, &center, radius, UI_CARD_ARC_START,
+              (UI_CARD_ARC_START + UI_CARD_ARC_SWEEP) % 360);
+
+  if (value > cfg->gauge_min && span > 0 && card->text[0][0] != '-') {
+    int32_t sweep;
+
+    if (value > cfg->gauge_max) {
+      value = cfg->gauge_max;
+    }
+    sweep = (value - cfg->gauge_min) * UI_CARD_ARC_SWEEP / span;
+    arc.color = value >= cfg->gauge_warn ? lv_palette_main(LV_PALETTE_RED)
+                                         : lv_palette_main(LV_PALETTE_BLUE);
+    lv_draw_arc(draw_ctx, &arc, &center, radius, UI_CARD_ARC_START,
+                (uint16_t)((UI_CARD_ARC_START + sweep) % 360));
+  }
+
+  card_draw_text(draw_ctx, dsc, cfg->value_font, card->text[0], center.x,
+                 center.y - unit_h / 2);
+  card_draw_text(draw_ctx, dsc, cfg->text_font, cfg->units[0], center.x,
+                 center.y + value_h / 2);
+}
+
+static void card_draw_event_cb(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_target(e);
+  ui_card_t *card = (ui_card_t *)lv_event_get_user_data(e);
+  lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+  lv_draw_label_dsc_t dsc;
+  lv_area_t content, band;
+
+  lv_obj_get_content_coords(obj, &content);
+  card_value_area(card, &band);
+  lv_draw_label_dsc_init(&dsc);
+  dsc.color = lv_obj_get_style_text_color(obj, LV_PART_MAIN);
+
+  card_draw_text(draw_ctx, &dsc, card->cfg->text_font, card->cfg->title,
+                 (content.x1 + content.x2) / 2,
+                 content.y1 + lv_font_get_line_height(card->cfg->text_font) / 2);
+
+  if (card->cfg->gauge) {
+    card_draw_gauge(card, draw_ctx, &dsc, &band);
+  } else {
+    card_draw_fields(card, draw_ctx, &dsc, &band);
+  }
+
+  if (card->alert) {
+    const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_point_t size;
+    lv_area_t area;
+
+    lv_txt_get_size(&size, LV_SYMBOL_WARNING, font, 0, 0, LV_COORD_MAX,
+                    LV_TEXT_FLAG_NONE);
+    area.x2 = content.x2;
+    area.x1 = area.x2 - size.x + 1;
+    area.y1 = content.y1;
+    area.y2 = area.y1 + size.y - 1;
+    dsc.font = font;
+    dsc.color = lv_palette_main(LV_PALETTE_ORANGE);
+    lv_draw_label(draw_ctx, &dsc, &area, LV_SYMBOL_WARNING, NULL);
+  }
+}
+
+/* -----------------------------------------------------------
+ * 公共函数
+ * ----------------------------------------------------------- */
+
+lv_obj_t *ui_comp_card_create(lv_obj_t *parent, ui_card_t *card,
+                              const ui_card_config_t *cfg) {
+  memset(card, 0, sizeof(*card));
+  card->cfg = cfg;
+  for (uint8_t i = 0; i < UI_CARD_MAX_FIELDS; i++) {
+    strcpy(card->text[i], "--");
+  }
+
+  card->obj = lv_obj_create(parent);
+  lv_obj_clear_flag(card->obj, LV_OBJ_FLAG_SCROLLABLE);
+  lv_obj_add_event_cb(card->obj, card_draw_event_cb, LV_EVENT_DRAW_MAIN_END,
+                      card);
+  return card->obj;
+}
+
+bool ui_comp_card_set_text(ui_card_t *card, uint8_t field, const char *text) {
+  lv_area_t band;
+
+  if (card == NULL || card->obj == NULL || text == NULL ||
+      field >= card->cfg->field_count ||
+      strncmp(card->text[field], text, UI_CARD_TEXT_MAX) == 0) {
+    return false;
+  }
+  strncpy(card->text[field], text, UI_CARD_TEXT_MAX - 1);
+  card->text[field][UI_CARD_TEXT_MAX - 1] = '\0';
+
+  card_value_area(card, &band);
+  lv_obj_invalidate_area(card->obj, &band);
+  return true;
+}
+
+void ui_comp_card_set_gauge(ui_card_t *card, int32_t value) {
+  lv_area_t band;
+
+  if (card == NULL || card->obj == NULL || !card->cfg->gauge ||
+      card->gauge_value == value) {
+    return;
+  }
+  card->gauge_value = value;
+  card_value_area(card, &band);
+  lv_obj_invalidate_area(card->obj, &band);
+}
+
+void ui_comp_card_set_alert(ui_card_t *card, bool alert) {
+  if (card == NULL || card->obj == NULL || card->alert == alert) {
+    return;
+  }
+  card->alert = alert;
+  lv_obj_invalidate(card->obj);
+}
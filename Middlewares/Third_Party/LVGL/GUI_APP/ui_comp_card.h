@@ -0,0 +1,73 @@
+/**
+ * @file    ui_comp_card.h
+ * @brief   轻量数值卡片 / 仪表组件
+ * @details 一张卡片只有一个 LVGL 对象：标题、数值、单位、异常标记与仪表弧
+ *          都在对象的 LV_EVENT_DRAW_MAIN_END 回调中直接绘制，不再为每个
+ *          文字创建标签与 flex 容器 (原仪表盘一张卡片 6~10 个对象)。
+ *            1. 卡片状态 (ui_card_t) 由调用者静态分配，对象的 user_data
+ *               指向它，lv_mem 中只有对象本身；
+ *            2. 没有子对象，不参与 flex 布局与样式继承计算；
+ *            3. 数值变化时只使标题以下的数值区域失效，标题不重绘。
+ *          对象使用主题的默认卡片样式 (背景、边框、圆角、内边距)，
+ *          文字颜色取对象 LV_PART_MAIN 的 text_color。
+ */
+
+#ifndef UI_COMP_CARD_H
+#define UI_COMP_CARD_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UI_CARD_MAX_FIELDS 2 /* 每张卡片最多的数值个数 (并排显示) */
+#define UI_CARD_TEXT_MAX 12  /* 数值文本最大长度 (含结束符) */
+
+/* 卡片配置 (字符串与字体须为静态存储) */
+typedef struct {
+  const char *title;                     /* 标题 */
+  const char *units[UI_CARD_MAX_FIELDS]; /* 各数值的单位 */
+  uint8_t field_count;                   /* 数值个数 (1 ~ UI_CARD_MAX_FIELDS) */
+  const lv_font_t *text_font;            /* 标题与单位字体 */
+  const lv_font_t *value_font;           /* 数值字体 */
+  bool gauge;        /* 绘制仪表弧 (按第一个数值的 gauge 值) */
+  int32_t gauge_min; /* 仪表量程 */
+  int32_t gauge_max;
+  int32_t gauge_warn; /* 达到该值时指示弧改为告警色 */
+} ui_card_config_t;
+
+/* 卡片状态 (由调用者分配，生命周期不短于对象) */
+typedef struct {
+  lv_obj_t *obj;
+  const ui_card_config_t *cfg;
+  char text[UI_CARD_MAX_FIELDS][UI_CARD_TEXT_MAX]; /* 当前数值文本 */
+  int32_t gauge_value;                             /* 仪表当前值 */
+  bool alert;                                      /* 显示异常标记 */
+} ui_card_t;
+
+/**
+ * @brief 创建卡片对象
+ * @param parent 父对象
+ * @param card   卡片状态
+ * @param cfg    卡片配置
+ * @return 卡片对象 (数值初始为 "--")
+ */
+lv_obj_t *ui_comp_card_create(lv_obj_t *parent, ui_card_t *card,
+                              const ui_card_config_t *cfg);
+
+/**
+ * @brief 设置数值文本，与当前文本相同则不做任何操作
+ * @return true: 已更新
+ */
+bool ui_comp_card_set_text(ui_card_t *card, uint8_t field, const char *text);
+
+/**
+ * @brief 设置仪表值，不变则不做任何操作
+ */
+void ui_comp_card_set_gauge(ui_card_t *card, int32_t value);
+
+/**
+ * @brief 显示 / 隐藏右上角的异常标记
+ */
+void ui_comp_card_set_alert(ui_card_t *card, bool alert);
+
+#endif /* UI_COMP_CARD_H */
@@ -0,0 +1,179 @@
+/**
+ ******************************************************************************
+ * @file    ui_comp_gif.c
+ * @brief   GIF 动画组件实现
+ * @details gd_get_frame 先按上一帧的处置方式处理画布 (方式 2 把上一帧矩形
+ *          恢复为背景，其余方式不改变已有像素)，再读入本帧；gd_render_frame
+ *          只写本帧矩形。因此一帧改变的像素不超出两个矩形的并集。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_comp_gif.h"
+#include "main.h"
+#include "profiler.h"
+
+typedef struct {
+  lv_obj_t *obj;
+  lv_timer_t *timer;
+  uint32_t last_call;   // 上一帧解码时刻 (lv_tick)
+  uint32_t interval_ms; // 到下一帧的最短间隔 (帧延时与解码预算取大)
+  bool active;          // 未被暂停
+} ui_gif_ctx_t;
+
+/* -----------------------------------------------------------
+ * 私有函数
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 画布矩形 (GIF 坐标) 转为屏幕坐标
+ */
+static void gif_rect_to_area(const lv_obj_t *obj, uint16_t x, uint16_t y,
+                             uint16_t w, uint16_t h, lv_area_t *area) {
+  lv_area_t content;
+
+  lv_obj_get_content_coords(obj, &content);
+  area->x1 = content.x1 + x;
+  area->y1 = content.y1 + y;
+  area->x2 = area->x1 + w - 1;
+  area->y2 = area->y1 + h - 1;
+}
+
+/**
+ * @brief 对象按 1:1 绘制 GIF 时才能只使部分区域失效
+ */
+static bool gif_is_plain(lv_obj_t *obj, const gd_GIF *gif) {
+  return lv_img_get_zoom(obj) == LV_IMG_ZOOM_NONE &&
+         lv_img_get_angle(obj) == 0 && lv_img_get_offset_x(obj) == 0 &&
+         lv_img_get_offset_y(obj) == 0 &&
+         lv_obj_get_content_width(obj) == gif->width &&
+         lv_obj_get_content_height(obj) == gif->height;
+}
+
+static void gif_timer_cb(lv_timer_t *t) {
+  ui_gif_ctx_t *ctx = (ui_gif_ctx_t *)t->user_data;
+  lv_gif_t *gifobj = (lv_gif_t *)ctx->obj;
+  gd_GIF *gif = gifobj->gif;
+  uint16_t px, py, pw, ph;
+  bool prev_cleared;
+  uint32_t start, cost_us, budget_ms;
+  int has_next;
+
+  if (gif == NULL || lv_tick_elaps(ctx->last_call) < ctx->interval_ms) {
+    return;
+  }
+  if (!lv_obj_is_visible(ctx->obj)) {
+    return; // 不可见：保持当前帧，重新可见后从这里继续
+  }
+
+  /* 上一帧矩形在 gd_get_frame 中按其处置方式处理 */
+  px = gif->fx;
+  py = gif->fy;
+  pw = gif->fw;
+  ph = gif->fh;
+  prev_cleared = gif->gce.disposal == 2;
+
+  start = prof_now();
+  has_next = gd_get_frame(gif);
+  if (has_next == 0) {
+    /* 最后一次循环结束 */
+    if (gif->loop_count == 1) {
+      if (lv_event_send(ctx->obj, LV_EVENT_READY, NULL) != LV_RES_OK) {
+        return;
+      }
+    } else {
+      if (gif->loop_count > 1) {
+        gif->loop_count--;
+      }
+      gd_rewind(gif);
+    }
+  }
+  gd_render_frame(gif, (uint8_t *)gifobj->imgdsc.data);
+  cost_us = (prof_now() - start) / (SystemCoreClock / 1000000U);
+
+  /* 下一帧: 帧延时与解码预算取大，从本次解码时刻起算 (落后时不追帧) */
+  ctx->last_call = lv_tick_get();
+  budget_ms = cost_us / (UI_GIF_DECODE_BUDGET_PCT * 10U);
+  ctx->interval_ms = (uint32_t)gif->gce.delay * 10U;
+  if (ctx->interval_ms < budget_ms) {
+    ctx->interval_ms = budget_ms;
+  }
+
+  lv_img_cache_invalidate_src(lv_img_get_src(ctx->obj));
+  if (gif_is_plain(ctx->obj, gif)) {
+    lv_area_t area;
+
+    if (gif->fw > 0 && gif->fh > 0) {
+      gif_rect_to_area(ctx->obj, gif->fx, gif->fy, gif->fw, gif->fh, &area);
+      lv_obj_invalidate_area(ctx->obj, &area);
+    }
+    if (prev_cleared && pw > 0 && ph > 0) {
+      gif_rect_to_area(ctx->obj, px, py, pw, ph, &area);
+      lv_obj_invalidate_area(ctx->obj, &area); // 与本帧重叠时由 LVGL 合并
+    }
+  } else {
+    lv_obj_invalidate(ctx->obj); // 缩放或平铺显示：整体失效
+  }
+}
+
+static void gif_delete_event_cb(lv_event_t *e) {
+  ui_gif_ctx_t *ctx = (ui_gif_ctx_t *)lv_event_get_user_data(e);
+
+  lv_timer_del(ctx->timer);
+  lv_mem_free(ctx);
+}
+
+/* -----------------------------------------------------------
+ * 公共函数
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 创建 GIF 对象并开始播放
+ */
+lv_obj_t *ui_comp_gif_create(lv_obj_t *parent, const void *src) {
+  lv_obj_t *obj = lv_gif_create(parent);
+  lv_gif_t *gifobj = (lv_gif_t *)obj;
+  ui_gif_ctx_t *ctx;
+
+  lv_gif_set_src(obj, src); // 解码第一帧
+  lv_timer_pause(gifobj->timer); // lv_gif 自带的定时器不再使用
+  if (gifobj->gif == NULL) {
+    return obj;
+  }
+
+  ctx = (ui_gif_ctx_t *)lv_mem_alloc(sizeof(ui_gif_ctx_t));
+  if (ctx == NULL) {
+    return obj;
+  }
+  ctx->obj = obj;
+  ctx->last_call = lv_tick_get();
+  ctx->interval_ms = (uint32_t)gifobj->gif->gce.delay * 10U;
+  ctx->active = true;
+  ctx->timer = lv_timer_create(gif_timer_cb, UI_GIF_TIMER_PERIOD_MS, ctx);
+  lv_obj_set_user_data(obj, ctx);
+  lv_obj_add_event_cb(obj, gif_delete_event_cb, LV_EVENT_DELETE, ctx);
+  return obj;
+}
+
+/**
+ * @brief 暂停 / 恢复播放
+ */
+void ui_comp_gif_set_active(lv_obj_t *obj, bool active) {
+  ui_gif_ctx_t *ctx;
+
+  if (obj == NULL) {
+    return;
+  }
+  ctx = (ui_gif_ctx_t *)lv_obj_get_user_data(obj);
+  if (ctx == NULL || ctx->active == active) {
+    return;
+  }
+  ctx->active = active;
+  if (active) {
+    ctx->last_call = lv_tick_get(); // 暂停的时间不计入帧延时
+    lv_timer_resume(ctx->timer);
+  } else {
+    lv_timer_pause(ctx->timer);
+  }
+}
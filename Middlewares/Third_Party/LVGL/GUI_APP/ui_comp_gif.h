@@ -0,0 +1,35 @@
+/**
+ * @file    ui_comp_gif.h
+ * @brief   GIF 动画组件
+ * @details 在 lv_gif 对象上用自己的帧定时器代替 lv_gif 的定时器：
+ *            1. 每帧只使本帧矩形与上一帧"恢复背景"矩形的并集失效，
+ *               不再整个对象重绘 (对象尺寸与 GIF 不同时仍整体失效)；
+ *            2. 解码时间按占空比限制：一帧解码耗时 t 后，下一帧至少间隔
+ *               t * 100 / UI_GIF_DECODE_BUDGET_PCT，落后时不追帧；
+ *            3. 对象不可见 (被遮挡、滚出或所在屏幕未加载) 或被暂停
+ *               (屏幕隐藏、界面空闲) 时不解码。
+ */
+
+#ifndef UI_COMP_GIF_H
+#define UI_COMP_GIF_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+
+#define UI_GIF_DECODE_BUDGET_PCT 10 /* 解码时间占 LVGL 任务时间的上限 (%) */
+#define UI_GIF_TIMER_PERIOD_MS 10   /* 帧定时器周期 */
+
+/**
+ * @brief 创建 GIF 对象并开始播放
+ * @param parent 父对象
+ * @param src GIF 数据 (lv_img_dsc_t) 或文件路径
+ * @return lv_gif 对象；内存不足时返回的对象不播放
+ */
+lv_obj_t* ui_comp_gif_create(lv_obj_t* parent, const void* src);
+
+/**
+ * @brief 暂停 / 恢复播放 (屏幕隐藏、界面空闲时暂停)
+ */
+void ui_comp_gif_set_active(lv_obj_t* obj, bool active);
+
+#endif /* UI_COMP_GIF_H */
@@ -3,161 +3,307 @@
  * @file    ui_comp_header.c
  * @brief   可重用的页面顶部栏组件实现
  * @details 提供统一的顶部栏样式，包含返回按钮、标题和时间显示。
+ *          控件常驻 lv_layer_top()，按钮回调转发给当前屏幕的配置。
+ *          时间来自 RTC：时钟定时器由 RTC 每秒事件使其就绪，执行一次后
+ *          暂停，不再轮询。
  * @author  MmsY
  * @time    2025/11/23
  ******************************************************************************
  */
 
 #include "ui_comp_header.h"
+#include "rtc_clock.h"
+#include "ui_styles.h"
 #include <stdio.h>
-#include <time.h>
-
-/* 声明外部字体 */
-LV_FONT_DECLARE(my_font_yahei_24);
+#include <string.h>
+#if UI_HEADER_SHOW_FRAME_STATS
+#include "frame_stats.h"
+#endif
 
 /* 顶部栏高度 */
 #define HEADER_HEIGHT 70
 
-/* 顶部栏背景色 */
-#define HEADER_BG_COLOR 0xF5EFE6
-
-/* 时间更新定时器周期 (ms) */
+/* 共享时钟定时器周期 (ms)：平时暂停，由 RTC 每秒事件唤醒；
+ * 显示帧统计时按此周期持续运行 */
 #define TIME_UPDATE_PERIOD_MS 1000
 
+/* 时间未设置 (显示 --:--:--) */
+#define HEADER_TIME_UNSET UINT32_MAX
+
+/* -----------------------------------------------------------
+ * 内部变量
+ * ----------------------------------------------------------- */
+/* 共用的顶部栏控件 */
+static struct {
+  lv_obj_t *container;    /* 顶部栏容器 (lv_layer_top 的子对象) */
+  lv_obj_t *back_btn;     /* 返回按钮 */
+  lv_obj_t *custom_btn;   /* 自定义按钮 */
+  lv_obj_t *custom_label; /* 自定义按钮文字 */
+  lv_obj_t *title_label;  /* 标题标签 */
+  lv_obj_t *time_label;   /* 时间标签 */
+  lv_obj_t *stats_label;  /* 帧统计标签 (UI_HEADER_SHOW_FRAME_STATS) */
+  uint32_t shown_time;    /* 时间标签当前显示的秒 (RtcClock_Now) */
+} s_bar;
+
+static ui_header_t *s_current = NULL;    /* 当前屏幕的配置，NULL 时隐藏 */
+static lv_timer_t *s_clock_timer = NULL;
+
 /* -----------------------------------------------------------
  * 内部函数声明
  * ----------------------------------------------------------- */
-static void time_update_timer_cb(lv_timer_t *timer);
+static void clock_timer_cb(lv_timer_t *timer);
+static void header_update_time(void);
+#if UI_HEADER_SHOW_FRAME_STATS
+static void header_update_frame_stats(void);
+#endif
 
 /* -----------------------------------------------------------
- * 时间更新定时器回调
+ * 时钟定时器回调：刷新可见的顶部栏
  * ----------------------------------------------------------- */
-static void time_update_timer_cb(lv_timer_t *timer) {
-  ui_header_t *header = (ui_header_t *)timer->user_data;
-  if (header && header->time_label) {
-    ui_comp_header_update_time(header);
+static void clock_timer_cb(lv_timer_t *timer) {
+  if (s_current) {
+    header_update_time();
+#if UI_HEADER_SHOW_FRAME_STATS
+    header_update_frame_stats();
+#endif
   }
+#if !UI_HEADER_SHOW_FRAME_STATS
+  lv_timer_pause(timer); /* 等待下一个 RTC 秒事件 */
+#else
+  (void)timer;
+#endif
 }
 
+#if UI_HEADER_SHOW_FRAME_STATS
 /* -----------------------------------------------------------
- * 公共 API 实现
+ * 帧统计叠加显示
+ * ----------------------------------------------------------- */
+static void header_update_frame_stats(void) {
+  FrameStats_t fs;
+  if (!FrameStats_Get(&fs)) {
+    lv_label_set_text(s_bar.stats_label, "-- Hz");
+    return;
+  }
+  /* 第一行: 刷新率与主循环空闲占比; 第二行: 平均渲染/flush 耗时 (ms) */
+  lv_label_set_text_fmt(s_bar.stats_label,
+                        "%u.%u Hz  idle %u%%\nR %lu.%lu  F %lu.%lu ms",
+                        fs.refr_rate_x10 / 10, fs.refr_rate_x10 % 10,
+                        fs.idle_permille / 10,
+                        (unsigned long)(fs.render_us_avg / 1000),
+                        (unsigned long)(fs.render_us_avg % 1000 / 100),
+                        (unsigned long)(fs.flush_us_avg / 1000),
+                        (unsigned long)(fs.flush_us_avg % 1000 / 100));
+}
+#endif
+
+/* -----------------------------------------------------------
+ * 更新时间显示 (显示的秒未变化时不重绘)
  * ----------------------------------------------------------- */
+static void header_update_time(void) {
+  if (lv_obj_has_flag(s_bar.time_label, LV_OBJ_FLAG_HIDDEN))
+    return;
 
-/**
- * @brief 创建标准顶部栏
- */
-ui_header_t *ui_comp_header_create(lv_obj_t *parent,
-                                   const ui_header_config_t *config) {
-  /* 分配句柄内存 */
-  ui_header_t *header = (ui_header_t *)lv_mem_alloc(sizeof(ui_header_t));
-  if (!header)
-    return NULL;
-  memset(header, 0, sizeof(ui_header_t));
+  uint32_t now = RtcClock_IsSet() ? RtcClock_Now() : HEADER_TIME_UNSET;
+  if (now == s_bar.shown_time)
+    return; /* 显示的秒未变化 */
+  s_bar.shown_time = now;
+
+  if (now == HEADER_TIME_UNSET) {
+    lv_label_set_text(s_bar.time_label, "--:--:--");
+    return;
+  }
+  uint32_t sec = now % 86400;
+  lv_label_set_text_fmt(s_bar.time_label, "%02u:%02u:%02u",
+                        (unsigned)(sec / 3600), (unsigned)(sec / 60 % 60),
+                        (unsigned)(sec % 60));
+}
+
+/* -----------------------------------------------------------
+ * 只在状态/文本变化时修改控件，避免无谓的重绘
+ * ----------------------------------------------------------- */
+static void header_set_visible(lv_obj_t *obj, bool visible) {
+  if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN) != visible)
+    return;
+  if (visible) {
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_HIDDEN);
+  } else {
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+  }
+}
+
+static void header_set_text(lv_obj_t *label, const char *text) {
+  if (strcmp(lv_label_get_text(label), text) != 0) {
+    lv_label_set_text(label, text);
+  }
+}
+
+/* -----------------------------------------------------------
+ * 把当前屏幕的配置应用到共用控件
+ * ----------------------------------------------------------- */
+static void header_apply(const ui_header_t *header) {
+  const ui_header_config_t *config = &header->config;
+  bool custom = config->show_custom_btn && config->custom_btn_text;
+
+  header_set_visible(s_bar.back_btn, config->show_back_btn);
+  header_set_visible(s_bar.custom_btn, custom);
+  if (custom) {
+    header_set_text(s_bar.custom_label, config->custom_btn_text);
+  }
+  header_set_text(s_bar.title_label, header->title);
+  if (config->title_long_press_cb) {
+    lv_obj_add_flag(s_bar.title_label, LV_OBJ_FLAG_CLICKABLE);
+  } else {
+    lv_obj_clear_flag(s_bar.title_label, LV_OBJ_FLAG_CLICKABLE);
+  }
+  header_set_visible(s_bar.time_label, config->show_time);
+  header_update_time();
+}
+
+/* -----------------------------------------------------------
+ * 控件事件转发给当前屏幕的回调 (user_data 换成屏幕的 user_data)
+ * ----------------------------------------------------------- */
+static void header_forward(lv_event_t *e, lv_event_cb_t cb) {
+  lv_event_t fwd;
+
+  if (!cb)
+    return;
+  fwd = *e;
+  fwd.user_data = s_current->config.user_data;
+  cb(&fwd);
+}
+
+static void back_btn_event_cb(lv_event_t *e) {
+  if (s_current)
+    header_forward(e, s_current->config.back_btn_cb);
+}
+
+static void custom_btn_event_cb(lv_event_t *e) {
+  if (s_current)
+    header_forward(e, s_current->config.custom_btn_cb);
+}
+
+static void title_event_cb(lv_event_t *e) {
+  if (s_current)
+    header_forward(e, s_current->config.title_long_press_cb);
+}
 
+/* -----------------------------------------------------------
+ * 创建共用的顶部栏控件 (只执行一次，初始隐藏)
+ * ----------------------------------------------------------- */
+static void header_bar_create(void) {
   /* === 1. 创建顶部栏容器 === */
-  header->container = lv_obj_create(parent);
-  lv_obj_remove_style_all(header->container);
-  lv_obj_set_size(header->container, LV_PCT(100), HEADER_HEIGHT);
-  lv_obj_set_style_bg_color(header->container, lv_color_hex(HEADER_BG_COLOR),
-                            0);
-  lv_obj_set_style_bg_opa(header->container, LV_OPA_COVER, 0);
-  lv_obj_set_style_pad_all(header->container, 10, 0); /* 左右内边距 */
+  s_bar.container = lv_obj_create(lv_layer_top());
+  lv_obj_remove_style_all(s_bar.container);
+  lv_obj_set_size(s_bar.container, LV_PCT(100), HEADER_HEIGHT);
+  lv_obj_add_style(s_bar.container, ui_style(UI_STYLE_HEADER), 0);
+  lv_obj_add_flag(s_bar.container, LV_OBJ_FLAG_HIDDEN);
 
   /* 使用 Flex 布局 (水平排列) */
-  lv_obj_set_flex_flow(header->container, LV_FLEX_FLOW_ROW);
-  lv_obj_set_flex_align(header->container,
+  lv_obj_set_flex_flow(s_bar.container, LV_FLEX_FLOW_ROW);
+  lv_obj_set_flex_align(s_bar.container,
                         LV_FLEX_ALIGN_SPACE_BETWEEN, /* 主轴两端对齐 */
                         LV_FLEX_ALIGN_CENTER,        /* 交叉轴居中 */
                         LV_FLEX_ALIGN_CENTER);
-  lv_obj_set_style_pad_gap(header->container, 10, 0); /* 子元素间距 */
 
   /* === 2. 创建左侧容器 (返回按钮 + 自定义按钮) === */
-  lv_obj_t *left_container = lv_obj_create(header->container);
+  lv_obj_t *left_container = lv_obj_create(s_bar.container);
   lv_obj_remove_style_all(left_container);
   lv_obj_set_size(left_container, LV_SIZE_CONTENT, LV_PCT(100));
   lv_obj_set_flex_flow(left_container, LV_FLEX_FLOW_ROW);
   lv_obj_set_flex_align(left_container, LV_FLEX_ALIGN_START,
                         LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-  lv_obj_set_style_pad_gap(left_container, 10, 0);
-
-  /* 2.1 返回按钮 (可选) */
-  if (config->show_back_btn) {
-    header->back_btn = lv_btn_create(left_container);
-    lv_obj_set_size(header->back_btn, 80, 40);
-
-    lv_obj_t *back_label = lv_label_create(header->back_btn);
-    lv_label_set_text(back_label, LV_SYMBOL_LEFT " 返回");
-    lv_obj_set_style_text_font(back_label, &my_font_yahei_24, 0);
-    lv_obj_center(back_label);
-
-    if (config->back_btn_cb) {
-      lv_obj_add_event_cb(header->back_btn, config->back_btn_cb,
-                          LV_EVENT_CLICKED, config->user_data);
-    }
-  }
+  lv_obj_add_style(left_container, ui_style(UI_STYLE_GAP), 0);
 
-  /* 2.2 自定义按钮 (可选) */
-  if (config->show_custom_btn && config->custom_btn_text) {
-    header->custom_btn = lv_btn_create(left_container);
-    lv_obj_set_size(header->custom_btn, 80, 40);
+  /* 2.1 返回按钮 (按屏幕配置显示) */
+  s_bar.back_btn = lv_btn_create(left_container);
+  lv_obj_set_size(s_bar.back_btn, 80, 40);
+  lv_obj_add_flag(s_bar.back_btn, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_add_event_cb(s_bar.back_btn, back_btn_event_cb, LV_EVENT_CLICKED,
+                      NULL);
 
-    lv_obj_t *custom_label = lv_label_create(header->custom_btn);
-    lv_label_set_text(custom_label, config->custom_btn_text);
-    lv_obj_set_style_text_font(custom_label, &my_font_yahei_24, 0);
-    lv_obj_center(custom_label);
+  lv_obj_t *back_label = lv_label_create(s_bar.back_btn);
+  lv_label_set_text(back_label, LV_SYMBOL_LEFT " 返回");
+  lv_obj_add_style(back_label, ui_style(UI_STYLE_TEXT_CN), 0);
+  lv_obj_center(back_label);
 
-    if (config->custom_btn_cb) {
-      lv_obj_add_event_cb(header->custom_btn, config->custom_btn_cb,
-                          LV_EVENT_CLICKED, config->user_data);
-    }
-  }
+  /* 2.2 自定义按钮 (按屏幕配置显示) */
+  s_bar.custom_btn = lv_btn_create(left_container);
+  lv_obj_set_size(s_bar.custom_btn, 80, 40);
+  lv_obj_add_flag(s_bar.custom_btn, LV_OBJ_FLAG_HIDDEN);
+  lv_obj_add_event_cb(s_bar.custom_btn, custom_btn_event_cb, LV_EVENT_CLICKED,
+                      NULL);
+
+  s_bar.custom_label = lv_label_create(s_bar.custom_btn);
+  lv_label_set_text(s_bar.custom_label, "");
+  lv_obj_add_style(s_bar.custom_label, ui_style(UI_STYLE_TEXT_CN), 0);
+  lv_obj_center(s_bar.custom_label);
 
   /* === 3. 创建标题 (居中) === */
-  header->title_label = lv_label_create(header->container);
-  lv_label_set_text(header->title_label,
-                    config->title ? config->title : "未命名页面");
-  lv_obj_set_style_text_font(header->title_label, &my_font_yahei_24, 0);
-  lv_obj_set_flex_grow(header->title_label, 1); /* 占据剩余空间 */
-  lv_obj_set_style_text_align(header->title_label, LV_TEXT_ALIGN_CENTER, 0);
-
-  /* === 4. 创建时间标签 (右侧) === */
-  if (config->show_time) {
-    header->time_label = lv_label_create(header->container);
-    lv_label_set_text(header->time_label, "--:--:--");
-    lv_obj_set_style_text_font(header->time_label, &lv_font_montserrat_20, 0);
-    lv_obj_set_width(header->time_label, 100); /* 固定宽度，避免抖动 */
-    lv_obj_set_style_text_align(header->time_label, LV_TEXT_ALIGN_RIGHT, 0);
-
-    /* 立即更新一次时间 */
-    ui_comp_header_update_time(header);
-
-    /* 创建定时器以定期更新时间 */
-    header->time_update_timer =
-        lv_timer_create(time_update_timer_cb, TIME_UPDATE_PERIOD_MS, header);
-  }
+  s_bar.title_label = lv_label_create(s_bar.container);
+  lv_label_set_text(s_bar.title_label, "");
+  lv_obj_add_style(s_bar.title_label, ui_style(UI_STYLE_TEXT_CN), 0);
+  lv_obj_set_flex_grow(s_bar.title_label, 1); /* 占据剩余空间 */
+  lv_obj_set_style_text_align(s_bar.title_label, LV_TEXT_ALIGN_CENTER, 0);
+  lv_obj_add_event_cb(s_bar.title_label, title_event_cb, LV_EVENT_LONG_PRESSED,
+                      NULL);
+
+#if UI_HEADER_SHOW_FRAME_STATS
+  /* === 3.1 帧统计标签 (时间左侧) === */
+  s_bar.stats_label = lv_label_create(s_bar.container);
+  lv_obj_set_style_text_font(s_bar.stats_label, &lv_font_montserrat_12, 0);
+  lv_obj_set_width(s_bar.stats_label, 130); /* 固定宽度，避免抖动 */
+  header_update_frame_stats();
+#endif
+
+  /* === 4. 创建时间标签 (右侧，按屏幕配置显示) === */
+  s_bar.time_label = lv_label_create(s_bar.container);
+  lv_label_set_text(s_bar.time_label, "--:--:--");
+  s_bar.shown_time = HEADER_TIME_UNSET;
+  lv_obj_set_style_text_font(s_bar.time_label, &lv_font_montserrat_20, 0);
+  lv_obj_set_width(s_bar.time_label, 100); /* 固定宽度，避免抖动 */
+  lv_obj_set_style_text_align(s_bar.time_label, LV_TEXT_ALIGN_RIGHT, 0);
+
+  s_clock_timer = lv_timer_create(clock_timer_cb, TIME_UPDATE_PERIOD_MS, NULL);
+#if !UI_HEADER_SHOW_FRAME_STATS
+  lv_timer_pause(s_clock_timer);
+#endif
+}
+
+/* -----------------------------------------------------------
+ * 公共 API 实现
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 为屏幕启用顶部栏
+ */
+ui_header_t *ui_comp_header_create(const ui_header_config_t *config) {
+  /* 分配句柄内存 */
+  ui_header_t *header = (ui_header_t *)lv_mem_alloc(sizeof(ui_header_t));
+  if (!header)
+    return NULL;
+
+  header->config = *config;
+  ui_comp_header_set_title(header, config->title ? config->title
+                                                 : "未命名页面");
 
+  if (!s_bar.container) {
+    header_bar_create();
+  }
+  ui_comp_header_set_active(header, true);
   return header;
 }
 
 /**
- * @brief 销毁顶部栏
+ * @brief 销毁本屏幕的顶部栏配置
  */
 void ui_comp_header_destroy(ui_header_t *header) {
   if (!header)
     return;
 
-  /* 删除定时器 */
-  if (header->time_update_timer) {
-    lv_timer_del(header->time_update_timer);
-    header->time_update_timer = NULL;
+  /* 共用控件在 ui_comp_header_sync 中按需隐藏 */
+  if (s_current == header) {
+    s_current = NULL;
   }
-
-  /* 删除容器 (会自动删除所有子对象) */
-  if (header->container) {
-    lv_obj_del(header->container);
-  }
-
-  /* 释放句柄内存 */
   lv_mem_free(header);
 }
 
@@ -165,37 +311,69 @@ void ui_comp_header_destroy(ui_header_t *header) {
  * @brief 更新标题文本
  */
 void ui_comp_header_set_title(ui_header_t *header, const char *title) {
-  if (header && header->title_label) {
-    lv_label_set_text(header->title_label, title ? title : "");
+  if (!header)
+    return;
+
+  strncpy(header->title, title ? title : "", sizeof(header->title) - 1);
+  header->title[sizeof(header->title) - 1] = '\0';
+  header->config.title = header->title;
+  if (s_current == header) {
+    header_set_text(s_bar.title_label, header->title);
   }
 }
 
 /**
- * @brief 更新时间显示
- * @note 需要根据你的系统实现获取时间的逻辑
+ * @brief 更新自定义按钮文本
  */
-void ui_comp_header_update_time(ui_header_t *header) {
-  if (!header || !header->time_label)
+void ui_comp_header_set_custom_text(ui_header_t *header, const char *text) {
+  if (!header || !text)
     return;
 
-/* 方法1: 使用 C 标准库 time.h (如果支持) */
-#if 0
-    time_t now = time(NULL);
-    struct tm* tm_info = localtime(&now);
-    if (tm_info) {
-        lv_label_set_text_fmt(header->time_label, "%02d:%02d:%02d", 
-                              tm_info->tm_hour, 
-                              tm_info->tm_min, 
-                              tm_info->tm_sec);
-    }
-#else
-  /* 方法2: 如果没有 RTC，可以使用 lv_tick_get() 模拟 */
-  uint32_t tick_ms = lv_tick_get();
-  uint32_t total_seconds = tick_ms / 1000;
-  uint8_t hours = (total_seconds / 3600) % 24;
-  uint8_t minutes = (total_seconds / 60) % 60;
-  uint8_t seconds = total_seconds % 60;
-  lv_label_set_text_fmt(header->time_label, "%02d:%02d:%02d", hours, minutes,
-                        seconds);
+  header->config.custom_btn_text = text;
+  if (s_current == header && header->config.show_custom_btn) {
+    header_set_text(s_bar.custom_label, text);
+  }
+}
+
+/**
+ * @brief RTC 每秒事件到达
+ */
+void ui_comp_header_clock_tick(void) {
+  if (s_clock_timer) {
+    lv_timer_resume(s_clock_timer);
+    lv_timer_ready(s_clock_timer);
+  }
+}
+
+/**
+ * @brief 本屏幕显示 / 隐藏
+ */
+void ui_comp_header_set_active(ui_header_t *header, bool active) {
+  if (!header)
+    return;
+
+  if (active) {
+    s_current = header;
+    /* 隐藏期间时间已过期 */
+    header_apply(header);
+#if UI_HEADER_SHOW_FRAME_STATS
+    header_update_frame_stats();
 #endif
+  } else if (s_current == header) {
+    s_current = NULL;
+  }
+}
+
+/**
+ * @brief 屏幕切换完成后调用
+ */
+void ui_comp_header_sync(void) {
+  bool visible = s_current != NULL;
+
+  if (!s_bar.container ||
+      lv_obj_has_flag(s_bar.container, LV_OBJ_FLAG_HIDDEN) != visible)
+    return;
+
+  header_set_visible(s_bar.container, visible);
+  lv_obj_set_style_pad_top(lv_scr_act(), visible ? HEADER_HEIGHT : 0, 0);
 }
@@ -3,6 +3,9 @@
  * @brief   õҳ涥
  * @details ṩ׼ĶҲ֣
  *          ذť(ѡ) | Զ尴ť(ѡ) | () | ϵͳʱ
+ *          ֻһΣ lv_layer_top() ϣĻ·л
+ *          ĻֻԼ (ui_header_t)ʾʱӦõõĿؼ
+ *          лĻؽͬİťҲػ档
  */
 
 #ifndef UI_COMP_HEADER_H
@@ -11,38 +14,42 @@
 #include "lvgl.h"
 #include <stdbool.h>
 
+/* 1: ڶʱʾ֡ͳ (ˢ/Ⱦ/ˢ/) */
+#define UI_HEADER_SHOW_FRAME_STATS 0
+
+/* ı󳤶 (β 0ض) */
+#define UI_HEADER_TITLE_MAX 48
+
 /* ýṹ */
 typedef struct {
-    const char* title;              /* ҳı */
+    const char* title;              /* ҳı (ʱ) */
     bool show_back_btn;             /* Ƿʾذť */
     bool show_custom_btn;           /* ǷʾԶ尴ť */
-    const char* custom_btn_text;    /* Զ尴ťı ( """") */
+    const char* custom_btn_text;    /* Զ尴ťı ( """")賤Ч */
     lv_event_cb_t back_btn_cb;      /* ذťص */
     lv_event_cb_t custom_btn_cb;    /* Զ尴ťص */
     void* user_data;                /* ûԶ (ݸص) */
     bool show_time;                 /* Ƿʾϵͳʱ (Ĭʾ) */
+    lv_event_cb_t title_long_press_cb; /* ص (NULL: ⲻӦ) */
 } ui_header_config_t;
 
-/*  */
-typedef struct {
-    lv_obj_t* container;            /*  */
-    lv_obj_t* back_btn;             /* ذť */
-    lv_obj_t* custom_btn;           /* Զ尴ť */
-    lv_obj_t* title_label;          /* ǩ */
-    lv_obj_t* time_label;           /* ʱǩ */
-    lv_timer_t* time_update_timer;  /* ʱ¶ʱ */
+/* ĻԶ (Ļһ) */
+typedef struct ui_header_s {
+    ui_header_config_t config;      /* title ָĸ */
+    char title[UI_HEADER_TITLE_MAX];
 } ui_header_t;
 
 /**
- * @brief ׼
- * @param parent 
+ * @brief ΪĻö
+ * @details ڵһεʱ lv_layer_top()֮פ
+ *          ˴ֻòӦ (ֻݲͬĲֲŻػ)
  * @param config 
- * @return  (ҪԱ)
+ * @return ĻĶ (ҪԱ)
  */
-ui_header_t* ui_comp_header_create(lv_obj_t* parent, const ui_header_config_t* config);
+ui_header_t* ui_comp_header_create(const ui_header_config_t* config);
 
 /**
- * @brief ٶ (ͷԴ)
+ * @brief ٱĻĶ (õĶ)
  * @param header 
  */
 void ui_comp_header_destroy(ui_header_t* header);
@@ -55,9 +62,30 @@ void ui_comp_header_destroy(ui_header_t* header);
 void ui_comp_header_set_title(ui_header_t* header, const char* title);
 
 /**
- * @brief ֶʱʾ (ͨɶʱԶ)
+ * @brief Զ尴ťı
  * @param header 
+ * @param text ı (賤Ч)
+ */
+void ui_comp_header_set_custom_text(ui_header_t* header, const char* text);
+
+/**
+ * @brief RTC ÿ¼ ( ui_sleep  LVGL е)
+ * @details ʱӶʱƽʱͣ˴ֻ
+ */
+void ui_comp_header_clock_tick(void);
+
+/**
+ * @brief Ļʾ /  (Ļʱ false)
+ * @param header 
+ * @param active true ӦñĻòˢʱ䣬false ʹ
+ */
+void ui_comp_header_set_active(ui_header_t* header, bool active);
+
+/**
+ * @brief Ļлɺ (ui_manager)
+ * @details ûĻʹʱضʾ״̬仯ʱ lv_scr_act() 
+ *          ڱ߾࣬Ļ (100% ߶) ֮ܿ
  */
-void ui_comp_header_update_time(ui_header_t* header);
+void ui_comp_header_sync(void);
 
 #endif /* UI_COMP_HEADER_H */
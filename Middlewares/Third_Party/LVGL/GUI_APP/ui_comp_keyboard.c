@@ -0,0 +1,84 @@
+/**
+ ******************************************************************************
+ * @file    ui_comp_keyboard.c
+ * @brief   虚拟键盘组件实现
+ * @details 图集按键盘分配，键盘删除时释放。切换键盘模式 (符号页、大小写)
+ *          时字符集之外的键由原字体绘制，显示不受影响。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_comp_keyboard.h"
+#include "ui_glyph_atlas.h"
+
+/* -----------------------------------------------------------
+ * 私有函数
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 给被按下的键套用加深滤镜 (代替 LV_STATE_PRESSED 样式)
+ */
+static void keyboard_draw_part_event_cb(lv_event_t *e) {
+  lv_obj_t *obj = lv_event_get_target(e);
+  lv_obj_draw_part_dsc_t *dsc = lv_event_get_draw_part_dsc(e);
+  lv_draw_rect_dsc_t *rect;
+
+  if (dsc->class_p != &lv_btnmatrix_class ||
+      dsc->type != LV_BTNMATRIX_DRAW_PART_BTN ||
+      !lv_obj_has_state(obj, LV_STATE_PRESSED) ||
+      dsc->id != lv_btnmatrix_get_selected_btn(obj) ||
+      lv_btnmatrix_has_btn_ctrl(obj, dsc->id, LV_BTNMATRIX_CTRL_DISABLED)) {
+    return;
+  }
+
+  rect = dsc->rect_dsc;
+  rect->bg_color = lv_color_darken(rect->bg_color, UI_KEYBOARD_PRESSED_DARKEN);
+  rect->border_color =
+      lv_color_darken(rect->border_color, UI_KEYBOARD_PRESSED_DARKEN);
+  rect->shadow_color =
+      lv_color_darken(rect->shadow_color, UI_KEYBOARD_PRESSED_DARKEN);
+  dsc->label_dsc->color =
+      lv_color_darken(dsc->label_dsc->color, UI_KEYBOARD_PRESSED_DARKEN);
+}
+
+static void keyboard_delete_event_cb(lv_event_t *e) {
+  ui_glyph_atlas_t *atlas = (ui_glyph_atlas_t *)lv_event_get_user_data(e);
+
+  ui_glyph_atlas_deinit(atlas);
+  lv_mem_free(atlas);
+}
+
+/* -----------------------------------------------------------
+ * 公共函数
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 创建虚拟键盘
+ */
+lv_obj_t *ui_comp_keyboard_create(lv_obj_t *parent, lv_keyboard_mode_t mode,
+                                  const char *keycaps) {
+  lv_obj_t *kb = lv_keyboard_create(parent);
+
+  lv_keyboard_set_mode(kb, mode);
+
+  /* 按下外观改由绘制回调提供，键盘状态变化不再使整个矩阵失效 */
+  lv_obj_remove_style(kb, NULL, LV_PART_ITEMS | LV_STATE_PRESSED);
+  lv_obj_add_event_cb(kb, keyboard_draw_part_event_cb,
+                      LV_EVENT_DRAW_PART_BEGIN, NULL);
+
+  if (keycaps != NULL) {
+    ui_glyph_atlas_t *atlas =
+        (ui_glyph_atlas_t *)lv_mem_alloc(sizeof(ui_glyph_atlas_t));
+
+    if (atlas != NULL) {
+      ui_glyph_atlas_init(atlas,
+                          lv_obj_get_style_text_font(kb, LV_PART_ITEMS),
+                          keycaps);
+      lv_obj_set_style_text_font(kb, &atlas->font, LV_PART_ITEMS);
+      lv_obj_add_event_cb(kb, keyboard_delete_event_cb, LV_EVENT_DELETE,
+                          atlas);
+    }
+  }
+  return kb;
+}
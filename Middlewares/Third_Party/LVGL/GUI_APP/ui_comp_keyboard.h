@@ -0,0 +1,38 @@
+/**
+ * @file    ui_comp_keyboard.h
+ * @brief   虚拟键盘组件
+ * @details 在 lv_keyboard 上减少每次按键的重绘：
+ *            1. 按键的按下外观不再由 LV_PART_ITEMS | LV_STATE_PRESSED 样式提供。
+ *               按矩阵是一个对象，整个键盘进入 PRESSED 状态时
+ *               lv_obj_set_state 会因为按键部件的样式不同而使整个键盘失效；
+ *               改为在 LV_EVENT_DRAW_PART_BEGIN 中对被按下的键套用同样的
+ *               加深滤镜后，按下/松开只剩 lv_btnmatrix 自己对这两个键的
+ *               局部失效。
+ *            2. 固定字符集的键帽字形预渲染为图集 (ui_glyph_atlas)，重绘
+ *               按键时不再查 cmap，8 bpp 位图直接作为遮罩混合；字符集之外
+ *               的字符 (符号键) 交给原字体。
+ */
+
+#ifndef UI_COMP_KEYBOARD_H
+#define UI_COMP_KEYBOARD_H
+
+#include "lvgl.h"
+
+/* 数字键盘 (LV_KEYBOARD_MODE_NUMBER) 上出现的全部 ASCII 字符 */
+#define UI_KEYBOARD_NUMBER_KEYCAPS "0123456789+-./"
+
+/* 按下键的加深程度 (与默认主题的 pressed 样式一致) */
+#define UI_KEYBOARD_PRESSED_DARKEN 35
+
+/**
+ * @brief 创建虚拟键盘
+ * @param parent 父对象
+ * @param mode 键盘模式
+ * @param keycaps 预渲染的键帽字符 (最多 UI_GLYPH_ATLAS_MAX_GLYPHS 个)，
+ *                NULL 时不预渲染
+ * @return lv_keyboard 对象
+ */
+lv_obj_t* ui_comp_keyboard_create(lv_obj_t* parent, lv_keyboard_mode_t mode,
+                                  const char* keycaps);
+
+#endif /* UI_COMP_KEYBOARD_H */
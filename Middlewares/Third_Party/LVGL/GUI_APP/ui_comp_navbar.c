@@ -2,7 +2,8 @@
  ******************************************************************************
  * @file    ui_comp_navbar.c
  * @brief   底部导航栏组件
- * @details 提供主页、传感器列表、设备列表、设置四个导航按钮
+ * @details 提供主页、传感器列表、设备列表、设置四个导航按钮。
+ *          所有屏幕共用一份，常驻 lv_layer_top()。
  * @author  MmsY
  * @time    2025/11/23
  ******************************************************************************
@@ -10,12 +11,34 @@
 
 #include "ui_comp_navbar.h"
 #include "ui_manager.h"
+#include "ui_styles.h"
 
 /* 导航栏高度 */
 #define NAVBAR_HEIGHT 70
 
-/* 导航栏背景色 */
-#define NAVBAR_BG_COLOR 0xF5EFE6
+/* 导航按钮配置 */
+typedef struct {
+  const char *symbol;        /* 按钮图标 */
+  lv_palette_t palette;      /* 按钮颜色 */
+  ui_screen_t target_screen; /* 目标屏幕 */
+} nav_button_config_t;
+
+static const nav_button_config_t g_nav_buttons[] = {
+    /* 主页按钮 */
+    {LV_SYMBOL_HOME, LV_PALETTE_BLUE, UI_SCREEN_DASHBOARD},
+    /* 传感器列表按钮 */
+    {LV_SYMBOL_LIST, LV_PALETTE_GREEN, UI_SCREEN_SENSORS_LISTS},
+    /* 设备列表按钮 (可改为设备图标 / UI_SCREEN_DEVICES_LISTS) */
+    {LV_SYMBOL_SETTINGS, LV_PALETTE_ORANGE, UI_SCREEN_DEVICE_DETAILS},
+    /* 设置/登出按钮 */
+    {LV_SYMBOL_POWER, LV_PALETTE_RED, UI_SCREEN_LOGIN}};
+
+#define NAV_BUTTON_COUNT (sizeof(g_nav_buttons) / sizeof(g_nav_buttons[0]))
+
+static lv_obj_t *s_nav_bar = NULL;
+static lv_obj_t *s_nav_btns[NAV_BUTTON_COUNT];
+static lv_obj_t *s_active_btn = NULL; /* 当前高亮的按钮 */
+static uint32_t s_nav_screens = 0;    /* 启用了导航栏的屏幕 (位图) */
 
 /**
  * @brief 导航按钮点击事件回调
@@ -26,20 +49,19 @@ static void nav_button_event_cb(lv_event_t *e) {
 }
 
 /**
- * @brief 创建底部导航栏
+ * @brief 创建共用的导航栏 (只执行一次，初始隐藏)
  */
-lv_obj_t *ui_comp_navbar_create(lv_obj_t *parent, ui_screen_t active_screen) {
+static void navbar_create(void) {
   /* === 1. 创建导航栏容器 === */
-  lv_obj_t *nav_bar = lv_obj_create(parent);
-  lv_obj_remove_style_all(nav_bar);
-  lv_obj_set_size(nav_bar, LV_PCT(100), NAVBAR_HEIGHT);
-  lv_obj_set_style_bg_color(nav_bar, lv_color_hex(NAVBAR_BG_COLOR), 0);
-  lv_obj_set_style_bg_opa(nav_bar, LV_OPA_COVER, 0);
-  lv_obj_set_style_radius(nav_bar, 0, 0);
-  lv_obj_set_style_border_width(nav_bar, 0, 0);
+  s_nav_bar = lv_obj_create(lv_layer_top());
+  lv_obj_remove_style_all(s_nav_bar);
+  lv_obj_set_size(s_nav_bar, LV_PCT(100), NAVBAR_HEIGHT);
+  lv_obj_align(s_nav_bar, LV_ALIGN_BOTTOM_MID, 0, 0);
+  lv_obj_add_style(s_nav_bar, ui_style(UI_STYLE_NAVBAR), 0);
+  lv_obj_add_flag(s_nav_bar, LV_OBJ_FLAG_HIDDEN);
 
   /* === 2. 创建按钮容器（水平 Flex 布局） === */
-  lv_obj_t *btn_container = lv_obj_create(nav_bar);
+  lv_obj_t *btn_container = lv_obj_create(s_nav_bar);
   lv_obj_remove_style_all(btn_container);
   lv_obj_set_size(btn_container, LV_PCT(100), LV_PCT(100));
   lv_obj_set_flex_flow(btn_container, LV_FLEX_FLOW_ROW);
@@ -49,66 +71,86 @@ lv_obj_t *ui_comp_navbar_create(lv_obj_t *parent, ui_screen_t active_screen) {
                         LV_FLEX_ALIGN_CENTER);
   lv_obj_center(btn_container);
   lv_obj_set_style_pad_hor(btn_container, 10, 0);
-  lv_obj_set_style_pad_gap(btn_container, 10, 0);
-
-  /* === 3. 定义导航按钮配置 === */
-  typedef struct {
-    const char *symbol;        /* 按钮图标 */
-    lv_color_t color;          /* 按钮颜色 */
-    ui_screen_t target_screen; /* 目标屏幕 */
-  } nav_button_config_t;
-
-  const nav_button_config_t buttons[] = {
-      /* 主页按钮 */
-      {.symbol = LV_SYMBOL_HOME,
-       .color = lv_palette_main(LV_PALETTE_BLUE),
-       .target_screen = UI_SCREEN_DASHBOARD},
-      /* 传感器列表按钮 */
-      {
-          .symbol = LV_SYMBOL_LIST,
-          .color = lv_palette_main(LV_PALETTE_GREEN),
-          .target_screen = UI_SCREEN_SENSORS_LISTS // [CHANGED] 使用新枚举名
-      },
-      /* 设备列表按钮（可选） */
-      {
-          .symbol = LV_SYMBOL_SETTINGS, // 可改为设备图标
-          .color = lv_palette_main(LV_PALETTE_ORANGE),
-          .target_screen =
-              UI_SCREEN_DEVICE_DETAILS // 或创建 UI_SCREEN_DEVICES_LISTS
-      },
-      /* 设置/登出按钮 */
-      {.symbol = LV_SYMBOL_POWER,
-       .color = lv_palette_main(LV_PALETTE_RED),
-       .target_screen = UI_SCREEN_LOGIN}};
-
-  const uint8_t button_count = sizeof(buttons) / sizeof(buttons[0]);
-
-  /* === 4. 循环创建导航按钮 === */
-  for (uint8_t i = 0; i < button_count; i++) {
+  lv_obj_add_style(btn_container, ui_style(UI_STYLE_GAP), 0);
+
+  /* === 3. 循环创建导航按钮 === */
+  for (uint8_t i = 0; i < NAV_BUTTON_COUNT; i++) {
+    lv_color_t color = lv_palette_main(g_nav_buttons[i].palette);
     lv_obj_t *btn = lv_btn_create(btn_container);
     lv_obj_set_flex_grow(btn, 1); /* 按钮等分剩余空间 */
-    lv_obj_set_style_bg_color(btn, buttons[i].color, 0);
-    lv_obj_set_style_radius(btn, 8, 0); /* 圆角 */
+    lv_obj_add_style(btn, ui_style(UI_STYLE_NAV_BTN), 0); /* 圆角 + 图标字体 */
+    lv_obj_set_style_bg_color(btn, color, 0);
+    lv_obj_set_style_shadow_color(btn, color, 0); /* 高亮时的阴影颜色 */
 
     /* 创建按钮图标 */
     lv_obj_t *label = lv_label_create(btn);
-    lv_label_set_text(label, buttons[i].symbol);
-    lv_obj_set_style_text_font(label, &lv_font_montserrat_28, 0);
+    lv_label_set_text(label, g_nav_buttons[i].symbol);
     lv_obj_center(label);
 
     /* 添加点击事件 */
     lv_obj_add_event_cb(btn, nav_button_event_cb, LV_EVENT_CLICKED,
-                        (void *)(intptr_t)buttons[i].target_screen);
-
-    /* === 高亮当前活动按钮 === */
-    if (active_screen == buttons[i].target_screen) {
-      lv_obj_set_style_outline_width(btn, 3, 0);
-      lv_obj_set_style_outline_color(btn, lv_color_white(), 0);
-      lv_obj_set_style_outline_pad(btn, 3, 0);
-      lv_obj_set_style_shadow_width(btn, 10, 0); /* 添加阴影增强效果 */
-      lv_obj_set_style_shadow_color(btn, buttons[i].color, 0);
+                        (void *)(intptr_t)g_nav_buttons[i].target_screen);
+    s_nav_btns[i] = btn;
+  }
+}
+
+/**
+ * @brief 高亮当前屏幕对应的按钮 (没有对应按钮时不高亮)
+ */
+static void navbar_highlight(ui_screen_t screen) {
+  lv_obj_t *btn = NULL;
+
+  for (uint8_t i = 0; i < NAV_BUTTON_COUNT; i++) {
+    if (g_nav_buttons[i].target_screen == screen) {
+      btn = s_nav_btns[i];
+      break;
     }
   }
+  if (btn == s_active_btn) {
+    return;
+  }
+  if (s_active_btn) {
+    lv_obj_remove_style(s_active_btn, ui_style(UI_STYLE_NAV_BTN_ACTIVE), 0);
+  }
+  if (btn) {
+    lv_obj_add_style(btn, ui_style(UI_STYLE_NAV_BTN_ACTIVE), 0);
+  }
+  s_active_btn = btn;
+}
 
-  return nav_bar;
+/**
+ * @brief 为屏幕启用底部导航栏
+ */
+void ui_comp_navbar_attach(ui_screen_t screen) {
+  if ((uint32_t)screen >= 32) {
+    return;
+  }
+  s_nav_screens |= 1UL << screen;
+  if (!s_nav_bar) {
+    navbar_create();
+  }
+}
+
+/**
+ * @brief 屏幕切换完成后调用
+ */
+void ui_comp_navbar_sync(ui_screen_t screen) {
+  bool visible =
+      (uint32_t)screen < 32 && (s_nav_screens & (1UL << screen)) != 0;
+
+  if (!s_nav_bar) {
+    return;
+  }
+  if (visible) {
+    navbar_highlight(screen);
+  }
+  if (lv_obj_has_flag(s_nav_bar, LV_OBJ_FLAG_HIDDEN) != visible) {
+    return;
+  }
+  if (visible) {
+    lv_obj_clear_flag(s_nav_bar, LV_OBJ_FLAG_HIDDEN);
+  } else {
+    lv_obj_add_flag(s_nav_bar, LV_OBJ_FLAG_HIDDEN);
+  }
+  lv_obj_set_style_pad_bottom(lv_scr_act(), visible ? NAVBAR_HEIGHT : 0, 0);
 }
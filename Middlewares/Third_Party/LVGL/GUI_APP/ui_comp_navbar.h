@@ -9,12 +9,20 @@ extern "C" {
 #endif
 
 /**
- * @brief һͨõĵײ
- * @param parent    Ҫϵĸ
- * @param active_screen ǰĸĻڸӦİť
- * @return lv_obj_t* ĵָ
+ * @brief ΪĻõײ (Ļ init е)
+ * @details ڵһεʱ lv_layer_top()֮פ
+ *          Ļлʱֻƶؽ
+ * @param screen ʹõĻͬʱĸť
  */
-lv_obj_t* ui_comp_navbar_create(lv_obj_t* parent, ui_screen_t active_screen);
+void ui_comp_navbar_attach(ui_screen_t screen);
+
+/**
+ * @brief Ļлɺ (ui_manager)
+ * @details ǰĻ˵ʱʾӦťأ
+ *          ʾ״̬仯ʱ lv_scr_act() ڱ߾
+ * @param screen ǰĻ
+ */
+void ui_comp_navbar_sync(ui_screen_t screen);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,199 @@
+/**
+ ******************************************************************************
+ * @file    ui_comp_vlist.c
+ * @brief   虚拟列表组件实现
+ * @details 条目 i 固定由池中第 i % 池容量 个行对象显示，滚动时只处理行号
+ *          发生变化的行对象，其余行不重新绑定、不重新布局。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_comp_vlist.h"
+
+struct ui_vlist_s {
+  lv_obj_t *container;
+  ui_vlist_config_t config;
+  lv_obj_t *rows[UI_VLIST_MAX_ROWS];       // 行对象池
+  uint16_t row_index[UI_VLIST_MAX_ROWS];   // 各行对象绑定的条目下标
+  uint8_t row_count;                       // 池中已创建的行对象数
+  uint16_t count;                          // 条目数
+};
+
+/* -----------------------------------------------------------
+ * 私有函数
+ * ----------------------------------------------------------- */
+
+static lv_coord_t vlist_pitch(const ui_vlist_t *vlist) {
+  return vlist->config.row_height +
+         lv_obj_get_style_pad_row(vlist->container, LV_PART_MAIN);
+}
+
+/**
+ * @brief 按可见区域高度扩充行对象池
+ * @return true: 池容量变化 (条目与行对象的对应关系改变)
+ */
+static bool vlist_ensure_rows(ui_vlist_t *vlist) {
+  lv_coord_t view_h = lv_obj_get_content_height(vlist->container);
+  uint32_t needed;
+  bool grown = false;
+
+  if (view_h <= 0) {
+    return false;
+  }
+  /* 任意滚动位置下部分可见的行数 + 上下 overscan */
+  needed = (uint32_t)(view_h / vlist_pitch(vlist)) + 2U +
+           2U * vlist->config.overscan;
+  if (needed > vlist->count) {
+    needed = vlist->count;
+  }
+  if (needed > UI_VLIST_MAX_ROWS) {
+    needed = UI_VLIST_MAX_ROWS;
+  }
+
+  while (vlist->row_count < needed) {
+    uint8_t slot = vlist->row_count;
+    lv_obj_t *row =
+        vlist->config.create_cb(vlist->container, slot, vlist->config.user_data);
+
+    lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_set_user_data(row, (void *)(uintptr_t)UI_VLIST_NONE);
+    vlist->rows[slot] = row;
+    vlist->row_index[slot] = UI_VLIST_NONE;
+    vlist->row_count++;
+    grown = true;
+  }
+  return grown;
+}
+
+/**
+ * @brief 把可见范围内的条目绑定到行对象
+ * @param force true: 可见行全部重新绑定
+ */
+static void vlist_update(ui_vlist_t *vlist, bool force) {
+  lv_coord_t pitch = vlist_pitch(vlist);
+  lv_coord_t scroll_y;
+  int32_t first;
+
+  if (vlist_ensure_rows(vlist)) {
+    force = true;
+  }
+  if (vlist->row_count == 0) {
+    return;
+  }
+
+  scroll_y = lv_obj_get_scroll_y(vlist->container);
+  first = (scroll_y > 0 ? scroll_y / pitch : 0) - vlist->config.overscan;
+  if (first + vlist->row_count > vlist->count) {
+    first = (int32_t)vlist->count - vlist->row_count;
+  }
+  if (first < 0) {
+    first = 0;
+  }
+
+  for (uint8_t n = 0; n < vlist->row_count; n++) {
+    uint16_t index = (uint16_t)(first + n);
+    uint8_t slot = (uint8_t)(index % vlist->row_count);
+    lv_obj_t *row = vlist->rows[slot];
+
+    if (index >= vlist->count) {
+      if (vlist->row_index[slot] != UI_VLIST_NONE) {
+        vlist->row_index[slot] = UI_VLIST_NONE;
+        lv_obj_set_user_data(row, (void *)(uintptr_t)UI_VLIST_NONE);
+        lv_obj_add_flag(row, LV_OBJ_FLAG_HIDDEN);
+      }
+      continue;
+    }
+    if (vlist->row_index[slot] != index) {
+      vlist->row_index[slot] = index;
+      lv_obj_set_user_data(row, (void *)(uintptr_t)index);
+      lv_obj_set_y(row, (lv_coord_t)(index * pitch));
+      lv_obj_clear_flag(row, LV_OBJ_FLAG_HIDDEN);
+    } else if (!force) {
+      continue;
+    }
+    vlist->config.bind_cb(slot, index, vlist->config.user_data);
+  }
+}
+
+static void vlist_event_cb(lv_event_t *e) {
+  ui_vlist_t *vlist = (ui_vlist_t *)lv_event_get_user_data(e);
+
+  switch (lv_event_get_code(e)) {
+  case LV_EVENT_SCROLL:
+    vlist_update(vlist, false);
+    break;
+
+  case LV_EVENT_SIZE_CHANGED:
+    vlist_update(vlist, false);
+    break;
+
+  case LV_EVENT_GET_SELF_SIZE: {
+    lv_point_t *p = lv_event_get_self_size_info(e);
+    lv_coord_t h = vlist->count > 0
+                       ? (lv_coord_t)(vlist->count * vlist_pitch(vlist) -
+                                      lv_obj_get_style_pad_row(vlist->container,
+                                                               LV_PART_MAIN))
+                       : 0;
+    p->y = LV_MAX(p->y, h);
+    break;
+  }
+
+  case LV_EVENT_DELETE:
+    lv_mem_free(vlist);
+    break;
+
+  default:
+    break;
+  }
+}
+
+/* -----------------------------------------------------------
+ * 公共函数
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 把可滚动容器变为虚拟列表
+ */
+ui_vlist_t *ui_comp_vlist_create(lv_obj_t *container,
+                                 const ui_vlist_config_t *config) {
+  ui_vlist_t *vlist = (ui_vlist_t *)lv_mem_alloc(sizeof(ui_vlist_t));
+
+  if (vlist == NULL) {
+    return NULL;
+  }
+  lv_memset_00(vlist, sizeof(ui_vlist_t));
+  vlist->container = container;
+  vlist->config = *config;
+
+  lv_obj_add_event_cb(container, vlist_event_cb, LV_EVENT_ALL, vlist);
+  return vlist;
+}
+
+/**
+ * @brief 设置条目数并重新绑定可见行
+ */
+void ui_comp_vlist_set_count(ui_vlist_t *vlist, uint16_t count) {
+  if (vlist == NULL) {
+    return;
+  }
+  vlist->count = count;
+  lv_obj_readjust_scroll(vlist->container, LV_ANIM_OFF); // 条目减少时收回滚动位置
+  vlist_update(vlist, true);
+}
+
+/**
+ * @brief 重新绑定所有可见行
+ */
+void ui_comp_vlist_refresh(ui_vlist_t *vlist) {
+  if (vlist != NULL) {
+    vlist_update(vlist, true);
+  }
+}
+
+/**
+ * @brief 获取行对象当前绑定的条目下标
+ */
+uint16_t ui_comp_vlist_get_index(const lv_obj_t *row) {
+  return (uint16_t)(uintptr_t)lv_obj_get_user_data((lv_obj_t *)row);
+}
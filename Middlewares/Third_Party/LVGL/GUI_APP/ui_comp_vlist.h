@@ -0,0 +1,68 @@
+/**
+ * @file    ui_comp_vlist.h
+ * @brief   虚拟列表组件
+ * @details 只为可见区域及上下各 overscan 行创建行对象，滚动时按行号对池中
+ *          对象取模复用 (只改纵坐标并重新绑定数据)，对象数与条目数无关。
+ *          内容高度通过 LV_EVENT_GET_SELF_SIZE 报告给滚动计算，容器内不使用
+ *          flex 布局，行对象按 行号 * (行高 + pad_row) 绝对定位。
+ */
+
+#ifndef UI_COMP_VLIST_H
+#define UI_COMP_VLIST_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UI_VLIST_MAX_ROWS 16        /* 行对象池容量 (可见行 + 2 * overscan + 1) */
+#define UI_VLIST_NONE 0xFFFFU       /* 行对象未绑定条目 */
+
+/**
+ * @brief 创建一个行对象 (池扩容时调用)
+ * @param parent 列表容器
+ * @param slot 池中的下标 (0 ~ UI_VLIST_MAX_ROWS - 1)，可用于保存行内控件
+ * @return 行对象
+ */
+typedef lv_obj_t* (*ui_vlist_create_cb_t)(lv_obj_t* parent, uint8_t slot, void* user_data);
+
+/**
+ * @brief 把条目数据绑定到行对象 (行复用或主动刷新时调用)
+ */
+typedef void (*ui_vlist_bind_cb_t)(uint8_t slot, uint16_t index, void* user_data);
+
+/* 虚拟列表配置 */
+typedef struct {
+    lv_coord_t row_height;          /* 行高 (所有行相同) */
+    uint8_t overscan;               /* 可见区域上下各多准备的行数 */
+    ui_vlist_create_cb_t create_cb; /* 创建行对象 */
+    ui_vlist_bind_cb_t bind_cb;     /* 绑定条目数据 */
+    void* user_data;                /* 传给回调 */
+} ui_vlist_config_t;
+
+typedef struct ui_vlist_s ui_vlist_t;
+
+/**
+ * @brief 把可滚动容器变为虚拟列表
+ * @param container 列表容器 (不能设置 flex / grid 布局)
+ * @param config 配置 (内容被复制)
+ * @return 列表句柄，随容器删除自动释放；内存不足返回 NULL
+ */
+ui_vlist_t* ui_comp_vlist_create(lv_obj_t* container, const ui_vlist_config_t* config);
+
+/**
+ * @brief 设置条目数并重新绑定可见行
+ */
+void ui_comp_vlist_set_count(ui_vlist_t* vlist, uint16_t count);
+
+/**
+ * @brief 重新绑定所有可见行 (数据刷新定时器调用)
+ */
+void ui_comp_vlist_refresh(ui_vlist_t* vlist);
+
+/**
+ * @brief 获取行对象当前绑定的条目下标 (用于行内事件回调)
+ * @return 条目下标，未绑定返回 UI_VLIST_NONE
+ */
+uint16_t ui_comp_vlist_get_index(const lv_obj_t* row);
+
+#endif /* UI_COMP_VLIST_H */
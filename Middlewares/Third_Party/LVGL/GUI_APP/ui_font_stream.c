@@ -0,0 +1,209 @@
+/**
+ ******************************************************************************
+ * @file    ui_font_stream.c
+ * @brief   字形位图按需从外部 Flash 读取的字体后端
+ * @details 字形号取自 lv_font_fmt_txt 的查找缓存：LVGL 绘制字符时先取字形
+ *          描述 (lv_font_get_glyph_dsc_fmt_txt 写入 cache->last_letter /
+ *          last_glyph_id)，紧接着取位图，所以这里通常不必再查 cmap。
+ *          缓存键为 (字体序号 << 24) | 字形号，字形号 0 表示字体中没有该字符，
+ *          因此键 0 可以表示空槽。槽数较少，查找用线性扫描；淘汰顺序由双向
+ *          链表维护，头部为最近使用，尾部为下一个被替换的槽。
+ *          SPI Flash 驱动以轮询方式读取 (工程未启用 SPI DMA)，42 MHz 下读一个
+ *          24 px 字形约 60 us，只在未命中时发生。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_font_stream.h"
+#include "ui_assets.h"
+#include <stdio.h>
+
+#define LOG_MODULE "UI_FONT"
+#include "log.h"
+
+#define UI_FONT_STREAM_NONE 0xFFU
+
+/* 私有类型 */
+typedef struct {
+  const lv_font_t *font;
+  lv_fs_file_t file;
+  bool failed; /* 打开失败，之后不再尝试 */
+} ui_font_stream_font_t;
+
+typedef struct {
+  uint32_t key;
+  uint8_t prev;
+  uint8_t next;
+} ui_font_stream_slot_t;
+
+/* 私有全局变量 */
+static ui_font_stream_font_t g_fonts[UI_FONT_STREAM_MAX_FONTS];
+static uint8_t g_font_count = 0;
+static ui_font_stream_slot_t g_slots[UI_FONT_STREAM_SLOTS];
+static uint8_t g_data[UI_FONT_STREAM_SLOTS][UI_FONT_STREAM_SLOT_SIZE];
+static uint8_t g_head = UI_FONT_STREAM_NONE; /* 最近使用 */
+static uint8_t g_tail = UI_FONT_STREAM_NONE; /* 最久未使用 */
+static uint8_t *g_big = NULL;                /* 超过槽大小的字形 */
+static uint32_t g_big_size = 0;
+static ui_font_stream_stats_t g_stats;
+
+/* ------------------ 私有函数 ------------------ */
+
+static void ui_font_stream_lru_init(void) {
+  for (uint8_t i = 0; i < UI_FONT_STREAM_SLOTS; i++) {
+    g_slots[i].key = 0;
+    g_slots[i].prev = (i == 0) ? UI_FONT_STREAM_NONE : (uint8_t)(i - 1);
+    g_slots[i].next =
+        (i + 1 == UI_FONT_STREAM_SLOTS) ? UI_FONT_STREAM_NONE : (uint8_t)(i + 1);
+  }
+  g_head = 0;
+  g_tail = UI_FONT_STREAM_SLOTS - 1;
+}
+
+/* 把槽移到链表头部 */
+static void ui_font_stream_touch(uint8_t slot) {
+  ui_font_stream_slot_t *s = &g_slots[slot];
+
+  if (slot == g_head) {
+    return;
+  }
+  g_slots[s->prev].next = s->next; /* 不是头部，prev 一定存在 */
+  if (s->next != UI_FONT_STREAM_NONE) {
+    g_slots[s->next].prev = s->prev;
+  } else {
+    g_tail = s->prev;
+  }
+  s->prev = UI_FONT_STREAM_NONE;
+  s->next = g_head;
+  g_slots[g_head].prev = slot;
+  g_head = slot;
+}
+
+/**
+ * @brief 查找字体的位图文件，首次使用时打开
+ * @return 字体序号，失败时返回 UI_FONT_STREAM_NONE
+ */
+static uint8_t ui_font_stream_open(const lv_font_t *font) {
+  const lv_font_fmt_txt_dsc_t *fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+  ui_font_stream_font_t *entry;
+  char path[UI_ASSETS_NAME_MAX + 2];
+
+  for (uint8_t i = 0; i < g_font_count; i++) {
+    if (g_fonts[i].font == font) {
+      return g_fonts[i].failed ? UI_FONT_STREAM_NONE : i;
+    }
+  }
+  if (g_font_count >= UI_FONT_STREAM_MAX_FONTS) {
+    return UI_FONT_STREAM_NONE;
+  }
+  if (g_head == UI_FONT_STREAM_NONE) {
+    ui_font_stream_lru_init();
+  }
+
+  entry = &g_fonts[g_font_count];
+  entry->font = font;
+  entry->failed = true;
+  if (font->user_data == NULL || fdsc->cache == NULL ||
+      fdsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) {
+    LOG_ERROR("字体不是流式索引字体");
+  } else if (snprintf(path, sizeof(path), "%c:%s", UI_ASSETS_LETTER,
+                      (const char *)font->user_data) >= (int)sizeof(path) ||
+             lv_fs_open(&entry->file, path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+    LOG_WARN("资源包中没有字体位图 %s", (const char *)font->user_data);
+  } else {
+    entry->failed = false;
+  }
+  return entry->failed ? UI_FONT_STREAM_NONE : g_font_count++;
+}
+
+/**
+ * @brief 从位图文件读取一个字形
+ */
+static bool ui_font_stream_read(uint8_t font_idx, uint32_t offset, uint8_t *buf,
+                                uint32_t size) {
+  lv_fs_file_t *file = &g_fonts[font_idx].file;
+  uint32_t br = 0;
+
+  return lv_fs_seek(file, offset, LV_FS_SEEK_SET) == LV_FS_RES_OK &&
+         lv_fs_read(file, buf, size, &br) == LV_FS_RES_OK && br == size;
+}
+
+/* ------------------ 公共函数 ------------------ */
+
+/**
+ * @brief 索引字体的 get_glyph_bitmap 回调
+ */
+const uint8_t *ui_font_stream_get_bitmap(const lv_font_t *font,
+                                         uint32_t letter) {
+  const lv_font_fmt_txt_dsc_t *fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+  const lv_font_fmt_txt_glyph_dsc_t *gdsc;
+  uint8_t font_idx;
+  uint32_t gid, size, key;
+  uint8_t slot;
+
+  if (letter == '\t') {
+    letter = ' ';
+  }
+  font_idx = ui_font_stream_open(font);
+  if (font_idx == UI_FONT_STREAM_NONE) {
+    return NULL;
+  }
+
+  /* 通常刚取过字形描述，直接使用查找缓存中的字形号 */
+  if (fdsc->cache->last_letter != letter) {
+    lv_font_glyph_dsc_t dsc;
+    lv_font_get_glyph_dsc_fmt_txt(font, &dsc, letter, 0);
+  }
+  gid = fdsc->cache->last_glyph_id;
+  if (gid == 0) {
+    return NULL;
+  }
+  gdsc = &fdsc->glyph_dsc[gid];
+  size = ((uint32_t)gdsc->box_w * gdsc->box_h * fdsc->bpp + 7U) / 8U;
+  if (size == 0) {
+    return NULL;
+  }
+
+  key = ((uint32_t)(font_idx + 1U) << 24) | gid;
+  for (slot = 0; slot < UI_FONT_STREAM_SLOTS; slot++) {
+    if (g_slots[slot].key == key) {
+      g_stats.hits++;
+      ui_font_stream_touch(slot);
+      return g_data[slot];
+    }
+  }
+
+  /* 大字形不进入缓存，避免一个字形挤出多个常用字形 */
+  if (size > UI_FONT_STREAM_SLOT_SIZE) {
+    if (g_big_size < size) {
+      uint8_t *buf = lv_mem_realloc(g_big, size);
+      if (buf == NULL) {
+        return NULL;
+      }
+      g_big = buf;
+      g_big_size = size;
+    }
+    g_stats.oversize++;
+    return ui_font_stream_read(font_idx, gdsc->bitmap_index, g_big, size)
+               ? g_big
+               : NULL;
+  }
+
+  slot = g_tail;
+  g_slots[slot].key = 0;
+  g_stats.misses++;
+  if (!ui_font_stream_read(font_idx, gdsc->bitmap_index, g_data[slot], size)) {
+    return NULL; /* 空槽留在尾部，下次优先复用 */
+  }
+  g_slots[slot].key = key;
+  ui_font_stream_touch(slot);
+  return g_data[slot];
+}
+
+/**
+ * @brief 缓存统计
+ */
+void ui_font_stream_get_stats(ui_font_stream_stats_t *stats) {
+  *stats = g_stats;
+}
@@ -0,0 +1,50 @@
+/**
+ ******************************************************************************
+ * @file    ui_font_stream.h
+ * @brief   字形位图按需从外部 Flash 读取的字体后端
+ * @details 中文字体的位图占片内 Flash 的绝大部分。asset_pack.py --font 把
+ *          lv_font_conv 生成的字体 .c 中的 glyph_bitmap 数组打包为资源包中的
+ *          "<字体名>.fnt"，--emit-font-index 另外生成只含索引 (cmap 与字形描述)
+ *          的同名字体：glyph_bitmap 为 NULL，get_glyph_bitmap 指向
+ *          ui_font_stream_get_bitmap，user_data 为资源包中的文件名。工程中用
+ *          索引字体替换原字体后，引用字体对象的代码无需修改。
+ *          位图读入按字形槽划分的 RAM 缓存，按最近最少使用淘汰：数字、常用
+ *          标签等热点字形命中缓存后与片内字体的绘制速度相同。
+ *          只支持未压缩 (bitmap_format = 0) 且带 cache 的 lv_font_fmt_txt 字体；
+ *          只在 LVGL 任务中调用。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef UI_FONT_STREAM_H
+#define UI_FONT_STREAM_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* --------------------------- 系统配置 --------------------------- */
+#define UI_FONT_STREAM_SLOTS 32        /* 缓存的字形槽数 */
+#define UI_FONT_STREAM_SLOT_SIZE 320   /* 每槽字节数 (24 px、4 bpp 字形最大 288 字节) */
+#define UI_FONT_STREAM_MAX_FONTS 4     /* 同时使用的流式字体数 */
+
+typedef struct {
+  uint32_t hits;     /* 命中缓存 */
+  uint32_t misses;   /* 从 Flash 读取 */
+  uint32_t oversize; /* 超过槽大小、未缓存的读取 */
+} ui_font_stream_stats_t;
+
+/**
+ * @brief 索引字体的 get_glyph_bitmap 回调
+ * @details 首次调用时按 font->user_data 打开资源包中的位图文件；资源包缺失
+ *          时该字体的字形都不绘制，超出文件长度的字形同样返回 NULL。
+ *          返回的指针在下一次调用前有效。
+ */
+const uint8_t *ui_font_stream_get_bitmap(const lv_font_t *font,
+                                         uint32_t letter);
+
+/* 缓存统计 */
+void ui_font_stream_get_stats(ui_font_stream_stats_t *stats);
+
+#endif /* UI_FONT_STREAM_H */
@@ -0,0 +1,181 @@
+/**
+ ******************************************************************************
+ * @file    ui_glyph_atlas.c
+ * @brief   数值标签用的预渲染字形图集
+ * @details 初始化时分两遍处理字符集：第一遍取字形描述并统计位图大小，一次性
+ *          分配；第二遍逐个取基础字体位图并展开为 8 bpp。基础字体为压缩格式时
+ *          lv_font_get_glyph_bitmap 返回的是共用的解压缓冲区，所以取出后立即
+ *          转换，不保留指针。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_glyph_atlas.h"
+#include <string.h>
+
+#define LOG_MODULE "UI_ATLAS"
+#include "log.h"
+
+/* ------------------ 私有函数 ------------------ */
+
+static const ui_glyph_atlas_glyph_t *ui_glyph_atlas_find(
+    const ui_glyph_atlas_t *atlas, uint32_t letter) {
+  uint8_t slot;
+
+  if (letter < UI_GLYPH_ATLAS_FIRST || letter > UI_GLYPH_ATLAS_LAST) {
+    return NULL;
+  }
+  slot = atlas->index[letter - UI_GLYPH_ATLAS_FIRST];
+  return slot ? &atlas->glyphs[slot - 1] : NULL;
+}
+
+/* 字符集外的字符返回 false，由 lv_font_get_glyph_dsc 转到 fallback (基础字体) */
+static bool ui_glyph_atlas_get_dsc(const lv_font_t *font,
+                                   lv_font_glyph_dsc_t *dsc_out,
+                                   uint32_t letter, uint32_t letter_next) {
+  const ui_glyph_atlas_glyph_t *glyph = ui_glyph_atlas_find(font->dsc, letter);
+
+  LV_UNUSED(letter_next);
+  if (glyph == NULL) {
+    return false;
+  }
+  *dsc_out = glyph->dsc;
+  return true;
+}
+
+static const uint8_t *ui_glyph_atlas_get_bitmap(const lv_font_t *font,
+                                                uint32_t letter) {
+  const ui_glyph_atlas_t *atlas = font->dsc;
+  const ui_glyph_atlas_glyph_t *glyph = ui_glyph_atlas_find(atlas, letter);
+
+  if (glyph == NULL || atlas->bitmap == NULL) {
+    return NULL;
+  }
+  return atlas->bitmap + glyph->offset;
+}
+
+/**
+ * @brief 把 1/2/4/8 bpp 的连续位流展开为每像素一字节的不透明度
+ * @note  与 lv_draw_sw_letter.c 一致，3 bpp 按 4 bpp 处理
+ */
+static void ui_glyph_atlas_expand(const uint8_t *src, uint8_t *dst,
+                                  uint32_t px_count, uint8_t bpp) {
+  uint8_t scale;
+  uint8_t mask;
+  uint32_t bit = 0;
+
+  if (bpp == 3) {
+    bpp = 4;
+  }
+  mask = (uint8_t)((1u << bpp) - 1);
+  scale = (uint8_t)(255 / mask); /* 1 bpp: 255, 2 bpp: 85, 4 bpp: 17, 8 bpp: 1 */
+
+  for (uint32_t i = 0; i < px_count; i++) {
+    uint8_t v = (uint8_t)((src[bit >> 3] >> (8 - bpp - (bit & 7))) & mask);
+    dst[i] = (uint8_t)(v * scale);
+    bit += bpp;
+  }
+}
+
+/* ------------------ 公共函数 ------------------ */
+
+/**
+ * @brief 从基础字体生成图集
+ */
+bool ui_glyph_atlas_init(ui_glyph_atlas_t *atlas, const lv_font_t *base,
+                         const char *charset) {
+  uint32_t total = 0;
+
+  memset(atlas, 0, sizeof(ui_glyph_atlas_t));
+  atlas->base = base;
+  atlas->font.get_glyph_dsc = ui_glyph_atlas_get_dsc;
+  atlas->font.get_glyph_bitmap = ui_glyph_atlas_get_bitmap;
+  atlas->font.line_height = base->line_height;
+  atlas->font.base_line = base->base_line;
+  atlas->font.subpx = LV_FONT_SUBPX_NONE;
+  atlas->font.underline_position = base->underline_position;
+  atlas->font.underline_thickness = base->underline_thickness;
+  atlas->font.dsc = atlas;
+  atlas->font.fallback = base;
+
+  if (charset == NULL) {
+    charset = UI_GLYPH_ATLAS_DIGITS;
+  }
+
+  /* 第一遍：字形描述与位图大小 */
+  for (const char *p = charset; *p != '\0'; p++) {
+    uint8_t c = (uint8_t)*p;
+    ui_glyph_atlas_glyph_t *glyph;
+
+    if (c < UI_GLYPH_ATLAS_FIRST || c > UI_GLYPH_ATLAS_LAST ||
+        atlas->index[c - UI_GLYPH_ATLAS_FIRST] != 0) {
+      continue;
+    }
+    if (atlas->count >= UI_GLYPH_ATLAS_MAX_GLYPHS) {
+      LOG_WARN("字符集超过 %u 个，'%c' 之后的字符不进图集",
+               UI_GLYPH_ATLAS_MAX_GLYPHS, c);
+      break;
+    }
+
+    glyph = &atlas->glyphs[atlas->count];
+    if (!lv_font_get_glyph_dsc(base, &glyph->dsc, c, '\0') ||
+        glyph->dsc.resolved_font->subpx != LV_FONT_SUBPX_NONE) {
+      continue; /* 缺失或子像素字形交给基础字体处理 */
+    }
+    glyph->offset = total;
+    total += (uint32_t)glyph->dsc.box_w * glyph->dsc.box_h;
+    atlas->index[c - UI_GLYPH_ATLAS_FIRST] = ++atlas->count;
+  }
+
+  if (total > 0) {
+    atlas->bitmap = lv_mem_alloc(total);
+    if (atlas->bitmap == NULL) {
+      LOG_WARN("图集位图 %lu 字节分配失败", (unsigned long)total);
+      atlas->count = 0;
+      memset(atlas->index, 0, sizeof(atlas->index));
+      return false;
+    }
+  }
+
+  /* 第二遍：取位图并展开为 8 bpp */
+  for (uint16_t c = UI_GLYPH_ATLAS_FIRST; c <= UI_GLYPH_ATLAS_LAST; c++) {
+    uint8_t slot = atlas->index[c - UI_GLYPH_ATLAS_FIRST];
+    ui_glyph_atlas_glyph_t *glyph;
+    const uint8_t *src;
+    uint32_t px_count;
+
+    if (slot == 0) {
+      continue;
+    }
+    glyph = &atlas->glyphs[slot - 1];
+    px_count = (uint32_t)glyph->dsc.box_w * glyph->dsc.box_h;
+    if (px_count > 0) {
+      src = lv_font_get_glyph_bitmap(glyph->dsc.resolved_font, c);
+      if (src == NULL) {
+        atlas->index[c - UI_GLYPH_ATLAS_FIRST] = 0; /* 交给基础字体 */
+        continue;
+      }
+      ui_glyph_atlas_expand(src, atlas->bitmap + glyph->offset, px_count,
+                            glyph->dsc.bpp);
+    }
+    glyph->dsc.bpp = 8;
+    glyph->dsc.is_placeholder = 0;
+    glyph->dsc.resolved_font = NULL;
+  }
+
+  LOG_DEBUG("图集: %u 个字形, %lu 字节", atlas->count, (unsigned long)total);
+  return true;
+}
+
+/**
+ * @brief 释放图集位图
+ */
+void ui_glyph_atlas_deinit(ui_glyph_atlas_t *atlas) {
+  if (atlas->bitmap != NULL) {
+    lv_mem_free(atlas->bitmap);
+    atlas->bitmap = NULL;
+  }
+  atlas->count = 0;
+  memset(atlas->index, 0, sizeof(atlas->index));
+}
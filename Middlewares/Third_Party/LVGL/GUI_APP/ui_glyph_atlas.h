@@ -0,0 +1,62 @@
+/**
+ ******************************************************************************
+ * @file    ui_glyph_atlas.h
+ * @brief   数值标签用的预渲染字形图集
+ * @details 主页数值标签刷新最频繁，但只会用到 "0-9 . - %" 等少数字符。
+ *          图集在初始化时把指定字符集从基础字体中取出，展开成 8 bpp 位图
+ *          并缓存字形描述，包装成一个新的 lv_font_t：
+ *            - 查找字形是一次数组下标访问，不再经过 cmap 搜索 (基础字体为
+ *              压缩格式时也省去了每次绘制的解压)；
+ *            - lv_draw_sw_letter.c 对未被裁剪的 8 bpp 字形直接把位图作为
+ *              遮罩混合，不再逐像素拆位、查表、拷贝。
+ *          字符集之外的字符通过 fallback 交给基础字体，显示效果与直接使用
+ *          基础字体相同 (不处理字距调整，本工程字体均不含字距表)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef UI_GLYPH_ATLAS_H
+#define UI_GLYPH_ATLAS_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* --------------------------- 系统配置 --------------------------- */
+#define UI_GLYPH_ATLAS_DIGITS "0123456789.-%" /* 默认字符集：数值标签 */
+#define UI_GLYPH_ATLAS_MAX_GLYPHS 16          /* 每个图集最多字符数 */
+
+/* 图集仅支持可打印 ASCII 字符 */
+#define UI_GLYPH_ATLAS_FIRST 0x20
+#define UI_GLYPH_ATLAS_LAST 0x7E
+
+typedef struct {
+  lv_font_glyph_dsc_t dsc; /* bpp 固定为 8 */
+  uint32_t offset;         /* 在 bitmap 中的偏移 */
+} ui_glyph_atlas_glyph_t;
+
+typedef struct {
+  lv_font_t font;       /* 交给 lv_obj_set_style_text_font 使用 */
+  const lv_font_t *base;
+  uint8_t *bitmap;      /* 所有字形的 8 bpp 位图，连续存放 */
+  uint8_t count;
+  /* 字符 -> glyphs 下标 + 1，0 表示不在图集中 */
+  uint8_t index[UI_GLYPH_ATLAS_LAST - UI_GLYPH_ATLAS_FIRST + 1];
+  ui_glyph_atlas_glyph_t glyphs[UI_GLYPH_ATLAS_MAX_GLYPHS];
+} ui_glyph_atlas_t;
+
+/**
+ * @brief 从基础字体生成图集 (位图从 lv_mem 分配，atlas 本身需长期有效)
+ * @param atlas   图集
+ * @param base    基础字体
+ * @param charset 预渲染的字符，NULL 时使用 UI_GLYPH_ATLAS_DIGITS
+ * @return true 成功；失败时 atlas->font 仍可用，全部字符交给基础字体
+ */
+bool ui_glyph_atlas_init(ui_glyph_atlas_t *atlas, const lv_font_t *base,
+                         const char *charset);
+
+/* 释放图集位图 (之后不能再用 atlas->font 绘制) */
+void ui_glyph_atlas_deinit(ui_glyph_atlas_t *atlas);
+
+#endif /* UI_GLYPH_ATLAS_H */
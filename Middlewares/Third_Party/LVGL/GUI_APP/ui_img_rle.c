@@ -0,0 +1,303 @@
+/**
+ ******************************************************************************
+ * @file    ui_img_rle.c
+ * @brief   RLE 压缩图片的流式解码器
+ * @details open 时只分配一行解码缓冲区 (文件源另有行偏移表和一行压缩数据的
+ *          读缓冲区)，read_line 解码所请求的整行后拷贝出 [x, x + len) 部分。
+ *          LVGL 在同一行上会因裁剪区域不同而多次读取，因此缓存最近解码的行号，
+ *          同一行只解码一次。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_img_rle.h"
+#include <string.h>
+
+/* 私有类型 */
+typedef struct {
+  bool is_file;
+  lv_fs_file_t f;        /* 文件源 */
+  uint32_t data_pos;     /* 文件源：数据区在文件中的偏移 */
+  uint32_t *rows;        /* 文件源：行偏移表 (h + 1 项) */
+  uint8_t *comp_buf;     /* 文件源：一行压缩数据 */
+  const uint8_t *table;  /* 变量源：行偏移表 (可能未对齐) */
+  const uint8_t *data;   /* 变量源：数据区 */
+  uint8_t *row_buf;      /* 一行解码结果 */
+  uint8_t px_size;       /* 每像素字节数 */
+  lv_coord_t cached_y;   /* row_buf 中的行号，-1 表示无效 */
+} ui_img_rle_dsc_t;
+
+/* ------------------ 私有函数 ------------------ */
+
+static uint8_t ui_img_rle_px_size(uint8_t cf) {
+  if (cf == LV_IMG_CF_TRUE_COLOR) {
+    return LV_COLOR_SIZE / 8;
+  }
+  if (cf == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+    return LV_IMG_PX_SIZE_ALPHA_BYTE;
+  }
+  return 0;
+}
+
+/* 一行压缩数据的最大长度：全部为原样像素时每 128 个像素多 1 个控制字节 */
+static uint32_t ui_img_rle_comp_max(lv_coord_t w, uint8_t px_size) {
+  return (uint32_t)w * px_size + ((uint32_t)w + 127) / 128;
+}
+
+static uint32_t ui_img_rle_read_u32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief 解码一行，输出长度必须恰好填满一行
+ */
+static bool ui_img_rle_decode_row(const uint8_t *src, uint32_t src_len,
+                                  uint8_t *dst, uint32_t dst_len,
+                                  uint8_t px_size) {
+  const uint8_t *end = src + src_len;
+  uint8_t *dst_end = dst + dst_len;
+
+  while (src < end && dst < dst_end) {
+    uint8_t ctrl = *src++;
+    uint32_t count = (uint32_t)(ctrl & 0x7F) + 1;
+    uint32_t bytes = count * px_size;
+
+    if (bytes > (uint32_t)(dst_end - dst)) {
+      return false;
+    }
+    if (ctrl & UI_IMG_RLE_RUN_FLAG) {
+      if ((uint32_t)(end - src) < px_size) {
+        return false;
+      }
+      for (uint32_t i = 0; i < count; i++) {
+        memcpy(dst, src, px_size);
+        dst += px_size;
+      }
+      src += px_size;
+    } else {
+      if ((uint32_t)(end - src) < bytes) {
+        return false;
+      }
+      memcpy(dst, src, bytes);
+      dst += bytes;
+      src += bytes;
+    }
+  }
+  return dst == dst_end;
+}
+
+/**
+ * @brief 把第 y 行解码到 row_buf
+ */
+static bool ui_img_rle_load_row(ui_img_rle_dsc_t *rle,
+                                const lv_img_header_t *header, lv_coord_t y) {
+  uint32_t start, end, br;
+  const uint8_t *src;
+
+  if (rle->is_file) {
+    start = rle->rows[y];
+    end = rle->rows[y + 1];
+    if (end < start ||
+        end - start > ui_img_rle_comp_max(header->w, rle->px_size)) {
+      return false;
+    }
+    if (lv_fs_seek(&rle->f, rle->data_pos + start, LV_FS_SEEK_SET) !=
+            LV_FS_RES_OK ||
+        lv_fs_read(&rle->f, rle->comp_buf, end - start, &br) !=
+            LV_FS_RES_OK ||
+        br != end - start) {
+      return false;
+    }
+    src = rle->comp_buf;
+  } else {
+    start = ui_img_rle_read_u32(rle->table + (uint32_t)y * 4);
+    end = ui_img_rle_read_u32(rle->table + (uint32_t)(y + 1) * 4);
+    if (end < start) {
+      return false;
+    }
+    src = rle->data + start;
+  }
+
+  if (!ui_img_rle_decode_row(src, end - start, rle->row_buf,
+                             (uint32_t)header->w * rle->px_size,
+                             rle->px_size)) {
+    return false;
+  }
+  rle->cached_y = y;
+  return true;
+}
+
+static void ui_img_rle_free(ui_img_rle_dsc_t *rle) {
+  if (rle->is_file) {
+    lv_fs_close(&rle->f);
+  }
+  if (rle->rows != NULL) {
+    lv_mem_free(rle->rows);
+  }
+  if (rle->comp_buf != NULL) {
+    lv_mem_free(rle->comp_buf);
+  }
+  if (rle->row_buf != NULL) {
+    lv_mem_free(rle->row_buf);
+  }
+  lv_mem_free(rle);
+}
+
+/* ------------------ 解码器回调 ------------------ */
+
+static lv_res_t ui_img_rle_info(lv_img_decoder_t *decoder, const void *src,
+                                lv_img_header_t *header) {
+  ui_img_rle_info_t info;
+  lv_img_src_t src_type = lv_img_src_get_type(src);
+
+  LV_UNUSED(decoder);
+  if (src_type == LV_IMG_SRC_VARIABLE) {
+    const lv_img_dsc_t *img = src;
+    if (img->header.cf != UI_IMG_RLE_CF || img->data_size < sizeof(info)) {
+      return LV_RES_INV;
+    }
+    *header = img->header;
+    memcpy(&info, img->data, sizeof(info));
+  } else if (src_type == LV_IMG_SRC_FILE) {
+    lv_fs_file_t f;
+    uint32_t br1 = 0, br2 = 0;
+
+    if (strcmp(lv_fs_get_ext(src), UI_IMG_RLE_EXT) != 0) {
+      return LV_RES_INV;
+    }
+    if (lv_fs_open(&f, src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+      return LV_RES_INV;
+    }
+    lv_fs_read(&f, header, sizeof(lv_img_header_t), &br1);
+    lv_fs_read(&f, &info, sizeof(info), &br2);
+    lv_fs_close(&f);
+    if (br1 != sizeof(lv_img_header_t) || br2 != sizeof(info) ||
+        header->cf != UI_IMG_RLE_CF) {
+      return LV_RES_INV;
+    }
+  } else {
+    return LV_RES_INV;
+  }
+
+  if (ui_img_rle_px_size(info.cf) == 0) {
+    return LV_RES_INV;
+  }
+  header->cf = info.cf; /* 绘制时按解码后的真彩色格式处理 */
+  return LV_RES_OK;
+}
+
+static lv_res_t ui_img_rle_open(lv_img_decoder_t *decoder,
+                                lv_img_decoder_dsc_t *dsc) {
+  ui_img_rle_dsc_t *rle;
+  uint32_t table_size = ((uint32_t)dsc->header.h + 1) * 4;
+
+  LV_UNUSED(decoder);
+  rle = lv_mem_alloc(sizeof(ui_img_rle_dsc_t));
+  if (rle == NULL) {
+    return LV_RES_INV;
+  }
+  lv_memset_00(rle, sizeof(ui_img_rle_dsc_t));
+  rle->px_size = ui_img_rle_px_size(dsc->header.cf);
+  rle->cached_y = -1;
+
+  if (dsc->src_type == LV_IMG_SRC_FILE) {
+    uint32_t br = 0;
+
+    if (lv_fs_open(&rle->f, dsc->src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+      lv_mem_free(rle);
+      return LV_RES_INV;
+    }
+    rle->is_file = true;
+    rle->data_pos =
+        sizeof(lv_img_header_t) + sizeof(ui_img_rle_info_t) + table_size;
+    rle->rows = lv_mem_alloc(table_size);
+    rle->comp_buf =
+        lv_mem_alloc(ui_img_rle_comp_max(dsc->header.w, rle->px_size));
+    if (rle->rows == NULL || rle->comp_buf == NULL ||
+        lv_fs_seek(&rle->f,
+                   sizeof(lv_img_header_t) + sizeof(ui_img_rle_info_t),
+                   LV_FS_SEEK_SET) != LV_FS_RES_OK ||
+        lv_fs_read(&rle->f, rle->rows, table_size, &br) != LV_FS_RES_OK ||
+        br != table_size) {
+      ui_img_rle_free(rle);
+      return LV_RES_INV;
+    }
+  } else {
+    const lv_img_dsc_t *img = dsc->src;
+    if (img->data_size < sizeof(ui_img_rle_info_t) + table_size) {
+      ui_img_rle_free(rle);
+      return LV_RES_INV;
+    }
+    rle->table = img->data + sizeof(ui_img_rle_info_t);
+    rle->data = rle->table + table_size;
+    if (ui_img_rle_read_u32(rle->table + table_size - 4) >
+        img->data_size - sizeof(ui_img_rle_info_t) - table_size) {
+      ui_img_rle_free(rle);
+      return LV_RES_INV;
+    }
+  }
+
+  rle->row_buf = lv_mem_alloc((uint32_t)dsc->header.w * rle->px_size);
+  if (rle->row_buf == NULL) {
+    ui_img_rle_free(rle);
+    return LV_RES_INV;
+  }
+
+  dsc->user_data = rle;
+  dsc->img_data = NULL; /* 不提供整幅数据，LVGL 改为逐行调用 read_line */
+  return LV_RES_OK;
+}
+
+static lv_res_t ui_img_rle_read_line(lv_img_decoder_t *decoder,
+                                     lv_img_decoder_dsc_t *dsc, lv_coord_t x,
+                                     lv_coord_t y, lv_coord_t len,
+                                     uint8_t *buf) {
+  ui_img_rle_dsc_t *rle = dsc->user_data;
+
+  LV_UNUSED(decoder);
+  if (y < 0 || y >= dsc->header.h || x < 0 || len < 0 ||
+      x + len > dsc->header.w) {
+    return LV_RES_INV;
+  }
+  if (rle->cached_y != y && !ui_img_rle_load_row(rle, &dsc->header, y)) {
+    rle->cached_y = -1;
+    return LV_RES_INV;
+  }
+  memcpy(buf, rle->row_buf + (uint32_t)x * rle->px_size,
+         (uint32_t)len * rle->px_size);
+  return LV_RES_OK;
+}
+
+static void ui_img_rle_close(lv_img_decoder_t *decoder,
+                             lv_img_decoder_dsc_t *dsc) {
+  LV_UNUSED(decoder);
+  if (dsc->user_data != NULL) {
+    ui_img_rle_free(dsc->user_data);
+    dsc->user_data = NULL;
+  }
+}
+
+/* ------------------ 公共函数 ------------------ */
+
+/**
+ * @brief 注册解码器
+ */
+void ui_img_rle_init(void) {
+  static bool inited = false;
+  lv_img_decoder_t *decoder;
+
+  if (inited) {
+    return;
+  }
+  decoder = lv_img_decoder_create();
+  if (decoder == NULL) {
+    return;
+  }
+  lv_img_decoder_set_info_cb(decoder, ui_img_rle_info);
+  lv_img_decoder_set_open_cb(decoder, ui_img_rle_open);
+  lv_img_decoder_set_read_line_cb(decoder, ui_img_rle_read_line);
+  lv_img_decoder_set_close_cb(decoder, ui_img_rle_close);
+  inited = true;
+}
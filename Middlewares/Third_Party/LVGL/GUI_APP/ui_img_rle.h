@@ -0,0 +1,44 @@
+/**
+ ******************************************************************************
+ * @file    ui_img_rle.h
+ * @brief   RLE 压缩图片的流式解码器
+ * @details 界面中的图标和照片大面积是纯色或透明背景，按像素做行程编码后
+ *          一般能压缩到 1/3 ~ 1/5。每行独立编码并带行偏移表，解码器按 LVGL
+ *          请求的行随机定位，只在一行大小的暂存缓冲区内解码，整幅图片不会
+ *          展开到 RAM；从 SPI Flash 读取的字节数也随压缩比同步减少。
+ *          图片源可以是文件 ("*.rle"，见 ui_assets) 或 cf 为
+ *          LV_IMG_CF_USER_ENCODED_0 的 lv_img_dsc_t 变量。
+ *          与 LVGL 按行读取的其它图片一样，不支持旋转和缩放。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef UI_IMG_RLE_H
+#define UI_IMG_RLE_H
+
+#include "lvgl.h"
+#include <stdint.h>
+
+/* --------------------------- 数据格式 --------------------------- */
+/* 与 assets/asset_pack.py 保持一致，多字节字段均为小端：
+ *   lv_img_header_t     cf = LV_IMG_CF_USER_ENCODED_0，w/h 为图片尺寸
+ *   ui_img_rle_info_t   原始像素格式
+ *   uint32_t row[h + 1] 各行编码数据相对数据区起点的偏移，row[h] 为数据区总长
+ *   数据区              逐行编码：控制字节 c，c & 0x80 时后跟 1 个像素并重复
+ *                       (c & 0x7F) + 1 次，否则后跟 c + 1 个原样像素；
+ *                       行程不跨行，像素长度为 2 (RGB565) 或 3 (RGB565 + A)
+ * 变量源时 lv_img_dsc_t.data 指向 ui_img_rle_info_t，文件源时紧跟在 4 字节头部之后 */
+#define UI_IMG_RLE_CF LV_IMG_CF_USER_ENCODED_0
+#define UI_IMG_RLE_EXT "rle"
+#define UI_IMG_RLE_RUN_FLAG 0x80
+
+typedef struct {
+    uint8_t cf;         /* 解码后的格式: LV_IMG_CF_TRUE_COLOR / TRUE_COLOR_ALPHA */
+    uint8_t reserved[3];
+} ui_img_rle_info_t;
+
+/* 注册解码器 (lv_init 之后调用一次) */
+void ui_img_rle_init(void);
+
+#endif /* UI_IMG_RLE_H */
@@ -0,0 +1,87 @@
+/**
+ ******************************************************************************
+ * @file    ui_layout.c
+ * @brief   声明式屏幕布局描述
+ * @details 标签使用 lv_label_set_text_static，描述中的文本直接引用 Flash，
+ *          不在 lv_mem 中复制；之后以 set_text/set_text_fmt 刷新时 LVGL
+ *          自动改为动态文本。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_layout.h"
+
+/**
+ * @brief 按节点类型创建对象
+ */
+static lv_obj_t *ui_layout_create(uint8_t type, lv_obj_t *parent) {
+  switch (type) {
+  case UI_LAYOUT_LABEL:
+    return lv_label_create(parent);
+  case UI_LAYOUT_BAR:
+    return lv_bar_create(parent);
+  case UI_LAYOUT_TABLE:
+    return lv_table_create(parent);
+  case UI_LAYOUT_LED: {
+    lv_obj_t *led = lv_led_create(parent);
+    lv_led_on(led);
+    return led;
+  }
+  case UI_LAYOUT_OBJ:
+  default:
+    return lv_obj_create(parent);
+  }
+}
+
+/**
+ * @brief 按描述实例化控件树
+ */
+void ui_layout_build(lv_obj_t *parent, const ui_layout_node_t *nodes,
+                     uint8_t count, lv_obj_t **objs) {
+  for (uint8_t i = 0; i < count; i++) {
+    const ui_layout_node_t *n = &nodes[i];
+    lv_obj_t *obj;
+
+    LV_ASSERT(n->parent <= i && n->align_to <= i);
+    obj = ui_layout_create(n->type, n->parent ? objs[n->parent - 1] : parent);
+    objs[i] = obj;
+
+    if (n->flags & UI_LAYOUT_F_BARE) {
+      lv_obj_remove_style_all(obj);
+    }
+    if (n->style) {
+      lv_obj_add_style(obj, ui_style((ui_style_id_t)(n->style - 1)),
+                       (lv_style_selector_t)n->part << 16);
+    }
+    if (n->w && n->h) {
+      lv_obj_set_size(obj, n->w, n->h);
+    } else if (n->w) {
+      lv_obj_set_width(obj, n->w);
+    } else if (n->h) {
+      lv_obj_set_height(obj, n->h);
+    }
+    if (n->flags & UI_LAYOUT_F_GROW) {
+      lv_obj_set_flex_grow(obj, 1);
+    }
+    if (n->flags & UI_LAYOUT_F_COLUMN) {
+      lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_COLUMN);
+    } else if (n->flags & UI_LAYOUT_F_ROW) {
+      lv_obj_set_flex_flow(obj, LV_FLEX_FLOW_ROW);
+    }
+    if (n->flags & UI_LAYOUT_F_CLICKABLE) {
+      lv_obj_add_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+    }
+    if (n->text && n->type == UI_LAYOUT_LABEL) {
+      lv_label_set_text_static(obj, n->text);
+    }
+    /* 对齐放在最后：OUT_xxx 对齐依赖自身已确定的尺寸 */
+    if (n->align != LV_ALIGN_DEFAULT) {
+      if (n->align_to) {
+        lv_obj_align_to(obj, objs[n->align_to - 1], n->align, n->x, n->y);
+      } else {
+        lv_obj_align(obj, n->align, n->x, n->y);
+      }
+    }
+  }
+}
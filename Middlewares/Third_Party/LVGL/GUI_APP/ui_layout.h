@@ -0,0 +1,71 @@
+/**
+ ******************************************************************************
+ * @file    ui_layout.h
+ * @brief   声明式屏幕布局描述
+ * @details 屏幕的静态控件树写成 const 节点数组 (放在 Flash 中)，由
+ *          ui_layout_build 按顺序实例化：创建控件、设置尺寸/对齐/标志、
+ *          挂共享样式、设置静态文本。节点以下标引用父节点与对齐参照，
+ *          父节点必须排在子节点之前。
+ *          创建出的对象按节点下标写入调用者提供的数组，屏幕从中取出需要
+ *          刷新的控件 (标签绑定、LED 等)；事件回调、表格列等随实例变化的
+ *          部分仍在构建后设置。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef UI_LAYOUT_H
+#define UI_LAYOUT_H
+
+#include "lvgl.h"
+#include "ui_styles.h"
+
+/* 节点引用：0 表示 "无" (父节点为 build 的 parent / 对齐参照为父对象) */
+#define UI_LAYOUT_REF(index) ((uint8_t)((index) + 1))
+/* 样式引用：0 表示不挂共享样式 */
+#define UI_LAYOUT_STYLE(id) ((uint8_t)((id) + 1))
+/* 样式作用的部件 (LV_PART_xxx 只占用选择器的第 16~23 位) */
+#define UI_LAYOUT_PART(part) ((uint8_t)((part) >> 16))
+
+/* 节点标志 */
+#define UI_LAYOUT_F_BARE 0x01U      /* lv_obj_remove_style_all，去掉主题样式 */
+#define UI_LAYOUT_F_GROW 0x02U      /* lv_obj_set_flex_grow(obj, 1) */
+#define UI_LAYOUT_F_COLUMN 0x04U    /* 子元素纵向 flex 排列 */
+#define UI_LAYOUT_F_ROW 0x08U       /* 子元素横向 flex 排列 */
+#define UI_LAYOUT_F_CLICKABLE 0x10U /* 添加 LV_OBJ_FLAG_CLICKABLE */
+
+typedef enum {
+  UI_LAYOUT_OBJ = 0, /* 基础对象 (面板/容器) */
+  UI_LAYOUT_LABEL,   /* 标签，text 以静态文本设置 */
+  UI_LAYOUT_BAR,     /* 进度条 */
+  UI_LAYOUT_TABLE,   /* 表格 */
+  UI_LAYOUT_LED,     /* LED，创建后点亮 */
+} ui_layout_type_t;
+
+/**
+ * @brief 一个布局节点，未填写的字段为 0 时即为默认值
+ */
+typedef struct {
+  uint8_t type;     /* ui_layout_type_t */
+  uint8_t parent;   /* UI_LAYOUT_REF(父节点)，0: build 的 parent */
+  uint8_t align;    /* lv_align_t，LV_ALIGN_DEFAULT 不对齐 */
+  uint8_t align_to; /* UI_LAYOUT_REF(参照节点)，0: 相对父对象 */
+  uint8_t style;    /* UI_LAYOUT_STYLE(样式)，0: 无 */
+  uint8_t part;     /* UI_LAYOUT_PART(部件)，样式作用的部件 */
+  uint8_t flags;    /* UI_LAYOUT_F_xxx */
+  lv_coord_t x, y;  /* 对齐偏移 */
+  lv_coord_t w, h;  /* 尺寸 (可用 LV_PCT)，0: 保持默认 */
+  const char *text; /* 标签文本 (必须长期有效)，NULL: 不设置 */
+} ui_layout_node_t;
+
+/**
+ * @brief 按描述实例化控件树
+ * @param parent 根节点的父对象
+ * @param nodes  节点数组 (父节点在前)
+ * @param count  节点数
+ * @param objs   输出：与 nodes 一一对应的对象，长度不小于 count
+ */
+void ui_layout_build(lv_obj_t *parent, const ui_layout_node_t *nodes,
+                     uint8_t count, lv_obj_t **objs);
+
+#endif /* UI_LAYOUT_H */
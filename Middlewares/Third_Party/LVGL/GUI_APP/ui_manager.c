@@ -3,18 +3,43 @@
  * @file    ui_manager.c
  * @brief   UI中央屏幕管理器
  * @details 负责所有屏幕的创建、销毁、切换和上下文传递。
+ *          支持 on_show/on_hide 的屏幕切走时隐藏进 LRU 缓存 (见
+ *          UI_SCREEN_CACHE_SIZE)，再次进入时直接显示；其余屏幕仍然销毁重建。
+ *          顶部栏与导航栏常驻 lv_layer_top()，切换屏幕时不重建。
+ *          翻页顺序中的页面之间切换时由 ui_transition 滑入。
  * @author  MmsY
  * @time    2025/11/23
  ******************************************************************************
  */
 
 #include "ui_manager.h"
+#include "FreeRTOS.h"
+#include "config_store.h"
+#include "frame_stats.h"
+#include "lcd.h"
+#include "lv_port_disp.h"
+#include "lv_port_indev.h"
 #include "lvgl.h"
+#include "rtc_clock.h"
+#include "sensor_event_bus.h"
+#include "sensor_latency.h"
+#include "sys_monitor.h"
+#include "task.h"
+#include "ui_assets.h"
+#include "ui_builder.h"
+#include "ui_comp_header.h"
+#include "ui_comp_navbar.h"
+#include "ui_styles.h"
+#include "ui_theme.h"
+#include "ui_transition.h"
+#include "warm_start.h"
+#include <string.h>
 
 /* 引入所有屏幕模块的头文件 */
 #include "ui_screen_boot.h"
 #include "ui_screen_dashboard.h"
 #include "ui_screen_devices_details.h"
+#include "ui_screen_diagnostics.h"
 #include "ui_screen_login.h"
 #include "ui_screen_sensors_details.h" // [CHANGED] 新文件名
 #include "ui_screen_sensors_lists.h"   // [CHANGED] 新文件名
@@ -23,9 +48,425 @@
 /* 私有全局变量 */
 static lv_obj_t *g_current_screen_container = NULL;
 static ui_screen_t g_current_screen_id = UI_SCREEN_NONE;
+static int32_t g_current_screen_context = 0;
 static ui_screen_t g_previous_screen_id = UI_SCREEN_NONE;
 static SensorType_t g_active_sensor_for_details = SENSOR_TYPE_NONE;
 static DeviceType_t g_active_device_type = DEVICE_TYPE_RGBLED;
+static lv_timer_t *g_sensor_event_timer = NULL;
+static TaskHandle_t g_ui_task = NULL; // LVGL 任务句柄 (ui_init 中记录)
+static SensorEventSub_t g_sensor_sub = -1; // 传感器事件总线订阅者
+static volatile ui_idle_state_t g_idle_state = UI_IDLE_ACTIVE; // 无操作节能状态 (RTC 中断中读取)
+static volatile lcd_rotation_t g_pending_rotation = LCD_ORIENT_DEFAULT; // 待切换的屏幕方向
+static volatile ui_render_profile_t g_pending_render = UI_RENDER_FULL; // 待切换的渲染档位
+
+/* 传感器快照队列的兜底排空周期；正常情况下由快照投递通知立即唤醒 */
+#define UI_SENSOR_EVENT_PERIOD_MS 500
+
+/* lv_mem 统计上报周期：与监控任务的采样周期一致 */
+#define UI_MEM_REPORT_PERIOD_MS SYS_MONITOR_PERIOD_MS
+
+/* LVGL 任务单次休眠的上下限：下限保证同优先级以下的任务有机会运行，
+ * 上限防止唤醒源异常时界面失去响应 */
+#define UI_SLEEP_MIN_MS 2
+#define UI_SLEEP_MAX_MS 500
+
+/* 无操作检查周期；调暗后 LVGL 任务单次休眠的下限 (约 5 帧/秒)；
+ * 熄屏后只为排空传感器事件队列而醒来，休眠时长固定 */
+#define UI_IDLE_CHECK_PERIOD_MS 1000
+#define UI_IDLE_DIM_MIN_SLEEP_MS 200
+#define UI_IDLE_OFF_SLEEP_MS 5000
+
+/* 左右滑动切换的屏幕顺序 (与底部导航栏一致，登录页不参与) */
+static const ui_screen_t g_swipe_order[] = {
+    UI_SCREEN_DASHBOARD, UI_SCREEN_SENSORS_LISTS, UI_SCREEN_DEVICE_DETAILS};
+#define UI_SWIPE_ORDER_COUNT (sizeof(g_swipe_order) / sizeof(g_swipe_order[0]))
+
+/* 屏幕操作表：on_show 为 NULL 的屏幕不进缓存；
+ * on_idle 在进入/退出无操作节能时调用，用于暂停连续动画 */
+typedef struct {
+  void (*init)(lv_obj_t *parent);
+  void (*deinit)(void);
+  void (*on_show)(void);
+  void (*on_hide)(void);
+  void (*on_idle)(bool idle);
+} ui_screen_ops_t;
+
+static void ui_devices_details_init(lv_obj_t *parent);
+
+static const ui_screen_ops_t g_screen_ops[] = {
+    [UI_SCREEN_BOOT] = {ui_screen_boot_init, ui_screen_boot_deinit, NULL, NULL},
+    [UI_SCREEN_LOGIN] = {ui_screen_login_init, NULL, NULL, NULL},
+    [UI_SCREEN_DASHBOARD] = {ui_screen_dashboard_init,
+                             ui_screen_dashboard_deinit,
+                             ui_screen_dashboard_on_show,
+                             ui_screen_dashboard_on_hide,
+                             ui_screen_dashboard_on_idle},
+    [UI_SCREEN_SENSORS_DETAILS] = {ui_screen_sensors_details_init,
+                                   ui_screen_sensors_details_deinit,
+                                   ui_screen_sensors_details_on_show,
+                                   ui_screen_sensors_details_on_hide},
+    [UI_SCREEN_SENSORS_LISTS] = {ui_screen_sensors_lists_init,
+                                 ui_screen_sensors_lists_deinit,
+                                 ui_screen_sensors_lists_on_show,
+                                 ui_screen_sensors_lists_on_hide},
+    [UI_SCREEN_DEVICE_DETAILS] = {ui_devices_details_init,
+                                  ui_screen_devices_details_deinit,
+                                  ui_screen_devices_details_on_show,
+                                  ui_screen_devices_details_on_hide},
+    [UI_SCREEN_SETTINGS] = {NULL, NULL, NULL, NULL}, // 预留
+    [UI_SCREEN_DIAGNOSTICS] = {ui_screen_diagnostics_init,
+                               ui_screen_diagnostics_deinit, NULL, NULL},
+};
+#define UI_SCREEN_OPS_COUNT (sizeof(g_screen_ops) / sizeof(g_screen_ops[0]))
+
+#if UI_SCREEN_CACHE_SIZE > 0
+/* 缓存中的隐藏屏幕，[0] 为最近使用 */
+typedef struct {
+  ui_screen_t id;
+  int32_t context; // 屏幕内容依赖的上下文 (传感器/设备类型)，不同则重建
+  lv_obj_t *container;
+} ui_screen_cache_entry_t;
+
+static ui_screen_cache_entry_t g_screen_cache[UI_SCREEN_CACHE_SIZE];
+static uint8_t g_screen_cache_count = 0;
+#endif
+
+/* -----------------------------------------------------------
+ * 私有函数
+ * ----------------------------------------------------------- */
+
+static const ui_screen_ops_t *ui_screen_get_ops(ui_screen_t screen) {
+  return (uint32_t)screen < UI_SCREEN_OPS_COUNT ? &g_screen_ops[screen] : NULL;
+}
+
+static void ui_devices_details_init(lv_obj_t *parent) {
+  ui_screen_devices_details_init(parent, g_active_device_type);
+}
+
+/**
+ * @brief 屏幕内容依赖的上下文：同一屏幕上下文不同时不能复用缓存
+ */
+static int32_t ui_screen_context(ui_screen_t screen) {
+  switch (screen) {
+  case UI_SCREEN_SENSORS_DETAILS:
+    return (int32_t)g_active_sensor_for_details;
+  case UI_SCREEN_DEVICE_DETAILS:
+    return (int32_t)g_active_device_type;
+  default:
+    return 0;
+  }
+}
+
+/**
+ * @brief 销毁屏幕：先调用其专属的清理函数，再删除根容器
+ * @param now false 时异步删除 (容器可能正是触发本次切换的事件来源)
+ */
+static void ui_screen_destroy(ui_screen_t screen, lv_obj_t *container,
+                              bool now) {
+  const ui_screen_ops_t *ops = ui_screen_get_ops(screen);
+
+  ui_builder_cancel(container); // 未执行的构建步骤会引用已清理的状态
+  if (ops && ops->deinit) {
+    ops->deinit();
+  }
+  if (container) {
+    if (now) {
+      lv_obj_del(container);
+    } else {
+      lv_obj_del_async(container);
+    }
+  }
+}
+
+#if UI_SCREEN_CACHE_SIZE > 0
+static void ui_cache_evict_oldest(bool now) {
+  ui_screen_cache_entry_t entry = g_screen_cache[--g_screen_cache_count];
+  ui_screen_destroy(entry.id, entry.container, now);
+}
+
+/**
+ * @brief 把切走的屏幕隐藏进缓存
+ * @return false 表示该屏幕不支持缓存，由调用方销毁
+ */
+static bool ui_cache_put(ui_screen_t screen, int32_t context,
+                         lv_obj_t *container) {
+  const ui_screen_ops_t *ops = ui_screen_get_ops(screen);
+
+  if (!ops || !ops->on_show || !ops->on_hide) {
+    return false;
+  }
+
+  ui_builder_finish(container); // 缓存中的屏幕总是完整的
+  ops->on_hide();
+  lv_obj_add_flag(container, LV_OBJ_FLAG_HIDDEN);
+
+  if (g_screen_cache_count == UI_SCREEN_CACHE_SIZE) {
+    ui_cache_evict_oldest(false);
+  }
+  memmove(&g_screen_cache[1], &g_screen_cache[0],
+          g_screen_cache_count * sizeof(ui_screen_cache_entry_t));
+  g_screen_cache[0].id = screen;
+  g_screen_cache[0].context = context;
+  g_screen_cache[0].container = container;
+  g_screen_cache_count++;
+  return true;
+}
+
+/**
+ * @brief 从缓存中取出屏幕并重新显示
+ * @return 根容器；不在缓存中或上下文已变化时返回 NULL
+ */
+static lv_obj_t *ui_cache_take(ui_screen_t screen, int32_t context) {
+  for (uint8_t i = 0; i < g_screen_cache_count; i++) {
+    ui_screen_cache_entry_t entry = g_screen_cache[i];
+
+    if (entry.id != screen) {
+      continue;
+    }
+    memmove(&g_screen_cache[i], &g_screen_cache[i + 1],
+            (g_screen_cache_count - i - 1) * sizeof(ui_screen_cache_entry_t));
+    g_screen_cache_count--;
+
+    if (entry.context != context) {
+      ui_screen_destroy(entry.id, entry.container, false);
+      return NULL;
+    }
+    lv_obj_clear_flag(entry.container, LV_OBJ_FLAG_HIDDEN);
+    ui_screen_get_ops(screen)->on_show();
+    return entry.container;
+  }
+  return NULL;
+}
+
+/**
+ * @brief lv_mem 不足时淘汰缓存
+ * @details 推迟到切换之后执行：此时缓存中的容器都不是事件来源，
+ *          可以同步删除，lv_mem_monitor 也能立即看到释放的内存。
+ */
+static void ui_cache_trim_async_cb(void *arg) {
+  (void)arg;
+  lv_mem_monitor_t mon;
+
+  while (g_screen_cache_count > 0) {
+    lv_mem_monitor(&mon);
+    if (mon.free_size >= UI_SCREEN_CACHE_MIN_FREE) {
+      break;
+    }
+    ui_cache_evict_oldest(true);
+  }
+}
+#else
+static bool ui_cache_put(ui_screen_t screen, int32_t context,
+                         lv_obj_t *container) {
+  (void)screen;
+  (void)context;
+  (void)container;
+  return false;
+}
+
+static lv_obj_t *ui_cache_take(ui_screen_t screen, int32_t context) {
+  (void)screen;
+  (void)context;
+  return NULL;
+}
+#endif
+
+/**
+ * @brief 传感器快照投递通知 (运行在传感器任务中)
+ */
+static void ui_sensor_snapshot_notify(void) { ui_wake(UI_WAKE_SENSOR); }
+
+/**
+ * @brief RTC 每秒事件 (运行在 RTC 唤醒中断中)，熄屏时不唤醒 LVGL 任务
+ */
+static void ui_clock_second_notify(uint32_t now) {
+  (void)now;
+  if (g_idle_state != UI_IDLE_OFF) {
+    ui_wake_from_isr(UI_WAKE_CLOCK);
+  }
+}
+
+/**
+ * @brief 排空传感器事件队列并分发给当前屏幕
+ * @details 运行在 lv_task_handler 上下文中，不会等待传感器互斥锁；
+ *          只有真正收到新数据时，屏幕才会刷新控件。快照直接在事件
+ *          记录池中读取，分发完立即释放。
+ *          数据更新交给显示数值的屏幕后记录 UI 延迟，并登记等待上屏
+ *          (熄屏时不登记，见 sensor_latency.h)。
+ */
+static void sensor_event_timer_cb(lv_timer_t *timer) {
+  (void)timer;
+  const SensorSnapshot_t *snapshot;
+
+  while ((snapshot = SensorEventBus_Receive(g_sensor_sub, 0)) != NULL) {
+    bool shown = true;
+
+    switch (g_current_screen_id) {
+    case UI_SCREEN_DASHBOARD:
+      ui_screen_dashboard_on_sensor_event(snapshot);
+      break;
+    case UI_SCREEN_SENSORS_DETAILS:
+      ui_screen_sensors_details_on_sensor_event(snapshot);
+      break;
+    default:
+      shown = false;
+      break;
+    }
+    if (shown && snapshot->event.event_type == SENSOR_EVENT_DATA_UPDATE) {
+      SensorLatency_Record(SENSOR_LATENCY_UI, snapshot->event.data.timestamp_us);
+      if (g_idle_state != UI_IDLE_OFF) {
+        SensorLatency_DisplayQueued(snapshot->event.data.timestamp_us);
+      }
+    }
+    SensorEventBus_Release(snapshot);
+  }
+}
+
+/**
+ * @brief 切换无操作节能状态
+ * @details 熄屏时暂停显示刷新定时器，控件更新只累积无效区域；
+ *          亮屏时整屏重绘一次，顶部栏时钟立即更新 (熄屏期间不处理秒事件)。
+ */
+static void ui_idle_set_state(ui_idle_state_t state) {
+  const ui_screen_ops_t *ops = ui_screen_get_ops(g_current_screen_id);
+  lv_timer_t *refr_timer = _lv_disp_get_refr_timer(lv_disp_get_default());
+  ui_idle_state_t old = g_idle_state;
+
+  if (state == old) {
+    return;
+  }
+  g_idle_state = state;
+
+  if (old == UI_IDLE_OFF) {
+    lv_timer_resume(refr_timer);
+    lv_obj_invalidate(lv_scr_act());
+    ui_comp_header_clock_tick();
+  } else if (state == UI_IDLE_OFF) {
+    lv_timer_pause(refr_timer);
+  }
+
+  if ((old == UI_IDLE_ACTIVE || state == UI_IDLE_ACTIVE) && ops &&
+      ops->on_idle) {
+    ops->on_idle(state != UI_IDLE_ACTIVE);
+  }
+
+  lcd_backlight_set(state == UI_IDLE_ACTIVE ? UI_IDLE_BACKLIGHT_ON
+                    : state == UI_IDLE_DIM  ? UI_IDLE_BACKLIGHT_DIM
+                                            : 0);
+}
+
+/**
+ * @brief 按距上次触摸的时间推进无操作节能状态
+ */
+static void idle_timer_cb(lv_timer_t *timer) {
+  (void)timer;
+  uint32_t inactive = lv_disp_get_inactive_time(NULL);
+
+  if (UI_IDLE_OFF_MS > 0 && inactive >= UI_IDLE_OFF_MS) {
+    ui_idle_set_state(UI_IDLE_OFF);
+  } else if (UI_IDLE_DIM_MS > 0 && inactive >= UI_IDLE_DIM_MS) {
+    ui_idle_set_state(UI_IDLE_DIM);
+  }
+}
+
+/**
+ * @brief 触摸中断唤醒：在读取这次触摸之前就恢复正常显示
+ */
+static void ui_idle_wake(void) {
+  if (g_idle_state == UI_IDLE_ACTIVE) {
+    return;
+  }
+  if (g_idle_state == UI_IDLE_OFF) {
+    /* 用户看不到屏幕内容，唤醒的这次触摸不作为点击 */
+    lv_indev_wait_release(lv_indev_get_next(NULL));
+  }
+  lv_disp_trig_activity(NULL);
+  ui_idle_set_state(UI_IDLE_ACTIVE);
+}
+
+/**
+ * @brief 统计 lv_mem 内存池并上报给监控任务
+ * @details lv_mem_monitor 要遍历整个 TLSF 内存池，只能在 LVGL 任务中调用。
+ */
+static void mem_report_timer_cb(lv_timer_t *timer) {
+  (void)timer;
+  lv_mem_monitor_t mon;
+  SysMonitor_GuiHeap_t heap;
+
+  lv_mem_monitor(&mon);
+  heap.total = mon.total_size;
+  heap.free = mon.free_size;
+  heap.biggest_free = mon.free_biggest_size;
+  heap.max_used = mon.max_used;
+  heap.frag_pct = mon.frag_pct;
+  heap.valid = true;
+  SysMonitor_SetGuiHeap(&heap);
+}
+
+/**
+ * @brief 滑动翻页的异步执行体
+ * @details 手势在输入设备读取回调中识别，此时不能销毁屏幕对象，
+ *          推迟到下一次 lv_timer_handler 再切换。
+ */
+static void ui_swipe_async_cb(void *arg) {
+  ui_load_screen((ui_screen_t)(intptr_t)arg);
+}
+
+/**
+ * @brief 屏幕在 g_swipe_order 中的位置，不参与滑动时返回 -1
+ */
+static int8_t ui_swipe_index(ui_screen_t screen) {
+  for (uint8_t i = 0; i < UI_SWIPE_ORDER_COUNT; i++) {
+    if (g_swipe_order[i] == screen)
+      return (int8_t)i;
+  }
+  return -1;
+}
+
+/**
+ * @brief 左右滑动：在 g_swipe_order 中前后切换，不循环
+ */
+static bool ui_handle_swipe(bool to_next) {
+  for (uint8_t i = 0; i < UI_SWIPE_ORDER_COUNT; i++) {
+    if (g_swipe_order[i] != g_current_screen_id)
+      continue;
+    if (to_next && i + 1 < UI_SWIPE_ORDER_COUNT) {
+      lv_async_call(ui_swipe_async_cb, (void *)(intptr_t)g_swipe_order[i + 1]);
+      return true;
+    }
+    if (!to_next && i > 0) {
+      lv_async_call(ui_swipe_async_cb, (void *)(intptr_t)g_swipe_order[i - 1]);
+      return true;
+    }
+    return false;
+  }
+  return false;
+}
+
+/**
+ * @brief 热启动时回到的屏幕
+ * @details 只恢复监控类页面 (连同详情页的传感器/设备类型)；开机动画、
+ *          登录与设置页面回到主页。
+ */
+static ui_screen_t ui_warm_screen(void) {
+  const WarmStart_State_t *warm = WarmStart_Get();
+
+  if (warm == NULL || warm->sensor_type >= SENSOR_TYPE_MAX ||
+      warm->device_type > DEVICE_TYPE_MOTOR) {
+    return UI_SCREEN_DASHBOARD;
+  }
+  switch (warm->screen) {
+  case UI_SCREEN_SENSORS_DETAILS:
+  case UI_SCREEN_SENSORS_LISTS:
+  case UI_SCREEN_DEVICE_DETAILS:
+  case UI_SCREEN_DIAGNOSTICS:
+    g_active_sensor_for_details = (SensorType_t)warm->sensor_type;
+    g_active_device_type = (DeviceType_t)warm->device_type;
+    return (ui_screen_t)warm->screen;
+  default:
+    return UI_SCREEN_DASHBOARD;
+  }
+}
 
 /* -----------------------------------------------------------
  * 公共函数
@@ -57,85 +498,221 @@ DeviceType_t ui_get_active_device(void) { return g_active_device_type; }
  * @brief 加载指定屏幕
  */
 void ui_load_screen(ui_screen_t screen) {
-  if (screen != g_current_screen_id) {
-    g_previous_screen_id = g_current_screen_id;
-  }
+  const ui_screen_ops_t *ops = ui_screen_get_ops(screen);
+  int32_t context = ui_screen_context(screen);
+  int8_t from = ui_swipe_index(g_current_screen_id);
+  int8_t to = ui_swipe_index(screen);
 
   if (screen == g_current_screen_id) {
     return;
   }
+  g_previous_screen_id = g_current_screen_id;
 
-  /* 获取当前活动屏幕 */
-  lv_obj_t *active_scr = lv_scr_act();
-
-  /* 在销毁旧屏幕之前，调用其专属的清理函数 */
-  switch (g_current_screen_id) {
-  case UI_SCREEN_DASHBOARD:
-    ui_screen_dashboard_deinit();
-    break;
-  case UI_SCREEN_SENSORS_DETAILS:       // [CHANGED] 新枚举名
-    ui_screen_sensors_details_deinit(); // [CHANGED] 新函数名
-    break;
-  case UI_SCREEN_SENSORS_LISTS:       // [CHANGED] 新枚举名
-    ui_screen_sensors_lists_deinit(); // [CHANGED] 新函数名
-    break;
-  case UI_SCREEN_DEVICE_DETAILS:
-    ui_screen_devices_details_deinit();
-    break;
-  default:
-    break;
+  /* 旧屏幕：能缓存则隐藏，否则销毁 (异步删除旧容器) */
+  if (g_current_screen_container == NULL ||
+      !ui_cache_put(g_current_screen_id, g_current_screen_context,
+                    g_current_screen_container)) {
+    ui_screen_destroy(g_current_screen_id, g_current_screen_container, false);
   }
 
-  /* 异步删除旧容器 */
-  if (g_current_screen_container) {
-    lv_obj_del_async(g_current_screen_container);
-    g_current_screen_container = NULL;
+  /* 新屏幕：优先从缓存中恢复 */
+  g_current_screen_container = ui_cache_take(screen, context);
+  if (g_current_screen_container == NULL) {
+    /* 为新屏幕创建一个根容器 */
+    g_current_screen_container = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(g_current_screen_container);
+    lv_obj_set_size(g_current_screen_container, LV_PCT(100), LV_PCT(100));
+
+    if (ops && ops->init) {
+      ops->init(g_current_screen_container);
+    }
   }
 
-  /* 为新屏幕创建一个根容器 */
-  g_current_screen_container = lv_obj_create(active_scr);
-  lv_obj_remove_style_all(g_current_screen_container);
-  lv_obj_set_size(g_current_screen_container, LV_PCT(100), LV_PCT(100));
+  g_current_screen_id = screen;
+  g_current_screen_context = context;
+  FrameStats_SetTag((uint8_t)screen); // 逐帧记录按屏幕区分
+  WarmStart_SetScreen((uint8_t)screen, (uint8_t)g_active_sensor_for_details,
+                      (uint8_t)g_active_device_type);
 
-  /* 根据枚举加载新屏幕的UI */
-  switch (screen) {
-  case UI_SCREEN_BOOT:
-    ui_screen_boot_init(g_current_screen_container);
-    break;
-  case UI_SCREEN_LOGIN:
-    ui_screen_login_init(g_current_screen_container);
-    break;
-  case UI_SCREEN_DASHBOARD:
-    ui_screen_dashboard_init(g_current_screen_container);
-    break;
-  case UI_SCREEN_SENSORS_DETAILS: // [CHANGED] 新枚举名
-    ui_screen_sensors_details_init(
-        g_current_screen_container); // [CHANGED] 新函数名
-    break;
-  case UI_SCREEN_SENSORS_LISTS: // [CHANGED] 新枚举名
-    ui_screen_sensors_lists_init(
-        g_current_screen_container); // [CHANGED] 新函数名
-    break;
-  case UI_SCREEN_DEVICE_DETAILS:
-    ui_screen_devices_details_init(g_current_screen_container,
-                                   g_active_device_type);
-    break;
-  case UI_SCREEN_SETTINGS:
-    // ui_screen_settings_init(g_current_screen_container);
-    break;
-  default:
-    break;
+  /* 常驻的顶部栏/导航栏：新屏幕不用时才隐藏，用到时只更新内容 */
+  ui_comp_header_sync();
+  ui_comp_navbar_sync(screen);
+
+  /* 翻页顺序中的两页之间切换时滑入 (按顺序决定方向)，其余直接显示 */
+  if (from >= 0 && to >= 0 && g_idle_state == UI_IDLE_ACTIVE) {
+    ui_transition_slide(to > from ? 1 : -1);
+  } else {
+    ui_transition_cancel();
   }
 
-  g_current_screen_id = screen;
+  /* 无操作期间由程序切换的屏幕同样暂停动画 */
+  if (g_idle_state != UI_IDLE_ACTIVE && ops && ops->on_idle) {
+    ops->on_idle(true);
+  }
+
+#if UI_SCREEN_CACHE_SIZE > 0
+  if (g_screen_cache_count > 0) {
+    lv_async_call(ui_cache_trim_async_cb, NULL);
+  }
+#endif
+}
+
+/**
+ * @brief 处理触摸手势
+ */
+bool ui_handle_gesture(const TouchGesture_t *gesture) {
+  switch (gesture->type) {
+  case TOUCH_GESTURE_SWIPE_LEFT: // 手指向左：下一页
+    return ui_handle_swipe(true);
+  case TOUCH_GESTURE_SWIPE_RIGHT:
+    return ui_handle_swipe(false);
+  case TOUCH_GESTURE_PINCH_BEGIN:
+  case TOUCH_GESTURE_PINCH:
+  case TOUCH_GESTURE_PINCH_END:
+  case TOUCH_GESTURE_LONG_PRESS:
+    if (g_current_screen_id == UI_SCREEN_SENSORS_DETAILS) {
+      ui_screen_sensors_details_on_gesture(gesture);
+      // 长按交给 LVGL 继续处理 (控件自身的长按事件)
+      return gesture->type != TOUCH_GESTURE_LONG_PRESS;
+    }
+    return false;
+  default:
+    return false;
+  }
 }
 
 /**
  * @brief 初始化UI系统
  */
 void ui_init(void) {
-  // ui_load_screen(UI_SCREEN_BOOT);  // 开机动画
-  ui_load_screen(UI_SCREEN_DASHBOARD); // 调试时直接加载主页
+  g_ui_task = xTaskGetCurrentTaskHandle();
+  g_sensor_event_timer = lv_timer_create(sensor_event_timer_cb,
+                                         UI_SENSOR_EVENT_PERIOD_MS, NULL);
+  g_sensor_sub = SensorEventBus_Subscribe("ui", ui_sensor_snapshot_notify);
+  RtcClock_Subscribe(ui_clock_second_notify); // 顶部栏时钟
+  lv_timer_ready(
+      lv_timer_create(mem_report_timer_cb, UI_MEM_REPORT_PERIOD_MS, NULL));
+  lv_timer_create(idle_timer_cb, UI_IDLE_CHECK_PERIOD_MS, NULL);
+  ui_assets_init(); // 挂载 SPI Flash 中的图片资源包
+  ui_theme_init();  // 应用主题 (常量样式)，须在创建任何对象之前
+  ui_styles_init(); // 共享样式，所有屏幕引用同一份
+
+  // 恢复保存的屏幕方向 (在创建屏幕之前，避免整屏重建一次)
+  uint8_t rot;
+  if (ConfigStore_Get(CONFIG_KEY_DISPLAY_ROTATION, &rot, 1) &&
+      rot < LCD_ROT_COUNT) {
+    lv_port_disp_set_rotation((lcd_rotation_t)rot);
+  }
+  uint8_t profile;
+  if (ConfigStore_Get(CONFIG_KEY_RENDER_PROFILE, &profile, 1) &&
+      profile < UI_RENDER_COUNT) {
+    ui_styles_set_render_profile((ui_render_profile_t)profile);
+  }
+
+  // 冷启动显示开机动画 (其余启动阶段在后台继续)，热启动回到复位前的页面
+  ui_load_screen(ui_screen_boot_wanted() ? UI_SCREEN_BOOT : ui_warm_screen());
+}
+
+/**
+ * @brief 提前唤醒 LVGL 任务 (任务上下文)
+ */
+void ui_wake(uint32_t reason) {
+  if (g_ui_task != NULL) {
+    xTaskNotify(g_ui_task, reason, eSetBits);
+  }
+}
+
+/**
+ * @brief 提前唤醒 LVGL 任务 (中断上下文)
+ */
+void ui_wake_from_isr(uint32_t reason) {
+  BaseType_t woken = pdFALSE;
+  if (g_ui_task != NULL) {
+    xTaskNotifyFromISR(g_ui_task, reason, eSetBits, &woken);
+    portYIELD_FROM_ISR(woken);
+  }
+}
+
+/**
+ * @brief 请求切换屏幕方向
+ * @details 切换要等待 DMA 刷新结束并改写 LCD 寄存器，只能在 LVGL 任务中
+ *          进行；其他任务记下方向后唤醒 LVGL 任务，并保存以便重启后恢复。
+ */
+void ui_request_rotation(lcd_rotation_t rot) {
+  uint8_t value = (uint8_t)rot;
+
+  if (rot >= LCD_ROT_COUNT) {
+    return;
+  }
+  g_pending_rotation = rot;
+  ConfigStore_Set(CONFIG_KEY_DISPLAY_ROTATION, &value, 1);
+  ui_wake(UI_WAKE_ROTATE);
+}
+
+/**
+ * @brief 请求切换渲染档位
+ * @details 改写共享样式、使屏幕失效都要在 LVGL 任务中进行，处理方式与
+ *          屏幕方向相同。
+ */
+void ui_request_render_profile(ui_render_profile_t profile) {
+  uint8_t value = (uint8_t)profile;
+
+  if (profile >= UI_RENDER_COUNT) {
+    return;
+  }
+  g_pending_render = profile;
+  ConfigStore_Set(CONFIG_KEY_RENDER_PROFILE, &value, 1);
+  ui_wake(UI_WAKE_RENDER);
+}
+
+/**
+ * @brief 获取当前无操作节能状态
+ */
+ui_idle_state_t ui_get_idle_state(void) { return g_idle_state; }
+
+/**
+ * @brief LVGL 任务休眠，直到下一个定时器到期或被唤醒
+ * @details 唤醒原因以通知位累积，不会丢失；处理方式只是让对应的
+ *          LVGL 定时器立即就绪，具体工作仍在下一次 lv_timer_handler 中完成。
+ *          调暗后放慢定时器；熄屏后固定休眠 UI_IDLE_OFF_SLEEP_MS，
+ *          只有触摸与传感器快照会提前唤醒。
+ */
+void ui_sleep(uint32_t wait_ms) {
+  uint32_t reasons = 0;
+  uint32_t min_ms = g_idle_state == UI_IDLE_DIM ? UI_IDLE_DIM_MIN_SLEEP_MS
+                                                : UI_SLEEP_MIN_MS;
+
+  if (g_idle_state == UI_IDLE_OFF) {
+    wait_ms = UI_IDLE_OFF_SLEEP_MS;
+  } else if (wait_ms < min_ms) {
+    wait_ms = min_ms;
+  } else if (wait_ms > UI_SLEEP_MAX_MS) {
+    wait_ms = UI_SLEEP_MAX_MS; // 含 LV_NO_TIMER_READY
+  }
+
+  if (xTaskNotifyWait(0, UINT32_MAX, &reasons, pdMS_TO_TICKS(wait_ms)) !=
+      pdTRUE) {
+    return;
+  }
+
+  if (reasons & UI_WAKE_TOUCH) {
+    ui_idle_wake();
+    lv_port_indev_resume();
+  }
+  if ((reasons & UI_WAKE_SENSOR) && g_sensor_event_timer) {
+    lv_timer_ready(g_sensor_event_timer);
+  }
+  if (reasons & UI_WAKE_CLOCK) {
+    ui_comp_header_clock_tick();
+  }
+  if (reasons & UI_WAKE_ROTATE) {
+    ui_idle_wake();
+    lv_port_disp_set_rotation(g_pending_rotation);
+  }
+  if (reasons & UI_WAKE_RENDER) {
+    ui_idle_wake();
+    ui_styles_set_render_profile(g_pending_render);
+  }
 }
 
 /**
@@ -148,3 +725,8 @@ void ui_load_previous_screen(void) {
     ui_load_screen(UI_SCREEN_DASHBOARD); // 默认返回主页
   }
 }
+
+/**
+ * @brief 获取当前屏幕
+ */
+ui_screen_t ui_get_current_screen(void) { return g_current_screen_id; }
@@ -2,8 +2,11 @@
 #define __UI_MANAGER_H
 
 #include "lvgl.h"
+#include "lcd_orient.h"
 #include "sensor_task.h"
+#include "touch_gesture.h"
 #include "ui_screen_devices_details.h"
+#include "ui_styles.h"
 
 /**
  * @brief UIĻö
@@ -16,9 +19,30 @@ typedef enum {
     UI_SCREEN_SENSORS_DETAILS,       // [CHANGED] 
     UI_SCREEN_SENSORS_LISTS,         // [CHANGED] 
     UI_SCREEN_DEVICE_DETAILS,
-    UI_SCREEN_SETTINGS               // [ADD] Ԥҳ
+    UI_SCREEN_SETTINGS,              // [ADD] Ԥҳ
+    UI_SCREEN_DIAGNOSTICS            // [ADD] صϵͳҳ (ҳ)
 } ui_screen_t;
 
+/* Ļ棺ߵĻضɾౣ UI_SCREEN_CACHE_SIZE  (LRU)
+ * ٴνʱֻʾһΣؽȫؼ0 رջ (ÿлؽ) */
+#define UI_SCREEN_CACHE_SIZE 2
+/* lv_mem ʣڸֵʱ̭δõĻĻ */
+#define UI_SCREEN_CACHE_MIN_FREE (8 * 1024)
+
+/* ޲ܣ޴ UI_IDLE_DIM_MS 󱳹ͣ GIF 
+ *  LVGL ʱ UI_IDLE_OFF_MS رձⲢͣȾ
+ * ⴥָ (ϨʱѵδΪ)ȡ 0 رնӦ׶ */
+#define UI_IDLE_DIM_MS (60 * 1000)
+#define UI_IDLE_OFF_MS (5 * 60 * 1000)
+#define UI_IDLE_BACKLIGHT_ON 100   /*  (%) */
+#define UI_IDLE_BACKLIGHT_DIM 15   /* ı (%) */
+
+typedef enum {
+    UI_IDLE_ACTIVE = 0, /* ʾ */
+    UI_IDLE_DIM,        /* ͣʱ */
+    UI_IDLE_OFF         /* رգͣȾ */
+} ui_idle_state_t;
+
 /* ʼUIϵͳ */
 void ui_init(void);
 
@@ -28,6 +52,9 @@ void ui_load_screen(ui_screen_t screen);
 /* һĻ */
 void ui_load_previous_screen(void);
 
+/* ǰĻ */
+ui_screen_t ui_get_current_screen(void);
+
 /*  */
 void ui_set_active_sensor(SensorType_t type);
 SensorType_t ui_get_active_sensor(void);
@@ -36,4 +63,31 @@ SensorType_t ui_get_active_sensor(void);
 void ui_set_active_device(DeviceType_t type);
 DeviceType_t ui_get_active_device(void);
 
+/* LVGL ԭ (֪ͨλ) */
+#define UI_WAKE_TOUCH   (1u << 0)   /* ж */
+#define UI_WAKE_SENSOR  (1u << 1)   /* µĴ */
+#define UI_WAKE_CLOCK   (1u << 2)   /* RTC ÿ¼ */
+#define UI_WAKE_ROTATE  (1u << 3)   /* Ļл */
+#define UI_WAKE_RENDER  (1u << 4)   /* Ⱦλл */
+
+/* ǰ LVGL  ( / ж) */
+void ui_wake(uint32_t reason);
+void ui_wake_from_isr(uint32_t reason);
+
+/* лĻ ():  LVGL л棬ָ */
+void ui_request_rotation(lcd_rotation_t rot);
+
+/* лȾλ ():  LVGL л棬ָ */
+void ui_request_render_profile(ui_render_profile_t profile);
+
+/* ǰ޲״̬ */
+ui_idle_state_t ui_get_idle_state(void);
+
+/* LVGL : ȴ wait_ms (lv_timer_handler ķֵ)ʱԭ */
+void ui_sleep(uint32_t wait_ms);
+
+/*  (LVGL ): һлĻַǰĻ;
+ *  true ʾѱʹã÷Ӧȡ LVGL ԱΰµĴ */
+bool ui_handle_gesture(const TouchGesture_t *gesture);
+
 #endif // __UI_MANAGER_H
@@ -2,16 +2,24 @@
  ******************************************************************************
  * @file    ui_screen_boot.c
  * @brief   开机动画屏幕模块
- * @details 负责显示开机时的打字效果和作者信息动画。
- *          动画结束后，通过ui_manager加载登录屏幕。
+ * @details 负责显示开机时的打字效果和作者信息动画，底部显示启动阶段与
+ *          传感器上线进度。启动阶段全部完成且各传感器都给出初始化结果后，
+ *          只要动画播完或已显示 UI_BOOT_MIN_SHOW_MS，就切换到主页；
+ *          超过 UI_BOOT_READY_TIMEOUT_MS 仍未就绪时也切换。
+ *          触摸屏幕立即跳过。热启动 (看门狗/软件复位) 时不显示本屏幕。
  * @author  MmsY
  * @time    2025/11/23
  ******************************************************************************
  */
 
 #include "ui_screen_boot.h"
+#include "boot_graph.h"
+#include "sensor_task.h"
 #include "string.h"
+#include "sys_monitor.h"
+#include "ui_assets.h"
 #include "ui_manager.h" // [CHANGED] 引入UI管理器
+#include "ui_styles.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -20,10 +28,12 @@
 LV_IMG_DECLARE(author_photo);
 LV_IMG_DECLARE(bilbil);
 LV_FONT_DECLARE(my_font_yahei_36);
-LV_FONT_DECLARE(my_font_yahei_24);
 
 /* --------------------- 模块私有定义 ------------------------- */
 
+#define BOOT_NEXT_SCREEN UI_SCREEN_DASHBOARD
+#define BOOT_PROGRESS_PERIOD_MS 100
+
 // 将所有静态全局变量封装到一个结构体中
 typedef struct {
   lv_obj_t *author_obj;       // 作者信息的容器对象
@@ -35,6 +45,15 @@ typedef struct {
   lv_obj_t *text_label;       // 第一行打字效果文本标签
   lv_obj_t *text_label1;      // 第二行打字效果文本标签
   lv_timer_t *typing_timer;   // 打字效果定时器
+  size_t typed_len;           // 第一行已显示的字符数
+  size_t typed_len1;          // 第二行已显示的字符数
+  lv_obj_t *parent;           // 屏幕根容器
+  lv_obj_t *progress_bar;     // 启动进度条
+  lv_obj_t *progress_label;   // 启动进度文字
+  lv_timer_t *progress_timer; // 进度刷新与就绪检查定时器
+  uint32_t start_tick;        // 本屏幕创建时刻
+  bool anim_done;             // 动画已播完
+  bool leaving;               // 已请求切换到下一个屏幕
 } boot_screen_ui_t;
 
 static boot_screen_ui_t g_ui; // 使用一个全局的结构体实例
@@ -49,6 +68,7 @@ static void bounce_anim(void *var);
 static void display_anim(void *var);
 static void left_move_anim(void *var);
 static void obj_hide_anim(void *var);
+static void boot_leave(void);
 
 // --- 动画回调函数 ---
 // 通用的透明度设置回调
@@ -87,10 +107,12 @@ static void author_photo_anim_end(lv_anim_t *var) {
   obj_hide_anim(g_ui.label_obj);
 }
 
-// [关键修改] 所有动画的最终回调：通知UI管理器切换到登录界面
+// 所有动画的最终回调 (三个隐藏动画各调用一次)：是否切换由进度定时器判断
 static void obj_anim_end(lv_anim_t *var) {
-  // 动画流程结束，加载下一个屏幕
-  ui_load_screen(UI_SCREEN_LOGIN);
+  g_ui.anim_done = true;
+  if (g_ui.progress_timer) {
+    lv_timer_ready(g_ui.progress_timer);
+  }
 }
 
 // [关键修改] 打字效果的渐隐动画结束后，启动第二阶段的作者动画
@@ -153,25 +175,21 @@ static void obj_hide_anim(void *var) {
 static void lv_typing_effect(lv_timer_t *timer) {
   static const char *full_text = "STM32 ZGT6";
   static const char *full_text1 = "HAL库+FreeRTOS+LVGL";
-  static size_t text_len = 0;
-  static size_t text_len1 = 0;
   static char typing_buffer[128]; // 使用静态缓冲区，避免malloc
 
-  if (text_len < strlen(full_text)) {
-    text_len++;
-    strncpy(typing_buffer, full_text, text_len);
-    typing_buffer[text_len] = '\0';
+  if (g_ui.typed_len < strlen(full_text)) {
+    g_ui.typed_len++;
+    strncpy(typing_buffer, full_text, g_ui.typed_len);
+    typing_buffer[g_ui.typed_len] = '\0';
     lv_label_set_text(g_ui.text_label, typing_buffer);
-  } else if (text_len1 < strlen(full_text1)) {
-    text_len1++;
-    strncpy(typing_buffer, full_text1, text_len1);
-    typing_buffer[text_len1] = '\0';
+  } else if (g_ui.typed_len1 < strlen(full_text1)) {
+    g_ui.typed_len1++;
+    strncpy(typing_buffer, full_text1, g_ui.typed_len1);
+    typing_buffer[g_ui.typed_len1] = '\0';
     lv_label_set_text(g_ui.text_label1, typing_buffer);
   } else {
     lv_timer_del(timer); // 打字效果完成后删除定时器
     g_ui.typing_timer = NULL;
-    text_len = 0;
-    text_len1 = 0;
 
     // 启动文字渐隐动画
     lv_anim_t a1;
@@ -226,19 +244,18 @@ static void create_typing_effect(lv_obj_t *parent) {
 
 // 创建第二阶段的作者信息UI
 static void lv_boot_anim2_author(void) {
-  lv_obj_t *parent = lv_scr_act(); // 此时父对象就是屏幕本身
-
-  g_ui.author_obj = lv_obj_create(parent);
+  // 建在本屏幕的根容器中，随屏幕一起删除
+  g_ui.author_obj = lv_obj_create(g_ui.parent);
   lv_obj_remove_style_all(g_ui.author_obj);
   lv_obj_set_size(g_ui.author_obj, 600, 480);
   lv_obj_center(g_ui.author_obj);
 
   g_ui.bilbil_img = lv_img_create(g_ui.author_obj);
-  lv_img_set_src(g_ui.bilbil_img, &bilbil);
+  lv_img_set_src(g_ui.bilbil_img, UI_ASSET_SRC(bilbil));
   lv_obj_align(g_ui.bilbil_img, LV_ALIGN_TOP_MID, 0, 0);
 
   g_ui.author_photo_img = lv_img_create(g_ui.author_obj);
-  lv_img_set_src(g_ui.author_photo_img, &author_photo);
+  lv_img_set_src(g_ui.author_photo_img, UI_ASSET_SRC(author_photo));
   lv_obj_align(g_ui.author_photo_img, LV_ALIGN_CENTER, -120, 50);
   lv_obj_set_style_img_opa(g_ui.author_photo_img, 0, 0);
 
@@ -249,13 +266,13 @@ static void lv_boot_anim2_author(void) {
 
   lv_obj_t *name_label = lv_label_create(g_ui.label_obj);
   lv_label_set_text(name_label, "UP主：");
-  lv_obj_set_style_text_font(name_label, &my_font_yahei_24, 0);
+  lv_obj_add_style(name_label, ui_style(UI_STYLE_TEXT_CN), 0);
   lv_obj_set_style_text_color(name_label, lv_color_hex(0xFFD700), 0);
   lv_obj_align(name_label, LV_ALIGN_TOP_MID, 0, 0);
 
   lv_obj_t *name_label1 = lv_label_create(g_ui.label_obj);
   lv_label_set_text(name_label1, "木木三鸭MmsY");
-  lv_obj_set_style_text_font(name_label1, &my_font_yahei_24, 0);
+  lv_obj_add_style(name_label1, ui_style(UI_STYLE_TEXT_CN), 0);
   lv_obj_set_style_text_color(name_label1, lv_color_hex(0xFFD700), 0);
   lv_obj_align(name_label1, LV_ALIGN_BOTTOM_MID, -5, 0);
 
@@ -263,6 +280,89 @@ static void lv_boot_anim2_author(void) {
   bounce_anim(g_ui.bilbil_img);
 }
 
+// --- 启动进度 ---
+
+// 各传感器都已给出初始化结果 (不再处于初始化中) 的个数
+static uint8_t boot_sensors_settled(uint8_t *total) {
+  uint8_t settled = 0;
+
+  *total = 0;
+  for (int type = SENSOR_TYPE_NONE + 1; type < SENSOR_TYPE_MAX; type++) {
+    SensorStatus_t status;
+
+    (*total)++;
+    if (SensorTask_GetSensorStatus((SensorType_t)type, &status) &&
+        status != SENSOR_STATUS_INITIALIZING) {
+      settled++;
+    }
+  }
+  return settled;
+}
+
+// 刷新进度并判断是否可以离开：传感器在启动阶段中注册，阶段全部完成后的
+// 状态才有意义
+static void boot_progress_timer_cb(lv_timer_t *timer) {
+  (void)timer;
+  uint8_t done, total;
+  uint8_t sensors, sensor_total;
+  uint32_t elapsed = lv_tick_elaps(g_ui.start_tick);
+  bool ready;
+
+  BootGraph_GetProgress(&done, &total);
+  sensors = boot_sensors_settled(&sensor_total);
+  ready = (done == total) && (sensors == sensor_total);
+
+  lv_bar_set_range(g_ui.progress_bar, 0, total + sensor_total);
+  lv_bar_set_value(g_ui.progress_bar, done == total ? done + sensors : done,
+                   LV_ANIM_OFF);
+  if (done < total) {
+    lv_label_set_text_fmt(g_ui.progress_label, "Starting %u/%u", done, total);
+  } else {
+    lv_label_set_text_fmt(g_ui.progress_label, "Sensors %u/%u", sensors,
+                          sensor_total);
+  }
+
+  if (!g_ui.anim_done && elapsed < UI_BOOT_MIN_SHOW_MS) {
+    return;
+  }
+  if (ready || elapsed >= UI_BOOT_READY_TIMEOUT_MS) {
+    boot_leave();
+  }
+}
+
+// 切换到下一个屏幕 (只执行一次)
+static void boot_leave(void) {
+  if (g_ui.leaving) {
+    return;
+  }
+  g_ui.leaving = true;
+  ui_load_screen(BOOT_NEXT_SCREEN);
+}
+
+// 触摸任意位置跳过开机动画
+static void boot_skip_event_cb(lv_event_t *e) {
+  (void)e;
+  boot_leave();
+}
+
+// 创建底部的启动进度条与文字
+static void create_progress(lv_obj_t *parent) {
+  g_ui.progress_bar = lv_bar_create(parent);
+  lv_obj_set_size(g_ui.progress_bar, LV_PCT(60), 6);
+  lv_obj_align(g_ui.progress_bar, LV_ALIGN_BOTTOM_MID, 0, -40);
+  lv_obj_clear_flag(g_ui.progress_bar, LV_OBJ_FLAG_CLICKABLE);
+
+  g_ui.progress_label = lv_label_create(parent);
+  lv_obj_set_style_text_color(g_ui.progress_label, lv_color_hex(0x808080), 0);
+  lv_obj_align_to(g_ui.progress_label, g_ui.progress_bar,
+                  LV_ALIGN_OUT_BOTTOM_MID, 0, 6);
+  lv_label_set_text(g_ui.progress_label, "");
+
+  g_ui.progress_timer =
+      lv_timer_create(boot_progress_timer_cb, BOOT_PROGRESS_PERIOD_MS, NULL);
+  lv_timer_ready(g_ui.progress_timer);
+}
+
 // --- 公共函数实现 ---
 
 /**
@@ -272,11 +372,54 @@ static void lv_boot_anim2_author(void) {
 void ui_screen_boot_init(lv_obj_t *parent) {
   // 清空全局结构体，确保没有残留数据
   memset(&g_ui, 0, sizeof(boot_screen_ui_t));
+  g_ui.parent = parent;
+  g_ui.start_tick = lv_tick_get();
 
   // 设置父容器(即屏幕)的背景色
   lv_obj_set_style_bg_color(parent, lv_color_hex(0x000000), 0);
   lv_obj_set_style_bg_opa(parent, LV_OPA_COVER, 0);
 
+  // 按下任意位置跳过
+  lv_obj_add_flag(parent, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_event_cb(parent, boot_skip_event_cb, LV_EVENT_PRESSED, NULL);
+
   // 启动第一阶段动画：打字效果
   create_typing_effect(parent);
+  create_progress(parent);
+}
+
+/**
+ * @brief 反初始化开机动画屏幕：删除定时器，停止仍在进行的动画
+ * @note  根容器由 UI 管理器异步删除，动画须在这里先删掉，避免完成回调
+ *        在删除之前再次触发切换
+ */
+void ui_screen_boot_deinit(void) {
+  if (g_ui.typing_timer) {
+    lv_timer_del(g_ui.typing_timer);
+    g_ui.typing_timer = NULL;
+  }
+  if (g_ui.progress_timer) {
+    lv_timer_del(g_ui.progress_timer);
+    g_ui.progress_timer = NULL;
+  }
+  // lv_anim_del 的对象为 NULL 时会删除所有动画，尚未创建的对象要跳过
+  lv_obj_t *anim_objs[] = {g_ui.text_label, g_ui.text_label1, g_ui.bilbil_img,
+                           g_ui.author_photo_img, g_ui.label_obj};
+  for (size_t i = 0; i < sizeof(anim_objs) / sizeof(anim_objs[0]); i++) {
+    if (anim_objs[i]) {
+      lv_anim_del(anim_objs[i], NULL);
+    }
+  }
+  g_ui.leaving = true;
+}
+
+/**
+ * @brief 本次启动是否显示开机动画
+ */
+bool ui_screen_boot_wanted(void) {
+#if UI_BOOT_SKIP_ON_WARM_RESET
+  return !SysMonitor_IsWarmReset();
+#else
+  return true;
+#endif
 }
@@ -3,7 +3,20 @@
 
 #include "lvgl.h"
 
+/* ʾʱ䣻򳬹ʱϵͳлҳ */
+#define UI_BOOT_MIN_SHOW_MS 3000
+/* ʱδ (߻׶οס) ʱͬл */
+#define UI_BOOT_READY_TIMEOUT_MS 8000
+/* 1:  (Ź//λ) ʱֱӽҳ */
+#define UI_BOOT_SKIP_ON_WARM_RESET 1
+
 // ʼĻUI
 void ui_screen_boot_init(lv_obj_t* parent);
 
+// ʼĻ ( UI ʱ)
+void ui_screen_boot_deinit(void);
+
+// Ƿʾ (δ)
+bool ui_screen_boot_wanted(void);
+
 #endif
@@ -3,7 +3,7 @@
  * @file    ui_screen_dashboard.c
  * @brief   主控台屏幕模块（整理版）
  * @details - 顶部：标准顶部栏组件（含系统时间）
- *          - 中部：1x4 数据显示栅格
+ *          - 中部：1x4 数据显示栅格 (每张数据卡片为一个自绘对象，见 ui_comp_card)
  *          - 底部：1x3 设备控制栅格
  *          - 最底部：导航栏
  * @author  MmsY
@@ -13,33 +13,54 @@
 
 #include "ui_screen_dashboard.h"
 #include "devices_manager.h"
+#include "fmt_fixed.h"
+#include "sensor_anomaly.h"
 #include "sensor_task.h"
+#include "ui_comp_binding.h"
+#include "ui_comp_card.h"
+#include "ui_comp_gif.h"
 #include "ui_comp_header.h"
 #include "ui_comp_navbar.h"
+#include "ui_assets.h"
+#include "ui_builder.h"
+#include "ui_glyph_atlas.h"
 #include "ui_manager.h"
+#include "ui_styles.h"
+#include <string.h>
 
 
 /* 字体与资源声明 */
 LV_FONT_DECLARE(my_font_yahei_24);
 LV_IMG_DECLARE(led_symbol);
-LV_IMG_DECLARE(beep_symbol);
-LV_IMG_DECLARE(mygif);
+LV_IMG_DECLARE(beep_symbol); /* 需要旋转，旋转只支持整幅在内存中的图片 */
+LV_IMG_DECLARE(mygif); /* GIF 较小且由 gifdec 整体读取，保留在片内 */
+
+/* 烟感仪表量程与告警色阈值 (与烟雾超限告警规则一致) */
+#define DASH_SMOKE_GAUGE_MAX 1000
+#define DASH_SMOKE_GAUGE_WARN 300
+
+/* 数据卡片 */
+typedef enum {
+  DASH_CARD_CLIMATE = 0, /* 温湿度 (两个数值) */
+  DASH_CARD_LIGHT,       /* 光照 */
+  DASH_CARD_SMOKE,       /* 烟感 (仪表) */
+  DASH_CARD_COUNT
+} dash_card_t;
 
 /* UI 状态结构体 */
 typedef struct {
   ui_header_t *header;
 
-  /* 数据标签 */
-  lv_obj_t *temp_label;
-  lv_obj_t *humi_label;
-  lv_obj_t *light_label;
-  lv_obj_t *smoke_label;
+  /* 数据卡片：数值与异常标记只在变化时使数值区失效 */
+  ui_card_t cards[DASH_CARD_COUNT];
+  ui_led_binding_t led_bind;
 
   /* LED 控制 */
   lv_obj_t *led_indicator;
   lv_obj_t *led_cycle_btn;
   lv_obj_t *led_mode_btn;
   lv_obj_t *led_panel;
+  uint32_t led_state_version; /* 上次同步的设备状态版本 */
 
   /* 蜂鸣器 */
   lv_obj_t *beep_img;
@@ -50,16 +71,36 @@ typedef struct {
   lv_obj_t *gif_anim_obj;
   lv_anim_t gif_anim;
 
-  /* 数据更新定时器 */
-  lv_timer_t *data_update_timer;
+  lv_obj_t *ctrl_grid; /* 设备控制区 (面板分步加入) */
 } dashboard_ui_t;
 
 static dashboard_ui_t g_ui;
 
+/* 数值字体：预渲染图集，屏幕重建时沿用 */
+static ui_glyph_atlas_t g_value_atlas;
+static bool g_value_atlas_ready = false;
+
+/* 卡片配置 (字体在创建时填入) */
+static ui_card_config_t g_card_cfg[DASH_CARD_COUNT] = {
+    [DASH_CARD_CLIMATE] = {.title = "温湿度", .units = {"℃", "%RH"}, .field_count = 2},
+    [DASH_CARD_LIGHT] = {.title = "光照", .units = {"Lux"}, .field_count = 1},
+    [DASH_CARD_SMOKE] = {.title = "烟感",
+                         .units = {"PPM"},
+                         .field_count = 1,
+                         .gauge = true,
+                         .gauge_min = 0,
+                         .gauge_max = DASH_SMOKE_GAUGE_MAX,
+                         .gauge_warn = DASH_SMOKE_GAUGE_WARN},
+};
+
 /* 函数声明（按实现顺序） */
-static void sync_led_controls_from_driver(void);
-static void sensor_data_update_cb(lv_timer_t *timer);
+static void sync_led_controls_from_driver(bool force);
+static void dashboard_apply_sensor_data(SensorType_t type,
+                                        const SensorData_t *data);
+static void dashboard_load_sensor_data(bool full);
+static void dashboard_apply_anomaly(SensorType_t type, uint8_t mask);
 static void data_panel_click_event_cb(lv_event_t *e);
+static void title_long_press_event_cb(lv_event_t *e);
 static void led_cycle_btn_event_cb(lv_event_t *e);
 static void led_mode_btn_event_cb(lv_event_t *e);
 static void led_panel_click_event_cb(lv_event_t *e);
@@ -68,23 +109,32 @@ static void beep_off_timer_cb(lv_timer_t *timer);
 static void gif_switch_event_cb(lv_event_t *e);
 static void set_angle_anim_cb(void *obj, int32_t v);
 static void set_size_anim_cb(void *obj, int32_t v);
-static void create_temp_humi_panel(lv_obj_t *parent, int grid_col);
-static void create_single_data_panel(lv_obj_t *parent, int grid_col,
-                                     const char *title, const char *unit,
-                                     lv_obj_t **value_label,
-                                     SensorType_t sensor_type);
+static const lv_font_t *dashboard_value_font(void);
+static void create_data_card(lv_obj_t *parent, int grid_col, int col_span,
+                             dash_card_t card, SensorType_t sensor_type);
 static void create_led_panel(lv_obj_t *parent, int grid_col, int grid_row);
 static void create_beep_panel(lv_obj_t *parent, int grid_col, int grid_row);
 static void create_gif_panel(lv_obj_t *parent, int grid_col, int grid_row);
+static void dashboard_build_step(uint8_t step);
 
 /* -------------------- 帮助函数 -------------------- */
 
-/* 从驱动层同步 LED 控制区状态 */
-static void sync_led_controls_from_driver(void) {
-  led_control_mode_t mode = Drivers_RGBLED_GetMode();
-  lv_obj_t *mode_label = lv_obj_get_child(g_ui.led_mode_btn, 0);
+/* 从驱动层同步 LED 控制区状态：每次只读取一份设备状态快照，
+ * force 为 false 且状态版本未变化时跳过刷新 */
+static void sync_led_controls_from_driver(bool force) {
+  Drivers_State_t state;
+  lv_obj_t *mode_label;
 
-  if (mode == LED_MODE_AUTO) {
+  if (g_ui.led_mode_btn == NULL) {
+    return; /* LED 面板尚未构建，建好时会强制同步一次 */
+  }
+  mode_label = lv_obj_get_child(g_ui.led_mode_btn, 0);
+  if (!force && Drivers_GetStateVersion() == g_ui.led_state_version) {
+    return;
+  }
+  g_ui.led_state_version = Drivers_GetState(&state);
+
+  if (state.led_mode == LED_MODE_AUTO) {
     lv_label_set_text(mode_label, LV_SYMBOL_REFRESH " 自动");
     lv_obj_add_state(g_ui.led_cycle_btn, LV_STATE_DISABLED);
   } else {
@@ -92,111 +142,130 @@ static void sync_led_controls_from_driver(void) {
     lv_obj_clear_state(g_ui.led_cycle_btn, LV_STATE_DISABLED);
   }
 
-  if (mode == LED_MODE_MANUAL) {
-    led_manual_state_t state = Drivers_RGBLED_GetManualState();
-    RGB_Color slot_color;
+  if (state.led_mode == LED_MODE_MANUAL) {
     lv_obj_t *cycle_label = lv_obj_get_child(g_ui.led_cycle_btn, 0);
+    RGB_Color slot_color;
 
-    switch (state) {
+    switch (state.led_manual_state) {
     case LED_STATE_SLOT_1:
-      if (Drivers_RGBLED_GetSlotColor(1, &slot_color)) {
-        lv_led_set_color(
-            g_ui.led_indicator,
-            lv_color_make(slot_color.R, slot_color.G, slot_color.B));
-        lv_led_on(g_ui.led_indicator);
-      }
-      lv_label_set_text(cycle_label, "颜色1");
-      break;
-
     case LED_STATE_SLOT_2:
-      if (Drivers_RGBLED_GetSlotColor(2, &slot_color)) {
-        lv_led_set_color(
-            g_ui.led_indicator,
-            lv_color_make(slot_color.R, slot_color.G, slot_color.B));
-        lv_led_on(g_ui.led_indicator);
-      }
-      lv_label_set_text(cycle_label, "颜色2");
-      break;
-
     case LED_STATE_SLOT_3:
-      if (Drivers_RGBLED_GetSlotColor(3, &slot_color)) {
-        lv_led_set_color(
-            g_ui.led_indicator,
-            lv_color_make(slot_color.R, slot_color.G, slot_color.B));
-        lv_led_on(g_ui.led_indicator);
-      }
-      lv_label_set_text(cycle_label, "颜色3");
+      slot_color = state.led_slots[state.led_manual_state - LED_STATE_SLOT_1];
+      ui_bind_led_set(&g_ui.led_bind,
+                      lv_color_make(slot_color.R, slot_color.G, slot_color.B),
+                      true);
+      lv_label_set_text_fmt(cycle_label, "颜色%d",
+                            (int)(state.led_manual_state - LED_STATE_OFF));
       break;
 
     case LED_STATE_OFF:
     default:
-      lv_led_off(g_ui.led_indicator);
+      ui_bind_led_set(&g_ui.led_bind, lv_color_black(), false);
       lv_label_set_text(cycle_label, "关闭");
       break;
     }
   } else {
-    RGB_Color current_color = Drivers_RGBLED_GetColor();
+    RGB_Color current_color = state.led_color;
     if (current_color.R == 0 && current_color.G == 0 && current_color.B == 0) {
-      lv_led_off(g_ui.led_indicator);
+      ui_bind_led_set(&g_ui.led_bind, lv_color_black(), false);
     } else {
-      lv_led_set_color(
-          g_ui.led_indicator,
-          lv_color_make(current_color.R, current_color.G, current_color.B));
-      lv_led_on(g_ui.led_indicator);
+      ui_bind_led_set(&g_ui.led_bind,
+                      lv_color_make(current_color.R, current_color.G,
+                                    current_color.B),
+                      true);
     }
   }
 }
 
-/* -------------------- 定时器回调 -------------------- */
+/* -------------------- 数据刷新 -------------------- */
+
+/* 把一个传感器的数据写入对应控件，data 为 NULL 表示数据无效
+ * （内容不变的控件不会被重绘） */
+static void dashboard_apply_sensor_data(SensorType_t type,
+                                        const SensorData_t *data) {
+  char text[FMT_FIXED_BUF_SIZE];
+  ui_card_t *card;
+
+  switch (type) {
+  case SENSOR_TYPE_SHT30: /* 温湿度 */
+    card = &g_ui.cards[DASH_CARD_CLIMATE];
+    if (data != NULL) {
+      ui_comp_card_set_text(card, 0, fmt_q1(data->values.sht30.temp, text));
+      ui_comp_card_set_text(card, 1, fmt_q1(data->values.sht30.humi, text));
+    } else {
+      ui_comp_card_set_text(card, 0, "--.-");
+      ui_comp_card_set_text(card, 1, "--.-");
+    }
+    break;
 
-/* 定时从 sensor_task 获取并更新 UI 数据 */
-static void sensor_data_update_cb(lv_timer_t *timer) {
-  SensorData_t data;
+  case SENSOR_TYPE_GY30: /* 光照 */
+    card = &g_ui.cards[DASH_CARD_LIGHT];
+    if (data != NULL) {
+      lv_snprintf(text, sizeof(text), "%d", (int)data->values.gy30.lux);
+      ui_comp_card_set_text(card, 0, text);
 
-  /* 温湿度 */
-  if (SensorTask_GetSensorData(SENSOR_TYPE_SHT30, &data) && data.is_valid) {
-    if (g_ui.temp_label)
-      lv_label_set_text_fmt(g_ui.temp_label, "%.1f", data.values.sht30.temp);
-    if (g_ui.humi_label)
-      lv_label_set_text_fmt(g_ui.humi_label, "%.1f", data.values.sht30.humi);
-  } else {
-    if (g_ui.temp_label)
-      lv_label_set_text(g_ui.temp_label, "--.-");
-    if (g_ui.humi_label)
-      lv_label_set_text(g_ui.humi_label, "--.-");
-  }
+      /* 自动模式下 LED 由输出控制任务按光照调节，这里只同步显示 */
+      sync_led_controls_from_driver(false);
+    } else {
+      ui_comp_card_set_text(card, 0, "--");
+    }
+    break;
 
-  /* 光照 */
-  if (SensorTask_GetSensorData(SENSOR_TYPE_GY30, &data) && data.is_valid) {
-    if (g_ui.light_label)
-      lv_label_set_text_fmt(g_ui.light_label, "%d", (int)data.values.gy30.lux);
-
-    /* 自动模式下根据光照调节 LED */
-    if (Drivers_RGBLED_GetMode() == LED_MODE_AUTO) {
-      Drivers_RGBLED_AutoAdjust(data.values.gy30.lux);
-      RGB_Color current_color = Drivers_RGBLED_GetColor();
-      if (current_color.R == 0 && current_color.G == 0 &&
-          current_color.B == 0) {
-        lv_led_off(g_ui.led_indicator);
-      } else {
-        lv_led_set_color(
-            g_ui.led_indicator,
-            lv_color_make(current_color.R, current_color.G, current_color.B));
-        lv_led_on(g_ui.led_indicator);
-      }
+  case SENSOR_TYPE_SMOKE: /* 烟感 */
+    card = &g_ui.cards[DASH_CARD_SMOKE];
+    if (data != NULL) {
+      lv_snprintf(text, sizeof(text), "%d", data->values.smoke.ppm);
+      ui_comp_card_set_text(card, 0, text);
+      ui_comp_card_set_gauge(card, data->values.smoke.ppm);
+    } else {
+      ui_comp_card_set_text(card, 0, "--");
+      ui_comp_card_set_gauge(card, 0);
     }
-  } else {
-    if (g_ui.light_label)
-      lv_label_set_text(g_ui.light_label, "--");
+    break;
+
+  default:
+    break;
   }
+}
 
-  /* 烟感 */
-  if (SensorTask_GetSensorData(SENSOR_TYPE_SMOKE, &data) && data.is_valid) {
-    if (g_ui.smoke_label)
-      lv_label_set_text_fmt(g_ui.smoke_label, "%d", data.values.smoke.ppm);
-  } else {
-    if (g_ui.smoke_label)
-      lv_label_set_text(g_ui.smoke_label, "--");
+/* 异常标记：任一通道异常时在卡片右上角显示 */
+static void dashboard_apply_anomaly(SensorType_t type, uint8_t mask) {
+  switch (type) {
+  case SENSOR_TYPE_SHT30:
+    ui_comp_card_set_alert(&g_ui.cards[DASH_CARD_CLIMATE], mask != 0);
+    break;
+  case SENSOR_TYPE_GY30:
+    ui_comp_card_set_alert(&g_ui.cards[DASH_CARD_LIGHT], mask != 0);
+    break;
+  case SENSOR_TYPE_SMOKE:
+    ui_comp_card_set_alert(&g_ui.cards[DASH_CARD_SMOKE], mask != 0);
+    break;
+  default:
+    break;
+  }
+}
+
+/* 进入页面时主动拉取一次当前数据，之后完全由传感器事件驱动
+ * 一次取得全部传感器的一致快照；full 为 false 时只刷新隐藏期间有变化的卡片 */
+static void dashboard_load_sensor_data(bool full) {
+  static const SensorType_t types[] = {SENSOR_TYPE_SHT30, SENSOR_TYPE_GY30,
+                                       SENSOR_TYPE_SMOKE};
+  static SensorSystemSnapshot_t snap;
+
+  if (full) {
+    memset(&snap, 0, sizeof(snap));
+  }
+  SensorTask_GetSnapshot(&snap);
+
+  for (size_t i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+    const SensorSnapshotEntry_t *e = SensorTask_SnapshotFind(&snap, types[i]);
+    bool ok = e != NULL && e->is_enabled && e->data.is_valid;
+
+    if (full || e == NULL ||
+        (snap.changed & (1UL << (uint32_t)(e - snap.entry)))) {
+      dashboard_apply_sensor_data(types[i], ok ? &e->data : NULL);
+    }
+    dashboard_apply_anomaly(types[i], SensorAnomaly_GetMask(types[i]));
   }
 }
 
@@ -218,62 +287,26 @@ static void data_panel_click_event_cb(lv_event_t *e) {
   }
 }
 
+/* 长按顶部栏标题：进入隐藏的系统诊断页 */
+static void title_long_press_event_cb(lv_event_t *e) {
+  (void)e;
+  ui_load_screen(UI_SCREEN_DIAGNOSTICS);
+}
+
 /* LED 手动循环按钮 */
 static void led_cycle_btn_event_cb(lv_event_t *e) {
   Drivers_RGBLED_CycleColor();
-  led_manual_state_t state = Drivers_RGBLED_GetManualState();
-  RGB_Color slot_color;
-
-  switch (state) {
-  case LED_STATE_SLOT_1:
-    if (Drivers_RGBLED_GetSlotColor(1, &slot_color)) {
-      lv_led_set_color(g_ui.led_indicator,
-                       lv_color_make(slot_color.R, slot_color.G, slot_color.B));
-      lv_led_on(g_ui.led_indicator);
-    }
-    lv_label_set_text(lv_obj_get_child(g_ui.led_cycle_btn, 0), "颜色1");
-    break;
-
-  case LED_STATE_SLOT_2:
-    if (Drivers_RGBLED_GetSlotColor(2, &slot_color)) {
-      lv_led_set_color(g_ui.led_indicator,
-                       lv_color_make(slot_color.R, slot_color.G, slot_color.B));
-      lv_led_on(g_ui.led_indicator);
-    }
-    lv_label_set_text(lv_obj_get_child(g_ui.led_cycle_btn, 0), "颜色2");
-    break;
-
-  case LED_STATE_SLOT_3:
-    if (Drivers_RGBLED_GetSlotColor(3, &slot_color)) {
-      lv_led_set_color(g_ui.led_indicator,
-                       lv_color_make(slot_color.R, slot_color.G, slot_color.B));
-      lv_led_on(g_ui.led_indicator);
-    }
-    lv_label_set_text(lv_obj_get_child(g_ui.led_cycle_btn, 0), "颜色3");
-    break;
-
-  case LED_STATE_OFF:
-  default:
-    lv_led_off(g_ui.led_indicator);
-    lv_label_set_text(lv_obj_get_child(g_ui.led_cycle_btn, 0), "关闭");
-    break;
-  }
+  sync_led_controls_from_driver(false);
 }
 
 /* LED 模式切换按钮 */
 static void led_mode_btn_event_cb(lv_event_t *e) {
-  led_control_mode_t current_mode = Drivers_RGBLED_GetMode();
-  if (current_mode == LED_MODE_MANUAL) {
+  if (Drivers_RGBLED_GetMode() == LED_MODE_MANUAL) {
     Drivers_RGBLED_SetMode(LED_MODE_AUTO);
-    lv_label_set_text(lv_obj_get_child(g_ui.led_mode_btn, 0),
-                      LV_SYMBOL_REFRESH " 自动");
-    lv_obj_add_state(g_ui.led_cycle_btn, LV_STATE_DISABLED);
   } else {
     Drivers_RGBLED_SetMode(LED_MODE_MANUAL);
-    lv_label_set_text(lv_obj_get_child(g_ui.led_mode_btn, 0),
-                      LV_SYMBOL_SETTINGS " 手动");
-    lv_obj_clear_state(g_ui.led_cycle_btn, LV_STATE_DISABLED);
   }
+  sync_led_controls_from_driver(false);
 }
 
 /* LED 面板点击：进入详情页 */
@@ -322,93 +355,28 @@ static void set_size_anim_cb(void *obj, int32_t v) {
 
 /* -------------------- UI 创建函数 -------------------- */
 
-/* 创建温湿度组合面板 */
-static void create_temp_humi_panel(lv_obj_t *parent, int grid_col) {
-  lv_obj_t *panel = lv_obj_create(parent);
-  lv_obj_set_grid_cell(panel, LV_GRID_ALIGN_STRETCH, grid_col, 2,
-                       LV_GRID_ALIGN_STRETCH, 0, 1);
-  lv_obj_add_flag(panel, LV_OBJ_FLAG_CLICKABLE);
-  lv_obj_add_event_cb(panel, data_panel_click_event_cb, LV_EVENT_CLICKED,
-                      (void *)SENSOR_TYPE_SHT30);
-
-  lv_obj_set_flex_flow(panel, LV_FLEX_FLOW_COLUMN);
-  lv_obj_set_flex_align(panel, LV_FLEX_ALIGN_SPACE_AROUND, LV_FLEX_ALIGN_CENTER,
-                        LV_FLEX_ALIGN_CENTER);
-
-  lv_obj_t *title_label = lv_label_create(panel);
-  lv_label_set_text(title_label, "温湿度");
-  lv_obj_set_style_text_font(title_label, &my_font_yahei_24, 0);
-
-  lv_obj_t *data_container = lv_obj_create(panel);
-  lv_obj_remove_style_all(data_container);
-  lv_obj_set_size(data_container, LV_PCT(100), LV_SIZE_CONTENT);
-  lv_obj_set_flex_flow(data_container, LV_FLEX_FLOW_ROW);
-  lv_obj_set_flex_align(data_container, LV_FLEX_ALIGN_SPACE_AROUND,
-                        LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-
-  /* 温度 */
-  lv_obj_t *temp_container = lv_obj_create(data_container);
-  lv_obj_remove_style_all(temp_container);
-  lv_obj_set_size(temp_container, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-  lv_obj_set_flex_flow(temp_container, LV_FLEX_FLOW_ROW);
-  lv_obj_set_flex_align(temp_container, LV_FLEX_ALIGN_CENTER,
-                        LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-  g_ui.temp_label = lv_label_create(temp_container);
-  lv_label_set_text(g_ui.temp_label, "--.-");
-  lv_obj_t *temp_unit = lv_label_create(temp_container);
-  lv_label_set_text(temp_unit, "℃");
-
-  /* 湿度 */
-  lv_obj_t *humi_container = lv_obj_create(data_container);
-  lv_obj_remove_style_all(humi_container);
-  lv_obj_set_size(humi_container, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-  lv_obj_set_flex_flow(humi_container, LV_FLEX_FLOW_ROW);
-  lv_obj_set_flex_align(humi_container, LV_FLEX_ALIGN_CENTER,
-                        LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-  g_ui.humi_label = lv_label_create(humi_container);
-  lv_label_set_text(g_ui.humi_label, "--.-");
-  lv_obj_t *humi_unit = lv_label_create(humi_container);
-  lv_label_set_text(humi_unit, "%RH");
-
-  lv_obj_set_style_text_font(g_ui.temp_label, &my_font_yahei_24, 0);
-  lv_obj_set_style_text_font(temp_unit, &my_font_yahei_24, 0);
-  lv_obj_set_style_text_font(g_ui.humi_label, &my_font_yahei_24, 0);
-  lv_obj_set_style_text_font(humi_unit, &my_font_yahei_24, 0);
+/* 首次使用时生成图集；分配失败时图集字体退化为直接使用基础字体 */
+static const lv_font_t *dashboard_value_font(void) {
+  if (!g_value_atlas_ready) {
+    ui_glyph_atlas_init(&g_value_atlas, &my_font_yahei_24, NULL);
+    g_value_atlas_ready = true;
+  }
+  return &g_value_atlas.font;
 }
 
-/* 创建单个数据面板 */
-static void create_single_data_panel(lv_obj_t *parent, int grid_col,
-                                     const char *title, const char *unit,
-                                     lv_obj_t **value_label,
-                                     SensorType_t sensor_type) {
-  lv_obj_t *panel = lv_obj_create(parent);
-  lv_obj_set_grid_cell(panel, LV_GRID_ALIGN_STRETCH, grid_col, 1,
+/* 创建数据卡片：点击进入对应传感器的详情页 */
+static void create_data_card(lv_obj_t *parent, int grid_col, int col_span,
+                             dash_card_t card, SensorType_t sensor_type) {
+  lv_obj_t *obj;
+
+  g_card_cfg[card].text_font = &my_font_yahei_24;
+  g_card_cfg[card].value_font = dashboard_value_font();
+  obj = ui_comp_card_create(parent, &g_ui.cards[card], &g_card_cfg[card]);
+  lv_obj_set_grid_cell(obj, LV_GRID_ALIGN_STRETCH, grid_col, col_span,
                        LV_GRID_ALIGN_STRETCH, 0, 1);
-  lv_obj_add_flag(panel, LV_OBJ_FLAG_CLICKABLE);
-  lv_obj_add_event_cb(panel, data_panel_click_event_cb, LV_EVENT_CLICKED,
+  lv_obj_add_flag(obj, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_event_cb(obj, data_panel_click_event_cb, LV_EVENT_CLICKED,
                       (void *)sensor_type);
-
-  lv_obj_t *title_label = lv_label_create(panel);
-  lv_label_set_text(title_label, title);
-  lv_obj_set_style_text_font(title_label, &my_font_yahei_24, 0);
-  lv_obj_align(title_label, LV_ALIGN_TOP_MID, 0, 5);
-
-  lv_obj_t *value_container = lv_obj_create(panel);
-  lv_obj_remove_style_all(value_container);
-  lv_obj_set_size(value_container, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-  lv_obj_set_flex_flow(value_container, LV_FLEX_FLOW_ROW);
-  lv_obj_set_flex_align(value_container, LV_FLEX_ALIGN_CENTER,
-                        LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
-  lv_obj_set_style_pad_gap(value_container, 5, 0);
-  lv_obj_align(value_container, LV_ALIGN_CENTER, 0, 10);
-
-  *value_label = lv_label_create(value_container);
-  lv_label_set_text(*value_label, "--");
-  lv_obj_set_style_text_font(*value_label, &my_font_yahei_24, 0);
-
-  lv_obj_t *unit_label = lv_label_create(value_container);
-  lv_label_set_text(unit_label, unit);
-  lv_obj_set_style_text_font(unit_label, &my_font_yahei_24, 0);
 }
 
 /* 创建 LED 控制面板 */
@@ -422,12 +390,13 @@ static void create_led_panel(lv_obj_t *parent, int grid_col, int grid_row) {
                       LV_EVENT_CLICKED, NULL);
 
   lv_obj_t *led_img = lv_img_create(g_ui.led_panel);
-  lv_img_set_src(led_img, &led_symbol);
+  lv_img_set_src(led_img, UI_ASSET_SRC(led_symbol));
   lv_obj_align(led_img, LV_ALIGN_CENTER, 0, -25);
 
   g_ui.led_indicator = lv_led_create(g_ui.led_panel);
   lv_led_set_color(g_ui.led_indicator, lv_palette_main(LV_PALETTE_RED));
   lv_led_off(g_ui.led_indicator);
+  ui_bind_led_init(&g_ui.led_bind, g_ui.led_indicator);
   lv_obj_set_size(g_ui.led_indicator, 30, 30);
   lv_obj_align(g_ui.led_indicator, LV_ALIGN_CENTER, 0, 0);
 
@@ -446,18 +415,18 @@ static void create_led_panel(lv_obj_t *parent, int grid_col, int grid_row) {
   lv_obj_align(btn_container, LV_ALIGN_BOTTOM_MID, 0, 0);
 
   g_ui.led_cycle_btn = lv_btn_create(btn_container);
-  lv_obj_set_style_pad_all(g_ui.led_cycle_btn, 8, 0);
+  lv_obj_add_style(g_ui.led_cycle_btn, ui_style(UI_STYLE_BTN), 0);
   lv_obj_t *cycle_label = lv_label_create(g_ui.led_cycle_btn);
   lv_label_set_text(cycle_label, "关闭");
-  lv_obj_set_style_text_font(cycle_label, &my_font_yahei_24, 0);
+  lv_obj_add_style(cycle_label, ui_style(UI_STYLE_TEXT_CN), 0);
   lv_obj_add_event_cb(g_ui.led_cycle_btn, led_cycle_btn_event_cb,
                       LV_EVENT_CLICKED, NULL);
 
   g_ui.led_mode_btn = lv_btn_create(btn_container);
-  lv_obj_set_style_pad_all(g_ui.led_mode_btn, 8, 0);
+  lv_obj_add_style(g_ui.led_mode_btn, ui_style(UI_STYLE_BTN), 0);
   lv_obj_t *mode_label = lv_label_create(g_ui.led_mode_btn);
   lv_label_set_text(mode_label, LV_SYMBOL_SETTINGS " 手动");
-  lv_obj_set_style_text_font(mode_label, &my_font_yahei_24, 0);
+  lv_obj_add_style(mode_label, ui_style(UI_STYLE_TEXT_CN), 0);
   lv_obj_add_event_cb(g_ui.led_mode_btn, led_mode_btn_event_cb,
                       LV_EVENT_CLICKED, NULL);
 }
@@ -491,8 +460,7 @@ static void create_gif_panel(lv_obj_t *parent, int grid_col, int grid_row) {
   lv_obj_set_grid_cell(panel, LV_GRID_ALIGN_STRETCH, grid_col, 1,
                        LV_GRID_ALIGN_STRETCH, grid_row, 1);
 
-  g_ui.gif_anim_obj = lv_gif_create(panel);
-  lv_gif_set_src(g_ui.gif_anim_obj, &mygif);
+  g_ui.gif_anim_obj = ui_comp_gif_create(panel, &mygif);
   lv_obj_set_size(g_ui.gif_anim_obj, 40, 40);
   lv_obj_align(g_ui.gif_anim_obj, LV_ALIGN_CENTER, 0, -10);
 
@@ -507,6 +475,28 @@ static void create_gif_panel(lv_obj_t *parent, int grid_col, int grid_row) {
                       NULL);
 }
 
+/* 分步构建设备控制区：LED -> 蜂鸣器 -> GIF (数据卡片在骨架中同步创建) */
+#define DASH_BUILD_STEPS 3
+
+static void dashboard_build_step(uint8_t step) {
+  switch (step) {
+  case 0:
+    create_led_panel(g_ui.ctrl_grid, 0, 0);
+    sync_led_controls_from_driver(true);
+    break;
+  case 1:
+    create_beep_panel(g_ui.ctrl_grid, 1, 0);
+    break;
+  default:
+    create_gif_panel(g_ui.ctrl_grid, 2, 0);
+    /* 无操作期间进入的屏幕，on_idle 调用时 GIF 还不存在 */
+    if (ui_get_idle_state() != UI_IDLE_ACTIVE) {
+      ui_comp_gif_set_active(g_ui.gif_anim_obj, false);
+    }
+    break;
+  }
+}
+
 /* -------------------- 对外接口 -------------------- */
 
 void ui_screen_dashboard_init(lv_obj_t *parent) {
@@ -521,8 +511,10 @@ void ui_screen_dashboard_init(lv_obj_t *parent) {
                                       .back_btn_cb = NULL,
                                       .custom_btn_cb = NULL,
                                       .user_data = NULL,
-                                      .show_time = true};
-  g_ui.header = ui_comp_header_create(parent, &header_config);
+                                      .show_time = true,
+                                      .title_long_press_cb =
+                                          title_long_press_event_cb};
+  g_ui.header = ui_comp_header_create(&header_config);
 
   /* 主内容区 */
   lv_obj_t *content_panel = lv_obj_create(parent);
@@ -530,52 +522,44 @@ void ui_screen_dashboard_init(lv_obj_t *parent) {
   lv_obj_set_flex_grow(content_panel, 1);
   lv_obj_set_width(content_panel, LV_PCT(100));
   lv_obj_set_flex_flow(content_panel, LV_FLEX_FLOW_COLUMN);
-  lv_obj_set_style_pad_all(content_panel, 10, 0);
-  lv_obj_set_style_pad_gap(content_panel, 10, 0);
+  lv_obj_add_style(content_panel, ui_style(UI_STYLE_CONTENT), 0);
 
   /* 数据显示区 */
   lv_obj_t *data_grid = lv_obj_create(content_panel);
   lv_obj_remove_style_all(data_grid);
   lv_obj_set_width(data_grid, LV_PCT(100));
   lv_obj_set_height(data_grid, LV_SIZE_CONTENT);
-  lv_obj_set_style_pad_gap(data_grid, 10, 0);
+  lv_obj_add_style(data_grid, ui_style(UI_STYLE_GAP), 0);
 
   static lv_coord_t data_col[] = {LV_GRID_FR(1), LV_GRID_FR(1), LV_GRID_FR(1),
                                   LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
   static lv_coord_t data_row[] = {LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
   lv_obj_set_grid_dsc_array(data_grid, data_col, data_row);
 
-  create_temp_humi_panel(data_grid, 0);
-  create_single_data_panel(data_grid, 2, "光照", "Lux", &g_ui.light_label,
-                           SENSOR_TYPE_GY30);
-  create_single_data_panel(data_grid, 3, "烟感", "PPM", &g_ui.smoke_label,
-                           SENSOR_TYPE_SMOKE);
+  create_data_card(data_grid, 0, 2, DASH_CARD_CLIMATE, SENSOR_TYPE_SHT30);
+  create_data_card(data_grid, 2, 1, DASH_CARD_LIGHT, SENSOR_TYPE_GY30);
+  create_data_card(data_grid, 3, 1, DASH_CARD_SMOKE, SENSOR_TYPE_SMOKE);
 
-  /* 设备控制区 */
+  /* 设备控制区：面板在之后的几次 lv_timer_handler 中加入 (见 ui_builder.h) */
   lv_obj_t *ctrl_grid = lv_obj_create(content_panel);
+  g_ui.ctrl_grid = ctrl_grid;
   lv_obj_remove_style_all(ctrl_grid);
   lv_obj_set_width(ctrl_grid, LV_PCT(100));
   lv_obj_set_flex_grow(ctrl_grid, 1);
-  lv_obj_set_style_pad_gap(ctrl_grid, 10, 0);
+  lv_obj_add_style(ctrl_grid, ui_style(UI_STYLE_GAP), 0);
 
   static lv_coord_t ctrl_col[] = {LV_GRID_FR(1), LV_GRID_FR(1), LV_GRID_FR(1),
                                   LV_GRID_TEMPLATE_LAST};
   static lv_coord_t ctrl_row[] = {LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
   lv_obj_set_grid_dsc_array(ctrl_grid, ctrl_col, ctrl_row);
 
-  create_led_panel(ctrl_grid, 0, 0);
-  create_beep_panel(ctrl_grid, 1, 0);
-  create_gif_panel(ctrl_grid, 2, 0);
-
-  /* 底部导航栏 */
-  ui_comp_navbar_create(parent, UI_SCREEN_DASHBOARD);
+  /* 底部导航栏 (常驻 lv_layer_top，屏幕容器已避开其区域) */
+  ui_comp_navbar_attach(UI_SCREEN_DASHBOARD);
 
-  /* 同步 LED 状态 */
-  sync_led_controls_from_driver();
+  /* 显示当前数据，后续刷新由 ui_screen_dashboard_on_sensor_event 驱动 */
+  dashboard_load_sensor_data(true);
 
-  /* 启动数据更新定时器 */
-  g_ui.data_update_timer = lv_timer_create(sensor_data_update_cb, 500, NULL);
-  lv_timer_set_repeat_count(g_ui.data_update_timer, -1);
+  ui_builder_start(parent, dashboard_build_step, DASH_BUILD_STEPS);
 }
 
 void ui_screen_dashboard_deinit(void) {
@@ -584,13 +568,48 @@ void ui_screen_dashboard_deinit(void) {
     g_ui.header = NULL;
   }
 
-  if (g_ui.data_update_timer) {
-    lv_timer_del(g_ui.data_update_timer);
-    g_ui.data_update_timer = NULL;
-  }
-
   if (g_ui.beep_once_timer) {
     lv_timer_del(g_ui.beep_once_timer);
     g_ui.beep_once_timer = NULL;
   }
 }
+
+/**
+ * @brief 暂停/恢复 GIF 帧定时器 (隐藏或无操作时不再逐帧解码)
+ */
+static void dashboard_set_gif_running(bool running) {
+  ui_comp_gif_set_active(g_ui.gif_anim_obj, running);
+}
+
+void ui_screen_dashboard_on_show(void) {
+  ui_comp_header_set_active(g_ui.header, true);
+  dashboard_set_gif_running(true);
+
+  /* 隐藏期间的快照没有分发到本屏幕，LED 也可能在详情页被修改 */
+  sync_led_controls_from_driver(true);
+  dashboard_load_sensor_data(false);
+}
+
+void ui_screen_dashboard_on_hide(void) {
+  ui_comp_header_set_active(g_ui.header, false);
+  dashboard_set_gif_running(false);
+}
+
+void ui_screen_dashboard_on_idle(bool idle) {
+  dashboard_set_gif_running(!idle);
+}
+
+void ui_screen_dashboard_on_sensor_event(const SensorSnapshot_t *snapshot) {
+  const SensorEvent_t *event = &snapshot->event;
+
+  if (event->sensor == (SensorHandle_t)event->sensor_type) {
+    dashboard_apply_anomaly(event->sensor_type, snapshot->anomaly);
+  }
+  if (event->event_type == SENSOR_EVENT_DATA_UPDATE) {
+    dashboard_apply_sensor_data(event->sensor_type, &event->data);
+  } else if (event->event_type == SENSOR_EVENT_STATUS_CHANGE &&
+             (event->status == SENSOR_STATUS_OFFLINE ||
+              event->status == SENSOR_STATUS_ERROR)) {
+    dashboard_apply_sensor_data(event->sensor_type, NULL);
+  }
+}
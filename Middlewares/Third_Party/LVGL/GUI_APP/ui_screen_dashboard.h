@@ -2,6 +2,7 @@
 #define __UI_SCREEN_DASHBOARD_H
 
 #include "lvgl.h"
+#include "sensor_task.h"
 
 /**
  * @brief ʼ̨ĻUI
@@ -14,4 +15,21 @@ void ui_screen_dashboard_init(lv_obj_t* parent);
  */
 void ui_screen_dashboard_deinit(void); 
 
+/**
+ * @brief Ļӻʾ / ؽ ( UI )
+ */
+void ui_screen_dashboard_on_show(void);
+void ui_screen_dashboard_on_hide(void);
+
+/**
+ * @brief /˳޲ ( UI )ͣ/ָ GIF 
+ */
+void ui_screen_dashboard_on_idle(bool idle);
+
+/**
+ * @brief գ UI  LVGL зַ
+ * @param snapshot 
+ */
+void ui_screen_dashboard_on_sensor_event(const SensorSnapshot_t* snapshot);
+
 #endif // __UI_SCREEN_DASHBOARD_H
@@ -11,13 +11,13 @@
 #include "ui_screen_devices_details.h"
 #include "devices_manager.h"
 #include "lvgl.h"
+#include "ui_builder.h"
+#include "ui_coalesce.h"
 #include "ui_comp_header.h"
 #include "ui_manager.h"
+#include "ui_styles.h"
 
 
-/* 字体声明（如需） */
-LV_FONT_DECLARE(my_font_yahei_24);
-
 /* UI 状态结构体 */
 typedef struct {
   lv_obj_t *r_slider[3];
@@ -28,6 +28,7 @@ typedef struct {
   lv_obj_t *b_value_label[3];
   lv_obj_t *brightness_slider;
   lv_obj_t *brightness_panel;
+  lv_obj_t *brightness_value_label;
 
   lv_obj_t *preview_led[3];
   lv_obj_t *slot_label[3];
@@ -36,6 +37,7 @@ typedef struct {
   lv_obj_t *content_panel;
   uint8_t current_editing_slot;
   bool is_auto_mode;
+  uint32_t state_version; /* 上次同步的设备状态版本 */
 } rgbled_details_ui_t;
 
 static rgbled_details_ui_t g_rgbled_ui;
@@ -43,6 +45,7 @@ static ui_header_t *g_header = NULL;
 
 /* 函数声明（按实现顺序） */
 static void set_led_border_smart(lv_obj_t *led, RGB_Color color);
+static void show_led_preview(uint8_t slot, RGB_Color color, bool is_active);
 static void update_led_display(uint8_t slot, bool is_active);
 static void refresh_ui_for_mode(void);
 static void led_click_event_cb(lv_event_t *e);
@@ -55,7 +58,10 @@ static void back_btn_event_cb(lv_event_t *e);
 static void slot_panel_click_event_cb(lv_event_t *e);
 static void mode_switch_btn_event_cb(lv_event_t *e);
 static void create_rgb_slider_group(lv_obj_t *parent, uint8_t slot_index);
-static void init_ui_from_driver_state(void);
+static void create_slot_controls(uint8_t slot_index);
+static void create_brightness_controls(void);
+static void init_ui_from_driver_state(bool force);
+static void rgbled_build_step(uint8_t step);
 static void create_rgbled_details_ui(lv_obj_t *parent);
 
 /* -------------------- 帮助函数 -------------------- */
@@ -70,17 +76,11 @@ static void set_led_border_smart(lv_obj_t *led, RGB_Color color) {
   }
 }
 
-/* 更新单个槽位的预览显示
+/* 以给定颜色显示单个槽位的预览
    - 背景色显示槽位颜色（始终）
    - 高光（白色）表示该槽位为当前激活槽位 */
-static void update_led_display(uint8_t slot, bool is_active) {
-  if (slot < 1 || slot > 3)
-    return;
+static void show_led_preview(uint8_t slot, RGB_Color color, bool is_active) {
   lv_obj_t *led = g_rgbled_ui.preview_led[slot - 1];
-  RGB_Color color;
-  if (!Drivers_RGBLED_GetSlotColor(slot, &color)) {
-    return;
-  }
 
   /* 背景色：显示槽位颜色 */
   lv_obj_set_style_bg_color(led, lv_color_make(color.R, color.G, color.B),
@@ -100,6 +100,17 @@ static void update_led_display(uint8_t slot, bool is_active) {
   }
 }
 
+/* 更新单个槽位的预览显示（颜色取自驱动层） */
+static void update_led_display(uint8_t slot, bool is_active) {
+  RGB_Color color;
+
+  if (slot < 1 || slot > 3)
+    return;
+  if (Drivers_RGBLED_GetSlotColor(slot, &color)) {
+    show_led_preview(slot, color, is_active);
+  }
+}
+
 /* -------------------- 事件回调 -------------------- */
 
 /* LED 预览点击事件：切换激活槽位或关闭物理 LED */
@@ -108,6 +119,9 @@ static void led_click_event_cb(lv_event_t *e) {
   if (slot < 1 || slot > 3)
     return;
 
+  /* 以下会用到全部槽位的控件，分步构建未完成时先建完 */
+  ui_builder_finish(NULL);
+
   /* 只在手动模式下生效 */
   if (g_rgbled_ui.is_auto_mode) {
     return;
@@ -155,7 +169,8 @@ static void led_click_event_cb(lv_event_t *e) {
   }
 }
 
-/* RGB 滑块：改变槽位颜色（只改变槽位颜色与背景，按当前激活槽位更新物理灯） */
+/* RGB 滑块：改变槽位颜色（只改变槽位颜色与背景，按当前激活槽位更新物理灯）
+   拖动时按帧合并调用 (见 ui_coalesce.h)，数值标签仍逐次更新 */
 static void rgb_slider_event_cb(lv_event_t *e) {
   lv_obj_t *slider = lv_event_get_target(e);
   uint32_t data = (uint32_t)(intptr_t)lv_event_get_user_data(e);
@@ -218,6 +233,8 @@ static void brightness_value_update_cb(lv_event_t *e) {
 
 /* 重置按钮（恢复驱动层默认并刷新 UI） */
 static void reset_btn_event_cb(lv_event_t *e) {
+  ui_builder_finish(NULL);
+
   // 如果为手动模式
   if (!g_rgbled_ui.is_auto_mode) {
     Drivers_RGBLED_ResetSlotColors();
@@ -286,6 +303,7 @@ static void slot_panel_click_event_cb(lv_event_t *e) {
   if (slot < 1 || slot > 3)
     return;
 
+  ui_builder_finish(NULL);
   g_rgbled_ui.current_editing_slot = slot;
 
   for (uint8_t i = 0; i < 3; i++) {
@@ -312,6 +330,8 @@ static void slot_panel_click_event_cb(lv_event_t *e) {
 
 /* 模式切换（自动 <-> 手动） */
 static void mode_switch_btn_event_cb(lv_event_t *e) {
+  ui_builder_finish(NULL);
+
   led_control_mode_t current_mode = Drivers_RGBLED_GetMode();
   if (current_mode == LED_MODE_MANUAL) {
     Drivers_RGBLED_SetMode(LED_MODE_AUTO);
@@ -361,8 +381,8 @@ static void create_rgb_slider_group(lv_obj_t *parent, uint8_t slot_index) {
   lv_obj_set_style_bg_color(g_rgbled_ui.r_slider[slot_index],
                             lv_color_hex(0xFF0000), LV_PART_INDICATOR);
   uint32_t r_data = (slot_index << 8) | 0;
-  lv_obj_add_event_cb(g_rgbled_ui.r_slider[slot_index], rgb_slider_event_cb,
-                      LV_EVENT_VALUE_CHANGED, (void *)(intptr_t)r_data);
+  ui_coalesce_add_event_cb(g_rgbled_ui.r_slider[slot_index],
+                           rgb_slider_event_cb, (void *)(intptr_t)r_data);
 
   g_rgbled_ui.r_value_label[slot_index] = lv_label_create(r_container);
   lv_label_set_text_fmt(g_rgbled_ui.r_value_label[slot_index], "%d", color.R);
@@ -393,8 +413,8 @@ static void create_rgb_slider_group(lv_obj_t *parent, uint8_t slot_index) {
   lv_obj_set_style_bg_color(g_rgbled_ui.g_slider[slot_index],
                             lv_color_hex(0x00FF00), LV_PART_INDICATOR);
   uint32_t g_data = (slot_index << 8) | 1;
-  lv_obj_add_event_cb(g_rgbled_ui.g_slider[slot_index], rgb_slider_event_cb,
-                      LV_EVENT_VALUE_CHANGED, (void *)(intptr_t)g_data);
+  ui_coalesce_add_event_cb(g_rgbled_ui.g_slider[slot_index],
+                           rgb_slider_event_cb, (void *)(intptr_t)g_data);
 
   g_rgbled_ui.g_value_label[slot_index] = lv_label_create(g_container);
   lv_label_set_text_fmt(g_rgbled_ui.g_value_label[slot_index], "%d", color.G);
@@ -425,8 +445,8 @@ static void create_rgb_slider_group(lv_obj_t *parent, uint8_t slot_index) {
   lv_obj_set_style_bg_color(g_rgbled_ui.b_slider[slot_index],
                             lv_color_hex(0x0000FF), LV_PART_INDICATOR);
   uint32_t b_data = (slot_index << 8) | 2;
-  lv_obj_add_event_cb(g_rgbled_ui.b_slider[slot_index], rgb_slider_event_cb,
-                      LV_EVENT_VALUE_CHANGED, (void *)(intptr_t)b_data);
+  ui_coalesce_add_event_cb(g_rgbled_ui.b_slider[slot_index],
+                           rgb_slider_event_cb, (void *)(intptr_t)b_data);
 
   g_rgbled_ui.b_value_label[slot_index] = lv_label_create(b_container);
   lv_label_set_text_fmt(g_rgbled_ui.b_value_label[slot_index], "%d", color.B);
@@ -453,17 +473,23 @@ static void refresh_ui_for_mode(void) {
   }
 }
 
-/* 初始化 UI（从驱动层读取状态并同步） */
-static void init_ui_from_driver_state(void) {
-  led_control_mode_t mode = Drivers_RGBLED_GetMode();
-  g_rgbled_ui.is_auto_mode = (mode == LED_MODE_AUTO);
+/* 初始化 UI（从驱动层读取一份状态快照并同步）
+ * force 为 false 且状态版本未变化时跳过，返回页面时不重复设置控件 */
+static void init_ui_from_driver_state(bool force) {
+  Drivers_State_t state;
+
+  if (!force && Drivers_GetStateVersion() == g_rgbled_ui.state_version) {
+    return;
+  }
+  g_rgbled_ui.state_version = Drivers_GetState(&state);
+
+  g_rgbled_ui.is_auto_mode = (state.led_mode == LED_MODE_AUTO);
 
   refresh_ui_for_mode();
 
   uint8_t active_slot = 1;
-  if (mode == LED_MODE_MANUAL) {
-    led_manual_state_t s = Drivers_RGBLED_GetManualState();
-    switch (s) {
+  if (state.led_mode == LED_MODE_MANUAL) {
+    switch (state.led_manual_state) {
     case LED_STATE_SLOT_1:
       active_slot = 1;
       break;
@@ -483,9 +509,7 @@ static void init_ui_from_driver_state(void) {
   }
 
   for (uint8_t i = 0; i < 3; i++) {
-    RGB_Color color;
-    if (!Drivers_RGBLED_GetSlotColor(i + 1, &color))
-      continue;
+    RGB_Color color = state.led_slots[i];
 
     lv_slider_set_value(g_rgbled_ui.r_slider[i], color.R, LV_ANIM_OFF);
     lv_slider_set_value(g_rgbled_ui.g_slider[i], color.G, LV_ANIM_OFF);
@@ -511,13 +535,90 @@ static void init_ui_from_driver_state(void) {
       lv_obj_clear_state(g_rgbled_ui.slot_label[i], LV_STATE_FOCUSED);
     }
 
-    update_led_display(i + 1, is_active);
+    show_led_preview(i + 1, color, is_active);
   }
 
+  /* 亮度滑块显示用户设置的亮度 */
+  lv_slider_set_value(g_rgbled_ui.brightness_slider, state.led_brightness,
+                      LV_ANIM_OFF);
+  lv_label_set_text_fmt(g_rgbled_ui.brightness_value_label, "%d",
+                        state.led_brightness);
+
   g_rgbled_ui.current_editing_slot = active_slot;
 }
 
-/* 主界面创建 */
+/* 单个槽位的预览 LED、分隔线与 RGB 滑块组 (分步构建，每个槽位一步) */
+static void create_slot_controls(uint8_t slot_index) {
+  lv_obj_t *panel = g_rgbled_ui.slot_panel[slot_index];
+
+  g_rgbled_ui.preview_led[slot_index] = lv_led_create(panel);
+  lv_obj_t *led = g_rgbled_ui.preview_led[slot_index];
+  lv_obj_set_size(led, 55, 55);
+  lv_obj_set_style_border_width(led, 3, 0);
+  lv_obj_set_style_border_opa(led, LV_OPA_100, 0);
+
+  /* [NEW] 调整高光扩散范围（默认 LV_LED_BRIGHT_MAX = 2） */
+  lv_obj_set_style_shadow_spread(led, 8,
+                                 LV_PART_MAIN); // 范围：0-20，越大越扩散
+  lv_obj_set_style_shadow_width(led, 15, LV_PART_MAIN); // 阴影宽度
+
+  lv_obj_add_flag(led, LV_OBJ_FLAG_CLICKABLE);
+  lv_obj_add_event_cb(led, led_click_event_cb, LV_EVENT_CLICKED,
+                      (void *)(intptr_t)(slot_index + 1));
+
+  RGB_Color color;
+  if (Drivers_RGBLED_GetSlotColor(slot_index + 1, &color)) {
+    lv_obj_set_style_bg_color(led, lv_color_make(color.R, color.G, color.B),
+                              LV_PART_MAIN);
+    lv_obj_set_style_bg_opa(led, LV_OPA_COVER, LV_PART_MAIN);
+    set_led_border_smart(led, color);
+    lv_led_off(led);
+  }
+
+  lv_obj_t *separator = lv_obj_create(panel);
+  lv_obj_remove_style_all(separator);
+  lv_obj_set_size(separator, LV_PCT(80), 2);
+  lv_obj_set_style_bg_color(separator, lv_color_hex(0xCCCCCC), 0);
+  lv_obj_set_style_bg_opa(separator, LV_OPA_50, 0);
+
+  create_rgb_slider_group(panel, slot_index);
+}
+
+/* 亮度滑块与数值 (分步构建) */
+static void create_brightness_controls(void) {
+  g_rgbled_ui.brightness_slider =
+      lv_slider_create(g_rgbled_ui.brightness_panel);
+  lv_obj_set_size(g_rgbled_ui.brightness_slider, 320, 20);
+  lv_slider_set_range(g_rgbled_ui.brightness_slider, 0, 255);
+  lv_slider_set_value(g_rgbled_ui.brightness_slider, 255, LV_ANIM_OFF);
+  ui_coalesce_add_event_cb(g_rgbled_ui.brightness_slider,
+                           brightness_slider_event_cb, NULL);
+
+  lv_obj_t *brightness_value_label =
+      lv_label_create(g_rgbled_ui.brightness_panel);
+  g_rgbled_ui.brightness_value_label = brightness_value_label;
+  lv_label_set_text(brightness_value_label, "255");
+  lv_obj_add_style(brightness_value_label, ui_style(UI_STYLE_TEXT_CN), 0);
+  lv_obj_set_width(brightness_value_label, 50);
+  lv_obj_add_event_cb(g_rgbled_ui.brightness_slider, brightness_value_update_cb,
+                      LV_EVENT_VALUE_CHANGED, brightness_value_label);
+}
+
+/* 分步构建：3 个槽位 -> 亮度 -> 按驱动状态同步 */
+#define RGBLED_BUILD_STEPS 5
+
+static void rgbled_build_step(uint8_t step) {
+  if (step < 3) {
+    create_slot_controls(step);
+  } else if (step == 3) {
+    create_brightness_controls();
+  } else {
+    init_ui_from_driver_state(true);
+  }
+}
+
+/* 主界面创建：同步创建骨架 (顶部栏、模式按钮、槽位面板与标题、亮度面板)，
+ * 预览 LED 与滑块在之后的几次 lv_timer_handler 中逐个加入 (见 ui_builder.h) */
 static void create_rgbled_details_ui(lv_obj_t *parent) {
   memset(&g_rgbled_ui, 0, sizeof(rgbled_details_ui_t));
   g_rgbled_ui.current_editing_slot = 1;
@@ -539,7 +640,7 @@ static void create_rgbled_details_ui(lv_obj_t *parent) {
                                       .custom_btn_cb = reset_btn_event_cb,
                                       .user_data = NULL,
                                       .show_time = true};
-  g_header = ui_comp_header_create(parent, &header_config);
+  g_header = ui_comp_header_create(&header_config);
 
   /* 模式切换按钮 */
   lv_obj_t *mode_btn_container = lv_obj_create(parent);
@@ -559,7 +660,7 @@ static void create_rgbled_details_ui(lv_obj_t *parent) {
     lv_label_set_text(mode_btn_label, LV_SYMBOL_REFRESH " 自动模式");
   else
     lv_label_set_text(mode_btn_label, LV_SYMBOL_SETTINGS " 手动模式");
-  lv_obj_set_style_text_font(mode_btn_label, &my_font_yahei_24, 0);
+  lv_obj_add_style(mode_btn_label, ui_style(UI_STYLE_TEXT_CN), 0);
   lv_obj_center(mode_btn_label);
   lv_obj_add_event_cb(g_rgbled_ui.mode_switch_btn, mode_switch_btn_event_cb,
                       LV_EVENT_CLICKED, NULL);
@@ -592,41 +693,7 @@ static void create_rgbled_details_ui(lv_obj_t *parent) {
 
     g_rgbled_ui.slot_label[i] = lv_label_create(g_rgbled_ui.slot_panel[i]);
     lv_label_set_text(g_rgbled_ui.slot_label[i], slot_names[i]);
-    lv_obj_set_style_text_font(g_rgbled_ui.slot_label[i], &my_font_yahei_24, 0);
-
-    g_rgbled_ui.preview_led[i] = lv_led_create(g_rgbled_ui.slot_panel[i]);
-    lv_obj_set_size(g_rgbled_ui.preview_led[i], 55, 55);
-    lv_obj_set_style_border_width(g_rgbled_ui.preview_led[i], 3, 0);
-    lv_obj_set_style_border_opa(g_rgbled_ui.preview_led[i], LV_OPA_100, 0);
-
-    /* [NEW] 调整高光扩散范围（默认 LV_LED_BRIGHT_MAX = 2） */
-    lv_obj_set_style_shadow_spread(g_rgbled_ui.preview_led[i], 8,
-                                   LV_PART_MAIN); // 范围：0-20，越大越扩散
-    lv_obj_set_style_shadow_width(g_rgbled_ui.preview_led[i], 15,
-                                  LV_PART_MAIN); // 阴影宽度
-
-    lv_obj_add_flag(g_rgbled_ui.preview_led[i], LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_add_event_cb(g_rgbled_ui.preview_led[i], led_click_event_cb,
-                        LV_EVENT_CLICKED, (void *)(intptr_t)(i + 1));
-
-    RGB_Color color;
-    if (Drivers_RGBLED_GetSlotColor(i + 1, &color)) {
-      lv_obj_set_style_bg_color(g_rgbled_ui.preview_led[i],
-                                lv_color_make(color.R, color.G, color.B),
-                                LV_PART_MAIN);
-      lv_obj_set_style_bg_opa(g_rgbled_ui.preview_led[i], LV_OPA_COVER,
-                              LV_PART_MAIN);
-      set_led_border_smart(g_rgbled_ui.preview_led[i], color);
-      lv_led_off(g_rgbled_ui.preview_led[i]);
-    }
-
-    lv_obj_t *separator = lv_obj_create(g_rgbled_ui.slot_panel[i]);
-    lv_obj_remove_style_all(separator);
-    lv_obj_set_size(separator, LV_PCT(80), 2);
-    lv_obj_set_style_bg_color(separator, lv_color_hex(0xCCCCCC), 0);
-    lv_obj_set_style_bg_opa(separator, LV_OPA_50, 0);
-
-    create_rgb_slider_group(g_rgbled_ui.slot_panel[i], i);
+    lv_obj_add_style(g_rgbled_ui.slot_label[i], ui_style(UI_STYLE_TEXT_CN), 0);
   }
 
   /* 亮度面板 */
@@ -641,26 +708,10 @@ static void create_rgbled_details_ui(lv_obj_t *parent) {
 
   lv_obj_t *brightness_icon = lv_label_create(g_rgbled_ui.brightness_panel);
   lv_label_set_text(brightness_icon, LV_SYMBOL_EYE_OPEN " 亮度调节: ");
-  lv_obj_set_style_text_font(brightness_icon, &my_font_yahei_24, 0);
-
-  g_rgbled_ui.brightness_slider =
-      lv_slider_create(g_rgbled_ui.brightness_panel);
-  lv_obj_set_size(g_rgbled_ui.brightness_slider, 320, 20);
-  lv_slider_set_range(g_rgbled_ui.brightness_slider, 0, 255);
-  lv_slider_set_value(g_rgbled_ui.brightness_slider, 255, LV_ANIM_OFF);
-  lv_obj_add_event_cb(g_rgbled_ui.brightness_slider, brightness_slider_event_cb,
-                      LV_EVENT_VALUE_CHANGED, NULL);
-
-  lv_obj_t *brightness_value_label =
-      lv_label_create(g_rgbled_ui.brightness_panel);
-  lv_label_set_text(brightness_value_label, "255");
-  lv_obj_set_style_text_font(brightness_value_label, &my_font_yahei_24, 0);
-  lv_obj_set_width(brightness_value_label, 50);
-  lv_obj_add_event_cb(g_rgbled_ui.brightness_slider, brightness_value_update_cb,
-                      LV_EVENT_VALUE_CHANGED, brightness_value_label);
+  lv_obj_add_style(brightness_icon, ui_style(UI_STYLE_TEXT_CN), 0);
 
   refresh_ui_for_mode();
-  init_ui_from_driver_state();
+  ui_builder_start(parent, rgbled_build_step, RGBLED_BUILD_STEPS);
 }
 
 /* -------------------- 对外接口 -------------------- */
@@ -680,3 +731,16 @@ void ui_screen_devices_details_deinit(void) {
     g_header = NULL;
   }
 }
+
+void ui_screen_devices_details_on_show(void) {
+  ui_comp_header_set_active(g_header, true);
+  if (g_rgbled_ui.brightness_slider) {
+    init_ui_from_driver_state(false);
+  }
+}
+
+void ui_screen_devices_details_on_hide(void) {
+  ui_comp_header_set_active(g_header, false);
+  /* 离开页面时不等待空闲时间，尽快写入修改过的设置 */
+  Drivers_Settings_Commit();
+}
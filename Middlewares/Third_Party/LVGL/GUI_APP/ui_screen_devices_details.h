@@ -40,6 +40,13 @@ void ui_screen_devices_details_init(lv_obj_t* parent, DeviceType_t device_type);
  */
 void ui_screen_devices_details_deinit(void);
 
+/**
+ * @brief 屏幕从缓存中重新显示 / 被隐藏进缓存 (由 UI 管理器调用)
+ * @note  隐藏期间可能在别处修改了设备状态，显示时重新同步
+ */
+void ui_screen_devices_details_on_show(void);
+void ui_screen_devices_details_on_hide(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,298 @@
+/**
+ ******************************************************************************
+ * @file    ui_screen_diagnostics.c
+ * @brief   系统诊断页面模块
+ * @details 显示 SysMonitor 快照：总 CPU 负载、heap_4 当前/历史最小空闲堆，
+ *          指标注册表中各直方图的分位数，
+ *          以及各任务的 CPU 占用、栈剩余与优先级。页面不在导航栏中，
+ *          通过长按主页顶部栏标题进入。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_screen_diagnostics.h"
+#include "frame_stats.h"
+#include "metrics.h"
+#include "sys_monitor.h"
+#include "task_plan.h"
+#include "ui_comp_header.h"
+#include "ui_layout.h"
+#include "ui_manager.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DIAG_UPDATE_PERIOD_MS 1000
+#define DIAG_TABLE_COLS 5
+
+/**
+ * @brief 诊断页面UI控件集合
+ */
+typedef struct {
+  ui_header_t *header;      // 顶部栏组件句柄
+  lv_obj_t *summary_label;  // CPU / 堆汇总
+  lv_obj_t *frame_label;    // LVGL 帧统计
+  lv_obj_t *locks_label;    // 互斥锁争用
+  lv_obj_t *metrics_label;  // 指标直方图分位数
+  lv_obj_t *heap_bar;       // 堆使用率
+  lv_obj_t *task_table;     // 任务统计表
+  lv_timer_t *update_timer; // 数据更新定时器
+  uint32_t last_timestamp;  // 已显示快照的采样时刻
+} diagnostics_ui_t;
+
+static diagnostics_ui_t g_diag_ui;
+
+/* -----------------------------------------------------------
+ * 布局描述
+ * ----------------------------------------------------------- */
+enum {
+  DIAG_NODE_CONTENT = 0, // 内容区
+  DIAG_NODE_SUMMARY,     // CPU / 堆汇总
+  DIAG_NODE_FRAME,       // LVGL 帧统计
+  DIAG_NODE_LOCKS,       // 互斥锁争用
+  DIAG_NODE_METRICS,     // 指标直方图分位数
+  DIAG_NODE_HEAP_BAR,    // 堆使用率 (默认范围 0~100)
+  DIAG_NODE_TABLE,       // 任务统计表
+  DIAG_NODE_COUNT
+};
+
+static const ui_layout_node_t s_diag_layout[DIAG_NODE_COUNT] = {
+    [DIAG_NODE_CONTENT] = {.type = UI_LAYOUT_OBJ,
+                           .style = UI_LAYOUT_STYLE(UI_STYLE_CONTENT),
+                           .flags = UI_LAYOUT_F_BARE | UI_LAYOUT_F_GROW |
+                                    UI_LAYOUT_F_COLUMN,
+                           .w = LV_PCT(100)},
+    [DIAG_NODE_SUMMARY] = {.type = UI_LAYOUT_LABEL,
+                           .parent = UI_LAYOUT_REF(DIAG_NODE_CONTENT),
+                           .style = UI_LAYOUT_STYLE(UI_STYLE_TEXT_16),
+                           .text = "--"},
+    [DIAG_NODE_FRAME] = {.type = UI_LAYOUT_LABEL,
+                         .parent = UI_LAYOUT_REF(DIAG_NODE_CONTENT),
+                         .style = UI_LAYOUT_STYLE(UI_STYLE_TEXT_14),
+                         .text = "--"},
+    [DIAG_NODE_LOCKS] = {.type = UI_LAYOUT_LABEL,
+                         .parent = UI_LAYOUT_REF(DIAG_NODE_CONTENT),
+                         .style = UI_LAYOUT_STYLE(UI_STYLE_TEXT_14),
+                         .w = LV_PCT(100),
+                         .text = "--"},
+    [DIAG_NODE_METRICS] = {.type = UI_LAYOUT_LABEL,
+                           .parent = UI_LAYOUT_REF(DIAG_NODE_CONTENT),
+                           .style = UI_LAYOUT_STYLE(UI_STYLE_TEXT_14),
+                           .w = LV_PCT(100),
+                           .text = "--"},
+    [DIAG_NODE_HEAP_BAR] = {.type = UI_LAYOUT_BAR,
+                            .parent = UI_LAYOUT_REF(DIAG_NODE_CONTENT),
+                            .w = LV_PCT(100),
+                            .h = 12},
+    [DIAG_NODE_TABLE] = {.type = UI_LAYOUT_TABLE,
+                         .parent = UI_LAYOUT_REF(DIAG_NODE_CONTENT),
+                         .style = UI_LAYOUT_STYLE(UI_STYLE_TABLE_CELL),
+                         .part = UI_LAYOUT_PART(LV_PART_ITEMS),
+                         .flags = UI_LAYOUT_F_GROW,
+                         .w = LV_PCT(100)},
+};
+
+/* -----------------------------------------------------------
+ * 前向声明
+ * ----------------------------------------------------------- */
+static void back_btn_event_cb(lv_event_t *e);
+static void diagnostics_update_timer_cb(lv_timer_t *timer);
+
+/* -----------------------------------------------------------
+ * 回调函数实现
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 返回按钮事件回调
+ */
+static void back_btn_event_cb(lv_event_t *e) {
+  (void)e;
+  ui_load_previous_screen();
+}
+
+/**
+ * @brief 刷新互斥锁争用：每个锁的等待次数 / 最长等待 / 平均持有 (us)
+ */
+static void diagnostics_update_locks(void) {
+  static char buf[384];
+  TaskPlan_MutexStats_t st;
+  int len = snprintf(buf, sizeof(buf), "Locks wait n/max us, hold avg us:");
+
+  for (uint8_t i = 0; TaskPlan_GetMutexStats(i, &st) && len > 0 &&
+                      (size_t)len < sizeof(buf);
+       i++) {
+    if (st.takes == 0) {
+      continue;
+    }
+    len += snprintf(buf + len, sizeof(buf) - (size_t)len,
+                    "   %s %lu/%lu %lu%s", st.name != NULL ? st.name : "?",
+                    (unsigned long)st.waits, (unsigned long)st.max_wait_us,
+                    (unsigned long)(st.hold_total_us / st.takes),
+                    st.timeouts != 0 ? " T" : "");
+  }
+  lv_label_set_text(g_diag_ui.locks_label, buf);
+}
+
+/**
+ * @brief 刷新指标直方图：上电以来的 p50 / p99 / 最大值
+ */
+static void diagnostics_update_metrics(void) {
+  static char buf[320];
+  MetricSnapshot_t snap;
+  int len = snprintf(buf, sizeof(buf), "Metrics p50/p99/max:");
+
+  for (int id = 0; id < METRIC_HIST_COUNT && len > 0 &&
+                   (size_t)len < sizeof(buf);
+       id++) {
+    if (!Metrics_Read((MetricId_t)id, &snap) || snap.value == 0) {
+      continue;
+    }
+    len += snprintf(buf + len, sizeof(buf) - (size_t)len,
+                    "   %s %lu/%lu/%lu %s", snap.name,
+                    (unsigned long)Metrics_Percentile(&snap, 50),
+                    (unsigned long)Metrics_Percentile(&snap, 99),
+                    (unsigned long)snap.max, snap.unit);
+  }
+  lv_label_set_text(g_diag_ui.metrics_label, buf);
+}
+
+/**
+ * @brief 定时器回调，快照更新后才重绘表格
+ */
+static void diagnostics_update_timer_cb(lv_timer_t *timer) {
+  (void)timer;
+  static SysMonitor_Snapshot_t snap; // 约 300 字节，避免占用 LVGL 任务栈
+  FrameStats_t fs;
+
+  if (FrameStats_Get(&fs)) {
+    lv_label_set_text_fmt(
+        g_diag_ui.frame_label,
+        "LVGL %u.%u Hz   render %lu us (max %lu)   wait %lu us   flush %lu us"
+        "   %lu px   idle %u.%u%%\n"
+        "Cache hit/miss   img %lu/%lu (total %lu/%lu)"
+        "   shadow %lu/%lu (total %lu/%lu)",
+        fs.refr_rate_x10 / 10, fs.refr_rate_x10 % 10,
+        (unsigned long)fs.render_us_avg, (unsigned long)fs.render_us_max,
+        (unsigned long)fs.wait_us_avg, (unsigned long)fs.flush_us_avg,
+        (unsigned long)fs.px_avg, fs.idle_permille / 10,
+        fs.idle_permille % 10,
+        (unsigned long)fs.cache_hit[FRAME_STATS_CACHE_IMG],
+        (unsigned long)fs.cache_miss[FRAME_STATS_CACHE_IMG],
+        (unsigned long)fs.cache_hit_total[FRAME_STATS_CACHE_IMG],
+        (unsigned long)fs.cache_miss_total[FRAME_STATS_CACHE_IMG],
+        (unsigned long)fs.cache_hit[FRAME_STATS_CACHE_SHADOW],
+        (unsigned long)fs.cache_miss[FRAME_STATS_CACHE_SHADOW],
+        (unsigned long)fs.cache_hit_total[FRAME_STATS_CACHE_SHADOW],
+        (unsigned long)fs.cache_miss_total[FRAME_STATS_CACHE_SHADOW]);
+  }
+  diagnostics_update_locks();
+  diagnostics_update_metrics();
+
+  if (!SysMonitor_GetSnapshot(&snap)) {
+    lv_label_set_text(g_diag_ui.summary_label, "Waiting for first sample...");
+    return;
+  }
+  if (snap.timestamp == g_diag_ui.last_timestamp)
+    return;
+  g_diag_ui.last_timestamp = snap.timestamp;
+
+  size_t used = snap.heap_total - snap.heap_free;
+  const SysMonitor_GuiHeap_t *g = &snap.gui_heap;
+  lv_label_set_text_fmt(
+      g_diag_ui.summary_label,
+      "CPU %u.%u%%   Heap used %u / %u B   Free %u B   Min ever %u B\n"
+      "LVGL mem used %lu / %lu B   Peak %lu B   Biggest free %lu B   "
+      "Frag %u%%\n"
+      "VDDA %u mV   Die %d C",
+      snap.cpu_load_permille / 10, snap.cpu_load_permille % 10,
+      (unsigned)used, (unsigned)snap.heap_total, (unsigned)snap.heap_free,
+      (unsigned)snap.heap_min_free, (unsigned long)(g->total - g->free),
+      (unsigned long)g->total, (unsigned long)g->max_used,
+      (unsigned long)g->biggest_free, g->frag_pct, snap.vdda_mv,
+      snap.die_temp_c10 / 10);
+  lv_bar_set_value(g_diag_ui.heap_bar,
+                   (int32_t)(used * 100u / snap.heap_total), LV_ANIM_OFF);
+
+  lv_table_set_row_cnt(g_diag_ui.task_table, snap.task_count + 1);
+  for (uint8_t i = 0; i < snap.task_count; i++) {
+    const SysMonitor_Task_t *t = &snap.tasks[i];
+    uint16_t row = i + 1;
+    lv_table_set_cell_value(g_diag_ui.task_table, row, 0, t->name);
+    lv_table_set_cell_value_fmt(g_diag_ui.task_table, row, 1, "%c", t->state);
+    lv_table_set_cell_value_fmt(g_diag_ui.task_table, row, 2, "%u.%u%%",
+                                t->cpu_permille / 10, t->cpu_permille % 10);
+    lv_table_set_cell_value_fmt(g_diag_ui.task_table, row, 3, "%u B",
+                                t->stack_free_words * 4u);
+    lv_table_set_cell_value_fmt(g_diag_ui.task_table, row, 4, "%u",
+                                t->priority);
+  }
+}
+
+/* -----------------------------------------------------------
+ * 界面初始化与反初始化
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 初始化系统诊断屏幕
+ */
+void ui_screen_diagnostics_init(lv_obj_t *parent) {
+  static const char *const col_titles[DIAG_TABLE_COLS] = {
+      "Task", "State", "CPU", "Stack free", "Prio"};
+  static const uint8_t col_pct[DIAG_TABLE_COLS] = {32, 12, 18, 24, 14};
+
+  memset(&g_diag_ui, 0, sizeof(diagnostics_ui_t));
+  lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_COLUMN);
+
+  /* === 1. 顶部栏 === */
+  ui_header_config_t header_config = {.title = "System Diagnostics",
+                                      .show_back_btn = true,
+                                      .show_custom_btn = false,
+                                      .custom_btn_text = NULL,
+                                      .back_btn_cb = back_btn_event_cb,
+                                      .custom_btn_cb = NULL,
+                                      .user_data = NULL,
+                                      .show_time = true};
+  g_diag_ui.header = ui_comp_header_create(&header_config);
+
+  /* === 2. 内容区 === */
+  lv_obj_t *objs[DIAG_NODE_COUNT];
+  ui_layout_build(parent, s_diag_layout, DIAG_NODE_COUNT, objs);
+  g_diag_ui.summary_label = objs[DIAG_NODE_SUMMARY];
+  g_diag_ui.frame_label = objs[DIAG_NODE_FRAME];
+  g_diag_ui.locks_label = objs[DIAG_NODE_LOCKS];
+  g_diag_ui.metrics_label = objs[DIAG_NODE_METRICS];
+  g_diag_ui.heap_bar = objs[DIAG_NODE_HEAP_BAR];
+  g_diag_ui.task_table = objs[DIAG_NODE_TABLE];
+  lv_obj_update_layout(objs[DIAG_NODE_CONTENT]);
+
+  lv_coord_t table_w = lv_obj_get_content_width(g_diag_ui.task_table);
+  lv_table_set_col_cnt(g_diag_ui.task_table, DIAG_TABLE_COLS);
+  lv_table_set_row_cnt(g_diag_ui.task_table, 1);
+  for (uint16_t c = 0; c < DIAG_TABLE_COLS; c++) {
+    lv_table_set_col_width(g_diag_ui.task_table, c,
+                           table_w * col_pct[c] / 100);
+    lv_table_set_cell_value(g_diag_ui.task_table, 0, c, col_titles[c]);
+  }
+
+  /* === 3. 启动定时器刷新数据 === */
+  g_diag_ui.update_timer =
+      lv_timer_create(diagnostics_update_timer_cb, DIAG_UPDATE_PERIOD_MS, NULL);
+  diagnostics_update_timer_cb(g_diag_ui.update_timer); // 立即执行一次
+}
+
+/**
+ * @brief 销毁诊断屏幕时调用的清理函数
+ */
+void ui_screen_diagnostics_deinit(void) {
+  /* 销毁顶部栏 */
+  if (g_diag_ui.header) {
+    ui_comp_header_destroy(g_diag_ui.header);
+    g_diag_ui.header = NULL;
+  }
+
+  /* 删除定时器 */
+  if (g_diag_ui.update_timer) {
+    lv_timer_del(g_diag_ui.update_timer);
+    g_diag_ui.update_timer = NULL;
+  }
+}
@@ -0,0 +1,25 @@
+#ifndef __UI_SCREEN_DIAGNOSTICS_H
+#define __UI_SCREEN_DIAGNOSTICS_H
+
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 初始化系统诊断屏幕的UI (隐藏页面，长按主页标题进入)
+ * @param parent 父对象 (通常是屏幕的根容器)
+ */
+void ui_screen_diagnostics_init(lv_obj_t* parent);
+
+/**
+ * @brief 反初始化系统诊断屏幕的UI，释放资源
+ */
+void ui_screen_diagnostics_deinit(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __UI_SCREEN_DIAGNOSTICS_H
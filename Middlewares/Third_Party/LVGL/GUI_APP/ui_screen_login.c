@@ -13,6 +13,7 @@
  * 包含头文件
  *********************************************************************************/
 #include "ui_screen_login.h"
+#include "ui_comp_keyboard.h"
 #include "ui_manager.h" // 用于屏幕切换
 #include <string.h>     // 用于 strcmp
 
@@ -355,14 +356,15 @@ static void create_login_widgets(lv_obj_t *parent) {
   lv_obj_set_style_text_font(login_label, &my_font_yahei_18, 0);
   lv_obj_center(login_label);
 
-  // 5. 创建虚拟键盘
-  g_ui.user_name_keyboard = lv_keyboard_create(parent);
+  // 5. 创建虚拟键盘 (字母键盘字符太多，只有数字键盘预渲染键帽)
+  g_ui.user_name_keyboard =
+      ui_comp_keyboard_create(parent, LV_KEYBOARD_MODE_TEXT_LOWER, NULL);
   lv_obj_add_flag(g_ui.user_name_keyboard, LV_OBJ_FLAG_HIDDEN);
   lv_obj_add_event_cb(g_ui.user_name_keyboard, keyboard_event_cb, LV_EVENT_ALL,
                       NULL);
 
-  g_ui.password_keyboard = lv_keyboard_create(parent);
-  lv_keyboard_set_mode(g_ui.password_keyboard, LV_KEYBOARD_MODE_NUMBER);
+  g_ui.password_keyboard = ui_comp_keyboard_create(
+      parent, LV_KEYBOARD_MODE_NUMBER, UI_KEYBOARD_NUMBER_KEYCAPS);
   lv_obj_add_flag(g_ui.password_keyboard, LV_OBJ_FLAG_HIDDEN);
   lv_obj_add_event_cb(g_ui.password_keyboard, keyboard_event_cb, LV_EVENT_ALL,
                       NULL);
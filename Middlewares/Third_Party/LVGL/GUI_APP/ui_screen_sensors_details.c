@@ -3,16 +3,29 @@
  * @file    ui_screen_sensors_details.c
  * @brief   传感器数据显示详情页面 (支持单/双曲线)
  * @details 使用LVGL展示传感器实时值、统计信息及历史曲线。
- *          图表数据采用整数缩放方式以保留浮点精度（SCALE_FACTOR）。
+ *          图表直接使用传感器任务维护的定点历史 (SensorTask_FixedScale)，
+ *          实时模式使用循环更新 (扫描式) 曲线：每个新样本只覆盖一个点，
+ *          只重绘该点两侧的线段，不再整体换算、重写和重绘曲线。
+ *          近期模式由传感器任务的压缩原始历史按时段求平均，覆盖范围
+ *          介于原始历史与分钟级汇总之间。
+ *          汇总模式按绘制宽度做 LTTB 降采样 (点数超过像素宽度时保留峰谷)，
+ *          只在有新封存的汇总桶时增量更新。
  * @author  MmsY
  * @time    2025/11/23
  ******************************************************************************
  */
 
 #include "ui_screen_sensors_details.h"
+#include "dsp_q15.h"
+#include "fmt_fixed.h"
+#include "lttb.h"
+#include "sensor_anomaly.h"
+#include "sensor_derived.h"
+#include "sensor_quality.h"
 #include "sensor_task.h"
 #include "ui_comp_header.h" // [NEW] 引入顶部栏组件
 #include "ui_manager.h"
+#include "ui_styles.h"
 
 
 LV_FONT_DECLARE(my_font_yahei_24);
@@ -20,42 +33,119 @@ LV_FONT_DECLARE(my_font_yahei_24);
 /* -----------------------------------------------------------
  * 常量与类型
  * ----------------------------------------------------------- */
-#define SCALE_FACTOR 10
 #define LV_COORD_T_MAX 32767
 #define LV_COORD_T_MIN -32768
 
+/* 图表最多点数：取原始历史与分钟级汇总中较大者 */
+#define DETAILS_CHART_MAX_POINTS                                               \
+  ((SENSOR_ROLLUP_MINUTE_SLOTS > SENSOR_HISTORY_SIZE)                          \
+       ? SENSOR_ROLLUP_MINUTE_SLOTS                                            \
+       : SENSOR_HISTORY_SIZE)
+
+/* 实时模式 Y 轴跨度小于该值 (实际值) 时改用默认跨度，避免平稳数据被放大成噪声 */
+#define DETAILS_LIVE_MIN_SPAN 10.0f
+
+/* 近期模式的时间窗口 (分钟)，按 DETAILS_CHART_MAX_POINTS 个时段求平均 */
+#define DETAILS_RECENT_MINUTES 15
+
+/* 双指缩放图表 X 轴的上限 (LV_IMG_ZOOM_NONE = 256 为原始宽度) */
+#define DETAILS_CHART_ZOOM_MAX (LV_IMG_ZOOM_NONE * 8)
+
+/**
+ * @brief 图表时间范围
+ */
+typedef enum {
+  DETAILS_RANGE_LIVE = 0, // 原始历史
+  DETAILS_RANGE_RECENT,   // 最近 DETAILS_RECENT_MINUTES 分钟 (压缩原始历史)
+  DETAILS_RANGE_HOUR,     // 最近 1 小时 (分钟级汇总)
+  DETAILS_RANGE_DAY,      // 最近 1 天 (小时级汇总)
+  DETAILS_RANGE_MAX
+} details_range_t;
+
 /**
  * @brief 传感器详情页面UI控件集合
  */
 typedef struct {
   ui_header_t *header;                 // [NEW] 顶部栏组件句柄
   lv_obj_t *realtime_val_label;        // 实时数值显示
+  lv_obj_t *anomaly_badge;             // 异常通道标记 (无异常时隐藏)
+  lv_obj_t *derived_label;             // 派生通道 (露点等，没有时隐藏)
   lv_obj_t *min_val_label;             // 最小值标签
   lv_obj_t *max_val_label;             // 最大值标签
   lv_obj_t *avg_val_label;             // 平均值标签
   lv_obj_t *chart;                     // 历史曲线图表对象
   lv_chart_series_t *series_primary;   // 主曲线系列（例如温度）
   lv_chart_series_t *series_secondary; // 次曲线系列（例如湿度）
-  lv_timer_t *update_timer;            // 定时器：用于定期刷新界面
 } sensors_details_ui_t;                // [CHANGED] 重命名结构体
 
 /* 模块静态变量 */
 static sensors_details_ui_t g_sensors_details_ui; // [CHANGED] 重命名变量
 static SensorType_t g_active_sensor_type;         // [CHANGED] 重命名变量
 
-/* 均为 SENSOR_HISTORY_SIZE 长度的坐标缓存（整数，已缩放） */
-static lv_coord_t primary_coord_buffer[SENSOR_HISTORY_SIZE];
-static lv_coord_t secondary_coord_buffer[SENSOR_HISTORY_SIZE];
+static details_range_t g_chart_range;             // 当前图表时间范围
+static uint16_t g_zoom_base = LV_IMG_ZOOM_NONE;    // 本次双指缩放开始时的缩放值
+static float g_value_scale = 1.0f;                // 定点值 = 实际值 * g_value_scale
+
+/* 坐标缓存（定点值，作为图表的外部数组） */
+static lv_coord_t primary_coord_buffer[DETAILS_CHART_MAX_POINTS];
+static lv_coord_t secondary_coord_buffer[DETAILS_CHART_MAX_POINTS];
+
+/* 已设置到图表的 Y 轴范围，未变化时不再调用 lv_chart_set_range */
+static struct {
+  lv_coord_t min;
+  lv_coord_t max;
+  bool valid;
+} g_axis_range[2];
+
+/* 汇总历史读取缓冲区（静态分配，避免占用 LVGL 任务栈） */
+static SensorRollupPoint_t rollup_buffer[DETAILS_CHART_MAX_POINTS];
+static lv_coord_t rollup_coords[DETAILS_CHART_MAX_POINTS]; // 降采样前的坐标
+static int16_t recent_buffer[DETAILS_CHART_MAX_POINTS];     // 近期模式的时段平均
+
+/* 汇总曲线降采样 (输出直接写入坐标缓存)，以及当前结果对应的数据版本 */
+static LTTB_t g_lttb[2];
+static uint16_t lttb_pos[2][DETAILS_CHART_MAX_POINTS];
+static struct {
+  SensorTier_t tier;
+  uint32_t end;   // 最新封存桶之后的绝对桶号
+  uint16_t width; // 降采样目标点数
+  bool valid;     // 坐标缓存中是该版本的汇总曲线
+} g_rollup_view;
+
+static const char *const range_btn_text[DETAILS_RANGE_MAX] = {"Live", "15M",
+                                                               "1H", "24H"};
 
 /* -----------------------------------------------------------
  * 前向声明
  * ----------------------------------------------------------- */
 static void back_btn_event_cb(lv_event_t *e);
-static void convert_float_to_scaled_coords(const float *src, lv_coord_t *dst,
-                                           uint16_t count, int scale);
+static uint16_t copy_span_to_ring(const SensorHistorySpan_t *span,
+                                  lv_coord_t *dst);
 static void chart_draw_event_cb(lv_event_t *e);
-static void
-sensors_details_update_timer_cb(lv_timer_t *timer); // [CHANGED] 重命名函数
+static void details_show_realtime(const SensorData_t *data);
+static void details_show_anomaly(uint8_t mask);
+static void details_show_derived(void);
+static void details_show_stats(const SensorStats_t *primary_stats,
+                               const SensorStats_t *secondary_stats);
+static void details_set_axis_range(lv_chart_axis_t axis, int32_t lo,
+                                   int32_t hi);
+static void details_set_live_range(lv_chart_axis_t axis,
+                                   const SensorStats_t *stats,
+                                   float default_span);
+static void details_set_fixed_range(lv_chart_axis_t axis, int32_t lo,
+                                    int32_t hi, float default_span);
+static void details_set_span_range(lv_chart_axis_t axis,
+                                   const SensorHistorySpan_t *span,
+                                   float default_span);
+static void details_show_points(uint16_t point_cnt, uint16_t start);
+static void details_clear_chart(void);
+static void details_push_history(const SensorSnapshot_t *snapshot);
+static void details_load_initial(void);
+static void details_load_raw_history(void);
+static void details_load_recent(void);
+static void details_load_rollup(void);
+static void details_load_range(void);
+static void range_btn_event_cb(lv_event_t *e);
 
 /* -----------------------------------------------------------
  * 回调与工具函数实现
@@ -70,13 +160,29 @@ static void back_btn_event_cb(lv_event_t *e) {
 }
 
 /**
- * @brief 将浮点数组转换为缩放后的整数坐标数组
+ * @brief 按环形缓冲区原有的槽位拷贝定点历史 (槽位 = 曲线上的点序号)
+ * @details 视图的第二段从槽位 0 开始，第一段紧随其后；未写过的槽位与
+ *          被剔除的样本为断点
+ * @return 下一个写入槽位 (即最旧的点)
  */
-static void convert_float_to_scaled_coords(const float *src, lv_coord_t *dst,
-                                           uint16_t count, int scale) {
-  for (uint16_t i = 0; i < count; i++) {
-    dst[i] = (lv_coord_t)(src[i] * scale);
+static uint16_t copy_span_to_ring(const SensorHistorySpan_t *span,
+                                  lv_coord_t *dst) {
+  uint16_t count = span->len[0] + span->len[1];
+  uint16_t base[2] = {span->len[1], 0}; // 各段在曲线上的起始点
+
+  for (uint8_t s = 0; s < 2; s++) {
+    if (span->len[s] == 0)
+      continue;
+    memcpy(&dst[base[s]], span->fixed[s], span->len[s] * sizeof(lv_coord_t));
+    for (uint16_t i = 0; i < span->len[s]; i++) {
+      if (span->quality[s][i] & SENSOR_QUALITY_REJECTED)
+        dst[base[s] + i] = LV_CHART_POINT_NONE;
+    }
   }
+  for (uint16_t i = count; i < SENSOR_HISTORY_SIZE; i++) {
+    dst[i] = LV_CHART_POINT_NONE;
+  }
+  return (count < SENSOR_HISTORY_SIZE) ? count : span->len[1];
 }
 
 /**
@@ -92,154 +198,606 @@ static void chart_draw_event_cb(lv_event_t *e) {
 
   if (dsc->p1 && dsc->p2) {
     if (dsc->id == LV_CHART_AXIS_PRIMARY_X) {
-      int total_seconds = SENSOR_HISTORY_SIZE / 2;
       int num_ticks = 4;
       int tick_index = (int)dsc->value;
-      int seconds_per_interval = total_seconds / (num_ticks - 1);
-      int time_val = tick_index * seconds_per_interval;
+      int total = SENSOR_HISTORY_SIZE / 2;
+      const char *unit = "s";
+
+      if (g_chart_range == DETAILS_RANGE_LIVE) {
+        /* 扫描式曲线：刻度表示扫描位置，断点处为当前时刻 */
+        snprintf(dsc->text, dsc->text_length, "%d%s",
+                 tick_index * total / (num_ticks - 1), unit);
+        return;
+      } else if (g_chart_range == DETAILS_RANGE_RECENT) {
+        total = DETAILS_RECENT_MINUTES;
+        unit = "m";
+      } else if (g_chart_range == DETAILS_RANGE_HOUR) {
+        total = SENSOR_ROLLUP_MINUTE_SLOTS;
+        unit = "m";
+      } else if (g_chart_range == DETAILS_RANGE_DAY) {
+        total = SENSOR_ROLLUP_HOUR_SLOTS;
+        unit = "h";
+      }
+
+      int per_interval = total / (num_ticks - 1);
+      int time_val = tick_index * per_interval;
 
       if (tick_index == num_ticks - 1) {
         snprintf(dsc->text, dsc->text_length, "Now");
       } else {
-        snprintf(dsc->text, dsc->text_length, "-%ds", total_seconds - time_val);
+        snprintf(dsc->text, dsc->text_length, "-%d%s", total - time_val, unit);
       }
     } else if (dsc->id == LV_CHART_AXIS_PRIMARY_Y ||
                dsc->id == LV_CHART_AXIS_SECONDARY_Y) {
       lv_coord_t value = dsc->value;
-      snprintf(dsc->text, dsc->text_length, "%.1f",
-               (float)value / SCALE_FACTOR);
+      char text[FMT_FIXED_BUF_SIZE];
+      snprintf(dsc->text, dsc->text_length, "%s",
+               fmt_q1((float)value / g_value_scale, text));
     }
   }
 }
 
 /**
- * @brief 界面周期性刷新定时器回调
+ * @brief 刷新实时数值
  */
-static void
-sensors_details_update_timer_cb(lv_timer_t *timer) // [CHANGED] 重命名函数
-{
-  (void)timer;
-  SensorData_t data;
-  SensorStats_t primary_stats;
-  SensorStats_t secondary_stats;
-  const float *history_primary = NULL;
-  const float *history_secondary = NULL;
-  uint16_t history_count = 0;
-
-  /* 1. 获取最新传感器数据并显示实时数值 */
-  if (SensorTask_GetSensorData(g_active_sensor_type, &data) && data.is_valid) {
-    if (g_active_sensor_type == SENSOR_TYPE_SHT30) {
-      lv_label_set_text_fmt(g_sensors_details_ui.realtime_val_label,
-                            "%.1f °C / %.1f %%RH", data.values.sht30.temp,
-                            data.values.sht30.humi);
+static void details_show_realtime(const SensorData_t *data) {
+  char text[2][FMT_FIXED_BUF_SIZE];
+
+  if (g_active_sensor_type == SENSOR_TYPE_SHT30) {
+    lv_label_set_text_fmt(g_sensors_details_ui.realtime_val_label,
+                          "%s °C / %s %%RH",
+                          fmt_q1(data->values.sht30.temp, text[0]),
+                          fmt_q1(data->values.sht30.humi, text[1]));
+  } else {
+    float value = 0.0f;
+    if (g_active_sensor_type == SENSOR_TYPE_GY30)
+      value = data->values.gy30.lux;
+    else if (g_active_sensor_type == SENSOR_TYPE_SMOKE)
+      value = (float)data->values.smoke.ppm;
+    lv_label_set_text(g_sensors_details_ui.realtime_val_label,
+                      fmt_q1(value, text[0]));
+  }
+  details_show_derived();
+}
+
+/**
+ * @brief 刷新派生通道：只在本页面显示时读取，派生值按需计算
+ */
+static void details_show_derived(void) {
+  char buf[96];
+  char text[FMT_FIXED_BUF_SIZE];
+  size_t len = 0;
+
+  for (uint8_t i = 0; i < SensorDerived_GetCount() && len < sizeof(buf); i++) {
+    const SensorDerivedDesc_t *desc = SensorDerived_GetDesc(i);
+    float value;
+
+    if (SENSOR_HANDLE_TYPE(desc->sensor) != g_active_sensor_type) {
+      continue;
+    }
+    len += (size_t)lv_snprintf(
+        buf + len, sizeof(buf) - len, "%s%s %s %s", len > 0 ? "\n" : "",
+        desc->name,
+        SensorDerived_Get(i, &value) ? fmt_q1(value, text) : "--", desc->unit);
+  }
+  if (len == 0) {
+    lv_obj_add_flag(g_sensors_details_ui.derived_label, LV_OBJ_FLAG_HIDDEN);
+    return;
+  }
+  lv_label_set_text(g_sensors_details_ui.derived_label, buf);
+  lv_obj_clear_flag(g_sensors_details_ui.derived_label, LV_OBJ_FLAG_HIDDEN);
+}
+
+/**
+ * @brief 刷新异常标记：列出处于异常的通道名
+ */
+static void details_show_anomaly(uint8_t mask) {
+  lv_obj_t *badge = g_sensors_details_ui.anomaly_badge;
+  const SensorChannelDesc_t *channels;
+  uint8_t count = SensorTask_GetChannels(g_active_sensor_type, &channels);
+  char text[32];
+  int len;
+
+  if (mask == 0) {
+    lv_obj_add_flag(badge, LV_OBJ_FLAG_HIDDEN);
+    return;
+  }
+  len = snprintf(text, sizeof(text), LV_SYMBOL_WARNING);
+  for (uint8_t ch = 0; ch < count && len < (int)sizeof(text); ch++) {
+    if (mask & (1U << ch)) {
+      len += snprintf(text + len, sizeof(text) - len, " %s", channels[ch].name);
+    }
+  }
+  lv_label_set_text(badge, text);
+  lv_obj_clear_flag(badge, LV_OBJ_FLAG_HIDDEN);
+}
+
+/**
+ * @brief 刷新统计数据（Min/Max/Avg）及图表 Y 轴范围
+ * @param secondary_stats 次统计数据，仅 SHT30 使用
+ */
+static void details_show_stats(const SensorStats_t *primary_stats,
+                               const SensorStats_t *secondary_stats) {
+  char t[4][FMT_FIXED_BUF_SIZE];
+
+  if (g_active_sensor_type == SENSOR_TYPE_SHT30) {
+    lv_label_set_text_fmt(
+        g_sensors_details_ui.min_val_label,
+        "Min: #D00000 %s#/ #7f7f7f %s# | #0000D0 %s#/ #7f7f7f %s#",
+        fmt_q1(primary_stats->min, t[0]),
+        fmt_q1(primary_stats->local_min, t[1]),
+        fmt_q1(secondary_stats->min, t[2]),
+        fmt_q1(secondary_stats->local_min, t[3]));
+    lv_label_set_text_fmt(
+        g_sensors_details_ui.max_val_label,
+        "Max: #D00000 %s#/ #7f7f7f %s# | #0000D0 %s#/ #7f7f7f %s#",
+        fmt_q1(primary_stats->max, t[0]),
+        fmt_q1(primary_stats->local_max, t[1]),
+        fmt_q1(secondary_stats->max, t[2]),
+        fmt_q1(secondary_stats->local_max, t[3]));
+    lv_label_set_text_fmt(g_sensors_details_ui.avg_val_label,
+                          "Avg: #D00000 %s# / #0000D0 %s#",
+                          fmt_q1(primary_stats->local_avg, t[0]),
+                          fmt_q1(secondary_stats->local_avg, t[1]));
+  } else {
+    lv_label_set_text_fmt(g_sensors_details_ui.min_val_label,
+                          "Min: #00D000 %s#/ #7f7f7f %s#",
+                          fmt_q1(primary_stats->min, t[0]),
+                          fmt_q1(primary_stats->local_min, t[1]));
+    lv_label_set_text_fmt(g_sensors_details_ui.max_val_label,
+                          "Max: #00D000 %s#/ #7f7f7f %s#",
+                          fmt_q1(primary_stats->max, t[0]),
+                          fmt_q1(primary_stats->local_max, t[1]));
+    lv_label_set_text_fmt(g_sensors_details_ui.avg_val_label,
+                          "Avg: #00D000 %s#",
+                          fmt_q1(primary_stats->local_avg, t[0]));
+  }
+
+  /* 近期/汇总模式下 Y 轴范围由 details_load_recent/rollup 根据数据决定 */
+  if (g_chart_range != DETAILS_RANGE_LIVE)
+    return;
+
+  details_set_live_range(LV_CHART_AXIS_PRIMARY_Y, primary_stats, 20.0f);
+  if (g_active_sensor_type == SENSOR_TYPE_SHT30) {
+    details_set_live_range(LV_CHART_AXIS_SECONDARY_Y, secondary_stats, 10.0f);
+  }
+}
+
+/**
+ * @brief 设置 Y 轴范围 (定点值)，与当前范围相同时跳过
+ */
+static void details_set_axis_range(lv_chart_axis_t axis, int32_t lo,
+                                   int32_t hi) {
+  int idx = (axis == LV_CHART_AXIS_SECONDARY_Y) ? 1 : 0;
+
+  lo = (lo <= LV_COORD_T_MIN) ? LV_COORD_T_MIN : lo;
+  hi = (hi >= LV_COORD_T_MAX) ? LV_COORD_T_MAX : hi;
+  lo = (lo >= hi) ? (hi - 1) : lo;
+
+  if (g_axis_range[idx].valid && g_axis_range[idx].min == lo &&
+      g_axis_range[idx].max == hi) {
+    return;
+  }
+  g_axis_range[idx].min = (lv_coord_t)lo;
+  g_axis_range[idx].max = (lv_coord_t)hi;
+  g_axis_range[idx].valid = true;
+  lv_chart_set_range(g_sensors_details_ui.chart, axis, (lv_coord_t)lo,
+                     (lv_coord_t)hi);
+}
+
+/**
+ * @brief 按窗口极值设置实时模式的 Y 轴范围
+ * @details local_min/local_max 由传感器任务的单调队列在 O(1) 内维护，
+ *          这里只做一次定点换算；极值不变时范围不变，不触发图表重算。
+ * @param default_span 窗口跨度不足 DETAILS_LIVE_MIN_SPAN 时使用的跨度 (实际值)
+ */
+static void details_set_live_range(lv_chart_axis_t axis,
+                                   const SensorStats_t *stats,
+                                   float default_span) {
+  uint8_t ch = (axis == LV_CHART_AXIS_SECONDARY_Y) ? 1 : 0;
+
+  details_set_fixed_range(
+      axis, SensorTask_ToFixed(g_active_sensor_type, ch, stats->local_min),
+      SensorTask_ToFixed(g_active_sensor_type, ch, stats->local_max),
+      default_span);
+}
+
+/**
+ * @brief 按定点极值加上边距设置实时模式的 Y 轴范围
+ */
+static void details_set_fixed_range(lv_chart_axis_t axis, int32_t lo,
+                                    int32_t hi, float default_span) {
+  int32_t span = hi - lo;
+
+  if (span < (int32_t)(DETAILS_LIVE_MIN_SPAN * g_value_scale))
+    span = (int32_t)(default_span * g_value_scale);
+  int32_t margin = span / 10;
+
+  details_set_axis_range(axis, lo - margin, hi + margin);
+}
+
+/**
+ * @brief 按历史视图中的定点极值设置实时模式的 Y 轴范围
+ * @details 与统计中的 local_min/local_max 覆盖同一窗口；从汇总模式切回时
+ *          立即按已有历史缩放，不必等下一个样本的统计数据。
+ *          极值直接在定点数据上求 (SIMD 每次比较两个点)，不经 float 换算。
+ */
+static void details_set_span_range(lv_chart_axis_t axis,
+                                   const SensorHistorySpan_t *span,
+                                   float default_span) {
+  int16_t lo = 0, hi = 0;
+  bool any = false;
+
+  for (uint8_t s = 0; s < 2; s++) {
+    int16_t seg_lo, seg_hi;
+
+    if (span->len[s] == 0)
+      continue;
+    DSP_MinMaxQ15(span->fixed[s], span->len[s], &seg_lo, &seg_hi);
+    if (!any || seg_lo < lo)
+      lo = seg_lo;
+    if (!any || seg_hi > hi)
+      hi = seg_hi;
+    any = true;
+  }
+  if (any)
+    details_set_fixed_range(axis, lo, hi, default_span);
+}
+
+/**
+ * @brief 以坐标缓存的前 point_cnt 个点重新显示曲线
+ * @param start 下一个新样本写入的点序号 (实时模式)，汇总模式为 0
+ */
+static void details_show_points(uint16_t point_cnt, uint16_t start) {
+  lv_obj_t *chart = g_sensors_details_ui.chart;
+
+  lv_chart_set_point_count(chart, point_cnt);
+  lv_chart_set_x_start_point(chart, g_sensors_details_ui.series_primary,
+                             start);
+  if (g_sensors_details_ui.series_secondary != NULL) {
+    lv_chart_set_x_start_point(chart, g_sensors_details_ui.series_secondary,
+                               start);
+  }
+  lv_chart_refresh(chart);
+}
+
+/**
+ * @brief 清空曲线 (显示为一个断点)
+ */
+static void details_clear_chart(void) {
+  lv_chart_set_point_count(g_sensors_details_ui.chart, 1);
+  lv_chart_set_all_value(g_sensors_details_ui.chart,
+                         g_sensors_details_ui.series_primary,
+                         LV_CHART_POINT_NONE);
+  if (g_sensors_details_ui.series_secondary != NULL) {
+    lv_chart_set_all_value(g_sensors_details_ui.chart,
+                           g_sensors_details_ui.series_secondary,
+                           LV_CHART_POINT_NONE);
+  }
+  lv_chart_refresh(g_sensors_details_ui.chart);
+}
+
+/**
+ * @brief 向曲线追加一个数据点
+ * @details 实时模式下图表固定为 SENSOR_HISTORY_SIZE 个点的循环数组：
+ *          lv_chart_set_next_value 覆盖最旧的点并使两侧线段失效，
+ *          随后把下一个点置为断点，作为扫描位置的标记。
+ */
+static void details_push_history(const SensorSnapshot_t *snapshot) {
+  if (g_chart_range != DETAILS_RANGE_LIVE) {
+    details_load_range();
+    return;
+  }
+  if (!snapshot->event.data.is_valid)
+    return;
+
+  lv_obj_t *chart = g_sensors_details_ui.chart;
+  lv_chart_series_t *primary = g_sensors_details_ui.series_primary;
+  lv_chart_series_t *secondary = g_sensors_details_ui.series_secondary;
+  const uint8_t *quality = snapshot->event.data.quality;
+
+  /* 断点所在区域已由 lv_chart_set_next_value 标记为失效，直接写缓存即可；
+   * 被剔除的样本同样显示为断点 */
+  lv_chart_set_next_value(chart, primary,
+                          (quality[0] & SENSOR_QUALITY_REJECTED)
+                              ? LV_CHART_POINT_NONE
+                              : snapshot->fixed[0]);
+  primary_coord_buffer[lv_chart_get_x_start_point(chart, primary)] =
+      LV_CHART_POINT_NONE;
+  if (secondary != NULL) {
+    lv_chart_set_next_value(chart, secondary,
+                            (quality[1] & SENSOR_QUALITY_REJECTED)
+                                ? LV_CHART_POINT_NONE
+                                : snapshot->fixed[1]);
+    secondary_coord_buffer[lv_chart_get_x_start_point(chart, secondary)] =
+        LV_CHART_POINT_NONE;
+  }
+}
+
+/**
+ * @brief 进入页面时主动拉取一次数据、统计与历史，之后完全由事件驱动
+ */
+static void details_load_initial(void) {
+  static SensorSystemSnapshot_t snap;
+  const SensorSnapshotEntry_t *e;
+
+  /* 实时数值与统计数据取自同一次快照，两者对应同一个样本 */
+  SensorTask_GetSnapshot(&snap);
+  e = SensorTask_SnapshotFind(&snap, g_active_sensor_type);
+
+  /* 1. 实时数值 */
+  if (e != NULL && e->is_enabled && e->data.is_valid) {
+    details_show_realtime(&e->data);
+  }
+  details_show_anomaly(SensorAnomaly_GetMask(g_active_sensor_type));
+
+  /* 2. 统计数据 */
+  if (e != NULL && e->is_enabled && e->history_count > 0) {
+    if (g_active_sensor_type != SENSOR_TYPE_SHT30) {
+      details_show_stats(&e->stats[0], NULL);
     } else {
-      float value = 0.0f;
-      if (g_active_sensor_type == SENSOR_TYPE_GY30)
-        value = data.values.gy30.lux;
-      else if (g_active_sensor_type == SENSOR_TYPE_SMOKE)
-        value = (float)data.values.smoke.ppm;
-      lv_label_set_text_fmt(g_sensors_details_ui.realtime_val_label, "%.1f",
-                            value);
+      details_show_stats(&e->stats[0], &e->stats[1]);
     }
   }
 
-  /* 2. 更新统计数据（Min/Max/Avg） */
-  if (SensorTask_GetStats(g_active_sensor_type, &primary_stats)) {
+  /* 3. 历史数据 (从缓存重新显示时保持之前选择的时间范围) */
+  details_load_range();
+}
+
+/**
+ * @brief 从传感器任务拉取原始历史并显示
+ * @details 曲线固定为 SENSOR_HISTORY_SIZE 个点，与传感器历史的槽位一一对应，
+ *          之后新样本由 details_push_history 逐点覆盖。
+ */
+static void details_load_raw_history(void) {
+  SensorHistorySpan_t primary;
+  SensorHistorySpan_t secondary;
+  uint16_t history_count;
+  uint16_t next;
+
+  /* 原地读取环形缓冲区；拷贝期间有新样本写入则重读 (主视图仍有效说明
+   * 两组数据都没有被改写) */
+  do {
+    history_count =
+        SensorTask_GetHistorySpan(g_active_sensor_type, 0, &primary);
+    next = copy_span_to_ring(&primary, primary_coord_buffer);
     if (g_active_sensor_type == SENSOR_TYPE_SHT30) {
-      if (SensorTask_GetSecondaryStats(g_active_sensor_type,
-                                       &secondary_stats)) {
-        lv_label_set_text_fmt(
-            g_sensors_details_ui.min_val_label,
-            "Min: #D00000 %.1f#/ #7f7f7f %.1f# | #0000D0 %.1f#/ #7f7f7f %.1f#",
-            primary_stats.min, primary_stats.local_min, secondary_stats.min,
-            secondary_stats.local_min);
-        lv_label_set_text_fmt(
-            g_sensors_details_ui.max_val_label,
-            "Max: #D00000 %.1f#/ #7f7f7f %.1f# | #0000D0 %.1f#/ #7f7f7f %.1f#",
-            primary_stats.max, primary_stats.local_max, secondary_stats.max,
-            secondary_stats.local_max);
-        lv_label_set_text_fmt(g_sensors_details_ui.avg_val_label,
-                              "Avg: #D00000 %.1f# / #0000D0 %.1f#",
-                              primary_stats.local_avg,
-                              secondary_stats.local_avg);
-      }
-    } else {
-      lv_label_set_text_fmt(g_sensors_details_ui.min_val_label,
-                            "Min: #00D000 %.1f#/ #7f7f7f %.1f#",
-                            primary_stats.min, primary_stats.local_min);
-      lv_label_set_text_fmt(g_sensors_details_ui.max_val_label,
-                            "Max: #00D000 %.1f#/ #7f7f7f %.1f#",
-                            primary_stats.max, primary_stats.local_max);
-      lv_label_set_text_fmt(g_sensors_details_ui.avg_val_label,
-                            "Avg: #00D000 %.1f#", primary_stats.local_avg);
+      SensorTask_GetHistorySpan(g_active_sensor_type, 1, &secondary);
+      copy_span_to_ring(&secondary, secondary_coord_buffer);
     }
+  } while (history_count > 0 && !SensorTask_HistorySpanValid(&primary));
 
-    float range = primary_stats.local_max - primary_stats.local_min;
-    if (range < 10)
-      range = 20;
-    float margin = range * 0.1f;
+  /* 视图在重读后仍有效，可直接在原地求极值 */
+  details_set_span_range(LV_CHART_AXIS_PRIMARY_Y, &primary, 20.0f);
+  if (g_active_sensor_type == SENSOR_TYPE_SHT30) {
+    details_set_span_range(LV_CHART_AXIS_SECONDARY_Y, &secondary, 10.0f);
+  }
 
-    float y_max_float = (primary_stats.local_max + margin) * SCALE_FACTOR;
-    float y_min_float = (primary_stats.local_min - margin) * SCALE_FACTOR;
+  /* 下一个写入位置显示为断点 (历史已满时即丢弃最旧的一个点) */
+  g_rollup_view.valid = false; // 坐标缓存改为原始历史
+  primary_coord_buffer[next] = LV_CHART_POINT_NONE;
+  secondary_coord_buffer[next] = LV_CHART_POINT_NONE;
+  details_show_points(SENSOR_HISTORY_SIZE, next);
+}
 
-    y_max_float =
-        (y_max_float >= LV_COORD_T_MAX) ? LV_COORD_T_MAX : y_max_float;
-    y_min_float =
-        (y_min_float <= LV_COORD_T_MIN) ? LV_COORD_T_MIN : y_min_float;
-    y_min_float =
-        (y_min_float >= y_max_float) ? (y_max_float - 1) : y_min_float;
+/**
+ * @brief 读取一个通道的压缩原始历史 -> 坐标，无数据的时段显示为断点
+ * @return 是否存在有效点；有效时输出定点最小/最大值
+ */
+static bool details_recent_to_coords(uint8_t channel, lv_coord_t *dst,
+                                     int32_t *lo, int32_t *hi) {
+  bool any = false;
 
-    lv_chart_set_range(g_sensors_details_ui.chart, LV_CHART_AXIS_PRIMARY_Y,
-                       (lv_coord_t)y_min_float, (lv_coord_t)y_max_float);
+  if (SensorTask_GetRecentHistory(
+          g_active_sensor_type, channel,
+          (uint32_t)DETAILS_RECENT_MINUTES * 60U * 1000U, recent_buffer,
+          DETAILS_CHART_MAX_POINTS) == 0) {
+    return false;
+  }
+  for (uint16_t i = 0; i < DETAILS_CHART_MAX_POINTS; i++) {
+    if (recent_buffer[i] == SENSOR_SERIES_EMPTY) {
+      dst[i] = LV_CHART_POINT_NONE;
+      continue;
+    }
+    dst[i] = recent_buffer[i];
+    if (!any || recent_buffer[i] < *lo)
+      *lo = recent_buffer[i];
+    if (!any || recent_buffer[i] > *hi)
+      *hi = recent_buffer[i];
+    any = true;
+  }
+  return any;
+}
 
-    if (g_active_sensor_type == SENSOR_TYPE_SHT30) {
-      range = secondary_stats.local_max - secondary_stats.local_min;
-      if (range < 10)
-        range = 10;
-      margin = range * 0.1f;
-
-      y_max_float = (secondary_stats.local_max + margin) * SCALE_FACTOR;
-      y_min_float = (secondary_stats.local_min - margin) * SCALE_FACTOR;
-
-      y_max_float =
-          (y_max_float >= LV_COORD_T_MAX) ? LV_COORD_T_MAX : y_max_float;
-      y_min_float =
-          (y_min_float <= LV_COORD_T_MIN) ? LV_COORD_T_MIN : y_min_float;
-      y_min_float =
-          (y_min_float >= y_max_float) ? (y_max_float - 1) : y_min_float;
-
-      lv_chart_set_range(g_sensors_details_ui.chart, LV_CHART_AXIS_SECONDARY_Y,
-                         (lv_coord_t)y_min_float, (lv_coord_t)y_max_float);
+/**
+ * @brief 读取最近 DETAILS_RECENT_MINUTES 分钟的压缩原始历史并显示
+ * @details 每个时段为该时段内原始样本的平均值，时段数等于图表点数，
+ *          不再降采样；每个新样本到达时整体重新解码
+ */
+static void details_load_recent(void) {
+  int32_t lo = 0, hi = 0;
+
+  g_rollup_view.valid = false; // 坐标缓存改为近期历史
+  if (!details_recent_to_coords(0, primary_coord_buffer, &lo, &hi)) {
+    details_clear_chart();
+    return;
+  }
+  details_set_fixed_range(LV_CHART_AXIS_PRIMARY_Y, lo, hi, 20.0f);
+
+  if (g_sensors_details_ui.series_secondary != NULL) {
+    if (details_recent_to_coords(1, secondary_coord_buffer, &lo, &hi)) {
+      details_set_fixed_range(LV_CHART_AXIS_SECONDARY_Y, lo, hi, 10.0f);
+    } else {
+      for (uint16_t i = 0; i < DETAILS_CHART_MAX_POINTS; i++)
+        secondary_coord_buffer[i] = LV_CHART_POINT_NONE;
     }
   }
 
-  /* 3. 获取历史数据并更新图表 */
-  history_count =
-      SensorTask_GetPrimaryHistory(g_active_sensor_type, &history_primary);
-  if (history_count > 0 && history_primary != NULL) {
-    convert_float_to_scaled_coords(history_primary, primary_coord_buffer,
-                                   history_count, SCALE_FACTOR);
-    lv_chart_set_ext_y_array(g_sensors_details_ui.chart,
-                             g_sensors_details_ui.series_primary,
-                             primary_coord_buffer);
-    lv_chart_set_point_count(g_sensors_details_ui.chart, history_count);
+  details_show_points(DETAILS_CHART_MAX_POINTS, 0);
+}
 
-    if (g_active_sensor_type == SENSOR_TYPE_SHT30) {
-      SensorTask_GetSecondaryHistory(g_active_sensor_type, &history_secondary);
-      if (history_secondary != NULL) {
-        convert_float_to_scaled_coords(history_secondary,
-                                       secondary_coord_buffer, history_count,
-                                       SCALE_FACTOR);
-        lv_chart_set_ext_y_array(g_sensors_details_ui.chart,
-                                 g_sensors_details_ui.series_secondary,
-                                 secondary_coord_buffer);
-      }
+/**
+ * @brief 汇总桶 -> 坐标，无数据的时段显示为断点
+ * @return 是否存在有效点；有效时输出桶数据的最小/最大值
+ */
+static bool details_rollup_to_coords(uint8_t channel, uint16_t count,
+                                     lv_coord_t *dst, float *lo, float *hi) {
+  bool any = false;
+
+  for (uint16_t i = 0; i < count; i++) {
+    if (!rollup_buffer[i].valid) {
+      dst[i] = LV_CHART_POINT_NONE;
+      continue;
+    }
+    dst[i] = SensorTask_ToFixed(g_active_sensor_type, channel,
+                                rollup_buffer[i].avg);
+    if (!any || rollup_buffer[i].min < *lo)
+      *lo = rollup_buffer[i].min;
+    if (!any || rollup_buffer[i].max > *hi)
+      *hi = rollup_buffer[i].max;
+    any = true;
+  }
+  return any;
+}
+
+/**
+ * @brief 按桶数据设置 Y 轴范围
+ */
+static void details_set_rollup_range(lv_chart_axis_t axis, float lo,
+                                     float hi) {
+  uint8_t ch = (axis == LV_CHART_AXIS_SECONDARY_Y) ? 1 : 0;
+  float margin = (hi - lo) * 0.1f;
+  if (margin < 1.0f)
+    margin = 1.0f;
+
+  details_set_axis_range(
+      axis, SensorTask_ToFixed(g_active_sensor_type, ch, lo - margin),
+      SensorTask_ToFixed(g_active_sensor_type, ch, hi + margin));
+}
+
+/**
+ * @brief 汇总曲线的目标点数：图表的绘制宽度 (像素，含 X 轴缩放)
+ * @details 布局尚未完成时不降采样
+ */
+static uint16_t details_plot_width(uint16_t max_points) {
+  lv_obj_t *chart = g_sensors_details_ui.chart;
+  int32_t w = (int32_t)lv_obj_get_content_width(chart) *
+              lv_chart_get_zoom_x(chart) / LV_IMG_ZOOM_NONE;
+
+  if (w < 2 || w > max_points)
+    return max_points;
+  return (uint16_t)w;
+}
+
+/**
+ * @brief 读取一个通道的汇总桶
+ * @details 读取期间封存了新桶则重读，保证 end 与读出的数据对应
+ * @param end 输出：最后一个桶之后的绝对桶号
+ */
+static uint16_t details_read_rollup(uint8_t channel, SensorTier_t tier,
+                                    uint16_t max_points, uint32_t *end) {
+  uint16_t count;
+
+  do {
+    *end = SensorTask_GetRollupEnd(g_active_sensor_type, channel, tier);
+    count = SensorTask_GetRollupHistory(g_active_sensor_type, channel, tier,
+                                        rollup_buffer, max_points);
+  } while (*end !=
+           SensorTask_GetRollupEnd(g_active_sensor_type, channel, tier));
+  return count;
+}
+
+/**
+ * @brief 读取分钟/小时级汇总并显示平均值曲线
+ * @details 汇总在传感器任务插入样本时已完成；汇总桶每分钟 (小时) 才封存
+ *          一个，没有新桶且绘制宽度不变时保留已有曲线。有新桶时只对变化
+ *          的降采样分组重新选点，Y 轴范围仍按全部桶的极值设置。
+ */
+static void details_load_rollup(void) {
+  SensorTier_t tier = (g_chart_range == DETAILS_RANGE_DAY) ? SENSOR_TIER_HOUR
+                                                           : SENSOR_TIER_MINUTE;
+  uint16_t max_points = (tier == SENSOR_TIER_HOUR) ? SENSOR_ROLLUP_HOUR_SLOTS
+                                                   : SENSOR_ROLLUP_MINUTE_SLOTS;
+  uint16_t width = details_plot_width(max_points);
+  uint32_t end = SensorTask_GetRollupEnd(g_active_sensor_type, 0, tier);
+  float lo = 0.0f, hi = 0.0f;
+
+  if (g_rollup_view.valid && g_rollup_view.tier == tier &&
+      g_rollup_view.end == end && g_rollup_view.width == width) {
+    return;
+  }
+  if (!g_rollup_view.valid || g_rollup_view.tier != tier ||
+      g_rollup_view.width != width) {
+    LTTB_Init(&g_lttb[0], primary_coord_buffer, lttb_pos[0], width,
+              max_points, LV_CHART_POINT_NONE);
+    LTTB_Init(&g_lttb[1], secondary_coord_buffer, lttb_pos[1], width,
+              max_points, LV_CHART_POINT_NONE);
+  }
+
+  uint16_t count = details_read_rollup(0, tier, max_points, &end);
+  g_rollup_view.tier = tier;
+  g_rollup_view.end = end;
+  g_rollup_view.width = width;
+  g_rollup_view.valid = true;
+  if (count == 0) {
+    /* 尚无封存的汇总桶 */
+    LTTB_Reset(&g_lttb[0]);
+    LTTB_Reset(&g_lttb[1]);
+    details_clear_chart();
+    return;
+  }
+
+  if (details_rollup_to_coords(0, count, rollup_coords, &lo, &hi)) {
+    details_set_rollup_range(LV_CHART_AXIS_PRIMARY_Y, lo, hi);
+  }
+  uint16_t points = LTTB_Update(&g_lttb[0], rollup_coords, count, end);
+
+  if (g_sensors_details_ui.series_secondary != NULL) {
+    uint32_t end1;
+    uint16_t n = details_read_rollup(1, tier, max_points, &end1);
+    if (n == count && end1 == end &&
+        details_rollup_to_coords(1, count, rollup_coords, &lo, &hi)) {
+      details_set_rollup_range(LV_CHART_AXIS_SECONDARY_Y, lo, hi);
+      LTTB_Update(&g_lttb[1], rollup_coords, count, end);
+    } else {
+      LTTB_Reset(&g_lttb[1]);
+      for (uint16_t i = 0; i < points; i++)
+        secondary_coord_buffer[i] = LV_CHART_POINT_NONE;
     }
+  }
+
+  details_show_points(points, 0);
+}
 
-    lv_chart_refresh(g_sensors_details_ui.chart);
+/**
+ * @brief 按当前时间范围重新读取并显示历史
+ */
+static void details_load_range(void) {
+  switch (g_chart_range) {
+  case DETAILS_RANGE_LIVE:
+    details_load_raw_history();
+    break;
+  case DETAILS_RANGE_RECENT:
+    details_load_recent();
+    break;
+  default:
+    details_load_rollup();
+    break;
   }
 }
 
+/**
+ * @brief 时间范围切换按钮：Live -> 15M -> 1H -> 24H
+ */
+static void range_btn_event_cb(lv_event_t *e) {
+  (void)e;
+
+  g_chart_range = (details_range_t)((g_chart_range + 1) % DETAILS_RANGE_MAX);
+  ui_comp_header_set_custom_text(g_sensors_details_ui.header,
+                                 range_btn_text[g_chart_range]);
+  details_load_range();
+}
+
 /* -----------------------------------------------------------
  * 界面初始化与反初始化
  * ----------------------------------------------------------- */
@@ -249,16 +807,21 @@ sensors_details_update_timer_cb(lv_timer_t *timer) // [CHANGED] 重命名函数
  */
 void ui_screen_sensors_details_init(lv_obj_t *parent) // [CHANGED] 重命名函数
 {
+  g_zoom_base = LV_IMG_ZOOM_NONE;
   memset(&g_sensors_details_ui, 0, sizeof(sensors_details_ui_t));
+  memset(g_axis_range, 0, sizeof(g_axis_range));
+  g_rollup_view.valid = false;
+  g_chart_range = DETAILS_RANGE_LIVE;
   g_active_sensor_type = ui_get_active_sensor();
+  g_value_scale = SensorTask_FixedScale(g_active_sensor_type, 0);
   const char *sensor_name = SensorType_ToString(g_active_sensor_type);
 
   /* Grid 布局与间距 */
   lv_obj_set_layout(parent, LV_LAYOUT_GRID);
   // lv_obj_set_style_pad_all(parent, 10, 0);
-  lv_obj_set_style_pad_gap(parent, 10, 0);
+  lv_obj_add_style(parent, ui_style(UI_STYLE_GAP), 0);
   static lv_coord_t col_dsc[] = {LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
-  static lv_coord_t row_dsc[] = {70, LV_GRID_CONTENT, LV_GRID_CONTENT,
+  static lv_coord_t row_dsc[] = {LV_GRID_CONTENT, LV_GRID_CONTENT,
                                  LV_GRID_FR(1), LV_GRID_TEMPLATE_LAST};
   lv_obj_set_grid_dsc_array(parent, col_dsc, row_dsc);
 
@@ -268,32 +831,43 @@ void ui_screen_sensors_details_init(lv_obj_t *parent) // [CHANGED] 重命名函
 
   ui_header_config_t header_config = {.title = title_buf,
                                       .show_back_btn = true,
-                                      .show_custom_btn = false,
-                                      .custom_btn_text = NULL,
+                                      .show_custom_btn = true,
+                                      .custom_btn_text =
+                                          range_btn_text[DETAILS_RANGE_LIVE],
                                       .back_btn_cb = back_btn_event_cb,
-                                      .custom_btn_cb = NULL,
+                                      .custom_btn_cb = range_btn_event_cb,
                                       .user_data = NULL,
                                       .show_time = true};
 
-  g_sensors_details_ui.header = ui_comp_header_create(parent, &header_config);
-
-  /* 设置顶部栏在 Grid 中的位置 */
-  lv_obj_set_grid_cell(g_sensors_details_ui.header->container,
-                       LV_GRID_ALIGN_STRETCH, 0, 1, LV_GRID_ALIGN_STRETCH, 0,
-                       1);
+  /* 顶部栏常驻 lv_layer_top，不占用 Grid 行 */
+  g_sensors_details_ui.header = ui_comp_header_create(&header_config);
 
   /* === 2. 实时数据显示面板 === */
   lv_obj_t *realtime_panel = lv_obj_create(parent);
   lv_obj_set_height(realtime_panel, LV_SIZE_CONTENT);
   lv_obj_set_style_pad_all(realtime_panel, 5, 0);
   lv_obj_set_grid_cell(realtime_panel, LV_GRID_ALIGN_STRETCH, 0, 1,
-                       LV_GRID_ALIGN_STRETCH, 1, 1);
+                       LV_GRID_ALIGN_STRETCH, 0, 1);
   g_sensors_details_ui.realtime_val_label = lv_label_create(realtime_panel);
   lv_obj_set_style_text_font(g_sensors_details_ui.realtime_val_label,
                              &lv_font_montserrat_36, 0);
   lv_label_set_text(g_sensors_details_ui.realtime_val_label, "--.-");
   lv_obj_center(g_sensors_details_ui.realtime_val_label);
 
+  g_sensors_details_ui.anomaly_badge = lv_label_create(realtime_panel);
+  lv_obj_set_style_text_font(g_sensors_details_ui.anomaly_badge,
+                             &lv_font_montserrat_20, 0);
+  lv_obj_set_style_text_color(g_sensors_details_ui.anomaly_badge,
+                              lv_palette_main(LV_PALETTE_ORANGE), 0);
+  lv_obj_align(g_sensors_details_ui.anomaly_badge, LV_ALIGN_TOP_RIGHT, 0, 0);
+  lv_obj_add_flag(g_sensors_details_ui.anomaly_badge, LV_OBJ_FLAG_HIDDEN);
+
+  g_sensors_details_ui.derived_label = lv_label_create(realtime_panel);
+  lv_obj_set_style_text_font(g_sensors_details_ui.derived_label,
+                             &lv_font_montserrat_14, 0);
+  lv_obj_align(g_sensors_details_ui.derived_label, LV_ALIGN_TOP_LEFT, 0, 0);
+  lv_obj_add_flag(g_sensors_details_ui.derived_label, LV_OBJ_FLAG_HIDDEN);
+
   /* === 3. 统计信息面板 === */
   lv_obj_t *stats_panel = lv_obj_create(parent);
   lv_obj_set_height(stats_panel, LV_SIZE_CONTENT);
@@ -303,7 +877,7 @@ void ui_screen_sensors_details_init(lv_obj_t *parent) // [CHANGED] 重命名函
   lv_obj_set_flex_align(stats_panel, LV_FLEX_ALIGN_SPACE_EVENLY,
                         LV_FLEX_ALIGN_CENTER, LV_FLEX_ALIGN_CENTER);
   lv_obj_set_grid_cell(stats_panel, LV_GRID_ALIGN_STRETCH, 0, 1,
-                       LV_GRID_ALIGN_STRETCH, 2, 1);
+                       LV_GRID_ALIGN_STRETCH, 1, 1);
 
   g_sensors_details_ui.min_val_label = lv_label_create(stats_panel);
   g_sensors_details_ui.max_val_label = lv_label_create(stats_panel);
@@ -328,7 +902,7 @@ void ui_screen_sensors_details_init(lv_obj_t *parent) // [CHANGED] 重命名函
   lv_obj_t *chart_container = lv_obj_create(parent);
   lv_obj_remove_style_all(chart_container);
   lv_obj_set_grid_cell(chart_container, LV_GRID_ALIGN_STRETCH, 0, 1,
-                       LV_GRID_ALIGN_STRETCH, 3, 1);
+                       LV_GRID_ALIGN_STRETCH, 2, 1);
 
   lv_obj_set_style_pad_left(chart_container, 50, 0);
   lv_obj_set_style_pad_right(chart_container, 50, 0);
@@ -340,32 +914,17 @@ void ui_screen_sensors_details_init(lv_obj_t *parent) // [CHANGED] 重命名函
   lv_obj_center(g_sensors_details_ui.chart);
 
   lv_chart_set_type(g_sensors_details_ui.chart, LV_CHART_TYPE_LINE);
+  lv_chart_set_update_mode(g_sensors_details_ui.chart,
+                           LV_CHART_UPDATE_MODE_CIRCULAR);
   lv_chart_set_point_count(g_sensors_details_ui.chart, SENSOR_HISTORY_SIZE);
   lv_obj_add_event_cb(g_sensors_details_ui.chart, chart_draw_event_cb,
                       LV_EVENT_DRAW_PART_BEGIN, NULL);
 
-  lv_obj_set_style_bg_color(g_sensors_details_ui.chart, lv_color_hex(0xFFFFFF),
-                            LV_PART_MAIN);
-  lv_obj_set_style_bg_opa(g_sensors_details_ui.chart, LV_OPA_COVER,
-                          LV_PART_MAIN);
-  lv_obj_set_style_border_width(g_sensors_details_ui.chart, 1, LV_PART_MAIN);
-  lv_obj_set_style_border_color(g_sensors_details_ui.chart,
-                                lv_color_hex(0xCCCCCC), LV_PART_MAIN);
-  lv_obj_set_style_border_side(g_sensors_details_ui.chart,
-                               LV_BORDER_SIDE_LEFT | LV_BORDER_SIDE_BOTTOM,
-                               LV_PART_MAIN);
-
+  lv_obj_add_style(g_sensors_details_ui.chart, ui_style(UI_STYLE_CHART),
+                   LV_PART_MAIN);
+  lv_obj_add_style(g_sensors_details_ui.chart, ui_style(UI_STYLE_CHART_TICKS),
+                   LV_PART_TICKS);
   lv_chart_set_div_line_count(g_sensors_details_ui.chart, 5, 10);
-  lv_obj_set_style_line_width(g_sensors_details_ui.chart, 1, LV_PART_MAIN);
-  lv_obj_set_style_line_dash_width(g_sensors_details_ui.chart, 2, LV_PART_MAIN);
-  lv_obj_set_style_line_dash_gap(g_sensors_details_ui.chart, 2, LV_PART_MAIN);
-  lv_obj_set_style_line_color(g_sensors_details_ui.chart,
-                              lv_color_hex(0xECECEC), LV_PART_MAIN);
-
-  lv_obj_set_style_text_font(g_sensors_details_ui.chart, &lv_font_montserrat_14,
-                             LV_PART_TICKS);
-  lv_obj_set_style_text_color(g_sensors_details_ui.chart, lv_color_black(),
-                              LV_PART_TICKS);
 
   lv_chart_set_axis_tick(g_sensors_details_ui.chart, LV_CHART_AXIS_PRIMARY_X, 5,
                          2, 4, 2, true, 40);
@@ -390,12 +949,23 @@ void ui_screen_sensors_details_init(lv_obj_t *parent) // [CHANGED] 重命名函
     g_sensors_details_ui.series_secondary = NULL;
   }
 
-  lv_obj_set_style_line_width(g_sensors_details_ui.chart, 2, LV_PART_ITEMS);
-  lv_obj_set_style_size(g_sensors_details_ui.chart, 5, LV_PART_INDICATOR);
+  /* 曲线直接使用本页的坐标缓存，之后只调整点数与起始位置 */
+  lv_chart_set_ext_y_array(g_sensors_details_ui.chart,
+                           g_sensors_details_ui.series_primary,
+                           primary_coord_buffer);
+  if (g_sensors_details_ui.series_secondary != NULL) {
+    lv_chart_set_ext_y_array(g_sensors_details_ui.chart,
+                             g_sensors_details_ui.series_secondary,
+                             secondary_coord_buffer);
+  }
 
-  /* === 5. 启动定时器 === */
-  g_sensors_details_ui.update_timer =
-      lv_timer_create(sensors_details_update_timer_cb, 500, NULL);
+  lv_obj_add_style(g_sensors_details_ui.chart, ui_style(UI_STYLE_CHART_SERIES),
+                   LV_PART_ITEMS);
+  lv_obj_add_style(g_sensors_details_ui.chart, ui_style(UI_STYLE_CHART_POINT),
+                   LV_PART_INDICATOR);
+
+  /* === 5. 显示当前数据，后续刷新由传感器事件驱动 === */
+  details_load_initial();
 }
 
 /**
@@ -408,10 +978,93 @@ void ui_screen_sensors_details_deinit(void) // [CHANGED] 重命名函数
     ui_comp_header_destroy(g_sensors_details_ui.header);
     g_sensors_details_ui.header = NULL;
   }
+  g_sensors_details_ui.chart = NULL; // 图表随根容器异步删除，手势不再访问
+}
+
+/**
+ * @brief 从缓存中重新显示：补上隐藏期间错过的数据
+ */
+void ui_screen_sensors_details_on_show(void) {
+  ui_comp_header_set_active(g_sensors_details_ui.header, true);
+  details_load_initial();
+}
+
+/**
+ * @brief 隐藏进缓存
+ */
+void ui_screen_sensors_details_on_hide(void) {
+  ui_comp_header_set_active(g_sensors_details_ui.header, false);
+}
+
+/**
+ * @brief 处理传感器快照：只在当前传感器有新数据时刷新界面
+ */
+void ui_screen_sensors_details_on_sensor_event(
+    const SensorSnapshot_t *snapshot) {
+  const SensorEvent_t *event = &snapshot->event;
+
+  if (event->sensor != (SensorHandle_t)g_active_sensor_type) {
+    return;
+  }
+  details_show_anomaly(snapshot->anomaly); // 所有事件都带有当前异常位图
+  if (event->event_type != SENSOR_EVENT_DATA_UPDATE) {
+    return;
+  }
 
-  /* 删除定时器 */
-  if (g_sensors_details_ui.update_timer) {
-    lv_timer_del(g_sensors_details_ui.update_timer);
-    g_sensors_details_ui.update_timer = NULL;
+  details_show_realtime(&event->data);
+  if (snapshot->has_stats) {
+    details_show_stats(&snapshot->stats[0], &snapshot->stats[1]);
   }
+  details_push_history(snapshot);
+}
+
+/**
+ * @brief 处理触摸手势：双指缩放图表 X 轴，长按恢复原始宽度
+ * @details 缩放时调整滚动位置，使两指中点下的数据点保持不动。
+ */
+void ui_screen_sensors_details_on_gesture(const TouchGesture_t *gesture) {
+  lv_obj_t *chart = g_sensors_details_ui.chart;
+  uint32_t zoom;
+
+  if (chart == NULL)
+    return;
+
+  switch (gesture->type) {
+  case TOUCH_GESTURE_PINCH_BEGIN:
+    g_zoom_base = lv_chart_get_zoom_x(chart);
+    return;
+  case TOUCH_GESTURE_PINCH:
+    zoom = ((uint32_t)g_zoom_base * gesture->scale_q8) >> 8;
+    break;
+  case TOUCH_GESTURE_LONG_PRESS:
+    zoom = LV_IMG_ZOOM_NONE;
+    break;
+  default:
+    return;
+  }
+
+  if (zoom < LV_IMG_ZOOM_NONE)
+    zoom = LV_IMG_ZOOM_NONE;
+  if (zoom > DETAILS_CHART_ZOOM_MAX)
+    zoom = DETAILS_CHART_ZOOM_MAX;
+
+  uint16_t old_zoom = lv_chart_get_zoom_x(chart);
+  if (zoom == old_zoom)
+    return;
+
+  lv_coord_t anchor = gesture->x - chart->coords.x1;
+  lv_coord_t scroll_x = lv_obj_get_scroll_x(chart);
+
+  lv_chart_set_zoom_x(chart, (uint16_t)zoom);
+  lv_obj_update_layout(chart);
+  lv_obj_scroll_to_x(
+      chart, (lv_coord_t)((int32_t)(scroll_x + anchor) * (int32_t)zoom /
+                              old_zoom -
+                          anchor),
+      LV_ANIM_OFF);
+
+  /* 绘制宽度变化：汇总曲线按新宽度重新降采样 */
+  if (g_chart_range == DETAILS_RANGE_HOUR ||
+      g_chart_range == DETAILS_RANGE_DAY)
+    details_load_rollup();
 }
@@ -2,6 +2,8 @@
 #define __UI_SCREEN_SENSORS_DETAILS_H
 
 #include "lvgl.h"
+#include "sensor_task.h"
+#include "touch_gesture.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -18,6 +20,24 @@ void ui_screen_sensors_details_init(lv_obj_t* parent);
  */
 void ui_screen_sensors_details_deinit(void);
 
+/**
+ * @brief 屏幕从缓存中重新显示 / 被隐藏进缓存 (由 UI 管理器调用)
+ */
+void ui_screen_sensors_details_on_show(void);
+void ui_screen_sensors_details_on_hide(void);
+
+/**
+ * @brief 处理传感器快照（由 UI 管理器在 LVGL 任务中分发）
+ * @param snapshot 传感器快照
+ */
+void ui_screen_sensors_details_on_sensor_event(const SensorSnapshot_t* snapshot);
+
+/**
+ * @brief 处理触摸手势 (双指缩放图表、长按恢复)，由 UI 管理器在 LVGL 任务中分发
+ * @param gesture 手势 (坐标已换算到当前屏幕方向)
+ */
+void ui_screen_sensors_details_on_gesture(const TouchGesture_t* gesture);
+
 #ifdef __cplusplus
 }
 #endif
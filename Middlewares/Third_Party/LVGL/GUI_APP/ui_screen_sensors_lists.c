@@ -2,27 +2,32 @@
  ******************************************************************************
  * @file    ui_screen_sensors_lists.c
  * @brief   传感器列表页面模块 (动态刷新版)
- * @details 动态创建传感器列表，并定时刷新每个传感器的状态和实时数据。
+ * @details 列表按注册表下标绑定传感器实例，由虚拟列表只创建可见行及少量
+ *          预备行，滚动时复用行对象；定时刷新只重新绑定可见行，对象数与
+ *          刷新开销不随传感器数量增长。
  * @author  MmsY
  * @time    2025/11/23
  ******************************************************************************
  */
 
 #include "ui_screen_sensors_lists.h"
+#include "fmt_fixed.h"
 #include "sensor_task.h"
 #include "ui_comp_header.h" // [NEW] 引入顶部栏组件
 #include "ui_comp_navbar.h"
+#include "ui_comp_vlist.h"
+#include "ui_layout.h"
 #include "ui_manager.h"
+#include "ui_styles.h"
 
 
-LV_FONT_DECLARE(my_font_yahei_24);
-
 /**
  * @brief 传感器列表项UI控件集合
  */
 typedef struct {
   lv_obj_t *container;    // 列表项的根容器
   lv_obj_t *status_led;   // 状态指示灯
+  lv_obj_t *name_label;   // 传感器名称标签
   lv_obj_t *value_label;  // 实时数据显示标签
 } sensors_list_item_ui_t; // [CHANGED] 重命名结构体
 
@@ -30,19 +35,77 @@ typedef struct {
  * @brief 传感器列表页面UI控件集合
  */
 typedef struct {
-  ui_header_t *header;                           // [NEW] 顶部栏组件句柄
-  sensors_list_item_ui_t items[SENSOR_TYPE_MAX]; // [CHANGED] 使用新结构体名
-  lv_timer_t *update_timer;                      // 数据更新定时器
+  ui_header_t *header;                             // [NEW] 顶部栏组件句柄
+  ui_vlist_t *vlist;                               // 虚拟列表
+  sensors_list_item_ui_t items[UI_VLIST_MAX_ROWS]; // 行对象池 (与虚拟列表同下标)
+  lv_timer_t *update_timer;                        // 数据更新定时器
+  uint8_t sensor_count;                            // 列表当前的条目数
 } sensors_lists_ui_t;                            // [NEW] 新增整体UI结构体
 
 /* 全局变量 */
 static sensors_lists_ui_t g_sensors_lists_ui; // [CHANGED] 重命名并使用新结构体
 
+/* -----------------------------------------------------------
+ * 布局描述
+ * ----------------------------------------------------------- */
+
+/* 可滚动的列表容器 (行由虚拟列表绝对定位，不使用 flex) */
+static const ui_layout_node_t s_list_layout = {
+    .type = UI_LAYOUT_OBJ,
+    .style = UI_LAYOUT_STYLE(UI_STYLE_CONTENT),
+    .flags = UI_LAYOUT_F_BARE | UI_LAYOUT_F_GROW,
+    .w = LV_PCT(100)};
+
+#define ITEM_ROW_HEIGHT 70 // 列表项高度
+#define ITEM_OVERSCAN 1    // 可见区域上下各多准备的行数
+
+/* 列表项模板，每个行对象实例化一次 */
+enum {
+  ITEM_NODE_PANEL = 0, // 根容器 (可点击的面板)
+  ITEM_NODE_LED,       // 左侧：状态指示灯
+  ITEM_NODE_NAME,      // 中间：传感器名称 (构建后设置)
+  ITEM_NODE_ARROW,     // 右侧：详情箭头
+  ITEM_NODE_VALUE,     // 右中：实时数值
+  ITEM_NODE_COUNT
+};
+
+static const ui_layout_node_t s_item_layout[ITEM_NODE_COUNT] = {
+    [ITEM_NODE_PANEL] = {.type = UI_LAYOUT_OBJ,
+                         .flags = UI_LAYOUT_F_CLICKABLE,
+                         .w = LV_PCT(100),
+                         .h = ITEM_ROW_HEIGHT},
+    [ITEM_NODE_LED] = {.type = UI_LAYOUT_LED,
+                       .parent = UI_LAYOUT_REF(ITEM_NODE_PANEL),
+                       .align = LV_ALIGN_LEFT_MID,
+                       .x = 15},
+    [ITEM_NODE_NAME] = {.type = UI_LAYOUT_LABEL, // 名称 (绑定时设置)
+                        .parent = UI_LAYOUT_REF(ITEM_NODE_PANEL),
+                        .align = LV_ALIGN_OUT_RIGHT_MID,
+                        .align_to = UI_LAYOUT_REF(ITEM_NODE_LED),
+                        .style = UI_LAYOUT_STYLE(UI_STYLE_TEXT_CN),
+                        .x = 15},
+    [ITEM_NODE_ARROW] = {.type = UI_LAYOUT_LABEL,
+                         .parent = UI_LAYOUT_REF(ITEM_NODE_PANEL),
+                         .align = LV_ALIGN_RIGHT_MID,
+                         .x = -15,
+                         .text = LV_SYMBOL_RIGHT},
+    [ITEM_NODE_VALUE] = {.type = UI_LAYOUT_LABEL,
+                         .parent = UI_LAYOUT_REF(ITEM_NODE_PANEL),
+                         .align = LV_ALIGN_OUT_LEFT_MID,
+                         .align_to = UI_LAYOUT_REF(ITEM_NODE_ARROW),
+                         .x = -15,
+                         .text = "--"},
+};
+
 /* -----------------------------------------------------------
  * 前向声明
  * ----------------------------------------------------------- */
 static void back_btn_event_cb(lv_event_t *e);
 static void sensor_item_click_event_cb(lv_event_t *e);
+static lv_obj_t *sensors_lists_create_row(lv_obj_t *parent, uint8_t slot,
+                                          void *user_data);
+static void sensors_lists_bind_row(uint8_t slot, uint16_t index,
+                                   void *user_data);
 static void
 sensors_lists_update_timer_cb(lv_timer_t *timer); // [CHANGED] 重命名函数
 
@@ -62,68 +125,108 @@ static void back_btn_event_cb(lv_event_t *e) {
  * @brief 列表中某个传感器按钮被点击时的事件回调
  */
 static void sensor_item_click_event_cb(lv_event_t *e) {
-  SensorType_t sensor_type = (SensorType_t)(intptr_t)lv_event_get_user_data(e);
-  ui_set_active_sensor(sensor_type);
+  uint16_t index = ui_comp_vlist_get_index(lv_event_get_current_target(e));
+  SensorHandle_t handle = SensorTask_GetHandleAt((uint8_t)index);
+
+  if (index == UI_VLIST_NONE || handle == SENSOR_HANDLE_INVALID) {
+    return;
+  }
+  /* 详情页按类型显示 */
+  ui_set_active_sensor(SENSOR_HANDLE_TYPE(handle));
   ui_load_screen(UI_SCREEN_SENSORS_DETAILS); // [CHANGED] 使用新的枚举名
 }
 
 /**
- * @brief 定时器回调，用于刷新列表上所有传感器的状态和数据
+ * @brief 虚拟列表创建行对象
  */
-static void
-sensors_lists_update_timer_cb(lv_timer_t *timer) // [CHANGED] 重命名函数
-{
-  (void)timer;
+static lv_obj_t *sensors_lists_create_row(lv_obj_t *parent, uint8_t slot,
+                                          void *user_data) {
+  sensors_list_item_ui_t *item_ui = &g_sensors_lists_ui.items[slot];
+  lv_obj_t *objs[ITEM_NODE_COUNT];
+
+  (void)user_data;
+  ui_layout_build(parent, s_item_layout, ITEM_NODE_COUNT, objs);
+  item_ui->container = objs[ITEM_NODE_PANEL];
+  item_ui->status_led = objs[ITEM_NODE_LED];
+  item_ui->name_label = objs[ITEM_NODE_NAME];
+  item_ui->value_label = objs[ITEM_NODE_VALUE];
+  lv_obj_add_event_cb(item_ui->container, sensor_item_click_event_cb,
+                      LV_EVENT_CLICKED, NULL);
+  return item_ui->container;
+}
+
+/**
+ * @brief 虚拟列表绑定行数据：刷新一个传感器实例的名称、状态和实时数据
+ */
+static void sensors_lists_bind_row(uint8_t slot, uint16_t index,
+                                   void *user_data) {
+  sensors_list_item_ui_t *item_ui = &g_sensors_lists_ui.items[slot];
+  SensorHandle_t handle = SensorTask_GetHandleAt((uint8_t)index);
+  SensorType_t current_type = SENSOR_HANDLE_TYPE(handle);
   SensorData_t data;
-  SensorStatus_t status;
-
-  /* 循环遍历所有传感器 */
-  for (int i = SENSOR_TYPE_NONE + 1; i < SENSOR_TYPE_MAX; i++) {
-    SensorType_t current_type = (SensorType_t)i;
-    sensors_list_item_ui_t *item_ui =
-        &g_sensors_lists_ui.items[current_type]; // [CHANGED] 使用新变量名
-
-    /* 1. 更新状态指示灯 */
-    if (SensorTask_GetSensorStatus(current_type, &status)) {
-      switch (status) {
-      case SENSOR_STATUS_ONLINE:
-        lv_led_set_color(item_ui->status_led,
-                         lv_palette_main(LV_PALETTE_GREEN));
-        break;
-      case SENSOR_STATUS_ERROR:
-        lv_led_set_color(item_ui->status_led, lv_palette_main(LV_PALETTE_RED));
-        break;
-      case SENSOR_STATUS_INITIALIZING:
-        lv_led_set_color(item_ui->status_led,
-                         lv_palette_main(LV_PALETTE_ORANGE));
-        break;
-      case SENSOR_STATUS_OFFLINE:
-      default:
-        lv_led_set_color(item_ui->status_led, lv_palette_main(LV_PALETTE_GREY));
-        break;
-      }
+  SensorStatus_t status = SENSOR_STATUS_OFFLINE;
+  char text[2][FMT_FIXED_BUF_SIZE];
+
+  (void)user_data;
+  lv_label_set_text_static(item_ui->name_label, SensorTask_GetName(handle));
+
+  /* 1. 更新状态指示灯 */
+  if (SensorTask_GetSensorStatus(handle, &status)) {
+    switch (status) {
+    case SENSOR_STATUS_ONLINE:
+      lv_led_set_color(item_ui->status_led, lv_palette_main(LV_PALETTE_GREEN));
+      break;
+    case SENSOR_STATUS_ERROR:
+      lv_led_set_color(item_ui->status_led, lv_palette_main(LV_PALETTE_RED));
+      break;
+    case SENSOR_STATUS_INITIALIZING:
+      lv_led_set_color(item_ui->status_led,
+                       lv_palette_main(LV_PALETTE_ORANGE));
+      break;
+    case SENSOR_STATUS_OFFLINE:
+    default:
+      lv_led_set_color(item_ui->status_led, lv_palette_main(LV_PALETTE_GREY));
+      break;
     }
+  }
 
-    /* 2. 更新实时数据 */
-    if (status == SENSOR_STATUS_ONLINE &&
-        SensorTask_GetSensorData(current_type, &data) && data.is_valid) {
-      if (current_type == SENSOR_TYPE_SHT30) {
-        lv_label_set_text_fmt(item_ui->value_label, "%.1f °C / %.1f %%",
-                              data.values.sht30.temp, data.values.sht30.humi);
-      } else if (current_type == SENSOR_TYPE_GY30) {
-        lv_label_set_text_fmt(item_ui->value_label, "%.0f Lux",
-                              data.values.gy30.lux);
-      } else if (current_type == SENSOR_TYPE_SMOKE) {
-        lv_label_set_text_fmt(item_ui->value_label, "%d PPM",
-                              data.values.smoke.ppm);
-      }
-    } else {
-      /* 如果传感器不在线或数据无效，显示占位符 */
-      lv_label_set_text(item_ui->value_label, "--");
+  /* 2. 更新实时数据 */
+  if (status == SENSOR_STATUS_ONLINE &&
+      SensorTask_GetSensorData(handle, &data) && data.is_valid) {
+    if (current_type == SENSOR_TYPE_SHT30) {
+      lv_label_set_text_fmt(item_ui->value_label, "%s °C / %s %%",
+                            fmt_q1(data.values.sht30.temp, text[0]),
+                            fmt_q1(data.values.sht30.humi, text[1]));
+    } else if (current_type == SENSOR_TYPE_GY30) {
+      lv_label_set_text_fmt(item_ui->value_label, "%s Lux",
+                            fmt_q0(data.values.gy30.lux, text[0]));
+    } else if (current_type == SENSOR_TYPE_SMOKE) {
+      lv_label_set_text_fmt(item_ui->value_label, "%d PPM",
+                            data.values.smoke.ppm);
     }
+  } else {
+    /* 如果传感器不在线或数据无效，显示占位符 */
+    lv_label_set_text(item_ui->value_label, "--");
   }
 }
 
+/**
+ * @brief 定时器回调，只刷新可见行的状态和数据
+ */
+static void
+sensors_lists_update_timer_cb(lv_timer_t *timer) // [CHANGED] 重命名函数
+{
+  (void)timer;
+  /* 显示期间也可能有新实例注册 (重新探测、网关导入的远端传感器) */
+  if (SensorTask_GetSensorCount() != g_sensors_lists_ui.sensor_count) {
+    g_sensors_lists_ui.sensor_count = SensorTask_GetSensorCount();
+    ui_comp_vlist_set_count(g_sensors_lists_ui.vlist,
+                            g_sensors_lists_ui.sensor_count);
+    return;
+  }
+  ui_comp_vlist_refresh(g_sensors_lists_ui.vlist);
+}
+
 /* -----------------------------------------------------------
  * 界面初始化与反初始化
  * ----------------------------------------------------------- */
@@ -146,58 +249,26 @@ void ui_screen_sensors_lists_init(lv_obj_t *parent) // [CHANGED] 重命名函数
                                       .user_data = NULL,
                                       .show_time = true};
 
-  g_sensors_lists_ui.header = ui_comp_header_create(parent, &header_config);
+  g_sensors_lists_ui.header = ui_comp_header_create(&header_config);
 
   /* === 2. 创建一个可滚动的列表容器 === */
-  lv_obj_t *list_container = lv_obj_create(parent);
-  lv_obj_remove_style_all(list_container);
-  lv_obj_set_width(list_container, LV_PCT(100));
-  lv_obj_set_flex_grow(list_container, 1);
-  lv_obj_set_flex_flow(list_container, LV_FLEX_FLOW_COLUMN);
-  lv_obj_set_style_pad_all(list_container, 10, 0);
-  lv_obj_set_style_pad_gap(list_container, 10, 0);
-
-  /* === 3. 动态创建传感器列表项 === */
-  for (int i = SENSOR_TYPE_NONE + 1; i < SENSOR_TYPE_MAX; i++) {
-    SensorType_t current_type = (SensorType_t)i;
-    sensors_list_item_ui_t *item_ui =
-        &g_sensors_lists_ui.items[current_type]; // [CHANGED] 使用新变量名
-
-    /* 创建根容器 (一个可点击的面板) */
-    item_ui->container = lv_obj_create(list_container);
-    lv_obj_set_size(item_ui->container, LV_PCT(100), 70);
-    lv_obj_add_flag(item_ui->container, LV_OBJ_FLAG_CLICKABLE);
-    lv_obj_add_event_cb(item_ui->container, sensor_item_click_event_cb,
-                        LV_EVENT_CLICKED, (void *)(intptr_t)current_type);
-
-    /* 左侧：状态指示灯 */
-    item_ui->status_led = lv_led_create(item_ui->container);
-    lv_obj_align(item_ui->status_led, LV_ALIGN_LEFT_MID, 15, 0);
-    lv_led_on(item_ui->status_led);
-
-    /* 中间：传感器名称 */
-    lv_obj_t *name_label = lv_label_create(item_ui->container);
-    lv_label_set_text(name_label, SensorType_ToString(current_type));
-    lv_obj_set_style_text_font(name_label, &my_font_yahei_24, 0);
-    lv_obj_align_to(name_label, item_ui->status_led, LV_ALIGN_OUT_RIGHT_MID, 15,
-                    0);
-
-    /* 右侧：详情箭头 */
-    lv_obj_t *arrow_label = lv_label_create(item_ui->container);
-    lv_label_set_text(arrow_label, LV_SYMBOL_RIGHT);
-    lv_obj_align(arrow_label, LV_ALIGN_RIGHT_MID, -15, 0);
-
-    /* 右中：实时数值 */
-    item_ui->value_label = lv_label_create(item_ui->container);
-    lv_label_set_text(item_ui->value_label, "--");
-    lv_obj_set_style_text_align(item_ui->value_label, LV_TEXT_ALIGN_RIGHT, 0);
-    lv_obj_align_to(item_ui->value_label, arrow_label, LV_ALIGN_OUT_LEFT_MID,
-                    -15, 0);
-  }
+  lv_obj_t *list_container;
+  ui_layout_build(parent, &s_list_layout, 1, &list_container);
+
+  /* === 3. 虚拟列表：行对象在容器得到尺寸后按可见高度创建 === */
+  ui_vlist_config_t vlist_config = {.row_height = ITEM_ROW_HEIGHT,
+                                    .overscan = ITEM_OVERSCAN,
+                                    .create_cb = sensors_lists_create_row,
+                                    .bind_cb = sensors_lists_bind_row,
+                                    .user_data = NULL};
+
+  g_sensors_lists_ui.vlist = ui_comp_vlist_create(list_container, &vlist_config);
+  g_sensors_lists_ui.sensor_count = SensorTask_GetSensorCount();
+  ui_comp_vlist_set_count(g_sensors_lists_ui.vlist,
+                          g_sensors_lists_ui.sensor_count);
 
   /* === 4. 创建底部导航栏 === */
-  ui_comp_navbar_create(parent,
-                        UI_SCREEN_SENSORS_LISTS); // [CHANGED] 使用新的枚举名
+  ui_comp_navbar_attach(UI_SCREEN_SENSORS_LISTS);
 
   /* === 5. 启动定时器以刷新列表数据 === */
   g_sensors_lists_ui.update_timer =
@@ -222,4 +293,31 @@ void ui_screen_sensors_lists_deinit(void) // [CHANGED] 重命名函数
     lv_timer_del(g_sensors_lists_ui.update_timer);
     g_sensors_lists_ui.update_timer = NULL;
   }
+
+  /* 虚拟列表随容器删除释放 */
+  g_sensors_lists_ui.vlist = NULL;
+}
+
+/**
+ * @brief 从缓存中重新显示：恢复定时器并立即刷新
+ */
+void ui_screen_sensors_lists_on_show(void) {
+  ui_comp_header_set_active(g_sensors_lists_ui.header, true);
+  /* 隐藏期间可能有新实例注册 (重新探测) */
+  g_sensors_lists_ui.sensor_count = SensorTask_GetSensorCount();
+  ui_comp_vlist_set_count(g_sensors_lists_ui.vlist,
+                          g_sensors_lists_ui.sensor_count);
+  if (g_sensors_lists_ui.update_timer) {
+    lv_timer_resume(g_sensors_lists_ui.update_timer);
+  }
+}
+
+/**
+ * @brief 隐藏进缓存：暂停定时器
+ */
+void ui_screen_sensors_lists_on_hide(void) {
+  ui_comp_header_set_active(g_sensors_lists_ui.header, false);
+  if (g_sensors_lists_ui.update_timer) {
+    lv_timer_pause(g_sensors_lists_ui.update_timer);
+  }
 }
@@ -18,6 +18,12 @@ void ui_screen_sensors_lists_init(lv_obj_t* parent);
  */
 void ui_screen_sensors_lists_deinit(void);
 
+/**
+ * @brief Ļӻʾ / ؽ ( UI )
+ */
+void ui_screen_sensors_lists_on_show(void);
+void ui_screen_sensors_lists_on_hide(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,54 @@
+/**
+ ******************************************************************************
+ * @file    ui_static_layer.c
+ * @brief   静态图层实现
+ * @details 快照包含控件的扩展绘制区域，作为背景图居中绘制时与原控件的
+ *          绘制位置一致。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_static_layer.h"
+
+static uint32_t s_used; // 当前快照占用的字节数
+
+static void static_layer_delete_event_cb(lv_event_t *e) {
+  lv_img_dsc_t *dsc = (lv_img_dsc_t *)lv_event_get_user_data(e);
+
+  s_used -= dsc->data_size;
+  lv_snapshot_free(dsc);
+}
+
+/**
+ * @brief 烘焙一个控件
+ */
+bool ui_static_layer_bake(lv_obj_t *obj) {
+  lv_img_dsc_t *dsc;
+  uint32_t size;
+
+  if (obj == NULL || lv_obj_get_child_cnt(obj) > 0) {
+    return false;
+  }
+
+  size = lv_snapshot_buf_size_needed(obj, LV_IMG_CF_TRUE_COLOR_ALPHA);
+  if (size == 0 || s_used + size > UI_STATIC_LAYER_BUDGET) {
+    return false;
+  }
+  dsc = lv_snapshot_take(obj, LV_IMG_CF_TRUE_COLOR_ALPHA);
+  if (dsc == NULL) {
+    return false;
+  }
+  dsc->data_size = size;
+  s_used += size;
+
+  lv_obj_set_style_bg_img_src(obj, dsc, 0);
+  lv_obj_set_style_text_opa(obj, LV_OPA_TRANSP, 0);
+  lv_obj_add_event_cb(obj, static_layer_delete_event_cb, LV_EVENT_DELETE, dsc);
+  return true;
+}
+
+/**
+ * @brief 当前快照占用的字节数
+ */
+uint32_t ui_static_layer_used(void) { return s_used; }
@@ -0,0 +1,38 @@
+/**
+ ******************************************************************************
+ * @file    ui_static_layer.h
+ * @brief   静态图层：把不再变化的控件预渲染为图片
+ * @details 卡片中的标题、单位等标签内容固定，但与相邻数值标签的失效区域
+ *          重叠时 (数值宽度变化引起同一 flex 行重新排列) 每次都要重新查找
+ *          字形、逐像素抗锯齿混合。烘焙后控件用 lv_snapshot 得到的
+ *          TRUE_COLOR_ALPHA 图片作为背景图 (bg_img_src) 绘制，自身文字
+ *          透明度设为 0：尺寸与布局不变，绘制只剩一次图片混合。
+ *          只适用于没有子对象、内容与状态样式不再变化的控件；快照从
+ *          lv_mem 分配，总量受 UI_STATIC_LAYER_BUDGET 限制，超出预算或
+ *          分配失败时控件保持正常绘制。控件删除时自动释放快照。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef UI_STATIC_LAYER_H
+#define UI_STATIC_LAYER_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* --------------------------- 系统配置 --------------------------- */
+#define UI_STATIC_LAYER_BUDGET (12U * 1024U) /* 所有快照占用 lv_mem 的上限 (字节) */
+
+/**
+ * @brief 烘焙一个控件 (需在设置完文字与样式之后调用)
+ * @param obj 控件 (无子对象)
+ * @return true 已改为图片绘制；false 保持正常绘制
+ */
+bool ui_static_layer_bake(lv_obj_t *obj);
+
+/* 当前快照占用的字节数 */
+uint32_t ui_static_layer_used(void);
+
+#endif /* UI_STATIC_LAYER_H */
@@ -0,0 +1,147 @@
+/**
+ ******************************************************************************
+ * @file    ui_styles.c
+ * @brief   各屏幕共用的样式表
+ * @details lv_style_t 本身放在静态存储区，属性表在初始化时从 lv_mem 分配一次，
+ *          之后不再释放。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_styles.h"
+#include "lv_port_draw.h"
+
+LV_FONT_DECLARE(my_font_yahei_24);
+
+/* 顶部栏 / 导航栏背景色 */
+#define HEADER_BG_COLOR 0xF5EFE6
+#define NAVBAR_BG_COLOR 0xF5EFE6
+
+/* 完整档位下导航按钮的圆角与高亮阴影 */
+#define NAV_BTN_RADIUS 8
+#define NAV_BTN_ACTIVE_SHADOW 10
+
+static lv_style_t g_styles[UI_STYLE_MAX];
+static bool g_styles_ready = false;
+static ui_render_profile_t g_render_profile = UI_RENDER_FULL;
+
+/**
+ * @brief 建立样式表
+ */
+void ui_styles_init(void) {
+  lv_style_t *s;
+
+  if (g_styles_ready) {
+    return;
+  }
+  for (uint32_t i = 0; i < UI_STYLE_MAX; i++) {
+    lv_style_init(&g_styles[i]);
+  }
+
+  lv_style_set_text_font(&g_styles[UI_STYLE_TEXT_CN], &my_font_yahei_24);
+
+  s = &g_styles[UI_STYLE_HEADER];
+  lv_style_set_bg_color(s, lv_color_hex(HEADER_BG_COLOR));
+  lv_style_set_bg_opa(s, LV_OPA_COVER);
+  lv_style_set_pad_all(s, 10);
+  lv_style_set_pad_gap(s, 10);
+
+  s = &g_styles[UI_STYLE_NAVBAR];
+  lv_style_set_bg_color(s, lv_color_hex(NAVBAR_BG_COLOR));
+  lv_style_set_bg_opa(s, LV_OPA_COVER);
+  lv_style_set_radius(s, 0);
+  lv_style_set_border_width(s, 0);
+
+  s = &g_styles[UI_STYLE_NAV_BTN];
+  lv_style_set_radius(s, NAV_BTN_RADIUS);
+  lv_style_set_text_font(s, &lv_font_montserrat_28);
+
+  s = &g_styles[UI_STYLE_NAV_BTN_ACTIVE];
+  lv_style_set_outline_width(s, 3);
+  lv_style_set_outline_color(s, lv_color_white());
+  lv_style_set_outline_pad(s, 3);
+  lv_style_set_shadow_width(s, NAV_BTN_ACTIVE_SHADOW);
+
+  s = &g_styles[UI_STYLE_CONTENT];
+  lv_style_set_pad_all(s, 10);
+  lv_style_set_pad_gap(s, 10);
+
+  lv_style_set_pad_gap(&g_styles[UI_STYLE_GAP], 10);
+
+  lv_style_set_pad_all(&g_styles[UI_STYLE_BTN], 8);
+
+  s = &g_styles[UI_STYLE_CHART];
+  lv_style_set_bg_color(s, lv_color_hex(0xFFFFFF));
+  lv_style_set_bg_opa(s, LV_OPA_COVER);
+  lv_style_set_border_width(s, 1);
+  lv_style_set_border_color(s, lv_color_hex(0xCCCCCC));
+  lv_style_set_border_side(s, LV_BORDER_SIDE_LEFT | LV_BORDER_SIDE_BOTTOM);
+  lv_style_set_line_width(s, 1);
+  lv_style_set_line_dash_width(s, 2);
+  lv_style_set_line_dash_gap(s, 2);
+  lv_style_set_line_color(s, lv_color_hex(0xECECEC));
+
+  s = &g_styles[UI_STYLE_CHART_TICKS];
+  lv_style_set_text_font(s, &lv_font_montserrat_14);
+  lv_style_set_text_color(s, lv_color_black());
+
+  lv_style_set_line_width(&g_styles[UI_STYLE_CHART_SERIES], 2);
+
+  lv_style_set_size(&g_styles[UI_STYLE_CHART_POINT], 5);
+
+  lv_style_set_text_font(&g_styles[UI_STYLE_TEXT_16], &lv_font_montserrat_16);
+
+  lv_style_set_text_font(&g_styles[UI_STYLE_TEXT_14], &lv_font_montserrat_14);
+
+  s = &g_styles[UI_STYLE_TABLE_CELL];
+  lv_style_set_text_font(s, &lv_font_montserrat_14);
+  lv_style_set_pad_ver(s, 4);
+
+  g_styles_ready = true;
+}
+
+/**
+ * @brief 获取共享样式
+ */
+lv_style_t *ui_style(ui_style_id_t id) {
+  LV_ASSERT(g_styles_ready && id < UI_STYLE_MAX);
+  return &g_styles[id];
+}
+
+/**
+ * @brief 切换渲染档位
+ * @details 样式表中的圆角与阴影直接改写，引用它们的对象由
+ *          lv_obj_report_style_change 刷新；主题与本地样式的效果由绘图层在
+ *          绘制时去掉，只需重绘。
+ */
+void ui_styles_set_render_profile(ui_render_profile_t profile) {
+  lv_disp_t *disp = lv_disp_get_default();
+  bool fast = profile == UI_RENDER_FAST;
+
+  if (!g_styles_ready || profile >= UI_RENDER_COUNT ||
+      profile == g_render_profile) {
+    return;
+  }
+  g_render_profile = profile;
+
+  lv_style_set_radius(&g_styles[UI_STYLE_NAV_BTN], fast ? 0 : NAV_BTN_RADIUS);
+  lv_style_set_shadow_width(&g_styles[UI_STYLE_NAV_BTN_ACTIVE],
+                            fast ? 0 : NAV_BTN_ACTIVE_SHADOW);
+  lv_obj_report_style_change(&g_styles[UI_STYLE_NAV_BTN]);
+  lv_obj_report_style_change(&g_styles[UI_STYLE_NAV_BTN_ACTIVE]);
+
+  lv_port_draw_set_flat(fast);
+  if (disp != NULL) {
+    disp->driver->antialiasing = fast ? 0 : 1;
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    lv_obj_invalidate(lv_disp_get_layer_top(disp));
+  }
+}
+
+/**
+ * @brief 当前渲染档位
+ */
+ui_render_profile_t ui_styles_get_render_profile(void) {
+  return g_render_profile;
+}
@@ -0,0 +1,61 @@
+/**
+ ******************************************************************************
+ * @file    ui_styles.h
+ * @brief   各屏幕共用的样式表
+ * @details 样式在 ui_init 中一次性建立，之后所有屏幕通过 lv_obj_add_style
+ *          引用同一份 lv_style_t，不再为每个对象分配本地样式：
+ *            - 切换屏幕时少了大量 lv_mem 分配/释放；
+ *            - 共享样式的对象在样式级联时命中同一批指针。
+ *          每个对象各不相同的属性 (颜色、尺寸) 仍用本地样式设置。
+ *          渲染档位 (ui_styles_set_render_profile) 也从这里切换：简化档位
+ *          改写样式表中的圆角与阴影，并让绘图层对所有矩形 (含主题与本地
+ *          样式) 去掉圆角遮罩、阴影、渐变和半透明混合，关闭抗锯齿；
+ *          尺寸相关的属性不变，布局与完整档位一致。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef UI_STYLES_H
+#define UI_STYLES_H
+
+#include "lvgl.h"
+
+typedef enum {
+  UI_STYLE_TEXT_CN = 0,    /* 中文正文字体 (my_font_yahei_24) */
+  UI_STYLE_HEADER,         /* 顶部栏容器 */
+  UI_STYLE_NAVBAR,         /* 底部导航栏容器 */
+  UI_STYLE_NAV_BTN,        /* 导航按钮，图标字体由子标签继承 */
+  UI_STYLE_NAV_BTN_ACTIVE, /* 当前页导航按钮高亮 (阴影颜色随按钮设置) */
+  UI_STYLE_CONTENT,        /* 主内容区：10 px 内边距与间距 */
+  UI_STYLE_GAP,            /* 布局容器：10 px 子元素间距 */
+  UI_STYLE_BTN,            /* 面板内的文字按钮 */
+  UI_STYLE_CHART,          /* 图表背景、边框与分割线 (LV_PART_MAIN) */
+  UI_STYLE_CHART_TICKS,    /* 图表刻度文字 (LV_PART_TICKS) */
+  UI_STYLE_CHART_SERIES,   /* 图表折线 (LV_PART_ITEMS) */
+  UI_STYLE_CHART_POINT,    /* 图表数据点 (LV_PART_INDICATOR) */
+  UI_STYLE_TEXT_16,        /* 英文小字 (lv_font_montserrat_16) */
+  UI_STYLE_TEXT_14,        /* 英文小字 (lv_font_montserrat_14) */
+  UI_STYLE_TABLE_CELL,     /* 表格单元格：14 号字、4 px 上下内边距 (LV_PART_ITEMS) */
+  UI_STYLE_MAX
+} ui_style_id_t;
+
+typedef enum {
+  UI_RENDER_FULL = 0, /* 完整效果 */
+  UI_RENDER_FAST,     /* 简化效果：平面填充，无阴影、圆角、渐变与抗锯齿 */
+  UI_RENDER_COUNT
+} ui_render_profile_t;
+
+/* 建立样式表 (在 lv_init 之后、加载屏幕之前调用，重复调用无效) */
+void ui_styles_init(void);
+
+/* 获取共享样式，返回的指针长期有效，不能修改 */
+lv_style_t *ui_style(ui_style_id_t id);
+
+/* 切换渲染档位 (LVGL 任务上下文，在 ui_styles_init 之后调用)，已显示的对象立即重绘 */
+void ui_styles_set_render_profile(ui_render_profile_t profile);
+
+/* 当前渲染档位 */
+ui_render_profile_t ui_styles_get_render_profile(void);
+
+#endif /* UI_STYLES_H */
@@ -0,0 +1,390 @@
+/**
+ ******************************************************************************
+ * @file    ui_theme.c
+ * @brief   应用主题实现
+ * @details 样式属性表按默认主题的浅色模式、大屏档位 (DISP_LARGE) 展开，
+ *          尺寸按 LV_DPI_DEF 在编译期换算 (同 lv_disp_dpx)。
+ *          常量样式只读：LVGL 接口的参数为 lv_style_t *，添加时去掉 const，
+ *          之后不能对其调用 lv_style_set_*。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_theme.h"
+
+/* 编译期 lv_disp_dpx */
+#define DPX(n) _LV_DPX_CALC(LV_DPI_DEF, n)
+
+#define COLOR_HEX(c)                                                           \
+  LV_COLOR_MAKE((((c) >> 16) & 0xFF), (((c) >> 8) & 0xFF), ((c)&0xFF))
+
+/* 常量属性表条目 */
+#define PROP_NUM(p, v) {.prop = LV_STYLE_##p, .value = {.num = (v)}}
+#define PROP_PTR(p, v) {.prop = LV_STYLE_##p, .value = {.ptr = (v)}}
+#define PROP_COLOR(p, c) {.prop = LV_STYLE_##p, .value = {.color = COLOR_HEX(c)}}
+#define PROP_PAD_ALL(v)                                                        \
+  PROP_NUM(PAD_TOP, v), PROP_NUM(PAD_BOTTOM, v), PROP_NUM(PAD_LEFT, v),        \
+      PROP_NUM(PAD_RIGHT, v)
+#define PROP_PAD_GAP(v) PROP_NUM(PAD_ROW, v), PROP_NUM(PAD_COLUMN, v)
+#define PROP_END {.prop = LV_STYLE_PROP_INV, .value = {.num = 0}}
+
+/* 调色板 (lv_palette_* 的对应值) */
+#define COLOR_PRIMARY 0x2196F3   /* BLUE main */
+#define COLOR_SECONDARY 0xF44336 /* RED main */
+#define COLOR_SCR 0xF5F5F5       /* GREY lighten 4 */
+#define COLOR_CARD 0xFFFFFF
+#define COLOR_TEXT 0x212121      /* GREY darken 4 */
+#define COLOR_GREY 0xE0E0E0      /* GREY lighten 2 */
+#define COLOR_GREY_MAIN 0x9E9E9E /* GREY main */
+
+#define RADIUS_DEFAULT DPX(12)
+#define BORDER_WIDTH DPX(2)
+#define PAD_DEF DPX(24)
+#define PAD_SMALL DPX(14)
+#define PAD_TINY DPX(8)
+
+#define THEME_ADD(obj, style, selector)                                        \
+  lv_obj_add_style((obj), (lv_style_t *)&(style), (selector))
+
+/* -----------------------------------------------------------
+ * 颜色滤镜
+ * ----------------------------------------------------------- */
+
+static lv_color_t pressed_filter_cb(const lv_color_filter_dsc_t *f,
+                                    lv_color_t c, lv_opa_t opa) {
+  LV_UNUSED(f);
+  return lv_color_darken(c, opa);
+}
+
+static lv_color_t disabled_filter_cb(const lv_color_filter_dsc_t *f,
+                                     lv_color_t c, lv_opa_t opa) {
+  LV_UNUSED(f);
+  return lv_color_mix(lv_color_hex(COLOR_GREY), c, opa);
+}
+
+static const lv_color_filter_dsc_t s_pressed_filter = {pressed_filter_cb, NULL};
+static const lv_color_filter_dsc_t s_disabled_filter = {disabled_filter_cb,
+                                                        NULL};
+
+/* -----------------------------------------------------------
+ * 常量样式
+ * ----------------------------------------------------------- */
+
+static const lv_style_const_prop_t scr_props[] = {
+    PROP_NUM(BG_OPA, LV_OPA_COVER), PROP_COLOR(BG_COLOR, COLOR_SCR),
+    PROP_COLOR(TEXT_COLOR, COLOR_TEXT), PROP_PAD_GAP(PAD_SMALL), PROP_END};
+LV_STYLE_CONST_INIT(s_scr, scr_props);
+
+static const lv_style_const_prop_t scrollbar_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_GREY_MAIN), PROP_NUM(RADIUS, LV_RADIUS_CIRCLE),
+    PROP_PAD_ALL(DPX(7)),                  PROP_NUM(WIDTH, DPX(5)),
+    PROP_NUM(BG_OPA, LV_OPA_40),           PROP_END};
+LV_STYLE_CONST_INIT(s_scrollbar, scrollbar_props);
+
+static const lv_style_const_prop_t scrollbar_scrolled_props[] = {
+    PROP_NUM(BG_OPA, LV_OPA_COVER), PROP_END};
+LV_STYLE_CONST_INIT(s_scrollbar_scrolled, scrollbar_scrolled_props);
+
+static const lv_style_const_prop_t card_props[] = {
+    PROP_NUM(RADIUS, RADIUS_DEFAULT),
+    PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_COLOR(BG_COLOR, COLOR_CARD),
+    PROP_COLOR(BORDER_COLOR, COLOR_GREY),
+    PROP_NUM(BORDER_WIDTH, BORDER_WIDTH),
+    PROP_NUM(BORDER_POST, 1),
+    PROP_COLOR(TEXT_COLOR, COLOR_TEXT),
+    PROP_PAD_ALL(PAD_DEF),
+    PROP_PAD_GAP(PAD_SMALL),
+    PROP_COLOR(LINE_COLOR, COLOR_GREY_MAIN),
+    PROP_NUM(LINE_WIDTH, DPX(1)),
+    PROP_END};
+LV_STYLE_CONST_INIT(s_card, card_props);
+
+static const lv_style_const_prop_t btn_props[] = {
+    PROP_NUM(RADIUS, DPX(16)),
+    PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_COLOR(BG_COLOR, COLOR_GREY),
+    PROP_COLOR(SHADOW_COLOR, COLOR_GREY_MAIN),
+    PROP_NUM(SHADOW_WIDTH, DPX(3)),
+    PROP_NUM(SHADOW_OPA, LV_OPA_50),
+    PROP_NUM(SHADOW_OFS_Y, DPX(3)),
+    PROP_COLOR(TEXT_COLOR, COLOR_TEXT),
+    PROP_NUM(PAD_LEFT, PAD_DEF),
+    PROP_NUM(PAD_RIGHT, PAD_DEF),
+    PROP_NUM(PAD_TOP, PAD_SMALL),
+    PROP_NUM(PAD_BOTTOM, PAD_SMALL),
+    PROP_PAD_GAP(DPX(5)),
+    PROP_END};
+LV_STYLE_CONST_INIT(s_btn, btn_props);
+
+static const lv_style_const_prop_t pressed_props[] = {
+    PROP_PTR(COLOR_FILTER_DSC, &s_pressed_filter),
+    PROP_NUM(COLOR_FILTER_OPA, 35), PROP_END};
+LV_STYLE_CONST_INIT(s_pressed, pressed_props);
+
+static const lv_style_const_prop_t disabled_props[] = {
+    PROP_PTR(COLOR_FILTER_DSC, &s_disabled_filter),
+    PROP_NUM(COLOR_FILTER_OPA, LV_OPA_50), PROP_END};
+LV_STYLE_CONST_INIT(s_disabled, disabled_props);
+
+static const lv_style_const_prop_t bg_primary_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_PRIMARY), PROP_COLOR(TEXT_COLOR, 0xFFFFFF),
+    PROP_NUM(BG_OPA, LV_OPA_COVER), PROP_END};
+LV_STYLE_CONST_INIT(s_bg_primary, bg_primary_props);
+
+static const lv_style_const_prop_t bg_primary_muted_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_PRIMARY), PROP_COLOR(TEXT_COLOR, COLOR_PRIMARY),
+    PROP_NUM(BG_OPA, LV_OPA_20), PROP_END};
+LV_STYLE_CONST_INIT(s_bg_primary_muted, bg_primary_muted_props);
+
+static const lv_style_const_prop_t bg_secondary_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_SECONDARY), PROP_COLOR(TEXT_COLOR, 0xFFFFFF),
+    PROP_NUM(BG_OPA, LV_OPA_COVER), PROP_END};
+LV_STYLE_CONST_INIT(s_bg_secondary, bg_secondary_props);
+
+static const lv_style_const_prop_t bg_grey_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_GREY), PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_COLOR(TEXT_COLOR, COLOR_TEXT), PROP_END};
+LV_STYLE_CONST_INIT(s_bg_grey, bg_grey_props);
+
+static const lv_style_const_prop_t bg_white_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_CARD), PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_COLOR(TEXT_COLOR, COLOR_TEXT), PROP_END};
+LV_STYLE_CONST_INIT(s_bg_white, bg_white_props);
+
+static const lv_style_const_prop_t circle_props[] = {
+    PROP_NUM(RADIUS, LV_RADIUS_CIRCLE), PROP_END};
+LV_STYLE_CONST_INIT(s_circle, circle_props);
+
+static const lv_style_const_prop_t knob_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_PRIMARY), PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_PAD_ALL(DPX(6)), PROP_NUM(RADIUS, LV_RADIUS_CIRCLE), PROP_END};
+LV_STYLE_CONST_INIT(s_knob, knob_props);
+
+/* 开关的滑块：白色、比轨道缩进 */
+static const lv_style_const_prop_t switch_knob_props[] = {
+    PROP_COLOR(BG_COLOR, 0xFFFFFF), PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_PAD_ALL(-DPX(4)), PROP_NUM(RADIUS, LV_RADIUS_CIRCLE), PROP_END};
+LV_STYLE_CONST_INIT(s_switch_knob, switch_knob_props);
+
+static const lv_style_const_prop_t switch_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_GREY), PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_NUM(RADIUS, LV_RADIUS_CIRCLE), PROP_NUM(ANIM_TIME, 120), PROP_END};
+LV_STYLE_CONST_INIT(s_switch, switch_props);
+
+static const lv_style_const_prop_t chart_bg_props[] = {
+    PROP_PAD_ALL(PAD_SMALL), PROP_NUM(PAD_ROW, PAD_SMALL),
+    PROP_NUM(PAD_COLUMN, DPX(10)), PROP_NUM(BORDER_POST, 0),
+    PROP_COLOR(LINE_COLOR, COLOR_GREY), PROP_END};
+LV_STYLE_CONST_INIT(s_chart_bg, chart_bg_props);
+
+static const lv_style_const_prop_t chart_series_props[] = {
+    PROP_NUM(LINE_WIDTH, DPX(3)), PROP_NUM(RADIUS, DPX(3)),
+    PROP_NUM(WIDTH, DPX(8)),      PROP_NUM(HEIGHT, DPX(8)),
+    PROP_NUM(PAD_COLUMN, DPX(2)), PROP_END};
+LV_STYLE_CONST_INIT(s_chart_series, chart_series_props);
+
+static const lv_style_const_prop_t chart_indic_props[] = {
+    PROP_NUM(RADIUS, LV_RADIUS_CIRCLE), PROP_NUM(WIDTH, DPX(8)),
+    PROP_NUM(HEIGHT, DPX(8)), PROP_COLOR(BG_COLOR, COLOR_PRIMARY),
+    PROP_NUM(BG_OPA, LV_OPA_COVER), PROP_END};
+LV_STYLE_CONST_INIT(s_chart_indic, chart_indic_props);
+
+static const lv_style_const_prop_t chart_ticks_props[] = {
+    PROP_NUM(LINE_WIDTH, DPX(1)), PROP_COLOR(LINE_COLOR, COLOR_TEXT),
+    PROP_PAD_ALL(DPX(2)), PROP_COLOR(TEXT_COLOR, COLOR_GREY_MAIN), PROP_END};
+LV_STYLE_CONST_INIT(s_chart_ticks, chart_ticks_props);
+
+/* 表格：容器无内边距与圆角，单元格上下分隔线 */
+static const lv_style_const_prop_t table_props[] = {
+    PROP_PAD_ALL(0), PROP_PAD_GAP(0), PROP_NUM(RADIUS, 0), PROP_END};
+LV_STYLE_CONST_INIT(s_table, table_props);
+
+static const lv_style_const_prop_t table_cell_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_CARD),
+    PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_COLOR(TEXT_COLOR, COLOR_TEXT),
+    PROP_NUM(BORDER_WIDTH, DPX(1)),
+    PROP_COLOR(BORDER_COLOR, COLOR_GREY),
+    PROP_NUM(BORDER_SIDE, LV_BORDER_SIDE_TOP | LV_BORDER_SIDE_BOTTOM),
+    PROP_PAD_ALL(PAD_DEF),
+    PROP_PAD_GAP(PAD_DEF),
+    PROP_END};
+LV_STYLE_CONST_INIT(s_table_cell, table_cell_props);
+
+static const lv_style_const_prop_t pad_small_props[] = {
+    PROP_PAD_ALL(PAD_SMALL), PROP_PAD_GAP(PAD_SMALL), PROP_END};
+LV_STYLE_CONST_INIT(s_pad_small, pad_small_props);
+
+static const lv_style_const_prop_t ta_cursor_props[] = {
+    PROP_COLOR(BORDER_COLOR, COLOR_TEXT), PROP_NUM(BORDER_WIDTH, DPX(2)),
+    PROP_NUM(PAD_LEFT, -DPX(1)), PROP_NUM(BORDER_SIDE, LV_BORDER_SIDE_LEFT),
+    PROP_NUM(ANIM_TIME, 400), PROP_END};
+LV_STYLE_CONST_INIT(s_ta_cursor, ta_cursor_props);
+
+static const lv_style_const_prop_t ta_placeholder_props[] = {
+    PROP_COLOR(TEXT_COLOR, 0xBDBDBD), /* GREY lighten 1 */
+    PROP_END};
+LV_STYLE_CONST_INIT(s_ta_placeholder, ta_placeholder_props);
+
+static const lv_style_const_prop_t keyboard_props[] = {
+    PROP_NUM(BG_OPA, LV_OPA_COVER), PROP_COLOR(BG_COLOR, COLOR_SCR),
+    PROP_COLOR(TEXT_COLOR, COLOR_TEXT), PROP_PAD_ALL(PAD_SMALL),
+    PROP_PAD_GAP(PAD_SMALL), PROP_END};
+LV_STYLE_CONST_INIT(s_keyboard, keyboard_props);
+
+/* 键盘按键：白底、无阴影 */
+static const lv_style_const_prop_t keyboard_btn_props[] = {
+    PROP_NUM(RADIUS, RADIUS_DEFAULT),
+    PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_COLOR(BG_COLOR, COLOR_CARD),
+    PROP_COLOR(TEXT_COLOR, COLOR_TEXT),
+    PROP_NUM(PAD_LEFT, PAD_DEF),
+    PROP_NUM(PAD_RIGHT, PAD_DEF),
+    PROP_NUM(PAD_TOP, PAD_SMALL),
+    PROP_NUM(PAD_BOTTOM, PAD_SMALL),
+    PROP_END};
+LV_STYLE_CONST_INIT(s_keyboard_btn, keyboard_btn_props);
+
+static const lv_style_const_prop_t msgbox_props[] = {
+    PROP_NUM(MAX_WIDTH, LV_PCT(100)), PROP_END};
+LV_STYLE_CONST_INIT(s_msgbox, msgbox_props);
+
+static const lv_style_const_prop_t msgbox_btns_props[] = {
+    PROP_PAD_ALL(DPX(4)), PROP_PAD_GAP(DPX(10)), PROP_END};
+LV_STYLE_CONST_INIT(s_msgbox_btns, msgbox_btns_props);
+
+static const lv_style_const_prop_t msgbox_backdrop_props[] = {
+    PROP_COLOR(BG_COLOR, COLOR_GREY_MAIN), PROP_NUM(BG_OPA, LV_OPA_50),
+    PROP_END};
+LV_STYLE_CONST_INIT(s_msgbox_backdrop, msgbox_backdrop_props);
+
+static const lv_style_const_prop_t led_props[] = {
+    PROP_NUM(BG_OPA, LV_OPA_COVER),
+    PROP_COLOR(BG_COLOR, 0xFFFFFF),
+    PROP_COLOR(BG_GRAD_COLOR, COLOR_GREY_MAIN),
+    PROP_NUM(RADIUS, LV_RADIUS_CIRCLE),
+    PROP_NUM(SHADOW_WIDTH, DPX(15)),
+    PROP_COLOR(SHADOW_COLOR, 0xFFFFFF),
+    PROP_NUM(SHADOW_SPREAD, DPX(5)),
+    PROP_END};
+LV_STYLE_CONST_INIT(s_led, led_props);
+
+static lv_theme_t s_theme;
+
+/* -----------------------------------------------------------
+ * 私有函数
+ * ----------------------------------------------------------- */
+
+static void theme_add_scrollbar(lv_obj_t *obj) {
+  THEME_ADD(obj, s_scrollbar, LV_PART_SCROLLBAR);
+  THEME_ADD(obj, s_scrollbar_scrolled, LV_PART_SCROLLBAR | LV_STATE_SCROLLED);
+}
+
+/* 按钮矩阵的按键 (消息框按钮与通用按钮矩阵) */
+static void theme_add_btnm_items(lv_obj_t *obj) {
+  THEME_ADD(obj, s_btn, LV_PART_ITEMS);
+  THEME_ADD(obj, s_pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
+  THEME_ADD(obj, s_disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
+  THEME_ADD(obj, s_bg_primary, LV_PART_ITEMS | LV_STATE_CHECKED);
+}
+
+static void theme_apply(lv_theme_t *th, lv_obj_t *obj) {
+  LV_UNUSED(th);
+
+  if (lv_obj_get_parent(obj) == NULL) {
+    THEME_ADD(obj, s_scr, 0);
+    theme_add_scrollbar(obj);
+    return;
+  }
+
+  if (lv_obj_check_type(obj, &lv_obj_class)) {
+    THEME_ADD(obj, s_card, 0);
+    theme_add_scrollbar(obj);
+  } else if (lv_obj_check_type(obj, &lv_btn_class)) {
+    THEME_ADD(obj, s_btn, 0);
+    THEME_ADD(obj, s_bg_primary, 0);
+    THEME_ADD(obj, s_pressed, LV_STATE_PRESSED);
+    THEME_ADD(obj, s_bg_secondary, LV_STATE_CHECKED);
+    THEME_ADD(obj, s_disabled, LV_STATE_DISABLED);
+  } else if (lv_obj_check_type(obj, &lv_btnmatrix_class)) {
+    if (lv_obj_check_type(lv_obj_get_parent(obj), &lv_msgbox_class)) {
+      THEME_ADD(obj, s_msgbox_btns, 0);
+    } else {
+      THEME_ADD(obj, s_card, 0);
+    }
+    theme_add_btnm_items(obj);
+  } else if (lv_obj_check_type(obj, &lv_slider_class)) {
+    THEME_ADD(obj, s_bg_primary_muted, 0);
+    THEME_ADD(obj, s_circle, 0);
+    THEME_ADD(obj, s_bg_primary, LV_PART_INDICATOR);
+    THEME_ADD(obj, s_circle, LV_PART_INDICATOR);
+    THEME_ADD(obj, s_knob, LV_PART_KNOB);
+  } else if (lv_obj_check_type(obj, &lv_bar_class)) {
+    THEME_ADD(obj, s_bg_primary_muted, 0);
+    THEME_ADD(obj, s_circle, 0);
+    THEME_ADD(obj, s_bg_primary, LV_PART_INDICATOR);
+    THEME_ADD(obj, s_circle, LV_PART_INDICATOR);
+  } else if (lv_obj_check_type(obj, &lv_switch_class)) {
+    THEME_ADD(obj, s_switch, 0);
+    THEME_ADD(obj, s_disabled, LV_STATE_DISABLED);
+    THEME_ADD(obj, s_bg_primary, LV_PART_INDICATOR | LV_STATE_CHECKED);
+    THEME_ADD(obj, s_circle, LV_PART_INDICATOR);
+    THEME_ADD(obj, s_switch_knob, LV_PART_KNOB);
+  } else if (lv_obj_check_type(obj, &lv_chart_class)) {
+    THEME_ADD(obj, s_card, 0);
+    THEME_ADD(obj, s_chart_bg, 0);
+    theme_add_scrollbar(obj);
+    THEME_ADD(obj, s_chart_series, LV_PART_ITEMS);
+    THEME_ADD(obj, s_chart_indic, LV_PART_INDICATOR);
+    THEME_ADD(obj, s_chart_ticks, LV_PART_TICKS);
+    THEME_ADD(obj, s_chart_series, LV_PART_CURSOR);
+  } else if (lv_obj_check_type(obj, &lv_table_class)) {
+    THEME_ADD(obj, s_card, 0);
+    THEME_ADD(obj, s_table, 0);
+    theme_add_scrollbar(obj);
+    THEME_ADD(obj, s_table_cell, LV_PART_ITEMS);
+    THEME_ADD(obj, s_pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
+  } else if (lv_obj_check_type(obj, &lv_textarea_class)) {
+    THEME_ADD(obj, s_card, 0);
+    THEME_ADD(obj, s_pad_small, 0);
+    theme_add_scrollbar(obj);
+    THEME_ADD(obj, s_ta_cursor, LV_PART_CURSOR | LV_STATE_FOCUSED);
+    THEME_ADD(obj, s_ta_placeholder, LV_PART_TEXTAREA_PLACEHOLDER);
+  } else if (lv_obj_check_type(obj, &lv_keyboard_class)) {
+    THEME_ADD(obj, s_keyboard, 0);
+    THEME_ADD(obj, s_keyboard_btn, LV_PART_ITEMS);
+    THEME_ADD(obj, s_disabled, LV_PART_ITEMS | LV_STATE_DISABLED);
+    THEME_ADD(obj, s_pressed, LV_PART_ITEMS | LV_STATE_PRESSED);
+    THEME_ADD(obj, s_bg_grey, LV_PART_ITEMS | LV_STATE_CHECKED);
+  } else if (lv_obj_check_type(obj, &lv_msgbox_class)) {
+    THEME_ADD(obj, s_card, 0);
+    THEME_ADD(obj, s_msgbox, 0);
+  } else if (lv_obj_check_type(obj, &lv_msgbox_backdrop_class)) {
+    THEME_ADD(obj, s_msgbox_backdrop, 0);
+  } else if (lv_obj_check_type(obj, &lv_led_class)) {
+    THEME_ADD(obj, s_led, 0);
+  }
+  /* 标签、图片 (含 GIF)：不挂样式，文字颜色与字体继承父对象 */
+}
+
+/* -----------------------------------------------------------
+ * 公共函数
+ * ----------------------------------------------------------- */
+
+void ui_theme_init(void) {
+  lv_disp_t *disp = lv_disp_get_default();
+
+  if (s_theme.apply_cb != NULL) {
+    return;
+  }
+  s_theme.apply_cb = theme_apply;
+  s_theme.disp = disp;
+  s_theme.color_primary = lv_color_hex(COLOR_PRIMARY);
+  s_theme.color_secondary = lv_color_hex(COLOR_SECONDARY);
+  s_theme.font_small = LV_FONT_DEFAULT;
+  s_theme.font_normal = LV_FONT_DEFAULT;
+  s_theme.font_large = LV_FONT_DEFAULT;
+  lv_disp_set_theme(disp, &s_theme);
+}
@@ -0,0 +1,28 @@
+/**
+ * @file    ui_theme.h
+ * @brief   应用主题 (代替 LVGL 默认主题)
+ * @details 默认主题 (lv_theme_default) 在注册显示时从 lv_mem 分配约 60 个
+ *          lv_style_t 并逐条写入属性，每个新建对象按类型挂上 6~12 个样式
+ *          (含按下过渡、放大、焦点轮廓等本应用用不到的状态)，屏幕随后又
+ *          用共享样式或本地样式覆盖其中大部分。
+ *          本主题只保留应用实际使用的控件与状态：
+ *            1. 样式为 LV_STYLE_CONST_INIT 常量，属性表在 Flash 中，不占
+ *               lv_mem，初始化时也不需要逐条写入；
+ *            2. 每个对象挂的样式更少，创建对象与级联查找属性都更快；
+ *            3. 没有键盘/编码器输入组，去掉 FOCUS_KEY / EDITED 轮廓；
+ *               按下时不再有过渡动画与放大。
+ *          颜色与尺寸取默认主题在本屏幕 (800x480，LV_DPI_DEF) 上的值，
+ *          外观与之前一致。LV_USE_THEME_DEFAULT 已在 lv_conf.h 中关闭。
+ */
+
+#ifndef UI_THEME_H
+#define UI_THEME_H
+
+#include "lvgl.h"
+
+/**
+ * @brief 设置默认显示的主题 (在创建任何屏幕之前调用，重复调用无效)
+ */
+void ui_theme_init(void);
+
+#endif /* UI_THEME_H */
@@ -0,0 +1,62 @@
+/**
+ ******************************************************************************
+ * @file    ui_transition.c
+ * @brief   屏幕切换滑动动画实现
+ * @details 动画只驱动已滑入的宽度，失效区域、刷新裁剪与控制器平移都在
+ *          lv_port_disp 中完成。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ui_transition.h"
+#include "lv_port_disp.h"
+
+static uint8_t s_anim_var; // 动画目标 (只用作标识)
+static bool s_active;
+
+static void transition_anim_exec_cb(void *var, int32_t value) {
+  LV_UNUSED(var);
+  lv_port_disp_slide_step((lv_coord_t)value);
+}
+
+static void transition_anim_ready_cb(lv_anim_t *a) {
+  LV_UNUSED(a);
+  s_active = false;
+  lv_port_disp_slide_end();
+}
+
+/**
+ * @brief 开始滑动
+ */
+bool ui_transition_slide(int8_t dir) {
+  lv_anim_t a;
+
+  ui_transition_cancel();
+  if (!lv_port_disp_slide_begin(dir)) {
+    return false;
+  }
+
+  lv_anim_init(&a);
+  lv_anim_set_var(&a, &s_anim_var);
+  lv_anim_set_exec_cb(&a, transition_anim_exec_cb);
+  lv_anim_set_ready_cb(&a, transition_anim_ready_cb);
+  lv_anim_set_values(&a, 0, lv_disp_get_hor_res(NULL));
+  lv_anim_set_time(&a, UI_TRANSITION_TIME_MS);
+  lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+  lv_anim_start(&a);
+  s_active = true;
+  return true;
+}
+
+/**
+ * @brief 立即结束滑动
+ */
+void ui_transition_cancel(void) {
+  if (!s_active) {
+    return;
+  }
+  s_active = false;
+  lv_anim_del(&s_anim_var, NULL);
+  lv_port_disp_slide_end(); // 未滑完：整屏重绘
+}
@@ -0,0 +1,31 @@
+/**
+ * @file    ui_transition.h
+ * @brief   屏幕切换滑动动画
+ * @details 左右翻页时新页面从一侧滑入。画面平移由 LCD 控制器的垂直滚动区
+ *          完成 (lv_port_disp_slide_*)：每一步只重绘新露出的一条，整个动画
+ *          新页面的每个像素经 FSMC 只写一次，而不是每一步整屏 800x480 重绘。
+ *          当前方向或控制器不支持硬件滚动 (竖屏方向、非 NT35510/ILI9806/
+ *          SSD1963) 时直接显示新页面。屏幕快照滑动需要整屏大小的缓冲区
+ *          (768 KB)，片上 RAM 放不下，不作为后备方案。
+ */
+
+#ifndef UI_TRANSITION_H
+#define UI_TRANSITION_H
+
+#include "lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define UI_TRANSITION_TIME_MS 240 /* 滑动时长 */
+
+/**
+ * @brief 新页面创建之后开始滑动 (上一次未完成的滑动立即结束)
+ * @param dir 1: 新页面从右侧进入 (下一页)，-1: 从左侧进入 (上一页)
+ * @return false 不支持硬件滚动，新页面已直接显示
+ */
+bool ui_transition_slide(int8_t dir);
+
+/* 立即结束正在进行的滑动 */
+void ui_transition_cancel(void);
+
+#endif /* UI_TRANSITION_H */
@@ -9,11 +9,26 @@
  */
 
 #include "sensor_app.h"
+#include "config_store.h"
+#include "devices_manager.h"
+#include "fmt_fixed.h"
+#include "gy30.h"
 #include "gy30_sensor.h"
 #include "i2c_bus_manager.h"
 #include "main.h"
 #include "mq2_sensor.h"
+#include "sensor_adapt.h"
+#include "sensor_alarm.h"
+#include "sensor_anomaly.h"
+#include "sensor_config.h"
+#include "sensor_derived.h"
+#include "sensor_event_bus.h"
+#include "sensor_filter.h"
+#include "sensor_probe.h"
+#include "sensor_quality.h"
+#include "sensor_vent.h"
 #include "sensor_task.h"
+#include "sht30.h"
 #include "sht30_sensor.h"
 #include <stdio.h>
 #include <string.h>
@@ -22,6 +37,110 @@
 #define LOG_MODULE "SensorAPP"
 #include "log.h"
 
+/* --------------------------- 驱动配置 --------------------------- */
+// 由 sensor_config.h 生成，整张表位于 Flash
+static const SensorDriverDesc_t s_sensor_drivers[] = {
+    SENSOR_CONFIG_TABLE(SENSOR_CONFIG_DRIVER)};
+
+/* --------------------------- 告警规则 --------------------------- */
+// 按优先级排列：同时激活时蜂鸣器频率与 LED 颜色取靠前的规则
+static const SensorAlarmRule_t s_alarm_rules[] = {
+    // 烟雾超限：超限的样本上立即鸣响、亮红灯并全速排风
+    {"smoke", SENSOR_TYPE_SMOKE, 0, SENSOR_ALARM_ABOVE, 300.0f, 50.0f, 0,
+     SENSOR_ALARM_ACT_BUZZER | SENSOR_ALARM_ACT_LED | SENSOR_ALARM_ACT_MOTOR,
+     2000, 0xFF0000, 999},
+    // 高温持续 10 s：橙灯并排风
+    {"temp_high", SENSOR_TYPE_SHT30, 0, SENSOR_ALARM_ABOVE, 45.0f, 2.0f, 10000,
+     SENSOR_ALARM_ACT_LED | SENSOR_ALARM_ACT_MOTOR, 0, 0xFF4000, 600},
+    // 烟雾快速上升：未超限前提前预警 (黄灯)
+    {"smoke_rise", SENSOR_TYPE_SMOKE, 0, SENSOR_ALARM_RISE_RATE, 20.0f, 10.0f,
+     0, SENSOR_ALARM_ACT_LED, 0, 0xFFA000, 0},
+    // 温度快速上升 (> 0.5 °C/s 持续 5 s)
+    {"temp_rise", SENSOR_TYPE_SHT30, 0, SENSOR_ALARM_RISE_RATE, 0.5f, 0.2f,
+     5000, SENSOR_ALARM_ACT_BUZZER, 1000, 0, 0},
+};
+
+/* --------------------------- 通风曲线 --------------------------- */
+// 电机处于通风模式时生效，多条曲线取最大速度
+static const SensorVentPoint_t s_vent_smoke_points[] = {
+    {50.0f, 0}, {100.0f, 300}, {300.0f, 999}};
+static const SensorVentPoint_t s_vent_humi_points[] = {
+    {70.0f, 0}, {85.0f, 500}};
+static const SensorVentCurve_t s_vent_curves[] = {
+    {SENSOR_TYPE_SMOKE, 0, 20.0f, s_vent_smoke_points,
+     sizeof(s_vent_smoke_points) / sizeof(s_vent_smoke_points[0])},
+    {SENSOR_TYPE_SHT30, 1, 3.0f, s_vent_humi_points,
+     sizeof(s_vent_humi_points) / sizeof(s_vent_humi_points[0])},
+};
+
+/* --------------------------- 自适应采样 --------------------------- */
+// 配置间隔为平稳状态的基准；信号变化快或接近告警阈值时加速，长期平稳时放慢
+static const SensorAdaptPolicy_t s_adapt_policies[] = {
+    // 烟雾：上升 5 ppm/s 或距告警 100 ppm 以内时 250 ms 采样
+    {SENSOR_TYPE_SMOKE, 0, 5.0f, 100.0f, 250, 8000, 5},
+    // 温度 0.1 °C/s、湿度 1 %RH/s
+    {SENSOR_TYPE_SHT30, 0, 0.1f, 3.0f, 1000, 10000, 5},
+    {SENSOR_TYPE_SHT30, 1, 1.0f, 5.0f, 1000, 10000, 5},
+    // 光照：自动调光在快速变化时需要更密的样本
+    {SENSOR_TYPE_GY30, 0, 50.0f, 0.0f, 500, 5000, 5},
+};
+
+/* --------------------------- 数据质量 --------------------------- */
+// 写入历史之前逐通道检查：范围取器件量程，跳变取一个采样间隔内不可能的变化
+// {传感器, 通道, 下限, 上限, 最大跳变, 尖峰阈值}
+static const SensorQualityRule_t s_quality_rules[] = {
+    {SENSOR_TYPE_SHT30, 0, -40.0f, 125.0f, 5.0f, 1.0f},
+    {SENSOR_TYPE_SHT30, 1, 0.0f, 100.0f, 20.0f, 5.0f},
+    {SENSOR_TYPE_GY30, 0, 0.0f, 65535.0f, 0.0f, 500.0f},
+    // 烟雾不做尖峰滤波与跳变检查，告警须在超限的那个样本上触发
+    {SENSOR_TYPE_SMOKE, 0, 0.0f, 10000.0f, 0.0f, 0.0f},
+};
+
+/* --------------------------- 通道滤波 --------------------------- */
+// 质量检查之后的平滑，配置可由命令行 filter 修改并保存 (按槽位顺序)
+// {传感器, 通道, 定点系数, 默认配置 (中值, 低通, 滑动平均)}
+static const SensorFilterSlot_t s_filter_slots[] = {
+    {SENSOR_TYPE_SHT30, 0, 100, SENSOR_FILTER_SPEC(0, 0, 1)},
+    {SENSOR_TYPE_SHT30, 1, 100, SENSOR_FILTER_SPEC(0, 0, 1)},
+    // 光照：自动调光跟随平滑后的读数，避免灯光随阴影抖动
+    {SENSOR_TYPE_GY30, 0, 10, SENSOR_FILTER_SPEC(1, 0, 2)},
+    // 烟雾默认不滤波，告警须在超限的那个样本上触发
+    {SENSOR_TYPE_SMOKE, 0, 10, SENSOR_FILTER_NONE},
+};
+
+/* --------------------------- 异常检测 --------------------------- */
+// 固定阈值之外的统计检测：尖峰/掉零用 z-score，缓慢漂移用 CUSUM
+static const SensorAnomalyRule_t s_anomaly_rules[] = {
+    // 温湿度跳变 (SHT30 故障时常见单点跳变或卡死后突变)
+    {"temp_spike", SENSOR_TYPE_SHT30, 0, SENSOR_ANOMALY_ZSCORE, 0.05f, 6.0f,
+     0.0f, 0.2f, 30},
+    {"humi_spike", SENSOR_TYPE_SHT30, 1, SENSOR_ANOMALY_ZSCORE, 0.05f, 6.0f,
+     0.0f, 1.0f, 30},
+    // 光照突然掉零或突增
+    {"lux_jump", SENSOR_TYPE_GY30, 0, SENSOR_ANOMALY_ZSCORE, 0.1f, 5.0f, 0.0f,
+     20.0f, 20},
+    // 烟雾基线缓慢抬升 (传感器老化、污染)：慢基线 + 累积和
+    {"smoke_drift", SENSOR_TYPE_SMOKE, 0, SENSOR_ANOMALY_CUSUM, 0.01f, 8.0f,
+     0.5f, 2.0f, 60},
+};
+
+/* --------------------------- 派生通道 --------------------------- */
+// 只在界面或命令行读取时计算，源样本更新前重复读取返回缓存值
+static const SensorDerivedDesc_t s_derived_channels[] = {
+    {"dewpoint", "C", SENSOR_TYPE_SHT30, {0, 1}, 2, SensorDerived_DewPoint},
+    {"heatindex", "C", SENSOR_TYPE_SHT30, {0, 1}, 2, SensorDerived_HeatIndex},
+    {"abshumi", "g/m3", SENSOR_TYPE_SHT30, {0, 1}, 2, SensorDerived_AbsHumidity},
+};
+
+/* --------------------------- 总线探测 --------------------------- */
+// 启动时探测全部地址，未应答的按退避间隔重新探测，插上后自动注册
+static const SensorProbeCandidate_t s_probe_candidates[] = {
+    {SENSOR_TYPE_GY30, BH1750_ADDR_LOW, GY30_Sensor_Attach},
+    {SENSOR_TYPE_GY30, BH1750_ADDR_HIGH, GY30_Sensor_Attach},
+    {SENSOR_TYPE_SHT30, SHT30_DEFAULT_ADDR, SHT30_Sensor_Attach},
+    {SENSOR_TYPE_SHT30, SHT30_ALT_ADDR, SHT30_Sensor_Attach},
+};
+
 /* --------------------------- 事件回调实现 --------------------------- */
 void Sensor_EventCallback(const SensorEvent_t *event) {
   if (event == NULL)
@@ -33,13 +152,16 @@ void Sensor_EventCallback(const SensorEvent_t *event) {
     switch (event->sensor_type) {
     case SENSOR_TYPE_GY30: {
       // 获取光照强度
-      LOG_DEBUG("环境光照强度: %.1f lux", event->data.values.gy30.lux);
+      LOG_DEBUG("环境光照强度: %s lux", FMT_Q1(event->data.values.gy30.lux));
+      // 光照值交给输出控制任务，自动模式下平滑调节 LED 亮度
+      Drivers_RGBLED_AutoAdjust(event->data.values.gy30.lux);
       break;
     }
     case SENSOR_TYPE_SHT30: {
       // 获取温湿度
-      LOG_DEBUG("环境温湿度: %.1f C, %.1f %%RH", event->data.values.sht30.temp,
-                event->data.values.sht30.humi);
+      LOG_DEBUG("环境温湿度: %s C, %s %%RH",
+                FMT_Q1(event->data.values.sht30.temp),
+                FMT_Q1(event->data.values.sht30.humi));
       break;
     }
     case SENSOR_TYPE_SMOKE: {
@@ -66,6 +188,13 @@ void Sensor_EventCallback(const SensorEvent_t *event) {
     LOG_ERROR("传感器错误: 类型=%s", SensorType_ToString(event->sensor_type));
     break;
   }
+  case SENSOR_EVENT_ANOMALY: {
+    // 异常状态变化 (详情已由检测模块记录，这里只给出当前位图)
+    LOG_DEBUG("传感器异常状态变化: 类型=%s, 通道位图=0x%02X",
+              SensorType_ToString(event->sensor_type),
+              SensorAnomaly_GetMask(event->sensor));
+    break;
+  }
   }
 }
 
@@ -77,28 +206,53 @@ void Sensor_System_Init(void) {
     // 1. 初始化传感器任务管理系统
     if (!SensorTask_Init())
       break;
+    if (!SensorTask_SetDrivers(s_sensor_drivers, sizeof(s_sensor_drivers) /
+                                                     sizeof(s_sensor_drivers[0])))
+      break;
 
-    // 2. 注册事件回调函数
-    SensorTask_RegisterEventCallback(Sensor_EventCallback);
+    // 2. 加载质量检查、通道滤波、告警规则、异常检测、通风曲线与自适应采样策略 (在传感器任务中逐样本评估)
+    SensorQuality_SetRules(s_quality_rules, sizeof(s_quality_rules) /
+                                                sizeof(s_quality_rules[0]));
+    SensorFilter_SetSlots(s_filter_slots, sizeof(s_filter_slots) /
+                                              sizeof(s_filter_slots[0]));
+    SensorAlarm_SetRules(s_alarm_rules,
+                         sizeof(s_alarm_rules) / sizeof(s_alarm_rules[0]));
+    SensorAnomaly_SetRules(s_anomaly_rules, sizeof(s_anomaly_rules) /
+                                                sizeof(s_anomaly_rules[0]));
+    SensorVent_SetCurves(s_vent_curves,
+                         sizeof(s_vent_curves) / sizeof(s_vent_curves[0]));
+    SensorAdapt_SetPolicies(s_adapt_policies, sizeof(s_adapt_policies) /
+                                                  sizeof(s_adapt_policies[0]));
+    SensorDerived_SetChannels(s_derived_channels,
+                              sizeof(s_derived_channels) /
+                                  sizeof(s_derived_channels[0]));
 
-    // 3. 等待I2C总线稳定
+    // 订阅传感器事件 (只写异步日志，不会阻塞，直接在传感器任务中回调)
+    SensorEventBus_SubscribeCallback("log", Sensor_EventCallback);
+
+    // 3. 初始化I2C总线互斥锁 (上电稳定时间由传感器任务保证，这里不再等待)
     LOG_INFO("初始化I2C总线互斥锁...");
     if (!I2C_Bus_Manager_Init())
       break;
-    LOG_INFO("等待I2C总线稳定...");
-    osDelay(500);
 
-    // // 4. 注册GY30驱动
-    if (!GY30_Sensor_Register())
+    // 4. 注册MQ-2驱动 (模拟量，不经 I2C 探测)
+    if (!MQ2_Sensor_Register())
       break;
 
-    // // 5. 注册SHT30驱动
-    if (!SHT30_Sensor_Register())
-      break;
+    // 5. 探测 I2C 总线，注册应答的 GY30/SHT30 (之后由监控任务重新探测缺失的地址)
+    SensorProbe_SetCandidates(s_probe_candidates,
+                              sizeof(s_probe_candidates) /
+                                  sizeof(s_probe_candidates[0]));
+    SensorProbe_Scan();
 
-    // 6. 注册MQ-2驱动
-    if (!MQ2_Sensor_Register())
-      break;
+    // 6. 恢复保存的采样间隔 (启动时不在线的传感器使用驱动默认间隔)
+    for (int type = SENSOR_TYPE_GY30; type < SENSOR_TYPE_MAX; type++) {
+      uint32_t interval_ms;
+      if (ConfigStore_Get(CONFIG_KEY_SENSOR_INTERVAL(type), &interval_ms,
+                          sizeof(interval_ms))) {
+        SensorTask_SetUpdateInterval((SensorType_t)type, interval_ms);
+      }
+    }
 
     success = true;
   } while (0);
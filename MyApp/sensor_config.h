@@ -0,0 +1,69 @@
+/**
+ ******************************************************************************
+ * @file    sensor_config.h
+ * @brief   传感器驱动配置表
+ * @details 每种传感器一行：类型、驱动前缀、名称与默认更新间隔。
+ *          驱动前缀 XXX 对应驱动头文件导出的 XXX_Sensor_Callbacks、
+ *          XXX_Sensor_Channels 与 XXX_SENSOR_CHANNEL_COUNT。
+ *          sensor_app.c 以 SENSOR_CONFIG_DRIVER 展开本表，得到放在 Flash 中
+ *          的 const 驱动表；实例注册时只保存指向表项的指针。
+ *          保存过的采样间隔 (ConfigStore) 在启动时覆盖这里的默认值。
+ *          电源域：CubeMX 中把传感器电源开关引脚命名为 SENSOR_PWR_<驱动前缀>
+ *          (推挽输出、默认上电) 后，该传感器在两次采样之间自动断电，
+ *          预热时间见下表；本板传感器直接供电，未定义时为常供电。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_CONFIG_H
+#define __SENSOR_CONFIG_H
+
+#include "gy30_sensor.h"
+#include "mq2_sensor.h"
+#include "sensor_task.h"
+#include "sht30_sensor.h"
+
+/* --------------------------- 电源域 --------------------------- */
+// 上电到可以初始化并得到有效数据的时间 (ms)
+#define GY30_POWER_WARMUP_MS 200   // 上电复位 + 首次高分辨率转换
+#define SHT30_POWER_WARMUP_MS 20   // 上电时间 1.5ms，另加首次测量
+#define MQ2_POWER_WARMUP_MS 20000  // 加热丝稳定 (远长于默认间隔，实际只在长间隔时断电)
+
+#define SENSOR_CONFIG_POWER(drv)                                               \
+  SENSOR_POWER_GPIO(SENSOR_PWR_##drv##_GPIO_Port, SENSOR_PWR_##drv##_Pin,      \
+                    GPIO_PIN_SET, drv##_POWER_WARMUP_MS)
+
+#ifdef SENSOR_PWR_GY30_Pin
+#define GY30_POWER SENSOR_CONFIG_POWER(GY30)
+#else
+#define GY30_POWER SENSOR_POWER_NONE
+#endif
+#ifdef SENSOR_PWR_SHT30_Pin
+#define SHT30_POWER SENSOR_CONFIG_POWER(SHT30)
+#else
+#define SHT30_POWER SENSOR_POWER_NONE
+#endif
+#ifdef SENSOR_PWR_MQ2_Pin
+#define MQ2_POWER SENSOR_CONFIG_POWER(MQ2)
+#else
+#define MQ2_POWER SENSOR_POWER_NONE
+#endif
+
+/* --------------------------- 驱动配置表 --------------------------- */
+// X(类型, 驱动前缀, 名称, 默认更新间隔 ms)，电源域取 <驱动前缀>_POWER
+#define SENSOR_CONFIG_TABLE(X)                                                 \
+  /* 连续模式下读取只是取回结果，较短的间隔让 RGB 灯平滑跟随环境光 */         \
+  X(SENSOR_TYPE_GY30, GY30, "GY30 光照传感器", 1000)                           \
+  /* 周期测量 1 次/秒，间隔须不短于测量周期 */                                 \
+  X(SENSOR_TYPE_SHT30, SHT30, "SHT30 温湿度传感器", 3000)                      \
+  X(SENSOR_TYPE_SMOKE, MQ2, "MQ-2 烟雾传感器", 2000)
+
+/* 展开为一条 SensorDriverDesc_t 初始化项 */
+#define SENSOR_CONFIG_DRIVER(type, drv, name, interval_ms)                     \
+  {(type),                    (name),                                          \
+   &drv##_Sensor_Callbacks,   drv##_Sensor_Channels,                           \
+   drv##_SENSOR_CHANNEL_COUNT, (interval_ms),                                  \
+   drv##_POWER},
+
+#endif /* __SENSOR_CONFIG_H */
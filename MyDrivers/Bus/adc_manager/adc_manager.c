@@ -0,0 +1,283 @@
+/**
+ * @file adc_manager.c
+ * @brief ADC1 连续采样服务源文件
+ * @author MmsY
+ * @date 2025
+ */
+
+#include "adc_manager.h"
+#include "dsp_q15.h"
+#include <string.h>
+
+/* --------------------------- 日志配置 --------------------------- */
+#define LOG_MODULE "ADC_MGR"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define ADC_MANAGER_BLOCK_LEN   (ADC_MANAGER_BLOCK_SCANS * ADC_MANAGER_CH_COUNT)
+#define ADC_MANAGER_RING_LEN    (ADC_MANAGER_BLOCK_LEN * 2)    // 前半块 + 后半块
+
+// 出厂校准值 (系统存储区，VDDA = 3.3 V 时测得)
+#define ADC_VREFINT_CAL         (*(const uint16_t *)0x1FFF7A2AU)   // 30 °C 时的 VREFINT 读数
+#define ADC_TS_CAL1             (*(const uint16_t *)0x1FFF7A2CU)   // 30 °C 时的温度传感器读数
+#define ADC_TS_CAL2             (*(const uint16_t *)0x1FFF7A2EU)   // 110 °C 时的温度传感器读数
+#define ADC_TS_CAL1_C10         300
+#define ADC_TS_CAL2_C10         1100
+// 校准值缺失时使用数据手册典型值：V25 = 0.76 V，斜率 2.5 mV/°C
+#define ADC_TS_V25_MV           760
+#define ADC_TS_SLOPE_UV         2500
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+    uint32_t channel;       // ADC_CHANNEL_x
+    uint32_t sample_time;   // ADC_SAMPLETIME_x
+    uint8_t decim;          // 抽取块数
+    uint8_t flags;          // ADC_MANAGER_F_x
+} ADC_Manager_ChannelDef_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+#define ADC_MANAGER_CH_DEF(name, channel, sample_time, decim, flags) {channel, sample_time, decim, flags},
+static const ADC_Manager_ChannelDef_t s_channels[ADC_MANAGER_CH_COUNT] = {
+    ADC_MANAGER_CHANNELS(ADC_MANAGER_CH_DEF)
+};
+#undef ADC_MANAGER_CH_DEF
+
+// DMA 环形缓冲区：按扫描顺序交错存放 {通道0, 通道1, ..., 通道0, ...}
+static uint16_t s_ring[ADC_MANAGER_RING_LEN];
+// 抽取累加器 (只在DMA中断中访问)
+static uint32_t s_acc[ADC_MANAGER_CH_COUNT];
+static uint8_t s_acc_blocks[ADC_MANAGER_CH_COUNT];
+// 双缓冲快照：中断写入 s_snap[s_snap_idx ^ 1] 后切换索引
+static ADC_Manager_Snapshot_t s_snap[2];
+static volatile uint8_t s_snap_idx = 0;
+static volatile uint32_t s_unpublished;     // 尚未发布过的通道 (位图)
+static volatile uint32_t s_block_count = 0;
+static bool s_started = false;
+static uint16_t s_vrefint_cal;              // 启动时读出的 VREFINT 校准值 (无效时为 0)
+static volatile ADC_Manager_BlockHook_t s_block_hook;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 按注册表配置规则组 (覆盖 CubeMX 生成的通道与 Rank)
+ */
+static bool ADC_Manager_ConfigChannels(void) {
+    ADC_ChannelConfTypeDef config = {0};
+
+    ADC_MANAGER_HANDLE->Init.NbrOfConversion = ADC_MANAGER_CH_COUNT;
+    if (HAL_ADC_Init(ADC_MANAGER_HANDLE) != HAL_OK) {
+        return false;
+    }
+    for (uint32_t ch = 0; ch < ADC_MANAGER_CH_COUNT; ch++) {
+        config.Channel = s_channels[ch].channel;
+        config.Rank = ch + 1;
+        config.SamplingTime = s_channels[ch].sample_time;
+        if (HAL_ADC_ConfigChannel(ADC_MANAGER_HANDLE, &config) != HAL_OK) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 对半个环形缓冲区做块平均并发布结果 (在DMA中断中调用)
+ * @details 两个通道时每次扫描正好是一个 32 位字，用 SIMD 并行累加
+ */
+static void ADC_Manager_ProcessBlock(const uint16_t *block) {
+    uint32_t sum[ADC_MANAGER_CH_COUNT] = {0};
+    const ADC_Manager_Snapshot_t *cur = &s_snap[s_snap_idx];
+    ADC_Manager_Snapshot_t *next = &s_snap[s_snap_idx ^ 1U];
+    uint32_t unpublished = s_unpublished;
+    uint32_t published = 0;
+    uint32_t vref;
+
+    if (ADC_MANAGER_CH_COUNT == 2) {
+        DSP_SumPairsU12(block, ADC_MANAGER_BLOCK_SCANS, sum);
+    } else {
+        for (uint32_t i = 0; i < ADC_MANAGER_BLOCK_LEN; i += ADC_MANAGER_CH_COUNT) {
+            for (uint32_t ch = 0; ch < ADC_MANAGER_CH_COUNT; ch++) {
+                sum[ch] += block[i + ch];
+            }
+        }
+    }
+
+    *next = *cur;
+    for (uint32_t ch = 0; ch < ADC_MANAGER_CH_COUNT; ch++) {
+        uint32_t n;
+
+        s_acc[ch] += sum[ch];
+        if (++s_acc_blocks[ch] < s_channels[ch].decim) {
+            continue;
+        }
+        // 四舍五入到 12 位
+        n = (uint32_t)s_acc_blocks[ch] * ADC_MANAGER_BLOCK_SCANS;
+        sum[ch] = (s_acc[ch] + n / 2) / n;
+        s_acc[ch] = 0;
+        s_acc_blocks[ch] = 0;
+        published |= 1UL << ch;
+        if (ch == ADC_MANAGER_CH_VREFINT) {
+            next->value[ch] = (uint16_t)sum[ch];
+        }
+    }
+
+    // 比例修正使用本次快照中的 VREFINT (先于其他通道更新)
+    vref = next->value[ADC_MANAGER_CH_VREFINT];
+    for (uint32_t ch = 0; ch < ADC_MANAGER_CH_COUNT; ch++) {
+        uint32_t v = sum[ch];
+
+        if ((published & (1UL << ch)) == 0 || ch == ADC_MANAGER_CH_VREFINT) {
+            continue;
+        }
+        if ((s_channels[ch].flags & ADC_MANAGER_F_VREF) && vref != 0 && s_vrefint_cal != 0) {
+            v = (v * s_vrefint_cal + vref / 2) / vref;
+            if (v > 4095U) {
+                v = 4095U;
+            }
+        }
+        next->value[ch] = (uint16_t)v;
+    }
+    unpublished &= ~published;
+    next->block = s_block_count + 1;
+
+    __DMB(); // 快照内容先于索引可见
+    s_snap_idx ^= 1U;
+    s_unpublished = unpublished;
+    s_block_count++;
+
+    ADC_Manager_BlockHook_t hook = s_block_hook;
+    if (hook != NULL) {
+        hook(s_block_count);
+    }
+}
+
+/* --------------------------- 接口函数 --------------------------- */
+
+bool ADC_Manager_Init(void) {
+    if (s_started) {
+        return true;
+    }
+
+    memset(s_ring, 0, sizeof(s_ring));
+    memset(s_snap, 0, sizeof(s_snap));
+    memset(s_acc, 0, sizeof(s_acc));
+    memset(s_acc_blocks, 0, sizeof(s_acc_blocks));
+    s_unpublished = (1UL << ADC_MANAGER_CH_COUNT) - 1U;
+    s_block_count = 0;
+
+    // 校准值应在标称 1.21 V 附近 (约 1500)，超出范围时不做修正
+    s_vrefint_cal = ADC_VREFINT_CAL;
+    if (s_vrefint_cal < 1300U || s_vrefint_cal > 1700U) {
+        LOG_WARN("VREFINT 校准值无效 (%u)，不做比例修正", s_vrefint_cal);
+        s_vrefint_cal = 0;
+    }
+
+    if (!ADC_Manager_ConfigChannels()) {
+        LOG_ERROR("配置ADC规则组失败");
+        return false;
+    }
+
+    if (HAL_ADC_Start_DMA(ADC_MANAGER_HANDLE, (uint32_t *)s_ring, ADC_MANAGER_RING_LEN) != HAL_OK) {
+        LOG_ERROR("启动ADC循环DMA失败");
+        return false;
+    }
+
+    // 计数器可能已由 RGB 灯的 PWM 启动，这里只确保它在运行
+    __HAL_TIM_ENABLE(ADC_MANAGER_TRIGGER_TIM);
+
+    s_started = true;
+    LOG_INFO("ADC连续采样已启动: %d Hz, %d 通道, 每块 %d 次扫描", ADC_MANAGER_SAMPLE_RATE_HZ,
+             ADC_MANAGER_CH_COUNT, ADC_MANAGER_BLOCK_SCANS);
+    return true;
+}
+
+bool ADC_Manager_IsReady(void) {
+    return s_started && s_unpublished == 0;
+}
+
+uint16_t ADC_Manager_GetValue(ADC_Manager_Channel_t channel) {
+    if (channel >= ADC_MANAGER_CH_COUNT) {
+        return 0;
+    }
+    return s_snap[s_snap_idx].value[channel];
+}
+
+bool ADC_Manager_GetSnapshot(ADC_Manager_Snapshot_t *snap) {
+    uint8_t idx;
+
+    if (snap == NULL) {
+        return false;
+    }
+    // 拷贝期间发生切换 (中断写完另一份) 时重新拷贝；同一份至少两个块周期后才会被覆盖
+    do {
+        idx = s_snap_idx;
+        *snap = s_snap[idx];
+        __DMB();
+    } while (idx != s_snap_idx);
+
+    return ADC_Manager_IsReady();
+}
+
+uint16_t ADC_Manager_GetVddaMv(void) {
+    uint16_t vref = s_snap[s_snap_idx].value[ADC_MANAGER_CH_VREFINT];
+
+    if (vref == 0 || s_vrefint_cal == 0) {
+        return ADC_MANAGER_VDDA_NOMINAL_MV;
+    }
+    return (uint16_t)(((uint32_t)ADC_MANAGER_VDDA_NOMINAL_MV * s_vrefint_cal + vref / 2) / vref);
+}
+
+int16_t ADC_Manager_GetDieTempC10(void) {
+    // 修正后的读数等效于 VDDA = 3.3 V，与出厂校准条件一致
+    int32_t raw = s_snap[s_snap_idx].value[ADC_MANAGER_CH_TEMP];
+    int32_t cal1 = ADC_TS_CAL1;
+    int32_t cal2 = ADC_TS_CAL2;
+    int32_t mv;
+
+    if (raw == 0) {
+        return 0;
+    }
+    if (cal2 > cal1 && cal1 > 0 && cal2 < 4095) {
+        return (int16_t)(ADC_TS_CAL1_C10 +
+                         (raw - cal1) * (ADC_TS_CAL2_C10 - ADC_TS_CAL1_C10) / (cal2 - cal1));
+    }
+    mv = raw * ADC_MANAGER_VDDA_NOMINAL_MV / 4095;
+    return (int16_t)(250 + (mv - ADC_TS_V25_MV) * 10000 / ADC_TS_SLOPE_UV);
+}
+
+uint32_t ADC_Manager_GetBlockCount(void) {
+    return s_block_count;
+}
+
+void ADC_Manager_SetBlockHook(ADC_Manager_BlockHook_t hook) {
+    s_block_hook = hook;
+}
+
+/* --------------------------- HAL 回调 --------------------------- */
+
+/**
+ * @brief DMA 半传输完成：前半块已写满，DMA 正在写后半块
+ */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc) {
+    if (hadc == ADC_MANAGER_HANDLE) {
+        ADC_Manager_ProcessBlock(&s_ring[0]);
+    }
+}
+
+/**
+ * @brief DMA 传输完成：后半块已写满，DMA 回绕到前半块
+ */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc) {
+    if (hadc == ADC_MANAGER_HANDLE) {
+#if LOG_ISR_TRACE
+        uint32_t start = log_cycles();
+#endif
+        ADC_Manager_ProcessBlock(&s_ring[ADC_MANAGER_BLOCK_LEN]);
+#if LOG_ISR_TRACE
+        // 约每秒一次：块平均耗时 (周期数)
+        if ((s_block_count & 0x1F) == 0) {
+            LOG_ISR("block %lu processed in %lu cycles", s_block_count,
+                    log_cycles() - start, 0);
+        }
+#endif
+    }
+}
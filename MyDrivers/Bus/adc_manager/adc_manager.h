@@ -0,0 +1,145 @@
+/**
+ * @file adc_manager.h
+ * @brief ADC1 连续采样服务头文件
+ * @details TIM2 更新事件 (TRGO) 以固定频率触发 ADC1 扫描转换，DMA 以循环模式
+ *          写入一个可容纳 2 个数据块的环形缓冲区。DMA 半传输/传输完成中断中
+ *          对刚写满的一半做块平均 (过采样)，按通道的抽取块数累加后发布，
+ *          读取方无需等待或访问 DMA 缓冲区。
+ *          通道在 ADC_MANAGER_CHANNELS 中注册：表的顺序即扫描顺序 (Rank)，
+ *          ADC_Manager_Init 按表重新配置规则组，新增通道不需要改动下标。
+ *          发布结果为双缓冲快照：中断写入不在使用的一份后切换索引，
+ *          ADC_Manager_GetSnapshot 拿到的所有通道来自同一次发布。
+ *          扫描中包含内部参考电压 VREFINT 与芯片温度传感器：标记
+ *          ADC_MANAGER_F_VREF 的通道在发布时按 VREFINT 的出厂校准值做比例
+ *          修正，结果等效于 VDDA 恰为 3.3 V 时的读数，背光、电机负载引起的
+ *          电源跌落不再改变换算出的电压；由 VDDA 供电的分压 (电位器) 本身
+ *          与 VDDA 成比例，不做修正。
+ * @author MmsY
+ * @date 2025
+ */
+
+#ifndef __ADC_MANAGER_H
+#define __ADC_MANAGER_H
+
+#include "main.h"
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 配置 --------------------------- */
+extern ADC_HandleTypeDef hadc1;
+extern TIM_HandleTypeDef htim2;
+#define ADC_MANAGER_HANDLE          (&hadc1)    // 扫描转换的ADC句柄
+#define ADC_MANAGER_TRIGGER_TIM     (&htim2)    // 触发定时器 (与RGB灯PWM共用，TRGO=更新事件)
+#define ADC_MANAGER_SAMPLE_RATE_HZ  1000        // 扫描频率，由 TIM2 的 PSC/ARR 决定
+#define ADC_MANAGER_BLOCK_SCANS     32          // 每个数据块的扫描次数 (块平均长度)
+
+// 每个数据块的时长 (ms)，即滤波结果的刷新周期
+#define ADC_MANAGER_BLOCK_MS \
+    ((ADC_MANAGER_BLOCK_SCANS * 1000U + ADC_MANAGER_SAMPLE_RATE_HZ - 1) / ADC_MANAGER_SAMPLE_RATE_HZ)
+
+#define ADC_MANAGER_VDDA_NOMINAL_MV 3300        // 出厂校准时的 VDDA，修正后的读数以此为满量程
+
+// 通道标志
+#define ADC_MANAGER_F_VREF          0x01U       // 按 VREFINT 做比例修正 (信号与 VDDA 无关时使用)
+
+/**
+ * @brief 通道注册表 X(名称, ADC 通道, 采样时间, 抽取块数, 标志)
+ * @note  抽取块数 N：发布值为最近 N 个数据块的平均 (N * BLOCK_SCANS 次过采样)，
+ *        刷新周期 N * ADC_MANAGER_BLOCK_MS；变化慢、噪声大的通道取大值。
+ *        外部引脚须在 HAL_ADC_MspInit 中配置为模拟输入。
+ *        内部通道要求采样时间不短于 10 us (480 周期 / 21 MHz 约 23 us)。
+ *        VREFINT 与 TEMP 两个内部通道由本模块使用，不能删除。
+ */
+#define ADC_MANAGER_CHANNELS(X)                                                                     \
+    X(MQ2,     ADC_CHANNEL_3,          ADC_SAMPLETIME_144CYCLES, 4, ADC_MANAGER_F_VREF) /* PA3 MQ-2 */ \
+    X(POT,     ADC_CHANNEL_4,          ADC_SAMPLETIME_144CYCLES, 1, 0)          /* PA4 电位器 */      \
+    X(VREFINT, ADC_CHANNEL_VREFINT,    ADC_SAMPLETIME_480CYCLES, 4, 0)          /* 内部参考电压 */    \
+    X(TEMP,    ADC_CHANNEL_TEMPSENSOR, ADC_SAMPLETIME_480CYCLES, 8, ADC_MANAGER_F_VREF) /* 芯片温度 */
+
+/* --------------------------- 数据类型 --------------------------- */
+/**
+ * @brief ADC 逻辑通道 (由注册表生成，顺序即扫描顺序)
+ */
+#define ADC_MANAGER_CH_ENUM(name, channel, sample_time, decim, flags) ADC_MANAGER_CH_##name,
+typedef enum {
+    ADC_MANAGER_CHANNELS(ADC_MANAGER_CH_ENUM)
+    ADC_MANAGER_CH_COUNT
+} ADC_Manager_Channel_t;
+#undef ADC_MANAGER_CH_ENUM
+
+/**
+ * @brief 所有通道的一致快照
+ */
+typedef struct {
+    uint16_t value[ADC_MANAGER_CH_COUNT];   // 各通道滤波值 (12 位，F_VREF 通道已修正)
+    uint32_t block;                         // 发布时的数据块计数
+} ADC_Manager_Snapshot_t;
+
+/**
+ * @brief 数据块钩子 (在DMA中断中、快照发布之后调用)
+ * @param block 刚发布的数据块计数
+ * @note  数据块由 TIM2 的 TRGO 计数，钩子的调用时刻即硬件采样节拍，
+ *        可作为其他采集的同步时基；钩子中只能做中断安全的短操作
+ */
+typedef void (*ADC_Manager_BlockHook_t)(uint32_t block);
+
+/* --------------------------- 接口函数 --------------------------- */
+
+/**
+ * @brief 启动连续采样 (启动 DMA 循环传输与触发定时器)
+ * @note  需在 MX_ADC1_Init / MX_TIM2_Init 之后调用。RGB 灯若停止 TIM2 的全部
+ *        PWM 通道，HAL 会同时关闭计数器，采样也随之停止。
+ * @return true: 启动成功 (重复调用直接返回 true)
+ */
+bool ADC_Manager_Init(void);
+
+/**
+ * @brief 是否所有通道都已发布过 (抽取块数最大的通道决定就绪时间)
+ */
+bool ADC_Manager_IsReady(void);
+
+/**
+ * @brief 读取通道的滤波值 (块平均后的 12 位结果，0-4095，F_VREF 通道已修正)
+ * @note  可在任意任务中调用，不阻塞。尚未就绪时返回 0。
+ */
+uint16_t ADC_Manager_GetValue(ADC_Manager_Channel_t channel);
+
+/**
+ * @brief 读取所有通道的一致快照 (来自同一次发布)
+ * @note  可在任意任务中调用，不阻塞
+ * @return false: 尚未就绪 (snap 内容为当前已发布的值，未发布的通道为 0)
+ */
+bool ADC_Manager_GetSnapshot(ADC_Manager_Snapshot_t *snap);
+
+/**
+ * @brief 由 VREFINT 换算的模拟电源电压 (mV)
+ * @return 尚未就绪时返回 ADC_MANAGER_VDDA_NOMINAL_MV
+ */
+uint16_t ADC_Manager_GetVddaMv(void);
+
+/**
+ * @brief 芯片温度 (0.1 °C，按出厂两点校准值换算)
+ * @note  反映芯片自身发热，不代表环境温度，只用于诊断
+ * @return 尚未就绪时返回 0
+ */
+int16_t ADC_Manager_GetDieTempC10(void);
+
+/**
+ * @brief 已发布的数据块计数 (可用于判断数据是否更新)
+ */
+uint32_t ADC_Manager_GetBlockCount(void);
+
+/**
+ * @brief 设置数据块钩子 (只有一个，NULL 表示取消)
+ */
+void ADC_Manager_SetBlockHook(ADC_Manager_BlockHook_t hook);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __ADC_MANAGER_H */
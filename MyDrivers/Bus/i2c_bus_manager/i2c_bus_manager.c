@@ -1,18 +1,72 @@
 #include "i2c_bus_manager.h"
+#include "metrics.h"
+#include "mydelay.h"
+#include "touch_bus.h"
+#include <string.h>
 
 #define LOG_MODULE "I2C_MUTEXID"
 #include "log.h"
 
 // 定义私有的互斥锁句柄和定义
 static osMutexId i2c_mutex_handle = NULL;
-static osMutexDef(i2c_mutex);
+static osStaticMutexDef_t i2c_mutex_cb;
+static osMutexStaticDef(i2c_mutex, &i2c_mutex_cb);
+
+// 总线服务：唯一的总线使用者，按优先级依次执行提交的事务
+static osThreadId bus_task_handle = NULL;
+static QueueHandle_t bus_queue = NULL;                          // 提交队列 (事务指针)
+static uint32_t bus_task_stack[I2C_BUS_TASK_STACK_SIZE];        // 任务与队列静态分配
+static osStaticThreadDef_t bus_task_tcb;
+static StaticQueue_t bus_queue_buf;
+static uint8_t bus_queue_storage[I2C_BUS_QUEUE_LEN * sizeof(I2C_Transaction_t *)];
+static I2C_Transaction_t *pending_head[I2C_PRIORITY_MAX];       // 各优先级待执行链表
+static I2C_Transaction_t *pending_tail[I2C_PRIORITY_MAX];
+static I2C_Transaction_t *parked[I2C_BUS_MAX_PARKED];           // 已写入、等待读取的事务
+static I2C_BusStats_t bus_stats;
+
+// 当前中断传输的上下文 (只有持有总线锁的一方会发起，同一时刻最多一笔)
+static I2C_HandleTypeDef *xfer_hi2c = NULL;     // 正在传输的总线句柄
+static TaskHandle_t xfer_task = NULL;           // 等待传输完成的任务
+static volatile HAL_StatusTypeDef xfer_status = HAL_OK;
+
+static void I2C_Bus_ServerTask(void const *argument);
+static void I2C_Bus_AppendPending(I2C_Transaction_t *transaction);
+static I2C_Transaction_t *I2C_Bus_PopPending(void);
+static bool I2C_Bus_Park(I2C_Transaction_t *transaction);
+static I2C_Transaction_t *I2C_Bus_TakeDueParked(uint32_t *wait_ms);
+static void I2C_Bus_RunFirstPhase(I2C_Transaction_t *transaction, bool allow_park);
+static HAL_StatusTypeDef I2C_Bus_RunPhase(I2C_Transaction_t *transaction, bool is_read);
+static void I2C_Bus_Complete(I2C_Transaction_t *transaction, HAL_StatusTypeDef status);
+static HAL_StatusTypeDef I2C_Bus_Transfer(I2C_HandleTypeDef *hi2c, uint16_t dev_addr,
+                                          uint8_t *data, uint16_t size,
+                                          uint32_t timeout_ms, bool is_read);
+static HAL_StatusTypeDef I2C_Bus_TransferOnce(I2C_HandleTypeDef *hi2c, uint16_t dev_addr,
+                                              uint8_t *data, uint16_t size,
+                                              uint32_t timeout_ms, bool is_read);
+static bool I2C_Bus_IsStuck(HAL_StatusTypeDef status);
+static bool I2C_Bus_Recover(I2C_HandleTypeDef *hi2c);
+static void I2C_Bus_CompleteFromISR(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status);
 
 bool I2C_Bus_Manager_Init(void)
 {
     if (i2c_mutex_handle == NULL) {
         i2c_mutex_handle = osMutexCreate(osMutex(i2c_mutex));
+        TaskPlan_WatchMutex(i2c_mutex_handle, "i2c", 10);
+    }
+    if (bus_queue == NULL) {
+        bus_queue = xQueueCreateStatic(I2C_BUS_QUEUE_LEN, sizeof(I2C_Transaction_t *),
+                                       bus_queue_storage, &bus_queue_buf);
+    }
+    if (i2c_mutex_handle == NULL || bus_queue == NULL) {
+        return false;
     }
-    return (i2c_mutex_handle != NULL);
+
+    if (bus_task_handle == NULL) {
+        osThreadStaticDef(i2cBusTask, I2C_Bus_ServerTask, I2C_BUS_TASK_PRIORITY, 0,
+                          I2C_BUS_TASK_STACK_SIZE, bus_task_stack, &bus_task_tcb);
+        bus_task_handle = osThreadCreate(osThread(i2cBusTask), NULL);
+    }
+    return (bus_task_handle != NULL);
 }
 
 bool I2C_Bus_Lock(uint32_t timeout_ms)
@@ -34,3 +88,498 @@ void I2C_Bus_Unlock(void)
         osMutexRelease(i2c_mutex_handle);
     }
 }
+
+void I2C_Transaction_Init(I2C_Transaction_t *transaction, uint8_t addr)
+{
+    memset(transaction, 0, sizeof(I2C_Transaction_t));
+    transaction->addr = addr;
+    transaction->timeout_ms = I2C_BUS_DEFAULT_TIMEOUT_MS;
+    transaction->priority = I2C_PRIORITY_NORMAL;
+    transaction->status = HAL_ERROR;
+}
+
+bool I2C_Bus_Submit(I2C_Transaction_t *transaction)
+{
+    if (transaction == NULL || transaction->callback == NULL || bus_queue == NULL ||
+        transaction->priority >= I2C_PRIORITY_MAX) {
+        return false;
+    }
+
+    transaction->waiter = NULL;
+    transaction->done = false;
+    transaction->submit_tick = osKernelSysTick();
+    return xQueueSend(bus_queue, &transaction, 0) == pdPASS;
+}
+
+HAL_StatusTypeDef I2C_Bus_Execute(I2C_Transaction_t *transaction)
+{
+    if (transaction == NULL || transaction->priority >= I2C_PRIORITY_MAX) {
+        return HAL_ERROR;
+    }
+
+    if (__get_IPSR() != 0) {
+        return HAL_ERROR;   // 不能在中断中等待总线
+    }
+
+    transaction->callback = NULL;
+    transaction->waiter = NULL;
+    transaction->done = false;
+    transaction->submit_tick = osKernelSysTick();
+
+    // 调度器未运行或在总线服务自身的回调里：直接在当前上下文执行
+    if (osKernelRunning() == 0 || bus_queue == NULL ||
+        osThreadGetId() == bus_task_handle) {
+        I2C_Bus_RunFirstPhase(transaction, false);
+        return transaction->status;
+    }
+
+    transaction->waiter = xTaskGetCurrentTaskHandle();
+    if (xQueueSend(bus_queue, &transaction, pdMS_TO_TICKS(transaction->timeout_ms)) != pdPASS) {
+        return HAL_BUSY;
+    }
+
+    // 总线服务保证每个阶段在各自超时内结束，因此这里无限等待是安全的。
+    // 与调用任务的其他通知 (如传感器调度唤醒) 共用通知值，收到不属于本事务
+    // 的通知时在结束后补发一次
+    bool foreign = false;
+    while (!transaction->done) {
+        uint32_t count = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (!transaction->done || count > 1) {
+            foreign = true;
+        }
+    }
+    if (foreign) {
+        xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+    }
+
+    return transaction->status;
+}
+
+void I2C_Bus_GetStats(I2C_BusStats_t *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    *stats = bus_stats;
+    taskEXIT_CRITICAL();
+}
+
+/* --------------------------- 总线服务 --------------------------- */
+
+/**
+ * @brief 总线服务任务
+ * @details 每轮只执行一个阶段后重新检查：已到期的写后等待事务最先执行，
+ *          其次是高优先级事务，最后是普通事务。慢速或无应答的从机只会
+ *          占用它自己那一个阶段的超时时间。
+ */
+static void I2C_Bus_ServerTask(void const *argument)
+{
+    for (;;) {
+        uint32_t wait_ms = 0;
+        I2C_Transaction_t *transaction = I2C_Bus_TakeDueParked(&wait_ms);
+
+        // 1. 写后等待已到期的事务：完成读取阶段
+        if (transaction != NULL) {
+            I2C_Bus_Complete(transaction, I2C_Bus_RunPhase(transaction, true));
+            continue;
+        }
+
+        // 2. 收取新提交的事务 (无事可做时睡眠到最近的等待到期)
+        TickType_t ticks = (pending_head[I2C_PRIORITY_HIGH] != NULL ||
+                            pending_head[I2C_PRIORITY_NORMAL] != NULL)
+                               ? 0
+                               : ((wait_ms == portMAX_DELAY) ? portMAX_DELAY
+                                                             : pdMS_TO_TICKS(wait_ms));
+        if (xQueueReceive(bus_queue, &transaction, ticks) == pdPASS) {
+            do {
+                I2C_Bus_AppendPending(transaction);
+            } while (xQueueReceive(bus_queue, &transaction, 0) == pdPASS);
+        }
+
+        // 3. 按优先级执行一个新事务
+        transaction = I2C_Bus_PopPending();
+        if (transaction != NULL) {
+            I2C_Bus_RunFirstPhase(transaction, true);
+        }
+    }
+}
+
+static void I2C_Bus_AppendPending(I2C_Transaction_t *transaction)
+{
+    I2C_Priority_t prio = transaction->priority;
+
+    transaction->next = NULL;
+    if (pending_tail[prio] != NULL) {
+        pending_tail[prio]->next = transaction;
+    } else {
+        pending_head[prio] = transaction;
+    }
+    pending_tail[prio] = transaction;
+}
+
+static I2C_Transaction_t *I2C_Bus_PopPending(void)
+{
+    for (int prio = I2C_PRIORITY_MAX - 1; prio >= 0; prio--) {
+        I2C_Transaction_t *transaction = pending_head[prio];
+        if (transaction != NULL) {
+            pending_head[prio] = transaction->next;
+            if (pending_head[prio] == NULL) {
+                pending_tail[prio] = NULL;
+            }
+            return transaction;
+        }
+    }
+    return NULL;
+}
+
+static bool I2C_Bus_Park(I2C_Transaction_t *transaction)
+{
+    for (int i = 0; i < I2C_BUS_MAX_PARKED; i++) {
+        if (parked[i] == NULL) {
+            transaction->due_tick = osKernelSysTick() + pdMS_TO_TICKS(transaction->delay_ms);
+            parked[i] = transaction;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief 取出一个已到期的写后等待事务；没有时输出最近的剩余等待时间
+ */
+static I2C_Transaction_t *I2C_Bus_TakeDueParked(uint32_t *wait_ms)
+{
+    uint32_t now = osKernelSysTick();
+    *wait_ms = portMAX_DELAY;
+
+    for (int i = 0; i < I2C_BUS_MAX_PARKED; i++) {
+        I2C_Transaction_t *transaction = parked[i];
+        if (transaction == NULL) {
+            continue;
+        }
+        int32_t remain = (int32_t)(transaction->due_tick - now);
+        if (remain <= 0) {
+            parked[i] = NULL;
+            return transaction;
+        }
+        if ((uint32_t)remain < *wait_ms) {
+            *wait_ms = (uint32_t)remain;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 执行事务的写阶段 (或探测)，需要等待时挂起，否则直接完成读阶段
+ */
+static void I2C_Bus_RunFirstPhase(I2C_Transaction_t *transaction, bool allow_park)
+{
+    HAL_StatusTypeDef status = HAL_OK;
+
+    transaction->queue_ms = osKernelSysTick() - transaction->submit_tick;
+
+    // 探测从机
+    if (transaction->tx_len == 0 && transaction->rx_len == 0) {
+        bool locked = (osKernelRunning() == 0) || I2C_Bus_Lock(transaction->timeout_ms);
+        if (!locked) {
+            I2C_Bus_Complete(transaction, HAL_BUSY);
+            return;
+        }
+        status = HAL_I2C_IsDeviceReady(I2C_BUS_HANDLE, transaction->addr << 1, 2,
+                                       transaction->timeout_ms);
+        if (I2C_Bus_IsStuck(status) && I2C_Bus_Recover(I2C_BUS_HANDLE)) {
+            status = HAL_I2C_IsDeviceReady(I2C_BUS_HANDLE, transaction->addr << 1, 2,
+                                           transaction->timeout_ms);
+        }
+        if (osKernelRunning() != 0) {
+            I2C_Bus_Unlock();
+        }
+        I2C_Bus_Complete(transaction, status);
+        return;
+    }
+
+    // 写阶段
+    if (transaction->tx_len > 0) {
+        status = I2C_Bus_RunPhase(transaction, false);
+        if (status != HAL_OK || transaction->rx_len == 0) {
+            I2C_Bus_Complete(transaction, status);
+            return;
+        }
+    }
+
+    // 写读间隔：挂起事务，期间总线继续服务其他从机
+    if (transaction->delay_ms > 0) {
+        if (allow_park && I2C_Bus_Park(transaction)) {
+            return;
+        }
+        if (osKernelRunning() != 0) {
+            osDelay(transaction->delay_ms);
+        } else {
+            HAL_Delay(transaction->delay_ms);
+        }
+    }
+
+    // 读阶段
+    I2C_Bus_Complete(transaction, I2C_Bus_RunPhase(transaction, true));
+}
+
+/**
+ * @brief 在总线锁保护下执行一次写或读
+ */
+static HAL_StatusTypeDef I2C_Bus_RunPhase(I2C_Transaction_t *transaction, bool is_read)
+{
+    bool use_lock = (osKernelRunning() != 0 && i2c_mutex_handle != NULL);
+
+    if (use_lock && !I2C_Bus_Lock(transaction->timeout_ms)) {
+        return HAL_BUSY;
+    }
+
+    HAL_StatusTypeDef status = I2C_Bus_Transfer(
+        I2C_BUS_HANDLE,
+        transaction->addr << 1,
+        is_read ? transaction->rx_buf : (uint8_t *)transaction->tx_buf,
+        is_read ? transaction->rx_len : transaction->tx_len,
+        transaction->timeout_ms,
+        is_read
+    );
+
+    if (use_lock) {
+        I2C_Bus_Unlock();
+    }
+    return status;
+}
+
+/**
+ * @brief 记录结果与耗时，并通知提交者
+ */
+static void I2C_Bus_Complete(I2C_Transaction_t *transaction, HAL_StatusTypeDef status)
+{
+    transaction->status = status;
+    transaction->latency_ms = osKernelSysTick() - transaction->submit_tick;
+
+    taskENTER_CRITICAL();
+    if (status == HAL_OK) {
+        bus_stats.completed++;
+    } else {
+        bus_stats.failed++;
+    }
+    bus_stats.last_latency_ms = transaction->latency_ms;
+    if (transaction->latency_ms > bus_stats.max_latency_ms[transaction->priority]) {
+        bus_stats.max_latency_ms[transaction->priority] = transaction->latency_ms;
+    }
+    taskEXIT_CRITICAL();
+
+    METRIC_OBSERVE(METRIC_I2C_LATENCY, transaction->latency_ms);
+    if (status != HAL_OK) {
+        METRIC_INC(METRIC_I2C_ERRORS);
+    }
+
+    if (transaction->callback != NULL) {
+        transaction->callback(transaction);
+    } else if (transaction->waiter != NULL) {
+        // 置位 done 后描述符可能立即失效，先取出等待者
+        TaskHandle_t waiter = transaction->waiter;
+        transaction->done = true;
+        xTaskNotifyGive(waiter);
+    } else {
+        transaction->done = true;
+    }
+}
+
+/* --------------------------- 总线恢复 --------------------------- */
+
+/**
+ * @brief 判断失败的传输是否意味着总线卡死
+ * @details BUSY/超时说明外设一直在等总线空闲；NACK 之后外设会发出 STOP，
+ *          留出 STOP 完成的时间后 SDA 仍为低电平，说明从机停在传输中途。
+ */
+static bool I2C_Bus_IsStuck(HAL_StatusTypeDef status)
+{
+    if (status == HAL_OK) {
+        return false;
+    }
+    if (status != HAL_ERROR) {
+        return true;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (HAL_GPIO_ReadPin(I2C_BUS_SDA_PORT, I2C_BUS_SDA_PIN) == GPIO_PIN_SET) {
+            return false;
+        }
+        delay_us(I2C_BUS_RECOVERY_HALF_US);
+    }
+    return true;
+}
+
+/**
+ * @brief 总线卡死恢复 (调用者持有总线锁或调度器未运行)
+ * @details 从机在字节中途被打断时会一直拉低 SDA，外设因此始终处于 BUSY，
+ *          HAL_I2C_* 全部失败。这里把引脚切换为开漏 GPIO，在 SCL 上
+ *          输出 9 个时钟让从机移出剩余的位并释放 SDA，再产生 STOP，
+ *          最后重新初始化外设 (HAL_I2C_Init 会先软复位，清除卡住的 BUSY 标志)。
+ * @return true: SDA 已释放，可以重试
+ */
+static bool I2C_Bus_Recover(I2C_HandleTypeDef *hi2c)
+{
+    GPIO_InitTypeDef gpio = {0};
+    bool released;
+
+    HAL_I2C_DeInit(hi2c);   // MspDeInit 同时把引脚恢复为默认状态
+
+    HAL_GPIO_WritePin(I2C_BUS_SCL_PORT, I2C_BUS_SCL_PIN, GPIO_PIN_SET);
+    HAL_GPIO_WritePin(I2C_BUS_SDA_PORT, I2C_BUS_SDA_PIN, GPIO_PIN_SET);
+    gpio.Mode = GPIO_MODE_OUTPUT_OD;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+    gpio.Pin = I2C_BUS_SCL_PIN;
+    HAL_GPIO_Init(I2C_BUS_SCL_PORT, &gpio);
+    gpio.Pin = I2C_BUS_SDA_PIN;
+    HAL_GPIO_Init(I2C_BUS_SDA_PORT, &gpio);
+    delay_us(I2C_BUS_RECOVERY_HALF_US);
+
+    // 时钟脉冲：SDA 为输出高 (开漏释放)，从机在每个低电平期间移出一位
+    for (int i = 0; i < I2C_BUS_RECOVERY_PULSES; i++) {
+        HAL_GPIO_WritePin(I2C_BUS_SCL_PORT, I2C_BUS_SCL_PIN, GPIO_PIN_RESET);
+        delay_us(I2C_BUS_RECOVERY_HALF_US);
+        HAL_GPIO_WritePin(I2C_BUS_SCL_PORT, I2C_BUS_SCL_PIN, GPIO_PIN_SET);
+        delay_us(I2C_BUS_RECOVERY_HALF_US);
+    }
+
+    // STOP：SCL 为低时拉低 SDA，SCL 释放后再释放 SDA
+    HAL_GPIO_WritePin(I2C_BUS_SCL_PORT, I2C_BUS_SCL_PIN, GPIO_PIN_RESET);
+    delay_us(I2C_BUS_RECOVERY_HALF_US);
+    HAL_GPIO_WritePin(I2C_BUS_SDA_PORT, I2C_BUS_SDA_PIN, GPIO_PIN_RESET);
+    delay_us(I2C_BUS_RECOVERY_HALF_US);
+    HAL_GPIO_WritePin(I2C_BUS_SCL_PORT, I2C_BUS_SCL_PIN, GPIO_PIN_SET);
+    delay_us(I2C_BUS_RECOVERY_HALF_US);
+    HAL_GPIO_WritePin(I2C_BUS_SDA_PORT, I2C_BUS_SDA_PIN, GPIO_PIN_SET);
+    delay_us(I2C_BUS_RECOVERY_HALF_US);
+
+    released = (HAL_GPIO_ReadPin(I2C_BUS_SDA_PORT, I2C_BUS_SDA_PIN) == GPIO_PIN_SET) &&
+               (HAL_GPIO_ReadPin(I2C_BUS_SCL_PORT, I2C_BUS_SCL_PIN) == GPIO_PIN_SET);
+
+    HAL_I2C_Init(hi2c);     // MspInit 把引脚切回复用功能
+
+    taskENTER_CRITICAL();
+    bus_stats.recoveries++;
+    if (!released) {
+        bus_stats.recovery_failed++;
+    }
+    taskEXIT_CRITICAL();
+    METRIC_INC(METRIC_I2C_RECOVERIES);
+
+    if (released) {
+        LOG_WARN("I2C总线卡死，已输出 %d 个时钟并重新初始化", I2C_BUS_RECOVERY_PULSES);
+    } else {
+        LOG_ERROR("I2C总线恢复失败：SDA/SCL 仍被拉低");
+    }
+    return released;
+}
+
+/* --------------------------- 中断传输 --------------------------- */
+
+/**
+ * @brief 执行一次传输；总线卡死时恢复总线并重试一次
+ */
+static HAL_StatusTypeDef I2C_Bus_Transfer(I2C_HandleTypeDef *hi2c, uint16_t dev_addr,
+                                          uint8_t *data, uint16_t size,
+                                          uint32_t timeout_ms, bool is_read)
+{
+    HAL_StatusTypeDef status =
+        I2C_Bus_TransferOnce(hi2c, dev_addr, data, size, timeout_ms, is_read);
+
+    if (!I2C_Bus_IsStuck(status)) {
+        return status;
+    }
+    LOG_ERROR("I2C传输失败 (地址: 0x%02X, 状态: %d)，尝试恢复总线", dev_addr >> 1, status);
+    if (!I2C_Bus_Recover(hi2c)) {
+        return status;
+    }
+
+    status = I2C_Bus_TransferOnce(hi2c, dev_addr, data, size, timeout_ms, is_read);
+    if (status == HAL_OK) {
+        taskENTER_CRITICAL();
+        bus_stats.recovery_retried_ok++;
+        taskEXIT_CRITICAL();
+    }
+    return status;
+}
+
+/**
+ * @brief 启动中断方式传输，并阻塞等待完成回调发来的任务通知
+ */
+static HAL_StatusTypeDef I2C_Bus_TransferOnce(I2C_HandleTypeDef *hi2c, uint16_t dev_addr,
+                                              uint8_t *data, uint16_t size,
+                                              uint32_t timeout_ms, bool is_read)
+{
+    if (hi2c == NULL || data == NULL || size == 0) {
+        return HAL_ERROR;
+    }
+
+    // 调度器未运行或处于中断上下文时无法等待通知，退回阻塞传输
+    if (osKernelRunning() == 0 || __get_IPSR() != 0) {
+        return is_read ? HAL_I2C_Master_Receive(hi2c, dev_addr, data, size, timeout_ms)
+                       : HAL_I2C_Master_Transmit(hi2c, dev_addr, data, size, timeout_ms);
+    }
+
+    (void)ulTaskNotifyTake(pdTRUE, 0);  // 清除上一次遗留的通知
+    taskENTER_CRITICAL();
+    xfer_hi2c = hi2c;
+    xfer_task = xTaskGetCurrentTaskHandle();
+    xfer_status = HAL_ERROR;
+    taskEXIT_CRITICAL();
+
+    HAL_StatusTypeDef status = is_read ? HAL_I2C_Master_Receive_IT(hi2c, dev_addr, data, size)
+                                       : HAL_I2C_Master_Transmit_IT(hi2c, dev_addr, data, size);
+    if (status == HAL_OK) {
+        if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms)) != 0) {
+            status = xfer_status;
+        } else {
+            status = HAL_TIMEOUT;
+        }
+    }
+
+    taskENTER_CRITICAL();
+    xfer_hi2c = NULL;
+    xfer_task = NULL;
+    taskEXIT_CRITICAL();
+
+    return status;
+}
+
+/**
+ * @brief 在中断中唤醒等待传输完成的任务
+ */
+static void I2C_Bus_CompleteFromISR(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (hi2c != xfer_hi2c || xfer_task == NULL) {
+        return;     // 不是本管理器发起的传输，或等待方已超时放弃
+    }
+
+    xfer_status = status;
+    vTaskNotifyGiveFromISR(xfer_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/* --------------------------- HAL 回调 --------------------------- */
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2C_Bus_CompleteFromISR(hi2c, HAL_OK);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2C_Bus_CompleteFromISR(hi2c, HAL_OK);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+    I2C_Bus_CompleteFromISR(hi2c, HAL_ERROR);   // NACK/仲裁丢失/总线错误
+#if TOUCH_BUS_USE_HW_I2C
+    touch_bus_error_callback(hi2c);             // 触摸控制器的 I2C3 共用此回调
+#endif
+}
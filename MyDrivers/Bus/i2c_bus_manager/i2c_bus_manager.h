@@ -3,16 +3,91 @@
 
 #include "main.h"
 #include "cmsis_os.h" // 推荐：如果用到RTOS
+#include "task_plan.h"
 #include <stdbool.h>
 
 #ifdef  __cplusplus
 extern "C" {
 #endif
 
+/* --------------------------- 配置 --------------------------- */
+extern I2C_HandleTypeDef hi2c1;
+#define I2C_BUS_HANDLE              (&hi2c1)    // 总线服务管理的I2C句柄
+#define I2C_BUS_TASK_STACK_SIZE     256         // 总线服务任务栈大小
+#define I2C_BUS_TASK_PRIORITY       TASK_PLAN_OS_PRIO(TASK_PRIO_I2C_BUS) // 高于所有使用者
+#define I2C_BUS_QUEUE_LEN           8           // 提交队列深度
+#define I2C_BUS_MAX_PARKED          4           // 同时处于"写后等待"的事务数
+#define I2C_BUS_DEFAULT_TIMEOUT_MS  100         // 单个阶段的默认超时
+
+// 总线卡死恢复：引脚临时切换为开漏 GPIO 输出时钟 (须与 i2c.c 中的引脚一致)
+#define I2C_BUS_SCL_PORT            GPIOB
+#define I2C_BUS_SCL_PIN             GPIO_PIN_6
+#define I2C_BUS_SDA_PORT            GPIOB
+#define I2C_BUS_SDA_PIN             GPIO_PIN_7
+#define I2C_BUS_RECOVERY_PULSES     9           // 8 个数据位 + 1 个应答位
+#define I2C_BUS_RECOVERY_HALF_US    5           // 恢复时钟的半周期 (约 100kHz)
+
+/* --------------------------- 数据类型 --------------------------- */
+typedef enum {
+    I2C_PRIORITY_NORMAL = 0,    // 普通 (传感器周期读取)
+    I2C_PRIORITY_HIGH,          // 时间敏感，始终优先于普通事务执行
+    I2C_PRIORITY_MAX
+} I2C_Priority_t;
+
+typedef struct I2C_Transaction I2C_Transaction_t;
+typedef void (*I2C_TransactionCallback_t)(I2C_Transaction_t *transaction);
+
+/**
+ * @brief I2C 事务描述符
+ * @details 一个事务对同一从机依次执行：写 tx_buf -> 等待 delay_ms -> 读 rx_buf，
+ *          命令+读取可以合并成一个事务提交。tx_len 与 rx_len 都为 0 时
+ *          表示探测从机是否在线。等待期间总线服务会继续执行其他事务。
+ *          描述符及缓冲区由调用者提供，在事务完成前必须保持有效。
+ */
+struct I2C_Transaction {
+    // 请求 (由调用者填写)
+    uint8_t addr;                       // 7位从机地址
+    const uint8_t *tx_buf;              // 写缓冲区
+    uint16_t tx_len;
+    uint8_t *rx_buf;                    // 读缓冲区
+    uint16_t rx_len;
+    uint16_t delay_ms;                  // 写与读之间的间隔 (如等待转换完成)
+    uint16_t timeout_ms;                // 单个阶段的超时
+    I2C_Priority_t priority;            // 优先级
+    I2C_TransactionCallback_t callback; // 完成回调 (在总线服务任务中调用)，NULL 表示同步等待
+    void *user_data;                    // 回调用户数据
+
+    // 结果 (由总线服务填写)
+    HAL_StatusTypeDef status;           // 执行结果
+    uint32_t queue_ms;                  // 提交到开始执行的排队时间
+    uint32_t latency_ms;                // 提交到完成的总耗时
+
+    // 内部使用
+    I2C_Transaction_t *next;
+    uint32_t submit_tick;
+    uint32_t due_tick;
+    TaskHandle_t waiter;
+    volatile bool done;
+};
+
+/**
+ * @brief 总线统计信息
+ */
+typedef struct {
+    uint32_t completed;                         // 成功完成的事务数
+    uint32_t failed;                            // 失败的事务数 (NACK/超时等)
+    uint32_t last_latency_ms;                   // 最近一个事务的总耗时
+    uint32_t max_latency_ms[I2C_PRIORITY_MAX];  // 各优先级的最大总耗时
+    uint32_t recoveries;                        // 总线卡死恢复次数
+    uint32_t recovery_failed;                   // 恢复后 SDA 仍被拉低的次数
+    uint32_t recovery_retried_ok;               // 恢复后重试成功的传输数
+} I2C_BusStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
 /**
  * @brief 初始化I2C总线管理器
- * @note  此函数会创建用于保护I2C总线的互斥信号量。
- *        应在RTOS内核启动前调用。
+ * @note  此函数会创建用于保护I2C总线的互斥信号量、事务队列和总线服务任务。
  * @param None
  * @return true  初始化成功
  * @return false 初始化失败
@@ -21,8 +96,9 @@ bool I2C_Bus_Manager_Init(void);
 
 /**
  * @brief 申请I2C总线
- * @note  任何任务在开始一系列I2C操作前应调用此函数。
- *        若长时间未获得总线会超时返回。
+ * @note  供需要直接调用 HAL 的代码使用 (如 HAL_I2C_IsDeviceReady)，
+ *        总线服务执行每个阶段时同样会持有此锁。
+ *        持有锁期间不得调用 I2C_Bus_Execute()，否则会死锁。
  * @param timeout_ms 等待超时时间 (毫秒)
  * @return true 成功获得锁
  * @return false 获得锁超时
@@ -37,6 +113,34 @@ bool I2C_Bus_Lock(uint32_t timeout_ms);
  */
 void I2C_Bus_Unlock(void);
 
+/**
+ * @brief 以默认参数初始化事务描述符
+ * @param transaction 事务描述符
+ * @param addr 7位从机地址
+ */
+void I2C_Transaction_Init(I2C_Transaction_t *transaction, uint8_t addr);
+
+/**
+ * @brief 异步提交事务，完成后在总线服务任务中调用 transaction->callback
+ * @param transaction 事务描述符 (callback 不能为 NULL)
+ * @return true 已入队, false: 参数无效或队列已满
+ */
+bool I2C_Bus_Submit(I2C_Transaction_t *transaction);
+
+/**
+ * @brief 同步执行事务，阻塞直到完成
+ * @note  调度器未启动时直接在调用者上下文中以阻塞方式执行；不能在中断中调用。
+ * @param transaction 事务描述符 (callback 会被忽略)
+ * @return HAL_StatusTypeDef HAL_OK / HAL_ERROR (含 NACK) / HAL_BUSY / HAL_TIMEOUT
+ */
+HAL_StatusTypeDef I2C_Bus_Execute(I2C_Transaction_t *transaction);
+
+/**
+ * @brief 获取总线统计信息
+ * @param stats 输出统计信息
+ */
+void I2C_Bus_GetStats(I2C_BusStats_t *stats);
+
 #ifdef  __cplusplus
 }
 #endif
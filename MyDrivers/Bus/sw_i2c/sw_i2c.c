@@ -0,0 +1,211 @@
+/**
+ ******************************************************************************
+ * @file    sw_i2c.c
+ * @brief   通用软件 I2C 引擎实现
+ * @details 时序与原 myiic/ctiic 相同 (SCL 低电平期间改变 SDA，高电平期间
+ *          采样)，只是等待时间由档位决定。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sw_i2c.h"
+
+const sw_i2c_timing_t SW_I2C_TIMING_STANDARD = {5000, 5000, 1000};
+const sw_i2c_timing_t SW_I2C_TIMING_LEGACY = {2000, 2000, 0};
+const sw_i2c_timing_t SW_I2C_TIMING_FAST = {1300, 700, 1000};
+
+/* -----------------------------------------------------------
+ * 私有函数
+ * ----------------------------------------------------------- */
+
+#define SW_I2C_SCL_H(b) ((b)->scl_port->BSRR = (b)->scl_pin)
+#define SW_I2C_SCL_L(b) ((b)->scl_port->BSRR = (uint32_t)(b)->scl_pin << 16U)
+#define SW_I2C_SDA_H(b) ((b)->sda_port->BSRR = (b)->sda_pin)
+#define SW_I2C_SDA_L(b) ((b)->sda_port->BSRR = (uint32_t)(b)->sda_pin << 16U)
+#define SW_I2C_SDA_READ(b) (((b)->sda_port->IDR & (b)->sda_pin) != 0U)
+#define SW_I2C_SCL_READ(b) (((b)->scl_port->IDR & (b)->scl_pin) != 0U)
+
+static uint32_t sw_i2c_ns_to_cycles(uint32_t ns) {
+    uint32_t cycles = (uint32_t)(((uint64_t)ns * SystemCoreClock + 999999999U) / 1000000000U);
+
+    return cycles > SW_I2C_PIN_OVERHEAD_CYCLES ? cycles - SW_I2C_PIN_OVERHEAD_CYCLES : 0;
+}
+
+static inline void sw_i2c_wait(uint32_t cycles) {
+    uint32_t start = DWT->CYCCNT;
+
+    while (DWT->CYCCNT - start < cycles) {
+    }
+}
+
+static inline void sw_i2c_wait_low(const sw_i2c_bus_t *bus) { sw_i2c_wait(bus->low_cycles); }
+
+/**
+ * @brief 释放 SCL 并保持高电平时间; 允许拉伸时等待从机释放 SCL
+ */
+static inline void sw_i2c_scl_release(const sw_i2c_bus_t *bus) {
+    SW_I2C_SCL_H(bus);
+    if (bus->stretch_cycles != 0 && !SW_I2C_SCL_READ(bus)) {
+        uint32_t start = DWT->CYCCNT;
+
+        while (!SW_I2C_SCL_READ(bus) && DWT->CYCCNT - start < bus->stretch_cycles) {
+        }
+    }
+    sw_i2c_wait(bus->high_cycles);
+}
+
+/* -----------------------------------------------------------
+ * 公共函数
+ * ----------------------------------------------------------- */
+
+/**
+ * @brief 初始化引脚 (开漏输出、上拉; 输出 1 时可读取外部电平)
+ */
+void sw_i2c_init(sw_i2c_bus_t *bus) {
+    GPIO_InitTypeDef gpio_init_struct;
+
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+
+    gpio_init_struct.Pin = bus->scl_pin;
+    gpio_init_struct.Mode = GPIO_MODE_OUTPUT_OD;
+    gpio_init_struct.Pull = GPIO_PULLUP;
+    gpio_init_struct.Speed = GPIO_SPEED_FREQ_HIGH;
+    HAL_GPIO_Init(bus->scl_port, &gpio_init_struct);
+
+    gpio_init_struct.Pin = bus->sda_pin;
+    HAL_GPIO_Init(bus->sda_port, &gpio_init_struct);
+
+    sw_i2c_set_timing(bus, bus->timing != NULL ? bus->timing : &SW_I2C_TIMING_STANDARD);
+    sw_i2c_stop(bus);
+}
+
+/**
+ * @brief 切换时序档位 (按当前系统时钟换算为周期数)
+ */
+void sw_i2c_set_timing(sw_i2c_bus_t *bus, const sw_i2c_timing_t *timing) {
+    bus->timing = timing;
+    bus->low_cycles = sw_i2c_ns_to_cycles(timing->low_ns);
+    bus->high_cycles = sw_i2c_ns_to_cycles(timing->high_ns);
+    bus->stretch_cycles = timing->stretch_timeout_us * (SystemCoreClock / 1000000U);
+}
+
+/**
+ * @brief 起始信号: SCL 为高时 SDA 由高变低
+ */
+void sw_i2c_start(sw_i2c_bus_t *bus) {
+    SW_I2C_SDA_H(bus);
+    sw_i2c_scl_release(bus);
+    SW_I2C_SDA_L(bus);
+    sw_i2c_wait(bus->high_cycles);
+    SW_I2C_SCL_L(bus); // 钳住总线，准备发送或接收数据
+    sw_i2c_wait_low(bus);
+}
+
+/**
+ * @brief 停止信号: SCL 为高时 SDA 由低变高
+ */
+void sw_i2c_stop(sw_i2c_bus_t *bus) {
+    SW_I2C_SDA_L(bus);
+    sw_i2c_wait_low(bus);
+    sw_i2c_scl_release(bus);
+    SW_I2C_SDA_H(bus);
+    sw_i2c_wait(bus->high_cycles); // 总线空闲时间 tBUF
+}
+
+/**
+ * @brief 等待应答
+ * @return 0 收到应答；1 无应答 (已发送停止信号)
+ */
+uint8_t sw_i2c_wait_ack(sw_i2c_bus_t *bus) {
+    uint16_t polls = 0;
+    uint8_t rack = 0;
+
+    SW_I2C_SDA_H(bus); // 释放 SDA，从机可拉低
+    sw_i2c_wait_low(bus);
+    sw_i2c_scl_release(bus);
+
+    while (SW_I2C_SDA_READ(bus)) {
+        if (++polls > SW_I2C_ACK_POLLS) {
+            sw_i2c_stop(bus);
+            rack = 1;
+            break;
+        }
+        sw_i2c_wait(bus->high_cycles);
+    }
+
+    SW_I2C_SCL_L(bus);
+    sw_i2c_wait_low(bus);
+    return rack;
+}
+
+/**
+ * @brief 发送 ACK
+ */
+void sw_i2c_ack(sw_i2c_bus_t *bus) {
+    SW_I2C_SDA_L(bus);
+    sw_i2c_wait_low(bus);
+    sw_i2c_scl_release(bus);
+    SW_I2C_SCL_L(bus);
+    sw_i2c_wait_low(bus);
+    SW_I2C_SDA_H(bus); // 释放 SDA
+}
+
+/**
+ * @brief 发送 NACK
+ */
+void sw_i2c_nack(sw_i2c_bus_t *bus) {
+    SW_I2C_SDA_H(bus);
+    sw_i2c_wait_low(bus);
+    sw_i2c_scl_release(bus);
+    SW_I2C_SCL_L(bus);
+    sw_i2c_wait_low(bus);
+}
+
+/**
+ * @brief 发送一个字节 (高位在前)
+ */
+void sw_i2c_send_byte(sw_i2c_bus_t *bus, uint8_t data) {
+    uint8_t t;
+
+    for (t = 0; t < 8; t++) {
+        if (data & 0x80) {
+            SW_I2C_SDA_H(bus);
+        } else {
+            SW_I2C_SDA_L(bus);
+        }
+        sw_i2c_wait_low(bus);
+        sw_i2c_scl_release(bus);
+        SW_I2C_SCL_L(bus);
+        data <<= 1;
+    }
+    SW_I2C_SDA_H(bus); // 发送完成，释放 SDA
+}
+
+/**
+ * @brief 读取一个字节
+ * @param ack 1: 发送 ACK；0: 发送 NACK
+ */
+uint8_t sw_i2c_read_byte(sw_i2c_bus_t *bus, uint8_t ack) {
+    uint8_t i, receive = 0;
+
+    for (i = 0; i < 8; i++) {
+        receive <<= 1;
+        sw_i2c_scl_release(bus);
+        if (SW_I2C_SDA_READ(bus)) {
+            receive++;
+        }
+        SW_I2C_SCL_L(bus);
+        sw_i2c_wait_low(bus);
+    }
+
+    if (ack) {
+        sw_i2c_ack(bus);
+    } else {
+        sw_i2c_nack(bus);
+    }
+    return receive;
+}
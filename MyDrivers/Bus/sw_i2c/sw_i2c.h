@@ -0,0 +1,72 @@
+/**
+ ******************************************************************************
+ * @file    sw_i2c.h
+ * @brief   通用软件 I2C 引擎
+ * @details 一套位操作时序同时服务 EEPROM 总线 (myiic) 与电容触摸总线
+ *          (ctiic)，两者只提供各自的引脚与时序档位：
+ *            - 引脚用开漏输出 + 上拉，直接写 BSRR、读 IDR；
+ *            - SCL 半周期按 DWT 周期计数等待，扣除引脚操作本身的开销；
+ *            - 可选时钟拉伸：释放 SCL 后等待它真正变高 (带超时)；
+ *            - 档位可在运行时切换 (如先用标准模式探测，再升到快速模式)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SW_I2C_H
+#define __SW_I2C_H
+
+#include "main.h"
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 配置 --------------------------- */
+#define SW_I2C_PIN_OVERHEAD_CYCLES  8       // 一次 BSRR 写 + 循环判断的周期数 (从半周期中扣除)
+#define SW_I2C_ACK_POLLS            250     // 等待应答的轮询次数上限
+
+/* --------------------------- 数据类型 --------------------------- */
+// 时序档位
+typedef struct {
+    uint16_t low_ns;                // SCL 低电平时间
+    uint16_t high_ns;               // SCL 高电平时间
+    uint16_t stretch_timeout_us;    // 时钟拉伸的最长等待, 0 表示不检测拉伸
+} sw_i2c_timing_t;
+
+// 总线描述符 (引脚由使用者静态定义)
+typedef struct {
+    GPIO_TypeDef *scl_port;
+    uint16_t scl_pin;
+    GPIO_TypeDef *sda_port;
+    uint16_t sda_pin;
+    const sw_i2c_timing_t *timing;
+
+    // 由 sw_i2c_set_timing 计算
+    uint32_t low_cycles;
+    uint32_t high_cycles;
+    uint32_t stretch_cycles;
+} sw_i2c_bus_t;
+
+/* --------------------------- 时序档位 --------------------------- */
+extern const sw_i2c_timing_t SW_I2C_TIMING_STANDARD;   // 100kHz, 任何器件都支持
+extern const sw_i2c_timing_t SW_I2C_TIMING_LEGACY;     // 原 delay_us(2) 时序 (约 250kHz)
+extern const sw_i2c_timing_t SW_I2C_TIMING_FAST;       // 400kHz (快速模式, tLOW >= 1.3us, tHIGH >= 0.6us)
+
+/* --------------------------- 接口 --------------------------- */
+void sw_i2c_init(sw_i2c_bus_t *bus);                                    // 初始化引脚并发送停止信号
+void sw_i2c_set_timing(sw_i2c_bus_t *bus, const sw_i2c_timing_t *timing); // 切换时序档位
+void sw_i2c_start(sw_i2c_bus_t *bus);
+void sw_i2c_stop(sw_i2c_bus_t *bus);
+void sw_i2c_ack(sw_i2c_bus_t *bus);
+void sw_i2c_nack(sw_i2c_bus_t *bus);
+uint8_t sw_i2c_wait_ack(sw_i2c_bus_t *bus);                             // 0: 收到应答, 1: 无应答
+void sw_i2c_send_byte(sw_i2c_bus_t *bus, uint8_t data);
+uint8_t sw_i2c_read_byte(sw_i2c_bus_t *bus, uint8_t ack);               // ack=1 发送 ACK, 0 发送 NACK
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __SW_I2C_H */
@@ -18,13 +18,20 @@
  * ޸˵
  * V1.0 20200424
  * һη
+ * V1.1
+ * ʱͨ I2C  (sw_i2c) ʵ, ļֻ뵵λ
  *
  ****************************************************************************************************
  */
 
 #include "myiic.h"
-#include "mydelay.h"
-#include "main.h"
+
+static sw_i2c_bus_t s_iic_bus =
+{
+    IIC_SCL_GPIO_PORT, IIC_SCL_GPIO_PIN,
+    IIC_SDA_GPIO_PORT, IIC_SDA_GPIO_PIN,
+    IIC_TIMING,
+};
 
 /**
  * @brief       ʼIIC
@@ -33,192 +40,16 @@
  */
 void iic_init(void)
 {
-    GPIO_InitTypeDef gpio_init_struct;
-
     IIC_SCL_GPIO_CLK_ENABLE();  /* SCLʱʹ */
     IIC_SDA_GPIO_CLK_ENABLE();  /* SDAʱʹ */
-
-    gpio_init_struct.Pin = IIC_SCL_GPIO_PIN;
-    gpio_init_struct.Mode = GPIO_MODE_OUTPUT_OD;        /* © */
-    gpio_init_struct.Pull = GPIO_PULLUP;                /*  */
-    gpio_init_struct.Speed = GPIO_SPEED_FREQ_HIGH;      /*  */
-    HAL_GPIO_Init(IIC_SCL_GPIO_PORT, &gpio_init_struct);/* SCL */
-
-    gpio_init_struct.Pin = IIC_SDA_GPIO_PIN;
-    HAL_GPIO_Init(IIC_SDA_GPIO_PORT, &gpio_init_struct);/* SDA */
-    /* SDAģʽ,©,, ͲIO, ©ʱ(=1), ҲԶȡⲿźŵĸߵ͵ƽ */
-
-    iic_stop();     /* ֹͣ豸 */
-}
-
-/**
- * @brief       IICʱ,ڿIICдٶ
- * @param       
- * @retval      
- */
-static void iic_delay(void)
-{
-    delay_us(2);    /* 2usʱ, дٶ250Khz */
-}
-
-/**
- * @brief       IICʼź
- * @param       
- * @retval      
- */
-void iic_start(void)
-{
-    IIC_SDA(1);
-    IIC_SCL(1);
-    iic_delay();
-    IIC_SDA(0);     /* STARTź: SCLΪʱ, SDAӸ߱ɵ, ʾʼź */
-    iic_delay();
-    IIC_SCL(0);     /* ǯסI2Cߣ׼ͻ */
-    iic_delay();
-}
-
-/**
- * @brief       IICֹͣź
- * @param       
- * @retval      
- */
-void iic_stop(void)
-{
-    IIC_SDA(0);     /* STOPź: SCLΪʱ, SDAӵͱɸ, ʾֹͣź */
-    iic_delay();
-    IIC_SCL(1);
-    iic_delay();
-    IIC_SDA(1);     /* I2C߽ź */
-    iic_delay();
-}
-
-/**
- * @brief       ȴӦźŵ
- * @param       
- * @retval      1Ӧʧ
- *              0Ӧɹ
- */
-uint8_t iic_wait_ack(void)
-{
-    uint8_t waittime = 0;
-    uint8_t rack = 0;
-
-    IIC_SDA(1);     /* ͷSDA(ʱⲿSDA) */
-    iic_delay();
-    IIC_SCL(1);     /* SCL=1, ʱӻԷACK */
-    iic_delay();
-
-    while (IIC_READ_SDA)    /* ȴӦ */
-    {
-        waittime++;
-
-        if (waittime > 250)
-        {
-            iic_stop();
-            rack = 1;
-            break;
-        }
-    }
-
-    IIC_SCL(0);     /* SCL=0, ACK */
-    iic_delay();
-    return rack;
+    sw_i2c_init(&s_iic_bus);       /* © + , ֹͣ豸 */
 }
 
-/**
- * @brief       ACKӦ
- * @param       
- * @retval      
- */
-void iic_ack(void)
-{
-    IIC_SDA(0);     /* SCL 0 -> 1  ʱ SDA = 0,ʾӦ */
-    iic_delay();
-    IIC_SCL(1);     /* һʱ */
-    iic_delay();
-    IIC_SCL(0);
-    iic_delay();
-    IIC_SDA(1);     /* ͷSDA */
-    iic_delay();
-}
-
-/**
- * @brief       ACKӦ
- * @param       
- * @retval      
- */
-void iic_nack(void)
-{
-    IIC_SDA(1);     /* SCL 0 -> 1  ʱ SDA = 1,ʾӦ */
-    iic_delay();
-    IIC_SCL(1);     /* һʱ */
-    iic_delay();
-    IIC_SCL(0);
-    iic_delay();
-}
-
-/**
- * @brief       IICһֽ
- * @param       data: Ҫ͵
- * @retval      
- */
-void iic_send_byte(uint8_t data)
-{
-    uint8_t t;
-    
-    for (t = 0; t < 8; t++)
-    {
-        IIC_SDA((data & 0x80) >> 7);    /* λȷ */
-        iic_delay();
-        IIC_SCL(1);
-        iic_delay();
-        IIC_SCL(0);
-        data <<= 1;     /* 1λ,һη */
-    }
-    IIC_SDA(1);         /* , ͷSDA */
-}
-
-/**
- * @brief       IICȡһֽ
- * @param       ack:  ack=1ʱack; ack=0ʱnack
- * @retval      յ
- */
-uint8_t iic_read_byte(uint8_t ack)
-{
-    uint8_t i, receive = 0;
-
-    for (i = 0; i < 8; i++ )    /* 1ֽ */
-    {
-        receive <<= 1;  /* λ,յλҪ */
-        IIC_SCL(1);
-        iic_delay();
-
-        if (IIC_READ_SDA)
-        {
-            receive++;
-        }
-        
-        IIC_SCL(0);
-        iic_delay();
-    }
-
-    if (!ack)
-    {
-        iic_nack();     /* nACK */
-    }
-    else
-    {
-        iic_ack();      /* ACK */
-    }
-
-    return receive;
-}
-
-
-
-
-
-
-
-
-
+/* ½ӿڱԭк, ֱת sw_i2c */
+void iic_start(void) { sw_i2c_start(&s_iic_bus); }
+void iic_stop(void) { sw_i2c_stop(&s_iic_bus); }
+void iic_ack(void) { sw_i2c_ack(&s_iic_bus); }
+void iic_nack(void) { sw_i2c_nack(&s_iic_bus); }
+uint8_t iic_wait_ack(void) { return sw_i2c_wait_ack(&s_iic_bus); }
+void iic_send_byte(uint8_t data) { sw_i2c_send_byte(&s_iic_bus, data); }
+uint8_t iic_read_byte(unsigned char ack) { return sw_i2c_read_byte(&s_iic_bus, ack); }
@@ -18,6 +18,8 @@
  * ޸˵
  * V1.0 20200424
  * һη
+ * V1.1
+ * ʱͨ I2C  (sw_i2c) ʵ, ļֻ뵵λ
  *
  ****************************************************************************************************
  */
@@ -26,6 +28,7 @@
 #define __MYIIC_H
 
 #include "main.h"
+#include "sw_i2c.h"
 
 
 /******************************************************************************************/
@@ -41,19 +44,8 @@
 
 /******************************************************************************************/
 
-/* IO */
-#define IIC_SCL(x)        do{ x ? \
-                              HAL_GPIO_WritePin(IIC_SCL_GPIO_PORT, IIC_SCL_GPIO_PIN, GPIO_PIN_SET) : \
-                              HAL_GPIO_WritePin(IIC_SCL_GPIO_PORT, IIC_SCL_GPIO_PIN, GPIO_PIN_RESET); \
-                          }while(0)       /* SCL */
-
-#define IIC_SDA(x)        do{ x ? \
-                              HAL_GPIO_WritePin(IIC_SDA_GPIO_PORT, IIC_SDA_GPIO_PIN, GPIO_PIN_SET) : \
-                              HAL_GPIO_WritePin(IIC_SDA_GPIO_PORT, IIC_SDA_GPIO_PIN, GPIO_PIN_RESET); \
-                          }while(0)       /* SDA */
-
-#define IIC_READ_SDA     HAL_GPIO_ReadPin(IIC_SDA_GPIO_PORT, IIC_SDA_GPIO_PIN) /* ȡSDA */
-
+/* ʱλ ( sw_i2c.h), 24C02  2.7V ֧ 400kHz */
+#define IIC_TIMING     (&SW_I2C_TIMING_FAST)
 
 /* IICв */
 void iic_init(void);            /* ʼIICIO */
@@ -18,210 +18,38 @@
  * ޸˵
  * V1.0 20200425
  * һη
+ * V1.1
+ * ʱͨ I2C  (sw_i2c) ʵ, ļֻ뵵λ
  *
  ****************************************************************************************************
  */
  
 #include "ctiic.h"
-#include "main.h"
-#include "mydelay.h"
 
-/**
- * @brief       I2Cٶȵʱ
- * @param       
- * @retval      
- */
-static void ct_iic_delay(void)
+static sw_i2c_bus_t s_ct_iic_bus =
 {
-    delay_us(2);
-}
+    CT_IIC_SCL_GPIO_PORT, CT_IIC_SCL_GPIO_PIN,
+    CT_IIC_SDA_GPIO_PORT, CT_IIC_SDA_GPIO_PIN,
+    CT_IIC_TIMING,
+};
 
 /**
- * @brief       ݴоƬIICӿڳʼ
+ * @brief       ʼIIC
  * @param       
  * @retval      
  */
 void ct_iic_init(void)
 {
-    GPIO_InitTypeDef gpio_init_struct;
-    
-    CT_IIC_SCL_GPIO_CLK_ENABLE();   /* SCLʱʹ */
-    CT_IIC_SDA_GPIO_CLK_ENABLE();   /* SDAʱʹ */
-
-    gpio_init_struct.Pin = CT_IIC_SCL_GPIO_PIN;
-    gpio_init_struct.Mode = GPIO_MODE_OUTPUT_OD;             /* © */
-    gpio_init_struct.Pull = GPIO_PULLUP;                     /*  */
-    gpio_init_struct.Speed = GPIO_SPEED_FREQ_HIGH;           /*  */
-    HAL_GPIO_Init(CT_IIC_SCL_GPIO_PORT, &gpio_init_struct);  /* ʼSCL */
-    
-    gpio_init_struct.Pin = CT_IIC_SDA_GPIO_PIN;
-    HAL_GPIO_Init(CT_IIC_SDA_GPIO_PORT, &gpio_init_struct);  /* ʼSDA */
-    /* SDAģʽ,©,, ͲIO, ©ʱ(=1), ҲԶȡⲿźŵĸߵ͵ƽ */
-
-    ct_iic_stop();  /* ֹͣ豸 */
-}
-
-/**
- * @brief       IICʼź
- * @param       
- * @retval      
- */
-void ct_iic_start(void)
-{
-    CT_IIC_SDA(1);
-    CT_IIC_SCL(1);
-    ct_iic_delay();
-    CT_IIC_SDA(0);      /* STARTź: SCLΪʱ, SDAӸ߱ɵ, ʾʼź */
-    ct_iic_delay();
-    CT_IIC_SCL(0);      /* ǯסI2Cߣ׼ͻ */
-    ct_iic_delay();
+    CT_IIC_SCL_GPIO_CLK_ENABLE();  /* SCLʱʹ */
+    CT_IIC_SDA_GPIO_CLK_ENABLE();  /* SDAʱʹ */
+    sw_i2c_init(&s_ct_iic_bus);       /* © + , ֹͣ豸 */
 }
 
-/**
- * @brief       IICֹͣź
- * @param       
- * @retval      
- */
-void ct_iic_stop(void)
-{
-    CT_IIC_SDA(0);      /* STOPź: SCLΪʱ, SDAӵͱɸ, ʾֹͣź */
-    ct_iic_delay();
-    CT_IIC_SCL(1);
-    ct_iic_delay();
-    CT_IIC_SDA(1);      /* I2C߽ź */
-    ct_iic_delay();
-}
-
-/**
- * @brief       ȴӦźŵ
- * @param       
- * @retval      1Ӧʧ
- *              0Ӧɹ
- */
-uint8_t ct_iic_wait_ack(void)
-{
-    uint8_t waittime = 0;
-    uint8_t rack = 0;
-    
-    CT_IIC_SDA(1);      /* ͷSDA(ʱⲿSDA) */
-    ct_iic_delay();
-    CT_IIC_SCL(1);      /* SCL=1, ʱӻԷACK */
-    ct_iic_delay();
-
-    while (CT_READ_SDA) /* ȴӦ */
-    {
-        waittime++;
-
-        if (waittime > 250)
-        {
-            ct_iic_stop();
-            rack = 1;
-            break;
-        }
-
-        ct_iic_delay();
-    }
-
-    CT_IIC_SCL(0);      /* SCL=0, ACK */
-    ct_iic_delay();
-    return rack;
-}
-
-
-/**
- * @brief       ACKӦ
- * @param       
- * @retval      
- */
-void ct_iic_ack(void)
-{
-    CT_IIC_SDA(0);  /* SCL 0 -> 1  ʱSDA = 0,ʾӦ */
-    ct_iic_delay();
-    CT_IIC_SCL(1);
-    ct_iic_delay();
-    CT_IIC_SCL(0);
-    ct_iic_delay(); 
-    CT_IIC_SDA(1);  /* ͷSDA */
-    ct_iic_delay(); 
-}
-
-/**
- * @brief       ACKӦ
- * @param       
- * @retval      
- */
-void ct_iic_nack(void)
-{
-    CT_IIC_SDA(1);  /* SCL 0 -> 1  ʱ SDA = 1,ʾӦ */
-    ct_iic_delay();
-    CT_IIC_SCL(1);
-    ct_iic_delay();
-    CT_IIC_SCL(0);
-    ct_iic_delay();
-}
-
-/**
- * @brief       IICһֽ
- * @param       data: Ҫ͵
- * @retval      
- */
-void ct_iic_send_byte(uint8_t data)
-{
-    uint8_t t;
-    
-    for (t = 0; t < 8; t++)
-    {
-        CT_IIC_SDA((data & 0x80) >> 7); /* λȷ */
-        ct_iic_delay();
-        CT_IIC_SCL(1);
-        ct_iic_delay();
-        CT_IIC_SCL(0);
-        data <<= 1;     /* 1λ,һη */
-    }
-
-    CT_IIC_SDA(1);      /* , ͷSDA */
-}
-
-/**
- * @brief       IICһֽ
- * @param       ack:  ack=1ʱack; ack=0ʱnack
- * @retval      յ
- */
-uint8_t ct_iic_read_byte(unsigned char ack)
-{
-    uint8_t i, receive = 0;
-
-    for (i = 0; i < 8; i++ )    /* 1ֽ */
-    {
-        receive <<= 1;  /* λ,յλҪ */
-        CT_IIC_SCL(1);
-        ct_iic_delay();
-
-        if (CT_READ_SDA)
-        {
-            receive++;
-        }
-        
-        CT_IIC_SCL(0);
-        ct_iic_delay();
-
-    }
-
-    if (!ack)
-    {
-        ct_iic_nack();  /* nACK */
-    }
-    else
-    {
-        ct_iic_ack();   /* ACK */
-    }
-
-    return receive;
-}
-
-
-
-
-
-
-
+/* ½ӿڱԭк, ֱת sw_i2c */
+void ct_iic_start(void) { sw_i2c_start(&s_ct_iic_bus); }
+void ct_iic_stop(void) { sw_i2c_stop(&s_ct_iic_bus); }
+void ct_iic_ack(void) { sw_i2c_ack(&s_ct_iic_bus); }
+void ct_iic_nack(void) { sw_i2c_nack(&s_ct_iic_bus); }
+uint8_t ct_iic_wait_ack(void) { return sw_i2c_wait_ack(&s_ct_iic_bus); }
+void ct_iic_send_byte(uint8_t data) { sw_i2c_send_byte(&s_ct_iic_bus, data); }
+uint8_t ct_iic_read_byte(unsigned char ack) { return sw_i2c_read_byte(&s_ct_iic_bus, ack); }
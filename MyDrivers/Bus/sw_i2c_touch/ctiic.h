@@ -18,6 +18,8 @@
  * ޸˵
  * V1.0 20200425
  * һη
+ * V1.1
+ * ʱͨ I2C  (sw_i2c) ʵ, ļֻ뵵λ
  *
  ****************************************************************************************************
  */
@@ -26,6 +28,7 @@
 #define __CT_IIC_H
 
 #include "main.h"
+#include "sw_i2c.h"
 
 
 /******************************************************************************************/
@@ -41,19 +44,8 @@
 
 /******************************************************************************************/
 
-/* IO */
-#define CT_IIC_SCL(x)     do{ x ? \
-                              HAL_GPIO_WritePin(CT_IIC_SCL_GPIO_PORT, CT_IIC_SCL_GPIO_PIN, GPIO_PIN_SET) : \
-                              HAL_GPIO_WritePin(CT_IIC_SCL_GPIO_PORT, CT_IIC_SCL_GPIO_PIN, GPIO_PIN_RESET); \
-                          }while(0)       /* SCL */
-
-#define CT_IIC_SDA(x)     do{ x ? \
-                              HAL_GPIO_WritePin(CT_IIC_SDA_GPIO_PORT, CT_IIC_SDA_GPIO_PIN, GPIO_PIN_SET) : \
-                              HAL_GPIO_WritePin(CT_IIC_SDA_GPIO_PORT, CT_IIC_SDA_GPIO_PIN, GPIO_PIN_RESET); \
-                          }while(0)       /* SDA */
-
-#define CT_READ_SDA       HAL_GPIO_ReadPin(CT_IIC_SDA_GPIO_PORT, CT_IIC_SDA_GPIO_PIN) /* ȡSDA */
-
+/* ʱλ ( sw_i2c.h), GT9xxx/FT5206 ֧ 400kHz, λʱ */
+#define CT_IIC_TIMING     (&SW_I2C_TIMING_FAST)
 
 /* IICв */
 void ct_iic_init(void);             /* ʼIICIO */
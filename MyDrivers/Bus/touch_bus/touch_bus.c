@@ -0,0 +1,322 @@
+/**
+ ******************************************************************************
+ * @file    touch_bus.c
+ * @brief   电容触摸控制器寄存器访问传输层源文件
+ * @details 软件总线沿用 ctiic 的时序，与原 ft5206/gt9xxx 中的实现一致。
+ *          硬件总线使用 HAL 的寄存器读写接口：2 字节以内的短访问 (状态寄存器、
+ *          清标志) 用中断方式，更长的读取 (触点坐标) 用 DMA。完成信号使用
+ *          独立的二值信号量，而不是任务通知，因为触摸任务的任务通知已用于
+ *          INT 引脚事件，两者混用会让传输提前“完成”。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "touch_bus.h"
+#include "ctiic.h"
+
+#if TOUCH_BUS_USE_HW_I2C
+#include "FreeRTOS.h"
+#include "cmsis_os.h"
+#include "semphr.h"
+
+#define LOG_MODULE "TOUCH_BUS"
+#include "log.h"
+#endif
+
+/* --------------------------- 私有变量 --------------------------- */
+static touch_bus_mode_t s_mode = TOUCH_BUS_SOFT;
+static bool s_inited = false;
+
+#if TOUCH_BUS_USE_HW_I2C
+I2C_HandleTypeDef hi2c3;
+DMA_HandleTypeDef hdma_i2c3_rx;
+
+static SemaphoreHandle_t s_xfer_done = NULL;
+static StaticSemaphore_t s_xfer_done_buf;
+static volatile HAL_StatusTypeDef s_xfer_status = HAL_OK;
+#endif
+
+/* --------------------------- 软件总线 --------------------------- */
+
+static void touch_bus_soft_send_reg(uint8_t addr, uint16_t reg, uint8_t reg_len)
+{
+    ct_iic_start();
+    ct_iic_send_byte(addr);             /* 发送写命令 */
+    ct_iic_wait_ack();
+
+    if (reg_len > 1)
+    {
+        ct_iic_send_byte(reg >> 8);     /* 发送高8位地址 */
+        ct_iic_wait_ack();
+    }
+
+    ct_iic_send_byte(reg & 0XFF);       /* 发送低8位地址 */
+    ct_iic_wait_ack();
+}
+
+static uint8_t touch_bus_soft_write(uint8_t addr, uint16_t reg, uint8_t reg_len, const uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+    uint8_t ret = 0;
+
+    touch_bus_soft_send_reg(addr, reg, reg_len);
+
+    for (i = 0; i < len; i++)
+    {
+        ct_iic_send_byte(buf[i]);       /* 发数据 */
+        ret = ct_iic_wait_ack();
+
+        if (ret) break;
+    }
+
+    ct_iic_stop();                      /* 产生一个停止条件 */
+    return ret;
+}
+
+static uint8_t touch_bus_soft_read(uint8_t addr, uint16_t reg, uint8_t reg_len, uint8_t *buf, uint16_t len)
+{
+    uint16_t i;
+
+    touch_bus_soft_send_reg(addr, reg, reg_len);
+    ct_iic_start();
+    ct_iic_send_byte(addr | 0X01);      /* 发送读命令 */
+    ct_iic_wait_ack();
+
+    for (i = 0; i < len; i++)
+    {
+        buf[i] = ct_iic_read_byte(i == (len - 1) ? 0 : 1);  /* 读取数据 */
+    }
+
+    ct_iic_stop();                      /* 产生一个停止条件 */
+    return 0;                           /* 软件总线读取不检查应答, 与原实现一致 */
+}
+
+/* --------------------------- 硬件总线 --------------------------- */
+#if TOUCH_BUS_USE_HW_I2C
+
+/**
+ * @brief 初始化 I2C3 (PA8/PC9) 与接收 DMA (DMA1 Stream2 Channel3)
+ * @return true: 成功
+ */
+static bool touch_bus_hw_init(void)
+{
+    GPIO_InitTypeDef gpio_init_struct = {0};
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    __HAL_RCC_I2C3_CLK_ENABLE();
+
+    gpio_init_struct.Pin = GPIO_PIN_8;                      /* I2C3_SCL */
+    gpio_init_struct.Mode = GPIO_MODE_AF_OD;
+    gpio_init_struct.Pull = GPIO_PULLUP;
+    gpio_init_struct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio_init_struct.Alternate = GPIO_AF4_I2C3;
+    HAL_GPIO_Init(GPIOA, &gpio_init_struct);
+
+    gpio_init_struct.Pin = GPIO_PIN_9;                      /* I2C3_SDA */
+    HAL_GPIO_Init(GPIOC, &gpio_init_struct);
+
+    hdma_i2c3_rx.Instance = DMA1_Stream2;
+    hdma_i2c3_rx.Init.Channel = DMA_CHANNEL_3;
+    hdma_i2c3_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_i2c3_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_i2c3_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_i2c3_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_i2c3_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_i2c3_rx.Init.Mode = DMA_NORMAL;
+    hdma_i2c3_rx.Init.Priority = DMA_PRIORITY_HIGH;
+    hdma_i2c3_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_i2c3_rx) != HAL_OK)
+    {
+        return false;
+    }
+    __HAL_LINKDMA(&hi2c3, hdmarx, hdma_i2c3_rx);
+
+    hi2c3.Instance = I2C3;
+    hi2c3.Init.ClockSpeed = TOUCH_BUS_HW_CLOCK_HZ;
+    hi2c3.Init.DutyCycle = I2C_DUTYCYCLE_2;
+    hi2c3.Init.OwnAddress1 = 0;
+    hi2c3.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+    hi2c3.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+    hi2c3.Init.OwnAddress2 = 0;
+    hi2c3.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+    hi2c3.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+    if (HAL_I2C_Init(&hi2c3) != HAL_OK)
+    {
+        return false;
+    }
+
+    /* 需不高于 configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY, 回调中释放信号量 */
+    HAL_NVIC_SetPriority(DMA1_Stream2_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream2_IRQn);
+    HAL_NVIC_SetPriority(I2C3_EV_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C3_EV_IRQn);
+    HAL_NVIC_SetPriority(I2C3_ER_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(I2C3_ER_IRQn);
+
+    s_xfer_done = xSemaphoreCreateBinaryStatic(&s_xfer_done_buf);
+    return s_xfer_done != NULL;
+}
+
+/**
+ * @brief 启动一次硬件传输并阻塞等待完成
+ */
+static uint8_t touch_bus_hw_xfer(uint8_t addr, uint16_t reg, uint8_t reg_len, uint8_t *buf, uint16_t len, bool is_read)
+{
+    uint16_t mem_size = (reg_len > 1) ? I2C_MEMADD_SIZE_16BIT : I2C_MEMADD_SIZE_8BIT;
+    HAL_StatusTypeDef status;
+
+    // 调度器未运行或处于中断上下文时无法等待信号量，退回阻塞传输
+    if (osKernelRunning() == 0 || __get_IPSR() != 0)
+    {
+        status = is_read ? HAL_I2C_Mem_Read(&hi2c3, addr, reg, mem_size, buf, len, TOUCH_BUS_TIMEOUT_MS)
+                         : HAL_I2C_Mem_Write(&hi2c3, addr, reg, mem_size, buf, len, TOUCH_BUS_TIMEOUT_MS);
+        return (status == HAL_OK) ? 0 : 1;
+    }
+
+    (void)xSemaphoreTake(s_xfer_done, 0);   // 清除上一次超时后迟到的完成信号
+    s_xfer_status = HAL_ERROR;
+
+    if (!is_read)
+    {
+        status = HAL_I2C_Mem_Write_IT(&hi2c3, addr, reg, mem_size, buf, len);
+    }
+    else if (len > 2)
+    {
+        status = HAL_I2C_Mem_Read_DMA(&hi2c3, addr, reg, mem_size, buf, len);
+    }
+    else
+    {
+        status = HAL_I2C_Mem_Read_IT(&hi2c3, addr, reg, mem_size, buf, len);
+    }
+
+    if (status == HAL_OK)
+    {
+        if (xSemaphoreTake(s_xfer_done, pdMS_TO_TICKS(TOUCH_BUS_TIMEOUT_MS)) == pdTRUE)
+        {
+            status = s_xfer_status;
+        }
+        else
+        {
+            status = HAL_TIMEOUT;
+        }
+    }
+
+    if (status == HAL_TIMEOUT)
+    {
+        // 传输卡死 (如控制器复位中拉低 SCL)：复位外设，避免后续一直 BUSY
+        LOG_WARN("触摸I2C传输超时 (地址: 0x%02X)，复位I2C3", addr >> 1);
+        HAL_DMA_Abort(&hdma_i2c3_rx);
+        HAL_I2C_DeInit(&hi2c3);
+        HAL_I2C_Init(&hi2c3);
+    }
+
+    return (status == HAL_OK) ? 0 : 1;
+}
+
+static void touch_bus_hw_complete_from_isr(I2C_HandleTypeDef *hi2c, HAL_StatusTypeDef status)
+{
+    BaseType_t woken = pdFALSE;
+
+    if (hi2c != &hi2c3 || s_xfer_done == NULL)
+    {
+        return;
+    }
+
+    s_xfer_status = status;
+    xSemaphoreGiveFromISR(s_xfer_done, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    touch_bus_hw_complete_from_isr(hi2c, HAL_OK);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+    touch_bus_hw_complete_from_isr(hi2c, HAL_OK);
+}
+
+/**
+ * @brief I2C 错误回调转发 (中断上下文)
+ */
+void touch_bus_error_callback(I2C_HandleTypeDef *hi2c)
+{
+    touch_bus_hw_complete_from_isr(hi2c, HAL_ERROR);  /* NACK/总线错误 */
+}
+
+#endif /* TOUCH_BUS_USE_HW_I2C */
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化传输层
+ */
+void touch_bus_init(void)
+{
+    if (s_inited)
+    {
+        return;
+    }
+
+    s_inited = true;
+    s_mode = TOUCH_BUS_SOFT;
+
+#if TOUCH_BUS_USE_HW_I2C
+    if (touch_bus_hw_init())
+    {
+        s_mode = TOUCH_BUS_HW_DMA;
+        return;
+    }
+
+    LOG_WARN("触摸硬件I2C初始化失败，使用软件I2C");
+#endif
+
+    ct_iic_init();  /* 初始化电容屏的软件I2C总线 */
+}
+
+/**
+ * @brief 当前实际使用的传输方式
+ */
+touch_bus_mode_t touch_bus_get_mode(void)
+{
+    return s_mode;
+}
+
+/**
+ * @brief 写控制器寄存器
+ */
+uint8_t touch_bus_write(uint8_t addr, uint16_t reg, uint8_t reg_len, const uint8_t *buf, uint16_t len)
+{
+#if TOUCH_BUS_USE_HW_I2C
+    if (s_mode == TOUCH_BUS_HW_DMA)
+    {
+        return touch_bus_hw_xfer(addr, reg, reg_len, (uint8_t *)buf, len, false);
+    }
+#endif
+
+    return touch_bus_soft_write(addr, reg, reg_len, buf, len);
+}
+
+/**
+ * @brief 读控制器寄存器
+ */
+uint8_t touch_bus_read(uint8_t addr, uint16_t reg, uint8_t reg_len, uint8_t *buf, uint16_t len)
+{
+    if (len == 0)
+    {
+        return 0;
+    }
+
+#if TOUCH_BUS_USE_HW_I2C
+    if (s_mode == TOUCH_BUS_HW_DMA)
+    {
+        return touch_bus_hw_xfer(addr, reg, reg_len, buf, len, true);
+    }
+#endif
+
+    return touch_bus_soft_read(addr, reg, reg_len, buf, len);
+}
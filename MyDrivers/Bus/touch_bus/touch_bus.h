@@ -0,0 +1,88 @@
+/**
+ ******************************************************************************
+ * @file    touch_bus.h
+ * @brief   电容触摸控制器寄存器访问传输层头文件
+ * @details ft5206/gt9xxx 的 rd_reg/wr_reg 统一经由本层访问控制器。
+ *          默认使用 sw_i2c_touch (ctiic) 软件模拟总线；打开
+ *          TOUCH_BUS_USE_HW_I2C 后改用硬件 I2C3，读取走 DMA，传输期间
+ *          调用任务阻塞而不占用 CPU。硬件初始化失败时自动退回软件总线。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __TOUCH_BUS_H
+#define __TOUCH_BUS_H
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+/* 板载触摸 SCL/SDA 接在 PB0/PF11，不是任何硬件 I2C 的复用引脚；
+ * 使用硬件 I2C 需把触摸排线改接到 I2C3 (PA8: SCL, PC9: SDA) 后再置 1 */
+#define TOUCH_BUS_USE_HW_I2C        0
+#define TOUCH_BUS_HW_CLOCK_HZ       400000  // 硬件 I2C 时钟 (GT9xxx/FT5206 均支持 400 kHz)
+#define TOUCH_BUS_TIMEOUT_MS        10      // 单次寄存器访问超时
+
+/* --------------------------- 数据类型 --------------------------- */
+typedef enum {
+    TOUCH_BUS_SOFT = 0,     // 软件模拟 I2C (ctiic)
+    TOUCH_BUS_HW_DMA,       // 硬件 I2C3 + DMA
+} touch_bus_mode_t;
+
+#if TOUCH_BUS_USE_HW_I2C
+extern I2C_HandleTypeDef hi2c3;
+extern DMA_HandleTypeDef hdma_i2c3_rx;
+#endif
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化传输层 (可重复调用)，在控制器复位前调用
+ */
+void touch_bus_init(void);
+
+/**
+ * @brief 当前实际使用的传输方式
+ */
+touch_bus_mode_t touch_bus_get_mode(void);
+
+/**
+ * @brief 写控制器寄存器
+ * @param addr    8 位写地址 (如 GT9XXX_CMD_WR)
+ * @param reg     起始寄存器地址
+ * @param reg_len 寄存器地址字节数 (FT5206: 1, GT9xxx: 2)
+ * @param buf     数据
+ * @param len     数据长度
+ * @return 0: 成功, 1: 失败 (NACK/超时)
+ */
+uint8_t touch_bus_write(uint8_t addr, uint16_t reg, uint8_t reg_len, const uint8_t *buf, uint16_t len);
+
+/**
+ * @brief 读控制器寄存器
+ * @param addr    8 位写地址，读地址为 addr | 1
+ * @param reg     起始寄存器地址
+ * @param reg_len 寄存器地址字节数
+ * @param buf     输出缓冲区
+ * @param len     读取长度
+ * @return 0: 成功, 1: 失败 (NACK/超时)
+ */
+uint8_t touch_bus_read(uint8_t addr, uint16_t reg, uint8_t reg_len, uint8_t *buf, uint16_t len);
+
+#if TOUCH_BUS_USE_HW_I2C
+/**
+ * @brief I2C 错误回调转发 (中断上下文)，由唯一的 HAL_I2C_ErrorCallback 调用
+ */
+void touch_bus_error_callback(I2C_HandleTypeDef *hi2c);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TOUCH_BUS_H */
@@ -0,0 +1,114 @@
+/**
+ * @file checksum.h
+ * @brief 公共校验和工具头文件 (CRC-8 / CRC-16 / CRC-32，以及串口二进制帧使用的 COBS 编码)
+ * @author MmsY
+ * @date 2025
+*/
+
+#ifndef __CHECKSUM_H
+#define __CHECKSUM_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 配置 --------------------------- */
+// 查表方式：0 使用 256 项整字节表 (256 字节 Flash，每字节一次查表)
+//           1 使用 16 项半字节表 (16 字节 Flash，每字节两次查表)
+#ifndef CHECKSUM_CRC8_USE_NIBBLE_TABLE
+#define CHECKSUM_CRC8_USE_NIBBLE_TABLE 0
+#endif
+
+/* --------------------------- CRC-8 --------------------------- */
+// CRC-8/NRSC-5 (Sensirion): 多项式 0x31 (x^8+x^5+x^4+1)，初值 0xFF，不反转，无异或输出
+#define CRC8_POLY 0x31
+#define CRC8_INIT 0xFF
+
+/**
+ * @brief 流式更新 CRC-8
+ * @note  分段计算时把上一段的返回值作为下一段的 crc 传入，首段传 CRC8_INIT
+ * @param crc 当前 CRC 值
+ * @param data 数据
+ * @param len 数据长度
+ * @return uint8_t 更新后的 CRC 值
+ */
+uint8_t CRC8_Update(uint8_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief 计算一段数据的 CRC-8
+ * @param data 数据
+ * @param len 数据长度
+ * @return uint8_t CRC 值
+ */
+uint8_t CRC8_Compute(const uint8_t *data, size_t len);
+
+/* --------------------------- CRC-16 --------------------------- */
+// CRC-16/MODBUS: 反射多项式 0xA001，初值 0xFFFF，无异或输出；帧中低字节在前。
+// 帧长不超过 256 字节，使用 16 项半字节表 (32 字节 Flash)
+#define CRC16_MODBUS_INIT 0xFFFF
+
+/**
+ * @brief 流式更新 CRC-16/MODBUS
+ * @note  首段传 CRC16_MODBUS_INIT，之后把上一段的返回值传入
+ * @param crc 当前 CRC 值
+ * @param data 数据
+ * @param len 数据长度
+ * @return uint16_t 更新后的 CRC 值
+ */
+uint16_t CRC16_Modbus_Update(uint16_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief 计算一段数据的 CRC-16/MODBUS
+ * @param data 数据
+ * @param len 数据长度
+ * @return uint16_t CRC 值
+ */
+uint16_t CRC16_Modbus_Compute(const uint8_t *data, size_t len);
+
+/* --------------------------- CRC-32 --------------------------- */
+// CRC-32/ISO-HDLC: 反射多项式 0xEDB88320，初值与输出异或均为 0xFFFFFFFF，
+// 与 zlib.crc32 / Python binascii.crc32 结果一致，用于校验主机工具生成的数据块。
+// 数据量大、不在热路径上，固定使用 16 项半字节表 (64 字节 Flash)
+
+/**
+ * @brief 流式更新 CRC-32
+ * @note  与 zlib 相同，输入输出均为最终值：首段传 0，之后把上一段的返回值传入
+ * @param crc 上一段的 CRC 值
+ * @param data 数据
+ * @param len 数据长度
+ * @return uint32_t 更新后的 CRC 值
+ */
+uint32_t CRC32_Update(uint32_t crc, const uint8_t *data, size_t len);
+
+/**
+ * @brief 计算一段数据的 CRC-32
+ * @param data 数据
+ * @param len 数据长度
+ * @return uint32_t CRC 值
+ */
+uint32_t CRC32_Compute(const uint8_t *data, size_t len);
+
+/* --------------------------- COBS --------------------------- */
+// 串口二进制帧 0x00 | COBS(载荷 | CRC-32) | 0x00 的编码部分：输出不含 0x00，
+// 与文本日志混在同一串口上也能按分隔符可靠分帧
+
+// 编码输出的最大长度 (每 254 字节最多增加 1 字节开销，不含分隔符)
+#define COBS_ENCODED_MAX(len) ((len) + (len) / 254 + 1)
+
+/**
+ * @brief COBS 编码
+ * @param src 数据
+ * @param len 数据长度
+ * @param dst 输出缓冲区 (至少 COBS_ENCODED_MAX(len) 字节)
+ * @return size_t 编码后长度 (不含分隔符)
+ */
+size_t COBS_Encode(const uint8_t *src, size_t len, uint8_t *dst);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __CHECKSUM_H */
@@ -0,0 +1,184 @@
+/**
+ * @file dsp_q15.c
+ * @brief 16 位定点数据的块运算与滤波
+ * @author MmsY
+ * @date 2025
+*/
+
+#include "dsp_q15.h"
+
+#if DSP_Q15_USE_SIMD
+#include "cmsis_compiler.h"
+
+// 一次读取两个相邻的 16 位样本：低半字为 p[0]，高半字为 p[1]
+#define DSP_READ_PAIR(p) __UNALIGNED_UINT32_READ(p)
+#endif
+
+/* --------------------------- 块运算 --------------------------- */
+
+/**
+ * @brief 求和
+ */
+int32_t DSP_SumQ15(const int16_t *src, uint32_t len) {
+    int32_t acc = 0;
+    uint32_t i = 0;
+
+#if DSP_Q15_USE_SIMD
+    for (; i + 1 < len; i += 2) {
+        acc = (int32_t)__SMLAD(DSP_READ_PAIR(&src[i]), 0x00010001U, (uint32_t)acc);
+    }
+#endif
+    for (; i < len; i++) {
+        acc += src[i];
+    }
+    return acc;
+}
+
+/**
+ * @brief 求最小值与最大值
+ */
+void DSP_MinMaxQ15(const int16_t *src, uint32_t len, int16_t *min, int16_t *max) {
+    int16_t lo, hi;
+    uint32_t i = 1;
+
+    if (len == 0) {
+        return;
+    }
+    lo = hi = src[0];
+
+#if DSP_Q15_USE_SIMD
+    if (len >= 3) {
+        // 两个通道各自维护极值：__SSUB16 按通道置 GE 位，__SEL 按 GE 位逐通道选择
+        uint32_t vmin = (uint16_t)src[0] * 0x00010001U;
+        uint32_t vmax = vmin;
+
+        for (; i + 1 < len; i += 2) {
+            uint32_t w = DSP_READ_PAIR(&src[i]);
+            __SSUB16(w, vmax);
+            vmax = __SEL(w, vmax);
+            __SSUB16(w, vmin);
+            vmin = __SEL(vmin, w);
+        }
+        lo = (int16_t)vmin;
+        if ((int16_t)(vmin >> 16) < lo) {
+            lo = (int16_t)(vmin >> 16);
+        }
+        hi = (int16_t)vmax;
+        if ((int16_t)(vmax >> 16) > hi) {
+            hi = (int16_t)(vmax >> 16);
+        }
+    }
+#endif
+    for (; i < len; i++) {
+        if (src[i] < lo) {
+            lo = src[i];
+        }
+        if (src[i] > hi) {
+            hi = src[i];
+        }
+    }
+    *min = lo;
+    *max = hi;
+}
+
+/**
+ * @brief 交错存放的两路 12 位采样分别求和
+ * @details 两路在同一个字的高/低半字中并行累加，每 DSP_U12_LANE_FLUSH 对展开一次
+ */
+void DSP_SumPairsU12(const uint16_t *src, uint32_t pairs, uint32_t sum[2]) {
+    sum[0] = 0;
+    sum[1] = 0;
+
+    while (pairs > 0) {
+        uint32_t n = (pairs < DSP_U12_LANE_FLUSH) ? pairs : DSP_U12_LANE_FLUSH;
+        pairs -= n;
+#if DSP_Q15_USE_SIMD
+        uint32_t acc = 0;
+        for (; n > 0; n--, src += 2) {
+            acc = __UADD16(acc, DSP_READ_PAIR(src));
+        }
+        sum[0] += acc & 0xFFFFU;
+        sum[1] += acc >> 16;
+#else
+        for (; n > 0; n--, src += 2) {
+            sum[0] += src[0];
+            sum[1] += src[1];
+        }
+#endif
+    }
+}
+
+/**
+ * @brief 点积
+ */
+int64_t DSP_DotQ15(const int16_t *a, const int16_t *b, uint32_t len) {
+    int64_t acc = 0;
+    uint32_t i = 0;
+
+#if DSP_Q15_USE_SIMD
+    for (; i + 1 < len; i += 2) {
+        acc = (int64_t)__SMLALD(DSP_READ_PAIR(&a[i]), DSP_READ_PAIR(&b[i]), (uint64_t)acc);
+    }
+#endif
+    for (; i < len; i++) {
+        acc += (int32_t)a[i] * b[i];
+    }
+    return acc;
+}
+
+/* --------------------------- 滤波 --------------------------- */
+
+/**
+ * @brief FIR 单点输出
+ */
+int16_t DSP_FirQ15(const int16_t *src, const int16_t *coeffs, uint16_t taps) {
+    int64_t acc = (DSP_DotQ15(src, coeffs, taps) + (1 << 14)) >> 15;
+
+    if (acc > INT16_MAX) {
+        return INT16_MAX;
+    }
+    if (acc < INT16_MIN) {
+        return INT16_MIN;
+    }
+    return (int16_t)acc;
+}
+
+void DSP_Iir1Q15_Init(DSP_Iir1Q15_t *f, int16_t alpha, int16_t initial) {
+    f->alpha = alpha;
+    f->acc = (int32_t)initial * 32768;
+}
+
+/**
+ * @brief 一阶 IIR 更新
+ * @note  alpha * (x - y) 最大为 32767 * 65535，不超出 int32_t；
+ *        新的 acc 位于 y 与 x 之间，同样不会溢出
+ */
+int16_t DSP_Iir1Q15_Update(DSP_Iir1Q15_t *f, int16_t x) {
+    int32_t y = (f->acc + (1 << 14)) >> 15;
+
+    f->acc += (int32_t)f->alpha * (x - y);
+    return (int16_t)((f->acc + (1 << 14)) >> 15);
+}
+
+void DSP_MovAvgQ15_Init(DSP_MovAvgQ15_t *f, int16_t *window, uint16_t len) {
+    f->window = window;
+    f->len = len;
+    f->pos = 0;
+    f->count = 0;
+    f->sum = 0;
+}
+
+/**
+ * @brief 推入新样本并返回当前窗口均值
+ */
+int16_t DSP_MovAvgQ15_Update(DSP_MovAvgQ15_t *f, int16_t x) {
+    if (f->count < f->len) {
+        f->count++;
+    } else {
+        f->sum -= f->window[f->pos];
+    }
+    f->window[f->pos] = x;
+    f->sum += x;
+    f->pos = (uint16_t)((f->pos + 1U == f->len) ? 0U : f->pos + 1U);
+    return (int16_t)(f->sum / (int32_t)f->count);
+}
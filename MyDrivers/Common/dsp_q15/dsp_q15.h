@@ -0,0 +1,115 @@
+/**
+ * @file dsp_q15.h
+ * @brief 16 位定点数据的块运算与滤波 (Cortex-M4 SIMD)
+ * @details 定点历史 (int16_t) 与 ADC 采样 (12 位) 按 32 位字一次读取两个样本，
+ *          用 CMSIS-Core 的 SIMD 指令同时处理两个 16 位通道：
+ *            求和 / 点积   __SMLAD / __SMLALD (每周期两次乘加)
+ *            最小 / 最大值 __SSUB16 + __SEL
+ *            ADC 双通道累加 __UADD16
+ *          工程未包含 CMSIS-DSP 库，这里只实现用到的几个核心函数；
+ *          非 ARMv7E-M 目标 (如主机测试) 自动退回逐点实现，结果一致。
+ *          输入指针只需 2 字节对齐 (M4 的 LDR 支持非对齐访问)。
+ * @author MmsY
+ * @date 2025
+*/
+
+#ifndef __DSP_Q15_H
+#define __DSP_Q15_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 配置 --------------------------- */
+#if defined(__TARGET_ARCH_7E_M) || (defined(__ARM_ARCH_7EM__) && (__ARM_ARCH_7EM__ == 1))
+#define DSP_Q15_USE_SIMD 1
+#else
+#define DSP_Q15_USE_SIMD 0
+#endif
+
+// DSP_SumPairsU12 每累加这么多对样本就展开到 32 位 (16 * 4095 < 65536)
+#define DSP_U12_LANE_FLUSH 16
+
+/* --------------------------- 块运算 --------------------------- */
+
+/**
+ * @brief 求和
+ * @param src 数据
+ * @param len 点数 (len < 65536 时不会溢出)
+ * @return int32_t 各点之和
+ */
+int32_t DSP_SumQ15(const int16_t *src, uint32_t len);
+
+/**
+ * @brief 求最小值与最大值
+ * @note  len 为 0 时不修改输出
+ * @param src 数据
+ * @param len 点数
+ * @param min 输出最小值
+ * @param max 输出最大值
+ */
+void DSP_MinMaxQ15(const int16_t *src, uint32_t len, int16_t *min, int16_t *max);
+
+/**
+ * @brief 交错存放的两路 12 位采样分别求和 ({a0, b0, a1, b1, ...})
+ * @param src   数据
+ * @param pairs 样本对数
+ * @param sum   输出：sum[0] 为偶数位置之和，sum[1] 为奇数位置之和
+ */
+void DSP_SumPairsU12(const uint16_t *src, uint32_t pairs, uint32_t sum[2]);
+
+/**
+ * @brief 点积 (64 位累加，不会溢出)
+ * @return int64_t sum(a[i] * b[i])，Q30
+ */
+int64_t DSP_DotQ15(const int16_t *a, const int16_t *b, uint32_t len);
+
+/* --------------------------- 滤波 --------------------------- */
+
+/**
+ * @brief FIR 单点输出 (用于抽取：每隔 M 个输入调用一次)
+ * @param src   最近 taps 个输入，src[taps - 1] 为最新样本
+ * @param coeffs 按时间反序存放的系数 (coeffs[taps - 1] 作用于最新样本)，Q15
+ * @param taps  阶数
+ * @return int16_t 输出 (饱和到 int16_t)
+ */
+int16_t DSP_FirQ15(const int16_t *src, const int16_t *coeffs, uint16_t taps);
+
+/**
+ * @brief 一阶 IIR 低通 (指数滑动平均) 状态
+ * @details y += alpha * (x - y)；acc 保存 y << 15 以保留小数部分
+ */
+typedef struct {
+    int32_t acc;
+    int16_t alpha;  // 平滑系数，Q15 (32768 * (1 - e^(-T/tau)))
+} DSP_Iir1Q15_t;
+
+void DSP_Iir1Q15_Init(DSP_Iir1Q15_t *f, int16_t alpha, int16_t initial);
+int16_t DSP_Iir1Q15_Update(DSP_Iir1Q15_t *f, int16_t x);
+
+/**
+ * @brief 滑动平均状态 (窗口存储由调用者提供)
+ */
+typedef struct {
+    int16_t *window;
+    uint16_t len;
+    uint16_t pos;
+    uint16_t count;
+    int32_t sum;
+} DSP_MovAvgQ15_t;
+
+void DSP_MovAvgQ15_Init(DSP_MovAvgQ15_t *f, int16_t *window, uint16_t len);
+
+/**
+ * @brief 推入新样本并返回当前窗口均值 (窗口未满时按已有点数平均)
+ */
+int16_t DSP_MovAvgQ15_Update(DSP_MovAvgQ15_t *f, int16_t x);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __DSP_Q15_H */
@@ -0,0 +1,82 @@
+/**
+ * @file fmt_fixed.c
+ * @brief 定点小数格式化
+ * @author MmsY
+ * @date 2025
+*/
+
+#include "fmt_fixed.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+static const float s_scale[FMT_FIXED_MAX_DECIMALS + 1] = {1.0f, 10.0f, 100.0f, 1000.0f};
+static const uint32_t s_pow10[FMT_FIXED_MAX_DECIMALS + 1] = {1U, 10U, 100U, 1000U};
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 把 value 格式化为定点小数
+ */
+size_t fmt_fixed(char *buf, float value, uint8_t decimals, uint8_t width, uint8_t flags) {
+    char digits[12];
+    uint8_t n = 0;
+    size_t len, pos = 0;
+    uint32_t scaled, int_part, frac_part;
+    int negative;
+    float scaled_f;
+
+    if (decimals > FMT_FIXED_MAX_DECIMALS) {
+        decimals = FMT_FIXED_MAX_DECIMALS;
+    }
+    if (width > FMT_FIXED_BUF_SIZE - 1) {
+        width = FMT_FIXED_BUF_SIZE - 1;
+    }
+
+    negative = value < 0.0f;
+    scaled_f = (negative ? -value : value) * s_scale[decimals] + 0.5f;
+    if (!(scaled_f < 4294967040.0f)) { // NaN 与溢出 (最大的可表示 float < 2^32)
+        buf[0] = '-';
+        buf[1] = '-';
+        buf[2] = '\0';
+        return 2;
+    }
+    scaled = (uint32_t)scaled_f;
+    negative = negative && scaled != 0; // -0.04 -> "0.0"
+
+    // 小数部分低位在前写入 digits，整数部分随后，最后整体反向输出
+    int_part = scaled / s_pow10[decimals];
+    frac_part = scaled - int_part * s_pow10[decimals];
+    for (uint8_t i = 0; i < decimals; i++) {
+        digits[n++] = (char)('0' + frac_part % 10U);
+        frac_part /= 10U;
+    }
+    do {
+        digits[n++] = (char)('0' + int_part % 10U);
+        int_part /= 10U;
+    } while (int_part != 0U);
+
+    len = (size_t)n + (decimals ? 1U : 0U) + (negative ? 1U : 0U);
+    if (!(flags & FMT_FIXED_ZERO_PAD)) {
+        while (len < width) {
+            buf[pos++] = ' ';
+            width--;
+        }
+    }
+    if (negative) {
+        buf[pos++] = '-';
+    }
+    while (len < width) { // 补零
+        buf[pos++] = '0';
+        len++;
+    }
+    while (n > decimals) {
+        buf[pos++] = digits[--n];
+    }
+    if (decimals) {
+        buf[pos++] = '.';
+        while (n > 0) {
+            buf[pos++] = digits[--n];
+        }
+    }
+    buf[pos] = '\0';
+    return pos;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file fmt_fixed.h
+ * @brief 定点小数格式化 (替代 "%.1f" / "%.2f")
+ * @details 按 10^decimals 放大后四舍五入为整数，再拆成整数/小数部分逐位输出，
+ *          只用一次单精度乘法和整数除法。格式串中不再出现 %f 时，
+ *          ARM Compiler 不链接 printf 的浮点转换部分。
+ *          放大发生在 float 上，恰好落在 ...5 上的值可能与 printf
+ *          (按二进制精确值舍入) 在末位差 1。
+ *          |value| * 10^decimals 超出 uint32_t 或值为 NaN 时输出 "--"。
+ * @author MmsY
+ * @date 2025
+*/
+
+#ifndef __FMT_FIXED_H
+#define __FMT_FIXED_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 配置 --------------------------- */
+#define FMT_FIXED_BUF_SIZE 16       // 最长输出 (含符号、小数点与结束符)
+#define FMT_FIXED_MAX_DECIMALS 3
+
+// flags
+#define FMT_FIXED_ZERO_PAD 0x01     // 不足 width 时在符号之后补 '0' (同 "%05.1f")，否则在前面补空格
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 把 value 格式化为定点小数
+ * @param buf      输出缓冲区，至少 FMT_FIXED_BUF_SIZE 字节
+ * @param value    数值
+ * @param decimals 小数位数 (0 ~ FMT_FIXED_MAX_DECIMALS)
+ * @param width    最小总宽度 (0: 不填充)
+ * @param flags    FMT_FIXED_xxx
+ * @return size_t  写入的字符数 (不含结束符)
+ */
+size_t fmt_fixed(char *buf, float value, uint8_t decimals, uint8_t width, uint8_t flags);
+
+/**
+ * @brief 一位小数，返回 buf 以便直接作为 "%s" 的参数
+ */
+static inline char *fmt_q1(float value, char *buf) {
+    fmt_fixed(buf, value, 1, 0, 0);
+    return buf;
+}
+
+/**
+ * @brief 两位小数，返回 buf
+ */
+static inline char *fmt_q2(float value, char *buf) {
+    fmt_fixed(buf, value, 2, 0, 0);
+    return buf;
+}
+
+/**
+ * @brief 取整 (四舍五入)，返回 buf
+ */
+static inline char *fmt_q0(float value, char *buf) {
+    fmt_fixed(buf, value, 0, 0, 0);
+    return buf;
+}
+
+/*
+ * 以复合字面量作为缓冲区，直接用作 "%s" 参数 (典型用法是日志宏)：
+ *   LOG_INFO("R0 = %s kΩ", FMT_Q2(r0));
+ * 缓冲区在所在语句块结束前有效；日志宏只在级别通过时才求值参数。
+ */
+#define FMT_Q1(value) fmt_q1((value), (char[FMT_FIXED_BUF_SIZE]){0})
+#define FMT_Q2(value) fmt_q2((value), (char[FMT_FIXED_BUF_SIZE]){0})
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FMT_FIXED_H */
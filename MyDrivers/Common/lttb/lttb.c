@@ -0,0 +1,209 @@
+/**
+ * @file lttb.c
+ * @brief 曲线降采样 (Largest-Triangle-Three-Buckets)
+ * @details 坐标取相对于当前桶起点的样本序号：上一桶选点 A 的 x 在 [-B, 0)，
+ *          本桶候选点 P 在 [0, B)，下一桶平均点 C 在 [B, 2B)。C 不做除法，
+ *          以下一桶有效点的坐标和 (sx, sy) 与点数 n 表示，三角形面积的 2n 倍
+ *            |(n * ax - sx) * (py - ay) - (ax - px) * (sy - n * ay)|
+ *          只需整数乘法。缺少 A 时 (首桶或上一桶全为断点) 取 P 到 C 的纵向
+ *          距离，缺少 C 时 (末桶或下一桶全为断点) 取 P 到 A 的纵向距离，两者
+ *          都缺时以本桶均值代替 C。
+ * @author MmsY
+ * @date 2025
+*/
+
+#include "lttb.h"
+#include <string.h>
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 桶 k 与当前窗口的交集 (src 下标 [lo, hi))
+ */
+static void lttb_range(const LTTB_t *s, uint32_t k, uint32_t *lo, uint32_t *hi) {
+    uint32_t begin = k * s->bucket_len;
+    uint32_t end = begin + s->bucket_len;
+
+    if (begin < s->start_seq) {
+        begin = s->start_seq;
+    }
+    if (end > s->end_seq) {
+        end = s->end_seq;
+    }
+    if (begin >= end) {
+        *lo = *hi = 0;
+        return;
+    }
+    *lo = begin - s->start_seq;
+    *hi = end - s->start_seq;
+}
+
+/**
+ * @brief 有效点的坐标和 (坐标相对于 base)
+ */
+static void lttb_sum(const LTTB_t *s, const int16_t *src, uint32_t k, uint32_t base,
+                     int64_t *n, int64_t *sx, int64_t *sy) {
+    uint32_t lo, hi;
+
+    lttb_range(s, k, &lo, &hi);
+    for (uint32_t i = lo; i < hi; i++) {
+        if (src[i] != s->gap) {
+            (*n)++;
+            *sx += (int64_t)(s->start_seq + i) - (int64_t)base;
+            *sy += src[i];
+        }
+    }
+}
+
+/**
+ * @brief 为桶 k 选点，写入 out / pos 的对应槽位
+ */
+static void lttb_select(LTTB_t *s, const int16_t *src, uint32_t k) {
+    uint32_t base = k * s->bucket_len;
+    uint16_t slot = (uint16_t)(k - s->first);
+    bool has_a = false;
+    int64_t ax = 0, ay = 0;
+    int64_t n = 0, sx = 0, sy = 0;
+    int64_t best = -1;
+    uint32_t lo, hi;
+
+    if (slot > 0 && s->out[slot - 1] != s->gap) {
+        has_a = true;
+        ax = (int64_t)s->pos[slot - 1] - (int64_t)s->bucket_len;
+        ay = s->out[slot - 1];
+    }
+    lttb_sum(s, src, k + 1, base, &n, &sx, &sy);
+    if (!has_a && n == 0) {
+        lttb_sum(s, src, k, base, &n, &sx, &sy); // 以本桶均值代替 C
+    }
+
+    s->out[slot] = s->gap;
+    s->pos[slot] = 0;
+    lttb_range(s, k, &lo, &hi);
+    for (uint32_t i = lo; i < hi; i++) {
+        int64_t px, py, metric;
+
+        if (src[i] == s->gap) {
+            continue;
+        }
+        px = (int64_t)(s->start_seq + i) - (int64_t)base;
+        py = src[i];
+        if (has_a && n > 0) {
+            metric = (n * ax - sx) * (py - ay) - (ax - px) * (sy - n * ay);
+        } else if (has_a) {
+            metric = py - ay;
+        } else {
+            metric = n * py - sy;
+        }
+        if (metric < 0) {
+            metric = -metric;
+        }
+        if (metric > best) {
+            best = metric;
+            s->out[slot] = src[i];
+            s->pos[slot] = (uint16_t)px;
+        }
+    }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化
+ */
+void LTTB_Init(LTTB_t *s, int16_t *out, uint16_t *pos, uint16_t capacity,
+               uint16_t max_len, int16_t gap) {
+    memset(s, 0, sizeof(LTTB_t));
+    s->out = out;
+    s->pos = pos;
+    s->capacity = (capacity < 2) ? 2 : capacity;
+    s->gap = gap;
+    // 任意对齐下 max_len 个点跨越的桶数 ceil((max_len - 1) / B) + 1 不超过 capacity
+    if (max_len <= s->capacity) {
+        s->bucket_len = 1;
+    } else {
+        s->bucket_len = (uint16_t)((max_len - 2U + s->capacity - 1U) / (s->capacity - 1U));
+    }
+}
+
+/**
+ * @brief 丢弃已有结果
+ */
+void LTTB_Reset(LTTB_t *s) {
+    s->valid = false;
+    s->count = 0;
+}
+
+/**
+ * @brief 输入当前窗口，增量更新降采样结果
+ */
+uint16_t LTTB_Update(LTTB_t *s, const int16_t *src, uint16_t len, uint32_t end_seq) {
+    uint32_t start_seq, first, last, old_last, k;
+    bool head_changed, tail_changed;
+
+    if (len == 0 || s->out == NULL) {
+        LTTB_Reset(s);
+        return 0;
+    }
+
+    if (s->bucket_len == 1) {
+        if (len > s->capacity) {
+            src += len - s->capacity;
+            len = s->capacity;
+        }
+        memcpy(s->out, src, len * sizeof(int16_t));
+        s->count = len;
+        return len;
+    }
+
+    start_seq = end_seq - len;
+    first = start_seq / s->bucket_len;
+    last = (end_seq - 1U) / s->bucket_len;
+    if (last - first + 1U > s->capacity) {
+        // 窗口超过 max_len：只保留最新的 capacity 个桶
+        first = last - s->capacity + 1U;
+        src += first * s->bucket_len - start_seq;
+        start_seq = first * s->bucket_len;
+    }
+
+    old_last = s->first + s->count - 1U;
+    if (!s->valid || s->count == 0 || start_seq < s->start_seq ||
+        end_seq < s->end_seq || first < s->first || first > old_last) {
+        // 无可复用的结果：完整重算
+        s->start_seq = start_seq;
+        s->end_seq = end_seq;
+        s->first = first;
+        s->count = (uint16_t)(last - first + 1U);
+        for (k = first; k <= last; k++) {
+            lttb_select(s, src, k);
+        }
+        s->valid = true;
+        return s->count;
+    }
+
+    // 移出窗口的桶：其余结果前移
+    if (first > s->first) {
+        uint32_t shift = first - s->first;
+
+        memmove(s->out, s->out + shift, (s->count - shift) * sizeof(int16_t));
+        memmove(s->pos, s->pos + shift, (s->count - shift) * sizeof(uint16_t));
+    }
+    head_changed = (start_seq != s->start_seq);
+    tail_changed = (end_seq != s->end_seq);
+    s->start_seq = start_seq;
+    s->end_seq = end_seq;
+    s->first = first;
+    s->count = (uint16_t)(last - first + 1U);
+
+    if (head_changed) {
+        for (k = first; k <= first + 1U && k <= last; k++) {
+            lttb_select(s, src, k);
+        }
+    }
+    if (tail_changed) {
+        for (k = (old_last > first) ? old_last - 1U : first; k <= last; k++) {
+            lttb_select(s, src, k);
+        }
+    }
+    return s->count;
+}
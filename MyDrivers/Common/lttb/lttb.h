@@ -0,0 +1,80 @@
+/**
+ * @file lttb.h
+ * @brief 曲线降采样 (Largest-Triangle-Three-Buckets)
+ * @details 把一段时间序列压缩到不超过 capacity 个点 (通常为图表的像素宽度)：
+ *          输入按固定长度分桶，每桶选出与"上一桶已选点、下一桶平均点"
+ *          构成三角形面积最大的一个点，峰谷因此得以保留。
+ *
+ *          桶的边界按样本的绝对序号对齐 (桶 k 覆盖 [k * B, (k + 1) * B))，
+ *          窗口滑动时已封存的桶不会重新划分：
+ *            - 新点到达只重算最后两个桶 (倒数第二个桶的"下一桶平均点"变化)；
+ *            - 旧点移出窗口只重算最前两个桶，中间各桶保持原来的选择；
+ *          与完整重算相比只在链式依赖 (前一桶选点变化影响后一桶) 上略有
+ *          差别，不影响峰值保留。
+ *
+ *          与 LV_CHART_POINT_NONE 一样，等于 gap 的输入点视为断点：不参与
+ *          选点与平均，整桶都是断点时输出断点。
+ *          只依赖 C 标准库；不可重入，每条曲线使用独立的状态。
+ * @author MmsY
+ * @date 2025
+*/
+
+#ifndef __LTTB_H
+#define __LTTB_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 降采样状态
+ */
+typedef struct {
+    int16_t *out;        // 输出：每桶选出的值 (调用者提供，容量 capacity)
+    uint16_t *pos;       // 每桶选出点在桶内的偏移 (调用者提供，容量 capacity)
+    uint16_t capacity;   // 输出点数上限
+    uint16_t bucket_len; // 每桶输入点数 B (为 1 时直接拷贝)
+    int16_t gap;         // 断点值
+
+    bool valid;          // out 是否与上次输入对应
+    uint32_t start_seq;  // 上次输入首点的绝对序号
+    uint32_t end_seq;    // 上次输入末点之后的绝对序号
+    uint32_t first;      // out[0] 对应的桶号
+    uint16_t count;      // 输出点数
+} LTTB_t;
+
+/**
+ * @brief 初始化
+ * @param s        状态
+ * @param out      输出缓冲区 (capacity 个点)
+ * @param pos      选点偏移缓冲区 (capacity 个)
+ * @param capacity 输出点数上限 (>= 2)
+ * @param max_len  输入窗口的最大点数，用于确定每桶点数
+ * @param gap      断点值
+ */
+void LTTB_Init(LTTB_t *s, int16_t *out, uint16_t *pos, uint16_t capacity,
+               uint16_t max_len, int16_t gap);
+
+/**
+ * @brief 丢弃已有结果，下次更新时完整重算 (切换数据源时调用)
+ */
+void LTTB_Reset(LTTB_t *s);
+
+/**
+ * @brief 输入当前窗口，增量更新降采样结果
+ * @param s       状态
+ * @param src     窗口数据 (从旧到新)
+ * @param len     窗口点数 (<= max_len)
+ * @param end_seq src[len - 1] 之后的绝对序号 (即 src[i] 的序号为 end_seq - len + i)
+ * @return uint16_t 输出点数 (结果在 s->out[0 .. count))
+ */
+uint16_t LTTB_Update(LTTB_t *s, const int16_t *src, uint16_t len, uint32_t end_seq);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LTTB_H */
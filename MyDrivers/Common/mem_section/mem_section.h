@@ -0,0 +1,63 @@
+/**
+ * @file mem_section.h
+ * @brief 段放置：把选定的数据放进 64 KB CCM RAM，把热点函数放进 SRAM 执行
+ * @details CCM RAM (0x10000000) 只挂在 CPU 的 D 总线上，零等待且不与 DMA 争用
+ *          SRAM1/2 的总线带宽，但任何 DMA (含 DMA2 存储器到存储器) 都访问不到。
+ *          用 CCM_RAM 标记的变量由 MDK-ARM/EnviroSense_zgt6.sct 中的 RW_CCM
+ *          执行区接收，启动时与其它 ZI 数据一样被清零 (不能带初始值)。
+ *          适合放 CPU 独占的大块数据；DMA 缓冲区、以及会把局部变量交给 DMA
+ *          的任务的栈必须留在 SRAM。
+ *          用 RAM_FUNC 标记的函数放在 RW_IRAM1 中，启动时由 __main 从 Flash
+ *          拷贝过去；CCM 不在 I 总线上，不能执行代码。
+ *          用 NOINIT_RAM 标记的变量放在 SRAM2 末尾的 RW_NOINIT 执行区，
+ *          启动时不清零，复位 (上电复位除外) 后保持原值；使用者须自行
+ *          校验内容 (魔数、CRC) 后再信任。
+ * @author MmsY
+ * @date 2025
+*/
+
+#ifndef __MEM_SECTION_H
+#define __MEM_SECTION_H
+
+#include <stdint.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- CCM RAM --------------------------- */
+#define MEM_CCM_BASE 0x10000000UL
+#define MEM_CCM_SIZE 0x00010000UL
+
+#if defined(__CC_ARM)
+#define CCM_RAM __attribute__((section(".bss.ccmram"), zero_init))
+#else
+#define CCM_RAM __attribute__((section(".bss.ccmram")))
+#endif
+
+/* --------------------------- 复位保持 RAM --------------------------- */
+#if defined(__CC_ARM)
+#define NOINIT_RAM __attribute__((section(".bss.noinit"), zero_init))
+#else
+#define NOINIT_RAM __attribute__((section(".noinit")))
+#endif
+
+/* --------------------------- RAM 函数 --------------------------- */
+/* 1: RAM_FUNC 函数在 SRAM 中执行 (跳转不受 Flash 预取缺失影响)，0: 留在 Flash */
+#define MEM_RAMFUNC_ENABLE 1
+
+#if MEM_RAMFUNC_ENABLE
+#define RAM_FUNC __attribute__((section(".ramfunc")))
+#else
+#define RAM_FUNC
+#endif
+
+/* 地址是否能被 DMA 访问 (不在 CCM 中) */
+#define MEM_IS_DMA_REACHABLE(p) \
+    (((uint32_t)(uintptr_t)(p) - MEM_CCM_BASE) >= MEM_CCM_SIZE)
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif /* __MEM_SECTION_H */
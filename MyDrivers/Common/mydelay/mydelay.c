@@ -6,40 +6,121 @@
 */
 
 #include "mydelay.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
 
-// Լģʵֵ
+#define DELAY_TIMER         TIM5        // 32 λͨöʱ, ;δռ
+#define DELAY_TIMER_HZ      1000000U    // 1 MHz , 1 Ϊ 1 us
+
+static SemaphoreHandle_t s_timer_sem = NULL;   // ʱʱͷ (֪ͨ, ̵Լ֪ͨ)
+static volatile uint8_t s_timer_busy = 0;       // ڵȴʱ (ͬһʱֻһ)
+
+// Ҵġδжʱ
+static int delay_can_block(void) {
+    return xTaskGetSchedulerState() == taskSCHEDULER_RUNNING && __get_IPSR() == 0 &&
+           __get_PRIMASK() == 0 && __get_BASEPRI() == 0;
+}
+
+//  DWT ڼæ (CYCCNT δʱ)
+static void delay_cycles(uint32_t cycles) {
+    uint32_t start;
+
+    if ((DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk) == 0) {
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    }
+    start = DWT->CYCCNT;
+    while (DWT->CYCCNT - start < cycles) {
+    }
+}
+
+// TIM5 ģʽʼ (һʹʱ, )
+static int delay_timer_init(void) {
+    RCC_ClkInitTypeDef clk;
+    uint32_t latency;
+    uint32_t timclk;
+
+    /* APB1 ƵΪ 1 ʱʱʱΪ PCLK1  2  */
+    HAL_RCC_GetClockConfig(&clk, &latency);
+    timclk = HAL_RCC_GetPCLK1Freq();
+    if (clk.APB1CLKDivider != RCC_HCLK_DIV1) {
+        timclk *= 2U;
+    }
+
+    s_timer_sem = xSemaphoreCreateBinary();
+    if (s_timer_sem == NULL) {
+        return 0;
+    }
+
+    __HAL_RCC_TIM5_CLK_ENABLE();
+    DELAY_TIMER->CR1 = TIM_CR1_OPM | TIM_CR1_URS;   // , ֻ
+    DELAY_TIMER->PSC = timclk / DELAY_TIMER_HZ - 1U;
+    DELAY_TIMER->EGR = TIM_EGR_UG;                  // װԤƵֵ
+    DELAY_TIMER->SR = 0;
+    DELAY_TIMER->DIER = TIM_DIER_UIE;
+
+    HAL_NVIC_SetPriority(TIM5_IRQn, configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY + 1, 0);
+    HAL_NVIC_EnableIRQ(TIM5_IRQn);
+    return 1;
+}
+
+// ʱʱ; ʱûѱռʱ 0
+static int delay_timer_wait(uint32_t nus) {
+    int ok = 1;
+
+    vTaskSuspendAll();
+    if (s_timer_sem == NULL) {
+        ok = delay_timer_init();
+    }
+    if (ok && s_timer_busy) {
+        ok = 0;
+    }
+    if (ok) {
+        s_timer_busy = 1;
+    }
+    (void)xTaskResumeAll();
+    if (!ok) {
+        return 0;
+    }
+
+    (void)xSemaphoreTake(s_timer_sem, 0);               // һγʱͷ
+    DELAY_TIMER->ARR = nus - 1U;
+    DELAY_TIMER->CNT = 0;
+    DELAY_TIMER->SR = 0;
+    DELAY_TIMER->CR1 |= TIM_CR1_CEN;
+    (void)xSemaphoreTake(s_timer_sem, pdMS_TO_TICKS(nus / 1000U) + 2); // ʱֻǱ
+
+    DELAY_TIMER->CR1 &= ~TIM_CR1_CEN;
+    s_timer_busy = 0;
+    return 1;
+}
+
+// TIM5 : ѵȴ
+void delay_timer_irq_handler(void) {
+    BaseType_t woken = pdFALSE;
+
+    DELAY_TIMER->SR = 0;
+    if (s_timer_sem != NULL) {
+        (void)xSemaphoreGiveFromISR(s_timer_sem, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// ʱ (I2C λʱ) æ DWT; ʱϳʱ TIM5
 void delay_us(uint32_t nus) {
-    uint32_t ticks;
-    uint32_t told, tnow, tcnt = 0;
-    uint32_t reload = SysTick->LOAD;
-    
-    ticks = nus * (SystemCoreClock / 1000000);  // ҪĽ
-    told = SysTick->VAL;                        // սʱļֵ
-    
-    while (1)
-    {
-        tnow = SysTick->VAL;
-        if (tnow != told)
-        {
-            // SYSTICKһݼļ
-            if (tnow < told) {
-                tcnt += told - tnow;
-            }
-            else {
-                // װ
-                tcnt += reload - tnow + told;
-            }
-            told = tnow;
-            
-            // ʱ䳬/Ҫӳٵʱ,˳
-            if (tcnt >= ticks) {
-                break;
-            }
-        }
+    if (nus >= DELAY_TIMER_MIN_US && delay_can_block() && delay_timer_wait(nus)) {
+        return;
     }
+    delay_cycles(nus * (SystemCoreClock / 1000000U));
 }
 
-// ʹHAL_Delaydelay_ms
+// Ҵʱó CPU (LCD/ʼеĳʱڼ
+// ׶οԼִ)ʹHAL_Delayæ
 void delay_ms(uint32_t nms) {
+    if (delay_can_block()) {
+        vTaskDelay(pdMS_TO_TICKS(nms) + 1); // +1 ֤ʱ nms
+        return;
+    }
     HAL_Delay(nms);
 }
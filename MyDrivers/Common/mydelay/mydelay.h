@@ -1,6 +1,10 @@
 /**
  * @file mydelay.c
  * @brief ʹhalĵʱ׼ʱ
+ * @details delay_us: ʱ DWT ڼæ ( 1 ms 
+ *          ж)ʱ DELAY_TIMER_MIN_US ʱ TIM5
+ *          嶨ʱȴʱжϣڼ CPU 
+ *          delay_ms: ʱ vTaskDelay HAL_Delay
  * @author MmsY
  * @date 2025
 */
@@ -10,8 +14,10 @@
 
 #include "main.h"
 
+#define DELAY_TIMER_MIN_US  50      // ڸֵ΢ʱΪʱ (лԼ΢)
+
 void delay_us(uint32_t nus);
 void delay_ms(uint32_t nms);
+void delay_timer_irq_handler(void); // TIM5 жϷ (stm32f4xx_it.c)
 
 #endif
-
@@ -0,0 +1,258 @@
+/**
+ ******************************************************************************
+ * @file    can_bus.c
+ * @brief   bxCAN (CAN1) 驱动
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "can_bus.h"
+#include <string.h>
+
+#define LOG_MODULE "CAN"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define CAN_BUS_TQ_PER_BIT  14  // 1 (同步段) + 11 (BS1) + 2 (BS2)，采样点 85.7%
+#define CAN_BUS_BS1         11
+#define CAN_BUS_BS2         2
+#define CAN_BUS_SJW         1
+
+/* 16 位过滤器格式：STID[10:0] 在 15:5，RTR 在 4，IDE 在 3 */
+#define CAN_BUS_FILTER16(id)    ((uint32_t)(id) << 5)
+#define CAN_BUS_FILTER16_STD    0x0018U     // 掩码中的 RTR/IDE 位：只接收标准数据帧
+
+/* --------------------------- 私有变量 --------------------------- */
+static CanBus_Frame_t s_ring[CAN_BUS_RX_RING_SIZE];
+static volatile uint8_t s_head = 0;         // 下一个写入位置 (中断写)
+static volatile uint8_t s_tail = 0;         // 下一个读取位置 (任务写)
+static TaskHandle_t s_owner = NULL;
+static uint8_t s_filters = 0;               // 已使用的过滤器半组数
+static CanBus_Stats_t s_stats;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 初始化 PB8/PB9 与 CAN1 时钟
+ */
+static void can_bus_gpio_init(void) {
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_CAN1_CLK_ENABLE();
+
+    gpio.Pin = GPIO_PIN_8 | GPIO_PIN_9;    /* CAN1_RX / CAN1_TX */
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_PULLUP;               /* 未接收发器时 RX 保持隐性 */
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF9_CAN1;
+    HAL_GPIO_Init(GPIOB, &gpio);
+}
+
+/**
+ * @brief 等待 MSR 中的 INAK 变为指定状态
+ */
+static bool can_bus_wait_inak(bool set) {
+    uint32_t start = HAL_GetTick();
+
+    while (((CAN1->MSR & CAN_MSR_INAK) != 0) != set) {
+        if (HAL_GetTick() - start > CAN_BUS_INIT_TIMEOUT_MS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief 取出一个接收 FIFO 中的全部帧 (中断上下文)
+ * @return 放入环形缓冲区的帧数
+ */
+static uint32_t can_bus_drain_fifo(uint8_t fifo) {
+    volatile uint32_t *rfr = fifo == 0 ? &CAN1->RF0R : &CAN1->RF1R;
+    CAN_FIFOMailBox_TypeDef *mb = &CAN1->sFIFOMailBox[fifo];
+    uint32_t count = 0;
+
+    /* FMP 与 FOVR/RFOM 在 RF0R/RF1R 中的位置相同 */
+    if (*rfr & CAN_RF0R_FOVR0) {
+        *rfr = CAN_RF0R_FOVR0;             /* 写 1 清除 */
+        s_stats.fifo_overruns++;
+    }
+    while (*rfr & CAN_RF0R_FMP0) {
+        uint8_t head = s_head;
+        uint8_t next = (uint8_t)((head + 1U) & (CAN_BUS_RX_RING_SIZE - 1U));
+
+        if ((mb->RIR & CAN_RI0R_IDE) != 0) {
+            /* 扩展帧：过滤器只放行标准帧，不会出现 */
+        } else if (next == s_tail) {
+            s_stats.rx_dropped++;
+        } else {
+            CanBus_Frame_t *frame = &s_ring[head];
+            uint32_t lo = mb->RDLR;
+            uint32_t hi = mb->RDHR;
+
+            frame->id = (uint16_t)(mb->RIR >> CAN_RI0R_STID_Pos);
+            frame->len = (uint8_t)(mb->RDTR & CAN_RDT0R_DLC_Msk);
+            if (frame->len > 8) {
+                frame->len = 8;
+            }
+            memcpy(&frame->data[0], &lo, 4);
+            memcpy(&frame->data[4], &hi, 4);
+            __DMB();                        /* 帧写完后再发布 head */
+            s_head = next;
+            s_stats.rx_frames++;
+            count++;
+        }
+        *rfr = CAN_RF0R_RFOM0;              /* 释放邮箱 */
+    }
+    return count;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+bool CanBus_Init(uint32_t bitrate, TaskHandle_t owner) {
+    uint32_t pclk = HAL_RCC_GetPCLK1Freq();
+    uint32_t prescaler = pclk / (bitrate * CAN_BUS_TQ_PER_BIT);
+
+    if (bitrate == 0 || prescaler == 0 || prescaler > 1024 ||
+        prescaler * bitrate * CAN_BUS_TQ_PER_BIT != pclk) {
+        LOG_ERROR("波特率 %lu 无法由 %lu Hz 精确分频", (unsigned long)bitrate,
+                  (unsigned long)pclk);
+        return false;
+    }
+    s_owner = owner;
+    can_bus_gpio_init();
+
+    /* 退出睡眠并进入初始化模式 */
+    CAN1->MCR = (CAN1->MCR & ~CAN_MCR_SLEEP) | CAN_MCR_INRQ;
+    if (!can_bus_wait_inak(true)) {
+        LOG_ERROR("进入初始化模式超时");
+        return false;
+    }
+
+    /* 总线关闭自动恢复、自动重发、发送邮箱按请求顺序发出 */
+    CAN1->MCR = CAN_MCR_INRQ | CAN_MCR_ABOM | CAN_MCR_TXFP;
+    CAN1->BTR = ((uint32_t)(CAN_BUS_SJW - 1) << CAN_BTR_SJW_Pos) |
+                ((uint32_t)(CAN_BUS_BS2 - 1) << CAN_BTR_TS2_Pos) |
+                ((uint32_t)(CAN_BUS_BS1 - 1) << CAN_BTR_TS1_Pos) |
+                (prescaler - 1);
+
+    /* 过滤器全部停用：没有添加过滤器之前不接收任何帧 */
+    CAN1->FMR |= CAN_FMR_FINIT;
+    CAN1->FA1R = 0;
+    CAN1->FM1R = 0;                          /* 掩码模式 */
+    CAN1->FS1R = 0;                          /* 16 位 */
+    CAN1->FFA1R = 0;
+    CAN1->FMR &= ~CAN_FMR_FINIT;
+    s_filters = 0;
+
+    CAN1->IER = CAN_IER_FMPIE0 | CAN_IER_FMPIE1;
+    HAL_NVIC_SetPriority(CAN1_RX0_IRQn, CAN_BUS_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(CAN1_RX0_IRQn);
+    HAL_NVIC_SetPriority(CAN1_RX1_IRQn, CAN_BUS_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(CAN1_RX1_IRQn);
+
+    /* 退出初始化模式 (需在总线上检测到 11 个连续隐性位) */
+    CAN1->MCR &= ~CAN_MCR_INRQ;
+    if (!can_bus_wait_inak(false)) {
+        LOG_ERROR("退出初始化模式超时 (检查收发器与总线)");
+        return false;
+    }
+    LOG_INFO("CAN1 已启动: %lu bps", (unsigned long)bitrate);
+    return true;
+}
+
+bool CanBus_AddFilter(uint16_t id, uint16_t mask, uint8_t fifo) {
+    uint32_t word = (CAN_BUS_FILTER16(mask) | CAN_BUS_FILTER16_STD) << 16 |
+                    CAN_BUS_FILTER16(id);
+    uint8_t bank = s_filters / 2;
+    bool second = (s_filters & 1U) != 0;
+    uint32_t bit;
+
+    /* 同一组的两半只能进入同一个 FIFO：FIFO 不同时改用下一组 */
+    if (second && ((CAN1->FFA1R >> bank) & 1U) != (fifo & 1U)) {
+        s_filters++;
+        bank++;
+        second = false;
+    }
+    if (bank >= CAN_BUS_FILTER_BANKS) {
+        return false;
+    }
+    bit = 1UL << bank;
+
+    CAN1->FMR |= CAN_FMR_FINIT;
+    if (!second) {
+        /* 新组的两半都写同一条，另一半空闲时不会放行其他帧 */
+        CAN1->FA1R &= ~bit;
+        CAN1->sFilterRegister[bank].FR1 = word;
+        CAN1->sFilterRegister[bank].FR2 = word;
+        if (fifo & 1U) {
+            CAN1->FFA1R |= bit;
+        } else {
+            CAN1->FFA1R &= ~bit;
+        }
+        CAN1->FA1R |= bit;
+    } else {
+        CAN1->sFilterRegister[bank].FR2 = word;
+    }
+    CAN1->FMR &= ~CAN_FMR_FINIT;
+    s_filters++;
+    return true;
+}
+
+bool CanBus_Send(const CanBus_Frame_t *frame) {
+    uint32_t tsr = CAN1->TSR;
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+    uint8_t len = frame->len > 8 ? 8 : frame->len;
+    CAN_TxMailBox_TypeDef *mb;
+
+    if ((tsr & (CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2)) == 0) {
+        s_stats.tx_busy++;
+        return false;
+    }
+    /* CODE 给出下一个空闲邮箱 */
+    mb = &CAN1->sTxMailBox[(tsr & CAN_TSR_CODE_Msk) >> CAN_TSR_CODE_Pos];
+    memcpy(&lo, &frame->data[0], len < 4 ? len : 4);
+    if (len > 4) {
+        memcpy(&hi, &frame->data[4], len - 4U);
+    }
+    mb->TIR = (uint32_t)(frame->id & 0x7FFU) << CAN_TI0R_STID_Pos;
+    mb->TDTR = len;
+    mb->TDLR = lo;
+    mb->TDHR = hi;
+    mb->TIR |= CAN_TI0R_TXRQ;
+    s_stats.tx_frames++;
+    return true;
+}
+
+bool CanBus_Receive(CanBus_Frame_t *frame) {
+    uint8_t tail = s_tail;
+
+    if (tail == s_head) {
+        return false;
+    }
+    __DMB();                                 /* 先读 head 再读帧 */
+    *frame = s_ring[tail];
+    __DMB();                                 /* 取完帧再归还槽位 */
+    s_tail = (uint8_t)((tail + 1U) & (CAN_BUS_RX_RING_SIZE - 1U));
+    return true;
+}
+
+void CanBus_GetStats(CanBus_Stats_t *stats) {
+    uint32_t esr = CAN1->ESR;
+
+    *stats = s_stats;
+    stats->tx_errors = (uint8_t)((esr & CAN_ESR_TEC_Msk) >> CAN_ESR_TEC_Pos);
+    stats->rx_errors = (uint8_t)((esr & CAN_ESR_REC_Msk) >> CAN_ESR_REC_Pos);
+    stats->bus_off = (esr & CAN_ESR_BOFF) != 0;
+    stats->last_error = (uint8_t)((esr & CAN_ESR_LEC_Msk) >> CAN_ESR_LEC_Pos);
+}
+
+void CanBus_RxIRQHandler(uint8_t fifo) {
+    if (can_bus_drain_fifo(fifo) != 0 && s_owner != NULL) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(s_owner, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ ******************************************************************************
+ * @file    can_bus.h
+ * @brief   bxCAN (CAN1) 驱动头文件
+ * @details 收发器接 PB8 CAN1_RX、PB9 CAN1_TX (PA11/PA12 已被 USB 虚拟串口
+ *          占用)。CubeMX 工程未配置 CAN，库中也没有 HAL CAN 模块，驱动直接
+ *          操作寄存器：
+ *            - 只收发 11 位标准数据帧；
+ *            - 硬件验收过滤器：每条 (ID, 掩码) 占 16 位掩码模式过滤器组的
+ *              一半，不匹配的帧由硬件丢弃，不产生中断；
+ *            - FIFO0/FIFO1 消息挂起中断中把帧取出放入无锁环形缓冲区
+ *              (中断只写 head，任务只写 tail)，再通知属主任务；
+ *            - 发送直接写入空闲的发送邮箱，不等待发送完成；
+ *            - 总线关闭后由硬件自动恢复 (ABOM)，错误计数可经统计查看。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __CAN_BUS_H
+#define __CAN_BUS_H
+
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define CAN_BUS_RX_RING_SIZE    32          // 接收环形缓冲区帧数 (2 的幂)
+#define CAN_BUS_FILTER_BANKS    14          // CAN1 可用的过滤器组数 (CAN2 未使用)
+#define CAN_BUS_IRQ_PRIORITY    5           // 不高于 configMAX_SYSCALL_INTERRUPT_PRIORITY
+#define CAN_BUS_INIT_TIMEOUT_MS 10          // 进入/退出初始化模式的等待上限
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 一帧标准数据帧
+ */
+typedef struct {
+    uint16_t id;        // 11 位标识符
+    uint8_t len;        // 数据长度 (0~8)
+    uint8_t data[8];
+} CanBus_Frame_t;
+
+/**
+ * @brief 驱动统计
+ */
+typedef struct {
+    uint32_t rx_frames;     // 放入环形缓冲区的帧数
+    uint32_t rx_dropped;    // 环形缓冲区满而丢弃的帧数
+    uint32_t fifo_overruns; // 硬件 FIFO 溢出次数
+    uint32_t tx_frames;     // 写入发送邮箱的帧数
+    uint32_t tx_busy;       // 发送邮箱全满而未发出的次数
+    uint8_t tx_errors;      // 发送错误计数 (TEC)
+    uint8_t rx_errors;      // 接收错误计数 (REC)
+    bool bus_off;           // 处于总线关闭状态
+    uint8_t last_error;     // 最近的错误码 (LEC，0 无错误)
+} CanBus_Stats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化引脚与 CAN1 并进入正常模式
+ * @param bitrate 波特率 (APB1 时钟须能被 bitrate * 14 整除，如 125k/250k/500k/1M)
+ * @param owner   收到帧时通知的任务 (xTaskNotifyGive)
+ * @return false: 波特率无法精确配置或初始化模式切换超时
+ * @note  初始化后没有过滤器，不接收任何帧
+ */
+bool CanBus_Init(uint32_t bitrate, TaskHandle_t owner);
+
+/**
+ * @brief 添加一条验收过滤器
+ * @param id   标识符
+ * @param mask 掩码 (1 的位须与 id 相同，0 的位任意)
+ * @param fifo 匹配的帧放入的接收 FIFO (0 或 1)
+ * @return false: 过滤器组已用完
+ */
+bool CanBus_AddFilter(uint16_t id, uint16_t mask, uint8_t fifo);
+
+/**
+ * @brief 发送一帧 (不等待)
+ * @return false: 三个发送邮箱均忙
+ * @note  只能由一个任务调用
+ */
+bool CanBus_Send(const CanBus_Frame_t *frame);
+
+/**
+ * @brief 从环形缓冲区取出一帧 (不等待，只能由属主任务调用)
+ * @return false: 没有帧
+ */
+bool CanBus_Receive(CanBus_Frame_t *frame);
+
+/**
+ * @brief 获取驱动统计 (含当前错误状态)
+ */
+void CanBus_GetStats(CanBus_Stats_t *stats);
+
+/**
+ * @brief 接收中断处理，在 CAN1_RX0_IRQHandler / CAN1_RX1_IRQHandler 中调用
+ * @param fifo 0 或 1
+ */
+void CanBus_RxIRQHandler(uint8_t fifo);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CAN_BUS_H */
@@ -18,6 +18,9 @@
  * ޸˵
  * V1.0 20200424
  * һη
+ * V1.1
+ * ҳд,  ACK ѯ̶ʱȴд, ֽ
+ * дӻ, ڶʹ (ô洢ں̨д)
  *
  ****************************************************************************************************
  */
@@ -25,6 +28,33 @@
 #include "myiic.h"
 #include "24cxx.h"
 #include "main.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include "task_plan.h"
+
+
+static SemaphoreHandle_t s_mutex = NULL;
+static StaticSemaphore_t s_mutex_buf;
+
+/**
+ * @brief       ȡ/ͷ߻ (ǰֱӷ)
+ */
+static void at24cxx_lock(void)
+{
+    if (s_mutex != NULL && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+    {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+    }
+}
+
+static void at24cxx_unlock(void)
+{
+    if (s_mutex != NULL && xTaskGetSchedulerState() == taskSCHEDULER_RUNNING)
+    {
+        xSemaphoreGive(s_mutex);
+    }
+}
 
 
 /**
@@ -34,17 +64,22 @@
  */
 void at24cxx_init(void)
 {
+    if (s_mutex == NULL)
+    {
+        s_mutex = xSemaphoreCreateMutexStatic(&s_mutex_buf);
+        TaskPlan_WatchMutex(s_mutex, "eeprom", 50);
+    }
+
     iic_init();
 }
 
 /**
- * @brief       AT24CXXַָһ
- * @param       readaddr: ʼĵַ
- * @retval      
+ * @brief       ʼźšַ(д)ʹ洢ַ
+ * @param       addr: 洢ַ
+ * @retval      0: ɹ; 1: Ӧ(ѷֹͣź)
  */
-uint8_t at24cxx_read_one_byte(uint16_t addr)
+static uint8_t at24cxx_send_addr(uint16_t addr)
 {
-    uint8_t temp = 0;
     iic_start();                /* ʼź */
 
     /* ݲͬ24CXXͺ, ͸λַ
@@ -57,27 +92,88 @@ uint8_t at24cxx_read_one_byte(uint16_t addr)
      *    R/W      : /дλ 0,ʾд; 1,ʾ;
      *    A0/A1/A2 : Ӧ1,2,3(ֻ24C01/02/04/8Щ)
      *    a8/a9/a10: Ӧ洢еĸλַ, 11bitַԱʾ2048λ,Ѱַ24C16ڵͺ
-     */    
+     */
     if (EE_TYPE > AT24C16)      /* 24C16ϵͺ, 2ֽڷ͵ַ */
     {
         iic_send_byte(0XA0);    /* д, IIC涨λ0, ʾд */
-        iic_wait_ack();         /* ÿηһֽ,ҪȴACK */
+        if (iic_wait_ack()) return 1;   /* ÿηһֽ,ҪȴACK */
         iic_send_byte(addr >> 8);/* ͸ֽڵַ */
     }
-    else 
+    else
     {
         iic_send_byte(0XA0 + ((addr >> 8) << 1));   /*  0XA0 + λa8/a9/a10ַ,д */
     }
-    
-    iic_wait_ack();             /* ÿηһֽ,ҪȴACK */
+
+    if (iic_wait_ack()) return 1;   /* ÿηһֽ,ҪȴACK */
     iic_send_byte(addr % 256);  /* ͵λַ */
-    iic_wait_ack();             /* ȴACK, ʱַ */
-    
-    iic_start();                /* ·ʼź */ 
-    iic_send_byte(0XA1);        /* ģʽ, IIC涨λ0, ʾȡ */
-    iic_wait_ack();             /* ÿηһֽ,ҪȴACK */
-    temp = iic_read_byte(0);    /* һֽ */
-    iic_stop();                 /* һֹͣ */
+    return iic_wait_ack();      /* ȴACK, ʱַ */
+}
+
+/**
+ * @brief       ȴڲдڽ
+ *   @note      дӦԼĵַ, ֱַӦ(ACK ѯ),
+ *              ͨ 1~5ms ɽ, ع̶ʱ 10ms
+ * @param       
+ * @retval      0: дѽ; 1: ʱ
+ */
+static uint8_t at24cxx_wait_write_done(void)
+{
+    uint32_t start = HAL_GetTick();
+
+    do
+    {
+        iic_start();
+        iic_send_byte(0XA0);    /* д, 24C16µͺп鹲һд */
+
+        if (iic_wait_ack() == 0)
+        {
+            iic_stop();
+            return 0;
+        }
+    } while (HAL_GetTick() - start <= EE_WRITE_TIMEOUT_MS);
+
+    return 1;
+}
+
+/**
+ * @brief       AT24CXXַָʼдһҳڵ
+ * @param       addr    : дĿĵַ
+ * @param       pbuf    : ׵ַ
+ * @param       datalen : ݸ, ܿԽҳ߽
+ * @retval      
+ */
+static void at24cxx_write_page(uint16_t addr, const uint8_t *pbuf, uint16_t datalen)
+{
+    if (at24cxx_send_addr(addr) == 0)
+    {
+        /* Ϊдݵʱ,Ҫģʽ,ﲻ·ʼź */
+        uint8_t nack = 0;
+
+        while (datalen-- && nack == 0)
+        {
+            iic_send_byte(*pbuf++); /* 1ֽ */
+            nack = iic_wait_ack();  /* Ӧʱ iic_wait_ack ѷֹͣź */
+        }
+
+        if (nack == 0)
+        {
+            iic_stop();         /* һֹͣ, ʼڲд */
+        }
+    }
+
+    at24cxx_wait_write_done();  /* ע: EEPROM дȽ, дڽٲ */
+}
+
+/**
+ * @brief       AT24CXXַָһ
+ * @param       readaddr: ʼĵַ
+ * @retval      
+ */
+uint8_t at24cxx_read_one_byte(uint16_t addr)
+{
+    uint8_t temp = 0;
+
+    at24cxx_read(addr, &temp, 1);
     return temp;
 }
 
@@ -89,30 +185,7 @@ uint8_t at24cxx_read_one_byte(uint16_t addr)
  */
 void at24cxx_write_one_byte(uint16_t addr, uint8_t data)
 {
-    /* ԭ˵:at24cxx_read_one_byte, ȫ */
-    iic_start();                /* ʼź */
-
-    if (EE_TYPE > AT24C16)      /* 24C16ϵͺ, 2ֽڷ͵ַ */
-    {
-        iic_send_byte(0XA0);    /* д, IIC涨λ0, ʾд */
-        iic_wait_ack();         /* ÿηһֽ,ҪȴACK */
-        iic_send_byte(addr >> 8);/* ͸ֽڵַ */
-    }
-    else 
-    {
-        iic_send_byte(0XA0 + ((addr >> 8) << 1));   /*  0XA0 + λa8/a9/a10ַ,д */
-    }
-    
-    iic_wait_ack();             /* ÿηһֽ,ҪȴACK */
-    iic_send_byte(addr % 256);  /* ͵λַ */
-    iic_wait_ack();             /* ȴACK, ʱַ */
-    
-    /* Ϊдݵʱ,Ҫģʽ,ﲻ·ʼź */
-    iic_send_byte(data);        /* 1ֽ */
-    iic_wait_ack();             /* ȴACK */
-    iic_stop();                 /* һֹͣ */
-    HAL_Delay(10);
-    // delay_ms(10);               /* ע: EEPROM дȽ,ȵ10msдһֽ */
+    at24cxx_write(addr, &data, 1);
 }
  
 /**
@@ -148,6 +221,7 @@ uint8_t at24cxx_check(void)
 
 /**
  * @brief       AT24CXXַָʼָ
+ *   @note      ֻһεַ, ֮ȡ(ڲַԶ)
  * @param       addr    : ʼĵַ 24c02Ϊ0~255
  * @param       pbuf    : ׵ַ
  * @param       datalen : Ҫݵĸ
@@ -155,25 +229,53 @@ uint8_t at24cxx_check(void)
  */
 void at24cxx_read(uint16_t addr, uint8_t *pbuf, uint16_t datalen)
 {
-    while (datalen--)
+    if (datalen == 0) return;
+
+    at24cxx_lock();
+
+    if (at24cxx_send_addr(addr) == 0)
     {
-        *pbuf++ = at24cxx_read_one_byte(addr++);
+        iic_start();            /* ·ʼź */
+        iic_send_byte(0XA1);    /* ģʽ, IIC涨λ1, ʾȡ */
+
+        if (iic_wait_ack() == 0)
+        {
+            while (datalen--)
+            {
+                *pbuf++ = iic_read_byte(datalen ? 1 : 0);   /* һֽڷ NACK */
+            }
+
+            iic_stop();         /* һֹͣ */
+        }
     }
+
+    at24cxx_unlock();
 }
 
 /**
  * @brief       AT24CXXַָʼдָ
+ *   @note      ҳ, ÿҳһʼ/ַ//ֹͣһд,
+ *              64 ֽ 24C02 ֻ 8 д
  * @param       addr    : ʼдĵַ 24c02Ϊ0~255
  * @param       pbuf    : ׵ַ
  * @param       datalen : Ҫдݵĸ
  * @retval      
  */
-void at24cxx_write(uint16_t addr, uint8_t *pbuf, uint16_t datalen)
+void at24cxx_write(uint16_t addr, const uint8_t *pbuf, uint16_t datalen)
 {
-    while (datalen--)
+    at24cxx_lock();
+
+    while (datalen)
     {
-        at24cxx_write_one_byte(addr, *pbuf);
-        addr++;
-        pbuf++;
+        uint16_t len = EE_PAGE_SIZE - (addr % EE_PAGE_SIZE);    /* ҳʣռ */
+
+        if (len > datalen) len = datalen;
+
+        at24cxx_write_page(addr, pbuf, len);
+        addr += len;
+        pbuf += len;
+        datalen -= len;
     }
+
+    at24cxx_unlock();
 }
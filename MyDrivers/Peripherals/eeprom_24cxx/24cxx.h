@@ -18,6 +18,8 @@
  * ޸˵
  * V1.0 20200424
  * һη
+ * V1.1
+ * ҳд,  ACK ѯ̶ʱȴд, ֽ
  *
  ****************************************************************************************************
  */
@@ -42,11 +44,24 @@
 
 #define EE_TYPE     AT24C02
 
+/* ҳС: ҳд벻ܿҳ, ҳֻؾǱҳͷ */
+#if (EE_TYPE <= AT24C02)
+#define EE_PAGE_SIZE    8
+#elif (EE_TYPE <= AT24C16)
+#define EE_PAGE_SIZE    16
+#elif (EE_TYPE <= AT24C64)
+#define EE_PAGE_SIZE    32
+#else
+#define EE_PAGE_SIZE    64
+#endif
+
+#define EE_WRITE_TIMEOUT_MS     10      /* ڲд 5ms, ACK ѯĳʱʱ */
+
 void at24cxx_init(void);        /* ʼIIC */
 uint8_t at24cxx_check(void);    /*  */
 uint8_t at24cxx_read_one_byte(uint16_t addr);                       /* ַָȡһֽ */
 void at24cxx_write_one_byte(uint16_t addr,uint8_t data);            /* ַָдһֽ */
-void at24cxx_write(uint16_t addr, uint8_t *pbuf, uint16_t datalen); /* ַָʼдָȵ */
+void at24cxx_write(uint16_t addr, const uint8_t *pbuf, uint16_t datalen); /* ַָʼдָȵ */
 void at24cxx_read(uint16_t addr, uint8_t *pbuf, uint16_t datalen);  /* ַָʼָȵ */
 
 #endif
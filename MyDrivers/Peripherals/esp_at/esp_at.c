@@ -0,0 +1,409 @@
+/**
+ ******************************************************************************
+ * @file    esp_at.c
+ * @brief   ESP8266/ESP32 AT 固件 Wi-Fi 模块驱动
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "esp_at.h"
+#include "energy_meter.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_MODULE "ESP_AT"
+#include "log.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+UART_HandleTypeDef huart5;
+DMA_HandleTypeDef hdma_uart5_rx;
+DMA_HandleTypeDef hdma_uart5_tx;
+
+static uint8_t s_rx_buf[ESP_AT_RX_BUFFER_SIZE];
+static volatile uint16_t s_rx_head = 0;     // DMA 写入位置 (中断中更新)
+static uint16_t s_rx_tail = 0;              // 任务读取位置
+static volatile uint8_t s_rx_resync = 0;    // 接收重启后从缓冲区开头读取
+
+static char s_line[ESP_AT_LINE_MAX];        // 正在拼接的应答行 (跨调用保留)
+static uint16_t s_line_len = 0;
+static char s_cmd[ESP_AT_CMD_MAX];          // 命令发送缓冲区 (DMA 读取)
+
+static TaskHandle_t volatile s_waiter = NULL;   // 等待应答的任务
+static SemaphoreHandle_t s_tx_done = NULL;
+static StaticSemaphore_t s_tx_done_buf;
+static EspAtStats_t s_stats;
+static bool s_started = false;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 初始化引脚、UART5 与收发 DMA
+ */
+static bool esp_at_hw_init(void) {
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_GPIOD_CLK_ENABLE();
+    __HAL_RCC_UART5_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    gpio.Pin = GPIO_PIN_12;                 /* UART5_TX */
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_PULLUP;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF8_UART5;
+    HAL_GPIO_Init(GPIOC, &gpio);
+
+    gpio.Pin = GPIO_PIN_2;                  /* UART5_RX */
+    HAL_GPIO_Init(GPIOD, &gpio);
+
+    /* UART5_RX: DMA1 Stream0 通道 4，循环接收 */
+    hdma_uart5_rx.Instance = DMA1_Stream0;
+    hdma_uart5_rx.Init.Channel = DMA_CHANNEL_4;
+    hdma_uart5_rx.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    hdma_uart5_rx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_uart5_rx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_uart5_rx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_uart5_rx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_uart5_rx.Init.Mode = DMA_CIRCULAR;
+    hdma_uart5_rx.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_uart5_rx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_uart5_rx) != HAL_OK) {
+        return false;
+    }
+    __HAL_LINKDMA(&huart5, hdmarx, hdma_uart5_rx);
+
+    /* UART5_TX: DMA1 Stream7 通道 4 */
+    hdma_uart5_tx.Instance = DMA1_Stream7;
+    hdma_uart5_tx.Init.Channel = DMA_CHANNEL_4;
+    hdma_uart5_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_uart5_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_uart5_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_uart5_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_uart5_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_uart5_tx.Init.Mode = DMA_NORMAL;
+    hdma_uart5_tx.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_uart5_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_uart5_tx) != HAL_OK) {
+        return false;
+    }
+    __HAL_LINKDMA(&huart5, hdmatx, hdma_uart5_tx);
+
+    huart5.Instance = UART5;
+    huart5.Init.BaudRate = ESP_AT_BAUDRATE;
+    huart5.Init.WordLength = UART_WORDLENGTH_8B;
+    huart5.Init.StopBits = UART_STOPBITS_1;
+    huart5.Init.Parity = UART_PARITY_NONE;
+    huart5.Init.Mode = UART_MODE_TX_RX;
+    huart5.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+    huart5.Init.OverSampling = UART_OVERSAMPLING_16;
+    if (HAL_UART_Init(&huart5) != HAL_OK) {
+        return false;
+    }
+
+    HAL_NVIC_SetPriority(DMA1_Stream0_IRQn, ESP_AT_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream0_IRQn);
+    HAL_NVIC_SetPriority(DMA1_Stream7_IRQn, ESP_AT_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream7_IRQn);
+    HAL_NVIC_SetPriority(UART5_IRQn, ESP_AT_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(UART5_IRQn);
+    return true;
+}
+
+static bool esp_at_start_rx(void) {
+    return HAL_UARTEx_ReceiveToIdle_DMA(&huart5, s_rx_buf, ESP_AT_RX_BUFFER_SIZE) == HAL_OK;
+}
+
+/**
+ * @brief 唤醒等待应答的任务 (中断上下文)
+ */
+static void esp_at_wake_waiter(void) {
+    TaskHandle_t waiter = s_waiter;
+
+    if (waiter != NULL) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(waiter, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+/**
+ * @brief 读取一行应答 (去掉 \r\n，跳过空行)
+ * @details CIPSEND 的提示符 '>' 后面没有换行，出现在行首时单独作为一行返回
+ * @param deadline 截止时刻 (tick)，已过期时只取出缓冲区中现有的数据
+ * @return 行内容 (下一次调用前有效)，超时返回 NULL
+ */
+static const char *esp_at_read_line(TickType_t deadline) {
+    for (;;) {
+        if (s_rx_resync) {
+            s_rx_resync = 0;
+            s_rx_tail = 0;
+            s_line_len = 0;
+        }
+        while (s_rx_tail != s_rx_head) {
+            char c = (char)s_rx_buf[s_rx_tail];
+            s_rx_tail = (uint16_t)((s_rx_tail + 1U) % ESP_AT_RX_BUFFER_SIZE);
+
+            if (c == '\n') {
+                if (s_line_len > 0 && s_line[s_line_len - 1] == '\r') {
+                    s_line_len--;
+                }
+                if (s_line_len == 0) {
+                    continue;
+                }
+                s_line[s_line_len] = '\0';
+                s_line_len = 0;
+                return s_line;
+            }
+            if (c == '>' && s_line_len == 0) {
+                s_line[0] = '>';
+                s_line[1] = '\0';
+                return s_line;
+            }
+            if (s_line_len < ESP_AT_LINE_MAX - 1) {
+                s_line[s_line_len++] = c;
+            }
+        }
+
+        TickType_t now = xTaskGetTickCount();
+        if ((int32_t)(deadline - now) <= 0) {
+            return NULL;
+        }
+        ulTaskNotifyTake(pdTRUE, deadline - now);
+    }
+}
+
+/**
+ * @brief 处理异步上报，维护链路状态
+ */
+static void esp_at_handle_urc(const char *line) {
+    if (strcmp(line, "WIFI GOT IP") == 0) {
+        s_stats.has_ip = true;
+    } else if (strcmp(line, "WIFI DISCONNECT") == 0) {
+        s_stats.has_ip = false;
+        s_stats.linked = false;
+    } else if (strcmp(line, "CONNECT") == 0 || strcmp(line, "ALREADY CONNECTED") == 0) {
+        s_stats.linked = true;
+    } else if (strcmp(line, "CLOSED") == 0) {
+        s_stats.linked = false;
+    }
+}
+
+/**
+ * @brief 取出缓冲区中残留的应答 (只处理其中的异步上报)
+ */
+static void esp_at_discard_input(void) {
+    const char *line;
+
+    while ((line = esp_at_read_line(xTaskGetTickCount())) != NULL) {
+        esp_at_handle_urc(line);
+    }
+}
+
+/**
+ * @brief DMA 发送并等待完成
+ */
+static bool esp_at_transmit(const uint8_t *data, uint16_t len) {
+    // 按波特率估算的发送时间 (10 位/字节) 加余量
+    uint32_t timeout_ms = (uint32_t)len * 10000U / ESP_AT_BAUDRATE + 100U;
+
+    (void)xSemaphoreTake(s_tx_done, 0);     // 清除上一次超时后迟到的完成信号
+    if (HAL_UART_Transmit_DMA(&huart5, (uint8_t *)data, len) != HAL_OK) {
+        return false;
+    }
+    if (xSemaphoreTake(s_tx_done, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        HAL_UART_AbortTransmit(&huart5);
+        s_stats.timeouts++;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 等待成功标志行
+ */
+static bool esp_at_wait(const char *expect, uint32_t timeout_ms) {
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(timeout_ms);
+    size_t expect_len = (expect != NULL) ? strlen(expect) : 0;
+    const char *line;
+
+    while ((line = esp_at_read_line(deadline)) != NULL) {
+        esp_at_handle_urc(line);
+        if (expect != NULL ? strncmp(line, expect, expect_len) == 0 : strcmp(line, "OK") == 0) {
+            return true;
+        }
+        if (strcmp(line, "ERROR") == 0 || strcmp(line, "FAIL") == 0 ||
+            strcmp(line, "SEND FAIL") == 0) {
+            s_stats.errors++;
+            LOG_DEBUG("命令失败: %s", line);
+            return false;
+        }
+    }
+    s_stats.timeouts++;
+    return false;
+}
+
+/**
+ * @brief 等待以 prefix 开头的数据行并取出其余部分，然后等待 OK
+ */
+static bool esp_at_wait_reply(const char *prefix, char *reply, uint16_t size,
+                              uint32_t timeout_ms) {
+    TickType_t deadline = xTaskGetTickCount() + pdMS_TO_TICKS(timeout_ms);
+    size_t prefix_len = strlen(prefix);
+    bool got = false;
+    const char *line;
+
+    while ((line = esp_at_read_line(deadline)) != NULL) {
+        esp_at_handle_urc(line);
+        if (strncmp(line, prefix, prefix_len) == 0) {
+            strncpy(reply, line + prefix_len, size - 1U);
+            reply[size - 1U] = '\0';
+            got = true;
+        } else if (strcmp(line, "OK") == 0) {
+            return got;
+        } else if (strcmp(line, "ERROR") == 0 || strcmp(line, "FAIL") == 0) {
+            s_stats.errors++;
+            LOG_DEBUG("命令失败: %s", line);
+            return false;
+        }
+    }
+    s_stats.timeouts++;
+    return false;
+}
+
+/**
+ * @brief 格式化并发送一条命令 (不等待应答)
+ */
+static bool esp_at_send_command(const char *fmt, va_list ap) {
+    int n;
+
+    if (!s_started) {
+        return false;
+    }
+    s_waiter = xTaskGetCurrentTaskHandle();
+
+    n = vsnprintf(s_cmd, ESP_AT_CMD_MAX - 2, fmt, ap);
+    if (n < 0 || n >= ESP_AT_CMD_MAX - 2) {
+        return false;
+    }
+    s_cmd[n++] = '\r';
+    s_cmd[n++] = '\n';
+
+    esp_at_discard_input();     // 上一条命令超时后迟到的应答不能算作本条的结果
+    if (!esp_at_transmit((const uint8_t *)s_cmd, (uint16_t)n)) {
+        return false;
+    }
+    s_stats.commands++;
+    return true;
+}
+
+/* --------------------------- 接口函数 --------------------------- */
+
+bool EspAt_Init(void) {
+    if (s_started) {
+        return true;
+    }
+    if (s_tx_done == NULL) {
+        s_tx_done = xSemaphoreCreateBinaryStatic(&s_tx_done_buf);
+    }
+    if (!esp_at_hw_init() || !esp_at_start_rx()) {
+        LOG_ERROR("UART5 初始化失败");
+        return false;
+    }
+    s_rx_head = 0;
+    s_rx_tail = 0;
+    s_line_len = 0;
+    s_started = true;
+    Energy_SetLevel(ENERGY_RAIL_RADIO, 1000); // 模块开始工作，按平均电流计入
+    return true;
+}
+
+bool EspAt_Command(uint32_t timeout_ms, const char *expect, const char *fmt, ...) {
+    va_list ap;
+    bool sent;
+
+    va_start(ap, fmt);
+    sent = esp_at_send_command(fmt, ap);
+    va_end(ap);
+    return sent && esp_at_wait(expect, timeout_ms);
+}
+
+bool EspAt_Query(uint32_t timeout_ms, const char *prefix, char *reply, uint16_t size,
+                 const char *fmt, ...) {
+    va_list ap;
+    bool sent;
+
+    if (size == 0) {
+        return false;
+    }
+    va_start(ap, fmt);
+    sent = esp_at_send_command(fmt, ap);
+    va_end(ap);
+    return sent && esp_at_wait_reply(prefix, reply, size, timeout_ms);
+}
+
+bool EspAt_Send(const uint8_t *data, uint16_t len, uint32_t timeout_ms) {
+    // 模块先回复 OK，再给出 '>' 提示符
+    if (!EspAt_Command(1000, ">", "AT+CIPSEND=%u", (unsigned)len)) {
+        return false;
+    }
+    if (!esp_at_transmit(data, len)) {
+        return false;
+    }
+    return esp_at_wait("SEND OK", timeout_ms);
+}
+
+bool EspAt_HasIp(void) {
+    return s_stats.has_ip;
+}
+
+bool EspAt_IsLinked(void) {
+    return s_stats.linked;
+}
+
+void EspAt_GetStats(EspAtStats_t *stats) {
+    *stats = s_stats;
+}
+
+/* --------------------------- HAL 回调 --------------------------- */
+
+/**
+ * @brief 接收事件 (半满/满/空闲)：更新写入位置 (中断上下文)
+ */
+void EspAt_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size) {
+    if (huart != &huart5) {
+        return;
+    }
+    s_rx_head = size % ESP_AT_RX_BUFFER_SIZE;
+    esp_at_wake_waiter();
+}
+
+void EspAt_TxCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart != &huart5) {
+        return;
+    }
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(s_tx_done, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief UART 错误：溢出等错误会中止接收 DMA，重新启动后从缓冲区开头写入
+ */
+void EspAt_ErrorCallback(UART_HandleTypeDef *huart) {
+    if (huart != &huart5) {
+        return;
+    }
+    s_stats.uart_errors++;
+    if (huart->RxState == HAL_UART_STATE_READY) {
+        s_rx_head = 0;
+        s_rx_resync = 1;
+        esp_at_start_rx();
+        esp_at_wake_waiter();
+    }
+}
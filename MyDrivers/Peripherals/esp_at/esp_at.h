@@ -0,0 +1,104 @@
+/**
+ ******************************************************************************
+ * @file    esp_at.h
+ * @brief   ESP8266/ESP32 AT 固件 Wi-Fi 模块驱动头文件
+ * @details 模块接在 UART5：PC12 TX, PD2 RX (板上 SDIO 引脚，工程未使用 SD 卡)。
+ *          CubeMX 工程未配置 UART5，驱动自行初始化引脚、UART 与 DMA：
+ *            - 接收：DMA1 Stream0 循环模式 + 空闲中断 (ReceiveToIdle)，
+ *              中断只更新写入位置并唤醒等待的任务，行解析在任务中进行；
+ *            - 发送：DMA1 Stream7 单次模式，命令与数据都不经过 CPU 逐字节发送。
+ *          接口为阻塞式，同一时刻只允许一个任务 (遥测任务) 调用。
+ *          异步上报 (WIFI GOT IP / WIFI DISCONNECT / CONNECT / CLOSED) 在读取
+ *          应答的过程中顺带处理，用于跟踪链路状态。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __ESP_AT_H
+#define __ESP_AT_H
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define ESP_AT_BAUDRATE         115200      // AT 固件默认波特率
+#define ESP_AT_RX_BUFFER_SIZE   256         // 接收环形缓冲区 (字节)
+#define ESP_AT_LINE_MAX         64          // 单行应答最大长度 (超出部分丢弃)
+#define ESP_AT_CMD_MAX          128         // 单条命令最大长度 (含 \r\n)
+#define ESP_AT_IRQ_PRIORITY     5           // 不高于 configMAX_SYSCALL_INTERRUPT_PRIORITY
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 驱动统计
+ */
+typedef struct {
+    uint32_t commands;      // 已发送的命令数
+    uint32_t timeouts;      // 等待应答超时次数
+    uint32_t errors;        // ERROR / FAIL 应答次数
+    uint32_t uart_errors;   // UART 错误 (溢出、噪声等) 次数
+    bool has_ip;            // 已获取 IP
+    bool linked;            // TCP 链路已建立
+} EspAtStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化 UART5 与收发 DMA 并开始接收 (可重复调用)
+ * @return true: 成功
+ */
+bool EspAt_Init(void);
+
+/**
+ * @brief 发送一条 AT 命令并等待应答
+ * @param timeout_ms 等待应答的时间
+ * @param expect     成功标志行的前缀；NULL 表示以 "OK" 为成功
+ * @param fmt        命令格式串 (不含 \r\n)
+ * @return true: 收到成功标志；收到 ERROR/FAIL 或超时返回 false
+ */
+bool EspAt_Command(uint32_t timeout_ms, const char *expect, const char *fmt, ...);
+
+/**
+ * @brief 发送一条查询命令并取出数据行
+ * @param prefix 数据行前缀 (如 "+CIPSNTPTIME:")，reply 中不含前缀
+ * @param reply  数据行缓冲区 (超长时截断)
+ * @return true: 收到数据行且命令以 OK 结束
+ */
+bool EspAt_Query(uint32_t timeout_ms, const char *prefix, char *reply, uint16_t size,
+                 const char *fmt, ...);
+
+/**
+ * @brief 在已建立的 TCP 链路上发送一段数据 (AT+CIPSEND)
+ * @param data 数据 (DMA 发送期间须保持有效)
+ * @param len  长度 (不超过 2048)
+ * @return true: 模块回复 SEND OK
+ */
+bool EspAt_Send(const uint8_t *data, uint16_t len, uint32_t timeout_ms);
+
+/**
+ * @brief 链路状态 (由异步上报维护)
+ */
+bool EspAt_HasIp(void);
+bool EspAt_IsLinked(void);
+
+/**
+ * @brief 获取驱动统计
+ */
+void EspAt_GetStats(EspAtStats_t *stats);
+
+/* --------------------------- HAL 回调 (main.c 中分发) --------------------------- */
+void EspAt_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size);
+void EspAt_TxCpltCallback(UART_HandleTypeDef *huart);
+void EspAt_ErrorCallback(UART_HandleTypeDef *huart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ESP_AT_H */
@@ -0,0 +1,379 @@
+/**
+ ******************************************************************************
+ * @file    eth_mac.c
+ * @brief   以太网 MAC (RMII + LAN8720) 驱动实现
+ * @details 描述符为普通 (非增强) 格式，环形排列 (最后一个置 TER/RER)。
+ *          发送：头部复制到该描述符专用的小缓冲区作为缓冲区 1，负载指针
+ *          直接作为缓冲区 2，一个描述符即一帧 (FS + LS)，MAC 在发送 FIFO
+ *          中计算并插入 IPv4 头与 UDP 校验和 (要求发送存储转发)。
+ *          接收：每个描述符一个最大帧长的缓冲区，帧不会跨描述符；DMA
+ *          完成一帧后中断释放信号量，EthMac_Poll 依次交给回调后归还。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "eth_mac.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include <string.h>
+
+#define LOG_MODULE "ETH"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define ETH_HEAD_MAX        64          // 发送头部上限 (以太网 + IPv4 + UDP 为 42 字节)
+#define ETH_FRAME_MAX       1514        // 不含 FCS
+
+/* 发送描述符 TDES0 */
+#define TDES0_OWN           (1UL << 31)
+#define TDES0_IC            (1UL << 30) // 完成中断
+#define TDES0_LS            (1UL << 29)
+#define TDES0_FS            (1UL << 28)
+#define TDES0_CIC_FULL      (3UL << 22) // IP 头与载荷校验和 (含伪首部) 由硬件插入
+#define TDES0_TER           (1UL << 21)
+#define TDES0_ES            (1UL << 15)
+
+/* 接收描述符 RDES0/RDES1 */
+#define RDES0_OWN           (1UL << 31)
+#define RDES0_FL_POS        16
+#define RDES0_FL_MASK       0x3FFFUL
+#define RDES0_ES            (1UL << 15)
+#define RDES0_FS            (1UL << 9)
+#define RDES0_LS            (1UL << 8)
+#define RDES1_RER           (1UL << 15)
+
+/* PHY 寄存器 (LAN8720) */
+#define LAN8720_BCR             0
+#define LAN8720_BSR             1
+#define LAN8720_ID1             2
+#define LAN8720_SCSR            31          // 特殊控制/状态：协商结果
+#define LAN8720_BCR_RESET       0x8000
+#define LAN8720_BCR_AUTONEG     0x1000
+#define LAN8720_BCR_RESTART_AN  0x0200
+#define LAN8720_BSR_LINK        0x0004
+#define LAN8720_BSR_AN_DONE     0x0020
+#define LAN8720_SCSR_100M       0x0008
+#define LAN8720_SCSR_FULL       0x0010
+
+typedef struct {
+    volatile uint32_t status;
+    volatile uint32_t control;
+    volatile uint32_t buf1;
+    volatile uint32_t buf2;
+} EthDesc_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static bool s_ready = false;
+static volatile bool s_link = false;
+
+static EthDesc_t s_rx_desc[ETH_MAC_RX_DESC_COUNT];
+static EthDesc_t s_tx_desc[ETH_MAC_TX_DESC_COUNT];
+static uint32_t s_rx_buf[ETH_MAC_RX_DESC_COUNT][ETH_MAC_RX_BUF_SIZE / 4];
+static uint32_t s_tx_head[ETH_MAC_TX_DESC_COUNT][ETH_HEAD_MAX / 4];
+static uint8_t s_rx_next;
+static uint8_t s_tx_next;
+
+static SemaphoreHandle_t s_rx_sem = NULL;
+static StaticSemaphore_t s_rx_sem_buf;
+static SemaphoreHandle_t s_tx_sem = NULL;
+static StaticSemaphore_t s_tx_sem_buf;
+static SemaphoreHandle_t s_tx_mutex = NULL;
+static StaticSemaphore_t s_tx_mutex_buf;
+static EthMac_Stats_t s_stats;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static bool eth_mdio_wait(void) {
+    uint32_t start = HAL_GetTick();
+
+    while (ETH->MACMIIAR & ETH_MACMIIAR_MB) {
+        if (HAL_GetTick() - start > 10) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool eth_phy_read(uint8_t reg, uint16_t *value) {
+    ETH->MACMIIAR = ((uint32_t)ETH_MAC_PHY_ADDR << ETH_MACMIIAR_PA_Pos) |
+                    ((uint32_t)reg << ETH_MACMIIAR_MR_Pos) | ETH_MACMIIAR_CR_Div102 |
+                    ETH_MACMIIAR_MB;
+    if (!eth_mdio_wait()) {
+        return false;
+    }
+    *value = (uint16_t)ETH->MACMIIDR;
+    return true;
+}
+
+static bool eth_phy_write(uint8_t reg, uint16_t value) {
+    ETH->MACMIIDR = value;
+    ETH->MACMIIAR = ((uint32_t)ETH_MAC_PHY_ADDR << ETH_MACMIIAR_PA_Pos) |
+                    ((uint32_t)reg << ETH_MACMIIAR_MR_Pos) | ETH_MACMIIAR_CR_Div102 |
+                    ETH_MACMIIAR_MW | ETH_MACMIIAR_MB;
+    return eth_mdio_wait();
+}
+
+/* MAC 寄存器写入后需等待几个 MII 时钟才生效，回读一次 */
+static void eth_write_maccr(uint32_t value) {
+    ETH->MACCR = value;
+    (void)ETH->MACCR;
+    vTaskDelay(1);
+    ETH->MACCR = value;
+}
+
+/**
+ * @brief 引脚、RMII 选择与 MAC 时钟
+ */
+static void eth_hw_init(void) {
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_GPIOG_CLK_ENABLE();
+    __HAL_RCC_SYSCFG_CLK_ENABLE();
+    SYSCFG->PMC |= SYSCFG_PMC_MII_RMII_SEL;     /* 须在 MAC 时钟使能前选择 RMII */
+
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF11_ETH;
+    gpio.Pin = GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_7;                    /* REF_CLK MDIO CRS_DV */
+    HAL_GPIO_Init(GPIOA, &gpio);
+    gpio.Pin = GPIO_PIN_1 | GPIO_PIN_4 | GPIO_PIN_5;                    /* MDC RXD0 RXD1 */
+    HAL_GPIO_Init(GPIOC, &gpio);
+    gpio.Pin = GPIO_PIN_11 | GPIO_PIN_13 | GPIO_PIN_14;                 /* TX_EN TXD0 TXD1 */
+    HAL_GPIO_Init(GPIOG, &gpio);
+
+    __HAL_RCC_ETHMAC_CLK_ENABLE();
+    __HAL_RCC_ETHMACTX_CLK_ENABLE();
+    __HAL_RCC_ETHMACRX_CLK_ENABLE();
+    __HAL_RCC_ETHMAC_FORCE_RESET();
+    __HAL_RCC_ETHMAC_RELEASE_RESET();
+}
+
+static void eth_desc_init(void) {
+    for (uint32_t i = 0; i < ETH_MAC_RX_DESC_COUNT; i++) {
+        s_rx_desc[i].buf1 = (uint32_t)s_rx_buf[i];
+        s_rx_desc[i].buf2 = 0;
+        s_rx_desc[i].control = ETH_MAC_RX_BUF_SIZE |
+                               (i + 1 == ETH_MAC_RX_DESC_COUNT ? RDES1_RER : 0);
+        s_rx_desc[i].status = RDES0_OWN;
+    }
+    for (uint32_t i = 0; i < ETH_MAC_TX_DESC_COUNT; i++) {
+        s_tx_desc[i].buf1 = (uint32_t)s_tx_head[i];
+        s_tx_desc[i].buf2 = 0;
+        s_tx_desc[i].control = 0;
+        s_tx_desc[i].status = (i + 1 == ETH_MAC_TX_DESC_COUNT) ? TDES0_TER : 0;
+    }
+    s_rx_next = 0;
+    s_tx_next = 0;
+    ETH->DMARDLAR = (uint32_t)s_rx_desc;
+    ETH->DMATDLAR = (uint32_t)s_tx_desc;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+bool EthMac_Init(const uint8_t mac[6]) {
+    uint16_t value = 0;
+    uint32_t start;
+
+    if (s_ready) {
+        return true;
+    }
+    if (s_rx_sem == NULL) {
+        s_rx_sem = xSemaphoreCreateBinaryStatic(&s_rx_sem_buf);
+        s_tx_sem = xSemaphoreCreateBinaryStatic(&s_tx_sem_buf);
+        s_tx_mutex = xSemaphoreCreateMutexStatic(&s_tx_mutex_buf);
+    }
+    eth_hw_init();
+
+    /* DMA 软件复位在 PHY 提供 50 MHz 参考时钟后才能完成 */
+    ETH->DMABMR |= ETH_DMABMR_SR;
+    for (uint8_t i = 0; i < 20 && (ETH->DMABMR & ETH_DMABMR_SR); i++) {
+        vTaskDelay(pdMS_TO_TICKS(1));
+    }
+    if (ETH->DMABMR & ETH_DMABMR_SR) {
+        LOG_WARN("以太网 DMA 复位超时 (PHY 未提供参考时钟)");
+        return false;
+    }
+    if (!eth_phy_read(LAN8720_ID1, &value) || value == 0 || value == 0xFFFF) {
+        LOG_WARN("PHY 无应答");
+        return false;
+    }
+
+    eth_phy_write(LAN8720_BCR, LAN8720_BCR_RESET);
+    start = HAL_GetTick();
+    do {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    } while (eth_phy_read(LAN8720_BCR, &value) && (value & LAN8720_BCR_RESET) &&
+             HAL_GetTick() - start < 500);
+    eth_phy_write(LAN8720_BCR, LAN8720_BCR_AUTONEG | LAN8720_BCR_RESTART_AN);
+
+    ETH->MACA0HR = (uint32_t)mac[4] | ((uint32_t)mac[5] << 8);
+    ETH->MACA0LR = (uint32_t)mac[0] | ((uint32_t)mac[1] << 8) |
+                   ((uint32_t)mac[2] << 16) | ((uint32_t)mac[3] << 24);
+    ETH->MACFFR = 0;                            /* 单播地址匹配 + 广播 */
+    ETH->MACFCR = 0;
+    eth_desc_init();
+    ETH->DMABMR = ETH_DMABMR_AAB | ETH_DMABMR_PBL_32Beat;
+    ETH->DMAOMR = ETH_DMAOMR_RSF | ETH_DMAOMR_TSF;
+    ETH->DMAIER = ETH_DMAIER_NISE | ETH_DMAIER_RIE | ETH_DMAIER_TIE;
+
+    HAL_NVIC_SetPriority(ETH_IRQn, ETH_MAC_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(ETH_IRQn);
+
+    /* 速率与双工在链路建立后按协商结果修改 */
+    eth_write_maccr(ETH_MACCR_FES | ETH_MACCR_DM | ETH_MACCR_TE | ETH_MACCR_RE);
+    ETH->DMAOMR |= ETH_DMAOMR_FTF;
+    for (uint32_t i = 0; i < 10000U && (ETH->DMAOMR & ETH_DMAOMR_FTF); i++) {
+    }
+    ETH->DMAOMR |= ETH_DMAOMR_ST | ETH_DMAOMR_SR;
+
+    s_ready = true;
+    LOG_INFO("以太网 MAC %02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2],
+             mac[3], mac[4], mac[5]);
+    return true;
+}
+
+bool EthMac_CheckLink(void) {
+    uint16_t bsr = 0;
+    uint16_t scsr = 0;
+    bool up;
+
+    if (!s_ready) {
+        return false;
+    }
+    /* 链路位低电平锁存，第二次读取为当前状态 */
+    up = eth_phy_read(LAN8720_BSR, &bsr) && eth_phy_read(LAN8720_BSR, &bsr) &&
+         (bsr & LAN8720_BSR_LINK) && (bsr & LAN8720_BSR_AN_DONE);
+    if (up == s_link) {
+        return up;
+    }
+
+    if (up && eth_phy_read(LAN8720_SCSR, &scsr)) {
+        uint32_t cr = ETH->MACCR & ~(ETH_MACCR_FES | ETH_MACCR_DM);
+        if (scsr & LAN8720_SCSR_100M) {
+            cr |= ETH_MACCR_FES;
+        }
+        if (scsr & LAN8720_SCSR_FULL) {
+            cr |= ETH_MACCR_DM;
+        }
+        eth_write_maccr(cr);
+        LOG_INFO("以太网链路已建立: %s %s", (scsr & LAN8720_SCSR_100M) ? "100M" : "10M",
+                 (scsr & LAN8720_SCSR_FULL) ? "全双工" : "半双工");
+    } else if (!up) {
+        LOG_WARN("以太网链路断开");
+    }
+    s_link = up;
+    s_stats.link_changes++;
+    return up;
+}
+
+bool EthMac_IsLinkUp(void) {
+    return s_link;
+}
+
+bool EthMac_Send(const uint8_t *head, uint16_t head_len, const void *payload,
+                 uint16_t payload_len) {
+    EthDesc_t *desc;
+    uint8_t index;
+    bool ok;
+
+    if (!s_ready || !s_link || head_len == 0 || head_len > ETH_HEAD_MAX ||
+        head_len + payload_len > ETH_FRAME_MAX || (payload_len != 0 && payload == NULL)) {
+        return false;
+    }
+
+    xSemaphoreTake(s_tx_mutex, portMAX_DELAY);
+    index = s_tx_next;
+    desc = &s_tx_desc[index];
+    if (desc->status & TDES0_OWN) {
+        /* 上一次使用该描述符的帧超时仍未发出 */
+        s_stats.tx_errors++;
+        xSemaphoreGive(s_tx_mutex);
+        return false;
+    }
+    memcpy(s_tx_head[index], head, head_len);
+    desc->buf2 = (uint32_t)payload;
+    desc->control = ((uint32_t)payload_len << 16) | head_len;
+    xSemaphoreTake(s_tx_sem, 0);
+    desc->status = (desc->status & TDES0_TER) | TDES0_OWN | TDES0_IC | TDES0_FS |
+                   TDES0_LS | TDES0_CIC_FULL;
+    __DSB();
+    s_tx_next = (uint8_t)((index + 1) % ETH_MAC_TX_DESC_COUNT);
+
+    ETH->DMASR = ETH_DMASR_TBUS;
+    ETH->DMATPDR = 0;                           /* 唤醒挂起的发送 DMA */
+
+    ok = xSemaphoreTake(s_tx_sem, pdMS_TO_TICKS(ETH_MAC_TX_TIMEOUT_MS)) == pdTRUE &&
+         (desc->status & (TDES0_OWN | TDES0_ES)) == 0;
+    if (ok) {
+        s_stats.tx_frames++;
+    } else {
+        s_stats.tx_errors++;
+    }
+    xSemaphoreGive(s_tx_mutex);
+    return ok;
+}
+
+uint32_t EthMac_Poll(EthMac_RxCallback_t cb, uint32_t timeout_ms) {
+    uint32_t count = 0;
+
+    if (!s_ready) {
+        vTaskDelay(pdMS_TO_TICKS(timeout_ms));
+        return 0;
+    }
+    if (s_rx_desc[s_rx_next].status & RDES0_OWN) {
+        xSemaphoreTake(s_rx_sem, pdMS_TO_TICKS(timeout_ms));
+    }
+
+    while ((s_rx_desc[s_rx_next].status & RDES0_OWN) == 0) {
+        EthDesc_t *desc = &s_rx_desc[s_rx_next];
+        uint32_t status = desc->status;
+        uint32_t len = (status >> RDES0_FL_POS) & RDES0_FL_MASK;
+
+        if ((status & (RDES0_FS | RDES0_LS)) == (RDES0_FS | RDES0_LS) &&
+            (status & RDES0_ES) == 0 && len > 4) {
+            if (cb != NULL) {
+                cb((const uint8_t *)s_rx_buf[s_rx_next], (uint16_t)(len - 4));
+            }
+            s_stats.rx_frames++;
+            count++;
+        } else {
+            s_stats.rx_errors++;
+        }
+        desc->status = RDES0_OWN;
+        s_rx_next = (uint8_t)((s_rx_next + 1) % ETH_MAC_RX_DESC_COUNT);
+    }
+
+    /* 描述符用尽时接收 DMA 挂起，归还后唤醒 */
+    if (ETH->DMASR & ETH_DMASR_RBUS) {
+        ETH->DMASR = ETH_DMASR_RBUS;
+        ETH->DMARPDR = 0;
+    }
+    s_stats.rx_missed += ETH->DMAMFBOCR & 0xFFFFU;  /* 读清零 */
+    return count;
+}
+
+void EthMac_GetStats(EthMac_Stats_t *stats) {
+    *stats = s_stats;
+}
+
+/**
+ * @brief 收发完成：唤醒等待的任务
+ */
+void EthMac_IRQHandler(void) {
+    BaseType_t woken = pdFALSE;
+    uint32_t sr = ETH->DMASR;
+
+    ETH->DMASR = sr & (ETH_DMASR_NIS | ETH_DMASR_RS | ETH_DMASR_TS);
+    if ((sr & ETH_DMASR_RS) && s_rx_sem != NULL) {
+        xSemaphoreGiveFromISR(s_rx_sem, &woken);
+    }
+    if ((sr & ETH_DMASR_TS) && s_tx_sem != NULL) {
+        xSemaphoreGiveFromISR(s_tx_sem, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
@@ -0,0 +1,113 @@
+/**
+ ******************************************************************************
+ * @file    eth_mac.h
+ * @brief   以太网 MAC (RMII + LAN8720) 驱动头文件
+ * @details PHY 为板载 LAN8720，RMII 引脚：PA1 REF_CLK, PA2 MDIO, PA7 CRS_DV,
+ *          PC1 MDC, PC4 RXD0, PC5 RXD1, PG11 TX_EN, PG13 TXD0, PG14 TXD1。
+ *          CubeMX 工程未配置 ETH，库中也没有 HAL ETH 模块，驱动直接操作
+ *          MAC/DMA 寄存器：
+ *            - 收发各一个固定的描述符环，接收缓冲区在初始化时一次分配，
+ *              运行中不申请内存；
+ *            - 发送描述符的两个缓冲区指针分别指向协议头与负载，负载直接
+ *              引用调用者的数据 (零拷贝)，IP/UDP 校验和由 MAC 硬件插入；
+ *            - 接收帧在描述符的缓冲区中原地交给回调，回调返回后归还 DMA。
+ *          PA1/PA2 与 RGB 灯的 TIM2_CH2/CH3 共用，启用以太网后 RGB 灯不再
+ *          输出。PHY 的复位脚不由 MCU 控制，初始化时经 MDIO 软件复位。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __ETH_MAC_H
+#define __ETH_MAC_H
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define ETH_MAC_PHY_ADDR        0           // LAN8720 PHYAD0 下拉
+#define ETH_MAC_RX_DESC_COUNT   4           // 接收描述符 (缓冲区) 数
+#define ETH_MAC_TX_DESC_COUNT   2           // 发送描述符数
+#define ETH_MAC_RX_BUF_SIZE     1524        // 接收缓冲区大小 (最大帧 + 4 字节 FCS，4 字节对齐)
+#define ETH_MAC_IRQ_PRIORITY    6           // 不高于 configMAX_SYSCALL_INTERRUPT_PRIORITY
+#define ETH_MAC_TX_TIMEOUT_MS   20          // 等待单帧发送完成的上限
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 接收帧回调 (任务上下文)
+ * @param frame 以太网帧 (从目的 MAC 开始，不含 FCS)，回调返回后失效
+ */
+typedef void (*EthMac_RxCallback_t)(const uint8_t *frame, uint16_t len);
+
+/**
+ * @brief 驱动统计
+ */
+typedef struct {
+    uint32_t tx_frames;     // 发送完成的帧数
+    uint32_t tx_errors;     // 发送错误或超时
+    uint32_t rx_frames;     // 交给回调的帧数
+    uint32_t rx_errors;     // CRC、长度等错误而丢弃的帧数
+    uint32_t rx_missed;     // 接收描述符用尽时 MAC 丢弃的帧数
+    uint32_t link_changes;  // 链路状态变化次数
+} EthMac_Stats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化引脚、MAC 与 DMA，复位 PHY 并开始自协商
+ * @param mac 本机 MAC 地址
+ * @return false: PHY 无应答或 DMA 复位超时 (没有 50 MHz 参考时钟)
+ * @note  须在任务中调用
+ */
+bool EthMac_Init(const uint8_t mac[6]);
+
+/**
+ * @brief 查询链路 (读取 PHY 状态，链路建立时按协商结果配置 MAC 速率与双工)
+ * @return true: 链路已建立
+ */
+bool EthMac_CheckLink(void);
+
+/**
+ * @brief 最近一次查询的链路状态
+ */
+bool EthMac_IsLinkUp(void);
+
+/**
+ * @brief 发送一帧：头部与负载由同一个描述符的两个缓冲区发出
+ * @param head    以太网头与协议头 (复制到驱动内部，可在返回前修改)
+ * @param payload 负载，直接由 DMA 读取 (不能位于 CCM RAM)，可为 NULL
+ * @return true: 已发出
+ * @note  阻塞到 DMA 读完负载，返回后调用者才能修改负载；多个任务可同时调用
+ */
+bool EthMac_Send(const uint8_t *head, uint16_t head_len, const void *payload,
+                 uint16_t payload_len);
+
+/**
+ * @brief 等待并处理接收帧
+ * @param cb         每个完整的帧调用一次
+ * @param timeout_ms 没有帧时最长等待时间
+ * @return 处理的帧数
+ */
+uint32_t EthMac_Poll(EthMac_RxCallback_t cb, uint32_t timeout_ms);
+
+/**
+ * @brief 获取驱动统计
+ */
+void EthMac_GetStats(EthMac_Stats_t *stats);
+
+/**
+ * @brief ETH 中断处理，在 ETH_IRQHandler 中调用
+ */
+void EthMac_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ETH_MAC_H */
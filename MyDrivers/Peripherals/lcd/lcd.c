@@ -27,6 +27,7 @@
  */
 
 #include "lcd.h"
+#include "energy_meter.h"
 #include "fsmc.h"
 #include "lcdfont.h"
 #include "main.h"
@@ -49,11 +50,14 @@ uint32_t g_back_color = 0xFFFF;  /* 
 _lcd_dev lcddev;
 /* ɨ跽 */
 uint8_t g_lcd_scan_dir = 0;
+/* ǰ (0~100) */
+static uint8_t g_lcd_backlight = 0;
 
 /**
  * @brief       LCDд
  * @param       data: Ҫд
  * @retval      
+ * @note        ; ʹ lcd.h  lcd_stream_pixels
  */
 void lcd_wr_data(volatile uint16_t data) {
   data = data; /* ʹ-O2Żʱ,ʱ */
@@ -108,7 +112,57 @@ static uint16_t lcd_rd_data(void) {
  * @param       
  * @retval      
  */
-void lcd_write_ram_prepare(void) { LCD->LCD_REG = lcddev.wramcmd; }
+void lcd_write_ram_prepare(void) { LCD->LCD_REG = LCD_CMD_WRAM; }
+
+#if LCD_FILL_USE_DMA
+/**
+ * @brief       ʹ DMA(洢洢, ѯʽ) LCD_RAM д n 
+ *   @note      /ȷ LVGL ,  LVGL ˢʹòͬ;
+ *              NDTR Ϊ 16 λ,  65535 ʱֶδ
+ * @param       src: Դַ
+ * @param       n: ظ
+ * @param       src_inc: DMA_PINC_ENABLE(ɫ) / DMA_PINC_DISABLE(ɫ)
+ * @retval      
+ */
+static void lcd_dma_stream(uint32_t src, uint32_t n, uint32_t src_inc) {
+  static DMA_HandleTypeDef hdma_lcd_fill;
+  static uint8_t inited = 0;
+
+  if (!inited) {
+    __HAL_RCC_DMA2_CLK_ENABLE();
+    hdma_lcd_fill.Instance = LCD_FILL_DMA_STREAM;
+    hdma_lcd_fill.Init.Channel = DMA_CHANNEL_0;
+    hdma_lcd_fill.Init.Direction = DMA_MEMORY_TO_MEMORY;
+    hdma_lcd_fill.Init.PeriphInc = DMA_PINC_ENABLE;
+    hdma_lcd_fill.Init.MemInc = DMA_MINC_DISABLE;
+    hdma_lcd_fill.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    hdma_lcd_fill.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    hdma_lcd_fill.Init.Mode = DMA_NORMAL;
+    hdma_lcd_fill.Init.Priority = DMA_PRIORITY_HIGH;
+    hdma_lcd_fill.Init.FIFOMode = DMA_FIFOMODE_ENABLE;
+    hdma_lcd_fill.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_FULL;
+    hdma_lcd_fill.Init.MemBurst = DMA_MBURST_SINGLE;
+    hdma_lcd_fill.Init.PeriphBurst = DMA_PBURST_SINGLE;
+    HAL_DMA_Init(&hdma_lcd_fill);
+    inited = 1;
+  }
+
+  MODIFY_REG(hdma_lcd_fill.Instance->CR, DMA_SxCR_PINC, src_inc);
+
+  while (n > 0) {
+    uint32_t len = (n > 0xFFFF) ? 0xFFFF : n;
+
+    HAL_DMA_Start(&hdma_lcd_fill, src, (uint32_t)&LCD->LCD_RAM, len);
+    HAL_DMA_PollForTransfer(&hdma_lcd_fill, HAL_DMA_FULL_TRANSFER,
+                            HAL_MAX_DELAY);
+
+    if (src_inc == DMA_PINC_ENABLE) {
+      src += len * 2;
+    }
+    n -= len;
+  }
+}
+#endif
 
 /**
  * @brief       ȡĳɫֵ
@@ -124,7 +178,7 @@ uint32_t lcd_read_point(uint16_t x, uint16_t y) {
 
   lcd_set_cursor(x, y); /*  */
 
-  if (lcddev.id == 0x5510) {
+  if (LCD_ID_IS(0x5510)) {
     lcd_wr_regno(0x2E00); /* 5510 ͶGRAMָ */
   } else {
     lcd_wr_regno(0x2E); /* 9341/5310/1963/7789/7796/9806 ȷͶGRAMָ */
@@ -132,13 +186,13 @@ uint32_t lcd_read_point(uint16_t x, uint16_t y) {
 
   r = lcd_rd_data(); /* ٶ(dummy read) */
 
-  if (lcddev.id == 0x1963) {
+  if (LCD_ID_IS(0x1963)) {
     return r; /* 1963ֱӶͿ */
   }
 
   r = lcd_rd_data(); /* ʵɫ */
 
-  if (lcddev.id == 0x7796) /* 7796 һζȡһֵ */
+  if (LCD_ID_IS(0x7796)) /* 7796 һζȡһֵ */
   {
     return r;
   }
@@ -160,7 +214,7 @@ uint32_t lcd_read_point(uint16_t x, uint16_t y) {
  * @retval      
  */
 void lcd_display_on(void) {
-  if (lcddev.id == 0x5510) {
+  if (LCD_ID_IS(0x5510)) {
     lcd_wr_regno(0x2900); /* ʾ */
   } else                  /* 9341/5310/1963/7789/7796/9806 ȷͿʾָ */
   {
@@ -174,7 +228,7 @@ void lcd_display_on(void) {
  * @retval      
  */
 void lcd_display_off(void) {
-  if (lcddev.id == 0x5510) {
+  if (LCD_ID_IS(0x5510)) {
     lcd_wr_regno(0x2800); /* رʾ */
   } else                  /* 9341/5310/1963/7789/7796/9806 ȷ͹رʾָ */
   {
@@ -188,45 +242,45 @@ void lcd_display_off(void) {
  * @retval      
  */
 void lcd_set_cursor(uint16_t x, uint16_t y) {
-  if (lcddev.id == 0x1963) {
+  if (LCD_ID_IS(0x1963)) {
     if (lcddev.dir == 0) /* ģʽ, xҪ任 */
     {
       x = lcddev.width - 1 - x;
-      lcd_wr_regno(lcddev.setxcmd);
+      lcd_wr_regno(LCD_CMD_SETX);
       lcd_wr_data(0);
       lcd_wr_data(0);
       lcd_wr_data(x >> 8);
       lcd_wr_data(x & 0xFF);
     } else /* ģʽ */
     {
-      lcd_wr_regno(lcddev.setxcmd);
+      lcd_wr_regno(LCD_CMD_SETX);
       lcd_wr_data(x >> 8);
       lcd_wr_data(x & 0xFF);
       lcd_wr_data((lcddev.width - 1) >> 8);
       lcd_wr_data((lcddev.width - 1) & 0xFF);
     }
 
-    lcd_wr_regno(lcddev.setycmd);
+    lcd_wr_regno(LCD_CMD_SETY);
     lcd_wr_data(y >> 8);
     lcd_wr_data(y & 0xFF);
     lcd_wr_data((lcddev.height - 1) >> 8);
     lcd_wr_data((lcddev.height - 1) & 0xFF);
 
-  } else if (lcddev.id == 0x5510) {
-    lcd_wr_regno(lcddev.setxcmd);
+  } else if (LCD_ID_IS(0x5510)) {
+    lcd_wr_regno(LCD_CMD_SETX);
     lcd_wr_data(x >> 8);
-    lcd_wr_regno(lcddev.setxcmd + 1);
+    lcd_wr_regno(LCD_CMD_SETX + 1);
     lcd_wr_data(x & 0xFF);
-    lcd_wr_regno(lcddev.setycmd);
+    lcd_wr_regno(LCD_CMD_SETY);
     lcd_wr_data(y >> 8);
-    lcd_wr_regno(lcddev.setycmd + 1);
+    lcd_wr_regno(LCD_CMD_SETY + 1);
     lcd_wr_data(y & 0xFF);
   } else /* 9341/5310/7789/7796/9806   */
   {
-    lcd_wr_regno(lcddev.setxcmd);
+    lcd_wr_regno(LCD_CMD_SETX);
     lcd_wr_data(x >> 8);
     lcd_wr_data(x & 0xFF);
-    lcd_wr_regno(lcddev.setycmd);
+    lcd_wr_regno(LCD_CMD_SETY);
     lcd_wr_data(y >> 8);
     lcd_wr_data(y & 0xFF);
   }
@@ -250,8 +304,8 @@ void lcd_scan_dir(uint8_t dir) {
 
   /* ʱ1963ıɨ跽ʱ1963ı䷽(1963⴦,ICЧ)
    */
-  if ((lcddev.dir == 1 && lcddev.id != 0x1963) ||
-      (lcddev.dir == 0 && lcddev.id == 0x1963)) {
+  if ((lcddev.dir == 1 && !LCD_ID_IS(0x1963)) ||
+      (lcddev.dir == 0 && LCD_ID_IS(0x1963))) {
     switch (dir) /* ת */
     {
     case 0:
@@ -325,18 +379,18 @@ void lcd_scan_dir(uint8_t dir) {
 
   dirreg = 0x36; /* Ծ󲿷IC, 0x36Ĵ */
 
-  if (lcddev.id == 0x5510) {
+  if (LCD_ID_IS(0x5510)) {
     dirreg = 0x3600; /* 5510, icļĴв */
   }
 
   /* 9341 & 7789 & 7796 ҪBGRλ */
-  if (lcddev.id == 0x9341 || lcddev.id == 0x7789 || lcddev.id == 0x7796) {
+  if (LCD_ID_IS(0x9341) || LCD_ID_IS(0x7789) || LCD_ID_IS(0x7796)) {
     regval |= 0x08;
   }
 
   lcd_write_reg(dirreg, regval);
 
-  if (lcddev.id != 0x1963) /* 1963괦 */
+  if (!LCD_ID_IS(0x1963)) /* 1963괦 */
   {
     if (regval & 0x20) {
       if (lcddev.width < lcddev.height) /* X,Y */
@@ -356,30 +410,30 @@ void lcd_scan_dir(uint8_t dir) {
   }
 
   /* ʾ()С */
-  if (lcddev.id == 0x5510) {
-    lcd_wr_regno(lcddev.setxcmd);
+  if (LCD_ID_IS(0x5510)) {
+    lcd_wr_regno(LCD_CMD_SETX);
     lcd_wr_data(0);
-    lcd_wr_regno(lcddev.setxcmd + 1);
+    lcd_wr_regno(LCD_CMD_SETX + 1);
     lcd_wr_data(0);
-    lcd_wr_regno(lcddev.setxcmd + 2);
+    lcd_wr_regno(LCD_CMD_SETX + 2);
     lcd_wr_data((lcddev.width - 1) >> 8);
-    lcd_wr_regno(lcddev.setxcmd + 3);
+    lcd_wr_regno(LCD_CMD_SETX + 3);
     lcd_wr_data((lcddev.width - 1) & 0xFF);
-    lcd_wr_regno(lcddev.setycmd);
+    lcd_wr_regno(LCD_CMD_SETY);
     lcd_wr_data(0);
-    lcd_wr_regno(lcddev.setycmd + 1);
+    lcd_wr_regno(LCD_CMD_SETY + 1);
     lcd_wr_data(0);
-    lcd_wr_regno(lcddev.setycmd + 2);
+    lcd_wr_regno(LCD_CMD_SETY + 2);
     lcd_wr_data((lcddev.height - 1) >> 8);
-    lcd_wr_regno(lcddev.setycmd + 3);
+    lcd_wr_regno(LCD_CMD_SETY + 3);
     lcd_wr_data((lcddev.height - 1) & 0xFF);
   } else {
-    lcd_wr_regno(lcddev.setxcmd);
+    lcd_wr_regno(LCD_CMD_SETX);
     lcd_wr_data(0);
     lcd_wr_data(0);
     lcd_wr_data((lcddev.width - 1) >> 8);
     lcd_wr_data((lcddev.width - 1) & 0xFF);
-    lcd_wr_regno(lcddev.setycmd);
+    lcd_wr_regno(LCD_CMD_SETY);
     lcd_wr_data(0);
     lcd_wr_data(0);
     lcd_wr_data((lcddev.height - 1) >> 8);
@@ -414,6 +468,71 @@ void lcd_ssd_backlight_set(uint8_t pwm) {
   lcd_wr_data(0x00);       /* 6F */
 }
 
+/**
+ * @brief        PWM ʼ: PB15 лΪ TIM12_CH2 
+ * @param       
+ * @retval      
+ */
+static void lcd_backlight_pwm_init(void) {
+  GPIO_InitTypeDef gpio_init_struct = {0};
+  RCC_ClkInitTypeDef clk;
+  uint32_t latency;
+  uint32_t timclk;
+
+  /* APB1 ƵΪ 1 ʱʱʱΪ PCLK1  2  */
+  HAL_RCC_GetClockConfig(&clk, &latency);
+  timclk = HAL_RCC_GetPCLK1Freq();
+  if (clk.APB1CLKDivider != RCC_HCLK_DIV1) {
+    timclk *= 2U;
+  }
+
+  LCD_BL_TIM_CLK_ENABLE();
+  LCD_BL_TIM->CR1 = 0;
+  LCD_BL_TIM->PSC = timclk / (100U * LCD_BL_PWM_HZ) - 1U;
+  LCD_BL_TIM->ARR = 100U - 1U;   /* 100 , ȽֵΪٷֱ */
+  LCD_BL_TIM->CCR2 = 0;
+  LCD_BL_TIM->CCMR1 = (6U << TIM_CCMR1_OC2M_Pos) | TIM_CCMR1_OC2PE; /* PWM1 */
+  LCD_BL_TIM->CCER = TIM_CCER_CC2E;
+  LCD_BL_TIM->EGR = TIM_EGR_UG;
+  LCD_BL_TIM->CR1 = TIM_CR1_ARPE | TIM_CR1_CEN;
+
+  LCD_BL_GPIO_CLK_ENABLE();
+  gpio_init_struct.Pin = LCD_BL_GPIO_PIN;
+  gpio_init_struct.Mode = GPIO_MODE_AF_PP;
+  gpio_init_struct.Pull = GPIO_NOPULL;
+  gpio_init_struct.Speed = GPIO_SPEED_FREQ_LOW;
+  gpio_init_struct.Alternate = LCD_BL_GPIO_AF;
+  HAL_GPIO_Init(LCD_BL_GPIO_PORT, &gpio_init_struct);
+}
+
+/**
+ * @brief       
+ *   @note      SSD1963 ɿ PWM, ͺ TIM12_CH2  PB15;
+ *              100 ʱȽֵڼ, Ϊߵƽ
+ * @param       percent:  0~100, 0 رձ
+ * @retval      
+ */
+void lcd_backlight_set(uint8_t percent) {
+  if (percent > 100) {
+    percent = 100;
+  }
+  g_lcd_backlight = percent;
+  Energy_SetLevel(ENERGY_RAIL_BACKLIGHT, percent * 10U);
+
+  if (LCD_ID_IS(0x1963)) {
+    lcd_ssd_backlight_set(percent);
+  } else {
+    LCD_BL_TIM->CCR2 = percent;
+  }
+}
+
+/**
+ * @brief       ȡǰ
+ * @param       
+ * @retval       0~100
+ */
+uint8_t lcd_backlight_get(void) { return g_lcd_backlight; }
+
 /**
  * @brief       LCDʾ
  * @param       dir:0,; 1,
@@ -427,13 +546,13 @@ void lcd_display_dir(uint8_t dir) {
     lcddev.width = 240;
     lcddev.height = 320;
 
-    if (lcddev.id == 0x5510) {
+    if (LCD_ID_IS(0x5510)) {
       lcddev.wramcmd = 0x2C00;
       lcddev.setxcmd = 0x2A00;
       lcddev.setycmd = 0x2B00;
       lcddev.width = 480;
       lcddev.height = 800;
-    } else if (lcddev.id == 0x1963) {
+    } else if (LCD_ID_IS(0x1963)) {
       lcddev.wramcmd = 0x2C; /* дGRAMָ */
       lcddev.setxcmd = 0x2B; /* дXָ */
       lcddev.setycmd = 0x2A; /* дYָ */
@@ -446,14 +565,14 @@ void lcd_display_dir(uint8_t dir) {
       lcddev.setycmd = 0x2B;
     }
 
-    if (lcddev.id == 0x5310 ||
-        lcddev.id == 0x7796) /* 5310/7796 ʾ 320*480ֱ */
+    if (LCD_ID_IS(0x5310) ||
+        LCD_ID_IS(0x7796)) /* 5310/7796 ʾ 320*480ֱ */
     {
       lcddev.width = 320;
       lcddev.height = 480;
     }
 
-    if (lcddev.id == 0X9806) /* 9806 ʾ 480*800 ֱ */
+    if (LCD_ID_IS(0x9806)) /* 9806 ʾ 480*800 ֱ */
     {
       lcddev.width = 480;
       lcddev.height = 800;
@@ -463,13 +582,13 @@ void lcd_display_dir(uint8_t dir) {
     lcddev.width = 320;  /* ĬϿ */
     lcddev.height = 240; /* Ĭϸ߶ */
 
-    if (lcddev.id == 0x5510) {
+    if (LCD_ID_IS(0x5510)) {
       lcddev.wramcmd = 0x2C00;
       lcddev.setxcmd = 0x2A00;
       lcddev.setycmd = 0x2B00;
       lcddev.width = 800;
       lcddev.height = 480;
-    } else if (lcddev.id == 0x1963 || lcddev.id == 0x9806) {
+    } else if (LCD_ID_IS(0x1963) || LCD_ID_IS(0x9806)) {
       lcddev.wramcmd = 0x2C; /* дGRAMָ */
       lcddev.setxcmd = 0x2A; /* дXָ */
       lcddev.setycmd = 0x2B; /* дYָ */
@@ -482,8 +601,8 @@ void lcd_display_dir(uint8_t dir) {
       lcddev.setycmd = 0x2B;
     }
 
-    if (lcddev.id == 0x5310 ||
-        lcddev.id == 0x7796) /* 5310/7796 ʾ 320*480ֱ */
+    if (LCD_ID_IS(0x5310) ||
+        LCD_ID_IS(0x7796)) /* 5310/7796 ʾ 320*480ֱ */
     {
       lcddev.width = 480;
       lcddev.height = 320;
@@ -506,45 +625,45 @@ void lcd_set_window(uint16_t sx, uint16_t sy, uint16_t width, uint16_t height) {
   twidth = sx + width - 1;
   theight = sy + height - 1;
 
-  if (lcddev.id == 0x1963 && lcddev.dir != 1) /* 1963⴦ */
+  if (LCD_ID_IS(0x1963) && lcddev.dir != 1) /* 1963⴦ */
   {
     sx = lcddev.width - width - sx;
     height = sy + height - 1;
-    lcd_wr_regno(lcddev.setxcmd);
+    lcd_wr_regno(LCD_CMD_SETX);
     lcd_wr_data(sx >> 8);
     lcd_wr_data(sx & 0xFF);
     lcd_wr_data((sx + width - 1) >> 8);
     lcd_wr_data((sx + width - 1) & 0xFF);
-    lcd_wr_regno(lcddev.setycmd);
+    lcd_wr_regno(LCD_CMD_SETY);
     lcd_wr_data(sy >> 8);
     lcd_wr_data(sy & 0xFF);
     lcd_wr_data(height >> 8);
     lcd_wr_data(height & 0xFF);
-  } else if (lcddev.id == 0x5510) {
-    lcd_wr_regno(lcddev.setxcmd);
+  } else if (LCD_ID_IS(0x5510)) {
+    lcd_wr_regno(LCD_CMD_SETX);
     lcd_wr_data(sx >> 8);
-    lcd_wr_regno(lcddev.setxcmd + 1);
+    lcd_wr_regno(LCD_CMD_SETX + 1);
     lcd_wr_data(sx & 0xFF);
-    lcd_wr_regno(lcddev.setxcmd + 2);
+    lcd_wr_regno(LCD_CMD_SETX + 2);
     lcd_wr_data(twidth >> 8);
-    lcd_wr_regno(lcddev.setxcmd + 3);
+    lcd_wr_regno(LCD_CMD_SETX + 3);
     lcd_wr_data(twidth & 0xFF);
-    lcd_wr_regno(lcddev.setycmd);
+    lcd_wr_regno(LCD_CMD_SETY);
     lcd_wr_data(sy >> 8);
-    lcd_wr_regno(lcddev.setycmd + 1);
+    lcd_wr_regno(LCD_CMD_SETY + 1);
     lcd_wr_data(sy & 0xFF);
-    lcd_wr_regno(lcddev.setycmd + 2);
+    lcd_wr_regno(LCD_CMD_SETY + 2);
     lcd_wr_data(theight >> 8);
-    lcd_wr_regno(lcddev.setycmd + 3);
+    lcd_wr_regno(LCD_CMD_SETY + 3);
     lcd_wr_data(theight & 0xFF);
   } else /* 9341/5310/7789/1963/7796/9806  ô */
   {
-    lcd_wr_regno(lcddev.setxcmd);
+    lcd_wr_regno(LCD_CMD_SETX);
     lcd_wr_data(sx >> 8);
     lcd_wr_data(sx & 0xFF);
     lcd_wr_data(twidth >> 8);
     lcd_wr_data(twidth & 0xFF);
-    lcd_wr_regno(lcddev.setycmd);
+    lcd_wr_regno(LCD_CMD_SETY);
     lcd_wr_data(sy >> 8);
     lcd_wr_data(sy & 0xFF);
     lcd_wr_data(theight >> 8);
@@ -587,6 +706,118 @@ void lcd_set_window(uint16_t sx, uint16_t sy, uint16_t width, uint16_t height) {
 //    HAL_GPIO_Init(GPIOE, &gpio_init_struct);
 //}
 
+/*  FSMC дʱ(λ: HCLK , 168MHz Լ 6ns)
+ * ADDSET/DATAST ȡʵȶֵ, ûеͺű MX_FSMC_Init() ıʱ */
+typedef struct {
+  uint16_t id;     /* LCD ID */
+  uint8_t addset;  /* ַʱ */
+  uint8_t datast;  /* ݽʱ */
+} lcd_fsmc_timing_t;
+
+static const lcd_fsmc_timing_t g_lcd_fsmc_timing_tab[] = {
+    {0x7789, 3, 3}, {0x9341, 3, 3}, {0x1963, 3, 3}, {0x5310, 5, 5},
+    {0x7796, 5, 5}, {0x5510, 5, 5}, {0x9806, 5, 5},
+};
+
+static uint8_t g_lcd_addset = 9; /* ǰдʱ,  MX_FSMC_Init() һ */
+static uint8_t g_lcd_datast = 9;
+
+/**
+ * @brief        lcddev.id  FSMC дʱ
+ * @param       
+ * @retval      
+ */
+static void lcd_fsmc_timing_apply(void) {
+  uint8_t i;
+
+  for (i = 0; i < sizeof(g_lcd_fsmc_timing_tab) / sizeof(g_lcd_fsmc_timing_tab[0]); i++) {
+    if (g_lcd_fsmc_timing_tab[i].id == lcddev.id) {
+      g_lcd_addset = g_lcd_fsmc_timing_tab[i].addset;
+      g_lcd_datast = g_lcd_fsmc_timing_tab[i].datast;
+      FSMC_Bank4_Write_Timing_Set(g_lcd_addset, g_lcd_datast);
+      return;
+    }
+  }
+}
+
+#if LCD_FSMC_WRITE_CFG
+/**
+ * @brief        Bank4 дͨ·
+ *   @note      EXTMOD λдʹ BWTR4 ʱ( BTR4 ʱ),
+ *              BUSTURN ʹд֮䲻뷭תȴ; F407 д FIFO 
+ *              ʹ, ֻ F42x/F43x  BCR1  WFDIS λ
+ * @param       
+ * @retval      
+ */
+static void lcd_fsmc_write_cfg(void) {
+  hsram4.Init.ExtendedMode = FSMC_EXTENDED_MODE_ENABLE; /* ֮дʱʱд BWTR4 */
+  LCD_FSMC_BCRX |= FSMC_BCR4_EXTMOD;
+  LCD_FSMC_BWTRX &= ~FSMC_BWTR4_BUSTURN;
+#ifdef FMC_BCR1_WFDIS
+  FSMC_Bank1->BTCR[0] &= ~FMC_BCR1_WFDIS;
+#endif
+}
+#endif
+
+#if LCD_FSMC_AUTOTUNE
+/**
+ * @brief       дͼУ
+ *   @note      ʱ̶Ϊ MX_FSMC_Init() , ˶ʧ˵дʱ
+ * @param       
+ * @retval      1: Уͨ; 0: ʧ
+ */
+static uint8_t lcd_fsmc_pattern_test(void) {
+  static const uint16_t pattern[] = {RED,  GREEN,  BLUE,   WHITE,
+                                     BLACK, 0xA5A5, 0x5A5A, 0x1234};
+  uint8_t i;
+
+  for (i = 0; i < sizeof(pattern) / sizeof(pattern[0]); i++) {
+    lcd_draw_point(i, 0, pattern[i]);
+  }
+
+  for (i = 0; i < sizeof(pattern) / sizeof(pattern[0]); i++) {
+    if ((uint16_t)lcd_read_point(i, 0) != pattern[i]) {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/**
+ * @brief       ڲʱսдʱ, ֱУʧ
+ *   @note      ʱһͨĻϸſ 1 Ϊ,
+ *              ùֻ lcd_init() ִһ, Ҫ lcddev 
+ * @param       
+ * @retval      
+ */
+static void lcd_fsmc_timing_autotune(void) {
+  uint8_t addset = g_lcd_addset;
+  uint8_t datast = g_lcd_datast;
+
+  if (!lcd_fsmc_pattern_test()) {
+    return; /* ʱ¾Уʧ(ֶ֧ܲ GRAM),  */
+  }
+
+  while (datast > 1) {
+    uint8_t next_addset = (addset > 0) ? addset - 1 : 0;
+    uint8_t next_datast = datast - 1;
+
+    FSMC_Bank4_Write_Timing_Set(next_addset, next_datast);
+    if (!lcd_fsmc_pattern_test()) {
+      break;
+    }
+    addset = next_addset;
+    datast = next_datast;
+  }
+
+  /*  1 , ҲȲֵ */
+  g_lcd_addset = (addset + 1 < g_lcd_addset) ? addset + 1 : g_lcd_addset;
+  g_lcd_datast = (datast + 1 < g_lcd_datast) ? datast + 1 : g_lcd_datast;
+  FSMC_Bank4_Write_Timing_Set(g_lcd_addset, g_lcd_datast);
+}
+#endif
+
 /**
  * @brief       ʼLCD
  *   @note      óʼԳʼͺŵLCD(.cļǰ)
@@ -679,6 +910,7 @@ void lcd_init(void) {
   //    HAL_SRAM_Init(&g_sram_handle, &fsmc_read_handle, &fsmc_write_handle);
   delay_ms(50);
 
+#if LCD_PANEL == LCD_PANEL_AUTO
   /* 9341 IDĶȡ */
   lcd_wr_regno(0xD3);
   lcddev.id = lcd_rd_data(); /* dummy read */
@@ -764,6 +996,9 @@ void lcd_init(void) {
       }
     }
   }
+#else
+  lcddev.id = LCD_PANEL; /* ʱָͺ, ̽ */
+#endif
 
   /* رע, mainδ1ʼ, Ῠprintf
    * (f_putc), , ʼ1, ε
@@ -771,76 +1006,133 @@ void lcd_init(void) {
    */
   // printf("LCD ID:%x\r\n", lcddev.id); /* ӡLCD ID */
 
-  if (lcddev.id == 0x7789) {
+  /* δĳʼв֧ ( LCD_PANEL) */
+#if LCD_PANEL_HAS(LCD_PANEL_ST7789)
+  if (LCD_ID_IS(0x7789)) {
     lcd_ex_st7789_reginit(); /* ִST7789ʼ */
-  } else if (lcddev.id == 0x9341) {
+  }
+#endif
+#if LCD_PANEL_HAS(LCD_PANEL_ILI9341)
+  if (LCD_ID_IS(0x9341)) {
     lcd_ex_ili9341_reginit(); /* ִILI9341ʼ */
-  } else if (lcddev.id == 0x5310) {
+  }
+#endif
+#if LCD_PANEL_HAS(LCD_PANEL_NT35310)
+  if (LCD_ID_IS(0x5310)) {
     lcd_ex_nt35310_reginit(); /* ִNT35310ʼ */
-  } else if (lcddev.id == 0x7796) {
+  }
+#endif
+#if LCD_PANEL_HAS(LCD_PANEL_ST7796)
+  if (LCD_ID_IS(0x7796)) {
     lcd_ex_st7796_reginit(); /* ִST7796ʼ */
-  } else if (lcddev.id == 0x5510) {
+  }
+#endif
+#if LCD_PANEL_HAS(LCD_PANEL_NT35510)
+  if (LCD_ID_IS(0x5510)) {
     lcd_ex_nt35510_reginit(); /* ִNT35510ʼ */
-  } else if (lcddev.id == 0x9806) {
+  }
+#endif
+#if LCD_PANEL_HAS(LCD_PANEL_ILI9806)
+  if (LCD_ID_IS(0x9806)) {
     lcd_ex_ili9806_reginit(); /* ִILI9806ʼ */
-  } else if (lcddev.id == 0x1963) {
+  }
+#endif
+#if LCD_PANEL_HAS(LCD_PANEL_SSD1963)
+  if (LCD_ID_IS(0x1963)) {
     lcd_ex_ssd1963_reginit();   /* ִSSD1963ʼ */
     lcd_ssd_backlight_set(100); /* Ϊ */
   }
+#endif
 
-  /* ʼԺ, */
-  if (lcddev.id == 0x7789 || lcddev.id == 0x9341 ||
-      lcddev.id == 0x1963) /* 7789/9341/1963  */
-  {
-    // /* дʱƼĴʱ */
-    // fsmc_write_handle.AddressSetupTime = 3; /*
-    // ַʱ(ADDSET)Ϊ3fsmc_ker_ck=6*3=18ns */
-    // fsmc_write_handle.DataSetupTime = 3;    /*
-    // ݱʱ(DATAST)Ϊ3fsmc_ker_ck=6*3=18ns */
-    // FSMC_NORSRAM_Extended_Timing_Init(g_sram_handle.Extended,
-    // &fsmc_write_handle, g_sram_handle.Init.NSBank,
-    // g_sram_handle.Init.ExtendedMode);
-
-    // [MODIFIED] fsmc.cṩı׼ӿڽ
-    FSMC_Bank4_Write_Timing_Set(3, 3);
-  } else if (lcddev.id == 0x5310 || lcddev.id == 0x7796 ||
-             lcddev.id == 0x5510 ||
-             lcddev.id == 0x9806) /* ⼸IC, WRʱΪ */
-  {
-    // /* дʱƼĴʱ */
-    // fsmc_write_handle.AddressSetupTime = 2; /*
-    // ַʱ(ADDSET)Ϊ2fsmc_ker_ck=6*2=12ns */
-    // fsmc_write_handle.DataSetupTime = 2;    /*
-    // ݱʱ(DATAST)Ϊ2fsmc_ker_ck=6*2=12ns */
-    // FSMC_NORSRAM_Extended_Timing_Init(g_sram_handle.Extended,
-    // &fsmc_write_handle, g_sram_handle.Init.NSBank,
-    // g_sram_handle.Init.ExtendedMode);
-
-    // [MODIFIED] fsmc.cṩı׼ӿڽ
-    FSMC_Bank4_Write_Timing_Set(5, 5);
-  }
+  /* ʼԺ,ͺŲ */
+#if LCD_FSMC_WRITE_CFG
+  lcd_fsmc_write_cfg();
+#endif
+  lcd_fsmc_timing_apply();
 
   lcd_display_dir(0); /* ĬΪ */
-  LCD_BL(1);          /*  */
+
+#if LCD_FSMC_AUTOTUNE
+  lcd_fsmc_timing_autotune(); /* У, һսдʱ */
+#endif
+
+  if (LCD_ID_IS(0x1963)) {
+    LCD_BL(1);          /*  SSD1963  PWM  */
+  } else {
+    lcd_backlight_pwm_init();
+  }
+  lcd_backlight_set(100); /*  */
   lcd_clear(WHITE);
 }
 
+/**
+ * @brief       д n ͬɫ(ôڲ lcd_write_ram_prepare)
+ *   @note      CPU · 8 չ, ѭ; DMA ·Դַ
+ * @param       color: ɫ
+ * @param       n: ظ
+ * @retval      
+ */
+static void lcd_stream_color(uint16_t color, uint32_t n) {
+#if LCD_FILL_USE_DMA
+  static uint16_t s_color;
+  s_color = color;
+  lcd_dma_stream((uint32_t)&s_color, n, DMA_PINC_DISABLE);
+#else
+  lcd_stream_fill(color, n);
+#endif
+}
+
+/**
+ * @brief       д n (ôڲ lcd_write_ram_prepare)
+ * @param       color: ɫ
+ * @param       n: ظ
+ * @retval      
+ */
+static void lcd_stream_buf(const uint16_t *color, uint32_t n) {
+#if LCD_FILL_USE_DMA
+  lcd_dma_stream((uint32_t)color, n, DMA_PINC_ENABLE);
+#else
+  lcd_stream_pixels(color, n);
+#endif
+}
+
+/**
+ * @brief       ڷʽɫ: ֻһδ, Ȼд
+ * @param       sx,sy: ʼ
+ * @param       width,height: , 0
+ * @param       color: ɫ
+ * @retval      
+ */
+void lcd_fill_window(uint16_t sx, uint16_t sy, uint16_t width, uint16_t height,
+                     uint16_t color) {
+  lcd_set_window(sx, sy, width, height);
+  lcd_write_ram_prepare();
+  lcd_stream_color(color, (uint32_t)width * height);
+  lcd_set_window(0, 0, lcddev.width, lcddev.height); /* ָȫ, Ⱥֻ */
+}
+
+/**
+ * @brief       ڷʽдɫ: ֻһδ, Ȼд
+ * @param       sx,sy: ʼ
+ * @param       width,height: , 0
+ * @param       color: ɫ׵ַ()
+ * @retval      
+ */
+void lcd_write_window(uint16_t sx, uint16_t sy, uint16_t width,
+                      uint16_t height, const uint16_t *color) {
+  lcd_set_window(sx, sy, width, height);
+  lcd_write_ram_prepare();
+  lcd_stream_buf(color, (uint32_t)width * height);
+  lcd_set_window(0, 0, lcddev.width, lcddev.height); /* ָȫ */
+}
+
 /**
  * @brief       
  * @param       color: Ҫɫ
  * @retval      
  */
 void lcd_clear(uint16_t color) {
-  uint32_t index = 0;
-  uint32_t totalpoint = lcddev.width;
-
-  totalpoint *= lcddev.height;  /* õܵ */
-  lcd_set_cursor(0x00, 0x0000); /* ùλ */
-  lcd_write_ram_prepare();      /* ʼдGRAM */
-
-  for (index = 0; index < totalpoint; index++) {
-    LCD->LCD_RAM = color;
-  }
+  lcd_fill_window(0, 0, lcddev.width, lcddev.height, color);
 }
 
 /**
@@ -852,18 +1144,7 @@ void lcd_clear(uint16_t color) {
  */
 void lcd_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey,
               uint32_t color) {
-  uint16_t i, j;
-  uint16_t xlen = 0;
-  xlen = ex - sx + 1;
-
-  for (i = sy; i <= ey; i++) {
-    lcd_set_cursor(sx, i);   /* ùλ */
-    lcd_write_ram_prepare(); /* ʼдGRAM */
-
-    for (j = 0; j < xlen; j++) {
-      LCD->LCD_RAM = color; /* ʾɫ */
-    }
-  }
+  lcd_fill_window(sx, sy, ex - sx + 1, ey - sy + 1, (uint16_t)color);
 }
 
 /**
@@ -875,20 +1156,7 @@ void lcd_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey,
  */
 void lcd_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey,
                     uint16_t *color) {
-  uint16_t height, width;
-  uint16_t i, j;
-
-  width = ex - sx + 1;  /* õĿ */
-  height = ey - sy + 1; /* ߶ */
-
-  for (i = 0; i < height; i++) {
-    lcd_set_cursor(sx, sy + i); /* ùλ */
-    lcd_write_ram_prepare();    /* ʼдGRAM */
-
-    for (j = 0; j < width; j++) {
-      LCD->LCD_RAM = color[i * width + j]; /* д */
-    }
-  }
+  lcd_write_window(sx, sy, ex - sx + 1, ey - sy + 1, color);
 }
 
 /**
@@ -1251,3 +1519,72 @@ void lcd_show_string(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
     p++;
   }
 }
+
+/**
+ * @brief       ʾ(ڷʽ, 㻭)
+ *   @note       [0, lcddev.width) x [y, y + size) ֻһδ, ɨ
+ *              ˳дǰɫ/ɫ, ֮Ĳ䱳ɫ,
+ *              ͬʱ˸ԭе;  ASCII ɴӡַʾΪ '?'
+ * @param       y           : еʼ
+ * @param       size        : ѡ 12/16/24/32
+ * @param       p           : ַ׵ַ
+ * @param       color       : ɫ
+ * @param       bg          : ɫ
+ * @retval      
+ */
+void lcd_show_line(uint16_t y, uint8_t size, const char *p, uint16_t color,
+                   uint16_t bg) {
+  uint8_t chr[LCD_LINE_MAX_CHARS];               /* ֿ± */
+  uint8_t cw = size / 2;                          /* ַ */
+  uint8_t bpc = size / 8 + ((size % 8) ? 1 : 0);  /* ÿֽ */
+  uint16_t csize = (uint16_t)bpc * cw;            /* ÿַֽ */
+  const uint8_t *font;
+  uint16_t cols, n = 0, tail;
+  uint8_t row, c, px;
+
+  switch (size) {
+  case 12:
+    font = asc2_1206[0];
+    break;
+  case 16:
+    font = asc2_1608[0];
+    break;
+  case 24:
+    font = asc2_2412[0];
+    break;
+  case 32:
+    font = asc2_3216[0];
+    break;
+  default:
+    return;
+  }
+  if (y + size > lcddev.height) {
+    return;
+  }
+
+  cols = lcddev.width / cw;
+  if (cols > LCD_LINE_MAX_CHARS) {
+    cols = LCD_LINE_MAX_CHARS;
+  }
+  for (; n < cols && *p != '\0'; n++, p++) {
+    chr[n] = ((uint8_t)*p >= ' ' && (uint8_t)*p <= '~') ? *p - ' ' : '?' - ' ';
+  }
+  tail = lcddev.width - n * cw;
+
+  lcd_set_window(0, y, lcddev.width, size);
+  lcd_write_ram_prepare();
+  for (row = 0; row < size; row++) {
+    uint8_t offset = row / 8;
+    uint8_t mask = 0x80 >> (row % 8);
+
+    for (c = 0; c < n; c++) {
+      const uint8_t *col = font + chr[c] * csize + offset;
+
+      for (px = 0; px < cw; px++, col += bpc) {
+        LCD->LCD_RAM = (*col & mask) ? color : bg;
+      }
+    }
+    lcd_stream_fill(bg, tail);
+  }
+  lcd_set_window(0, 0, lcddev.width, lcddev.height); /* ָȫ */
+}
@@ -44,6 +44,16 @@
     __HAL_RCC_GPIOB_CLK_ENABLE();                                              \
   } while (0) /* IOʱʹ */
 
+/*  PWM: PB15 Ϊ TIM12_CH2 (AF9), ռձ 0~100 ֱдȽϼĴ,
+ * ƵȡΧ, ⱳѹ·Х (SSD1963 ʹÿԴ PWM) */
+#define LCD_BL_TIM TIM12
+#define LCD_BL_TIM_CLK_ENABLE()                                                \
+  do {                                                                         \
+    __HAL_RCC_TIM12_CLK_ENABLE();                                              \
+  } while (0)
+#define LCD_BL_GPIO_AF GPIO_AF9_TIM12
+#define LCD_BL_PWM_HZ 20000
+
 // // /* LCD_CS(ҪLCD_FSMC_NEXȷIO) 
 // LCD_RS(ҪLCD_FSMC_AXȷIO)   */ #define
 // LCD_CS_GPIO_PORT                GPIOG #define LCD_CS_GPIO_PIN GPIO_PIN_12
@@ -137,6 +147,68 @@ typedef struct {
              (((1 << LCD_FSMC_AX) * 2) - 2))
 #define LCD ((LCD_TypeDef *)LCD_BASE)
 
+/* LCD_RAM  32 λ: FSMC  16 λݿȲд, ȵͰֺ
+ * ߰, ڶεַ +2 ֻı FSMC_A0, Ӱ RS  FSMC_Ax(x >= 1),
+ * ֶд GRAM; ֻռһ AHB , д FIFO пɶ໺һ */
+#if LCD_FSMC_AX == 0
+#error "LCD_RS  FSMC_A0 ʱ 32 λдĵڶֻдĴ, ʹ"
+#endif
+#define LCD_RAM32 (*(volatile uint32_t *)&LCD->LCD_RAM)
+
+/* 1: lcd_init() ǿ Bank4 չģʽ(дʹ BWTR4 Ŀʱ)ȥд
+ * ֮߷תȴ; 0: ȫʹ MX_FSMC_Init()  */
+#define LCD_FSMC_WRITE_CFG 1
+
+/* (lcd_fill/lcd_color_fill/lcd_clear)д뷽ʽ:
+ * 0: CPU չѭд; 1: DMA2 洢洢(ѯʽ) */
+#define LCD_FILL_USE_DMA 0
+#define LCD_FILL_DMA_STREAM DMA2_Stream3 /* Stream1/2 ѱ LVGL ˢºͻͼռ */
+
+/* 1: lcd_init() ͨд/زͼԶս FSMC дʱ; 0: ֻʹòֵ */
+#define LCD_FSMC_AUTOTUNE 0
+
+/* ͺ(ȡֵ lcddev.id) */
+#define LCD_PANEL_AUTO 0         /* ʱ ID ʶ */
+#define LCD_PANEL_ILI9341 0x9341
+#define LCD_PANEL_ST7789 0x7789
+#define LCD_PANEL_NT35310 0x5310
+#define LCD_PANEL_ST7796 0x7796
+#define LCD_PANEL_NT35510 0x5510
+#define LCD_PANEL_ILI9806 0x9806
+#define LCD_PANEL_SSD1963 0x1963
+
+/* ʱѡ: LCD_PANEL_AUTO  ID ̽ȫʼ;
+ * ָͺʱ lcd_init() ̽, lcd_ex.c ֻͺŵĳʼ,
+ * LCD_ID_IS() Ϊ, //ɨ跽еͺŷ֧ڱʱȥ,
+ * ҲΪ (SSD1963  X/Y , Զ lcddev) */
+#ifndef LCD_PANEL
+#define LCD_PANEL LCD_PANEL_AUTO
+#endif
+
+#if LCD_PANEL == LCD_PANEL_AUTO
+#define LCD_ID_IS(x) (lcddev.id == (x))
+#else
+#define LCD_ID_IS(x) (LCD_PANEL == (x))
+#endif
+
+/* ͺŵĴǷ */
+#define LCD_PANEL_HAS(x) (LCD_PANEL == LCD_PANEL_AUTO || LCD_PANEL == (x))
+
+/* д GRAM /  */
+#if LCD_PANEL == LCD_PANEL_AUTO || LCD_PANEL == LCD_PANEL_SSD1963
+#define LCD_CMD_WRAM lcddev.wramcmd
+#define LCD_CMD_SETX lcddev.setxcmd
+#define LCD_CMD_SETY lcddev.setycmd
+#elif LCD_PANEL == LCD_PANEL_NT35510
+#define LCD_CMD_WRAM 0x2C00
+#define LCD_CMD_SETX 0x2A00
+#define LCD_CMD_SETY 0x2B00
+#else
+#define LCD_CMD_WRAM 0x2C
+#define LCD_CMD_SETX 0x2A
+#define LCD_CMD_SETY 0x2B
+#endif
+
 /******************************************************************************************/
 /* LCDɨ跽ɫ  */
 
@@ -153,6 +225,8 @@ typedef struct {
 
 #define DFT_SCAN_DIR L2R_U2D /* Ĭϵɨ跽 */
 
+#define LCD_LINE_MAX_CHARS 133 /* lcd_show_line һַ(800  / 6) */
+
 /* ûɫ */
 #define WHITE 0xFFFF   /* ɫ */
 #define BLACK 0x0000   /* ɫ */
@@ -200,7 +274,7 @@ typedef struct {
 /******************************************************************************************/
 /*  */
 
-void lcd_wr_data(volatile uint16_t data);          /* LCDд */
+void lcd_wr_data(volatile uint16_t data);          /* LCDд(,  lcd_stream_pixels) */
 void lcd_wr_regno(volatile uint16_t regno);        /* LCDдĴ/ַ */
 void lcd_write_reg(uint16_t regno, uint16_t data); /* LCDдĴֵ */
 
@@ -210,6 +284,8 @@ void lcd_display_off(void);              /* 
 void lcd_scan_dir(uint8_t dir);          /* ɨ跽 */
 void lcd_display_dir(uint8_t dir);       /* Ļʾ */
 void lcd_ssd_backlight_set(uint8_t pwm); /* SSD1963  */
+void lcd_backlight_set(uint8_t percent); /*  0~100 (0 ر) */
+uint8_t lcd_backlight_get(void);         /* ǰ */
 
 void lcd_write_ram_prepare(void);                /* ׼ЩGRAM */
 void lcd_set_cursor(uint16_t x, uint16_t y);     /* ù */
@@ -228,6 +304,11 @@ void lcd_set_window(uint16_t sx, uint16_t sy, uint16_t width,
                     uint16_t height); /* ô */
 void lcd_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey,
               uint32_t color); /* ɫ(32λɫ,LTDC) */
+void lcd_fill_window(uint16_t sx, uint16_t sy, uint16_t width, uint16_t height,
+                     uint16_t color); /* ڷʽɫ(ֻһδ) */
+void lcd_write_window(uint16_t sx, uint16_t sy, uint16_t width,
+                      uint16_t height,
+                      const uint16_t *color); /* ڷʽдɫ */
 void lcd_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey,
                     uint16_t *color); /* ɫ */
 void lcd_draw_line(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2,
@@ -243,5 +324,79 @@ void lcd_show_xnum(uint16_t x, uint16_t y, uint32_t num, uint8_t len,
                    uint8_t size, uint8_t mode, uint16_t color);
 void lcd_show_string(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
                      uint8_t size, char *p, uint16_t color);
+void lcd_show_line(uint16_t y, uint8_t size, const char *p, uint16_t color,
+                   uint16_t bg); /* ʾ, ಿ䱳ɫ */
+
+/******************************************************************************************/
+/* (ôڲ lcd_write_ram_prepare), ˢ/ѭ */
+
+/**
+ * @brief       д n 
+ *   @note      ÿ 32 λд, ѭչ 8 (16 ); ɫ
+ *              ֶֻʱȵдһ
+ * @param       color: ɫ
+ * @param       n: ظ
+ * @retval      
+ */
+static inline void lcd_stream_pixels(const uint16_t *color, uint32_t n) {
+  const uint32_t *src;
+
+  if (n == 0) {
+    return;
+  }
+  if ((uint32_t)color & 2U) {
+    LCD->LCD_RAM = *color++;
+    n--;
+  }
+  src = (const uint32_t *)color;
+  while (n >= 16) {
+    LCD_RAM32 = src[0];
+    LCD_RAM32 = src[1];
+    LCD_RAM32 = src[2];
+    LCD_RAM32 = src[3];
+    LCD_RAM32 = src[4];
+    LCD_RAM32 = src[5];
+    LCD_RAM32 = src[6];
+    LCD_RAM32 = src[7];
+    src += 8;
+    n -= 16;
+  }
+  while (n >= 2) {
+    LCD_RAM32 = *src++;
+    n -= 2;
+  }
+  if (n) {
+    LCD->LCD_RAM = *(const uint16_t *)src;
+  }
+}
+
+/**
+ * @brief       д n ͬɫ
+ * @param       color: ɫ
+ * @param       n: ظ
+ * @retval      
+ */
+static inline void lcd_stream_fill(uint16_t color, uint32_t n) {
+  uint32_t word = (uint32_t)color * 0x00010001U;
+
+  while (n >= 16) {
+    LCD_RAM32 = word;
+    LCD_RAM32 = word;
+    LCD_RAM32 = word;
+    LCD_RAM32 = word;
+    LCD_RAM32 = word;
+    LCD_RAM32 = word;
+    LCD_RAM32 = word;
+    LCD_RAM32 = word;
+    n -= 16;
+  }
+  while (n >= 2) {
+    LCD_RAM32 = word;
+    n -= 2;
+  }
+  if (n) {
+    LCD->LCD_RAM = color;
+  }
+}
 
 #endif
@@ -30,7 +30,9 @@
 #include "main.h"
 #include "mydelay.h"
 
+/* ÿͺŵĳʼֻ LCD_PANEL ΪͺŻ LCD_PANEL_AUTO ʱ */
 
+#if LCD_PANEL_HAS(LCD_PANEL_ST7789)
 /**
  * @brief       ST7789 Ĵʼ
  * @param       
@@ -125,7 +127,9 @@ void lcd_ex_st7789_reginit(void) {
 
   lcd_wr_regno(0x29); /* display on */
 }
+#endif
 
+#if LCD_PANEL_HAS(LCD_PANEL_ILI9341)
 /**
  * @brief       ILI9341Ĵʼ
  * @param       
@@ -225,7 +229,9 @@ void lcd_ex_ili9341_reginit(void) {
   delay_ms(120);
   lcd_wr_regno(0x29); /* display on */
 }
+#endif
 
+#if LCD_PANEL_HAS(LCD_PANEL_NT35310)
 /**
  * @brief       NT35310Ĵʼ
  * @param       
@@ -910,7 +916,9 @@ void lcd_ex_nt35310_reginit(void) {
   lcd_wr_data(0x82);
   lcd_wr_regno(0x2c);
 }
+#endif
 
+#if LCD_PANEL_HAS(LCD_PANEL_ST7796)
 /**
  * @brief       ST7796Ĵʼ
  * @param       
@@ -1013,7 +1021,9 @@ void lcd_ex_st7796_reginit(void) {
   lcd_wr_regno(0x21);
   lcd_wr_regno(0x29);
 }
+#endif
 
+#if LCD_PANEL_HAS(LCD_PANEL_NT35510)
 /**
  * @brief       NT35510Ĵʼ
  * @param       
@@ -1431,7 +1441,9 @@ void lcd_ex_nt35510_reginit(void) {
   delay_us(120);
   lcd_wr_regno(0x2900);
 }
+#endif
 
+#if LCD_PANEL_HAS(LCD_PANEL_ILI9806)
 /**
  * @brief       ILI9806Ĵʼ
  * @param       
@@ -1599,7 +1611,9 @@ void lcd_ex_ili9806_reginit(void) {
   delay_ms(20);
   lcd_wr_regno(0x2C);
 }
+#endif
 
+#if LCD_PANEL_HAS(LCD_PANEL_SSD1963)
 /**
  * @brief       SSD1963Ĵʼ
  * @param       
@@ -1676,3 +1690,4 @@ void lcd_ex_ssd1963_reginit(void) {
   lcd_wr_regno(0xBA);
   lcd_wr_data(0x01); /* GPIO[1:0]=01,LCD */
 }
+#endif
@@ -0,0 +1,308 @@
+/**
+ ******************************************************************************
+ * @file    lcd_orient.c
+ * @brief   屏幕方向服务源文件
+ * @details 横屏基准由 lcd_display_dir(1) + lcd_scan_dir(L2R_U2D) 决定:
+ *          多数控制器的 GRAM 为竖屏排列，基准为 MY|MV；SSD1963 的帧缓冲为
+ *          横屏排列，基准为 0。其余三个方向相对基准做行列交换/镜像，两张表
+ *          分别列出，切换时直接写入，不经过 lcd_scan_dir 的方向换算。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "lcd_orient.h"
+
+/* MADCTL 位: MY(行地址反向) MX(列地址反向) MV(行列交换) */
+#define LCD_MADCTL_MY 0x80
+#define LCD_MADCTL_MX 0x40
+#define LCD_MADCTL_MV 0x20
+#define LCD_MADCTL_BGR 0x08
+
+/* GRAM 竖屏排列的控制器 (9341/5310/5510/7789/7796/9806) */
+static const uint8_t s_madctl_portrait_gram[LCD_ROT_COUNT] = {
+    LCD_MADCTL_MY | LCD_MADCTL_MV, /* 0 */
+    0,                             /* 90 */
+    LCD_MADCTL_MX | LCD_MADCTL_MV, /* 180 */
+    LCD_MADCTL_MY | LCD_MADCTL_MX, /* 270 */
+};
+
+/* 帧缓冲横屏排列的控制器 (SSD1963) */
+static const uint8_t s_madctl_landscape_gram[LCD_ROT_COUNT] = {
+    0,                             /* 0 */
+    LCD_MADCTL_MX | LCD_MADCTL_MV, /* 90 */
+    LCD_MADCTL_MY | LCD_MADCTL_MX, /* 180 */
+    LCD_MADCTL_MY | LCD_MADCTL_MV, /* 270 */
+};
+
+/* 硬件滚动 (垂直滚动区 0x33/0x37) 沿 GRAM 行移动显示内容。MV 置位时逻辑
+ * x 对应 GRAM 行，滚动表现为水平平移；行地址方向由 MY 决定，表中 +1 表示
+ * 滚动起始行增大时内容向左移动。行列不交换的方向不支持水平滚动 (0) */
+static const int8_t s_hscroll_portrait_gram[LCD_ROT_COUNT] = {-1, 0, 1, 0};
+static const int8_t s_hscroll_landscape_gram[LCD_ROT_COUNT] = {0, 1, 0, -1};
+
+/* 行列不交换的方向上逻辑 y 对应 GRAM 行，滚动表现为垂直平移；+1 表示
+ * 滚动起始行增大时内容向上移动 (MY 置位的方向相反) */
+static const int8_t s_vscroll_portrait_gram[LCD_ROT_COUNT] = {0, 1, 0, -1};
+static const int8_t s_vscroll_landscape_gram[LCD_ROT_COUNT] = {1, 0, -1, 0};
+
+static lcd_rotation_t g_lcd_rotation = LCD_ROT_0;
+static uint16_t g_native_width;  /* 横屏基准方向的宽度 */
+static uint16_t g_native_height; /* 横屏基准方向的高度 */
+static lcd_touch_xform_t g_touch_xform = {1, 0, 0, 0, 1, 0};
+
+/**
+ * @brief       控制器是否支持垂直滚动区 (已验证的 800x480 控制器)
+ */
+static int lcd_orient_scroll_capable(void) {
+  return LCD_ID_IS(0x5510) || LCD_ID_IS(0x9806) || LCD_ID_IS(0x1963);
+}
+
+/**
+ * @brief       GRAM 行数 (滚动区长度)
+ */
+static uint16_t lcd_orient_gram_rows(void) {
+  return LCD_ID_IS(0x1963) ? g_native_height : g_native_width;
+}
+
+/**
+ * @brief       写入滚动起始行
+ * @param       line: 起始行, 0 为不滚动
+ * @retval      无
+ */
+static void lcd_orient_write_scroll_start(uint16_t line) {
+  if (LCD_ID_IS(0x5510)) {
+    lcd_wr_regno(0x3700);
+    lcd_wr_data(line >> 8);
+    lcd_wr_regno(0x3701);
+    lcd_wr_data(line & 0xFF);
+  } else {
+    lcd_wr_regno(0x37);
+    lcd_wr_data(line >> 8);
+    lcd_wr_data(line & 0xFF);
+  }
+}
+
+/**
+ * @brief       设置滚动区为整个 GRAM (无固定区)
+ * @param       无
+ * @retval      无
+ */
+static void lcd_orient_write_scroll_area(void) {
+  uint16_t rows = lcd_orient_gram_rows();
+
+  if (LCD_ID_IS(0x5510)) {
+    lcd_write_reg(0x3300, 0);
+    lcd_write_reg(0x3301, 0);
+    lcd_write_reg(0x3302, rows >> 8);
+    lcd_write_reg(0x3303, rows & 0xFF);
+    lcd_write_reg(0x3304, 0);
+    lcd_write_reg(0x3305, 0);
+  } else {
+    lcd_wr_regno(0x33);
+    lcd_wr_data(0);
+    lcd_wr_data(0);
+    lcd_wr_data(rows >> 8);
+    lcd_wr_data(rows & 0xFF);
+    lcd_wr_data(0);
+    lcd_wr_data(0);
+  }
+}
+
+/**
+ * @brief       计算横屏基准坐标到指定方向逻辑坐标的变换
+ * @param       rot: 方向
+ * @param       t: 输出变换
+ * @retval      无
+ */
+static void lcd_orient_build_xform(lcd_rotation_t rot, lcd_touch_xform_t *t) {
+  int16_t w = (int16_t)g_native_width;
+  int16_t h = (int16_t)g_native_height;
+
+  switch (rot) {
+  case LCD_ROT_90: /* (x, y) -> (y, W - 1 - x) */
+    t->xx = 0;
+    t->xy = 1;
+    t->x0 = 0;
+    t->yx = -1;
+    t->yy = 0;
+    t->y0 = w - 1;
+    break;
+
+  case LCD_ROT_180: /* (x, y) -> (W - 1 - x, H - 1 - y) */
+    t->xx = -1;
+    t->xy = 0;
+    t->x0 = w - 1;
+    t->yx = 0;
+    t->yy = -1;
+    t->y0 = h - 1;
+    break;
+
+  case LCD_ROT_270: /* (x, y) -> (H - 1 - y, x) */
+    t->xx = 0;
+    t->xy = -1;
+    t->x0 = h - 1;
+    t->yx = 1;
+    t->yy = 0;
+    t->y0 = 0;
+    break;
+
+  default:
+    t->xx = 1;
+    t->xy = 0;
+    t->x0 = 0;
+    t->yx = 0;
+    t->yy = 1;
+    t->y0 = 0;
+    break;
+  }
+}
+
+/**
+ * @brief       初始化方向服务: 切换到横屏基准并记录基准尺寸, 然后设置方向
+ * @param       rot: 初始方向
+ * @retval      无
+ */
+void lcd_orient_init(lcd_rotation_t rot) {
+  lcd_display_dir(1); /* 设置横屏命令与尺寸 */
+  g_native_width = lcddev.width;
+  g_native_height = lcddev.height;
+  if (lcd_orient_scroll_capable()) {
+    lcd_orient_write_scroll_area();
+  }
+  lcd_orient_set(rot);
+}
+
+/**
+ * @brief       设置方向
+ *   @note      只写一次 MADCTL 并重设全屏窗口, 之后的绘制与刷新按新方向的
+ *              逻辑坐标进行; 调用方须保证此时没有正在进行的刷新
+ * @param       rot: 方向
+ * @retval      无
+ */
+void lcd_orient_set(lcd_rotation_t rot) {
+  uint16_t regval;
+
+  if (rot >= LCD_ROT_COUNT) {
+    rot = LCD_ROT_0;
+  }
+
+  regval = (LCD_ID_IS(0x1963)) ? s_madctl_landscape_gram[rot]
+                                 : s_madctl_portrait_gram[rot];
+
+  /* 9341 & 7789 & 7796 要设置BGR位 */
+  if (LCD_ID_IS(0x9341) || LCD_ID_IS(0x7789) || LCD_ID_IS(0x7796)) {
+    regval |= LCD_MADCTL_BGR;
+  }
+  lcd_write_reg(LCD_ID_IS(0x5510) ? 0x3600 : 0x36, regval);
+  if (lcd_orient_scroll_capable()) {
+    lcd_orient_write_scroll_start(0); /* 新方向从未滚动状态开始 */
+  }
+
+  /* 竖屏方向交换宽高 */
+  if (rot == LCD_ROT_90 || rot == LCD_ROT_270) {
+    lcddev.width = g_native_height;
+    lcddev.height = g_native_width;
+  } else {
+    lcddev.width = g_native_width;
+    lcddev.height = g_native_height;
+  }
+  lcd_set_window(0, 0, lcddev.width, lcddev.height);
+
+  lcd_orient_build_xform(rot, &g_touch_xform);
+  g_lcd_rotation = rot;
+}
+
+/**
+ * @brief       获取当前方向
+ * @param       无
+ * @retval      当前方向
+ */
+lcd_rotation_t lcd_orient_get(void) { return g_lcd_rotation; }
+
+/**
+ * @brief       获取当前方向的触摸坐标变换
+ * @param       无
+ * @retval      变换 (切换方向时原地更新)
+ */
+const lcd_touch_xform_t *lcd_orient_touch_xform(void) { return &g_touch_xform; }
+
+/**
+ * @brief       获取横屏基准方向的宽度 (触摸驱动的坐标系)
+ * @param       无
+ * @retval      宽度
+ */
+uint16_t lcd_orient_native_width(void) { return g_native_width; }
+
+/**
+ * @brief       获取横屏基准方向的高度 (触摸驱动的坐标系)
+ * @param       无
+ * @retval      高度
+ */
+uint16_t lcd_orient_native_height(void) { return g_native_height; }
+
+/**
+ * @brief       当前方向下硬件滚动能否水平平移显示内容
+ * @param       无
+ * @retval      +1/-1: 可以 (滚动起始行与平移方向的关系), 0: 不支持
+ */
+int8_t lcd_orient_hscroll_dir(void) {
+  if (!lcd_orient_scroll_capable()) {
+    return 0;
+  }
+  return LCD_ID_IS(0x1963) ? s_hscroll_landscape_gram[g_lcd_rotation]
+                             : s_hscroll_portrait_gram[g_lcd_rotation];
+}
+
+/**
+ * @brief       水平平移显示内容
+ *   @note      之后屏幕位置 x 显示的是逻辑列 (x + shift) % width 的 GRAM 内容,
+ *              逻辑坐标的写入不受影响; 调用方须保证此时没有正在进行的刷新
+ * @param       shift: 平移量 (0 ~ width - 1)
+ * @retval      无
+ */
+void lcd_orient_hscroll_set(uint16_t shift) {
+  int8_t dir = lcd_orient_hscroll_dir();
+
+  if (dir == 0) {
+    return;
+  }
+  shift %= lcddev.width;
+  if (dir < 0 && shift != 0) {
+    shift = lcddev.width - shift;
+  }
+  lcd_orient_write_scroll_start(shift);
+}
+
+/**
+ * @brief       当前方向下硬件滚动能否垂直平移显示内容
+ * @param       无
+ * @retval      +1/-1: 可以 (滚动起始行与平移方向的关系), 0: 不支持
+ */
+int8_t lcd_orient_vscroll_dir(void) {
+  if (!lcd_orient_scroll_capable()) {
+    return 0;
+  }
+  return LCD_ID_IS(0x1963) ? s_vscroll_landscape_gram[g_lcd_rotation]
+                             : s_vscroll_portrait_gram[g_lcd_rotation];
+}
+
+/**
+ * @brief       垂直平移显示内容
+ *   @note      之后屏幕位置 y 显示的是逻辑行 (y + shift) % height 的 GRAM 内容,
+ *              逻辑坐标的写入不受影响; 调用方须保证此时没有正在进行的刷新
+ * @param       shift: 平移量 (0 ~ height - 1)
+ * @retval      无
+ */
+void lcd_orient_vscroll_set(uint16_t shift) {
+  int8_t dir = lcd_orient_vscroll_dir();
+
+  if (dir == 0) {
+    return;
+  }
+  shift %= lcddev.height;
+  if (dir < 0 && shift != 0) {
+    shift = lcddev.height - shift;
+  }
+  lcd_orient_write_scroll_start(shift);
+}
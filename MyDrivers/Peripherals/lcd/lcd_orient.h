@@ -0,0 +1,59 @@
+/**
+ ******************************************************************************
+ * @file    lcd_orient.h
+ * @brief   屏幕方向服务头文件
+ * @details 四个方向都只在切换时写一次控制器的扫描方向寄存器 (MADCTL,
+ *          0x36/0x3600)，由控制器完成行列交换与镜像，刷新与绘制路径仍按
+ *          逻辑坐标开窗、顺序写入，不做任何逐像素的旋转。
+ *          触摸驱动固定输出横屏基准方向 (LCD_ROT_0) 的坐标，切换方向时同时
+ *          算好整数仿射变换 (lcd_touch_xform_t)，输入层每个触点只做一次乘加，
+ *          不再按扫描方向分支。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __LCD_ORIENT_H
+#define __LCD_ORIENT_H
+
+#include "lcd.h"
+#include <stdint.h>
+
+/* 方向：内容相对横屏基准顺时针旋转的角度 */
+typedef enum {
+  LCD_ROT_0 = 0, /* 横屏 (控制器横屏基准) */
+  LCD_ROT_90,    /* 竖屏 */
+  LCD_ROT_180,   /* 横屏翻转 */
+  LCD_ROT_270,   /* 竖屏翻转 */
+  LCD_ROT_COUNT
+} lcd_rotation_t;
+
+/* 上电默认方向 (本机面板倒装，与原 lcd_scan_dir(R2L_D2U) 一致) */
+#define LCD_ORIENT_DEFAULT LCD_ROT_180
+
+/* 触摸坐标变换: x' = xx * x + xy * y + x0, y' = yx * x + yy * y + y0
+ * (系数只取 -1/0/1，输入为横屏基准方向的触摸坐标) */
+typedef struct {
+  int16_t xx, xy, x0;
+  int16_t yx, yy, y0;
+} lcd_touch_xform_t;
+
+#define LCD_XFORM_X(t, x, y) ((t)->xx * (x) + (t)->xy * (y) + (t)->x0)
+#define LCD_XFORM_Y(t, x, y) ((t)->yx * (x) + (t)->yy * (y) + (t)->y0)
+
+void lcd_orient_init(lcd_rotation_t rot);  /* 在 lcd_init() 之后调用 */
+void lcd_orient_set(lcd_rotation_t rot);   /* 切换方向 (不能与刷新同时进行) */
+lcd_rotation_t lcd_orient_get(void);       /* 当前方向 */
+const lcd_touch_xform_t *lcd_orient_touch_xform(void); /* 当前触摸变换 */
+uint16_t lcd_orient_native_width(void);    /* 横屏基准方向的宽度 */
+uint16_t lcd_orient_native_height(void);   /* 横屏基准方向的高度 */
+
+/* 硬件滚动水平平移 (控制器垂直滚动区, 只在行列交换的方向上可用) */
+int8_t lcd_orient_hscroll_dir(void);       /* 0: 当前方向/控制器不支持 */
+void lcd_orient_hscroll_set(uint16_t shift); /* 位置 x 显示逻辑列 (x + shift) % width */
+
+/* 硬件滚动垂直平移 (只在行列不交换的方向上可用) */
+int8_t lcd_orient_vscroll_dir(void);       /* 0: 当前方向/控制器不支持 */
+void lcd_orient_vscroll_set(uint16_t shift); /* 位置 y 显示逻辑行 (y + shift) % height */
+
+#endif
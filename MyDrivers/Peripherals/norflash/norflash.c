@@ -0,0 +1,325 @@
+/**
+ ******************************************************************************
+ * @file    norflash.c
+ * @brief   板载 SPI NOR Flash (W25Qxx) 驱动源文件
+ * @details SPI1 工作在模式 3、8 位、软件片选。W25Qxx 在 SPI 时钟可达 104 MHz，
+ *          SPI1 最高只能跑到 fPCLK2/2 = 42 MHz，因此快速读不需要降频。
+ *          等待擦除/编程完成时，调度器运行后每次查询间隔让出 1 ms，
+ *          避免 400 ms 的扇区擦除期间占满 CPU。
+ *          只使用 3 字节地址命令，容量大于 16 MB 的芯片只访问前 16 MB。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "norflash.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include "task_plan.h"
+
+#define LOG_MODULE "NORFLASH"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define NORFLASH_CS_PORT            GPIOB
+#define NORFLASH_CS_PIN             GPIO_PIN_14
+
+#define NORFLASH_CS(x)              HAL_GPIO_WritePin(NORFLASH_CS_PORT, NORFLASH_CS_PIN, (x) ? GPIO_PIN_SET : GPIO_PIN_RESET)
+
+#define NORFLASH_MAX_SIZE           0x1000000UL     // 3 字节地址可访问的上限
+
+/* 指令表 */
+#define W25X_WRITE_ENABLE           0x06
+#define W25X_READ_STATUS1           0x05
+#define W25X_FAST_READ              0x0B
+#define W25X_PAGE_PROGRAM           0x02
+#define W25X_SECTOR_ERASE           0x20
+#define W25X_RELEASE_POWER_DOWN     0xAB
+#define W25X_JEDEC_ID               0x9F
+
+#define W25X_STATUS_BUSY            0x01
+
+/* --------------------------- 私有变量 --------------------------- */
+static bool s_ready = false;
+static uint32_t s_size = 0;
+
+static SemaphoreHandle_t s_mutex = NULL;
+static StaticSemaphore_t s_mutex_buf;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static bool norflash_rtos_running(void)
+{
+    return xTaskGetSchedulerState() == taskSCHEDULER_RUNNING;
+}
+
+static void norflash_lock(void)
+{
+    if (s_mutex != NULL && norflash_rtos_running())
+    {
+        xSemaphoreTake(s_mutex, portMAX_DELAY);
+    }
+}
+
+static void norflash_unlock(void)
+{
+    if (s_mutex != NULL && norflash_rtos_running())
+    {
+        xSemaphoreGive(s_mutex);
+    }
+}
+
+/**
+ * @brief 全双工收发一个字节
+ */
+static uint8_t norflash_spi_rw(uint8_t data)
+{
+    while ((SPI1->SR & SPI_SR_TXE) == 0);
+    *(__IO uint8_t *)&SPI1->DR = data;
+
+    while ((SPI1->SR & SPI_SR_RXNE) == 0);
+    return *(__IO uint8_t *)&SPI1->DR;
+}
+
+static void norflash_send_addr(uint8_t cmd, uint32_t addr)
+{
+    norflash_spi_rw(cmd);
+    norflash_spi_rw((uint8_t)(addr >> 16));
+    norflash_spi_rw((uint8_t)(addr >> 8));
+    norflash_spi_rw((uint8_t)addr);
+}
+
+static void norflash_write_enable(void)
+{
+    NORFLASH_CS(0);
+    norflash_spi_rw(W25X_WRITE_ENABLE);
+    NORFLASH_CS(1);
+}
+
+/**
+ * @brief 等待 BUSY 位清零
+ * @return 0: 完成, 1: 超时
+ */
+static uint8_t norflash_wait_busy(uint32_t timeout_ms)
+{
+    uint32_t start = HAL_GetTick();
+    uint8_t status;
+
+    for (;;)
+    {
+        NORFLASH_CS(0);
+        norflash_spi_rw(W25X_READ_STATUS1);
+        status = norflash_spi_rw(0xFF);
+        NORFLASH_CS(1);
+
+        if ((status & W25X_STATUS_BUSY) == 0) return 0;
+
+        if (HAL_GetTick() - start > timeout_ms) return 1;
+
+        if (norflash_rtos_running()) vTaskDelay(1);
+    }
+}
+
+static uint32_t norflash_read_id_raw(void)
+{
+    uint32_t id;
+
+    NORFLASH_CS(0);
+    norflash_spi_rw(W25X_JEDEC_ID);
+    id = (uint32_t)norflash_spi_rw(0xFF) << 16;
+    id |= (uint32_t)norflash_spi_rw(0xFF) << 8;
+    id |= norflash_spi_rw(0xFF);
+    NORFLASH_CS(1);
+    return id;
+}
+
+static bool norflash_range_ok(uint32_t addr, uint32_t len)
+{
+    return s_ready && addr < s_size && len <= s_size - addr;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化 SPI1 与片选引脚并识别芯片
+ */
+uint8_t norflash_init(void)
+{
+    GPIO_InitTypeDef gpio_init_struct = {0};
+    uint32_t id;
+    uint8_t capacity;
+
+    if (s_ready) return 0;
+
+    if (s_mutex == NULL)
+    {
+        s_mutex = xSemaphoreCreateMutexStatic(&s_mutex_buf);
+        TaskPlan_WatchMutex(s_mutex, "norflash", NORFLASH_SECTOR_ERASE_MS);
+    }
+
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_SPI1_CLK_ENABLE();
+
+    NORFLASH_CS(1);
+    gpio_init_struct.Pin = NORFLASH_CS_PIN;
+    gpio_init_struct.Mode = GPIO_MODE_OUTPUT_PP;
+    gpio_init_struct.Pull = GPIO_PULLUP;
+    gpio_init_struct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    HAL_GPIO_Init(NORFLASH_CS_PORT, &gpio_init_struct);
+
+    /* PB3/PB4 复位后为 JTAG 引脚，改为复用功能后只保留 SWD 调试 */
+    gpio_init_struct.Pin = GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5;
+    gpio_init_struct.Mode = GPIO_MODE_AF_PP;
+    gpio_init_struct.Alternate = GPIO_AF5_SPI1;
+    HAL_GPIO_Init(GPIOB, &gpio_init_struct);
+
+    /* 主机、模式 3 (CPOL=1 CPHA=1)、8 位、MSB 先行、软件 NSS */
+    SPI1->CR1 = 0;
+    SPI1->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI | SPI_CR1_CPOL | SPI_CR1_CPHA |
+                (NORFLASH_SPI_BR << SPI_CR1_BR_Pos);
+    SPI1->CR2 = 0;
+    SPI1->CR1 |= SPI_CR1_SPE;
+
+    /* 掉电模式下芯片不响应读 ID，先唤醒 (tRES1 = 3 us) */
+    NORFLASH_CS(0);
+    norflash_spi_rw(W25X_RELEASE_POWER_DOWN);
+    NORFLASH_CS(1);
+    HAL_Delay(1);
+
+    id = norflash_read_id_raw();
+    capacity = (uint8_t)id;
+
+    if ((id >> 16) == 0x00 || (id >> 16) == 0xFF || capacity < 0x10 || capacity > 0x20)
+    {
+        LOG_WARN("未检测到 SPI Flash (JEDEC ID 0x%06lX)", (unsigned long)id);
+        return 1;
+    }
+
+    /* JEDEC 容量字节为 log2(字节数) */
+    s_size = 1UL << capacity;
+    if (s_size > NORFLASH_MAX_SIZE) s_size = NORFLASH_MAX_SIZE;
+    s_ready = true;
+
+    LOG_INFO("SPI Flash 0x%06lX, %lu KB", (unsigned long)id, (unsigned long)(s_size >> 10));
+    return 0;
+}
+
+/**
+ * @brief 芯片是否已识别
+ */
+bool norflash_is_ready(void)
+{
+    return s_ready;
+}
+
+/**
+ * @brief 读取 JEDEC ID
+ */
+uint32_t norflash_read_id(void)
+{
+    uint32_t id;
+
+    norflash_lock();
+    id = norflash_read_id_raw();
+    norflash_unlock();
+    return id;
+}
+
+/**
+ * @brief 芯片容量 (字节)
+ */
+uint32_t norflash_get_size(void)
+{
+    return s_size;
+}
+
+/**
+ * @brief 读取数据
+ */
+uint8_t norflash_read(uint32_t addr, uint8_t *buf, uint32_t len)
+{
+    if (buf == NULL || !norflash_range_ok(addr, len)) return 1;
+
+    if (len == 0) return 0;
+
+    norflash_lock();
+    NORFLASH_CS(0);
+    norflash_send_addr(W25X_FAST_READ, addr);
+    norflash_spi_rw(0xFF);              /* 8 个空周期 */
+
+    while (len--)
+    {
+        *buf++ = norflash_spi_rw(0xFF);
+    }
+
+    NORFLASH_CS(1);
+    norflash_unlock();
+    return 0;
+}
+
+/**
+ * @brief 擦除 addr 所在的 4 KB 扇区
+ */
+uint8_t norflash_erase_sector(uint32_t addr)
+{
+    uint8_t ret;
+
+    if (!norflash_range_ok(addr, 1)) return 1;
+
+    addr &= ~(uint32_t)(NORFLASH_SECTOR_SIZE - 1);
+
+    norflash_lock();
+    norflash_write_enable();
+    NORFLASH_CS(0);
+    norflash_send_addr(W25X_SECTOR_ERASE, addr);
+    NORFLASH_CS(1);
+    ret = norflash_wait_busy(NORFLASH_SECTOR_ERASE_MS);
+    norflash_unlock();
+
+    if (ret) LOG_ERROR("扇区 0x%06lX 擦除超时", (unsigned long)addr);
+
+    return ret;
+}
+
+/**
+ * @brief 写入数据 (内部按页拆分)
+ */
+uint8_t norflash_write(uint32_t addr, const uint8_t *buf, uint32_t len)
+{
+    uint32_t chunk;
+    uint8_t ret = 0;
+
+    if (buf == NULL || !norflash_range_ok(addr, len)) return 1;
+
+    norflash_lock();
+
+    while (len > 0 && ret == 0)
+    {
+        /* 页编程不能跨越 256 字节页边界，否则地址回绕到页首 */
+        chunk = NORFLASH_PAGE_SIZE - (addr & (NORFLASH_PAGE_SIZE - 1));
+        if (chunk > len) chunk = len;
+
+        norflash_write_enable();
+        NORFLASH_CS(0);
+        norflash_send_addr(W25X_PAGE_PROGRAM, addr);
+
+        for (uint32_t i = 0; i < chunk; i++)
+        {
+            norflash_spi_rw(buf[i]);
+        }
+
+        NORFLASH_CS(1);
+        ret = norflash_wait_busy(NORFLASH_PAGE_PROGRAM_MS);
+
+        addr += chunk;
+        buf += chunk;
+        len -= chunk;
+    }
+
+    norflash_unlock();
+
+    if (ret) LOG_ERROR("页编程超时 (0x%06lX)", (unsigned long)addr);
+
+    return ret;
+}
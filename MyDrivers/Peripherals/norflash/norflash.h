@@ -0,0 +1,88 @@
+/**
+ ******************************************************************************
+ * @file    norflash.h
+ * @brief   板载 SPI NOR Flash (W25Qxx) 驱动头文件
+ * @details 板载 W25Q128 (16 MB) 接在 SPI1：PB3 SCK, PB4 MISO, PB5 MOSI，
+ *          片选 PB14。工程未启用 HAL SPI 模块，驱动直接操作 SPI1 寄存器，
+ *          以轮询方式收发；读取使用 0x0B 快速读命令，可连续读任意长度。
+ *          所有接口由内部互斥量保护，GUI 任务读图片与命令行任务烧写可以并发调用。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __NORFLASH_H
+#define __NORFLASH_H
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define NORFLASH_SPI_BR             0       // SPI1 分频 (BR[2:0])，0: fPCLK2/2 = 42 MHz
+#define NORFLASH_PAGE_SIZE          256     // 页编程最大长度
+#define NORFLASH_SECTOR_SIZE        4096    // 最小擦除单位
+#define NORFLASH_SECTOR_ERASE_MS    400     // 扇区擦除超时 (手册最大值)
+#define NORFLASH_PAGE_PROGRAM_MS    3       // 页编程超时
+
+/* --------------------------- 芯片 ID --------------------------- */
+#define NORFLASH_JEDEC_W25Q16       0xEF4015
+#define NORFLASH_JEDEC_W25Q32       0xEF4016
+#define NORFLASH_JEDEC_W25Q64       0xEF4017
+#define NORFLASH_JEDEC_W25Q128      0xEF4018
+#define NORFLASH_JEDEC_W25Q256      0xEF4019
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化 SPI1 与片选引脚并识别芯片 (可重复调用)
+ * @return 0: 成功, 1: 未检测到芯片
+ */
+uint8_t norflash_init(void);
+
+/**
+ * @brief 芯片是否已识别
+ */
+bool norflash_is_ready(void);
+
+/**
+ * @brief 读取 JEDEC ID (厂商 << 16 | 类型 << 8 | 容量)
+ */
+uint32_t norflash_read_id(void);
+
+/**
+ * @brief 芯片容量 (字节)，未识别时为 0
+ */
+uint32_t norflash_get_size(void);
+
+/**
+ * @brief 读取数据
+ * @param addr 起始地址
+ * @param buf  输出缓冲区
+ * @param len  读取长度 (不受页/扇区边界限制)
+ * @return 0: 成功, 1: 芯片未就绪或越界
+ */
+uint8_t norflash_read(uint32_t addr, uint8_t *buf, uint32_t len);
+
+/**
+ * @brief 擦除 addr 所在的 4 KB 扇区
+ * @return 0: 成功, 1: 失败 (未就绪/越界/超时)
+ */
+uint8_t norflash_erase_sector(uint32_t addr);
+
+/**
+ * @brief 写入数据 (内部按页拆分)
+ * @note  目标区域必须已擦除，本函数不做读-改-写
+ * @return 0: 成功, 1: 失败 (未就绪/越界/超时)
+ */
+uint8_t norflash_write(uint32_t addr, const uint8_t *buf, uint32_t len);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NORFLASH_H */
@@ -91,18 +91,19 @@ Buzzer_Status_t Buzzer_Init(void);
  * @note   ̬ͨ TIM3  ARR ĴʵƵʿ
  * @note   ̶ռձ 50%ȷȶ
  * @note   ԭPWMƵ = TIM_CLK / (PSC+1) / (ARR+1)
+ * @note   ڼȡڲźŶӵɣܾڱ
  */
 void Buzzer_SetFrequency(uint16_t freq_hz);
 
 /**
  * @brief  ֹͣ
- * @note   ر PWM ֹͣ
+ * @note   ر PWM ͬʱȡڲźŶӵ
  */
 void Buzzer_Stop(void);
 
 /**
  * @brief  ѯǷڲ
- * @retval true: ڲ
+ * @retval true: ڷδ
  * @retval false: ֹͣ
  */
 bool Buzzer_IsPlaying(void);
@@ -110,32 +111,61 @@ bool Buzzer_IsPlaying(void);
 /* ==================== ź ==================== */
 
 /**
- * @brief  ָƵʺʱ
+ * @brief ȼ
+ * @note  ȼڲŵĵȼ (ϵɶ)
+ *        ͬȼŶӣȵǰɽȼβ
+ */
+typedef enum {
+    BUZZER_PRIO_LOW = 0,    /**<  */
+    BUZZER_PRIO_NORMAL,     /**< ʾ (ɹʧ) */
+    BUZZER_PRIO_ALARM       /**<  */
+} Buzzer_Priority_t;
+
+#define BUZZER_QUEUE_LEN    4   /**< Ŷӵȴ */
+#define BUZZER_NOTE_GAP_MS  50  /**< ֮ļ (ms)ճ */
+
+/**
+ * @brief  ȼ첽
+ * @param  melody: 飬ڲŽǰЧ (̬洢)
+ * @param  length: 
+ * @param  prio: ȼ
+ * @retval BUZZER_OK: ѿʼŻŶ
+ * @retval BUZZER_ERROR: ڼڱ
+ * @note   أ Buzzer_Tick()  1ms ʱжл
+ * @note   еãже
+ */
+Buzzer_Status_t Buzzer_Play(const Note* melody, uint16_t length,
+                            Buzzer_Priority_t prio);
+
+/**
+ * @brief  ɲ
+ * @note    1ms ʱʱ (TIM6) ĸже
+ */
+void Buzzer_Tick(void);
+
+/**
+ * @brief  ָƵʺʱ (첽BUZZER_PRIO_NORMAL)
  * @param  freq_hz: Ƶ (Hz)
  * @param  duration_ms: ʱ (ms)
- * @note   ?? ʹ osDelay ʵʱǰ
- * @note   ??  FreeRTOS еãжʹ
- * @note   ɺԶֹͣ
+ * @note   أɺԶֹͣ
  */
 void Buzzer_PlayTone(uint16_t freq_hz, uint16_t duration_ms);
 
 /**
- * @brief  ŵ
+ * @brief  ŵ (첽BUZZER_PRIO_NORMAL)
  * @param  note: ṹ壬Ƶʺʱ
- * @note   ?? ʹ osDelay ʵʱĵ
  * @note   ֧־ţNOTE_SILENCE
  */
 void Buzzer_PlayNote(Note note);
 
 /**
- * @brief  ɣУ
- * @param  melody: ָ
+ * @brief   (첽BUZZER_PRIO_NORMAL)
+ * @param  melody: 飬Ϊ̬洢
  * @param  length: 
- * @note   ?? ʹ osDelay ʵʱĵ
- * @note   Զ 50ms ǿ
+ * @note   ÿԶ BUZZER_NOTE_GAP_MS ǿ
  * @note   ʾ
  *         @code
- *         const Note melody[] = {
+ *         static const Note melody[] = {
  *             {NOTE_M1, 200}, {NOTE_M2, 200}, {NOTE_M3, 400}
  *         };
  *         Buzzer_PlayMelody(melody, 3);
@@ -153,7 +183,7 @@ void Buzzer_PlayMelody(const Note* melody, uint16_t length);
 /**
  * @brief  򵥵1000Hz100ms
  * @note   ڰȷϵȳ
- * @note   ?? ĵ
+ * @note   첽ţȼ BUZZER_PRIO_LOW
  */
 void Buzzer_Beep(void);
 
@@ -161,7 +191,7 @@ void Buzzer_Beep(void);
  * @brief  Чף
  * @note   УDo-Mi-Sol
  * @note   ϵͳʾ
- * @note   ?? ĵ
+ * @note   첽ţȼ BUZZER_PRIO_NORMAL
  */
 void Buzzer_StartupSound(void);
 
@@ -169,7 +199,7 @@ void Buzzer_StartupSound(void);
  * @brief  ɹЧȶ
  * @note   УSol-Do-Mi
  * @note   ڲɹɵȳ
- * @note   ?? ĵ
+ * @note   첽ţȼ BUZZER_PRIO_NORMAL
  */
 void Buzzer_SuccessSound(void);
 
@@ -177,7 +207,7 @@ void Buzzer_SuccessSound(void);
  * @brief  Ч½ף
  * @note   УSol-Mi-Doݼ
  * @note   ڲʧܡʾȳ
- * @note   ?? ĵ
+ * @note   첽ţȼ BUZZER_PRIO_NORMAL
  */
 void Buzzer_ErrorSound(void);
 
@@ -185,7 +215,7 @@ void Buzzer_ErrorSound(void);
  * @brief  Ч
  * @note    800Hz  1200Hz ظ 3 
  * @note   ڱشȳ
- * @note   ?? ĵ
+ * @note   첽ţȼ BUZZER_PRIO_ALARM
  */
 void Buzzer_WarningSound(void);
 
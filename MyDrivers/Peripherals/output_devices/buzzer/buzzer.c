@@ -4,6 +4,8 @@
  * @brief   无源蜂鸣器驱动实现
  * @details 基于 STM32 TIM3 PWM 输出控制无源蜂鸣器频率
  *          支持音符播放、旋律播放、预定义音效等功能
+ *          旋律由 1ms 时基中断驱动的播放器逐个切换音符，调用者立即返回；
+ *          播放器状态在任务与中断之间共享，任务侧的修改在关中断下进行
  * @author  MmsY
  * @date    2025
  ******************************************************************************
@@ -11,7 +13,7 @@
 
 #include "buzzer.h"
 #include "tim.h"
-#include "cmsis_os.h"
+#include "energy_meter.h"
 
 #define LOG_MODULE "BUZZER"
 #include "log.h"
@@ -35,40 +37,47 @@
 
 /**
  * @brief 蜂鸣器播放状态标志
- * @note  true: 正在播放，false: 已停止
+ * @note  true: 正在发声，false: 已停止
  */
-static bool s_is_playing = false;
+static volatile bool s_is_playing = false;
 
-/* ==================== 公共函数实现 ==================== */
+/**
+ * @brief 一次播放请求
+ * @note  melody 为 NULL 时播放 single (单音调请求无需调用者提供存储)
+ */
+typedef struct {
+    const Note* melody;
+    uint16_t length;
+    Buzzer_Priority_t prio;
+    Note single;
+} Buzzer_Request_t;
 
 /**
- * @brief 初始化无源蜂鸣器
+ * @brief 旋律播放器状态（任务与 TIM6 中断共享）
  */
-Buzzer_Status_t Buzzer_Init(void)
-{
-    /* 停止 PWM 输出，确保初始状态为关闭 */
-    HAL_TIM_PWM_Stop(&htim3, TIM_CHANNEL_1);
-    s_is_playing = false;
-    LOG_INFO("蜂鸣器初始化完成");
-    return BUZZER_OK;
-}
+static struct {
+    bool active;                /**< 正在播放旋律 */
+    bool in_gap;                /**< 处于音符间隔 */
+    bool hold;                  /**< Buzzer_SetFrequency 持续发声中 */
+    uint16_t index;             /**< 当前音符序号 */
+    uint16_t remain_ms;         /**< 当前音符/间隔剩余时间 */
+    Buzzer_Request_t cur;       /**< 当前旋律 */
+    Buzzer_Request_t queue[BUZZER_QUEUE_LEN];
+    uint8_t queue_count;
+} s_player;
+
+/* ==================== 私有函数 ==================== */
 
 /**
- * @brief 设置蜂鸣器频率
- * @param freq_hz: 目标频率 (Hz)，0 为关闭
- * 
- * @note 工作原理：
- *       PWM频率 = TIM_CLK / (PSC+1) / (ARR+1)
- *       固定 PSC=83（在 CubeMX 中配置），通过调整 ARR 改变频率
- *       ARR = TIM_CLK / (PSC+1) / freq - 1
- * 
- * @note 占空比固定为 50%（CCR = ARR/2），确保音量稳定
+ * @brief 写 PWM 寄存器输出指定频率（0 为关闭）
+ * @note  任务侧须在关中断下调用，避免与播放器中断交错
  */
-void Buzzer_SetFrequency(uint16_t freq_hz)
+static void buzzer_output(uint16_t freq_hz)
 {
-    /* 频率为 0 时关闭蜂鸣器 */
     if (freq_hz == 0) {
-        Buzzer_Stop();
+        HAL_TIM_PWM_Stop(&htim3, TIM_CHANNEL_1);
+        s_is_playing = false;
+        Energy_SetLevel(ENERGY_RAIL_BUZZER, 0);
         return;
     }
     
@@ -106,6 +115,134 @@ void Buzzer_SetFrequency(uint16_t freq_hz)
     
     /* 更新播放状态 */
     s_is_playing = true;
+    Energy_SetLevel(ENERGY_RAIL_BUZZER, 1000);
+}
+
+/**
+ * @brief 开始播放当前旋律的第 index 个音符
+ */
+static void player_start_note(uint16_t index)
+{
+    const Note* note = &s_player.cur.melody[index];
+    
+    s_player.index = index;
+    s_player.in_gap = false;
+    s_player.remain_ms = note->duration ? note->duration : 1;
+    buzzer_output(note->freq);  /* NOTE_SILENCE 为 0，即休止符 */
+}
+
+/**
+ * @brief 开始播放一个请求（替换当前旋律）
+ */
+static void player_start(const Buzzer_Request_t* req)
+{
+    s_player.cur = *req;
+    if (s_player.cur.melody == NULL) {
+        s_player.cur.melody = &s_player.cur.single;
+        s_player.cur.length = 1;
+    }
+    s_player.active = true;
+    player_start_note(0);
+}
+
+/**
+ * @brief 从队列中取出优先级最高的请求（同级先进先出）开始播放
+ */
+static void player_next(void)
+{
+    uint8_t best = 0;
+    
+    if (s_player.queue_count == 0) {
+        s_player.active = false;
+        buzzer_output(0);
+        return;
+    }
+    
+    for (uint8_t i = 1; i < s_player.queue_count; i++) {
+        if (s_player.queue[i].prio > s_player.queue[best].prio) {
+            best = i;
+        }
+    }
+    player_start(&s_player.queue[best]);
+    
+    s_player.queue_count--;
+    for (uint8_t i = best; i < s_player.queue_count; i++) {
+        s_player.queue[i] = s_player.queue[i + 1];
+    }
+}
+
+/**
+ * @brief 提交播放请求
+ */
+static Buzzer_Status_t player_submit(const Buzzer_Request_t* req)
+{
+    Buzzer_Status_t status = BUZZER_OK;
+    uint32_t primask = __get_PRIMASK();
+    
+    __disable_irq();
+    if (s_player.hold && req->prio < BUZZER_PRIO_ALARM) {
+        status = BUZZER_ERROR;
+    } else if (!s_player.active || s_player.hold ||
+               req->prio > s_player.cur.prio) {
+        /* 空闲或高优先级：立即打断当前旋律 */
+        s_player.hold = false;
+        player_start(req);
+    } else if (s_player.queue_count < BUZZER_QUEUE_LEN) {
+        s_player.queue[s_player.queue_count++] = *req;
+    } else {
+        status = BUZZER_ERROR;
+    }
+    __set_PRIMASK(primask);
+    
+    if (status != BUZZER_OK) {
+        LOG_DEBUG("旋律被丢弃 (优先级 %d)", (int)req->prio);
+    }
+    return status;
+}
+
+/**
+ * @brief 取消全部旋律并设置持续输出
+ */
+static void player_hold(uint16_t freq_hz)
+{
+    uint32_t primask = __get_PRIMASK();
+    
+    __disable_irq();
+    s_player.active = false;
+    s_player.queue_count = 0;
+    s_player.hold = (freq_hz != 0);
+    buzzer_output(freq_hz);
+    __set_PRIMASK(primask);
+}
+
+/* ==================== 公共函数实现 ==================== */
+
+/**
+ * @brief 初始化无源蜂鸣器
+ */
+Buzzer_Status_t Buzzer_Init(void)
+{
+    /* 停止 PWM 输出，确保初始状态为关闭 */
+    player_hold(0);
+    LOG_INFO("蜂鸣器初始化完成");
+    return BUZZER_OK;
+}
+
+/**
+ * @brief 设置蜂鸣器频率
+ * @param freq_hz: 目标频率 (Hz)，0 为关闭
+ * 
+ * @note 工作原理：
+ *       PWM频率 = TIM_CLK / (PSC+1) / (ARR+1)
+ *       固定 PSC=83（在 CubeMX 中配置），通过调整 ARR 改变频率
+ *       ARR = TIM_CLK / (PSC+1) / freq - 1
+ * 
+ * @note 占空比固定为 50%（CCR = ARR/2），确保音量稳定
+ */
+void Buzzer_SetFrequency(uint16_t freq_hz)
+{
+    /* 频率为 0 时关闭蜂鸣器；持续发声优先于旋律 */
+    player_hold(freq_hz);
 }
 
 /**
@@ -113,9 +250,8 @@ void Buzzer_SetFrequency(uint16_t freq_hz)
  */
 void Buzzer_Stop(void)
 {
-    /* 停止 PWM 输出 */
-    HAL_TIM_PWM_Stop(&htim3, TIM_CHANNEL_1);
-    s_is_playing = false;
+    /* 停止 PWM 输出并清空旋律 */
+    player_hold(0);
 }
 
 /**
@@ -123,55 +259,85 @@ void Buzzer_Stop(void)
  */
 bool Buzzer_IsPlaying(void)
 {
-    return s_is_playing;
+    return s_is_playing || s_player.active;
+}
+
+/**
+ * @brief 按优先级异步播放旋律
+ */
+Buzzer_Status_t Buzzer_Play(const Note* melody, uint16_t length,
+                            Buzzer_Priority_t prio)
+{
+    Buzzer_Request_t req;
+    
+    if (melody == NULL || length == 0) {
+        return BUZZER_ERROR;
+    }
+    req.melody = melody;
+    req.length = length;
+    req.prio = prio;
+    return player_submit(&req);
+}
+
+/**
+ * @brief 旋律播放器节拍（TIM6 更新中断，1ms）
+ * @note  每个音符后插入 BUZZER_NOTE_GAP_MS 静音间隔，最后一个间隔结束后
+ *        播放队列中的下一个旋律
+ */
+void Buzzer_Tick(void)
+{
+    if (!s_player.active || --s_player.remain_ms != 0) {
+        return;
+    }
+    
+    if (!s_player.in_gap) {
+        /* 音符结束：进入间隔 */
+        s_player.in_gap = true;
+        s_player.remain_ms = BUZZER_NOTE_GAP_MS;
+        buzzer_output(0);
+    } else if (s_player.index + 1 < s_player.cur.length) {
+        player_start_note(s_player.index + 1);
+    } else {
+        player_next();
+    }
 }
 
 /**
  * @brief 播放指定频率和时长的音调
  * @param freq_hz: 频率 (Hz)
  * @param duration_ms: 持续时间 (ms)
- * 
- * @note ⚠️ 此函数会阻塞当前任务，使用 osDelay 实现延时
- * @note 仅能在 FreeRTOS 任务上下文中调用，不可在中断中使用
  */
 void Buzzer_PlayTone(uint16_t freq_hz, uint16_t duration_ms)
 {
-    Buzzer_SetFrequency(freq_hz);
-    osDelay(duration_ms);  /* 阻塞等待 */
-    Buzzer_Stop();
+    Note note = {freq_hz, duration_ms};
+    Buzzer_PlayNote(note);
 }
 
 /**
  * @brief 播放音符
  * @param note: 音符结构体
  * 
- * @note 如果音符频率为 NOTE_SILENCE，则仅延时不发声（休止符）
+ * @note 音符按值保存在请求中，调用者无需保留
  */
 void Buzzer_PlayNote(Note note)
 {
-    if (note.freq == NOTE_SILENCE) {
-        /* 休止符：停止发声，仅延时 */
-        Buzzer_Stop();
-        osDelay(note.duration);
-    } else {
-        /* 普通音符：播放指定频率和时长 */
-        Buzzer_PlayTone(note.freq, note.duration);
-    }
+    Buzzer_Request_t req;
+    
+    req.melody = NULL;
+    req.length = 1;
+    req.prio = BUZZER_PRIO_NORMAL;
+    req.single = note;
+    player_submit(&req);
 }
 
 /**
  * @brief 播放旋律
  * @param melody: 音符数组
  * @param length: 音符数量
- * 
- * @note 每个音符之间会自动插入 50ms 间隔，增强节奏感
  */
 void Buzzer_PlayMelody(const Note* melody, uint16_t length)
 {
-    for (uint16_t i = 0; i < length; i++) {
-        Buzzer_PlayNote(melody[i]);
-        osDelay(50);  /* 音符间隔，避免音符粘连 */
-    }
+    Buzzer_Play(melody, length, BUZZER_PRIO_NORMAL);
 }
 
 /* ==================== 预定义音效 ==================== */
@@ -182,7 +348,10 @@ void Buzzer_PlayMelody(const Note* melody, uint16_t length)
  */
 void Buzzer_Beep(void)
 {
-    Buzzer_PlayTone(1000, 100);
+    static const Note beep[] = {
+        {1000, 100}
+    };
+    Buzzer_Play(beep, 1, BUZZER_PRIO_LOW);
 }
 
 /**
@@ -191,12 +360,12 @@ void Buzzer_Beep(void)
  */
 void Buzzer_StartupSound(void)
 {
-    const Note startup[] = {
+    static const Note startup[] = {
         {NOTE_M1, 100},  /* Do (523Hz) */
         {NOTE_M3, 100},  /* Mi (659Hz) */
         {NOTE_M5, 200}   /* Sol (784Hz) */
     };
-    Buzzer_PlayMelody(startup, 3);
+    Buzzer_Play(startup, 3, BUZZER_PRIO_NORMAL);
 }
 
 /**
@@ -205,12 +374,12 @@ void Buzzer_StartupSound(void)
  */
 void Buzzer_SuccessSound(void)
 {
-    const Note success[] = {
+    static const Note success[] = {
         {NOTE_M5, 100},  /* Sol (784Hz) */
         {NOTE_H1, 100},  /* 高Do (1047Hz) */
         {NOTE_H3, 300}   /* 高Mi (1319Hz) */
     };
-    Buzzer_PlayMelody(success, 3);
+    Buzzer_Play(success, 3, BUZZER_PRIO_NORMAL);
 }
 
 /**
@@ -219,12 +388,12 @@ void Buzzer_SuccessSound(void)
  */
 void Buzzer_ErrorSound(void)
 {
-    const Note error[] = {
+    static const Note error[] = {
         {NOTE_M5, 150},  /* Sol (784Hz) */
         {NOTE_M3, 150},  /* Mi (659Hz) */
         {NOTE_M1, 300}   /* Do (523Hz) */
     };
-    Buzzer_PlayMelody(error, 3);
+    Buzzer_Play(error, 3, BUZZER_PRIO_NORMAL);
 }
 
 /**
@@ -234,11 +403,10 @@ void Buzzer_ErrorSound(void)
  */
 void Buzzer_WarningSound(void)
 {
-    for (uint8_t i = 0; i < 3; i++)
-    {
-        Buzzer_PlayTone(800, 100);   /* 低音 */
-        osDelay(50);                 /* 短暂停顿 */
-        Buzzer_PlayTone(1200, 100);  /* 高音 */
-        osDelay(50);                 /* 短暂停顿 */
-    }
+    static const Note warning[] = {
+        {800, 100}, {1200, 100},
+        {800, 100}, {1200, 100},
+        {800, 100}, {1200, 100}
+    };
+    Buzzer_Play(warning, 6, BUZZER_PRIO_ALARM);
 }
@@ -5,6 +5,8 @@
  * @details 提供基于 PWM 的直流电机速度控制，支持自动/手动两种模式
  *          自动模式：通过电位器 ADC 值实时调速
  *          手动模式：通过软件接口设置固定速度
+ *          MOTOR_CLOSED_LOOP 为 1 时，设定值换算为目标转速，由风扇测速
+ *          (FG) 信号反馈做 PID 闭环；为 0 时设定值直接作为 PWM 占空比
  * @author  EnviroSense Team
  * @date    2025
  ******************************************************************************
@@ -20,6 +22,20 @@
 extern "C" {
 #endif
 
+/* ==================== 闭环配置 ==================== */
+
+#define MOTOR_CLOSED_LOOP           0       /**< 1: 测速反馈闭环（需将风扇 FG 信号接到 PD12/TIM4_CH1） */
+#define MOTOR_CONTROL_PERIOD_MS     10      /**< Motor_Update 调用周期（输出控制任务） */
+#define MOTOR_MAX_RPM               3000    /**< 设定值 999 对应的目标转速 */
+#define MOTOR_TACH_PULSES_PER_REV   2       /**< 每转测速脉冲数（常见风扇为 2） */
+#define MOTOR_TACH_TIMEOUT_MS       200     /**< 超过此时间无脉冲视为停转 */
+
+/* PID 增益，Q10 定点（1024 = 1.0），单位：占空比 / rpm；积分按每个控制周期累加 */
+#define MOTOR_PID_KP                100
+#define MOTOR_PID_KI                8
+#define MOTOR_PID_KD                0
+#define MOTOR_PID_I_LIMIT           (400L << 10)    /**< 积分项限幅（占空比，Q10） */
+
 /* ==================== 数据结构定义 ==================== */
 
 /**
@@ -27,7 +43,8 @@ extern "C" {
  */
 typedef enum {
     MOTOR_MODE_AUTO,    /**< 自动模式：速度由电位器 ADC 值决定 */
-    MOTOR_MODE_MANUAL   /**< 手动模式：速度由软件接口设置 */
+    MOTOR_MODE_MANUAL,  /**< 手动模式：速度由软件接口设置 */
+    MOTOR_MODE_VENT     /**< 通风模式：速度由上层按空气质量通过 Motor_SetSpeed() 设置 */
 } Motor_Control_Mode_t;
 
 /**
@@ -70,15 +87,34 @@ void Motor_SetControlMode(Motor_Control_Mode_t mode);
 Motor_Control_Mode_t Motor_GetControlMode(void);
 
 /**
- * @brief  手动设置电机速度（仅手动模式有效）
+ * @brief  手动设置电机速度（手动/通风模式有效）
  * @param  duty: PWM 占空比（0-999）
  *               0 = 停止，999 = 最大速度
- * @note   ⚠️ 仅在 MOTOR_MODE_MANUAL 模式下生效
+ * @note   ⚠️ 仅在 MOTOR_MODE_MANUAL / MOTOR_MODE_VENT 模式下生效
  * @note   在自动模式下调用此函数无效（会被电位器值覆盖）
  * @note   超过 999 会自动截断为 999
+ * @note   闭环模式下为目标转速 duty * MOTOR_MAX_RPM / 999，由下一次
+ *         Motor_Update() 调节到位
  */
 void Motor_SetSpeed(uint16_t duty);
 
+/**
+ * @brief  获取速度设定值
+ * @retval uint16_t: 设定值（0-999），自动模式下为电位器映射值
+ */
+uint16_t Motor_GetSetpoint(void);
+
+/**
+ * @brief  获取测速转速
+ * @retval uint16_t: 转速 (rpm)，未启用闭环或停转时为 0
+ */
+uint16_t Motor_GetRpm(void);
+
+/**
+ * @brief  测速输入捕获中断处理（TIM4_IRQHandler 中调用）
+ */
+void Motor_TachIRQHandler(void);
+
 /**
  * @brief  获取电位器 ADC 原始值
  * @retval uint16_t: 电位器 ADC 值（0-4095）
@@ -97,14 +133,12 @@ uint16_t Motor_GetPotValue(void);
 uint16_t Motor_GetCurrentSpeed(void);
 
 /**
- * @brief  周期性更新电机速度（自动模式）
- * @note   应在主循环或定时任务中调用（建议周期 50-100ms）
- * @note   仅在自动模式下生效，根据电位器值实时调速
- * @note   手动模式下调用无效果
+ * @brief  周期性更新电机速度
+ * @note   由输出控制任务以 MOTOR_CONTROL_PERIOD_MS 固定周期调用
  * @note   工作流程：
- *         1. 读取电位器 ADC 值
- *         2. 映射到 PWM 占空比（0-999）
- *         3. 更新硬件 PWM 输出
+ *         1. 自动模式下读取电位器 ADC 值，映射为设定值（0-999）
+ *         2. 开环：设定值直接作为 PWM 占空比
+ *         3. 闭环：设定值作为前馈，叠加转速误差的 PID 修正（带抗积分饱和）
  */
 void Motor_Update(void);
 
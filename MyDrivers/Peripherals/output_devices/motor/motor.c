@@ -3,7 +3,9 @@
  * @file    motor.c
  * @brief   直流电机驱动实现
  * @details 基于 STM32 TIM1 PWM 输出控制直流电机速度
- *          通过 ADC DMA 采集电位器值，实现自动调速功能
+ *          通过 ADC 采样服务读取电位器滤波值，实现自动调速功能
+ *          闭环模式下 TIM4_CH1 输入捕获测量测速脉冲周期 (1MHz 计数，
+ *          溢出中断扩展为 32 位)，Motor_Update 中做定点 PID
  * @author  EnviroSense Team
  * @date    2025
  ******************************************************************************
@@ -12,17 +14,14 @@
 #include "motor.h"
 #include "adc.h"
 #include "tim.h"
+#include "adc_manager.h"
+#include "energy_meter.h"
 
 #define LOG_MODULE "MOTOR"
 #include "log.h"
 
 /* ==================== 外部引用 ==================== */
 
-/**
- * @brief ADC1 句柄（在 CubeMX 生成的 adc.c 中定义）
- */
-extern ADC_HandleTypeDef hadc1;
-
 /**
  * @brief TIM1 句柄（在 CubeMX 生成的 tim.c 中定义）
  */
@@ -30,14 +29,6 @@ extern TIM_HandleTypeDef htim1;
 
 /* ==================== 静态变量 ==================== */
 
-/**
- * @brief ADC DMA 采集缓冲区
- * @note  [0] = 传感器通道（如 MQ-2 烟雾传感器）
- * @note  [1] = 电位器通道（用于电机速度控制）
- * @note  DMA 循环模式，数据自动更新
- */
-extern uint16_t adc_dma_buffer[];
-
 /**
  * @brief 当前控制模式
  * @note  默认为自动模式（跟随电位器）
@@ -50,6 +41,28 @@ static Motor_Control_Mode_t s_control_mode = MOTOR_MODE_AUTO;
  */
 static uint16_t s_current_pwm_duty = 0;
 
+/**
+ * @brief 速度设定值（0-999）
+ */
+static uint16_t s_setpoint = 0;
+
+#if MOTOR_CLOSED_LOOP
+/**
+ * @brief 测速状态（由 TIM4 中断更新）
+ */
+static volatile uint32_t s_tach_period_us = 0;  /**< 最近一个脉冲周期 */
+static volatile uint32_t s_tach_last_tick = 0;  /**< 最近一个脉冲的 HAL tick */
+static uint32_t s_tach_overflow = 0;            /**< 计数器溢出次数（高 16 位） */
+static uint32_t s_tach_last_capture = 0;        /**< 上一个脉冲的 32 位捕获值 */
+
+/**
+ * @brief PID 状态
+ */
+static uint16_t s_rpm = 0;
+static int32_t s_pid_integral = 0;      /**< 积分项（占空比，Q10） */
+static int32_t s_pid_prev_error = 0;
+#endif
+
 /* ==================== 私有函数 ==================== */
 
 /**
@@ -86,11 +99,104 @@ static void motor_set_pwm_hw(uint16_t duty)
     
     /* 更新 TIM1 通道 1 的比较值（CCR 寄存器） */
     __HAL_TIM_SET_COMPARE(&htim1, TIM_CHANNEL_1, duty);
+    Energy_SetLevel(ENERGY_RAIL_MOTOR, (uint16_t)(duty * 1000U / 999U));
     
     /* 更新内部缓存 */
     s_current_pwm_duty = duty;
 }
 
+#if MOTOR_CLOSED_LOOP
+/**
+ * @brief 初始化测速输入捕获（PD12 / TIM4_CH1，1MHz 计数）
+ */
+static void motor_tach_init(void)
+{
+    GPIO_InitTypeDef gpio = {0};
+    
+    __HAL_RCC_GPIOD_CLK_ENABLE();
+    __HAL_RCC_TIM4_CLK_ENABLE();
+    
+    gpio.Pin = GPIO_PIN_12;
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_PULLUP;    /* FG 多为集电极开路输出 */
+    gpio.Speed = GPIO_SPEED_FREQ_LOW;
+    gpio.Alternate = GPIO_AF2_TIM4;
+    HAL_GPIO_Init(GPIOD, &gpio);
+    
+    TIM4->PSC = 84 - 1;         /* APB1 定时器时钟 84MHz -> 1MHz */
+    TIM4->ARR = 0xFFFF;
+    TIM4->CCMR1 = TIM_CCMR1_CC1S_0 |                    /* CC1 输入，映射到 TI1 */
+                  (0x3U << TIM_CCMR1_IC1F_Pos);         /* 滤波 fCK_INT, N=8 */
+    TIM4->CCER = TIM_CCER_CC1E;                         /* 上升沿捕获 */
+    TIM4->EGR = TIM_EGR_UG;
+    TIM4->SR = 0;
+    TIM4->DIER = TIM_DIER_CC1IE | TIM_DIER_UIE;
+    TIM4->CR1 = TIM_CR1_CEN;
+    
+    HAL_NVIC_SetPriority(TIM4_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(TIM4_IRQn);
+}
+
+/**
+ * @brief 由最近一个脉冲周期计算转速
+ */
+static uint16_t motor_tach_rpm(void)
+{
+    uint32_t period;
+    uint32_t last;
+    uint32_t primask = __get_PRIMASK();
+    
+    __disable_irq();
+    period = s_tach_period_us;
+    last = s_tach_last_tick;
+    __set_PRIMASK(primask);
+    
+    if (period == 0 || HAL_GetTick() - last > MOTOR_TACH_TIMEOUT_MS) {
+        return 0;   /* 停转或未接测速信号 */
+    }
+    return (uint16_t)(60000000UL / (period * MOTOR_TACH_PULSES_PER_REV));
+}
+
+/**
+ * @brief PID 一步：设定值作为前馈，叠加转速误差修正
+ * @note  输出已饱和且误差继续推向饱和方向时不再积分（抗积分饱和）
+ */
+static void motor_pid_step(void)
+{
+    int32_t target = (int32_t)s_setpoint * MOTOR_MAX_RPM / 999;
+    int32_t error;
+    int32_t out;
+    
+    /* 测速反馈做一阶低通，抑制单个脉冲周期的抖动 */
+    s_rpm = (uint16_t)((s_rpm * 3 + motor_tach_rpm()) / 4);
+    
+    if (s_setpoint == 0) {
+        s_pid_integral = 0;
+        s_pid_prev_error = 0;
+        motor_set_pwm_hw(0);
+        return;
+    }
+    
+    error = target - (int32_t)s_rpm;
+    out = ((int32_t)s_setpoint << 10) +
+          MOTOR_PID_KP * error +
+          s_pid_integral +
+          MOTOR_PID_KD * (error - s_pid_prev_error);
+    s_pid_prev_error = error;
+    
+    if (!((out >= (999L << 10) && error > 0) || (out <= 0 && error < 0))) {
+        s_pid_integral += MOTOR_PID_KI * error;
+        if (s_pid_integral > MOTOR_PID_I_LIMIT) s_pid_integral = MOTOR_PID_I_LIMIT;
+        if (s_pid_integral < -MOTOR_PID_I_LIMIT) s_pid_integral = -MOTOR_PID_I_LIMIT;
+    }
+    
+    out >>= 10;
+    if (out < 0) out = 0;
+    if (out > 999) out = 999;
+    motor_set_pwm_hw((uint16_t)out);
+}
+#endif
+
 /* ==================== 公共函数实现 ==================== */
 
 /**
@@ -98,11 +204,11 @@ static void motor_set_pwm_hw(uint16_t duty)
  */
 Motor_Status_t Motor_Init(void)
 {
-    /* 启动 ADC DMA 连续采集（2 通道：传感器 + 电位器） */
-    // if (HAL_ADC_Start_DMA(&hadc1, (uint32_t*)adc_dma_buffer, 2) != HAL_OK) {
-    //     LOG_ERROR("电机 ADC DMA 启动失败");
-    //     return MOTOR_ERROR;
-    // }
+    /* 确保 ADC 连续采样已启动（已启动时直接返回） */
+    if (!ADC_Manager_Init()) {
+        LOG_ERROR("电机 ADC 采样启动失败");
+        return MOTOR_ERROR;
+    }
     
     /* 启动 TIM1 通道 1 的 PWM 输出 */
     if (HAL_TIM_PWM_Start(&htim1, TIM_CHANNEL_1) != HAL_OK) {
@@ -110,6 +216,10 @@ Motor_Status_t Motor_Init(void)
         return MOTOR_ERROR;
     }
     
+#if MOTOR_CLOSED_LOOP
+    motor_tach_init();
+#endif
+    
     /* 设置默认控制模式为自动 */
     s_control_mode = MOTOR_MODE_AUTO;
     
@@ -142,13 +252,16 @@ Motor_Control_Mode_t Motor_GetControlMode(void)
 }
 
 /**
- * @brief 手动设置速度（仅手动模式生效）
+ * @brief 手动设置速度（手动/通风模式生效）
  */
 void Motor_SetSpeed(uint16_t duty)
 {
-    /* 只有在手动模式下才允许设置速度 */
-    if (s_control_mode == MOTOR_MODE_MANUAL) {
-        motor_set_pwm_hw(duty);
+    /* 自动模式下速度跟随电位器，其余模式由软件设置 */
+    if (s_control_mode != MOTOR_MODE_AUTO) {
+        s_setpoint = (duty > 999) ? 999 : duty;
+#if !MOTOR_CLOSED_LOOP
+        motor_set_pwm_hw(s_setpoint);
+#endif
     }
     /* 自动模式下忽略此调用（会被电位器值覆盖） */
 }
@@ -158,8 +271,8 @@ void Motor_SetSpeed(uint16_t duty)
  */
 uint16_t Motor_GetPotValue(void)
 {
-    /* 返回 DMA 缓冲区中的电位器通道数据 */
-    return adc_dma_buffer[1];
+    /* 返回 ADC 采样服务发布的电位器滤波值 */
+    return ADC_Manager_GetValue(ADC_MANAGER_CH_POT);
 }
 
 /**
@@ -171,33 +284,72 @@ uint16_t Motor_GetCurrentSpeed(void)
 }
 
 /**
- * @brief 周期性更新电机速度（自动模式）
+ * @brief 获取速度设定值
+ */
+uint16_t Motor_GetSetpoint(void)
+{
+    return s_setpoint;
+}
+
+/**
+ * @brief 获取测速转速
+ */
+uint16_t Motor_GetRpm(void)
+{
+#if MOTOR_CLOSED_LOOP
+    return s_rpm;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * @brief 测速输入捕获中断
+ * @note  捕获与溢出同时挂起时，捕获值较小说明捕获发生在溢出之后
+ */
+void Motor_TachIRQHandler(void)
+{
+#if MOTOR_CLOSED_LOOP
+    uint32_t sr = TIM4->SR;
+    
+    if (sr & TIM_SR_CC1IF) {
+        uint32_t ccr = TIM4->CCR1;  /* 读取 CCR1 清除 CC1IF */
+        uint32_t ovf = s_tach_overflow;
+        uint32_t now;
+        
+        if ((sr & TIM_SR_UIF) && ccr < 0x8000) {
+            ovf++;
+        }
+        now = (ovf << 16) | ccr;
+        s_tach_period_us = now - s_tach_last_capture;
+        s_tach_last_capture = now;
+        s_tach_last_tick = HAL_GetTick();
+    }
+    if (sr & TIM_SR_UIF) {
+        TIM4->SR = (uint32_t)~TIM_SR_UIF;
+        s_tach_overflow++;
+    }
+#endif
+}
+
+/**
+ * @brief 周期性更新电机速度
  * 
- * @note 建议在 FreeRTOS 任务中以 50-100ms 周期调用
- * @note 示例：
- *       @code
- *       void MotorControlTask(void const *argument)
- *       {
- *           for(;;)
- *           {
- *               Motor_Update();
- *               osDelay(100);
- *           }
- *       }
- *       @endcode
+ * @note 由输出控制任务以 MOTOR_CONTROL_PERIOD_MS 固定周期调用
  */
 void Motor_Update(void)
 {
-    /* 读取电位器 ADC 值（DMA 自动更新） */
-    uint16_t pot_value = Motor_GetPotValue();
+    /* 自动模式：电位器值作为设定值（DMA 自动更新） */
+    if (s_control_mode == MOTOR_MODE_AUTO) {
+        s_setpoint = map_adc_to_pwm(Motor_GetPotValue());
+    }
     
-    /* 仅在自动模式下更新速度 */
+#if MOTOR_CLOSED_LOOP
+    motor_pid_step();
+#else
     if (s_control_mode == MOTOR_MODE_AUTO) {
-        /* 将 ADC 值映射到 PWM 占空比 */
-        uint16_t new_duty = map_adc_to_pwm(pot_value);
-        
-        /* 更新硬件 PWM 输出 */
-        motor_set_pwm_hw(new_duty);
+        /* 开环：设定值直接作为 PWM 输出 */
+        motor_set_pwm_hw(s_setpoint);
     }
-    /* 手动模式下不做任何操作 */
+#endif
 }
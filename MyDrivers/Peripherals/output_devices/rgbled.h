@@ -54,7 +54,7 @@ RGB_LED_Status_t RGB_LED_Init(void);
  * @param  r: 红色分量 (0-255)
  * @param  g: 绿色分量 (0-255)
  * @param  b: 蓝色分量 (0-255)
- * @note   实际输出会根据全局亮度设置进行缩放
+ * @note   实际输出会根据全局亮度设置进行缩放，并经过伽马校正
  * @note   支持共阳/共阴 LED（通过 LED_TYPE_COMMON_ANODE 宏控制）
  */
 void RGB_LED_SetColor(uint8_t r, uint8_t g, uint8_t b);
@@ -75,6 +75,24 @@ void RGB_LED_SetColorStruct(RGB_Color color);
  */
 void RGB_LED_SetBrightness(uint8_t brightness);
 
+/**
+ * @brief  渐变到指定颜色与亮度
+ * @param  color: 目标颜色
+ * @param  brightness: 目标全局亮度 (0-255)
+ * @param  duration_ms: 渐变时长 (ms)，过短时立即设置
+ * @note   每个 PWM 周期 (1kHz) 一步，由 DMA 突发写入 CCR，渐变期间不占用 CPU
+ * @note   立即返回；GetCurrentColor/GetBrightness 返回目标值
+ * @note   渐变期间调用 SetColor/SetBrightness/Off 会打断渐变，再次调用
+ *         FadeTo 从当前输出值开始新的渐变
+ */
+void RGB_LED_FadeTo(RGB_Color color, uint8_t brightness, uint16_t duration_ms);
+
+/**
+ * @brief  查询是否正在渐变
+ * @retval true: 渐变进行中
+ */
+bool RGB_LED_IsFading(void);
+
 /**
  * @brief  关闭 RGB LED
  * @note   等效于 RGB_LED_SetColor(0, 0, 0)
@@ -103,10 +121,24 @@ uint8_t RGB_LED_GetBrightness(void);
  * @param  v: 明度 (0-255)
  * @retval RGB_Color 结构体
  * @note   用于实现彩虹渐变、呼吸灯等效果
- * @note   算法基于标准 HSV 到 RGB 转换公式
+ * @note   整数实现：区间内位置查表，区间选择查表代替分支，适合在触摸
+ *         拖动事件中逐次调用
  */
 RGB_Color HSV_to_RGB(uint16_t h, uint8_t s, uint8_t v);
 
+/**
+ * @brief  批量生成等间隔色相的调色板
+ * @param  h_start: 起始色相 (度)
+ * @param  h_step: 色相间隔 (度)
+ * @param  s: 饱和度 (0-255)
+ * @param  v: 明度 (0-255)
+ * @param  out: 输出数组
+ * @param  count: 颜色数量
+ * @note   示例：生成 12 色色轮 HSV_to_RGB_Palette(0, 30, 255, 255, colors, 12)
+ */
+void HSV_to_RGB_Palette(uint16_t h_start, uint16_t h_step, uint8_t s, uint8_t v,
+                        RGB_Color *out, uint16_t count);
+
 /* ==================== 预定义颜色常量 ==================== */
 
 /**
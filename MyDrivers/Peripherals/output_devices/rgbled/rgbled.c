@@ -4,6 +4,9 @@
  * @brief   RGB LED 驱动实现
  * @details 基于 STM32 TIM2 PWM 输出控制 RGB LED 三通道
  *          支持颜色设置、亮度调节、HSV 转换等功能
+ *          输出经过伽马校正查找表；渐变由 TIM2 更新事件触发 DMA 突发传输
+ *          (DMAR)，每个 PWM 周期从环形缓冲区写入三个 CCR，CPU 只在半缓冲区
+ *          中断中批量填充后续步进值
  * @author  MmsY
  * @date    2025
  ******************************************************************************
@@ -11,6 +14,7 @@
 
 #include "rgbled.h"
 #include "tim.h"
+#include <string.h>
 
 #define LOG_MODULE "RGB_LED"
 #include "log.h"
@@ -24,10 +28,26 @@
  */
 #define LED_TYPE_COMMON_ANODE 0
 
+/**
+ * @brief 伽马校正开关
+ * @note  1 = 颜色值按感知亮度 (gamma 2.2) 映射到占空比
+ */
+#define LED_GAMMA_CORRECTION 1
+
+/**
+ * @brief 渐变 DMA：TIM2_UP 请求映射到 DMA1 Stream1 通道 3
+ */
+#define LED_FADE_DMA_STREAM   DMA1_Stream1
+#define LED_FADE_DMA_CHANNEL  DMA_CHANNEL_3
+#define LED_FADE_DMA_IRQn     DMA1_Stream1_IRQn
+#define LED_FADE_HALF_STEPS   32    /**< 半个环形缓冲区的步数 (PWM 周期) */
+#define LED_FADE_STEPS        (LED_FADE_HALF_STEPS * 2)
+
 /* ==================== 静态变量 ==================== */
 
 /**
  * @brief 当前颜色缓存（原始值，未经亮度缩放）
+ * @note  渐变期间为目标颜色
  */
 static RGB_Color s_current_color = {0, 0, 0};
 
@@ -37,6 +57,232 @@ static RGB_Color s_current_color = {0, 0, 0};
  */
 static uint8_t s_global_brightness = 255;
 
+/**
+ * @brief 伽马校正表：0-255 颜色值 -> 12 位线性占空比 (round(4095 * (i/255)^2.2))
+ */
+static const uint16_t s_gamma_table[256] = {
+       0,    0,    0,    0,    0,    1,    1,    2,    2,    3,    3,    4,
+       5,    6,    7,    8,    9,   11,   12,   14,   15,   17,   19,   21,
+      23,   25,   27,   29,   32,   34,   37,   40,   43,   46,   49,   52,
+      55,   59,   62,   66,   70,   73,   77,   82,   86,   90,   95,   99,
+     104,  109,  114,  119,  124,  129,  135,  140,  146,  152,  158,  164,
+     170,  176,  182,  189,  196,  202,  209,  216,  224,  231,  238,  246,
+     254,  261,  269,  277,  286,  294,  302,  311,  320,  328,  337,  347,
+     356,  365,  375,  384,  394,  404,  414,  424,  435,  445,  456,  467,
+     477,  488,  500,  511,  522,  534,  545,  557,  569,  581,  594,  606,
+     619,  631,  644,  657,  670,  683,  697,  710,  724,  738,  752,  766,
+     780,  794,  809,  823,  838,  853,  868,  884,  899,  914,  930,  946,
+     962,  978,  994, 1011, 1027, 1044, 1061, 1078, 1095, 1112, 1130, 1147,
+    1165, 1183, 1201, 1219, 1237, 1256, 1274, 1293, 1312, 1331, 1350, 1370,
+    1389, 1409, 1429, 1449, 1469, 1489, 1509, 1530, 1551, 1572, 1593, 1614,
+    1635, 1657, 1678, 1700, 1722, 1744, 1766, 1789, 1811, 1834, 1857, 1880,
+    1903, 1926, 1950, 1974, 1997, 2021, 2045, 2070, 2094, 2119, 2143, 2168,
+    2193, 2219, 2244, 2270, 2295, 2321, 2347, 2373, 2400, 2426, 2453, 2479,
+    2506, 2534, 2561, 2588, 2616, 2644, 2671, 2700, 2728, 2756, 2785, 2813,
+    2842, 2871, 2900, 2930, 2959, 2989, 3019, 3049, 3079, 3109, 3140, 3170,
+    3201, 3232, 3263, 3295, 3326, 3358, 3390, 3421, 3454, 3486, 3518, 3551,
+    3584, 3617, 3650, 3683, 3716, 3750, 3784, 3818, 3852, 3886, 3920, 3955,
+    3990, 4025, 4060, 4095
+};
+
+/**
+ * @brief 颜色值 -> CCR 查找表（初始化时按 ARR 生成，含伽马与共阳极反相）
+ */
+static uint16_t s_duty_table[256];
+
+/**
+ * @brief 当前输出的三通道颜色值（已含亮度缩放，渐变起点）
+ */
+static uint8_t s_level[3];
+
+/**
+ * @brief 渐变 DMA 缓冲区：每步三个字依次写入 CCR1-CCR3
+ * @note  s_fade_level 记录每步对应的颜色值，用于打断渐变时确定起点
+ */
+static uint32_t s_fade_buf[LED_FADE_STEPS][3];
+static uint8_t s_fade_level[LED_FADE_STEPS][3];
+
+/**
+ * @brief 渐变状态（任务与 DMA 中断共享）
+ */
+static struct {
+    volatile bool active;   /**< 渐变进行中 */
+    uint8_t from[3];        /**< 起点颜色值 */
+    uint8_t to[3];          /**< 终点颜色值 */
+    uint32_t step;          /**< 已填充的步数 */
+    uint32_t total;         /**< 总步数 */
+    uint8_t tail;           /**< 到达终点后又填充的半缓冲区数 */
+    bool wrapped;           /**< DMA 已至少完整发送一轮缓冲区 */
+} s_fade;
+
+static uint32_t s_pwm_hz;   /**< PWM 频率 (Hz)，即每秒步数 */
+
+DMA_HandleTypeDef hdma_rgbled;
+
+/* ==================== 私有函数 ==================== */
+
+/**
+ * @brief 按当前 ARR 生成颜色值 -> CCR 查找表
+ */
+static void led_build_duty_table(void)
+{
+    uint32_t max_pwm = __HAL_TIM_GET_AUTORELOAD(&htim2);
+    
+    for (uint16_t i = 0; i < 256; i++) {
+#if LED_GAMMA_CORRECTION
+        uint32_t duty = (s_gamma_table[i] * max_pwm + 2047) / 4095;
+#else
+        uint32_t duty = (i * max_pwm) / 255;
+#endif
+        /* 如果是共阳极 LED，需要反相 PWM（高电平=灭，低电平=亮） */
+        if (LED_TYPE_COMMON_ANODE) {
+            duty = max_pwm - duty;
+        }
+        s_duty_table[i] = (uint16_t)duty;
+    }
+}
+
+/**
+ * @brief 计算亮度缩放后的三通道颜色值
+ */
+static void led_scale(RGB_Color color, uint8_t brightness, uint8_t level[3])
+{
+    /* 避免浮点运算，使用整数除法 */
+    level[0] = (uint8_t)((color.R * brightness) / 255);
+    level[1] = (uint8_t)((color.G * brightness) / 255);
+    level[2] = (uint8_t)((color.B * brightness) / 255);
+}
+
+/**
+ * @brief 立即输出三通道颜色值
+ */
+static void led_write(const uint8_t level[3])
+{
+    /* 更新 PWM 比较寄存器（预装载，下一个周期生效） */
+    __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_1, s_duty_table[level[0]]);  /* R 通道 */
+    __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_2, s_duty_table[level[1]]);  /* G 通道 */
+    __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_3, s_duty_table[level[2]]);  /* B 通道 */
+    s_level[0] = level[0];
+    s_level[1] = level[1];
+    s_level[2] = level[2];
+}
+
+/**
+ * @brief 填充 DMA 缓冲区的一半（或启动时整个缓冲区）
+ * @param first: 起始步序号
+ * @param count: 步数
+ */
+static void led_fade_fill(uint16_t first, uint16_t count)
+{
+    for (uint16_t i = first; i < first + count; i++) {
+        if (s_fade.step < s_fade.total) {
+            s_fade.step++;
+        }
+        for (uint8_t ch = 0; ch < 3; ch++) {
+            int32_t diff = (int32_t)s_fade.to[ch] - s_fade.from[ch];
+            uint8_t level = (uint8_t)(s_fade.from[ch] +
+                                      diff * (int32_t)s_fade.step / (int32_t)s_fade.total);
+            s_fade_level[i][ch] = level;
+            s_fade_buf[i][ch] = s_duty_table[level];
+        }
+    }
+    if (s_fade.step >= s_fade.total) {
+        s_fade.tail++;
+    }
+}
+
+/**
+ * @brief 渐变 DMA 半缓冲区/全缓冲区中断：填充刚发送完的一半
+ * @note  终点值填满两个半缓冲区后停止 DMA 请求，CCR 保持终点值
+ */
+static void led_fade_refill(uint16_t first)
+{
+    if (!s_fade.active) {
+        return;
+    }
+    if (s_fade.tail >= 2) {
+        __HAL_TIM_DISABLE_DMA(&htim2, TIM_DMA_UPDATE);
+        s_level[0] = s_fade.to[0];
+        s_level[1] = s_fade.to[1];
+        s_level[2] = s_fade.to[2];
+        s_fade.active = false;
+        return;
+    }
+    led_fade_fill(first, LED_FADE_HALF_STEPS);
+}
+
+static void led_fade_half_cplt(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    led_fade_refill(0);
+}
+
+static void led_fade_cplt(DMA_HandleTypeDef *hdma)
+{
+    (void)hdma;
+    s_fade.wrapped = true;
+    led_fade_refill(LED_FADE_HALF_STEPS);
+}
+
+/**
+ * @brief 停止渐变，s_level 更新为 DMA 最近写入的颜色值
+ * @note  须在关中断下调用
+ */
+static void led_fade_stop(void)
+{
+    if (s_fade.active) {
+        uint32_t sent = LED_FADE_STEPS * 3 - __HAL_DMA_GET_COUNTER(&hdma_rgbled);
+        uint16_t index = (uint16_t)((sent + LED_FADE_STEPS * 3 - 1) / 3) % LED_FADE_STEPS;
+        
+        __HAL_TIM_DISABLE_DMA(&htim2, TIM_DMA_UPDATE);
+        if (!s_fade.wrapped && sent < 3) {
+            /* 尚未输出第一步：保持渐变前的输出 */
+        } else {
+            s_level[0] = s_fade_level[index][0];
+            s_level[1] = s_fade_level[index][1];
+            s_level[2] = s_fade_level[index][2];
+        }
+        s_fade.active = false;
+    }
+    if (hdma_rgbled.State != HAL_DMA_STATE_READY) {
+        HAL_DMA_Abort(&hdma_rgbled);
+    }
+}
+
+/**
+ * @brief 初始化渐变 DMA（TIM2 更新事件 -> DMAR 突发写 CCR1-CCR3）
+ */
+static bool led_fade_init(void)
+{
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    
+    hdma_rgbled.Instance = LED_FADE_DMA_STREAM;
+    hdma_rgbled.Init.Channel = LED_FADE_DMA_CHANNEL;
+    hdma_rgbled.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_rgbled.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_rgbled.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_rgbled.Init.PeriphDataAlignment = DMA_PDATAALIGN_WORD;
+    hdma_rgbled.Init.MemDataAlignment = DMA_MDATAALIGN_WORD;
+    hdma_rgbled.Init.Mode = DMA_CIRCULAR;
+    hdma_rgbled.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_rgbled.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_rgbled) != HAL_OK) {
+        return false;
+    }
+    hdma_rgbled.XferHalfCpltCallback = led_fade_half_cplt;
+    hdma_rgbled.XferCpltCallback = led_fade_cplt;
+    
+    /* 每个更新事件突发 3 次传输，从 CCR1 开始 */
+    htim2.Instance->DCR = TIM_DMABASE_CCR1 | TIM_DMABURSTLENGTH_3TRANSFERS;
+    
+    s_pwm_hz = HAL_RCC_GetPCLK1Freq() * 2 / (htim2.Instance->PSC + 1) /
+               (__HAL_TIM_GET_AUTORELOAD(&htim2) + 1);
+    
+    HAL_NVIC_SetPriority(LED_FADE_DMA_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(LED_FADE_DMA_IRQn);
+    return true;
+}
+
 /* ==================== 公共函数实现 ==================== */
 
 /**
@@ -52,6 +298,12 @@ RGB_LED_Status_t RGB_LED_Init(void)
         return RGB_LED_ERROR;
     }
     
+    led_build_duty_table();
+    if (!led_fade_init()) {
+        LOG_ERROR("RGB LED 渐变 DMA 初始化失败");
+        return RGB_LED_ERROR;
+    }
+    
     /* 初始状态设为关闭 */
     RGB_LED_Off();
     LOG_INFO("RGB LED初始化完成");
@@ -63,35 +315,22 @@ RGB_LED_Status_t RGB_LED_Init(void)
  */
 void RGB_LED_SetColor(uint8_t r, uint8_t g, uint8_t b)
 {
+    uint8_t level[3];
+    uint32_t primask = __get_PRIMASK();
+    
     /* 保存原始颜色值（供后续亮度调节使用） */
     s_current_color.R = r;
     s_current_color.G = g;
     s_current_color.B = b;
     
-    /* 应用全局亮度缩放（避免浮点运算，使用整数除法） */
-    uint16_t red   = (r * s_global_brightness) / 255;
-    uint16_t green = (g * s_global_brightness) / 255;
-    uint16_t blue  = (b * s_global_brightness) / 255;
-    
-    /* 获取 PWM 最大计数值（ARR 寄存器值） */
-    uint16_t max_pwm = __HAL_TIM_GET_AUTORELOAD(&htim2);
+    /* 应用全局亮度缩放 */
+    led_scale(s_current_color, s_global_brightness, level);
     
-    /* 将 0-255 颜色值映射到 PWM 占空比 */
-    uint16_t pwm_r = (red   * max_pwm) / 255;
-    uint16_t pwm_g = (green * max_pwm) / 255;
-    uint16_t pwm_b = (blue  * max_pwm) / 255;
-    
-    /* 如果是共阳极 LED，需要反相 PWM（高电平=灭，低电平=亮） */
-    if (LED_TYPE_COMMON_ANODE) {
-        pwm_r = max_pwm - pwm_r;
-        pwm_g = max_pwm - pwm_g;
-        pwm_b = max_pwm - pwm_b;
-    }
-    
-    /* 更新 PWM 比较寄存器（立即生效） */
-    __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_1, pwm_r);  /* R 通道 */
-    __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_2, pwm_g);  /* G 通道 */
-    __HAL_TIM_SET_COMPARE(&htim2, TIM_CHANNEL_3, pwm_b);  /* B 通道 */
+    /* 打断正在进行的渐变，立即输出 */
+    __disable_irq();
+    led_fade_stop();
+    led_write(level);
+    __set_PRIMASK(primask);
 }
 
 /**
@@ -114,6 +353,50 @@ void RGB_LED_SetBrightness(uint8_t brightness)
     RGB_LED_SetColor(s_current_color.R, s_current_color.G, s_current_color.B);
 }
 
+/**
+ * @brief 渐变到指定颜色与亮度
+ * @note  步数 = 时长 x PWM 频率，每步颜色值线性插值后查伽马表
+ */
+void RGB_LED_FadeTo(RGB_Color color, uint8_t brightness, uint16_t duration_ms)
+{
+    uint32_t total = (uint32_t)duration_ms * s_pwm_hz / 1000;
+    uint32_t primask;
+    
+    if (total < 2) {
+        s_global_brightness = brightness;
+        RGB_LED_SetColorStruct(color);
+        return;
+    }
+    
+    primask = __get_PRIMASK();
+    __disable_irq();
+    led_fade_stop();
+    
+    s_current_color = color;
+    s_global_brightness = brightness;
+    memcpy(s_fade.from, s_level, sizeof(s_fade.from));
+    led_scale(color, brightness, s_fade.to);
+    s_fade.step = 0;
+    s_fade.total = total;
+    s_fade.tail = 0;
+    s_fade.wrapped = false;
+    led_fade_fill(0, LED_FADE_STEPS);
+    s_fade.active = true;
+    
+    HAL_DMA_Start_IT(&hdma_rgbled, (uint32_t)s_fade_buf,
+                     (uint32_t)&htim2.Instance->DMAR, LED_FADE_STEPS * 3);
+    __HAL_TIM_ENABLE_DMA(&htim2, TIM_DMA_UPDATE);
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 查询是否正在渐变
+ */
+bool RGB_LED_IsFading(void)
+{
+    return s_fade.active;
+}
+
 /**
  * @brief 关闭 LED
  */
@@ -138,43 +421,107 @@ uint8_t RGB_LED_GetBrightness(void)
     return s_global_brightness;
 }
 
+/**
+ * @brief 色相区间内的 0-255 斜坡：s_hue_ramp[i] = round(i * 255 / 60)
+ */
+static const uint8_t s_hue_ramp[60] = {
+      0,   4,   9,  13,  17,  21,  26,  30,  34,  38,  43,  47,  51,  55,  60,
+     64,  68,  72,  77,  81,  85,  89,  94,  98, 102, 106, 111, 115, 119, 123,
+    128, 132, 136, 140, 145, 149, 153, 157, 162, 166, 170, 174, 179, 183, 187,
+    191, 196, 200, 204, 208, 213, 217, 221, 225, 230, 234, 238, 242, 247, 251
+};
+
+/**
+ * @brief 各色相区间的 R/G/B 取值来源（0=v，1=q 递减，2=t 递增，3=p 最小）
+ */
+static const uint8_t s_hue_select[6][3] = {
+    {0, 2, 3},  /* 红 -> 黄 */
+    {1, 0, 3},  /* 黄 -> 绿 */
+    {3, 0, 2},  /* 绿 -> 青 */
+    {3, 1, 0},  /* 青 -> 蓝 */
+    {2, 3, 0},  /* 蓝 -> 洋红 */
+    {0, 3, 1}   /* 洋红 -> 红 */
+};
+
+/**
+ * @brief 两个 0-255 值相乘再除以 255（四舍五入，结果与浮点计算一致）
+ */
+static inline uint8_t mul_div255(uint8_t a, uint8_t b)
+{
+    uint32_t x = (uint32_t)a * b + 128;
+    return (uint8_t)((x + (x >> 8)) >> 8);
+}
+
+/**
+ * @brief 已知区间与区间内位置的 HSV 转换（无分支查表）
+ * @param region: 色相区间 (0-5)
+ * @param f: 区间内位置 (0-255)
+ */
+static inline RGB_Color hsv_convert(uint8_t region, uint8_t f, uint8_t s, uint8_t v)
+{
+    uint8_t val[4];
+    RGB_Color rgb;
+    const uint8_t *sel = s_hue_select[region];
+    
+    val[0] = v;
+    val[1] = mul_div255(v, 255 - mul_div255(s, f));          /* 递减值 */
+    val[2] = mul_div255(v, 255 - mul_div255(s, 255 - f));    /* 递增值 */
+    val[3] = mul_div255(v, 255 - s);                         /* 最小亮度 */
+    
+    rgb.R = val[sel[0]];
+    rgb.G = val[sel[1]];
+    rgb.B = val[sel[2]];
+    return rgb;
+}
+
 /**
  * @brief HSV 转 RGB
- * @note  算法基于标准 HSV 色彩模型
- * @note  H(色相): 0-359 度，分为 6 个区间（红-黄-绿-青-蓝-洋红）
- * @note  S(饱和度): 0=灰色，255=纯色
+ * @note  算法基于标准 HSV 色彩模型，全整数运算
+ * @note  H(色相): 0-359 度，分为 6 个区间（红-黄-绿-青-蓝-洋红），超出时取模
+ * @note  S(饱和度): 0=灰色，255=纯色（s=0 时自然得到 R=G=B=v）
  * @note  V(明度): 0=黑色，255=最亮
+ * @note  区间号用乘法移位代替除法：(h * 1093) >> 16 == h / 60 (h < 360)
  */
 RGB_Color HSV_to_RGB(uint16_t h, uint8_t s, uint8_t v)
 {
-    RGB_Color rgb;
+    uint8_t region;
     
-    /* 特殊情况：饱和度为 0 时，输出灰度 */
-    if (s == 0) {
-        rgb.R = rgb.G = rgb.B = v;
-        return rgb;
+    if (h >= 360) {
+        h %= 360;
     }
+    region = (uint8_t)(((uint32_t)h * 1093) >> 16);
+    return hsv_convert(region, s_hue_ramp[h - region * 60], s, v);
+}
+
+/**
+ * @brief 批量生成等间隔色相的调色板
+ * @note  色相逐步累加并在区间内递进，循环中没有除法
+ */
+void HSV_to_RGB_Palette(uint16_t h_start, uint16_t h_step, uint8_t s, uint8_t v,
+                        RGB_Color *out, uint16_t count)
+{
+    uint8_t region;
+    uint16_t pos;
     
-    /* 计算色相所在的色轮区间 (0-5) */
-    uint8_t region = h / 60;
-    
-    /* 计算区间内的偏移量（0-255 范围内） */
-    uint8_t remainder = (h % 60) * 6;
-    
-    /* 计算三个中间值（使用位移避免浮点运算） */
-    uint8_t p = (v * (255 - s)) >> 8;                           /* 最小亮度 */
-    uint8_t q = (v * (255 - ((s * remainder) >> 8))) >> 8;       /* 递减值 */
-    uint8_t t = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8; /* 递增值 */
-    
-    /* 根据色相区间分配 RGB 值 */
-    switch (region) {
-        case 0: rgb.R = v; rgb.G = t; rgb.B = p; break;  /* 红 -> 黄 */
-        case 1: rgb.R = q; rgb.G = v; rgb.B = p; break;  /* 黄 -> 绿 */
-        case 2: rgb.R = p; rgb.G = v; rgb.B = t; break;  /* 绿 -> 青 */
-        case 3: rgb.R = p; rgb.G = q; rgb.B = v; break;  /* 青 -> 蓝 */
-        case 4: rgb.R = t; rgb.G = p; rgb.B = v; break;  /* 蓝 -> 洋红 */
-        default: rgb.R = v; rgb.G = p; rgb.B = q; break; /* 洋红 -> 红 */
+    if (out == NULL || count == 0) {
+        return;
     }
     
-    return rgb;
+    h_start %= 360;
+    h_step %= 360;
+    region = (uint8_t)(((uint32_t)h_start * 1093) >> 16);
+    pos = h_start - region * 60;
+    
+    for (uint16_t i = 0; i < count; i++) {
+        out[i] = hsv_convert(region, s_hue_ramp[pos], s, v);
+        
+        /* 前进 h_step 度：先进位到区间，再回绕色轮 */
+        pos += h_step;
+        while (pos >= 60) {
+            pos -= 60;
+            if (++region == 6) {
+                region = 0;
+            }
+        }
+    }
 }
@@ -0,0 +1,206 @@
+/**
+ ******************************************************************************
+ * @file    rs485.c
+ * @brief   RS-485 半双工收发驱动
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "rs485.h"
+#include <string.h>
+
+#define LOG_MODULE "RS485"
+#include "log.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+UART_HandleTypeDef huart3;
+static DMA_HandleTypeDef hdma_usart3_tx;
+
+static uint8_t s_rx_buf[RS485_FRAME_MAX];       // 接收中的帧 (中断写入)
+static uint8_t s_frame[RS485_FRAME_MAX];        // 已收完的帧，等待任务取走
+static volatile uint16_t s_frame_len = 0;       // 0 表示没有新帧
+static volatile bool s_tx_busy = false;
+static TaskHandle_t s_owner = NULL;
+static RS485_Stats_t s_stats;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static void rs485_set_tx(bool tx) {
+    HAL_GPIO_WritePin(RS485_DE_PORT, RS485_DE_PIN, tx ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+/**
+ * @brief 初始化引脚与 USART3
+ */
+static bool rs485_hw_init(uint32_t baudrate) {
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOB_CLK_ENABLE();
+    __HAL_RCC_GPIOG_CLK_ENABLE();
+    __HAL_RCC_USART3_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    gpio.Pin = GPIO_PIN_10 | GPIO_PIN_11;  /* USART3_TX / USART3_RX */
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_PULLUP;
+    gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+    gpio.Alternate = GPIO_AF7_USART3;
+    HAL_GPIO_Init(GPIOB, &gpio);
+
+    rs485_set_tx(false);                   /* 先置为接收，避免上电时占用总线 */
+    gpio.Pin = RS485_DE_PIN;
+    gpio.Mode = GPIO_MODE_OUTPUT_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_LOW;
+    gpio.Alternate = 0;
+    HAL_GPIO_Init(RS485_DE_PORT, &gpio);
+
+    /* USART3_TX: DMA1 Stream3 通道 4 */
+    hdma_usart3_tx.Instance = DMA1_Stream3;
+    hdma_usart3_tx.Init.Channel = DMA_CHANNEL_4;
+    hdma_usart3_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_usart3_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+    hdma_usart3_tx.Init.MemInc = DMA_MINC_ENABLE;
+    hdma_usart3_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_BYTE;
+    hdma_usart3_tx.Init.MemDataAlignment = DMA_MDATAALIGN_BYTE;
+    hdma_usart3_tx.Init.Mode = DMA_NORMAL;
+    hdma_usart3_tx.Init.Priority = DMA_PRIORITY_LOW;
+    hdma_usart3_tx.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    if (HAL_DMA_Init(&hdma_usart3_tx) != HAL_OK) {
+        return false;
+    }
+    __HAL_LINKDMA(&huart3, hdmatx, hdma_usart3_tx);
+
+    /* 9 位字长含校验位，即 8 数据位 + 偶校验 (Modbus RTU 缺省格式) */
+    huart3.Instance = USART3;
+    huart3.Init.BaudRate = baudrate;
+    huart3.Init.WordLength = UART_WORDLENGTH_9B;
+    huart3.Init.StopBits = UART_STOPBITS_1;
+    huart3.Init.Parity = UART_PARITY_EVEN;
+    huart3.Init.Mode = UART_MODE_TX_RX;
+    huart3.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+    huart3.Init.OverSampling = UART_OVERSAMPLING_16;
+    if (HAL_UART_Init(&huart3) != HAL_OK) {
+        return false;
+    }
+
+    HAL_NVIC_SetPriority(USART3_IRQn, RS485_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(USART3_IRQn);
+    HAL_NVIC_SetPriority(DMA1_Stream3_IRQn, RS485_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(DMA1_Stream3_IRQn);
+    return true;
+}
+
+static bool rs485_start_rx(void) {
+    return HAL_UARTEx_ReceiveToIdle_IT(&huart3, s_rx_buf, RS485_FRAME_MAX) == HAL_OK;
+}
+
+/**
+ * @brief 通知属主任务 (中断上下文)
+ */
+static void rs485_notify_owner(void) {
+    if (s_owner != NULL) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(s_owner, &woken);
+        portYIELD_FROM_ISR(woken);
+    }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+bool RS485_Init(uint32_t baudrate, TaskHandle_t owner) {
+    s_owner = owner;
+    if (!rs485_hw_init(baudrate) || !rs485_start_rx()) {
+        LOG_ERROR("USART3 初始化失败");
+        return false;
+    }
+    return true;
+}
+
+uint16_t RS485_Read(uint8_t *buf) {
+    uint16_t len;
+
+    taskENTER_CRITICAL();
+    len = s_frame_len;
+    if (len != 0) {
+        memcpy(buf, s_frame, len);
+        s_frame_len = 0;
+    }
+    taskEXIT_CRITICAL();
+    return len;
+}
+
+bool RS485_Write(const uint8_t *data, uint16_t len) {
+    if (s_tx_busy) {
+        return false;
+    }
+    s_tx_busy = true;
+    rs485_set_tx(true);
+    if (HAL_UART_Transmit_DMA(&huart3, (uint8_t *)data, len) != HAL_OK) {
+        rs485_set_tx(false);
+        s_tx_busy = false;
+        return false;
+    }
+    return true;
+}
+
+void RS485_GetStats(RS485_Stats_t *stats) {
+    *stats = s_stats;
+}
+
+void RS485_TxDmaIRQHandler(void) {
+    HAL_DMA_IRQHandler(&hdma_usart3_tx);
+}
+
+/* --------------------------- HAL 回调 --------------------------- */
+
+/**
+ * @brief 总线空闲或缓冲区满：整帧移交给任务并重新开始接收 (中断上下文)
+ */
+void RS485_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size) {
+    if (huart != &huart3) {
+        return;
+    }
+    if (size != 0) {
+        if (s_frame_len != 0) {
+            s_stats.rx_overruns++;
+        }
+        memcpy(s_frame, s_rx_buf, size);
+        s_frame_len = size;
+        s_stats.rx_frames++;
+    }
+    rs485_start_rx();
+    if (size != 0) {
+        rs485_notify_owner();
+    }
+}
+
+/**
+ * @brief 最后一个字节已移出：释放总线
+ */
+void RS485_TxCpltCallback(UART_HandleTypeDef *huart) {
+    if (huart != &huart3) {
+        return;
+    }
+    rs485_set_tx(false);
+    s_tx_busy = false;
+    s_stats.tx_frames++;
+}
+
+/**
+ * @brief UART 错误 (校验错误的帧整帧作废)：丢弃正在接收的数据并重新开始
+ */
+void RS485_ErrorCallback(UART_HandleTypeDef *huart) {
+    if (huart != &huart3) {
+        return;
+    }
+    s_stats.uart_errors++;
+    if (huart->gState == HAL_UART_STATE_READY && s_tx_busy) {
+        rs485_set_tx(false);
+        s_tx_busy = false;
+    }
+    if (huart->RxState == HAL_UART_STATE_READY) {
+        rs485_start_rx();
+    }
+}
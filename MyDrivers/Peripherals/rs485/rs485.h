@@ -0,0 +1,93 @@
+/**
+ ******************************************************************************
+ * @file    rs485.h
+ * @brief   RS-485 半双工收发驱动头文件
+ * @details 收发器接在 USART3：PB10 TX, PB11 RX，方向控制 (DE/RE) 接 PG8，
+ *          高电平发送、低电平接收。CubeMX 工程未配置 USART3，驱动自行初始化。
+ *            - 接收：中断 + 空闲检测 (ReceiveToIdle)，总线空闲 1 个字符时间
+ *              即认为一帧结束，整帧复制到帧缓冲区后通知属主任务；
+ *            - 发送：拉高 DE 后由 DMA1 Stream3 (通道 4) 发送，发送完成 (TC，
+ *              最后一个停止位已移出) 时在中断中拉低 DE，不需要任务参与切换
+ *              方向；发送期间 CPU 不参与，主站可在此期间解析上一帧应答。
+ *          USART3_RX 唯一可用的 DMA1 Stream1 已被 RGB 灯渐变占用，接收仍为
+ *          逐字节中断 (帧不超过 RS485_FRAME_MAX 字节，19200 bps 下约 2k 次/秒)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __RS485_H
+#define __RS485_H
+
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define RS485_FRAME_MAX     256         // 单帧最大长度 (Modbus RTU ADU 上限)
+#define RS485_DE_PORT       GPIOG
+#define RS485_DE_PIN        GPIO_PIN_8
+#define RS485_IRQ_PRIORITY  5           // 不高于 configMAX_SYSCALL_INTERRUPT_PRIORITY (USART3 与发送 DMA)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 驱动统计
+ */
+typedef struct {
+    uint32_t rx_frames;     // 收到的帧数
+    uint32_t rx_overruns;   // 上一帧未被取走即被新帧覆盖的次数
+    uint32_t tx_frames;     // 发出的帧数
+    uint32_t uart_errors;   // UART 错误 (校验、噪声、溢出等) 次数
+} RS485_Stats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化 USART3 与方向控制引脚并开始接收
+ * @param baudrate 波特率 (8 数据位、偶校验、1 停止位)
+ * @param owner    收到帧或发送完成时通知的任务 (xTaskNotifyGive)
+ * @return true: 成功
+ */
+bool RS485_Init(uint32_t baudrate, TaskHandle_t owner);
+
+/**
+ * @brief 取出最近收到的一帧 (不等待)
+ * @param buf 输出缓冲区 (至少 RS485_FRAME_MAX 字节)
+ * @return 帧长度，没有新帧返回 0
+ */
+uint16_t RS485_Read(uint8_t *buf);
+
+/**
+ * @brief 发送一帧 (不等待发送完成)
+ * @param data 数据 (发送完成前须保持有效，不能位于 CCM RAM)
+ * @return false: 上一帧仍在发送
+ */
+bool RS485_Write(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief 获取驱动统计
+ */
+void RS485_GetStats(RS485_Stats_t *stats);
+
+/* --------------------------- HAL 回调 (main.c 中分发) --------------------------- */
+void RS485_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size);
+void RS485_TxCpltCallback(UART_HandleTypeDef *huart);
+void RS485_ErrorCallback(UART_HandleTypeDef *huart);
+
+/**
+ * @brief 发送 DMA 中断处理，在 DMA1_Stream3_IRQHandler 中调用
+ */
+void RS485_TxDmaIRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RS485_H */
@@ -0,0 +1,386 @@
+/**
+ ******************************************************************************
+ * @file    sdcard.c
+ * @brief   microSD 卡 SDIO 4 位 DMA 块设备驱动
+ * @details 命令阶段轮询 (响应在几十个时钟内到达)，数据阶段由 DMA 搬运，
+ *          任务在信号量上等待 SDIO 的 DATAEND 或错误中断。每次传输之前
+ *          与写入之后用 CMD13 确认卡处于 transfer 状态，写入返回时卡已
+ *          完成编程，掉电不会丢失已返回成功的数据。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sdcard.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include <string.h>
+
+#define LOG_MODULE "SD"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define SD_RESP_NONE        0U
+#define SD_RESP_SHORT       SDIO_CMD_WAITRESP_0
+#define SD_RESP_LONG        (SDIO_CMD_WAITRESP_0 | SDIO_CMD_WAITRESP_1)
+
+#define SD_CLKDIV_INIT      118U        // 48 MHz / (118 + 2) = 400 kHz
+#define SD_CLKDIV_TRANSFER  0U          // 48 MHz / 2 = 24 MHz
+#define SD_DATA_TIMEOUT_CLK (24000U * SDCARD_DATA_TIMEOUT_MS)
+
+#define SD_CMD_FLAGS        (SDIO_STA_CCRCFAIL | SDIO_STA_CTIMEOUT | SDIO_STA_CMDREND | SDIO_STA_CMDSENT)
+#define SD_DATA_ERRORS      (SDIO_STA_DCRCFAIL | SDIO_STA_DTIMEOUT | SDIO_STA_TXUNDERR | \
+                             SDIO_STA_RXOVERR | SDIO_STA_STBITERR)
+#define SD_STATIC_FLAGS     0x00C007FFU
+#define SD_R1_ERRORS        0xFDFFE008U // R1 中的错误位
+#define SD_R1_READY         (1U << 8)   // READY_FOR_DATA
+#define SD_STATE_TRAN       4U
+
+#define SD_DMA_STREAM       DMA2_Stream3
+#define SD_DMA_CHANNEL      4U
+#define SD_DMA_FLAGS        0x0F400000U // DMA2 Stream3 的 TC/HT/TE/DME/FE 标志 (LIFCR)
+
+/* --------------------------- 私有变量 --------------------------- */
+static bool s_ready = false;
+static bool s_high_capacity;            // SDHC/SDXC：按扇区寻址
+static uint32_t s_rca;
+static uint32_t s_sectors;
+static volatile uint32_t s_xfer_status; // 数据阶段结束时的 SDIO->STA
+static SemaphoreHandle_t s_done = NULL;
+static StaticSemaphore_t s_done_buf;
+static SdCard_Stats_t s_stats;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 发送命令并等待响应
+ * @param check_crc R3 (OCR) 响应不带 CRC，不检查
+ */
+static bool sd_command(uint8_t index, uint32_t arg, uint32_t resp, bool check_crc) {
+    uint32_t start = HAL_GetTick();
+    uint32_t sta;
+
+    SDIO->ICR = SD_CMD_FLAGS;
+    SDIO->ARG = arg;
+    SDIO->CMD = index | resp | SDIO_CMD_CPSMEN;
+    for (;;) {
+        sta = SDIO->STA;
+        if (resp == SD_RESP_NONE ? (sta & SDIO_STA_CMDSENT) != 0
+                                 : (sta & (SDIO_STA_CCRCFAIL | SDIO_STA_CTIMEOUT | SDIO_STA_CMDREND)) != 0) {
+            break;
+        }
+        if (HAL_GetTick() - start > 10) {
+            sta = SDIO_STA_CTIMEOUT;
+            break;
+        }
+    }
+    SDIO->ICR = SD_CMD_FLAGS;
+
+    if (resp == SD_RESP_NONE) {
+        return true;
+    }
+    if ((sta & SDIO_STA_CTIMEOUT) || ((sta & SDIO_STA_CCRCFAIL) && check_crc)) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 发送 R1 类命令并检查状态位
+ */
+static bool sd_command_r1(uint8_t index, uint32_t arg) {
+    return sd_command(index, arg, SD_RESP_SHORT, true) && SDIO->RESPCMD == index &&
+           (SDIO->RESP1 & SD_R1_ERRORS) == 0;
+}
+
+/**
+ * @brief 发送应用命令 (CMD55 + ACMDn)
+ */
+static bool sd_app_command_r1(uint8_t index, uint32_t arg) {
+    return sd_command_r1(55, s_rca << 16) && sd_command_r1(index, arg);
+}
+
+/**
+ * @brief 等待卡回到 transfer 状态 (编程、擦除完成)
+ */
+static bool sd_wait_ready(uint32_t timeout_ms) {
+    uint32_t start = HAL_GetTick();
+
+    for (;;) {
+        if (sd_command(13, s_rca << 16, SD_RESP_SHORT, true)) {
+            uint32_t status = SDIO->RESP1;
+            if ((status & SD_R1_READY) && ((status >> 9) & 0x0F) == SD_STATE_TRAN) {
+                return true;
+            }
+        }
+        if (HAL_GetTick() - start > timeout_ms) {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+}
+
+/**
+ * @brief 由 CSD 计算容量
+ */
+static uint32_t sd_csd_sectors(void) {
+    uint32_t r2 = SDIO->RESP2;
+    uint32_t r3 = SDIO->RESP3;
+
+    if ((SDIO->RESP1 >> 30) == 1) {
+        /* CSD 2.0：C_SIZE [69:48]，单位 512 KB */
+        return ((((r2 & 0x3FU) << 16) | (r3 >> 16)) + 1) * 1024U;
+    }
+    /* CSD 1.0：(C_SIZE + 1) * 2^(C_SIZE_MULT + 2) * 2^READ_BL_LEN 字节 */
+    {
+        uint32_t bl_len = (r2 >> 16) & 0x0F;
+        uint32_t c_size = ((r2 & 0x3FFU) << 2) | (r3 >> 30);
+        uint32_t mult = (r3 >> 15) & 0x07;
+        return ((c_size + 1) << (mult + 2)) << bl_len >> 9;
+    }
+}
+
+/**
+ * @brief 初始化引脚、SDIO 时钟与中断
+ */
+static void sd_hw_init(void) {
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOC_CLK_ENABLE();
+    __HAL_RCC_GPIOD_CLK_ENABLE();
+    __HAL_RCC_SDIO_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    gpio.Pin = GPIO_PIN_8 | GPIO_PIN_9 | GPIO_PIN_10 | GPIO_PIN_11;   /* D0 ~ D3 */
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_PULLUP;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF12_SDIO;
+    HAL_GPIO_Init(GPIOC, &gpio);
+    gpio.Pin = GPIO_PIN_12;                                             /* CK */
+    gpio.Pull = GPIO_NOPULL;
+    HAL_GPIO_Init(GPIOC, &gpio);
+    gpio.Pin = GPIO_PIN_2;                                              /* CMD */
+    gpio.Pull = GPIO_PULLUP;
+    HAL_GPIO_Init(GPIOD, &gpio);
+
+    SDIO->POWER = SDIO_POWER_PWRCTRL;
+    vTaskDelay(pdMS_TO_TICKS(2));
+    SDIO->CLKCR = SDIO_CLKCR_CLKEN | SD_CLKDIV_INIT;
+    vTaskDelay(pdMS_TO_TICKS(2));                                       /* 上电后至少 74 个时钟 */
+
+    HAL_NVIC_SetPriority(SDIO_IRQn, SDCARD_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(SDIO_IRQn);
+}
+
+/**
+ * @brief 识别卡：复位、电压协商、分配地址、选中并切换到 4 位总线
+ */
+static bool sd_identify(void) {
+    uint32_t start, ocr = 0;
+    bool v2;
+
+    s_rca = 0;
+    sd_command(0, 0, SD_RESP_NONE, false);
+    v2 = sd_command(8, 0x1AA, SD_RESP_SHORT, true) && (SDIO->RESP1 & 0xFFF) == 0x1AA;
+
+    start = HAL_GetTick();
+    do {
+        if (!sd_command(55, 0, SD_RESP_SHORT, true) ||
+            !sd_command(41, 0x80100000U | (v2 ? 0x40000000U : 0), SD_RESP_SHORT, false)) {
+            return false;
+        }
+        ocr = SDIO->RESP1;
+        if (ocr & 0x80000000U) {
+            break;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    } while (HAL_GetTick() - start < 1000);
+    if (!(ocr & 0x80000000U)) {
+        return false;
+    }
+    s_high_capacity = (ocr & 0x40000000U) != 0;
+
+    if (!sd_command(2, 0, SD_RESP_LONG, true) || !sd_command(3, 0, SD_RESP_SHORT, true)) {
+        return false;
+    }
+    s_rca = SDIO->RESP1 >> 16;
+    if (!sd_command(9, s_rca << 16, SD_RESP_LONG, true)) {
+        return false;
+    }
+    s_sectors = sd_csd_sectors();
+
+    if (!sd_command_r1(7, s_rca << 16) || !sd_wait_ready(SDCARD_BUSY_TIMEOUT_MS)) {
+        return false;
+    }
+    if (!s_high_capacity && !sd_command_r1(16, SDCARD_SECTOR_SIZE)) {
+        return false;
+    }
+    if (!sd_app_command_r1(6, 2)) {
+        return false;
+    }
+    SDIO->CLKCR = SDIO_CLKCR_CLKEN | SDIO_CLKCR_WIDBUS_0 | SD_CLKDIV_TRANSFER;
+    return true;
+}
+
+static void sd_dma_stop(void) {
+    SD_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+    for (uint32_t i = 0; i < 10000U && (SD_DMA_STREAM->CR & DMA_SxCR_EN); i++) {
+    }
+    DMA2->LIFCR = SD_DMA_FLAGS;
+}
+
+/**
+ * @brief 配置 DMA (SDIO 为流控方，NDTR 不起作用)
+ */
+static void sd_dma_start(const void *buf, bool to_card) {
+    sd_dma_stop();
+    SD_DMA_STREAM->PAR = (uint32_t)&SDIO->FIFO;
+    SD_DMA_STREAM->M0AR = (uint32_t)buf;
+    SD_DMA_STREAM->NDTR = 0;
+    SD_DMA_STREAM->FCR = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH;
+    SD_DMA_STREAM->CR = (SD_DMA_CHANNEL << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MBURST_0 |
+                        DMA_SxCR_PBURST_0 | DMA_SxCR_PL | DMA_SxCR_MSIZE_1 |
+                        DMA_SxCR_PSIZE_1 | DMA_SxCR_MINC | DMA_SxCR_PFCTRL |
+                        (to_card ? DMA_SxCR_DIR_0 : 0);
+    SD_DMA_STREAM->CR |= DMA_SxCR_EN;
+}
+
+/**
+ * @brief 一次读或写传输
+ */
+static bool sd_transfer(uint32_t sector, void *buf, uint32_t count, bool write) {
+    uint32_t addr = s_high_capacity ? sector : sector * SDCARD_SECTOR_SIZE;
+    uint32_t dctrl = (9U << SDIO_DCTRL_DBLOCKSIZE_Pos) | SDIO_DCTRL_DMAEN | SDIO_DCTRL_DTEN;
+    bool ok;
+
+    if (!s_ready || count == 0 || ((uint32_t)buf & 3U) != 0 ||
+        sector + count > s_sectors || !sd_wait_ready(SDCARD_BUSY_TIMEOUT_MS)) {
+        return false;
+    }
+
+    xSemaphoreTake(s_done, 0);
+    SDIO->DCTRL = 0;
+    SDIO->ICR = SD_STATIC_FLAGS;
+    SDIO->DTIMER = SD_DATA_TIMEOUT_CLK;
+    SDIO->DLEN = count * SDCARD_SECTOR_SIZE;
+    SDIO->MASK = SDIO_MASK_DATAENDIE | SDIO_MASK_DCRCFAILIE | SDIO_MASK_DTIMEOUTIE |
+                 SDIO_MASK_TXUNDERRIE | SDIO_MASK_RXOVERRIE | SDIO_MASK_STBITERRIE;
+    sd_dma_start(buf, write);
+
+    if (write) {
+        /* 预告块数，卡可以提前擦除整段 (失败不影响写入) */
+        if (count > 1) {
+            sd_app_command_r1(23, count);
+        }
+        ok = sd_command_r1(count > 1 ? 25 : 24, addr);
+        if (ok) {
+            SDIO->DCTRL = dctrl;
+        }
+        s_stats.writes++;
+    } else {
+        SDIO->DCTRL = dctrl | SDIO_DCTRL_DTDIR;
+        ok = sd_command_r1(count > 1 ? 18 : 17, addr);
+        s_stats.reads++;
+    }
+
+    if (ok) {
+        ok = xSemaphoreTake(s_done, pdMS_TO_TICKS(SDCARD_DATA_TIMEOUT_MS +
+                                                  count / 8)) == pdTRUE &&
+             (s_xfer_status & SD_DATA_ERRORS) == 0 &&
+             (s_xfer_status & SDIO_STA_DATAEND) != 0;
+    }
+    SDIO->MASK = 0;
+    if (!ok) {
+        SDIO->DCTRL = 0;
+    }
+    if (count > 1 || !ok) {
+        sd_command(12, 0, SD_RESP_SHORT, true);
+    }
+    /* 读：SDIO 数据结束后 DMA FIFO 中可能还有最后一组数据 */
+    for (uint32_t i = 0; i < 10000U && (SD_DMA_STREAM->CR & DMA_SxCR_EN); i++) {
+    }
+    sd_dma_stop();
+
+    if (ok && write) {
+        ok = sd_wait_ready(SDCARD_BUSY_TIMEOUT_MS);
+        if (ok) {
+            s_stats.sectors_written += count;
+        }
+    }
+    if (!ok) {
+        s_stats.errors++;
+    }
+    return ok;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+bool SdCard_Init(void) {
+    if (s_ready) {
+        return true;
+    }
+    if (s_done == NULL) {
+        s_done = xSemaphoreCreateBinaryStatic(&s_done_buf);
+    }
+    sd_hw_init();
+    if (!sd_identify()) {
+        SDIO->CLKCR = 0;
+        SDIO->POWER = 0;
+        LOG_WARN("未检测到 SD 卡");
+        return false;
+    }
+    s_ready = true;
+    LOG_INFO("SD 卡: %lu MB, %s", (unsigned long)(s_sectors / 2048U),
+             s_high_capacity ? "SDHC/SDXC" : "SDSC");
+    return true;
+}
+
+uint32_t SdCard_GetSectorCount(void) {
+    return s_ready ? s_sectors : 0;
+}
+
+bool SdCard_Read(uint32_t sector, void *buf, uint32_t count) {
+    return sd_transfer(sector, buf, count, false);
+}
+
+bool SdCard_Write(uint32_t sector, const void *buf, uint32_t count) {
+    return sd_transfer(sector, (void *)buf, count, true);
+}
+
+bool SdCard_Erase(uint32_t first, uint32_t last) {
+    uint32_t scale = s_high_capacity ? 1U : SDCARD_SECTOR_SIZE;
+    bool ok;
+
+    if (!s_ready || first > last || last >= s_sectors ||
+        !sd_wait_ready(SDCARD_BUSY_TIMEOUT_MS)) {
+        return false;
+    }
+    ok = sd_command_r1(32, first * scale) && sd_command_r1(33, last * scale) &&
+         sd_command_r1(38, 0) && sd_wait_ready(SDCARD_BUSY_TIMEOUT_MS);
+    s_stats.erases++;
+    if (!ok) {
+        s_stats.errors++;
+    }
+    return ok;
+}
+
+void SdCard_GetStats(SdCard_Stats_t *stats) {
+    *stats = s_stats;
+}
+
+/**
+ * @brief 数据阶段结束或出错：记录状态并唤醒等待的任务
+ */
+void SdCard_IRQHandler(void) {
+    BaseType_t woken = pdFALSE;
+
+    s_xfer_status = SDIO->STA;
+    SDIO->MASK = 0;
+    SDIO->ICR = SD_STATIC_FLAGS & ~SD_CMD_FLAGS;
+    if (s_done != NULL) {
+        xSemaphoreGiveFromISR(s_done, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
@@ -0,0 +1,95 @@
+/**
+ ******************************************************************************
+ * @file    sdcard.h
+ * @brief   microSD 卡 SDIO 4 位 DMA 块设备驱动头文件
+ * @details 卡座接在 SDIO：PC8~PC11 D0~D3，PC12 CK，PD2 CMD。CubeMX 工程
+ *          未配置 SDIO，库中也没有 HAL SD 模块，驱动直接操作 SDIO 寄存器：
+ *            - 识别 SDSC/SDHC/SDXC 卡，4 位总线，数据阶段 24 MHz
+ *              (SDIOCLK 为 PLLQ 输出的 48 MHz)；
+ *            - 数据经 DMA2 Stream3 Channel4 传输，SDIO 作为流控方，
+ *              完成、CRC 错误与超时由 SDIO 中断通知等待的任务；
+ *            - 多块写先用 ACMD23 告知块数，卡可以预擦除，连续写入效率最高。
+ *          PC12/PD2 与 Wi-Fi 模块的 UART5 共用，PC9 与硬件 I2C3 触摸共用，
+ *          三者同一时刻只能启用其一。接口为阻塞式，只允许一个任务调用。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SDCARD_H
+#define __SDCARD_H
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SDCARD_SECTOR_SIZE      512
+#define SDCARD_IRQ_PRIORITY     6           // 不高于 configMAX_SYSCALL_INTERRUPT_PRIORITY
+#define SDCARD_DATA_TIMEOUT_MS  500         // 单次读写的数据超时
+#define SDCARD_BUSY_TIMEOUT_MS  3000        // 编程或擦除后等待卡空闲的上限
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 驱动统计
+ */
+typedef struct {
+    uint32_t reads;             // 读命令次数
+    uint32_t writes;            // 写命令次数 (一次多块写计一次)
+    uint32_t sectors_written;   // 写入的扇区数
+    uint32_t erases;            // 擦除命令次数
+    uint32_t errors;            // 命令、CRC 或超时错误次数
+} SdCard_Stats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化引脚、SDIO 与 DMA，识别卡并切换到 4 位总线
+ * @return false: 没有插卡或卡不响应
+ * @note  须在任务中调用
+ */
+bool SdCard_Init(void);
+
+/**
+ * @brief 卡容量 (扇区数)，未初始化时为 0
+ */
+uint32_t SdCard_GetSectorCount(void);
+
+/**
+ * @brief 读取连续扇区
+ * @param buf 4 字节对齐，不能位于 CCM RAM (DMA 不可访问)
+ */
+bool SdCard_Read(uint32_t sector, void *buf, uint32_t count);
+
+/**
+ * @brief 写入连续扇区 (多于一个扇区时使用多块写)
+ * @param buf 4 字节对齐，不能位于 CCM RAM
+ * @note  返回时卡已完成编程
+ */
+bool SdCard_Write(uint32_t sector, const void *buf, uint32_t count);
+
+/**
+ * @brief 擦除 [first, last] 扇区 (擦除后内容为全 0 或全 1，取决于卡)
+ */
+bool SdCard_Erase(uint32_t first, uint32_t last);
+
+/**
+ * @brief 获取驱动统计
+ */
+void SdCard_GetStats(SdCard_Stats_t *stats);
+
+/**
+ * @brief SDIO 中断处理，在 SDIO_IRQHandler 中调用
+ */
+void SdCard_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SDCARD_H */
@@ -21,6 +21,8 @@ extern "C" {
 // 根据您的CubeMX配置修改I2C句柄名称，通常是hi2c1或hi2c2
 extern I2C_HandleTypeDef hi2c1;  // 假设使用I2C1，请根据实际情况修改
 #define GY30_I2C_HANDLE         (&hi2c1)
+#define GY30_RETRY_COUNT        3       // 初始化各步骤的尝试次数 (在线查询除外)
+#define GY30_RETRY_DELAY_MS     10      // 两次尝试之间的等待时间
 
 #ifndef GY30_USE_I2C_BUS_MANAGER
 #define GY30_USE_I2C_BUS_MANAGER 1
@@ -51,6 +53,17 @@ extern I2C_HandleTypeDef hi2c1;  // 假设使用I2C1，请根据实际情况修
 #define BH1750_ONE_H_MODE2      0x21    // 一次H分辨率模式2 (0.5lx分辨率)
 #define BH1750_ONE_L_MODE       0x23    // 一次L分辨率模式 (4lx分辨率)
 
+// 测量时间寄存器 (MTreg)：积分时间与读数灵敏度都与 MTreg 成正比
+#define BH1750_MTREG_HIGH_BIT   0x40    // 01000_MT[7:5]
+#define BH1750_MTREG_LOW_BIT    0x60    // 011_MT[4:0]
+#define BH1750_MTREG_DEFAULT    69
+#define BH1750_MTREG_MIN        31
+#define BH1750_MTREG_MAX        254
+
+// 自动量程：连续模式下按光照强度切换 测量模式 + MTreg
+#define GY30_AUTO_RANGE_LEVELS  5       // 量程档位数 (见 gy30.c 中的档位表)
+#define GY30_AUTO_RANGE_DEFAULT 2       // 初始档位: 连续H分辨率, MTreg = 69
+
 /* --------------------------- 数据类型定义 --------------------------- */
 // GY-30工作模式枚举
 typedef enum {
@@ -76,6 +89,9 @@ typedef struct {
     GY30_Mode_t mode;           // 当前工作模式
     bool is_initialized;        // 初始化标志
     uint32_t last_read_time;    // 上次读取时间 (ms)
+    uint8_t mtreg;              // 当前测量时间寄存器值
+    bool auto_range;            // 是否启用自动量程 (仅连续模式)
+    uint8_t range_level;        // 自动量程当前档位 (0 最亮/最快)
 } GY30_Device_t;
 
 /* --------------------------- 公共函数声明 --------------------------- */
@@ -96,6 +112,26 @@ GY30_Status_t GY30_Init(GY30_Device_t *device, uint8_t i2c_addr);
  */
 GY30_Status_t GY30_SetMode(GY30_Device_t *device, GY30_Mode_t mode);
 
+/**
+ * @brief 设置测量时间寄存器 MTreg (31~254)
+ * @note  MTreg 越大积分时间越长、暗光分辨率越高，量程相应缩小
+ * @param device GY-30设备结构体指针
+ * @param mtreg 测量时间寄存器值
+ * @return GY30_Status_t 操作状态
+ */
+GY30_Status_t GY30_SetMeasurementTimeReg(GY30_Device_t *device, uint8_t mtreg);
+
+/**
+ * @brief 启用/关闭自动量程
+ * @note  可在 GY30_Init() 之前调用 (配置在初始化时保留)。启用后每次读数根据
+ *        光照强度选择档位：强光下使用低分辨率短积分快速读取，仅在暗光下
+ *        延长积分时间。会把工作模式切换为对应的连续模式。
+ * @param device GY-30设备结构体指针
+ * @param enable true: 启用
+ * @return GY30_Status_t 操作状态
+ */
+GY30_Status_t GY30_SetAutoRange(GY30_Device_t *device, bool enable);
+
 /**
  * @brief 读取光照强度值
  * @param device GY-30设备结构体指针
@@ -104,6 +140,22 @@ GY30_Status_t GY30_SetMode(GY30_Device_t *device, GY30_Mode_t mode);
  */
 GY30_Status_t GY30_ReadLux(GY30_Device_t *device, float *lux);
 
+/**
+ * @brief 触发一次测量 (非阻塞，分阶段读取的第一步)
+ * @param device GY-30设备结构体指针
+ * @param wait_ms 输出距离结果可读还需等待的时间 (ms)
+ * @return GY30_Status_t 操作状态
+ */
+GY30_Status_t GY30_StartMeasurement(GY30_Device_t *device, uint32_t *wait_ms);
+
+/**
+ * @brief 取回测量结果 (须在 GY30_StartMeasurement 给出的等待时间之后调用)
+ * @param device GY-30设备结构体指针
+ * @param lux 输出的光照强度值 (单位: lux)
+ * @return GY30_Status_t 操作状态
+ */
+GY30_Status_t GY30_CollectLux(GY30_Device_t *device, float *lux);
+
 /**
  * @brief 重置GY-30传感器
  * @param device GY-30设备结构体指针
@@ -133,7 +185,7 @@ GY30_Status_t GY30_Wakeup(GY30_Device_t *device);
 GY30_Status_t GY30_IsOnline(GY30_Device_t *device);
 
 /**
- * @brief 获取测量模式对应的等待时间 (ms)
+ * @brief 获取测量模式对应的等待时间 (ms, MTreg 为默认值 69 时)
  * @param mode 测量模式
  * @return uint32_t 等待时间 (毫秒)
  */
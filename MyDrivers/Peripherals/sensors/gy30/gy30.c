@@ -10,17 +10,43 @@
 #include <string.h>
 #include <stdio.h>
 #include "i2c_bus_manager.h"
+#include "fmt_fixed.h"
 
 /* --------------------------- 日志配置 --------------------------- */
 // 这个log.h是我自己实现的日志系统，移植的时候必须拷贝上，否则得重新实现LOG__xxx等实现
 #define LOG_MODULE "GY30"
 #include "log.h"
 
+/* --------------------------- 私有变量 --------------------------- */
+/**
+ * @brief 自动量程档位表
+ * @details 读数低于 lux_min 时切换到更暗的档位，高于 lux_max 或饱和时切换到
+ *          更亮的档位；相邻档位的阈值区间互相重叠，避免在边界来回切换。
+ */
+typedef struct {
+    GY30_Mode_t mode;
+    uint8_t mtreg;
+    float lux_min;
+    float lux_max;
+} GY30_RangeLevel_t;
+
+static const GY30_RangeLevel_t gy30_range_levels[GY30_AUTO_RANGE_LEVELS] = {
+    { GY30_MODE_LOW_RES,   BH1750_MTREG_MIN,     20000.0f, 1.0e9f   },  // ~11ms, 量程约 12 万 lx
+    { GY30_MODE_LOW_RES,   BH1750_MTREG_DEFAULT, 1000.0f,  40000.0f },  // 24ms,  4lx 分辨率
+    { GY30_MODE_HIGH_RES,  BH1750_MTREG_DEFAULT, 10.0f,    2000.0f  },  // 180ms, 1lx 分辨率
+    { GY30_MODE_HIGH_RES2, 138,                  2.0f,     20.0f    },  // ~360ms, 0.25lx 分辨率
+    { GY30_MODE_HIGH_RES2, BH1750_MTREG_MAX,     0.0f,     5.0f     },  // ~660ms, 约 0.14lx 分辨率
+};
+
 /* --------------------------- 私有函数声明 --------------------------- */
 static GY30_Status_t GY30_WriteCommand(GY30_Device_t *device, uint8_t command);
 static GY30_Status_t GY30_ReadData(GY30_Device_t *device, uint8_t *data, uint16_t size);
 static uint32_t GY30_GetTickMs(void);
 static GY30_Status_t GY30_ApplyMode(GY30_Device_t *device);
+static GY30_Status_t GY30_WriteMTreg(GY30_Device_t *device, uint8_t mtreg);
+static GY30_Status_t GY30_ApplyRange(GY30_Device_t *device, uint8_t level);
+static void GY30_AutoRange(GY30_Device_t *device, uint16_t raw_value, float lux);
+static uint32_t GY30_GetCurrentMeasurementTime(const GY30_Device_t *device);
 static GY30_Status_t GY30_ExecuteWithRetry(GY30_Device_t *device, 
                                         GY30_Status_t (*func)(GY30_Device_t *), 
                                         const char *action_name);
@@ -40,21 +66,29 @@ GY30_Status_t GY30_Init(GY30_Device_t *device, uint8_t i2c_addr) {
 
     LOG_INFO("开始初始化GY30设备, I2C地址: 0x%02X", i2c_addr);
     
-    // 初始化设备结构体
+    // 初始化设备结构体 (保留 GY30_SetAutoRange() 预先设置的配置)
+    bool auto_range = device->auto_range;
     memset(device, 0, sizeof(GY30_Device_t));
     device->addr = i2c_addr;
     device->mode = GY30_MODE_HIGH_RES;
+    device->mtreg = BH1750_MTREG_DEFAULT;   // 复位后芯片内的 MTreg 为默认值
+    device->auto_range = auto_range;
+    device->range_level = GY30_AUTO_RANGE_DEFAULT;
     device->is_initialized = true;  // 临时标记为已初始化
     device->last_read_time = 0;
     
-    // 初始化设备
-    if (GY30_ExecuteWithRetry(device, GY30_IsOnline, "查询设备在线状态") != GY30_OK) {
+    // 在线查询只尝试一次：设备缺失时立即返回，由传感器任务按退避间隔重新探测
+    if (GY30_IsOnline(device) != GY30_OK) {
+        LOG_DEBUG("GY30设备 0x%02X 无响应", i2c_addr);
+        device->is_initialized = false;  // 清除临时标记，下次探测重新初始化
         return GY30_ERROR;
     }
     if (GY30_ExecuteWithRetry(device, GY30_Reset, "复位设备") != GY30_OK) {
+        device->is_initialized = false;
         return GY30_ERROR;
     }
     if (GY30_ExecuteWithRetry(device, GY30_Wakeup, "设备唤醒") != GY30_OK) {
+        device->is_initialized = false;
         return GY30_ERROR;
     }
     if (GY30_ExecuteWithRetry(device, GY30_ApplyMode, "设置工作模式") != GY30_OK) {
@@ -68,13 +102,32 @@ GY30_Status_t GY30_Init(GY30_Device_t *device, uint8_t i2c_addr) {
 }
 
 /**
- * @brief 读取光照强度值
+ * @brief 读取光照强度值 (阻塞：触发 -> 等待转换 -> 取回)
  */
 GY30_Status_t GY30_ReadLux(GY30_Device_t *device, float *lux) {
-    if (device == NULL || lux == NULL || !device->is_initialized) {
+    uint32_t wait_ms = 0;
+    GY30_Status_t status = GY30_StartMeasurement(device, &wait_ms);
+    if (status != GY30_OK) {
+        return status;
+    }
+
+    if (wait_ms > 0) {
+        osDelay(wait_ms);
+    }
+
+    return GY30_CollectLux(device, lux);
+}
+
+/**
+ * @brief 触发一次测量
+ */
+GY30_Status_t GY30_StartMeasurement(GY30_Device_t *device, uint32_t *wait_ms) {
+    if (device == NULL || wait_ms == NULL || !device->is_initialized) {
         return GY30_ERROR;
     }
 
+    uint32_t required_time = GY30_GetCurrentMeasurementTime(device); // 获取当前模式的测量时间
+
     // 对于单次模式，重新触发测量
     if (device->mode >= GY30_MODE_ONE_LOW_RES) {
         GY30_Status_t status = GY30_WriteCommand(device, (uint8_t)device->mode);
@@ -82,13 +135,25 @@ GY30_Status_t GY30_ReadLux(GY30_Device_t *device, float *lux) {
             return status;
         }
         device->last_read_time = GY30_GetTickMs();
+        *wait_ms = required_time;
+        return GY30_OK;
     }
-    // 对于“连续测量”模式，传感器会自动进行下一次测量，无需发送命令
-    
-    // 检查是否需要等待测量完成
-    uint32_t required_time = GY30_GetMeasurementTime(device->mode); // 获取当前模式的测量时间
-    osDelay(required_time); 
-    
+
+    // 对于“连续测量”模式，传感器会自动进行下一次测量，无需发送命令；
+    // 只有刚设置模式后的第一次转换尚未完成时才需要等待
+    uint32_t elapsed = GY30_GetTickMs() - device->last_read_time;
+    *wait_ms = (elapsed >= required_time) ? 0 : (required_time - elapsed);
+    return GY30_OK;
+}
+
+/**
+ * @brief 取回测量结果
+ */
+GY30_Status_t GY30_CollectLux(GY30_Device_t *device, float *lux) {
+    if (device == NULL || lux == NULL || !device->is_initialized) {
+        return GY30_ERROR;
+    }
+
     // 读取2字节原始数据
     uint8_t data[2];
     GY30_Status_t status = GY30_ReadData(device, data, 2);
@@ -98,27 +163,38 @@ GY30_Status_t GY30_ReadLux(GY30_Device_t *device, float *lux) {
     
     // 转换为光照强度值
     uint16_t raw_value = (data[0] << 8) | data[1];
+    float value;
     
     // 根据模式计算lux值
     switch (device->mode) {
         case GY30_MODE_LOW_RES:
         case GY30_MODE_ONE_LOW_RES:
-            *lux = (float)raw_value / 1.2f;  // 低分辨率模式
+            value = (float)raw_value / 1.2f;  // 低分辨率模式
             break;
             
         case GY30_MODE_HIGH_RES:
         case GY30_MODE_ONE_HIGH_RES:
-            *lux = (float)raw_value / 1.2f;  // 高分辨率模式
+            value = (float)raw_value / 1.2f;  // 高分辨率模式
             break;
             
         case GY30_MODE_HIGH_RES2:
         case GY30_MODE_ONE_HIGH_RES2:
-            *lux = (float)raw_value / 2.4f;  // 高分辨率模式2
+            value = (float)raw_value / 2.4f;  // 高分辨率模式2
             break;
             
         default:
             return GY30_ERROR;
     }
+
+    // 读数与 MTreg 成正比，换算回默认 MTreg 下的刻度
+    if (device->mtreg != BH1750_MTREG_DEFAULT) {
+        value = value * BH1750_MTREG_DEFAULT / device->mtreg;
+    }
+    *lux = value;
+
+    if (device->auto_range) {
+        GY30_AutoRange(device, raw_value, value);
+    }
     
     return GY30_OK;
 }
@@ -216,6 +292,40 @@ GY30_Status_t GY30_SetMode(GY30_Device_t *device, GY30_Mode_t mode) {
     return status;
 }
 
+/**
+ * @brief 设置测量时间寄存器 MTreg
+ */
+GY30_Status_t GY30_SetMeasurementTimeReg(GY30_Device_t *device, uint8_t mtreg) {
+    if (device == NULL || !device->is_initialized ||
+        mtreg < BH1750_MTREG_MIN || mtreg > BH1750_MTREG_MAX) {
+        return GY30_ERROR;
+    }
+
+    GY30_Status_t status = GY30_WriteMTreg(device, mtreg);
+    if (status != GY30_OK) {
+        return status;
+    }
+
+    // 修改 MTreg 后需重新发送测量命令才会按新的积分时间测量
+    return GY30_SetMode(device, device->mode);
+}
+
+/**
+ * @brief 启用/关闭自动量程
+ */
+GY30_Status_t GY30_SetAutoRange(GY30_Device_t *device, bool enable) {
+    if (device == NULL) {
+        return GY30_ERROR;
+    }
+
+    device->auto_range = enable;
+    if (!device->is_initialized || !enable) {
+        return GY30_OK;
+    }
+
+    return GY30_ApplyRange(device, device->range_level);
+}
+
 /**
  * @brief 获取测量模式对应的等待时间
  */
@@ -246,20 +356,21 @@ static GY30_Status_t GY30_WriteCommand(GY30_Device_t *device, uint8_t command) {
     HAL_StatusTypeDef hal_status;
 
 #if GY30_USE_I2C_BUS_MANAGER
-    if (!I2C_Bus_Lock(GY30_I2C_LOCK_TIMEOUT_MS)) {
-        LOG_ERROR("GY30发送命令时获取I2C总线锁失败");
-        return GY30_TIMEOUT;
-    }
-#endif
-        hal_status = HAL_I2C_Master_Transmit(
-            GY30_I2C_HANDLE,
-            device->addr << 1,
-            &command,
-            1,
-            GY30_DEFAULT_TIMEOUT
-        );
-#if GY30_USE_I2C_BUS_MANAGER
-        I2C_Bus_Unlock();
+    // 交给总线服务执行，等待期间任务让出 CPU
+    I2C_Transaction_t xfer;
+    I2C_Transaction_Init(&xfer, device->addr);
+    xfer.tx_buf = &command;
+    xfer.tx_len = 1;
+    xfer.timeout_ms = GY30_DEFAULT_TIMEOUT;
+    hal_status = I2C_Bus_Execute(&xfer);
+#else
+    hal_status = HAL_I2C_Master_Transmit(
+        GY30_I2C_HANDLE,
+        device->addr << 1,
+        &command,
+        1,
+        GY30_DEFAULT_TIMEOUT
+    );
 #endif
     
     switch (hal_status) {
@@ -277,22 +388,21 @@ static GY30_Status_t GY30_ReadData(GY30_Device_t *device, uint8_t *data, uint16_
     HAL_StatusTypeDef hal_status;
     
 #if GY30_USE_I2C_BUS_MANAGER
-    if (!I2C_Bus_Lock(GY30_I2C_LOCK_TIMEOUT_MS)) {
-        LOG_ERROR("GY30读取数据时获取I2C总线锁失败");
-        return GY30_TIMEOUT;
-    }
-#endif
-    
+    // 交给总线服务执行，等待期间任务让出 CPU
+    I2C_Transaction_t xfer;
+    I2C_Transaction_Init(&xfer, device->addr);
+    xfer.rx_buf = data;
+    xfer.rx_len = size;
+    xfer.timeout_ms = GY30_DEFAULT_TIMEOUT;
+    hal_status = I2C_Bus_Execute(&xfer);
+#else
     hal_status = HAL_I2C_Master_Receive(
-        GY30_I2C_HANDLE, 
-        device->addr << 1, 
-        data, 
-        size, 
+        GY30_I2C_HANDLE,
+        device->addr << 1,
+        data,
+        size,
         GY30_DEFAULT_TIMEOUT
     );
-
-#if GY30_USE_I2C_BUS_MANAGER
-    I2C_Bus_Unlock();
 #endif
     
     switch (hal_status) {
@@ -319,7 +429,7 @@ static uint32_t GY30_GetTickMs(void) {
 static GY30_Status_t GY30_ExecuteWithRetry(GY30_Device_t* device, 
                                         GY30_Status_t (*func)(GY30_Device_t*), 
                                         const char* action_name) {
-    const int max_retries = 3;
+    const int max_retries = GY30_RETRY_COUNT;
     GY30_Status_t status;
     for (int i = 0; i < max_retries; i++) {
         status = func(device);
@@ -328,7 +438,9 @@ static GY30_Status_t GY30_ExecuteWithRetry(GY30_Device_t* device,
             return GY30_OK;
         }
         LOG_WARN("操作 '%s' 失败 (尝试 %d/%d)，等待重试...", action_name, i + 1, max_retries);
-        osDelay(1000);
+        if (i + 1 < max_retries) {
+            osDelay(GY30_RETRY_DELAY_MS);
+        }
     }
 
     return status;
@@ -342,5 +454,76 @@ static GY30_Status_t GY30_ApplyMode(GY30_Device_t *device) {
         return GY30_ERROR;
     }
     device->is_initialized = true;  // 临时标记为已初始化
+    if (device->auto_range) {
+        return GY30_ApplyRange(device, device->range_level);
+    }
     return GY30_SetMode(device, device->mode);
 }
+
+/**
+ * @brief 写入测量时间寄存器 (分高3位、低5位两条命令)
+ */
+static GY30_Status_t GY30_WriteMTreg(GY30_Device_t *device, uint8_t mtreg) {
+    GY30_Status_t status = GY30_WriteCommand(device, BH1750_MTREG_HIGH_BIT | (mtreg >> 5));
+    if (status != GY30_OK) {
+        return status;
+    }
+    status = GY30_WriteCommand(device, BH1750_MTREG_LOW_BIT | (mtreg & 0x1F));
+    if (status == GY30_OK) {
+        device->mtreg = mtreg;
+    }
+    return status;
+}
+
+/**
+ * @brief 切换到指定的自动量程档位
+ */
+static GY30_Status_t GY30_ApplyRange(GY30_Device_t *device, uint8_t level) {
+    const GY30_RangeLevel_t *range = &gy30_range_levels[level];
+
+    if (device->mtreg != range->mtreg) {
+        GY30_Status_t status = GY30_WriteMTreg(device, range->mtreg);
+        if (status != GY30_OK) {
+            return status;
+        }
+    }
+
+    GY30_Status_t status = GY30_SetMode(device, range->mode);
+    if (status == GY30_OK) {
+        device->range_level = level;
+    }
+    return status;
+}
+
+/**
+ * @brief 根据本次读数选择下一次测量的档位
+ * @details 未饱和时读数本身可信，直接跳到覆盖该光照的档位；
+ *          饱和时真实光照未知，只向更亮的方向移动一档。
+ */
+static void GY30_AutoRange(GY30_Device_t *device, uint16_t raw_value, float lux) {
+    uint8_t level = device->range_level;
+
+    if (raw_value == 0xFFFF) {
+        if (level > 0) level--;
+    } else {
+        while (level > 0 && lux > gy30_range_levels[level].lux_max) level--;
+        while (level < GY30_AUTO_RANGE_LEVELS - 1 && lux < gy30_range_levels[level].lux_min) level++;
+    }
+
+    if (level == device->range_level) {
+        return;
+    }
+
+    LOG_DEBUG("GY30自动量程: 档位 %d -> %d (%s lx)", device->range_level, level, FMT_Q1(lux));
+    if (GY30_ApplyRange(device, level) != GY30_OK) {
+        LOG_WARN("GY30切换量程失败，保持当前档位");
+    }
+}
+
+/**
+ * @brief 当前模式与 MTreg 下的测量时间
+ */
+static uint32_t GY30_GetCurrentMeasurementTime(const GY30_Device_t *device) {
+    uint32_t base = GY30_GetMeasurementTime(device->mode);
+    return (base * device->mtreg + BH1750_MTREG_DEFAULT - 1) / BH1750_MTREG_DEFAULT;
+}
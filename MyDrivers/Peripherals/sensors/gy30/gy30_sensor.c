@@ -17,39 +17,67 @@
 #include "log.h"
 
 
+/* --------------------------- 采集配置 --------------------------- */
+// 连续模式 + 自动量程：正常光照下每次读取只是取回最新结果，无需等待转换，
+// 因此可以用较短的更新间隔 (见 sensor_config.h) 让 RGB 灯平滑跟随环境光
+#define GY30_SENSOR_AUTO_RANGE          true
+
 /* --------------------------- 私有变量 --------------------------- */
-static GY30_Device_t g_gy30_device;      // GY30设备实例
+static GY30_Device_t g_gy30_devices[SENSOR_MAX_PER_TYPE]; // GY30设备实例 (按实例序号)
+static uint8_t g_gy30_count;                             // 已注册的实例数
 
 /* --------------------------- 私有函数声明 --------------------------- */
 static bool GY30_Sensor_Init(SensorInstance_t* sensor);
 static bool GY30_Sensor_Read(SensorInstance_t* sensor);
 static bool GY30_Sensor_Deinit(SensorInstance_t* sensor);
+static bool GY30_Sensor_Start(SensorInstance_t* sensor, uint32_t* wait_ms);
+static SensorCollectResult_t GY30_Sensor_Collect(SensorInstance_t* sensor, uint32_t* wait_ms);
 static const char* GY30_Sensor_GetUnit(void);
 
 /* --------------------------- 回调函数结构体 --------------------------- */
-static const SensorCallbacks_t gy30_callbacks = {
+const SensorCallbacks_t GY30_Sensor_Callbacks = {
     .init_func = GY30_Sensor_Init,
     .read_func = GY30_Sensor_Read,
     .deinit_func = GY30_Sensor_Deinit,
-    .get_unit = GY30_Sensor_GetUnit
+    .get_unit = GY30_Sensor_GetUnit,
+    .start_func = GY30_Sensor_Start,
+    .collect_func = GY30_Sensor_Collect
+};
+
+/* --------------------------- 通道描述 --------------------------- */
+const SensorChannelDesc_t GY30_Sensor_Channels[GY30_SENSOR_CHANNEL_COUNT] = {
+    SENSOR_CHANNEL_FLOAT("lux", "lux", gy30.lux, 0.5f)  // 2 lux 分辨率，量程 65534 lux
 };
 
 /* --------------------------- 公共函数实现 --------------------------- */
 
 /**
- * @brief 注册GY30传感器到传感器任务系统
+ * @brief 注册默认地址的GY30传感器到传感器任务系统
  */
 bool GY30_Sensor_Register(void) {
-    // 注册GY30传感器
-    bool result = SensorTask_RegisterSensor(
-        SENSOR_TYPE_GY30,           // 传感器类型
-        "GY30 光照传感器",          // 传感器名称
-        &gy30_callbacks,            // 回调函数
-        &g_gy30_device,             // 设备句柄
-        2000                        // 更新间隔2秒
-    );
-
-    return result;
+    return GY30_Sensor_Attach(BH1750_DEFAULT_ADDR) != SENSOR_HANDLE_INVALID;
+}
+
+/**
+ * @brief 注册指定地址的GY30传感器 (总线探测发现设备后调用)
+ */
+SensorHandle_t GY30_Sensor_Attach(uint8_t addr) {
+    if (g_gy30_count >= SENSOR_MAX_PER_TYPE) {
+        LOG_ERROR("GY30实例已满，忽略地址 0x%02X", addr);
+        return SENSOR_HANDLE_INVALID;
+    }
+
+    // 地址保存在设备结构体中，初始化回调按此地址初始化
+    GY30_Device_t* device = &g_gy30_devices[g_gy30_count];
+    memset(device, 0, sizeof(GY30_Device_t));
+    device->addr = addr;
+
+    // 名称、回调、通道表与更新间隔取自驱动配置表 (sensor_config.h)
+    SensorHandle_t handle = SensorTask_RegisterInstance(SENSOR_TYPE_GY30, device);
+    if (handle != SENSOR_HANDLE_INVALID) {
+        g_gy30_count++;
+    }
+    return handle;
 }
 
 
@@ -66,8 +94,9 @@ static bool GY30_Sensor_Init(SensorInstance_t* sensor) {
         return true;
     }
     
-    // 初始化GY30传感器
-    GY30_Status_t status = GY30_Init(device, BH1750_DEFAULT_ADDR);
+    // 初始化GY30传感器 (自动量程在初始化时生效)
+    GY30_SetAutoRange(device, GY30_SENSOR_AUTO_RANGE);
+    GY30_Status_t status = GY30_Init(device, device->addr);
     if (status != GY30_OK) {
         LOG_ERROR("GY30传感器硬件初始化失败 (状态码: %d)", status);
         return false;
@@ -95,6 +124,41 @@ static bool GY30_Sensor_Read(SensorInstance_t* sensor) {
     }
 }
 
+/**
+ * @brief GY30传感器触发转换回调 (分阶段读取)
+ */
+static bool GY30_Sensor_Start(SensorInstance_t* sensor, uint32_t* wait_ms) {
+    GY30_Device_t* device = (GY30_Device_t*)sensor->device_handle;
+
+    GY30_Status_t status = GY30_StartMeasurement(device, wait_ms);
+    if (status != GY30_OK) {
+        LOG_ERROR("触发GY30传感器测量失败 (状态码: %d)", status);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief GY30传感器取回结果回调 (分阶段读取)
+ */
+static SensorCollectResult_t GY30_Sensor_Collect(SensorInstance_t* sensor, uint32_t* wait_ms) {
+    GY30_Device_t* device = (GY30_Device_t*)sensor->device_handle;
+    float lux_value;
+
+    (void)wait_ms;
+    GY30_Status_t status = GY30_CollectLux(device, &lux_value);
+
+    if (status == GY30_OK) {
+        // 更新传感器数据
+        sensor->data.values.gy30.lux = lux_value;
+        return SENSOR_COLLECT_DONE;
+    } else {
+        // 读取失败
+        LOG_ERROR("读取GY30传感器数据失败 (状态码: %d)", status);
+        return SENSOR_COLLECT_ERROR;
+    }
+}
+
 /**
  * @brief GY30传感器反初始化回调
  */
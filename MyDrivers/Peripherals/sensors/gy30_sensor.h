@@ -8,6 +8,7 @@
 #ifndef __GY30_SENSOR_H
 #define __GY30_SENSOR_H
 
+#include "sensor_task.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -15,6 +16,12 @@
 extern "C" {
 #endif
 
+/* --------------------------- 驱动描述 --------------------------- */
+#define GY30_SENSOR_CHANNEL_COUNT 1  // 通道数 (lux)
+
+extern const SensorCallbacks_t GY30_Sensor_Callbacks;                         // 驱动回调
+extern const SensorChannelDesc_t GY30_Sensor_Channels[GY30_SENSOR_CHANNEL_COUNT]; // 通道表
+
 /* --------------------------- 公共函数声明 --------------------------- */
 /**
  * @brief 注册GY30传感器到传感器任务系统
@@ -22,6 +29,13 @@ extern "C" {
  */
 bool GY30_Sensor_Register(void);
 
+/**
+ * @brief 注册指定地址的GY30传感器 (供总线探测调用)
+ * @param addr 7位I2C地址 (BH1750_ADDR_LOW / BH1750_ADDR_HIGH)
+ * @return 实例句柄，失败返回 SENSOR_HANDLE_INVALID
+ */
+SensorHandle_t GY30_Sensor_Attach(uint8_t addr);
+
 #ifdef  __cplusplus
 }
 #endif
@@ -9,7 +9,7 @@
 #define __MQ2_H
 
 #include "main.h"
-#include "adc.h"
+#include "adc_manager.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -18,31 +18,33 @@ extern "C" {
 #endif
 
 /* --------------------------- 硬件配置 --------------------------- */
-// 根据您的CubeMX配置修改ADC句柄名称
-extern ADC_HandleTypeDef hadc1;
-#define MQ2_ADC_HANDLE          (&hadc1)
-#define MQ2_ADC_CHANNEL         ADC_CHANNEL_3  // 根据实际连接的ADC通道修改
-
-// [新增] 定义一个宏来控制ADC的读取模式
-// 设置为 1: 使用DMA模式，直接从全局缓冲区读取
-// 设置为 0: 使用阻塞轮询模式，独立读取ADC
-#define MQ2_USE_DMA_MODE    1
-// 在DMA模式下，MQ-2数据在adc_dma_buffer[]中的索引
-#if MQ2_USE_DMA_MODE 
-    #define MQ2_ADC_DMA_BUFFER_INDEX  0  
-#endif
+// ADC1 由 adc_manager 以定时器触发 + 循环DMA 方式连续采样，
+// 驱动只读取其发布的块平均结果，不直接操作 ADC
+#define MQ2_ADC_CHANNEL         ADC_MANAGER_CH_MQ2
 
 /* --------------------------- MQ-2传感器参数 --------------------------- */
 #define MQ2_ADC_RESOLUTION      4095    // 12位ADC的最大值
 #define MQ2_VREF                3.3f    // 参考电压 (V)
 #define MQ2_RL_VALUE            1.0f    // 负载电阻值 (kΩ)，根据实际电路调整
 #define MQ2_CLEAN_AIR_FACTOR    9.83f   // 清洁空气中的RS/R0比值
+#define MQ2_PPM_MAX             10000   // 浓度输出上限 (PPM)
+
+// 浓度换算查找表：按原始ADC值等间隔取节点，节点间线性插值。
+// 表在校准/切换气体曲线时重建，采样路径中不再调用 powf
+#define MQ2_USE_PPM_LUT         1       // 1: 查表, 0: 每次按曲线公式计算 (调试对比用)
+#define MQ2_PPM_LUT_SHIFT       4       // 节点间隔 = 2^SHIFT 个ADC码
+#define MQ2_PPM_LUT_SIZE        ((MQ2_ADC_RESOLUTION >> MQ2_PPM_LUT_SHIFT) + 2)
 
-// 校准参数
+// 校准参数 (校准在后台分步进行，由 MQ2_CalibrateStep() 推进，不阻塞调用者)
+#define MQ2_WARMUP_TIME_MS              30000   // 上电后加热器预热时间 (ms)，预热结束后才开始校准采样
 #define MQ2_CALIBRATION_SAMPLE_TIMES    50      // 校准采样次数
 #define MQ2_CALIBRATION_SAMPLE_INTERVAL 50      // 校准采样间隔 (ms)
-#define MQ2_READ_SAMPLE_TIMES           5       // 读取时采样次数
-#define MQ2_READ_SAMPLE_INTERVAL        50      // 读取采样间隔 (ms)
+#define MQ2_ADC_READY_TIMEOUT           500     // 预热结束后等待首个ADC数据块的超时 (ms)
+
+// R0 持久化：校准结果保存到 24Cxx EEPROM，上电时恢复，跳过预热与校准
+#define MQ2_USE_EEPROM_R0               1
+#define MQ2_R0_EEPROM_ADDR              64      // 存储起始地址 (触摸屏校准参数占用 40~52)
+#define MQ2_R0_MAX_RESTORES             30      // 同一 R0 最多被恢复的次数，超过后视为过期并重新校准
 
 /* --------------------------- 数据类型定义 --------------------------- */
 // MQ-2状态枚举
@@ -50,33 +52,79 @@ typedef enum {
     MQ2_OK              = 0x00,     // 操作成功
     MQ2_ERROR           = 0x01,     // 一般错误
     MQ2_NOT_CALIBRATED  = 0x02,     // 未校准
-    MQ2_TIMEOUT         = 0x03      // 超时错误
+    MQ2_TIMEOUT         = 0x03,     // 超时错误
+    MQ2_BUSY            = 0x04      // ADC采样服务尚未发布数据
 } MQ2_Status_t;
 
+// 气体曲线 (数据手册灵敏度曲线拟合: PPM = A * (RS/R0)^B)
+typedef enum {
+    MQ2_GAS_SMOKE = 0,          // 烟雾 (默认)
+    MQ2_GAS_LPG,                // 液化石油气
+    MQ2_GAS_H2,                 // 氢气
+    MQ2_GAS_COUNT
+} MQ2_Gas_t;
+
+// 后台校准状态
+typedef enum {
+    MQ2_CAL_IDLE = 0,           // 未在校准
+    MQ2_CAL_WARMUP,             // 等待加热器预热 / ADC 就绪
+    MQ2_CAL_SAMPLING            // 清洁空气中采样
+} MQ2_CalState_t;
+
 // MQ-2设备结构体
 typedef struct {
     float r0;                   // 传感器在清洁空气中的基准电阻值
     bool is_initialized;        // 初始化标志
     bool is_calibrated;         // 校准标志
     uint32_t last_read_time;    // 上次读取时间 (ms)
+    MQ2_Gas_t gas;              // 当前使用的气体曲线
+    MQ2_CalState_t cal_state;   // 后台校准状态
+    float cal_rs_sum;           // 校准采样的 RS 累加和
+    uint8_t cal_count;          // 校准已采样次数
+#if MQ2_USE_PPM_LUT
+    uint16_t ppm_lut[MQ2_PPM_LUT_SIZE]; // 原始ADC值 -> PPM 查找表 (依赖 r0 与 gas)
+#endif
 } MQ2_Device_t;
 
 /* --------------------------- 公共函数声明 --------------------------- */
 
 /**
- * @brief 初始化MQ-2传感器
+ * @brief 初始化MQ-2传感器 (不阻塞)
+ * @note  从 EEPROM 恢复到有效的 R0 时立即可用；否则进入后台校准状态，
+ *        需周期调用 MQ2_CalibrateStep() 完成预热与校准
  * @param device MQ-2设备结构体指针
  * @return MQ2_Status_t 初始化状态
  */
 MQ2_Status_t MQ2_Init(MQ2_Device_t *device);
 
 /**
- * @brief 校准MQ-2传感器 (在清洁空气中进行)
+ * @brief 校准MQ-2传感器 (在清洁空气中进行，阻塞直到完成)
  * @param device MQ-2设备结构体指针
  * @return MQ2_Status_t 校准状态
  */
 MQ2_Status_t MQ2_Calibrate(MQ2_Device_t *device);
 
+/**
+ * @brief 开始后台校准 (强制重新校准时调用，校准完成前沿用旧的 R0)
+ * @param device MQ-2设备结构体指针
+ * @return MQ2_Status_t 操作状态
+ */
+MQ2_Status_t MQ2_StartCalibration(MQ2_Device_t *device);
+
+/**
+ * @brief 推进一步后台校准 (非阻塞)
+ * @param device MQ-2设备结构体指针
+ * @param wait_ms 返回 MQ2_BUSY 时输出距离下一步的等待时间 (ms)
+ * @return MQ2_Status_t MQ2_OK: 校准完成 (已保存到EEPROM), MQ2_BUSY: 继续等待,
+ *         其他: 校准失败 (状态保留，再次调用会重新开始采样)
+ */
+MQ2_Status_t MQ2_CalibrateStep(MQ2_Device_t *device, uint32_t *wait_ms);
+
+/**
+ * @brief 是否正在后台校准
+ */
+bool MQ2_IsCalibrating(const MQ2_Device_t *device);
+
 /**
  * @brief 读取烟雾浓度 (PPM)
  * @param device MQ-2设备结构体指针
@@ -85,6 +133,32 @@ MQ2_Status_t MQ2_Calibrate(MQ2_Device_t *device);
  */
 MQ2_Status_t MQ2_ReadPPM(MQ2_Device_t *device, int *ppm);
 
+/**
+ * @brief 开始一次测量 (非阻塞，ADC 已在后台连续采样，无需等待)
+ * @param device MQ-2设备结构体指针
+ * @param wait_ms 输出距离可以取回结果的等待时间 (ms)，通常为 0
+ * @return MQ2_Status_t 操作状态
+ */
+MQ2_Status_t MQ2_StartMeasurement(MQ2_Device_t *device, uint32_t *wait_ms);
+
+/**
+ * @brief 取回测量结果 (非阻塞)，由最新的ADC块平均值计算浓度
+ * @param device MQ-2设备结构体指针
+ * @param ppm 输出的烟雾浓度值 (单位: PPM)，仅返回 MQ2_OK 时有效
+ * @param wait_ms 返回 MQ2_BUSY 时输出建议的等待时间 (ms)
+ * @return MQ2_Status_t MQ2_OK: 完成, MQ2_BUSY: ADC尚未就绪, 其他: 错误
+ */
+MQ2_Status_t MQ2_CollectPPM(MQ2_Device_t *device, int *ppm, uint32_t *wait_ms);
+
+/**
+ * @brief 选择浓度换算使用的气体曲线
+ * @note  可在 MQ2_Init() 之前调用 (配置在初始化时保留)；已校准时立即重建查找表
+ * @param device MQ-2设备结构体指针
+ * @param gas 气体曲线
+ * @return MQ2_Status_t 操作状态
+ */
+MQ2_Status_t MQ2_SetGas(MQ2_Device_t *device, MQ2_Gas_t gas);
+
 /**
  * @brief 读取传感器电阻值 (RS)
  * @param device MQ-2设备结构体指针
@@ -94,8 +168,8 @@ MQ2_Status_t MQ2_ReadPPM(MQ2_Device_t *device, int *ppm);
 MQ2_Status_t MQ2_ReadResistance(MQ2_Device_t *device, float *rs);
 
 /**
- * @brief 读取原始ADC值
- * @param raw_value 输出的原始ADC值
+ * @brief 读取原始ADC值 (块平均后的滤波值)
+ * @param raw_value 输出的原始ADC值 (0-4095)
  * @return MQ2_Status_t 操作状态
  */
 MQ2_Status_t MQ2_ReadRawValue(uint16_t *raw_value);
@@ -108,9 +182,6 @@ MQ2_Status_t MQ2_ReadRawValue(uint16_t *raw_value);
  */
 bool MQ2_IsSmoke(MQ2_Device_t *device, int threshold);
 
-/* --------------------------- 便利宏定义 --------------------------- */
-#define MQ2_DEFAULT_TIMEOUT    1000    // 默认超时时间 (ms)
-
 #ifdef  __cplusplus
 }
 #endif
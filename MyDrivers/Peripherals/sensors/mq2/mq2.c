@@ -7,6 +7,12 @@
 
 #include "mq2.h"
 #include "cmsis_os.h"
+#include "warm_start.h"
+#if MQ2_USE_EEPROM_R0
+#include "24cxx.h"
+#include "checksum.h"
+#include "fmt_fixed.h"
+#endif
 #include <string.h>
 #include <stdio.h>
 #include <math.h>
@@ -15,20 +21,36 @@
 #define LOG_MODULE "MQ2"
 #include "log.h"
 
-/* --------------------------- 共有宏定义 --------------------------- */
-/* 声明adc_dma_buffer[]定义 */
-/* mq2与motor公用了adc，这里没有添加adc_manager文件，只是简单的extern共用数组 */
-/* mq2在dma中的索引是 0， motor索引为1 */
-// uint16_t adc_dma_buffer[2];
-extern uint16_t adc_dma_buffer[];
+/* --------------------------- 私有宏定义 --------------------------- */
+// EEPROM 中的 R0 记录: 'M' '2' | r0 (float) | CRC-8 | 恢复次数 | ~恢复次数
+#define MQ2_R0_RECORD_LEN       9
+#define MQ2_R0_CRC_LEN          6       // CRC 覆盖魔数与 r0
+#define MQ2_R0_COUNT_OFFSET     7       // 恢复次数单独校验，每次上电只需改写 2 字节
+#define MQ2_R0_MIN              0.0f
+#define MQ2_R0_MAX              100.0f
+
+/* --------------------------- 私有变量 --------------------------- */
+// 各气体曲线的拟合参数 {A, B}，顺序与 MQ2_Gas_t 一致
+// 注意：这些参数可能需要根据实际传感器进行调整
+static const float mq2_gas_curve[MQ2_GAS_COUNT][2] = {
+    { 613.9f,  -2.074f },   // 烟雾
+    { 574.25f, -2.222f },   // LPG
+    { 987.99f, -2.162f },   // H2
+};
 
 /* --------------------------- 私有函数声明 --------------------------- */
 static float MQ2_ResistanceCalculation(uint16_t raw_adc);
+static int MQ2_CurvePPM(const MQ2_Device_t *device, uint16_t raw_adc);
+static int MQ2_ConvertPPM(const MQ2_Device_t *device, uint16_t raw_adc);
+#if MQ2_USE_PPM_LUT
+static void MQ2_BuildPpmTable(MQ2_Device_t *device);
+#endif
 static float MQ2_ReadSensor(void);
 static uint32_t MQ2_GetTickMs(void);
-static MQ2_Status_t MQ2_ExecuteWithRetry(MQ2_Device_t *device, 
-                                        MQ2_Status_t (*func)(MQ2_Device_t *), 
-                                        const char *action_name);
+#if MQ2_USE_EEPROM_R0
+static MQ2_Status_t MQ2_LoadR0(MQ2_Device_t *device);
+static void MQ2_SaveR0(const MQ2_Device_t *device);
+#endif
 
 /* --------------------------- 公共函数实现 --------------------------- */
 
@@ -47,66 +69,184 @@ MQ2_Status_t MQ2_Init(MQ2_Device_t *device) {
 
     LOG_INFO("开始初始化MQ-2设备");
     
-    // 初始化设备结构体
+    // 初始化设备结构体 (保留 MQ2_SetGas() 预先设置的气体曲线)
+    MQ2_Gas_t gas = device->gas;
     memset(device, 0, sizeof(MQ2_Device_t));
+    device->gas = gas;
     device->r0 = 0.0f;
     device->is_initialized = false;
     device->is_calibrated = false;
     device->last_read_time = 0;
 
-    // 执行校准
-    if (MQ2_ExecuteWithRetry(device, MQ2_Calibrate, "校准传感器") != MQ2_OK) {
-        LOG_ERROR("MQ-2传感器校准失败");
-        return MQ2_ERROR;
+    // 热启动沿用复位前的 R0：不改写 EEPROM，也不计入恢复次数
+    const WarmStart_State_t *warm = WarmStart_Get();
+    if (warm != NULL && warm->mq2_r0 > MQ2_R0_MIN && warm->mq2_r0 <= MQ2_R0_MAX) {
+        device->r0 = warm->mq2_r0;
+        device->is_calibrated = true;
+    }
+
+#if MQ2_USE_EEPROM_R0
+    // 其次恢复已保存的 R0，成功则无需预热校准
+    at24cxx_init();
+    if (!device->is_calibrated) {
+        device->is_calibrated = (MQ2_LoadR0(device) == MQ2_OK);
+    }
+#endif
+
+    if (device->is_calibrated) {
+#if MQ2_USE_PPM_LUT
+        MQ2_BuildPpmTable(device);
+#endif
+        WarmStart_SetMq2R0(device->r0);
     }
 
     device->is_initialized = true;
-    LOG_INFO("MQ-2设备初始化成功, R0 = %.2f kΩ", device->r0);
+    if (device->is_calibrated) {
+        LOG_INFO("MQ-2设备初始化成功, 已恢复 R0 = %s kΩ", FMT_Q2(device->r0));
+    } else {
+        MQ2_StartCalibration(device);
+        LOG_INFO("MQ-2设备初始化成功, 无有效 R0, 后台预热后校准");
+    }
     return MQ2_OK;
 }
 
 /**
- * @brief 校准MQ-2传感器
+ * @brief 校准MQ-2传感器 (阻塞)
  */
 MQ2_Status_t MQ2_Calibrate(MQ2_Device_t *device) {
-    if (device == NULL) {
+    uint32_t wait_ms = 0;
+    MQ2_Status_t status = MQ2_StartCalibration(device);
+    if (status != MQ2_OK) {
+        return status;
+    }
+
+    while ((status = MQ2_CalibrateStep(device, &wait_ms)) == MQ2_BUSY) {
+        osDelay(wait_ms);
+    }
+
+    return status;
+}
+
+/**
+ * @brief 开始后台校准
+ */
+MQ2_Status_t MQ2_StartCalibration(MQ2_Device_t *device) {
+    if (device == NULL || !device->is_initialized) {
         return MQ2_ERROR;
     }
 
-    LOG_INFO("开始校准MQ-2传感器 (请确保在清洁空气中)...");
-    
-    float rs_sum = 0.0f;
-    
-    for (int i = 0; i < MQ2_CALIBRATION_SAMPLE_TIMES; i++) {
-        float rs = MQ2_ReadSensor();
-
-        rs_sum += rs;
-        osDelay(MQ2_CALIBRATION_SAMPLE_INTERVAL);
-        
-        if ((i + 1) % 10 == 0) {
-            LOG_DEBUG("校准进度: %d/%d", i + 1, MQ2_CALIBRATION_SAMPLE_TIMES);
+    device->cal_state = MQ2_CAL_WARMUP;
+    device->cal_rs_sum = 0.0f;
+    device->cal_count = 0;
+    return MQ2_OK;
+}
+
+/**
+ * @brief 推进一步后台校准
+ */
+MQ2_Status_t MQ2_CalibrateStep(MQ2_Device_t *device, uint32_t *wait_ms) {
+    if (device == NULL || wait_ms == NULL || !device->is_initialized) {
+        return MQ2_ERROR;
+    }
+
+    if (device->cal_state == MQ2_CAL_IDLE) {
+        return device->is_calibrated ? MQ2_OK : MQ2_NOT_CALIBRATED;
+    }
+
+    if (device->cal_state == MQ2_CAL_WARMUP) {
+        uint32_t now = MQ2_GetTickMs();
+
+        // 加热器随系统上电，预热时间从开机算起
+        if (now < MQ2_WARMUP_TIME_MS) {
+            *wait_ms = MQ2_WARMUP_TIME_MS - now;
+            return MQ2_BUSY;
+        }
+
+        // 等待ADC采样服务发布第一个数据块
+        if (!ADC_Manager_IsReady()) {
+            if (now - MQ2_WARMUP_TIME_MS > MQ2_ADC_READY_TIMEOUT) {
+                LOG_ERROR("等待ADC数据超时，ADC采样服务未启动?");
+                return MQ2_TIMEOUT;
+            }
+            *wait_ms = ADC_MANAGER_BLOCK_MS;
+            return MQ2_BUSY;
         }
+
+        LOG_INFO("开始校准MQ-2传感器 (请确保在清洁空气中)...");
+        device->cal_state = MQ2_CAL_SAMPLING;
+        device->cal_rs_sum = 0.0f;
+        device->cal_count = 0;
     }
+
+    // 每步采一个样本
+    device->cal_rs_sum += MQ2_ReadSensor();
+    device->cal_count++;
+
+    if (device->cal_count % 10 == 0) {
+        LOG_DEBUG("校准进度: %d/%d", device->cal_count, MQ2_CALIBRATION_SAMPLE_TIMES);
+    }
+    if (device->cal_count < MQ2_CALIBRATION_SAMPLE_TIMES) {
+        *wait_ms = MQ2_CALIBRATION_SAMPLE_INTERVAL;
+        return MQ2_BUSY;
+    }
+
+    float rs_avg = device->cal_rs_sum / MQ2_CALIBRATION_SAMPLE_TIMES;
+    float r0 = rs_avg / MQ2_CLEAN_AIR_FACTOR;
+
+    // 下次调用从头重新采样
+    device->cal_state = MQ2_CAL_WARMUP;
     
-    float rs_avg = rs_sum / MQ2_CALIBRATION_SAMPLE_TIMES;
-    device->r0 = rs_avg / MQ2_CLEAN_AIR_FACTOR;
-    
-    if (device->r0 <= 0.0f || device->r0 > 100.0f) {
-        LOG_ERROR("MQ-2校准失败，R0值异常: %.2f", device->r0);
+    if (r0 <= MQ2_R0_MIN || r0 > MQ2_R0_MAX) {
+        LOG_ERROR("MQ-2校准失败，R0值异常: %s", FMT_Q2(r0));
         return MQ2_ERROR;
     }
     
+    device->r0 = r0;
+#if MQ2_USE_PPM_LUT
+    MQ2_BuildPpmTable(device);
+#endif
     device->is_calibrated = true;
-    LOG_INFO("MQ-2传感器校准完成, R0 = %.2f kΩ", device->r0);
+    device->cal_state = MQ2_CAL_IDLE;
+    LOG_INFO("MQ-2传感器校准完成, R0 = %s kΩ", FMT_Q2(device->r0));
+    WarmStart_SetMq2R0(device->r0);
+
+#if MQ2_USE_EEPROM_R0
+    MQ2_SaveR0(device);
+#endif
     
     return MQ2_OK;
 }
 
+/**
+ * @brief 是否正在后台校准
+ */
+bool MQ2_IsCalibrating(const MQ2_Device_t *device) {
+    return device != NULL && device->cal_state != MQ2_CAL_IDLE;
+}
+
 /**
  * @brief 读取烟雾浓度 (PPM)
  */
 MQ2_Status_t MQ2_ReadPPM(MQ2_Device_t *device, int *ppm) {
-    if (device == NULL || ppm == NULL || !device->is_initialized) {
+    uint32_t wait_ms = 0;
+    MQ2_Status_t status = MQ2_StartMeasurement(device, &wait_ms);
+    if (status != MQ2_OK) {
+        return status;
+    }
+
+    do {
+        osDelay(wait_ms);
+        status = MQ2_CollectPPM(device, ppm, &wait_ms);
+    } while (status == MQ2_BUSY);
+
+    return status;
+}
+
+/**
+ * @brief 开始一次测量
+ */
+MQ2_Status_t MQ2_StartMeasurement(MQ2_Device_t *device, uint32_t *wait_ms) {
+    if (device == NULL || wait_ms == NULL || !device->is_initialized) {
         return MQ2_ERROR;
     }
 
@@ -115,36 +255,55 @@ MQ2_Status_t MQ2_ReadPPM(MQ2_Device_t *device, int *ppm) {
         return MQ2_NOT_CALIBRATED;
     }
 
-    // 多次采样取平均值
-    float rs_sum = 0.0f;
-    for (int i = 0; i < MQ2_READ_SAMPLE_TIMES; i++) {
-        rs_sum += MQ2_ReadSensor();
-        if (i < MQ2_READ_SAMPLE_TIMES - 1) {
-            osDelay(MQ2_READ_SAMPLE_INTERVAL);
-        }
+    // ADC 在后台连续采样并做块平均，结果随时可取
+    *wait_ms = 0;
+
+    return MQ2_OK;
+}
+
+/**
+ * @brief 由最新的ADC滤波值计算浓度
+ */
+MQ2_Status_t MQ2_CollectPPM(MQ2_Device_t *device, int *ppm, uint32_t *wait_ms) {
+    if (device == NULL || ppm == NULL || wait_ms == NULL || !device->is_initialized) {
+        return MQ2_ERROR;
     }
-    float rs = rs_sum / MQ2_READ_SAMPLE_TIMES;
-    
-    // 计算 RS/R0 比值
-    float ratio = rs / device->r0;
-    
-    // MQ-2的PPM计算公式 (根据数据手册曲线拟合)
-    // 这里使用简化的指数模型: PPM = A * (RS/R0)^B
-    // 对于烟雾检测，典型参数为: A ≈ 613.9, B ≈ -2.074
-    // 注意：这些参数可能需要根据实际传感器进行调整
-    float ppm_value = 613.9f * powf(ratio, -2.074f);
-    
-    // 限制范围 (MQ-2典型范围: 200-10000 PPM)
-    if (ppm_value < 0) ppm_value = 0;
-    if (ppm_value > 10000) ppm_value = 10000;
-    
-    *ppm = (int)ppm_value;
-    printf("MQ2 Read PPM: RS=%.2f kΩ, R0=%.2f kΩ, Ratio=%.2f, PPM=%d\n", rs, device->r0, ratio, *ppm);
+
+    uint16_t raw_value;
+    MQ2_Status_t status = MQ2_ReadRawValue(&raw_value);
+    if (status == MQ2_BUSY) {
+        *wait_ms = ADC_MANAGER_BLOCK_MS;
+        return MQ2_BUSY;
+    }
+    if (status != MQ2_OK) {
+        return status;
+    }
+
+    *ppm = MQ2_ConvertPPM(device, raw_value);
+    LOG_DEBUG("MQ2 Read PPM: ADC=%u, R0=%s kΩ, PPM=%d", raw_value, FMT_Q2(device->r0), *ppm);
     device->last_read_time = MQ2_GetTickMs();
+    *wait_ms = 0;
     
     return MQ2_OK;
 }
 
+/**
+ * @brief 选择浓度换算使用的气体曲线
+ */
+MQ2_Status_t MQ2_SetGas(MQ2_Device_t *device, MQ2_Gas_t gas) {
+    if (device == NULL || gas >= MQ2_GAS_COUNT) {
+        return MQ2_ERROR;
+    }
+
+    device->gas = gas;
+#if MQ2_USE_PPM_LUT
+    if (device->is_calibrated) {
+        MQ2_BuildPpmTable(device);
+    }
+#endif
+    return MQ2_OK;
+}
+
 /**
  * @brief 读取传感器电阻值 (RS)
  */
@@ -160,48 +319,19 @@ MQ2_Status_t MQ2_ReadResistance(MQ2_Device_t *device, float *rs) {
 }
 
 /**
- * @brief 读取原始ADC值 (支持DMA和轮询两种模式)
+ * @brief 读取原始ADC值 (ADC采样服务发布的块平均值)
  */
 MQ2_Status_t MQ2_ReadRawValue(uint16_t *raw_value) {
     if (raw_value == NULL) {
         return MQ2_ERROR;
     }
 
-#if MQ2_USE_DMA_MODE == 1
-    /********************* DMA模式 *********************/
-    // 直接从后台DMA缓冲区读取预先采集好的数据。
-    // 根据CubeMX的Rank配置，MQ2(Channel 3)是第1个通道，对应索引MQ2_ADC_DMA_BUFFER_INDEX=0。
-    *raw_value = adc_dma_buffer[MQ2_ADC_DMA_BUFFER_INDEX];
-    return MQ2_OK;
-
-#else
-    /******************* 轮询模式 (非DMA) *******************/
-    // 这种模式会独占式地使用ADC，在多任务或多ADC通道环境下需谨慎使用。
-    HAL_StatusTypeDef status;
-
-    // 启动ADC转换
-    status = HAL_ADC_Start(MQ2_ADC_HANDLE);
-    if (status != HAL_OK) {
-        LOG_ERROR("轮询模式：启动ADC转换失败 (HAL Status: %d)", status);
-        return MQ2_ERROR;
-    }
-    
-    // 等待转换完成
-    status = HAL_ADC_PollForConversion(MQ2_ADC_HANDLE, MQ2_DEFAULT_TIMEOUT);
-    if (status != HAL_OK) {
-        LOG_ERROR("轮询模式：ADC转换超时 (HAL Status: %d)", status);
-        HAL_ADC_Stop(MQ2_ADC_HANDLE); // 确保在出错时停止ADC
-        return MQ2_TIMEOUT;
+    if (!ADC_Manager_IsReady()) {
+        return MQ2_BUSY;
     }
-    
-    // 读取ADC值
-    *raw_value = HAL_ADC_GetValue(MQ2_ADC_HANDLE);
-    
-    // 停止ADC
-    HAL_ADC_Stop(MQ2_ADC_HANDLE);
-    
+
+    *raw_value = ADC_Manager_GetValue(MQ2_ADC_CHANNEL);
     return MQ2_OK;
-#endif
 }
 
 /**
@@ -250,6 +380,57 @@ static float MQ2_ResistanceCalculation(uint16_t raw_adc) {
     return rs;
 }
 
+/**
+ * @brief 按气体曲线公式计算浓度: PPM = A * (RS/R0)^B
+ */
+static int MQ2_CurvePPM(const MQ2_Device_t *device, uint16_t raw_adc) {
+    float rs = MQ2_ResistanceCalculation(raw_adc);
+    if (rs <= 0.0f) {
+        return MQ2_PPM_MAX;     // RS 趋于 0 对应浓度极高
+    }
+
+    // 计算 RS/R0 比值
+    float ratio = rs / device->r0;
+    float ppm_value = mq2_gas_curve[device->gas][0] * powf(ratio, mq2_gas_curve[device->gas][1]);
+    
+    // 限制范围 (MQ-2典型范围: 200-10000 PPM)
+    if (ppm_value < 0) ppm_value = 0;
+    if (ppm_value > MQ2_PPM_MAX) ppm_value = MQ2_PPM_MAX;
+
+    return (int)ppm_value;
+}
+
+#if MQ2_USE_PPM_LUT
+/**
+ * @brief 按当前 r0 与气体曲线重建 原始ADC值 -> PPM 查找表
+ */
+static void MQ2_BuildPpmTable(MQ2_Device_t *device) {
+    for (uint32_t i = 0; i < MQ2_PPM_LUT_SIZE; i++) {
+        uint32_t raw = i << MQ2_PPM_LUT_SHIFT;
+        if (raw > MQ2_ADC_RESOLUTION) {
+            raw = MQ2_ADC_RESOLUTION;
+        }
+        device->ppm_lut[i] = (uint16_t)MQ2_CurvePPM(device, (uint16_t)raw);
+    }
+}
+#endif
+
+/**
+ * @brief 原始ADC值换算为浓度 (查表 + 线性插值，或直接按公式计算)
+ */
+static int MQ2_ConvertPPM(const MQ2_Device_t *device, uint16_t raw_adc) {
+#if MQ2_USE_PPM_LUT
+    uint32_t idx = raw_adc >> MQ2_PPM_LUT_SHIFT;
+    uint32_t frac = raw_adc & ((1U << MQ2_PPM_LUT_SHIFT) - 1);
+    int32_t y0 = device->ppm_lut[idx];
+    int32_t y1 = device->ppm_lut[idx + 1];
+
+    return (int)(y0 + (y1 - y0) * (int32_t)frac / (1 << MQ2_PPM_LUT_SHIFT));
+#else
+    return MQ2_CurvePPM(device, raw_adc);
+#endif
+}
+
 /**
  * @brief 读取传感器电阻值
  */
@@ -270,24 +451,61 @@ static uint32_t MQ2_GetTickMs(void) {
     return HAL_GetTick();
 }
 
+#if MQ2_USE_EEPROM_R0
 /**
- * @brief 执行带重试的操作
+ * @brief 从 EEPROM 恢复 R0，并累加恢复次数
  */
-static MQ2_Status_t MQ2_ExecuteWithRetry(MQ2_Device_t* device, 
-                                        MQ2_Status_t (*func)(MQ2_Device_t*), 
-                                        const char* action_name) {
-    const int max_retries = 3;
-    MQ2_Status_t status;
-    
-    for (int i = 0; i < max_retries; i++) {
-        status = func(device);
-        if (status == MQ2_OK) {
-            LOG_DEBUG("操作 '%s' 成功", action_name);
-            return MQ2_OK;
-        }
-        LOG_WARN("操作 '%s' 失败 (尝试 %d/%d)，等待重试...", action_name, i + 1, max_retries);
-        osDelay(1000);
+static MQ2_Status_t MQ2_LoadR0(MQ2_Device_t *device) {
+    uint8_t record[MQ2_R0_RECORD_LEN];
+    float r0;
+
+    at24cxx_read(MQ2_R0_EEPROM_ADDR, record, MQ2_R0_RECORD_LEN);
+
+    if (record[0] != 'M' || record[1] != '2' ||
+        CRC8_Compute(record, MQ2_R0_CRC_LEN) != record[MQ2_R0_CRC_LEN]) {
+        LOG_INFO("EEPROM中没有有效的R0记录");
+        return MQ2_ERROR;
     }
 
-    return status;
+    // 计数损坏时按已过期处理
+    uint8_t restores = record[MQ2_R0_COUNT_OFFSET];
+    if ((uint8_t)~record[MQ2_R0_COUNT_OFFSET + 1] != restores) {
+        restores = MQ2_R0_MAX_RESTORES;
+    }
+    if (restores >= MQ2_R0_MAX_RESTORES) {
+        LOG_INFO("保存的R0已过期 (已恢复 %d 次)，重新校准", restores);
+        return MQ2_ERROR;
+    }
+
+    memcpy(&r0, &record[2], sizeof(r0));
+    if (!(r0 > MQ2_R0_MIN && r0 <= MQ2_R0_MAX)) {
+        return MQ2_ERROR;
+    }
+
+    restores++;
+    record[MQ2_R0_COUNT_OFFSET] = restores;
+    record[MQ2_R0_COUNT_OFFSET + 1] = (uint8_t)~restores;
+    at24cxx_write(MQ2_R0_EEPROM_ADDR + MQ2_R0_COUNT_OFFSET, &record[MQ2_R0_COUNT_OFFSET], 2);
+
+    device->r0 = r0;
+    return MQ2_OK;
 }
+
+/**
+ * @brief 保存 R0 到 EEPROM，恢复次数清零
+ * @note  at24cxx 按页写入并以 ACK 轮询等待写周期，整条记录跨 2 页约 10ms
+ */
+static void MQ2_SaveR0(const MQ2_Device_t *device) {
+    uint8_t record[MQ2_R0_RECORD_LEN];
+
+    record[0] = 'M';
+    record[1] = '2';
+    memcpy(&record[2], &device->r0, sizeof(device->r0));
+    record[MQ2_R0_CRC_LEN] = CRC8_Compute(record, MQ2_R0_CRC_LEN);
+    record[MQ2_R0_COUNT_OFFSET] = 0;
+    record[MQ2_R0_COUNT_OFFSET + 1] = 0xFF;
+
+    at24cxx_write(MQ2_R0_EEPROM_ADDR, record, MQ2_R0_RECORD_LEN);
+    LOG_INFO("R0 已保存到EEPROM");
+}
+#endif
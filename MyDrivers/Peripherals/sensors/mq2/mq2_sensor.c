@@ -15,6 +15,9 @@
 #define LOG_MODULE "MQ2_SENSOR"
 #include "log.h"
 
+/* --------------------------- 采集配置 --------------------------- */
+#define MQ2_SENSOR_GAS  MQ2_GAS_SMOKE   // 浓度换算使用的气体曲线
+
 /* --------------------------- 私有变量 --------------------------- */
 static MQ2_Device_t g_mq2_device;      // MQ-2设备实例
 
@@ -22,14 +25,23 @@ static MQ2_Device_t g_mq2_device;      // MQ-2设备实例
 static bool MQ2_Sensor_Init(SensorInstance_t* sensor);
 static bool MQ2_Sensor_Read(SensorInstance_t* sensor);
 static bool MQ2_Sensor_Deinit(SensorInstance_t* sensor);
+static bool MQ2_Sensor_Start(SensorInstance_t* sensor, uint32_t* wait_ms);
+static SensorCollectResult_t MQ2_Sensor_Collect(SensorInstance_t* sensor, uint32_t* wait_ms);
 static const char* MQ2_Sensor_GetUnit(void);
 
 /* --------------------------- 回调函数结构体 --------------------------- */
-static const SensorCallbacks_t mq2_callbacks = {
+const SensorCallbacks_t MQ2_Sensor_Callbacks = {
     .init_func = MQ2_Sensor_Init,
     .read_func = MQ2_Sensor_Read,
     .deinit_func = MQ2_Sensor_Deinit,
-    .get_unit = MQ2_Sensor_GetUnit
+    .get_unit = MQ2_Sensor_GetUnit,
+    .start_func = MQ2_Sensor_Start,
+    .collect_func = MQ2_Sensor_Collect
+};
+
+/* --------------------------- 通道描述 --------------------------- */
+const SensorChannelDesc_t MQ2_Sensor_Channels[MQ2_SENSOR_CHANNEL_COUNT] = {
+    SENSOR_CHANNEL_INT("ppm", "PPM", smoke.ppm, 1.0f)  // 1 PPM
 };
 
 /* --------------------------- 公共函数实现 --------------------------- */
@@ -38,14 +50,8 @@ static const SensorCallbacks_t mq2_callbacks = {
  * @brief 注册MQ-2传 感器到传感器任务系统
  */
 bool MQ2_Sensor_Register(void) {
-    // 注册MQ-2传感器
-    bool result = SensorTask_RegisterSensor(
-        SENSOR_TYPE_SMOKE,          // 传感器类型
-        "MQ-2 烟雾传感器",          // 传感器名称
-        &mq2_callbacks,             // 回调函数
-        &g_mq2_device,              // 设备句柄
-        2000                        // 更新间隔2秒
-    );
+    // 注册MQ-2传感器 (名称、回调、通道表与更新间隔取自驱动配置表 sensor_config.h)
+    bool result = SensorTask_RegisterSensor(SENSOR_TYPE_SMOKE, &g_mq2_device);
 
     return result;
 }
@@ -63,7 +69,8 @@ static bool MQ2_Sensor_Init(SensorInstance_t* sensor) {
         return true;
     }
     
-    // 初始化MQ-2传感器
+    // 初始化MQ-2传感器 (气体曲线在校准后生成查找表)
+    MQ2_SetGas(device, MQ2_SENSOR_GAS);
     MQ2_Status_t status = MQ2_Init(device);
     if (status != MQ2_OK) {
         LOG_ERROR("MQ-2传感器硬件初始化失败 (状态码: %d)", status);
@@ -92,6 +99,62 @@ static bool MQ2_Sensor_Read(SensorInstance_t* sensor) {
     }
 }
 
+/**
+ * @brief MQ-2传感器开始采样回调 (分阶段读取)
+ */
+static bool MQ2_Sensor_Start(SensorInstance_t* sensor, uint32_t* wait_ms) {
+    MQ2_Device_t* device = (MQ2_Device_t*)sensor->device_handle;
+
+    // 后台校准尚未完成：交给取回回调逐步推进
+    if (MQ2_IsCalibrating(device)) {
+        *wait_ms = 0;
+        return true;
+    }
+
+    MQ2_Status_t status = MQ2_StartMeasurement(device, wait_ms);
+    if (status != MQ2_OK) {
+        LOG_ERROR("启动MQ-2传感器采样失败 (状态码: %d)", status);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief MQ-2传感器取回结果回调 (读取ADC采样服务发布的滤波值，ADC未就绪时挂起)
+ * @note  预热/校准期间每次调用推进一步校准，本轮采样保持挂起，
+ *        传感器任务在等待期间照常处理其他传感器
+ */
+static SensorCollectResult_t MQ2_Sensor_Collect(SensorInstance_t* sensor, uint32_t* wait_ms) {
+    MQ2_Device_t* device = (MQ2_Device_t*)sensor->device_handle;
+    int ppm_value;
+    MQ2_Status_t status;
+
+    if (MQ2_IsCalibrating(device)) {
+        status = MQ2_CalibrateStep(device, wait_ms);
+        if (status == MQ2_BUSY) {
+            return SENSOR_COLLECT_PENDING;
+        }
+        if (status != MQ2_OK) {
+            LOG_ERROR("MQ-2传感器校准失败 (状态码: %d)", status);
+            return SENSOR_COLLECT_ERROR;
+        }
+    }
+
+    status = MQ2_CollectPPM(device, &ppm_value, wait_ms);
+
+    if (status == MQ2_OK) {
+        // 更新传感器数据
+        sensor->data.values.smoke.ppm = ppm_value;
+        return SENSOR_COLLECT_DONE;
+    } else if (status == MQ2_BUSY) {
+        return SENSOR_COLLECT_PENDING;
+    } else {
+        // 读取失败
+        LOG_ERROR("读取MQ-2传感器数据失败 (状态码: %d)", status);
+        return SENSOR_COLLECT_ERROR;
+    }
+}
+
 /**
  * @brief MQ-2传感器反初始化回调
  */
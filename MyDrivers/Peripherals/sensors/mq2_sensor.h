@@ -8,6 +8,7 @@
 #ifndef __MQ2_SENSOR_H
 #define __MQ2_SENSOR_H
 
+#include "sensor_task.h"
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -15,6 +16,12 @@
 extern "C" {
 #endif
 
+/* --------------------------- 驱动描述 --------------------------- */
+#define MQ2_SENSOR_CHANNEL_COUNT 1  // 通道数 (ppm)
+
+extern const SensorCallbacks_t MQ2_Sensor_Callbacks;                         // 驱动回调
+extern const SensorChannelDesc_t MQ2_Sensor_Channels[MQ2_SENSOR_CHANNEL_COUNT]; // 通道表
+
 /* --------------------------- 公共函数声明 --------------------------- */
 /**
  * @brief 注册MQ-2传感器到传感器任务系统
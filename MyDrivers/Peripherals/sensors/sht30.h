@@ -21,13 +21,32 @@ extern "C" {
 extern I2C_HandleTypeDef hi2c1;
 #define SHT30_I2C_HANDLE         (&hi2c1)
 #define SHT30_USE_I2C_BUS_MANAGER 1
+#define SHT30_RETRY_COUNT        3    // 初始化各步骤的尝试次数 (在线查询除外)
+#define SHT30_RETRY_DELAY_MS     10   // 两次尝试之间的等待时间
 
 /* --------------------------- SHT30寄存器和命令 --------------------------- */
-#define SHT30_DEFAULT_ADDR  0x44    // 默认I2C地址
+#define SHT30_DEFAULT_ADDR  0x44    // 默认I2C地址 (ADDR引脚接GND)
+#define SHT30_ALT_ADDR      0x45    // ADDR引脚接VDD
 
 // SHT30指令 (2字节)
 #define SHT30_CMD_MEAS_SINGLE_H {0x2C, 0x06} // 单次测量，高精度
 #define SHT30_CMD_RESET         {0x30, 0xA2} // 软复位
+#define SHT30_CMD_FETCH         {0xE0, 0x00} // 读取周期测量的最新结果
+#define SHT30_CMD_BREAK         {0x30, 0x93} // 停止周期测量，回到空闲
+#define SHT30_CMD_HEATER_ON     {0x30, 0x6D} // 打开片上加热器
+#define SHT30_CMD_HEATER_OFF    {0x30, 0x66} // 关闭片上加热器
+#define SHT30_CMD_READ_STATUS   {0xF3, 0x2D} // 读取状态寄存器
+#define SHT30_CMD_CLEAR_STATUS  {0x30, 0x41} // 清除状态寄存器中的告警标志
+#define SHT30_MEAS_TIME_MS      20           // 高精度单次测量等待时间 (ms)
+
+// 状态寄存器位 (复位后加热器关闭)
+#define SHT30_STATUS_ALERT_PENDING  (1U << 15)  // 至少有一个待处理的告警
+#define SHT30_STATUS_HEATER_ON      (1U << 13)  // 加热器已打开
+#define SHT30_STATUS_RH_ALERT       (1U << 11)  // 湿度跟踪告警
+#define SHT30_STATUS_T_ALERT        (1U << 10)  // 温度跟踪告警
+#define SHT30_STATUS_RESET_DETECTED (1U << 4)   // 上次清除后检测到复位 (上电、软复位或掉电)
+#define SHT30_STATUS_CMD_ERROR      (1U << 1)   // 上一条命令未被执行
+#define SHT30_STATUS_CRC_ERROR      (1U << 0)   // 上一次写入的校验和错误
 
 /* --------------------------- 数据类型定义 --------------------------- */
 typedef enum {
@@ -37,9 +56,30 @@ typedef enum {
     SHT30_CRC_ERROR  = 0x03     // CRC校验错误
 } SHT30_Status_t;
 
+// 重复性：越高噪声越小，但单次转换时间和功耗越大
+typedef enum {
+    SHT30_REPEAT_HIGH = 0,      // 高 (转换约15ms)
+    SHT30_REPEAT_MEDIUM,        // 中 (转换约6ms)
+    SHT30_REPEAT_LOW            // 低 (转换约4ms)
+} SHT30_Repeatability_t;
+
+// 采集模式
+typedef enum {
+    SHT30_MODE_SINGLE = 0,          // 单次测量：每次读取先触发再等待转换
+    SHT30_MODE_PERIODIC_0_5MPS,     // 周期测量 0.5 次/秒
+    SHT30_MODE_PERIODIC_1MPS,       // 周期测量 1 次/秒
+    SHT30_MODE_PERIODIC_2MPS,       // 周期测量 2 次/秒
+    SHT30_MODE_PERIODIC_4MPS,       // 周期测量 4 次/秒
+    SHT30_MODE_PERIODIC_10MPS       // 周期测量 10 次/秒
+} SHT30_Mode_t;
+
 typedef struct {
     uint8_t addr;               // I2C地址
     bool is_initialized;        // 初始化标志
+    SHT30_Mode_t mode;          // 采集模式
+    SHT30_Repeatability_t repeatability; // 重复性
+    bool periodic_running;      // 芯片当前是否处于周期测量状态
+    bool heater_on;             // 加热器是否已打开 (复位后为关闭)
 } SHT30_Device_t;
 
 /* --------------------------- 公共函数声明 --------------------------- */
@@ -51,6 +91,25 @@ typedef struct {
  */
 SHT30_Status_t SHT30_Init(SHT30_Device_t *device, uint8_t i2c_addr);
 
+/**
+ * @brief 设置采集模式与重复性
+ * @note  未初始化时只保存配置，由 SHT30_Init() 生效；周期模式下每次读取
+ *        只是一次 FETCH，读取间隔应不短于测量周期，否则芯片会以 NACK 表示无新数据
+ * @param device SHT30设备结构体指针
+ * @param mode 采集模式
+ * @param repeatability 重复性
+ * @return SHT30_Status_t 操作状态
+ */
+SHT30_Status_t SHT30_SetMode(SHT30_Device_t *device, SHT30_Mode_t mode,
+                             SHT30_Repeatability_t repeatability);
+
+/**
+ * @brief 获取触发测量后到可取回结果的等待时间
+ * @param device SHT30设备结构体指针
+ * @return uint32_t 等待时间 (ms)，周期模式下为 0
+ */
+uint32_t SHT30_GetMeasurementTime(const SHT30_Device_t *device);
+
 /**
  * @brief 读取温度和湿度 (阻塞式)
  * @param device SHT30设备结构体指针
@@ -60,6 +119,23 @@ SHT30_Status_t SHT30_Init(SHT30_Device_t *device, uint8_t i2c_addr);
  */
 SHT30_Status_t SHT30_ReadTempHumi(SHT30_Device_t *device, float *temp, float *humi);
 
+/**
+ * @brief 触发一次测量 (非阻塞，需等待 SHT30_GetMeasurementTime() 后再取回)
+ * @note  周期模式下芯片自行测量，此函数不访问总线
+ * @param device SHT30设备结构体指针
+ * @return SHT30_Status_t 操作状态
+ */
+SHT30_Status_t SHT30_StartMeasurement(SHT30_Device_t *device);
+
+/**
+ * @brief 取回测量结果并校验 CRC (周期模式下为一次 FETCH)
+ * @param device SHT30设备结构体指针
+ * @param temp 输出的温度值 (单位: °C)
+ * @param humi 输出的湿度值 (单位: %RH)
+ * @return SHT30_Status_t 操作状态
+ */
+SHT30_Status_t SHT30_CollectTempHumi(SHT30_Device_t *device, float *temp, float *humi);
+
 /**
  * @brief 复位SHT30传感器
  * @param device SHT30设备结构体指针
@@ -67,6 +143,39 @@ SHT30_Status_t SHT30_ReadTempHumi(SHT30_Device_t *device, float *temp, float *hu
  */
 SHT30_Status_t SHT30_Reset(SHT30_Device_t *device);
 
+/**
+ * @brief 打开或关闭片上加热器
+ * @note  加热器使芯片升温数 °C，期间温度偏高、湿度偏低，读数不可用；
+ *        周期模式下芯片不接受其他命令，先停止周期测量，切换后按原配置重新
+ *        启动，新的第一个结果在 SHT30_GetRestartTime() 之后才可取回
+ * @param device SHT30设备结构体指针
+ * @param on true: 打开，false: 关闭
+ * @return SHT30_Status_t 操作状态
+ */
+SHT30_Status_t SHT30_SetHeater(SHT30_Device_t *device, bool on);
+
+/**
+ * @brief 获取周期测量重新启动后到第一个结果可取回的时间
+ * @param device SHT30设备结构体指针
+ * @return uint32_t 等待时间 (ms)，单次模式下为 0
+ */
+uint32_t SHT30_GetRestartTime(const SHT30_Device_t *device);
+
+/**
+ * @brief 读取状态寄存器
+ * @param device SHT30设备结构体指针
+ * @param status 输出的状态字 (SHT30_STATUS_*)
+ * @return SHT30_Status_t 操作状态
+ */
+SHT30_Status_t SHT30_ReadStatus(SHT30_Device_t *device, uint16_t *status);
+
+/**
+ * @brief 清除状态寄存器中的告警与复位标志
+ * @param device SHT30设备结构体指针
+ * @return SHT30_Status_t 操作状态
+ */
+SHT30_Status_t SHT30_ClearStatus(SHT30_Device_t *device);
+
 /**
  * @brief 检查传感器是否在线
  * @param device SHT30设备结构体指针
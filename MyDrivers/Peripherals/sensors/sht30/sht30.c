@@ -10,6 +10,7 @@
 #include <string.h>
 #include <stdio.h>
 #include "i2c_bus_manager.h"
+#include "checksum.h"
 
 /* --------------------------- 调试宏定义 --------------------------- */
 #define LOG_MODULE "SHT30"
@@ -18,10 +19,31 @@
 #define SHT30_DEFAULT_TIMEOUT    200
 #define SHT30_I2C_LOCK_TIMEOUT_MS 100
 
+/* --------------------------- 命令表 --------------------------- */
+// 单次测量 (时钟拉伸) 命令 LSB，按重复性索引，MSB 固定为 0x2C
+static const uint8_t sht30_single_lsb[3] = {0x06, 0x0D, 0x10};
+// 单次测量最长转换时间 (ms)，按重复性索引
+static const uint8_t sht30_meas_time_ms[3] = {SHT30_MEAS_TIME_MS, 8, 6};
+// 周期测量命令，按 [测量频率][重复性] 索引
+static const uint8_t sht30_periodic_cmd[5][3][2] = {
+    {{0x20, 0x32}, {0x20, 0x24}, {0x20, 0x2F}},     // 0.5 mps
+    {{0x21, 0x30}, {0x21, 0x26}, {0x21, 0x2D}},     // 1 mps
+    {{0x22, 0x36}, {0x22, 0x20}, {0x22, 0x2B}},     // 2 mps
+    {{0x23, 0x34}, {0x23, 0x22}, {0x23, 0x29}},     // 4 mps
+    {{0x27, 0x37}, {0x27, 0x21}, {0x27, 0x2A}}      // 10 mps
+};
+
 /* --------------------------- 私有函数声明 --------------------------- */
 static SHT30_Status_t SHT30_WriteCommand(SHT30_Device_t *device, const uint8_t *command, uint16_t size);
 static SHT30_Status_t SHT30_ReadData(SHT30_Device_t *device, uint8_t *data, uint16_t size);
-static uint8_t SHT30_CheckCrc(uint8_t *data, uint8_t len);
+static SHT30_Status_t SHT30_ParseTempHumi(const uint8_t *data, float *temp, float *humi);
+static SHT30_Status_t SHT30_WriteRead(SHT30_Device_t *device, const uint8_t *command,
+                                      uint16_t delay_ms, uint8_t *data, uint16_t size);
+static SHT30_Status_t SHT30_ApplyMode(SHT30_Device_t *device);
+static SHT30_Status_t SHT30_BeginIdleCommand(SHT30_Device_t *device, bool *was_periodic);
+static SHT30_Status_t SHT30_EndIdleCommand(SHT30_Device_t *device, bool was_periodic,
+                                           SHT30_Status_t status);
+static SHT30_Status_t SHT30_StopPeriodic(SHT30_Device_t *device);
 static SHT30_Status_t SHT30_ExecuteWithRetry(SHT30_Device_t *device, 
                                             SHT30_Status_t (*func)(SHT30_Device_t *), 
                                             const char *action_name);
@@ -40,18 +62,28 @@ SHT30_Status_t SHT30_Init(SHT30_Device_t *device, uint8_t i2c_addr) {
 
     LOG_INFO("开始初始化SHT30设备, I2C地址: 0x%02X", i2c_addr);
 
-    // 初始化设备结构体
+    // 初始化设备结构体 (保留 SHT30_SetMode() 预先设置的采集配置)
+    SHT30_Mode_t mode = device->mode;
+    SHT30_Repeatability_t repeatability = device->repeatability;
     memset(device, 0, sizeof(SHT30_Device_t));
     device->addr = i2c_addr;
     device->is_initialized = false;
+    device->mode = mode;
+    device->repeatability = repeatability;
     
-    // 初始化设备
-    if (SHT30_ExecuteWithRetry(device, SHT30_IsOnline, "查询设备在线状态") != SHT30_OK) {
+    // 在线查询只尝试一次：设备缺失时立即返回，由传感器任务按退避间隔重新探测
+    if (SHT30_IsOnline(device) != SHT30_OK) {
+        LOG_DEBUG("SHT30设备 0x%02X 无响应", i2c_addr);
         return SHT30_ERROR;
     }
+    // 上电前可能残留周期测量状态，复位前先发送停止命令 (空闲时芯片会忽略/NACK)
+    device->periodic_running = true;
     if (SHT30_ExecuteWithRetry(device, SHT30_Reset, "复位设备") != SHT30_OK) {
         return SHT30_ERROR;
     }
+    if (SHT30_ExecuteWithRetry(device, SHT30_ApplyMode, "设置采集模式") != SHT30_OK) {
+        return SHT30_ERROR;
+    }
 
     device->is_initialized = true;          // 标记为已初始化
     return SHT30_OK;
@@ -61,43 +93,76 @@ SHT30_Status_t SHT30_Init(SHT30_Device_t *device, uint8_t i2c_addr) {
  * @brief 获取SHT30传感器温湿度数据
  */
 SHT30_Status_t SHT30_ReadTempHumi(SHT30_Device_t *device, float *temp, float *humi) {
+#if SHT30_USE_I2C_BUS_MANAGER
     if (device == NULL || temp == NULL || humi == NULL || !device->is_initialized) {
         return SHT30_ERROR;
     }
 
-    // 发送单次测量命令
-    uint8_t cmd[2] = SHT30_CMD_MEAS_SINGLE_H;
-    SHT30_Status_t status = SHT30_WriteCommand(device, cmd, 2);
+    // 周期模式直接 FETCH；单次模式把命令 + 等待 + 读取合并为一个总线事务，
+    // 转换期间总线可服务其他从机
+    if (device->mode != SHT30_MODE_SINGLE) {
+        return SHT30_CollectTempHumi(device, temp, humi);
+    }
+
+    uint8_t cmd[2] = {0x2C, sht30_single_lsb[device->repeatability]};
+    uint8_t data[6];
+    SHT30_Status_t status = SHT30_WriteRead(device, cmd, SHT30_GetMeasurementTime(device), data, 6);
+    if (status != SHT30_OK) return status;
+
+    return SHT30_ParseTempHumi(data, temp, humi);
+#else
+    SHT30_Status_t status = SHT30_StartMeasurement(device);
     if (status != SHT30_OK) return status;
 
     // 等待测量完成 (高精度模式约15ms)
-    osDelay(20);
+    uint32_t wait_ms = SHT30_GetMeasurementTime(device);
+    if (wait_ms > 0) {
+        osDelay(wait_ms);
+    }
 
-    // 读取6字节数据 (Temp_MSB, Temp_LSB, Temp_CRC, Humi_MSB, Humi_LSB, Humi_CRC)
-    uint8_t data[6];
-    status = SHT30_ReadData(device, data, 6);
-    if (status != SHT30_OK) return status;
+    return SHT30_CollectTempHumi(device, temp, humi);
+#endif
+}
 
-    // 校验温度CRC
-    if (SHT30_CheckCrc(data, 2) != data[2]) {
-        LOG_ERROR("温度数据CRC校验失败!");
-        return SHT30_CRC_ERROR;
+/**
+ * @brief 触发一次单次测量
+ */
+SHT30_Status_t SHT30_StartMeasurement(SHT30_Device_t *device) {
+    if (device == NULL || !device->is_initialized) {
+        return SHT30_ERROR;
     }
 
-    // 校验湿度CRC
-    if (SHT30_CheckCrc(data + 3, 2) != data[5]) {
-        LOG_ERROR("湿度数据CRC校验失败!");
-        return SHT30_CRC_ERROR;
+    // 周期模式由芯片自行测量，无需触发
+    if (device->mode != SHT30_MODE_SINGLE) {
+        return SHT30_OK;
     }
 
-    // 计算温度和湿度
-    uint16_t raw_temp = (data[0] << 8) | data[1];
-    uint16_t raw_humi = (data[3] << 8) | data[4];
+    // 发送单次测量命令
+    uint8_t cmd[2] = {0x2C, sht30_single_lsb[device->repeatability]};
+    return SHT30_WriteCommand(device, cmd, 2);
+}
 
-    *temp = -45.0f + 175.0f * ((float)raw_temp / 65535.0f);
-    *humi = 100.0f * ((float)raw_humi / 65535.0f);
+/**
+ * @brief 取回测量结果
+ */
+SHT30_Status_t SHT30_CollectTempHumi(SHT30_Device_t *device, float *temp, float *humi) {
+    if (device == NULL || temp == NULL || humi == NULL || !device->is_initialized) {
+        return SHT30_ERROR;
+    }
 
-    return SHT30_OK;
+    // 读取6字节数据 (Temp_MSB, Temp_LSB, Temp_CRC, Humi_MSB, Humi_LSB, Humi_CRC)
+    uint8_t data[6];
+    SHT30_Status_t status;
+    if (device->mode != SHT30_MODE_SINGLE) {
+        // 周期模式：FETCH 命令与读取合并为一个短事务，无转换等待
+        uint8_t cmd[2] = SHT30_CMD_FETCH;
+        status = SHT30_WriteRead(device, cmd, 0, data, 6);
+    } else {
+        status = SHT30_ReadData(device, data, 6);
+    }
+    if (status != SHT30_OK) return status;
+
+    return SHT30_ParseTempHumi(data, temp, humi);
 }
 
 /**
@@ -108,14 +173,130 @@ SHT30_Status_t SHT30_Reset(SHT30_Device_t *device) {
         return SHT30_ERROR;
     }
 
+    // 周期测量期间芯片不响应软复位，先停止
+    if (device->periodic_running) {
+        (void)SHT30_StopPeriodic(device);
+    }
+
     uint8_t cmd[2] = SHT30_CMD_RESET;
     SHT30_Status_t status = SHT30_WriteCommand(device, cmd, 2);
     if (status == SHT30_OK) {
+        device->heater_on = false;  // 软复位同时关闭加热器
         osDelay(10); // 等待复位完成
     }
     return status;
 }
 
+/**
+ * @brief 设置采集模式与重复性
+ */
+SHT30_Status_t SHT30_SetMode(SHT30_Device_t *device, SHT30_Mode_t mode,
+                             SHT30_Repeatability_t repeatability) {
+    if (device == NULL || mode > SHT30_MODE_PERIODIC_10MPS ||
+        repeatability > SHT30_REPEAT_LOW) {
+        return SHT30_ERROR;
+    }
+
+    // 先切回空闲状态，才能接受新的周期命令
+    if (device->is_initialized && device->periodic_running) {
+        SHT30_Status_t status = SHT30_StopPeriodic(device);
+        if (status != SHT30_OK) return status;
+    }
+
+    device->mode = mode;
+    device->repeatability = repeatability;
+
+    // 未初始化时只保存配置
+    if (!device->is_initialized) {
+        return SHT30_OK;
+    }
+    return SHT30_ApplyMode(device);
+}
+
+/**
+ * @brief 获取触发测量后到可取回结果的等待时间
+ */
+uint32_t SHT30_GetMeasurementTime(const SHT30_Device_t *device) {
+    if (device == NULL || device->mode != SHT30_MODE_SINGLE) {
+        return 0;
+    }
+    return sht30_meas_time_ms[device->repeatability];
+}
+
+/**
+ * @brief 打开或关闭片上加热器
+ */
+SHT30_Status_t SHT30_SetHeater(SHT30_Device_t *device, bool on) {
+    if (device == NULL || !device->is_initialized) {
+        return SHT30_ERROR;
+    }
+
+    bool was_periodic;
+    SHT30_Status_t status = SHT30_BeginIdleCommand(device, &was_periodic);
+    if (status == SHT30_OK) {
+        uint8_t cmd_on[2] = SHT30_CMD_HEATER_ON;
+        uint8_t cmd_off[2] = SHT30_CMD_HEATER_OFF;
+        status = SHT30_WriteCommand(device, on ? cmd_on : cmd_off, 2);
+        if (status == SHT30_OK) {
+            device->heater_on = on;
+        }
+    }
+    return SHT30_EndIdleCommand(device, was_periodic, status);
+}
+
+/**
+ * @brief 获取周期测量重新启动后到第一个结果可取回的时间
+ */
+uint32_t SHT30_GetRestartTime(const SHT30_Device_t *device) {
+    if (device == NULL || device->mode == SHT30_MODE_SINGLE) {
+        return 0;
+    }
+    // 重新启动后立即开始第一次转换，转换时间与单次测量相同
+    return sht30_meas_time_ms[device->repeatability];
+}
+
+/**
+ * @brief 读取状态寄存器
+ */
+SHT30_Status_t SHT30_ReadStatus(SHT30_Device_t *device, uint16_t *status) {
+    if (device == NULL || status == NULL || !device->is_initialized) {
+        return SHT30_ERROR;
+    }
+
+    bool was_periodic;
+    uint8_t data[3];
+    SHT30_Status_t result = SHT30_BeginIdleCommand(device, &was_periodic);
+    if (result == SHT30_OK) {
+        uint8_t cmd[2] = SHT30_CMD_READ_STATUS;
+        result = SHT30_WriteRead(device, cmd, 0, data, 3);
+    }
+    if (result == SHT30_OK && CRC8_Compute(data, 2) != data[2]) {
+        LOG_ERROR("状态寄存器CRC校验失败!");
+        result = SHT30_CRC_ERROR;
+    }
+    if (result == SHT30_OK) {
+        *status = (uint16_t)((data[0] << 8) | data[1]);
+    }
+    return SHT30_EndIdleCommand(device, was_periodic, result);
+}
+
+/**
+ * @brief 清除状态寄存器中的告警与复位标志
+ */
+SHT30_Status_t SHT30_ClearStatus(SHT30_Device_t *device) {
+    if (device == NULL || !device->is_initialized) {
+        return SHT30_ERROR;
+    }
+
+    bool was_periodic;
+    SHT30_Status_t status = SHT30_BeginIdleCommand(device, &was_periodic);
+    if (status == SHT30_OK) {
+        uint8_t cmd[2] = SHT30_CMD_CLEAR_STATUS;
+        status = SHT30_WriteCommand(device, cmd, 2);
+    }
+    return SHT30_EndIdleCommand(device, was_periodic, status);
+}
+
 /**
  * @brief 检查SHT30传感器是否在线
  */ 
@@ -162,20 +343,21 @@ static SHT30_Status_t SHT30_WriteCommand(SHT30_Device_t *device, const uint8_t *
     HAL_StatusTypeDef hal_status;
 
 #if SHT30_USE_I2C_BUS_MANAGER
-    if (!I2C_Bus_Lock(SHT30_I2C_LOCK_TIMEOUT_MS)) {
-        LOG_ERROR("SHT30发送命令时获取I2C总线锁失败");
-        return SHT30_TIMEOUT;
-    }
-#endif
+    // 交给总线服务执行，等待期间任务让出 CPU
+    I2C_Transaction_t xfer;
+    I2C_Transaction_Init(&xfer, device->addr);
+    xfer.tx_buf = command;
+    xfer.tx_len = size;
+    xfer.timeout_ms = SHT30_DEFAULT_TIMEOUT;
+    hal_status = I2C_Bus_Execute(&xfer);
+#else
     hal_status = HAL_I2C_Master_Transmit(
-        SHT30_I2C_HANDLE, 
-        device->addr << 1, 
-        (uint8_t*)command, 
-        size, 
+        SHT30_I2C_HANDLE,
+        device->addr << 1,
+        (uint8_t*)command,
+        size,
         SHT30_DEFAULT_TIMEOUT
     );
-#if (SHT30_USE_I2C_BUS_MANAGER == 1)
-    I2C_Bus_Unlock();
 #endif
     switch (hal_status) {
         case HAL_OK:      return SHT30_OK;
@@ -195,20 +377,21 @@ static SHT30_Status_t SHT30_ReadData(SHT30_Device_t *device, uint8_t *data, uint
     HAL_StatusTypeDef hal_status;
 
 #if SHT30_USE_I2C_BUS_MANAGER
-    if (!I2C_Bus_Lock(SHT30_I2C_LOCK_TIMEOUT_MS)) {
-        LOG_ERROR("SHT30读取数据时获取I2C总线锁失败");
-        return SHT30_TIMEOUT;
-    }
-#endif
+    // 交给总线服务执行，等待期间任务让出 CPU
+    I2C_Transaction_t xfer;
+    I2C_Transaction_Init(&xfer, device->addr);
+    xfer.rx_buf = data;
+    xfer.rx_len = size;
+    xfer.timeout_ms = SHT30_DEFAULT_TIMEOUT;
+    hal_status = I2C_Bus_Execute(&xfer);
+#else
     hal_status = HAL_I2C_Master_Receive(
-        SHT30_I2C_HANDLE, 
-        device->addr << 1, 
-        data, 
-        size, 
+        SHT30_I2C_HANDLE,
+        device->addr << 1,
+        data,
+        size,
         SHT30_DEFAULT_TIMEOUT
     );
-#if (SHT30_USE_I2C_BUS_MANAGER == 1)
-    I2C_Bus_Unlock();
 #endif
     switch (hal_status) {
         case HAL_OK:      return SHT30_OK;
@@ -218,21 +401,113 @@ static SHT30_Status_t SHT30_ReadData(SHT30_Device_t *device, uint8_t *data, uint
 }
 
 /**
- * @brief CRC校验函数
+ * @brief 发送命令并读取结果 (命令与读取合并为一个总线事务)
  */
-static uint8_t SHT30_CheckCrc(uint8_t *data, uint8_t len) {
-    uint8_t crc = 0xFF;
-    for (uint8_t i = 0; i < len; i++) {
-        crc ^= data[i];
-        for (uint8_t j = 8; j > 0; --j) {
-            if (crc & 0x80) {
-                crc = (crc << 1) ^ 0x31;
-            } else {
-                crc = (crc << 1);
-            }
+static SHT30_Status_t SHT30_WriteRead(SHT30_Device_t *device, const uint8_t *command,
+                                      uint16_t delay_ms, uint8_t *data, uint16_t size) {
+#if SHT30_USE_I2C_BUS_MANAGER
+    I2C_Transaction_t xfer;
+    I2C_Transaction_Init(&xfer, device->addr);
+    xfer.tx_buf = command;
+    xfer.tx_len = 2;
+    xfer.delay_ms = delay_ms;
+    xfer.rx_buf = data;
+    xfer.rx_len = size;
+    xfer.timeout_ms = SHT30_DEFAULT_TIMEOUT;
+
+    HAL_StatusTypeDef hal_status = I2C_Bus_Execute(&xfer);
+    switch (hal_status) {
+        case HAL_OK:      return SHT30_OK;
+        case HAL_TIMEOUT: LOG_ERROR("SHT30 I2C测量事务超时"); return SHT30_TIMEOUT;
+        default:          LOG_ERROR("SHT30 I2C测量事务失败, HAL Status: %d", hal_status); return SHT30_ERROR;
+    }
+#else
+    SHT30_Status_t status = SHT30_WriteCommand(device, command, 2);
+    if (status != SHT30_OK) return status;
+    if (delay_ms > 0) {
+        osDelay(delay_ms);
+    }
+    return SHT30_ReadData(device, data, size);
+#endif
+}
+
+/**
+ * @brief 按当前配置启动周期测量 (单次模式无需操作)
+ */
+static SHT30_Status_t SHT30_ApplyMode(SHT30_Device_t *device) {
+    if (device->mode == SHT30_MODE_SINGLE) {
+        return SHT30_OK;
+    }
+
+    const uint8_t *cmd = sht30_periodic_cmd[device->mode - SHT30_MODE_PERIODIC_0_5MPS][device->repeatability];
+    SHT30_Status_t status = SHT30_WriteCommand(device, cmd, 2);
+    if (status == SHT30_OK) {
+        device->periodic_running = true;
+    }
+    return status;
+}
+
+/**
+ * @brief 停止周期测量
+ */
+static SHT30_Status_t SHT30_StopPeriodic(SHT30_Device_t *device) {
+    uint8_t cmd[2] = SHT30_CMD_BREAK;
+    SHT30_Status_t status = SHT30_WriteCommand(device, cmd, 2);
+    device->periodic_running = false;
+    osDelay(1);     // 停止命令需约1ms生效
+    return status;
+}
+
+/**
+ * @brief 发送非测量命令前切回空闲 (周期测量期间芯片只接受 FETCH 与停止命令)
+ */
+static SHT30_Status_t SHT30_BeginIdleCommand(SHT30_Device_t *device, bool *was_periodic) {
+    *was_periodic = device->periodic_running;
+    if (*was_periodic) {
+        return SHT30_StopPeriodic(device);
+    }
+    return SHT30_OK;
+}
+
+/**
+ * @brief 命令完成后按原配置恢复周期测量
+ * @return 命令本身失败时返回命令的状态，否则返回恢复的状态
+ */
+static SHT30_Status_t SHT30_EndIdleCommand(SHT30_Device_t *device, bool was_periodic,
+                                           SHT30_Status_t status) {
+    if (was_periodic) {
+        SHT30_Status_t restart = SHT30_ApplyMode(device);
+        if (status == SHT30_OK) {
+            status = restart;
         }
     }
-    return crc;
+    return status;
+}
+
+/**
+ * @brief 校验并换算6字节测量结果
+ */
+static SHT30_Status_t SHT30_ParseTempHumi(const uint8_t *data, float *temp, float *humi) {
+    // 校验温度CRC
+    if (CRC8_Compute(data, 2) != data[2]) {
+        LOG_ERROR("温度数据CRC校验失败!");
+        return SHT30_CRC_ERROR;
+    }
+
+    // 校验湿度CRC
+    if (CRC8_Compute(data + 3, 2) != data[5]) {
+        LOG_ERROR("湿度数据CRC校验失败!");
+        return SHT30_CRC_ERROR;
+    }
+
+    // 计算温度和湿度
+    uint16_t raw_temp = (data[0] << 8) | data[1];
+    uint16_t raw_humi = (data[3] << 8) | data[4];
+
+    *temp = -45.0f + 175.0f * ((float)raw_temp / 65535.0f);
+    *humi = 100.0f * ((float)raw_humi / 65535.0f);
+
+    return SHT30_OK;
 }
 
 /**
@@ -241,7 +516,7 @@ static uint8_t SHT30_CheckCrc(uint8_t *data, uint8_t len) {
 static SHT30_Status_t SHT30_ExecuteWithRetry(SHT30_Device_t *device,
                                             SHT30_Status_t (*func)(SHT30_Device_t *),
                                             const char *action_name) {
-    const int max_retries = 3;
+    const int max_retries = SHT30_RETRY_COUNT;
     SHT30_Status_t status;
     for (int i = 0; i < max_retries; i++) {
         status = func(device);
@@ -250,7 +525,9 @@ static SHT30_Status_t SHT30_ExecuteWithRetry(SHT30_Device_t *device,
             return SHT30_OK;
         }
         LOG_WARN("操作 '%s' 失败 (尝试 %d/%d)，等待重试...", action_name, i + 1, max_retries);
-        osDelay(100);
+        if (i + 1 < max_retries) {
+            osDelay(SHT30_RETRY_DELAY_MS);
+        }
     }
     LOG_ERROR("经过 %d 次尝试, 操作 '%s' 仍失败", max_retries, action_name);
     return status;                                            
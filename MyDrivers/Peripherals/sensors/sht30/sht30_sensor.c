@@ -7,6 +7,8 @@
 
 #include "sht30_sensor.h"
 #include "sht30.h"
+#include "sensor_quality.h"
+#include "cmsis_os.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -15,39 +17,97 @@
 #include "log.h"
 
 
+/* --------------------------- 采集配置 --------------------------- */
+// 周期模式下每次读取只是一次 FETCH，无转换等待；读取间隔 (见 sensor_config.h) 须不短于测量周期
+#define SHT30_SENSOR_MODE           SHT30_MODE_PERIODIC_1MPS
+#define SHT30_SENSOR_REPEATABILITY  SHT30_REPEAT_HIGH   // 降低可减小功耗，噪声会增大
+
+/* --------------------------- 加热器策略 --------------------------- */
+// 湿度长时间接近饱和时芯片表面结露，读数卡在 100%RH 附近，干燥后数分钟内仍偏高；
+// 持续超过阈值一段时间后打开片上加热器蒸发凝结水，加热期间与冷却恢复期间的
+// 读数标记为 SENSOR_QUALITY_INVALID (保持上一个有效值，不进入历史、统计与告警)
+#define SHT30_HEATER_ENABLE         1
+#define SHT30_HEATER_RH_THRESHOLD   95.0f                // 触发加热的湿度 (%RH)
+#define SHT30_HEATER_HOLD_MS        (5U * 60U * 1000U)   // 持续超过阈值多久后加热 (同时是两次加热的最小间隔)
+#define SHT30_HEATER_PULSE_MS       10000U               // 加热时长
+#define SHT30_HEATER_RECOVERY_MS    60000U               // 关闭加热器后读数恢复所需时间
+
+typedef enum {
+    SHT30_HEATER_IDLE = 0,      // 正常测量
+    SHT30_HEATER_PULSE,         // 加热中
+    SHT30_HEATER_RECOVERY       // 加热器已关闭，等待芯片冷却
+} SHT30_HeaterPhase_t;
+
+typedef struct {
+    SHT30_HeaterPhase_t phase;
+    bool toggle_pending;        // 下次触发转换前切换加热器 (按 phase 决定开关)
+    bool humid;                 // 上一个读数超过阈值
+    uint32_t humid_since;       // 开始超过阈值的时刻
+    uint32_t phase_end;         // 当前阶段结束时刻
+    uint32_t pulse_count;       // 上电以来的加热次数
+} SHT30_HeaterCtx_t;
+
 /* --------------------------- 私有变量 --------------------------- */
-static SHT30_Device_t g_sht30_device; // SHT30设备实例
+static SHT30_Device_t g_sht30_devices[SENSOR_MAX_PER_TYPE]; // SHT30设备实例 (按实例序号)
+static uint8_t g_sht30_count;                               // 已注册的实例数
+static SHT30_HeaterCtx_t g_sht30_heater[SENSOR_MAX_PER_TYPE]; // 加热器策略状态 (与设备同序号)
 
 /* --------------------------- 私有函数声明 --------------------------- */
 static bool SHT30_Sensor_Init(SensorInstance_t* sensor);
 static bool SHT30_Sensor_Read(SensorInstance_t* sensor);
 static bool SHT30_Sensor_Deinit(SensorInstance_t* sensor);
+static bool SHT30_Sensor_Start(SensorInstance_t* sensor, uint32_t* wait_ms);
+static SensorCollectResult_t SHT30_Sensor_Collect(SensorInstance_t* sensor, uint32_t* wait_ms);
 static const char* SHT30_Sensor_GetUnit(void);
+static SHT30_HeaterCtx_t* SHT30_Sensor_Heater(const SHT30_Device_t* device);
+static uint32_t SHT30_Sensor_ApplyHeater(SensorInstance_t* sensor);
+static void SHT30_Sensor_UpdateHeater(SensorInstance_t* sensor);
 
 /* --------------------------- 回调函数结构体 --------------------------- */
-static const SensorCallbacks_t sht30_callbacks = {
+const SensorCallbacks_t SHT30_Sensor_Callbacks = {
     .init_func = SHT30_Sensor_Init,
     .read_func = SHT30_Sensor_Read,
     .deinit_func = SHT30_Sensor_Deinit,
-    .get_unit = SHT30_Sensor_GetUnit
+    .get_unit = SHT30_Sensor_GetUnit,
+    .start_func = SHT30_Sensor_Start,
+    .collect_func = SHT30_Sensor_Collect
+};
+
+/* --------------------------- 通道描述 --------------------------- */
+const SensorChannelDesc_t SHT30_Sensor_Channels[SHT30_SENSOR_CHANNEL_COUNT] = {
+    SENSOR_CHANNEL_FLOAT("temp", "C", sht30.temp, 100.0f),   // 0.01°C
+    SENSOR_CHANNEL_FLOAT("humi", "%RH", sht30.humi, 100.0f)  // 0.01%RH
 };
 
 /* --------------------------- 公共函数实现 --------------------------- */
 
 /**
- * @brief 注册SHT30传感器到传感器任务系统
+ * @brief 注册默认地址的SHT30传感器到传感器任务系统
+ */
+bool SHT30_Sensor_Register(void) {
+    return SHT30_Sensor_Attach(SHT30_DEFAULT_ADDR) != SENSOR_HANDLE_INVALID;
+}
+
+/**
+ * @brief 注册指定地址的SHT30传感器 (总线探测发现设备后调用)
  */
-bool SHT30_Sensor_Register(void) {    
-    // 1. 注册温度传感器
-    bool result = SensorTask_RegisterSensor(
-        SENSOR_TYPE_SHT30,      // 传感器类型    
-        "SHT30 温湿度传感器",   // 传感器名称
-        &sht30_callbacks,  // 回调函数
-        &g_sht30_device,        // 设备句柄
-        3000                    // 更新间隔3秒
-    );
-
-    return result;
+SensorHandle_t SHT30_Sensor_Attach(uint8_t addr) {
+    if (g_sht30_count >= SENSOR_MAX_PER_TYPE) {
+        LOG_ERROR("SHT30实例已满，忽略地址 0x%02X", addr);
+        return SENSOR_HANDLE_INVALID;
+    }
+
+    // 地址保存在设备结构体中，初始化回调按此地址初始化
+    SHT30_Device_t* device = &g_sht30_devices[g_sht30_count];
+    memset(device, 0, sizeof(SHT30_Device_t));
+    device->addr = addr;
+
+    // 名称、回调、通道表与更新间隔取自驱动配置表 (sensor_config.h)
+    SensorHandle_t handle = SensorTask_RegisterInstance(SENSOR_TYPE_SHT30, device);
+    if (handle != SENSOR_HANDLE_INVALID) {
+        g_sht30_count++;
+    }
+    return handle;
 }
 
 /* --------------------------- 传感器回调函数实现 --------------------------- */
@@ -63,8 +123,10 @@ static bool SHT30_Sensor_Init(SensorInstance_t* sensor) {
         return true;
     }
 
-    // 初始化SHT30设备
-    SHT30_Status_t status = SHT30_Init(device, SHT30_DEFAULT_ADDR);
+    // 初始化SHT30设备 (采集模式在初始化时生效；复位后加热器关闭)
+    memset(SHT30_Sensor_Heater(device), 0, sizeof(SHT30_HeaterCtx_t));
+    SHT30_SetMode(device, SHT30_SENSOR_MODE, SHT30_SENSOR_REPEATABILITY);
+    SHT30_Status_t status = SHT30_Init(device, device->addr);
     if (status != SHT30_OK) {
         LOG_ERROR("SHT30传感器硬件初始化失败(状态码: %d)", status);
         return false;
@@ -78,12 +140,19 @@ static bool SHT30_Sensor_Init(SensorInstance_t* sensor) {
 static bool SHT30_Sensor_Read(SensorInstance_t* sensor) {
     SHT30_Device_t* device = (SHT30_Device_t*)sensor->device_handle;
     float temp, humi;
+
+    // 切换加热器后周期测量重新启动，等待第一个新结果
+    uint32_t restart_ms = SHT30_Sensor_ApplyHeater(sensor);
+    if (restart_ms > 0) {
+        osDelay(restart_ms);
+    }
     SHT30_Status_t status = SHT30_ReadTempHumi(device, &temp, &humi);
  
     if (status == SHT30_OK) {
         sensor->data.values.sht30.temp = temp;
         sensor->data.values.sht30.humi = humi;
         sensor->data.is_valid = true;
+        SHT30_Sensor_UpdateHeater(sensor);
         return true;
     } else {
         sensor->data.is_valid = false;
@@ -92,6 +161,50 @@ static bool SHT30_Sensor_Read(SensorInstance_t* sensor) {
     }
 }
 
+/**
+ * @brief SHT30传感器触发转换回调 (分阶段读取)
+ */
+static bool SHT30_Sensor_Start(SensorInstance_t* sensor, uint32_t* wait_ms) {
+    SHT30_Device_t* device = (SHT30_Device_t*)sensor->device_handle;
+
+    // 切换加热器会重新启动周期测量：推迟取回，避免 FETCH 因无新数据被 NACK 计为错误
+    uint32_t restart_ms = SHT30_Sensor_ApplyHeater(sensor);
+
+    SHT30_Status_t status = SHT30_StartMeasurement(device);
+    if (status != SHT30_OK) {
+        LOG_ERROR("触发SHT30传感器测量失败 (状态码: %d)", status);
+        return false;
+    }
+    *wait_ms = SHT30_GetMeasurementTime(device);   // 周期模式下为 0
+    if (restart_ms > *wait_ms) {
+        *wait_ms = restart_ms;
+    }
+    return true;
+}
+
+/**
+ * @brief SHT30传感器取回结果回调 (分阶段读取)
+ */
+static SensorCollectResult_t SHT30_Sensor_Collect(SensorInstance_t* sensor, uint32_t* wait_ms) {
+    SHT30_Device_t* device = (SHT30_Device_t*)sensor->device_handle;
+    float temp, humi;
+
+    (void)wait_ms;
+    SHT30_Status_t status = SHT30_CollectTempHumi(device, &temp, &humi);
+
+    if (status == SHT30_OK) {
+        sensor->data.values.sht30.temp = temp;
+        sensor->data.values.sht30.humi = humi;
+        sensor->data.is_valid = true;
+        SHT30_Sensor_UpdateHeater(sensor);
+        return SENSOR_COLLECT_DONE;
+    } else {
+        sensor->data.is_valid = false;
+        LOG_ERROR("读取SHT30传感器数据失败 (状态码: %d)", status);
+        return SENSOR_COLLECT_ERROR;
+    }
+}
+
 /**
  * @brief SHT30传感器反初始化回调
  * @note  SHT30 本身就会处于低功耗模式，这里只是复位设备并标记为未初始化
@@ -99,6 +212,7 @@ static bool SHT30_Sensor_Read(SensorInstance_t* sensor) {
 static bool SHT30_Sensor_Deinit(SensorInstance_t* sensor) {
     SHT30_Device_t* device = (SHT30_Device_t*)sensor->device_handle;
 
+    memset(SHT30_Sensor_Heater(device), 0, sizeof(SHT30_HeaterCtx_t));
     if (device->is_initialized) {
         device->is_initialized = false;     // 标记为未初始化
         if (SHT30_Reset(device) != SHT30_OK) {
@@ -116,3 +230,97 @@ static const char* SHT30_Sensor_GetUnit(void) {
     // 对于多值传感器，这个函数意义不大，可以返回一个通用描述或空字符串
     return "C/%RH";
 }
+
+/* --------------------------- 加热器策略实现 --------------------------- */
+
+/**
+ * @brief 获取设备对应的加热器策略状态
+ */
+static SHT30_HeaterCtx_t* SHT30_Sensor_Heater(const SHT30_Device_t* device) {
+    return &g_sht30_heater[device - g_sht30_devices];
+}
+
+/**
+ * @brief 执行待处理的加热器切换 (在触发转换之前调用)
+ * @return 切换后到第一个新结果可取回的等待时间 (ms)，未切换时为 0
+ */
+static uint32_t SHT30_Sensor_ApplyHeater(SensorInstance_t* sensor) {
+    SHT30_Device_t* device = (SHT30_Device_t*)sensor->device_handle;
+    SHT30_HeaterCtx_t* ctx = SHT30_Sensor_Heater(device);
+    bool on = (ctx->phase == SHT30_HEATER_PULSE);
+    uint16_t reg;
+
+    if (!ctx->toggle_pending) {
+        return 0;
+    }
+    if (SHT30_SetHeater(device, on) != SHT30_OK) {
+        LOG_WARN("%s 加热器%s失败", sensor->name, on ? "打开" : "关闭");
+        if (on) {
+            ctx->phase = SHT30_HEATER_IDLE;     // 放弃本次加热，重新计时
+            ctx->humid = false;
+            ctx->toggle_pending = false;
+        }
+        return SHT30_GetRestartTime(device);    // 关闭失败时下一轮重试
+    }
+
+    ctx->toggle_pending = false;
+    if (on) {
+        ctx->phase_end = HAL_GetTick() + SHT30_HEATER_PULSE_MS;
+        ctx->pulse_count++;
+        if (SHT30_ReadStatus(device, &reg) == SHT30_OK && !(reg & SHT30_STATUS_HEATER_ON)) {
+            LOG_WARN("%s 状态寄存器显示加热器未打开 (0x%04X)", sensor->name, reg);
+        }
+        LOG_INFO("%s 湿度持续高于 %d%%RH，加热 %u ms (第 %u 次)", sensor->name,
+                 (int)SHT30_HEATER_RH_THRESHOLD, (unsigned)SHT30_HEATER_PULSE_MS,
+                 (unsigned)ctx->pulse_count);
+    } else {
+        ctx->phase_end = HAL_GetTick() + SHT30_HEATER_RECOVERY_MS;
+        LOG_INFO("%s 加热结束，%u ms 后恢复采样", sensor->name,
+                 (unsigned)SHT30_HEATER_RECOVERY_MS);
+    }
+    return SHT30_GetRestartTime(device);
+}
+
+/**
+ * @brief 按新读数推进加热器策略，并标记加热与恢复期间的读数
+ */
+static void SHT30_Sensor_UpdateHeater(SensorInstance_t* sensor) {
+#if SHT30_HEATER_ENABLE
+    SHT30_HeaterCtx_t* ctx = SHT30_Sensor_Heater((SHT30_Device_t*)sensor->device_handle);
+    uint32_t now = HAL_GetTick();
+    bool expired = !ctx->toggle_pending && (int32_t)(now - ctx->phase_end) >= 0;
+
+    switch (ctx->phase) {
+    case SHT30_HEATER_IDLE:
+        if (sensor->data.values.sht30.humi < SHT30_HEATER_RH_THRESHOLD) {
+            ctx->humid = false;
+        } else if (!ctx->humid) {
+            ctx->humid = true;
+            ctx->humid_since = now;
+        } else if (now - ctx->humid_since >= SHT30_HEATER_HOLD_MS) {
+            ctx->phase = SHT30_HEATER_PULSE;    // 下一轮触发前打开，本读数仍有效
+            ctx->toggle_pending = true;
+        }
+        return;
+    case SHT30_HEATER_PULSE:
+        if (expired) {
+            ctx->phase = SHT30_HEATER_RECOVERY;
+            ctx->toggle_pending = true;
+        }
+        break;
+    case SHT30_HEATER_RECOVERY:
+        if (expired) {
+            ctx->phase = SHT30_HEATER_IDLE;     // 重新计时，即两次加热的最小间隔
+            ctx->humid = false;
+            return;
+        }
+        break;
+    }
+
+    // 加热使芯片升温、湿度读数偏低，两个通道都不可用
+    sensor->data.quality[0] |= SENSOR_QUALITY_INVALID;
+    sensor->data.quality[1] |= SENSOR_QUALITY_INVALID;
+#else
+    (void)sensor;
+#endif
+}
@@ -17,6 +17,12 @@ extern "C" {
 #endif
 
 
+/* --------------------------- 驱动描述 --------------------------- */
+#define SHT30_SENSOR_CHANNEL_COUNT 2  // 通道数 (temp, humi)
+
+extern const SensorCallbacks_t SHT30_Sensor_Callbacks;                         // 驱动回调
+extern const SensorChannelDesc_t SHT30_Sensor_Channels[SHT30_SENSOR_CHANNEL_COUNT]; // 通道表
+
 /* --------------------------- 公共函数声明 --------------------------- */
 
 /** 
@@ -25,6 +31,13 @@ extern "C" {
  */
 bool SHT30_Sensor_Register(void);
 
+/**
+ * @brief 注册指定地址的SHT30传感器 (供总线探测调用)
+ * @param addr 7位I2C地址 (SHT30_DEFAULT_ADDR / SHT30_ALT_ADDR)
+ * @return 实例句柄，失败返回 SENSOR_HANDLE_INVALID
+ */
+SensorHandle_t SHT30_Sensor_Attach(uint8_t addr);
+
 
 #ifdef  __cplusplus
 }
@@ -0,0 +1,162 @@
+/**
+ ******************************************************************************
+ * @file    sram.c
+ * @brief   外部 SRAM (IS62WV51216) 驱动源文件
+ * @details 模式 A 异步读写，读写使用同一组时序。HCLK 168 MHz 时一次 16 位
+ *          访问约 (2 + 8 + 1) 个 HCLK，连续写约 15 MB/s：CPU 直接在这里绘制
+ *          比内部 SRAM 慢，但 DMA 从这里搬到 LCD 时不占用 CPU。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sram.h"
+
+#define LOG_MODULE "SRAM"
+#include "log.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+static SRAM_HandleTypeDef s_sram_handle;
+static bool s_ready = false;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 配置地址线、字节选择与片选 (数据线与 NOE/NWE 已由 LCD 配置)
+ *   PF0~5  A0~A5     PF12~15 A6~A9 (PF12 同时是 LCD 的 RS)
+ *   PG0~5  A10~A15   PD11~13 A16~A18
+ *   PE0/1  NBL0/NBL1 PG10    NE3
+ */
+static void sram_gpio_init(void)
+{
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOD_CLK_ENABLE();
+    __HAL_RCC_GPIOE_CLK_ENABLE();
+    __HAL_RCC_GPIOF_CLK_ENABLE();
+    __HAL_RCC_GPIOG_CLK_ENABLE();
+
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF12_FSMC;
+
+    gpio.Pin = GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 |
+               GPIO_PIN_12 | GPIO_PIN_13 | GPIO_PIN_14 | GPIO_PIN_15;
+    HAL_GPIO_Init(GPIOF, &gpio);
+
+    gpio.Pin = GPIO_PIN_0 | GPIO_PIN_1 | GPIO_PIN_2 | GPIO_PIN_3 | GPIO_PIN_4 | GPIO_PIN_5 |
+               GPIO_PIN_10;
+    HAL_GPIO_Init(GPIOG, &gpio);
+
+    gpio.Pin = GPIO_PIN_11 | GPIO_PIN_12 | GPIO_PIN_13;
+    HAL_GPIO_Init(GPIOD, &gpio);
+
+    gpio.Pin = GPIO_PIN_0 | GPIO_PIN_1;
+    HAL_GPIO_Init(GPIOE, &gpio);
+}
+
+/**
+ * @brief 地址线/数据线自检
+ * @details 先在 0 与每个 2^n 半字地址写入各不相同的值，再全部读回：某条地址线
+ *          开路或短路时两个地址落在同一单元，后写的值会覆盖先写的值。
+ *          自检覆盖的单元随后会被帧缓冲区重写，不保留原内容。
+ */
+static bool sram_self_test(void)
+{
+    volatile uint16_t *mem = (volatile uint16_t *)SRAM_BASE_ADDR;
+    uint32_t words = SRAM_SIZE / 2;
+    uint32_t off;
+    uint16_t n;
+
+    mem[0] = 0xA55A;
+    for (off = 1, n = 1; off < words; off <<= 1, n++)
+    {
+        mem[off] = (uint16_t)(0x0101U * n) ^ 0x5AA5;
+    }
+
+    if (mem[0] != 0xA55A)
+    {
+        return false;
+    }
+    for (off = 1, n = 1; off < words; off <<= 1, n++)
+    {
+        if (mem[off] != ((uint16_t)(0x0101U * n) ^ 0x5AA5))
+        {
+            return false;
+        }
+    }
+
+    /* 高低字节分别写入, 检查 NBL0/NBL1 */
+    *(volatile uint8_t *)SRAM_BASE_ADDR = 0x12;
+    *((volatile uint8_t *)SRAM_BASE_ADDR + 1) = 0x34;
+    return mem[0] == 0x3412;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 配置 FSMC Bank1 NE3 并自检
+ */
+uint8_t sram_init(void)
+{
+    FSMC_NORSRAM_TimingTypeDef timing = {0};
+
+    if (s_ready)
+    {
+        return 0;
+    }
+
+    sram_gpio_init();
+
+    s_sram_handle.Instance = FSMC_NORSRAM_DEVICE;
+    s_sram_handle.Extended = FSMC_NORSRAM_EXTENDED_DEVICE;
+    s_sram_handle.Init.NSBank = FSMC_NORSRAM_BANK3;
+    s_sram_handle.Init.DataAddressMux = FSMC_DATA_ADDRESS_MUX_DISABLE;
+    s_sram_handle.Init.MemoryType = FSMC_MEMORY_TYPE_SRAM;
+    s_sram_handle.Init.MemoryDataWidth = FSMC_NORSRAM_MEM_BUS_WIDTH_16;
+    s_sram_handle.Init.BurstAccessMode = FSMC_BURST_ACCESS_MODE_DISABLE;
+    s_sram_handle.Init.WaitSignalPolarity = FSMC_WAIT_SIGNAL_POLARITY_LOW;
+    s_sram_handle.Init.WrapMode = FSMC_WRAP_MODE_DISABLE;
+    s_sram_handle.Init.WaitSignalActive = FSMC_WAIT_TIMING_BEFORE_WS;
+    s_sram_handle.Init.WriteOperation = FSMC_WRITE_OPERATION_ENABLE;
+    s_sram_handle.Init.WaitSignal = FSMC_WAIT_SIGNAL_DISABLE;
+    s_sram_handle.Init.ExtendedMode = FSMC_EXTENDED_MODE_DISABLE;
+    s_sram_handle.Init.AsynchronousWait = FSMC_ASYNCHRONOUS_WAIT_DISABLE;
+    s_sram_handle.Init.WriteBurst = FSMC_WRITE_BURST_DISABLE;
+    s_sram_handle.Init.PageSize = FSMC_PAGE_SIZE_NONE;
+
+    timing.AddressSetupTime = SRAM_ADDR_SETUP;
+    timing.AddressHoldTime = 0;
+    timing.DataSetupTime = SRAM_DATA_SETUP;
+    timing.BusTurnAroundDuration = 0;
+    timing.CLKDivision = 2;
+    timing.DataLatency = 2;
+    timing.AccessMode = FSMC_ACCESS_MODE_A;
+
+    /* HAL_SRAM_MspInit 中的 FSMC 时钟与共用引脚已在 MX_FSMC_Init 中完成 */
+    if (HAL_SRAM_Init(&s_sram_handle, &timing, &timing) != HAL_OK)
+    {
+        LOG_ERROR("FSMC NE3 配置失败");
+        return 1;
+    }
+
+    if (!sram_self_test())
+    {
+        LOG_ERROR("外部 SRAM 自检失败");
+        return 1;
+    }
+
+    s_ready = true;
+    LOG_INFO("外部 SRAM 就绪: %lu KB @ 0x%08lX", (unsigned long)(SRAM_SIZE / 1024),
+             (unsigned long)SRAM_BASE_ADDR);
+    return 0;
+}
+
+/**
+ * @brief 外部 SRAM 是否可用
+ */
+bool sram_is_ready(void)
+{
+    return s_ready;
+}
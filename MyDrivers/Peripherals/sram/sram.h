@@ -0,0 +1,50 @@
+/**
+ ******************************************************************************
+ * @file    sram.h
+ * @brief   外部 SRAM (IS62WV51216) 驱动头文件
+ * @details 板载 1 MB 16 位 SRAM 接在 FSMC Bank1 NE3 (PG10)，映射到
+ *          0x68000000。数据线、NOE/NWE 与 LCD (NE4) 共用，已由 MX_FSMC_Init
+ *          配置；这里只补充地址线 A0~A18、字节选择 NBL0/NBL1 与片选 NE3。
+ *          初始化后 CPU 与 DMA 都可以直接按地址访问。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SRAM_H
+#define __SRAM_H
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SRAM_BASE_ADDR              0x68000000UL    // FSMC Bank1 NE3
+#define SRAM_SIZE                   (1024UL * 1024UL)
+#define SRAM_ADDR_SETUP             2       // 地址建立时间 (HCLK 周期)
+#define SRAM_DATA_SETUP             8       // 数据建立时间 (HCLK 周期, 55 ns 芯片)
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 配置 FSMC Bank1 NE3 并自检 (须在 MX_FSMC_Init 之后调用，可重复调用)
+ * @details 自检按地址线逐位写入不同的值再读回，地址线或数据线开路、短路时
+ *          返回失败，调用方应改用内部 RAM。
+ * @return 0: 成功, 1: 自检失败 (未焊接芯片或连线故障)
+ */
+uint8_t sram_init(void);
+
+/**
+ * @brief 外部 SRAM 是否可用
+ */
+bool sram_is_ready(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SRAM_H */
@@ -25,8 +25,9 @@
 
 #include "string.h"
 #include "lcd.h"
+#include "lcd_orient.h"
 #include "touch.h"
-#include "ctiic.h"
+#include "touch_bus.h"
 #include "ft5206.h"
 #include "usart.h"
 #include "main.h"
@@ -43,25 +44,7 @@
  */
 uint8_t ft5206_wr_reg(uint16_t reg, uint8_t *buf, uint8_t len)
 {
-    uint8_t i;
-    uint8_t ret = 0;
-    
-    ct_iic_start();
-    ct_iic_send_byte(FT5206_CMD_WR);    /* д */
-    ct_iic_wait_ack();
-    ct_iic_send_byte(reg & 0XFF);       /* ͵8λַ */
-    ct_iic_wait_ack();
-
-    for (i = 0; i < len; i++)
-    {
-        ct_iic_send_byte(buf[i]);       /*  */
-        ret = ct_iic_wait_ack();
-
-        if (ret)break;
-    }
-
-    ct_iic_stop();  /* һֹͣ */
-    return ret;
+    return touch_bus_write(FT5206_CMD_WR, reg, 1, buf, len);
 }
 
 /**
@@ -73,23 +56,7 @@ uint8_t ft5206_wr_reg(uint16_t reg, uint8_t *buf, uint8_t len)
  */
 void ft5206_rd_reg(uint16_t reg, uint8_t *buf, uint8_t len)
 {
-    uint8_t i;
-    
-    ct_iic_start();
-    ct_iic_send_byte(FT5206_CMD_WR);    /* д */
-    ct_iic_wait_ack();
-    ct_iic_send_byte(reg & 0XFF);       /* ͵8λַ */
-    ct_iic_wait_ack();
-    ct_iic_start();
-    ct_iic_send_byte(FT5206_CMD_RD);    /* Ͷ */
-    ct_iic_wait_ack();
-
-    for (i = 0; i < len; i++)
-    {
-        buf[i] = ct_iic_read_byte(i == (len - 1) ? 0 : 1);  /* ȡ */
-    }
-
-    ct_iic_stop();  /* һֹͣ */
+    touch_bus_read(FT5206_CMD_WR, reg, 1, buf, len);    /* ַΪдַ|1 */
 }
 
 /**
@@ -117,7 +84,7 @@ uint8_t ft5206_init(void)
     gpio_init_struct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;     /*  */
     HAL_GPIO_Init(FT5206_INT_GPIO_PORT, &gpio_init_struct); /* ʼINT */
 
-    ct_iic_init();      /* ʼI2C */
+    touch_bus_init();   /* ʼI2C(/Ӳ) */
     FT5206_RST(0);      /* λ */
     delay_ms(20);
     FT5206_RST(1);      /* ͷŸλ */
@@ -147,7 +114,7 @@ const uint16_t FT5206_TPX_TBL[5] = {FT5206_TP1_REG, FT5206_TP2_REG, FT5206_TP3_R
 
 /**
  * @brief       ɨ败(òѯʽ)
- * @param       mode : δõβ, Ϊ˼ݵ
+ * @param       mode : ʹ TP_SCAN_NOW λ(н), Ϊݵ
  * @retval      ǰ״̬
  *   @arg       0, ޴; 
  *   @arg       1, д;
@@ -163,7 +130,7 @@ uint8_t ft5206_scan(uint8_t mode)
     
     t++;
     
-    if ((t % 10) == 0 || t < 10)   /* ʱ,ÿ10CTP_Scanż1,ӶʡCPUʹ */
+    if ((mode & TP_SCAN_NOW) || (t % 10) == 0 || t < 10)   /* жϴʱȡ; ʱ,ÿ10CTP_Scanż1,ӶʡCPUʹ */
     {
         ft5206_rd_reg(FT5206_REG_NUM_FINGER, &sta, 1);  /* ȡ״̬ */
 
@@ -186,7 +153,7 @@ uint8_t ft5206_scan(uint8_t mode)
                     }
                     else
                     {
-                        tp_dev.x[i] = lcddev.width - (((uint16_t)(buf[0] & 0X0F) << 8) + buf[1]);
+                        tp_dev.x[i] = lcd_orient_native_width() - (((uint16_t)(buf[0] & 0X0F) << 8) + buf[1]);
                         tp_dev.y[i] = ((uint16_t)(buf[2] & 0X0F) << 8) + buf[3];
                     }
 
@@ -24,14 +24,18 @@
  * V1.1 20230529
  * 1, ST7796 3.5/ILI9806 4.3GT1151֧
  * 2, gt9xxx_initӴICжضICͷ1ʾʼʧ
+ * V1.2
+ * 1, ѡڳʼʱдGT911/GT9147(ϱ/ֵ/, У)
+ * 2, ɨֻĻ״̬λ(0X814E bit7), ȡѯ
  ****************************************************************************************************
  */
 
 #include <stdio.h>
 #include "string.h"
 #include "lcd.h"
+#include "lcd_orient.h"
 #include "touch.h"
-#include "ctiic.h"
+#include "touch_bus.h"
 #include "gt9xxx.h"
 #include "main.h"
 #include "mydelay.h"
@@ -49,27 +53,7 @@ uint8_t g_gt_tnum = 5;      /* Ĭ
  */
 uint8_t gt9xxx_wr_reg(uint16_t reg, uint8_t *buf, uint8_t len)
 {
-    uint8_t i;
-    uint8_t ret = 0;
-
-    ct_iic_start();
-    ct_iic_send_byte(GT9XXX_CMD_WR);    /* д */
-    ct_iic_wait_ack();
-    ct_iic_send_byte(reg >> 8);         /* ͸8λַ */
-    ct_iic_wait_ack();
-    ct_iic_send_byte(reg & 0XFF);       /* ͵8λַ */
-    ct_iic_wait_ack();
-
-    for (i = 0; i < len; i++)
-    {
-        ct_iic_send_byte(buf[i]);       /*  */
-        ret = ct_iic_wait_ack();
-
-        if (ret) break;
-    }
-
-    ct_iic_stop();  /* һֹͣ */
-    return ret;
+    return touch_bus_write(GT9XXX_CMD_WR, reg, 2, buf, len);
 }
 
 /**
@@ -81,27 +65,94 @@ uint8_t gt9xxx_wr_reg(uint16_t reg, uint8_t *buf, uint8_t len)
  */
 void gt9xxx_rd_reg(uint16_t reg, uint8_t *buf, uint8_t len)
 {
+    touch_bus_read(GT9XXX_CMD_WR, reg, 2, buf, len);    /* ַΪдַ|1 */
+}
+
+#if GT9XXX_CFG_UPLOAD
+
+/**
+ * @brief       ޸еһ
+ * @param       cfg  : 
+ * @param       ofs  : ƫ
+ * @param       mask : ռõλ
+ * @param       val  : ֵ
+ * @retval      0, δı; 1, Ѹı
+ */
+static uint8_t gt9xxx_cfg_patch(uint8_t *cfg, uint8_t ofs, uint8_t mask, uint8_t val)
+{
+    uint8_t old = cfg[ofs];
+
+    cfg[ofs] = (old & ~mask) | (val & mask);
+    return cfg[ofs] != old;
+}
+
+/**
+ * @brief       дGT911/GT9147(ϱ/ֵ/)
+ *   @note      У = 184ֽ֮ȡ; Уʧʱд.
+ *              ð汾Ų, ܰ汾Ųڵǰֵ.
+ * @param       
+ * @retval      0, дд; 1, Ч
+ */
+static uint8_t gt9xxx_cfg_upload(void)
+{
+    uint8_t cfg[GT9XXX_CFG_LEN];
+    uint8_t chk[2];
+    uint8_t sum = 0;
+    uint8_t changed = 0;
     uint8_t i;
 
-    ct_iic_start();
-    ct_iic_send_byte(GT9XXX_CMD_WR);    /* д */
-    ct_iic_wait_ack();
-    ct_iic_send_byte(reg >> 8);         /* ͸8λַ */
-    ct_iic_wait_ack();
-    ct_iic_send_byte(reg & 0XFF);       /* ͵8λַ */
-    ct_iic_wait_ack();
-    ct_iic_start();
-    ct_iic_send_byte(GT9XXX_CMD_RD);    /* Ͷ */
-    ct_iic_wait_ack();
-
-    for (i = 0; i < len; i++)
+    gt9xxx_rd_reg(GT9XXX_CFGS_REG, cfg, GT9XXX_CFG_LEN);
+    gt9xxx_rd_reg(GT9XXX_CHECK_REG, chk, 1);
+
+    for (i = 0; i < GT9XXX_CFG_LEN; i++)
+    {
+        sum += cfg[i];
+    }
+
+    if ((uint8_t)(sum + chk[0]) != 0)
+    {
+        return 1;   /* Уʧ(ߴδʼ), ԭ */
+    }
+
+    changed |= gt9xxx_cfg_patch(cfg, GT9XXX_CFG_OFS_REFRESH, 0X0F, GT9XXX_CFG_REFRESH);
+
+    if (GT9XXX_CFG_TOUCH_LEVEL != 0)
+    {
+        changed |= gt9xxx_cfg_patch(cfg, GT9XXX_CFG_OFS_TOUCH_LEVEL, 0XFF, GT9XXX_CFG_TOUCH_LEVEL);
+    }
+
+    if (GT9XXX_CFG_LEAVE_LEVEL != 0)
+    {
+        changed |= gt9xxx_cfg_patch(cfg, GT9XXX_CFG_OFS_LEAVE_LEVEL, 0XFF, GT9XXX_CFG_LEAVE_LEVEL);
+    }
+
+    if (GT9XXX_CFG_TOUCH_NUM != 0)
+    {
+        changed |= gt9xxx_cfg_patch(cfg, GT9XXX_CFG_OFS_TOUCH_NUM, 0X0F, GT9XXX_CFG_TOUCH_NUM);
+    }
+
+    if (!changed)
+    {
+        return 0;   /* 뵱ǰͬ, дFlash */
+    }
+
+    sum = 0;
+
+    for (i = 0; i < GT9XXX_CFG_LEN; i++)
     {
-        buf[i] = ct_iic_read_byte(i == (len - 1) ? 0 : 1);  /* ȡ */
+        sum += cfg[i];
     }
 
-    ct_iic_stop();  /* һֹͣ */
+    chk[0] = (uint8_t)(~sum + 1);   /* У */
+    chk[1] = 1;                     /* ø± */
+    gt9xxx_wr_reg(GT9XXX_CFGS_REG, cfg, GT9XXX_CFG_LEN);
+    gt9xxx_wr_reg(GT9XXX_CHECK_REG, chk, 2);
+    delay_ms(10);                   /* ȴ */
+    return 0;
 }
 
+#endif
+
 /**
  * @brief       ʼgt9xxx
  * @param       
@@ -127,7 +178,7 @@ uint8_t gt9xxx_init(void)
     gpio_init_struct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;     /*  */
     HAL_GPIO_Init(GT9XXX_INT_GPIO_PORT, &gpio_init_struct); /* ʼINT */
 
-    ct_iic_init();      /* ʼI2C */
+    touch_bus_init();   /* ʼI2C(/Ӳ) */
     GT9XXX_RST(0);      /* λ */
     delay_ms(10);
     GT9XXX_RST(1);      /* ͷŸλ */
@@ -157,6 +208,13 @@ uint8_t gt9xxx_init(void)
     {
         g_gt_tnum = 10;    /* ֧10㴥 */
     }
+
+#if GT9XXX_CFG_UPLOAD
+    if (strcmp((char *)temp, "911") == 0 || strcmp((char *)temp, "9147") == 0)  /* ֪ͺ */
+    {
+        gt9xxx_cfg_upload();    /* Чʱԭ, Ӱʼ; λʹЧ */
+    }
+#endif
     
     temp[0] = 0X02;
     gt9xxx_wr_reg(GT9XXX_CTRL_REG, temp, 1);    /* λGT9XXX */
@@ -178,9 +236,12 @@ const uint16_t GT9XXX_TPX_TBL[10] =
 
 /**
  * @brief       ɨ败(òѯʽ)
- * @param       mode : δõβ, Ϊ˼ݵ
+ *   @note      ÿֻ1ֽ״̬Ĵ: b7(״̬)Ϊ0ʾûµ
+ *              (ϱ֮), ֵǰ״ֱ̬ӷ; Ϊ1ʱŶȡ겢־.
+ *              ڼÿϱλһ, ɿλ.
+ * @param       mode : ʹ(TP_SCAN_NOW ״̬λ), Ϊݵ
  * @retval      ǰ״̬
- *   @arg       0, ޴; 
+ *   @arg       0, ޴(); 
  *   @arg       1, д;
  */
 uint8_t gt9xxx_scan(uint8_t mode)
@@ -190,85 +251,80 @@ uint8_t gt9xxx_scan(uint8_t mode)
     uint8_t res = 0;
     uint16_t temp;
     uint16_t tempsta;
-    static uint8_t t = 0;   /* Ʋѯ,ӶCPUռ */
-    t++;
 
-    if ((t % 10) == 0 || t < 10)    /* ʱ,ÿ10CTP_Scanż1,ӶʡCPUʹ */
+    gt9xxx_rd_reg(GT9XXX_GSTID_REG, &mode, 1);  /* ȡ״̬ */
+
+    if ((mode & 0X80) == 0)
     {
-        gt9xxx_rd_reg(GT9XXX_GSTID_REG, &mode, 1);  /* ȡ״̬ */
+        return 0;   /*  */
+    }
 
-        if ((mode & 0X80) && ((mode & 0XF) <= g_gt_tnum))
-        {
-            i = 0;
-            gt9xxx_wr_reg(GT9XXX_GSTID_REG, &i, 1); /* ־ */
-        }
+    if ((mode & 0XF) <= g_gt_tnum)
+    {
+        i = 0;
+        gt9xxx_wr_reg(GT9XXX_GSTID_REG, &i, 1); /* ־ */
+    }
 
-        if ((mode & 0XF) && ((mode & 0XF) <= g_gt_tnum))
-        {
-            temp = 0XFFFF << (mode & 0XF);  /* ĸתΪ1λ,ƥtp_dev.sta */
-            tempsta = tp_dev.sta;           /* 浱ǰtp_dev.staֵ */
-            tp_dev.sta = (~temp) | TP_PRES_DOWN | TP_CATH_PRES;
-            tp_dev.x[g_gt_tnum - 1] = tp_dev.x[0];  /* 津0,һ */
-            tp_dev.y[g_gt_tnum - 1] = tp_dev.y[0];
+    if ((mode & 0XF) && ((mode & 0XF) <= g_gt_tnum))
+    {
+        temp = 0XFFFF << (mode & 0XF);  /* ĸתΪ1λ,ƥtp_dev.sta */
+        tempsta = tp_dev.sta;           /* 浱ǰtp_dev.staֵ */
+        tp_dev.sta = (~temp) | TP_PRES_DOWN | TP_CATH_PRES;
+        tp_dev.x[g_gt_tnum - 1] = tp_dev.x[0];  /* 津0,һ */
+        tp_dev.y[g_gt_tnum - 1] = tp_dev.y[0];
 
-            for (i = 0; i < g_gt_tnum; i++)
+        for (i = 0; i < g_gt_tnum; i++)
+        {
+            if (tp_dev.sta & (1 << i))  /* Ч? */
             {
-                if (tp_dev.sta & (1 << i))  /* Ч? */
-                {
-                    gt9xxx_rd_reg(GT9XXX_TPX_TBL[i], buf, 4);   /* ȡXYֵ */
+                gt9xxx_rd_reg(GT9XXX_TPX_TBL[i], buf, 4);   /* ȡXYֵ */
 
-                    if (lcddev.id == 0X5510 || lcddev.id == 0X9806 || lcddev.id == 0X7796)     /* 4.3800*480  3.5480*320 MCU */
+                if (lcddev.id == 0X5510 || lcddev.id == 0X9806 || lcddev.id == 0X7796)     /* 4.3800*480  3.5480*320 MCU */
+                {
+                    if (tp_dev.touchtype & 0X01)    /*  */
                     {
-                        if (tp_dev.touchtype & 0X01)    /*  */
-                        {
-                            tp_dev.x[i] = lcddev.width - (((uint16_t)buf[3] << 8) + buf[2]);
-                            tp_dev.y[i] = ((uint16_t)buf[1] << 8) + buf[0];
-                        }
-                        else
-                        {
-                            tp_dev.x[i] = ((uint16_t)buf[1] << 8) + buf[0];
-                            tp_dev.y[i] = ((uint16_t)buf[3] << 8) + buf[2];
-                        }
+                        tp_dev.x[i] = lcd_orient_native_width() - (((uint16_t)buf[3] << 8) + buf[2]);
+                        tp_dev.y[i] = ((uint16_t)buf[1] << 8) + buf[0];
                     }
-                    else    /* ͺ */
+                    else
                     {
-                        if (tp_dev.touchtype & 0X01)    /*  */
-                        {
-                            tp_dev.x[i] = ((uint16_t)buf[1] << 8) + buf[0];
-                            tp_dev.y[i] = ((uint16_t)buf[3] << 8) + buf[2];
-                        }
-                        else
-                        {
-                            tp_dev.x[i] = lcddev.width - (((uint16_t)buf[3] << 8) + buf[2]);
-                            tp_dev.y[i] = ((uint16_t)buf[1] << 8) + buf[0];
-                        }
+                        tp_dev.x[i] = ((uint16_t)buf[1] << 8) + buf[0];
+                        tp_dev.y[i] = ((uint16_t)buf[3] << 8) + buf[2];
+                    }
+                }
+                else    /* ͺ */
+                {
+                    if (tp_dev.touchtype & 0X01)    /*  */
+                    {
+                        tp_dev.x[i] = ((uint16_t)buf[1] << 8) + buf[0];
+                        tp_dev.y[i] = ((uint16_t)buf[3] << 8) + buf[2];
+                    }
+                    else
+                    {
+                        tp_dev.x[i] = lcd_orient_native_width() - (((uint16_t)buf[3] << 8) + buf[2]);
+                        tp_dev.y[i] = ((uint16_t)buf[1] << 8) + buf[0];
                     }
-
-                    // printf("x[%d]:%d,y[%d]:%d\r\n", i, tp_dev.x[i], i, tp_dev.y[i]);
                 }
+
+                // printf("x[%d]:%d,y[%d]:%d\r\n", i, tp_dev.x[i], i, tp_dev.y[i]);
             }
+        }
 
-            res = 1;
+        res = 1;
 
-            if (tp_dev.x[0] > lcddev.width || tp_dev.y[0] > lcddev.height)  /* Ƿ(곬) */
+        if (tp_dev.x[0] > lcd_orient_native_width() || tp_dev.y[0] > lcd_orient_native_height())  /* Ƿ(곬) */
+        {
+            if ((mode & 0XF) > 1)   /* ,򸴵ڶݵһ. */
             {
-                if ((mode & 0XF) > 1)   /* ,򸴵ڶݵһ. */
-                {
-                    tp_dev.x[0] = tp_dev.x[1];
-                    tp_dev.y[0] = tp_dev.y[1];
-                    t = 0;  /* һ,10,Ӷ */
-                }
-                else        /* Ƿ,Դ˴(ԭԭ) */
-                {
-                    tp_dev.x[0] = tp_dev.x[g_gt_tnum - 1];
-                    tp_dev.y[0] = tp_dev.y[g_gt_tnum - 1];
-                    mode = 0X80;
-                    tp_dev.sta = tempsta;   /* ָtp_dev.sta */
-                }
+                tp_dev.x[0] = tp_dev.x[1];
+                tp_dev.y[0] = tp_dev.y[1];
             }
-            else 
+            else        /* Ƿ,Դ˴(ԭԭ) */
             {
-                t = 0;      /* һ,10,Ӷ */
+                tp_dev.x[0] = tp_dev.x[g_gt_tnum - 1];
+                tp_dev.y[0] = tp_dev.y[g_gt_tnum - 1];
+                mode = 0X80;
+                tp_dev.sta = tempsta;   /* ָtp_dev.sta */
             }
         }
     }
@@ -287,7 +343,5 @@ uint8_t gt9xxx_scan(uint8_t mode)
         }
     }
 
-    if (t > 240)t = 10; /* ´10ʼ */
-
     return res;
 }
@@ -24,6 +24,9 @@
  * V1.1 20230529
  * 1, ST7796 3.5/ILI9806 4.3GT1151֧
  * 2, gt9xxx_initӴICжضICͷ1ʾʼʧ
+ * V1.2
+ * 1, ѡڳʼʱдGT911/GT9147(ϱ/ֵ/, У)
+ * 2, ɨֻĻ״̬λ(0X814E bit7), ȡѯ
  ****************************************************************************************************
  */
 
@@ -56,6 +59,16 @@
 
 #define GT9XXX_INT        HAL_GPIO_ReadPin(GT9XXX_INT_GPIO_PORT, GT9XXX_INT_GPIO_PIN)     /* ȡ */
 
+/* øд(GT911/GT9147, ͺֲͬ, д)
+ * ǰ, ֻ޸漸У, 뵱ǰֵͬʱд,
+ * ÿϵ綼дڲFlash. ֵΪ0ʾֿԭֵ.
+ */
+#define GT9XXX_CFG_UPLOAD       1       /* 1, ʼʱд; 0, ʹÿ */
+#define GT9XXX_CFG_REFRESH      0       /* ϱ = 5 + N ms(0~15), 0(5ms) */
+#define GT9XXX_CFG_TOUCH_LEVEL  0       /* ֵ(0, ԭֵ) */
+#define GT9XXX_CFG_LEAVE_LEVEL  0       /* ɿֵ(0, ԭֵ, Сڰֵ) */
+#define GT9XXX_CFG_TOUCH_NUM    5       /* (1~5, 0, ԭֵ) */
+
 /* IICд */
 #define GT9XXX_CMD_WR       0X28        /* д */
 #define GT9XXX_CMD_RD       0X29        /*  */
@@ -64,6 +77,13 @@
 #define GT9XXX_CTRL_REG     0X8040      /* GT9XXXƼĴ */
 #define GT9XXX_CFGS_REG     0X8047      /* GT9XXXʼַĴ */
 #define GT9XXX_CHECK_REG    0X80FF      /* GT9XXXУͼĴ */
+#define GT9XXX_CFG_LEN      184         /* (0X8047~0X80FE), 0X8100Ϊø± */
+
+/* ڵƫ(GT9XXX_CFGS_REG) */
+#define GT9XXX_CFG_OFS_TOUCH_NUM    5   /* 0X804C (b3~b0) */
+#define GT9XXX_CFG_OFS_TOUCH_LEVEL  12  /* 0X8053 ֵ */
+#define GT9XXX_CFG_OFS_LEAVE_LEVEL  13  /* 0X8054 ɿֵ */
+#define GT9XXX_CFG_OFS_REFRESH      15  /* 0X8056 ϱ(b3~b0, 5+N ms) */
 #define GT9XXX_PID_REG      0X8140      /* GT9XXXƷIDĴ */
 
 #define GT9XXX_GSTID_REG    0X814E      /* GT9XXXǰ⵽Ĵ */
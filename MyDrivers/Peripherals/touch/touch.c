@@ -29,12 +29,16 @@
 
 #include "main.h"
 #include "lcd.h"
+#include "lcd_orient.h"
 #include "touch.h"
 #include "24cxx.h"
 #include "gt9xxx.h"
 #include "ft5206.h"
 #include <stdio.h>
 #include "mydelay.h"
+#include "fmt_fixed.h"
+#include "config_store.h"
+#include <string.h>
 
 _m_tp_dev tp_dev =
 {
@@ -51,145 +55,176 @@ _m_tp_dev tp_dev =
     0,
 };
 
+/* 败оƬ ݲɼ ˲ò */
+#define TP_READ_TIMES   5       /* ÿĲ */
+#define TP_LOST_VAL     1       /* ˸Ĳ */
+
+#if (TP_LOST_VAL != 1) || (TP_READ_TIMES < 3)
+#error "βƽһɨȥСֵֵʵ,  TP_LOST_VAL == 1  TP_READ_TIMES >= 3"
+#endif
+
+#define TP_CMD_X        0XD0    /* ȡX(@״̬,״̬YԵ.) */
+#define TP_CMD_Y        0X90    /* ȡY(@״̬,״̬XԵ.) */
+#define TP_MAX_PAIRS    2       /* һδɼ (X, Y)  */
+
+/*  SPI ֱд BSRR /  IDR,  HAL_GPIO_WritePin ĺ */
+#define TP_CLK_H()      (T_CLK_GPIO_PORT->BSRR = T_CLK_GPIO_PIN)
+#define TP_CLK_L()      (T_CLK_GPIO_PORT->BSRR = (uint32_t)T_CLK_GPIO_PIN << 16U)
+#define TP_MOSI_H()     (T_MOSI_GPIO_PORT->BSRR = T_MOSI_GPIO_PIN)
+#define TP_MOSI_L()     (T_MOSI_GPIO_PORT->BSRR = (uint32_t)T_MOSI_GPIO_PIN << 16U)
+#define TP_MISO()       ((T_MISO_GPIO_PORT->IDR & T_MISO_GPIO_PIN) != 0U)
+
+/* DCLK /͵ƽıʱ: XPT2046 ҪС 200ns ( 2.5MHz) */
+#define TP_SPI_HALF_NOPS 40
+
 /**
- * @brief       SPIд
- *   @note      ICд1 byte
- * @param       data: Ҫд
+ * @brief       SPI ʱڵʱ
+ * @param       
  * @retval      
  */
-static void tp_write_byte(uint8_t data)
+static inline void tp_spi_delay(void)
 {
-    uint8_t count = 0;
+    uint8_t i;
 
-    for (count = 0; count < 8; count++)
+    for (i = 0; i < TP_SPI_HALF_NOPS; i++)
     {
-        if (data & 0x80)    /* 1 */
-        {
-            T_MOSI(1);
-        }
-        else                /* 0 */
-        {
-            T_MOSI(0);
-        }
-
-        data <<= 1;
-        T_CLK(0);
-        delay_us(1);
-        T_CLK(1);           /* Ч */
+        __NOP();
     }
 }
 
 /**
- * @brief       SPI
- *   @note      ӴICȡadcֵ
- * @param       cmd: ָ
- * @retval      ȡ,ADCֵ(12bit)
+ * @brief       SPI  n λ(λǰ)
+ *   @note      ½ MOSI, оƬ; ͬһڶ MISO
+ * @param       data: Ҫ͵( n λЧ)
+ * @param       n: λ
+ * @retval      ص
  */
-static uint16_t tp_read_ad(uint8_t cmd)
+static uint16_t tp_spi_xfer(uint16_t data, uint8_t n)
 {
-    uint8_t count = 0;
     uint16_t num = 0;
-    
-    T_CLK(0);           /* ʱ */
-    T_MOSI(0);          /*  */
-    T_CS(0);            /* ѡдIC */
-    tp_write_byte(cmd); /*  */
-    delay_us(6);        /* ADS7846תʱΪ6us */
-    T_CLK(0);
-    delay_us(1);
-    T_CLK(1);           /* 1ʱӣBUSY */
-    delay_us(1);
-    T_CLK(0);
-
-    for (count = 0; count < 16; count++)    /* 16λ,ֻи12λЧ */
+    uint16_t mask = (uint16_t)(1U << (n - 1));
+
+    while (mask)
     {
+        TP_CLK_L();
+        if (data & mask)
+        {
+            TP_MOSI_H();
+        }
+        else
+        {
+            TP_MOSI_L();
+        }
+        tp_spi_delay();
+        TP_CLK_H();
+        tp_spi_delay();
         num <<= 1;
-        T_CLK(0);       /* ½Ч */
-        delay_us(1);
-        T_CLK(1);
-
-        if (T_MISO) num++;
+        if (TP_MISO()) num++;
+        mask >>= 1;
     }
 
-    num >>= 4;          /* ֻи12λЧ. */
-    T_CS(1);            /* ͷƬѡ */
     return num;
 }
 
-/* 败оƬ ݲɼ ˲ò */
-#define TP_READ_TIMES   5       /* ȡ */
-#define TP_LOST_VAL     1       /* ֵ */
-
 /**
- * @brief       ȡһֵ(xy)
- *   @note      ȡTP_READ_TIMES,Щ,
- *              ȻȥͺTP_LOST_VAL, ȡƽֵ
- *              ʱ: TP_READ_TIMES > 2*TP_LOST_VAL 
- *
- * @param       cmd : ָ
- *   @arg       0XD0: ȡX(@״̬,״̬YԵ.)
- *   @arg       0X90: ȡY(@״̬,״̬XԵ.)
- *
- * @retval      ȡ(˲), ADCֵ(12bit)
+ * @brief       һƬѡɼ pairs  (X  TP_READ_TIMES , Y  TP_READ_TIMES )
+ *   @note      ʹ XPT2046 "ÿת 16 ʱ"ʽ: ֮ 16 ʱ
+ *              ǰ 13  BUSY  12 λ,  8 ͬʱͳһת
+ *              , ÿβٵȴתƬѡ. һ
+ *              תͳȫ 0 (ʼλ) 
+ * @param       buf: ,  [][X/Y][] 
+ * @param       pairs: (1 ~ TP_MAX_PAIRS)
+ * @retval      
  */
-static uint16_t tp_read_xoy(uint8_t cmd)
+static void tp_read_samples(uint16_t *buf, uint8_t pairs)
 {
-    uint16_t i, j;
-    uint16_t buf[TP_READ_TIMES];
-    uint16_t sum = 0;
-    uint16_t temp;
+    uint16_t total = (uint16_t)pairs * 2U * TP_READ_TIMES;
+    uint16_t i;
+    uint8_t cmd, next;
 
-    for (i = 0; i < TP_READ_TIMES; i++)     /* ȶȡTP_READ_TIMES */
-    {
-        buf[i] = tp_read_ad(cmd);
-    }
+    TP_CLK_L();
+    TP_MOSI_L();
+    T_CS(0);                                /* ѡдIC */
 
-    for (i = 0; i < TP_READ_TIMES - 1; i++) /* ݽ */
+    cmd = TP_CMD_X;
+    tp_spi_xfer(cmd, 8);                    /* һת */
+
+    for (i = 0; i < total; i++)
     {
-        for (j = i + 1; j < TP_READ_TIMES; j++)
+        if (i + 1 < total)
         {
-            if (buf[i] > buf[j])   /*  */
-            {
-                temp = buf[i];
-                buf[i] = buf[j];
-                buf[j] = temp;
-            }
+            next = (((i + 1) / TP_READ_TIMES) & 1U) ? TP_CMD_Y : TP_CMD_X;
         }
+        else
+        {
+            next = 0;
+        }
+
+        /* b15: BUSY, b14~b3: 12 λ, b2~b0: 0;  8 ʱͳһ */
+        buf[i] = (tp_spi_xfer(next, 16) >> 3) & 0x0FFF;
     }
 
-    sum = 0;
+    TP_CLK_L();
+    T_CS(1);                                /* ͷƬѡ */
+}
+
+/**
+ * @brief       βƽ: һɨͲ¼С/ֵ, ȥߺȡƽ
+ *   @note      ȥ˸ TP_LOST_VAL Ľͬ (TP_LOST_VAL = 1)
+ * @param       buf: TP_READ_TIMES 
+ * @retval      ˲ ADC ֵ(12bit)
+ */
+static uint16_t tp_trimmed_mean(const uint16_t *buf)
+{
+    uint32_t sum = buf[0];
+    uint16_t vmin = buf[0];
+    uint16_t vmax = buf[0];
+    uint8_t i;
 
-    for (i = TP_LOST_VAL; i < TP_READ_TIMES - TP_LOST_VAL; i++)   /* ȥ˵Ķֵ */
+    for (i = 1; i < TP_READ_TIMES; i++)
     {
-        sum += buf[i];  /* ۼȥֵԺ. */
+        sum += buf[i];
+        if (buf[i] < vmin) vmin = buf[i];
+        if (buf[i] > vmax) vmax = buf[i];
     }
 
-    temp = sum / (TP_READ_TIMES - 2 * TP_LOST_VAL); /* ȡƽֵ */
-    return temp;
+    return (uint16_t)((sum - vmin - vmax) / (TP_READ_TIMES - 2 * TP_LOST_VAL));
 }
 
 /**
- * @brief       ȡx, y
- * @param       x,y: ȡֵ
+ * @brief       һΪ x, y 
+ * @param       buf: tp_read_samples һ (X ǰ, Y ں)
+ * @param       x,y: ֵ
  * @retval      
  */
-static void tp_read_xy(uint16_t *x, uint16_t *y)
+static void tp_samples_to_xy(const uint16_t *buf, uint16_t *x, uint16_t *y)
 {
-    uint16_t xval, yval;
+    uint16_t xval = tp_trimmed_mean(buf);
+    uint16_t yval = tp_trimmed_mean(buf + TP_READ_TIMES);
 
     if (tp_dev.touchtype & 0X01)    /* X,YĻ෴ */
     {
-        xval = tp_read_xoy(0X90);   /* ȡXADֵ, з任 */
-        yval = tp_read_xoy(0XD0);   /* ȡYADֵ */
+        *x = yval;
+        *y = xval;
     }
     else                            /* X,YĻͬ */
     {
-        xval = tp_read_xoy(0XD0);   /* ȡXADֵ */
-        yval = tp_read_xoy(0X90);   /* ȡYADֵ */
+        *x = xval;
+        *y = yval;
     }
+}
 
-    *x = xval;
-    *y = yval;
+/**
+ * @brief       ȡx, y
+ * @param       x,y: ȡֵ
+ * @retval      
+ */
+static void tp_read_xy(uint16_t *x, uint16_t *y)
+{
+    uint16_t buf[2 * TP_READ_TIMES];
+
+    tp_read_samples(buf, 1);
+    tp_samples_to_xy(buf, x, y);
 }
 
 /* ζȡX,Yֵ */
@@ -205,11 +240,13 @@ static void tp_read_xy(uint16_t *x, uint16_t *y)
  */
 static uint8_t tp_read_xy2(uint16_t *x, uint16_t *y)
 {
+    uint16_t buf[TP_MAX_PAIRS * 2 * TP_READ_TIMES];
     uint16_t x1, y1;
     uint16_t x2, y2;
 
-    tp_read_xy(&x1, &y1);   /* ȡһ */
-    tp_read_xy(&x2, &y2);   /* ȡڶ */
+    tp_read_samples(buf, TP_MAX_PAIRS);     /* ͬһδвɼ */
+    tp_samples_to_xy(buf, &x1, &y1);
+    tp_samples_to_xy(buf + 2 * TP_READ_TIMES, &x2, &y2);
 
     /* ǰβ+-TP_ERR_RANGE */
     if (((x2 <= x1 && x1 < x2 + TP_ERR_RANGE) || (x1 <= x2 && x2 < x1 + TP_ERR_RANGE)) &&
@@ -259,11 +296,95 @@ void tp_draw_big_point(uint16_t x, uint16_t y, uint16_t color)
 
 /******************************************************************************************/
 
+/**
+ * @brief       תΪĻ(һγ˼), ĻĲȡԵֵ
+ * @param       cal : У׼
+ * @param       raw : (ADֵ)
+ * @param       size: ÷Ļ
+ * @retval      Ļ
+ */
+static uint16_t tp_cal_apply(const TpCalAxis_t *cal, uint16_t raw, uint16_t size)
+{
+    int32_t v = (((int32_t)raw * cal->gain) >> TP_CAL_SHIFT) + cal->off;
+
+    if (v < 0)
+    {
+        return 0;
+    }
+
+    if (v >= size)
+    {
+        return size - 1;
+    }
+
+    return (uint16_t)v;
+}
+
+/**
+ * @brief       鵥У׼
+ *   @note      ʾԴ, 0~4095븲Ļ
+ * @param       cal : У׼
+ * @param       size: ÷Ļ
+ * @retval      0, Ч; 1, Ч
+ */
+static uint8_t tp_cal_axis_valid(const TpCalAxis_t *cal, uint16_t size)
+{
+    int32_t v0, v1;
+
+    if (cal->gain == 0)
+    {
+        return 0;
+    }
+
+    v0 = cal->off;
+    v1 = (((int32_t)4095 * cal->gain) >> TP_CAL_SHIFT) + cal->off;
+
+    if (v0 > v1)
+    {
+        int32_t t = v0;
+        v0 = v1;
+        v1 = t;
+    }
+
+    return (v0 <= 0 && v1 >= size - 1) ? 1 : 0;
+}
+
+/**
+ * @brief       5У׼xfac/yfac/xc/yc㶨任xcal/ycal
+ *   @note      x = (X - xc) / xfac + W / 2 = X * (1 / xfac) + (W / 2 - xc / xfac)
+ * @param       
+ * @retval      0, ʾΧЧ; 1, ɹ
+ */
+static uint8_t tp_cal_update(void)
+{
+    uint16_t w = lcd_orient_native_width();
+    uint16_t h = lcd_orient_native_height();
+    float xg, yg;
+
+    xg = (1 << TP_CAL_SHIFT) / tp_dev.xfac;
+    yg = (1 << TP_CAL_SHIFT) / tp_dev.yfac;
+
+    if (!(xg > -32767.0f && xg < 32767.0f) || !(yg > -32767.0f && yg < 32767.0f))
+    {
+        return 0;   /*  >= 2 /ADֵ(Ϊ0), Q14 Ų */
+    }
+
+    tp_dev.xcal.gain = (int16_t)(xg + (xg < 0 ? -0.5f : 0.5f));
+    tp_dev.ycal.gain = (int16_t)(yg + (yg < 0 ? -0.5f : 0.5f));
+
+    /* ƫưȡ, ʹĵ (xc,yc) ׼ȷĻ */
+    tp_dev.xcal.off = w / 2 - (((int32_t)tp_dev.xc * tp_dev.xcal.gain) >> TP_CAL_SHIFT);
+    tp_dev.ycal.off = h / 2 - (((int32_t)tp_dev.yc * tp_dev.ycal.gain) >> TP_CAL_SHIFT);
+
+    return tp_cal_axis_valid(&tp_dev.xcal, w) && tp_cal_axis_valid(&tp_dev.ycal, h);
+}
+
 /**
  * @brief       ɨ
  * @param       mode: ģʽ
  *   @arg       0, Ļ;
  *   @arg       1, (У׼ⳡ)
+ *   @arg       ɻ TP_SCAN_NOW, ޽, Ըλ
  *
  * @retval      0, ޴; 1, д;
  */
@@ -271,17 +392,17 @@ static uint8_t tp_scan(uint8_t mode)
 {
     if (T_PEN == 0)     /* а */
     {
-        if (mode)       /* ȡ, ת */
+        if (mode & 0x01)    /* ȡ, ת */
         {
             tp_read_xy2(&tp_dev.x[0], &tp_dev.y[0]);
         }
         else if (tp_read_xy2(&tp_dev.x[0], &tp_dev.y[0]))     /* ȡĻ, Ҫת */
         {
             /* X ת߼(ӦLCDĻXֵ) */
-            tp_dev.x[0] = (signed short)(tp_dev.x[0] - tp_dev.xc) / tp_dev.xfac + lcddev.width / 2;
+            tp_dev.x[0] = tp_cal_apply(&tp_dev.xcal, tp_dev.x[0], lcd_orient_native_width());
 
             /* Y ת߼(ӦLCDĻYֵ) */
-            tp_dev.y[0] = (signed short)(tp_dev.y[0] - tp_dev.yc) / tp_dev.yfac + lcddev.height / 2;
+            tp_dev.y[0] = tp_cal_apply(&tp_dev.ycal, tp_dev.y[0], lcd_orient_native_height());
         }
 
         if ((tp_dev.sta & TP_PRES_DOWN) == 0)   /* ֮ǰûб */
@@ -309,56 +430,70 @@ static uint8_t tp_scan(uint8_t mode)
     return tp_dev.sta & TP_PRES_DOWN; /* صǰĴ״̬ */
 }
 
-/* TP_SAVE_ADDR_BASE崥У׼EEPROMλ(ʼַ)
- * ռÿռ : 13ֽ.
+/* TP_SAVE_ADDR_BASEɰ汾У׼EEPROMλ(ʼַ)
+ * ռÿռ : 13ֽ(xfac,yfac,xc,yc + У׼0X0A). ֻǨʱȡ.
  */
 #define TP_SAVE_ADDR_BASE   40
 
 /**
  * @brief       У׼
- *   @note      EEPROMоƬ(24C02),ʼַΪTP_SAVE_ADDR_BASE.
- *              ռôСΪ13ֽ
+ *   @note      xfac/yfac/xc/yc任, CONFIG_KEY_TP_CAL_X/Y
+ *              ô洢(ÿ¼CRC-8, ɺ̨дEEPROM).
+ *              Ч(У׼ʱ)ʱ.
  * @param       
  * @retval      
  */
 void tp_save_adjust_data(void)
 {
-    uint8_t *p = (uint8_t *)&tp_dev.xfac;   /* ָ׵ַ */
-
-    /* pָtp_dev.xfacĵַ, p+4tp_dev.yfacĵַ
-     * p+8tp_dev.xoffĵַ,p+10,tp_dev.yoffĵַ
-     * ܹռ12ֽ(4)
-     * p+12ڴűǵ败ǷУ׼(0X0A)
-     * p[12]д0X0A. ѾУ׼.
-     */
-    at24cxx_write(TP_SAVE_ADDR_BASE, p, 12);                /* 12ֽ(xfac,yfac,xc,yc) */
-    at24cxx_write_one_byte(TP_SAVE_ADDR_BASE + 12, 0X0A);   /* У׼ֵ */
+    if (tp_cal_update() == 0)
+    {
+        return;
+    }
+
+    ConfigStore_Set(CONFIG_KEY_TP_CAL_X, &tp_dev.xcal, sizeof(TpCalAxis_t));
+    ConfigStore_Set(CONFIG_KEY_TP_CAL_Y, &tp_dev.ycal, sizeof(TpCalAxis_t));
+    ConfigStore_RequestFlush();     /* ȴϲʱ */
 }
 
 /**
- * @brief       ȡEEPROMУ׼ֵ
+ * @brief       ȡУ׼ֵ
+ *   @note      ô洢ϵʱڴ, ֻӰӸ.
+ *              ô洢ûʱ, ȡһξɰ汾EEPROMǨƵô洢.
  * @param       
  * @retval      0ȡʧܣҪУ׼
  *              1ɹȡ
  */
 uint8_t tp_get_adjust_data(void)
 {
-    uint8_t *p = (uint8_t *)&tp_dev.xfac;
-    uint8_t temp = 0;
-
-    /* ֱָtp_dev.xfacַб, ȡʱ,ȡ
-     * дָtp_dev.xfac׵ַ, ͿԻԭдȥֵ, Ҫ
-     * . ˷ڸ(ṹ)ı/ȡ(ṹ).
-     */
-    at24cxx_read(TP_SAVE_ADDR_BASE, p, 12);                 /* ȡ12ֽ */
-    temp = at24cxx_read_one_byte(TP_SAVE_ADDR_BASE + 12);   /* ȡУ׼״̬ */
+    uint8_t buf[13];
 
-    if (temp == 0X0A)
+    if (ConfigStore_Get(CONFIG_KEY_TP_CAL_X, &tp_dev.xcal, sizeof(TpCalAxis_t)) &&
+            ConfigStore_Get(CONFIG_KEY_TP_CAL_Y, &tp_dev.ycal, sizeof(TpCalAxis_t)) &&
+            tp_cal_axis_valid(&tp_dev.xcal, lcd_orient_native_width()) &&
+            tp_cal_axis_valid(&tp_dev.ycal, lcd_orient_native_height()))
     {
         return 1;
     }
 
-    return 0;
+    at24cxx_read(TP_SAVE_ADDR_BASE, buf, 13);   /* һζ12ֽڲУ׼ */
+
+    if (buf[12] != 0X0A)
+    {
+        return 0;
+    }
+
+    memcpy(&tp_dev.xfac, &buf[0], 4);
+    memcpy(&tp_dev.yfac, &buf[4], 4);
+    memcpy(&tp_dev.xc, &buf[8], 2);
+    memcpy(&tp_dev.yc, &buf[10], 2);
+
+    if (tp_cal_update() == 0)
+    {
+        return 0;
+    }
+
+    tp_save_adjust_data();
+    return 1;
 }
 
 /* ʾַ */
@@ -385,10 +520,10 @@ static void tp_adjust_info_show(uint16_t xy[5][2], double px, double py)
 
     /* ʾX/Yı */
     lcd_fill(40, 160 + (i * 20), lcddev.width - 1, 16, WHITE);  /* ֮ǰpx,pyʾ */
-    sprintf(sbuf, "px:%0.2f", px);
+    sprintf(sbuf, "px:%s", FMT_Q2(px));
     sbuf[7] = 0; /* ӽ */
     lcd_show_string(40, 160 + (i * 20), lcddev.width, lcddev.height, 16, sbuf, RED);
-    sprintf(sbuf, "py:%0.2f", py);
+    sprintf(sbuf, "py:%s", FMT_Q2(py));
     sbuf[7] = 0; /* ӽ */
     lcd_show_string(40 + 80, 160 + (i * 20), lcddev.width, lcddev.height, 16, sbuf, RED);
 }
@@ -587,11 +722,8 @@ uint8_t tp_init(void)
         else                    /* δУ׼? */
         {
             lcd_clear(WHITE);   /*  */
-            tp_adjust();        /* ĻУ׼ */
-            tp_save_adjust_data();
+            tp_adjust();        /* ĻУ׼(ɹʱѱ) */
         }
-
-        tp_get_adjust_data();
     }
 
     return 1;
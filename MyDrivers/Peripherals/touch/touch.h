@@ -81,12 +81,23 @@
 #define TP_PRES_DOWN    0x8000  /*  */
 #define TP_CATH_PRES    0x4000  /* а */
 #define CT_MAX_TOUCH    10      /* ֵ֧ĵ,̶Ϊ5 */
+#define TP_SCAN_NOW     0x80    /* scan: нȡ(жʱʹ) */
+#define TP_CAL_SHIFT    14      /* У׼ĶСλ(Q14, ֵ < 2 /ADֵ) */
+
+/* У׼: Ļ = (( * gain) >> TP_CAL_SHIFT) + off
+ * ô洢һ(4ֽ)
+ */
+typedef struct
+{
+    int16_t gain;               /* (Q14, /ADֵ, Ϊ) */
+    int16_t off;                /* ƫ() */
+} TpCalAxis_t;
 
 /*  */
 typedef struct
 {
     uint8_t (*init)(void);      /* ʼ */
-    uint8_t (*scan)(uint8_t);   /* ɨ败.0,Ļɨ;1,; */
+    uint8_t (*scan)(uint8_t);   /* ɨ败.0,Ļɨ;1,;ɻTP_SCAN_NOW */
     void (*adjust)(void);       /* У׼ */
     uint16_t x[CT_MAX_TOUCH];   /* ǰ */
     uint16_t y[CT_MAX_TOUCH];   /* 10,x[0],y[0]:˴ɨʱ,,
@@ -105,6 +116,8 @@ typedef struct
     float yfac;                 /* 5У׼y */
     short xc;                   /* Xֵ(ADֵ) */
     short yc;                   /* Yֵ(ADֵ) */
+    TpCalAxis_t xcal;           /* 4ԤĶ任, tp_scanֱʹ */
+    TpCalAxis_t ycal;
 
     /* Ĳ,ȫߵʱҪõ.
      * b0:0, (ʺΪX,ΪYTP)
@@ -121,9 +134,10 @@ extern _m_tp_dev tp_dev;        /* 
 
 /*  */
 
-static void tp_write_byte(uint8_t data);                /* оƬдһ */
-static uint16_t tp_read_ad(uint8_t cmd);                /* ȡADתֵ */
-static uint16_t tp_read_xoy(uint8_t cmd);               /* ˲ȡ(X/Y) */
+static uint16_t tp_spi_xfer(uint16_t data, uint8_t n);  /* SPInλ */
+static void tp_read_samples(uint16_t *buf, uint8_t pairs);  /* һδɼX/Y */
+static uint16_t tp_trimmed_mean(const uint16_t *buf);   /* ȥС/ֵƽ */
+static void tp_samples_to_xy(const uint16_t *buf, uint16_t *x, uint16_t *y);   /* һΪ */
 static void tp_read_xy(uint16_t *x, uint16_t *y);       /* ˫ȡ(X+Y) */
 static uint8_t tp_read_xy2(uint16_t *x, uint16_t *y);   /* ǿ˲˫ȡ */
 static void tp_draw_touch_point(uint16_t x, uint16_t y, uint16_t color);    /* һУ׼ */
@@ -134,6 +148,9 @@ static uint8_t tp_scan(uint8_t mode);  /* ɨ
 void tp_adjust(void);                  /* У׼ */
 void tp_save_adjust_data(void);        /* У׼ */
 uint8_t tp_get_adjust_data(void);      /* ȡУ׼ */
+static uint16_t tp_cal_apply(const TpCalAxis_t *cal, uint16_t raw, uint16_t size);   /* תĻ */
+static uint8_t tp_cal_axis_valid(const TpCalAxis_t *cal, uint16_t size);    /* 鵥У׼ */
+static uint8_t tp_cal_update(void);    /* xfac/yfac/xc/yc㶨任 */
 void tp_draw_big_point(uint16_t x, uint16_t y, uint16_t color); /* һ */
 
 #endif
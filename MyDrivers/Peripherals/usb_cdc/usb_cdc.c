@@ -0,0 +1,838 @@
+/**
+ ******************************************************************************
+ * @file    usb_cdc.c
+ * @brief   USB 虚拟串口 (CDC-ACM) 设备驱动
+ * @details OTG FS 工作在从模式 (无 DMA)：OUT 数据在接收 FIFO 非空中断中
+ *          逐包读出，IN 数据在端点 FIFO 空中断中写入。所有状态只在
+ *          OTG 中断中修改；printf 通过 usb_tx_start 启动发送时已处于
+ *          屏蔽本中断的临界区或本中断中。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "usb_cdc.h"
+#include "printf_redirect.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#define LOG_MODULE "USB"
+#include "log.h"
+
+/* --------------------------- 寄存器访问 --------------------------- */
+#define USBx            USB_OTG_FS
+#define USBx_BASE       USB_OTG_FS_PERIPH_BASE
+#define USB_DEVICE      ((USB_OTG_DeviceTypeDef *)(USBx_BASE + USB_OTG_DEVICE_BASE))
+#define USB_INEP(i)     ((USB_OTG_INEndpointTypeDef *)(USBx_BASE + USB_OTG_IN_ENDPOINT_BASE + (i) * USB_OTG_EP_REG_SIZE))
+#define USB_OUTEP(i)    ((USB_OTG_OUTEndpointTypeDef *)(USBx_BASE + USB_OTG_OUT_ENDPOINT_BASE + (i) * USB_OTG_EP_REG_SIZE))
+#define USB_FIFO(i)     (*(__IO uint32_t *)(USBx_BASE + USB_OTG_FIFO_BASE + (i) * USB_OTG_FIFO_SIZE))
+#define USB_PCGCCTL     (*(__IO uint32_t *)(USBx_BASE + USB_OTG_PCGCCTL_BASE))
+
+/* FIFO 分配 (单位: 字，FS 内核共 320 字) */
+#define USB_RX_FIFO_WORDS   128     // 所有 OUT 端点共用 (含 SETUP)
+#define USB_EP0_TX_WORDS    16      // 一个控制包
+#define USB_EP1_TX_WORDS    128     // 8 个批量包，半空中断时仍有 4 包排队
+#define USB_EP2_TX_WORDS    16
+
+#define USB_EP0_SIZE        64
+#define USB_EP_DATA         1       // 批量 IN/OUT
+#define USB_EP_NOTIFY       2       // 中断 IN
+#define USB_NOTIFY_SIZE     8
+#define USB_WAIT_LOOPS      200000U // 等待内核状态位的上限 (约数毫秒)
+
+/* 接收状态 (GRXSTSP.PKTSTS) */
+#define USB_PKTSTS_OUT_DATA     2U
+#define USB_PKTSTS_SETUP_DATA   6U
+
+/* 标准请求 */
+#define USB_REQ_GET_STATUS          0x00
+#define USB_REQ_CLEAR_FEATURE       0x01
+#define USB_REQ_SET_FEATURE         0x03
+#define USB_REQ_SET_ADDRESS         0x05
+#define USB_REQ_GET_DESCRIPTOR      0x06
+#define USB_REQ_GET_CONFIGURATION   0x08
+#define USB_REQ_SET_CONFIGURATION   0x09
+#define USB_REQ_GET_INTERFACE       0x0A
+#define USB_REQ_SET_INTERFACE       0x0B
+
+/* CDC 类请求 */
+#define CDC_SET_LINE_CODING         0x20
+#define CDC_GET_LINE_CODING         0x21
+#define CDC_SET_CONTROL_LINE_STATE  0x22
+#define CDC_SEND_BREAK              0x23
+
+#define USB_LO(x)   ((uint8_t)((x) & 0xFF))
+#define USB_HI(x)   ((uint8_t)(((x) >> 8) & 0xFF))
+
+/* --------------------------- 描述符 --------------------------- */
+static const uint8_t s_device_desc[18] = {
+    18, 0x01,                       /* bLength, DEVICE */
+    0x00, 0x02,                     /* USB 2.0 */
+    0x02, 0x00, 0x00,               /* 类在接口中定义 (CDC) */
+    USB_EP0_SIZE,
+    USB_LO(USB_CDC_VID), USB_HI(USB_CDC_VID),
+    USB_LO(USB_CDC_PID), USB_HI(USB_CDC_PID),
+    0x00, 0x02,                     /* bcdDevice 2.00 */
+    1, 2, 3,                        /* 厂商、产品、序列号字符串 */
+    1                               /* 配置数 */
+};
+
+#define USB_CONFIG_DESC_SIZE 67
+static const uint8_t s_config_desc[USB_CONFIG_DESC_SIZE] = {
+    9, 0x02, USB_CONFIG_DESC_SIZE, 0x00, 2, 1, 0, 0xC0, 50, /* 2 个接口，自供电，100 mA */
+
+    /* 接口 0：通信类，抽象控制模型 */
+    9, 0x04, 0, 0, 1, 0x02, 0x02, 0x01, 0,
+    5, 0x24, 0x00, 0x10, 0x01,      /* Header, CDC 1.10 */
+    5, 0x24, 0x01, 0x00, 1,         /* Call Management：数据接口 1 */
+    4, 0x24, 0x02, 0x02,            /* ACM：支持线路编码与控制线状态 */
+    5, 0x24, 0x06, 0, 1,            /* Union：主接口 0，从接口 1 */
+    7, 0x05, 0x80 | USB_EP_NOTIFY, 0x03, USB_NOTIFY_SIZE, 0x00, 16,
+
+    /* 接口 1：数据类 */
+    9, 0x04, 1, 0, 2, 0x0A, 0x00, 0x00, 0,
+    7, 0x05, USB_EP_DATA, 0x02, USB_CDC_PACKET_SIZE, 0x00, 0,
+    7, 0x05, 0x80 | USB_EP_DATA, 0x02, USB_CDC_PACKET_SIZE, 0x00, 0,
+};
+
+static const uint8_t s_langid_desc[4] = {4, 0x03, 0x09, 0x04}; /* 英语 (美国) */
+static const char *const s_strings[] = {"MmsY", "EnviroSense Virtual COM Port"};
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef enum {
+    EP0_IDLE = 0,
+    EP0_DATA_IN,
+    EP0_DATA_OUT,
+    EP0_STATUS_IN,
+    EP0_STATUS_OUT
+} usb_ep0_state_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static UsbCdc_RxCallback_t s_rx_cb = NULL;
+static UsbCdc_Stats_t s_stats;
+
+static uint8_t s_setup[8];
+static uint8_t s_packet[USB_CDC_PACKET_SIZE];   // OUT 包 (从接收 FIFO 读出)
+static uint8_t s_ep0_buf[USB_EP0_SIZE];         // 控制传输的应答 (字符串描述符等)
+
+static struct {
+    usb_ep0_state_t state;
+    const uint8_t *ptr;     // 数据 IN 阶段下一个包
+    uint16_t left;
+    bool zlp;               // 应答短于主机请求且为整包，需补零长度包
+    uint8_t request;        // 数据 OUT 阶段所属请求
+    uint16_t rx_len;
+} s_ep0;
+
+/* EP1 IN 中的区段：ptr 直接指向 printf 环形缓冲区 */
+static struct {
+    const uint8_t *ptr;     // 下一个写入 FIFO 的字节
+    uint16_t left;          // 尚未写入 FIFO 的字节数
+    uint16_t len;           // 区段长度
+    bool zlp;               // 区段为整包的倍数，结束后补零长度包
+    bool acked;             // 数据已全部取走，只剩零长度包
+    bool busy;
+} s_tx;
+
+/* 115200 8N1 (主机可改写，不影响实际传输) */
+static uint8_t s_line_coding[7] = {0x00, 0xC2, 0x01, 0x00, 0, 0, 8};
+
+static bool s_configured = false;
+static bool s_dtr = false;
+static bool s_suspended = false;
+static volatile bool s_open = false;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static bool usb_wait(__IO uint32_t *reg, uint32_t mask, uint32_t value) {
+    for (uint32_t i = 0; i < USB_WAIT_LOOPS; i++) {
+        if ((*reg & mask) == value) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void usb_flush_tx(uint32_t num) {
+    USBx->GRSTCTL = USB_OTG_GRSTCTL_TXFFLSH | (num << USB_OTG_GRSTCTL_TXFNUM_Pos);
+    usb_wait(&USBx->GRSTCTL, USB_OTG_GRSTCTL_TXFFLSH, 0);
+}
+
+static void usb_flush_rx(void) {
+    USBx->GRSTCTL = USB_OTG_GRSTCTL_RXFFLSH;
+    usb_wait(&USBx->GRSTCTL, USB_OTG_GRSTCTL_RXFFLSH, 0);
+}
+
+/**
+ * @brief 写入端点发送 FIFO (src 可不对齐，末尾不足一个字的部分逐字节拼接)
+ */
+static void usb_write_fifo(uint8_t ep, const uint8_t *src, uint16_t len) {
+    __IO uint32_t *fifo = &USB_FIFO(ep);
+    uint16_t words = len / 4;
+
+    while (words-- > 0) {
+        *fifo = __UNALIGNED_UINT32_READ(src);
+        src += 4;
+    }
+    len &= 3;
+    if (len != 0) {
+        uint32_t w = 0;
+        for (uint16_t i = 0; i < len; i++) {
+            w |= (uint32_t)src[i] << (8 * i);
+        }
+        *fifo = w;
+    }
+}
+
+/**
+ * @brief 从接收 FIFO 读出 len 字节 (整字弹出)
+ */
+static void usb_read_fifo(uint8_t *dst, uint16_t len) {
+    __IO uint32_t *fifo = &USB_FIFO(0);
+
+    for (uint16_t i = 0; i < len; i += 4) {
+        uint32_t w = *fifo;
+        for (uint16_t b = 0; b < 4 && i + b < len; b++) {
+            dst[i + b] = (uint8_t)(w >> (8 * b));
+        }
+    }
+}
+
+/**
+ * @brief 初始化引脚与 OTG FS 内核，配置为全速设备
+ */
+static bool usb_hw_init(void) {
+    GPIO_InitTypeDef gpio = {0};
+
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+    gpio.Pin = GPIO_PIN_11 | GPIO_PIN_12;  /* OTG_FS_DM / OTG_FS_DP */
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+    gpio.Alternate = GPIO_AF10_OTG_FS;
+    HAL_GPIO_Init(GPIOA, &gpio);
+
+    __HAL_RCC_USB_OTG_FS_CLK_ENABLE();
+
+    /* 内核软复位 */
+    if (!usb_wait(&USBx->GRSTCTL, USB_OTG_GRSTCTL_AHBIDL, USB_OTG_GRSTCTL_AHBIDL)) {
+        return false;
+    }
+    USBx->GRSTCTL |= USB_OTG_GRSTCTL_CSRST;
+    if (!usb_wait(&USBx->GRSTCTL, USB_OTG_GRSTCTL_CSRST, 0)) {
+        return false;
+    }
+
+    /* 打开收发器；不检测 VBUS，始终认为已接入 */
+    USBx->GCCFG = USB_OTG_GCCFG_PWRDWN | USB_OTG_GCCFG_NOVBUSSENS;
+
+    /* 强制设备模式 (25 ms 后生效)；AHB >= 32 MHz 时周转时间取 6 */
+    USBx->GUSBCFG = (USBx->GUSBCFG & ~(USB_OTG_GUSBCFG_FHMOD | USB_OTG_GUSBCFG_TRDT)) |
+                    USB_OTG_GUSBCFG_FDMOD | (6U << USB_OTG_GUSBCFG_TRDT_Pos);
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    USB_PCGCCTL = 0;
+    USB_DEVICE->DCTL |= USB_OTG_DCTL_SDIS;     /* 配置完成前不上拉 DP */
+    USB_DEVICE->DCFG |= USB_OTG_DCFG_DSPD;     /* 全速，内置 PHY */
+
+    usb_flush_tx(0x10);
+    usb_flush_rx();
+    USB_DEVICE->DIEPMSK = 0;
+    USB_DEVICE->DOEPMSK = 0;
+    USB_DEVICE->DAINTMSK = 0;
+    USB_DEVICE->DIEPEMPMSK = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        USB_INEP(i)->DIEPCTL = 0;
+        USB_INEP(i)->DIEPTSIZ = 0;
+        USB_INEP(i)->DIEPINT = 0xFB7FU;
+        USB_OUTEP(i)->DOEPCTL = 0;
+        USB_OUTEP(i)->DOEPTSIZ = 0;
+        USB_OUTEP(i)->DOEPINT = 0xFB7FU;
+    }
+
+    USBx->GRXFSIZ = USB_RX_FIFO_WORDS;
+    USBx->DIEPTXF0_HNPTXFSIZ = (USB_EP0_TX_WORDS << 16) | USB_RX_FIFO_WORDS;
+    USBx->DIEPTXF[USB_EP_DATA - 1] = (USB_EP1_TX_WORDS << 16) |
+                                     (USB_RX_FIFO_WORDS + USB_EP0_TX_WORDS);
+    USBx->DIEPTXF[USB_EP_NOTIFY - 1] = (USB_EP2_TX_WORDS << 16) |
+                                       (USB_RX_FIFO_WORDS + USB_EP0_TX_WORDS + USB_EP1_TX_WORDS);
+
+    USBx->GINTMSK = 0;
+    USBx->GINTSTS = 0xBFFFFFFFU;
+    USBx->GINTMSK = USB_OTG_GINTMSK_USBRST | USB_OTG_GINTMSK_ENUMDNEM |
+                    USB_OTG_GINTMSK_RXFLVLM | USB_OTG_GINTMSK_IEPINT |
+                    USB_OTG_GINTMSK_OEPINT | USB_OTG_GINTMSK_USBSUSPM |
+                    USB_OTG_GINTMSK_WUIM;
+    USBx->GAHBCFG |= USB_OTG_GAHBCFG_GINT;
+
+    HAL_NVIC_SetPriority(OTG_FS_IRQn, USB_CDC_IRQ_PRIORITY, 0);
+    HAL_NVIC_EnableIRQ(OTG_FS_IRQn);
+
+    USB_DEVICE->DCTL &= ~USB_OTG_DCTL_SDIS;    /* 上拉 DP，主机开始枚举 */
+    return true;
+}
+
+/* ---------------- 批量端点与 printf 发送通道 ---------------- */
+
+static void usb_rx_arm(void) {
+    USB_OUTEP(USB_EP_DATA)->DOEPTSIZ = (1U << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | USB_CDC_PACKET_SIZE;
+    USB_OUTEP(USB_EP_DATA)->DOEPCTL |= USB_OTG_DOEPCTL_CNAK | USB_OTG_DOEPCTL_EPENA;
+}
+
+/**
+ * @brief printf 发送通道：把环形缓冲区中的一个区段交给 EP1 IN
+ * @note  在临界区或 OTG 中断中调用
+ */
+static uint8_t usb_tx_start(const uint8_t *data, uint16_t len) {
+    uint32_t packets;
+
+    if (!s_open || s_tx.busy || len == 0) {
+        return 0;
+    }
+    packets = (len + USB_CDC_PACKET_SIZE - 1) / USB_CDC_PACKET_SIZE;
+    s_tx.ptr = data;
+    s_tx.left = len;
+    s_tx.len = len;
+    s_tx.zlp = (len % USB_CDC_PACKET_SIZE) == 0;
+    s_tx.acked = false;
+    s_tx.busy = true;
+
+    USB_INEP(USB_EP_DATA)->DIEPTSIZ = (packets << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | len;
+    USB_INEP(USB_EP_DATA)->DIEPCTL |= USB_OTG_DIEPCTL_CNAK | USB_OTG_DIEPCTL_EPENA;
+    USB_DEVICE->DIEPEMPMSK |= 1U << USB_EP_DATA;
+    return 1;
+}
+
+/**
+ * @brief FIFO 有空间：按整包从环形缓冲区写入
+ */
+static void usb_tx_fill(void) {
+    while (s_tx.left > 0) {
+        uint16_t n = s_tx.left > USB_CDC_PACKET_SIZE ? USB_CDC_PACKET_SIZE : s_tx.left;
+
+        if ((USB_INEP(USB_EP_DATA)->DTXFSTS & USB_OTG_DTXFSTS_INEPTFSAV) < (uint32_t)((n + 3) / 4)) {
+            return;
+        }
+        usb_write_fifo(USB_EP_DATA, s_tx.ptr, n);
+        s_tx.ptr += n;
+        s_tx.left -= n;
+    }
+    USB_DEVICE->DIEPEMPMSK &= ~(1U << USB_EP_DATA);
+}
+
+/**
+ * @brief 区段 (及其后的零长度包) 已被主机取走
+ */
+static void usb_tx_done(void) {
+    if (!s_tx.busy) {
+        return;
+    }
+    if (s_tx.zlp) {
+        s_tx.zlp = false;
+        s_tx.acked = true;
+        USB_INEP(USB_EP_DATA)->DIEPTSIZ = 1U << USB_OTG_DIEPTSIZ_PKTCNT_Pos;
+        USB_INEP(USB_EP_DATA)->DIEPCTL |= USB_OTG_DIEPCTL_CNAK | USB_OTG_DIEPCTL_EPENA;
+        return;
+    }
+    s_tx.busy = false;
+    s_stats.tx_bytes += s_tx.len;
+    s_stats.tx_transfers++;
+    printf_tx_channel_done(s_tx.len);
+}
+
+/**
+ * @brief 放弃发送中的区段，已被主机取走的整包计为已发出
+ */
+static void usb_tx_abort(void) {
+    USB_OTG_INEndpointTypeDef *ep = USB_INEP(USB_EP_DATA);
+    uint32_t packets, left;
+    uint16_t sent;
+
+    if (!s_tx.busy) {
+        return;
+    }
+    if (ep->DIEPCTL & USB_OTG_DIEPCTL_EPENA) {
+        ep->DIEPCTL |= USB_OTG_DIEPCTL_SNAK;
+        ep->DIEPCTL |= USB_OTG_DIEPCTL_EPDIS;
+        usb_wait(&ep->DIEPINT, USB_OTG_DIEPINT_EPDISD, USB_OTG_DIEPINT_EPDISD);
+        ep->DIEPINT = USB_OTG_DIEPINT_EPDISD;
+    }
+    usb_flush_tx(USB_EP_DATA);
+    USB_DEVICE->DIEPEMPMSK &= ~(1U << USB_EP_DATA);
+
+    /* PKTCNT 在包从 FIFO 发出时递减 */
+    packets = (s_tx.len + USB_CDC_PACKET_SIZE - 1) / USB_CDC_PACKET_SIZE;
+    left = (ep->DIEPTSIZ & USB_OTG_DIEPTSIZ_PKTCNT) >> USB_OTG_DIEPTSIZ_PKTCNT_Pos;
+    sent = left < packets ? (uint16_t)((packets - left) * USB_CDC_PACKET_SIZE) : 0;
+    if (s_tx.acked || sent > s_tx.len) {
+        sent = s_tx.len;
+    }
+
+    s_tx.busy = false;
+    s_tx.zlp = false;
+    s_stats.tx_bytes += sent;
+    s_stats.tx_aborted++;
+    printf_tx_channel_done(sent);
+}
+
+/**
+ * @brief 根据配置、DTR 与挂起状态打开或关闭端口
+ */
+static void usb_port_update(void) {
+    bool open = s_configured && s_dtr && !s_suspended;
+
+    if (open == s_open) {
+        return;
+    }
+    s_open = open;
+    if (open) {
+        printf_set_tx_channel(usb_tx_start);
+    } else {
+        /* 先切回 UART，放弃的区段完成后剩余数据由 UART 接着发送 */
+        printf_set_tx_channel(NULL);
+        usb_tx_abort();
+    }
+}
+
+static void usb_data_eps_open(void) {
+    USB_INEP(USB_EP_DATA)->DIEPCTL = USB_OTG_DIEPCTL_USBAEP | USB_OTG_DIEPCTL_SD0PID_SEVNFRM |
+                                     (2U << USB_OTG_DIEPCTL_EPTYP_Pos) |
+                                     (USB_EP_DATA << USB_OTG_DIEPCTL_TXFNUM_Pos) |
+                                     USB_CDC_PACKET_SIZE;
+    USB_OUTEP(USB_EP_DATA)->DOEPCTL = USB_OTG_DOEPCTL_USBAEP | USB_OTG_DOEPCTL_SD0PID_SEVNFRM |
+                                      (2U << USB_OTG_DOEPCTL_EPTYP_Pos) | USB_CDC_PACKET_SIZE;
+    USB_INEP(USB_EP_NOTIFY)->DIEPCTL = USB_OTG_DIEPCTL_USBAEP | USB_OTG_DIEPCTL_SD0PID_SEVNFRM |
+                                       (3U << USB_OTG_DIEPCTL_EPTYP_Pos) |
+                                       (USB_EP_NOTIFY << USB_OTG_DIEPCTL_TXFNUM_Pos) |
+                                       USB_NOTIFY_SIZE;
+    USB_DEVICE->DAINTMSK |= (1U << USB_EP_DATA) | (1U << (16 + USB_EP_DATA));
+    usb_rx_arm();
+}
+
+static void usb_data_eps_close(void) {
+    USB_DEVICE->DAINTMSK &= ~((1U << USB_EP_DATA) | (1U << (16 + USB_EP_DATA)));
+    USB_INEP(USB_EP_DATA)->DIEPCTL &= ~USB_OTG_DIEPCTL_USBAEP;
+    USB_OUTEP(USB_EP_DATA)->DOEPCTL &= ~USB_OTG_DOEPCTL_USBAEP;
+    USB_INEP(USB_EP_NOTIFY)->DIEPCTL &= ~USB_OTG_DIEPCTL_USBAEP;
+}
+
+/* --------------------------- 控制端点 --------------------------- */
+
+/**
+ * @brief 准备接收 SETUP (enable 同时允许数据/状态 OUT 阶段)
+ */
+static void usb_ep0_out_arm(bool enable) {
+    USB_OUTEP(0)->DOEPTSIZ = (3U << USB_OTG_DOEPTSIZ_STUPCNT_Pos) |
+                             (1U << USB_OTG_DOEPTSIZ_PKTCNT_Pos) | USB_EP0_SIZE;
+    if (enable) {
+        USB_OUTEP(0)->DOEPCTL |= USB_OTG_DOEPCTL_CNAK | USB_OTG_DOEPCTL_EPENA;
+    }
+}
+
+static void usb_ep0_in_packet(void) {
+    uint16_t n = s_ep0.left > USB_EP0_SIZE ? USB_EP0_SIZE : s_ep0.left;
+
+    USB_INEP(0)->DIEPTSIZ = (1U << USB_OTG_DIEPTSIZ_PKTCNT_Pos) | n;
+    USB_INEP(0)->DIEPCTL |= USB_OTG_DIEPCTL_CNAK | USB_OTG_DIEPCTL_EPENA;
+    if (n != 0) {
+        usb_write_fifo(0, s_ep0.ptr, n);    /* FIFO 恰好容纳一个包，上一包已完成 */
+    }
+    s_ep0.ptr += n;
+    s_ep0.left -= n;
+}
+
+static void usb_ep0_send(const uint8_t *data, uint16_t len, uint16_t w_length) {
+    if (len > w_length) {
+        len = w_length;
+    }
+    s_ep0.state = EP0_DATA_IN;
+    s_ep0.ptr = data;
+    s_ep0.left = len;
+    s_ep0.zlp = len < w_length && (len % USB_EP0_SIZE) == 0;
+    usb_ep0_in_packet();
+}
+
+static void usb_ep0_status_in(void) {
+    s_ep0.state = EP0_STATUS_IN;
+    USB_INEP(0)->DIEPTSIZ = 1U << USB_OTG_DIEPTSIZ_PKTCNT_Pos;
+    USB_INEP(0)->DIEPCTL |= USB_OTG_DIEPCTL_CNAK | USB_OTG_DIEPCTL_EPENA;
+}
+
+static void usb_ep0_receive(uint8_t request) {
+    s_ep0.state = EP0_DATA_OUT;
+    s_ep0.request = request;
+    s_ep0.rx_len = 0;
+    usb_ep0_out_arm(true);
+}
+
+static void usb_ep0_stall(void) {
+    USB_INEP(0)->DIEPCTL |= USB_OTG_DIEPCTL_STALL;
+    USB_OUTEP(0)->DOEPCTL |= USB_OTG_DOEPCTL_STALL;  /* 下一个 SETUP 到达时硬件清除 */
+    s_ep0.state = EP0_IDLE;
+    usb_ep0_out_arm(false);
+}
+
+/**
+ * @brief ASCII 字符串转为字符串描述符 (UTF-16LE)
+ */
+static uint16_t usb_string_desc(const char *text) {
+    uint16_t n = 2;
+
+    while (*text != '\0' && n + 2 <= sizeof(s_ep0_buf)) {
+        s_ep0_buf[n++] = (uint8_t)*text++;
+        s_ep0_buf[n++] = 0;
+    }
+    s_ep0_buf[0] = (uint8_t)n;
+    s_ep0_buf[1] = 0x03;
+    return n;
+}
+
+/**
+ * @brief 芯片唯一 ID 作为序列号 (96 位，24 个十六进制字符)
+ */
+static uint16_t usb_serial_desc(void) {
+    static const char hex[] = "0123456789ABCDEF";
+    const uint8_t *uid = (const uint8_t *)UID_BASE;
+    char text[25];
+
+    for (uint8_t i = 0; i < 12; i++) {
+        text[2 * i] = hex[uid[i] >> 4];
+        text[2 * i + 1] = hex[uid[i] & 0x0F];
+    }
+    text[24] = '\0';
+    return usb_string_desc(text);
+}
+
+static void usb_get_descriptor(uint16_t value, uint16_t length) {
+    uint8_t index = USB_LO(value);
+
+    switch (value >> 8) {
+    case 0x01:
+        usb_ep0_send(s_device_desc, sizeof(s_device_desc), length);
+        break;
+    case 0x02:
+        usb_ep0_send(s_config_desc, sizeof(s_config_desc), length);
+        break;
+    case 0x03:
+        if (index == 0) {
+            usb_ep0_send(s_langid_desc, sizeof(s_langid_desc), length);
+        } else if (index <= 2) {
+            usb_ep0_send(s_ep0_buf, usb_string_desc(s_strings[index - 1]), length);
+        } else if (index == 3) {
+            usb_ep0_send(s_ep0_buf, usb_serial_desc(), length);
+        } else {
+            usb_ep0_stall();
+        }
+        break;
+    default:
+        usb_ep0_stall();    /* 设备限定描述符等：仅全速设备，不支持 */
+        break;
+    }
+}
+
+static void usb_standard_request(uint8_t type, uint8_t request, uint16_t value,
+                                 uint16_t length) {
+    switch (request) {
+    case USB_REQ_GET_STATUS:
+        s_ep0_buf[0] = (type & 0x1F) == 0 ? 0x01 : 0x00;    /* 设备：自供电 */
+        s_ep0_buf[1] = 0;
+        usb_ep0_send(s_ep0_buf, 2, length);
+        break;
+    case USB_REQ_CLEAR_FEATURE:
+    case USB_REQ_SET_FEATURE:
+    case USB_REQ_SET_INTERFACE:
+        usb_ep0_status_in();
+        break;
+    case USB_REQ_SET_ADDRESS:
+        /* OTG 内核在状态阶段之前写入地址 */
+        USB_DEVICE->DCFG = (USB_DEVICE->DCFG & ~USB_OTG_DCFG_DAD) |
+                           ((uint32_t)(value & 0x7F) << USB_OTG_DCFG_DAD_Pos);
+        usb_ep0_status_in();
+        break;
+    case USB_REQ_GET_DESCRIPTOR:
+        usb_get_descriptor(value, length);
+        break;
+    case USB_REQ_GET_CONFIGURATION:
+        s_ep0_buf[0] = s_configured ? 1 : 0;
+        usb_ep0_send(s_ep0_buf, 1, length);
+        break;
+    case USB_REQ_SET_CONFIGURATION:
+        if (value > 1) {
+            usb_ep0_stall();
+            break;
+        }
+        if (value == 1 && !s_configured) {
+            usb_data_eps_open();
+        } else if (value == 0 && s_configured) {
+            s_dtr = false;
+        }
+        s_configured = value == 1;
+        usb_port_update();
+        if (!s_configured) {
+            usb_data_eps_close();
+        }
+        usb_ep0_status_in();
+        break;
+    case USB_REQ_GET_INTERFACE:
+        s_ep0_buf[0] = 0;
+        usb_ep0_send(s_ep0_buf, 1, length);
+        break;
+    default:
+        usb_ep0_stall();
+        break;
+    }
+}
+
+static void usb_class_request(uint8_t request, uint16_t value, uint16_t length) {
+    switch (request) {
+    case CDC_SET_LINE_CODING:
+        usb_ep0_receive(request);
+        break;
+    case CDC_GET_LINE_CODING:
+        usb_ep0_send(s_line_coding, sizeof(s_line_coding), length);
+        break;
+    case CDC_SET_CONTROL_LINE_STATE:
+        s_dtr = (value & 0x01) != 0;
+        usb_port_update();
+        usb_ep0_status_in();
+        break;
+    case CDC_SEND_BREAK:
+        usb_ep0_status_in();
+        break;
+    default:
+        usb_ep0_stall();
+        break;
+    }
+}
+
+static void usb_setup(void) {
+    uint8_t type = s_setup[0];
+    uint8_t request = s_setup[1];
+    uint16_t value = (uint16_t)(s_setup[2] | (s_setup[3] << 8));
+    uint16_t length = (uint16_t)(s_setup[6] | (s_setup[7] << 8));
+
+    s_ep0.state = EP0_IDLE;
+    switch (type & 0x60) {
+    case 0x00:
+        usb_standard_request(type, request, value, length);
+        break;
+    case 0x20:
+        usb_class_request(request, value, length);
+        break;
+    default:
+        usb_ep0_stall();
+        break;
+    }
+}
+
+/**
+ * @brief EP0 IN 包完成：继续数据阶段，或进入状态阶段
+ */
+static void usb_ep0_in_done(void) {
+    if (s_ep0.state == EP0_DATA_IN) {
+        if (s_ep0.left > 0) {
+            usb_ep0_in_packet();
+        } else if (s_ep0.zlp) {
+            s_ep0.zlp = false;
+            usb_ep0_in_packet();
+        } else {
+            s_ep0.state = EP0_STATUS_OUT;
+            usb_ep0_out_arm(true);
+        }
+    } else if (s_ep0.state == EP0_STATUS_IN) {
+        s_ep0.state = EP0_IDLE;
+        usb_ep0_out_arm(false);
+    }
+}
+
+/**
+ * @brief EP0 OUT 传输完成：数据阶段 (线路编码) 或状态阶段
+ */
+static void usb_ep0_out_done(void) {
+    if (s_ep0.state == EP0_DATA_OUT) {
+        if (s_ep0.request == CDC_SET_LINE_CODING && s_ep0.rx_len >= sizeof(s_line_coding)) {
+            memcpy(s_line_coding, s_ep0_buf, sizeof(s_line_coding));
+        }
+        usb_ep0_status_in();
+    } else if (s_ep0.state == EP0_STATUS_OUT) {
+        s_ep0.state = EP0_IDLE;
+        usb_ep0_out_arm(false);
+    }
+}
+
+/* --------------------------- 中断事件 --------------------------- */
+
+static void usb_on_reset(void) {
+    s_stats.bus_resets++;
+    s_configured = false;
+    s_dtr = false;
+    s_suspended = false;
+    usb_port_update();
+    usb_data_eps_close();
+
+    USB_DEVICE->DCTL &= ~USB_OTG_DCTL_RWUSIG;
+    usb_flush_tx(0x10);
+    for (uint8_t i = 0; i < 4; i++) {
+        USB_INEP(i)->DIEPINT = 0xFB7FU;
+        USB_INEP(i)->DIEPCTL &= ~USB_OTG_DIEPCTL_STALL;
+        USB_OUTEP(i)->DOEPINT = 0xFB7FU;
+        USB_OUTEP(i)->DOEPCTL &= ~USB_OTG_DOEPCTL_STALL;
+    }
+    USB_DEVICE->DAINTMSK = (1U << 0) | (1U << 16);
+    USB_DEVICE->DOEPMSK = USB_OTG_DOEPMSK_STUPM | USB_OTG_DOEPMSK_XFRCM;
+    USB_DEVICE->DIEPMSK = USB_OTG_DIEPMSK_XFRCM;
+    USB_DEVICE->DCFG &= ~USB_OTG_DCFG_DAD;
+
+    s_ep0.state = EP0_IDLE;
+    usb_ep0_out_arm(false);
+}
+
+static void usb_on_enum_done(void) {
+    USB_INEP(0)->DIEPCTL &= ~USB_OTG_DIEPCTL_MPSIZ;   /* 0: 64 字节 */
+    USB_DEVICE->DCTL |= USB_OTG_DCTL_CGINAK;
+}
+
+/**
+ * @brief 弹出一条接收状态并读出对应数据
+ */
+static void usb_on_rx_status(void) {
+    uint32_t status = USBx->GRXSTSP;
+    uint8_t ep = (uint8_t)(status & USB_OTG_GRXSTSP_EPNUM);
+    uint16_t len = (uint16_t)((status & USB_OTG_GRXSTSP_BCNT) >> USB_OTG_GRXSTSP_BCNT_Pos);
+    uint32_t kind = (status & USB_OTG_GRXSTSP_PKTSTS) >> USB_OTG_GRXSTSP_PKTSTS_Pos;
+
+    if (len > sizeof(s_packet)) {
+        len = sizeof(s_packet);
+    }
+    if (kind == USB_PKTSTS_SETUP_DATA) {
+        usb_read_fifo(s_setup, sizeof(s_setup));
+    } else if (kind == USB_PKTSTS_OUT_DATA && len != 0) {
+        usb_read_fifo(s_packet, len);
+        if (ep == 0) {
+            uint16_t room = sizeof(s_ep0_buf) - s_ep0.rx_len;
+            uint16_t n = len < room ? len : room;
+            memcpy(&s_ep0_buf[s_ep0.rx_len], s_packet, n);
+            s_ep0.rx_len += n;
+        } else if (ep == USB_EP_DATA) {
+            s_stats.rx_bytes += len;
+            if (s_rx_cb != NULL) {
+                s_rx_cb(s_packet, len);
+            }
+        }
+    }
+}
+
+static void usb_on_out_ep(void) {
+    uint32_t eps = (USB_DEVICE->DAINT & USB_DEVICE->DAINTMSK) >> 16;
+    uint32_t flags;
+
+    if (eps & (1U << 0)) {
+        flags = USB_OUTEP(0)->DOEPINT & USB_DEVICE->DOEPMSK;
+        USB_OUTEP(0)->DOEPINT = flags;
+        if (flags & USB_OTG_DOEPINT_XFRC) {
+            usb_ep0_out_done();
+        }
+        if (flags & USB_OTG_DOEPINT_STUP) {
+            usb_setup();
+        }
+    }
+    if (eps & (1U << USB_EP_DATA)) {
+        flags = USB_OUTEP(USB_EP_DATA)->DOEPINT & USB_DEVICE->DOEPMSK;
+        USB_OUTEP(USB_EP_DATA)->DOEPINT = flags;
+        if (flags & USB_OTG_DOEPINT_XFRC) {
+            usb_rx_arm();
+        }
+    }
+}
+
+static void usb_on_in_ep(void) {
+    uint32_t eps = USB_DEVICE->DAINT & USB_DEVICE->DAINTMSK & 0xFFFFU;
+    uint32_t flags;
+
+    if (eps & (1U << 0)) {
+        flags = USB_INEP(0)->DIEPINT & USB_DEVICE->DIEPMSK;
+        USB_INEP(0)->DIEPINT = flags;
+        if (flags & USB_OTG_DIEPINT_XFRC) {
+            usb_ep0_in_done();
+        }
+    }
+    if (eps & (1U << USB_EP_DATA)) {
+        uint32_t mask = USB_DEVICE->DIEPMSK;
+
+        if (USB_DEVICE->DIEPEMPMSK & (1U << USB_EP_DATA)) {
+            mask |= USB_OTG_DIEPINT_TXFE;
+        }
+        flags = USB_INEP(USB_EP_DATA)->DIEPINT & mask;
+        USB_INEP(USB_EP_DATA)->DIEPINT = flags & ~USB_OTG_DIEPINT_TXFE;  /* TXFE 只读 */
+        if (flags & USB_OTG_DIEPINT_TXFE) {
+            usb_tx_fill();
+        }
+        if (flags & USB_OTG_DIEPINT_XFRC) {
+            usb_tx_done();
+        }
+    }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+bool UsbCdc_Init(UsbCdc_RxCallback_t rx) {
+    s_rx_cb = rx;
+    if (!usb_hw_init()) {
+        LOG_ERROR("OTG FS 初始化失败");
+        return false;
+    }
+    return true;
+}
+
+bool UsbCdc_IsOpen(void) {
+    return s_open;
+}
+
+uint32_t UsbCdc_GetLineRate(void) {
+    return (uint32_t)s_line_coding[0] | ((uint32_t)s_line_coding[1] << 8) |
+           ((uint32_t)s_line_coding[2] << 16) | ((uint32_t)s_line_coding[3] << 24);
+}
+
+void UsbCdc_GetStats(UsbCdc_Stats_t *stats) {
+    *stats = s_stats;
+}
+
+/**
+ * @brief OTG FS 中断处理
+ */
+void UsbCdc_IRQHandler(void) {
+    uint32_t status = USBx->GINTSTS & USBx->GINTMSK;
+
+    if (status & USB_OTG_GINTSTS_USBRST) {
+        USBx->GINTSTS = USB_OTG_GINTSTS_USBRST;
+        usb_on_reset();
+    }
+    if (status & USB_OTG_GINTSTS_ENUMDNE) {
+        USBx->GINTSTS = USB_OTG_GINTSTS_ENUMDNE;
+        usb_on_enum_done();
+    }
+    /* RXFLVL 随接收状态弹出自动清除 */
+    while (USBx->GINTSTS & USB_OTG_GINTSTS_RXFLVL) {
+        usb_on_rx_status();
+    }
+    if (status & USB_OTG_GINTSTS_OEPINT) {
+        usb_on_out_ep();
+    }
+    if (status & USB_OTG_GINTSTS_IEPINT) {
+        usb_on_in_ep();
+    }
+    if (status & USB_OTG_GINTSTS_USBSUSP) {
+        /* 不检测 VBUS，拔线与主机挂起都表现为总线空闲 3 ms */
+        USBx->GINTSTS = USB_OTG_GINTSTS_USBSUSP;
+        s_stats.suspends++;
+        s_suspended = true;
+        usb_port_update();
+    }
+    if (status & USB_OTG_GINTSTS_WKUINT) {
+        USBx->GINTSTS = USB_OTG_GINTSTS_WKUINT;
+        USB_DEVICE->DCTL &= ~USB_OTG_DCTL_RWUSIG;
+        s_suspended = false;
+        usb_port_update();
+    }
+}
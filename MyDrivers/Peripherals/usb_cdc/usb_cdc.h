@@ -0,0 +1,92 @@
+/**
+ ******************************************************************************
+ * @file    usb_cdc.h
+ * @brief   USB 虚拟串口 (CDC-ACM) 设备驱动头文件
+ * @details 使用 OTG FS 内核 (PA11 DM, PA12 DP)，全速设备，不检测 VBUS
+ *          (PA9 已用作 USART1_TX)。CubeMX 工程未配置 USB，驱动直接操作
+ *          OTG 寄存器自行初始化，除 RCC 的 48 MHz 时钟 (PLLQ) 外不依赖
+ *          CubeMX 生成的代码。端点：
+ *            - EP0      控制传输 (枚举、线路编码、DTR)
+ *            - EP1 IN   批量，承载 printf 发送环形缓冲区的数据
+ *            - EP1 OUT  批量，主机输入转交接收回调 (命令行)
+ *            - EP2 IN   中断，CDC 通知 (不发送，主机轮询时 NAK)
+ *          主机打开端口 (置位 DTR) 后 printf 的发送通道从 USART1 切换到
+ *          EP1 IN，日志、分帧导出与事件跟踪随之走 USB；端口关闭、总线
+ *          复位或挂起 (拔线) 时切回 USART1。FS 内核没有 DMA，发送时在
+ *          FIFO 空中断里直接从 printf 环形缓冲区读出写入端点 FIFO，
+ *          不经过中间缓冲区。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __USB_CDC_H
+#define __USB_CDC_H
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define USB_CDC_VID           0x0483      // STMicroelectronics
+#define USB_CDC_PID           0x5740      // Virtual COM Port (主机使用系统自带驱动)
+#define USB_CDC_IRQ_PRIORITY  6           // 不高于 configMAX_SYSCALL_INTERRUPT_PRIORITY
+#define USB_CDC_PACKET_SIZE   64          // 全速批量端点最大包长
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 主机输入回调 (中断上下文)
+ */
+typedef void (*UsbCdc_RxCallback_t)(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief 驱动统计
+ */
+typedef struct {
+    uint32_t tx_bytes;      // 经 EP1 IN 发出的字节数
+    uint32_t tx_transfers;  // 完成的发送区段数
+    uint32_t tx_aborted;    // 发送中端口关闭而放弃的区段数
+    uint32_t rx_bytes;      // 主机发来的字节数
+    uint32_t bus_resets;    // 总线复位次数 (每次插入至少一次)
+    uint32_t suspends;      // 挂起次数 (拔线时也表现为挂起)
+} UsbCdc_Stats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化 OTG FS 内核并连接到总线
+ * @param rx 主机输入回调，NULL 表示丢弃
+ * @return true: 成功
+ */
+bool UsbCdc_Init(UsbCdc_RxCallback_t rx);
+
+/**
+ * @brief 主机是否已打开端口 (已配置并置位 DTR，且未挂起)
+ */
+bool UsbCdc_IsOpen(void);
+
+/**
+ * @brief 主机设置的波特率 (虚拟串口不使用，仅供查看)
+ */
+uint32_t UsbCdc_GetLineRate(void);
+
+/**
+ * @brief 获取驱动统计
+ */
+void UsbCdc_GetStats(UsbCdc_Stats_t *stats);
+
+/**
+ * @brief OTG FS 中断处理，在 OTG_FS_IRQHandler 中调用
+ */
+void UsbCdc_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __USB_CDC_H */
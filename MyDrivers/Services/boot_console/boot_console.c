@@ -0,0 +1,197 @@
+/**
+ ******************************************************************************
+ * @file    boot_console.c
+ * @brief   启动文字控制台实现
+ * @details 屏幕按行高划分为 s_lines 行。写满之前依次向下写；写满之后：
+ *          - 硬件滚动可用时 (控制器支持且行列不交换、屏高为行高整数倍)，
+ *            新行写在当前最上方一行的位置，再把滚动起始行移到下一行，
+ *            新行于是出现在屏幕最下方；
+ *          - 否则回到首行依次覆盖，并清空下一行标出最新位置。
+ *          多个启动工作任务可能同时输出日志，行缓冲与 LCD 写入由互斥量保护。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "boot_console.h"
+#include "FreeRTOS.h"
+#include "lcd.h"
+#include "lcd_orient.h"
+#include "semphr.h"
+#include <stdarg.h>
+#include <stdio.h>
+
+#define LOG_MODULE "CONSOLE"
+#include "log.h"
+
+#if BOOT_CONSOLE_ENABLE
+
+/* --------------------------- 私有变量 --------------------------- */
+static SemaphoreHandle_t s_lock;
+static StaticSemaphore_t s_lock_buf;
+static volatile bool s_active;
+static bool s_hw_scroll; // 写满后使用硬件滚动
+static bool s_full;      // 已写满一屏
+static uint16_t s_lines; // 屏幕行数
+static uint16_t s_cols;  // 每行字符数
+static uint16_t s_row;   // 下一行写入的位置 (硬件滚动时即最上方一行)
+static char s_fmt[LOG_SINK_MSG_SIZE + 24];   // 格式化结果
+static char s_line[LCD_LINE_MAX_CHARS + 1]; // 当前行
+
+/* --------------------------- 私有函数实现 --------------------------- */
+
+static bool console_lock(void) {
+  return xSemaphoreTake(s_lock, pdMS_TO_TICKS(BOOT_CONSOLE_LOCK_MS)) == pdTRUE;
+}
+
+static void console_unlock(void) { xSemaphoreGive(s_lock); }
+
+/**
+ * @brief 显示 s_line 并前进一行 (调用者持有互斥量)
+ */
+static void console_emit(uint16_t color) {
+  lcd_show_line(s_row * BOOT_CONSOLE_FONT, BOOT_CONSOLE_FONT, s_line, color,
+                BOOT_CONSOLE_BG);
+  if (++s_row == s_lines) {
+    s_row = 0;
+    s_full = true;
+  }
+  if (!s_full) {
+    return;
+  }
+  if (s_hw_scroll) {
+    lcd_orient_vscroll_set(s_row * BOOT_CONSOLE_FONT);
+  } else {
+    lcd_show_line(s_row * BOOT_CONSOLE_FONT, BOOT_CONSOLE_FONT, "", color,
+                  BOOT_CONSOLE_BG);
+  }
+}
+
+/**
+ * @brief 按行输出一段文字 (调用者持有互斥量)
+ * @note  UTF-8 多字节字符折合为一个 '?'，lcd_show_line 会把其余不可显示
+ *        的字符也换成 '?'
+ */
+static void console_puts(uint16_t color, const char *s) {
+  uint16_t n = 0;
+
+  for (; *s != '\0'; s++) {
+    unsigned char c = (unsigned char)*s;
+
+    if (c == '\n') {
+      s_line[n] = '\0';
+      console_emit(color);
+      n = 0;
+      continue;
+    }
+    if ((c & 0xC0) == 0x80) {
+      continue; // UTF-8 后续字节
+    }
+    if (n == s_cols) {
+      s_line[n] = '\0';
+      console_emit(color);
+      n = 0;
+    }
+    s_line[n++] = (c >= 0x80) ? '?' : (char)c;
+  }
+  s_line[n] = '\0';
+  console_emit(color);
+}
+
+/**
+ * @brief 日志附加输出：警告以上级别的日志
+ */
+static void console_log_sink(log_level_t level, const char *module,
+                             const char *msg) {
+  if (!s_active || !console_lock()) {
+    return;
+  }
+  if (s_active) {
+    snprintf(s_fmt, sizeof(s_fmt), "%c %s: %s",
+             (level >= LOG_LEVEL_ERROR) ? 'E' : 'W', module, msg);
+    console_puts((level >= LOG_LEVEL_ERROR) ? RED : YELLOW, s_fmt);
+  }
+  console_unlock();
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 清屏并开始显示
+ */
+void BootConsole_Init(void) {
+  if (s_lock == NULL) {
+    s_lock = xSemaphoreCreateMutexStatic(&s_lock_buf);
+  }
+  s_lines = lcddev.height / BOOT_CONSOLE_FONT;
+  s_cols = lcddev.width / (BOOT_CONSOLE_FONT / 2);
+  if (s_cols > LCD_LINE_MAX_CHARS) {
+    s_cols = LCD_LINE_MAX_CHARS;
+  }
+  s_hw_scroll = lcd_orient_vscroll_dir() != 0 &&
+                lcddev.height % BOOT_CONSOLE_FONT == 0;
+  s_row = 0;
+  s_full = false;
+
+  lcd_orient_vscroll_set(0);
+  lcd_clear(BOOT_CONSOLE_BG);
+  s_active = true;
+
+  BootConsole_Printf(GREEN, "EnviroSense boot  LCD %04X %ux%u", lcddev.id,
+                     lcddev.width, lcddev.height);
+  log_set_sink(console_log_sink, BOOT_CONSOLE_LOG_LEVEL);
+}
+
+/**
+ * @brief 输出一行
+ */
+void BootConsole_Printf(uint16_t color, const char *fmt, ...) {
+  va_list args;
+
+  if (!s_active || !console_lock()) {
+    return;
+  }
+  if (s_active) {
+    va_start(args, fmt);
+    vsnprintf(s_fmt, sizeof(s_fmt), fmt, args);
+    va_end(args);
+    console_puts(color, s_fmt);
+  }
+  console_unlock();
+}
+
+/**
+ * @brief 控制台是否正在显示
+ */
+bool BootConsole_IsActive(void) { return s_active; }
+
+/**
+ * @brief 停止显示并恢复滚动起始行
+ */
+void BootConsole_Stop(void) {
+  if (!s_active) {
+    return;
+  }
+  log_set_sink(NULL, LOG_LEVEL_OFF);
+  // 等待正在输出的一行写完 (超时也停止，LVGL 刷新会覆盖残留内容)
+  bool locked = console_lock();
+  s_active = false;
+  if (s_hw_scroll) {
+    lcd_orient_vscroll_set(0);
+  }
+  if (locked) {
+    console_unlock();
+  }
+}
+
+#else /* BOOT_CONSOLE_ENABLE */
+
+void BootConsole_Init(void) {}
+void BootConsole_Printf(uint16_t color, const char *fmt, ...) {
+  (void)color;
+  (void)fmt;
+}
+bool BootConsole_IsActive(void) { return false; }
+void BootConsole_Stop(void) {}
+
+#endif /* BOOT_CONSOLE_ENABLE */
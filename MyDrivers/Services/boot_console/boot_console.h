@@ -0,0 +1,65 @@
+/**
+ ******************************************************************************
+ * @file    boot_console.h
+ * @brief   启动文字控制台头文件
+ * @details LCD 初始化完成到 LVGL 接管屏幕之间没有任何显示，启动阶段卡住
+ *          (外设无响应、Flash 识别失败等) 时只能接串口查看。控制台在这段
+ *          时间里直接用 lcd_show_line 逐行显示启动阶段耗时与警告以上级别
+ *          的日志：每行只设置一次窗口，按行连续写入像素，不经过 LVGL。
+ *          屏幕写满后，控制器支持垂直硬件滚动时移动滚动起始行 (整屏上移
+ *          一行，只重绘新的一行)，否则回到首行覆盖并清空下一行。
+ *          字体只有 ASCII，中文等非 ASCII 字符显示为 '?'。
+ *          LVGL 创建第一个屏幕前调用 BootConsole_Stop，恢复滚动起始行后
+ *          由 LVGL 刷新覆盖整屏。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __BOOT_CONSOLE_H
+#define __BOOT_CONSOLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define BOOT_CONSOLE_ENABLE 1         // 0: 所有接口为空操作
+#define BOOT_CONSOLE_FONT 16          // 字体大小 (12/16/24/32)，即行高
+#define BOOT_CONSOLE_BG 0x0000        // 背景色 (黑)
+#define BOOT_CONSOLE_LOG_LEVEL LOG_LEVEL_WARN // 转发到控制台的最低日志级别
+#define BOOT_CONSOLE_LOCK_MS 50       // 等待控制台的最长时间，超时丢弃该行
+
+/* --------------------------- 公共接口 --------------------------- */
+
+/**
+ * @brief 清屏并开始显示 (LCD 初始化之后调用)
+ */
+void BootConsole_Init(void);
+
+/**
+ * @brief 输出一行 (过长时折行，'\n' 换行)
+ * @param color 文字颜色 (RGB565)
+ * @param fmt   格式串
+ * @note 只能在任务中调用；控制台未开始或已停止时直接返回
+ */
+void BootConsole_Printf(uint16_t color, const char *fmt, ...);
+
+/**
+ * @brief 控制台是否正在显示
+ */
+bool BootConsole_IsActive(void);
+
+/**
+ * @brief 停止显示并恢复滚动起始行 (LVGL 接管屏幕之前调用)
+ */
+void BootConsole_Stop(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_CONSOLE_H */
@@ -0,0 +1,164 @@
+/**
+ ******************************************************************************
+ * @file    boot_graph.c
+ * @brief   启动阶段依赖图实现
+ * @details 阶段完成状态保存在事件组中 (每个阶段一位)。工作任务在临界区内
+ *          领取依赖已满足的阶段，没有可领取的阶段时等待任一未结束的阶段
+ *          结束后重新检查；本类型的阶段都已被领取时工作任务返回。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "boot_graph.h"
+#include "FreeRTOS.h"
+#include "boot_console.h"
+#include "event_groups.h"
+#include "main.h"
+#include "task.h"
+
+/* --------------------------- 调试配置 --------------------------- */
+#define LOG_MODULE "BOOT"
+#include "log.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+static const BootStage_t *s_stages;
+static uint8_t s_count;
+static uint8_t s_finished; // 已结束的阶段数
+static uint32_t s_all;     // 全部阶段的位掩码
+static BootStageInfo_t s_info[BOOT_GRAPH_MAX_STAGES];
+static EventGroupHandle_t s_done;
+static StaticEventGroup_t s_done_buf;
+
+/* --------------------------- 私有函数实现 --------------------------- */
+
+/**
+ * @brief 领取一个依赖已完成的阶段
+ * @param done    已结束的阶段
+ * @param pending 输出本类型尚未领取的阶段
+ * @return 阶段编号，暂时没有可领取的阶段时返回 -1
+ */
+static int boot_graph_claim(BootWorker_t worker, uint32_t done,
+                            uint32_t *pending) {
+  int id = -1;
+
+  *pending = 0;
+  taskENTER_CRITICAL();
+  for (uint8_t i = 0; i < s_count; i++) {
+    if (s_stages[i].worker != worker || s_info[i].state != BOOT_STAGE_PENDING) {
+      continue;
+    }
+    *pending |= BOOT_BIT(i);
+    if (id < 0 && (s_stages[i].deps & ~done) == 0) {
+      s_info[i].state = BOOT_STAGE_RUNNING;
+      id = i;
+    }
+  }
+  taskEXIT_CRITICAL();
+  return id;
+}
+
+/**
+ * @brief 执行一个阶段并记录耗时
+ */
+static void boot_graph_run(uint8_t id) {
+  const BootStage_t *stage = &s_stages[id];
+  BootStageInfo_t *info = &s_info[id];
+  bool ok;
+  bool last;
+
+  info->start_ms = HAL_GetTick();
+  ok = stage->run();
+  info->end_ms = HAL_GetTick();
+
+  taskENTER_CRITICAL();
+  info->state = ok ? BOOT_STAGE_DONE : BOOT_STAGE_FAILED;
+  last = (++s_finished == s_count);
+  taskEXIT_CRITICAL();
+
+  if (ok) {
+    LOG_INFO("阶段 %-8s %4lu ms (%lu ~ %lu ms)", stage->name,
+             (unsigned long)(info->end_ms - info->start_ms),
+             (unsigned long)info->start_ms, (unsigned long)info->end_ms);
+  } else {
+    LOG_ERROR("阶段 %-8s 失败 %4lu ms (%lu ~ %lu ms)", stage->name,
+              (unsigned long)(info->end_ms - info->start_ms),
+              (unsigned long)info->start_ms, (unsigned long)info->end_ms);
+  }
+  // 启动控制台只有 ASCII 字体，单独输出一行英文
+  BootConsole_Printf(ok ? 0xFFFF : 0xF800, "%-9s %-4s %4lu ms", stage->name,
+                     ok ? "OK" : "FAIL",
+                     (unsigned long)(info->end_ms - info->start_ms));
+  if (last) {
+    LOG_INFO("启动完成: %u 个阶段，上电后 %lu ms", s_count,
+             (unsigned long)info->end_ms);
+  }
+
+  xEventGroupSetBits(s_done, BOOT_BIT(id));
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 设置阶段表
+ */
+void BootGraph_Init(const BootStage_t *stages, uint8_t count) {
+  if (count > BOOT_GRAPH_MAX_STAGES) {
+    count = BOOT_GRAPH_MAX_STAGES;
+  }
+  s_stages = stages;
+  s_count = count;
+  s_all = BOOT_BIT(count) - 1U;
+  s_done = xEventGroupCreateStatic(&s_done_buf);
+}
+
+/**
+ * @brief 作为工作任务执行阶段
+ */
+void BootGraph_RunWorker(BootWorker_t worker) {
+  for (;;) {
+    uint32_t done = xEventGroupGetBits(s_done) & s_all;
+    uint32_t pending;
+    int id = boot_graph_claim(worker, done, &pending);
+
+    if (id >= 0) {
+      boot_graph_run((uint8_t)id);
+      continue;
+    }
+    if (pending == 0) {
+      return;
+    }
+    // 读取之后才结束的阶段其位已置位，等待会立即返回，不会漏掉
+    xEventGroupWaitBits(s_done, s_all & ~done, pdFALSE, pdFALSE,
+                        portMAX_DELAY);
+  }
+}
+
+/**
+ * @brief 阶段是否都已结束
+ */
+bool BootGraph_IsDone(uint32_t mask) {
+  return s_done != NULL && (xEventGroupGetBits(s_done) & mask) == mask;
+}
+
+/**
+ * @brief 已结束的阶段数与总数
+ */
+void BootGraph_GetProgress(uint8_t *done, uint8_t *total) {
+  *done = s_finished;
+  *total = s_count;
+}
+
+/**
+ * @brief 获取阶段名称与运行记录
+ */
+bool BootGraph_GetStage(uint8_t id, const char **name, BootStageInfo_t *info) {
+  if (id >= s_count) {
+    return false;
+  }
+  *name = s_stages[id].name;
+  taskENTER_CRITICAL();
+  *info = s_info[id];
+  taskEXIT_CRITICAL();
+  return true;
+}
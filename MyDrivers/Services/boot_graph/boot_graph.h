@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ * @file    boot_graph.h
+ * @brief   启动阶段依赖图头文件
+ * @details 启动过程描述为一张阶段表：每个阶段给出初始化函数、依赖的阶段
+ *          (位掩码) 以及由哪类工作任务执行。多个工作任务同时从表中领取
+ *          依赖已全部完成的阶段，互不依赖的阶段 (LCD 初始化、配置加载、
+ *          ADC 启动、传感器探测等) 因此并发执行；某个阶段在延时或等待外设时，
+ *          其他阶段继续运行。
+ *          LVGL 相关阶段只能由 LVGL 任务执行 (BOOT_WORKER_UI)，其余阶段
+ *          由任意通用工作任务执行 (BOOT_WORKER_ANY)。
+ *          每个阶段完成时记录起止时间并输出日志，供启动画面显示进度。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __BOOT_GRAPH_H
+#define __BOOT_GRAPH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define BOOT_GRAPH_MAX_STAGES 24 // 事件组可用的位数
+
+/* 阶段编号转换为依赖位掩码 */
+#define BOOT_BIT(id) (1UL << (id))
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 执行阶段的工作任务类型
+ */
+typedef enum {
+  BOOT_WORKER_UI = 0, // LVGL 任务 (LVGL 对象只能在该任务中创建)
+  BOOT_WORKER_ANY     // 通用工作任务
+} BootWorker_t;
+
+/**
+ * @brief 阶段状态
+ */
+typedef enum {
+  BOOT_STAGE_PENDING = 0, // 等待依赖完成
+  BOOT_STAGE_RUNNING,     // 正在执行
+  BOOT_STAGE_DONE,        // 已完成
+  BOOT_STAGE_FAILED       // 已执行但返回失败 (依赖它的阶段照常执行)
+} BootStageState_t;
+
+/**
+ * @brief 阶段描述 (常量表，下标即阶段编号)
+ */
+typedef struct {
+  const char *name;    // 名称 (日志与启动画面显示)
+  bool (*run)(void);   // 初始化函数，返回 false 表示失败
+  uint32_t deps;       // 依赖的阶段 (BOOT_BIT 组合)
+  BootWorker_t worker; // 执行者
+} BootStage_t;
+
+/**
+ * @brief 阶段运行记录
+ */
+typedef struct {
+  BootStageState_t state;
+  uint32_t start_ms; // 开始时刻 (上电后的 HAL_GetTick)
+  uint32_t end_ms;   // 结束时刻
+} BootStageInfo_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 设置阶段表
+ * @param stages 阶段表 (须常驻；依赖只能指向表中的阶段，不能成环)
+ * @param count  阶段数，不超过 BOOT_GRAPH_MAX_STAGES
+ * @note  在启动调度器之前调用
+ */
+void BootGraph_Init(const BootStage_t *stages, uint8_t count);
+
+/**
+ * @brief 作为工作任务执行阶段，直到没有该类型可领取的阶段
+ * @param worker 本任务的类型
+ * @note  可在多个任务中同时调用；依赖未完成时阻塞等待
+ */
+void BootGraph_RunWorker(BootWorker_t worker);
+
+/**
+ * @brief 阶段是否都已结束 (完成或失败)
+ * @param mask 阶段位掩码
+ */
+bool BootGraph_IsDone(uint32_t mask);
+
+/**
+ * @brief 已结束的阶段数与总数
+ */
+void BootGraph_GetProgress(uint8_t *done, uint8_t *total);
+
+/**
+ * @brief 获取阶段名称与运行记录
+ * @return 编号无效时返回 false
+ */
+bool BootGraph_GetStage(uint8_t id, const char **name, BootStageInfo_t *info);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __BOOT_GRAPH_H */
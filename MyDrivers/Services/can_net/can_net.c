@@ -0,0 +1,378 @@
+/**
+ ******************************************************************************
+ * @file    can_net.c
+ * @brief   CAN 传感器网络源文件
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "can_net.h"
+#include "can_bus.h"
+#include "sensor_event_bus.h"
+#include "sensor_remote.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_MODULE "CANNET"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define CAN_NET_NODE_MASK 0x7F8U      // 过滤器掩码：帧类型与节点号须一致
+#define CAN_NET_FLAG_VALID 0x01U      // 标志位：传感器在线且样本有效
+#define CAN_NET_LOOP_MS 1000          // 没有事件时检查心跳与离线的间隔
+#define CAN_NET_RETRY_MS 5            // 发送邮箱全满时的重试间隔
+
+/* --------------------------- 私有类型 --------------------------- */
+
+/**
+ * @brief 本机广播的一个传感器
+ */
+typedef struct {
+  SensorHandle_t handle; // 本机实例句柄
+  CanBus_Frame_t frame;  // 最近一帧 (心跳时原样重发)
+  uint8_t seq;           // 样本序号
+  bool ready;            // frame 已有内容
+  bool pending;          // 待发送
+  bool heartbeat;        // 待发送的是心跳
+  TickType_t sent_tick;  // 最近一次发出的时刻
+} can_net_local_t;
+
+/**
+ * @brief 一个导入的远端实例
+ */
+typedef struct {
+  uint8_t node;          // 远端节点号
+  uint8_t slot;          // 远端槽位
+  uint8_t handle;        // 远端句柄 (槽位改变类型时不再接收)
+  bool online;           // 在离线超时内收到过帧
+  TickType_t rx_tick;    // 最近一次收到帧的时刻
+} can_net_map_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static StaticTask_t s_task_tcb;
+static StackType_t s_task_stack[CAN_NET_TASK_STACK_SIZE];
+static TaskHandle_t s_task = NULL;
+static SensorEventSub_t s_sub = -1;
+
+static can_net_local_t s_local[CAN_NET_MAX_SLOTS];
+static uint8_t s_local_count = 0;
+
+static SensorRemote_t s_remotes[CAN_NET_MAX_REMOTES];
+static can_net_map_t s_map[CAN_NET_MAX_REMOTES];
+static uint8_t s_remote_count = 0;
+
+static CanNetStats_t s_stats;
+
+/* --------------------------- 本机广播 --------------------------- */
+
+/**
+ * @brief 按注册顺序为新出现的本机传感器分配槽位 (远端实例不再转发)
+ */
+static void can_net_refresh_locals(void) {
+  uint8_t count = SensorTask_GetSensorCount();
+
+  for (uint8_t i = 0; i < count && s_local_count < CAN_NET_MAX_SLOTS; i++) {
+    SensorHandle_t handle = SensorTask_GetHandleAt(i);
+    bool known = false;
+
+    if (handle == SENSOR_HANDLE_INVALID || SensorTask_IsRemote(handle)) {
+      continue;
+    }
+    for (uint8_t s = 0; s < s_local_count; s++) {
+      if (s_local[s].handle == handle) {
+        known = true;
+        break;
+      }
+    }
+    if (!known) {
+      can_net_local_t *local = &s_local[s_local_count];
+
+      memset(local, 0, sizeof(*local));
+      local->handle = handle;
+      local->frame.id = CAN_NET_ID(CAN_NET_NODE_ID, s_local_count);
+      local->frame.len = 8;
+      local->frame.data[0] = handle;
+      s_local_count++;
+    }
+  }
+}
+
+static can_net_local_t *can_net_find_local(SensorHandle_t handle) {
+  for (uint8_t s = 0; s < s_local_count; s++) {
+    if (s_local[s].handle == handle) {
+      return &s_local[s];
+    }
+  }
+  return NULL;
+}
+
+/**
+ * @brief 按传感器事件更新对应槽位的帧
+ */
+static void can_net_apply_snapshot(const SensorSnapshot_t *snapshot) {
+  const SensorEvent_t *event = &snapshot->event;
+  can_net_local_t *local = can_net_find_local(event->sensor);
+  uint8_t *data;
+
+  if (local == NULL) {
+    if (SensorTask_IsRemote(event->sensor)) {
+      return;
+    }
+    can_net_refresh_locals();
+    local = can_net_find_local(event->sensor);
+    if (local == NULL) {
+      return; // 槽位已满
+    }
+  }
+  data = local->frame.data;
+
+  if (event->event_type == SENSOR_EVENT_DATA_UPDATE && event->data.is_valid &&
+      event->status == SENSOR_STATUS_ONLINE) {
+    local->seq++;
+    data[1] = CAN_NET_FLAG_VALID;
+    for (uint8_t ch = 0; ch < 2; ch++) {
+      uint16_t v = ch < snapshot->channel_count ? (uint16_t)snapshot->fixed[ch]
+                                                : 0;
+      data[2 + ch * 2] = (uint8_t)(v >> 8);
+      data[3 + ch * 2] = (uint8_t)v;
+    }
+    data[6] = local->seq;
+    data[7] = snapshot->channel_count > 2 ? 2 : snapshot->channel_count;
+  } else if (event->status != SENSOR_STATUS_ONLINE ||
+             (event->event_type == SENSOR_EVENT_DATA_UPDATE &&
+              !event->data.is_valid)) {
+    if (local->ready && (data[1] & CAN_NET_FLAG_VALID) == 0) {
+      return; // 已经广播过无效状态
+    }
+    data[1] = 0;
+  } else {
+    return; // 恢复在线：等下一个样本
+  }
+  local->ready = true;
+  local->pending = true;
+  local->heartbeat = false;
+}
+
+/**
+ * @brief 发出待发送的帧，到期的槽位重发心跳
+ * @return true: 仍有帧因发送邮箱全满而未发出
+ */
+static bool can_net_flush(TickType_t now) {
+  bool blocked = false;
+
+  for (uint8_t s = 0; s < s_local_count; s++) {
+    can_net_local_t *local = &s_local[s];
+
+    if (!local->ready) {
+      continue;
+    }
+    if (!local->pending &&
+        now - local->sent_tick >= pdMS_TO_TICKS(CAN_NET_HEARTBEAT_MS)) {
+      local->pending = true;
+      local->heartbeat = true;
+    }
+    if (!local->pending || blocked) {
+      continue;
+    }
+    if (!CanBus_Send(&local->frame)) {
+      s_stats.send_retries++;
+      blocked = true; // 三个邮箱都满：其余槽位也留到下一轮
+      continue;
+    }
+    if (local->heartbeat) {
+      s_stats.heartbeats_sent++;
+    } else {
+      s_stats.frames_sent++;
+    }
+    local->pending = false;
+    local->sent_tick = now;
+  }
+  return blocked;
+}
+
+/* --------------------------- 远端导入 --------------------------- */
+
+/**
+ * @brief 查找或导入 (节点, 槽位) 对应的远端实例
+ * @return 下标，失败返回 -1
+ */
+static int8_t can_net_find_remote(uint8_t node, uint8_t slot, uint8_t handle) {
+  SensorType_t type = SENSOR_HANDLE_TYPE(handle);
+  char name[SENSOR_REMOTE_NAME_MAX];
+
+  for (uint8_t i = 0; i < s_remote_count; i++) {
+    if (s_map[i].node == node && s_map[i].slot == slot) {
+      // 远端重新排列了传感器：保留原实例直到重启
+      return s_map[i].handle == handle ? (int8_t)i : -1;
+    }
+  }
+  if (type == SENSOR_TYPE_NONE || type >= SENSOR_TYPE_MAX ||
+      s_remote_count >= CAN_NET_MAX_REMOTES) {
+    return -1;
+  }
+  snprintf(name, sizeof(name), "%s #%u", SensorType_ToString(type),
+           (unsigned)node);
+  if (SensorRemote_Attach(&s_remotes[s_remote_count], type, name,
+                          CAN_NET_REMOTE_POLL_MS) == SENSOR_HANDLE_INVALID) {
+    return -1;
+  }
+  s_map[s_remote_count].node = node;
+  s_map[s_remote_count].slot = slot;
+  s_map[s_remote_count].handle = handle;
+  s_map[s_remote_count].online = false;
+  LOG_INFO("导入节点 %u 的 %s", (unsigned)node, SensorType_ToString(type));
+  return (int8_t)s_remote_count++;
+}
+
+/**
+ * @brief 处理一帧收到的传感器帧
+ */
+static void can_net_receive(const CanBus_Frame_t *frame, TickType_t now) {
+  uint8_t node = CAN_NET_ID_NODE(frame->id);
+  int16_t fixed[SENSOR_MAX_CHANNELS] = {0};
+  uint8_t count;
+  int8_t index;
+
+  if (frame->len != 8 || node == CAN_NET_NODE_ID) {
+    s_stats.frames_ignored++;
+    return;
+  }
+  index = can_net_find_remote(node, CAN_NET_ID_SLOT(frame->id), frame->data[0]);
+  if (index < 0) {
+    s_stats.frames_ignored++;
+    return;
+  }
+  s_stats.frames_received++;
+
+  count = frame->data[7] > 2 ? 2 : frame->data[7];
+  for (uint8_t ch = 0; ch < count && ch < SENSOR_MAX_CHANNELS; ch++) {
+    fixed[ch] = (int16_t)(((uint16_t)frame->data[2 + ch * 2] << 8) |
+                          frame->data[3 + ch * 2]);
+  }
+  SensorRemote_Update(&s_remotes[index],
+                      (frame->data[1] & CAN_NET_FLAG_VALID) != 0,
+                      frame->data[6], fixed, count);
+  s_map[index].online = true;
+  s_map[index].rx_tick = now;
+}
+
+/**
+ * @brief 超时没有收到帧的远端实例转为离线
+ */
+static void can_net_check_offline(TickType_t now) {
+  uint8_t online = 0;
+
+  for (uint8_t i = 0; i < s_remote_count; i++) {
+    if (s_map[i].online &&
+        now - s_map[i].rx_tick >= pdMS_TO_TICKS(CAN_NET_OFFLINE_MS)) {
+      s_map[i].online = false;
+      SensorRemote_SetOffline(&s_remotes[i]);
+      LOG_WARN("节点 %u 槽位 %u 离线", (unsigned)s_map[i].node,
+               (unsigned)s_map[i].slot);
+    }
+    online += s_map[i].online ? 1 : 0;
+  }
+  s_stats.remotes = s_remote_count;
+  s_stats.remotes_online = online;
+}
+
+/* --------------------------- 任务 --------------------------- */
+
+/**
+ * @brief 有新的传感器事件 (传感器任务上下文)
+ */
+static void can_net_event_notify(void) {
+  if (s_task != NULL) {
+    xTaskNotifyGive(s_task);
+  }
+}
+
+/**
+ * @brief 网络任务：收到帧或传感器事件时唤醒，定时检查心跳与离线
+ */
+static void can_net_task(void *argument) {
+  bool blocked = false;
+  (void)argument;
+
+  for (;;) {
+    const SensorSnapshot_t *snapshot;
+    CanBus_Frame_t frame;
+    TickType_t now;
+
+    (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(blocked ? CAN_NET_RETRY_MS
+                                                         : CAN_NET_LOOP_MS));
+    now = xTaskGetTickCount();
+
+    while (CanBus_Receive(&frame)) {
+      can_net_receive(&frame, now);
+    }
+
+    while ((snapshot = SensorEventBus_Receive(s_sub, 0)) != NULL) {
+      can_net_apply_snapshot(snapshot);
+      SensorEventBus_Release(snapshot);
+    }
+
+    blocked = can_net_flush(now);
+    can_net_check_offline(now);
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化
+ */
+bool CanNet_Init(void) {
+  uint8_t filters = 0;
+
+  if (s_task != NULL) {
+    return true;
+  }
+  if (CAN_NET_NODE_ID == 0 || CAN_NET_NODE_ID > 31) {
+    LOG_ERROR("节点号 %u 无效", (unsigned)CAN_NET_NODE_ID);
+    return false;
+  }
+
+  can_net_refresh_locals();
+  s_sub = SensorEventBus_Subscribe("can", can_net_event_notify);
+  if (s_sub < 0) {
+    LOG_ERROR("订阅传感器事件失败");
+    return false;
+  }
+
+  s_task = xTaskCreateStatic(can_net_task, "can", CAN_NET_TASK_STACK_SIZE,
+                             NULL, CAN_NET_TASK_PRIORITY, s_task_stack,
+                             &s_task_tcb);
+  if (!CanBus_Init(CAN_NET_BITRATE, s_task)) {
+    return false;
+  }
+
+  // 每个订阅的节点一条过滤器，其他节点的帧由硬件丢弃
+  for (uint8_t node = 1; node <= 31; node++) {
+    if (node == CAN_NET_NODE_ID || ((CAN_NET_SUBSCRIBE >> node) & 1U) == 0) {
+      continue;
+    }
+    if (!CanBus_AddFilter(CAN_NET_ID(node, 0), CAN_NET_NODE_MASK, 0)) {
+      LOG_WARN("过滤器已用完，不再订阅节点 %u 及之后的节点", (unsigned)node);
+      break;
+    }
+    filters++;
+  }
+
+  LOG_INFO("CAN 网络已启动: 节点 %u, 广播 %u 个传感器, 订阅 %u 个节点",
+           (unsigned)CAN_NET_NODE_ID, (unsigned)s_local_count,
+           (unsigned)filters);
+  return true;
+}
+
+/**
+ * @brief 获取网络统计
+ */
+void CanNet_GetStats(CanNetStats_t *stats) {
+  taskENTER_CRITICAL();
+  *stats = s_stats;
+  taskEXIT_CRITICAL();
+}
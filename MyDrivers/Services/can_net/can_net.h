@@ -0,0 +1,93 @@
+/**
+ ******************************************************************************
+ * @file    can_net.h
+ * @brief   CAN 传感器网络 (节点间传感器帧广播与订阅)
+ * @details 每个节点把本机传感器的每个新样本以一帧固定 ID 的标准帧广播，
+ *          订阅的节点经硬件验收过滤器只收到关心的节点发出的帧，导入为
+ *          本机的远端传感器实例 (见 sensor_remote.h)，不需要主站轮询，
+ *          多节点汇聚的延迟由总线仲裁决定，与节点数无关。
+ *
+ *          帧 ID (11 位)：[10:8] 帧类型 (CAN_NET_CLASS_SENSOR)，
+ *                         [7:3] 节点号 (1~31)，[2:0] 传感器槽位 (本机注册顺序)
+ *          数据 (8 字节，16 位量高字节在前)：
+ *            0 句柄 (低 4 位类型，高 4 位序号)  1 标志 (bit0 传感器在线且样本有效)
+ *            2~3 通道 0 定点值   4~5 通道 1 定点值
+ *            6 样本序号 (每个新样本加 1)      7 通道数
+ *          样本之间每 CAN_NET_HEARTBEAT_MS 重发最近一帧 (序号不变) 作为心跳，
+ *          超过 CAN_NET_OFFLINE_MS 没有收到某个远端实例的帧即判定离线。
+ *          同一总线上每个节点须配置不同的 CAN_NET_NODE_ID。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __CAN_NET_H
+#define __CAN_NET_H
+
+#include "task_plan.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#ifndef CAN_NET_NODE_ID
+#define CAN_NET_NODE_ID 0               // 本机节点号 (1~31，0 不启用 CAN 网络)
+#endif
+#ifndef CAN_NET_SUBSCRIBE
+#define CAN_NET_SUBSCRIBE 0x00000000UL  // 订阅的节点位图 (bit n 为节点 n)，0 只发送
+#endif
+#ifndef CAN_NET_BITRATE
+#define CAN_NET_BITRATE 250000          // 波特率 (工业现场长线缆取 250 kbps)
+#endif
+#define CAN_NET_CLASS_SENSOR 1          // 传感器帧类型 (ID 0x100~0x1FF)
+#define CAN_NET_MAX_SLOTS 8             // 每个节点广播的传感器数上限 (ID 低 3 位)
+#define CAN_NET_MAX_REMOTES 8           // 远端实例总数上限 (另受注册表容量限制)
+#define CAN_NET_HEARTBEAT_MS 5000       // 没有新样本时重发最近一帧的间隔
+#define CAN_NET_OFFLINE_MS 15000        // 多久没有收到帧判定远端实例离线
+#define CAN_NET_REMOTE_POLL_MS 100      // 远端实例没有新样本时再次查看的间隔
+#define CAN_NET_TASK_STACK_SIZE 256     // 网络任务栈大小 (单位: 字)
+#define CAN_NET_TASK_PRIORITY TASK_PRIO_CAN
+
+/* 帧 ID 组成 */
+#define CAN_NET_ID(node, slot)                                                 \
+  ((uint16_t)((CAN_NET_CLASS_SENSOR << 8) | ((node) << 3) | (slot)))
+#define CAN_NET_ID_NODE(id) ((uint8_t)(((id) >> 3) & 0x1FU))
+#define CAN_NET_ID_SLOT(id) ((uint8_t)((id) & 0x07U))
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 网络统计
+ */
+typedef struct {
+  uint32_t frames_sent;     // 发出的样本帧
+  uint32_t heartbeats_sent; // 发出的心跳帧
+  uint32_t send_retries;    // 发送邮箱全满、顺延到下一轮的次数
+  uint32_t frames_received; // 收到的样本帧 (含心跳)
+  uint32_t frames_ignored;  // 格式不符或远端实例已满而忽略的帧
+  uint8_t remotes;          // 已导入的远端实例数
+  uint8_t remotes_online;   // 当前在线的远端实例数
+} CanNetStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化 CAN1、按订阅位图配置验收过滤器、订阅传感器事件并启动任务
+ * @note  须在传感器系统初始化之后调用
+ * @return false: 未配置节点号、资源不足或 CAN 初始化失败
+ */
+bool CanNet_Init(void);
+
+/**
+ * @brief 获取网络统计
+ */
+void CanNet_GetStats(CanNetStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CAN_NET_H */
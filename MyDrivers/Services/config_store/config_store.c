@@ -0,0 +1,385 @@
+/**
+ ******************************************************************************
+ * @file    config_store.c
+ * @brief   设备配置存储服务实现
+ * @details 存储区格式:
+ *            区头  [魔数 | 布局版本 | 代数(小端 2 字节) | CRC-8]
+ *            记录  [键 | 值 (按键长度) | CRC-8(代数, 键, 值)]
+ *          从区头之后顺序解析，遇到未知键或 CRC 错误即为日志末尾，
+ *          新记录从该位置继续追加 (覆盖写了一半的记录)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "config_store.h"
+#include "24cxx.h"
+#include "checksum.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include "task_plan.h"
+#include <string.h>
+
+#define LOG_MODULE "CONFIG"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define CONFIG_STORE_MAGIC 0xC5
+#define CONFIG_HEADER_LEN 5
+#define CONFIG_RECORD_MAX (CONFIG_STORE_VALUE_MAX + 2)
+
+/* --------------------------- 私有变量 --------------------------- */
+static const uint8_t s_key_size[CONFIG_KEY_MAX] = {
+    3, 3, 3, // LED 槽位颜色
+    1,       // LED 亮度
+    1,       // LED 模式
+    1,       // 电机模式
+    4, 4, 4, // 传感器采样间隔
+    4,       // 串口波特率
+    4,       // 遥测送达游标
+    1,       // 屏幕方向
+    1,       // 渲染档位
+    4, 4,    // 电阻屏校准 X/Y
+    4,       // 传感器滤波配置
+};
+
+/* 影子副本 (由临界区保护，读写都很短) */
+static uint8_t s_value[CONFIG_KEY_MAX][CONFIG_STORE_VALUE_MAX];
+static uint32_t s_present; // 已保存过的键 (位图)
+static uint32_t s_dirty;   // 等待写入的键 (位图)
+static uint32_t s_first_dirty_tick;
+static uint32_t s_last_set_tick;
+static volatile bool s_flush_requested; // 下一次 Process 不等待合并时间
+
+/* 当前存储区，只在持有 s_mutex 时修改 */
+static uint8_t s_bank;
+static uint16_t s_generation;
+static uint8_t s_write_pos;
+static ConfigStoreStats_t s_stats;
+
+static SemaphoreHandle_t s_mutex = NULL;
+static StaticSemaphore_t s_mutex_buf;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static uint16_t config_bank_addr(uint8_t bank) {
+  return CONFIG_STORE_EEPROM_ADDR + (uint16_t)bank * CONFIG_STORE_BANK_SIZE;
+}
+
+static uint8_t config_record_crc(uint16_t generation, const uint8_t *record,
+                                 uint8_t len) {
+  uint8_t gen[2] = {(uint8_t)generation, (uint8_t)(generation >> 8)};
+  return CRC8_Update(CRC8_Update(CRC8_INIT, gen, 2), record, len);
+}
+
+/**
+ * @brief 解析区头
+ * @return true: 区头有效
+ */
+static bool config_parse_header(const uint8_t *buf, uint16_t *generation) {
+  if (buf[0] != CONFIG_STORE_MAGIC || buf[1] != CONFIG_STORE_LAYOUT_VERSION ||
+      CRC8_Compute(buf, CONFIG_HEADER_LEN - 1) != buf[CONFIG_HEADER_LEN - 1]) {
+    return false;
+  }
+  *generation = (uint16_t)(buf[2] | (buf[3] << 8));
+  return true;
+}
+
+/**
+ * @brief 组装一条记录
+ * @return 记录长度
+ */
+static uint8_t config_build_record(uint8_t *rec, uint16_t generation,
+                                   ConfigKey_t key, const uint8_t *value) {
+  uint8_t size = s_key_size[key];
+
+  rec[0] = (uint8_t)key;
+  memcpy(&rec[1], value, size);
+  rec[1 + size] = config_record_crc(generation, rec, 1 + size);
+  return size + 2;
+}
+
+/**
+ * @brief 写入并回读校验
+ */
+static bool config_write_verify(uint16_t addr, const uint8_t *data,
+                                uint8_t len) {
+  uint8_t check[CONFIG_STORE_BANK_SIZE];
+
+  at24cxx_write(addr, data, len);
+  at24cxx_read(addr, check, len);
+  if (memcmp(check, data, len) != 0) {
+    s_stats.errors++;
+    LOG_WARN("EEPROM 写入校验失败 (地址 %u)", addr);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief 把所有已保存键的当前值写入另一个存储区，最后写区头
+ * @param values 影子副本快照
+ * @param present 快照中的有效键
+ */
+static bool config_compact(uint8_t (*values)[CONFIG_STORE_VALUE_MAX],
+                           uint32_t present) {
+  uint8_t buf[CONFIG_STORE_BANK_SIZE];
+  uint8_t target = s_bank ^ 1;
+  uint16_t generation = s_generation + 1;
+  uint8_t pos = CONFIG_HEADER_LEN;
+
+  for (int key = 0; key < CONFIG_KEY_MAX; key++) {
+    if (present & (1UL << key)) {
+      pos += config_build_record(&buf[pos], generation, (ConfigKey_t)key,
+                                 values[key]);
+    }
+  }
+
+  /* 先写记录，区头最后写：区头写完之前掉电，上电后仍使用旧存储区 */
+  if (pos > CONFIG_HEADER_LEN &&
+      !config_write_verify(config_bank_addr(target) + CONFIG_HEADER_LEN,
+                           &buf[CONFIG_HEADER_LEN], pos - CONFIG_HEADER_LEN)) {
+    return false;
+  }
+  buf[0] = CONFIG_STORE_MAGIC;
+  buf[1] = CONFIG_STORE_LAYOUT_VERSION;
+  buf[2] = (uint8_t)generation;
+  buf[3] = (uint8_t)(generation >> 8);
+  buf[4] = CRC8_Compute(buf, CONFIG_HEADER_LEN - 1);
+  if (!config_write_verify(config_bank_addr(target), buf, CONFIG_HEADER_LEN)) {
+    return false;
+  }
+
+  s_bank = target;
+  s_generation = generation;
+  s_write_pos = pos;
+  s_stats.compactions++;
+  LOG_INFO("配置压缩到存储区 %u (代数 %u, %u 字节)", target, generation, pos);
+  return true;
+}
+
+/**
+ * @brief 解析存储区中的日志，建立影子副本
+ */
+static void config_load_bank(const uint8_t *buf) {
+  uint8_t pos = CONFIG_HEADER_LEN;
+
+  while (pos < CONFIG_STORE_BANK_SIZE) {
+    uint8_t key = buf[pos];
+    uint8_t size;
+
+    if (key >= CONFIG_KEY_MAX) {
+      break; // 未写过的区域 (0xFF) 或更新版本固件写入的键
+    }
+    size = s_key_size[key];
+    if (pos + size + 2 > CONFIG_STORE_BANK_SIZE ||
+        config_record_crc(s_generation, &buf[pos], size + 1) !=
+            buf[pos + size + 1]) {
+      break; // 写了一半或属于旧代数的记录
+    }
+    memcpy(s_value[key], &buf[pos + 1], size);
+    s_present |= 1UL << key;
+    pos += size + 2;
+  }
+  s_write_pos = pos;
+}
+
+/* --------------------------- 公共函数 --------------------------- */
+
+/**
+ * @brief 初始化：读取 EEPROM 并建立影子副本
+ */
+bool ConfigStore_Init(void) {
+  uint8_t buf[2][CONFIG_STORE_BANK_SIZE];
+  uint16_t generation[2];
+  bool valid[2];
+
+  if (s_mutex == NULL) {
+    s_mutex = xSemaphoreCreateMutexStatic(&s_mutex_buf);
+    TaskPlan_WatchMutex(s_mutex, "config", 100); // 整条记录逐页写入 EEPROM
+  }
+  at24cxx_init();
+
+  /* 两个存储区连续存放，一次读出 */
+  at24cxx_read(CONFIG_STORE_EEPROM_ADDR, buf[0], sizeof(buf));
+  valid[0] = config_parse_header(buf[0], &generation[0]);
+  valid[1] = config_parse_header(buf[1], &generation[1]);
+
+  s_present = 0;
+  s_dirty = 0;
+  if (!valid[0] && !valid[1]) {
+    /* 无有效数据：让第一次写入直接压缩到存储区 0 */
+    s_bank = 1;
+    s_generation = 0;
+    s_write_pos = CONFIG_STORE_BANK_SIZE;
+    LOG_INFO("EEPROM 中没有有效配置，使用默认值");
+    return false;
+  }
+
+  /* 两个都有效时取代数较新的 (按 16 位回绕比较) */
+  if (valid[0] && valid[1]) {
+    s_bank = ((int16_t)(generation[1] - generation[0]) > 0) ? 1 : 0;
+  } else {
+    s_bank = valid[1] ? 1 : 0;
+  }
+  s_generation = generation[s_bank];
+  config_load_bank(buf[s_bank]);
+
+  LOG_INFO("配置已加载: 存储区 %u, 代数 %u, 已用 %u 字节", s_bank, s_generation,
+           s_write_pos);
+  return true;
+}
+
+/**
+ * @brief 读取配置
+ */
+bool ConfigStore_Get(ConfigKey_t key, void *value, uint8_t len) {
+  bool found;
+
+  if (key >= CONFIG_KEY_MAX || value == NULL || len != s_key_size[key]) {
+    return false;
+  }
+
+  taskENTER_CRITICAL();
+  found = (s_present & (1UL << key)) != 0;
+  if (found) {
+    memcpy(value, s_value[key], len);
+  }
+  taskEXIT_CRITICAL();
+  return found;
+}
+
+/**
+ * @brief 修改配置
+ */
+bool ConfigStore_Set(ConfigKey_t key, const void *value, uint8_t len) {
+  uint32_t now = HAL_GetTick();
+  uint32_t bit;
+
+  if (key >= CONFIG_KEY_MAX || value == NULL || len != s_key_size[key]) {
+    return false;
+  }
+  bit = 1UL << key;
+
+  taskENTER_CRITICAL();
+  /* 与已保存的值相同则不产生写入 */
+  if (!(s_present & bit) || memcmp(s_value[key], value, len) != 0) {
+    memcpy(s_value[key], value, len);
+    s_present |= bit;
+    if (s_dirty == 0) {
+      s_first_dirty_tick = now;
+    }
+    s_dirty |= bit;
+    s_last_set_tick = now;
+  }
+  taskEXIT_CRITICAL();
+  return true;
+}
+
+/**
+ * @brief 后台处理
+ */
+void ConfigStore_Process(void) {
+  uint32_t now = HAL_GetTick();
+  bool due;
+
+  taskENTER_CRITICAL();
+  due = s_dirty != 0 &&
+        (s_flush_requested ||
+         now - s_last_set_tick >= CONFIG_STORE_COALESCE_MS ||
+         now - s_first_dirty_tick >= CONFIG_STORE_MAX_DELAY_MS);
+  taskEXIT_CRITICAL();
+
+  if (due) {
+    ConfigStore_Flush();
+  }
+}
+
+/**
+ * @brief 请求尽快写入
+ */
+void ConfigStore_RequestFlush(void) { s_flush_requested = true; }
+
+/**
+ * @brief 立即写入所有脏数据
+ */
+bool ConfigStore_Flush(void) {
+  uint8_t values[CONFIG_KEY_MAX][CONFIG_STORE_VALUE_MAX];
+  uint32_t present;
+  uint32_t dirty;
+  bool ok = true;
+
+  if (s_mutex == NULL) {
+    return false; // 未初始化
+  }
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+
+  /* 取快照后清除脏标记，写入期间的新修改留到下一次 */
+  taskENTER_CRITICAL();
+  memcpy(values, s_value, sizeof(values));
+  present = s_present;
+  dirty = s_dirty;
+  s_dirty = 0;
+  s_flush_requested = false;
+  taskEXIT_CRITICAL();
+
+  for (int key = 0; key < CONFIG_KEY_MAX && dirty != 0; key++) {
+    uint8_t rec[CONFIG_RECORD_MAX];
+    uint8_t len;
+
+    if (!(dirty & (1UL << key))) {
+      continue;
+    }
+
+    len = config_build_record(rec, s_generation, (ConfigKey_t)key,
+                              values[key]);
+    if (s_write_pos + len > CONFIG_STORE_BANK_SIZE ||
+        !config_write_verify(config_bank_addr(s_bank) + s_write_pos, rec,
+                             len)) {
+      /* 写满或写坏 (日志会在此截断)：压缩后所有键都已写入 */
+      ok = config_compact(values, present);
+      dirty = 0;
+      break;
+    }
+    s_write_pos += len;
+    s_stats.appends++;
+    dirty &= ~(1UL << key);
+  }
+
+  if (!ok) {
+    /* 下次 (CONFIG_STORE_COALESCE_MS 之后) 重试完整压缩 */
+    taskENTER_CRITICAL();
+    s_dirty |= present;
+    s_first_dirty_tick = s_last_set_tick = HAL_GetTick();
+    taskEXIT_CRITICAL();
+  }
+
+  xSemaphoreGive(s_mutex);
+  return ok;
+}
+
+/**
+ * @brief 获取存储统计
+ */
+void ConfigStore_GetStats(ConfigStoreStats_t *stats) {
+  uint32_t dirty;
+
+  if (stats == NULL) {
+    return;
+  }
+
+  taskENTER_CRITICAL();
+  *stats = s_stats;
+  dirty = s_dirty;
+  stats->generation = s_generation;
+  stats->bank = s_bank;
+  stats->used = s_write_pos;
+  taskEXIT_CRITICAL();
+
+  stats->dirty_count = 0;
+  for (; dirty != 0; dirty &= dirty - 1) {
+    stats->dirty_count++;
+  }
+}
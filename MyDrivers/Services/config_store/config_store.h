@@ -0,0 +1,136 @@
+/**
+ ******************************************************************************
+ * @file    config_store.h
+ * @brief   设备配置存储服务 (24Cxx EEPROM)
+ * @details 以键值对保存需要掉电保持的设置 (LED 槽位颜色、亮度、电机模式、
+ *          传感器采样间隔等)：
+ *            - 上电时一次连续读取整个存储区，建立 RAM 影子副本，之后的读取
+ *              都只访问内存；
+ *            - 写入只修改影子副本并标记为脏，由后台 (监控任务) 在最后一次
+ *              修改 CONFIG_STORE_COALESCE_MS 之后合并写入，滑块拖动等连续
+ *              修改只产生一次 EEPROM 写入；
+ *            - EEPROM 中为只追加的日志，每条记录 [键 | 值 | CRC-8]，同一个键
+ *              以最后一条为准，写入位置在存储区内轮转以分散擦写次数；
+ *            - 日志写满时把所有键的当前值压缩写入另一个存储区，最后才写
+ *              新的区头 (代数 + 1)，中途掉电时旧存储区仍然完整。
+ *          记录的 CRC 包含所在存储区的代数，存储区复用后残留的旧记录不会
+ *          被误认为有效。
+ *          EEPROM 地址分配: 旧版触摸屏校准 40~52 (只在迁移时读取)，MQ-2 R0 64~72，
+ *          本服务 CONFIG_STORE_EEPROM_ADDR 起 2 * CONFIG_STORE_BANK_SIZE 字节，
+ *          末地址 255 为 at24cxx_check 的检测字节。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __CONFIG_STORE_H
+#define __CONFIG_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define CONFIG_STORE_EEPROM_ADDR 80    // 存储区起始地址 (页对齐)
+#define CONFIG_STORE_BANK_SIZE 84      // 每个存储区字节数，共两个 (压缩后全部键 83 字节)
+#define CONFIG_STORE_LAYOUT_VERSION 1  // 键定义不兼容变化时加 1，旧数据被丢弃
+#define CONFIG_STORE_VALUE_MAX 4       // 单个键值最大字节数
+#define CONFIG_STORE_COALESCE_MS 1000  // 最后一次修改后多久写入
+#define CONFIG_STORE_MAX_DELAY_MS 5000 // 持续修改时最长延迟
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 配置键 (只能在末尾追加；含义或长度变化时修改 LAYOUT_VERSION)
+ */
+typedef enum {
+  CONFIG_KEY_LED_SLOT1 = 0,  // RGB_Color，3 字节
+  CONFIG_KEY_LED_SLOT2,      // RGB_Color，3 字节
+  CONFIG_KEY_LED_SLOT3,      // RGB_Color，3 字节
+  CONFIG_KEY_LED_BRIGHTNESS, // uint8_t
+  CONFIG_KEY_LED_MODE,       // uint8_t (led_control_mode_t)
+  CONFIG_KEY_MOTOR_MODE,     // uint8_t (Motor_Control_Mode_t)
+  CONFIG_KEY_INTERVAL_GY30,  // uint32_t 采样间隔 (ms)，顺序与 SensorType_t 一致
+  CONFIG_KEY_INTERVAL_SHT30, // uint32_t
+  CONFIG_KEY_INTERVAL_SMOKE, // uint32_t
+  CONFIG_KEY_UART_BAUD,      // uint32_t 命令行串口波特率 (确认后才保存)
+  CONFIG_KEY_UPLINK_ACK,     // uint32_t 遥测上行送达游标 (日志时间)
+  CONFIG_KEY_DISPLAY_ROTATION, // uint8_t 屏幕方向 (lcd_rotation_t)
+  CONFIG_KEY_RENDER_PROFILE,   // uint8_t 渲染档位 (ui_render_profile_t)
+  CONFIG_KEY_TP_CAL_X,         // TpCalAxis_t 电阻屏 X 轴校准 (int16 增益 Q14 + int16 偏移)
+  CONFIG_KEY_TP_CAL_Y,         // TpCalAxis_t 电阻屏 Y 轴校准
+  CONFIG_KEY_SENSOR_FILTER,    // SensorFilterSpec_t[4] 各滤波槽位的配置
+  CONFIG_KEY_MAX
+} ConfigKey_t;
+
+/* 传感器类型 -> 采样间隔键 (SENSOR_TYPE_GY30 为 1) */
+#define CONFIG_KEY_SENSOR_INTERVAL(type)                                       \
+  ((ConfigKey_t)(CONFIG_KEY_INTERVAL_GY30 + (int)(type)-1))
+
+/**
+ * @brief 存储统计
+ */
+typedef struct {
+  uint16_t generation;  // 当前存储区代数
+  uint8_t bank;         // 当前存储区 (0/1)
+  uint8_t used;         // 当前存储区已用字节数
+  uint8_t dirty_count;  // 等待写入的键数
+  uint32_t appends;     // 上电以来追加的记录数
+  uint32_t compactions; // 上电以来的压缩次数
+  uint32_t errors;      // 写入校验失败次数
+} ConfigStoreStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化：读取 EEPROM 并建立影子副本
+ * @note  须在使用配置的模块 (设备管理器、传感器系统) 初始化之前调用
+ * @return true: 找到有效的存储区; false: 无有效数据 (全部使用默认值)
+ */
+bool ConfigStore_Init(void);
+
+/**
+ * @brief 读取配置 (只访问影子副本)
+ * @param len 必须等于该键的长度
+ * @return true: 已保存过该键; false: 未保存，调用方使用默认值
+ */
+bool ConfigStore_Get(ConfigKey_t key, void *value, uint8_t len);
+
+/**
+ * @brief 修改配置：更新影子副本并等待后台写入，不访问 EEPROM
+ * @param len 必须等于该键的长度
+ * @return false: 键或长度无效
+ */
+bool ConfigStore_Set(ConfigKey_t key, const void *value, uint8_t len);
+
+/**
+ * @brief 后台处理：脏数据空闲超过 CONFIG_STORE_COALESCE_MS 时写入
+ * @note  在低优先级任务中周期调用 (监控任务)，写入期间会阻塞数毫秒
+ */
+void ConfigStore_Process(void);
+
+/**
+ * @brief 请求在下一次 ConfigStore_Process() 时写入，不等待合并时间
+ * @note  不访问 EEPROM，可在 GUI 任务中调用 (如离开设置页面)
+ */
+void ConfigStore_RequestFlush(void);
+
+/**
+ * @brief 立即写入所有脏数据 (如关机、掉电预警前)
+ * @return true: 全部写入成功
+ */
+bool ConfigStore_Flush(void);
+
+/**
+ * @brief 获取存储统计
+ */
+void ConfigStore_GetStats(ConfigStoreStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CONFIG_STORE_H */
@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    crash_decode.py
+@brief   崩溃转储主机端解码器 (与 crash_dump.c 配套)
+@details 从串口流中按 0x00 分隔符取出 COBS 帧，校验 CRC-32 后按偏移拼出
+         备份 SRAM 中的记录，输出寄存器、故障原因位、栈内容与崩溃前的日志。
+         帧格式见 crash_dump.c；其他帧与文本日志被忽略。
+         串口模式下发送 crash 命令请求导出 (启动时自动导出的帧也能收到)。
+         给出 .axf 时用 arm-none-eabi-addr2line 把 pc/lr 与栈中的代码地址
+         换算为函数名。
+
+用法:
+    python crash_decode.py COM5 [-b 115200]
+    python crash_decode.py capture.bin
+    python crash_decode.py COM5 --axf EnviroSense.axf
+
+@author  MmsY
+@time    2025/11/23
+"""
+
+import argparse
+import struct
+import subprocess
+import sys
+import time
+import zlib
+
+FRAME_TYPE = 0x10
+MAGIC_NEW, MAGIC_SEEN = 0xDEADC0DE, 0xC0DEDEAD
+VERSION = 1
+STACK_WORDS = 64
+# magic version size crc reason uptime exc_return msp psp frame[8]
+# cfsr hfsr mmfar bfar task[16] stack_words log_len
+HEADER = struct.Struct("<IHHIIIIII8IIIII16sHH")
+REASONS = {1: "HardFault", 2: "stack overflow"}
+FRAME_REGS = ["r0", "r1", "r2", "r3", "r12", "lr", "pc", "xpsr"]
+CFSR_BITS = {
+    0: "IACCVIOL", 1: "DACCVIOL", 3: "MUNSTKERR", 4: "MSTKERR", 5: "MLSPERR",
+    7: "MMARVALID", 8: "IBUSERR", 9: "PRECISERR", 10: "IMPRECISERR",
+    11: "UNSTKERR", 12: "STKERR", 13: "LSPERR", 15: "BFARVALID",
+    16: "UNDEFINSTR", 17: "INVSTATE", 18: "INVPC", 19: "NOCP",
+    24: "UNALIGNED", 25: "DIVBYZERO",
+}
+HFSR_BITS = {1: "VECTTBL", 30: "FORCED", 31: "DEBUGEVT"}
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Dump:
+    def __init__(self):
+        self.size = None
+        self.chunks = {}
+
+    def feed(self, frame):
+        raw = cobs_decode(frame)
+        if raw is None or len(raw) < 11 or raw[0] != FRAME_TYPE:
+            return
+        payload, crc = raw[:-4], struct.unpack("<I", raw[-4:])[0]
+        if zlib.crc32(payload) & 0xFFFFFFFF != crc:
+            print("CRC error, frame dropped", file=sys.stderr)
+            return
+        _, _seq, size, off = struct.unpack("<BHHH", payload[:7])
+        if self.size != size:
+            self.size, self.chunks = size, {}
+        self.chunks[off] = payload[7:]
+
+    def complete(self):
+        if self.size is None:
+            return None
+        data = bytearray()
+        while len(data) < self.size:
+            chunk = self.chunks.get(len(data))
+            if not chunk:
+                return None
+            data += chunk
+        return bytes(data[:self.size])
+
+
+def read_frames(read, dump, deadline=None):
+    buf = bytearray()
+    while deadline is None or time.time() < deadline:
+        data = read()
+        if not data:
+            if deadline is None:
+                break
+            continue
+        buf += data
+        while True:
+            start = buf.find(0)
+            end = buf.find(0, start + 1) if start >= 0 else -1
+            if end < 0:
+                break
+            if end > start + 1:
+                dump.feed(bytes(buf[start + 1:end]))
+            del buf[:end]
+        if dump.complete():
+            break
+
+
+def symbolize(axf, addrs):
+    if not axf or not addrs:
+        return {}
+    args = ["arm-none-eabi-addr2line", "-f", "-e", axf] + ["%08x" % a for a in addrs]
+    try:
+        out = subprocess.run(args, capture_output=True, text=True).stdout.split("\n")
+    except OSError:
+        return {}
+    return {a: "%s %s" % (out[2 * i], out[2 * i + 1]) for i, a in enumerate(addrs)}
+
+
+def is_code(addr):
+    return 0x08000000 <= (addr & ~1) < 0x08100000
+
+
+def flags(value, names):
+    return " ".join(n for bit, n in sorted(names.items()) if value & (1 << bit)) or "-"
+
+
+def report(data, axf):
+    f = HEADER.unpack_from(data)
+    magic, version, size, crc, reason, uptime, exc_return, msp, psp = f[:9]
+    frame = f[9:17]
+    cfsr, hfsr, mmfar, bfar, task, stack_words, log_len = f[17:]
+    if magic not in (MAGIC_NEW, MAGIC_SEEN) or version != VERSION:
+        sys.exit("not a crash record (magic %08X version %u)" % (magic, version))
+    if zlib.crc32(data[12:size]) & 0xFFFFFFFF != crc:
+        print("warning: record CRC mismatch", file=sys.stderr)
+    stack = struct.unpack_from("<%dI" % stack_words, data, HEADER.size)
+    log = data[HEADER.size + STACK_WORDS * 4:][:log_len]
+
+    code = [frame[5] & ~1, frame[6]] + [w & ~1 for w in stack if is_code(w)]
+    syms = symbolize(axf, sorted(set(a for a in code if is_code(a))))
+
+    print("reason   %s" % REASONS.get(reason, reason))
+    print("task     %s" % (task.split(b"\0")[0].decode(errors="replace") or "-"))
+    print("uptime   %u ms" % uptime)
+    if reason == 1:
+        print("stack    %s (EXC_RETURN %08X, msp %08X psp %08X)" % (
+            "psp" if exc_return & 4 else "msp", exc_return, msp, psp))
+        for name, value in zip(FRAME_REGS, frame):
+            sym = syms.get(value & ~1 if name == "lr" else value, "")
+            print("  %-4s %08X  %s" % (name, value, sym))
+        if frame[7] & 0x1FF:
+            print("  (interrupted exception #%u)" % (frame[7] & 0x1FF))
+        print("cfsr     %08X  %s" % (cfsr, flags(cfsr, CFSR_BITS)))
+        print("hfsr     %08X  %s" % (hfsr, flags(hfsr, HFSR_BITS)))
+        if cfsr & (1 << 7):
+            print("mmfar    %08X" % mmfar)
+        if cfsr & (1 << 15):
+            print("bfar     %08X" % bfar)
+    if stack:
+        print("stack after frame (%u words):" % len(stack))
+        for i, w in enumerate(stack):
+            mark = "  <- %s" % syms[w & ~1] if (w & ~1) in syms else ""
+            print("  +%03X %08X%s" % (i * 4, w, mark))
+    print("last log lines:")
+    sys.stdout.write(log.decode("utf-8", errors="replace").replace("\r\n", "\n"))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="EnviroSense crash dump decoder")
+    ap.add_argument("source", help="串口名或抓包文件")
+    ap.add_argument("-b", "--baud", type=int, default=115200)
+    ap.add_argument("--axf", help="对应固件的 .axf，用于换算函数名")
+    ap.add_argument("--timeout", type=float, default=5.0)
+    opts = ap.parse_args()
+
+    dump = Dump()
+    try:
+        with open(opts.source, "rb") as f:
+            read_frames(lambda: f.read(4096), dump)
+    except OSError:
+        import serial  # pyserial
+        port = serial.Serial(opts.source, opts.baud, timeout=0.2)
+        port.write(b"crash\r\n")
+        read_frames(lambda: port.read(4096), dump, time.time() + opts.timeout)
+        port.close()
+
+    data = dump.complete()
+    if data is None:
+        sys.exit("no complete crash record received")
+    report(data, opts.axf)
+
+
+if __name__ == "__main__":
+    main()
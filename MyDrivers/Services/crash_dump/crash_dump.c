@@ -0,0 +1,269 @@
+/**
+ ******************************************************************************
+ * @file    crash_dump.c
+ * @brief   崩溃转储实现
+ * @details 异常处理中不调用 HAL、不加锁、不访问可能已损坏的 RTOS 结构
+ *          之外的数据：读取任何指针 (栈帧、任务控制块) 之前先检查它落在
+ *          SRAM/CCM 内，避免在 HardFault 中再次 BusFault 而锁死。
+ *          记录最后写有效标记，写到一半复位的记录不会被当作有效。
+ *          导出帧载荷：[帧类型 | 序号 (2) | 记录总长 (2) | 偏移 (2) | 数据]。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "crash_dump.h"
+#include "FreeRTOS.h"
+#include "checksum.h"
+#include "main.h"
+#include "printf_redirect.h"
+#include "task.h"
+#include <stddef.h>
+#include <string.h>
+
+#define LOG_MODULE "CRASH"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define CRASH_DUMP_MAGIC_NEW 0xDEADC0DEU  // 尚未导出
+#define CRASH_DUMP_MAGIC_SEEN 0xC0DEDEADU // 已自动导出过
+#define CRASH_DUMP ((CrashDump_t *)BKPSRAM_BASE)
+#define CRASH_DUMP_HEADER_SIZE offsetof(CrashDump_t, stack)
+#define CRASH_DUMP_CRC_OFFSET offsetof(CrashDump_t, reason)
+#define CRASH_DUMP_SRAM_END (SRAM1_BASE + 0x20000U) // SRAM1 + SRAM2
+#define CRASH_DUMP_CCM_END (CCMDATARAM_END + 1U)
+
+// 帧载荷: 公共头 (7) | 数据 | CRC (4)
+#define CRASH_DUMP_PAYLOAD_MAX (7 + CRASH_DUMP_CHUNK + 4)
+
+typedef char crash_dump_size_check[(sizeof(CrashDump_t) <= CRASH_DUMP_BKP_SIZE) ? 1 : -1];
+
+/* --------------------------- 私有变量 --------------------------- */
+static uint8_t s_payload[CRASH_DUMP_PAYLOAD_MAX];
+static uint8_t s_frame[COBS_ENCODED_MAX(CRASH_DUMP_PAYLOAD_MAX) + 2];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/* 地址范围 [addr, addr + len) 是否在 SRAM1/SRAM2 或 CCM 内 */
+static bool crash_dump_in_ram(uint32_t addr, uint32_t len) {
+  return (addr >= SRAM1_BASE && addr + len <= CRASH_DUMP_SRAM_END) ||
+         (addr >= CCMDATARAM_BASE && addr + len <= CRASH_DUMP_CCM_END);
+}
+
+/* 打开备份 SRAM 的时钟与写访问 (异常处理中直接写寄存器) */
+static void crash_dump_enable(void) {
+  RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+  RCC->AHB1ENR |= RCC_AHB1ENR_BKPSRAMEN;
+  PWR->CR |= PWR_CR_DBP;
+  __DSB();
+}
+
+/* 记录中有效的部分 */
+static uint32_t crash_dump_crc(const CrashDump_t *dump) {
+  return CRC32_Compute((const uint8_t *)dump + CRASH_DUMP_CRC_OFFSET,
+                       dump->size - CRASH_DUMP_CRC_OFFSET);
+}
+
+static bool crash_dump_valid(const CrashDump_t *dump) {
+  return (dump->magic == CRASH_DUMP_MAGIC_NEW ||
+          dump->magic == CRASH_DUMP_MAGIC_SEEN) &&
+         dump->version == CRASH_DUMP_VERSION &&
+         dump->size >= CRASH_DUMP_HEADER_SIZE &&
+         dump->size <= sizeof(CrashDump_t) && dump->crc == crash_dump_crc(dump);
+}
+
+/**
+ * @brief 填写记录并复位 (不返回)
+ * @param frame 异常栈帧，NULL 表示没有
+ */
+static void crash_dump_save(CrashReason_t reason, const uint32_t *frame,
+                            uint32_t exc_return, const char *task) {
+  CrashDump_t *dump = CRASH_DUMP;
+  uint32_t sp_end;
+
+  __disable_irq();
+  crash_dump_enable();
+
+  dump->magic = 0;
+  dump->version = CRASH_DUMP_VERSION;
+  dump->reason = reason;
+  dump->uptime_ms = uwTick;
+  dump->exc_return = exc_return;
+  dump->msp = __get_MSP();
+  dump->psp = __get_PSP();
+  dump->cfsr = SCB->CFSR;
+  dump->hfsr = SCB->HFSR;
+  dump->mmfar = SCB->MMFAR;
+  dump->bfar = SCB->BFAR;
+
+  memset(dump->task, 0, sizeof(dump->task));
+  if (task != NULL && crash_dump_in_ram((uint32_t)task, 1)) {
+    strncpy(dump->task, task, sizeof(dump->task) - 1);
+  }
+
+  memset(dump->frame, 0, sizeof(dump->frame));
+  dump->stack_words = 0;
+  if (frame != NULL && crash_dump_in_ram((uint32_t)frame, sizeof(dump->frame))) {
+    memcpy(dump->frame, frame, sizeof(dump->frame));
+    // 栈帧之后是被打断的函数的栈；带浮点上下文的栈帧为 26 字
+    frame += (exc_return & 0x10U) ? 8U : 26U;
+    sp_end = ((uint32_t)frame < CRASH_DUMP_CCM_END) ? CRASH_DUMP_CCM_END
+                                                     : CRASH_DUMP_SRAM_END;
+    while (dump->stack_words < CRASH_DUMP_STACK_WORDS &&
+           (uint32_t)(frame + dump->stack_words) + 4U <= sp_end) {
+      dump->stack[dump->stack_words] = frame[dump->stack_words];
+      dump->stack_words++;
+    }
+  }
+
+  dump->log_len = (uint16_t)log_copy_recent(dump->log, sizeof(dump->log));
+  dump->size = (uint16_t)(offsetof(CrashDump_t, log) + dump->log_len);
+  dump->crc = crash_dump_crc(dump);
+  __DSB();
+  dump->magic = CRASH_DUMP_MAGIC_NEW; // 最后写标记
+  __DSB();
+
+  if (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk) {
+    __BKPT(0); // 调试器已连接：停在这里查看现场
+  }
+  NVIC_SystemReset();
+}
+
+/* 当前任务名称 (调度器未启动或控制块不可信时为 NULL) */
+static const char *crash_dump_task_name(void) {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+  if (self == NULL || !crash_dump_in_ram((uint32_t)self, 64)) {
+    return NULL;
+  }
+  return pcTaskGetName(self);
+}
+
+/**
+ * @brief 发送记录 [0, size) 的全部分块
+ */
+static void crash_dump_send(const CrashDump_t *dump) {
+  const uint8_t *src = (const uint8_t *)dump;
+  uint16_t seq = 0;
+
+  for (uint16_t off = 0; off < dump->size; off += CRASH_DUMP_CHUNK, seq++) {
+    uint16_t n = dump->size - off;
+    uint8_t *p = s_payload;
+    size_t len;
+
+    if (n > CRASH_DUMP_CHUNK) {
+      n = CRASH_DUMP_CHUNK;
+    }
+    *p++ = CRASH_DUMP_FRAME_TYPE;
+    *p++ = (uint8_t)seq;
+    *p++ = (uint8_t)(seq >> 8);
+    *p++ = (uint8_t)dump->size;
+    *p++ = (uint8_t)(dump->size >> 8);
+    *p++ = (uint8_t)off;
+    *p++ = (uint8_t)(off >> 8);
+    memcpy(p, src + off, n);
+    p += n;
+    len = (size_t)(p - s_payload);
+
+    uint32_t crc = CRC32_Compute(s_payload, len);
+    p[0] = (uint8_t)crc;
+    p[1] = (uint8_t)(crc >> 8);
+    p[2] = (uint8_t)(crc >> 16);
+    p[3] = (uint8_t)(crc >> 24);
+
+    s_frame[0] = 0x00;
+    len = COBS_Encode(s_payload, len + 4, s_frame + 1);
+    s_frame[len + 1] = 0x00;
+    printf_write(s_frame, len + 2);
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief HardFault 入口：按 EXC_RETURN 第 2 位选择被打断上下文使用的栈
+ */
+#if defined(__CC_ARM)
+__asm void HardFault_Handler(void) {
+  IMPORT CrashDump_OnFault
+  TST LR, #4
+  ITE EQ
+  MRSEQ R0, MSP
+  MRSNE R0, PSP
+  MOV R1, LR
+  B CrashDump_OnFault
+}
+#else
+__attribute__((naked)) void HardFault_Handler(void) {
+  __asm volatile("tst lr, #4      \n"
+                 "ite eq          \n"
+                 "mrseq r0, msp   \n"
+                 "mrsne r0, psp   \n"
+                 "mov r1, lr      \n"
+                 "b CrashDump_OnFault\n");
+}
+#endif
+
+/**
+ * @brief HardFault 处理的 C 部分
+ */
+void CrashDump_OnFault(uint32_t *frame, uint32_t exc_return) {
+  crash_dump_save(CRASH_REASON_HARDFAULT, frame, exc_return,
+                  crash_dump_task_name());
+}
+
+/**
+ * @brief 任务栈溢出时记录并复位
+ */
+void CrashDump_StackOverflow(const char *task) {
+  crash_dump_save(CRASH_REASON_STACK_OVERFLOW, NULL, 0, task);
+}
+
+/**
+ * @brief 报告并导出上次崩溃的记录
+ */
+void CrashDump_Report(void) {
+  CrashDump_t *dump = CRASH_DUMP;
+
+  crash_dump_enable();
+  // 备份调节器：有 VBAT 时主电源掉电也保持备份 SRAM
+  PWR->CSR |= PWR_CSR_BRE;
+
+  if (!crash_dump_valid(dump) || dump->magic != CRASH_DUMP_MAGIC_NEW) {
+    return;
+  }
+  LOG_ERROR("上次崩溃: %s 任务 %s，上电后 %lu ms",
+            (dump->reason == CRASH_REASON_STACK_OVERFLOW) ? "栈溢出" : "HardFault",
+            dump->task[0] ? dump->task : "-", (unsigned long)dump->uptime_ms);
+  if (dump->reason == CRASH_REASON_HARDFAULT) {
+    LOG_ERROR("  pc=%08lX lr=%08lX sp=%08lX cfsr=%08lX hfsr=%08lX",
+              (unsigned long)dump->frame[6], (unsigned long)dump->frame[5],
+              (unsigned long)((dump->exc_return & 0x4U) ? dump->psp : dump->msp),
+              (unsigned long)dump->cfsr, (unsigned long)dump->hfsr);
+    LOG_ERROR("  mmfar=%08lX bfar=%08lX，完整记录 %u 字节 (crash_decode.py)",
+              (unsigned long)dump->mmfar, (unsigned long)dump->bfar, dump->size);
+  }
+  // 日志是异步输出的，先等摘要发完再发二进制帧
+  log_flush();
+  crash_dump_send(dump);
+
+  dump->magic = CRASH_DUMP_MAGIC_SEEN; // 记录保留，可用命令行再次导出
+}
+
+/**
+ * @brief 导出备份 SRAM 中的记录
+ */
+bool CrashDump_Export(void) {
+  const CrashDump_t *dump = CRASH_DUMP;
+
+  if (!crash_dump_valid(dump)) {
+    return false;
+  }
+  crash_dump_send(dump);
+  return true;
+}
+
+/**
+ * @brief 清除记录
+ */
+void CrashDump_Clear(void) { CRASH_DUMP->magic = 0; }
@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ * @file    crash_dump.h
+ * @brief   崩溃转储头文件
+ * @details HardFault (MemManage/BusFault/UsageFault 未单独使能，均升级为
+ *          HardFault) 与任务栈溢出时，把现场写入备份 SRAM 的前 3.5 KB 后复位：
+ *            - 异常栈帧 (r0~r3/r12/lr/pc/xpsr)、EXC_RETURN、MSP/PSP；
+ *            - 故障状态寄存器 CFSR/HFSR/MMFAR/BFAR；
+ *            - 当前任务名称、上电以来的时间；
+ *            - 栈帧之后的一段栈内容 (调用链的返回地址通常在其中)；
+ *            - 日志环中最近的若干行 (串口还没来得及发出的也在内)。
+ *          备份 SRAM 在系统复位、看门狗复位时保持，备份调节器使能后有 VBAT
+ *          时掉电也保持。
+ *          下次启动时 CrashDump_Report() 输出摘要，并把整条记录以二进制帧
+ *          发送 (与 sensor_export 相同的 0x00 | COBS(载荷 | CRC-32) | 0x00
+ *          分帧)，由主机端 crash_decode.py 还原；命令行 crash 可再次导出。
+ *          调试器连接时先停在断点处，便于直接查看现场。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __CRASH_DUMP_H
+#define __CRASH_DUMP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define CRASH_DUMP_VERSION 1
+#define CRASH_DUMP_STACK_WORDS 64   // 栈内容快照 (字)
+#define CRASH_DUMP_LOG_BYTES 3072   // 最近日志 (字节)，与以上合计不超过 CRASH_DUMP_BKP_SIZE
+#define CRASH_DUMP_BKP_SIZE 3584    // 占用的备份 SRAM (其后 512 字节为 log_flash 的页缓冲)
+#define CRASH_DUMP_CHUNK 192        // 每帧携带的记录字节数
+#define CRASH_DUMP_FRAME_TYPE 0x10  // 帧类型 (与 sensor_export 的帧类型错开)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 崩溃原因
+ */
+typedef enum {
+  CRASH_REASON_HARDFAULT = 1,
+  CRASH_REASON_STACK_OVERFLOW, // 无异常栈帧，寄存器字段为 0
+} CrashReason_t;
+
+/**
+ * @brief 备份 SRAM 中的记录 (小端，主机按相同布局解析)
+ */
+typedef struct {
+  uint32_t magic;     // 有效标记 (已导出过的记录换为另一个值)
+  uint16_t version;   // CRASH_DUMP_VERSION
+  uint16_t size;      // 有效字节数 (含本结构头，日志只计实际长度)
+  uint32_t crc;       // [reason, size) 的 CRC-32
+  uint32_t reason;    // CrashReason_t
+  uint32_t uptime_ms; // 上电以来的时间
+  uint32_t exc_return;
+  uint32_t msp;
+  uint32_t psp;
+  uint32_t frame[8];  // r0 r1 r2 r3 r12 lr pc xpsr
+  uint32_t cfsr;
+  uint32_t hfsr;
+  uint32_t mmfar;
+  uint32_t bfar;
+  char task[16];      // 当前任务名称 (调度器未启动时为空)
+  uint16_t stack_words; // stack[] 有效字数
+  uint16_t log_len;     // log[] 有效字节数
+  uint32_t stack[CRASH_DUMP_STACK_WORDS];
+  char log[CRASH_DUMP_LOG_BYTES];
+} CrashDump_t;
+
+/* --------------------------- 公共接口 --------------------------- */
+
+/**
+ * @brief 使能备份 SRAM，报告并导出上次崩溃的记录 (每条记录只自动导出一次)
+ * @note  在日志初始化之后调用一次
+ */
+void CrashDump_Report(void);
+
+/**
+ * @brief 导出备份 SRAM 中的记录 (命令行使用)
+ * @return false 没有记录
+ */
+bool CrashDump_Export(void);
+
+/**
+ * @brief 清除记录
+ */
+void CrashDump_Clear(void);
+
+/**
+ * @brief 任务栈溢出时记录并复位 (vApplicationStackOverflowHook 中调用)
+ */
+void CrashDump_StackOverflow(const char *task);
+
+/**
+ * @brief HardFault 处理的 C 部分，由 HardFault_Handler 传入异常栈帧
+ * @param frame      异常栈帧 (按 EXC_RETURN 取自 MSP 或 PSP)
+ * @param exc_return 进入异常时的 LR
+ */
+void CrashDump_OnFault(uint32_t *frame, uint32_t exc_return);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __CRASH_DUMP_H */
@@ -8,6 +8,14 @@
  */
 
 #include "devices_manager.h"
+#include "config_store.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "task_wdt.h"
+#include "sensor_latency.h"
+#include "runtime_config.h"
+#include "warm_start.h"
+#include <string.h>
 
 /* ==================== 静态变量 ==================== */
 
@@ -22,31 +30,270 @@ static RGB_Color s_led_color_slots[3] = {
     {0, 0, 255}       // 槽位3默认：蓝色
 };
 
+static uint8_t s_led_brightness = 255;  // 用户设置的亮度（自动调光不修改）
+static uint8_t s_led_auto_brightness = 255;  // 自动调光最近一次计算的亮度
+
+/* 告警输出：激活期间覆盖 LED / 电机的用户设置，解除后恢复 */
+static Drivers_AlarmOutput_t s_alarm;
+
+/* 电机逻辑状态：实际输出由控制任务按告警与用户模式合成 */
+static Motor_Control_Mode_t s_motor_mode = MOTOR_MODE_MANUAL;  // 用户选择的模式
+static uint16_t s_motor_speed;          // 手动模式速度
+static uint16_t s_motor_vent_speed;     // 通风联动最近请求的速度
+
+/* 执行器命令：setter 只更新逻辑状态并登记命令，外设只在输出控制任务中访问。
+ * 每类命令只保留最新参数，滑块连续拖动时一个控制周期内只执行最后一次 */
+#define CMD_LED_COLOR           (1U << 0)
+#define CMD_LED_BRIGHTNESS      (1U << 1)
+#define CMD_MOTOR               (1U << 2)   // 按逻辑状态重新输出电机
+#define CMD_BUZZER_TONE         (1U << 3)
+#define CMD_BUZZER_BEEP         (1U << 4)
+
+typedef struct {
+    uint8_t pending;            // CMD_* 位掩码
+    RGB_Color led_color;        // CMD_LED_COLOR 目标颜色
+    bool led_fade;              // 以渐变方式切换颜色
+    uint8_t led_brightness;     // CMD_LED_BRIGHTNESS 目标亮度
+    uint16_t buzzer_hz;         // CMD_BUZZER_TONE 频率，0 表示停止
+    uint64_t buzzer_sample_us;  // 告警鸣响对应的样本时刻（延迟统计，0 表示无）
+} Drivers_Cmd_t;
+
+static Drivers_Cmd_t s_cmd;
+
+/* 输出控制任务 */
+static StaticTask_t s_control_task_tcb;
+static StackType_t s_control_task_stack[DRIVERS_CONTROL_TASK_STACK_SIZE];
+static TaskHandle_t s_control_task = NULL;
+static RuntimeConfigSub_t s_config_sub = -1;  // 运行时配置订阅 (LED 槽位颜色)
+static volatile float s_led_lux = -1.0f;  // 最近一次光照值，小于 0 表示尚未收到
+static bool s_led_auto_ramping;           // 自动调光尚未到达目标亮度
+
+/* 状态快照：顺序锁发布，序号为奇数表示正在写入 */
+static Drivers_State_t s_state;
+static volatile uint32_t s_state_seq;
+
+/* 设置写回：setter 只置脏标记，停止修改后由监控任务统一写入配置存储 */
+#define SETTING_LED_SLOTS       (1U << 0)
+#define SETTING_LED_BRIGHTNESS  (1U << 1)
+#define SETTING_LED_MODE        (1U << 2)
+#define SETTING_MOTOR_MODE      (1U << 3)
+
+static volatile uint8_t s_settings_dirty;
+static volatile uint32_t s_settings_changed_tick;
+static volatile bool s_power_fail;
+
 /* [SIMPLIFIED] 自动调光固定配置 */
 #define AUTO_LUX_MIN            50.0f    // 低于此值亮度固定为 255
 #define AUTO_LUX_MAX            1500.0f   // 高于此值关闭 LED
 #define AUTO_BRIGHTNESS_MIN     40       // 映射范围最小亮度
+#define AUTO_BRIGHTNESS_STEP    4        // 每个控制周期亮度最大变化量 (全程约 0.6 s)
+
+/* 标记设置已修改（滑块回调中调用，只改内存） */
+static void Drivers_Settings_MarkDirty(uint8_t mask)
+{
+    taskENTER_CRITICAL();
+    s_settings_dirty |= mask;
+    s_settings_changed_tick = HAL_GetTick();
+    taskEXIT_CRITICAL();
+}
+
+/* ==================== 执行器命令 ==================== */
+
+/* 唤醒输出控制任务（无周期工作时它阻塞等待通知），可在临界区内调用 */
+static void drivers_control_wake(void)
+{
+    if (s_control_task != NULL) {
+        xTaskNotifyGive(s_control_task);
+    }
+}
+
+static void drivers_cmd_post(uint8_t mask)
+{
+    taskENTER_CRITICAL();
+    s_cmd.pending |= mask;
+    taskEXIT_CRITICAL();
+    drivers_control_wake();
+}
+
+static void drivers_cmd_led_color(RGB_Color color, bool fade)
+{
+    taskENTER_CRITICAL();
+    s_cmd.led_color = color;
+    s_cmd.led_fade = fade;
+    s_cmd.pending |= CMD_LED_COLOR;
+    taskEXIT_CRITICAL();
+    drivers_control_wake();
+}
+
+static void drivers_cmd_led_brightness(uint8_t brightness)
+{
+    taskENTER_CRITICAL();
+    s_cmd.led_brightness = brightness;
+    s_cmd.pending |= CMD_LED_BRIGHTNESS;
+    taskEXIT_CRITICAL();
+    drivers_control_wake();
+}
+
+static void drivers_cmd_buzzer_tone(uint16_t freq_hz, uint64_t sample_us)
+{
+    taskENTER_CRITICAL();
+    s_cmd.buzzer_hz = freq_hz;
+    s_cmd.buzzer_sample_us = sample_us;
+    s_cmd.pending |= CMD_BUZZER_TONE;
+    taskEXIT_CRITICAL();
+    drivers_control_wake();
+}
+
+/* 按逻辑状态输出电机：告警接管时以手动模式固定速度运行，否则按用户模式 */
+static void motor_apply(void)
+{
+    Motor_Control_Mode_t mode;
+    uint16_t speed;
+
+    taskENTER_CRITICAL();
+    if (s_alarm.motor) {
+        mode = MOTOR_MODE_MANUAL;
+        speed = s_alarm.motor_speed;
+    } else {
+        mode = s_motor_mode;
+        speed = (mode == MOTOR_MODE_VENT) ? s_motor_vent_speed : s_motor_speed;
+    }
+    taskEXIT_CRITICAL();
+
+    if (Motor_GetControlMode() != mode) {
+        Motor_SetControlMode(mode);
+    }
+    Motor_SetSpeed(speed);  // 自动模式下被忽略
+}
+
+/* 执行登记的命令（输出控制任务中调用）：先亮度后颜色，渐变使用新亮度 */
+static void drivers_cmd_execute(void)
+{
+    Drivers_Cmd_t cmd;
+
+    taskENTER_CRITICAL();
+    cmd = s_cmd;
+    s_cmd.pending = 0;
+    taskEXIT_CRITICAL();
+
+    if (cmd.pending == 0) {
+        return;
+    }
+
+    if (s_status.rgb_led_ready) {
+        if (cmd.pending & CMD_LED_BRIGHTNESS) {
+            RGB_LED_SetBrightness(cmd.led_brightness);
+        }
+        if (cmd.pending & CMD_LED_COLOR) {
+            if (cmd.led_fade) {
+                RGB_LED_FadeTo(cmd.led_color, RGB_LED_GetBrightness(), DRIVERS_LED_FADE_MS);
+            } else {
+                RGB_LED_SetColorStruct(cmd.led_color);
+            }
+        }
+    }
+
+    if (s_status.motor_ready && (cmd.pending & CMD_MOTOR)) {
+        motor_apply();
+    }
+
+    if (s_status.buzzer_ready) {
+        if (cmd.pending & CMD_BUZZER_TONE) {
+            if (cmd.buzzer_hz != 0) {
+                Buzzer_SetFrequency(cmd.buzzer_hz);
+                SensorLatency_Record(SENSOR_LATENCY_BUZZER, cmd.buzzer_sample_us);
+            } else {
+                Buzzer_Stop();
+            }
+        }
+        if (cmd.pending & CMD_BUZZER_BEEP) {
+            Buzzer_Beep();
+        }
+    }
+}
+
+/* ==================== 状态快照 ==================== */
+
+/* 按当前状态生成快照，有变化时整体发布一次
+ * 写者分布在 LVGL、输出控制、传感器等任务中，生成与发布都在临界区内完成，
+ * 写者之间互斥，读者也不会在写入中途抢占写者 */
+static void drivers_state_publish(void)
+{
+    Drivers_State_t next;
+
+    memset(&next, 0, sizeof(next));  // 填充字节清零，便于整体比较
+
+    taskENTER_CRITICAL();
+    next.version = s_state.version;
+    next.led_mode = s_led_mode;
+    next.led_manual_state = s_led_manual_state;
+    memcpy(next.led_slots, s_led_color_slots, sizeof(next.led_slots));
+    next.led_color = s_status.rgb_led_ready ? RGB_LED_GetCurrentColor() : COLOR_OFF;
+    next.led_brightness = s_led_brightness;
+    next.led_auto_brightness = s_led_auto_brightness;
+    next.motor_mode = Drivers_Motor_GetMode();
+    next.motor_speed = Drivers_Motor_GetSpeed();
+    next.motor_setpoint = s_status.motor_ready ? Motor_GetSetpoint() : 0;
+    next.alarm_active = s_alarm.buzzer || s_alarm.led || s_alarm.motor;
+
+    if (memcmp(&next, &s_state, sizeof(next)) != 0) {
+        next.version++;
+        s_state_seq++;  // 变为奇数
+        __DMB();
+        memcpy(&s_state, &next, sizeof(s_state));
+        __DMB();
+        s_state_seq++;  // 恢复为偶数
+
+        /* 热启动记录：复位后恢复，不必等配置存储写回 */
+        WarmStart_Devices_t warm = {
+            (uint8_t)s_led_mode, (uint8_t)s_led_manual_state, s_led_brightness,
+            (uint8_t)s_motor_mode, s_motor_speed};
+        WarmStart_SetDevices(&warm);
+    }
+    taskEXIT_CRITICAL();
+}
+
+/* ==================== 状态快照接口 ==================== */
+
+uint32_t Drivers_GetState(Drivers_State_t *state)
+{
+    uint32_t seq;
+
+    do {
+        seq = s_state_seq;
+        __DMB();
+        memcpy(state, &s_state, sizeof(*state));
+        __DMB();
+    } while ((seq & 1u) || seq != s_state_seq);
+
+    return state->version;
+}
+
+uint32_t Drivers_GetStateVersion(void)
+{
+    return s_state.version;
+}
 
 /* ==================== 蜂鸣器控制接口 ==================== */
 
 void Drivers_Buzzer_On(uint16_t freq_hz)
 {
     if (s_status.buzzer_ready) {
-        Buzzer_SetFrequency(freq_hz);
+        drivers_cmd_buzzer_tone(freq_hz, 0);
     }
 }
 
 void Drivers_Buzzer_Off(void)
 {
     if (s_status.buzzer_ready) {
-        Buzzer_Stop();
+        drivers_cmd_buzzer_tone(0, 0);
     }
 }
 
 void Drivers_Buzzer_Beep(void)
 {
     if (s_status.buzzer_ready) {
-        Buzzer_Beep();
+        drivers_cmd_post(CMD_BUZZER_BEEP);
     }
 }
 
@@ -87,6 +334,67 @@ static uint8_t map_lux_to_brightness(float lux)
     return brightness;
 }
 
+/* LED 硬件输出（登记命令）：告警显示期间只更新状态，不改变实际输出 */
+static void led_apply_color(RGB_Color color)
+{
+    if (!s_alarm.led) {
+        drivers_cmd_led_color(color, false);
+    }
+}
+
+/* 渐变切换颜色（保持当前亮度），用于槽位切换等离散操作 */
+static void led_fade_color(RGB_Color color)
+{
+    if (!s_alarm.led) {
+        drivers_cmd_led_color(color, true);
+    }
+}
+
+static void led_apply_off(void)
+{
+    if (!s_alarm.led) {
+        drivers_cmd_led_color(COLOR_OFF, false);
+    }
+}
+
+static void led_apply_brightness(uint8_t brightness)
+{
+    if (!s_alarm.led) {
+        drivers_cmd_led_brightness(brightness);
+    }
+}
+
+/* 按当前模式重新输出 LED（告警解除后调用） */
+static void led_restore(void)
+{
+    if (s_led_mode == LED_MODE_AUTO) {
+        if (s_led_auto_brightness == 0) {
+            drivers_cmd_led_color(COLOR_OFF, false);
+        } else {
+            drivers_cmd_led_color(s_led_color_slots[0], false);
+            drivers_cmd_led_brightness(s_led_auto_brightness);
+        }
+        return;
+    }
+
+    drivers_cmd_led_brightness(s_led_brightness);
+    switch (s_led_manual_state) {
+        case LED_STATE_SLOT_1:
+            drivers_cmd_led_color(s_led_color_slots[0], false);
+            break;
+        case LED_STATE_SLOT_2:
+            drivers_cmd_led_color(s_led_color_slots[1], false);
+            break;
+        case LED_STATE_SLOT_3:
+            drivers_cmd_led_color(s_led_color_slots[2], false);
+            break;
+        case LED_STATE_OFF:
+        default:
+            drivers_cmd_led_color(COLOR_OFF, false);
+            break;
+    }
+}
+
 /* 设置槽位颜色 */
 bool Drivers_RGBLED_SetSlotColor(uint8_t slot, RGB_Color color)
 {
@@ -95,6 +403,7 @@ bool Drivers_RGBLED_SetSlotColor(uint8_t slot, RGB_Color color)
     }
     
     s_led_color_slots[slot - 1] = color;
+    Drivers_Settings_MarkDirty(SETTING_LED_SLOTS);
     
     /* 如果当前处于该槽位，立即应用新颜色 */
     if (s_led_mode == LED_MODE_MANUAL) {
@@ -103,16 +412,17 @@ bool Drivers_RGBLED_SetSlotColor(uint8_t slot, RGB_Color color)
             (slot == 3 && s_led_manual_state == LED_STATE_SLOT_3)) {
             
             if (s_status.rgb_led_ready) {
-                RGB_LED_SetColorStruct(color);
+                led_apply_color(color);
             }
         }
     } else if (s_led_mode == LED_MODE_AUTO && slot == 1) {
         /* 自动模式下只更新槽位1 */
         if (s_status.rgb_led_ready) {
-            RGB_LED_SetColorStruct(color);
+            led_apply_color(color);
         }
     }
     
+    drivers_state_publish();
     return true;
 }
 
@@ -133,6 +443,8 @@ void Drivers_RGBLED_ResetSlotColors(void)
     s_led_color_slots[0] = (RGB_Color){255, 0, 0};      // 槽位1：红色
     s_led_color_slots[1] = (RGB_Color){0, 255, 0};      // 槽位2：绿色
     s_led_color_slots[2] = (RGB_Color){0, 0, 255};      // 槽位3：蓝色
+    Drivers_Settings_MarkDirty(SETTING_LED_SLOTS);
+    drivers_state_publish();
 }
 
 /* 设置 LED 控制模式（自动/手动） */
@@ -143,29 +455,37 @@ void Drivers_RGBLED_SetMode(led_control_mode_t mode)
     }
     
     s_led_mode = mode;
+    Drivers_Settings_MarkDirty(SETTING_LED_MODE);
     
     if (mode == LED_MODE_MANUAL) {
         /* 手动模式：恢复上次的槽位状态 */
         switch (s_led_manual_state) {
             case LED_STATE_SLOT_1:
-                RGB_LED_SetColorStruct(s_led_color_slots[0]);
+                led_apply_color(s_led_color_slots[0]);
                 break;
             case LED_STATE_SLOT_2:
-                RGB_LED_SetColorStruct(s_led_color_slots[1]);
+                led_apply_color(s_led_color_slots[1]);
                 break;
             case LED_STATE_SLOT_3:
-                RGB_LED_SetColorStruct(s_led_color_slots[2]);
+                led_apply_color(s_led_color_slots[2]);
                 break;
             case LED_STATE_OFF:
             default:
-                RGB_LED_Off();
+                led_apply_off();
                 break;
         }
     } else {
-        /* 自动模式：默认使用槽位1的颜色 */
+        /* 自动模式：默认使用槽位1的颜色，从当前自动亮度开始调节 */
         s_led_manual_state = LED_STATE_SLOT_1;
-        RGB_LED_SetColorStruct(s_led_color_slots[0]);
+        if (s_led_auto_brightness == 0) {
+            led_apply_off();
+        } else {
+            led_apply_color(s_led_color_slots[0]);
+            led_apply_brightness(s_led_auto_brightness);
+        }
     }
+    
+    drivers_state_publish();
 }
 
 /* 获取当前 LED 控制模式 */
@@ -198,53 +518,84 @@ void Drivers_RGBLED_SetManualSlot(uint8_t slot)
     switch (slot) {
         case 1:
             s_led_manual_state = LED_STATE_SLOT_1;
-            RGB_LED_SetColorStruct(s_led_color_slots[0]);
+            led_fade_color(s_led_color_slots[0]);
             break;
             
         case 2:
             s_led_manual_state = LED_STATE_SLOT_2;
-            RGB_LED_SetColorStruct(s_led_color_slots[1]);
+            led_fade_color(s_led_color_slots[1]);
             break;
             
         case 3:
             s_led_manual_state = LED_STATE_SLOT_3;
-            RGB_LED_SetColorStruct(s_led_color_slots[2]);
+            led_fade_color(s_led_color_slots[2]);
             break;
             
         default:
             break;
     }
+    
+    drivers_state_publish();
 }
 
-/* 根据光照值自动调节 LED（仅自动模式下生效） */
+/* 更新自动调光使用的光照值，实际输出由控制任务完成 */
 void Drivers_RGBLED_AutoAdjust(float lux)
 {
     if (!s_status.rgb_led_ready) {
         return;
     }
     
-    if (s_led_mode != LED_MODE_AUTO) {
+    s_led_lux = lux;
+    drivers_control_wake();
+}
+
+/* 自动调光一步：亮度按步长逼近光照映射的目标值（控制任务中调用） */
+static void led_auto_step(void)
+{
+    float lux = s_led_lux;
+    uint8_t target;
+    uint8_t current;
+    
+    if (!s_status.rgb_led_ready || lux < 0.0f) {
         return;
     }
     
-    /* 使用映射函数计算亮度 */
-    uint8_t brightness = map_lux_to_brightness(lux);
+    /* 使用映射函数计算目标亮度 */
+    target = map_lux_to_brightness(lux);
     
-    if (brightness == 0) {
-        /* 明亮环境：关闭 LED */
-        RGB_LED_Off();
-    } else {
-        /* 暗环境：显示槽位1的颜色，调节亮度 */
-        RGB_LED_SetColorStruct(s_led_color_slots[0]);
-        RGB_LED_SetBrightness(brightness);
+    taskENTER_CRITICAL();
+    current = s_led_auto_brightness;
+    s_led_auto_ramping = false;
+    if (s_led_mode == LED_MODE_AUTO && target != current) {
+        if (target > current) {
+            s_led_auto_brightness = (target - current > AUTO_BRIGHTNESS_STEP) ?
+                                    current + AUTO_BRIGHTNESS_STEP : target;
+        } else {
+            s_led_auto_brightness = (current - target > AUTO_BRIGHTNESS_STEP) ?
+                                    current - AUTO_BRIGHTNESS_STEP : target;
+        }
+        
+        if (s_led_auto_brightness == 0) {
+            /* 明亮环境：关闭 LED */
+            led_apply_off();
+        } else {
+            /* 暗环境：显示槽位1的颜色，调节亮度 */
+            if (current == 0) {
+                led_apply_color(s_led_color_slots[0]);
+            }
+            led_apply_brightness(s_led_auto_brightness);
+        }
+        s_led_auto_ramping = (s_led_auto_brightness != target);
     }
+    taskEXIT_CRITICAL();
 }
 
 /* 直接设置 RGB LED 颜色（不影响槽位） */
 void Drivers_RGBLED_SetColor(RGB_Color color)
 {
     if (s_status.rgb_led_ready) {
-        RGB_LED_SetColorStruct(color);
+        led_apply_color(color);
+        drivers_state_publish();
     }
 }
 
@@ -252,12 +603,13 @@ void Drivers_RGBLED_SetColor(RGB_Color color)
 void Drivers_RGBLED_Off(void)
 {
     if (s_status.rgb_led_ready) {
-        RGB_LED_Off();
+        led_apply_off();
         
         /* 在手动模式下，更新状态为关闭 */
         if (s_led_mode == LED_MODE_MANUAL) {
             s_led_manual_state = LED_STATE_OFF;
         }
+        drivers_state_publish();
     }
 }
 
@@ -275,29 +627,31 @@ void Drivers_RGBLED_CycleColor(void)
     switch (s_led_manual_state) {
         case LED_STATE_OFF:
             s_led_manual_state = LED_STATE_SLOT_1;
-            RGB_LED_SetColorStruct(s_led_color_slots[0]);
+            led_fade_color(s_led_color_slots[0]);
             break;
             
         case LED_STATE_SLOT_1:
             s_led_manual_state = LED_STATE_SLOT_2;
-            RGB_LED_SetColorStruct(s_led_color_slots[1]);
+            led_fade_color(s_led_color_slots[1]);
             break;
             
         case LED_STATE_SLOT_2:
             s_led_manual_state = LED_STATE_SLOT_3;
-            RGB_LED_SetColorStruct(s_led_color_slots[2]);
+            led_fade_color(s_led_color_slots[2]);
             break;
             
         case LED_STATE_SLOT_3:
             s_led_manual_state = LED_STATE_OFF;
-            RGB_LED_Off();
+            led_fade_color(COLOR_OFF);
             break;
             
         default:
             s_led_manual_state = LED_STATE_OFF;
-            RGB_LED_Off();
+            led_fade_color(COLOR_OFF);
             break;
     }
+    
+    drivers_state_publish();
 }
 
 /* 获取当前 RGB LED 颜色 */
@@ -310,7 +664,10 @@ RGB_Color Drivers_RGBLED_GetColor(void)
 void Drivers_RGBLED_SetBrightness(uint8_t brightness)
 {
     if (s_status.rgb_led_ready) {
-        RGB_LED_SetBrightness(brightness);
+        led_apply_brightness(brightness);
+        s_led_brightness = brightness;
+        Drivers_Settings_MarkDirty(SETTING_LED_BRIGHTNESS);
+        drivers_state_publish();
     }
 }
 
@@ -319,19 +676,41 @@ void Drivers_RGBLED_SetBrightness(uint8_t brightness)
 void Drivers_Motor_SetMode(Motor_Control_Mode_t mode)
 {
     if (s_status.motor_ready) {
-        Motor_SetControlMode(mode);
+        taskENTER_CRITICAL();
+        /* 从其他模式切到手动时保持当前速度（告警接管时保持原手动速度） */
+        if (mode == MOTOR_MODE_MANUAL && s_motor_mode != MOTOR_MODE_MANUAL && !s_alarm.motor) {
+            s_motor_speed = Motor_GetSetpoint();
+        }
+        s_motor_mode = mode;
+        taskEXIT_CRITICAL();
+        drivers_cmd_post(CMD_MOTOR);
+        Drivers_Settings_MarkDirty(SETTING_MOTOR_MODE);
+        drivers_state_publish();
     }
 }
 
 Motor_Control_Mode_t Drivers_Motor_GetMode(void)
 {
-    return s_status.motor_ready ? Motor_GetControlMode() : MOTOR_MODE_MANUAL;
+    return s_status.motor_ready ? s_motor_mode : MOTOR_MODE_MANUAL;
 }
 
 void Drivers_Motor_SetSpeed(uint16_t speed)
 {
     if (s_status.motor_ready) {
-        Motor_SetSpeed(speed);
+        s_motor_speed = (speed > 999) ? 999 : speed;
+        if (s_motor_mode == MOTOR_MODE_MANUAL) {
+            drivers_cmd_post(CMD_MOTOR);
+        }
+        drivers_state_publish();
+    }
+}
+
+void Drivers_Motor_SetVentSpeed(uint16_t speed)
+{
+    s_motor_vent_speed = (speed > 999) ? 999 : speed;
+    if (s_status.motor_ready && s_motor_mode == MOTOR_MODE_VENT) {
+        drivers_cmd_post(CMD_MOTOR);
+        drivers_state_publish();
     }
 }
 
@@ -347,6 +726,125 @@ uint16_t Drivers_Motor_GetPotValue(void)
 
 /* ==================== 系统管理接口 ==================== */
 
+/* 是否有周期性工作：自动调速跟随电位器、闭环调速、自动调光逼近目标 */
+static bool drivers_control_periodic(void)
+{
+    if (s_status.motor_ready) {
+        Motor_Control_Mode_t mode = Motor_GetControlMode();
+        if (mode == MOTOR_MODE_AUTO || (MOTOR_CLOSED_LOOP && Motor_GetSetpoint() != 0)) {
+            return true;
+        }
+    }
+    return s_led_auto_ramping;
+}
+
+/* 应用新发布的运行时配置（只处理变化的槽位，界面单独修改过的槽位不被覆盖） */
+static void drivers_apply_config(void)
+{
+    const RuntimeConfig_t *cfg = RuntimeConfig_Poll(s_config_sub);
+
+    if (cfg == NULL) {
+        return;
+    }
+    for (uint8_t i = 0; i < RUNTIME_CONFIG_LED_SLOTS; i++) {
+        if (cfg->changed & RUNTIME_CONFIG_CHG_LED_SLOT(i)) {
+            Drivers_RGBLED_SetSlotColor(i + 1, cfg->led_slots[i]);
+        }
+    }
+}
+
+/* 输出控制任务：有周期工作时固定周期执行设备更新，不受界面页面与 LVGL 负载影响；
+ * 否则阻塞到有新命令或光照值，让空闲任务可以长时间睡眠 */
+static void Drivers_Control_Task(void *argument)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+    
+    (void)argument;
+    TaskWdt_Register(TASK_WDT_DEADLINE_OUTPUT_MS);
+    for (;;) {
+        TaskWdt_CheckIn();
+        drivers_apply_config();
+        Drivers_Manager_Update();
+        if (drivers_control_periodic()) {
+            vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(DRIVERS_CONTROL_PERIOD_MS));
+        } else {
+            TaskWdt_Idle();
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            last_wake = xTaskGetTickCount();
+        }
+    }
+}
+
+/* 热启动：沿用复位前的设备状态（只改动与配置存储不同的项，
+ * 复位前尚未写回的修改因此照常标记为待写回） */
+static void Drivers_Manager_RestoreWarm(void)
+{
+    const WarmStart_State_t *warm = WarmStart_Get();
+    const WarmStart_Devices_t *dev;
+
+    if (warm == NULL || !warm->devices_valid) {
+        return;
+    }
+    dev = &warm->devices;
+
+    if (s_status.rgb_led_ready) {
+        if (dev->led_brightness != s_led_brightness) {
+            Drivers_RGBLED_SetBrightness(dev->led_brightness);
+        }
+        if (dev->led_mode <= LED_MODE_AUTO && dev->led_mode != s_led_mode) {
+            Drivers_RGBLED_SetMode((led_control_mode_t)dev->led_mode);
+        }
+        if (s_led_mode == LED_MODE_MANUAL && dev->led_manual_state != s_led_manual_state) {
+            if (dev->led_manual_state == LED_STATE_OFF) {
+                Drivers_RGBLED_Off();
+            } else {
+                Drivers_RGBLED_SetManualSlot(dev->led_manual_state);
+            }
+        }
+    }
+
+    if (s_status.motor_ready) {
+        if (dev->motor_mode <= MOTOR_MODE_VENT && dev->motor_mode != s_motor_mode) {
+            Drivers_Motor_SetMode((Motor_Control_Mode_t)dev->motor_mode);
+        }
+        Drivers_Motor_SetSpeed(dev->motor_speed);
+    }
+}
+
+/* 从配置存储恢复上次保存的设置（未保存过的项保持默认值） */
+static void Drivers_Manager_LoadSettings(void)
+{
+    RGB_Color color;
+    uint8_t value;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        if (ConfigStore_Get((ConfigKey_t)(CONFIG_KEY_LED_SLOT1 + i), &color, sizeof(color))) {
+            s_led_color_slots[i] = color;
+        }
+    }
+
+    if (s_status.rgb_led_ready) {
+        if (ConfigStore_Get(CONFIG_KEY_LED_BRIGHTNESS, &value, 1)) {
+            s_led_brightness = value;
+            led_apply_brightness(value);
+        }
+        if (ConfigStore_Get(CONFIG_KEY_LED_MODE, &value, 1) && value <= LED_MODE_AUTO) {
+            Drivers_RGBLED_SetMode((led_control_mode_t)value);
+        }
+    }
+
+    if (s_status.motor_ready &&
+        ConfigStore_Get(CONFIG_KEY_MOTOR_MODE, &value, 1) && value <= MOTOR_MODE_VENT) {
+        s_motor_mode = (Motor_Control_Mode_t)value;
+        drivers_cmd_post(CMD_MOTOR);  // 控制任务启动后输出
+    }
+
+    /* 恢复过程中的 setter 调用不需要写回 */
+    s_settings_dirty = 0;
+    Drivers_Manager_RestoreWarm();
+    drivers_state_publish();
+}
+
 bool Drivers_Manager_Init(void)
 {
     /* 初始化蜂鸣器 */
@@ -357,17 +855,36 @@ bool Drivers_Manager_Init(void)
     
     /* 初始化电机控制 */
     s_status.motor_ready = (Motor_Init() == MOTOR_OK);
+    if (s_status.motor_ready) {
+        s_motor_mode = Motor_GetControlMode();
+        s_motor_speed = Motor_GetSetpoint();
+    }
+    
+    /* 恢复保存的设置 */
+    Drivers_Manager_LoadSettings();
     
     /* 检查总体状态 */
     bool all_ok = s_status.buzzer_ready && 
                   s_status.rgb_led_ready && 
                   s_status.motor_ready;
     
-    if (all_ok && s_status.buzzer_ready) {
+    /* 热启动不播放启动音效 */
+    if (all_ok && s_status.buzzer_ready && !WarmStart_IsValid()) {
         Buzzer_StartupSound();
     }
     
-    return all_ok;
+    /* 创建输出控制任务 */
+    if (s_config_sub < 0) {
+        s_config_sub = RuntimeConfig_Subscribe(drivers_control_wake);
+    }
+    if (s_control_task == NULL) {
+        s_control_task = xTaskCreateStatic(Drivers_Control_Task, "output",
+                                           DRIVERS_CONTROL_TASK_STACK_SIZE, NULL,
+                                           DRIVERS_CONTROL_TASK_PRIORITY,
+                                           s_control_task_stack, &s_control_task_tcb);
+    }
+    
+    return all_ok && s_control_task != NULL;
 }
 
 Drivers_Status_t Drivers_Manager_GetStatus(void)
@@ -377,7 +894,144 @@ Drivers_Status_t Drivers_Manager_GetStatus(void)
 
 void Drivers_Manager_Update(void)
 {
+    /* 电机：自动模式跟随电位器，闭环时调节转速（告警接管时为手动设定值） */
     if (s_status.motor_ready) {
         Motor_Update();
     }
+    
+    /* LED：自动模式按光照调光（登记命令，本周期内执行） */
+    led_auto_step();
+    
+    /* 执行各任务登记的命令，外设只在本任务中访问 */
+    drivers_cmd_execute();
+    
+    /* 电位器调速、自动调光等由本任务产生的变化在此统一发布 */
+    drivers_state_publish();
+}
+
+/* ==================== 告警输出接口 ==================== */
+
+/* 设置告警输出，只对发生变化的设备登记命令 */
+void Drivers_Alarm_SetOutput(const Drivers_AlarmOutput_t *output)
+{
+    Drivers_AlarmOutput_t next = {0};
+    Drivers_AlarmOutput_t prev;
+
+    if (output != NULL) {
+        next = *output;
+    }
+
+    taskENTER_CRITICAL();
+    prev = s_alarm;
+    s_alarm = next;
+
+    /* 蜂鸣器 */
+    if (s_status.buzzer_ready) {
+        if (next.buzzer && (!prev.buzzer || next.buzzer_hz != prev.buzzer_hz)) {
+            drivers_cmd_buzzer_tone(next.buzzer_hz, next.sample_us);
+        } else if (!next.buzzer && prev.buzzer) {
+            drivers_cmd_buzzer_tone(0, 0);
+        }
+    }
+
+    /* RGB LED：告警颜色以最大亮度显示 */
+    if (s_status.rgb_led_ready) {
+        if (next.led && (!prev.led ||
+                         memcmp(&next.led_color, &prev.led_color, sizeof(RGB_Color)) != 0)) {
+            drivers_cmd_led_brightness(255);
+            drivers_cmd_led_color(next.led_color, false);
+        } else if (!next.led && prev.led) {
+            led_restore();
+        }
+    }
+
+    /* 电机：告警期间固定速度，解除后按用户模式恢复 */
+    if (s_status.motor_ready &&
+        (next.motor != prev.motor || (next.motor && next.motor_speed != prev.motor_speed))) {
+        drivers_cmd_post(CMD_MOTOR);
+    }
+    taskEXIT_CRITICAL();
+
+    drivers_state_publish();
+}
+
+bool Drivers_Alarm_GetOutput(Drivers_AlarmOutput_t *output)
+{
+    if (output != NULL) {
+        *output = s_alarm;
+    }
+    return s_alarm.buzzer || s_alarm.led || s_alarm.motor;
+}
+
+/* ==================== 设置持久化接口 ==================== */
+
+/* 把脏设置交给配置存储，返回是否有内容提交 */
+static bool Drivers_Settings_Store(void)
+{
+    uint8_t dirty;
+    uint8_t value;
+
+    taskENTER_CRITICAL();
+    dirty = s_settings_dirty;
+    s_settings_dirty = 0;
+    taskEXIT_CRITICAL();
+
+    if (dirty == 0) {
+        return false;
+    }
+
+    if (dirty & SETTING_LED_SLOTS) {
+        for (uint8_t i = 0; i < 3; i++) {
+            RGB_Color color = s_led_color_slots[i];
+            ConfigStore_Set((ConfigKey_t)(CONFIG_KEY_LED_SLOT1 + i), &color, sizeof(color));
+        }
+    }
+    if (dirty & SETTING_LED_BRIGHTNESS) {
+        value = s_led_brightness;
+        ConfigStore_Set(CONFIG_KEY_LED_BRIGHTNESS, &value, 1);
+    }
+    if (dirty & SETTING_LED_MODE) {
+        value = (uint8_t)s_led_mode;
+        ConfigStore_Set(CONFIG_KEY_LED_MODE, &value, 1);
+    }
+    if (dirty & SETTING_MOTOR_MODE) {
+        value = (uint8_t)s_motor_mode;
+        ConfigStore_Set(CONFIG_KEY_MOTOR_MODE, &value, 1);
+    }
+    return true;
+}
+
+void Drivers_Settings_Commit(void)
+{
+    if (Drivers_Settings_Store()) {
+        ConfigStore_RequestFlush();
+    }
+}
+
+void Drivers_Settings_Process(void)
+{
+    uint32_t now = HAL_GetTick();
+    bool idle;
+
+    if (s_power_fail) {
+        /* 掉电预警：不再等待，直接同步写入 EEPROM */
+        s_power_fail = false;
+        Drivers_Settings_Store();
+        ConfigStore_Flush();
+        return;
+    }
+
+    taskENTER_CRITICAL();
+    idle = s_settings_dirty != 0 &&
+           now - s_settings_changed_tick >= DRIVERS_SETTINGS_COMMIT_MS;
+    taskEXIT_CRITICAL();
+
+    if (idle) {
+        Drivers_Settings_Commit();
+    }
+}
+
+void Drivers_Settings_OnPowerFail(void)
+{
+    s_power_fail = true;
 }
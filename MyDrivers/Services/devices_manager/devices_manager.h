@@ -4,6 +4,9 @@
  * @brief   外设设备统一管理器头文件
  * @details 提供蜂鸣器、RGB LED、电机的统一初始化和控制接口
  *          封装底层驱动，为上层应用（如 Dashboard）提供简洁的调用接口
+ *          控制接口只更新逻辑状态并登记命令，外设寄存器只在输出控制任务中
+ *          访问：命令在下一个控制周期（DRIVERS_CONTROL_PERIOD_MS 内）执行，
+ *          同类命令只执行最新的一次（如滑块连续拖动时的亮度）
  * @author  EnviroSense Team
  * @date    2025
  ******************************************************************************
@@ -13,6 +16,7 @@
 #define __DEVICES_MANAGER_H
 
 #include "main.h"
+#include "task_plan.h"
 #include <stdbool.h>
 #include "buzzer.h"
 #include "rgbled.h"
@@ -22,6 +26,13 @@
 extern "C" {
 #endif
 
+/* ==================== 系统配置 ==================== */
+#define DRIVERS_SETTINGS_COMMIT_MS  1000    /**< 设置停止修改多久后提交写入 */
+#define DRIVERS_CONTROL_PERIOD_MS   10      /**< 输出控制任务周期 (100 Hz) */
+#define DRIVERS_CONTROL_TASK_STACK_SIZE 192 /**< 输出控制任务栈大小 (单位: 字) */
+#define DRIVERS_CONTROL_TASK_PRIORITY   TASK_PRIO_OUTPUT /**< 输出控制任务优先级 (即 osPriorityNormal) */
+#define DRIVERS_LED_FADE_MS         300     /**< 槽位切换时 LED 颜色渐变时长 */
+
 /* ==================== 数据结构定义 ==================== */
 
 /**
@@ -53,6 +64,26 @@ typedef enum {
     LED_MODE_AUTO           /**< 自动模式：根据光照传感器自动调节 */
 } led_control_mode_t;
 
+/* ==================== 状态快照 ==================== */
+
+/**
+ * @brief  设备状态快照（供 UI 一次读取一致的状态）
+ * @note   由 Drivers_GetState() 整体复制，字段之间保证来自同一次发布
+ */
+typedef struct {
+    uint32_t version;                   /**< 发布计数，状态变化时递增 */
+    led_control_mode_t led_mode;        /**< LED 控制模式 */
+    led_manual_state_t led_manual_state;/**< 手动模式当前槽位 */
+    RGB_Color led_slots[3];             /**< 三个槽位的颜色 */
+    RGB_Color led_color;                /**< LED 当前颜色（未经亮度缩放），未初始化时为 COLOR_OFF */
+    uint8_t led_brightness;             /**< 用户设置的亮度 */
+    uint8_t led_auto_brightness;        /**< 自动调光当前亮度 */
+    Motor_Control_Mode_t motor_mode;    /**< 电机模式（告警接管时为解除后恢复的模式） */
+    uint16_t motor_speed;               /**< 电机当前 PWM 占空比 */
+    uint16_t motor_setpoint;            /**< 电机设定值 */
+    bool alarm_active;                  /**< 是否有告警输出接管设备 */
+} Drivers_State_t;
+
 /* ==================== 系统管理接口 ==================== */
 
 /**
@@ -62,6 +93,8 @@ typedef enum {
  * @note   会依次初始化蜂鸣器、RGB LED、电机
  * @note   即使部分设备失败，其他设备仍可正常使用
  * @note   初始化成功后会播放启动音效（如果蜂鸣器可用）
+ * @note   创建输出控制任务：有自动调速/调光等周期工作时以 DRIVERS_CONTROL_PERIOD_MS
+ *         周期调用 Drivers_Manager_Update()，否则阻塞到有新命令
  * @note   应在 FreeRTOS 任务启动前调用（建议在 main.c 或 sensor_app.c 中）
  */
 bool Drivers_Manager_Init(void);
@@ -73,6 +106,21 @@ bool Drivers_Manager_Init(void);
  */
 Drivers_Status_t Drivers_Manager_GetStatus(void);
 
+/**
+ * @brief  读取设备状态快照
+ * @param  state: 输出缓冲区
+ * @retval uint32_t: 快照的版本号（即 state->version）
+ * @note   无锁读取，可在任意任务中调用（不可在中断中调用）；各 setter 与
+ *         输出控制任务在状态变化后整体发布一次，读到的字段彼此一致
+ */
+uint32_t Drivers_GetState(Drivers_State_t *state);
+
+/**
+ * @brief  获取当前状态版本号
+ * @retval uint32_t: 与上次读取相同时说明状态未变化，UI 可跳过刷新
+ */
+uint32_t Drivers_GetStateVersion(void);
+
 /* ==================== 蜂鸣器控制接口 ==================== */
 
 /**
@@ -93,7 +141,7 @@ void Drivers_Buzzer_Off(void);
 
 /**
  * @brief  播放简短的哔声（1000Hz，100ms）
- * @note   ⚠️ 使用 osDelay 实现延时，仅能在任务上下文调用
+ * @note   异步播放，立即返回；正在播放其他音效或报警时被丢弃
  * @note   适用于按键反馈、操作确认等场景
  * @see    Buzzer_Beep
  */
@@ -135,6 +183,7 @@ void Drivers_RGBLED_SetColor(RGB_Color color);
  * @brief  获取当前 RGB LED 颜色
  * @retval RGB_Color: 当前颜色值，未初始化时返回 COLOR_OFF
  * @note   返回的是原始颜色值（未经亮度缩放）
+ * @note   为实际输出的颜色，刚调用的 setter 在下一个控制周期后才反映出来
  * @see    RGB_LED_GetCurrentColor
  */
 RGB_Color Drivers_RGBLED_GetColor(void);
@@ -145,8 +194,9 @@ RGB_Color Drivers_RGBLED_GetColor(void);
  * @param  color: RGB_Color 结构体
  * @retval true: 设置成功
  * @retval false: 槽位索引无效
- * @note   设置后立即生效（如果当前处于该槽位）
- * @note   颜色会保存到内存，但不会自动持久化
+ * @note   如果当前处于该槽位，下一个控制周期生效
+ * @note   只标记设置已修改，停止修改 DRIVERS_SETTINGS_COMMIT_MS 后在后台
+ *         写入 EEPROM，重启后恢复
  * @note   示例：
  *         @code
  *         Drivers_RGBLED_SetSlotColor(1, COLOR_PURPLE);  // 槽位1设为紫色
@@ -164,11 +214,18 @@ bool Drivers_RGBLED_SetSlotColor(uint8_t slot, RGB_Color color);
  */
 bool Drivers_RGBLED_GetSlotColor(uint8_t slot, RGB_Color *color);
 
+/**
+ * @brief  将三个槽位恢复为默认颜色（红/绿/蓝）
+ * @note   不改变 LED 当前输出，调用方需自行刷新
+ */
+void Drivers_RGBLED_ResetSlotColors(void);
+
 /**
  * @brief  设置 RGB LED 亮度
  * @param  brightness: 亮度值（0-255），0=关闭，255=最亮
  * @note   仅在 RGB LED 初始化成功时生效
- * @note   会立即应用到当前颜色
+ * @note   下一个控制周期应用到当前颜色，连续调用只执行最后一次
+ * @note   可在滑块回调中高频调用，持久化由后台写回完成
  * @see    RGB_LED_SetBrightness
  */
 void Drivers_RGBLED_SetBrightness(uint8_t brightness);
@@ -206,8 +263,8 @@ led_manual_state_t Drivers_RGBLED_GetManualState(void);
 /**
  * @brief  根据光照值自动调节 LED（自动模式专用）
  * @param  lux: 光照强度（来自 GY30 传感器）
- * @note   ⚠️ 仅在自动模式下生效
- * @note   应在数据更新定时器中调用
+ * @note   只记录光照值，由输出控制任务在自动模式下按步长平滑调节亮度
+ * @note   在传感器数据更新时调用（GY30 事件回调）
  * @note   调节规则：
  *         - lux < 50:  最亮暖白色（亮度 255）
  *         - 50-200:    中等亮度（亮度 150）
@@ -230,6 +287,7 @@ void Drivers_RGBLED_SetManualSlot(uint8_t slot);
  * @param  mode: 控制模式
  *               - MOTOR_MODE_AUTO: 速度由电位器 ADC 值决定
  *               - MOTOR_MODE_MANUAL: 速度由 Drivers_Motor_SetSpeed() 设置
+ *               - MOTOR_MODE_VENT: 速度由通风联动 (Drivers_Motor_SetVentSpeed) 设置
  * @note   仅在电机初始化成功时生效
  * @note   切换到自动模式时会立即根据电位器值更新速度
  * @see    Motor_SetControlMode
@@ -247,11 +305,20 @@ Motor_Control_Mode_t Drivers_Motor_GetMode(void);
  * @brief  手动设置电机速度
  * @param  speed: PWM 占空比（0-999），0=停止，999=最大速度
  * @note   ⚠️ 仅在手动模式（MOTOR_MODE_MANUAL）下生效
- * @note   在自动模式下调用无效（会被电位器值覆盖）
+ * @note   在自动模式下调用无效（会被电位器值覆盖）；告警接管期间只保存，
+ *         解除后生效
  * @see    Motor_SetSpeed
  */
 void Drivers_Motor_SetSpeed(uint16_t speed);
 
+/**
+ * @brief  设置通风联动请求的速度
+ * @param  speed: PWM 占空比（0-999）
+ * @note   由传感器任务中的通风曲线调用；始终保存最近的请求，仅在
+ *         通风模式 (MOTOR_MODE_VENT) 且无告警接管时输出
+ */
+void Drivers_Motor_SetVentSpeed(uint16_t speed);
+
 /**
  * @brief  获取电机当前速度
  * @retval uint16_t: 当前 PWM 占空比（0-999），未初始化时返回 0
@@ -273,24 +340,66 @@ uint16_t Drivers_Motor_GetPotValue(void);
 
 /**
  * @brief  周期性更新设备状态
- * @note   应在 FreeRTOS 任务中以 50-100ms 周期调用
+ * @note   由输出控制任务以 DRIVERS_CONTROL_PERIOD_MS 周期调用，其他地方无需调用
  * @note   当前功能：
  *         - 更新电机速度（自动模式下根据电位器值调速）
- *         - 预留其他设备的周期性任务接口
- * @note   示例：
- *         @code
- *         void VerificationTask_Entry(void const *argument)
- *         {
- *             for(;;)
- *             {
- *                 Drivers_Manager_Update();
- *                 osDelay(100);
- *             }
- *         }
- *         @endcode
+ *         - 自动模式下按光照值调节 LED 亮度
+ *         - 执行各任务登记的设备命令
  */
 void Drivers_Manager_Update(void);
 
+/* ==================== 告警输出接口 ==================== */
+
+/**
+ * @brief  告警输出（由传感器告警引擎按激活的规则合成）
+ */
+typedef struct {
+    bool buzzer;            // 蜂鸣器持续鸣响
+    uint16_t buzzer_hz;     // 鸣响频率
+    bool led;               // LED 以最大亮度显示告警颜色
+    RGB_Color led_color;    // 告警颜色
+    bool motor;             // 电机以固定速度运行（如排风）
+    uint16_t motor_speed;   // PWM 占空比（0-999）
+    uint64_t sample_us;     // 引起本次输出的样本时刻（延迟统计，0 表示无）
+} Drivers_AlarmOutput_t;
+
+/**
+ * @brief  设置告警输出
+ * @param  output: 新的告警输出，NULL 表示全部解除
+ * @note   只对发生变化的设备登记命令。激活期间 LED / 电机的用户设置照常
+ *         保存，但不改变实际输出；解除后恢复到当前的手动/自动状态
+ * @note   可在传感器任务中调用
+ */
+void Drivers_Alarm_SetOutput(const Drivers_AlarmOutput_t *output);
+
+/**
+ * @brief  获取当前告警输出
+ * @param  output: 输出缓冲区，可为 NULL
+ * @retval bool: 是否有任何告警输出处于激活状态
+ */
+bool Drivers_Alarm_GetOutput(Drivers_AlarmOutput_t *output);
+
+/* ==================== 设置持久化接口 ==================== */
+
+/**
+ * @brief  后台写回：设置停止修改 DRIVERS_SETTINGS_COMMIT_MS 后提交
+ * @note   在监控任务中周期调用；掉电预警后会同步写入 EEPROM（阻塞数十毫秒）
+ */
+void Drivers_Settings_Process(void);
+
+/**
+ * @brief  立即提交已修改的设置（不等待空闲时间）
+ * @note   离开设置页面时调用，只修改内存，实际写入仍在监控任务中完成
+ */
+void Drivers_Settings_Commit(void);
+
+/**
+ * @brief  掉电预警通知
+ * @note   可在中断中调用，只设置标志；调用方需唤醒监控任务执行
+ *         Drivers_Settings_Process()
+ */
+void Drivers_Settings_OnPowerFail(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,212 @@
+/**
+ ******************************************************************************
+ * @file    energy_meter.c
+ * @brief   分子系统能耗统计实现
+ * @details 负载按"电平保持时间"积分：每次电平变化时先把旧电平积分到当前时刻，
+ *          再记下新电平与时刻，关中断几微秒完成，可在蜂鸣器播放中断中调用。
+ *          任务电荷按系统监控快照中各任务的 CPU 占比 (0.1%) 乘以快照间隔计算，
+ *          任务表按名称匹配，已删除任务的累计值保留。
+ *          电荷单位 uA*ms，64 位累计不会溢出。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "energy_meter.h"
+#include "power_manager.h"
+#include "sys_clock.h"
+#include "main.h"
+#include "task.h"
+#include <string.h>
+
+#ifndef configIDLE_TASK_NAME
+#define configIDLE_TASK_NAME "IDLE" // 与 tasks.c 中的默认值一致
+#endif
+
+/* --------------------------- 私有变量 --------------------------- */
+
+/* 各负载名称与满载电流 (按 EnergyRail_t 顺序) */
+static const struct {
+  const char *name;
+  uint32_t current_ua;
+} s_rail_cfg[ENERGY_RAIL_COUNT] = {
+    [ENERGY_RAIL_BOARD] = {"board", ENERGY_I_BOARD_UA},
+    [ENERGY_RAIL_BACKLIGHT] = {"backlight", ENERGY_I_BACKLIGHT_UA},
+    [ENERGY_RAIL_MOTOR] = {"motor", ENERGY_I_MOTOR_UA},
+    [ENERGY_RAIL_BUZZER] = {"buzzer", ENERGY_I_BUZZER_UA},
+    [ENERGY_RAIL_RADIO] = {"radio", ENERGY_I_RADIO_UA},
+};
+
+/* 负载状态 (关中断访问)；板级基础电流从上电起一直计入 */
+static uint16_t s_level[ENERGY_RAIL_COUNT] = {[ENERGY_RAIL_BOARD] = 1000};
+static uint64_t s_since_us[ENERGY_RAIL_COUNT]; // 当前电平开始的时刻
+static uint64_t s_rail_charge[ENERGY_RAIL_COUNT];
+static uint64_t s_reset_us;
+
+/* 任务电荷 (调度器锁保护) */
+static EnergyItem_t s_tasks[ENERGY_MAX_TASKS];
+static uint8_t s_task_count;
+static uint64_t s_cpu_sleep;
+static uint64_t s_cpu_other;
+
+/* 仅系统监控任务访问 */
+static uint32_t s_last_snapshot_ms;
+static bool s_has_snapshot = false;
+static uint32_t s_last_slept_ms;
+static SysMonitor_Snapshot_t s_snapshot;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/* 把负载的当前电平积分到 now (调用方已关中断) */
+static void energy_integrate(EnergyRail_t rail, uint64_t now) {
+  uint64_t dt = now - s_since_us[rail];
+
+  // 先换算到 uA*ms 再乘电平，长时间不变的电平 (板级电流) 也不会溢出
+  s_rail_charge[rail] +=
+      dt * s_rail_cfg[rail].current_ua / 1000U * s_level[rail] / 1000U;
+  s_since_us[rail] = now;
+}
+
+/* 查找或新建任务项，任务表已满时返回 NULL */
+static EnergyItem_t *energy_task_item(const char *name) {
+  for (uint8_t i = 0; i < s_task_count; i++) {
+    if (strncmp(s_tasks[i].name, name, sizeof(s_tasks[i].name)) == 0) {
+      return &s_tasks[i];
+    }
+  }
+  if (s_task_count >= ENERGY_MAX_TASKS) {
+    return NULL;
+  }
+  memset(&s_tasks[s_task_count], 0, sizeof(s_tasks[0]));
+  strncpy(s_tasks[s_task_count].name, name, sizeof(s_tasks[0].name) - 1);
+  return &s_tasks[s_task_count++];
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 上报负载电平变化
+ */
+void Energy_SetLevel(EnergyRail_t rail, uint16_t level) {
+  uint32_t primask;
+  uint64_t now;
+
+  if ((unsigned)rail >= ENERGY_RAIL_COUNT) {
+    return;
+  }
+  if (level > 1000) {
+    level = 1000;
+  }
+  now = SysClock_Micros();
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  energy_integrate(rail, now);
+  s_level[rail] = level;
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 按系统监控快照累计 CPU 电荷
+ * @details 快照中的占比覆盖两次采样之间的整段时间；空闲任务的时间再按
+ *          睡眠统计拆成 WFI 睡眠与空转两部分
+ */
+void Energy_Update(void) {
+  PowerStats_t power;
+  uint32_t dt_ms;
+  uint32_t slept_ms;
+
+  if (!SysMonitor_GetSnapshot(&s_snapshot) ||
+      (s_has_snapshot && s_snapshot.timestamp == s_last_snapshot_ms)) {
+    return;
+  }
+  dt_ms = s_has_snapshot ? s_snapshot.timestamp - s_last_snapshot_ms
+                         : SYS_MONITOR_PERIOD_MS;
+  s_last_snapshot_ms = s_snapshot.timestamp;
+  s_has_snapshot = true;
+
+  Power_GetStats(&power);
+  slept_ms = power.slept_ms - s_last_slept_ms;
+  s_last_slept_ms = power.slept_ms;
+
+  vTaskSuspendAll();
+  for (uint8_t i = 0; i < s_snapshot.task_count; i++) {
+    const SysMonitor_Task_t *task = &s_snapshot.tasks[i];
+    uint32_t run_ms = (uint32_t)((uint64_t)task->cpu_permille * dt_ms / 1000U);
+    EnergyItem_t *item = energy_task_item(task->name);
+    uint64_t *charge = item != NULL ? &item->charge : &s_cpu_other;
+
+    if (strcmp(task->name, configIDLE_TASK_NAME) == 0) {
+      uint32_t sleep_ms = slept_ms < run_ms ? slept_ms : run_ms;
+
+      s_cpu_sleep += (uint64_t)sleep_ms * ENERGY_I_CPU_SLEEP_UA;
+      run_ms -= sleep_ms;
+    }
+    *charge += (uint64_t)run_ms * ENERGY_I_CPU_RUN_UA;
+  }
+  (void)xTaskResumeAll();
+}
+
+/**
+ * @brief 清零全部累计值
+ */
+void Energy_Reset(void) {
+  uint64_t now = SysClock_Micros();
+  uint32_t primask;
+
+  vTaskSuspendAll();
+  memset(s_tasks, 0, sizeof(s_tasks));
+  s_task_count = 0;
+  s_cpu_sleep = 0;
+  s_cpu_other = 0;
+  (void)xTaskResumeAll();
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  for (int r = 0; r < ENERGY_RAIL_COUNT; r++) {
+    s_rail_charge[r] = 0;
+    s_since_us[r] = now;
+  }
+  s_reset_us = now;
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 获取统计快照
+ */
+void Energy_GetStats(EnergyStats_t *stats) {
+  uint64_t now = SysClock_Micros();
+  uint32_t primask;
+
+  if (stats == NULL) {
+    return;
+  }
+  memset(stats, 0, sizeof(*stats));
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  for (int r = 0; r < ENERGY_RAIL_COUNT; r++) {
+    energy_integrate((EnergyRail_t)r, now);
+    stats->rails[r].level = s_level[r];
+    stats->rails[r].charge = s_rail_charge[r];
+  }
+  stats->elapsed_ms = (uint32_t)((now - s_reset_us) / 1000U);
+  __set_PRIMASK(primask);
+
+  vTaskSuspendAll();
+  memcpy(stats->tasks, s_tasks, sizeof(s_tasks));
+  stats->task_count = s_task_count;
+  stats->cpu_sleep = s_cpu_sleep;
+  stats->cpu_other = s_cpu_other;
+  (void)xTaskResumeAll();
+
+  stats->total = stats->cpu_sleep + stats->cpu_other;
+  for (int r = 0; r < ENERGY_RAIL_COUNT; r++) {
+    strncpy(stats->rails[r].name, s_rail_cfg[r].name,
+            sizeof(stats->rails[r].name) - 1);
+    stats->total += stats->rails[r].charge;
+  }
+  for (uint8_t i = 0; i < stats->task_count; i++) {
+    stats->total += stats->tasks[i].charge;
+  }
+}
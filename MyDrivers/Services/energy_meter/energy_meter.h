@@ -0,0 +1,107 @@
+/**
+ ******************************************************************************
+ * @file    energy_meter.h
+ * @brief   分子系统能耗统计
+ * @details 按配置表中的近似电流，把各耗电状态的持续时间积分为电荷量 (mAh)，
+ *          用于在设备上直接比较无节拍空闲、调暗背光、自适应采样等优化的效果：
+ *            - 负载 (背光、电机、蜂鸣器、无线模块) 由驱动在输出变化时调用
+ *              Energy_SetLevel() 上报千分比，按"电平 x 时间"精确积分，
+ *              与查询周期无关，短促的提示音也不会漏计；
+ *            - CPU 按任务统计：系统监控每次采样后调用 Energy_Update()，
+ *              按各任务的 CPU 占比 (运行时统计) 计入运行电流，空闲任务中
+ *              WFI 睡眠的时间 (Power_GetStats) 单独按睡眠电流计入 "sleep"；
+ *            - 板级基础电流 (LCD 逻辑、传感器、稳压器静态电流) 按时间计入。
+ *          电流为典型值，只用于相对比较；Energy_Reset() 后重新开始累计，
+ *          命令行 energy 输出各项电荷量与平均电流。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __ENERGY_METER_H
+#define __ENERGY_METER_H
+
+#include "FreeRTOS.h"
+#include "sys_monitor.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+/* 各状态的近似电流 (uA，负载为千分比 1000 时的值，与电平成正比) */
+#define ENERGY_I_BOARD_UA 25000      // 板级基础电流 (始终计入)
+#define ENERGY_I_CPU_RUN_UA 60000    // 168 MHz 运行 (外设时钟开启)
+#define ENERGY_I_CPU_SLEEP_UA 20000  // WFI 睡眠模式
+#define ENERGY_I_BACKLIGHT_UA 120000 // 背光 100%
+#define ENERGY_I_MOTOR_UA 180000     // 风扇占空比 100%
+#define ENERGY_I_BUZZER_UA 30000     // 蜂鸣器发声
+#define ENERGY_I_RADIO_UA 80000      // Wi-Fi 模块开启 (平均值)
+#define ENERGY_MAX_TASKS SYS_MONITOR_MAX_TASKS // 单独统计的任务数 (超出部分计入 other)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 按电平积分的负载
+ */
+typedef enum {
+  ENERGY_RAIL_BOARD = 0, // 板级基础电流
+  ENERGY_RAIL_BACKLIGHT, // LCD 背光 (亮度)
+  ENERGY_RAIL_MOTOR,     // 风扇电机 (PWM 占空比)
+  ENERGY_RAIL_BUZZER,    // 蜂鸣器 (发声/静音)
+  ENERGY_RAIL_RADIO,     // Wi-Fi 模块 (开启/关闭)
+  ENERGY_RAIL_COUNT
+} EnergyRail_t;
+
+/**
+ * @brief 单项电荷量
+ */
+typedef struct {
+  char name[configMAX_TASK_NAME_LEN];
+  uint16_t level;    // 当前电平 (千分比，任务项为 0)
+  uint64_t charge;   // 累计电荷量 (uA*ms，1 mAh = 3.6e9)
+} EnergyItem_t;
+
+/**
+ * @brief 能耗统计快照
+ */
+typedef struct {
+  uint32_t elapsed_ms;                 // 累计时长 (上电或 Energy_Reset 以来)
+  EnergyItem_t rails[ENERGY_RAIL_COUNT];
+  EnergyItem_t tasks[ENERGY_MAX_TASKS]; // 各任务的 CPU 运行电荷
+  uint8_t task_count;
+  uint64_t cpu_sleep;                  // 空闲任务中 WFI 睡眠的电荷
+  uint64_t cpu_other;                  // 超出任务表的任务的电荷
+  uint64_t total;                      // 以上全部之和
+} EnergyStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 上报负载电平变化 (任意上下文，包括中断)
+ * @param level 千分比 (0 关闭，1000 满载)，超出时按 1000 计
+ */
+void Energy_SetLevel(EnergyRail_t rail, uint16_t level);
+
+/**
+ * @brief 按最近一次系统监控快照累计 CPU 电荷
+ * @note  只由系统监控任务在 SysMonitor_Update() 之后调用
+ */
+void Energy_Update(void);
+
+/**
+ * @brief 清零全部累计值 (负载保持当前电平)
+ */
+void Energy_Reset(void);
+
+/**
+ * @brief 获取统计快照 (负载积分到当前时刻)
+ */
+void Energy_GetStats(EnergyStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ENERGY_METER_H */
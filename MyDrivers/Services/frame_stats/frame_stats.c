@@ -0,0 +1,278 @@
+/**
+ ******************************************************************************
+ * @file    frame_stats.c
+ * @brief   LVGL 帧统计源文件
+ * @details 除 FrameStats_FlushDone 外所有钩子都运行在 LVGL 任务中，累加器
+ *          无需保护；flush 累加器由 DMA 中断更新，换窗口时关中断取走。
+ *          渲染耗时 = 刷新定时器回调总耗时 - 其中等待 DMA 的时间，
+ *          只有确实重绘了像素的刷新才计入统计。
+ *          逐帧记录只由 LVGL 任务写入，写完一帧后才递增计数，读者只读取
+ *          计数以内的帧。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "frame_stats.h"
+#include "main.h"
+#include "metrics.h"
+#include "profiler.h"
+#include <string.h>
+
+/* --------------------------- 私有变量 --------------------------- */
+
+// LVGL 任务侧累加器
+static struct {
+  uint32_t window_start; // ms
+  uint32_t refr_start;   // 当前刷新的起始周期
+  uint32_t refr_wait;    // 当前刷新中累计的等待周期
+  uint32_t refr_px;      // 当前刷新重绘的像素数
+  uint32_t refr_inv_px;  // 当前刷新合并前的失效面积
+  uint8_t refr_inv_areas; // 当前刷新合并前的失效区域数
+  bool in_refr;
+  uint32_t refr_count;
+  uint64_t render_sum;
+  uint32_t render_max;
+  uint64_t wait_sum;
+  uint64_t px_sum;
+  uint32_t px_last;
+  uint32_t loop_count;
+  uint64_t handler_sum;
+  uint32_t handler_max;
+  uint64_t idle_sum;
+  uint32_t cache_hit[FRAME_STATS_CACHE_MAX];
+  uint32_t cache_miss[FRAME_STATS_CACHE_MAX];
+  uint32_t cache_hit_total[FRAME_STATS_CACHE_MAX];
+  uint32_t cache_miss_total[FRAME_STATS_CACHE_MAX];
+} g_acc;
+
+// 中断侧累加器 (flush 完成)
+static volatile uint32_t g_flush_count = 0;
+static volatile uint32_t g_flush_sum = 0;
+static volatile uint32_t g_flush_max = 0;
+
+static FrameStats_t g_stats;
+static bool g_stats_valid = false;
+
+// 逐帧抓取
+static FrameStatsFrame_t g_capture[FRAME_STATS_CAPTURE_SIZE];
+static volatile uint16_t g_capture_count = 0;
+static volatile uint16_t g_capture_target = 0;
+static uint8_t g_capture_tag = 0;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static uint32_t frame_cycles_to_us(uint64_t cycles, uint32_t n) {
+  uint32_t cycles_per_us = SystemCoreClock / 1000000u;
+  if (n == 0 || cycles_per_us == 0)
+    return 0;
+  return (uint32_t)(cycles / ((uint64_t)n * cycles_per_us));
+}
+
+static void frame_publish(uint32_t window_ms) {
+  FrameStats_t s;
+  uint32_t flush_count, flush_sum, flush_max;
+  uint32_t primask;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  flush_count = g_flush_count;
+  flush_sum = g_flush_sum;
+  flush_max = g_flush_max;
+  g_flush_count = 0;
+  g_flush_sum = 0;
+  g_flush_max = 0;
+  __set_PRIMASK(primask);
+
+  uint64_t window_cycles =
+      (uint64_t)window_ms * (SystemCoreClock / 1000u);
+
+  s.window_ms = window_ms;
+  s.refr_rate_x10 = (uint16_t)(g_acc.refr_count * 10000u / window_ms);
+  s.loop_rate = (uint16_t)(g_acc.loop_count * 1000u / window_ms);
+  s.idle_permille =
+      window_cycles ? (uint16_t)(g_acc.idle_sum * 1000u / window_cycles) : 0;
+  s.render_us_avg = frame_cycles_to_us(g_acc.render_sum, g_acc.refr_count);
+  s.render_us_max = frame_cycles_to_us(g_acc.render_max, 1);
+  s.wait_us_avg = frame_cycles_to_us(g_acc.wait_sum, g_acc.refr_count);
+  s.flush_us_avg = frame_cycles_to_us(flush_sum, flush_count);
+  s.flush_us_max = frame_cycles_to_us(flush_max, 1);
+  s.px_avg = g_acc.refr_count ? (uint32_t)(g_acc.px_sum / g_acc.refr_count) : 0;
+  s.px_last = g_acc.px_last;
+  s.handler_us_avg = frame_cycles_to_us(g_acc.handler_sum, g_acc.loop_count);
+  s.handler_us_max = frame_cycles_to_us(g_acc.handler_max, 1);
+  memcpy(s.cache_hit, g_acc.cache_hit, sizeof(s.cache_hit));
+  memcpy(s.cache_miss, g_acc.cache_miss, sizeof(s.cache_miss));
+  memcpy(s.cache_hit_total, g_acc.cache_hit_total, sizeof(s.cache_hit_total));
+  memcpy(s.cache_miss_total, g_acc.cache_miss_total,
+         sizeof(s.cache_miss_total));
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  g_stats = s;
+  g_stats_valid = true;
+  __set_PRIMASK(primask);
+
+  // 除 px_last 与缓存累计计数外清零，开始新窗口
+  uint32_t px_last = g_acc.px_last;
+  g_acc.refr_count = 0;
+  g_acc.render_sum = 0;
+  g_acc.render_max = 0;
+  g_acc.wait_sum = 0;
+  g_acc.px_sum = 0;
+  g_acc.px_last = px_last;
+  g_acc.loop_count = 0;
+  g_acc.handler_sum = 0;
+  g_acc.handler_max = 0;
+  g_acc.idle_sum = 0;
+  memset(g_acc.cache_hit, 0, sizeof(g_acc.cache_hit));
+  memset(g_acc.cache_miss, 0, sizeof(g_acc.cache_miss));
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+void FrameStats_RefreshBegin(void) {
+  g_acc.refr_start = prof_now();
+  g_acc.refr_wait = 0;
+  g_acc.refr_px = 0;
+  g_acc.refr_inv_px = 0;
+  g_acc.refr_inv_areas = 0;
+  g_acc.in_refr = true;
+}
+
+void FrameStats_RefreshAreas(uint8_t areas, uint32_t px) {
+  g_acc.refr_inv_areas = areas;
+  g_acc.refr_inv_px = px;
+}
+
+void FrameStats_RefreshPixels(uint32_t px) {
+  // lv_refr_now() 等绕过刷新定时器的刷新没有起点，不予统计
+  if (g_acc.in_refr)
+    g_acc.refr_px += px;
+}
+
+void FrameStats_RefreshEnd(void) {
+  if (!g_acc.in_refr)
+    return;
+  g_acc.in_refr = false;
+
+  // 没有重绘的刷新只做了布局检查，不计入帧数
+  if (g_acc.refr_px == 0)
+    return;
+
+  uint32_t total = prof_now() - g_acc.refr_start;
+  uint32_t render = total > g_acc.refr_wait ? total - g_acc.refr_wait : 0;
+
+  g_acc.refr_count++;
+  g_acc.render_sum += render;
+  if (render > g_acc.render_max)
+    g_acc.render_max = render;
+  g_acc.wait_sum += g_acc.refr_wait;
+  g_acc.px_sum += g_acc.refr_px;
+  g_acc.px_last = g_acc.refr_px;
+  METRIC_OBSERVE(METRIC_LV_RENDER, frame_cycles_to_us(render, 1));
+
+  uint16_t n = g_capture_count;
+  if (n < g_capture_target) {
+    FrameStatsFrame_t *f = &g_capture[n];
+    f->time_ms = HAL_GetTick();
+    f->render_us = frame_cycles_to_us(render, 1);
+    f->wait_us = frame_cycles_to_us(g_acc.refr_wait, 1);
+    f->px = g_acc.refr_px;
+    f->inv_px = g_acc.refr_inv_px;
+    f->inv_areas = g_acc.refr_inv_areas;
+    f->tag = g_capture_tag;
+    g_capture_count = n + 1;
+  }
+}
+
+void FrameStats_AddWait(uint32_t cycles) { g_acc.refr_wait += cycles; }
+
+void FrameStats_FlushDone(uint32_t cycles) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  g_flush_count++;
+  g_flush_sum += cycles;
+  if (cycles > g_flush_max)
+    g_flush_max = cycles;
+  __set_PRIMASK(primask);
+  METRIC_OBSERVE(METRIC_LV_FLUSH, frame_cycles_to_us(cycles, 1));
+}
+
+void FrameStats_CacheEvent(FrameStatsCache_t cache, bool hit) {
+  static const MetricId_t metric[FRAME_STATS_CACHE_MAX][2] = {
+      [FRAME_STATS_CACHE_IMG] = {METRIC_LV_IMG_MISS, METRIC_LV_IMG_HIT},
+      [FRAME_STATS_CACHE_SHADOW] = {METRIC_LV_SHADOW_MISS,
+                                    METRIC_LV_SHADOW_HIT}};
+
+  if (cache >= FRAME_STATS_CACHE_MAX)
+    return;
+  METRIC_INC(metric[cache][hit]);
+  if (hit) {
+    g_acc.cache_hit[cache]++;
+    g_acc.cache_hit_total[cache]++;
+  } else {
+    g_acc.cache_miss[cache]++;
+    g_acc.cache_miss_total[cache]++;
+  }
+}
+
+void FrameStats_LoopDone(uint32_t handler_cycles, uint32_t idle_cycles) {
+  uint32_t now = HAL_GetTick();
+
+  g_acc.loop_count++;
+  g_acc.handler_sum += handler_cycles;
+  if (handler_cycles > g_acc.handler_max)
+    g_acc.handler_max = handler_cycles;
+  g_acc.idle_sum += idle_cycles;
+
+  if (g_acc.window_start == 0) {
+    g_acc.window_start = now;
+    return;
+  }
+  uint32_t window_ms = now - g_acc.window_start;
+  if (window_ms >= FRAME_STATS_WINDOW_MS) {
+    frame_publish(window_ms);
+    g_acc.window_start = now;
+  }
+}
+
+bool FrameStats_Get(FrameStats_t *out) {
+  bool valid;
+  uint32_t primask;
+
+  if (out == NULL)
+    return false;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  valid = g_stats_valid;
+  if (valid)
+    *out = g_stats;
+  __set_PRIMASK(primask);
+  return valid;
+}
+
+void FrameStats_SetTag(uint8_t tag) { g_capture_tag = tag; }
+
+void FrameStats_CaptureStart(uint16_t frames) {
+  if (frames == 0 || frames > FRAME_STATS_CAPTURE_SIZE)
+    frames = FRAME_STATS_CAPTURE_SIZE;
+  // 先停止再清零，LVGL 任务不会在两步之间写入
+  g_capture_target = 0;
+  g_capture_count = 0;
+  g_capture_target = frames;
+}
+
+uint16_t FrameStats_CaptureCount(uint16_t *target) {
+  if (target != NULL)
+    *target = g_capture_target;
+  return g_capture_count;
+}
+
+bool FrameStats_CaptureGet(uint16_t i, FrameStatsFrame_t *out) {
+  if (out == NULL || i >= g_capture_count)
+    return false;
+  *out = g_capture[i];
+  return true;
+}
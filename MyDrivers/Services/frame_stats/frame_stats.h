@@ -0,0 +1,169 @@
+/**
+ ******************************************************************************
+ * @file    frame_stats.h
+ * @brief   LVGL 帧统计头文件
+ * @details 统计 LVGL 主循环的时间分布：每次刷新的渲染耗时、等待 DMA 刷屏的
+ *          耗时、单次 flush 传输耗时与像素数、刷新频率，以及主循环
+ *          休眠 (等待定时器到期或被唤醒) 的时间占比，以及图像/阴影缓存的
+ *          命中次数。数据按 1 s 窗口汇总后发布。
+ *          另可逐帧抓取一段刷新记录 (渲染耗时、失效区域数量与面积等)，
+ *          由命令行以 CSV 输出，用于比较界面改动前后的重绘开销。
+ *          本模块不依赖 LVGL，钩子由 lv_port_disp.c、StartDefaultTask 以及
+ *          lv_conf.h 中的缓存统计宏调用；
+ *          计时基于 DWT 周期计数器 (见 profiler.h)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __FRAME_STATS_H
+#define __FRAME_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define FRAME_STATS_WINDOW_MS 1000 // 汇总窗口长度
+#define FRAME_STATS_CAPTURE_SIZE 64 // 逐帧抓取的最大帧数
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief LVGL 缓存类型
+ */
+typedef enum {
+  FRAME_STATS_CACHE_IMG = 0, // 图像缓存 (已打开的解码器)
+  FRAME_STATS_CACHE_SHADOW,  // 阴影圆角缓存
+  FRAME_STATS_CACHE_MAX
+} FrameStatsCache_t;
+
+/**
+ * @brief 一个窗口内的帧统计 (时间单位: us)
+ */
+typedef struct {
+  uint32_t window_ms;       // 实际窗口长度
+  uint16_t refr_rate_x10;   // 刷新频率 (0.1 Hz)，只计入真正重绘的刷新
+  uint16_t loop_rate;       // 主循环频率 (Hz)
+  uint16_t idle_permille;   // 主循环休眠的时间占比 (0.1%)
+  uint32_t render_us_avg;   // 每次刷新的渲染耗时 (不含等待刷屏)
+  uint32_t render_us_max;
+  uint32_t wait_us_avg;     // 每次刷新中等待 DMA 刷屏的耗时
+  uint32_t flush_us_avg;    // 单次 flush 传输耗时 (调用到 DMA 完成)
+  uint32_t flush_us_max;
+  uint32_t px_avg;          // 每次刷新重绘的像素数
+  uint32_t px_last;
+  uint32_t handler_us_avg;  // 每次 lv_task_handler 调用耗时
+  uint32_t handler_us_max;
+  uint32_t cache_hit[FRAME_STATS_CACHE_MAX];  // 本窗口缓存命中次数
+  uint32_t cache_miss[FRAME_STATS_CACHE_MAX]; // 本窗口缓存未命中次数
+  uint32_t cache_hit_total[FRAME_STATS_CACHE_MAX]; // 上电以来累计
+  uint32_t cache_miss_total[FRAME_STATS_CACHE_MAX];
+} FrameStats_t;
+
+/**
+ * @brief 逐帧抓取的一帧记录 (只记录确实重绘了像素的刷新)
+ */
+typedef struct {
+  uint32_t time_ms;   // 刷新结束时刻 (HAL_GetTick)
+  uint32_t render_us; // 渲染耗时 (不含等待刷屏)
+  uint32_t wait_us;   // 等待 DMA 刷屏的耗时
+  uint32_t px;        // 合并后实际重绘的像素数
+  uint32_t inv_px;    // 合并前各失效区域的面积之和 (重叠部分重复计入)
+  uint8_t inv_areas;  // 合并前的失效区域数
+  uint8_t tag;        // 刷新时的标记 (界面设置为当前屏幕编号)
+} FrameStatsFrame_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 一次刷新开始 (LVGL 刷新定时器回调入口)
+ */
+void FrameStats_RefreshBegin(void);
+
+/**
+ * @brief 刷新中重绘了像素 (monitor_cb)
+ * @param px 重绘的像素数
+ */
+void FrameStats_RefreshPixels(uint32_t px);
+
+/**
+ * @brief 本次刷新开始时的失效区域 (刷新定时器回调中，合并区域之前)
+ * @param areas 失效区域数
+ * @param px    各区域面积之和
+ */
+void FrameStats_RefreshAreas(uint8_t areas, uint32_t px);
+
+/**
+ * @brief 一次刷新结束 (LVGL 刷新定时器回调返回)
+ */
+void FrameStats_RefreshEnd(void);
+
+/**
+ * @brief 累加一段等待刷屏完成的时间 (wait_cb)
+ * @param cycles 等待的 CPU 周期数
+ */
+void FrameStats_AddWait(uint32_t cycles);
+
+/**
+ * @brief 一次 flush 传输完成 (可在中断中调用)
+ * @param cycles 从 flush_cb 调用到传输完成的 CPU 周期数
+ */
+void FrameStats_FlushDone(uint32_t cycles);
+
+/**
+ * @brief 记录一次缓存查找 (LVGL 任务中由 lv_conf.h 的统计宏调用)
+ * @param cache 缓存类型
+ * @param hit   是否命中
+ */
+void FrameStats_CacheEvent(FrameStatsCache_t cache, bool hit);
+
+/**
+ * @brief 主循环一次迭代结束，窗口到期时发布统计值
+ * @param handler_cycles lv_task_handler 耗时
+ * @param idle_cycles    休眠 (空闲) 耗时
+ */
+void FrameStats_LoopDone(uint32_t handler_cycles, uint32_t idle_cycles);
+
+/**
+ * @brief 获取最近一个窗口的统计值
+ * @return true: 成功, false: 尚未完成第一个窗口
+ */
+bool FrameStats_Get(FrameStats_t *out);
+
+/**
+ * @brief 设置逐帧记录的标记 (LVGL 任务中调用)
+ * @param tag 标记值，之后的帧记录都带上该值
+ */
+void FrameStats_SetTag(uint8_t tag);
+
+/**
+ * @brief 开始逐帧抓取 (清空已有记录)
+ * @param frames 抓取帧数，0 或超过 FRAME_STATS_CAPTURE_SIZE 时取最大值
+ */
+void FrameStats_CaptureStart(uint16_t frames);
+
+/**
+ * @brief 获取抓取进度
+ * @param target 输出本次计划抓取的帧数 (可为 NULL)
+ * @return 已抓取的帧数
+ */
+uint16_t FrameStats_CaptureCount(uint16_t *target);
+
+/**
+ * @brief 读取一帧记录
+ * @param i   帧序号 (0 为最早)
+ * @param out 输出
+ * @return false: 序号超出已抓取的帧数
+ * @note  抓取过程中也可读取已完成的帧；重新开始抓取后旧记录失效
+ */
+bool FrameStats_CaptureGet(uint16_t i, FrameStatsFrame_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FRAME_STATS_H */
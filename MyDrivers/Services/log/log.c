@@ -3,16 +3,36 @@
  * @file    log.c
  * @brief   日志系统实现文件
  * @details 实现了分级日志输出、时间戳、模块名显示、颜色输出等功能。
+ *          异步模式下，调用者用一次 CAS 从多生产者环形缓冲区领取槽位，
+ *          把整行格式化进槽位后置位就绪标志；日志任务按领取顺序取出
+ *          就绪的行并写入 printf 缓冲区。环满时丢弃新日志并计数。
+ *          二进制模式下槽位中存放的是编码后的记录帧而不是文本：
+ *          A5 5A | len | level | tick(4) | fmt地址(4) | module地址(4) | 参数 | CRC-8
+ *          整数参数 4 字节 (ll 为 8 字节)，浮点参数转为 float 4 字节，
+ *          %s 参数为 长度(1) + 内容，均为小端。持久化输出 (log_flash.c)
+ *          在 Flash 中保存的也是同一格式的记录帧。
+ *          中断中可直接使用 LOG_*；对耗时敏感的回调另有 LOG_ISR：只把格式串
+ *          指针和 3 个整数参数写入独立的无锁事件环，由日志任务格式化输出。
  * @author  MmsY
  * @time    2025/11/23
  ******************************************************************************
  */
 
 #include "log.h"
+#include "mem_section.h"
 #include "printf_redirect.h"
+#include "profiler.h"
 #include <string.h>
 #include <time.h>
 
+#if LOG_USE_ASYNC
+#include "FreeRTOS.h"
+#include "task.h"
+#include "task_wdt.h"
+#endif
+
+#include "checksum.h"
+
 // 如果使用了printf_redirect系统，包含其头文件
 #ifdef PRINTF_REDIRECT_H__
 #include "printf_redirect.h"
@@ -25,6 +45,19 @@ static log_config_t g_log_config = {.level = LOG_LEVEL_DEBUG,
                                     .show_module = 1,
                                     .show_file_line = 0};
 
+// 模块级别表 (g_log_module_levels 为生效级别，供日志宏直接查表)
+volatile uint8_t g_log_module_levels[LOG_MAX_MODULES] = {LOG_LEVEL_DEBUG};
+static const char *g_log_module_names[LOG_MAX_MODULES] = {"*"};
+static volatile uint8_t g_log_module_count = 1;     // 槽位 0 为共享槽
+static volatile uint32_t g_log_module_override = 0; // 单独设置过级别的槽位
+static volatile uint8_t g_log_min_level = LOG_LEVEL_DEBUG; // 所有槽位的最低级别
+
+// 附加输出
+static log_sink_t volatile g_log_sink = NULL;
+static volatile uint8_t g_log_sink_level = LOG_LEVEL_OFF;
+static log_record_sink_t volatile g_log_record_sink = NULL;
+static volatile uint8_t g_log_record_level = LOG_LEVEL_OFF;
+
 // 日志级别字符串
 static const char *log_level_strings[] = {"TRACE", "DEBUG", "INFO ",
                                           "WARN ", "ERROR", "FATAL"};
@@ -42,6 +75,38 @@ static const char *log_level_colors[] = {
 static const char *log_color_reset = "\x1b[0m";
 #endif
 
+#if LOG_USE_ASYNC
+// 环形缓冲区槽位
+typedef struct {
+  volatile uint8_t ready; // 生产者写完整行后置 1，日志任务取走后清 0
+  uint16_t len;
+  char text[LOG_ASYNC_SLOT_SIZE];
+} log_slot_t;
+
+// 环、事件环和日志任务栈只由 CPU 访问，放在 CCM
+static CCM_RAM log_slot_t g_log_ring[LOG_ASYNC_SLOTS];
+static volatile uint32_t g_log_head = 0; // 下一个可领取的序号 (生产者 CAS 递增)
+static volatile uint32_t g_log_tail = 0; // 下一个待输出的序号 (仅日志任务修改)
+static volatile uint32_t g_log_dropped = 0;
+
+// 中断事件环：记录格式串与整数参数，格式化推迟到日志任务
+typedef struct {
+  volatile uint8_t ready;
+  uint8_t level;
+  const char *module;
+  const char *fmt;
+  uint32_t args[3];
+} log_isr_event_t;
+
+static CCM_RAM log_isr_event_t g_log_isr_ring[LOG_ISR_SLOTS];
+static volatile uint32_t g_log_isr_head = 0;
+static volatile uint32_t g_log_isr_tail = 0;
+
+static TaskHandle_t g_log_task = NULL;
+static StaticTask_t g_log_task_tcb;
+static CCM_RAM StackType_t g_log_task_stack[LOG_TASK_STACK_SIZE];
+#endif
+
 // 获取文件名（去掉路径）
 static const char *get_filename(const char *path) {
   const char *file = strrchr(path, '/');
@@ -51,24 +116,442 @@ static const char *get_filename(const char *path) {
   return file ? file + 1 : path;
 }
 
-// 获取时间戳字符串
-static void get_timestamp(char *buffer, size_t size) {
+static inline uint32_t log_in_isr(void) {
+  return (SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) != 0;
+}
+
+#if FREERTOS_VERSION
+// 当前 tick (与 RTOS 节拍同源同值，任务、中断与调度器启动前均可读取)
+static inline uint32_t log_tick(void) { return HAL_GetTick(); }
+#endif
+
+// 把时间戳直接写入 buffer (不经过调用者栈上的临时数组)，返回写入的字符数
+static size_t get_timestamp(char *buffer, size_t size) {
+  int n;
 #if FREERTOS_VERSION
   // FreeRTOS 环境下使用tick计数
-  snprintf(buffer, size, "%lu", (unsigned long)xTaskGetTickCount());
+  n = snprintf(buffer, size, "%lu", (unsigned long)log_tick());
 #else
   // 标准C环境下使用时间
   time_t now = time(NULL);
   struct tm *tm_info = localtime(&now);
-  strftime(buffer, size, "%H:%M:%S", tm_info);
+  n = (int)strftime(buffer, size, "%H:%M:%S", tm_info);
+#endif
+  if (n <= 0)
+    return 0;
+  return ((size_t)n < size) ? (size_t)n : size - 1;
+}
+
+#if LOG_USE_ASYNC
+
+// 用 CAS 递增 head 领取一个序号，环满时返回 false (任务与中断均可调用)
+static bool log_seq_claim(volatile uint32_t *head, volatile uint32_t *tail,
+                          uint32_t slots, uint32_t *seq) {
+  uint32_t h;
+
+  do {
+    h = __LDREXW(head);
+    if (h - *tail >= slots) {
+      __CLREX();
+      g_log_dropped++;
+      return false;
+    }
+  } while (__STREXW(h + 1, head) != 0);
+
+  *seq = h;
+  return true;
+}
+
+// 领取一个槽位 (无锁，任务与中断均可调用)
+static log_slot_t *log_ring_claim(void) {
+  uint32_t seq;
+
+  if (!log_seq_claim(&g_log_head, &g_log_tail, LOG_ASYNC_SLOTS, &seq)) {
+    return NULL;
+  }
+  return &g_log_ring[seq & (LOG_ASYNC_SLOTS - 1)];
+}
+
+// 唤醒日志任务
+static void log_task_notify(void) {
+  if (g_log_task == NULL) {
+    return;
+  }
+  if (log_in_isr()) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(g_log_task, &woken);
+    portYIELD_FROM_ISR(woken);
+  } else {
+    xTaskNotifyGive(g_log_task);
+  }
+}
+
+// 发布槽位并唤醒日志任务
+static void log_ring_commit(log_slot_t *slot) {
+  __DMB(); // 保证文本先于就绪标志可见
+  slot->ready = 1;
+  log_task_notify();
+}
+
+static void log_emit_deferred(log_level_t level, const char *module,
+                              const char *fmt, ...);
+
+// 格式化并输出所有已就绪的中断事件
+static uint32_t log_isr_drain(void) {
+  uint32_t written = 0;
+
+  while (g_log_isr_tail != g_log_isr_head) {
+    log_isr_event_t *ev =
+        &g_log_isr_ring[g_log_isr_tail & (LOG_ISR_SLOTS - 1)];
+    if (!ev->ready) {
+      break;
+    }
+    __DMB();
+    log_emit_deferred((log_level_t)ev->level, ev->module, ev->fmt,
+                      ev->args[0], ev->args[1], ev->args[2]);
+    ev->ready = 0;
+    g_log_isr_tail++;
+    written++;
+  }
+  return written;
+}
+
+// 输出所有已就绪的行，遇到尚未写完的槽位即停止 (保持顺序)
+static void log_ring_drain(void) {
+  uint32_t written = log_isr_drain();
+
+  while (g_log_tail != g_log_head) {
+    log_slot_t *slot = &g_log_ring[g_log_tail & (LOG_ASYNC_SLOTS - 1)];
+    if (!slot->ready) {
+      break;
+    }
+    __DMB();
+    printf_write(slot->text, slot->len);
+    slot->ready = 0;
+    g_log_tail++;
+    written++;
+  }
+
+  if (g_log_dropped > 0) {
+    uint32_t dropped = g_log_dropped;
+    g_log_dropped = 0;
+    printf("[LOG] %lu lines dropped\r\n", (unsigned long)dropped);
+    written++;
+  }
+
+  if (written > 0) {
+    printf_flush();
+  }
+}
+
+// 日志任务：被生产者通知后批量输出
+static void log_task(void *argument) {
+  (void)argument;
+  TaskWdt_Register(TASK_WDT_DEADLINE_LOG_MS);
+  for (;;) {
+    TaskWdt_Idle();
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    TaskWdt_CheckIn();
+    log_ring_drain();
+  }
+}
+#endif
+
+// 把一行日志 (前缀 + 正文 + \r\n) 格式化进 buf，返回长度
+static uint16_t log_format_line(char *buf, size_t size, log_level_t level,
+                                const char *module, const char *file, int line,
+                                const char *fmt, va_list args) {
+  size_t pos = 0;
+  int n;
+
+#define LOG_APPEND(...)                                                        \
+  do {                                                                         \
+    n = snprintf(buf + pos, size - pos, __VA_ARGS__);                          \
+    if (n > 0)                                                                 \
+      pos += ((size_t)n < size - pos) ? (size_t)n : size - pos - 1;            \
+  } while (0)
+
+#if LOG_USE_COLOR
+  LOG_APPEND("%s", log_level_colors[level]);
+#endif
+
+  // 输出时间戳
+  if (g_log_config.show_timestamp) {
+    LOG_APPEND("[");
+    pos += get_timestamp(buf + pos, size - pos);
+    LOG_APPEND("] ");
+  }
+
+  // 输出日志级别
+  if (g_log_config.show_level) {
+    LOG_APPEND("[%s] ", log_level_strings[level]);
+  }
+
+  // 输出模块名
+  if (g_log_config.show_module) {
+    LOG_APPEND("[%s] ", module);
+  }
+
+  // 输出文件名和行号
+  if (g_log_config.show_file_line && file) {
+    LOG_APPEND("[%s:%d] ", get_filename(file), line);
+  }
+
+#if LOG_USE_COLOR
+  LOG_APPEND("%s", log_color_reset);
+#endif
+#undef LOG_APPEND
+
+  // 输出用户消息 (预留 \r\n 的位置)
+  if (pos < size - 3) {
+    n = vsnprintf(buf + pos, size - 2 - pos, fmt, args);
+    if (n > 0)
+      pos += ((size_t)n < size - 2 - pos) ? (size_t)n : size - 3 - pos;
+  }
+
+  buf[pos++] = '\r';
+  buf[pos++] = '\n';
+  buf[pos] = '\0';
+  return (uint16_t)pos;
+}
+
+// 二进制记录帧编码 (串口二进制模式与持久化输出 log_flash.c 共用)
+static inline size_t log_put_u32(uint8_t *out, uint32_t v) {
+  out[0] = (uint8_t)v;
+  out[1] = (uint8_t)(v >> 8);
+  out[2] = (uint8_t)(v >> 16);
+  out[3] = (uint8_t)(v >> 24);
+  return 4;
+}
+
+// 按格式串取出参数并打包，返回写入的字节数；空间不足时提前结束
+static size_t log_pack_args(uint8_t *out, size_t cap, const char *fmt,
+                            va_list args) {
+  size_t pos = 0;
+
+  for (const char *p = fmt; *p; p++) {
+    if (*p != '%')
+      continue;
+    if (*++p == '%')
+      continue;
+
+    // 标志、宽度、精度 ('*' 从参数中取值，同样打包)
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0')
+      p++;
+    for (int field = 0; field < 2; field++) {
+      if (*p == '*') {
+        if (pos + 4 > cap)
+          return pos;
+        pos += log_put_u32(out + pos, (uint32_t)va_arg(args, int));
+        p++;
+      }
+      while (*p >= '0' && *p <= '9')
+        p++;
+      if (field == 0 && *p == '.')
+        p++;
+      else
+        break;
+    }
+
+    // 长度修饰符 (int/long 均为 32 位，只有 ll 需要 8 字节)
+    int is_ll = 0;
+    while (*p == 'h' || *p == 'l' || *p == 'z' || *p == 'j' || *p == 't' ||
+           *p == 'L') {
+      if (*p == 'l' && p[1] == 'l')
+        is_ll = 1;
+      p++;
+    }
+
+    switch (*p) {
+    case 'd': case 'i': case 'u': case 'x': case 'X': case 'o': case 'c':
+      if (is_ll) {
+        if (pos + 8 > cap)
+          return pos;
+        uint64_t v = va_arg(args, uint64_t);
+        pos += log_put_u32(out + pos, (uint32_t)v);
+        pos += log_put_u32(out + pos, (uint32_t)(v >> 32));
+      } else {
+        if (pos + 4 > cap)
+          return pos;
+        pos += log_put_u32(out + pos, (uint32_t)va_arg(args, int));
+      }
+      break;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+    case 'a': case 'A': {
+      if (pos + 4 > cap)
+        return pos;
+      float f = (float)va_arg(args, double);
+      uint32_t bits;
+      memcpy(&bits, &f, sizeof(bits));
+      pos += log_put_u32(out + pos, bits);
+      break;
+    }
+    case 's': {
+      const char *str = va_arg(args, const char *);
+      size_t len = str ? strlen(str) : 0;
+      if (len > LOG_BIN_MAX_STR)
+        len = LOG_BIN_MAX_STR;
+      if (pos + 1 + len > cap)
+        return pos;
+      out[pos++] = (uint8_t)len;
+      memcpy(out + pos, str, len);
+      pos += len;
+      break;
+    }
+    case 'p':
+      if (pos + 4 > cap)
+        return pos;
+      pos += log_put_u32(out + pos, (uint32_t)(uintptr_t)va_arg(args, void *));
+      break;
+    case 'n':
+      (void)va_arg(args, int *);
+      break;
+    default: // 格式串结束或不支持的转换
+      if (*p == '\0')
+        return pos;
+      break;
+    }
+  }
+
+  return pos;
+}
+
+// 把一条日志编码为二进制记录帧，返回帧长度
+uint16_t log_encode_record(uint8_t *buf, size_t size, log_level_t level,
+                           const char *module, const char *fmt, va_list args) {
+  uint8_t *payload = buf + 3;
+  size_t cap = size - 4; // 帧头 3 字节 + CRC 1 字节
+  size_t len = 0;
+
+  if (cap > 255)
+    cap = 255;
+
+  payload[len++] = (uint8_t)level;
+  len += log_put_u32(payload + len, log_tick());
+  len += log_put_u32(payload + len, (uint32_t)(uintptr_t)fmt);
+  len += log_put_u32(payload + len, (uint32_t)(uintptr_t)module);
+  len += log_pack_args(payload + len, cap - len, fmt, args);
+
+  buf[0] = LOG_BIN_SYNC0;
+  buf[1] = LOG_BIN_SYNC1;
+  buf[2] = (uint8_t)len;
+  payload[len] = CRC8_Compute(payload, len);
+  return (uint16_t)(len + 4);
+}
+
+// 重新计算最低级别 (供直接调用 log_write 的路径粗过滤)
+static void log_update_min_level(void) {
+  uint8_t min = g_log_config.level;
+  for (uint8_t i = 0; i < g_log_module_count; i++) {
+    if (g_log_module_levels[i] < min) {
+      min = g_log_module_levels[i];
+    }
+  }
+  g_log_min_level = min;
+}
+
+// 按名称查找已登记的模块 (不区分大小写，便于命令行输入)
+static int8_t log_module_find(const char *module) {
+  for (uint8_t i = 1; i < g_log_module_count; i++) {
+    const char *a = g_log_module_names[i];
+    const char *b = module;
+    while (*a && ((*a | 0x20) == (*b | 0x20))) {
+      a++;
+      b++;
+    }
+    if (*a == '\0' && *b == '\0') {
+      return (int8_t)i;
+    }
+  }
+  return -1;
+}
+
+// 登记模块，返回槽位号；各文件用同名 LOG_MODULE 时共用一个槽位
+int8_t log_module_register(const char *module) {
+  int8_t slot = 0;
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+
+  for (uint8_t i = 1; i < g_log_module_count; i++) {
+    if (strcmp(g_log_module_names[i], module) == 0) {
+      slot = (int8_t)i;
+      break;
+    }
+  }
+  if (slot == 0 && g_log_module_count < LOG_MAX_MODULES) {
+    slot = (int8_t)g_log_module_count;
+    g_log_module_names[slot] = module;
+    g_log_module_levels[slot] = g_log_config.level;
+    g_log_module_count++;
+  }
+
+  __set_PRIMASK(primask);
+  return slot;
+}
+
+#if LOG_USE_ASYNC
+// 在日志任务中格式化一条推迟的日志并直接写入串口缓冲区
+static void log_emit_deferred(log_level_t level, const char *module,
+                              const char *fmt, ...) {
+  char text[LOG_ASYNC_SLOT_SIZE];
+  va_list args;
+  va_start(args, fmt);
+#if LOG_USE_BINARY
+  uint16_t len =
+      log_encode_record((uint8_t *)text, sizeof(text), level, module, fmt, args);
+#else
+  uint16_t len =
+      log_format_line(text, sizeof(text), level, module, NULL, 0, fmt, args);
 #endif
+  va_end(args);
+  printf_write(text, len);
 }
 
+// 记录一条中断事件：只拷贝指针和整数，不做任何格式化
+void log_isr_event(log_level_t level, const char *module, const char *fmt,
+                   uint32_t a0, uint32_t a1, uint32_t a2) {
+  uint32_t seq;
+
+  if (!log_seq_claim(&g_log_isr_head, &g_log_isr_tail, LOG_ISR_SLOTS, &seq)) {
+    return;
+  }
+
+  log_isr_event_t *ev = &g_log_isr_ring[seq & (LOG_ISR_SLOTS - 1)];
+  ev->level = (uint8_t)level;
+  ev->module = module;
+  ev->fmt = fmt;
+  ev->args[0] = a0;
+  ev->args[1] = a1;
+  ev->args[2] = a2;
+  __DMB();
+  ev->ready = 1;
+  log_task_notify();
+}
+#else
+void log_isr_event(log_level_t level, const char *module, const char *fmt,
+                   uint32_t a0, uint32_t a1, uint32_t a2) {
+  (void)level;
+  (void)module;
+  (void)fmt;
+  (void)a0;
+  (void)a1;
+  (void)a2;
+}
+#endif
+
+// DWT 周期计数器 (用于测量中断处理耗时)
+uint32_t log_cycles(void) { return DWT->CYCCNT; }
+
 // 初始化日志系统
 void log_init(void) {
   // 1. 如果使用了printf_redirect，确保已经初始化
   // printf_init(huart) 应该在main中已经调用
 
+  // 启用 DWT 周期计数器，供 log_cycles() 使用
+  // (不清零：调度器启动时已作为运行时统计时钟开始计数)
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
   // 2. 可以在这里输出初始化信息
   printf("[LOG] Log system initialized\r\n");
   printf("[LOG] Log level: %s\r\n", log_level_strings[g_log_config.level]);
@@ -80,19 +563,98 @@ void log_init(void) {
 
   // 3. 强制刷新确保初始化信息输出
   printf_flush();
+
+#if LOG_USE_ASYNC
+  // 4. 创建日志输出任务 (静态分配，不占用 FreeRTOS 堆)
+  if (g_log_task == NULL) {
+    g_log_task = xTaskCreateStatic(log_task, "log", LOG_TASK_STACK_SIZE, NULL,
+                                   LOG_TASK_PRIORITY, g_log_task_stack,
+                                   &g_log_task_tcb);
+    // 任务创建前已经入队的日志
+    if (g_log_head != g_log_tail) {
+      xTaskNotifyGive(g_log_task);
+    }
+  }
+#endif
+}
+
+// 等待已入队的日志全部输出 (如进入故障处理前)
+void log_flush(void) {
+#if LOG_USE_ASYNC
+  if (log_in_isr()) {
+    return;
+  }
+  if (g_log_task == NULL ||
+      xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+    log_ring_drain();
+    return;
+  }
+  while (g_log_tail != g_log_head) {
+    xTaskNotifyGive(g_log_task);
+    vTaskDelay(pdMS_TO_TICKS(1));
+  }
+#endif
+  printf_flush();
 }
 
 // 设置日志级别
 void log_set_level(log_level_t level) {
   if (level <= LOG_LEVEL_OFF) {
     g_log_config.level = level;
+    // 未单独设置过的模块跟随全局级别
+    for (uint8_t i = 0; i < g_log_module_count; i++) {
+      if (!(g_log_module_override & (1UL << i))) {
+        g_log_module_levels[i] = level;
+      }
+    }
+    log_update_min_level();
+  }
+}
+
+// 设置单个模块的日志级别 (模块须已输出过日志，即已登记)
+bool log_set_module_level(const char *module, log_level_t level) {
+  int8_t slot = module ? log_module_find(module) : -1;
+  if (slot <= 0 || level > LOG_LEVEL_OFF) {
+    return false;
   }
+  g_log_module_levels[slot] = level;
+  g_log_module_override |= 1UL << slot;
+  log_update_min_level();
+  return true;
+}
+
+// 取消模块的单独设置，恢复跟随全局级别
+bool log_clear_module_level(const char *module) {
+  int8_t slot = module ? log_module_find(module) : -1;
+  if (slot <= 0) {
+    return false;
+  }
+  g_log_module_override &= ~(1UL << slot);
+  g_log_module_levels[slot] = g_log_config.level;
+  log_update_min_level();
+  return true;
+}
+
+// 按序号遍历已登记的模块 (index 从 0 开始，不含共享槽)
+bool log_get_module(uint8_t index, const char **module, log_level_t *level) {
+  uint8_t slot = index + 1;
+  if (slot >= g_log_module_count) {
+    return false;
+  }
+  if (module) {
+    *module = g_log_module_names[slot];
+  }
+  if (level) {
+    *level = (log_level_t)g_log_module_levels[slot];
+  }
+  return true;
 }
 
 // 设置日志配置
 void log_set_config(const log_config_t *config) {
   if (config) {
     g_log_config = *config;
+    log_set_level(config->level);
   }
 }
 
@@ -100,63 +662,152 @@ void log_set_config(const log_config_t *config) {
 log_level_t log_get_level(void) { return g_log_config.level; }
 
 // 核心日志输出函数
-void log_write(log_level_t level, const char *module, const char *file,
-               int line, const char *fmt, ...) {
-
-  // 检查日志级别
-  if (level < g_log_config.level || level >= LOG_LEVEL_OFF) {
-    return;
+/**
+ * @brief 设置附加输出
+ */
+void log_set_sink(log_sink_t sink, log_level_t min_level) {
+  g_log_sink_level = LOG_LEVEL_OFF; // 先关闭，避免新旧组合被并发调用看到
+  g_log_sink = sink;
+  if (sink != NULL) {
+    g_log_sink_level = (uint8_t)min_level;
   }
+}
 
-  // 参数检查
-  if (!fmt || !module) {
-    return;
+/**
+ * @brief 设置持久化输出
+ */
+void log_set_record_sink(log_record_sink_t sink, log_level_t min_level) {
+  g_log_record_level = LOG_LEVEL_OFF;
+  g_log_record_sink = sink;
+  if (sink != NULL) {
+    g_log_record_level = (uint8_t)min_level;
   }
+}
+
+/**
+ * @brief 复制日志环中最近的若干行
+ * @note  已输出的槽位内容在被覆盖前仍然保留，因此最近 LOG_ASYNC_SLOTS 行
+ *        无论是否已写入串口都能取到；正在格式化的槽位可能不完整
+ */
+size_t log_copy_recent(char *dst, size_t cap) {
+#if LOG_USE_ASYNC
+  uint32_t head = g_log_head;
+  uint32_t oldest = (head > LOG_ASYNC_SLOTS) ? head - LOG_ASYNC_SLOTS : 0;
+  uint32_t first = head;
+  size_t need = 0;
+  size_t used = 0;
 
-  char timestamp[32] = {0};
+  // 从新到旧找出放得下的行，再从旧到新复制
+  while (first > oldest) {
+    uint16_t len = g_log_ring[(first - 1U) & (LOG_ASYNC_SLOTS - 1)].len;
 
-  // 生成时间戳
-  if (g_log_config.show_timestamp) {
-    get_timestamp(timestamp, sizeof(timestamp));
+    if (len > LOG_ASYNC_SLOT_SIZE || need + len > cap) {
+      break;
+    }
+    need += len;
+    first--;
   }
+  for (; first != head; first++) {
+    const log_slot_t *slot = &g_log_ring[first & (LOG_ASYNC_SLOTS - 1)];
+    uint16_t len = slot->len;
 
-#if LOG_USE_COLOR
-  // 使用颜色输出
-  printf("%s", log_level_colors[level]);
+    if (len > LOG_ASYNC_SLOT_SIZE || used + len > cap) {
+      break; // 复制期间被改写
+    }
+    memcpy(dst + used, slot->text, len);
+    used += len;
+  }
+  return used;
+#else
+  (void)dst;
+  (void)cap;
+  return 0;
 #endif
+}
 
-  // 输出时间戳
-  if (g_log_config.show_timestamp) {
-    printf("[%s] ", timestamp);
-  }
+// 格式化正文交给附加输出 (不改动调用者的 args)
+static void log_sink_forward(log_level_t level, const char *module,
+                             const char *fmt, va_list args) {
+  log_sink_t sink = g_log_sink;
+  char msg[LOG_SINK_MSG_SIZE];
+  va_list copy;
 
-  // 输出日志级别
-  if (g_log_config.show_level) {
-    printf("[%s] ", log_level_strings[level]);
+  if (sink == NULL || level < g_log_sink_level || log_in_isr()) {
+    return;
   }
+  va_copy(copy, args);
+  vsnprintf(msg, sizeof(msg), fmt, copy);
+  va_end(copy);
+  sink(level, module, msg);
+}
 
-  // 输出模块名
-  if (g_log_config.show_module) {
-    printf("[%s] ", module);
+// 把格式串与参数交给持久化输出 (不改动调用者的 args)
+static void log_record_forward(log_level_t level, const char *module,
+                               const char *fmt, va_list args) {
+  log_record_sink_t sink = g_log_record_sink;
+  va_list copy;
+
+  if (sink == NULL || level < g_log_record_level) {
+    return;
   }
+  va_copy(copy, args);
+  sink(level, module, fmt, copy);
+  va_end(copy);
+}
 
-  // 输出文件名和行号
-  if (g_log_config.show_file_line && file) {
-    printf("[%s:%d] ", get_filename(file), line);
+void log_write(log_level_t level, const char *module, const char *file,
+               int line, const char *fmt, ...) {
+
+  // 模块级别已在日志宏中检查，这里只对直接调用做粗过滤
+  if (level < g_log_min_level || level >= LOG_LEVEL_OFF) {
+    return;
   }
 
-#if LOG_USE_COLOR
-  printf("%s", log_color_reset);
-#endif
+  // 参数检查
+  if (!fmt || !module) {
+    return;
+  }
 
-  // 输出用户消息
+  PROF_BEGIN(PROF_ZONE_LOG_WRITE);
   va_list args;
   va_start(args, fmt);
-  vprintf(fmt, args);
+  log_sink_forward(level, module, fmt, args);
+  log_record_forward(level, module, fmt, args);
+
+#if LOG_USE_ASYNC
+  // 致命错误之后系统可能停止运行，同步输出以免丢失；
+  // 中断中不能等待串口，致命错误也只能入队
+  if (level != LOG_LEVEL_FATAL || log_in_isr()) {
+    log_slot_t *slot = log_ring_claim();
+    if (slot != NULL) {
+#if LOG_USE_BINARY
+      slot->len = log_encode_record((uint8_t *)slot->text, LOG_ASYNC_SLOT_SIZE,
+                                    level, module, fmt, args);
+#else
+      slot->len = log_format_line(slot->text, LOG_ASYNC_SLOT_SIZE, level,
+                                  module, file, line, fmt, args);
+#endif
+      log_ring_commit(slot);
+    }
+    va_end(args);
+    PROF_END(PROF_ZONE_LOG_WRITE);
+    return;
+  }
+#endif
+
+  char text[LOG_ASYNC_SLOT_SIZE];
+#if LOG_USE_BINARY
+  uint16_t len = log_encode_record((uint8_t *)text, sizeof(text), level,
+                                   module, fmt, args);
+#else
+  uint16_t len =
+      log_format_line(text, sizeof(text), level, module, file, line, fmt, args);
+#endif
   va_end(args);
 
-  printf("\r\n");
+  printf_write(text, len);
 
   // 立即刷新输出缓冲区
-  fflush(stdout);
+  printf_flush();
+  PROF_END(PROF_ZONE_LOG_WRITE);
 }
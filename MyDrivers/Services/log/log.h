@@ -12,7 +12,10 @@
 #define LOG_H
 
 #include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include "task_plan.h"
 
 
 #ifdef __cplusplus
@@ -41,14 +44,48 @@ typedef struct {
 
 // 日志系统初始化和配置
 void log_init(void);
+void log_flush(void);
 void log_set_level(log_level_t level);
 void log_set_config(const log_config_t *config);
 log_level_t log_get_level(void);
 
+// 模块级日志级别 (模块名即各文件的 LOG_MODULE，首次输出日志时自动登记)
+bool log_set_module_level(const char *module, log_level_t level);
+bool log_clear_module_level(const char *module); // 恢复跟随全局级别
+bool log_get_module(uint8_t index, const char **module, log_level_t *level);
+
 // 核心日志函数
 void log_write(log_level_t level, const char *module, const char *file,
                int line, const char *fmt, ...);
 
+// 中断事件：fmt 须为字符串常量，只能使用整数转换 (%lu/%ld/%lx)
+void log_isr_event(log_level_t level, const char *module, const char *fmt,
+                   uint32_t a0, uint32_t a1, uint32_t a2);
+uint32_t log_cycles(void); // DWT 周期计数 (log_init 中启用)
+
+// 附加输出：不低于 min_level 的日志另外以 (级别, 模块, 正文) 交给 sink，
+// 在调用者上下文中同步执行 (中断中的日志不转发)，sink 内不得再输出日志；
+// 传入 NULL 取消
+typedef void (*log_sink_t)(log_level_t level, const char *module,
+                           const char *msg);
+void log_set_sink(log_sink_t sink, log_level_t min_level);
+
+// 持久化输出：不低于 min_level 的日志以 (级别, 模块, 格式串, 参数) 交给 sink，
+// 由 sink 用 log_encode_record() 编码为二进制记录帧 (见 log_flash.h)；
+// 在调用者上下文中同步执行 (含中断)，sink 内不得再输出日志；传入 NULL 取消
+typedef void (*log_record_sink_t)(log_level_t level, const char *module,
+                                  const char *fmt, va_list args);
+void log_set_record_sink(log_record_sink_t sink, log_level_t min_level);
+
+// 编码一条二进制记录帧 (格式同 LOG_USE_BINARY)，返回帧长度；
+// size 须不小于 LOG_BIN_MIN_FRAME，参数放不下时截断
+uint16_t log_encode_record(uint8_t *buf, size_t size, log_level_t level,
+                           const char *module, const char *fmt, va_list args);
+
+// 崩溃转储用：复制日志环中最近的若干行 (从旧到新，整行复制，不超过 cap 字节)；
+// 不加锁、不等待，可在异常处理中调用，返回复制的字节数
+size_t log_copy_recent(char *dst, size_t cap);
+
 // 便捷宏定义
 #ifndef LOG_MODULE
 #define LOG_MODULE "UNKNOWN"
@@ -58,19 +95,95 @@ void log_write(log_level_t level, const char *module, const char *file,
 #define LOG_USE_COLOR 0
 #define FREERTOS_VERSION 1
 
+// 异步输出：调用者只把整行格式化进无锁环形缓冲区的一个槽位，
+// 由低优先级的日志任务统一写入串口，调用者不再等待 UART
+#define LOG_USE_ASYNC 1
+#define LOG_ASYNC_SLOTS 16          // 槽位数 (必须为 2 的幂)
+#define LOG_ASYNC_SLOT_SIZE 160     // 单行最大长度 (含 \r\n)，超出部分被截断
+#define LOG_TASK_STACK_SIZE 192     // 日志任务栈大小 (字)
+#define LOG_TASK_PRIORITY TASK_PRIO_LOG // 日志任务的 FreeRTOS 优先级 (即 osPriorityLow)
+#define LOG_ISR_SLOTS 16            // 中断事件槽位数 (必须为 2 的幂)
+#define LOG_ISR_TRACE 0             // 在 TIM6/ADC DMA 回调中输出耗时统计
+
+// 二进制日志：不在目标板上格式化，只输出 格式串地址 + 时间戳 + 原始参数，
+// 由主机端 log_decode.py 根据 .axf 中的字符串还原文本 (见该脚本说明)
+#define LOG_USE_BINARY 0
+#define LOG_BIN_SYNC0 0xA5          // 帧头
+#define LOG_BIN_SYNC1 0x5A
+#define LOG_BIN_MAX_STR 32          // %s 参数最多携带的字节数
+#define LOG_BIN_MIN_FRAME 17        // 不带参数的记录帧长度 (帧头 3 + 固定字段 13 + CRC 1)
+
+#define LOG_SINK_MSG_SIZE 96        // 交给附加输出的正文最大长度 (含结尾 0)
+
+// 编译期最低级别：低于该级别的日志语句整体删除 (参数也不会被求值)
+// 0=TRACE 1=DEBUG 2=INFO 3=WARN 4=ERROR 5=FATAL，发布版本可在工程中定义为 2
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL 0
+#endif
+
+// 模块级别表：槽位 0 为共享槽 (表满后登记的模块共用，跟随全局级别)
+#define LOG_MAX_MODULES 24 // 不超过 32 (覆盖标志为 32 位掩码)
+
+extern volatile uint8_t g_log_module_levels[LOG_MAX_MODULES];
+int8_t log_module_register(const char *module);
+
+// 每个包含本头文件的源文件各有一个模块槽位缓存，首次使用时登记
+static int8_t log_module_slot __attribute__((unused)) = -1;
+
+// 在求值任何参数之前按模块级别过滤
+static inline int log_module_enabled(log_level_t level, int8_t *slot,
+                                     const char *module) {
+  if (*slot < 0) {
+    *slot = log_module_register(module);
+  }
+  return level >= g_log_module_levels[*slot];
+}
+
+#define LOG_AT(level, fmt, ...)                                                \
+  do {                                                                         \
+    if (log_module_enabled(level, &log_module_slot, LOG_MODULE))               \
+      log_write(level, LOG_MODULE, __FILE__, __LINE__, fmt, ##__VA_ARGS__);    \
+  } while (0)
+
 // 基础日志宏
-#define LOG_TRACE(fmt, ...)                                                    \
-  log_write(LOG_LEVEL_TRACE, LOG_MODULE, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define LOG_DEBUG(fmt, ...)                                                    \
-  log_write(LOG_LEVEL_DEBUG, LOG_MODULE, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define LOG_INFO(fmt, ...)                                                     \
-  log_write(LOG_LEVEL_INFO, LOG_MODULE, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define LOG_WARN(fmt, ...)                                                     \
-  log_write(LOG_LEVEL_WARN, LOG_MODULE, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define LOG_ERROR(fmt, ...)                                                    \
-  log_write(LOG_LEVEL_ERROR, LOG_MODULE, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
-#define LOG_FATAL(fmt, ...)                                                    \
-  log_write(LOG_LEVEL_FATAL, LOG_MODULE, __FILE__, __LINE__, fmt, ##__VA_ARGS__)
+#if LOG_COMPILE_LEVEL <= 0
+#define LOG_TRACE(fmt, ...) LOG_AT(LOG_LEVEL_TRACE, fmt, ##__VA_ARGS__)
+#else
+#define LOG_TRACE(fmt, ...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= 1
+#define LOG_DEBUG(fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(fmt, ...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= 2
+#define LOG_INFO(fmt, ...) LOG_AT(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define LOG_INFO(fmt, ...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= 3
+#define LOG_WARN(fmt, ...) LOG_AT(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOG_WARN(fmt, ...) ((void)0)
+#endif
+#if LOG_COMPILE_LEVEL <= 4
+#define LOG_ERROR(fmt, ...) LOG_AT(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) ((void)0)
+#endif
+#define LOG_FATAL(fmt, ...) LOG_AT(LOG_LEVEL_FATAL, fmt, ##__VA_ARGS__)
+
+// 中断回调专用：不格式化、不加锁，约几十个周期 (以 DEBUG 级别过滤)
+#if LOG_COMPILE_LEVEL <= 1
+#define LOG_ISR(fmt, a0, a1, a2)                                               \
+  do {                                                                         \
+    if (log_module_enabled(LOG_LEVEL_DEBUG, &log_module_slot, LOG_MODULE))     \
+      log_isr_event(LOG_LEVEL_DEBUG, LOG_MODULE, fmt, (uint32_t)(a0),          \
+                    (uint32_t)(a1), (uint32_t)(a2));                           \
+  } while (0)
+#else
+#define LOG_ISR(fmt, a0, a1, a2) ((void)0)
+#endif
 
 // 兼容你原来的宏定义风格
 #define LOG(fmt, ...) LOG_INFO(fmt, ##__VA_ARGS__)
@@ -0,0 +1,206 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    log_decode.py
+@brief   二进制日志 (LOG_USE_BINARY) 主机端解码器
+@details 目标板只发送格式串/模块名的 Flash 地址与原始参数，本脚本从 Keil
+         生成的 .axf (ELF) 中按地址取出字符串并在主机上完成格式化。
+         串口流中不属于二进制帧的字节 (如启动时的 printf 输出) 原样透传。
+
+用法:
+    python log_decode.py EnviroSense.axf COM5 [-b 115200]
+    python log_decode.py EnviroSense.axf capture.bin
+    python log_decode.py EnviroSense.axf --dump      # 列出日志格式串表
+
+@author  MmsY
+@time    2025/11/23
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SYNC = b"\xA5\x5A"
+LEVEL_NAMES = {0: "T", 1: "D", 2: "I", 3: "W", 4: "E", 5: "F"}
+SPEC_RE = re.compile(r"%([-+ #0]*)(\*|\d+)?(?:\.(\*|\d+))?(hh|h|ll|l|z|j|t|L)?([diuxXocpsfFeEgGaAn%])")
+
+
+def crc8(data):
+    """与 checksum.c 中 CRC8_Compute 相同 (多项式 0x31，初值 0xFF)"""
+    crc = 0xFF
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x31) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+class ElfImage:
+    """只解析 PT_LOAD 段，足以按地址读取 Flash 中的只读字符串"""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:4] != b"\x7fELF" or data[4] != 1:
+            raise ValueError("not an ELF32 file: %s" % path)
+        phoff, = struct.unpack_from("<I", data, 28)
+        phentsize, phnum = struct.unpack_from("<HH", data, 42)
+        self.segments = []
+        for i in range(phnum):
+            p_type, p_offset, _vaddr, p_paddr, p_filesz = struct.unpack_from(
+                "<IIIII", data, phoff + i * phentsize)
+            if p_type == 1 and p_filesz:
+                self.segments.append((p_paddr, data[p_offset:p_offset + p_filesz]))
+        self.cache = {}
+
+    def string(self, addr):
+        if addr in self.cache:
+            return self.cache[addr]
+        text = None
+        for base, blob in self.segments:
+            if base <= addr < base + len(blob):
+                end = blob.find(b"\0", addr - base)
+                raw = blob[addr - base:end if end >= 0 else len(blob)]
+                text = raw.decode("utf-8", "replace")
+                break
+        self.cache[addr] = text
+        return text
+
+
+def format_record(fmt, args):
+    """按与 log_pack_args 相同的规则解析参数并格式化"""
+    out = []
+    pos = 0
+    last = 0
+
+    def take(n):
+        nonlocal pos
+        chunk = args[pos:pos + n]
+        if len(chunk) < n:
+            raise IndexError
+        pos += n
+        return chunk
+
+    try:
+        for m in SPEC_RE.finditer(fmt):
+            out.append(fmt[last:m.start()])
+            last = m.end()
+            flags, width, prec, length, conv = m.groups()
+            if conv == "%":
+                out.append("%")
+                continue
+            if width == "*":
+                width = str(struct.unpack("<i", take(4))[0])
+            if prec == "*":
+                prec = str(struct.unpack("<i", take(4))[0])
+            spec = "%" + flags + (width or "") + ("." + prec if prec is not None else "")
+
+            if conv in "diuxXoc":
+                if length == "ll":
+                    v, = struct.unpack("<q" if conv in "di" else "<Q", take(8))
+                else:
+                    v, = struct.unpack("<i" if conv in "di" else "<I", take(4))
+                out.append((spec + ("d" if conv in "iu" else conv)) % v)
+            elif conv in "fFeEgGaA":
+                v, = struct.unpack("<f", take(4))
+                out.append((spec + ("f" if conv in "aA" else conv)) % v)
+            elif conv == "s":
+                n = take(1)[0]
+                out.append((spec + "s") % take(n).decode("utf-8", "replace"))
+            elif conv == "p":
+                out.append("0x%08x" % struct.unpack("<I", take(4))[0])
+    except IndexError:
+        out.append("<truncated>")
+        return "".join(out)
+
+    out.append(fmt[last:])
+    return "".join(out)
+
+
+def decode_frame(elf, payload):
+    level = payload[0]
+    tick, fmt_addr, mod_addr = struct.unpack_from("<III", payload, 1)
+    fmt = elf.string(fmt_addr)
+    module = elf.string(mod_addr) or "?"
+    if fmt is None:
+        return "[%d] [%s] [%s] <unknown fmt 0x%08x>" % (
+            tick, LEVEL_NAMES.get(level, "?"), module, fmt_addr)
+    return "[%d] [%s] [%s] %s" % (
+        tick, LEVEL_NAMES.get(level, "?"), module,
+        format_record(fmt, payload[13:]).rstrip("\r\n"))
+
+
+def decode_stream(elf, read, write):
+    buf = bytearray()
+    while True:
+        chunk = read()
+        if not chunk:
+            break
+        buf += chunk
+        while True:
+            i = buf.find(SYNC)
+            if i < 0:
+                # 保留末尾可能是半个帧头的字节
+                keep = 1 if buf.endswith(SYNC[:1]) else 0
+                write(bytes(buf[:len(buf) - keep]).decode("utf-8", "replace"))
+                del buf[:len(buf) - keep]
+                break
+            if i:
+                write(bytes(buf[:i]).decode("utf-8", "replace"))
+                del buf[:i]
+            if len(buf) < 3 or len(buf) < 3 + buf[2] + 1:
+                break
+            n = buf[2]
+            payload = bytes(buf[3:3 + n])
+            if n >= 13 and crc8(payload) == buf[3 + n]:
+                write(decode_frame(elf, payload) + "\n")
+                del buf[:4 + n]
+            else:
+                # 伪帧头：当作普通字节输出，继续向后同步
+                write(bytes(buf[:1]).decode("utf-8", "replace"))
+                del buf[:1]
+
+
+def dump_strings(elf):
+    """打印 .axf 中所有看起来像日志格式串的字符串及其地址"""
+    for base, blob in elf.segments:
+        for m in re.finditer(rb"[\x20-\x7e\x80-\xff\t\r\n]{2,}\x00", blob):
+            text = m.group()[:-1].decode("utf-8", "replace")
+            if "%" in text or text.isupper():
+                print("0x%08x  %r" % (base + m.start(), text))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="EnviroSense binary log decoder")
+    ap.add_argument("axf", help="Keil 生成的 .axf 文件 (须与板上固件一致)")
+    ap.add_argument("source", nargs="?", help="串口名或抓包文件，缺省为 stdin")
+    ap.add_argument("-b", "--baud", type=int, default=115200)
+    ap.add_argument("--dump", action="store_true", help="列出格式串表后退出")
+    opts = ap.parse_args()
+
+    elf = ElfImage(opts.axf)
+    if opts.dump:
+        dump_strings(elf)
+        return
+
+    def write(text):
+        sys.stdout.write(text)
+        sys.stdout.flush()
+
+    if opts.source is None:
+        decode_stream(elf, lambda: sys.stdin.buffer.read1(256), write)
+        return
+    try:
+        with open(opts.source, "rb") as f:
+            decode_stream(elf, lambda: f.read(4096), write)
+    except OSError:
+        import serial  # pyserial
+        port = serial.Serial(opts.source, opts.baud, timeout=None)
+        # 阻塞等待至少 1 字节，再取走已到达的全部数据
+        decode_stream(elf, lambda: port.read(1) + port.read(port.in_waiting),
+                      write)
+
+
+if __name__ == "__main__":
+    main()
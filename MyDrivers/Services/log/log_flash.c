@@ -0,0 +1,531 @@
+/**
+ ******************************************************************************
+ * @file    log_flash.c
+ * @brief   运行日志持久化实现
+ * @details 页格式 (256 字节):
+ *            页头  [魔数 | 版本 | 启动序号 (2) | 页序号 (4)]
+ *            数据  首尾相接的记录帧 (A5 5A | len | ... | CRC-8)，未用部分为 0xFF
+ *          页内不另设 CRC：每条记录帧自带 CRC-8，写坏的记录由解码端跳过；
+ *          恢复与读出时从页首逐帧解析，遇到非帧头即为结尾。
+ *          两个页缓冲位于备份 SRAM 的 [CRASH_DUMP_BKP_SIZE, 4 KB)，内容只由
+ *          日志调用者 (关中断追加) 与系统监控任务 (写出后释放) 修改。
+ *          挂载时读取每个扇区首页的页头，页序号最大的扇区为写入扇区，在其中
+ *          找到第一个已擦除页作为写入位置。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "log_flash.h"
+#include "crash_dump.h"
+#include "norflash.h"
+#include "printf_redirect.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task_plan.h"
+#include <string.h>
+
+#define LOG_MODULE "LOGF"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define LOG_FLASH_MAGIC 0x4C // 'L'
+#define LOG_FLASH_VERSION 1
+#define LOG_FLASH_HEADER_LEN 8
+#define LOG_FLASH_DATA_SIZE (NORFLASH_PAGE_SIZE - LOG_FLASH_HEADER_LEN)
+#define LOG_FLASH_PAGES_PER_SECTOR (NORFLASH_SECTOR_SIZE / NORFLASH_PAGE_SIZE)
+#define LOG_FLASH_SECTORS (LOG_FLASH_SIZE / NORFLASH_SECTOR_SIZE)
+#define LOG_FLASH_PAGES (LOG_FLASH_SIZE / NORFLASH_PAGE_SIZE)
+#define LOG_FLASH_END (LOG_FLASH_ADDR + LOG_FLASH_SIZE)
+#define LOG_FLASH_BUFFERS 2
+#define LOG_FLASH_BKP ((LogFlashBkp_t *)(BKPSRAM_BASE + CRASH_DUMP_BKP_SIZE))
+
+typedef struct {
+  uint8_t magic;
+  uint8_t version;
+  uint16_t boot;
+  uint32_t seq;
+  uint8_t data[LOG_FLASH_DATA_SIZE];
+} LogFlashPage_t;
+
+typedef struct {
+  LogFlashPage_t page[LOG_FLASH_BUFFERS];
+} LogFlashBkp_t;
+
+typedef char log_flash_page_check[(sizeof(LogFlashPage_t) == NORFLASH_PAGE_SIZE) ? 1 : -1];
+typedef char log_flash_bkp_check[(CRASH_DUMP_BKP_SIZE + sizeof(LogFlashBkp_t) <= 4096U) ? 1 : -1];
+
+/* --------------------------- 私有变量 --------------------------- */
+/* 以下页缓冲状态在关中断时修改 (追加可能发生在中断中) */
+static uint16_t s_used[LOG_FLASH_BUFFERS];  // 各页已用的数据字节数
+static bool s_sealed[LOG_FLASH_BUFFERS];    // 已封存，等待写入 Flash
+static int8_t s_active = -1;                // 正在追加的页，-1 表示两页都已封存
+static uint32_t s_next_seq = 0;
+static uint16_t s_boot = 0;
+static LogFlashStats_t s_stats;
+
+/* 以下只在持有 s_mutex 时访问 */
+static bool s_ready = false;
+static LogFlashPage_t s_page;               // 写入与读出的 SRAM 缓冲
+static uint32_t s_write_addr;               // 下一页的写入地址
+static bool s_head_erased;                  // s_write_addr 所在扇区的剩余部分已擦除
+
+static SemaphoreHandle_t s_mutex = NULL;
+static StaticSemaphore_t s_mutex_buf;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static bool log_flash_header_valid(const LogFlashPage_t *page) {
+  return page->magic == LOG_FLASH_MAGIC && page->version == LOG_FLASH_VERSION;
+}
+
+/* 从页首逐帧解析，返回有效数据长度 */
+static uint16_t log_flash_data_len(const uint8_t *data) {
+  uint16_t pos = 0;
+
+  while (pos + LOG_BIN_MIN_FRAME <= LOG_FLASH_DATA_SIZE &&
+         data[pos] == LOG_BIN_SYNC0 && data[pos + 1] == LOG_BIN_SYNC1) {
+    uint16_t len = (uint16_t)(data[pos + 2] + 4U);
+
+    if (pos + len > LOG_FLASH_DATA_SIZE) {
+      break;
+    }
+    pos += len;
+  }
+  return pos;
+}
+
+/* 初始化一个空页并设为追加页 (关中断时调用) */
+static void log_flash_open(uint8_t index) {
+  LogFlashPage_t *page = &LOG_FLASH_BKP->page[index];
+
+  memset(page->data, 0xFF, sizeof(page->data));
+  page->boot = s_boot;
+  page->seq = s_next_seq++;
+  page->version = LOG_FLASH_VERSION;
+  page->magic = LOG_FLASH_MAGIC;
+  s_used[index] = 0;
+  s_sealed[index] = false;
+  s_active = (int8_t)index;
+}
+
+/* 封存追加页并切换到另一页 (关中断时调用) */
+static void log_flash_seal_active(void) {
+  uint8_t other;
+
+  if (s_active < 0) {
+    return;
+  }
+  s_sealed[s_active] = true;
+  other = (uint8_t)(s_active ^ 1);
+  s_active = -1;
+  if (!s_sealed[other]) {
+    log_flash_open(other);
+  }
+}
+
+/* 持久化输出：关中断把记录帧直接编码进追加页 */
+static void log_flash_sink(log_level_t level, const char *module,
+                           const char *fmt, va_list args) {
+  uint32_t primask = __get_PRIMASK();
+  LogFlashPage_t *page;
+
+  __disable_irq();
+  if (s_active >= 0 &&
+      LOG_FLASH_DATA_SIZE - s_used[s_active] < LOG_FLASH_RECORD_RESERVE) {
+    log_flash_seal_active();
+  }
+  if (s_active < 0) {
+    s_stats.dropped++;
+    __set_PRIMASK(primask);
+    return;
+  }
+  page = &LOG_FLASH_BKP->page[s_active];
+  s_used[s_active] += log_encode_record(
+      page->data + s_used[s_active], LOG_FLASH_DATA_SIZE - s_used[s_active],
+      level, module, fmt, args);
+  s_stats.records++;
+  __set_PRIMASK(primask);
+}
+
+static uint32_t log_flash_next_addr(uint32_t addr) {
+  addr += NORFLASH_PAGE_SIZE;
+  return addr >= LOG_FLASH_END ? LOG_FLASH_ADDR : addr;
+}
+
+/**
+ * @brief 整页写入 s_page (调用方持有 s_mutex)，写到扇区开头时先擦除
+ * @return false: 擦除失败，页留在备份 SRAM 中下一轮重试
+ */
+static bool log_flash_program(void) {
+  if (!s_head_erased) {
+    if (norflash_erase_sector(s_write_addr) != 0) {
+      s_stats.errors++;
+      return false;
+    }
+    s_head_erased = true;
+    s_stats.sectors_erased++;
+  }
+  if (norflash_write(s_write_addr, (const uint8_t *)&s_page,
+                     sizeof(s_page)) == 0) {
+    s_stats.pages_written++;
+  } else {
+    s_stats.errors++; // 该页作废
+  }
+
+  /* 写坏的页也跳过，避免反复编程同一位置 */
+  s_write_addr = log_flash_next_addr(s_write_addr);
+  if (s_write_addr % NORFLASH_SECTOR_SIZE == 0) {
+    s_head_erased = false;
+  }
+  return true;
+}
+
+/* 封存的页中序号最小的一个，没有时返回 -1 */
+static int8_t log_flash_oldest_sealed(void) {
+  const LogFlashBkp_t *bkp = LOG_FLASH_BKP;
+  int8_t oldest = -1;
+
+  for (uint8_t i = 0; i < LOG_FLASH_BUFFERS; i++) {
+    if (s_sealed[i] &&
+        (oldest < 0 || bkp->page[i].seq < bkp->page[oldest].seq)) {
+      oldest = (int8_t)i;
+    }
+  }
+  return oldest;
+}
+
+/* 释放已写出的页 (关中断时调用) */
+static void log_flash_release(uint8_t index) {
+  LOG_FLASH_BKP->page[index].magic = 0xFF;
+  s_sealed[index] = false;
+  s_used[index] = 0;
+  if (s_active < 0) {
+    log_flash_open(index);
+  }
+}
+
+/* 写出所有封存的页 (调用方持有 s_mutex) */
+static void log_flash_write_sealed(void) {
+  int8_t index;
+
+  while ((index = log_flash_oldest_sealed()) >= 0) {
+    uint32_t primask;
+
+    memcpy(&s_page, &LOG_FLASH_BKP->page[index], sizeof(s_page));
+    if (!log_flash_program()) {
+      return;
+    }
+    primask = __get_PRIMASK();
+    __disable_irq();
+    log_flash_release((uint8_t)index);
+    __set_PRIMASK(primask);
+  }
+}
+
+/**
+ * @brief 扫描运行日志区，定位写入位置
+ * @param newest_seq  最新页的序号
+ * @param newest_boot 最新页的启动序号
+ * @return false: 日志区为空
+ */
+static bool log_flash_scan(uint32_t *newest_seq, uint16_t *newest_boot) {
+  uint32_t newest_addr = 0;
+  bool found = false;
+
+  for (uint32_t i = 0; i < LOG_FLASH_SECTORS; i++) {
+    uint32_t addr = LOG_FLASH_ADDR + i * NORFLASH_SECTOR_SIZE;
+
+    if (norflash_read(addr, (uint8_t *)&s_page, LOG_FLASH_HEADER_LEN) != 0 ||
+        !log_flash_header_valid(&s_page)) {
+      continue;
+    }
+    if (!found || s_page.seq > *newest_seq) {
+      *newest_seq = s_page.seq;
+      *newest_boot = s_page.boot;
+      newest_addr = addr;
+    }
+    found = true;
+  }
+  if (!found) {
+    s_write_addr = LOG_FLASH_ADDR;
+    s_head_erased = false;
+    return false;
+  }
+
+  /* 写入扇区内：最后一个有效页给出最新序号，第一个已擦除页为写入位置 */
+  s_write_addr = newest_addr + NORFLASH_SECTOR_SIZE;
+  for (uint32_t p = 0; p < LOG_FLASH_PAGES_PER_SECTOR; p++) {
+    uint32_t addr = newest_addr + p * NORFLASH_PAGE_SIZE;
+
+    if (norflash_read(addr, (uint8_t *)&s_page, LOG_FLASH_HEADER_LEN) != 0) {
+      continue;
+    }
+    if (s_page.magic == 0xFF && s_page.seq == 0xFFFFFFFFUL) {
+      s_write_addr = addr;
+      break;
+    }
+    if (log_flash_header_valid(&s_page) && s_page.seq > *newest_seq) {
+      *newest_seq = s_page.seq;
+      *newest_boot = s_page.boot;
+    }
+  }
+  if (s_write_addr >= LOG_FLASH_END) {
+    s_write_addr = LOG_FLASH_ADDR;
+  }
+  s_head_erased = s_write_addr % NORFLASH_SECTOR_SIZE != 0;
+  return true;
+}
+
+/* 输出 s_page 中的一页 (头一行文本，随后为原始记录帧) */
+static void log_flash_emit(void) {
+  uint16_t len = log_flash_data_len(s_page.data);
+
+  printf("\r\n[LOGFLASH] boot %u seq %lu, %u bytes\r\n", (unsigned)s_page.boot,
+         (unsigned long)s_page.seq, (unsigned)len);
+  printf_write(s_page.data, len);
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 恢复页缓冲并开始接收日志
+ */
+void LogFlash_Init(void) {
+  LogFlashBkp_t *bkp = LOG_FLASH_BKP;
+  bool restored = false;
+
+  /* 备份 SRAM 时钟与写访问 (与 crash_dump 相同，可重复执行) */
+  RCC->APB1ENR |= RCC_APB1ENR_PWREN;
+  RCC->AHB1ENR |= RCC_AHB1ENR_BKPSRAMEN;
+  PWR->CR |= PWR_CR_DBP;
+  __DSB();
+
+  /* 上次运行留下的页：有数据的封存待写，空页直接复用 */
+  for (uint8_t i = 0; i < LOG_FLASH_BUFFERS; i++) {
+    LogFlashPage_t *page = &bkp->page[i];
+
+    s_sealed[i] = false;
+    s_used[i] = 0;
+    if (!log_flash_header_valid(page)) {
+      continue;
+    }
+    if (!restored || page->seq >= s_next_seq) {
+      s_next_seq = page->seq + 1;
+    }
+    if (!restored || page->boot >= s_boot) {
+      s_boot = (uint16_t)(page->boot + 1);
+    }
+    restored = true;
+    s_used[i] = log_flash_data_len(page->data);
+    memset(page->data + s_used[i], 0xFF, LOG_FLASH_DATA_SIZE - s_used[i]);
+    s_sealed[i] = s_used[i] != 0;
+    if (!s_sealed[i]) {
+      page->magic = 0xFF;
+    }
+  }
+
+  s_active = -1;
+  for (uint8_t i = 0; i < LOG_FLASH_BUFFERS; i++) {
+    if (!s_sealed[i]) {
+      log_flash_open(i);
+      break;
+    }
+  }
+  log_set_record_sink(log_flash_sink, LOG_FLASH_MIN_LEVEL);
+}
+
+/**
+ * @brief 挂载运行日志区
+ */
+bool LogFlash_Mount(void) {
+  LogFlashBkp_t *bkp = LOG_FLASH_BKP;
+  uint32_t newest_seq = 0;
+  uint16_t newest_boot = 0;
+  uint32_t primask;
+  bool found;
+
+  if (s_ready) {
+    return true;
+  }
+  if (norflash_get_size() < LOG_FLASH_END) {
+    LOG_WARN("SPI Flash 容量不足，运行日志只保留在备份 SRAM 中");
+    return false;
+  }
+  s_mutex = xSemaphoreCreateMutexStatic(&s_mutex_buf);
+  TaskPlan_WatchMutex(s_mutex, "logflash", NORFLASH_SECTOR_ERASE_MS);
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  found = log_flash_scan(&newest_seq, &newest_boot);
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (found) {
+    uint32_t next = newest_seq + 1;
+    int8_t order[LOG_FLASH_BUFFERS + 1];
+    uint8_t n = 0;
+
+    /* 写出后、释放前复位的页已经在 Flash 中 */
+    for (uint8_t i = 0; i < LOG_FLASH_BUFFERS; i++) {
+      if (s_sealed[i] && bkp->page[i].seq <= newest_seq) {
+        log_flash_release(i);
+      }
+    }
+    /* 备份 SRAM 掉电丢失过 (或换过 Flash)：未写出的页接在最新页之后重新编号 */
+    order[0] = log_flash_oldest_sealed();
+    if (order[0] >= 0) {
+      n++;
+      if (s_sealed[order[0] ^ 1]) {
+        order[n++] = (int8_t)(order[0] ^ 1);
+      }
+    }
+    if (s_active >= 0) {
+      order[n++] = s_active;
+    }
+    for (uint8_t k = 0; k < n; k++) {
+      LogFlashPage_t *page = &bkp->page[order[k]];
+
+      if (page->seq < next) {
+        page->seq = next;
+      }
+      next = page->seq + 1;
+    }
+    if (s_next_seq < next) {
+      s_next_seq = next;
+    }
+    if (s_boot <= newest_boot) {
+      s_boot = (uint16_t)(newest_boot + 1);
+      if (s_active >= 0) {
+        bkp->page[s_active].boot = s_boot;
+      }
+    }
+  }
+  __set_PRIMASK(primask);
+
+  s_ready = true;
+  log_flash_write_sealed();
+  xSemaphoreGive(s_mutex);
+
+  LOG_INFO("运行日志已挂载: 写入地址 0x%06lX, 启动 %u, 页序号 %lu",
+           (unsigned long)s_write_addr, (unsigned)s_boot,
+           (unsigned long)s_next_seq);
+  return true;
+}
+
+/**
+ * @brief 写出封存的页
+ */
+void LogFlash_Process(void) {
+  if (!s_ready || log_flash_oldest_sealed() < 0) {
+    return;
+  }
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  log_flash_write_sealed();
+  xSemaphoreGive(s_mutex);
+}
+
+/**
+ * @brief 立即写出未满的页
+ */
+bool LogFlash_Flush(void) {
+  uint32_t primask;
+
+  if (!s_ready) {
+    return false;
+  }
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (s_active >= 0 && s_used[s_active] != 0) {
+    log_flash_seal_active();
+  }
+  __set_PRIMASK(primask);
+
+  LogFlash_Process();
+  return log_flash_oldest_sealed() < 0;
+}
+
+/**
+ * @brief 按时间顺序输出最近的若干页
+ */
+uint32_t LogFlash_Dump(uint32_t max_pages) {
+  uint32_t count = 0;
+  uint32_t addr;
+  uint32_t n;
+
+  if (!s_ready) {
+    return 0;
+  }
+  if (max_pages == 0 || max_pages > LOG_FLASH_PAGES) {
+    max_pages = LOG_FLASH_PAGES;
+  }
+
+  /* 从写入位置往前 max_pages 页开始 (环形区中写入位置之后即为最旧的页) */
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  addr = s_write_addr;
+  xSemaphoreGive(s_mutex);
+  addr = LOG_FLASH_ADDR + (addr - LOG_FLASH_ADDR +
+                           (LOG_FLASH_PAGES - max_pages) * NORFLASH_PAGE_SIZE) %
+                              LOG_FLASH_SIZE;
+
+  /* 每页单独加锁，输出期间不阻塞写入 */
+  for (n = 0; n < max_pages; n++, addr = log_flash_next_addr(addr)) {
+    bool valid;
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    valid = norflash_read(addr, (uint8_t *)&s_page, sizeof(s_page)) == 0 &&
+            log_flash_header_valid(&s_page);
+    if (valid) {
+      log_flash_emit();
+      count++;
+    }
+    xSemaphoreGive(s_mutex);
+  }
+
+  /* 备份 SRAM 中未写出的页：先封存的，再追加页 */
+  for (n = 0; n < LOG_FLASH_BUFFERS + 1; n++) {
+    int8_t index = -1;
+    uint32_t primask = __get_PRIMASK();
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    __disable_irq();
+    if (n < LOG_FLASH_BUFFERS) {
+      if (s_sealed[n]) {
+        index = (int8_t)n;
+      }
+    } else {
+      index = s_active;
+    }
+    if (index >= 0) {
+      memcpy(&s_page, &LOG_FLASH_BKP->page[index], sizeof(s_page));
+    }
+    __set_PRIMASK(primask);
+    if (index >= 0 && log_flash_data_len(s_page.data) != 0) {
+      log_flash_emit();
+      count++;
+    }
+    xSemaphoreGive(s_mutex);
+  }
+  printf_flush();
+  return count;
+}
+
+/**
+ * @brief 获取运行日志统计
+ */
+void LogFlash_GetStats(LogFlashStats_t *stats) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  *stats = s_stats;
+  stats->pending = 0;
+  for (uint8_t i = 0; i < LOG_FLASH_BUFFERS; i++) {
+    if (s_sealed[i] || (int8_t)i == s_active) {
+      stats->pending += s_used[i];
+    }
+  }
+  stats->boot = s_boot;
+  stats->next_seq = s_next_seq;
+  __set_PRIMASK(primask);
+  stats->ready = s_ready;
+}
@@ -0,0 +1,99 @@
+/**
+ ******************************************************************************
+ * @file    log_flash.h
+ * @brief   运行日志持久化 (SPI NOR Flash 环形区)
+ * @details 不低于 LOG_FLASH_MIN_LEVEL 的日志在调用者上下文中编码为二进制记录帧
+ *          (与 LOG_USE_BINARY 相同，只有格式串/模块名地址与原始参数，不在目标板
+ *          上格式化)，直接追加到备份 SRAM 末尾的两个页缓冲之一：
+ *            - 页缓冲 256 字节 (页头 8 字节 + 记录帧)，写满后封存并切换到另一页，
+ *              由系统监控任务整页编程到 Flash，CPU 与擦写开销按页摊薄；
+ *            - 备份 SRAM 在 HardFault/看门狗复位时保持，封存或未写满的页在下次
+ *              启动挂载后写出，故障前的最后几条记录不丢失；掉电预警时
+ *              LogFlash_Flush() 立即写出未满的页；
+ *            - 运行日志区按 4 KB 扇区环形使用，写到扇区开头时才擦除 (覆盖最旧的
+ *              数据)，每个扇区每轮只擦一次；
+ *            - 页头带启动序号与全局递增的页序号，按序号即可还原跨重启的顺序。
+ *          追加只在关中断的几微秒内进行，不分配内存、不等待 Flash；两页缓冲都
+ *          未写出时丢弃新记录并计数。
+ *          读出：命令行 logflash dump 按时间顺序输出各页的记录帧，用与板上固件
+ *          一致的 .axf 经 log_decode.py 还原文本。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __LOG_FLASH_H
+#define __LOG_FLASH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define LOG_FLASH_ADDR 0xFC0000UL          // 运行日志区起始地址 (传感器数据记录区之后)
+#define LOG_FLASH_SIZE 0x040000UL          // 运行日志区大小 (256 KB，约 1 万条记录)
+#define LOG_FLASH_MIN_LEVEL LOG_LEVEL_WARN // 写入 Flash 的最低日志级别 (log_level_t)
+#define LOG_FLASH_RECORD_RESERVE 64        // 页内剩余不足该字节数时先切换到新页 (避免截断参数)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 运行日志统计
+ */
+typedef struct {
+  bool ready;              // 运行日志区已挂载
+  uint16_t boot;           // 本次启动序号
+  uint32_t next_seq;       // 下一页的序号
+  uint16_t pending;        // 备份 SRAM 中尚未写入 Flash 的字节数
+  uint32_t records;        // 上电以来追加的记录数
+  uint32_t dropped;        // 两页缓冲都未写出而丢弃的记录数
+  uint32_t pages_written;  // 上电以来写入的页数
+  uint32_t sectors_erased; // 上电以来擦除的扇区数
+  uint32_t errors;         // 擦写失败次数
+} LogFlashStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 恢复备份 SRAM 中的页缓冲并开始接收日志 (不访问 Flash)
+ * @note  在 log_init() 之后尽早调用，启动阶段的告警也能保存
+ */
+void LogFlash_Init(void);
+
+/**
+ * @brief 挂载运行日志区：定位写入位置，续接页序号与启动序号
+ * @note  须在 norflash_init() 成功之后调用；失败时记录保留在备份 SRAM 中
+ */
+bool LogFlash_Mount(void);
+
+/**
+ * @brief 把封存的页写入 Flash (由系统监控任务周期调用，可能阻塞一次扇区擦除)
+ */
+void LogFlash_Process(void);
+
+/**
+ * @brief 封存未写满的页并立即写入 Flash (掉电预警、关机前)
+ * @return true: 备份 SRAM 中已没有未写出的记录
+ */
+bool LogFlash_Flush(void);
+
+/**
+ * @brief 按时间顺序输出最近的若干页 (每页一行文本页头，随后为原始记录帧)
+ * @param max_pages 最多输出的 Flash 页数，0 为全部；备份 SRAM 中的页总是输出
+ * @return 输出的页数
+ */
+uint32_t LogFlash_Dump(uint32_t max_pages);
+
+/**
+ * @brief 获取运行日志统计
+ */
+void LogFlash_GetStats(LogFlashStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __LOG_FLASH_H */
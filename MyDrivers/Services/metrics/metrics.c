@@ -0,0 +1,257 @@
+/**
+ ******************************************************************************
+ * @file    metrics.c
+ * @brief   统一指标注册表源文件
+ * @details 描述表与桶边界为 const，链接到 Flash；RAM 中只有每个指标的
+ *          数值字。直方图的总和拆成低/高两个字，低字回绕时高字加 1，读者
+ *          前后两次读高字一致才采用 (恰在回绕时被抢占的更新会让读者短暂
+ *          看到偏小的总和)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "metrics.h"
+#include "main.h"
+#include <stdio.h>
+#include <string.h>
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  const char *name;
+  const char *unit;
+  MetricKind_t kind;
+  uint8_t bound_count;
+  const uint32_t *bounds;
+} MetricDesc_t;
+
+#define METRICS_BOUNDS(b) (uint8_t)(sizeof(b) / sizeof((b)[0])), (b)
+#define METRICS_SCALAR(kind) (kind), 0, NULL
+
+/* --------------------------- 私有变量 --------------------------- */
+static const uint32_t s_bounds_i2c_ms[] = {1, 2, 5, 10, 20, 50, 100, 200, 500};
+static const uint32_t s_bounds_frame_us[] = {500,   1000,  2000,  5000,
+                                             10000, 20000, 50000, 100000};
+static const uint32_t s_bounds_wait_us[] = {10,   50,    100,   500,  1000,
+                                            5000, 10000, 50000, 100000};
+// 与 sensor_jitter.c 相同的 1-2.5-5 递增
+static const uint32_t s_bounds_late_us[] = {100,   250,   500,   1000,
+                                            2500,  5000,  10000, 25000,
+                                            50000, 100000, 250000};
+
+static const MetricDesc_t s_desc[METRIC_MAX] = {
+    [METRIC_I2C_LATENCY] = {"i2c.latency", "ms", METRIC_HISTOGRAM,
+                            METRICS_BOUNDS(s_bounds_i2c_ms)},
+    [METRIC_LV_RENDER] = {"lv.render", "us", METRIC_HISTOGRAM,
+                          METRICS_BOUNDS(s_bounds_frame_us)},
+    [METRIC_LV_FLUSH] = {"lv.flush", "us", METRIC_HISTOGRAM,
+                         METRICS_BOUNDS(s_bounds_frame_us)},
+    [METRIC_MUTEX_WAIT] = {"mutex.wait", "us", METRIC_HISTOGRAM,
+                           METRICS_BOUNDS(s_bounds_wait_us)},
+    [METRIC_SENSOR_LATENESS] = {"sensor.late", "us", METRIC_HISTOGRAM,
+                                METRICS_BOUNDS(s_bounds_late_us)},
+    [METRIC_I2C_ERRORS] = {"i2c.errors", "", METRICS_SCALAR(METRIC_COUNTER)},
+    [METRIC_I2C_RECOVERIES] = {"i2c.recoveries", "",
+                               METRICS_SCALAR(METRIC_COUNTER)},
+    [METRIC_MUTEX_TIMEOUTS] = {"mutex.timeouts", "",
+                               METRICS_SCALAR(METRIC_COUNTER)},
+    [METRIC_LV_IMG_HIT] = {"lv.img.hit", "", METRICS_SCALAR(METRIC_COUNTER)},
+    [METRIC_LV_IMG_MISS] = {"lv.img.miss", "", METRICS_SCALAR(METRIC_COUNTER)},
+    [METRIC_LV_SHADOW_HIT] = {"lv.shadow.hit", "",
+                              METRICS_SCALAR(METRIC_COUNTER)},
+    [METRIC_LV_SHADOW_MISS] = {"lv.shadow.miss", "",
+                               METRICS_SCALAR(METRIC_COUNTER)},
+    [METRIC_CPU_LOAD] = {"cpu.load", "0.1%", METRICS_SCALAR(METRIC_GAUGE)},
+    [METRIC_HEAP_FREE] = {"heap.free", "B", METRICS_SCALAR(METRIC_GAUGE)},
+    [METRIC_HEAP_MIN_FREE] = {"heap.min_free", "B",
+                              METRICS_SCALAR(METRIC_GAUGE)},
+    [METRIC_LV_MEM_FREE] = {"lv.mem.free", "B", METRICS_SCALAR(METRIC_GAUGE)},
+    [METRIC_LV_MEM_FRAG] = {"lv.mem.frag", "%", METRICS_SCALAR(METRIC_GAUGE)},
+};
+
+static const char *const s_kind_names[] = {"counter", "gauge", "histogram"};
+
+// 计数器与仪表的值 (按 id - METRIC_HIST_COUNT 存放)
+static volatile uint32_t s_value[METRIC_MAX - METRIC_HIST_COUNT];
+static volatile uint32_t s_bins[METRIC_HIST_COUNT][METRICS_HIST_BUCKETS];
+static volatile uint32_t s_sum_lo[METRIC_HIST_COUNT];
+static volatile uint32_t s_sum_hi[METRIC_HIST_COUNT];
+static volatile uint32_t s_max[METRIC_HIST_COUNT];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/* 原子加，返回加之前的值 */
+static uint32_t metrics_atomic_add(volatile uint32_t *p, uint32_t n) {
+  uint32_t v;
+
+  do {
+    v = __LDREXW(p);
+  } while (__STREXW(v + n, p) != 0);
+  return v;
+}
+
+static void metrics_atomic_max(volatile uint32_t *p, uint32_t value) {
+  do {
+    if (__LDREXW(p) >= value) {
+      __CLREX();
+      return;
+    }
+  } while (__STREXW(value, p) != 0);
+}
+
+static uint64_t metrics_read_sum(uint8_t h) {
+  uint32_t hi;
+  uint32_t lo;
+
+  do {
+    hi = s_sum_hi[h];
+    lo = s_sum_lo[h];
+  } while (hi != s_sum_hi[h]);
+  return ((uint64_t)hi << 32) | lo;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 计数器加 n
+ */
+void Metrics_Add(MetricId_t id, uint32_t n) {
+  if (id < METRIC_HIST_COUNT || id >= METRIC_MAX) {
+    return;
+  }
+  (void)metrics_atomic_add(&s_value[id - METRIC_HIST_COUNT], n);
+}
+
+/**
+ * @brief 设置仪表的值
+ */
+void Metrics_Set(MetricId_t id, uint32_t value) {
+  if (id < METRIC_HIST_COUNT || id >= METRIC_MAX) {
+    return;
+  }
+  s_value[id - METRIC_HIST_COUNT] = value; // 对齐的字写入本身是原子的
+}
+
+/**
+ * @brief 向直方图加入一个样本
+ */
+void Metrics_Observe(MetricId_t id, uint32_t value) {
+  const MetricDesc_t *d;
+  uint8_t i = 0;
+
+  if ((unsigned)id >= METRIC_HIST_COUNT) {
+    return;
+  }
+  d = &s_desc[id];
+  while (i < d->bound_count && value > d->bounds[i]) {
+    i++;
+  }
+  (void)metrics_atomic_add(&s_bins[id][i], 1U);
+  if (metrics_atomic_add(&s_sum_lo[id], value) > UINT32_MAX - value) {
+    (void)metrics_atomic_add(&s_sum_hi[id], 1U);
+  }
+  metrics_atomic_max(&s_max[id], value);
+}
+
+/**
+ * @brief 读取一个指标
+ */
+bool Metrics_Read(MetricId_t id, MetricSnapshot_t *out) {
+  const MetricDesc_t *d;
+
+  if ((unsigned)id >= METRIC_MAX || out == NULL) {
+    return false;
+  }
+  d = &s_desc[id];
+  memset(out, 0, sizeof(MetricSnapshot_t));
+  out->name = d->name;
+  out->unit = d->unit;
+  out->kind = d->kind;
+
+  if (id >= METRIC_HIST_COUNT) {
+    out->value = s_value[id - METRIC_HIST_COUNT];
+    return true;
+  }
+  out->bound_count = d->bound_count;
+  out->bounds = d->bounds;
+  for (uint8_t i = 0; i <= d->bound_count; i++) {
+    out->bins[i] = s_bins[id][i];
+    out->value += out->bins[i];
+  }
+  out->sum = metrics_read_sum((uint8_t)id);
+  out->max = s_max[id];
+  return true;
+}
+
+/**
+ * @brief 估计直方图的分位数
+ */
+uint32_t Metrics_Percentile(const MetricSnapshot_t *snap, uint8_t pct) {
+  uint32_t target;
+  uint32_t seen = 0;
+
+  if (snap->kind != METRIC_HISTOGRAM || snap->value == 0) {
+    return 0;
+  }
+  // 第 ceil(count * pct / 100) 个样本所在的桶
+  target = (uint32_t)(((uint64_t)snap->value * pct + 99U) / 100U);
+  for (uint8_t i = 0; i < snap->bound_count; i++) {
+    seen += snap->bins[i];
+    if (seen >= target) {
+      return snap->bounds[i] < snap->max ? snap->bounds[i] : snap->max;
+    }
+  }
+  return snap->max;
+}
+
+/**
+ * @brief 把读取结果格式化为一行文本
+ */
+int Metrics_Format(const MetricSnapshot_t *snap, char *buf, size_t size) {
+  int n;
+
+  if (snap->kind != METRIC_HISTOGRAM) {
+    n = snprintf(buf, size, "%-15s %-9s %lu %s", snap->name,
+                 Metrics_KindName(snap->kind), (unsigned long)snap->value,
+                 snap->unit);
+  } else {
+    n = snprintf(buf, size,
+                 "%-15s n=%lu avg=%lu p50=%lu p90=%lu p99=%lu max=%lu %s",
+                 snap->name, (unsigned long)snap->value,
+                 (unsigned long)(snap->value != 0 ? snap->sum / snap->value
+                                                  : 0),
+                 (unsigned long)Metrics_Percentile(snap, 50),
+                 (unsigned long)Metrics_Percentile(snap, 90),
+                 (unsigned long)Metrics_Percentile(snap, 99),
+                 (unsigned long)snap->max, snap->unit);
+  }
+  if (n < 0) {
+    return 0;
+  }
+  return (size_t)n < size ? n : (int)size - 1;
+}
+
+/**
+ * @brief 类型名称
+ */
+const char *Metrics_KindName(MetricKind_t kind) {
+  return (unsigned)kind <= METRIC_HISTOGRAM ? s_kind_names[kind] : "?";
+}
+
+/**
+ * @brief 清零计数器与直方图
+ */
+void Metrics_Reset(void) {
+  for (int id = 0; id < METRIC_MAX; id++) {
+    if (id < METRIC_HIST_COUNT) {
+      for (uint8_t i = 0; i < METRICS_HIST_BUCKETS; i++) {
+        s_bins[id][i] = 0;
+      }
+      s_sum_hi[id] = 0;
+      s_sum_lo[id] = 0;
+      s_max[id] = 0;
+    } else if (s_desc[id].kind == METRIC_COUNTER) {
+      s_value[id - METRIC_HIST_COUNT] = 0;
+    }
+  }
+}
@@ -0,0 +1,159 @@
+/**
+ ******************************************************************************
+ * @file    metrics.h
+ * @brief   统一指标注册表头文件
+ * @details 各子系统的性能数字 (I2C 事务耗时、LVGL 渲染/刷屏耗时、互斥锁等待、
+ *          采样启动延迟、缓存命中、堆与碎片) 集中登记在一张静态表中：
+ *            - 计数器 (COUNTER)：只增不减的事件数；
+ *            - 仪表 (GAUGE)：最近一次设置的瞬时值；
+ *            - 直方图 (HISTOGRAM)：固定桶计数 + 总和 + 最大值，桶边界随
+ *              描述表存放在 Flash 中，分位数取所在桶的上界。
+ *          指标在编译时通过 MetricId_t 与 metrics.c 中的描述表登记，不需要
+ *          初始化，上电即可更新。更新为每个字的 LDREX/STREX 原子操作，
+ *          任务与中断中均可调用，不关中断、不加锁；一次直方图更新只涉及
+ *          桶计数、总和与最大值三个字，读者看到的各字段可能相差正在进行的
+ *          一次更新。
+ *          读取统一经过 Metrics_Read 得到快照，命令行 (metrics)、诊断页面与
+ *          遥测上行 (TelemetryCodec_BuildMetrics) 共用这一条导出路径。
+ *          各模块原有的窗口统计 (frame_stats、task_plan 等) 保持不变，
+ *          注册表记录的是上电以来的累计值，供长期趋势与跨设备比较。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __METRICS_H
+#define __METRICS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define METRICS_ENABLE 1       // 0: 所有指标宏编译为空
+#define METRICS_HIST_BUCKETS 12 // 直方图最多 11 个边界 + 溢出桶
+#define METRICS_LINE_MAX 96    // Metrics_Format 一行的最大长度
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 指标 (与 metrics.c 中的描述表一一对应)
+ * @note  直方图排在最前，桶计数按序号存放
+ */
+typedef enum {
+  /* 直方图 */
+  METRIC_I2C_LATENCY = 0,  // I2C 事务提交到完成 (ms)
+  METRIC_LV_RENDER,        // LVGL 一次刷新的渲染耗时 (us，不含等待刷屏)
+  METRIC_LV_FLUSH,         // 单次 flush 调用到 DMA 完成 (us)
+  METRIC_MUTEX_WAIT,       // 获取互斥锁的阻塞时间 (us)
+  METRIC_SENSOR_LATENESS,  // 计划时刻到实际开始采样 (us)
+  METRIC_HIST_COUNT,
+
+  /* 计数器 */
+  METRIC_I2C_ERRORS = METRIC_HIST_COUNT, // I2C 失败的事务
+  METRIC_I2C_RECOVERIES,                 // I2C 总线卡死恢复
+  METRIC_MUTEX_TIMEOUTS,                 // 获取互斥锁超时
+  METRIC_LV_IMG_HIT,                     // LVGL 图像缓存命中
+  METRIC_LV_IMG_MISS,
+  METRIC_LV_SHADOW_HIT,                  // LVGL 阴影缓存命中
+  METRIC_LV_SHADOW_MISS,
+
+  /* 仪表 */
+  METRIC_CPU_LOAD,      // 总 CPU 负载 (0.1%)
+  METRIC_HEAP_FREE,     // FreeRTOS 堆剩余 (B)
+  METRIC_HEAP_MIN_FREE, // FreeRTOS 堆历史最小剩余 (B)
+  METRIC_LV_MEM_FREE,   // LVGL 内存池剩余 (B)
+  METRIC_LV_MEM_FRAG,   // LVGL 内存池碎片率 (%)
+  METRIC_MAX
+} MetricId_t;
+
+typedef enum {
+  METRIC_COUNTER = 0,
+  METRIC_GAUGE,
+  METRIC_HISTOGRAM
+} MetricKind_t;
+
+/**
+ * @brief 一个指标的读取结果
+ */
+typedef struct {
+  const char *name;
+  const char *unit;
+  MetricKind_t kind;
+  uint32_t value;          // 计数器/仪表的值；直方图为样本数 (各桶之和)
+  uint64_t sum;            // 直方图样本之和
+  uint32_t max;            // 直方图最大样本
+  uint8_t bound_count;     // 直方图桶边界数 (桶数为边界数 + 1)
+  const uint32_t *bounds;  // 各桶的上界 (含)，最后一个桶没有上界
+  uint32_t bins[METRICS_HIST_BUCKETS];
+} MetricSnapshot_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 计数器加 n (任务与中断中均可调用)
+ */
+void Metrics_Add(MetricId_t id, uint32_t n);
+
+/**
+ * @brief 设置仪表的值 (任务与中断中均可调用)
+ */
+void Metrics_Set(MetricId_t id, uint32_t value);
+
+/**
+ * @brief 向直方图加入一个样本 (任务与中断中均可调用)
+ */
+void Metrics_Observe(MetricId_t id, uint32_t value);
+
+/**
+ * @brief 读取一个指标
+ * @return false: 序号无效
+ */
+bool Metrics_Read(MetricId_t id, MetricSnapshot_t *out);
+
+/**
+ * @brief 估计直方图的分位数
+ * @param pct 百分位 (1~100)
+ * @return 所在桶的上界 (不超过最大值)；无样本返回 0
+ */
+uint32_t Metrics_Percentile(const MetricSnapshot_t *snap, uint8_t pct);
+
+/**
+ * @brief 把读取结果格式化为一行文本 (不含换行)
+ * @return 写入的字符数
+ */
+int Metrics_Format(const MetricSnapshot_t *snap, char *buf, size_t size);
+
+/**
+ * @brief 类型名称 ("counter" / "gauge" / "histogram")
+ */
+const char *Metrics_KindName(MetricKind_t kind);
+
+/**
+ * @brief 清零计数器与直方图 (仪表保留)
+ * @note  逐字清零，与之并发的更新可能丢失
+ */
+void Metrics_Reset(void);
+
+/* --------------------------- 指标宏 --------------------------- */
+#if METRICS_ENABLE
+#define METRIC_INC(id) Metrics_Add((id), 1U)
+#define METRIC_ADD(id, n) Metrics_Add((id), (n))
+#define METRIC_SET(id, value) Metrics_Set((id), (value))
+#define METRIC_OBSERVE(id, value) Metrics_Observe((id), (value))
+#else
+#define METRIC_INC(id) ((void)0)
+#define METRIC_ADD(id, n) ((void)(n))
+#define METRIC_SET(id, value) ((void)(value))
+#define METRIC_OBSERVE(id, value) ((void)(value))
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __METRICS_H */
@@ -0,0 +1,454 @@
+/**
+ ******************************************************************************
+ * @file    modbus_gateway.c
+ * @brief   Modbus RTU 网关实现
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "modbus_gateway.h"
+#include "checksum.h"
+#include "rs485.h"
+#include "sensor_remote.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_MODULE "GATEWAY"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define GATEWAY_FC_READ_INPUT 0x04
+#define GATEWAY_BLOCK_HEADER 0xFF // 计划项：读设备块 (映像版本与传感器数)
+#define GATEWAY_HEADER_QTY 2
+#define GATEWAY_BLOCK_QTY                                                      \
+  (MODBUS_IR_CHANNEL_BASE + SENSOR_MAX_CHANNELS * MODBUS_IR_CHANNEL_STRIDE)
+#define GATEWAY_NODES                                                          \
+  (MODBUS_GATEWAY_NODE_COUNT < MODBUS_GATEWAY_MAX_NODES                        \
+       ? MODBUS_GATEWAY_NODE_COUNT                                             \
+       : MODBUS_GATEWAY_MAX_NODES)
+#define GATEWAY_PLAN_MAX                                                       \
+  (MODBUS_GATEWAY_MAX_NODES * (1 + MODBUS_GATEWAY_SENSORS_PER_NODE))
+#define GATEWAY_REMOTE_NONE -1 // 尚未导入
+#define GATEWAY_REMOTE_FULL -2 // 远端实例已满或注册失败，不再尝试
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 一轮轮询中的一次请求
+ */
+typedef struct {
+  uint8_t node;  // 节点下标
+  uint8_t block; // 传感器块下标，GATEWAY_BLOCK_HEADER 为设备块
+} gateway_xfer_t;
+
+typedef struct {
+  ModbusGatewayNode_t info;
+  int8_t remote[MODBUS_GATEWAY_SENSORS_PER_NODE]; // 块 -> 远端实例下标
+  uint8_t misses;                                 // 连续无应答次数
+  uint32_t next_header;                           // 下次读取设备块的时刻
+} gateway_node_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static gateway_node_t s_nodes[MODBUS_GATEWAY_MAX_NODES];
+static SensorRemote_t s_remotes[MODBUS_GATEWAY_MAX_REMOTES];
+static uint8_t s_remote_count = 0;
+
+static gateway_xfer_t s_plan[GATEWAY_PLAN_MAX];
+// 请求与应答缓冲区成对交替使用：解析一帧应答时下一个请求正在发送
+static uint8_t s_req[2][8];
+static uint8_t s_rx[2][RS485_FRAME_MAX];
+static ModbusGatewayStats_t s_stats;
+
+static TaskHandle_t s_task = NULL;
+static StaticTask_t s_task_tcb;
+static StackType_t s_task_stack[MODBUS_GATEWAY_TASK_STACK_SIZE];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static uint16_t gateway_get16(const uint8_t *p) {
+  return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static void gateway_put16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)(v >> 8);
+  p[1] = (uint8_t)v;
+}
+
+static uint16_t gateway_qty(const gateway_xfer_t *x) {
+  return x->block == GATEWAY_BLOCK_HEADER ? GATEWAY_HEADER_QTY
+                                          : GATEWAY_BLOCK_QTY;
+}
+
+/**
+ * @brief 组装并发出一个读输入寄存器请求
+ * @param buf 使用的缓冲区对 (与正在解析的应答不同)
+ */
+static void gateway_send(const gateway_xfer_t *x, uint8_t buf) {
+  uint8_t *req = s_req[buf];
+  uint16_t start = x->block == GATEWAY_BLOCK_HEADER
+                       ? 0
+                       : (uint16_t)(MODBUS_IR_SENSOR_BASE +
+                                    x->block * MODBUS_IR_SENSOR_STRIDE);
+  uint16_t crc;
+
+  req[0] = s_nodes[x->node].info.addr;
+  req[1] = GATEWAY_FC_READ_INPUT;
+  gateway_put16(&req[2], start);
+  gateway_put16(&req[4], gateway_qty(x));
+  crc = CRC16_Modbus_Compute(req, 6);
+  req[6] = (uint8_t)crc;
+  req[7] = (uint8_t)(crc >> 8);
+
+  // 接收缓冲区中可能还有上一个请求迟到的应答，发送前丢弃
+  if (RS485_Read(s_rx[buf]) != 0) {
+    s_stats.stray++;
+  }
+  (void)ulTaskNotifyTake(pdTRUE, 0);
+  (void)RS485_Write(req, sizeof(s_req[0]));
+  s_nodes[x->node].info.requests++;
+  s_stats.requests++;
+}
+
+/**
+ * @brief 等待一帧应答
+ * @return 帧长，超时返回 0
+ */
+static uint16_t gateway_wait(uint8_t *rx) {
+  TickType_t start = xTaskGetTickCount();
+  TickType_t timeout = pdMS_TO_TICKS(MODBUS_GATEWAY_TIMEOUT_MS);
+
+  for (;;) {
+    uint16_t len = RS485_Read(rx);
+    TickType_t elapsed = xTaskGetTickCount() - start;
+
+    if (len != 0 || elapsed >= timeout) {
+      return len;
+    }
+    (void)ulTaskNotifyTake(pdTRUE, timeout - elapsed);
+  }
+}
+
+/**
+ * @brief 节点离线：清除远端实例的有效标志 (传感器任务随后按读取失败处理)
+ */
+static void gateway_node_offline(gateway_node_t *node) {
+  node->info.online = false;
+  for (uint8_t b = 0; b < MODBUS_GATEWAY_SENSORS_PER_NODE; b++) {
+    if (node->remote[b] >= 0) {
+      SensorRemote_SetOffline(&s_remotes[node->remote[b]]);
+    }
+  }
+  LOG_WARN("节点 %u 离线", (unsigned)node->info.addr);
+}
+
+/**
+ * @brief 一次请求没有得到有效应答
+ */
+static void gateway_miss(const gateway_xfer_t *x) {
+  gateway_node_t *node = &s_nodes[x->node];
+
+  node->info.misses++;
+  if (node->misses < UINT8_MAX) {
+    node->misses++;
+  }
+  if (node->info.online && node->misses >= MODBUS_GATEWAY_OFFLINE_MISSES) {
+    gateway_node_offline(node);
+  }
+}
+
+/**
+ * @brief 按传感器块中的类型注册远端实例
+ * @return 远端实例下标，失败返回 GATEWAY_REMOTE_FULL
+ */
+static int8_t gateway_import(uint8_t node_index, SensorType_t type) {
+  gateway_node_t *node = &s_nodes[node_index];
+  char name[SENSOR_REMOTE_NAME_MAX];
+
+  if (s_remote_count >= MODBUS_GATEWAY_MAX_REMOTES) {
+    LOG_WARN("远端实例已满，忽略节点 %u 的 %s", (unsigned)node->info.addr,
+             SensorType_ToString(type));
+    return GATEWAY_REMOTE_FULL;
+  }
+  snprintf(name, sizeof(name), "%s @%u", SensorType_ToString(type),
+           (unsigned)node->info.addr);
+  if (SensorRemote_Attach(&s_remotes[s_remote_count], type, name,
+                          MODBUS_GATEWAY_CYCLE_MS / 2) ==
+      SENSOR_HANDLE_INVALID) {
+    return GATEWAY_REMOTE_FULL;
+  }
+  node->info.imported++;
+  return (int8_t)s_remote_count++;
+}
+
+/**
+ * @brief 解析设备块：映像版本与传感器数
+ */
+static void gateway_parse_header(gateway_node_t *node, const uint8_t *regs) {
+  uint16_t version = gateway_get16(&regs[0]);
+  uint16_t count = gateway_get16(&regs[2]);
+
+  if (version != MODBUS_MAP_VERSION) {
+    if (node->info.online) {
+      gateway_node_offline(node);
+    }
+    LOG_WARN("节点 %u 映像版本 %u 不符", (unsigned)node->info.addr,
+             (unsigned)version);
+    return;
+  }
+  node->info.sensors = (uint8_t)(count > UINT8_MAX ? UINT8_MAX : count);
+  if (!node->info.online) {
+    node->info.online = true;
+    LOG_INFO("节点 %u 上线: %u 个传感器", (unsigned)node->info.addr,
+             (unsigned)count);
+  }
+}
+
+/**
+ * @brief 解析传感器块并更新远端实例缓存 (首次读到时注册)
+ */
+static void gateway_parse_block(uint8_t node_index, uint8_t block,
+                                const uint8_t *regs) {
+  gateway_node_t *node = &s_nodes[node_index];
+  SensorType_t type =
+      SENSOR_HANDLE_TYPE(gateway_get16(&regs[MODBUS_IR_S_HANDLE * 2]));
+  uint16_t status = gateway_get16(&regs[MODBUS_IR_S_STATUS * 2]);
+  uint16_t valid = gateway_get16(&regs[MODBUS_IR_S_VALID * 2]);
+  uint16_t samples = gateway_get16(&regs[MODBUS_IR_S_SAMPLES * 2]);
+  int16_t fixed[SENSOR_MAX_CHANNELS];
+
+  if (type <= SENSOR_TYPE_NONE || type >= SENSOR_TYPE_MAX) {
+    return; // 空块 (节点的传感器比设备块报告的少)
+  }
+  if (node->remote[block] == GATEWAY_REMOTE_NONE) {
+    node->remote[block] = gateway_import(node_index, type);
+  }
+  if (node->remote[block] < 0 || s_remotes[node->remote[block]].type != type) {
+    return; // 未导入，或节点重新排列了传感器 (保留原实例直到重启)
+  }
+  for (uint8_t ch = 0; ch < SENSOR_MAX_CHANNELS; ch++) {
+    fixed[ch] = (int16_t)gateway_get16(
+        &regs[(MODBUS_IR_CHANNEL_BASE + ch * MODBUS_IR_CHANNEL_STRIDE +
+               MODBUS_IR_C_VALUE) * 2]);
+  }
+  SensorRemote_Update(&s_remotes[node->remote[block]],
+                      status == SENSOR_STATUS_ONLINE && valid != 0, samples,
+                      fixed, SENSOR_MAX_CHANNELS);
+}
+
+/**
+ * @brief 校验并解析一帧应答
+ * @return false: 不是该请求的有效应答
+ */
+static bool gateway_parse(const gateway_xfer_t *x, const uint8_t *rx,
+                          uint16_t len) {
+  gateway_node_t *node = &s_nodes[x->node];
+  uint16_t qty = gateway_qty(x);
+  uint16_t crc;
+
+  if (len < 5 || rx[0] != node->info.addr) {
+    s_stats.stray++;
+    return false;
+  }
+  crc = CRC16_Modbus_Compute(rx, len - 2);
+  if (rx[len - 2] != (uint8_t)crc || rx[len - 1] != (uint8_t)(crc >> 8)) {
+    s_stats.crc_errors++;
+    return false;
+  }
+  if (rx[1] == (GATEWAY_FC_READ_INPUT | 0x80)) {
+    // 节点在线但映像比预期小 (注册表容量不同)：不再轮询之后的块
+    s_stats.exceptions++;
+    node->misses = 0;
+    if (x->block != GATEWAY_BLOCK_HEADER && x->block < node->info.sensors) {
+      node->info.sensors = x->block;
+    }
+    return true;
+  }
+  if (rx[1] != GATEWAY_FC_READ_INPUT || rx[2] != qty * 2 ||
+      len != 5 + qty * 2) {
+    s_stats.stray++;
+    return false;
+  }
+
+  s_stats.responses++;
+  node->misses = 0;
+  if (x->block == GATEWAY_BLOCK_HEADER) {
+    gateway_parse_header(node, &rx[3]);
+  } else {
+    gateway_parse_block(x->node, x->block, &rx[3]);
+  }
+  return true;
+}
+
+/**
+ * @brief 生成本轮的请求计划
+ * @details 到期的节点先读设备块 (离线节点只读设备块)，在线节点再读
+ *          各传感器块
+ */
+static uint8_t gateway_plan(void) {
+  uint32_t now = HAL_GetTick();
+  uint8_t n = 0;
+
+  for (uint8_t i = 0; i < GATEWAY_NODES; i++) {
+    gateway_node_t *node = &s_nodes[i];
+    uint8_t blocks = node->info.sensors < MODBUS_GATEWAY_SENSORS_PER_NODE
+                         ? node->info.sensors
+                         : MODBUS_GATEWAY_SENSORS_PER_NODE;
+
+    if ((int32_t)(now - node->next_header) >= 0) {
+      node->next_header = now + MODBUS_GATEWAY_REDISCOVER_MS;
+      s_plan[n].node = i;
+      s_plan[n].block = GATEWAY_BLOCK_HEADER;
+      n++;
+    }
+    if (!node->info.online) {
+      continue;
+    }
+    for (uint8_t b = 0; b < blocks; b++) {
+      s_plan[n].node = i;
+      s_plan[n].block = b;
+      n++;
+    }
+  }
+  return n;
+}
+
+/**
+ * @brief 计划中下一个可发出的请求 (跳过本轮已离线节点的传感器块)
+ * @return 下标，没有返回 -1
+ */
+static int16_t gateway_next(int16_t i, uint8_t n) {
+  for (i++; i < n; i++) {
+    if (s_plan[i].block == GATEWAY_BLOCK_HEADER ||
+        s_nodes[s_plan[i].node].info.online) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief 执行一轮轮询 (流水线)
+ * @details 收到应答 (或超时) 后立即发出下一个请求，然后解析刚收到的
+ *          应答：解析与注册远端实例的耗时和下一个请求的发送、对方的
+ *          处理重叠，总线上只剩帧间静默。
+ */
+static void gateway_run(uint8_t n) {
+  int16_t cur = gateway_next(-1, n);
+  uint8_t buf = 0;
+
+  if (cur < 0) {
+    return;
+  }
+  gateway_send(&s_plan[cur], buf);
+
+  while (cur >= 0) {
+    uint8_t *rx = s_rx[buf];
+    uint16_t len = gateway_wait(rx);
+    int16_t next;
+
+    if (len == 0) {
+      s_stats.timeouts++;
+      gateway_miss(&s_plan[cur]); // 先处理超时，离线节点的后续请求不再发出
+    }
+    next = gateway_next(cur, n);
+    if (next >= 0) {
+      vTaskDelay(pdMS_TO_TICKS(MODBUS_GATEWAY_TURNAROUND_MS));
+      buf ^= 1U;
+      gateway_send(&s_plan[next], buf);
+    }
+    if (len != 0 && !gateway_parse(&s_plan[cur], rx, len)) {
+      gateway_miss(&s_plan[cur]);
+    }
+    cur = next;
+  }
+}
+
+/**
+ * @brief 网关任务：按固定周期执行一轮轮询
+ */
+static void gateway_task(void *argument) {
+  TickType_t last_wake = xTaskGetTickCount();
+  (void)argument;
+
+  for (;;) {
+    uint32_t start = HAL_GetTick();
+    uint32_t elapsed;
+    uint8_t online = 0;
+
+    gateway_run(gateway_plan());
+
+    elapsed = HAL_GetTick() - start;
+    for (uint8_t i = 0; i < GATEWAY_NODES; i++) {
+      online += s_nodes[i].info.online ? 1 : 0;
+    }
+    taskENTER_CRITICAL();
+    s_stats.cycles++;
+    if (elapsed > s_stats.cycle_ms_max) {
+      s_stats.cycle_ms_max = elapsed;
+    }
+    s_stats.nodes_online = online;
+    s_stats.remotes = s_remote_count;
+    taskEXIT_CRITICAL();
+
+    vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(MODBUS_GATEWAY_CYCLE_MS));
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化
+ */
+bool ModbusGateway_Init(void) {
+  if (s_task != NULL) {
+    return true;
+  }
+  if (GATEWAY_NODES == 0) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < GATEWAY_NODES; i++) {
+    s_nodes[i].info.addr = (uint8_t)(MODBUS_GATEWAY_FIRST_NODE + i);
+    s_nodes[i].next_header = HAL_GetTick();
+    memset(s_nodes[i].remote, GATEWAY_REMOTE_NONE, sizeof(s_nodes[i].remote));
+  }
+
+  s_task = xTaskCreateStatic(gateway_task, "gateway",
+                             MODBUS_GATEWAY_TASK_STACK_SIZE, NULL,
+                             MODBUS_GATEWAY_TASK_PRIORITY, s_task_stack,
+                             &s_task_tcb);
+  if (!RS485_Init(MODBUS_BAUDRATE, s_task)) {
+    return false;
+  }
+
+  LOG_INFO("Modbus 网关已启动: 节点 %u~%u, %lu bps",
+           (unsigned)MODBUS_GATEWAY_FIRST_NODE,
+           (unsigned)(MODBUS_GATEWAY_FIRST_NODE + GATEWAY_NODES - 1),
+           (unsigned long)MODBUS_BAUDRATE);
+  return true;
+}
+
+/**
+ * @brief 获取节点状态
+ */
+bool ModbusGateway_GetNode(uint8_t i, ModbusGatewayNode_t *out) {
+  if (i >= GATEWAY_NODES) {
+    return false;
+  }
+  taskENTER_CRITICAL();
+  *out = s_nodes[i].info;
+  taskEXIT_CRITICAL();
+  return true;
+}
+
+/**
+ * @brief 获取网关统计
+ */
+void ModbusGateway_GetStats(ModbusGatewayStats_t *stats) {
+  taskENTER_CRITICAL();
+  *stats = s_stats;
+  taskEXIT_CRITICAL();
+}
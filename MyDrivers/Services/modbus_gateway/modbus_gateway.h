@@ -0,0 +1,113 @@
+/**
+ ******************************************************************************
+ * @file    modbus_gateway.h
+ * @brief   Modbus RTU 网关 (RS-485 主站)
+ * @details 一台设备作为楼层网关，轮询同一总线上其他 EnviroSense 节点的
+ *          从站寄存器映像 (见 modbus_slave.h)，把节点上的传感器导入本机
+ *          传感器注册表成为远端实例：
+ *            - 节点地址为 MODBUS_GATEWAY_FIRST_NODE 起连续的
+ *              MODBUS_GATEWAY_NODE_COUNT 个，先读设备块得到传感器数，再按
+ *              传感器块轮询 (每块一次 04 请求)；
+ *            - 流水线：收到一帧应答后先发出下一个请求 (DMA 发送)，在请求
+ *              与对方应答在总线上传输期间解析这一帧，解析耗时不占总线；
+ *            - 首次读到某个传感器块时按块中的类型注册远端实例 (名称为
+ *              "类型 @地址")，实例的驱动回调从网关缓存中取远端样本计数
+ *              变化后的最新值，历史、统计、告警、界面列表与遥测上行都与
+ *              本地传感器相同；
+ *            - 连续 MODBUS_GATEWAY_OFFLINE_MISSES 次无应答判定节点离线，
+ *              其远端实例读取失败后按传感器任务的退避机制处理，节点恢复后
+ *              自动重新上线。
+ *          网关与从站共用 RS-485，MODBUS_GATEWAY_NODE_COUNT 非 0 时启动网关
+ *          而不启动从站。远端实例占用本机注册表，须相应加大
+ *          SENSOR_MAX_INSTANCES 与 SENSOR_MAX_PER_TYPE (见 sensor_task.h)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __MODBUS_GATEWAY_H
+#define __MODBUS_GATEWAY_H
+
+#include "modbus_slave.h"
+#include "task_plan.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#ifndef MODBUS_GATEWAY_NODE_COUNT
+#define MODBUS_GATEWAY_NODE_COUNT 0        // 轮询的节点数 (0: 不作为网关，启动从站)
+#endif
+#ifndef MODBUS_GATEWAY_FIRST_NODE
+#define MODBUS_GATEWAY_FIRST_NODE 2        // 第一个节点的从站地址，其余依次加 1
+#endif
+#define MODBUS_GATEWAY_MAX_NODES 16        // 节点数上限
+#define MODBUS_GATEWAY_SENSORS_PER_NODE 3  // 每个节点最多导入的传感器块数
+#define MODBUS_GATEWAY_MAX_REMOTES 12      // 远端实例总数上限 (另受注册表容量限制)
+#define MODBUS_GATEWAY_CYCLE_MS 1000       // 一轮轮询的周期
+#define MODBUS_GATEWAY_TIMEOUT_MS 50       // 请求发出后等待应答的上限
+#define MODBUS_GATEWAY_TURNAROUND_MS 2     // 两帧之间的静默时间 (不少于 3.5 个字符)
+#define MODBUS_GATEWAY_OFFLINE_MISSES 3    // 连续无应答多少次判定节点离线
+#define MODBUS_GATEWAY_REDISCOVER_MS 10000 // 重新读取设备块 (传感器数) 的间隔
+#define MODBUS_GATEWAY_TASK_STACK_SIZE 320 // 网关任务栈大小 (单位: 字)
+#define MODBUS_GATEWAY_TASK_PRIORITY TASK_PRIO_MODBUS
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 节点状态
+ */
+typedef struct {
+  uint8_t addr;      // 从站地址
+  bool online;       // 最近有应答
+  uint8_t sensors;   // 节点报告的传感器数
+  uint8_t imported;  // 已导入的远端实例数
+  uint32_t requests; // 发给该节点的请求数
+  uint32_t misses;   // 无应答或应答无效的次数
+} ModbusGatewayNode_t;
+
+/**
+ * @brief 网关统计
+ */
+typedef struct {
+  uint32_t cycles;       // 完成的轮询轮数
+  uint32_t requests;     // 发出的请求数
+  uint32_t responses;    // 有效应答数
+  uint32_t timeouts;     // 超时未应答次数
+  uint32_t crc_errors;   // CRC 错误的应答数
+  uint32_t exceptions;   // 异常应答数
+  uint32_t stray;        // 与当前请求不匹配的帧 (迟到的应答等)
+  uint32_t cycle_ms_max; // 一轮轮询的最长耗时
+  uint8_t nodes_online;  // 在线节点数
+  uint8_t remotes;       // 已注册的远端实例数
+} ModbusGatewayStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化节点表、串口并启动网关任务
+ * @note  须在传感器系统初始化之后调用
+ * @return false: 未配置节点或串口初始化失败
+ */
+bool ModbusGateway_Init(void);
+
+/**
+ * @brief 获取节点状态
+ * @param i 节点下标 (0 ~ MODBUS_GATEWAY_NODE_COUNT - 1)
+ * @return false: 下标越界
+ */
+bool ModbusGateway_GetNode(uint8_t i, ModbusGatewayNode_t *out);
+
+/**
+ * @brief 获取网关统计
+ */
+void ModbusGateway_GetStats(ModbusGatewayStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODBUS_GATEWAY_H */
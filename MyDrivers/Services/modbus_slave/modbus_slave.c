@@ -0,0 +1,499 @@
+/**
+ ******************************************************************************
+ * @file    modbus_slave.c
+ * @brief   Modbus RTU 从站实现
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "modbus_slave.h"
+#include "checksum.h"
+#include "devices_manager.h"
+#include "rs485.h"
+#include "sensor_event_bus.h"
+#include "sys_clock.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+#define LOG_MODULE "MODBUS"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define MODBUS_FC_READ_HOLDING 0x03
+#define MODBUS_FC_READ_INPUT 0x04
+#define MODBUS_FC_WRITE_SINGLE 0x06
+#define MODBUS_FC_WRITE_MULTIPLE 0x10
+
+#define MODBUS_EX_ILLEGAL_FUNCTION 0x01
+#define MODBUS_EX_ILLEGAL_ADDRESS 0x02
+#define MODBUS_EX_ILLEGAL_VALUE 0x03
+
+#define MODBUS_READ_MAX 125  // 单次读取的最大寄存器数
+#define MODBUS_WRITE_MAX 123 // 单次写入的最大寄存器数
+#define MODBUS_TURNAROUND_MS 2 // 应答前的静默时间 (不少于 3.5 个字符)
+
+/* 输入寄存器：设备块 */
+enum {
+  IR_MAP_VERSION = 0,
+  IR_SENSOR_COUNT,
+  IR_UPTIME_HI,
+  IR_UPTIME_LO,
+  IR_ALARM_ACTIVE,
+  IR_LED_MODE,
+  IR_LED_SLOT,
+  IR_LED_BRIGHTNESS,
+  IR_LED_AUTO_BRIGHTNESS,
+  IR_LED_RG,
+  IR_LED_B,
+  IR_MOTOR_MODE,
+  IR_MOTOR_SPEED,
+  IR_MOTOR_SETPOINT,
+};
+
+/* 保持寄存器 */
+enum {
+  HR_LED_MODE = 0,
+  HR_LED_BRIGHTNESS,
+  HR_LED_SLOT,
+  HR_MOTOR_MODE,
+  HR_MOTOR_SPEED,
+};
+
+/* --------------------------- 私有变量 --------------------------- */
+// 寄存器映像，只由从站任务访问
+static uint16_t s_input[MODBUS_IR_COUNT];
+static uint16_t s_holding[MODBUS_HR_COUNT];
+static SensorHandle_t s_handles[SENSOR_MAX_INSTANCES]; // 传感器块 -> 句柄
+static uint32_t s_sample_tick[SENSOR_MAX_INSTANCES];   // 最近样本的时刻
+static uint8_t s_sensor_count = 0;
+static uint32_t s_dev_version = 0;
+
+static uint8_t s_req[RS485_FRAME_MAX];
+static uint8_t s_resp[RS485_FRAME_MAX]; // 发送期间须保持有效
+static ModbusSlaveStats_t s_stats;
+
+static SensorEventSub_t s_sub = -1;
+static TaskHandle_t s_task = NULL;
+static StaticTask_t s_task_tcb;
+static StackType_t s_task_stack[MODBUS_TASK_STACK_SIZE];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static uint16_t modbus_get16(const uint8_t *p) {
+  return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static void modbus_put16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)(v >> 8);
+  p[1] = (uint8_t)v;
+}
+
+static uint16_t *modbus_sensor_block(uint8_t slot) {
+  return &s_input[MODBUS_IR_SENSOR_BASE + slot * MODBUS_IR_SENSOR_STRIDE];
+}
+
+/**
+ * @brief 为传感器分配下一个传感器块
+ */
+static void modbus_add_sensor(SensorHandle_t handle) {
+  uint8_t slot = s_sensor_count;
+  uint16_t *blk = modbus_sensor_block(slot);
+
+  s_handles[slot] = handle;
+  blk[MODBUS_IR_S_HANDLE] = handle;
+  blk[MODBUS_IR_S_CHANNELS] = SensorTask_GetChannels(handle, NULL);
+  blk[MODBUS_IR_S_INTERVAL] = (uint16_t)SensorTask_GetSampleInterval(handle);
+  s_holding[MODBUS_HR_INTERVAL_BASE + slot] = blk[MODBUS_IR_S_INTERVAL];
+  for (uint8_t ch = 0; ch < blk[MODBUS_IR_S_CHANNELS]; ch++) {
+    float scale = SensorTask_FixedScale(handle, ch);
+    blk[MODBUS_IR_CHANNEL_BASE + ch * MODBUS_IR_CHANNEL_STRIDE +
+        MODBUS_IR_C_SCALE] =
+        (uint16_t)(scale + 0.5f);
+  }
+  s_input[IR_SENSOR_COUNT] = ++s_sensor_count;
+}
+
+/**
+ * @brief 查找传感器块；启动后才探测到的传感器按注册顺序追加
+ */
+static int8_t modbus_find_slot(SensorHandle_t handle) {
+  for (uint8_t i = 0; i < s_sensor_count; i++) {
+    if (s_handles[i] == handle) {
+      return (int8_t)i;
+    }
+  }
+  while (s_sensor_count < SENSOR_MAX_INSTANCES &&
+         s_sensor_count < SensorTask_GetSensorCount()) {
+    modbus_add_sensor(SensorTask_GetHandleAt(s_sensor_count));
+    if (s_handles[s_sensor_count - 1] == handle) {
+      return (int8_t)(s_sensor_count - 1);
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief 设备状态变化时刷新设备块与保持寄存器 (无锁快照)
+ */
+static void modbus_refresh_devices(void) {
+  Drivers_State_t st;
+
+  if (Drivers_GetStateVersion() == s_dev_version) {
+    return;
+  }
+  s_dev_version = Drivers_GetState(&st);
+
+  s_input[IR_ALARM_ACTIVE] = st.alarm_active ? 1 : 0;
+  s_input[IR_LED_MODE] = (uint16_t)st.led_mode;
+  s_input[IR_LED_SLOT] = (uint16_t)st.led_manual_state;
+  s_input[IR_LED_BRIGHTNESS] = st.led_brightness;
+  s_input[IR_LED_AUTO_BRIGHTNESS] = st.led_auto_brightness;
+  s_input[IR_LED_RG] = (uint16_t)((st.led_color.R << 8) | st.led_color.G);
+  s_input[IR_LED_B] = st.led_color.B;
+  s_input[IR_MOTOR_MODE] = (uint16_t)st.motor_mode;
+  s_input[IR_MOTOR_SPEED] = st.motor_speed;
+  s_input[IR_MOTOR_SETPOINT] = st.motor_setpoint;
+
+  s_holding[HR_LED_MODE] = (uint16_t)st.led_mode;
+  s_holding[HR_LED_BRIGHTNESS] = st.led_brightness;
+  s_holding[HR_LED_SLOT] = (uint16_t)st.led_manual_state;
+  s_holding[HR_MOTOR_MODE] = (uint16_t)st.motor_mode;
+  s_holding[HR_MOTOR_SPEED] = st.motor_setpoint;
+}
+
+/**
+ * @brief 刷新随时间变化的寄存器 (应答读请求前调用)
+ */
+static void modbus_refresh_time(void) {
+  uint32_t uptime = SysClock_Seconds();
+  uint32_t now = HAL_GetTick();
+
+  s_input[IR_UPTIME_HI] = (uint16_t)(uptime >> 16);
+  s_input[IR_UPTIME_LO] = (uint16_t)uptime;
+  for (uint8_t i = 0; i < s_sensor_count; i++) {
+    uint16_t *blk = modbus_sensor_block(i);
+    uint32_t age = (now - s_sample_tick[i]) / 1000U;
+    blk[MODBUS_IR_S_AGE] = blk[MODBUS_IR_S_SAMPLES] == 0 ? UINT16_MAX
+                    : (uint16_t)(age > UINT16_MAX ? UINT16_MAX : age);
+  }
+}
+
+/**
+ * @brief 按传感器事件更新对应的传感器块
+ */
+static void modbus_apply_snapshot(const SensorSnapshot_t *snapshot) {
+  const SensorEvent_t *event = &snapshot->event;
+  int8_t slot = modbus_find_slot(event->sensor);
+  uint16_t *blk;
+
+  if (slot < 0) {
+    return;
+  }
+  blk = modbus_sensor_block((uint8_t)slot);
+  s_stats.updates++;
+
+  if (event->event_type == SENSOR_EVENT_STATUS_CHANGE &&
+      event->status == SENSOR_STATUS_ERROR &&
+      blk[MODBUS_IR_S_STATUS] != SENSOR_STATUS_ERROR) {
+    blk[MODBUS_IR_S_ERRORS]++;
+  }
+  blk[MODBUS_IR_S_STATUS] = (uint16_t)event->status;
+  if (event->event_type != SENSOR_EVENT_DATA_UPDATE) {
+    return;
+  }
+
+  blk[MODBUS_IR_S_VALID] = event->data.is_valid ? 1 : 0;
+  if (!event->data.is_valid) {
+    return;
+  }
+  blk[MODBUS_IR_S_SAMPLES]++;
+  blk[MODBUS_IR_S_INTERVAL] =
+      (uint16_t)SensorTask_GetSampleInterval(event->sensor);
+  s_sample_tick[slot] = HAL_GetTick();
+
+  for (uint8_t ch = 0; ch < snapshot->channel_count; ch++) {
+    uint16_t *c = &blk[MODBUS_IR_CHANNEL_BASE + ch * MODBUS_IR_CHANNEL_STRIDE];
+    const SensorStats_t *st = &snapshot->stats[ch];
+
+    c[MODBUS_IR_C_VALUE] = (uint16_t)snapshot->fixed[ch];
+    if (snapshot->has_stats) {
+      c[MODBUS_IR_C_MIN] =
+          (uint16_t)SensorTask_ToFixed(event->sensor, ch, st->min);
+      c[MODBUS_IR_C_MAX] =
+          (uint16_t)SensorTask_ToFixed(event->sensor, ch, st->max);
+      c[MODBUS_IR_C_AVG] =
+          (uint16_t)SensorTask_ToFixed(event->sensor, ch, st->avg);
+      c[MODBUS_IR_C_COUNT] = (uint16_t)st->count;
+    }
+  }
+}
+
+/**
+ * @brief 检查或执行一次保持寄存器写入
+ * @param apply false 只检查，true 执行
+ * @return 0 成功，否则为异常码
+ */
+static uint8_t modbus_write_holding(uint16_t reg, uint16_t value, bool apply) {
+  if (reg >= MODBUS_HR_INTERVAL_BASE) {
+    uint16_t n = reg - MODBUS_HR_INTERVAL_BASE;
+    if (n >= s_sensor_count) {
+      return MODBUS_EX_ILLEGAL_ADDRESS;
+    }
+    if (value < 100) {
+      return MODBUS_EX_ILLEGAL_VALUE;
+    }
+    if (apply && !SensorTask_SetUpdateInterval(s_handles[n], value)) {
+      return MODBUS_EX_ILLEGAL_VALUE;
+    }
+  } else {
+    switch (reg) {
+    case HR_LED_MODE:
+      if (value > LED_MODE_AUTO) {
+        return MODBUS_EX_ILLEGAL_VALUE;
+      }
+      if (apply) {
+        Drivers_RGBLED_SetMode((led_control_mode_t)value);
+      }
+      break;
+    case HR_LED_BRIGHTNESS:
+      if (value > 255) {
+        return MODBUS_EX_ILLEGAL_VALUE;
+      }
+      if (apply) {
+        Drivers_RGBLED_SetBrightness((uint8_t)value);
+      }
+      break;
+    case HR_LED_SLOT:
+      if (value < LED_STATE_SLOT_1 || value > LED_STATE_SLOT_3) {
+        return MODBUS_EX_ILLEGAL_VALUE;
+      }
+      if (apply) {
+        Drivers_RGBLED_SetManualSlot((uint8_t)value);
+      }
+      break;
+    case HR_MOTOR_MODE:
+      if (value > MOTOR_MODE_VENT) {
+        return MODBUS_EX_ILLEGAL_VALUE;
+      }
+      if (apply) {
+        Drivers_Motor_SetMode((Motor_Control_Mode_t)value);
+      }
+      break;
+    case HR_MOTOR_SPEED:
+      if (value > 999) {
+        return MODBUS_EX_ILLEGAL_VALUE;
+      }
+      if (apply) {
+        Drivers_Motor_SetSpeed(value);
+      }
+      break;
+    default:
+      return MODBUS_EX_ILLEGAL_ADDRESS;
+    }
+  }
+  if (apply) {
+    s_holding[reg] = value; // 设备状态异步生效，先回显写入的值
+  }
+  return 0;
+}
+
+/**
+ * @brief 处理一条请求 (已确认地址与 CRC)，生成应答
+ * @param len 去掉 CRC 后的帧长
+ * @return 应答长度 (含地址，不含 CRC)
+ */
+static uint16_t modbus_handle(const uint8_t *req, uint16_t len) {
+  uint8_t fc = req[1];
+  uint16_t start = len >= 6 ? modbus_get16(&req[2]) : 0;
+  uint16_t qty = len >= 6 ? modbus_get16(&req[4]) : 0;
+  uint8_t ex = 0;
+
+  s_resp[0] = req[0];
+  s_resp[1] = fc;
+
+  switch (fc) {
+  case MODBUS_FC_READ_HOLDING:
+  case MODBUS_FC_READ_INPUT: {
+    const uint16_t *regs = fc == MODBUS_FC_READ_INPUT ? s_input : s_holding;
+    uint16_t count = fc == MODBUS_FC_READ_INPUT ? MODBUS_IR_COUNT
+                                                : MODBUS_HR_COUNT;
+    if (len != 6 || qty == 0 || qty > MODBUS_READ_MAX) {
+      ex = MODBUS_EX_ILLEGAL_VALUE;
+      break;
+    }
+    if ((uint32_t)start + qty > count) {
+      ex = MODBUS_EX_ILLEGAL_ADDRESS;
+      break;
+    }
+    modbus_refresh_devices();
+    modbus_refresh_time();
+    s_resp[2] = (uint8_t)(qty * 2);
+    for (uint16_t i = 0; i < qty; i++) {
+      modbus_put16(&s_resp[3 + i * 2], regs[start + i]);
+    }
+    return (uint16_t)(3 + qty * 2);
+  }
+
+  case MODBUS_FC_WRITE_SINGLE:
+    if (len != 6) {
+      ex = MODBUS_EX_ILLEGAL_VALUE;
+      break;
+    }
+    ex = modbus_write_holding(start, qty, false);
+    if (ex == 0) {
+      ex = modbus_write_holding(start, qty, true);
+    }
+    if (ex == 0) {
+      memcpy(&s_resp[2], &req[2], 4);
+      return 6;
+    }
+    break;
+
+  case MODBUS_FC_WRITE_MULTIPLE:
+    if (len < 7 || qty == 0 || qty > MODBUS_WRITE_MAX ||
+        req[6] != qty * 2 || len != 7 + qty * 2) {
+      ex = MODBUS_EX_ILLEGAL_VALUE;
+      break;
+    }
+    if ((uint32_t)start + qty > MODBUS_HR_COUNT) {
+      ex = MODBUS_EX_ILLEGAL_ADDRESS;
+      break;
+    }
+    // 先检查全部寄存器，避免只执行了一部分
+    for (uint16_t i = 0; i < qty && ex == 0; i++) {
+      ex = modbus_write_holding(start + i, modbus_get16(&req[7 + i * 2]), false);
+    }
+    for (uint16_t i = 0; i < qty && ex == 0; i++) {
+      ex = modbus_write_holding(start + i, modbus_get16(&req[7 + i * 2]), true);
+    }
+    if (ex == 0) {
+      memcpy(&s_resp[2], &req[2], 4);
+      return 6;
+    }
+    break;
+
+  default:
+    ex = MODBUS_EX_ILLEGAL_FUNCTION;
+    break;
+  }
+
+  s_stats.exceptions++;
+  s_resp[1] = (uint8_t)(fc | 0x80);
+  s_resp[2] = ex;
+  return 3;
+}
+
+/**
+ * @brief 校验并应答一帧
+ */
+static void modbus_process(uint16_t len) {
+  uint16_t crc;
+  uint16_t resp_len;
+  uint8_t addr = s_req[0];
+
+  if (len < 4) {
+    return;
+  }
+  crc = CRC16_Modbus_Compute(s_req, len - 2);
+  if (s_req[len - 2] != (uint8_t)crc || s_req[len - 1] != (uint8_t)(crc >> 8)) {
+    s_stats.crc_errors++;
+    return;
+  }
+  if (addr != MODBUS_SLAVE_ADDRESS && addr != 0) {
+    s_stats.foreign++;
+    return;
+  }
+  s_stats.requests++;
+
+  resp_len = modbus_handle(s_req, (uint16_t)(len - 2));
+  if (addr == 0) {
+    return; // 广播只执行不应答
+  }
+  crc = CRC16_Modbus_Compute(s_resp, resp_len);
+  s_resp[resp_len] = (uint8_t)crc;
+  s_resp[resp_len + 1] = (uint8_t)(crc >> 8);
+
+  vTaskDelay(pdMS_TO_TICKS(MODBUS_TURNAROUND_MS));
+  (void)RS485_Write(s_resp, (uint16_t)(resp_len + 2));
+}
+
+/**
+ * @brief 有新的传感器事件 (传感器任务上下文)
+ */
+static void modbus_event_notify(void) {
+  if (s_task != NULL) {
+    xTaskNotifyGive(s_task);
+  }
+}
+
+/**
+ * @brief 从站任务：应答请求，空闲时用传感器事件更新映像
+ */
+static void modbus_task(void *argument) {
+  (void)argument;
+
+  for (;;) {
+    const SensorSnapshot_t *snapshot;
+    uint16_t len;
+
+    (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+
+    len = RS485_Read(s_req);
+    if (len != 0) {
+      modbus_process(len);
+    }
+    while ((snapshot = SensorEventBus_Receive(s_sub, 0)) != NULL) {
+      modbus_apply_snapshot(snapshot);
+      SensorEventBus_Release(snapshot);
+    }
+    modbus_refresh_devices();
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化
+ */
+bool ModbusSlave_Init(void) {
+  if (s_task != NULL) {
+    return true;
+  }
+
+  s_input[IR_MAP_VERSION] = MODBUS_MAP_VERSION;
+  while (s_sensor_count < SENSOR_MAX_INSTANCES &&
+         s_sensor_count < SensorTask_GetSensorCount()) {
+    modbus_add_sensor(SensorTask_GetHandleAt(s_sensor_count));
+  }
+  s_dev_version = Drivers_GetStateVersion() - 1; // 首次强制刷新
+  modbus_refresh_devices();
+
+  s_sub = SensorEventBus_Subscribe("modbus", modbus_event_notify);
+  if (s_sub < 0) {
+    LOG_ERROR("订阅传感器事件失败");
+    return false;
+  }
+
+  s_task = xTaskCreateStatic(modbus_task, "modbus", MODBUS_TASK_STACK_SIZE,
+                             NULL, MODBUS_TASK_PRIORITY, s_task_stack,
+                             &s_task_tcb);
+  if (!RS485_Init(MODBUS_BAUDRATE, s_task)) {
+    return false;
+  }
+
+  LOG_INFO("Modbus 从站已启动: 地址 %u, %lu bps, %u 个传感器",
+           (unsigned)MODBUS_SLAVE_ADDRESS, (unsigned long)MODBUS_BAUDRATE,
+           (unsigned)s_sensor_count);
+  return true;
+}
+
+/**
+ * @brief 获取从站统计
+ */
+void ModbusSlave_GetStats(ModbusSlaveStats_t *stats) {
+  taskENTER_CRITICAL();
+  *stats = s_stats;
+  taskEXIT_CRITICAL();
+}
@@ -0,0 +1,129 @@
+/**
+ ******************************************************************************
+ * @file    modbus_slave.h
+ * @brief   Modbus RTU 从站 (RS-485)
+ * @details 供楼宇管理系统轮询：传感器数值、统计与输出设备状态映射到
+ *          输入寄存器 (只读)，输出设备的控制量与采样间隔映射到保持寄存器。
+ *          寄存器的值保存在 RAM 映像中：
+ *            - 映像只由从站任务读写，任务订阅传感器事件总线，每收到一个
+ *              样本更新一次对应的寄存器块；输出设备状态通过无锁快照
+ *              Drivers_GetState() 按版本号刷新；
+ *            - 主站的读请求直接从映像应答，不调用传感器管理器的接口，轮询
+ *              再密集也不会与传感器任务竞争，不影响采样时序；
+ *            - 写请求通过设备管理器与传感器管理器的公共接口执行。
+ *          帧边界由总线空闲检测给出 (见 rs485.h)，CRC 错误或地址不符的帧
+ *          静默丢弃；广播地址 0 的写请求执行但不应答。
+ *          支持功能码 03 (读保持寄存器)、04 (读输入寄存器)、06 (写单个
+ *          寄存器)、16 (写多个寄存器)；32 位量高字在前。
+ *
+ *          输入寄存器 (04)：
+ *            0  映像版本 MODBUS_MAP_VERSION   1  传感器数
+ *            2  上电秒数高字               3  上电秒数低字
+ *            4  告警接管输出 (0/1)          5  LED 模式 (0 手动 / 1 自动)
+ *            6  LED 手动槽位 (0 关 / 1~3)   7  LED 亮度 (0~255)
+ *            8  LED 自动亮度               9  LED 颜色 R << 8 | G
+ *            10 LED 颜色 B                 11 电机模式 (0 自动 / 1 手动 / 2 通风)
+ *            12 电机 PWM 占空比             13 电机设定值
+ *            32 + n * 32 起为第 n 个传感器 (按注册顺序)：
+ *              +0 句柄 (低 4 位类型，高 4 位序号)  +1 状态 (SensorStatus_t)
+ *              +2 通道数    +3 实际采样间隔 (ms)   +4 样本计数 (低 16 位)
+ *              +5 错误事件计数   +6 距上次样本的秒数   +7 最近样本有效 (0/1)
+ *              +8 + c * 8 起为第 c 个通道 (定点值 = 实际值 * 缩放系数)：
+ *                +0 当前值  +1 最小值  +2 最大值  +3 平均值
+ *                +4 缩放系数 (取整)  +5 累计样本数 (低 16 位)
+ *          保持寄存器 (03/06/16)：
+ *            0 LED 模式   1 LED 亮度   2 LED 手动槽位 (1~3)
+ *            3 电机模式   4 电机速度 (0~999，手动模式生效)
+ *            8 + n        第 n 个传感器的更新间隔 (ms，不小于 100)
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __MODBUS_SLAVE_H
+#define __MODBUS_SLAVE_H
+
+#include "sensor_task.h"
+#include "task_plan.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#ifndef MODBUS_SLAVE_ADDRESS
+#define MODBUS_SLAVE_ADDRESS 1         // 从站地址 (1~247)
+#endif
+#ifndef MODBUS_BAUDRATE
+#define MODBUS_BAUDRATE 19200          // 8 数据位、偶校验、1 停止位
+#endif
+#define MODBUS_MAP_VERSION 1           // 寄存器映射版本 (映射变化时加 1)
+#define MODBUS_TASK_STACK_SIZE 256     // 从站任务栈大小 (单位: 字)
+#define MODBUS_TASK_PRIORITY TASK_PRIO_MODBUS // 从站任务的 FreeRTOS 优先级
+
+/* 寄存器映射 */
+#define MODBUS_IR_SENSOR_BASE 32       // 第一个传感器块的起始地址
+#define MODBUS_IR_SENSOR_STRIDE 32     // 每个传感器块的寄存器数
+#define MODBUS_IR_CHANNEL_BASE 8       // 块内第一个通道的偏移
+#define MODBUS_IR_CHANNEL_STRIDE 8     // 每个通道的寄存器数
+#define MODBUS_IR_COUNT                                                        \
+  (MODBUS_IR_SENSOR_BASE + SENSOR_MAX_INSTANCES * MODBUS_IR_SENSOR_STRIDE)
+#define MODBUS_HR_INTERVAL_BASE 8      // 采样间隔的起始地址
+#define MODBUS_HR_COUNT (MODBUS_HR_INTERVAL_BASE + SENSOR_MAX_INSTANCES)
+
+/* 输入寄存器：传感器块内偏移 (网关解析其他节点的映像时共用) */
+enum {
+  MODBUS_IR_S_HANDLE = 0,
+  MODBUS_IR_S_STATUS,
+  MODBUS_IR_S_CHANNELS,
+  MODBUS_IR_S_INTERVAL,
+  MODBUS_IR_S_SAMPLES,
+  MODBUS_IR_S_ERRORS,
+  MODBUS_IR_S_AGE,
+  MODBUS_IR_S_VALID,
+};
+
+/* 输入寄存器：通道内偏移 */
+enum {
+  MODBUS_IR_C_VALUE = 0,
+  MODBUS_IR_C_MIN,
+  MODBUS_IR_C_MAX,
+  MODBUS_IR_C_AVG,
+  MODBUS_IR_C_SCALE,
+  MODBUS_IR_C_COUNT,
+};
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 从站统计
+ */
+typedef struct {
+  uint32_t requests;   // 地址匹配且 CRC 正确的请求数
+  uint32_t crc_errors; // CRC 错误的帧数
+  uint32_t foreign;    // 发给其他从站的帧数
+  uint32_t exceptions; // 回复的异常应答数
+  uint32_t updates;    // 映像更新次数 (收到的传感器事件数)
+} ModbusSlaveStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 建立寄存器映像、订阅传感器事件并启动从站任务
+ * @note  传感器块按注册顺序分配，之后探测到的传感器收到首个事件时追加
+ * @return false: 资源不足或串口初始化失败
+ */
+bool ModbusSlave_Init(void);
+
+/**
+ * @brief 获取从站统计
+ */
+void ModbusSlave_GetStats(ModbusSlaveStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MODBUS_SLAVE_H */
@@ -0,0 +1,326 @@
+/**
+ ******************************************************************************
+ * @file    net_udp.c
+ * @brief   以太网 UDP 上行实现
+ * @details 发送帧 = 42 字节协议头 [以太网 14 | IPv4 20 | UDP 8] + 数据，
+ *          协议头在调用者的栈上组装后由驱动复制到描述符的头部缓冲区，
+ *          数据不复制。IPv4 头与 UDP 校验和字段填 0，由 MAC 插入。
+ *          ping 应答同样零拷贝：以太网、IP 与 ICMP 头改写后作为头部，
+ *          回显数据直接引用接收缓冲区。
+ *          ARP 缓存只有下一跳一项；网络任务收到下一跳的 ARP 报文 (应答或
+ *          请求) 时更新缓存并唤醒等待解析的任务。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "net_udp.h"
+#include "checksum.h"
+#include "eth_mac.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_MODULE "NET"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define NET_ETH_HEADER 14
+#define NET_IP_HEADER 20
+#define NET_UDP_HEADER 8
+#define NET_ICMP_HEADER 8
+#define NET_ARP_LEN 28
+#define NET_UDP_MAX (1500 - NET_IP_HEADER - NET_UDP_HEADER)
+
+#define NET_TYPE_IP 0x0800
+#define NET_TYPE_ARP 0x0806
+#define NET_PROTO_ICMP 1
+#define NET_PROTO_UDP 17
+#define NET_ARP_REQUEST 1
+#define NET_ARP_REPLY 2
+#define NET_ICMP_ECHO_REQUEST 8
+#define NET_ICMP_ECHO_REPLY 0
+
+/* --------------------------- 私有变量 --------------------------- */
+static bool s_ready = false;
+static uint8_t s_mac[6];
+static uint8_t s_ip[4];
+static uint8_t s_mask[4];
+static uint8_t s_gateway[4];
+static uint8_t s_dest[4];
+static uint16_t s_dest_port;
+static uint8_t s_next_hop[4];  // 同网段为目的地址，否则为网关
+
+static uint8_t s_hop_mac[6];
+static volatile bool s_resolved = false;
+static volatile TickType_t s_resolved_at;
+static uint16_t s_ip_id;
+static NetUdp_Stats_t s_stats;
+
+static SemaphoreHandle_t s_arp_sem = NULL;
+static StaticSemaphore_t s_arp_sem_buf;
+
+static TaskHandle_t s_task = NULL;
+static StaticTask_t s_task_tcb;
+static StackType_t s_task_stack[NET_UDP_TASK_STACK_SIZE];
+
+static const uint8_t s_broadcast[6] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static void net_put16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)(v >> 8);
+  p[1] = (uint8_t)v;
+}
+
+static uint16_t net_get16(const uint8_t *p) {
+  return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static bool net_parse_ip(const char *text, uint8_t ip[4]) {
+  unsigned a, b, c, d;
+  char tail;
+
+  if (sscanf(text, "%u.%u.%u.%u%c", &a, &b, &c, &d, &tail) != 4 || a > 255 ||
+      b > 255 || c > 255 || d > 255) {
+    return false;
+  }
+  ip[0] = (uint8_t)a;
+  ip[1] = (uint8_t)b;
+  ip[2] = (uint8_t)c;
+  ip[3] = (uint8_t)d;
+  return true;
+}
+
+static void net_eth_header(uint8_t *p, const uint8_t *dst, uint16_t type) {
+  memcpy(p, dst, 6);
+  memcpy(p + 6, s_mac, 6);
+  net_put16(p + 12, type);
+}
+
+/* IPv4 头 (校验和由 MAC 插入) */
+static void net_ip_header(uint8_t *p, const uint8_t *dst, uint8_t proto, uint16_t total) {
+  p[0] = 0x45;
+  p[1] = 0;
+  net_put16(p + 2, total);
+  net_put16(p + 4, s_ip_id++);
+  net_put16(p + 6, 0x4000); // DF
+  p[8] = 64;
+  p[9] = proto;
+  net_put16(p + 10, 0);
+  memcpy(p + 12, s_ip, 4);
+  memcpy(p + 16, dst, 4);
+}
+
+static void net_send_arp(uint16_t op, const uint8_t *mac, const uint8_t *ip) {
+  uint8_t frame[NET_ETH_HEADER + NET_ARP_LEN];
+  uint8_t *arp = frame + NET_ETH_HEADER;
+
+  net_eth_header(frame, op == NET_ARP_REQUEST ? s_broadcast : mac, NET_TYPE_ARP);
+  net_put16(arp, 1);            // 以太网
+  net_put16(arp + 2, NET_TYPE_IP);
+  arp[4] = 6;
+  arp[5] = 4;
+  net_put16(arp + 6, op);
+  memcpy(arp + 8, s_mac, 6);
+  memcpy(arp + 14, s_ip, 4);
+  if (op == NET_ARP_REQUEST) {
+    memset(arp + 18, 0, 6);
+  } else {
+    memcpy(arp + 18, mac, 6);
+  }
+  memcpy(arp + 24, ip, 4);
+  EthMac_Send(frame, sizeof(frame), NULL, 0); // 短帧由 MAC 自动补齐到 60 字节
+}
+
+static void net_handle_arp(const uint8_t *arp, uint16_t len) {
+  const uint8_t *sender_mac = arp + 8;
+  const uint8_t *sender_ip = arp + 14;
+
+  if (len < NET_ARP_LEN || net_get16(arp) != 1 || net_get16(arp + 2) != NET_TYPE_IP) {
+    return;
+  }
+  /* 下一跳的任何 ARP 报文都带有它的 MAC */
+  if (memcmp(sender_ip, s_next_hop, 4) == 0) {
+    memcpy(s_hop_mac, sender_mac, 6);
+    s_resolved_at = xTaskGetTickCount();
+    if (!s_resolved) {
+      s_resolved = true;
+      xSemaphoreGive(s_arp_sem);
+    }
+  }
+  if (net_get16(arp + 6) == NET_ARP_REQUEST && memcmp(arp + 24, s_ip, 4) == 0) {
+    net_send_arp(NET_ARP_REPLY, sender_mac, sender_ip);
+    s_stats.arp_replies++;
+  }
+}
+
+/* ping 应答：改写的头部 + 接收缓冲区中的回显数据 */
+static void net_handle_icmp(const uint8_t *frame, uint16_t len) {
+  const uint8_t *ip = frame + NET_ETH_HEADER;
+  uint16_t ip_len = net_get16(ip + 2);
+  uint8_t head[NET_ETH_HEADER + NET_IP_HEADER + NET_ICMP_HEADER];
+  const uint8_t *icmp = ip + NET_IP_HEADER;
+
+  if ((ip[0] & 0x0F) != 5 || ip_len > len - NET_ETH_HEADER ||
+      ip_len < NET_IP_HEADER + NET_ICMP_HEADER || icmp[0] != NET_ICMP_ECHO_REQUEST) {
+    return; // 带选项的 IP 头不应答
+  }
+  net_eth_header(head, frame + 6, NET_TYPE_IP);
+  net_ip_header(head + NET_ETH_HEADER, ip + 12, NET_PROTO_ICMP, ip_len);
+  memcpy(head + NET_ETH_HEADER + NET_IP_HEADER, icmp, NET_ICMP_HEADER);
+  head[NET_ETH_HEADER + NET_IP_HEADER] = NET_ICMP_ECHO_REPLY;
+  net_put16(head + NET_ETH_HEADER + NET_IP_HEADER + 2, 0); // 校验和由 MAC 插入
+  if (EthMac_Send(head, sizeof(head), icmp + NET_ICMP_HEADER,
+                  (uint16_t)(ip_len - NET_IP_HEADER - NET_ICMP_HEADER))) {
+    s_stats.icmp_echoes++;
+  }
+}
+
+/* 网络任务的接收回调：帧在接收缓冲区中原地处理 */
+static void net_rx(const uint8_t *frame, uint16_t len) {
+  uint16_t type;
+
+  if (len < NET_ETH_HEADER) {
+    return;
+  }
+  type = net_get16(frame + 12);
+  if (type == NET_TYPE_ARP) {
+    net_handle_arp(frame + NET_ETH_HEADER, (uint16_t)(len - NET_ETH_HEADER));
+  } else if (type == NET_TYPE_IP && len >= NET_ETH_HEADER + NET_IP_HEADER &&
+             frame[NET_ETH_HEADER + 9] == NET_PROTO_ICMP &&
+             memcmp(frame + NET_ETH_HEADER + 16, s_ip, 4) == 0) {
+    net_handle_icmp(frame, len);
+  }
+}
+
+static void net_udp_task(void *argument) {
+  TickType_t link_at = 0;
+
+  (void)argument;
+  for (;;) {
+    EthMac_Poll(net_rx, NET_UDP_LINK_POLL_MS);
+
+    if (xTaskGetTickCount() - link_at >= pdMS_TO_TICKS(NET_UDP_LINK_POLL_MS)) {
+      link_at = xTaskGetTickCount();
+      s_stats.link = EthMac_CheckLink();
+      if (!s_stats.link ||
+          xTaskGetTickCount() - s_resolved_at >= pdMS_TO_TICKS(NET_UDP_ARP_TTL_S * 1000UL)) {
+        s_resolved = false; // 换线或下一跳更换网卡后重新解析
+      }
+    }
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化
+ */
+bool NetUdp_Init(const char *host, uint16_t port) {
+  uint32_t uid_crc;
+
+  if (s_ready) {
+    return true;
+  }
+  if (!net_parse_ip(NET_UDP_IP, s_ip) || !net_parse_ip(NET_UDP_NETMASK, s_mask) ||
+      !net_parse_ip(NET_UDP_GATEWAY, s_gateway) || !net_parse_ip(host, s_dest)) {
+    LOG_ERROR("IP 地址格式错误 (需要点分十进制): %s", host);
+    return false;
+  }
+  s_dest_port = port;
+  memcpy(s_next_hop, s_dest, 4);
+  for (uint8_t i = 0; i < 4; i++) {
+    if ((s_dest[i] ^ s_ip[i]) & s_mask[i]) {
+      memcpy(s_next_hop, s_gateway, 4);
+      break;
+    }
+  }
+
+  /* 本地管理的单播地址，低 4 字节取 UID 的 CRC-32 */
+  uid_crc = CRC32_Compute((const uint8_t *)UID_BASE, 12);
+  s_mac[0] = 0x02;
+  s_mac[1] = 0x45; // 'E'
+  s_mac[2] = (uint8_t)(uid_crc >> 24);
+  s_mac[3] = (uint8_t)(uid_crc >> 16);
+  s_mac[4] = (uint8_t)(uid_crc >> 8);
+  s_mac[5] = (uint8_t)uid_crc;
+  s_ip_id = (uint16_t)uid_crc;
+
+  if (!EthMac_Init(s_mac)) {
+    return false;
+  }
+  s_arp_sem = xSemaphoreCreateBinaryStatic(&s_arp_sem_buf);
+  s_task = xTaskCreateStatic(net_udp_task, "net", NET_UDP_TASK_STACK_SIZE, NULL,
+                             NET_UDP_TASK_PRIORITY, s_task_stack, &s_task_tcb);
+  s_ready = true;
+
+  LOG_INFO("以太网 %u.%u.%u.%u -> %s:%u", s_ip[0], s_ip[1], s_ip[2], s_ip[3], host,
+           (unsigned)port);
+  return true;
+}
+
+/**
+ * @brief 链路与下一跳可用
+ */
+bool NetUdp_IsUp(void) {
+  return s_ready && EthMac_IsLinkUp() && s_resolved;
+}
+
+/**
+ * @brief 解析下一跳
+ */
+bool NetUdp_Resolve(void) {
+  if (!s_ready || !EthMac_IsLinkUp()) {
+    return false;
+  }
+  if (s_resolved) {
+    return true;
+  }
+  xSemaphoreTake(s_arp_sem, 0);
+  net_send_arp(NET_ARP_REQUEST, s_broadcast, s_next_hop);
+  s_stats.arp_requests++;
+  xSemaphoreTake(s_arp_sem, pdMS_TO_TICKS(NET_UDP_ARP_TIMEOUT_MS));
+  s_stats.resolved = s_resolved;
+  return s_resolved;
+}
+
+/**
+ * @brief 发送数据报
+ */
+bool NetUdp_Send(const void *data, uint16_t len) {
+  uint8_t head[NET_ETH_HEADER + NET_IP_HEADER + NET_UDP_HEADER];
+  uint8_t *udp = head + NET_ETH_HEADER + NET_IP_HEADER;
+
+  if (len > NET_UDP_MAX || !NetUdp_Resolve()) {
+    s_stats.send_failures++;
+    return false;
+  }
+  net_eth_header(head, s_hop_mac, NET_TYPE_IP);
+  net_ip_header(head + NET_ETH_HEADER, s_dest, NET_PROTO_UDP,
+                (uint16_t)(NET_IP_HEADER + NET_UDP_HEADER + len));
+  net_put16(udp, NET_UDP_LOCAL_PORT);
+  net_put16(udp + 2, s_dest_port);
+  net_put16(udp + 4, (uint16_t)(NET_UDP_HEADER + len));
+  net_put16(udp + 6, 0);
+
+  if (!EthMac_Send(head, sizeof(head), data, len)) {
+    s_stats.send_failures++;
+    return false;
+  }
+  s_stats.datagrams_sent++;
+  s_stats.bytes_sent += len;
+  return true;
+}
+
+/**
+ * @brief 获取统计
+ */
+void NetUdp_GetStats(NetUdp_Stats_t *stats) {
+  *stats = s_stats;
+  stats->link = EthMac_IsLinkUp();
+  stats->resolved = s_resolved;
+}
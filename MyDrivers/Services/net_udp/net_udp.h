@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file    net_udp.h
+ * @brief   以太网 UDP 上行 (静态 IPv4、单一目的地址)
+ * @details 遥测有线链路的最小协议栈，只实现上行需要的部分：
+ *            - 静态地址 (NET_UDP_IP / NETMASK / GATEWAY)，不支持 DHCP 与 DNS，
+ *              目的地址须为点分十进制；
+ *            - ARP：解析下一跳 (同网段为目的地址，否则为网关) 并缓存
+ *              NET_UDP_ARP_TTL_S，应答对本机地址的 ARP 请求；
+ *            - ICMP：应答 ping，便于现场确认接线与地址；
+ *            - UDP 发送：协议头在栈上组装，数据由 MAC 直接从调用者的缓冲区
+ *              读取 (零拷贝)，校验和由硬件插入。
+ *          接收与链路检测在独立的网络任务中进行，内存全部静态分配
+ *          (接收描述符缓冲区见 eth_mac.h)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __NET_UDP_H
+#define __NET_UDP_H
+
+#include "task_plan.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#ifndef NET_UDP_IP
+#define NET_UDP_IP "192.168.1.50"
+#endif
+#ifndef NET_UDP_NETMASK
+#define NET_UDP_NETMASK "255.255.255.0"
+#endif
+#ifndef NET_UDP_GATEWAY
+#define NET_UDP_GATEWAY "192.168.1.1"
+#endif
+#define NET_UDP_LOCAL_PORT 9000         // 本机源端口
+#define NET_UDP_ARP_TIMEOUT_MS 1000     // 等待 ARP 应答的时间
+#define NET_UDP_ARP_TTL_S 300           // ARP 缓存有效期
+#define NET_UDP_LINK_POLL_MS 1000       // 链路检测间隔
+#define NET_UDP_TASK_STACK_SIZE 256     // 网络任务栈大小 (单位: 字)
+#define NET_UDP_TASK_PRIORITY TASK_PRIO_NET
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 网络统计
+ */
+typedef struct {
+  bool link;                // 以太网链路已建立
+  bool resolved;            // 下一跳 MAC 已知
+  uint32_t datagrams_sent;
+  uint32_t bytes_sent;      // UDP 数据字节数
+  uint32_t send_failures;
+  uint32_t arp_requests;    // 发出的 ARP 请求
+  uint32_t arp_replies;     // 应答的 ARP 请求
+  uint32_t icmp_echoes;     // 应答的 ping
+} NetUdp_Stats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化 MAC 与 PHY，设置目的地址并创建网络任务
+ * @param host 目的 IPv4 地址 (点分十进制)
+ * @return false: 地址格式错误或 PHY 不可用
+ */
+bool NetUdp_Init(const char *host, uint16_t port);
+
+/**
+ * @brief 链路已建立且下一跳已解析
+ */
+bool NetUdp_IsUp(void);
+
+/**
+ * @brief 解析下一跳 (已缓存时立即返回)
+ * @return false: 链路未建立或 ARP 超时
+ */
+bool NetUdp_Resolve(void);
+
+/**
+ * @brief 发送一个 UDP 数据报到目的地址
+ * @param data 数据 (不能位于 CCM RAM)，返回前由 MAC 直接读取
+ * @return true: 已发出 (UDP 没有送达确认)
+ */
+bool NetUdp_Send(const void *data, uint16_t len);
+
+/**
+ * @brief 获取网络统计
+ */
+void NetUdp_GetStats(NetUdp_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __NET_UDP_H */
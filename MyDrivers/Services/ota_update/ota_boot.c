@@ -0,0 +1,426 @@
+/**
+ ******************************************************************************
+ * @file    ota_boot.c
+ * @brief   引导程序：安装暂存槽中的新固件，试运行失败时回滚
+ * @details 链接在片内 Flash 扇区 0 (散列文件 ER_BOOT)，复位后最先运行，
+ *          完成后跳转到 OTA_APP_ADDR 处的应用程序。
+ *            - 在 __main 与 SystemInit 之前执行，使用复位后的 16 MHz HSI，
+ *              不初始化 RW/ZI 数据，只使用栈上的局部变量；
+ *            - 升级只替换应用程序，本文件的代码不随之更新，因此不能调用
+ *              本文件以外的任何函数 (HAL、C 库，以及结构体整体赋值等会
+ *              生成库调用的写法)，外部 Flash (SPI1) 与片内 Flash 都直接
+ *              操作寄存器；
+ *            - 擦写片内 Flash 期间取指暂停，无法喂狗：开始时把可能已由上次
+ *              运行启动的 IWDG 超时延长到最大值 (约 32 s)；
+ *            - 跳转前复位用过的外设，设置 VTOR 与 MSP。
+ *          流程与状态字见 ota_update.h。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ota_update.h"
+#include "stm32f4xx.h"
+#include <stddef.h>
+
+/* --------------------------- 私有宏 --------------------------- */
+#define BOOT_STACK_TOP 0x20020000UL  // SRAM1 + SRAM2 末尾
+#define BOOT_NOR_CS_PIN 14U          // PB14
+#define BOOT_NOR_PAGE 256U
+#define BOOT_NOR_SECTOR 4096U
+#define BOOT_CHUNK 256U              // 复制与校验的分块大小
+
+#define NOR_CMD_READ 0x03
+#define NOR_CMD_WRITE_ENABLE 0x06
+#define NOR_CMD_PAGE_PROGRAM 0x02
+#define NOR_CMD_SECTOR_ERASE 0x20
+#define NOR_CMD_READ_STATUS 0x05
+
+#define BOOT_FLASH_ERRORS                                                      \
+  (FLASH_SR_WRPERR | FLASH_SR_PGAERR | FLASH_SR_PGPERR | FLASH_SR_PGSERR)
+
+typedef void (*boot_vector_t)(void);
+
+static void boot_reset(void);
+static void boot_fault(void);
+
+/* 引导程序的向量表：只需要栈顶、复位与故障入口 (链接选项 --keep 保留) */
+const boot_vector_t g_boot_vectors[4] __attribute__((section("boot_vectors"))) = {
+    (boot_vector_t)BOOT_STACK_TOP,
+    boot_reset,
+    boot_fault, // NMI
+    boot_fault, // HardFault
+};
+
+/* --------------------------- 看门狗 --------------------------- */
+
+static void boot_wdt_feed(void) { IWDG->KR = 0xAAAA; }
+
+/**
+ * @brief 延长 IWDG 超时 (未启动时写入无效果，也不会启动它)
+ */
+static void boot_wdt_extend(void) {
+  IWDG->KR = 0x5555;
+  IWDG->PR = 6;      // 256 分频
+  IWDG->RLR = 0xFFF; // 32 kHz LSI 下约 32 s
+  boot_wdt_feed();
+}
+
+/* --------------------------- 外部 Flash (SPI1) --------------------------- */
+
+static void boot_nor_init(void) {
+  RCC->AHB1ENR |= RCC_AHB1ENR_GPIOBEN;
+  RCC->APB2ENR |= RCC_APB2ENR_SPI1EN;
+  (void)RCC->APB2ENR;
+
+  /* PB14 片选 (先置高)，PB3/4/5 复用为 SPI1 (AF5) */
+  GPIOB->BSRR = 1UL << BOOT_NOR_CS_PIN;
+  GPIOB->MODER = (GPIOB->MODER & ~(3UL << (BOOT_NOR_CS_PIN * 2U)) &
+                  ~(0x3FUL << 6)) |
+                 (1UL << (BOOT_NOR_CS_PIN * 2U)) | (0x2AUL << 6);
+  GPIOB->OSPEEDR |= (3UL << (BOOT_NOR_CS_PIN * 2U)) | (0x3FUL << 6);
+  GPIOB->PUPDR = (GPIOB->PUPDR & ~(3UL << (BOOT_NOR_CS_PIN * 2U)) &
+                  ~(0x3FUL << 6)) |
+                 (1UL << (BOOT_NOR_CS_PIN * 2U)) | (0x15UL << 6);
+  GPIOB->AFR[0] = (GPIOB->AFR[0] & ~0x00FFF000UL) | 0x00555000UL;
+
+  /* 模式 3、主机、软件片选，fPCLK2 / 2 = 8 MHz */
+  SPI1->CR1 = SPI_CR1_MSTR | SPI_CR1_SSM | SPI_CR1_SSI | SPI_CR1_CPOL |
+              SPI_CR1_CPHA;
+  SPI1->CR2 = 0;
+  SPI1->CR1 |= SPI_CR1_SPE;
+}
+
+/**
+ * @brief 复位 SPI1 与 GPIOB，交给应用程序重新初始化
+ */
+static void boot_nor_deinit(void) {
+  RCC->APB2RSTR |= RCC_APB2RSTR_SPI1RST;
+  RCC->APB2RSTR &= ~RCC_APB2RSTR_SPI1RST;
+  RCC->AHB1RSTR |= RCC_AHB1RSTR_GPIOBRST;
+  RCC->AHB1RSTR &= ~RCC_AHB1RSTR_GPIOBRST;
+  RCC->APB2ENR &= ~RCC_APB2ENR_SPI1EN;
+  RCC->AHB1ENR &= ~RCC_AHB1ENR_GPIOBEN;
+}
+
+static void boot_nor_cs(bool active) {
+  GPIOB->BSRR = active ? (1UL << (BOOT_NOR_CS_PIN + 16U))
+                       : (1UL << BOOT_NOR_CS_PIN);
+}
+
+static uint8_t boot_spi(uint8_t data) {
+  while ((SPI1->SR & SPI_SR_TXE) == 0) {
+  }
+  *(__IO uint8_t *)&SPI1->DR = data;
+  while ((SPI1->SR & SPI_SR_RXNE) == 0) {
+  }
+  return *(__IO uint8_t *)&SPI1->DR;
+}
+
+static void boot_nor_command(uint8_t cmd, uint32_t addr) {
+  boot_nor_cs(true);
+  boot_spi(cmd);
+  boot_spi((uint8_t)(addr >> 16));
+  boot_spi((uint8_t)(addr >> 8));
+  boot_spi((uint8_t)addr);
+}
+
+static void boot_nor_read(uint32_t addr, uint8_t *buf, uint32_t len) {
+  boot_nor_command(NOR_CMD_READ, addr);
+  while (len--) {
+    *buf++ = boot_spi(0xFF);
+  }
+  boot_nor_cs(false);
+}
+
+static void boot_nor_wait(void) {
+  uint8_t status;
+
+  boot_nor_cs(true);
+  boot_spi(NOR_CMD_READ_STATUS);
+  do {
+    status = boot_spi(0xFF);
+    boot_wdt_feed();
+  } while (status & 0x01U); // BUSY
+  boot_nor_cs(false);
+}
+
+static void boot_nor_write_enable(void) {
+  boot_nor_cs(true);
+  boot_spi(NOR_CMD_WRITE_ENABLE);
+  boot_nor_cs(false);
+}
+
+static void boot_nor_erase(uint32_t addr) {
+  boot_nor_write_enable();
+  boot_nor_command(NOR_CMD_SECTOR_ERASE, addr);
+  boot_nor_cs(false);
+  boot_nor_wait();
+}
+
+/**
+ * @brief 写入数据 (按页拆分，目标区域须已擦除)
+ */
+static void boot_nor_program(uint32_t addr, const uint8_t *data, uint32_t len) {
+  while (len > 0) {
+    uint32_t n = BOOT_NOR_PAGE - (addr % BOOT_NOR_PAGE);
+
+    if (n > len) {
+      n = len;
+    }
+    boot_nor_write_enable();
+    boot_nor_command(NOR_CMD_PAGE_PROGRAM, addr);
+    for (uint32_t i = 0; i < n; i++) {
+      boot_spi(data[i]);
+    }
+    boot_nor_cs(false);
+    boot_nor_wait();
+    addr += n;
+    data += n;
+    len -= n;
+  }
+}
+
+/* --------------------------- 片内 Flash --------------------------- */
+
+static uint32_t boot_flash_sector(uint32_t addr) {
+  addr -= OTA_BOOT_ADDR;
+  if (addr < 0x10000UL) {
+    return addr >> 14; // 扇区 0~3: 16 KB
+  }
+  if (addr < 0x20000UL) {
+    return 4;          // 扇区 4: 64 KB
+  }
+  return 5 + ((addr - 0x20000UL) >> 17); // 扇区 5~11: 128 KB
+}
+
+static bool boot_flash_done(void) {
+  while (FLASH->SR & FLASH_SR_BSY) {
+  }
+  return (FLASH->SR & BOOT_FLASH_ERRORS) == 0;
+}
+
+static bool boot_flash_erase(uint32_t sector) {
+  boot_wdt_feed();
+  FLASH->SR = BOOT_FLASH_ERRORS | FLASH_SR_EOP;
+  FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_SER | (sector << FLASH_CR_SNB_Pos);
+  FLASH->CR |= FLASH_CR_STRT;
+  return boot_flash_done();
+}
+
+static bool boot_flash_program(uint32_t addr, uint32_t word) {
+  FLASH->CR = FLASH_CR_PSIZE_1 | FLASH_CR_PG;
+  *(__IO uint32_t *)addr = word;
+  return boot_flash_done();
+}
+
+/* --------------------------- 镜像操作 --------------------------- */
+
+static uint32_t boot_crc32(uint32_t crc, const uint8_t *data, uint32_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (uint8_t k = 0; k < 8; k++) {
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1UL)));
+    }
+  }
+  return ~crc;
+}
+
+static bool boot_header_ok(const OtaImageHeader_t *h) {
+  return h->magic == OTA_IMAGE_MAGIC && h->load_addr == OTA_APP_ADDR &&
+         h->size != 0 && h->size <= OTA_IMAGE_MAX && (h->size & 3U) == 0 &&
+         boot_crc32(0, (const uint8_t *)h,
+                    offsetof(OtaImageHeader_t, header_crc)) == h->header_crc;
+}
+
+/**
+ * @brief 读取槽位的镜像头并校验整个镜像
+ */
+static bool boot_slot_ok(uint32_t slot, OtaImageHeader_t *h) {
+  uint8_t buf[BOOT_CHUNK];
+  uint32_t crc = 0;
+
+  boot_nor_read(slot, (uint8_t *)h, sizeof(*h));
+  if (!boot_header_ok(h)) {
+    return false;
+  }
+  for (uint32_t off = 0; off < h->size; off += BOOT_CHUNK) {
+    uint32_t n = h->size - off < BOOT_CHUNK ? h->size - off : BOOT_CHUNK;
+
+    boot_nor_read(slot + OTA_SLOT_DATA_OFFSET + off, buf, n);
+    crc = boot_crc32(crc, buf, n);
+    boot_wdt_feed();
+  }
+  return crc == h->crc;
+}
+
+/**
+ * @brief 暂存槽的一个状态字写为 OTA_STATE_DONE
+ */
+static void boot_mark(uint32_t field) {
+  uint8_t done[4] = {0, 0, 0, 0};
+
+  boot_nor_program(OTA_STAGING_ADDR + OTA_STATE_OFFSET + field, done,
+                   sizeof(done));
+}
+
+/**
+ * @brief 把当前应用程序备份到备份槽 (长度取到最后一个非空字)
+ */
+static bool boot_backup(void) {
+  OtaImageHeader_t h;
+  uint32_t end = OTA_APP_END;
+  uint32_t crc;
+
+  while (end > OTA_APP_ADDR && *(const uint32_t *)(end - 4) == 0xFFFFFFFFUL) {
+    end -= 4;
+  }
+  if (end == OTA_APP_ADDR) {
+    return true; // 片内没有应用程序，无需备份
+  }
+
+  for (uint32_t off = 0; off < OTA_SLOT_DATA_OFFSET + (end - OTA_APP_ADDR);
+       off += BOOT_NOR_SECTOR) {
+    boot_nor_erase(OTA_BACKUP_ADDR + off);
+  }
+  boot_nor_program(OTA_BACKUP_ADDR + OTA_SLOT_DATA_OFFSET,
+                   (const uint8_t *)OTA_APP_ADDR, end - OTA_APP_ADDR);
+  crc = boot_crc32(0, (const uint8_t *)OTA_APP_ADDR, end - OTA_APP_ADDR);
+
+  /* 镜像头最后写入 */
+  h.magic = OTA_IMAGE_MAGIC;
+  h.version = 0;
+  h.size = end - OTA_APP_ADDR;
+  h.crc = crc;
+  h.load_addr = OTA_APP_ADDR;
+  h.reserved[0] = 0xFFFFFFFFUL;
+  h.reserved[1] = 0xFFFFFFFFUL;
+  h.header_crc =
+      boot_crc32(0, (const uint8_t *)&h, offsetof(OtaImageHeader_t, header_crc));
+  boot_nor_program(OTA_BACKUP_ADDR, (const uint8_t *)&h, sizeof(h));
+  return boot_slot_ok(OTA_BACKUP_ADDR, &h);
+}
+
+/**
+ * @brief 把槽位中的镜像写入片内 Flash 并校验
+ */
+static bool boot_install(uint32_t slot, const OtaImageHeader_t *h) {
+  uint8_t buf[BOOT_CHUNK];
+  uint32_t last = boot_flash_sector(OTA_APP_ADDR + h->size - 1);
+  bool ok = true;
+
+  if (FLASH->CR & FLASH_CR_LOCK) {
+    FLASH->KEYR = 0x45670123UL;
+    FLASH->KEYR = 0xCDEF89ABUL;
+  }
+  for (uint32_t s = boot_flash_sector(OTA_APP_ADDR); ok && s <= last; s++) {
+    ok = boot_flash_erase(s);
+  }
+  for (uint32_t off = 0; ok && off < h->size; off += BOOT_CHUNK) {
+    uint32_t n = h->size - off < BOOT_CHUNK ? h->size - off : BOOT_CHUNK;
+
+    boot_nor_read(slot + OTA_SLOT_DATA_OFFSET + off, buf, n);
+    for (uint32_t i = 0; ok && i < n; i += 4) {
+      uint32_t word = (uint32_t)buf[i] | ((uint32_t)buf[i + 1] << 8) |
+                      ((uint32_t)buf[i + 2] << 16) |
+                      ((uint32_t)buf[i + 3] << 24);
+      ok = boot_flash_program(OTA_APP_ADDR + off + i, word);
+    }
+    boot_wdt_feed();
+  }
+  FLASH->CR = FLASH_CR_LOCK;
+
+  return ok &&
+         boot_crc32(0, (const uint8_t *)OTA_APP_ADDR, h->size) == h->crc;
+}
+
+/**
+ * @brief 从备份槽恢复原固件
+ */
+static void boot_rollback(void) {
+  OtaImageHeader_t h;
+
+  if (boot_slot_ok(OTA_BACKUP_ADDR, &h)) {
+    (void)boot_install(OTA_BACKUP_ADDR, &h);
+  }
+  boot_mark(offsetof(OtaSlotState_t, rejected));
+}
+
+/**
+ * @brief 按暂存槽的状态安装新固件或回滚 (每一步都可在掉电后重新执行)
+ */
+static void boot_update(void) {
+  OtaImageHeader_t h;
+  OtaSlotState_t s;
+  uint32_t i;
+
+  boot_nor_read(OTA_STAGING_ADDR, (uint8_t *)&h, sizeof(h));
+  boot_nor_read(OTA_STAGING_ADDR + OTA_STATE_OFFSET, (uint8_t *)&s, sizeof(s));
+  if (!boot_header_ok(&h) || s.rejected == OTA_STATE_DONE) {
+    return;
+  }
+
+  if (s.installed != OTA_STATE_DONE) {
+    if (!boot_slot_ok(OTA_STAGING_ADDR, &h)) {
+      boot_mark(offsetof(OtaSlotState_t, rejected));
+      return;
+    }
+    if (s.backed_up != OTA_STATE_DONE) {
+      if (!boot_backup()) {
+        boot_mark(offsetof(OtaSlotState_t, rejected)); // 无法回滚，不安装
+        return;
+      }
+      boot_mark(offsetof(OtaSlotState_t, backed_up));
+    }
+    if (!boot_install(OTA_STAGING_ADDR, &h)) {
+      boot_rollback(); // 片内已被部分改写
+      return;
+    }
+    boot_mark(offsetof(OtaSlotState_t, installed));
+  }
+
+  if (s.confirmed == OTA_STATE_DONE) {
+    return;
+  }
+  for (i = 0; i < OTA_TRIAL_BOOTS && s.trial[i] == OTA_STATE_DONE; i++) {
+  }
+  if (i < OTA_TRIAL_BOOTS) {
+    boot_mark(offsetof(OtaSlotState_t, trial) + i * sizeof(uint32_t));
+  } else {
+    boot_rollback(); // 试运行次数用完仍未确认
+  }
+}
+
+/**
+ * @brief 跳转到应用程序 (向量表无效时停在这里)
+ */
+static void boot_jump(void) {
+  const uint32_t *vectors = (const uint32_t *)OTA_APP_ADDR;
+  uint32_t sp = vectors[0];
+  uint32_t pc = vectors[1];
+
+  if (sp < SRAM1_BASE || sp > BOOT_STACK_TOP || pc < OTA_APP_ADDR ||
+      pc >= OTA_APP_END) {
+    boot_fault();
+  }
+  SCB->VTOR = OTA_APP_ADDR;
+  __DSB();
+  __set_MSP(sp);
+  ((void (*)(void))pc)();
+}
+
+/* --------------------------- 入口 --------------------------- */
+
+static void boot_reset(void) {
+  boot_wdt_extend();
+  boot_nor_init();
+  boot_update();
+  boot_nor_deinit();
+  boot_jump();
+}
+
+static void boot_fault(void) {
+  for (;;) {
+  }
+}
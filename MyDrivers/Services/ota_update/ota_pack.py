@@ -0,0 +1,165 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    ota_pack.py
+@brief   固件在线升级的打包与串口传输工具 (与 ota_update.c 配套)
+@details 从 Keil 生成的 Intel HEX 中取出应用程序区 [OTA_APP_ADDR, OTA_APP_END)
+         (扇区 0 的引导程序不随升级更新)，补齐到 4 字节，输出镜像文件
+         [镜像头 32 字节 | 镜像] (格式见 ota_update.h)。
+         可选通过串口命令行 (ota 命令) 传输到板子：每行一个 64 字节分块并附带
+         分块的 CRC-32，设备回复 ok 后发送下一块，CRC 错误时重发；中断后用
+         --resume 从设备已收到的偏移继续。全部写完后设备回读校验整个镜像，
+         复位后由引导程序安装。
+
+用法:
+    python ota_pack.py ../../../MDK-ARM/10-EnviroSense_zgt6/10-EnviroSense_zgt6.hex
+    python ota_pack.py fw.hex --version 3 --port COM5          # 打包并传输 (需要 pyserial)
+    python ota_pack.py fw.hex --version 3 --port COM5 --resume --reboot
+
+@author  MmsY
+@time    2025/11/23
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+import zlib
+
+APP_ADDR = 0x08004000       # OTA_APP_ADDR
+APP_END = 0x08100000        # OTA_APP_END
+MAGIC = 0x41544F45          # OTA_IMAGE_MAGIC "EOTA"
+HEADER_FMT = "<IIIII8x"     # magic, version, size, crc, load_addr, reserved[2]
+CHUNK = 64                  # 命令行一行最多 160 字符
+RETRIES = 5
+
+
+def crc32(data):
+    return zlib.crc32(data) & 0xFFFFFFFF
+
+
+def load_hex(path):
+    """读取 Intel HEX，返回应用程序区的字节 (空洞填 0xFF)"""
+    image = bytearray(b"\xFF" * (APP_END - APP_ADDR))
+    base, end = 0, APP_ADDR
+    with open(path, "r") as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            if not line.startswith(":"):
+                continue
+            rec = bytes.fromhex(line[1:])
+            if sum(rec) & 0xFF:
+                raise ValueError("%s:%d 校验和错误" % (path, lineno))
+            count, addr, kind = rec[0], (rec[1] << 8) | rec[2], rec[3]
+            data = rec[4:4 + count]
+            if kind == 0x00:
+                a = base + addr
+                if APP_ADDR <= a < APP_END:
+                    image[a - APP_ADDR:a - APP_ADDR + len(data)] = data
+                    end = max(end, a + len(data))
+            elif kind == 0x04:
+                base = ((data[0] << 8) | data[1]) << 16
+            elif kind == 0x02:
+                base = ((data[0] << 8) | data[1]) << 4
+            elif kind == 0x01:
+                break
+    size = (end - APP_ADDR + 3) & ~3
+    if size == 0:
+        raise ValueError("%s 中没有 0x%08X 起的应用程序" % (path, APP_ADDR))
+    return bytes(image[:size])
+
+
+def build_header(image, version):
+    head = struct.pack(HEADER_FMT, MAGIC, version, len(image), crc32(image), APP_ADDR)
+    return head + struct.pack("<I", crc32(head))
+
+
+def shell_command(port, line, timeout_lines=50):
+    """发送一条命令并返回第一行应答"""
+    port.write((line + "\r\n").encode("ascii"))
+    for _ in range(timeout_lines):
+        reply = port.readline().decode("ascii", "ignore").strip()
+        if reply.startswith(("ok", "error", "invalid", "usage", "state=")):
+            return reply
+    raise RuntimeError("命令无应答: %s" % line.split(" ")[0:2])
+
+
+def device_received(port):
+    reply = shell_command(port, "ota")
+    fields = dict(kv.split("=", 1) for kv in reply.split() if "=" in kv)
+    return fields.get("state"), int(fields.get("received", "0"))
+
+
+def upload(image, version, port_name, baud, resume, reboot):
+    import serial  # pyserial
+
+    with serial.Serial(port_name, baud, timeout=2) as port:
+        port.reset_input_buffer()
+        start = 0
+        if resume:
+            state, start = device_received(port)
+            if state != "receiving":
+                raise RuntimeError("设备没有进行中的接收 (state=%s)" % state)
+            start -= start % CHUNK
+            print("从偏移 %d 继续" % start)
+        else:
+            port.timeout = 3  # 擦除暂存槽首扇区
+            if shell_command(port, "ota begin %d 0x%08X %d"
+                             % (len(image), crc32(image), version)) != "ok":
+                raise RuntimeError("设备拒绝开始 (试运行中或容量不足)")
+
+        port.timeout = 2
+        t0 = time.time()
+        for off in range(start, len(image), CHUNK):
+            chunk = image[off:off + CHUNK]
+            line = "ota write %d %s 0x%08X" % (off, chunk.hex(), crc32(chunk))
+            for _ in range(RETRIES):
+                reply = shell_command(port, line)
+                if reply == "ok":
+                    break
+                if reply != "invalid chunk":
+                    raise RuntimeError("写入偏移 %d 失败: %s" % (off, reply))
+            else:
+                raise RuntimeError("偏移 %d 重发 %d 次仍失败" % (off, RETRIES))
+            if off % 4096 == 0:
+                rate = (off - start) / max(time.time() - t0, 1e-3)
+                print("\r写入 %d / %d (%.1f KB/s)" % (off, len(image), rate / 1024), end="")
+        print()
+
+        port.timeout = 10  # 回读校验整个镜像
+        reply = shell_command(port, "ota commit")
+        if reply != "ok":
+            raise RuntimeError("设备校验失败: %s" % reply)
+        print("传输完成，复位后安装")
+        if reboot:
+            port.write(b"ota reboot\r\n")
+            print("已复位，引导程序正在安装 (约 20 s)")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="打包并传输 EnviroSense 固件升级镜像")
+    parser.add_argument("hex", help="Keil 生成的 Intel HEX 文件")
+    parser.add_argument("-o", "--output", help="镜像文件 (默认与 HEX 同名 .ota)")
+    parser.add_argument("--version", type=int, default=int(time.strftime("%y%m%d%H")),
+                        help="固件版本 (默认 YYMMDDHH)")
+    parser.add_argument("--port", help="通过该串口传输到板子")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--resume", action="store_true", help="从设备已收到的偏移继续")
+    parser.add_argument("--reboot", action="store_true", help="传输完成后复位板子")
+    args = parser.parse_args()
+
+    image = load_hex(args.hex)
+    output = args.output or os.path.splitext(args.hex)[0] + ".ota"
+    with open(output, "wb") as f:
+        f.write(build_header(image, args.version) + image)
+    print("镜像 %s: 版本 %d, %d 字节, CRC 0x%08X"
+          % (output, args.version, len(image), crc32(image)))
+
+    if args.port:
+        upload(image, args.version, args.port, args.baud, args.resume, args.reboot)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,261 @@
+/**
+ ******************************************************************************
+ * @file    ota_update.c
+ * @brief   固件在线升级：应用程序侧 (接收镜像、确认新固件)
+ * @details 安装与回滚由引导程序完成 (见 ota_boot.c)。接收期间暂存槽按需
+ *          逐个 4 KB 扇区擦除，分块按顺序写入；镜像头在校验通过后最后写入。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "ota_update.h"
+#include "checksum.h"
+#include "norflash.h"
+#include "sys_clock.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stddef.h>
+#include <string.h>
+
+#define LOG_MODULE "OTA"
+#include "log.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+static bool s_ready = false;
+static OtaStatus_t s_status;
+static OtaImageHeader_t s_header; // 正在接收的镜像的镜像头
+static uint32_t s_erased_end;     // 暂存槽已擦除到的地址
+static uint8_t s_buf[64];         // 回读校验缓冲区
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static uint32_t ota_header_crc(const OtaImageHeader_t *h) {
+  return CRC32_Compute((const uint8_t *)h, offsetof(OtaImageHeader_t, header_crc));
+}
+
+static bool ota_header_valid(const OtaImageHeader_t *h) {
+  return h->magic == OTA_IMAGE_MAGIC && h->load_addr == OTA_APP_ADDR &&
+         h->size != 0 && h->size <= OTA_IMAGE_MAX && (h->size & 3U) == 0 &&
+         ota_header_crc(h) == h->header_crc;
+}
+
+/**
+ * @brief 把暂存槽的一个状态字写为 OTA_STATE_DONE
+ */
+static bool ota_mark(size_t field) {
+  uint32_t done = OTA_STATE_DONE;
+
+  return norflash_write(OTA_STAGING_ADDR + OTA_STATE_OFFSET + field,
+                        (const uint8_t *)&done, sizeof(done)) == 0;
+}
+
+/**
+ * @brief 回读暂存槽中的镜像并计算 CRC-32
+ */
+static bool ota_staging_crc(uint32_t size, uint32_t *crc) {
+  uint32_t addr = OTA_STAGING_ADDR + OTA_SLOT_DATA_OFFSET;
+  uint32_t value = 0;
+
+  while (size > 0) {
+    uint32_t n = size > sizeof(s_buf) ? sizeof(s_buf) : size;
+
+    if (norflash_read(addr, s_buf, n) != 0) {
+      return false;
+    }
+    value = CRC32_Update(value, s_buf, n);
+    addr += n;
+    size -= n;
+  }
+  *crc = value;
+  return true;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 读取暂存槽状态
+ */
+bool OtaUpdate_Init(void) {
+  OtaImageHeader_t header;
+  OtaSlotState_t state;
+
+  if (!norflash_is_ready() ||
+      norflash_get_size() < OTA_BACKUP_ADDR + OTA_SLOT_SIZE) {
+    LOG_WARN("外部 Flash 容量不足，在线升级关闭");
+    return false;
+  }
+  if (norflash_read(OTA_STAGING_ADDR, (uint8_t *)&header, sizeof(header)) != 0 ||
+      norflash_read(OTA_STAGING_ADDR + OTA_STATE_OFFSET, (uint8_t *)&state,
+                    sizeof(state)) != 0) {
+    return false;
+  }
+
+  memset(&s_status, 0, sizeof(s_status));
+  if (ota_header_valid(&header)) {
+    s_status.version = header.version;
+    s_status.size = header.size;
+    s_status.received = header.size;
+    if (state.installed != OTA_STATE_DONE) {
+      if (state.rejected != OTA_STATE_DONE) {
+        s_status.state = OTA_STATE_READY; // 引导程序尚未安装 (复位后安装)
+      }
+    } else if (state.rejected == OTA_STATE_DONE) {
+      s_status.rolled_back = true;
+      LOG_WARN("固件 %lu 未通过试运行，已回滚到原固件",
+               (unsigned long)header.version);
+    } else if (state.confirmed != OTA_STATE_DONE) {
+      s_status.state = OTA_STATE_TRIAL;
+      for (uint8_t i = 0; i < OTA_TRIAL_BOOTS; i++) {
+        s_status.trial_boots += state.trial[i] == OTA_STATE_DONE;
+      }
+      LOG_INFO("固件 %lu 试运行 (第 %u 次启动)", (unsigned long)header.version,
+               (unsigned)s_status.trial_boots);
+    }
+  }
+  s_ready = true;
+  return true;
+}
+
+/**
+ * @brief 开始接收新镜像
+ */
+bool OtaUpdate_Begin(uint32_t size, uint32_t crc, uint32_t version) {
+  if (!s_ready || s_status.state == OTA_STATE_TRIAL || size == 0 ||
+      size > OTA_IMAGE_MAX || (size & 3U) != 0) {
+    return false; // 试运行期间的状态字在暂存槽中，确认之前不能覆盖
+  }
+
+  /* 擦除首扇区：镜像头与状态字一并失效 */
+  if (norflash_erase_sector(OTA_STAGING_ADDR) != 0) {
+    s_status.state = OTA_STATE_ERROR;
+    return false;
+  }
+  memset(&s_header, 0xFF, sizeof(s_header));
+  s_header.magic = OTA_IMAGE_MAGIC;
+  s_header.version = version;
+  s_header.size = size;
+  s_header.crc = crc;
+  s_header.load_addr = OTA_APP_ADDR;
+  s_erased_end = OTA_STAGING_ADDR + OTA_SLOT_DATA_OFFSET;
+
+  memset(&s_status, 0, sizeof(s_status));
+  s_status.state = OTA_STATE_RECEIVING;
+  s_status.version = version;
+  s_status.size = size;
+  LOG_INFO("开始接收固件 %lu (%lu 字节)", (unsigned long)version,
+           (unsigned long)size);
+  return true;
+}
+
+/**
+ * @brief 写入一个分块
+ */
+bool OtaUpdate_Write(uint32_t offset, const uint8_t *data, uint32_t len) {
+  uint32_t addr = OTA_STAGING_ADDR + OTA_SLOT_DATA_OFFSET + offset;
+
+  if (s_status.state != OTA_STATE_RECEIVING || len == 0) {
+    return false;
+  }
+  if (offset + len <= s_status.received) {
+    return true; // 主机未收到应答而重发的分块
+  }
+  if (offset != s_status.received || offset + len > s_status.size) {
+    return false;
+  }
+
+  while (s_erased_end < addr + len) {
+    if (norflash_erase_sector(s_erased_end) != 0) {
+      s_status.state = OTA_STATE_ERROR;
+      return false;
+    }
+    s_erased_end += NORFLASH_SECTOR_SIZE;
+  }
+  if (norflash_write(addr, data, len) != 0) {
+    s_status.state = OTA_STATE_ERROR;
+    return false;
+  }
+  s_status.received += len;
+  return true;
+}
+
+/**
+ * @brief 校验镜像并写入镜像头
+ */
+bool OtaUpdate_Commit(void) {
+  uint32_t crc;
+
+  if (s_status.state != OTA_STATE_RECEIVING ||
+      s_status.received != s_status.size) {
+    return false;
+  }
+  if (!ota_staging_crc(s_header.size, &crc) || crc != s_header.crc) {
+    LOG_ERROR("固件校验失败: CRC %08lX, 期望 %08lX", (unsigned long)crc,
+              (unsigned long)s_header.crc);
+    s_status.state = OTA_STATE_ERROR;
+    return false;
+  }
+
+  s_header.header_crc = ota_header_crc(&s_header);
+  if (norflash_write(OTA_STAGING_ADDR, (const uint8_t *)&s_header,
+                     sizeof(s_header)) != 0) {
+    s_status.state = OTA_STATE_ERROR;
+    return false;
+  }
+  s_status.state = OTA_STATE_READY;
+  LOG_INFO("固件 %lu 已就绪，复位后安装", (unsigned long)s_header.version);
+  return true;
+}
+
+/**
+ * @brief 放弃正在接收的镜像 (镜像头尚未写入，暂存槽保持无效)
+ */
+void OtaUpdate_Abort(void) {
+  if (s_status.state == OTA_STATE_RECEIVING ||
+      s_status.state == OTA_STATE_ERROR) {
+    s_status.state = OTA_STATE_IDLE;
+    s_status.received = 0;
+  }
+}
+
+/**
+ * @brief 后台处理：确认试运行的新固件
+ */
+void OtaUpdate_Process(bool booted) {
+  if (s_status.state != OTA_STATE_TRIAL || !booted ||
+      SysClock_Seconds() < OTA_CONFIRM_UPTIME_S) {
+    return;
+  }
+  if (ota_mark(offsetof(OtaSlotState_t, confirmed))) {
+    s_status.state = OTA_STATE_IDLE;
+    LOG_INFO("固件 %lu 已确认", (unsigned long)s_status.version);
+  }
+}
+
+/**
+ * @brief 获取升级状态
+ */
+void OtaUpdate_GetStatus(OtaStatus_t *status) {
+  taskENTER_CRITICAL();
+  *status = s_status;
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 状态名称
+ */
+const char *OtaUpdate_StateName(OtaState_t state) {
+  switch (state) {
+  case OTA_STATE_RECEIVING:
+    return "receiving";
+  case OTA_STATE_READY:
+    return "ready";
+  case OTA_STATE_TRIAL:
+    return "trial";
+  case OTA_STATE_ERROR:
+    return "error";
+  case OTA_STATE_IDLE:
+  default:
+    return "idle";
+  }
+}
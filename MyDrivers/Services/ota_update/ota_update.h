@@ -0,0 +1,160 @@
+/**
+ ******************************************************************************
+ * @file    ota_update.h
+ * @brief   固件在线升级 (外部 Flash 暂存 + 引导程序安装，失败自动回滚)
+ * @details 片内 Flash 布局 (见 EnviroSense_zgt6.sct)：
+ *            扇区 0 (16 KB)      引导程序 ota_boot.c，升级时不改写
+ *            扇区 1~11           应用程序 (OTA_APP_ADDR 起，向量表在开头)
+ *          应用程序约 570 KB，片内放不下两份，A/B 两个槽位放在外部 SPI Flash：
+ *            OTA_STAGING_ADDR    暂存槽：下载中的新固件
+ *            OTA_BACKUP_ADDR     备份槽：安装前由引导程序备份的当前固件
+ *          每个槽位首扇区为 [镜像头 | ... | 状态字 (OTA_STATE_OFFSET 起)]，
+ *          镜像数据从 OTA_SLOT_DATA_OFFSET 开始。
+ *          升级流程：
+ *            1. 应用程序在后台接收镜像分块 (命令行 ota 命令，见 ota_pack.py)，
+ *               按顺序写入暂存槽，采样与界面照常运行；
+ *            2. 全部写完后回读校验整个镜像的 CRC-32，通过后才写入镜像头，
+ *               镜像头是否有效即"有待安装的固件"的唯一依据；
+ *            3. 复位后引导程序再次校验，备份当前固件，写入新固件并校验，
+ *               然后以试运行方式启动新固件；
+ *            4. 新固件启动完成并稳定运行 OTA_CONFIRM_UPTIME_S 后确认；
+ *               未确认就复位 OTA_TRIAL_BOOTS 次 (崩溃、看门狗复位) 时，
+ *               引导程序从备份槽恢复原固件。
+ *          状态字擦除后为全 1，每完成一步把对应的字写为 0 (NOR Flash 只能
+ *          1 -> 0，不需要再擦除)，任一步骤中途掉电，上电后从该步骤重新执行。
+ *          镜像只做 CRC-32 完整性校验，不做签名验证。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __OTA_UPDATE_H
+#define __OTA_UPDATE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define OTA_BOOT_ADDR 0x08000000UL     // 引导程序 (片内 Flash 扇区 0)
+#define OTA_APP_ADDR 0x08004000UL      // 应用程序起始地址 (扇区 1，与散列文件一致)
+#define OTA_APP_END 0x08100000UL       // 片内 Flash 末尾
+#define OTA_FLASH_ADDR 0x600000UL      // 外部 Flash 中升级区起始地址 (图片资源包须在此之前)
+#define OTA_SLOT_SIZE 0x100000UL       // 每个槽位大小 (1 MB)
+#define OTA_STAGING_ADDR OTA_FLASH_ADDR
+#define OTA_BACKUP_ADDR (OTA_FLASH_ADDR + OTA_SLOT_SIZE)
+#define OTA_SLOT_DATA_OFFSET 0x1000UL  // 槽位内镜像数据的偏移 (首扇区为镜像头与状态字)
+#define OTA_STATE_OFFSET 0x100UL       // 槽位内状态字的偏移 (镜像头之后的第二页)
+#define OTA_TRIAL_BOOTS 3              // 新固件未确认时允许的启动次数
+#define OTA_CONFIRM_UPTIME_S 60        // 启动完成后稳定运行多久确认新固件
+#define OTA_IMAGE_MAX (OTA_APP_END - OTA_APP_ADDR) // 镜像最大长度
+
+#define OTA_IMAGE_MAGIC 0x41544F45UL   // "EOTA"
+#define OTA_STATE_DONE 0x00000000UL    // 状态字：该步骤已完成 (擦除后为 0xFFFFFFFF)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 镜像头 (32 字节，位于槽位首地址)
+ */
+typedef struct {
+  uint32_t magic;      // OTA_IMAGE_MAGIC
+  uint32_t version;    // 固件版本 (打包工具写入，备份槽为 0)
+  uint32_t size;       // 镜像长度 (字节，4 的倍数)
+  uint32_t crc;        // 镜像 CRC-32
+  uint32_t load_addr;  // 片内 Flash 目标地址 (须为 OTA_APP_ADDR)
+  uint32_t reserved[2];
+  uint32_t header_crc; // 以上字段的 CRC-32
+} OtaImageHeader_t;
+
+/**
+ * @brief 槽位状态字 (位于槽位首地址 + OTA_STATE_OFFSET)
+ */
+typedef struct {
+  uint32_t backed_up; // 当前固件已备份到备份槽
+  uint32_t installed; // 新固件已写入片内 Flash 并校验
+  uint32_t confirmed; // 新固件已确认运行正常
+  uint32_t rejected;  // 校验失败或已回滚，不再安装
+  uint32_t trial[OTA_TRIAL_BOOTS]; // 每次试运行启动写 0 一个
+} OtaSlotState_t;
+
+typedef enum {
+  OTA_STATE_IDLE = 0,  // 没有进行中的下载
+  OTA_STATE_RECEIVING, // 正在接收镜像分块
+  OTA_STATE_READY,     // 镜像已校验，复位后安装
+  OTA_STATE_TRIAL,     // 正在试运行新固件，尚未确认
+  OTA_STATE_ERROR,     // 写入或校验失败，需要重新开始
+} OtaState_t;
+
+/**
+ * @brief 升级状态
+ */
+typedef struct {
+  OtaState_t state;
+  uint32_t version;     // 暂存槽中镜像的版本
+  uint32_t size;        // 镜像长度
+  uint32_t received;    // 已写入的字节数 (下一个分块的偏移)
+  uint8_t trial_boots;  // 试运行已启动的次数
+  bool rolled_back;     // 上一个新固件未确认，已回滚
+} OtaStatus_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 读取暂存槽状态 (须在外部 Flash 初始化之后调用)
+ * @return false: 外部 Flash 不可用，升级功能关闭
+ */
+bool OtaUpdate_Init(void);
+
+/**
+ * @brief 开始接收新镜像：使暂存槽中原有的镜像失效
+ * @param size    镜像长度 (字节，4 的倍数)
+ * @param crc     镜像 CRC-32
+ * @param version 固件版本
+ */
+bool OtaUpdate_Begin(uint32_t size, uint32_t crc, uint32_t version);
+
+/**
+ * @brief 写入一个分块
+ * @param offset 分块在镜像中的偏移，须等于已写入的长度 (重发已写入的分块视为成功)
+ * @return false: 偏移不连续、越界或写入失败
+ * @note  与传输方式无关，命令行与其他通道都调用本接口
+ */
+bool OtaUpdate_Write(uint32_t offset, const uint8_t *data, uint32_t len);
+
+/**
+ * @brief 全部分块写完：回读校验 CRC-32，通过后写入镜像头
+ * @return true: 复位后由引导程序安装
+ */
+bool OtaUpdate_Commit(void);
+
+/**
+ * @brief 放弃正在接收的镜像
+ */
+void OtaUpdate_Abort(void);
+
+/**
+ * @brief 后台处理：试运行的新固件启动完成并稳定运行后确认
+ * @param booted 所有启动阶段已完成
+ * @note  在监控任务中周期调用
+ */
+void OtaUpdate_Process(bool booted);
+
+/**
+ * @brief 获取升级状态
+ */
+void OtaUpdate_GetStatus(OtaStatus_t *status);
+
+/**
+ * @brief 状态名称
+ */
+const char *OtaUpdate_StateName(OtaState_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __OTA_UPDATE_H */
@@ -0,0 +1,158 @@
+/**
+ ******************************************************************************
+ * @file    power_manager.c
+ * @brief   低功耗管理实现 (无节拍空闲)
+ * @details 睡眠流程 (关中断执行，唤醒中断在补偿完成、开中断后才被处理)：
+ *            1. eTaskConfirmSleepModeStatus 确认期间没有任务就绪；
+ *            2. 关闭 TIM6 更新中断 (HAL 与 RTOS 共用的节拍源)，TIM7 单脉冲
+ *               定时 sleep_ms；
+ *            3. WFI，被 TIM7 或其他中断唤醒；
+ *            4. 按 TIM7 计数得到实际睡眠的整毫秒数，补给 RTOS 与 HAL 时基，
+ *               恢复 TIM6 中断。
+ *          节拍补偿不越过下一个任务的唤醒时刻 (vTaskStepTick 的要求)，
+ *          最后 1 个节拍由 TIM6 的下一次更新产生，任务唤醒最多晚 1 ms；
+ *          两个计数补上相同的毫秒数，HAL_GetTick 与 RTOS 节拍保持相等。
+ *          每次睡眠丢弃不足 1 ms 的零头，RTOS 节拍相对实际时间略慢，
+ *          墙上时钟由 RTC 提供，不受影响。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "power_manager.h"
+#include "FreeRTOS.h"
+#include "buzzer.h"
+#include "main.h"
+#include "sys_clock.h"
+#include "task.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define POWER_SLEEP_TIMER TIM7
+#define POWER_COUNTS_PER_MS (POWER_SLEEP_TIMER_HZ / 1000U)
+
+/* --------------------------- 私有变量 --------------------------- */
+static bool s_ready;
+static PowerStats_t s_stats;
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 配置睡眠定时器
+ */
+void Power_Init(void) {
+  RCC_ClkInitTypeDef clk;
+  uint32_t latency;
+  uint32_t timclk;
+
+  /* APB1 分频不为 1 时定时器时钟为 PCLK1 的 2 倍 */
+  HAL_RCC_GetClockConfig(&clk, &latency);
+  timclk = HAL_RCC_GetPCLK1Freq();
+  if (clk.APB1CLKDivider != RCC_HCLK_DIV1) {
+    timclk *= 2U;
+  }
+
+  __HAL_RCC_TIM7_CLK_ENABLE();
+  POWER_SLEEP_TIMER->CR1 = TIM_CR1_OPM | TIM_CR1_URS; // 单脉冲，只有溢出产生更新
+  POWER_SLEEP_TIMER->PSC = timclk / POWER_SLEEP_TIMER_HZ - 1U;
+  POWER_SLEEP_TIMER->EGR = TIM_EGR_UG; // 装载预分频值
+  POWER_SLEEP_TIMER->SR = 0;
+  POWER_SLEEP_TIMER->DIER = TIM_DIER_UIE;
+
+  /* 中断只用于把 CPU 从 WFI 唤醒，优先级最低 */
+  HAL_NVIC_SetPriority(TIM7_IRQn, 15, 0);
+  HAL_NVIC_EnableIRQ(TIM7_IRQn);
+
+  s_ready = true;
+}
+
+/**
+ * @brief 无节拍空闲实现
+ */
+void Power_SuppressTicksAndSleep(uint32_t expected_idle_ticks) {
+  uint32_t sleep_ms = expected_idle_ticks; // 节拍为 1 ms
+  uint32_t elapsed;
+  uint32_t cycles_before;
+  uint32_t cycles;
+
+  if (!s_ready) {
+    return;
+  }
+  if (sleep_ms > POWER_SLEEP_MAX_MS) {
+    sleep_ms = POWER_SLEEP_MAX_MS;
+  }
+
+  __disable_irq();
+  __DSB();
+  __ISB();
+
+  /* 关中断前有任务被唤醒，或蜂鸣器需要 1 ms 时基 */
+  if (eTaskConfirmSleepModeStatus() == eAbortSleep || Buzzer_IsPlaying()) {
+    s_stats.aborted++;
+    __enable_irq();
+    return;
+  }
+
+  HAL_SuspendTick();
+
+  POWER_SLEEP_TIMER->ARR = sleep_ms * POWER_COUNTS_PER_MS - 1U;
+  POWER_SLEEP_TIMER->CNT = 0;
+  POWER_SLEEP_TIMER->SR = 0;
+  POWER_SLEEP_TIMER->CR1 |= TIM_CR1_CEN;
+  cycles_before = DWT->CYCCNT;
+
+  __DSB();
+  __WFI();
+  __ISB();
+
+  POWER_SLEEP_TIMER->CR1 &= ~TIM_CR1_CEN;
+  if (POWER_SLEEP_TIMER->SR & TIM_SR_UIF) {
+    elapsed = sleep_ms;
+  } else {
+    elapsed = POWER_SLEEP_TIMER->CNT / POWER_COUNTS_PER_MS;
+  }
+  POWER_SLEEP_TIMER->SR = 0;
+  NVIC_ClearPendingIRQ(TIM7_IRQn);
+
+  /* 不越过下一个唤醒时刻，最后一个节拍留给 TIM6 */
+  if (elapsed >= expected_idle_ticks) {
+    elapsed = expected_idle_ticks - 1U;
+  }
+  if (elapsed > 0) {
+    SysClock_StepTick(elapsed);
+    vTaskStepTick(elapsed);
+  }
+
+  /* 运行时统计用的 DWT 周期计数器在睡眠时可能停止，补上后睡眠时间计入空闲任务 */
+  cycles = elapsed * (SystemCoreClock / 1000U);
+  if (DWT->CYCCNT - cycles_before < cycles) {
+    DWT->CYCCNT = cycles_before + cycles;
+  }
+
+  /* 睡眠期间 TIM6 仍在计数，丢弃挂起的更新，零头不重复计入 */
+  TIM6->SR = (uint32_t)~TIM_SR_UIF;
+  HAL_ResumeTick();
+
+  s_stats.sleeps++;
+  s_stats.slept_ms += elapsed;
+  if (elapsed > s_stats.longest_ms) {
+    s_stats.longest_ms = elapsed;
+  }
+
+  __enable_irq();
+}
+
+/**
+ * @brief 睡眠定时器中断 (正常情况下标志已在唤醒后清除，这里只做兜底)
+ */
+void Power_TimerIRQHandler(void) { POWER_SLEEP_TIMER->SR = 0; }
+
+/**
+ * @brief 获取睡眠统计
+ */
+void Power_GetStats(PowerStats_t *stats) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  *stats = s_stats;
+  __set_PRIMASK(primask);
+}
@@ -0,0 +1,76 @@
+/**
+ ******************************************************************************
+ * @file    power_manager.h
+ * @brief   低功耗管理头文件 (无节拍空闲)
+ * @details FreeRTOS 以 configUSE_TICKLESS_IDLE = 2 使用本模块的
+ *          Power_SuppressTicksAndSleep()：所有任务都在等待时，空闲任务
+ *          关闭 TIM6 时基中断 (HAL 与 RTOS 共用)，用 TIM7 定时到下一个任务
+ *          唤醒时刻，CPU 以 WFI 进入睡眠模式；任意中断 (触摸、DMA、串口、
+ *          RTC) 都会提前唤醒。醒来后按 TIM7 计数补上 RTOS 节拍、HAL_GetTick
+ *          与 SysClock 的毫秒数。
+ *          FSMC 显示、DMA 与串口在睡眠模式下照常工作，因此亮屏时也可以睡眠；
+ *          蜂鸣器旋律依赖 1 ms 时基，播放期间不进入睡眠。
+ *          各任务已按截止时间休眠 (LVGL 睡到下一个定时器、传感器任务睡到
+ *          下一次采样、输出控制任务无周期工作时阻塞等待命令)，空闲时段
+ *          可长达数十到数百毫秒。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __POWER_MANAGER_H
+#define __POWER_MANAGER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define POWER_SLEEP_TIMER_HZ 2000U      // TIM7 计数频率 (84 MHz / 42000)
+#define POWER_SLEEP_MAX_MS 30000U       // 单次睡眠上限 (16 位计数器 / 2 kHz)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 睡眠统计
+ */
+typedef struct {
+  uint32_t sleeps;     // 进入睡眠的次数
+  uint32_t aborted;    // 检查后放弃睡眠的次数 (有任务就绪或蜂鸣器播放中)
+  uint32_t slept_ms;   // 累计睡眠时间
+  uint32_t longest_ms; // 最长一次睡眠
+} PowerStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 配置睡眠定时器 TIM7
+ * @note  在启动调度器之前调用；未调用时空闲任务不睡眠
+ */
+void Power_Init(void);
+
+/**
+ * @brief 无节拍空闲实现 (portSUPPRESS_TICKS_AND_SLEEP)
+ * @param expected_idle_ticks 距下一个任务唤醒的节拍数
+ * @note  由 FreeRTOS 空闲任务在调度器挂起时调用，不要在其他地方调用
+ */
+void Power_SuppressTicksAndSleep(uint32_t expected_idle_ticks);
+
+/**
+ * @brief 睡眠定时器 TIM7 中断处理 (在 TIM7_IRQHandler 中调用)
+ */
+void Power_TimerIRQHandler(void);
+
+/**
+ * @brief 获取睡眠统计
+ */
+void Power_GetStats(PowerStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __POWER_MANAGER_H */
@@ -3,31 +3,41 @@
  * @file    printf_redirect.c
  * @brief   printf重定向实现文件
  * @details
- * 实现了基于UART的printf重定向，支持双缓冲、DMA/中断模式及FreeRTOS互斥锁保护。
+ * 实现了基于UART的printf重定向，使用单个环形发送缓冲区：DMA每次发送
+ * 从读指针到写指针 (或到缓冲区末尾) 的连续区段，发送完成回调中接着启动
+ * 下一段，形成链式DMA。缓冲区满时写入者阻塞在信号量上，由发送完成中断唤醒。
+ * 发送通道可切换 (如 USB 虚拟串口)：区段改由通道的启动函数发送，完成时通道
+ * 调用 printf_tx_channel_done，推进读指针与链式发送的逻辑与 UART 相同。
  * @author  MmsY
  * @time    2025/11/23
  ******************************************************************************
  */
 #include "printf_redirect.h"
+#include "task_plan.h"
 #include <string.h>
 
-/* 双缓冲区 */
-static char printf_buffer_a[PRINTF_BUFFER_SIZE];
-static char printf_buffer_b[PRINTF_BUFFER_SIZE];
-static volatile char *current_write_buffer;
-static volatile char *current_dma_buffer;
-static volatile uint16_t write_index = 0;
-static volatile uint16_t dma_length = 0;
+/* 环形发送缓冲区：tx_head 由写入者推进，tx_tail 由发送完成回调推进 */
+static char printf_buffer[PRINTF_BUFFER_SIZE];
+static volatile uint16_t tx_head = 0;
+static volatile uint16_t tx_tail = 0;
+static volatile uint16_t dma_length = 0; // 当前DMA区段长度
 static volatile uint8_t dma_busy = 0;
-static volatile uint8_t buffer_switch_pending = 0;
+static volatile uint8_t tx_waiting = 0; // 有写入者在等待缓冲区空间
 
 /* UART句柄指针 - 通过外部函数设置 */
 static UART_HandleTypeDef *printf_uart_handle = NULL;
 
+/* 发送通道：NULL 为 UART。切换请求先记在 tx_channel_next，
+ * 当前区段发送完成后才生效，同一区段不会由两个通道各发一部分 */
+static printf_tx_start_t tx_channel = NULL;
+static volatile printf_tx_start_t tx_channel_next = NULL;
+
 #if PRINTF_USE_FREERTOS
 /* FreeRTOS相关变量 */
 static SemaphoreHandle_t printf_mutex = NULL;
 static StaticSemaphore_t printf_mutex_buffer;
+static SemaphoreHandle_t printf_tx_sem = NULL; // 发送完成通知
+static StaticSemaphore_t printf_tx_sem_buffer;
 #define PRINTF_MUTEX_TIMEOUT pdMS_TO_TICKS(PRINTF_MUTEX_TIMEOUT_MS)
 
 /* 判断是否在中断上下文 */
@@ -49,94 +59,215 @@ static void give_mutex_safe(void) {
   }
 }
 
+#define TX_ENTER_CRITICAL() taskENTER_CRITICAL()
+#define TX_EXIT_CRITICAL() taskEXIT_CRITICAL()
+
 #else
 /* 非RTOS环境下的临界区保护实现 */
 static void take_mutex_safe(uint32_t timeout) { __disable_irq(); }
 
 static void give_mutex_safe(void) { __enable_irq(); }
+
+/* 非RTOS下写入者持有"锁"时中断已关闭，无需再嵌套 */
+#define TX_ENTER_CRITICAL()
+#define TX_EXIT_CRITICAL()
 #endif
 
+/* 已缓存、尚未发送完成的字节数 */
+static inline uint16_t tx_used(void) {
+  return (uint16_t)((tx_head + PRINTF_BUFFER_SIZE - tx_tail) %
+                    PRINTF_BUFFER_SIZE);
+}
+
+/* 剩余空间 (保留一个字节区分空/满) */
+static inline uint16_t tx_free(void) {
+  return (uint16_t)(PRINTF_BUFFER_SIZE - 1 - tx_used());
+}
+
 /* 设置UART句柄 */
 void printf_set_uart_handle(UART_HandleTypeDef *huart) {
   printf_uart_handle = huart;
 }
 
-/* 切换缓冲区 */
-static void switch_buffer(void) {
-  if (current_write_buffer == printf_buffer_a) {
-    current_write_buffer = printf_buffer_b;
-    current_dma_buffer = printf_buffer_a;
-  } else {
-    current_write_buffer = printf_buffer_a;
-    current_dma_buffer = printf_buffer_b;
+/* 启动DMA传输：发送从 tx_tail 开始的连续区段 (调用者须保证与回调互斥) */
+static void start_dma_transmission(void) {
+  if (dma_busy) {
+    return;
+  }
+  tx_channel = tx_channel_next;
+  if (tx_channel == NULL && printf_uart_handle == NULL) {
+    return;
   }
 
-  dma_length = write_index;
-  write_index = 0;
-  buffer_switch_pending = 0;
-}
-
-/* 启动DMA传输 */
-static void start_dma_transmission(void) {
-  if (printf_uart_handle == NULL) {
+  uint16_t head = tx_head;
+  uint16_t tail = tx_tail;
+  if (head == tail) {
     return;
   }
 
-  if (!dma_busy && dma_length > 0) {
-    dma_busy = 1;
+  /* 写指针已回绕时只发到缓冲区末尾，剩余部分在完成回调中接着发 */
+  dma_length = (head > tail) ? (head - tail) : (PRINTF_BUFFER_SIZE - tail);
+  dma_busy = 1;
+
+  if (tx_channel != NULL) {
+    if (!tx_channel((const uint8_t *)&printf_buffer[tail], dma_length)) {
+      dma_busy = 0;
+    }
+    return;
+  }
 
 #if PRINTF_USE_DMA
-    if (HAL_UART_Transmit_DMA(printf_uart_handle, (uint8_t *)current_dma_buffer,
-                              dma_length) != HAL_OK) {
-      /* DMA发送失败，自动切换到中断模式 */
+  if (HAL_UART_Transmit_DMA(printf_uart_handle, (uint8_t *)&printf_buffer[tail],
+                            dma_length) != HAL_OK) {
+    /* DMA发送失败，自动切换到中断模式 */
+    if (HAL_UART_Transmit_IT(printf_uart_handle,
+                             (uint8_t *)&printf_buffer[tail],
+                             dma_length) != HAL_OK) {
       dma_busy = 0;
-      HAL_UART_Transmit_IT(printf_uart_handle, (uint8_t *)current_dma_buffer,
-                           dma_length);
-      dma_busy = 1;
     }
+  }
 #else
-    /* 使用中断模式 */
-    HAL_UART_Transmit_IT(printf_uart_handle, (uint8_t *)current_dma_buffer,
-                         dma_length);
+  /* 使用中断模式 */
+  if (HAL_UART_Transmit_IT(printf_uart_handle, (uint8_t *)&printf_buffer[tail],
+                           dma_length) != HAL_OK) {
+    dma_busy = 0;
+  }
+#endif
+}
+
+/* 任务上下文中启动发送 */
+static void kick_transmission(void) {
+  TX_ENTER_CRITICAL();
+  start_dma_transmission();
+  TX_EXIT_CRITICAL();
+}
+
+/* 唤醒等待空间的写入者 (中断上下文) */
+static void notify_waiter_from_isr(void) {
+#if PRINTF_USE_FREERTOS
+  if (tx_waiting && printf_tx_sem != NULL) {
+    BaseType_t woken = pdFALSE;
+    tx_waiting = 0;
+    xSemaphoreGiveFromISR(printf_tx_sem, &woken);
+    portYIELD_FROM_ISR(woken);
+  }
 #endif
+}
+
+/* 区段发送完成 (中断上下文)：释放 sent 字节并链式发送下一段 */
+static void tx_segment_done(uint16_t sent) {
+  if (sent > dma_length) {
+    sent = dma_length;
   }
+  tx_tail = (uint16_t)((tx_tail + sent) % PRINTF_BUFFER_SIZE);
+  dma_length = 0;
+  dma_busy = 0;
+
+  /* 链式发送下一段 */
+  start_dma_transmission();
+  notify_waiter_from_isr();
 }
 
 /* HAL回调函数 - 需要在main.c的用户代码中调用 */
 void printf_uart_tx_complete_callback(UART_HandleTypeDef *huart) {
-  if (huart == printf_uart_handle) {
+  if (huart == printf_uart_handle && tx_channel == NULL) {
+    tx_segment_done(dma_length);
+  }
+}
+
+void printf_uart_error_callback(UART_HandleTypeDef *huart) {
+  /* 接收错误 (如溢出) 不影响仍在进行的发送，只有发送也被中止时才重发 */
+  if (huart == printf_uart_handle && tx_channel == NULL &&
+      huart->gState == HAL_UART_STATE_READY) {
+    /* 发生错误时从当前读指针重新发送 */
     dma_busy = 0;
     dma_length = 0;
-
-    /* 如果有缓冲区切换请求，则切换并继续发送 */
-    if (buffer_switch_pending) {
-      switch_buffer();
-      start_dma_transmission();
+    start_dma_transmission();
+    if (!dma_busy) {
+      notify_waiter_from_isr();
     }
   }
 }
 
-void printf_uart_error_callback(UART_HandleTypeDef *huart) {
-  if (huart == printf_uart_handle) {
-    dma_busy = 0;
+/* 切换发送通道：当前区段发完后生效，空闲时立即按新通道发送积压的数据 */
+void printf_set_tx_channel(printf_tx_start_t start) {
+#if PRINTF_USE_FREERTOS
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+#else
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+#endif
 
-    /* 发生错误时尝试重新发送 */
-    if (dma_length > 0) {
-#if PRINTF_USE_DMA
-      if (HAL_UART_Transmit_DMA(printf_uart_handle,
-                                (uint8_t *)current_dma_buffer,
-                                dma_length) == HAL_OK) {
-        dma_busy = 1;
-      }
+  tx_channel_next = start;
+  start_dma_transmission();
+
+#if PRINTF_USE_FREERTOS
+  taskEXIT_CRITICAL_FROM_ISR(mask);
 #else
-      if (HAL_UART_Transmit_IT(printf_uart_handle,
-                               (uint8_t *)current_dma_buffer,
-                               dma_length) == HAL_OK) {
-        dma_busy = 1;
-      }
+  __set_PRIMASK(primask);
 #endif
+}
+
+/* 发送通道完成一个区段 (中断上下文) */
+void printf_tx_channel_done(uint16_t sent) {
+  if (tx_channel != NULL && dma_busy) {
+    tx_segment_done(sent);
+  }
+}
+
+/**
+ * 等待发送完成事件 (调用前须已持有锁，返回时仍持有锁)
+ * 返回0表示超时，或DMA已停止且没有释放出空间
+ */
+static uint8_t wait_tx_event(void) {
+#if PRINTF_USE_FREERTOS
+  if (xTaskGetSchedulerState() != taskSCHEDULER_RUNNING ||
+      printf_tx_sem == NULL) {
+    /* 调度器启动前无法阻塞，直接忙等发送完成 */
+    uint16_t used = tx_used();
+    uint32_t start = HAL_GetTick();
+    while (dma_busy && tx_used() == used) {
+      if (HAL_GetTick() - start > PRINTF_MUTEX_TIMEOUT_MS) {
+        return 0;
+      }
     }
+    return tx_used() != used;
+  }
+
+  /* 先置等待标志再复查，避免错过回调中的通知 */
+  tx_waiting = 1;
+  if (!dma_busy) {
+    tx_waiting = 0;
+    return tx_free() > 0;
+  }
+  if (xSemaphoreTake(printf_tx_sem, PRINTF_MUTEX_TIMEOUT) != pdTRUE) {
+    tx_waiting = 0;
+    return 0;
+  }
+  return 1;
+#else
+  /* 开中断等待当前区段发送完成 */
+  uint16_t used = tx_used();
+  give_mutex_safe();
+  while (dma_busy && tx_used() == used) {
   }
+  take_mutex_safe(0);
+  return tx_used() != used;
+#endif
+}
+
+/* 向环形缓冲区拷贝数据 (处理回绕)，调用者保证空间足够 */
+static void tx_copy_in(const char *src, uint16_t len) {
+  uint16_t head = tx_head;
+  uint16_t first = PRINTF_BUFFER_SIZE - head;
+
+  if (first > len) {
+    first = len;
+  }
+  memcpy(&printf_buffer[head], src, first);
+  memcpy(&printf_buffer[0], src + first, len - first);
+
+  tx_head = (uint16_t)((head + len) % PRINTF_BUFFER_SIZE);
 }
 
 /* 内部字符写入函数 */
@@ -145,55 +276,20 @@ static int internal_putchar(int ch, uint8_t blocking) {
     return -1;
   }
 
-  /* 检查当前缓冲区是否有空间 */
-  if (write_index >= PRINTF_BUFFER_SIZE - 1) {
-    /* 当前缓冲区满，需要切换 */
-    if (dma_busy) {
-      if (!blocking) {
-        return -1; // 非阻塞模式下返回失败
-      }
-
-      /* 阻塞模式下等待切换完成 */
-      buffer_switch_pending = 1;
-
-#if PRINTF_USE_FREERTOS
-      /* 临时释放互斥锁，避免死锁 */
-      give_mutex_safe();
-
-      /* 等待DMA完成并切换缓冲区 */
-      while (buffer_switch_pending) {
-        vTaskDelay(pdMS_TO_TICKS(1));
-      }
-
-      /* 重新获取互斥锁 */
-      if (take_mutex_safe(PRINTF_MUTEX_TIMEOUT) != pdTRUE) {
-        return -1;
-      }
-#else
-      /* 非RTOS环境下简单等待 */
-      give_mutex_safe();
-      while (buffer_switch_pending) {
-        HAL_Delay(1);
-      }
-      take_mutex_safe(0);
-#endif
-    } else {
-      /* DMA空闲，直接切换缓冲区 */
-      switch_buffer();
+  /* 缓冲区满：启动发送并等待空间 */
+  while (tx_free() == 0) {
+    kick_transmission();
+    if (!blocking || !wait_tx_event()) {
+      return -1;
     }
   }
 
-  /* 写入字符到当前写缓冲区 */
-  ((char *)current_write_buffer)[write_index++] = (char)ch;
+  char c = (char)ch;
+  tx_copy_in(&c, 1);
 
   /* 如果是换行符或缓冲区接近满，则尝试发送 */
-  if (ch == '\n' || ch == '\r' || write_index >= PRINTF_BUFFER_SIZE - 10) {
-    if (!dma_busy && write_index > 0) {
-      switch_buffer();
-      start_dma_transmission();
-    } else if (dma_busy) {
-      buffer_switch_pending = 1;
-    }
+  if (ch == '\n' || ch == '\r' || tx_free() < PRINTF_BUFFER_SIZE / 4) {
+    kick_transmission();
   }
 
   return ch;
@@ -202,12 +298,8 @@ static int internal_putchar(int ch, uint8_t blocking) {
 /* 重写fputc函数 */
 int fputc(int ch, FILE *f) {
 #if PRINTF_USE_FREERTOS
-  /* 如果在中断中使用简化版本直接写入 */
+  /* 中断中不能加锁，也不能在任务写到一半时改动写指针，直接丢弃 */
   if (is_in_isr()) {
-    if (write_index < PRINTF_BUFFER_SIZE - 1) {
-      ((char *)current_write_buffer)[write_index++] = (char)ch;
-      return ch;
-    }
     return -1;
   }
 
@@ -230,7 +322,7 @@ int fputc(int ch, FILE *f) {
 int fputc_nb(int ch, FILE *f) {
 #if PRINTF_USE_FREERTOS
   if (is_in_isr()) {
-    return fputc(ch, f);
+    return -1;
   }
 
   if (take_mutex_safe(0) != pdTRUE) {
@@ -247,7 +339,7 @@ int fputc_nb(int ch, FILE *f) {
   return result;
 }
 
-/* 强制刷新缓冲区 */
+/* 强制刷新缓冲区：启动发送并等待全部数据发出 */
 void printf_flush(void) {
 #if PRINTF_USE_FREERTOS
   if (is_in_isr()) {
@@ -261,157 +353,152 @@ void printf_flush(void) {
   take_mutex_safe(0);
 #endif
 
-  if (write_index > 0) {
-    if (!dma_busy) {
-      switch_buffer();
-      start_dma_transmission();
-    } else {
-      buffer_switch_pending = 1;
+  kick_transmission();
+  while (tx_used() > 0 && dma_busy) {
+    if (!wait_tx_event()) {
+      break;
     }
   }
 
   give_mutex_safe();
-
-  /* 等待所有数据发送完成 */
-#if PRINTF_USE_FREERTOS
-  while (dma_busy || buffer_switch_pending) {
-    vTaskDelay(pdMS_TO_TICKS(1));
-  }
-#else
-  while (dma_busy || buffer_switch_pending) {
-    HAL_Delay(1);
-  }
-#endif
 }
 
-/* 查询传输状态 */
-uint8_t printf_is_busy(void) {
-  uint8_t busy = 0;
+/* 修改波特率：缓冲区中已有的数据先按原波特率发完，再改写 BRR。
+ * 不重新初始化串口，共用串口的接收 DMA (命令行) 不受影响 */
+uint8_t printf_set_baudrate(uint32_t baudrate) {
+  UART_HandleTypeDef *huart = printf_uart_handle;
+  uint32_t start, pclk;
 
+  if (huart == NULL || baudrate == 0) {
+    return 0;
+  }
 #if PRINTF_USE_FREERTOS
-  if (take_mutex_safe(pdMS_TO_TICKS(10)) == pdTRUE) {
-    busy = (dma_busy || buffer_switch_pending || write_index > 0);
-    give_mutex_safe();
+  if (is_in_isr()) {
+    return 0;
+  }
+  if (take_mutex_safe(PRINTF_MUTEX_TIMEOUT) != pdTRUE) {
+    return 0;
   }
 #else
   take_mutex_safe(0);
-  busy = (dma_busy || buffer_switch_pending || write_index > 0);
-  give_mutex_safe();
 #endif
 
-  return busy;
+  start = HAL_GetTick();
+  while ((dma_busy || tx_used() > 0) &&
+         HAL_GetTick() - start < PRINTF_BAUD_DRAIN_MS) {
+    kick_transmission();
+    wait_tx_event();
+  }
+  /* 等待最后一个字节移出移位寄存器 (不超过一个字符时间) */
+  while (!__HAL_UART_GET_FLAG(huart, UART_FLAG_TC) &&
+         HAL_GetTick() - start < PRINTF_BAUD_DRAIN_MS + 2) {
+  }
+
+  pclk = (huart->Instance == USART1 || huart->Instance == USART6)
+             ? HAL_RCC_GetPCLK2Freq()
+             : HAL_RCC_GetPCLK1Freq();
+  huart->Instance->BRR = (huart->Init.OverSampling == UART_OVERSAMPLING_8)
+                             ? UART_BRR_SAMPLING8(pclk, baudrate)
+                             : UART_BRR_SAMPLING16(pclk, baudrate);
+  huart->Init.BaudRate = baudrate;
+
+  give_mutex_safe();
+  return 1;
+}
+
+/* 查询传输状态 */
+uint8_t printf_is_busy(void) {
+  return (dma_busy || tx_used() > 0);
 }
 
 /* 获取状态信息 */
 void printf_get_status(uint16_t *pending_chars, uint8_t *is_transmitting) {
-#if PRINTF_USE_FREERTOS
-  if (take_mutex_safe(pdMS_TO_TICKS(10)) == pdTRUE) {
-    *pending_chars = write_index;
-    *is_transmitting = dma_busy;
-    give_mutex_safe();
-  } else {
-    *pending_chars = 0;
-    *is_transmitting = 0;
-  }
-#else
-  take_mutex_safe(0);
-  *pending_chars = write_index;
+  *pending_chars = tx_used();
   *is_transmitting = dma_busy;
-  give_mutex_safe();
-#endif
 }
 
-/* 写字符串接口 */
-void printf_write_string(const char *str) {
-  if (str == NULL || printf_uart_handle == NULL) {
-    return;
+/* 块写入接口：整段只加一次锁，按环形缓冲区剩余空间分块memcpy */
+size_t printf_write(const void *data, size_t len) {
+  const char *src = (const char *)data;
+  size_t done = 0;
+
+  if (src == NULL || len == 0 || printf_uart_handle == NULL) {
+    return 0;
   }
 
 #if PRINTF_USE_FREERTOS
   if (is_in_isr()) {
-    return;
+    return 0;
   }
 
   if (take_mutex_safe(PRINTF_MUTEX_TIMEOUT) != pdTRUE) {
-    return;
+    return 0;
   }
 #else
   take_mutex_safe(0);
 #endif
 
-  uint16_t len = strlen(str);
-  uint16_t i = 0;
-
-  while (i < len) {
-    uint16_t available = PRINTF_BUFFER_SIZE - 1 - write_index;
-    uint16_t to_write = (len - i) < available ? (len - i) : available;
+  while (done < len) {
+    uint16_t available = tx_free();
+    size_t to_write = (len - done) < available ? (len - done) : available;
 
     if (to_write == 0) {
-      if (dma_busy) {
-        buffer_switch_pending = 1;
-        give_mutex_safe();
-
-#if PRINTF_USE_FREERTOS
-        while (buffer_switch_pending) {
-          vTaskDelay(pdMS_TO_TICKS(1));
-        }
-
-        if (take_mutex_safe(PRINTF_MUTEX_TIMEOUT) != pdTRUE) {
-          return;
-        }
-#else
-        while (buffer_switch_pending) {
-          HAL_Delay(1);
-        }
-        take_mutex_safe(0);
-#endif
-        continue;
-      } else {
-        switch_buffer();
-        start_dma_transmission();
-        continue;
+      /* 缓冲区已满：确保DMA在发送，等待发送完成回调释放空间 */
+      kick_transmission();
+      if (!wait_tx_event()) {
+        break;
       }
+      continue;
     }
 
-    memcpy((char *)current_write_buffer + write_index, str + i, to_write);
-    write_index += to_write;
-    i += to_write;
-
-    if (write_index >= PRINTF_BUFFER_SIZE - 10) {
-      if (!dma_busy) {
-        switch_buffer();
-        start_dma_transmission();
-      } else {
-        buffer_switch_pending = 1;
-      }
-    }
+    tx_copy_in(src + done, (uint16_t)to_write);
+    done += to_write;
   }
 
+  /* 整块写完后启动一次发送 (相当于fputc遇到换行时的行为) */
+  kick_transmission();
+
   give_mutex_safe();
+
+  return done;
+}
+
+/* 写字符串接口 */
+void printf_write_string(const char *str) {
+  if (str == NULL) {
+    return;
+  }
+
+  printf_write(str, strlen(str));
 }
 
+#if defined(__GNUC__) && !defined(__CC_ARM)
+/* GCC/newlib: printf/fwrite 经 _write 整块输出，不再逐字节调用 fputc */
+int _write(int fd, char *ptr, int len) {
+  (void)fd;
+  return (int)printf_write(ptr, (size_t)len);
+}
+#endif
+
 /* 初始化函数 */
 void printf_init(UART_HandleTypeDef *huart) {
   printf_set_uart_handle(huart);
 #if PRINTF_USE_FREERTOS
-  /* 创建静态互斥锁 */
+  /* 创建静态互斥锁和发送完成信号量 */
   printf_mutex = xSemaphoreCreateMutexStatic(&printf_mutex_buffer);
-  if (printf_mutex == NULL) {
+  printf_tx_sem = xSemaphoreCreateBinaryStatic(&printf_tx_sem_buffer);
+  TaskPlan_WatchMutex(printf_mutex, "printf", 20); // 发送缓冲区满时等待 DMA
+  if (printf_mutex == NULL || printf_tx_sem == NULL) {
     HAL_UART_Transmit(huart, (uint8_t *)"Mutex Create Failed\r\n", 21, 1000);
   }
 #endif
 
-  /* 初始化缓冲区指针和状态 */
-  current_write_buffer = printf_buffer_a;
-  current_dma_buffer = printf_buffer_b;
-  write_index = 0;
+  /* 初始化环形缓冲区状态 */
+  tx_head = 0;
+  tx_tail = 0;
   dma_length = 0;
   dma_busy = 0;
-  buffer_switch_pending = 0;
-
-  /* 清空缓冲区 */
-  memset(printf_buffer_a, 0, PRINTF_BUFFER_SIZE);
-  memset(printf_buffer_b, 0, PRINTF_BUFFER_SIZE);
+  tx_waiting = 0;
 }
 
 #if PRINTF_USE_FREERTOS
@@ -15,15 +15,17 @@ extern "C" {
 #endif
 
 #include "main.h"
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 
 
 /* 配置参数 - 可根据项目需要修改 */
-#define PRINTF_BUFFER_SIZE 512
+#define PRINTF_BUFFER_SIZE 2048 // 环形发送缓冲区大小
 #define PRINTF_MUTEX_TIMEOUT_MS 100
 #define PRINTF_USE_FREERTOS 1 // 是否使用FreeRTOS
 #define PRINTF_USE_DMA 1      // 是否使用DMA
+#define PRINTF_BAUD_DRAIN_MS 500 // 修改波特率前等待缓冲区发完的最长时间
 
 /* 如果使用FreeRTOS */
 #if PRINTF_USE_FREERTOS
@@ -39,10 +41,27 @@ void printf_flush(void);
 uint8_t printf_is_busy(void);
 void printf_get_status(uint16_t *pending_chars, uint8_t *is_transmitting);
 void printf_write_string(const char *str);
+/* 块写入：整段只加一次锁并整块拷贝，返回实际写入的字节数 (中断中不可用)。
+ * MicroLIB 的 printf/fwrite 只能逐字节经过 fputc，大段输出应先格式化
+ * 再调用本函数；GCC/newlib 下 _write 已转发到这里。 */
+size_t printf_write(const void *data, size_t len);
 int fputc_nb(int ch, FILE *f);
 
+/* 发送通道：启动发送环形缓冲区中的一个连续区段，data 在完成前保持有效，
+ * 返回 0 表示无法启动 (数据留在缓冲区)。完成或放弃时通道在中断中调用
+ * printf_tx_channel_done 并给出已发出的字节数，未发出的部分由下一段重发 */
+typedef uint8_t (*printf_tx_start_t)(const uint8_t *data, uint16_t len);
+
+/* 切换发送通道 (NULL 恢复 UART)，正在发送的区段完成后生效。
+ * 任务与中断中均可调用 */
+void printf_set_tx_channel(printf_tx_start_t start);
+void printf_tx_channel_done(uint16_t sent);
+
 /* 辅助函数 - 可动态设置UART句柄 */
 void printf_set_uart_handle(UART_HandleTypeDef *huart);
+/* 运行中修改波特率：缓冲区中的数据按原波特率发完后才切换，不丢数据，
+ * 也不打断共用串口的接收 DMA。成功返回 1 (中断中不可用) */
+uint8_t printf_set_baudrate(uint32_t baudrate);
 
 /* 回调函数 */
 void printf_uart_tx_complete_callback(UART_HandleTypeDef *huart);
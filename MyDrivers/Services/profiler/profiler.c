@@ -0,0 +1,122 @@
+/**
+ ******************************************************************************
+ * @file    profiler.c
+ * @brief   DWT 周期计数器性能剖析源文件
+ * @details 区段可能同时被多个任务和中断更新 (如 log_write)，统计值的
+ *          读改写在关中断的几十个周期内完成，不影响被测代码的时序。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "profiler.h"
+#include <string.h>
+
+#define LOG_MODULE "PROF"
+#include "log.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+static const char *const g_prof_names[PROF_ZONE_MAX] = {
+    "lv_handler", "disp_flush", "touch_read",  "sensor_update",
+    "read_gy30",  "read_sht30", "read_smoke", "log_write"};
+
+static prof_stat_t g_prof_stats[PROF_ZONE_MAX];
+static uint32_t g_prof_window_start = 0; // 统计窗口起点 (ms)
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 记录一次测量
+ */
+void prof_record(prof_zone_t zone, uint32_t start) {
+  uint32_t cycles = prof_now() - start;
+  prof_stat_t *s;
+  uint32_t primask;
+
+  if ((unsigned)zone >= PROF_ZONE_MAX)
+    return;
+  s = &g_prof_stats[zone];
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (s->count == 0 || cycles < s->min)
+    s->min = cycles;
+  if (cycles > s->max)
+    s->max = cycles;
+  s->sum += cycles;
+  s->count++;
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 获取区段统计值的一致拷贝
+ */
+bool prof_get(prof_zone_t zone, prof_stat_t *out) {
+  uint32_t primask;
+
+  if ((unsigned)zone >= PROF_ZONE_MAX || out == NULL)
+    return false;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  *out = g_prof_stats[zone];
+  __set_PRIMASK(primask);
+  return true;
+}
+
+/**
+ * @brief 清空所有区段
+ */
+void prof_reset(void) {
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  memset(g_prof_stats, 0, sizeof(g_prof_stats));
+  __set_PRIMASK(primask);
+  g_prof_window_start = HAL_GetTick();
+}
+
+/**
+ * @brief 通过日志输出所有有数据的区段
+ */
+void prof_dump(bool reset) {
+  prof_stat_t snap[PROF_ZONE_MAX];
+  uint32_t primask;
+  uint32_t window_ms = HAL_GetTick() - g_prof_window_start;
+  uint32_t cycles_per_us = SystemCoreClock / 1000000u;
+
+  // 先整体拷贝再格式化，避免 log_write 自身的测量混入正在输出的数据
+  primask = __get_PRIMASK();
+  __disable_irq();
+  memcpy(snap, g_prof_stats, sizeof(snap));
+  if (reset)
+    memset(g_prof_stats, 0, sizeof(g_prof_stats));
+  __set_PRIMASK(primask);
+  if (reset)
+    g_prof_window_start = HAL_GetTick();
+
+  LOG_INFO("window %lu ms, unit us (min / mean / max), share of CPU",
+           (unsigned long)window_ms);
+
+  for (uint32_t i = 0; i < PROF_ZONE_MAX; i++) {
+    const prof_stat_t *s = &snap[i];
+    if (s->count == 0)
+      continue;
+
+    // 以 0.01 us 为单位，便于整数格式化
+    uint32_t min_c = (uint32_t)((uint64_t)s->min * 100u / cycles_per_us);
+    uint32_t max_c = (uint32_t)((uint64_t)s->max * 100u / cycles_per_us);
+    uint32_t mean_c =
+        (uint32_t)(s->sum * 100u / ((uint64_t)s->count * cycles_per_us));
+    // 区段总耗时占窗口的比例 (0.1%)
+    uint64_t window_cycles = (uint64_t)window_ms * cycles_per_us * 1000u;
+    uint32_t share =
+        window_cycles ? (uint32_t)(s->sum * 1000u / window_cycles) : 0;
+
+    LOG_INFO("  %-13s n=%-6lu %lu.%02lu / %lu.%02lu / %lu.%02lu  %lu.%lu%%",
+             g_prof_names[i], (unsigned long)s->count,
+             (unsigned long)(min_c / 100), (unsigned long)(min_c % 100),
+             (unsigned long)(mean_c / 100), (unsigned long)(mean_c % 100),
+             (unsigned long)(max_c / 100), (unsigned long)(max_c % 100),
+             (unsigned long)(share / 10), (unsigned long)(share % 10));
+  }
+}
@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ * @file    profiler.h
+ * @brief   DWT 周期计数器性能剖析头文件
+ * @details 以 CPU 周期 (168 MHz 下约 6 ns) 为单位测量热点代码段的执行时间，
+ *          每个区段在静态表中累计 次数/最小/最大/总和，定期通过日志输出。
+ *          计数器由 configureTimerForRunTimeStats 在调度器启动时开启，
+ *          单次测量不能超过 32 位回绕周期 (约 25 s)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __PROFILER_H
+#define __PROFILER_H
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define PROF_ENABLE 1                // 0: 所有剖析宏编译为空
+#define PROF_DUMP_PERIOD_MS 30000    // SystemMonitorTask 定期输出的周期
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 剖析区段 (与 profiler.c 中的名称表一一对应)
+ */
+typedef enum {
+  PROF_ZONE_LV_HANDLER = 0, // lv_task_handler 一次调用
+  PROF_ZONE_DISP_FLUSH,     // disp_flush 调用到 DMA 传输完成
+  PROF_ZONE_TOUCH_READ,     // touchpad_read
+  PROF_ZONE_SENSOR_UPDATE,  // SensorTask_UpdateSensor (含记录历史/统计)
+  PROF_ZONE_READ_GY30,      // 各传感器 read_func，顺序与 SensorType_t 一致
+  PROF_ZONE_READ_SHT30,
+  PROF_ZONE_READ_SMOKE,
+  PROF_ZONE_LOG_WRITE, // log_write (格式化并入队)
+  PROF_ZONE_MAX
+} prof_zone_t;
+
+/**
+ * @brief 单个区段的统计值 (单位: CPU 周期)
+ */
+typedef struct {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+} prof_stat_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 读取当前周期计数
+ */
+static inline uint32_t prof_now(void) { return DWT->CYCCNT; }
+
+/**
+ * @brief 记录一次测量 (任务与中断中均可调用)
+ * @param zone  区段
+ * @param start 起始时刻 (prof_now 的返回值)
+ */
+void prof_record(prof_zone_t zone, uint32_t start);
+
+/**
+ * @brief 获取区段统计值的一致拷贝
+ * @return true: 成功, false: 区段无效
+ */
+bool prof_get(prof_zone_t zone, prof_stat_t *out);
+
+/**
+ * @brief 清空所有区段，开始新的统计窗口
+ */
+void prof_reset(void);
+
+/**
+ * @brief 通过日志输出所有有数据的区段 (微秒，保留两位小数) 及其时间占比
+ * @param reset 输出后是否清空，开始新的统计窗口
+ */
+void prof_dump(bool reset);
+
+/* --------------------------- 剖析宏 --------------------------- */
+#if PROF_ENABLE
+// 同一作用域内成对使用: PROF_BEGIN(PROF_ZONE_X); ... PROF_END(PROF_ZONE_X);
+#define PROF_BEGIN(zone) uint32_t prof_t0_##zone = prof_now()
+#define PROF_END(zone) prof_record(zone, prof_t0_##zone)
+// 区段由运行时计算或起止点不在同一函数时使用
+#define PROF_NOW() prof_now()
+#define PROF_RECORD(zone, start) prof_record((zone), (start))
+#else
+#define PROF_BEGIN(zone) ((void)0)
+#define PROF_END(zone) ((void)0)
+#define PROF_NOW() 0u
+#define PROF_RECORD(zone, start) ((void)(start))
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __PROFILER_H */
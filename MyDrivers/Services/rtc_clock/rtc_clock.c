@@ -0,0 +1,537 @@
+/**
+ ******************************************************************************
+ * @file    rtc_clock.c
+ * @brief   RTC 墙上时钟源文件
+ * @details 唤醒定时器以 ck_spre (1 Hz) 为时钟、重装值 0，与日历秒同步触发。
+ *          中断中读取日历并缓存为 Unix 秒，RtcClock_Now 只读缓存，不访问
+ *          影子寄存器，任务间无需加锁。影子寄存器在秒进位后约 2 个 RTCCLK
+ *          才更新，中断中可能读到上一秒，因此缓存值至少比上次加 1。
+ *          备份寄存器 BKP0R 保存初始化标记，BKP1R 记录时间是否被设置过，
+ *          BKP8R 保存频率修正量 (BKP2R~BKP7R 由 task_wdt 使用)。
+ *          中断同时记下该秒开始时的单调时钟 s_tick_us，秒内的毫秒由两者
+ *          插值得到，校时时参考时间也经它换算到 RTC 时间上比较。
+ *          平滑调整：校准量 = 频率修正 ± RTC_CLOCK_SLEW_PPM，RTC 每秒多走
+ *          或少走约 RTC_CLOCK_SLEW_PPM us，中断中每秒扣减剩余偏差，扣完后
+ *          校准量恢复为频率修正。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "rtc_clock.h"
+#include "main.h"
+#include "sys_clock.h"
+#include <string.h>
+
+#define LOG_MODULE "RTC"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define RTC_CLOCK_MAGIC 0x32F2U      // BKP0R: 日历已初始化
+#define RTC_CLOCK_SET_FLAG 0x5A5AU   // BKP1R: 时间已被设置
+#define RTC_CLOCK_TIMEOUT_MS 1000    // 进入初始化模式 / 同步的超时
+#define RTC_CLOCK_ASYNC_PREDIV 127   // 32.768 kHz / 128 = 256 Hz
+#define RTC_CLOCK_SYNC_PREDIV_LSE 255
+#define RTC_CLOCK_SYNC_PREDIV_LSI 249 // LSI 约 32 kHz
+#define RTC_CLOCK_DEFAULT_YEAR 2025   // 首次上电的默认日期
+#define RTC_CLOCK_TRIM_MAGIC 0x7C1AU  // BKP8R 高 16 位: 低 16 位为频率修正量
+#define RTC_CLOCK_CAL_MAX_PPM 487     // 平滑校准的范围 (CALM 511 / 2^20)
+
+#define BCD2BIN(v) ((uint8_t)((((v) >> 4) & 0x0F) * 10 + ((v) & 0x0F)))
+#define BIN2BCD(v) ((uint32_t)((((v) / 10) << 4) | ((v) % 10)))
+
+/* --------------------------- 私有变量 --------------------------- */
+static volatile uint32_t s_now;  // 缓存的本地 Unix 秒
+static volatile uint64_t s_tick_us; // s_now 开始时的单调时钟 (us)
+static bool s_running;
+static bool s_lse;
+static RtcClockSecondCb_t s_subscribers[RTC_CLOCK_MAX_SUBSCRIBERS];
+
+/* 校时 (s_slew_us 与 s_cal_dirty 由中断与校时共同访问，校时时屏蔽唤醒中断) */
+static int32_t s_slew_us;        // 尚未消除的偏差 (参考时间 - RTC)
+static int16_t s_slew_rate;      // 平滑调整的实际速率 (us/s，符号同 s_slew_us)
+static int16_t s_trim_ppm;       // 频率修正量
+static bool s_cal_dirty;         // 校准寄存器待写入 (上次写入时上一次仍未生效)
+static bool s_sync_valid;        // s_sync_t / s_sync_us 可用于估计频率误差
+static uint64_t s_sync_us;       // 上次校时的单调时钟
+static RtcClockSyncStats_t s_sync;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static void rtc_clock_unlock(void) {
+  RTC->WPR = 0xCA;
+  RTC->WPR = 0x53;
+}
+
+static void rtc_clock_lock(void) { RTC->WPR = 0xFF; }
+
+static bool rtc_clock_wait(volatile uint32_t *reg, uint32_t mask) {
+  uint32_t start = HAL_GetTick();
+
+  while ((*reg & mask) == 0) {
+    if (HAL_GetTick() - start > RTC_CLOCK_TIMEOUT_MS) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 等待影子寄存器与日历同步 (须已解除写保护)
+ */
+static bool rtc_clock_wait_sync(void) {
+  RTC->ISR &= ~(RTC_ISR_INIT | RTC_ISR_RSF);
+  return rtc_clock_wait(&RTC->ISR, RTC_ISR_RSF);
+}
+
+/**
+ * @brief 启动 RTC 时钟源：优先 LSE，失败时退回 LSI
+ */
+static bool rtc_clock_start_source(void) {
+  RCC_OscInitTypeDef osc = {0};
+  RCC_PeriphCLKInitTypeDef clk = {0};
+
+  osc.OscillatorType = RCC_OSCILLATORTYPE_LSE;
+  osc.LSEState = RCC_LSE_ON;
+  osc.PLL.PLLState = RCC_PLL_NONE;
+  s_lse = (HAL_RCC_OscConfig(&osc) == HAL_OK);
+  if (!s_lse) {
+    osc.OscillatorType = RCC_OSCILLATORTYPE_LSI;
+    osc.LSIState = RCC_LSI_ON;
+    if (HAL_RCC_OscConfig(&osc) != HAL_OK) {
+      return false;
+    }
+  }
+
+  clk.PeriphClockSelection = RCC_PERIPHCLK_RTC;
+  clk.RTCClockSelection = s_lse ? RCC_RTCCLKSOURCE_LSE : RCC_RTCCLKSOURCE_LSI;
+  if (HAL_RCCEx_PeriphCLKConfig(&clk) != HAL_OK) {
+    return false;
+  }
+  __HAL_RCC_RTC_ENABLE();
+  return true;
+}
+
+/**
+ * @brief 写入日历 (及分频系数)
+ * @param prer 分频寄存器值，0 表示不修改
+ */
+static bool rtc_clock_write_calendar(uint32_t tr, uint32_t dr, uint32_t prer) {
+  bool ok;
+
+  rtc_clock_unlock();
+  RTC->ISR |= RTC_ISR_INIT;
+  ok = rtc_clock_wait(&RTC->ISR, RTC_ISR_INITF);
+  if (ok) {
+    if (prer != 0) {
+      // 同步与异步分频须分两次写入
+      RTC->PRER = prer & RTC_PRER_PREDIV_S;
+      RTC->PRER = prer;
+    }
+    RTC->TR = tr;
+    RTC->DR = dr;
+    RTC->CR &= ~RTC_CR_FMT; // 24 小时制
+    RTC->ISR &= ~RTC_ISR_INIT;
+    ok = rtc_clock_wait_sync();
+  }
+  rtc_clock_lock();
+  return ok;
+}
+
+static void rtc_clock_encode(const RtcDateTime_t *dt, uint32_t *tr,
+                             uint32_t *dr) {
+  *tr = (BIN2BCD(dt->hour) << 16) | (BIN2BCD(dt->minute) << 8) |
+        BIN2BCD(dt->second);
+  *dr = (BIN2BCD(dt->year - 2000) << 16) | ((uint32_t)dt->weekday << 13) |
+        (BIN2BCD(dt->month) << 8) | BIN2BCD(dt->day);
+}
+
+/**
+ * @brief 读取日历 (先读 TR 锁存影子寄存器，读 DR 后解锁)
+ */
+static uint32_t rtc_clock_read(void) {
+  uint32_t tr = RTC->TR;
+  uint32_t dr = RTC->DR;
+  RtcDateTime_t dt;
+
+  dt.year = (uint16_t)(2000 + BCD2BIN((dr >> 16) & 0xFF));
+  dt.month = BCD2BIN((dr >> 8) & 0x1F);
+  dt.day = BCD2BIN(dr & 0x3F);
+  dt.weekday = (uint8_t)((dr >> 13) & 0x07);
+  dt.hour = BCD2BIN((tr >> 16) & 0x3F);
+  dt.minute = BCD2BIN((tr >> 8) & 0x7F);
+  dt.second = BCD2BIN(tr & 0x7F);
+  return RtcClock_FromDateTime(&dt);
+}
+
+/**
+ * @brief 配置 1 Hz 唤醒中断 (EXTI22)
+ */
+static bool rtc_clock_start_wakeup(void) {
+  bool ok;
+
+  rtc_clock_unlock();
+  RTC->CR &= ~(RTC_CR_WUTE | RTC_CR_WUTIE);
+  ok = rtc_clock_wait(&RTC->ISR, RTC_ISR_WUTWF);
+  if (ok) {
+    RTC->WUTR = 0; // (0 + 1) 个 ck_spre 周期
+    RTC->CR = (RTC->CR & ~RTC_CR_WUCKSEL) | RTC_CR_WUCKSEL_2;
+    RTC->ISR &= ~(RTC_ISR_WUTF | RTC_ISR_INIT);
+    RTC->CR |= RTC_CR_WUTIE | RTC_CR_WUTE;
+  }
+  rtc_clock_lock();
+  if (!ok) {
+    return false;
+  }
+
+  EXTI->IMR |= EXTI_IMR_MR22;
+  EXTI->RTSR |= EXTI_RTSR_TR22;
+  EXTI->PR = EXTI_PR_PR22;
+  HAL_NVIC_SetPriority(RTC_WKUP_IRQn, RTC_CLOCK_IRQ_PRIORITY, 0);
+  HAL_NVIC_EnableIRQ(RTC_WKUP_IRQn);
+  return true;
+}
+
+/**
+ * @brief 写入平滑校准寄存器：频率修正 + 正在进行的平滑调整
+ * @return false: 上一次写入尚未生效，稍后重试
+ */
+static bool rtc_clock_apply_cal(void) {
+  int32_t ppm = s_trim_ppm;
+  int32_t pulses;
+
+  if (s_slew_us != 0) {
+    ppm += s_slew_us > 0 ? RTC_CLOCK_SLEW_PPM : -RTC_CLOCK_SLEW_PPM;
+    if (ppm > RTC_CLOCK_CAL_MAX_PPM) {
+      ppm = RTC_CLOCK_CAL_MAX_PPM;
+    } else if (ppm < -RTC_CLOCK_CAL_MAX_PPM) {
+      ppm = -RTC_CLOCK_CAL_MAX_PPM;
+    }
+  }
+  s_slew_rate = (int16_t)(ppm - s_trim_ppm);
+
+  if (RTC->ISR & RTC_ISR_RECALPF) {
+    s_cal_dirty = true;
+    return false;
+  }
+  /* 每 2^20 个 RTCCLK 加 512 个 (CALP) 减 CALM 个脉冲 */
+  pulses = ppm * 1048576 / 1000000;
+  rtc_clock_unlock();
+  RTC->CALR = pulses > 0 ? RTC_CALR_CALP | (uint32_t)(512 - pulses)
+                         : (uint32_t)(-pulses);
+  rtc_clock_lock();
+  s_cal_dirty = false;
+  return true;
+}
+
+/**
+ * @brief 单调时钟 at_us 时刻的 RTC 时间 (本地 Unix 微秒)
+ */
+static int64_t rtc_clock_micros_at(uint64_t at_us) {
+  uint32_t primask = __get_PRIMASK();
+  uint32_t now;
+  uint64_t tick_us;
+
+  __disable_irq();
+  now = s_now;
+  tick_us = s_tick_us;
+  __set_PRIMASK(primask);
+
+  return (int64_t)now * 1000000 + (int64_t)(at_us - tick_us);
+}
+
+/**
+ * @brief 偏差过大：直接设置日历，不足一秒的部分再平滑调整
+ */
+static bool rtc_clock_step(uint32_t t, uint64_t at_us) {
+  uint64_t now_us = SysClock_Micros();
+  RtcDateTime_t dt;
+
+  // 设为参考时间推算的当前整秒 (写入时分频器从 0 开始)，不足一秒的部分
+  // 在返回后作为剩余偏差平滑调整
+  RtcClock_ToDateTime(t + (uint32_t)((now_us - at_us) / 1000000U), &dt);
+  if (!RtcClock_Set(&dt)) {
+    return false;
+  }
+  s_sync.steps++;
+  s_sync_valid = false; // 跨越直接设置无法估计频率误差
+  return true;
+}
+
+/* 距 1970-01-01 的天数 (公历，见 H. Hinnant 的 days_from_civil) */
+static uint32_t rtc_clock_days_from_civil(uint32_t y, uint32_t m, uint32_t d) {
+  uint32_t era, yoe, doy, doe;
+
+  y -= (m <= 2);
+  era = y / 400;
+  yoe = y - era * 400;
+  doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+  doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 启动 RTC 与每秒唤醒中断
+ */
+bool RtcClock_Init(void) {
+  __HAL_RCC_PWR_CLK_ENABLE();
+  HAL_PWR_EnableBkUpAccess();
+
+  if ((RCC->BDCR & RCC_BDCR_RTCEN) && RTC->BKP0R == RTC_CLOCK_MAGIC) {
+    // 备份域保持供电，RTC 一直在走时
+    s_lse = (RCC->BDCR & RCC_BDCR_RTCSEL) == RCC_RTCCLKSOURCE_LSE;
+    rtc_clock_unlock();
+    rtc_clock_wait_sync();
+    rtc_clock_lock();
+  } else {
+    RtcDateTime_t dt = {RTC_CLOCK_DEFAULT_YEAR, 1, 1, 0, 0, 0, 0};
+    uint32_t tr, dr;
+
+    if (!rtc_clock_start_source()) {
+      LOG_ERROR("RTC 时钟源启动失败");
+      return false;
+    }
+    RtcClock_ToDateTime(RtcClock_FromDateTime(&dt), &dt); // 计算星期
+    rtc_clock_encode(&dt, &tr, &dr);
+    if (!rtc_clock_write_calendar(
+            tr, dr,
+            ((uint32_t)RTC_CLOCK_ASYNC_PREDIV << 16) |
+                (s_lse ? RTC_CLOCK_SYNC_PREDIV_LSE
+                       : RTC_CLOCK_SYNC_PREDIV_LSI))) {
+      LOG_ERROR("RTC 日历初始化超时");
+      return false;
+    }
+    RTC->BKP0R = RTC_CLOCK_MAGIC;
+    RTC->BKP1R = 0;
+  }
+
+  s_now = rtc_clock_read();
+  s_tick_us = SysClock_Micros();
+  if ((RTC->BKP8R >> 16) == RTC_CLOCK_TRIM_MAGIC) {
+    s_trim_ppm = (int16_t)(RTC->BKP8R & 0xFFFFU);
+  }
+  (void)rtc_clock_apply_cal();
+  if (!rtc_clock_start_wakeup()) {
+    LOG_ERROR("RTC 唤醒定时器配置超时");
+    return false;
+  }
+  s_running = true;
+
+  if (!s_lse) {
+    LOG_WARN("LSE 未起振，RTC 使用 LSI (走时误差较大)");
+  }
+  LOG_INFO("RTC 已启动 (%s)%s", s_lse ? "LSE" : "LSI",
+           RtcClock_IsSet() ? "" : "，时间未设置");
+  return true;
+}
+
+/**
+ * @brief 订阅每秒事件
+ */
+bool RtcClock_Subscribe(RtcClockSecondCb_t cb) {
+  for (int i = 0; i < RTC_CLOCK_MAX_SUBSCRIBERS; i++) {
+    if (s_subscribers[i] == NULL || s_subscribers[i] == cb) {
+      s_subscribers[i] = cb;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 当前本地 Unix 秒
+ */
+uint32_t RtcClock_Now(void) { return s_now; }
+
+/**
+ * @brief 当前本地 Unix 毫秒
+ */
+uint64_t RtcClock_NowMillis(void) {
+  int64_t us;
+  uint64_t ms;
+
+  if (!s_running) {
+    return 0;
+  }
+  us = rtc_clock_micros_at(SysClock_Micros());
+  ms = (uint64_t)us / 1000U;
+  if (ms >= (uint64_t)s_now * 1000U + 1000U) {
+    ms = (uint64_t)s_now * 1000U + 999U; // 唤醒中断延迟：不超过当前秒
+  }
+  return ms;
+}
+
+/**
+ * @brief 时间是否已被设置过
+ */
+bool RtcClock_IsSet(void) {
+  return s_running && RTC->BKP1R == RTC_CLOCK_SET_FLAG;
+}
+
+/**
+ * @brief 设置日历时间
+ */
+bool RtcClock_Set(const RtcDateTime_t *dt) {
+  RtcDateTime_t norm;
+  uint32_t tr, dr;
+  uint32_t t;
+  bool ok;
+
+  if (!s_running || dt == NULL || dt->year < 2000 || dt->year > 2099 ||
+      dt->month < 1 || dt->month > 12 || dt->day < 1 || dt->day > 31 ||
+      dt->hour > 23 || dt->minute > 59 || dt->second > 59) {
+    return false;
+  }
+  t = RtcClock_FromDateTime(dt);
+  RtcClock_ToDateTime(t, &norm);
+  if (norm.day != dt->day) {
+    return false; // 如 2 月 30 日
+  }
+  rtc_clock_encode(&norm, &tr, &dr);
+
+  // 写入期间屏蔽唤醒中断，避免中断读到初始化模式下的日历
+  HAL_NVIC_DisableIRQ(RTC_WKUP_IRQn);
+  ok = rtc_clock_write_calendar(tr, dr, 0);
+  if (ok) {
+    s_now = t;
+    s_tick_us = SysClock_Micros();
+    RTC->BKP1R = RTC_CLOCK_SET_FLAG;
+  }
+  HAL_NVIC_EnableIRQ(RTC_WKUP_IRQn);
+
+  if (ok) {
+    LOG_INFO("时间设置为 %04u-%02u-%02u %02u:%02u:%02u", norm.year, norm.month,
+             norm.day, norm.hour, norm.minute, norm.second);
+  }
+  return ok;
+}
+
+/**
+ * @brief 按外部参考时间校时
+ */
+bool RtcClock_Sync(uint32_t t, uint64_t at_us) {
+  int64_t offset_us;
+  int32_t trim;
+
+  if (!s_running) {
+    return false;
+  }
+  offset_us = (int64_t)t * 1000000 - rtc_clock_micros_at(at_us);
+  s_sync.syncs++;
+  s_sync.last_sync = t;
+  s_sync.last_offset_ms = (int32_t)(offset_us / 1000);
+
+  if (!RtcClock_IsSet() || offset_us > RTC_CLOCK_SLEW_MAX_MS * 1000LL ||
+      offset_us < -RTC_CLOCK_SLEW_MAX_MS * 1000LL) {
+    if (!rtc_clock_step(t, at_us)) {
+      return false;
+    }
+    offset_us = (int64_t)t * 1000000 - rtc_clock_micros_at(at_us);
+    if (offset_us > RTC_CLOCK_SLEW_MAX_MS * 1000LL ||
+        offset_us < -RTC_CLOCK_SLEW_MAX_MS * 1000LL) {
+      offset_us = 0; // 设置期间被长时间打断，下次校时再调整
+    }
+  } else if (s_sync_valid &&
+             at_us - s_sync_us >= RTC_CLOCK_TRIM_MIN_S * 1000000ULL) {
+    /* 上次的偏差中未消除的部分仍在 s_slew_us 中，其余新增的偏差来自频率误差 */
+    trim = s_trim_ppm +
+           (int32_t)((offset_us - s_slew_us) /
+                     (int64_t)((at_us - s_sync_us) / 1000000U) / 2);
+    if (trim > RTC_CLOCK_TRIM_MAX_PPM) {
+      trim = RTC_CLOCK_TRIM_MAX_PPM;
+    } else if (trim < -RTC_CLOCK_TRIM_MAX_PPM) {
+      trim = -RTC_CLOCK_TRIM_MAX_PPM;
+    }
+    s_trim_ppm = (int16_t)trim;
+    RTC->BKP8R = ((uint32_t)RTC_CLOCK_TRIM_MAGIC << 16) | (uint16_t)trim;
+  }
+  s_sync_valid = true;
+  s_sync_us = at_us;
+
+  HAL_NVIC_DisableIRQ(RTC_WKUP_IRQn);
+  s_slew_us = (int32_t)offset_us;
+  (void)rtc_clock_apply_cal();
+  HAL_NVIC_EnableIRQ(RTC_WKUP_IRQn);
+
+  LOG_DEBUG("校时: 偏差 %ld ms，频率修正 %d ppm",
+            (long)s_sync.last_offset_ms, (int)s_trim_ppm);
+  return true;
+}
+
+/**
+ * @brief 获取校时统计
+ */
+void RtcClock_GetSyncStats(RtcClockSyncStats_t *stats) {
+  *stats = s_sync;
+  stats->slew_ms = s_slew_us / 1000;
+  stats->trim_ppm = s_trim_ppm;
+}
+
+/**
+ * @brief 本地 Unix 秒 -> 日历时间 (见 H. Hinnant 的 civil_from_days)
+ */
+void RtcClock_ToDateTime(uint32_t t, RtcDateTime_t *dt) {
+  uint32_t days = t / 86400;
+  uint32_t sec = t % 86400;
+  uint32_t z = days + 719468;
+  uint32_t era = z / 146097;
+  uint32_t doe = z - era * 146097;
+  uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  uint32_t mp = (5 * doy + 2) / 153;
+  uint32_t m = mp < 10 ? mp + 3 : mp - 9;
+
+  dt->year = (uint16_t)(yoe + era * 400 + (m <= 2));
+  dt->month = (uint8_t)m;
+  dt->day = (uint8_t)(doy - (153 * mp + 2) / 5 + 1);
+  dt->hour = (uint8_t)(sec / 3600);
+  dt->minute = (uint8_t)(sec / 60 % 60);
+  dt->second = (uint8_t)(sec % 60);
+  dt->weekday = (uint8_t)((days + 3) % 7 + 1); // 1970-01-01 为周四
+}
+
+/**
+ * @brief 日历时间 -> 本地 Unix 秒
+ */
+uint32_t RtcClock_FromDateTime(const RtcDateTime_t *dt) {
+  return rtc_clock_days_from_civil(dt->year, dt->month, dt->day) * 86400U +
+         dt->hour * 3600U + dt->minute * 60U + dt->second;
+}
+
+/**
+ * @brief RTC 唤醒中断处理
+ */
+void RtcClock_IRQHandler(void) {
+  uint32_t now;
+
+  if (RTC->ISR & RTC_ISR_WUTF) {
+    RTC->ISR &= ~(RTC_ISR_WUTF | RTC_ISR_INIT);
+
+    now = rtc_clock_read();
+    if ((int32_t)(now - (s_now + 1)) < 0) {
+      now = s_now + 1; // 影子寄存器尚未更新
+    }
+    s_now = now;
+    s_tick_us = SysClock_Micros();
+
+    if (s_slew_us != 0) {
+      // 本秒 RTC 多走 (或少走) 了 s_slew_rate us
+      int32_t left = s_slew_us - s_slew_rate;
+
+      s_slew_us = ((left ^ s_slew_us) < 0) ? 0 : left;
+      if (s_slew_us == 0) {
+        s_cal_dirty = true;
+      }
+    }
+    if (s_cal_dirty) {
+      (void)rtc_clock_apply_cal();
+    }
+
+    for (int i = 0; i < RTC_CLOCK_MAX_SUBSCRIBERS && s_subscribers[i]; i++) {
+      s_subscribers[i](now);
+    }
+  }
+  EXTI->PR = EXTI_PR_PR22;
+}
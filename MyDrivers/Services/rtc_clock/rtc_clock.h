@@ -0,0 +1,142 @@
+/**
+ ******************************************************************************
+ * @file    rtc_clock.h
+ * @brief   RTC 墙上时钟头文件
+ * @details 使用片内 RTC (LSE 32.768 kHz 晶振，起振失败时退回 LSI) 提供
+ *          日历时间，并用唤醒定时器每秒产生一次中断，通知订阅者 (如界面
+ *          顶部栏的时钟)，订阅者无需轮询。
+ *          RTC 保存本地时间，对外以"本地 Unix 秒"表示 (不含时区换算)。
+ *          有 VBAT 供电时复位后 RTC 继续走时，不重新初始化日历。
+ *          外部参考时间 (如 SNTP) 通过 RtcClock_Sync 校时：偏差不超过
+ *          RTC_CLOCK_SLEW_MAX_MS 时用平滑校准 (RTC_CALR) 让 RTC 暂时走快或
+ *          走慢，逐渐消除偏差 (slew)，时间不跳变、不倒退；偏差更大或时间
+ *          未设置时直接设置 (step)。相邻两次校时还用来估计晶振的频率误差，
+ *          修正量保存在备份寄存器中，复位后继续生效。
+ *          本工程未包含 HAL RTC 驱动，寄存器直接访问。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __RTC_CLOCK_H
+#define __RTC_CLOCK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define RTC_CLOCK_MAX_SUBSCRIBERS 4 // 每秒事件的最大订阅者数
+#define RTC_CLOCK_IRQ_PRIORITY 5    // 唤醒中断优先级 (回调中可调用 FromISR API)
+#define RTC_CLOCK_SLEW_MAX_MS 1000  // 不超过该偏差时平滑调整，否则直接设置
+#define RTC_CLOCK_SLEW_PPM 400      // 平滑调整的速率 (1 s 偏差约 42 分钟消除)
+#define RTC_CLOCK_TRIM_MAX_PPM 80   // 频率修正量的上限
+#define RTC_CLOCK_TRIM_MIN_S 1800   // 两次校时相隔不少于该时间才估计频率误差
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 日历时间
+ */
+typedef struct {
+  uint16_t year;   // 2000 ~ 2099
+  uint8_t month;   // 1 ~ 12
+  uint8_t day;     // 1 ~ 31
+  uint8_t hour;    // 0 ~ 23
+  uint8_t minute;  // 0 ~ 59
+  uint8_t second;  // 0 ~ 59
+  uint8_t weekday; // 1 ~ 7 (周一 ~ 周日)
+} RtcDateTime_t;
+
+/**
+ * @brief 每秒事件回调 (在 RTC 唤醒中断中调用，只能做轻量工作)
+ * @param now 当前本地 Unix 秒
+ */
+typedef void (*RtcClockSecondCb_t)(uint32_t now);
+
+/**
+ * @brief 校时统计
+ */
+typedef struct {
+  uint32_t syncs;        // 校时次数
+  uint32_t steps;        // 其中直接设置的次数
+  uint32_t last_sync;    // 最近一次校时的参考时间 (本地 Unix 秒，0 为从未校时)
+  int32_t last_offset_ms; // 最近一次校时测得的偏差 (参考时间 - RTC)
+  int32_t slew_ms;       // 尚未消除的偏差
+  int16_t trim_ppm;      // 频率修正量 (正值为走快)
+} RtcClockSyncStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 启动 RTC 与每秒唤醒中断
+ * @return true: 成功 (LSE 起振失败时退回 LSI，走时误差较大并输出警告)
+ * @note  首次上电等待 LSE 起振最长 LSE_STARTUP_TIMEOUT
+ */
+bool RtcClock_Init(void);
+
+/**
+ * @brief 订阅每秒事件 (可在 RtcClock_Init 之前调用)
+ * @return false: 订阅者已满
+ */
+bool RtcClock_Subscribe(RtcClockSecondCb_t cb);
+
+/**
+ * @brief 当前本地 Unix 秒 (RTC 未启动时为 0)
+ */
+uint32_t RtcClock_Now(void);
+
+/**
+ * @brief 当前本地 Unix 毫秒 (秒内由单调时钟插值，平滑调整期间连续递增)
+ * @note  RTC 未启动时为 0
+ */
+uint64_t RtcClock_NowMillis(void);
+
+/**
+ * @brief 时间是否已被设置过 (否则为上电默认值)
+ */
+bool RtcClock_IsSet(void);
+
+/**
+ * @brief 设置日历时间 (星期由日期计算)
+ * @return false: RTC 未启动、参数超出范围或进入初始化模式超时
+ */
+bool RtcClock_Set(const RtcDateTime_t *dt);
+
+/**
+ * @brief 按外部参考时间校时
+ * @param t     参考时间 (本地 Unix 秒，整秒)
+ * @param at_us 该整秒时刻对应的 SysClock_Micros()
+ * @return false: RTC 未启动或设置失败
+ * @note  在任务中调用 (直接设置时会短暂屏蔽唤醒中断并等待 RTC 同步)
+ */
+bool RtcClock_Sync(uint32_t t, uint64_t at_us);
+
+/**
+ * @brief 获取校时统计
+ */
+void RtcClock_GetSyncStats(RtcClockSyncStats_t *stats);
+
+/**
+ * @brief 本地 Unix 秒 -> 日历时间
+ */
+void RtcClock_ToDateTime(uint32_t t, RtcDateTime_t *dt);
+
+/**
+ * @brief 日历时间 -> 本地 Unix 秒
+ */
+uint32_t RtcClock_FromDateTime(const RtcDateTime_t *dt);
+
+/**
+ * @brief RTC 唤醒中断处理 (在 RTC_WKUP_IRQHandler 中调用)
+ */
+void RtcClock_IRQHandler(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RTC_CLOCK_H */
@@ -0,0 +1,347 @@
+/**
+ ******************************************************************************
+ * @file    rtos_trace.c
+ * @brief   RTOS 事件跟踪实现
+ * @details 钩子可能在任意中断优先级、内核临界区中被调用，写入一个事件时
+ *          短暂关闭全部中断 (PRIMASK)，保证槽位领取、编号分配与时间戳
+ *          顺序一致。未记录时钩子只读一次标志即返回。
+ *          任务/队列编号以 RTOS_TRACE_TAG | 编号 的形式写入对象的
+ *          TaskNumber/QueueNumber 字段，并与名称表中的句柄核对：动态创建的
+ *          对象该字段未初始化，被删除后句柄又被新对象复用时也会重新分配。
+ *          编号表满后的对象统一记为编号 0。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "rtos_trace.h"
+#include "FreeRTOS.h"
+#include "checksum.h"
+#include "main.h"
+#include "mem_section.h"
+#include "printf_redirect.h"
+#include "queue.h"
+#include "task.h"
+#include <string.h>
+
+/* --------------------------- 私有宏 --------------------------- */
+#define RTOS_TRACE_TAG 0x7A000000UL
+#define RTOS_TRACE_TAG_MASK 0xFF000000UL
+#define RTOS_TRACE_NAME_LEN configMAX_TASK_NAME_LEN
+
+// 帧载荷: 公共头 (4) | 内容 | CRC (4)
+#define RTOS_TRACE_PAYLOAD_MAX (4 + RTOS_TRACE_FRAME_LEN * 8 + 4)
+
+/* --------------------------- 私有变量 --------------------------- */
+typedef struct {
+  uint32_t cycles;
+  uint8_t type;
+  uint8_t id;
+  uint16_t arg;
+} RtosTraceRecord_t;
+
+static CCM_RAM RtosTraceRecord_t s_events[RTOS_TRACE_EVENTS];
+static uint32_t s_head;  // 下一个写入的位置 (单调递增)
+static uint32_t s_count; // 缓冲区中的事件数
+static uint32_t s_lost;
+static volatile bool s_recording;
+static bool s_ring;
+
+static void *s_tasks[RTOS_TRACE_MAX_TASKS + 1]; // 下标即编号，0 不用
+static char s_task_names[RTOS_TRACE_MAX_TASKS + 1][RTOS_TRACE_NAME_LEN];
+static uint8_t s_task_count;
+static void *s_queues[RTOS_TRACE_MAX_QUEUES + 1];
+static uint8_t s_queue_count;
+
+static uint8_t s_payload[RTOS_TRACE_PAYLOAD_MAX];
+static uint8_t s_frame[COBS_ENCODED_MAX(RTOS_TRACE_PAYLOAD_MAX) + 2];
+static uint16_t s_seq;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/* 任务编号 (关中断时调用) */
+static uint8_t rtos_trace_task_id(void *tcb) {
+  UBaseType_t tag;
+  uint8_t id;
+
+  if (tcb == NULL) {
+    return 0;
+  }
+  tag = uxTaskGetTaskNumber((TaskHandle_t)tcb);
+  id = (uint8_t)(tag & 0xFFU);
+  if ((tag & RTOS_TRACE_TAG_MASK) == RTOS_TRACE_TAG && id != 0 &&
+      id <= s_task_count && s_tasks[id] == tcb) {
+    return id;
+  }
+  if (s_task_count >= RTOS_TRACE_MAX_TASKS) {
+    return 0;
+  }
+  id = ++s_task_count;
+  s_tasks[id] = tcb;
+  strncpy(s_task_names[id], pcTaskGetName((TaskHandle_t)tcb),
+          RTOS_TRACE_NAME_LEN - 1);
+  vTaskSetTaskNumber((TaskHandle_t)tcb, RTOS_TRACE_TAG | id);
+  return id;
+}
+
+/* 队列编号 (关中断时调用) */
+static uint8_t rtos_trace_queue_id(void *queue) {
+  UBaseType_t tag = uxQueueGetQueueNumber((QueueHandle_t)queue);
+  uint8_t id = (uint8_t)(tag & 0xFFU);
+
+  if ((tag & RTOS_TRACE_TAG_MASK) == RTOS_TRACE_TAG && id != 0 &&
+      id <= s_queue_count && s_queues[id] == queue) {
+    return id;
+  }
+  if (s_queue_count >= RTOS_TRACE_MAX_QUEUES) {
+    return 0;
+  }
+  id = ++s_queue_count;
+  s_queues[id] = queue;
+  vQueueSetQueueNumber((QueueHandle_t)queue, RTOS_TRACE_TAG | id);
+  return id;
+}
+
+/**
+ * @brief 领取一个槽位 (关中断时调用)
+ * @return NULL: 写满且不覆盖
+ */
+static RtosTraceRecord_t *rtos_trace_claim(void) {
+  RtosTraceRecord_t *ev;
+
+  if (s_count == RTOS_TRACE_EVENTS) {
+    s_lost++;
+    if (!s_ring) {
+      s_recording = false;
+      return NULL;
+    }
+  } else {
+    s_count++;
+  }
+  ev = &s_events[s_head & (RTOS_TRACE_EVENTS - 1)];
+  s_head++;
+  ev->cycles = DWT->CYCCNT;
+  return ev;
+}
+
+/* 记录一个事件；task/queue 非空时 id 取其编号 */
+static void rtos_trace_put(uint8_t type, void *task, void *queue, uint8_t id,
+                           uint16_t arg) {
+  RtosTraceRecord_t *ev;
+  uint32_t primask;
+
+  if (!s_recording) {
+    return;
+  }
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (s_recording) {
+    if (task != NULL) {
+      id = rtos_trace_task_id(task);
+    } else if (queue != NULL) {
+      id = rtos_trace_queue_id(queue);
+    }
+    ev = rtos_trace_claim();
+    if (ev != NULL) {
+      ev->type = type;
+      ev->id = id;
+      ev->arg = arg;
+    }
+  }
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 发送 s_payload 中的一帧
+ * @param len 载荷长度 (不含 CRC)
+ */
+static void rtos_trace_send(size_t len) {
+  uint32_t crc = CRC32_Compute(s_payload, len);
+  size_t n;
+
+  s_payload[len + 0] = (uint8_t)crc;
+  s_payload[len + 1] = (uint8_t)(crc >> 8);
+  s_payload[len + 2] = (uint8_t)(crc >> 16);
+  s_payload[len + 3] = (uint8_t)(crc >> 24);
+  s_frame[0] = 0x00;
+  n = COBS_Encode(s_payload, len + 4, s_frame + 1);
+  s_frame[n + 1] = 0x00;
+  printf_write(s_frame, n + 2);
+}
+
+/* 载荷公共头，返回内容起始位置 */
+static uint8_t *rtos_trace_begin(RtosTraceFrame_t kind) {
+  s_payload[0] = RTOS_TRACE_FRAME_TYPE;
+  s_payload[1] = (uint8_t)s_seq;
+  s_payload[2] = (uint8_t)(s_seq >> 8);
+  s_payload[3] = (uint8_t)kind;
+  s_seq++;
+  return s_payload + 4;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+  return p + 4;
+}
+
+/* 名称帧 */
+static void rtos_trace_send_name(uint8_t id, uint8_t kind, const char *name) {
+  uint8_t *p = rtos_trace_begin(RTOS_TRACE_FRAME_NAME);
+  size_t n = 0;
+
+  while (n < RTOS_TRACE_NAME_LEN && name[n] != '\0') {
+    n++;
+  }
+  *p++ = id;
+  *p++ = kind;
+  memcpy(p, name, n);
+  rtos_trace_send((size_t)(p + n - s_payload));
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 清空缓冲区并开始记录
+ */
+void RtosTrace_Start(bool ring) {
+#if RTOS_TRACE_ENABLE
+  taskENTER_CRITICAL();
+  s_head = 0;
+  s_count = 0;
+  s_lost = 0;
+  s_ring = ring;
+  s_recording = true;
+  taskEXIT_CRITICAL();
+  // 记录开始时正在运行的任务，主机据此画出第一段
+  rtos_trace_put(RTOS_TRACE_EV_TASK_IN, xTaskGetCurrentTaskHandle(), NULL, 0, 0);
+#else
+  (void)ring;
+#endif
+}
+
+/**
+ * @brief 停止记录
+ */
+void RtosTrace_Stop(void) { s_recording = false; }
+
+/**
+ * @brief 获取记录状态
+ */
+void RtosTrace_GetStatus(RtosTraceStatus_t *out) {
+  taskENTER_CRITICAL();
+  out->recording = s_recording;
+  out->ring = s_ring;
+  out->count = s_count;
+  out->lost = s_lost;
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 导出缓冲区
+ */
+uint32_t RtosTrace_Dump(void) {
+  uint32_t first = s_head - s_count;
+  uint32_t sent = 0;
+  uint8_t *p;
+
+  s_recording = false;
+  s_seq = 0;
+
+  p = rtos_trace_begin(RTOS_TRACE_FRAME_START);
+  p = put_u32(p, SystemCoreClock);
+  p = put_u32(p, s_count);
+  p = put_u32(p, s_lost);
+  rtos_trace_send((size_t)(p - s_payload));
+
+  for (uint8_t id = 1; id <= s_task_count; id++) {
+    rtos_trace_send_name(id, 0, s_task_names[id]);
+  }
+  for (uint8_t id = 1; id <= s_queue_count; id++) {
+    const char *name = pcQueueGetName((QueueHandle_t)s_queues[id]);
+
+    if (name != NULL) {
+      rtos_trace_send_name(id, 1, name);
+    }
+  }
+
+  while (sent < s_count) {
+    uint32_t n = s_count - sent;
+
+    if (n > RTOS_TRACE_FRAME_LEN) {
+      n = RTOS_TRACE_FRAME_LEN;
+    }
+    p = rtos_trace_begin(RTOS_TRACE_FRAME_EVENTS);
+    for (uint32_t i = 0; i < n; i++) {
+      const RtosTraceRecord_t *ev =
+          &s_events[(first + sent + i) & (RTOS_TRACE_EVENTS - 1)];
+
+      p = put_u32(p, ev->cycles);
+      *p++ = ev->type;
+      *p++ = ev->id;
+      *p++ = (uint8_t)ev->arg;
+      *p++ = (uint8_t)(ev->arg >> 8);
+    }
+    rtos_trace_send((size_t)(p - s_payload));
+    sent += n;
+  }
+
+  p = rtos_trace_begin(RTOS_TRACE_FRAME_END);
+  p = put_u32(p, sent);
+  rtos_trace_send((size_t)(p - s_payload));
+  return sent;
+}
+
+/**
+ * @brief 中断入口/出口
+ */
+void RtosTrace_IsrEnter(void) {
+  rtos_trace_put(RTOS_TRACE_EV_ISR_ENTER, NULL, NULL,
+                 (uint8_t)(__get_IPSR() & 0xFFU), 0);
+}
+
+void RtosTrace_IsrExit(void) {
+  rtos_trace_put(RTOS_TRACE_EV_ISR_EXIT, NULL, NULL,
+                 (uint8_t)(__get_IPSR() & 0xFFU), 0);
+}
+
+/**
+ * @brief 跟踪宏钩子
+ */
+void RtosTrace_TaskSwitchedIn(void *tcb) {
+  rtos_trace_put(RTOS_TRACE_EV_TASK_IN, tcb, NULL, 0, 0);
+}
+
+void RtosTrace_TaskReady(void *tcb) {
+  rtos_trace_put(RTOS_TRACE_EV_TASK_READY, tcb, NULL, 0, 0);
+}
+
+void RtosTrace_QueueSend(void *queue, int is_mutex) {
+  rtos_trace_put(is_mutex ? RTOS_TRACE_EV_MUTEX_GIVE : RTOS_TRACE_EV_QUEUE_SEND,
+                 NULL, queue, 0, 0);
+}
+
+void RtosTrace_QueueReceive(void *queue, int is_mutex) {
+  rtos_trace_put(is_mutex ? RTOS_TRACE_EV_MUTEX_TAKE : RTOS_TRACE_EV_QUEUE_RECV,
+                 NULL, queue, 0, 0);
+}
+
+void RtosTrace_QueueBlock(void *queue, int is_mutex, int sending, void *holder) {
+  uint32_t primask;
+  uint16_t arg = (uint16_t)(sending != 0);
+
+  if (!s_recording) {
+    return;
+  }
+  if (is_mutex) {
+    // 编号表只在关中断时修改
+    primask = __get_PRIMASK();
+    __disable_irq();
+    arg = rtos_trace_task_id(holder);
+    __set_PRIMASK(primask);
+  }
+  rtos_trace_put(is_mutex ? RTOS_TRACE_EV_MUTEX_BLOCK : RTOS_TRACE_EV_QUEUE_BLOCK,
+                 NULL, queue, 0, arg);
+}
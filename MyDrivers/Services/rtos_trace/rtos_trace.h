@@ -0,0 +1,119 @@
+/**
+ ******************************************************************************
+ * @file    rtos_trace.h
+ * @brief   RTOS 事件跟踪头文件
+ * @details 通过 FreeRTOS 跟踪宏 (FreeRTOSConfig.h) 与中断入口/出口记录
+ *          任务切换、任务就绪、队列/互斥锁的收发与阻塞，每个事件 8 字节
+ *          (DWT 周期时间戳 | 类型 | 对象编号 | 参数)，写入 CCM 中的环形
+ *          缓冲区。记录按命令行开始/停止，导出时暂停记录，以与 sensor_export
+ *          相同的 0x00 | COBS(载荷 | CRC-32) | 0x00 帧经串口发送，由主机端
+ *          trace_convert.py 转为 Chrome/Perfetto 的 JSON 跟踪格式
+ *          (ui.perfetto.dev 或 chrome://tracing 打开)。
+ *          任务与队列第一次出现时分配编号 (保存在 FreeRTOS 的 TaskNumber/
+ *          QueueNumber 字段中)，导出时附带名称；中断的编号即异常号。
+ *          TIM6 时基中断每毫秒一次，不记录 (系统节拍在任务切换中已可见)。
+ *          时间戳 32 位，168 MHz 下约 25 s 回绕，主机按事件顺序展开。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __RTOS_TRACE_H
+#define __RTOS_TRACE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define RTOS_TRACE_ENABLE 1        // 0: 钩子为空操作 (跟踪宏仍然展开)
+#define RTOS_TRACE_EVENTS 1024     // 环形缓冲区事件数 (必须为 2 的幂，8 字节/个)
+#define RTOS_TRACE_MAX_TASKS 24    // 可命名的任务数
+#define RTOS_TRACE_MAX_QUEUES 32   // 可命名的队列/信号量/互斥锁数
+#define RTOS_TRACE_FRAME_LEN 24    // 每帧事件数
+#define RTOS_TRACE_FRAME_TYPE 0x11 // 帧类型 (与 sensor_export/crash_dump 错开)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 事件类型
+ */
+typedef enum {
+  RTOS_TRACE_EV_TASK_IN = 1,  // 任务切入 (id: 任务)
+  RTOS_TRACE_EV_TASK_READY,   // 任务进入就绪 (id: 任务)
+  RTOS_TRACE_EV_ISR_ENTER,    // 中断进入 (id: 异常号)
+  RTOS_TRACE_EV_ISR_EXIT,     // 中断退出 (id: 异常号)
+  RTOS_TRACE_EV_MUTEX_TAKE,   // 获取互斥锁 (id: 队列)
+  RTOS_TRACE_EV_MUTEX_GIVE,   // 释放互斥锁
+  RTOS_TRACE_EV_MUTEX_BLOCK,  // 等待互斥锁 (arg: 持有者任务)
+  RTOS_TRACE_EV_QUEUE_SEND,   // 队列/信号量发送
+  RTOS_TRACE_EV_QUEUE_RECV,   // 队列/信号量接收
+  RTOS_TRACE_EV_QUEUE_BLOCK,  // 队列/信号量阻塞 (arg: 0 接收，1 发送)
+} RtosTraceEvent_t;
+
+/**
+ * @brief 导出帧内容类型 (载荷: 帧类型 | 序号 (2) | 内容类型 | 内容)
+ */
+typedef enum {
+  RTOS_TRACE_FRAME_START = 0, // CPU 频率 (4) | 事件数 (4) | 丢弃数 (4)
+  RTOS_TRACE_FRAME_NAME,      // 编号 | 类别 (0 任务，1 队列) | 名称
+  RTOS_TRACE_FRAME_EVENTS,    // 事件 x N [时间戳 (4) | 类型 | 编号 | 参数 (2)]
+  RTOS_TRACE_FRAME_END,       // 事件数 (4)
+} RtosTraceFrame_t;
+
+/**
+ * @brief 记录状态
+ */
+typedef struct {
+  bool recording;
+  bool ring;       // 写满后覆盖最旧的事件 (否则写满即停止)
+  uint32_t count;  // 缓冲区中的事件数
+  uint32_t lost;   // 覆盖或因写满丢弃的事件数
+} RtosTraceStatus_t;
+
+/* --------------------------- 公共接口 --------------------------- */
+
+/**
+ * @brief 清空缓冲区并开始记录
+ * @param ring true: 持续记录，保留最近的事件；false: 写满即停止
+ */
+void RtosTrace_Start(bool ring);
+
+/**
+ * @brief 停止记录
+ */
+void RtosTrace_Stop(void);
+
+/**
+ * @brief 获取记录状态
+ */
+void RtosTrace_GetStatus(RtosTraceStatus_t *out);
+
+/**
+ * @brief 导出缓冲区 (停止记录，阻塞到全部写入串口发送缓冲区)
+ * @return 导出的事件数
+ * @note  在命令行任务中调用
+ */
+uint32_t RtosTrace_Dump(void);
+
+/**
+ * @brief 中断入口/出口 (在中断处理函数首尾调用)
+ */
+void RtosTrace_IsrEnter(void);
+void RtosTrace_IsrExit(void);
+
+/* 跟踪宏钩子 (由 tasks.c/queue.c 在临界区或调度器挂起时调用，不要直接调用) */
+void RtosTrace_TaskSwitchedIn(void *tcb);
+void RtosTrace_TaskReady(void *tcb);
+void RtosTrace_QueueSend(void *queue, int is_mutex);
+void RtosTrace_QueueReceive(void *queue, int is_mutex);
+void RtosTrace_QueueBlock(void *queue, int is_mutex, int sending, void *holder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RTOS_TRACE_H */
@@ -0,0 +1,199 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    trace_convert.py
+@brief   RTOS 事件跟踪导出转换工具 (与 rtos_trace.c 配套)
+@details 从串口流中取出 trace dump 输出的 COBS 帧，转换为 Chrome/Perfetto
+         JSON 跟踪格式，在 ui.perfetto.dev 或 chrome://tracing 中打开：
+           - 每个任务一条轨道，运行区间为切片，就绪/队列收发/阻塞为瞬时事件；
+           - 每个中断一条轨道；
+           - 每个互斥锁一条轨道，获取到释放之间为切片 (以持有任务命名)，
+             等待者被阻塞处标出持有者。
+         帧格式见 rtos_trace.h；其他帧与文本日志被忽略。
+         串口模式下发送 trace dump 命令 (先以 trace start 开始记录)。
+
+用法:
+    python trace_convert.py COM5 -o trace.json
+    python trace_convert.py capture.bin -o trace.json
+
+@author  MmsY
+@time    2025/11/23
+"""
+
+import argparse
+import json
+import struct
+import sys
+import time
+import zlib
+
+FRAME_TYPE = 0x11
+KIND_START, KIND_NAME, KIND_EVENTS, KIND_END = 0, 1, 2, 3
+(EV_TASK_IN, EV_TASK_READY, EV_ISR_ENTER, EV_ISR_EXIT, EV_MUTEX_TAKE,
+ EV_MUTEX_GIVE, EV_MUTEX_BLOCK, EV_QUEUE_SEND, EV_QUEUE_RECV,
+ EV_QUEUE_BLOCK) = range(1, 11)
+EVENT = struct.Struct("<IBBH")
+PID = 1
+ISR_TID, MUTEX_TID = 1000, 2000
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Capture:
+    def __init__(self):
+        self.hz = None
+        self.lost = 0
+        self.tasks = {0: "(other)"}
+        self.queues = {}
+        self.events = []
+        self.done = False
+
+    def feed(self, frame):
+        raw = cobs_decode(frame)
+        if raw is None or len(raw) < 8 or raw[0] != FRAME_TYPE:
+            return
+        payload, crc = raw[:-4], struct.unpack("<I", raw[-4:])[0]
+        if zlib.crc32(payload) & 0xFFFFFFFF != crc:
+            print("CRC error, frame dropped", file=sys.stderr)
+            return
+        kind, body = payload[3], payload[4:]
+        if kind == KIND_START:
+            self.hz, _count, self.lost = struct.unpack("<III", body[:12])
+            self.events = []
+        elif kind == KIND_NAME:
+            names = self.tasks if body[1] == 0 else self.queues
+            names[body[0]] = body[2:].decode(errors="replace")
+        elif kind == KIND_EVENTS:
+            self.events += [EVENT.unpack_from(body, i)
+                            for i in range(0, len(body) - 7, EVENT.size)]
+        elif kind == KIND_END:
+            self.done = True
+
+
+def read_frames(read, cap, deadline=None):
+    buf = bytearray()
+    while not cap.done and (deadline is None or time.time() < deadline):
+        data = read()
+        if not data:
+            if deadline is None:
+                break
+            continue
+        buf += data
+        while True:
+            start = buf.find(0)
+            end = buf.find(0, start + 1) if start >= 0 else -1
+            if end < 0:
+                break
+            if end > start + 1:
+                cap.feed(bytes(buf[start + 1:end]))
+            del buf[:end]
+
+
+def convert(cap):
+    out = []
+    us = 1e6 / cap.hz
+    t = 0
+    prev = None
+    running = None      # (任务编号, 开始时间)
+    isr_start = {}
+    held = {}           # 互斥锁编号 -> (持有任务, 开始时间)
+
+    def task_name(i):
+        return cap.tasks.get(i, "task %d" % i)
+
+    def queue_name(i):
+        return cap.queues.get(i, "queue %d" % i)
+
+    def instant(tid, name, ts, **args):
+        out.append({"ph": "i", "s": "t", "pid": PID, "tid": tid, "name": name,
+                    "ts": ts, "args": args})
+
+    def slice_(tid, name, begin, end):
+        out.append({"ph": "X", "pid": PID, "tid": tid, "name": name,
+                    "ts": begin, "dur": max(end - begin, 0.01)})
+
+    for cycles, kind, obj, arg in cap.events:
+        t += 0 if prev is None else (cycles - prev) & 0xFFFFFFFF
+        prev = cycles
+        ts = t * us
+        cur = running[0] if running else 0
+        if kind == EV_TASK_IN:
+            if running:
+                slice_(running[0], "running", running[1], ts)
+            running = (obj, ts)
+        elif kind == EV_TASK_READY:
+            instant(obj, "ready", ts)
+        elif kind == EV_ISR_ENTER:
+            isr_start[obj] = ts
+        elif kind == EV_ISR_EXIT and obj in isr_start:
+            slice_(ISR_TID + obj, "IRQ %d" % (obj - 16), isr_start.pop(obj), ts)
+        elif kind == EV_MUTEX_TAKE:
+            held[obj] = (cur, ts)
+        elif kind == EV_MUTEX_GIVE and obj in held:
+            owner, begin = held.pop(obj)
+            slice_(MUTEX_TID + obj, task_name(owner), begin, ts)
+        elif kind == EV_MUTEX_BLOCK:
+            instant(cur, "wait " + queue_name(obj), ts, holder=task_name(arg))
+        elif kind in (EV_QUEUE_SEND, EV_QUEUE_RECV, EV_QUEUE_BLOCK):
+            what = {EV_QUEUE_SEND: "send", EV_QUEUE_RECV: "recv"}.get(
+                kind, "block " + ("send" if arg else "recv"))
+            instant(cur, "%s %s" % (what, queue_name(obj)), ts)
+
+    meta = [{"ph": "M", "pid": PID, "name": "process_name",
+             "args": {"name": "EnviroSense"}}]
+    tids = {e["tid"] for e in out}
+    for tid in sorted(tids):
+        if tid >= MUTEX_TID:
+            name = "mutex " + queue_name(tid - MUTEX_TID)
+        elif tid >= ISR_TID:
+            name = "IRQ %d" % (tid - ISR_TID - 16)
+        else:
+            name = task_name(tid)
+        meta.append({"ph": "M", "pid": PID, "tid": tid, "name": "thread_name",
+                     "args": {"name": name}})
+    return {"traceEvents": meta + out, "displayTimeUnit": "ns"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description="EnviroSense RTOS trace converter")
+    ap.add_argument("source", help="串口名或抓包文件")
+    ap.add_argument("-o", "--output", default="trace.json")
+    ap.add_argument("-b", "--baud", type=int, default=115200)
+    ap.add_argument("--timeout", type=float, default=10.0)
+    opts = ap.parse_args()
+
+    cap = Capture()
+    try:
+        with open(opts.source, "rb") as f:
+            read_frames(lambda: f.read(4096), cap)
+    except OSError:
+        import serial  # pyserial
+        port = serial.Serial(opts.source, opts.baud, timeout=0.2)
+        port.write(b"trace dump\r\n")
+        read_frames(lambda: port.read(4096), cap, time.time() + opts.timeout)
+        port.close()
+
+    if cap.hz is None:
+        sys.exit("no trace dump received")
+    if not cap.done:
+        print("warning: dump incomplete", file=sys.stderr)
+    with open(opts.output, "w") as out:
+        json.dump(convert(cap), out)
+    print("%d events (%d lost) -> %s" % (len(cap.events), cap.lost, opts.output),
+          file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,321 @@
+/**
+ ******************************************************************************
+ * @file    runtime_config.c
+ * @brief   运行时配置热加载实现
+ * @details 两个缓冲区轮流作为当前配置与草稿。发布只写一次 s_current
+ *          (对齐的指针写入是原子的)，订阅方读到的要么是旧版、要么是完整的
+ *          新版。草稿所在的缓冲区即上上一版，Edit 在改写它之前确认所有
+ *          订阅方都已 Poll 到当前版本，不再引用它。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "runtime_config.h"
+#include "FreeRTOS.h"
+#include "config_store.h"
+#include "devices_manager.h"
+#include "semphr.h"
+#include "task.h"
+#include <string.h>
+
+/* --------------------------- 调试配置 --------------------------- */
+#define LOG_MODULE "RtConfig"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define RUNTIME_CONFIG_POLL_MS 5 // 等待订阅方时的检查间隔
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  void (*wake)(void);
+  volatile uint32_t seen; // 已取走的版本
+} RuntimeConfigSubscriber_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static RuntimeConfig_t s_buf[2];
+static const RuntimeConfig_t *volatile s_current; // 当前配置，NULL 表示尚未发布
+static RuntimeConfig_t *s_draft;                  // 正在编辑的草稿
+static RuntimeConfigSubscriber_t s_subs[RUNTIME_CONFIG_MAX_SUBSCRIBERS];
+static uint8_t s_sub_count;
+static SemaphoreHandle_t s_lock; // 修改方互斥 (Edit 到 Publish / Cancel)
+static StaticSemaphore_t s_lock_buf;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static void runtime_config_create_lock(void) {
+  taskENTER_CRITICAL();
+  if (s_lock == NULL) {
+    s_lock = xSemaphoreCreateMutexStatic(&s_lock_buf);
+  }
+  taskEXIT_CRITICAL();
+}
+
+static void runtime_config_wake_all(void) {
+  for (uint8_t i = 0; i < s_sub_count; i++) {
+    if (s_subs[i].wake != NULL) {
+      s_subs[i].wake();
+    }
+  }
+}
+
+/* 所有订阅方都已取走当前版本 */
+static bool runtime_config_settled(void) {
+  const RuntimeConfig_t *cur = s_current;
+
+  for (uint8_t i = 0; cur != NULL && i < s_sub_count; i++) {
+    if (s_subs[i].seen != cur->version) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* 第一次修改：从各模块读取当前值 */
+static void runtime_config_capture(RuntimeConfig_t *cfg) {
+  memset(cfg, 0, sizeof(RuntimeConfig_t));
+
+  for (int type = SENSOR_TYPE_GY30; type < SENSOR_TYPE_MAX; type++) {
+    SensorHandle_t handle = SensorTask_Find((SensorType_t)type, 0);
+    if (handle != SENSOR_HANDLE_INVALID) {
+      cfg->interval_ms[type] = SensorTask_GetUpdateInterval(handle);
+    }
+  }
+  for (uint8_t i = 0; i < RUNTIME_CONFIG_LED_SLOTS; i++) {
+    Drivers_RGBLED_GetSlotColor(i + 1, &cfg->led_slots[i]);
+  }
+  cfg->log_level = (uint8_t)log_get_level();
+
+  for (uint8_t i = 0; i < SENSOR_ALARM_MAX_RULES; i++) {
+    const SensorAlarmRule_t *rule;
+    if (!SensorAlarm_GetRule(i, &rule, NULL)) {
+      break;
+    }
+    cfg->alarm_rules[i] = *rule;
+    if (rule->name != NULL) {
+      strncpy(cfg->alarm_names[i], rule->name, RUNTIME_CONFIG_NAME_LEN - 1);
+    }
+    cfg->alarm_count++;
+  }
+}
+
+/* 规则名指向本缓冲区的副本 (草稿由另一个缓冲区拷贝而来) */
+static void runtime_config_fix_names(RuntimeConfig_t *cfg) {
+  for (uint8_t i = 0; i < SENSOR_ALARM_MAX_RULES; i++) {
+    cfg->alarm_names[i][RUNTIME_CONFIG_NAME_LEN - 1] = '\0';
+    cfg->alarm_rules[i].name = cfg->alarm_names[i];
+  }
+}
+
+static const char *runtime_config_validate(const RuntimeConfig_t *cfg) {
+  for (int type = SENSOR_TYPE_GY30; type < SENSOR_TYPE_MAX; type++) {
+    if (cfg->interval_ms[type] != 0 &&
+        cfg->interval_ms[type] < RUNTIME_CONFIG_MIN_INTERVAL_MS) {
+      return "interval below minimum";
+    }
+  }
+  if (cfg->log_level > LOG_LEVEL_OFF) {
+    return "invalid log level";
+  }
+  if (cfg->alarm_count > SENSOR_ALARM_MAX_RULES) {
+    return "too many alarm rules";
+  }
+  for (uint8_t i = 0; i < cfg->alarm_count; i++) {
+    const SensorAlarmRule_t *rule = &cfg->alarm_rules[i];
+    if (SENSOR_HANDLE_TYPE(rule->sensor) == SENSOR_TYPE_NONE ||
+        SENSOR_HANDLE_TYPE(rule->sensor) >= SENSOR_TYPE_MAX ||
+        rule->channel >= SENSOR_MAX_CHANNELS) {
+      return "alarm rule sensor/channel invalid";
+    }
+    if (rule->cond > SENSOR_ALARM_FALL_RATE || rule->threshold != rule->threshold ||
+        !(rule->hysteresis >= 0.0f)) {
+      return "alarm rule condition invalid";
+    }
+    if (rule->motor_speed > 999) {
+      return "alarm rule motor speed > 999";
+    }
+  }
+  return NULL;
+}
+
+static bool runtime_config_alarms_equal(const RuntimeConfig_t *a,
+                                        const RuntimeConfig_t *b) {
+  if (a->alarm_count != b->alarm_count) {
+    return false;
+  }
+  for (uint8_t i = 0; i < a->alarm_count; i++) {
+    SensorAlarmRule_t ra = a->alarm_rules[i];
+    SensorAlarmRule_t rb = b->alarm_rules[i];
+    ra.name = rb.name = NULL;
+    if (memcmp(&ra, &rb, sizeof(ra)) != 0 ||
+        strcmp(a->alarm_names[i], b->alarm_names[i]) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* 与上一版比较，prev 为 NULL 时全部视为变化 */
+static uint32_t runtime_config_diff(const RuntimeConfig_t *prev,
+                                    const RuntimeConfig_t *next) {
+  uint32_t changed = 0;
+
+  for (int type = SENSOR_TYPE_GY30; type < SENSOR_TYPE_MAX; type++) {
+    if (next->interval_ms[type] != 0 &&
+        (prev == NULL || prev->interval_ms[type] != next->interval_ms[type])) {
+      changed |= RUNTIME_CONFIG_CHG_INTERVAL(type);
+    }
+  }
+  for (uint8_t i = 0; i < RUNTIME_CONFIG_LED_SLOTS; i++) {
+    if (prev == NULL || memcmp(&prev->led_slots[i], &next->led_slots[i],
+                               sizeof(RGB_Color)) != 0) {
+      changed |= RUNTIME_CONFIG_CHG_LED_SLOT(i);
+    }
+  }
+  if (prev == NULL || prev->log_level != next->log_level) {
+    changed |= RUNTIME_CONFIG_CHG_LOG_LEVEL;
+  }
+  if (prev == NULL || !runtime_config_alarms_equal(prev, next)) {
+    changed |= RUNTIME_CONFIG_CHG_ALARMS;
+  }
+  return changed;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 订阅配置变化
+ */
+RuntimeConfigSub_t RuntimeConfig_Subscribe(void (*wake)(void)) {
+  RuntimeConfigSub_t sub = -1;
+
+  runtime_config_create_lock();
+  taskENTER_CRITICAL();
+  if (s_sub_count < RUNTIME_CONFIG_MAX_SUBSCRIBERS) {
+    sub = (RuntimeConfigSub_t)s_sub_count;
+    s_subs[sub].wake = wake;
+    s_subs[sub].seen = 0;
+    s_sub_count++;
+  }
+  taskEXIT_CRITICAL();
+  return sub;
+}
+
+/**
+ * @brief 取得订阅方尚未处理的新配置
+ */
+const RuntimeConfig_t *RuntimeConfig_Poll(RuntimeConfigSub_t sub) {
+  const RuntimeConfig_t *cur = s_current;
+
+  if (sub < 0 || sub >= (RuntimeConfigSub_t)s_sub_count || cur == NULL ||
+      s_subs[sub].seen == cur->version) {
+    return NULL;
+  }
+  s_subs[sub].seen = cur->version;
+  return cur;
+}
+
+/**
+ * @brief 当前发布的配置
+ */
+const RuntimeConfig_t *RuntimeConfig_Current(void) { return s_current; }
+
+/**
+ * @brief 开始修改
+ */
+RuntimeConfig_t *RuntimeConfig_Edit(void) {
+  const RuntimeConfig_t *cur;
+  uint32_t waited = 0;
+
+  runtime_config_create_lock();
+  xSemaphoreTake(s_lock, portMAX_DELAY);
+
+  // 草稿将覆盖上上一版：等所有订阅方都换到当前版本
+  while (!runtime_config_settled()) {
+    if (waited >= RUNTIME_CONFIG_GRACE_MS) {
+      xSemaphoreGive(s_lock);
+      LOG_WARN("上一版配置尚未被所有订阅方接收");
+      return NULL;
+    }
+    runtime_config_wake_all();
+    vTaskDelay(pdMS_TO_TICKS(RUNTIME_CONFIG_POLL_MS));
+    waited += RUNTIME_CONFIG_POLL_MS;
+  }
+
+  cur = s_current;
+  if (cur == NULL) {
+    s_draft = &s_buf[0];
+    runtime_config_capture(s_draft);
+  } else {
+    s_draft = (cur == &s_buf[0]) ? &s_buf[1] : &s_buf[0];
+    memcpy(s_draft, cur, sizeof(RuntimeConfig_t));
+  }
+  runtime_config_fix_names(s_draft);
+  return s_draft;
+}
+
+/**
+ * @brief 校验草稿并发布
+ */
+bool RuntimeConfig_Publish(const char **error) {
+  const RuntimeConfig_t *cur = s_current;
+  RuntimeConfig_t *draft = s_draft;
+  const char *reason;
+
+  if (draft == NULL) {
+    if (error != NULL) {
+      *error = "no draft";
+    }
+    return false;
+  }
+  s_draft = NULL;
+
+  runtime_config_fix_names(draft);
+  reason = runtime_config_validate(draft);
+  if (reason != NULL) {
+    xSemaphoreGive(s_lock);
+    if (error != NULL) {
+      *error = reason;
+    }
+    LOG_WARN("配置校验失败: %s", reason);
+    return false;
+  }
+
+  draft->changed = runtime_config_diff(cur, draft);
+  if (draft->changed == 0) {
+    xSemaphoreGive(s_lock);
+    return true;
+  }
+  draft->version = (cur != NULL) ? cur->version + 1 : 1;
+
+  // 单字节设置直接生效，其余由订阅方在各自的任务中应用
+  if (draft->changed & RUNTIME_CONFIG_CHG_LOG_LEVEL) {
+    log_set_level((log_level_t)draft->log_level);
+  }
+  // 采样间隔与 interval 命令一样按类型持久化 (LED 槽位由输出模块自行写回)
+  for (int type = SENSOR_TYPE_GY30; type < SENSOR_TYPE_MAX; type++) {
+    if (draft->changed & RUNTIME_CONFIG_CHG_INTERVAL(type)) {
+      ConfigStore_Set(CONFIG_KEY_SENSOR_INTERVAL(type), &draft->interval_ms[type],
+                      sizeof(uint32_t));
+    }
+  }
+
+  __DMB(); // 草稿内容先于指针可见
+  s_current = draft;
+  xSemaphoreGive(s_lock);
+
+  LOG_INFO("发布配置 v%lu (变化 0x%04lX)", (unsigned long)draft->version,
+           (unsigned long)draft->changed);
+  runtime_config_wake_all();
+  return true;
+}
+
+/**
+ * @brief 放弃草稿
+ */
+void RuntimeConfig_Cancel(void) {
+  if (s_draft != NULL) {
+    s_draft = NULL;
+    xSemaphoreGive(s_lock);
+  }
+}
@@ -0,0 +1,123 @@
+/**
+ ******************************************************************************
+ * @file    runtime_config.h
+ * @brief   运行时配置热加载头文件
+ * @details 采样间隔、LED 槽位颜色、日志级别与告警规则集中在一个配置结构中，
+ *          以双缓冲的方式整体发布，使用配置的任务不会看到改了一半的设置：
+ *            - 修改方 (命令行等) 用 RuntimeConfig_Edit 取得草稿 (当前配置
+ *              的副本，位于另一个缓冲区)，修改任意多项后 RuntimeConfig_Publish
+ *              校验并通过一次指针交换发布，校验失败则整体丢弃；
+ *            - 订阅方 (传感器任务、输出控制任务) 在各自的下一个周期调用
+ *              RuntimeConfig_Poll 取得新配置，在自己的任务中应用 changed
+ *              标出的变化，发布过程不会暂停采样或刷新；
+ *            - 旧缓冲区要等所有订阅方都取走新配置后才会再次作为草稿，
+ *              订阅方可以一直引用取得的配置 (如告警规则表)，直到下一次 Poll。
+ *          日志级别只有一个字节，发布时直接生效。
+ *          尚未发布过时各模块使用各自的默认值与配置存储中的设置；第一次
+ *          Edit 时从各模块读取当前值作为草稿的起点。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __RUNTIME_CONFIG_H
+#define __RUNTIME_CONFIG_H
+
+#include "rgbled.h"
+#include "sensor_alarm.h"
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define RUNTIME_CONFIG_MAX_SUBSCRIBERS 4 // 订阅方最大数量
+#define RUNTIME_CONFIG_NAME_LEN 12       // 告警规则名最大长度 (含结尾 0)
+#define RUNTIME_CONFIG_GRACE_MS 1000     // Edit 等待订阅方取走上一版的最长时间
+#define RUNTIME_CONFIG_MIN_INTERVAL_MS 100 // 采样间隔下限 (与 SensorTask_SetUpdateInterval 一致)
+#define RUNTIME_CONFIG_LED_SLOTS 3
+
+/* 变化位图 (RuntimeConfig_t.changed) */
+#define RUNTIME_CONFIG_CHG_INTERVAL(type) (1UL << (type)) // 该类型的采样间隔
+#define RUNTIME_CONFIG_CHG_LED_SLOT(i) (1UL << (8 + (i)))  // 槽位 i (0 起)
+#define RUNTIME_CONFIG_CHG_LOG_LEVEL (1UL << 12)
+#define RUNTIME_CONFIG_CHG_ALARMS (1UL << 13)
+
+#if SENSOR_TYPE_MAX > 8
+#error "SENSOR_TYPE_MAX 超过变化位图中采样间隔的位数 (8)"
+#endif
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 一版运行时配置
+ */
+typedef struct {
+  uint32_t version; // 发布序号 (从 1 开始)
+  uint32_t changed; // 与上一版相比变化的项 (RUNTIME_CONFIG_CHG_*)
+
+  uint32_t interval_ms[SENSOR_TYPE_MAX]; // 各类型的采样间隔，0 表示不修改
+  RGB_Color led_slots[RUNTIME_CONFIG_LED_SLOTS];
+  uint8_t log_level;                     // log_level_t
+
+  uint8_t alarm_count;
+  SensorAlarmRule_t alarm_rules[SENSOR_ALARM_MAX_RULES]; // name 指向 alarm_names
+  char alarm_names[SENSOR_ALARM_MAX_RULES][RUNTIME_CONFIG_NAME_LEN];
+} RuntimeConfig_t;
+
+/**
+ * @brief 订阅方句柄 (-1 表示订阅失败)
+ */
+typedef int8_t RuntimeConfigSub_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 订阅配置变化
+ * @param wake 发布后调用，唤醒订阅方的任务以便尽快 Poll (可为 NULL)
+ * @note  在订阅方任务开始运行之前调用 (模块初始化中)
+ */
+RuntimeConfigSub_t RuntimeConfig_Subscribe(void (*wake)(void));
+
+/**
+ * @brief 取得订阅方尚未处理的新配置
+ * @return 有新版本时返回该版本 (在下一次 Poll 之前一直有效)，否则 NULL
+ * @note  只在订阅方自己的任务中调用
+ */
+const RuntimeConfig_t *RuntimeConfig_Poll(RuntimeConfigSub_t sub);
+
+/**
+ * @brief 当前发布的配置
+ * @return 尚未发布过时返回 NULL
+ * @note  只用于显示；需要长期引用时应订阅
+ */
+const RuntimeConfig_t *RuntimeConfig_Current(void);
+
+/**
+ * @brief 开始修改：取得草稿 (当前配置的副本)
+ * @return 草稿；上一版在 RUNTIME_CONFIG_GRACE_MS 内仍未被所有订阅方取走时
+ *         返回 NULL
+ * @note  与 Publish / Cancel 成对调用，期间其他修改方等待；只能在任务中调用
+ */
+RuntimeConfig_t *RuntimeConfig_Edit(void);
+
+/**
+ * @brief 校验草稿并发布
+ * @param error 校验失败时输出原因 (可为 NULL)
+ * @return false 校验失败，草稿被丢弃，当前配置不变
+ */
+bool RuntimeConfig_Publish(const char **error);
+
+/**
+ * @brief 放弃草稿
+ */
+void RuntimeConfig_Cancel(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __RUNTIME_CONFIG_H */
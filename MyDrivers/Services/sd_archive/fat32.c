@@ -0,0 +1,429 @@
+/**
+ ******************************************************************************
+ * @file    fat32.c
+ * @brief   FAT32 连续文件分配实现
+ * @details FAT 扇区带一个扇区的写回缓存，分配连续簇时顺序扫描 FAT，
+ *          每个 FAT 扇区只读一次；修改的 FAT 扇区同步写入每一份 FAT。
+ *          创建文件时先写簇链，再写目录项：中途掉电最多留下未引用的簇，
+ *          PC 的磁盘检查可以回收，不会出现指向未分配簇的文件。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "fat32.h"
+#include "sdcard.h"
+#include <string.h>
+
+#define LOG_MODULE "FAT"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define FAT32_SECTOR_SIZE 512
+#define FAT32_ENTRIES_PER_FAT_SECTOR (FAT32_SECTOR_SIZE / 4)
+#define FAT32_DIR_ENTRY_SIZE 32
+#define FAT32_DIR_PER_SECTOR (FAT32_SECTOR_SIZE / FAT32_DIR_ENTRY_SIZE)
+#define FAT32_CLUSTER_MASK 0x0FFFFFFFU
+#define FAT32_EOC 0x0FFFFFFFU
+#define FAT32_EOC_MIN 0x0FFFFFF8U
+
+#define FAT32_ATTR_VOLUME 0x08
+#define FAT32_ATTR_DIR 0x10
+#define FAT32_ATTR_ARCHIVE 0x20
+#define FAT32_ATTR_LFN 0x0F
+
+#define FAT32_FSINFO_LEAD 0x41615252U
+#define FAT32_FSINFO_STRUCT 0x61417272U
+
+/* 一次根目录遍历的参数与结果 */
+typedef struct {
+  const char *name;      // 要查找的文件 (NULL: 不查找)
+  Fat32_ListCb_t cb;     // 遍历回调 (可为 NULL)
+  void *user;
+  bool found;            // 找到 name
+  uint32_t found_cluster;
+  uint32_t found_size;
+  bool free_found;       // 有空闲目录项
+  uint32_t free_lba;     // 第一个空闲目录项所在扇区
+  uint8_t free_index;    // 扇区内序号
+  uint32_t last_cluster; // 根目录簇链的最后一簇
+} Fat32_DirScan_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static uint32_t s_fat_buf[FAT32_SECTOR_SIZE / 4]; // FAT 扇区缓存
+static uint32_t s_fat_lba;                         // 缓存的扇区 (0: 无效)
+static bool s_fat_dirty;
+static uint32_t s_buf[FAT32_SECTOR_SIZE / 4];     // 引导扇区、目录与 FSInfo
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static uint16_t fat32_rd16(const uint8_t *p) {
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t fat32_rd32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) |
+         ((uint32_t)p[3] << 24);
+}
+
+static void fat32_wr16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+}
+
+static void fat32_wr32(uint8_t *p, uint32_t v) {
+  fat32_wr16(p, (uint16_t)v);
+  fat32_wr16(p + 2, (uint16_t)(v >> 16));
+}
+
+static uint32_t fat32_cluster_lba(const Fat32_Volume_t *vol, uint32_t cluster) {
+  return vol->data_start + (cluster - 2) * vol->cluster_sectors;
+}
+
+static bool fat32_cluster_valid(const Fat32_Volume_t *vol, uint32_t cluster) {
+  return cluster >= 2 && cluster < vol->cluster_count + 2;
+}
+
+/* 写回缓存的 FAT 扇区 (每一份 FAT) */
+static bool fat32_sync(const Fat32_Volume_t *vol) {
+  if (!s_fat_dirty) {
+    return true;
+  }
+  for (uint8_t i = 0; i < vol->fat_count; i++) {
+    if (!SdCard_Write(s_fat_lba + i * vol->fat_sectors, s_fat_buf, 1)) {
+      return false;
+    }
+  }
+  s_fat_dirty = false;
+  return true;
+}
+
+static bool fat32_load(const Fat32_Volume_t *vol, uint32_t cluster) {
+  uint32_t lba = vol->fat_start + cluster / FAT32_ENTRIES_PER_FAT_SECTOR;
+
+  if (lba == s_fat_lba) {
+    return true;
+  }
+  if (!fat32_sync(vol)) {
+    return false;
+  }
+  if (!SdCard_Read(lba, s_fat_buf, 1)) {
+    s_fat_lba = 0;
+    return false;
+  }
+  s_fat_lba = lba;
+  return true;
+}
+
+static bool fat32_get(const Fat32_Volume_t *vol, uint32_t cluster, uint32_t *value) {
+  if (!fat32_load(vol, cluster)) {
+    return false;
+  }
+  *value = s_fat_buf[cluster % FAT32_ENTRIES_PER_FAT_SECTOR] & FAT32_CLUSTER_MASK;
+  return true;
+}
+
+static bool fat32_set(const Fat32_Volume_t *vol, uint32_t cluster, uint32_t value) {
+  uint32_t *entry;
+
+  if (!fat32_load(vol, cluster)) {
+    return false;
+  }
+  entry = &s_fat_buf[cluster % FAT32_ENTRIES_PER_FAT_SECTOR];
+  *entry = (*entry & ~FAT32_CLUSTER_MASK) | (value & FAT32_CLUSTER_MASK); // 保留高 4 位
+  s_fat_dirty = true;
+  return true;
+}
+
+/* 从分配提示处查找 count 个连续的空闲簇 (到卷尾后回到簇 2) */
+static bool fat32_find_run(Fat32_Volume_t *vol, uint32_t count, uint32_t *first) {
+  uint32_t cluster = vol->alloc_hint;
+  uint32_t run = 0;
+  uint32_t value;
+
+  for (uint32_t checked = 0; checked < vol->cluster_count; checked++, cluster++) {
+    if (!fat32_cluster_valid(vol, cluster)) {
+      cluster = 2;
+      run = 0; // 连续区不能跨过卷尾
+    }
+    if (!fat32_get(vol, cluster, &value)) {
+      return false;
+    }
+    if (value != 0) {
+      run = 0;
+      continue;
+    }
+    if (run++ == 0) {
+      *first = cluster;
+    }
+    if (run == count) {
+      vol->alloc_hint = cluster + 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* 把 [first, first + count) 链成一个文件 */
+static bool fat32_link_run(const Fat32_Volume_t *vol, uint32_t first, uint32_t count) {
+  for (uint32_t i = 0; i < count; i++) {
+    if (!fat32_set(vol, first + i, i + 1 == count ? FAT32_EOC : first + i + 1)) {
+      return false;
+    }
+  }
+  return fat32_sync(vol);
+}
+
+/* 遍历根目录 (跳过长文件名、卷标与子目录) */
+static bool fat32_scan_dir(Fat32_Volume_t *vol, Fat32_DirScan_t *scan) {
+  uint32_t cluster = vol->root_cluster;
+  uint32_t next;
+
+  for (uint32_t n = 0; n < vol->cluster_count; n++) {
+    for (uint8_t s = 0; s < vol->cluster_sectors; s++) {
+      uint32_t lba = fat32_cluster_lba(vol, cluster) + s;
+
+      if (!SdCard_Read(lba, s_buf, 1)) {
+        return false;
+      }
+      for (uint8_t i = 0; i < FAT32_DIR_PER_SECTOR; i++) {
+        const uint8_t *e = (const uint8_t *)s_buf + i * FAT32_DIR_ENTRY_SIZE;
+
+        if (e[0] == 0x00 || e[0] == 0xE5) {
+          if (!scan->free_found) {
+            scan->free_found = true;
+            scan->free_lba = lba;
+            scan->free_index = i;
+          }
+          if (e[0] == 0x00) { // 目录结束
+            scan->last_cluster = cluster;
+            return true;
+          }
+          continue;
+        }
+        if (e[11] == FAT32_ATTR_LFN || (e[11] & (FAT32_ATTR_VOLUME | FAT32_ATTR_DIR))) {
+          continue;
+        }
+        if (scan->name != NULL && memcmp(e, scan->name, 11) == 0) {
+          scan->found = true;
+          scan->found_cluster = ((uint32_t)fat32_rd16(e + 20) << 16) | fat32_rd16(e + 26);
+          scan->found_size = fat32_rd32(e + 28);
+          return true;
+        }
+        if (scan->cb != NULL && !scan->cb((const char *)e, fat32_rd32(e + 28), scan->user)) {
+          return true;
+        }
+      }
+    }
+    if (!fat32_get(vol, cluster, &next)) {
+      return false;
+    }
+    if (next >= FAT32_EOC_MIN) {
+      scan->last_cluster = cluster;
+      return true;
+    }
+    if (!fat32_cluster_valid(vol, next)) {
+      LOG_WARN("根目录簇链损坏");
+      return false;
+    }
+    cluster = next;
+  }
+  return false;
+}
+
+/* 根目录已满：追加一个清零的簇 */
+static bool fat32_extend_dir(Fat32_Volume_t *vol, Fat32_DirScan_t *scan) {
+  uint32_t cluster;
+
+  if (!fat32_find_run(vol, 1, &cluster)) {
+    return false;
+  }
+  memset(s_buf, 0, sizeof(s_buf));
+  for (uint8_t s = 0; s < vol->cluster_sectors; s++) {
+    if (!SdCard_Write(fat32_cluster_lba(vol, cluster) + s, s_buf, 1)) {
+      return false;
+    }
+  }
+  if (!fat32_set(vol, cluster, FAT32_EOC) ||
+      !fat32_set(vol, scan->last_cluster, cluster) || !fat32_sync(vol)) {
+    return false;
+  }
+  scan->free_found = true;
+  scan->free_lba = fat32_cluster_lba(vol, cluster);
+  scan->free_index = 0;
+  return true;
+}
+
+/* FSInfo：空闲簇数置为未知，更新下次分配提示 */
+static void fat32_update_fsinfo(const Fat32_Volume_t *vol) {
+  uint8_t *b = (uint8_t *)s_buf;
+
+  if (vol->fsinfo_sector == 0 || !SdCard_Read(vol->fsinfo_sector, s_buf, 1) ||
+      fat32_rd32(b) != FAT32_FSINFO_LEAD || fat32_rd32(b + 484) != FAT32_FSINFO_STRUCT) {
+    return;
+  }
+  fat32_wr32(b + 488, 0xFFFFFFFFU);
+  fat32_wr32(b + 492, vol->alloc_hint);
+  SdCard_Write(vol->fsinfo_sector, s_buf, 1);
+}
+
+static bool fat32_is_bpb(const uint8_t *b) {
+  uint8_t spc = b[13];
+
+  return fat32_rd16(b + 11) == FAT32_SECTOR_SIZE && spc != 0 && (spc & (spc - 1)) == 0 &&
+         b[16] != 0 && fat32_rd16(b + 17) == 0 && fat32_rd16(b + 22) == 0 &&
+         fat32_rd32(b + 36) != 0;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 挂载
+ */
+bool Fat32_Mount(Fat32_Volume_t *vol) {
+  uint8_t *b = (uint8_t *)s_buf;
+  uint32_t lba = 0;
+  uint32_t total;
+  uint16_t fsinfo;
+
+  s_fat_lba = 0;
+  s_fat_dirty = false;
+  if (!SdCard_Read(0, s_buf, 1) || fat32_rd16(b + 510) != 0xAA55) {
+    return false;
+  }
+  if (!fat32_is_bpb(b)) {
+    uint8_t type = b[0x1C2]; // 第一个分区表项
+    if (type != 0x0B && type != 0x0C) {
+      LOG_WARN("第一个分区不是 FAT32 (类型 0x%02X)", type);
+      return false;
+    }
+    lba = fat32_rd32(b + 0x1C6);
+    if (!SdCard_Read(lba, s_buf, 1) || fat32_rd16(b + 510) != 0xAA55 || !fat32_is_bpb(b)) {
+      LOG_WARN("分区引导扇区无效");
+      return false;
+    }
+  }
+
+  vol->cluster_sectors = b[13];
+  vol->fat_count = b[16];
+  vol->fat_sectors = fat32_rd32(b + 36);
+  vol->fat_start = lba + fat32_rd16(b + 14);
+  vol->data_start = vol->fat_start + vol->fat_count * vol->fat_sectors;
+  vol->root_cluster = fat32_rd32(b + 44);
+  total = fat32_rd32(b + 32);
+  if (total <= vol->data_start - lba) {
+    return false;
+  }
+  vol->cluster_count = (total - (vol->data_start - lba)) / vol->cluster_sectors;
+  if (vol->cluster_count > vol->fat_sectors * FAT32_ENTRIES_PER_FAT_SECTOR - 2) {
+    vol->cluster_count = vol->fat_sectors * FAT32_ENTRIES_PER_FAT_SECTOR - 2;
+  }
+  if (!fat32_cluster_valid(vol, vol->root_cluster)) {
+    return false;
+  }
+  fsinfo = fat32_rd16(b + 48);
+  vol->fsinfo_sector = (fsinfo != 0 && fsinfo != 0xFFFF) ? lba + fsinfo : 0;
+
+  /* FSInfo 中的下次分配提示可以省去从头扫描 FAT */
+  vol->alloc_hint = 2;
+  if (vol->fsinfo_sector != 0 && SdCard_Read(vol->fsinfo_sector, s_buf, 1) &&
+      fat32_rd32(b) == FAT32_FSINFO_LEAD && fat32_rd32(b + 484) == FAT32_FSINFO_STRUCT &&
+      fat32_cluster_valid(vol, fat32_rd32(b + 492))) {
+    vol->alloc_hint = fat32_rd32(b + 492);
+  }
+  return true;
+}
+
+/**
+ * @brief 遍历根目录
+ */
+bool Fat32_List(Fat32_Volume_t *vol, Fat32_ListCb_t cb, void *user) {
+  Fat32_DirScan_t scan = {0};
+
+  scan.cb = cb;
+  scan.user = user;
+  return fat32_scan_dir(vol, &scan);
+}
+
+/**
+ * @brief 打开已有文件并确认簇链连续
+ */
+bool Fat32_Open(Fat32_Volume_t *vol, const char name[11], Fat32_File_t *file) {
+  uint32_t cluster_bytes = (uint32_t)vol->cluster_sectors * FAT32_SECTOR_SIZE;
+  Fat32_DirScan_t scan = {0};
+  uint32_t clusters, value;
+
+  scan.name = name;
+  if (!fat32_scan_dir(vol, &scan) || !scan.found || scan.found_size == 0 ||
+      !fat32_cluster_valid(vol, scan.found_cluster)) {
+    return false;
+  }
+  clusters = (scan.found_size + cluster_bytes - 1) / cluster_bytes;
+  for (uint32_t i = 0; i + 1 < clusters; i++) {
+    if (!fat32_get(vol, scan.found_cluster + i, &value) ||
+        value != scan.found_cluster + i + 1) {
+      return false;
+    }
+  }
+  file->first_sector = fat32_cluster_lba(vol, scan.found_cluster);
+  file->size = scan.found_size;
+  return true;
+}
+
+/**
+ * @brief 创建连续文件
+ */
+bool Fat32_Create(Fat32_Volume_t *vol, const char name[11], uint32_t size,
+                  const Fat32_Time_t *time, Fat32_File_t *file) {
+  uint32_t cluster_bytes = (uint32_t)vol->cluster_sectors * FAT32_SECTOR_SIZE;
+  uint32_t clusters = (size + cluster_bytes - 1) / cluster_bytes;
+  Fat32_DirScan_t scan = {0};
+  uint16_t fdate = (20 << 9) | (1 << 5) | 1; // 2000-01-01
+  uint16_t ftime = 0;
+  uint32_t first;
+  uint8_t *e;
+
+  scan.name = name;
+  if (clusters == 0 || !fat32_scan_dir(vol, &scan) || scan.found) {
+    return false;
+  }
+  if (!scan.free_found && !fat32_extend_dir(vol, &scan)) {
+    LOG_WARN("根目录无法扩展");
+    return false;
+  }
+  if (!fat32_find_run(vol, clusters, &first)) {
+    LOG_WARN("没有 %lu 个连续空闲簇", (unsigned long)clusters);
+    return false;
+  }
+  if (!fat32_link_run(vol, first, clusters)) {
+    return false;
+  }
+
+  if (time != NULL) {
+    fdate = (uint16_t)(((time->year - 1980) << 9) | (time->month << 5) | time->day);
+    ftime = (uint16_t)((time->hour << 11) | (time->minute << 5) | (time->second / 2));
+  }
+  if (!SdCard_Read(scan.free_lba, s_buf, 1)) {
+    return false;
+  }
+  e = (uint8_t *)s_buf + scan.free_index * FAT32_DIR_ENTRY_SIZE;
+  memset(e, 0, FAT32_DIR_ENTRY_SIZE);
+  memcpy(e, name, 11);
+  e[11] = FAT32_ATTR_ARCHIVE;
+  fat32_wr16(e + 14, ftime); // 创建时间
+  fat32_wr16(e + 16, fdate);
+  fat32_wr16(e + 18, fdate); // 访问日期
+  fat32_wr16(e + 20, (uint16_t)(first >> 16));
+  fat32_wr16(e + 22, ftime); // 修改时间
+  fat32_wr16(e + 24, fdate);
+  fat32_wr16(e + 26, (uint16_t)first);
+  fat32_wr32(e + 28, size);
+  if (!SdCard_Write(scan.free_lba, s_buf, 1)) {
+    return false;
+  }
+  fat32_update_fsinfo(vol);
+
+  file->first_sector = fat32_cluster_lba(vol, first);
+  file->size = size;
+  return true;
+}
@@ -0,0 +1,95 @@
+/**
+ ******************************************************************************
+ * @file    fat32.h
+ * @brief   FAT32 连续文件分配 (SD 卡归档用)
+ * @details 只实现归档需要的最小子集：挂载 MBR 第一个 FAT32 分区 (或无
+ *          分区表的卷)，在根目录中按 8.3 短文件名查找、创建文件，并为
+ *          文件一次性分配一段连续的簇。文件创建后大小固定，数据直接按
+ *          扇区号写入，不再修改 FAT 与目录项，写入路径上没有文件系统开销。
+ *          不支持子目录、长文件名、exFAT 与删除文件；卷由 PC 格式化。
+ *          工作缓冲区为模块内静态变量，只支持一个卷，调用者负责互斥。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __FAT32_H
+#define __FAT32_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 已挂载的卷
+ */
+typedef struct {
+  uint32_t fat_start;      // 第一个 FAT 的起始扇区
+  uint32_t fat_sectors;    // 每个 FAT 的扇区数
+  uint32_t data_start;     // 簇 2 的起始扇区
+  uint32_t cluster_count;  // 数据簇数
+  uint32_t root_cluster;   // 根目录首簇
+  uint32_t fsinfo_sector;  // FSInfo 扇区 (0 表示没有)
+  uint32_t alloc_hint;     // 下次分配的起始簇
+  uint8_t fat_count;       // FAT 份数
+  uint8_t cluster_sectors; // 每簇扇区数
+} Fat32_Volume_t;
+
+/**
+ * @brief 根目录中的文件
+ */
+typedef struct {
+  uint32_t first_sector; // 数据起始扇区
+  uint32_t size;         // 文件大小 (字节)
+} Fat32_File_t;
+
+/**
+ * @brief 文件时间 (写入目录项)
+ */
+typedef struct {
+  uint16_t year;
+  uint8_t month, day, hour, minute, second;
+} Fat32_Time_t;
+
+/**
+ * @brief 查找回调：对根目录中每个文件调用一次
+ * @return false: 停止遍历
+ */
+typedef bool (*Fat32_ListCb_t)(const char name[11], uint32_t size, void *user);
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 挂载卷 (读取 MBR 与 BPB)
+ */
+bool Fat32_Mount(Fat32_Volume_t *vol);
+
+/**
+ * @brief 遍历根目录
+ */
+bool Fat32_List(Fat32_Volume_t *vol, Fat32_ListCb_t cb, void *user);
+
+/**
+ * @brief 打开根目录中已有的文件
+ * @return false: 不存在，或簇链不连续 (不是本模块创建的)
+ */
+bool Fat32_Open(Fat32_Volume_t *vol, const char name[11], Fat32_File_t *file);
+
+/**
+ * @brief 在根目录中创建文件并分配 size 字节的连续簇
+ * @param time 目录项的创建/修改时间，NULL 为 2000-01-01
+ * @note  FAT 与目录项写入后 FSInfo 的空闲簇数置为未知，由 PC 重新统计
+ */
+bool Fat32_Create(Fat32_Volume_t *vol, const char name[11], uint32_t size,
+                  const Fat32_Time_t *time, Fat32_File_t *file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __FAT32_H */
@@ -0,0 +1,509 @@
+/**
+ ******************************************************************************
+ * @file    sd_archive.c
+ * @brief   传感器记录 SD 卡归档服务实现
+ * @details 批缓冲区状态：空闲 -> 接收 (s_active) -> 封存 -> 写卡后空闲。
+ *          追加在数据记录任务中执行，只持有 s_mutex 复制一页；写卡只在
+ *          归档任务中进行，不持有锁。接收中的批在写卡时页数只增不减，
+ *          已写出的页不再被修改，只有最后一个不完整的扇区需要在锁内复制。
+ *          每批在第一次写卡时分配位置 (文件内的批序号)，之后按时限重写
+ *          与写满后的最终写入都落在同一位置。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sd_archive.h"
+#include "checksum.h"
+#include "fat32.h"
+#include "rtc_clock.h"
+#include "sdcard.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include "task_plan.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_MODULE "SDARC"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define SD_ARCHIVE_BATCH_SIZE (SD_ARCHIVE_PAGE_SIZE * SD_ARCHIVE_BATCH_PAGES)
+#define SD_ARCHIVE_BATCH_SECTORS (SD_ARCHIVE_BATCH_SIZE / SDCARD_SECTOR_SIZE)
+#define SD_ARCHIVE_PAGES_PER_SECTOR (SDCARD_SECTOR_SIZE / SD_ARCHIVE_PAGE_SIZE)
+#define SD_ARCHIVE_BATCHES_PER_FILE (SD_ARCHIVE_FILE_SIZE / SD_ARCHIVE_BATCH_SIZE)
+#define SD_ARCHIVE_MAX_SEQ 99
+#define SD_ARCHIVE_MAX_ERRORS 3      // 连续失败次数达到后停止归档
+#define SD_ARCHIVE_NO_DAY UINT32_MAX // s_file_day: 没有打开的文件
+
+/* 页头 (与 sensor_log.c 的页格式一致) */
+#define SD_ARCHIVE_PAGE_MAGIC 0xA5
+#define SD_ARCHIVE_PAGE_MAX_RECORDS 31
+
+typedef enum {
+  SD_ARCHIVE_BATCH_FREE = 0,
+  SD_ARCHIVE_BATCH_FILLING,
+  SD_ARCHIVE_BATCH_SEALED,
+} SdArchiveBatchState_t;
+
+typedef struct {
+  uint32_t data[SD_ARCHIVE_BATCH_SIZE / 4]; // DMA 直接读取，未用部分为 0xFF
+  uint8_t state;                            // SdArchiveBatchState_t
+  uint16_t pages;                           // 已追加的页数
+  uint16_t flushed;                         // 已写到卡上的页数
+  uint32_t day;                             // 日期键 YYYYMMDD (0: RTC 未设置)
+  uint32_t seal_seq;                        // 封存顺序
+  TickType_t opened;                        // 第一页追加的时刻
+  uint32_t sector;                          // 卡上位置 (0: 未分配)
+} SdArchiveBatch_t;
+
+/* 查找某天序号最大的文件 */
+typedef struct {
+  char prefix[8];
+  int seq;
+} SdArchiveFind_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static bool s_ready = false;
+static volatile bool s_mounted = false;
+static volatile bool s_flush_request = false;
+
+/* 以下只在持有 s_mutex 时访问 */
+static SdArchiveBatch_t s_batches[2];
+static SdArchiveBatch_t *s_active = NULL;
+static uint32_t s_seal_seq;
+
+/* 以下只由归档任务访问 */
+static Fat32_Volume_t s_volume;
+static Fat32_File_t s_file;
+static uint32_t s_file_day = SD_ARCHIVE_NO_DAY;
+static uint8_t s_file_seq;
+static uint16_t s_file_next;                       // 下一个空闲批位置
+static uint32_t s_tail[SDCARD_SECTOR_SIZE / 4];    // 接收中批的最后一个扇区
+static uint8_t s_consecutive_errors;
+static SdArchive_Stats_t s_stats;
+
+static SemaphoreHandle_t s_mutex = NULL;
+static StaticSemaphore_t s_mutex_buf;
+
+static TaskHandle_t s_task = NULL;
+static StaticTask_t s_task_tcb;
+static StackType_t s_task_stack[SD_ARCHIVE_TASK_STACK_SIZE];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/* 当前日期键 */
+static uint32_t sd_archive_today(void) {
+  RtcDateTime_t dt;
+
+  if (!RtcClock_IsSet()) {
+    return 0;
+  }
+  RtcClock_ToDateTime(RtcClock_Now(), &dt);
+  return dt.year * 10000UL + dt.month * 100UL + dt.day;
+}
+
+/* 8.3 文件名 (空格填充)；display 为 "YYYYMMDD.Lnn" 形式 */
+static void sd_archive_name(uint32_t day, uint8_t seq, char name[11], char *display) {
+  char base[9];
+
+  if (day == 0) {
+    strcpy(base, "NOCLOCK");
+  } else {
+    snprintf(base, sizeof(base), "%08lu", (unsigned long)day);
+  }
+  memset(name, ' ', 11);
+  memcpy(name, base, strlen(base));
+  name[8] = 'L';
+  name[9] = (char)('0' + seq / 10);
+  name[10] = (char)('0' + seq % 10);
+  if (display != NULL) {
+    snprintf(display, 13, "%s.L%02u", base, seq);
+  }
+}
+
+static bool sd_archive_find_cb(const char name[11], uint32_t size, void *user) {
+  SdArchiveFind_t *find = (SdArchiveFind_t *)user;
+
+  (void)size;
+  if (memcmp(name, find->prefix, 8) == 0 && name[8] == 'L' &&
+      name[9] >= '0' && name[9] <= '9' && name[10] >= '0' && name[10] <= '9') {
+    int seq = (name[9] - '0') * 10 + (name[10] - '0');
+    if (seq > find->seq) {
+      find->seq = seq;
+    }
+  }
+  return true;
+}
+
+/* 批位置 index 是否已写入 (首扇区是有效页) */
+static bool sd_archive_slot_used(uint16_t index) {
+  const uint8_t *page = (const uint8_t *)s_tail;
+  uint8_t crc;
+
+  if (!SdCard_Read(s_file.first_sector + index * SD_ARCHIVE_BATCH_SECTORS, s_tail, 1)) {
+    return true; // 读失败时保守地视为已用，不覆盖
+  }
+  if (page[0] != SD_ARCHIVE_PAGE_MAGIC || page[1] == 0 ||
+      page[1] > SD_ARCHIVE_PAGE_MAX_RECORDS) {
+    return false;
+  }
+  crc = page[2];
+  s_tail[0] &= ~0x00FF0000U; // CRC 以 CRC 字段为 0 计算
+  return CRC8_Compute(page, SD_ARCHIVE_PAGE_SIZE) == crc;
+}
+
+/* 打开已有文件后定位续写位置 (批按顺序写入，二分查找第一个空位) */
+static uint16_t sd_archive_resume(void) {
+  uint16_t lo = 0;
+  uint16_t hi = SD_ARCHIVE_BATCHES_PER_FILE;
+
+  while (lo < hi) {
+    uint16_t mid = (uint16_t)((lo + hi) / 2);
+    if (sd_archive_slot_used(mid)) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/* 创建并预擦除 seq 号文件 */
+static bool sd_archive_create(uint32_t day, uint8_t seq) {
+  char name[11];
+  RtcDateTime_t dt;
+  Fat32_Time_t time;
+
+  sd_archive_name(day, seq, name, NULL);
+  if (RtcClock_IsSet()) {
+    RtcClock_ToDateTime(RtcClock_Now(), &dt);
+    time.year = dt.year;
+    time.month = dt.month;
+    time.day = dt.day;
+    time.hour = dt.hour;
+    time.minute = dt.minute;
+    time.second = dt.second;
+  }
+  if (!Fat32_Create(&s_volume, name, SD_ARCHIVE_FILE_SIZE,
+                    RtcClock_IsSet() ? &time : NULL, &s_file)) {
+    return false;
+  }
+  /* 预擦除后卡内没有旧数据需要搬移，之后的写入最快；也清掉回收簇中的旧页 */
+  if (!SdCard_Erase(s_file.first_sector,
+                    s_file.first_sector + SD_ARCHIVE_FILE_SIZE / SDCARD_SECTOR_SIZE - 1)) {
+    LOG_WARN("预擦除失败");
+  }
+  s_stats.files_created++;
+  s_file_next = 0;
+  return true;
+}
+
+/* 打开某天的文件：续写最新的一个，写满或不存在时新建 */
+static bool sd_archive_open_day(uint32_t day) {
+  SdArchiveFind_t find;
+  char name[11];
+  bool ok = false;
+
+  s_file_day = SD_ARCHIVE_NO_DAY;
+  s_stats.file[0] = '\0';
+  sd_archive_name(day, 0, name, NULL);
+  memcpy(find.prefix, name, 8);
+  find.seq = -1;
+  if (!Fat32_List(&s_volume, sd_archive_find_cb, &find)) {
+    return false;
+  }
+
+  if (find.seq >= 0) {
+    s_file_seq = (uint8_t)find.seq;
+    sd_archive_name(day, s_file_seq, name, NULL);
+    if (Fat32_Open(&s_volume, name, &s_file) && s_file.size == SD_ARCHIVE_FILE_SIZE) {
+      s_file_next = sd_archive_resume();
+      ok = s_file_next < SD_ARCHIVE_BATCHES_PER_FILE;
+    }
+    /* 写满、大小不符或不连续 (被 PC 改写过) 的文件不再续写 */
+    if (!ok) {
+      if (s_file_seq >= SD_ARCHIVE_MAX_SEQ) {
+        return false;
+      }
+      s_file_seq++;
+    }
+  } else {
+    s_file_seq = 0;
+  }
+  if (!ok && !sd_archive_create(day, s_file_seq)) {
+    return false;
+  }
+
+  s_file_day = day;
+  s_stats.batches_used = s_file_next;
+  sd_archive_name(day, s_file_seq, name, s_stats.file);
+  LOG_INFO("归档文件 %s, 从第 %u 批续写", s_stats.file, s_file_next);
+  return true;
+}
+
+/* 为批分配卡上位置 */
+static bool sd_archive_place(SdArchiveBatch_t *batch) {
+  char name[11];
+
+  if (batch->sector != 0) {
+    return true;
+  }
+  if (s_file_day != batch->day || s_file_next >= SD_ARCHIVE_BATCHES_PER_FILE) {
+    if (s_file_day == batch->day) {
+      /* 当天文件写满，换下一个序号 */
+      if (s_file_seq >= SD_ARCHIVE_MAX_SEQ || !sd_archive_create(batch->day, s_file_seq + 1)) {
+        s_file_day = SD_ARCHIVE_NO_DAY;
+        return false;
+      }
+      s_file_seq++;
+      sd_archive_name(batch->day, s_file_seq, name, s_stats.file);
+    } else if (!sd_archive_open_day(batch->day)) {
+      return false;
+    }
+  }
+  batch->sector = s_file.first_sector + s_file_next * SD_ARCHIVE_BATCH_SECTORS;
+  s_file_next++;
+  s_stats.batches_used = s_file_next;
+  return true;
+}
+
+/* 写入失败计数，连续失败视为卡已拔出 */
+static void sd_archive_result(bool ok) {
+  if (ok) {
+    s_consecutive_errors = 0;
+    return;
+  }
+  s_stats.errors++;
+  if (++s_consecutive_errors >= SD_ARCHIVE_MAX_ERRORS) {
+    s_mounted = false;
+    s_stats.mounted = false;
+    LOG_ERROR("SD 卡连续写入失败，停止归档");
+  }
+}
+
+/* 写出封存的批并释放 */
+static void sd_archive_write_sealed(SdArchiveBatch_t *batch) {
+  uint32_t sectors = (batch->pages + SD_ARCHIVE_PAGES_PER_SECTOR - 1) / SD_ARCHIVE_PAGES_PER_SECTOR;
+  uint32_t start = HAL_GetTick();
+  bool ok;
+
+  ok = s_mounted && sd_archive_place(batch) &&
+       SdCard_Write(batch->sector, batch->data, sectors);
+  if (s_mounted) {
+    sd_archive_result(ok);
+  }
+  if (ok) {
+    uint32_t ms = HAL_GetTick() - start;
+    s_stats.batches_written++;
+    s_stats.pages_written += batch->pages;
+    if (ms > s_stats.write_ms_max) {
+      s_stats.write_ms_max = ms;
+    }
+  }
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  if (!ok) {
+    s_stats.pages_dropped += batch->pages;
+  }
+  batch->state = SD_ARCHIVE_BATCH_FREE;
+  xSemaphoreGive(s_mutex);
+}
+
+/* 接收中的批超过时限：写出已有的页，批继续接收 */
+static void sd_archive_flush_active(bool force) {
+  SdArchiveBatch_t *batch;
+  uint16_t pages = 0;
+  uint32_t full;
+  bool ok;
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  batch = s_active;
+  if (batch != NULL && batch->pages > batch->flushed &&
+      (force || xTaskGetTickCount() - batch->opened >=
+                    pdMS_TO_TICKS(SD_ARCHIVE_MAX_BATCH_AGE_S * 1000UL))) {
+    pages = batch->pages;
+    batch->opened = xTaskGetTickCount(); // 下次按时限重写从现在算起
+    if (pages % SD_ARCHIVE_PAGES_PER_SECTOR != 0) {
+      memcpy(s_tail, (const uint8_t *)batch->data + (pages / SD_ARCHIVE_PAGES_PER_SECTOR) * SDCARD_SECTOR_SIZE,
+             SDCARD_SECTOR_SIZE);
+    }
+  }
+  xSemaphoreGive(s_mutex);
+  if (pages == 0) {
+    return;
+  }
+
+  /* 锁外写卡：前 full 个扇区不再变化，最后一个扇区用锁内的副本 */
+  full = pages / SD_ARCHIVE_PAGES_PER_SECTOR;
+  ok = sd_archive_place(batch);
+  if (ok && full != 0) {
+    ok = SdCard_Write(batch->sector, batch->data, full);
+  }
+  if (ok && pages % SD_ARCHIVE_PAGES_PER_SECTOR != 0) {
+    ok = SdCard_Write(batch->sector + full, s_tail, 1);
+  }
+  sd_archive_result(ok);
+  if (ok) {
+    batch->flushed = pages; // 只由归档任务访问
+    s_stats.partial_flushes++;
+  }
+}
+
+/* 取最早封存的批 */
+static SdArchiveBatch_t *sd_archive_next_sealed(void) {
+  SdArchiveBatch_t *next = NULL;
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  for (uint32_t i = 0; i < 2; i++) {
+    SdArchiveBatch_t *b = &s_batches[i];
+    if (b->state == SD_ARCHIVE_BATCH_SEALED &&
+        (next == NULL || (int32_t)(b->seal_seq - next->seal_seq) < 0)) {
+      next = b;
+    }
+  }
+  xSemaphoreGive(s_mutex);
+  return next;
+}
+
+static void sd_archive_task(void *argument) {
+  SdArchiveBatch_t *batch;
+
+  (void)argument;
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+
+    while ((batch = sd_archive_next_sealed()) != NULL) {
+      sd_archive_write_sealed(batch);
+    }
+    if (s_mounted) {
+      bool force = s_flush_request;
+      s_flush_request = false;
+      sd_archive_flush_active(force);
+    }
+  }
+}
+
+/* 封存批 (持有 s_mutex) */
+static void sd_archive_seal(SdArchiveBatch_t *batch) {
+  batch->state = SD_ARCHIVE_BATCH_SEALED;
+  batch->seal_seq = s_seal_seq++;
+  s_active = NULL;
+}
+
+/* 取空闲批开始接收 (持有 s_mutex) */
+static SdArchiveBatch_t *sd_archive_take_free(uint32_t day) {
+  for (uint32_t i = 0; i < 2; i++) {
+    SdArchiveBatch_t *b = &s_batches[i];
+    if (b->state == SD_ARCHIVE_BATCH_FREE) {
+      memset(b->data, 0xFF, sizeof(b->data));
+      b->state = SD_ARCHIVE_BATCH_FILLING;
+      b->pages = 0;
+      b->flushed = 0;
+      b->day = day;
+      b->sector = 0;
+      b->opened = xTaskGetTickCount();
+      s_active = b;
+      return b;
+    }
+  }
+  return NULL;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化
+ */
+bool SdArchive_Init(void) {
+  if (s_ready) {
+    return true;
+  }
+  if (!SdCard_Init()) {
+    return false;
+  }
+  if (!Fat32_Mount(&s_volume)) {
+    LOG_WARN("SD 卡不是 FAT32 卷，不归档");
+    return false;
+  }
+  if (s_volume.cluster_sectors * SDCARD_SECTOR_SIZE > SD_ARCHIVE_FILE_SIZE ||
+      SD_ARCHIVE_FILE_SIZE % (s_volume.cluster_sectors * SDCARD_SECTOR_SIZE) != 0) {
+    LOG_WARN("簇大小 %u KB 不适合归档", s_volume.cluster_sectors / 2);
+    return false;
+  }
+
+  s_mutex = xSemaphoreCreateMutexStatic(&s_mutex_buf);
+  TaskPlan_WatchMutex(s_mutex, "sdarc", 1); // 只保护一页复制
+  s_stats.batches_total = SD_ARCHIVE_BATCHES_PER_FILE;
+  s_stats.mounted = true;
+  s_mounted = true;
+
+  /* 打开文件 (续写定位、建文件与预擦除) 在归档任务中第一次写卡时进行 */
+  s_task = xTaskCreateStatic(sd_archive_task, "sdarc", SD_ARCHIVE_TASK_STACK_SIZE,
+                             NULL, SD_ARCHIVE_TASK_PRIORITY, s_task_stack,
+                             &s_task_tcb);
+  s_ready = true;
+  LOG_INFO("SD 卡归档已启动: 每簇 %u 扇区, 文件 %lu KB",
+           s_volume.cluster_sectors, (unsigned long)(SD_ARCHIVE_FILE_SIZE >> 10));
+  return true;
+}
+
+/**
+ * @brief 追加一页
+ */
+void SdArchive_AppendPage(const void *page, uint32_t len) {
+  SdArchiveBatch_t *batch;
+  uint32_t day;
+  bool sealed = false;
+
+  if (!s_ready || len != SD_ARCHIVE_PAGE_SIZE) {
+    return;
+  }
+  day = sd_archive_today();
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  s_stats.pages_appended++;
+  batch = s_active;
+  if (batch != NULL && batch->day != day) {
+    sd_archive_seal(batch); // 跨天：新的一页进当天的文件
+    batch = NULL;
+    sealed = true;
+  }
+  if (batch == NULL && s_mounted) {
+    batch = sd_archive_take_free(day);
+  }
+  if (batch == NULL) {
+    s_stats.pages_dropped++;
+  } else {
+    memcpy((uint8_t *)batch->data + batch->pages * SD_ARCHIVE_PAGE_SIZE, page,
+           SD_ARCHIVE_PAGE_SIZE);
+    if (++batch->pages == SD_ARCHIVE_BATCH_PAGES) {
+      sd_archive_seal(batch);
+      sealed = true;
+    }
+  }
+  xSemaphoreGive(s_mutex);
+
+  if (sealed) {
+    xTaskNotifyGive(s_task);
+  }
+}
+
+/**
+ * @brief 请求立即写出
+ */
+void SdArchive_RequestFlush(void) {
+  if (s_ready) {
+    s_flush_request = true;
+    xTaskNotifyGive(s_task);
+  }
+}
+
+/**
+ * @brief 获取统计
+ */
+void SdArchive_GetStats(SdArchive_Stats_t *stats) {
+  *stats = s_stats;
+}
@@ -0,0 +1,91 @@
+/**
+ ******************************************************************************
+ * @file    sd_archive.h
+ * @brief   传感器记录 SD 卡归档服务
+ * @details 把数据记录服务写入 SPI Flash 的每一页 (256 字节) 同时归档到
+ *          microSD 卡，Flash 环形区被覆盖后历史数据仍保留在卡上：
+ *            - 页先追加到 RAM 中的批缓冲区 (8 KB，32 页)，两块缓冲区
+ *              轮换，一块写卡时另一块继续接收；
+ *            - 写满的批以一次多块写 (ACMD23 + CMD25) 写入卡上文件，
+ *              写入位置按批对齐，SD 卡每次都写整段闪存页，写放大最小；
+ *            - 未写满的批超过 SD_ARCHIVE_MAX_BATCH_AGE_S 也写到卡上
+ *              (写满后原位重写)，掉电最多丢失这段时间的数据；
+ *            - 每天一个文件 "YYYYMMDD.Lnn" (RTC 未设置时为 NOCLOCK.Lnn)，
+ *              创建时一次分配 SD_ARCHIVE_FILE_SIZE 的连续簇并预擦除，
+ *              写满后 nn 加一；重启后在文件中二分查找第一个空批位置续写。
+ *          文件内容与 Flash 中的页格式相同 (见 sensor_log.c)，未写入的
+ *          部分为擦除值，读取工具按页头魔数与 CRC 跳过。
+ *          卡座与 Wi-Fi 模块 (UART5)、硬件 I2C3 触摸共用引脚，两者启用时
+ *          不启动归档。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SD_ARCHIVE_H
+#define __SD_ARCHIVE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SD_ARCHIVE_PAGE_SIZE 256            // 与 NORFLASH_PAGE_SIZE 相同
+#define SD_ARCHIVE_BATCH_PAGES 32           // 每批页数 (8 KB，16 个扇区)
+#define SD_ARCHIVE_FILE_SIZE (4UL << 20)     // 每个文件的预分配大小 (簇大小的整数倍)
+#define SD_ARCHIVE_MAX_BATCH_AGE_S 60       // 未写满的批最长在 RAM 中停留的时间
+#define SD_ARCHIVE_TASK_STACK_SIZE 320      // 归档任务栈大小 (单位: 字)
+#define SD_ARCHIVE_TASK_PRIORITY TASK_PRIO_ARCHIVE
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 归档统计
+ */
+typedef struct {
+  bool mounted;             // 卡与文件系统可用
+  char file[13];            // 当前文件名 (未打开时为空)
+  uint16_t batches_used;    // 当前文件已用的批位置
+  uint16_t batches_total;   // 每个文件的批位置数
+  uint32_t pages_appended;  // 交给归档的页数
+  uint32_t pages_written;   // 写到卡上的页数 (满批)
+  uint32_t pages_dropped;   // 两块缓冲区都在写卡 (或卡不可用) 时丢弃的页数
+  uint32_t batches_written; // 满批写入次数
+  uint32_t partial_flushes; // 未满批按时限写入次数
+  uint32_t files_created;   // 上电以来创建的文件数
+  uint32_t errors;          // 写入或建文件失败次数
+  uint32_t write_ms_max;    // 单批写入最长耗时 (ms)
+} SdArchive_Stats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化卡、挂载文件系统并创建归档任务
+ * @return false: 没有卡或不是 FAT32 (不影响其他功能)
+ */
+bool SdArchive_Init(void);
+
+/**
+ * @brief 追加一页 (数据记录服务每写入 Flash 一页调用一次)
+ * @note  只复制到批缓冲区，不等待写卡
+ */
+void SdArchive_AppendPage(const void *page, uint32_t len);
+
+/**
+ * @brief 请求归档任务立即写出未满的批
+ */
+void SdArchive_RequestFlush(void);
+
+/**
+ * @brief 获取归档统计
+ */
+void SdArchive_GetStats(SdArchive_Stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SD_ARCHIVE_H */
@@ -0,0 +1,208 @@
+/**
+ ******************************************************************************
+ * @file    sensor_export.c
+ * @brief   传感器记录批量导出实现
+ * @details 第 k 个 DATA 帧 (序号 k) 固定包含区间内第 k * CHUNK ~ (k + 1) * CHUNK - 1
+ *          条记录，续传时跳过前 first_seq * CHUNK 条。START 帧的序号为
+ *          first_seq，END 帧的序号为最后一个 DATA 帧序号 + 1，其中的记录总数
+ *          包含续传时跳过的记录。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_export.h"
+#include "checksum.h"
+#include "printf_redirect.h"
+#include "sensor_log.h"
+#include "task_wdt.h"
+#include <string.h>
+
+/* --------------------------- 私有宏 --------------------------- */
+#define SENSOR_EXPORT_RECORD_LEN 10
+#define SENSOR_EXPORT_PAYLOAD_MAX                                              \
+  (4 + SENSOR_EXPORT_CHUNK_RECORDS * SENSOR_EXPORT_RECORD_LEN + 4)
+// COBS 每 254 字节最多增加 1 字节开销，另加首尾两个分隔符
+#define SENSOR_EXPORT_FRAME_MAX                                                \
+  (SENSOR_EXPORT_PAYLOAD_MAX + SENSOR_EXPORT_PAYLOAD_MAX / 254 + 1 + 2)
+// 样本帧: 公共头 (3) | 传感器 | 时间 (4) | 通道数 | float x N | CRC (4)
+#define SENSOR_EXPORT_SAMPLE_PAYLOAD_MAX (3 + 1 + 4 + 1 + SENSOR_MAX_CHANNELS * 4 + 4)
+
+/* --------------------------- 私有变量 --------------------------- */
+static uint8_t s_payload[SENSOR_EXPORT_PAYLOAD_MAX];
+static uint8_t s_frame[SENSOR_EXPORT_FRAME_MAX];
+
+// 样本帧由传感器任务发送，使用独立的缓冲区
+static uint8_t s_sample_payload[SENSOR_EXPORT_SAMPLE_PAYLOAD_MAX];
+static uint8_t s_sample_frame[SENSOR_EXPORT_SAMPLE_PAYLOAD_MAX +
+                              SENSOR_EXPORT_SAMPLE_PAYLOAD_MAX / 254 + 1 + 2];
+static uint16_t s_sample_seq;
+
+/* 一次导出的上下文 */
+typedef struct {
+  SensorHandle_t sensor;
+  uint32_t skip;    // 续传时跳过的记录数
+  uint32_t sent;    // 已发送的记录数
+  uint16_t seq;     // 当前 DATA 帧序号
+  uint8_t count;    // 当前 DATA 帧中的记录数
+} SensorExportCtx_t;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static uint8_t *put_u16(uint8_t *p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  return p + 2;
+}
+
+static uint8_t *put_u32(uint8_t *p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+  return p + 4;
+}
+
+/**
+ * @brief 为载荷加上 CRC、编码并整帧写入发送缓冲区
+ * @param payload 载荷 (其后须留出 4 字节 CRC 空间)
+ * @param len     载荷长度 (不含 CRC)
+ * @param frame   编码输出缓冲区
+ */
+static void sensor_export_encode(uint8_t *payload, size_t len, uint8_t *frame) {
+  size_t n;
+
+  put_u32(payload + len, CRC32_Compute(payload, len));
+  frame[0] = 0x00;
+  n = COBS_Encode(payload, len + 4, frame + 1);
+  frame[n + 1] = 0x00;
+  printf_write(frame, n + 2); // 缓冲区满时在此等待 DMA 发送
+}
+
+/**
+ * @brief 发送 s_payload 中的载荷
+ * @param len 载荷长度 (不含 CRC)
+ */
+static void sensor_export_send(size_t len) {
+  sensor_export_encode(s_payload, len, s_frame);
+  TaskWdt_CheckIn(); // 导出可持续数分钟，每帧延续截止时间
+}
+
+/* 载荷公共头 */
+static uint8_t *sensor_export_header(uint8_t *payload, SensorExportFrame_t kind,
+                                     uint16_t seq) {
+  payload[0] = (uint8_t)kind;
+  return put_u16(payload + 1, seq);
+}
+
+static uint8_t *sensor_export_begin(SensorExportFrame_t kind, uint16_t seq) {
+  return sensor_export_header(s_payload, kind, seq);
+}
+
+static void sensor_export_flush_data(SensorExportCtx_t *ctx) {
+  if (ctx->count == 0) {
+    return;
+  }
+  s_payload[3] = ctx->count;
+  sensor_export_send(4 + (size_t)ctx->count * SENSOR_EXPORT_RECORD_LEN);
+  ctx->seq++;
+  ctx->count = 0;
+}
+
+static bool sensor_export_record(uint32_t time, const SensorLogRecord_t *rec,
+                                 void *user) {
+  SensorExportCtx_t *ctx = (SensorExportCtx_t *)user;
+  uint8_t *p;
+
+  if (ctx->sensor != SENSOR_TYPE_NONE &&
+      rec->type != (uint8_t)ctx->sensor) {
+    return true;
+  }
+  if (ctx->skip != 0) {
+    ctx->skip--;
+    return true;
+  }
+
+  if (ctx->count == 0) {
+    sensor_export_begin(SENSOR_EXPORT_FRAME_DATA, ctx->seq);
+  }
+  p = s_payload + 4 + (size_t)ctx->count * SENSOR_EXPORT_RECORD_LEN;
+  p = put_u32(p, time);
+  *p++ = rec->type;
+  *p++ = rec->flags;
+  p = put_u16(p, (uint16_t)rec->value[0]);
+  put_u16(p, (uint16_t)rec->value[1]);
+  ctx->sent++;
+
+  if (++ctx->count == SENSOR_EXPORT_CHUNK_RECORDS) {
+    sensor_export_flush_data(ctx);
+  }
+  return true;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 导出记录
+ */
+uint32_t SensorExport_Run(SensorHandle_t sensor, uint32_t t_start,
+                          uint32_t t_end, uint16_t first_seq) {
+  SensorExportCtx_t ctx;
+  uint8_t *p;
+
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.sensor = sensor;
+  ctx.skip = (uint32_t)first_seq * SENSOR_EXPORT_CHUNK_RECORDS;
+  ctx.seq = first_seq;
+
+  p = sensor_export_begin(SENSOR_EXPORT_FRAME_START, first_seq);
+  *p++ = SENSOR_EXPORT_VERSION;
+  *p++ = (uint8_t)sensor;
+  p = put_u32(p, t_start);
+  p = put_u32(p, t_end);
+  p = put_u16(p, first_seq);
+  *p++ = SENSOR_EXPORT_CHUNK_RECORDS;
+  // 帧格式每种传感器一个系数 (主机按它换算全部通道)，取通道 0 的系数
+  for (int t = SENSOR_TYPE_GY30; t < SENSOR_TYPE_MAX; t++) {
+    float scale = SensorTask_FixedScale((SensorType_t)t, 0);
+    uint32_t bits;
+    memcpy(&bits, &scale, sizeof(bits));
+    p = put_u32(p, bits);
+  }
+  sensor_export_send((size_t)(p - s_payload));
+
+  SensorLog_ForEach(t_start, t_end, sensor_export_record, &ctx);
+  sensor_export_flush_data(&ctx);
+
+  p = sensor_export_begin(SENSOR_EXPORT_FRAME_END, ctx.seq);
+  *p++ = 0; // 状态: 完成
+  p = put_u32(p, (uint32_t)first_seq * SENSOR_EXPORT_CHUNK_RECORDS + ctx.sent);
+  sensor_export_send((size_t)(p - s_payload));
+  printf_flush();
+
+  return ctx.sent;
+}
+
+/**
+ * @brief 发送一个原始样本帧
+ */
+void SensorExport_Sample(SensorHandle_t sensor, uint32_t time_ms,
+                         const float *values, uint8_t count) {
+  uint8_t *p;
+
+  if (count > SENSOR_MAX_CHANNELS) {
+    count = SENSOR_MAX_CHANNELS;
+  }
+  p = sensor_export_header(s_sample_payload, SENSOR_EXPORT_FRAME_SAMPLE,
+                           s_sample_seq++);
+  *p++ = (uint8_t)sensor;
+  p = put_u32(p, time_ms);
+  *p++ = count;
+  for (uint8_t ch = 0; ch < count; ch++) {
+    uint32_t bits;
+    memcpy(&bits, &values[ch], sizeof(bits));
+    p = put_u32(p, bits);
+  }
+  sensor_export_encode(s_sample_payload, (size_t)(p - s_sample_payload),
+                       s_sample_frame);
+}
@@ -0,0 +1,73 @@
+/**
+ ******************************************************************************
+ * @file    sensor_export.h
+ * @brief   传感器记录批量导出 (串口二进制帧)
+ * @details 把外部 Flash 中的传感器记录以二进制帧经 printf 的 DMA 发送环形
+ *          缓冲区输出，由主机端 sensor_export.py 解码为 CSV：
+ *            - 帧格式 0x00 | COBS(载荷 | CRC-32) | 0x00，帧内不含 0x00，
+ *              与文本日志混在同一串口上也能可靠分帧；
+ *            - 载荷 [帧类型 | 序号 (2 字节) | 内容]，START 帧给出区间与
+ *              定点缩放系数，每个 DATA 帧固定 SENSOR_EXPORT_CHUNK_RECORDS 条
+ *              记录 (最后一帧可以更少)，END 帧给出总数；
+ *            - 同一区间的记录顺序固定，主机发现序号缺失或 CRC 错误时，
+ *              以相同区间和 first_seq 重新请求即可从该帧继续 (断点续传)。
+ *          另有独立的 SAMPLE 帧，逐个输出驱动读出的原始通道值 (数据回放的
+ *          录制端，见 sensor_replay.h)。
+ *          多字节字段均为小端。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_EXPORT_H
+#define __SENSOR_EXPORT_H
+
+#include "sensor_task.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_EXPORT_VERSION 1         // 协议版本
+#define SENSOR_EXPORT_CHUNK_RECORDS 24  // 每个 DATA 帧的记录数
+
+/* --------------------------- 帧类型 --------------------------- */
+typedef enum {
+  SENSOR_EXPORT_FRAME_START = 1, // 版本 | 传感器 | t_start | t_end | first_seq | 每帧记录数 | 缩放系数 x3 (float)
+  SENSOR_EXPORT_FRAME_DATA,      // 记录数 | 记录 x N [时间 (4) | 类型 | 标志 | 主值 (2) | 次值 (2)]
+  SENSOR_EXPORT_FRAME_END,       // 状态 | 区间内记录总数 (4)
+  SENSOR_EXPORT_FRAME_SAMPLE     // 传感器 | 时间 ms (4) | 通道数 | 通道值 x N (float)，序号连续递增
+} SensorExportFrame_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 导出 [t_start, t_end] 内的记录 (阻塞到全部写入发送缓冲区)
+ * @param sensor    传感器实例句柄，SENSOR_TYPE_NONE 表示全部
+ * @param t_start   起始日志时间 (s)
+ * @param t_end     结束日志时间 (s)
+ * @param first_seq 第一个要发送的 DATA 帧序号 (0 为从头开始)
+ * @return 本次发送的记录数
+ * @note  在命令行任务中调用，不可重入
+ */
+uint32_t SensorExport_Run(SensorHandle_t sensor, uint32_t t_start,
+                          uint32_t t_end, uint16_t first_seq);
+
+/**
+ * @brief 发送一个原始样本帧 (SENSOR_EXPORT_FRAME_SAMPLE)
+ * @param sensor  实例句柄
+ * @param time_ms 样本时刻 (上电以来的 ms)
+ * @param values  通道值
+ * @param count   通道数
+ * @note  只由传感器任务调用，与 SensorExport_Run 使用不同的缓冲区
+ */
+void SensorExport_Sample(SensorHandle_t sensor, uint32_t time_ms,
+                         const float *values, uint8_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_EXPORT_H */
@@ -0,0 +1,205 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    sensor_export.py
+@brief   传感器记录批量导出工具 (与 sensor_export.c 配套)
+@details 通过命令行串口发送 export 命令，把 COBS 分帧的二进制记录解码为 CSV。
+         帧格式见 sensor_export.h；帧之间夹杂的文本日志被忽略。
+         --fast 在导出期间切换到更高波特率 (baud 命令的确认握手)，结束后恢复。
+         发现序号缺失或 CRC 错误的帧时，以相同区间从第一个缺失的帧重新请求。
+
+用法:
+    python sensor_export.py COM5 -o data.csv                 # 导出全部记录
+    python sensor_export.py COM5 --fast 921600 --minutes 1440 -o day.csv
+    python sensor_export.py COM5 --sensor sht30 -o sht30.csv
+    python sensor_export.py capture.bin -o data.csv          # 解码抓包文件
+
+@author  MmsY
+@time    2025/11/23
+"""
+
+import argparse
+import csv
+import re
+import struct
+import sys
+import time
+import zlib
+
+FRAME_START, FRAME_DATA, FRAME_END = 1, 2, 3
+SENSOR_NAMES = {1: "gy30", 2: "sht30", 3: "mq2"}
+FLAG_SECONDARY = 0x01
+RECORD = struct.Struct("<IBBhh")
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data) + 1:
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def parse_frame(chunk):
+    """返回 (类型, 序号, 内容)，不是有效帧时返回 None"""
+    payload = cobs_decode(chunk)
+    if payload is None or len(payload) < 7:
+        return None
+    body, crc = payload[:-4], struct.unpack_from("<I", payload, len(payload) - 4)[0]
+    if zlib.crc32(body) & 0xFFFFFFFF != crc:
+        return None
+    return body[0], struct.unpack_from("<H", body, 1)[0], body[3:]
+
+
+class Session:
+    """收集一次 (可能多次续传的) 导出结果"""
+
+    def __init__(self):
+        self.start = None   # (sensor, t_start, t_end, chunk, scales)
+        self.chunks = {}    # 序号 -> 记录列表
+        self.end_seq = None
+        self.total = None
+
+    def feed(self, frame):
+        kind, seq, body = frame
+        if kind == FRAME_START:
+            _ver, sensor, t0, t1, _first, chunk = struct.unpack_from("<BBIIHB", body)
+            scales = struct.unpack_from("<3f", body, 13)
+            self.start = (sensor, t0, t1, chunk, scales)
+        elif kind == FRAME_DATA:
+            n = body[0]
+            self.chunks[seq] = [RECORD.unpack_from(body, 1 + i * RECORD.size)
+                                for i in range(n)]
+        elif kind == FRAME_END:
+            self.end_seq = seq
+            self.total = struct.unpack_from("<I", body, 1)[0]
+            return True
+        return False
+
+    def missing(self):
+        if self.end_seq is None:
+            return [max(self.chunks) + 1 if self.chunks else 0]
+        return [s for s in range(self.end_seq) if s not in self.chunks]
+
+    def write_csv(self, out):
+        scales = self.start[4] if self.start else (0.5, 100.0, 1.0)
+        w = csv.writer(out)
+        w.writerow(["time_s", "sensor", "value", "value2"])
+        for seq in sorted(self.chunks):
+            for t, sensor, flags, v0, v1 in self.chunks[seq]:
+                kind, index = sensor & 0x0F, sensor >> 4
+                scale = scales[kind - 1] if 1 <= kind <= 3 else 1.0
+                name = SENSOR_NAMES.get(kind, str(kind))
+                if index:
+                    name += ":%d" % index
+                w.writerow([t, name,
+                            "%g" % (v0 / scale),
+                            "%g" % (v1 / scale) if flags & FLAG_SECONDARY else ""])
+
+
+def read_frames(read, session):
+    """读取并分帧，直到 END 帧或数据读完"""
+    buf = bytearray()
+    while True:
+        data = read()
+        if not data:
+            return False
+        buf += data
+        while True:
+            i = buf.find(b"\0")
+            if i < 0:
+                break
+            chunk = bytes(buf[:i])
+            del buf[:i + 1]
+            frame = parse_frame(chunk) if chunk else None
+            if frame and session.feed(frame):
+                return True
+
+
+def command(port, line, expect=None, timeout=2.0):
+    """发送一行命令，返回收到的文本 (直到出现 expect 或超时)"""
+    port.reset_input_buffer()
+    port.write((line + "\r\n").encode())
+    text = b""
+    deadline = time.time() + timeout
+    while time.time() < deadline:
+        text += port.read(port.in_waiting or 1)
+        if expect and expect.encode() in text:
+            break
+    return text.decode("utf-8", "replace")
+
+
+def switch_baud(port, rate):
+    """切换波特率：板子回复后切换，主机须在 3 s 内以新波特率确认，否则板子恢复原值"""
+    if "ok" not in command(port, "baud %d" % rate, "\n"):
+        sys.exit("baud %d rejected" % rate)
+    time.sleep(0.05)
+    port.baudrate = rate
+    if "saved" not in command(port, "baud ok", "saved"):
+        sys.exit("baud %d not confirmed" % rate)
+
+
+def export_serial(opts, session):
+    import serial  # pyserial
+    port = serial.Serial(opts.source, opts.baud, timeout=1)
+
+    if opts.fast and opts.fast != opts.baud:
+        switch_baud(port, opts.fast)
+
+    m = re.search(r"now=(\d+)s oldest=(\d+)s", command(port, "datalog stats", "errors="))
+    if not m:
+        sys.exit("datalog not ready")
+    now, oldest = int(m.group(1)), int(m.group(2))
+    t0 = max(oldest, now - opts.minutes * 60) if opts.minutes else oldest
+
+    seq = 0
+    for attempt in range(opts.retries + 1):
+        port.reset_input_buffer()
+        port.write(("export %s %d %d %d\r\n" % (opts.sensor, t0, now, seq)).encode())
+        read_frames(lambda: port.read(port.in_waiting or 1), session)
+        todo = session.missing()
+        if not todo:
+            break
+        seq = todo[0]
+        print("resume from frame %d (attempt %d)" % (seq, attempt + 1), file=sys.stderr)
+
+    if opts.fast and opts.fast != opts.baud:
+        switch_baud(port, opts.baud)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="EnviroSense sensor log exporter")
+    ap.add_argument("source", help="串口名或抓包文件")
+    ap.add_argument("-o", "--output", help="CSV 输出文件，缺省为 stdout")
+    ap.add_argument("-b", "--baud", type=int, default=115200, help="当前波特率")
+    ap.add_argument("--fast", type=int, help="导出期间切换到的波特率 (如 921600)")
+    ap.add_argument("--sensor", default="all", help="gy30/sht30/mq2/all")
+    ap.add_argument("--minutes", type=int, help="只导出最近 N 分钟")
+    ap.add_argument("--retries", type=int, default=3)
+    opts = ap.parse_args()
+
+    session = Session()
+    try:
+        with open(opts.source, "rb") as f:
+            read_frames(lambda: f.read(4096), session)
+    except OSError:
+        export_serial(opts, session)
+
+    if session.total is not None:
+        got = sum(len(v) for v in session.chunks.values())
+        print("%d/%d records" % (got, session.total), file=sys.stderr)
+    if opts.output:
+        with open(opts.output, "w", newline="") as out:
+            session.write_csv(out)
+    else:
+        session.write_csv(sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,791 @@
+/**
+ ******************************************************************************
+ * @file    sensor_log.c
+ * @brief   传感器数据记录服务实现
+ * @details 页格式 (256 字节):
+ *            页头  [魔数 | 记录数 | CRC-8 | 保留 | 基准时间 (4 字节)]
+ *            记录  31 x SensorLogRecord_t，未用部分保持 0xFF
+ *          CRC 以 CRC 字段为 0 计算整页。页头全为 0xFF 表示已擦除。
+ *          挂载时读取每个扇区首页的页头，基准时间最大的扇区为写入扇区，
+ *          在其中找到第一个已擦除页作为写入位置。
+ *          外部 SRAM 镜像按扇区号直接映射到 SENSOR_LOG_MIRROR_SECTORS 个槽位，
+ *          槽位标签记录当前镜像的扇区号。擦除扇区时先作废标签、填 0xFF 再
+ *          写入新标签，写页成功后复制到槽位，写失败则作废整个槽位回退到 Flash。
+ *          查询只直接访问落后写入扇区不超过 SENSOR_LOG_MIRROR_SECTORS - 2 个
+ *          扇区的页，留出一个扇区的余量，访问期间不会被新扇区覆盖。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_log.h"
+#include "checksum.h"
+#include "norflash.h"
+#include "sd_archive.h"
+#include "sensor_event_bus.h"
+#include "sram.h"
+#include "sys_clock.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+#include "task_plan.h"
+#include <stddef.h>
+#include <string.h>
+
+#define LOG_MODULE "SLOG"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define SENSOR_LOG_PAGE_MAGIC 0xA5
+#define SENSOR_LOG_HEADER_LEN 8
+#define SENSOR_LOG_RECORDS_PER_PAGE                                            \
+  ((NORFLASH_PAGE_SIZE - SENSOR_LOG_HEADER_LEN) / sizeof(SensorLogRecord_t))
+#define SENSOR_LOG_PAGES_PER_SECTOR (NORFLASH_SECTOR_SIZE / NORFLASH_PAGE_SIZE)
+#define SENSOR_LOG_SECTORS (SENSOR_LOG_FLASH_SIZE / NORFLASH_SECTOR_SIZE)
+#define SENSOR_LOG_END (SENSOR_LOG_FLASH_ADDR + SENSOR_LOG_FLASH_SIZE)
+#define SENSOR_LOG_INDEX_SIZE (SENSOR_LOG_SECTORS / SENSOR_LOG_INDEX_STRIDE)
+#define SENSOR_LOG_NO_TIME UINT32_MAX // 索引项: 扇区为空
+#define SENSOR_LOG_MIRROR_BASE                                                 \
+  (SRAM_BASE_ADDR + SRAM_SIZE - SENSOR_LOG_MIRROR_SECTORS * NORFLASH_SECTOR_SIZE)
+#define SENSOR_LOG_MIRROR_SLOTS                                                \
+  (SENSOR_LOG_MIRROR_SECTORS > 0 ? SENSOR_LOG_MIRROR_SECTORS : 1)
+#define SENSOR_LOG_MIRROR_NONE 0xFFFFU // 槽位标签: 未镜像
+
+typedef struct {
+  uint8_t magic;
+  uint8_t count;
+  uint8_t crc;
+  uint8_t reserved;
+  uint32_t base_time;
+  SensorLogRecord_t records[SENSOR_LOG_RECORDS_PER_PAGE];
+} SensorLogPage_t;
+
+/* 查询中正在累积的桶 */
+typedef struct {
+  uint32_t time;
+  uint32_t n;
+  int32_t sum[2];
+  int16_t min[2];
+  int16_t max[2];
+} SensorLogAcc_t;
+
+/* 一次查询的上下文 */
+typedef struct {
+  SensorHandle_t type;
+  uint32_t t_start;
+  uint32_t t_end;
+  uint32_t resolution;
+  SensorLogQueryCb_t cb;
+  void *user;
+  SensorLogAcc_t acc;
+  uint32_t points;
+  bool stop;
+} SensorLogQuery_t;
+
+/* SensorLog_ForEach 的上下文 */
+typedef struct {
+  SensorLogRecordCb_t cb;
+  void *user;
+  uint32_t count;
+} SensorLogForEach_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static bool s_ready = false;
+static uint32_t s_time_base; // 日志时间 = s_time_base + SysClock_Seconds()
+
+/* 以下只在持有 s_mutex 时访问 */
+static SensorLogPage_t s_batch; // 正在攒的页
+static SensorLogPage_t s_page;  // 挂载与预擦时读取页头的缓冲区
+
+/* 稀疏时间索引：第 i 项为扇区 i * SENSOR_LOG_INDEX_STRIDE 首页的基准时间，
+ * 只由持有 s_mutex 的一方修改，查询按字读取无需加锁 */
+static volatile uint32_t s_index[SENSOR_LOG_INDEX_SIZE];
+
+/* 查询互斥执行，共用读取缓冲区 */
+static SensorLogPage_t s_query_page;
+static SensorLogPage_t s_query_batch;
+static uint32_t s_mapped_pages;
+static uint32_t s_read_pages;
+
+/* 外部 SRAM 镜像：标签只由持有 s_mutex 的一方修改，查询按半字读取无需加锁 */
+static bool s_mirror_ready = false;
+static volatile uint16_t s_mirror_tag[SENSOR_LOG_MIRROR_SLOTS];
+static SemaphoreHandle_t s_query_mutex = NULL;
+static StaticSemaphore_t s_query_mutex_buf;
+static uint32_t s_write_addr;   // 下一页的写入地址 (查询按字读取)
+static bool s_head_erased;      // s_write_addr 所在扇区的剩余部分已擦除
+static bool s_empty;            // 日志区中还没有任何页
+static SensorLogStats_t s_stats;
+
+static SemaphoreHandle_t s_mutex = NULL;
+static StaticSemaphore_t s_mutex_buf;
+static SensorEventSub_t s_sub = -1;
+
+static TaskHandle_t s_task = NULL;
+static StaticTask_t s_task_tcb;
+static StackType_t s_task_stack[SENSOR_LOG_TASK_STACK_SIZE];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/* 以 CRC 字段为 0 计算整页 (分段计算，镜像中的页只读访问) */
+static uint8_t sensor_log_page_crc(const SensorLogPage_t *page) {
+  const uint8_t *p = (const uint8_t *)page;
+  const uint8_t zero = 0;
+  const size_t at = offsetof(SensorLogPage_t, crc);
+  uint8_t crc;
+
+  crc = CRC8_Update(CRC8_INIT, p, at);
+  crc = CRC8_Update(crc, &zero, 1);
+  return CRC8_Update(crc, p + at + 1, sizeof(*page) - at - 1);
+}
+
+static bool sensor_log_page_erased(const SensorLogPage_t *page) {
+  const uint8_t *p = (const uint8_t *)page;
+
+  for (int i = 0; i < SENSOR_LOG_HEADER_LEN; i++) {
+    if (p[i] != 0xFF) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool sensor_log_header_valid(const SensorLogPage_t *page) {
+  return page->magic == SENSOR_LOG_PAGE_MAGIC && page->count != 0 &&
+         page->count <= SENSOR_LOG_RECORDS_PER_PAGE;
+}
+
+static uint32_t sensor_log_sector_of(uint32_t addr) {
+  return (addr - SENSOR_LOG_FLASH_ADDR) / NORFLASH_SECTOR_SIZE;
+}
+
+static uint32_t sensor_log_sector_addr(uint32_t sector) {
+  return SENSOR_LOG_FLASH_ADDR + sector * NORFLASH_SECTOR_SIZE;
+}
+
+/* 扇区首页写入或擦除后更新稀疏索引 */
+static void sensor_log_index_update(uint32_t sector, uint32_t time) {
+  if (sector % SENSOR_LOG_INDEX_STRIDE == 0) {
+    s_index[sector / SENSOR_LOG_INDEX_STRIDE] = time;
+  }
+}
+
+static uint8_t *sensor_log_mirror_slot(uint32_t sector) {
+  return (uint8_t *)SENSOR_LOG_MIRROR_BASE +
+         (sector % SENSOR_LOG_MIRROR_SLOTS) * NORFLASH_SECTOR_SIZE;
+}
+
+/* 扇区擦除后同步镜像 (调用方持有 s_mutex) */
+static void sensor_log_mirror_erase(uint32_t sector) {
+  uint32_t slot = sector % SENSOR_LOG_MIRROR_SLOTS;
+
+  if (!s_mirror_ready) {
+    return;
+  }
+  s_mirror_tag[slot] = SENSOR_LOG_MIRROR_NONE; // 先作废，查询回退到 Flash
+  __DMB();
+  memset(sensor_log_mirror_slot(sector), 0xFF, NORFLASH_SECTOR_SIZE);
+  __DMB();
+  s_mirror_tag[slot] = (uint16_t)sector;
+}
+
+/* 写页后同步镜像，写失败时 Flash 中该页内容不确定，作废整个槽位 */
+static void sensor_log_mirror_write(uint32_t addr, const SensorLogPage_t *page,
+                                    bool ok) {
+  uint32_t sector = sensor_log_sector_of(addr);
+  uint32_t slot = sector % SENSOR_LOG_MIRROR_SLOTS;
+
+  if (!s_mirror_ready || s_mirror_tag[slot] != sector) {
+    return;
+  }
+  if (!ok) {
+    s_mirror_tag[slot] = SENSOR_LOG_MIRROR_NONE;
+    return;
+  }
+  memcpy(sensor_log_mirror_slot(sector) + addr % NORFLASH_SECTOR_SIZE, page,
+         sizeof(*page));
+}
+
+/**
+ * @brief 挂载后把写入扇区及之前的扇区读入镜像
+ * @details 只填充查询会直接访问的 SENSOR_LOG_MIRROR_SECTORS - 1 个扇区，
+ *          Flash 直接读入 SRAM，不经中间缓冲
+ */
+static void sensor_log_mirror_fill(void) {
+  uint32_t head_sector = sensor_log_sector_of(s_write_addr);
+
+  for (uint32_t slot = 0; slot < SENSOR_LOG_MIRROR_SLOTS; slot++) {
+    s_mirror_tag[slot] = SENSOR_LOG_MIRROR_NONE;
+  }
+  for (uint32_t d = 0; d + 1 < SENSOR_LOG_MIRROR_SECTORS; d++) {
+    uint32_t sector = (head_sector + SENSOR_LOG_SECTORS - d) % SENSOR_LOG_SECTORS;
+
+    if (norflash_read(sensor_log_sector_addr(sector),
+                      sensor_log_mirror_slot(sector),
+                      NORFLASH_SECTOR_SIZE) == 0) {
+      s_mirror_tag[sector % SENSOR_LOG_MIRROR_SLOTS] = (uint16_t)sector;
+    }
+  }
+}
+
+/**
+ * @brief 取得一页供查询只读访问 (调用方持有 s_query_mutex)
+ * @param len 需要的字节数 (页头或整页)
+ * @return 镜像中扇区的页直接返回 SRAM 地址，否则读入 s_query_page；
+ *         读取失败返回 NULL
+ * @note  距离按当前写入位置计算，每页访问前重新判断
+ */
+static const SensorLogPage_t *sensor_log_map_page(uint32_t addr, uint32_t len) {
+  uint32_t sector = sensor_log_sector_of(addr);
+  uint32_t head_sector = sensor_log_sector_of(s_write_addr);
+  uint32_t behind = (head_sector + SENSOR_LOG_SECTORS - sector) % SENSOR_LOG_SECTORS;
+
+  if (s_mirror_ready && behind + 1 < SENSOR_LOG_MIRROR_SECTORS &&
+      s_mirror_tag[sector % SENSOR_LOG_MIRROR_SLOTS] == sector) {
+    s_mapped_pages++;
+    return (const SensorLogPage_t *)(sensor_log_mirror_slot(sector) +
+                                     addr % NORFLASH_SECTOR_SIZE);
+  }
+  if (norflash_read(addr, (uint8_t *)&s_query_page, len) != 0) {
+    return NULL;
+  }
+  s_read_pages++;
+  return &s_query_page;
+}
+
+static void sensor_log_reset_batch(void) {
+  memset(&s_batch, 0xFF, sizeof(s_batch));
+  s_batch.count = 0;
+}
+
+/* 擦除写入位置所在扇区 (写满一个扇区后预擦下一个，擦除会丢掉最旧的数据) */
+static void sensor_log_prepare_head(void) {
+  uint32_t next;
+
+  if (s_head_erased) {
+    return;
+  }
+  if (norflash_erase_sector(s_write_addr) != 0) {
+    s_stats.errors++;
+    return; // 下一次写入前重试
+  }
+  s_head_erased = true;
+  s_stats.sectors_erased++;
+  sensor_log_index_update(sensor_log_sector_of(s_write_addr), SENSOR_LOG_NO_TIME);
+  sensor_log_mirror_erase(sensor_log_sector_of(s_write_addr));
+
+  /* 被覆盖的是最旧的扇区，最旧时间前移到下一个扇区 */
+  next = s_write_addr + NORFLASH_SECTOR_SIZE;
+  if (next >= SENSOR_LOG_END) {
+    next = SENSOR_LOG_FLASH_ADDR;
+  }
+  if (norflash_read(next, (uint8_t *)&s_page, SENSOR_LOG_HEADER_LEN) == 0 &&
+      sensor_log_header_valid(&s_page)) {
+    s_stats.oldest_time = s_page.base_time;
+  }
+}
+
+/* 整页写入当前批次并清空 (调用方持有 s_mutex) */
+static bool sensor_log_write_batch(void) {
+  bool ok;
+
+  if (s_batch.count == 0) {
+    return true;
+  }
+
+  sensor_log_prepare_head();
+  s_batch.magic = SENSOR_LOG_PAGE_MAGIC;
+  s_batch.crc = sensor_log_page_crc(&s_batch);
+  ok = s_head_erased &&
+       norflash_write(s_write_addr, (const uint8_t *)&s_batch,
+                      sizeof(s_batch)) == 0;
+  if (s_head_erased) {
+    sensor_log_mirror_write(s_write_addr, &s_batch, ok);
+  }
+
+  if (ok) {
+    if (s_write_addr % NORFLASH_SECTOR_SIZE == 0) {
+      sensor_log_index_update(sensor_log_sector_of(s_write_addr),
+                              s_batch.base_time);
+    }
+    if (s_empty) {
+      s_empty = false;
+      s_stats.oldest_time = s_batch.base_time;
+    }
+    s_stats.pages_written++;
+    s_stats.records += s_batch.count;
+    SdArchive_AppendPage(&s_batch, sizeof(s_batch)); // 未启用时直接返回
+  } else {
+    s_stats.errors++; // 该页作废，数据丢弃
+  }
+
+  /* 写坏的页也跳过，避免反复编程同一位置 */
+  s_write_addr += NORFLASH_PAGE_SIZE;
+  if (s_write_addr >= SENSOR_LOG_END) {
+    s_write_addr = SENSOR_LOG_FLASH_ADDR;
+  }
+  if (s_write_addr % NORFLASH_SECTOR_SIZE == 0) {
+    s_head_erased = false; // 由记录任务在下一条事件之前预擦
+  }
+  sensor_log_reset_batch();
+  return ok;
+}
+
+/* 追加一条样本 */
+static void sensor_log_append(const SensorSnapshot_t *snapshot) {
+  const SensorEvent_t *event = &snapshot->event;
+  uint32_t t = s_time_base + (uint32_t)(event->data.timestamp_us / 1000000U);
+  SensorLogRecord_t *rec;
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+
+  /* 偏移超出 16 位时另起一页 (仅在采样间隔极长时出现) */
+  if (s_batch.count != 0 && t - s_batch.base_time > UINT16_MAX) {
+    sensor_log_write_batch();
+  }
+  if (s_batch.count == 0) {
+    s_batch.base_time = t;
+  }
+
+  rec = &s_batch.records[s_batch.count++];
+  rec->dt = (uint16_t)(t - s_batch.base_time);
+  rec->type = (uint8_t)event->sensor;
+  rec->flags = snapshot->channel_count > 1 ? SENSOR_LOG_FLAG_SECONDARY : 0;
+  rec->value[0] = snapshot->fixed[0];
+  rec->value[1] = snapshot->fixed[1];
+
+  if (s_batch.count == SENSOR_LOG_RECORDS_PER_PAGE) {
+    sensor_log_write_batch();
+  }
+
+  xSemaphoreGive(s_mutex);
+}
+
+/**
+ * @brief 挂载：定位写入扇区与写入页，恢复日志时间
+ */
+static void sensor_log_mount(void) {
+  SensorLogPage_t *page = &s_page;
+  uint32_t newest_addr = 0;
+  uint32_t newest_time = 0;
+  uint32_t oldest_time = UINT32_MAX;
+  uint32_t last_time = 0;
+  bool found = false;
+
+  for (uint32_t i = 0; i < SENSOR_LOG_SECTORS; i++) {
+    uint32_t addr = sensor_log_sector_addr(i);
+
+    sensor_log_index_update(i, SENSOR_LOG_NO_TIME);
+    if (norflash_read(addr, (uint8_t *)page, SENSOR_LOG_HEADER_LEN) != 0 ||
+        !sensor_log_header_valid(page)) {
+      continue;
+    }
+    sensor_log_index_update(i, page->base_time);
+    if (!found || page->base_time >= newest_time) {
+      newest_time = page->base_time;
+      newest_addr = addr;
+    }
+    if (page->base_time < oldest_time) {
+      oldest_time = page->base_time;
+    }
+    found = true;
+  }
+
+  if (!found) {
+    s_write_addr = SENSOR_LOG_FLASH_ADDR;
+    s_head_erased = false;
+    s_time_base = 0;
+    s_stats.oldest_time = 0;
+    s_empty = true;
+    return;
+  }
+
+  /* 写入扇区内：最后一个有效页给出最新时间，第一个已擦除页为写入位置 */
+  s_write_addr = newest_addr + NORFLASH_SECTOR_SIZE;
+  for (uint32_t p = 0; p < SENSOR_LOG_PAGES_PER_SECTOR; p++) {
+    uint32_t addr = newest_addr + p * NORFLASH_PAGE_SIZE;
+
+    if (norflash_read(addr, (uint8_t *)page, sizeof(*page)) != 0) {
+      continue;
+    }
+    if (sensor_log_page_erased(page)) {
+      s_write_addr = addr;
+      break;
+    }
+    if (sensor_log_header_valid(page) &&
+        sensor_log_page_crc(page) == page->crc) {
+      last_time = page->base_time + page->records[page->count - 1].dt;
+    }
+  }
+
+  if (s_write_addr >= SENSOR_LOG_END) {
+    s_write_addr = SENSOR_LOG_FLASH_ADDR;
+  }
+  s_head_erased = s_write_addr % NORFLASH_SECTOR_SIZE != 0;
+  s_time_base = (last_time > newest_time ? last_time : newest_time) + 1;
+  s_stats.oldest_time = oldest_time;
+}
+
+/* 读取扇区首页基准时间，空扇区返回 SENSOR_LOG_NO_TIME */
+static uint32_t sensor_log_sector_time(uint32_t sector) {
+  const SensorLogPage_t *page;
+
+  if (sector % SENSOR_LOG_INDEX_STRIDE == 0) {
+    return s_index[sector / SENSOR_LOG_INDEX_STRIDE];
+  }
+  page = sensor_log_map_page(sensor_log_sector_addr(sector), SENSOR_LOG_HEADER_LEN);
+  if (page == NULL || !sensor_log_header_valid(page)) {
+    return SENSOR_LOG_NO_TIME;
+  }
+  return page->base_time;
+}
+
+/**
+ * @brief 定位包含 t_start 的扇区 (返回相对最旧扇区的逻辑序号)
+ * @details 逻辑序号 0 为写入扇区的下一个扇区 (最旧)，SENSOR_LOG_SECTORS - 1
+ *          为写入扇区。各扇区的时间沿逻辑序号递增，尚未写过的空扇区只会
+ *          出现在开头。先在稀疏索引中找到不晚于 t_start 的最后一项，
+ *          再向后读取至多 SENSOR_LOG_INDEX_STRIDE 个扇区页头。
+ */
+static uint32_t sensor_log_seek(uint32_t head_sector, uint32_t t_start) {
+  uint32_t best_time = 0;
+  uint32_t start = 0;
+  bool found = false;
+
+  for (uint32_t i = 0; i < SENSOR_LOG_INDEX_SIZE; i++) {
+    uint32_t time = s_index[i];
+    uint32_t sector = i * SENSOR_LOG_INDEX_STRIDE;
+
+    if (sector == head_sector || time == SENSOR_LOG_NO_TIME ||
+        time > t_start) {
+      continue; // 写入扇区由下面的逐扇区查找处理 (其索引可能尚未更新)
+    }
+    if (!found || time >= best_time) {
+      best_time = time;
+      start = (sector + SENSOR_LOG_SECTORS - head_sector - 1) % SENSOR_LOG_SECTORS;
+      found = true;
+    }
+  }
+
+  for (uint32_t l = start + 1;
+       l < SENSOR_LOG_SECTORS && l < start + SENSOR_LOG_INDEX_STRIDE; l++) {
+    uint32_t time =
+        sensor_log_sector_time((head_sector + 1 + l) % SENSOR_LOG_SECTORS);
+
+    if (time == SENSOR_LOG_NO_TIME) {
+      continue;
+    }
+    if (time > t_start) {
+      break;
+    }
+    start = l;
+  }
+  return start;
+}
+
+/* 输出当前桶 */
+static void sensor_log_query_emit(SensorLogQuery_t *q) {
+  SensorLogAcc_t *acc = &q->acc;
+  SensorLogPoint_t point;
+  uint8_t channels = SensorTask_GetChannels(q->type, NULL);
+
+  if (acc->n == 0) {
+    return;
+  }
+
+  memset(&point, 0, sizeof(point));
+  point.time = acc->time;
+  point.samples = acc->n > UINT16_MAX ? UINT16_MAX : (uint16_t)acc->n;
+  for (int c = 0; c < 2; c++) {
+    float scale = SensorTask_FixedScale(q->type, (uint8_t)c);
+    point.value[c].min = acc->min[c] / scale;
+    point.value[c].max = acc->max[c] / scale;
+    point.value[c].avg = (float)acc->sum[c] / (float)acc->n / scale;
+    point.value[c].valid = c < channels;
+  }
+
+  q->points++;
+  if (!q->cb(&point, q->user)) {
+    q->stop = true;
+  }
+  acc->n = 0;
+}
+
+/* 转交一条记录给 SensorLog_ForEach 的回调 */
+static bool sensor_log_foreach_record(uint32_t t, const SensorLogRecord_t *rec,
+                                      void *user) {
+  SensorLogForEach_t *ctx = (SensorLogForEach_t *)user;
+
+  ctx->count++;
+  return ctx->cb(t, rec, ctx->user);
+}
+
+/* 聚合一条属于查询传感器的记录 */
+static bool sensor_log_query_record(uint32_t t, const SensorLogRecord_t *rec,
+                                    void *user) {
+  SensorLogQuery_t *q = (SensorLogQuery_t *)user;
+  SensorLogAcc_t *acc = &q->acc;
+
+  if (rec->type != (uint8_t)q->type) {
+    return true;
+  }
+
+  if (q->resolution == 0) {
+    acc->time = t; // 逐条输出
+  } else {
+    uint32_t bucket = q->t_start + (t - q->t_start) / q->resolution * q->resolution;
+    if (acc->n != 0 && bucket != acc->time) {
+      sensor_log_query_emit(q);
+    }
+    acc->time = bucket;
+  }
+
+  for (int c = 0; c < 2; c++) {
+    int16_t v = rec->value[c];
+    if (acc->n == 0 || v < acc->min[c]) acc->min[c] = v;
+    if (acc->n == 0 || v > acc->max[c]) acc->max[c] = v;
+    acc->sum[c] = acc->n == 0 ? v : acc->sum[c] + v;
+  }
+  acc->n++;
+
+  if (q->resolution == 0) {
+    sensor_log_query_emit(q);
+  }
+  return !q->stop;
+}
+
+/* 遍历一页中属于区间的记录，返回 false 表示已超出区间或被中止 */
+static bool sensor_log_scan_page(const SensorLogPage_t *page, uint32_t t_start,
+                                 uint32_t t_end, SensorLogRecordCb_t visit,
+                                 void *user) {
+  for (uint8_t i = 0; i < page->count; i++) {
+    const SensorLogRecord_t *rec = &page->records[i];
+    uint32_t t = page->base_time + rec->dt;
+
+    if (t > t_end) {
+      return false;
+    }
+    if (t >= t_start && !visit(t, rec, user)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief 按时间顺序遍历 [t_start, t_end] 内的所有记录 (调用方持有 s_query_mutex)
+ * @details 只取写入位置与未满页的快照，Flash 读取期间不阻塞记录任务；
+ *          镜像中的页直接在 SRAM 中遍历
+ */
+static void sensor_log_scan(uint32_t t_start, uint32_t t_end,
+                            SensorLogRecordCb_t visit, void *user) {
+  uint32_t head_addr;
+  uint32_t head_sector;
+  bool more = true;
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  head_addr = s_write_addr;
+  s_query_batch = s_batch;
+  xSemaphoreGive(s_mutex);
+
+  head_sector = sensor_log_sector_of(head_addr);
+  for (uint32_t l = sensor_log_seek(head_sector, t_start);
+       more && l < SENSOR_LOG_SECTORS; l++) {
+    uint32_t sector = (head_sector + 1 + l) % SENSOR_LOG_SECTORS;
+    uint32_t addr = sensor_log_sector_addr(sector);
+
+    for (uint32_t p = 0; more && p < SENSOR_LOG_PAGES_PER_SECTOR;
+         p++, addr += NORFLASH_PAGE_SIZE) {
+      const SensorLogPage_t *page;
+
+      if (sector == head_sector && addr >= head_addr) {
+        break; // 写入位置之后尚未写入
+      }
+      page = sensor_log_map_page(addr, NORFLASH_PAGE_SIZE);
+      if (page == NULL || sensor_log_page_erased(page)) {
+        break; // 空扇区 (或最旧扇区正被预擦)
+      }
+      if (!sensor_log_header_valid(page) || sensor_log_page_crc(page) != page->crc) {
+        continue; // 写坏的页
+      }
+      if (page->base_time > t_end) {
+        more = false;
+        break;
+      }
+      more = sensor_log_scan_page(page, t_start, t_end, visit, user);
+    }
+  }
+
+  if (more && s_query_batch.count != 0) {
+    sensor_log_scan_page(&s_query_batch, t_start, t_end, visit, user);
+  }
+}
+
+/**
+ * @brief 记录任务：取出数据更新事件写入批次，按需预擦扇区与写出超时的批次
+ */
+static void sensor_log_task(void *argument) {
+  (void)argument;
+
+  for (;;) {
+    const SensorSnapshot_t *snapshot = SensorEventBus_Receive(s_sub, 1000);
+
+    if (snapshot != NULL) {
+      if (snapshot->event.event_type == SENSOR_EVENT_DATA_UPDATE &&
+          snapshot->event.data.is_valid) {
+        sensor_log_append(snapshot);
+      }
+      SensorEventBus_Release(snapshot);
+    }
+
+    xSemaphoreTake(s_mutex, portMAX_DELAY);
+    if (s_batch.count != 0 &&
+        SensorLog_Now() - s_batch.base_time >= SENSOR_LOG_MAX_BATCH_AGE_S) {
+      sensor_log_write_batch();
+    }
+    /* 擦除放在写入之后的空闲时机，掉电预警时的写入不必等待擦除 */
+    sensor_log_prepare_head();
+    xSemaphoreGive(s_mutex);
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化
+ */
+bool SensorLog_Init(void) {
+  if (s_ready) {
+    return true;
+  }
+  if (norflash_init() != 0 ||
+      norflash_get_size() < SENSOR_LOG_FLASH_ADDR + SENSOR_LOG_FLASH_SIZE) {
+    LOG_WARN("SPI Flash 不可用，不记录传感器数据");
+    return false;
+  }
+
+  s_mutex = xSemaphoreCreateMutexStatic(&s_mutex_buf);
+  s_query_mutex = xSemaphoreCreateMutexStatic(&s_query_mutex_buf);
+  TaskPlan_WatchMutex(s_mutex, "slog", NORFLASH_SECTOR_ERASE_MS);
+  TaskPlan_WatchMutex(s_query_mutex, "slog_query", 0); // 导出期间一直持有
+  sensor_log_reset_batch();
+  sensor_log_mount();
+  s_stats.sector_count = SENSOR_LOG_SECTORS;
+  /* 镜像在 SRAM 顶端，LCD 全帧缓冲 (若启用) 从 SRAM 起始处向上使用 */
+  if (SENSOR_LOG_MIRROR_SECTORS > 0 && sram_init() == 0) {
+    s_mirror_ready = true;
+    sensor_log_mirror_fill();
+    s_stats.mirror_sectors = SENSOR_LOG_MIRROR_SECTORS;
+  }
+
+  s_sub = SensorEventBus_Subscribe("flashlog", NULL);
+  if (s_sub < 0) {
+    LOG_ERROR("订阅传感器事件失败");
+    return false;
+  }
+
+  s_task = xTaskCreateStatic(sensor_log_task, "slog", SENSOR_LOG_TASK_STACK_SIZE,
+                             NULL, SENSOR_LOG_TASK_PRIORITY, s_task_stack,
+                             &s_task_tcb);
+  s_ready = true;
+
+  LOG_INFO("数据记录已挂载: 写入地址 0x%06lX, 日志时间 %lus",
+           (unsigned long)s_write_addr, (unsigned long)s_time_base);
+  return true;
+}
+
+/**
+ * @brief 立即写出未满的页
+ */
+bool SensorLog_Flush(void) {
+  bool ok;
+
+  if (!s_ready) {
+    return true;
+  }
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  ok = sensor_log_write_batch();
+  xSemaphoreGive(s_mutex);
+  return ok;
+}
+
+/**
+ * @brief 按时间区间查询并聚合
+ */
+uint32_t SensorLog_Query(SensorHandle_t sensor, uint32_t t_start,
+                         uint32_t t_end, uint32_t resolution,
+                         SensorLogQueryCb_t cb, void *user) {
+  SensorLogQuery_t q;
+
+  if (!s_ready || cb == NULL || SENSOR_HANDLE_TYPE(sensor) <= SENSOR_TYPE_NONE ||
+      SENSOR_HANDLE_TYPE(sensor) >= SENSOR_TYPE_MAX ||
+      SENSOR_HANDLE_INDEX(sensor) >= SENSOR_MAX_PER_TYPE || t_start > t_end) {
+    return 0;
+  }
+
+  memset(&q, 0, sizeof(q));
+  q.type = sensor;
+  q.t_start = t_start;
+  q.t_end = t_end;
+  q.resolution = resolution;
+  q.cb = cb;
+  q.user = user;
+
+  xSemaphoreTake(s_query_mutex, portMAX_DELAY);
+  sensor_log_scan(t_start, t_end, sensor_log_query_record, &q);
+  if (!q.stop) {
+    sensor_log_query_emit(&q);
+  }
+
+  xSemaphoreGive(s_query_mutex);
+  return q.points;
+}
+
+/**
+ * @brief 按时间顺序遍历原始记录
+ */
+uint32_t SensorLog_ForEach(uint32_t t_start, uint32_t t_end,
+                           SensorLogRecordCb_t cb, void *user) {
+  SensorLogForEach_t ctx;
+
+  if (!s_ready || cb == NULL || t_start > t_end) {
+    return 0;
+  }
+
+  ctx.cb = cb;
+  ctx.user = user;
+  ctx.count = 0;
+  xSemaphoreTake(s_query_mutex, portMAX_DELAY);
+  sensor_log_scan(t_start, t_end, sensor_log_foreach_record, &ctx);
+  xSemaphoreGive(s_query_mutex);
+  return ctx.count;
+}
+
+/**
+ * @brief 当前日志时间
+ */
+uint32_t SensorLog_Now(void) { return s_time_base + SysClock_Seconds(); }
+
+/**
+ * @brief 获取记录统计
+ */
+void SensorLog_GetStats(SensorLogStats_t *stats) {
+  if (stats == NULL) {
+    return;
+  }
+  if (!s_ready) {
+    memset(stats, 0, sizeof(*stats));
+    return;
+  }
+
+  xSemaphoreTake(s_mutex, portMAX_DELAY);
+  *stats = s_stats;
+  stats->batch_count = s_batch.count;
+  xSemaphoreGive(s_mutex);
+  stats->mapped_pages = s_mapped_pages;
+  stats->read_pages = s_read_pages;
+
+  stats->ready = true;
+  stats->now = SensorLog_Now();
+}
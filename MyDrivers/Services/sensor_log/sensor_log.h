@@ -0,0 +1,155 @@
+/**
+ ******************************************************************************
+ * @file    sensor_log.h
+ * @brief   传感器数据记录服务 (SPI NOR Flash)
+ * @details 把传感器任务的数据更新事件长期保存到外部 Flash：
+ *            - 每个样本为 8 字节定长记录 [相对页基准时间 | 类型 | 标志 |
+ *              主/次定点值]，定点值与图表历史相同 (SensorTask_ToFixed)；
+ *            - 记录先在 RAM 中攒满一页 (256 字节，31 条)，再整页编程，
+ *              CPU 与擦写开销都按页摊薄；
+ *            - 日志区按 4 KB 扇区环形使用，写完一个扇区立即预擦下一个
+ *              (覆盖最旧的数据)，每个扇区每轮只擦一次；
+ *            - 每页带 CRC-8，掉电写坏的页在读取时跳过。
+ *          设备没有 RTC，记录使用"日志时间"(秒)：上电时从 Flash 中最新
+ *          记录的时间继续累加，跨重启单调递增，可用于区间查询。
+ *          查询先在 RAM 中的稀疏时间索引 (每 SENSOR_LOG_INDEX_STRIDE 个扇区
+ *          一项) 中定位，再读取少量扇区页头确定起始扇区，之后只顺序读取
+ *          时间区间覆盖的页，并在读取过程中按请求的分辨率聚合。
+ *          外部 SRAM 可用时，最新的 SENSOR_LOG_MIRROR_SECTORS 个扇区在 SRAM
+ *          顶端保留一份直写镜像 (擦除、写页时同步更新)，查询落在镜像内的页
+ *          直接按地址访问，不经 SPI 读取也不复制到缓冲区。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_LOG_H
+#define __SENSOR_LOG_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_LOG_FLASH_ADDR 0x800000UL // 日志区起始地址 (扇区对齐，低地址为图片资源包与固件升级区)
+#define SENSOR_LOG_FLASH_SIZE 0x7C0000UL // 日志区大小 (7.75 MB，约 97 万条记录；末尾 256 KB 为运行日志区)
+#define SENSOR_LOG_MAX_BATCH_AGE_S 600   // 未写满的页最长在 RAM 中停留的时间
+#define SENSOR_LOG_INDEX_STRIDE 16       // 稀疏时间索引间隔 (扇区)，共 124 项
+#define SENSOR_LOG_MIRROR_SECTORS 64     // 外部 SRAM 镜像的最新扇区数 (256 KB，位于 SRAM 顶端，与全帧缓冲不重叠；0 不使用)
+#define SENSOR_LOG_TASK_STACK_SIZE 256   // 记录任务栈大小 (单位: 字)
+#define SENSOR_LOG_TASK_PRIORITY TASK_PRIO_DATALOG // 记录任务的 FreeRTOS 优先级 (即 osPriorityLow)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+#define SENSOR_LOG_FLAG_SECONDARY 0x01 // value[1] 有效 (传感器有第二个通道)
+
+/**
+ * @brief Flash 中的一条记录 (8 字节)
+ */
+typedef struct {
+  uint16_t dt;      // 相对所在页基准时间的偏移 (s)
+  uint8_t type;     // SensorHandle_t (低 4 位类型，高 4 位实例序号)
+  uint8_t flags;    // SENSOR_LOG_FLAG_*
+  int16_t value[2]; // 通道 0/1 定点值 (实际值 * 通道 fixed_scale)
+} SensorLogRecord_t;
+
+/**
+ * @brief 查询输出的聚合点
+ */
+typedef struct {
+  uint32_t time;                // 桶起始日志时间 (s)
+  uint16_t samples;             // 桶内样本数
+  SensorRollupPoint_t value[2]; // 通道 0/1 (已换算为实际值，valid 表示该通道存在)
+} SensorLogPoint_t;
+
+/**
+ * @brief 查询回调
+ * @return false: 停止查询
+ */
+typedef bool (*SensorLogQueryCb_t)(const SensorLogPoint_t *point, void *user);
+
+/**
+ * @brief 原始记录遍历回调
+ * @param time 记录的日志时间 (s)
+ * @return false: 停止遍历
+ */
+typedef bool (*SensorLogRecordCb_t)(uint32_t time,
+                                    const SensorLogRecord_t *record,
+                                    void *user);
+
+/**
+ * @brief 记录统计
+ */
+typedef struct {
+  bool ready;              // 日志区已挂载
+  uint16_t sector_count;   // 日志区扇区数
+  uint16_t batch_count;    // RAM 中未写入的记录数
+  uint32_t oldest_time;    // Flash 中最旧页的基准时间 (s)
+  uint32_t now;            // 当前日志时间 (s)
+  uint32_t records;        // 上电以来写入 Flash 的记录数
+  uint32_t pages_written;  // 上电以来写入的页数
+  uint32_t sectors_erased; // 上电以来擦除的扇区数
+  uint32_t errors;         // 擦写失败次数
+  uint16_t mirror_sectors; // 外部 SRAM 镜像扇区数 (0 为未启用)
+  uint32_t mapped_pages;   // 查询中直接从镜像访问的页数
+  uint32_t read_pages;     // 查询中从 Flash 读取的页数
+} SensorLogStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 挂载日志区、订阅传感器事件并创建记录任务
+ * @note  须在传感器系统初始化之后调用；Flash 不存在时返回 false，不影响其他功能
+ */
+bool SensorLog_Init(void);
+
+/**
+ * @brief 把 RAM 中未写满的页立即写入 Flash (掉电预警、关机前)
+ * @return true: 成功或无数据
+ */
+bool SensorLog_Flush(void);
+
+/**
+ * @brief 按时间区间查询并聚合
+ * @param sensor     传感器实例句柄
+ * @param t_start    起始日志时间 (s，含)
+ * @param t_end      结束日志时间 (s，含)
+ * @param resolution 聚合分辨率 (s)，桶从 t_start 对齐；0 表示逐条输出
+ * @param cb         每个非空桶调用一次 (按时间顺序，在调用者任务中)
+ * @param user       回调参数
+ * @return 输出的点数
+ * @note  包含 RAM 中尚未写入的记录；多个任务的查询互斥执行，
+ *        不阻塞记录任务。例: 最近 24 小时、每 10 分钟一点
+ *        SensorLog_Query(sensor, SensorLog_Now() - 86400, SensorLog_Now(), 600, cb, NULL)
+ */
+uint32_t SensorLog_Query(SensorHandle_t sensor, uint32_t t_start,
+                         uint32_t t_end, uint32_t resolution,
+                         SensorLogQueryCb_t cb, void *user);
+
+/**
+ * @brief 按时间顺序遍历 [t_start, t_end] 内所有传感器的原始记录 (用于导出)
+ * @return 交给回调的记录数
+ * @note  与 SensorLog_Query 互斥执行，同样包含 RAM 中尚未写入的记录
+ */
+uint32_t SensorLog_ForEach(uint32_t t_start, uint32_t t_end,
+                           SensorLogRecordCb_t cb, void *user);
+
+/**
+ * @brief 当前日志时间 (s)
+ */
+uint32_t SensorLog_Now(void);
+
+/**
+ * @brief 获取记录统计
+ */
+void SensorLog_GetStats(SensorLogStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_LOG_H */
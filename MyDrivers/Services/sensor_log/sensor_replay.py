@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    sensor_replay.py
+@brief   传感器样本录制与回放工具 (与 sensor_replay.c 配套)
+@details record: 发送 replay capture on，把 SAMPLE 帧 (格式见 sensor_export.h)
+                 解码为 CSV，Ctrl-C 或 --seconds 到期后关闭录制。
+         play:   对文件中出现的每个实例发送 replay <sensor> start，按录制时的
+                 时间间隔 (可用 --speed 加速) 逐行发送 replay <sensor> push，
+                 结束后恢复驱动。数值以 9 位有效数字发送，float 可逐位还原。
+         板子在每次采样时取一个样本，加速回放时采样间隔须相应缩短，
+         否则队列溢出 (replay 命令的 dropped 计数)。
+
+用法:
+    python sensor_replay.py record COM5 -o smoke.csv --seconds 600
+    python sensor_replay.py play COM5 smoke.csv
+    python sensor_replay.py play COM5 smoke.csv --sensor mq2 --speed 4
+
+@author  MmsY
+@time    2025/11/23
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import time
+
+from sensor_export import SENSOR_NAMES, parse_frame
+
+FRAME_SAMPLE = 4
+
+
+def sensor_name(sensor):
+    kind, index = sensor & 0x0F, sensor >> 4
+    name = SENSOR_NAMES.get(kind, str(kind))
+    return name + (":%d" % index if index else "")
+
+
+def record(opts):
+    import serial  # pyserial
+    port = serial.Serial(opts.port, opts.baud, timeout=0.2)
+    port.write(b"replay capture on\r\n")
+    deadline = time.time() + opts.seconds if opts.seconds else None
+    expect = None
+    lost = 0
+    rows = 0
+
+    with open(opts.output, "w", newline="") as out:
+        w = csv.writer(out)
+        w.writerow(["time_ms", "sensor", "value", "value2"])
+        buf = bytearray()
+        try:
+            while deadline is None or time.time() < deadline:
+                buf += port.read(port.in_waiting or 1)
+                while True:
+                    i = buf.find(b"\0")
+                    if i < 0:
+                        break
+                    chunk = bytes(buf[:i])
+                    del buf[:i + 1]
+                    frame = parse_frame(chunk) if chunk else None
+                    if not frame or frame[0] != FRAME_SAMPLE:
+                        continue
+                    _kind, seq, body = frame
+                    if expect is not None and seq != expect:
+                        lost += (seq - expect) & 0xFFFF
+                    expect = (seq + 1) & 0xFFFF
+                    sensor, t, n = struct.unpack_from("<BIB", body)
+                    values = struct.unpack_from("<%df" % n, body, 6)
+                    w.writerow([t, sensor_name(sensor)] +
+                               ["%.9g" % v for v in values])
+                    rows += 1
+        except KeyboardInterrupt:
+            pass
+    port.write(b"replay capture off\r\n")
+    print("%d samples, %d lost" % (rows, lost), file=sys.stderr)
+
+
+def play(opts):
+    import serial  # pyserial
+    with open(opts.input, newline="") as f:
+        rows = [r for r in csv.DictReader(f)
+                if not opts.sensor or r["sensor"] == opts.sensor]
+    if not rows:
+        sys.exit("no samples")
+
+    port = serial.Serial(opts.port, opts.baud, timeout=0.2)
+    sensors = sorted(set(r["sensor"] for r in rows))
+    for s in sensors:
+        port.write(("replay %s start\r\n" % s).encode())
+        time.sleep(0.05)
+
+    t0 = int(rows[0]["time_ms"])
+    start = time.time()
+    try:
+        for r in rows:
+            due = start + (int(r["time_ms"]) - t0) / 1000.0 / opts.speed
+            delay = due - time.time()
+            if delay > 0:
+                time.sleep(delay)
+            values = [v for v in (r["value"], r.get("value2")) if v]
+            port.write(("replay %s push %s\r\n" % (r["sensor"], " ".join(values))).encode())
+            reply = port.read(port.in_waiting)
+            if b"rejected" in reply:
+                print("push rejected at %s ms" % r["time_ms"], file=sys.stderr)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        time.sleep(0.5)
+        for s in sensors:
+            port.write(("replay %s stop\r\n" % s).encode())
+            time.sleep(0.05)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="EnviroSense sensor record/replay")
+    sub = ap.add_subparsers(dest="cmd", required=True)
+
+    rec = sub.add_parser("record", help="录制样本到 CSV")
+    rec.add_argument("port")
+    rec.add_argument("-o", "--output", required=True)
+    rec.add_argument("-b", "--baud", type=int, default=115200)
+    rec.add_argument("--seconds", type=float, help="录制时长，缺省直到 Ctrl-C")
+
+    ply = sub.add_parser("play", help="按录制节奏回放 CSV")
+    ply.add_argument("port")
+    ply.add_argument("input")
+    ply.add_argument("-b", "--baud", type=int, default=115200)
+    ply.add_argument("--sensor", help="只回放一个实例 (如 sht30 或 sht30:1)")
+    ply.add_argument("--speed", type=float, default=1.0, help="回放倍速")
+
+    opts = ap.parse_args()
+    record(opts) if opts.cmd == "record" else play(opts)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,168 @@
+/**
+ ******************************************************************************
+ * @file    sensor_adapt.c
+ * @brief   自适应采样间隔源文件
+ * @details 策略状态 (上一个值与时刻) 按策略条目保存，当前间隔与平稳计数
+ *          按传感器实例保存。状态只由传感器任务修改：配置间隔由其他任务修改，
+ *          这里在评估时比较配置间隔发现变化，不需要跨任务复位。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_adapt.h"
+#include "sensor_alarm.h"
+#include <math.h>
+#include <string.h>
+
+#define LOG_MODULE "ADAPT"
+#include "log.h"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  bool valid;        // 已收到样本
+  float prev;        // 上一个值
+  uint64_t prev_us;  // 上一个样本时刻
+} SensorAdaptCtx_t;
+
+typedef struct {
+  uint32_t nominal_ms;  // 上次评估时的配置间隔，改变后从配置间隔重新开始
+  uint32_t interval_ms; // 当前间隔
+  uint8_t calm;         // 连续平稳样本数
+} SensorAdaptSensor_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static const SensorAdaptPolicy_t *s_policies;
+static uint8_t s_policy_count;
+static SensorAdaptCtx_t s_ctx[SENSOR_ADAPT_MAX_POLICIES];
+static SensorAdaptSensor_t s_sensor[SENSOR_TYPE_MAX][SENSOR_MAX_PER_TYPE];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 评估一条策略，返回该通道是否活跃
+ */
+static bool sensor_adapt_is_hot(const SensorAdaptPolicy_t *policy,
+                                SensorAdaptCtx_t *ctx, uint64_t time_us,
+                                float x) {
+  bool hot = false;
+
+  if (ctx->valid && policy->fast_rate > 0.0f && time_us > ctx->prev_us) {
+    float dt = (float)(time_us - ctx->prev_us) / 1000000.0f;
+    if (fabsf(x - ctx->prev) >= policy->fast_rate * dt) {
+      hot = true;
+    }
+  }
+  if (SensorAlarm_IsNear(policy->sensor, policy->channel, x,
+                         policy->alarm_margin)) {
+    hot = true;
+  }
+
+  ctx->valid = true;
+  ctx->prev = x;
+  ctx->prev_us = time_us;
+  return hot;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 设置策略表
+ */
+void SensorAdapt_SetPolicies(const SensorAdaptPolicy_t *policies,
+                             uint8_t count) {
+  if (count > SENSOR_ADAPT_MAX_POLICIES) {
+    count = SENSOR_ADAPT_MAX_POLICIES;
+  }
+  for (uint8_t i = 0; i < SENSOR_ADAPT_MAX_POLICIES; i++) {
+    s_ctx[i].valid = false;
+  }
+  memset(s_sensor, 0, sizeof(s_sensor));
+  s_policies = policies;
+  s_policy_count = (policies != NULL) ? count : 0;
+}
+
+/**
+ * @brief 评估一个新样本
+ */
+uint32_t SensorAdapt_Process(SensorHandle_t sensor, uint64_t time_us,
+                             const float *values, uint8_t count,
+                             uint32_t nominal_ms) {
+  SensorAdaptSensor_t *s;
+  uint32_t min_ms = 0xFFFFFFFFU;
+  uint32_t max_ms = 0;
+  uint8_t stable = 0xFF;
+  bool matched = false;
+  bool hot = false;
+  uint32_t next;
+
+  SensorType_t type = SENSOR_HANDLE_TYPE(sensor);
+  uint8_t index = SENSOR_HANDLE_INDEX(sensor);
+
+  if (type <= SENSOR_TYPE_NONE || type >= SENSOR_TYPE_MAX ||
+      index >= SENSOR_MAX_PER_TYPE) {
+    return nominal_ms;
+  }
+
+  for (uint8_t i = 0; i < s_policy_count; i++) {
+    const SensorAdaptPolicy_t *policy = &s_policies[i];
+    uint32_t cap;
+
+    if (policy->sensor != sensor || policy->channel >= count) {
+      continue;
+    }
+    matched = true;
+    if (sensor_adapt_is_hot(policy, &s_ctx[i], time_us,
+                            values[policy->channel])) {
+      hot = true;
+    }
+    cap = policy->max_interval_ms != 0 ? policy->max_interval_ms : nominal_ms;
+    if (policy->min_interval_ms < min_ms) {
+      min_ms = policy->min_interval_ms;
+    }
+    if (cap > max_ms) {
+      max_ms = cap;
+    }
+    if (policy->stable_samples < stable) {
+      stable = policy->stable_samples;
+    }
+  }
+  if (!matched) {
+    return nominal_ms;
+  }
+  // 平稳时不会比配置间隔采样得更频繁
+  if (max_ms < nominal_ms) {
+    max_ms = nominal_ms;
+  }
+  if (max_ms < min_ms) {
+    max_ms = min_ms;
+  }
+
+  s = &s_sensor[type][index];
+  if (s->nominal_ms != nominal_ms) {
+    s->nominal_ms = nominal_ms;
+    s->interval_ms = nominal_ms;
+    s->calm = 0;
+  }
+  next = s->interval_ms;
+  if (hot) {
+    next = min_ms;
+    s->calm = 0;
+  } else if (++s->calm >= (stable != 0 ? stable : 1)) {
+    next = next * 2U;
+    s->calm = 0;
+  }
+  if (next < min_ms) {
+    next = min_ms;
+  }
+  if (next > max_ms) {
+    next = max_ms;
+  }
+
+  if (next != s->interval_ms) {
+    LOG_DEBUG("%s 采样间隔 %lu ms", SensorTask_GetName(sensor),
+              (unsigned long)next);
+  }
+  s->interval_ms = next;
+  return next;
+}
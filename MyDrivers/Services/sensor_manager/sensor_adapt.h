@@ -0,0 +1,78 @@
+/**
+ ******************************************************************************
+ * @file    sensor_adapt.h
+ * @brief   自适应采样间隔头文件
+ * @details 按声明式策略表，根据信号活跃程度逐样本调整传感器的采样间隔：
+ *            - 变化率 (单位/秒) 超过 fast_rate，或数值接近告警阈值
+ *              (alarm_margin 以内、规则已激活或正在等待持续时间) 时，
+ *              下一个间隔立即降到 min_interval_ms；
+ *            - 连续 stable_samples 个平稳样本后间隔加倍，直到
+ *              max_interval_ms；
+ *          配置的更新间隔 (SensorTask_SetUpdateInterval) 是起点：修改后
+ *          从该间隔重新开始调整。没有策略的传感器始终按配置间隔采样。
+ *          同一传感器的多条策略 (如温度与湿度) 任一活跃即加速，
+ *          上下界取各条策略的最小/最大值。
+ *          稳定时采样、I2C/ADC 访问与日志量随间隔一起减少，烟雾上升时
+ *          在下一个样本就切换到快速采样。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_ADAPT_H
+#define __SENSOR_ADAPT_H
+
+#include "sensor_task.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_ADAPT_MAX_POLICIES 6 // 策略表最大条数
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 一条自适应策略 (对应传感器的一个通道)
+ */
+typedef struct {
+  SensorHandle_t sensor;    // 传感器实例 (写类型即该类型的第一个实例)
+  uint8_t channel;          // 通道下标 (如 SHT30 1: 湿度)
+  float fast_rate;          // 变化率不低于该值 (单位/秒) 时快速采样，0 不判断
+  float alarm_margin;       // 距告警阈值多近时快速采样 (与阈值同单位)
+  uint32_t min_interval_ms; // 活跃时的采样间隔
+  uint32_t max_interval_ms; // 长期平稳时的最长间隔
+  uint8_t stable_samples;   // 连续多少个平稳样本后间隔加倍
+} SensorAdaptPolicy_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 设置策略表 (表须为静态存储) 并清空状态
+ * @param policies 策略数组
+ * @param count    条数，超过 SENSOR_ADAPT_MAX_POLICIES 的部分忽略
+ * @note  在注册传感器之前调用
+ */
+void SensorAdapt_SetPolicies(const SensorAdaptPolicy_t *policies,
+                             uint8_t count);
+
+/**
+ * @brief 评估一个新样本，返回下一次采样的间隔 (由传感器任务调用)
+ * @param sensor      传感器实例句柄
+ * @param time_us     样本时间戳 (SysClock_Micros)
+ * @param values      各通道数值 (按通道下标)
+ * @param count       通道数
+ * @param nominal_ms  配置的更新间隔 (与上次不同时从该间隔重新开始)
+ * @return 采样间隔 (ms)；没有策略时返回 nominal_ms
+ */
+uint32_t SensorAdapt_Process(SensorHandle_t sensor, uint64_t time_us,
+                             const float *values, uint8_t count,
+                             uint32_t nominal_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_ADAPT_H */
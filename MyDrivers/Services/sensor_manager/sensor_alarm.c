@@ -0,0 +1,223 @@
+/**
+ ******************************************************************************
+ * @file    sensor_alarm.c
+ * @brief   传感器告警规则引擎源文件
+ * @details 每条规则只保存上一个样本的值与时间 (用于变化率) 以及条件开始
+ *          满足的时刻，评估开销与规则数成正比。规则表与状态只由传感器
+ *          任务修改，命令行读取状态时不加锁。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_alarm.h"
+#include "devices_manager.h"
+#include "sensor_latency.h"
+#include "fmt_fixed.h"
+#include <string.h>
+
+#define LOG_MODULE "ALARM"
+#include "log.h"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  SensorAlarmState_t pub;
+  bool has_prev;       // 已有上一个样本 (变化率规则)
+  float prev_value;    // 上一个样本的值
+  uint64_t prev_us;    // 上一个样本的时间
+  uint64_t since_us;   // 条件开始满足的时刻
+} SensorAlarmCtx_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static const SensorAlarmRule_t *s_rules;
+static uint8_t s_rule_count;
+static SensorAlarmCtx_t s_ctx[SENSOR_ALARM_MAX_RULES];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 按所有激活的规则合成输出并交给设备管理器
+ * @param time_us 引起变化的样本时刻 (随输出传递，用于统计鸣响延迟)
+ */
+static void sensor_alarm_apply(uint64_t time_us) {
+  Drivers_AlarmOutput_t out;
+
+  memset(&out, 0, sizeof(out));
+  out.sample_us = time_us;
+  for (uint8_t i = 0; i < s_rule_count; i++) {
+    const SensorAlarmRule_t *rule = &s_rules[i];
+    if (!s_ctx[i].pub.active) {
+      continue;
+    }
+    if ((rule->actions & SENSOR_ALARM_ACT_BUZZER) && !out.buzzer) {
+      out.buzzer = true;
+      out.buzzer_hz = rule->buzzer_hz;
+    }
+    if ((rule->actions & SENSOR_ALARM_ACT_LED) && !out.led) {
+      out.led = true;
+      out.led_color.R = (uint8_t)(rule->led_rgb >> 16);
+      out.led_color.G = (uint8_t)(rule->led_rgb >> 8);
+      out.led_color.B = (uint8_t)rule->led_rgb;
+    }
+    if ((rule->actions & SENSOR_ALARM_ACT_MOTOR) &&
+        rule->motor_speed >= out.motor_speed) {
+      out.motor = true;
+      out.motor_speed = rule->motor_speed;
+    }
+  }
+  Drivers_Alarm_SetOutput(&out);
+}
+
+/**
+ * @brief 评估单条规则
+ * @return true: 激活状态发生变化
+ */
+static bool sensor_alarm_eval(const SensorAlarmRule_t *rule,
+                              SensorAlarmCtx_t *ctx, uint64_t time_us,
+                              float value) {
+  float x = value;
+  bool set;
+  bool clear;
+
+  // 变化率：与上一个样本的差值 / 间隔
+  if (rule->cond == SENSOR_ALARM_RISE_RATE ||
+      rule->cond == SENSOR_ALARM_FALL_RATE) {
+    bool has_prev = ctx->has_prev && time_us > ctx->prev_us;
+    float prev = ctx->prev_value;
+    float dt = has_prev ? (float)(time_us - ctx->prev_us) * 1e-6f : 0.0f;
+
+    ctx->has_prev = true;
+    ctx->prev_value = value;
+    ctx->prev_us = time_us;
+    if (!has_prev) {
+      return false; // 第一个样本只记录
+    }
+    x = (value - prev) / dt;
+    if (rule->cond == SENSOR_ALARM_FALL_RATE) {
+      x = -x;
+    }
+  }
+  ctx->pub.last_value = x;
+
+  if (rule->cond == SENSOR_ALARM_BELOW) {
+    set = x < rule->threshold;
+    clear = x > rule->threshold + rule->hysteresis;
+  } else {
+    set = x > rule->threshold;
+    clear = x < rule->threshold - rule->hysteresis;
+  }
+
+  if (ctx->pub.active) {
+    if (clear) {
+      ctx->pub.active = false;
+      ctx->pub.pending = false;
+      LOG_INFO("告警解除: %s (%s)", rule->name, FMT_Q2(x));
+      return true;
+    }
+    return false;
+  }
+
+  if (!set) {
+    ctx->pub.pending = false;
+    return false;
+  }
+  if (!ctx->pub.pending) {
+    ctx->pub.pending = true;
+    ctx->since_us = time_us;
+  }
+  if (time_us - ctx->since_us < (uint64_t)rule->duration_ms * 1000U) {
+    return false;
+  }
+
+  ctx->pub.active = true;
+  ctx->pub.pending = false;
+  ctx->pub.trigger_count++;
+  SensorLatency_Record(SENSOR_LATENCY_ALARM, time_us);
+  LOG_WARN("告警触发: %s (%s, 阈值 %s)", rule->name, FMT_Q2(x),
+           FMT_Q2(rule->threshold));
+  return true;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 设置规则表
+ */
+void SensorAlarm_SetRules(const SensorAlarmRule_t *rules, uint8_t count) {
+  memset(s_ctx, 0, sizeof(s_ctx));
+  s_rules = rules;
+  s_rule_count = (rules != NULL) ? count : 0;
+  if (s_rule_count > SENSOR_ALARM_MAX_RULES) {
+    s_rule_count = SENSOR_ALARM_MAX_RULES;
+  }
+  Drivers_Alarm_SetOutput(NULL);
+}
+
+/**
+ * @brief 评估一个新样本
+ */
+void SensorAlarm_Process(SensorHandle_t sensor, uint64_t time_us,
+                         const float *values, uint8_t count) {
+  bool changed = false;
+
+  for (uint8_t i = 0; i < s_rule_count; i++) {
+    const SensorAlarmRule_t *rule = &s_rules[i];
+    if (rule->sensor != sensor || rule->channel >= count) {
+      continue;
+    }
+    if (sensor_alarm_eval(rule, &s_ctx[i], time_us, values[rule->channel])) {
+      changed = true;
+    }
+  }
+
+  if (changed) {
+    sensor_alarm_apply(time_us);
+  }
+}
+
+/**
+ * @brief 数值是否接近某条阈值规则，或该通道有规则已激活/等待持续时间
+ */
+bool SensorAlarm_IsNear(SensorHandle_t sensor, uint8_t channel, float value,
+                        float margin) {
+  for (uint8_t i = 0; i < s_rule_count; i++) {
+    const SensorAlarmRule_t *rule = &s_rules[i];
+    const SensorAlarmState_t *st = &s_ctx[i].pub;
+
+    if (rule->sensor != sensor || rule->channel != channel) {
+      continue;
+    }
+    if (st->active || st->pending) {
+      return true;
+    }
+    if (rule->cond == SENSOR_ALARM_ABOVE && value >= rule->threshold - margin) {
+      return true;
+    }
+    if (rule->cond == SENSOR_ALARM_BELOW && value <= rule->threshold + margin) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * @brief 获取规则数
+ */
+uint8_t SensorAlarm_GetRuleCount(void) { return s_rule_count; }
+
+/**
+ * @brief 获取规则及其状态
+ */
+bool SensorAlarm_GetRule(uint8_t index, const SensorAlarmRule_t **rule,
+                         SensorAlarmState_t *state) {
+  if (index >= s_rule_count) {
+    return false;
+  }
+  if (rule != NULL) {
+    *rule = &s_rules[index];
+  }
+  if (state != NULL) {
+    *state = s_ctx[index].pub;
+  }
+  return true;
+}
@@ -0,0 +1,126 @@
+/**
+ ******************************************************************************
+ * @file    sensor_alarm.h
+ * @brief   传感器告警规则引擎头文件
+ * @details 按声明式规则表在传感器任务中逐样本增量评估告警条件：
+ *            - 阈值 (高于/低于) 与回差，避免在阈值附近反复触发；
+ *            - 变化率 (单位/秒，按样本的微秒时间戳计算)；
+ *            - 持续时间：条件连续满足指定时间后才触发，0 表示立即触发。
+ *          规则状态变化时合成所有激活规则的动作，经设备管理器驱动
+ *          蜂鸣器、RGB LED 与电机。评估不依赖界面刷新，烟雾告警在
+ *          超限的那个样本上即可触发。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_ALARM_H
+#define __SENSOR_ALARM_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_ALARM_MAX_RULES 8 // 规则表最大条数
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 告警条件
+ */
+typedef enum {
+  SENSOR_ALARM_ABOVE = 0,   // 值 > 阈值；回落到 阈值 - 回差 以下解除
+  SENSOR_ALARM_BELOW,       // 值 < 阈值；回升到 阈值 + 回差 以上解除
+  SENSOR_ALARM_RISE_RATE,   // 上升速率 > 阈值 (单位/秒)；低于 阈值 - 回差 解除
+  SENSOR_ALARM_FALL_RATE    // 下降速率 > 阈值 (单位/秒)；低于 阈值 - 回差 解除
+} SensorAlarmCond_t;
+
+/* 告警动作 (可组合) */
+#define SENSOR_ALARM_ACT_BUZZER 0x01 // 蜂鸣器持续鸣响
+#define SENSOR_ALARM_ACT_LED 0x02    // LED 显示告警颜色
+#define SENSOR_ALARM_ACT_MOTOR 0x04  // 电机以固定速度运行 (如排风)
+
+/**
+ * @brief 一条告警规则
+ * @note  多条规则同时激活时，蜂鸣器频率与 LED 颜色取表中靠前的规则，
+ *        电机取最大速度
+ */
+typedef struct {
+  const char *name;       // 规则名 (日志、命令行)
+  SensorHandle_t sensor;  // 传感器实例 (写类型即该类型的第一个实例)
+  uint8_t channel;        // 通道下标 (见传感器通道表，如 SHT30 0: 温度 1: 湿度)
+  SensorAlarmCond_t cond; // 条件
+  float threshold;        // 阈值 (值或速率)
+  float hysteresis;       // 回差 (>= 0)
+  uint32_t duration_ms;   // 条件持续满足多久才触发
+  uint8_t actions;        // SENSOR_ALARM_ACT_*
+  uint16_t buzzer_hz;     // 蜂鸣器频率
+  uint32_t led_rgb;       // LED 颜色 0xRRGGBB
+  uint16_t motor_speed;   // 电机 PWM 占空比 (0-999)
+} SensorAlarmRule_t;
+
+/**
+ * @brief 规则运行状态
+ */
+typedef struct {
+  bool active;           // 告警已触发
+  bool pending;          // 条件满足，等待持续时间
+  float last_value;      // 最近一次评估的值 (变化率规则为速率)
+  uint32_t trigger_count; // 上电以来触发次数
+} SensorAlarmState_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 设置规则表并清空所有状态
+ * @param rules 规则表 (须长期有效，通常为 const 表)
+ * @param count 规则数，超过 SENSOR_ALARM_MAX_RULES 的部分被忽略
+ * @note  须在注册传感器之前调用；运行中只能在传感器任务中调用
+ *        (运行时配置发布新规则时，见 runtime_config.h)
+ */
+void SensorAlarm_SetRules(const SensorAlarmRule_t *rules, uint8_t count);
+
+/**
+ * @brief 评估一个新样本 (由传感器任务在提交样本后调用)
+ * @param sensor    传感器实例句柄
+ * @param time_us   样本时间戳 (SysClock_Micros)
+ * @param values    各通道数值 (按通道下标)
+ * @param count     通道数，规则通道超出范围时忽略
+ */
+void SensorAlarm_Process(SensorHandle_t sensor, uint64_t time_us,
+                         const float *values, uint8_t count);
+
+/**
+ * @brief 数值是否接近告警 (供自适应采样使用)
+ * @param sensor  传感器实例句柄
+ * @param channel 通道下标
+ * @param value   当前值
+ * @param margin  距离阈值多近算接近 (与阈值同单位)
+ * @return true: 距某条阈值规则不超过 margin (或已越过)，或该通道有规则
+ *         已激活、正在等待持续时间
+ */
+bool SensorAlarm_IsNear(SensorHandle_t sensor, uint8_t channel, float value,
+                        float margin);
+
+/**
+ * @brief 获取规则数
+ */
+uint8_t SensorAlarm_GetRuleCount(void);
+
+/**
+ * @brief 获取规则及其状态
+ * @return false: 下标越界
+ */
+bool SensorAlarm_GetRule(uint8_t index, const SensorAlarmRule_t **rule,
+                         SensorAlarmState_t *state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_ALARM_H */
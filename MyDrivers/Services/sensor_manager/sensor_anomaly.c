@@ -0,0 +1,170 @@
+/**
+ ******************************************************************************
+ * @file    sensor_anomaly.c
+ * @brief   传感器通道异常检测源文件
+ * @details 基线与方差由 SensorStats_EwmaPush 递推，评分按更新前的估计计算，
+ *          异常样本同样参与学习：尖峰过后方差短暂变大、随即恢复，持续的
+ *          电平变化在若干个 1/alpha 样本后成为新的基线。规则表与状态只由
+ *          传感器任务修改，命令行与界面读取状态时不加锁。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_anomaly.h"
+#include "fmt_fixed.h"
+#include <math.h>
+#include <string.h>
+
+#define LOG_MODULE "ANOMALY"
+#include "log.h"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  SensorAnomalyState_t pub;
+  SensorStatsEwma_t ewma;
+  float cusum_pos; // 偏高一侧的累积和
+  float cusum_neg; // 偏低一侧的累积和
+} SensorAnomalyCtx_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static const SensorAnomalyRule_t *s_rules;
+static uint8_t s_rule_count;
+static SensorAnomalyCtx_t s_ctx[SENSOR_ANOMALY_MAX_RULES];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 评估单条规则
+ * @return true: 异常状态发生变化
+ */
+static bool sensor_anomaly_eval(const SensorAnomalyRule_t *rule,
+                                SensorAnomalyCtx_t *ctx, float value) {
+  float z = SensorStats_EwmaPush(&ctx->ewma, value, rule->alpha,
+                                 rule->min_sigma, rule->warmup);
+  float score = z;
+  int8_t direction;
+
+  ctx->pub.mean = ctx->ewma.mean;
+  ctx->pub.sigma = sqrtf(ctx->ewma.var);
+  if (ctx->ewma.n < rule->warmup) {
+    return false; // 学习中 (z 恒为 0)
+  }
+
+  if (rule->method == SENSOR_ANOMALY_CUSUM) {
+    ctx->cusum_pos += z - rule->slack;
+    ctx->cusum_neg += -z - rule->slack;
+    if (ctx->cusum_pos < 0.0f)
+      ctx->cusum_pos = 0.0f;
+    if (ctx->cusum_neg < 0.0f)
+      ctx->cusum_neg = 0.0f;
+    score = ctx->cusum_pos >= ctx->cusum_neg ? ctx->cusum_pos : -ctx->cusum_neg;
+  }
+  ctx->pub.score = score;
+
+  direction = ctx->pub.direction;
+  if (fabsf(score) > rule->limit) {
+    direction = score > 0.0f ? 1 : -1;
+  } else if (fabsf(score) < rule->limit * SENSOR_ANOMALY_REARM) {
+    direction = 0;
+  }
+  if (direction == ctx->pub.direction) {
+    return false;
+  }
+
+  if (direction != 0) {
+    if (ctx->pub.direction == 0) {
+      ctx->pub.trigger_count++;
+    }
+    LOG_WARN("异常: %s %s (值 %s, 基线 %s, 评分 %s)", rule->name,
+             direction > 0 ? "偏高" : "偏低", FMT_Q2(value),
+             FMT_Q2(ctx->pub.mean), FMT_Q2(score));
+  } else {
+    LOG_INFO("异常解除: %s (值 %s)", rule->name, FMT_Q2(value));
+  }
+  ctx->pub.direction = direction;
+  return true;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 设置规则表
+ */
+void SensorAnomaly_SetRules(const SensorAnomalyRule_t *rules, uint8_t count) {
+  memset(s_ctx, 0, sizeof(s_ctx));
+  s_rules = rules;
+  s_rule_count = (rules != NULL) ? count : 0;
+  if (s_rule_count > SENSOR_ANOMALY_MAX_RULES) {
+    s_rule_count = SENSOR_ANOMALY_MAX_RULES;
+  }
+}
+
+/**
+ * @brief 评估一个新样本
+ */
+bool SensorAnomaly_Process(SensorHandle_t sensor, const float *values,
+                           uint8_t count) {
+  bool changed = false;
+
+  for (uint8_t i = 0; i < s_rule_count; i++) {
+    const SensorAnomalyRule_t *rule = &s_rules[i];
+    if (rule->sensor != sensor || rule->channel >= count) {
+      continue;
+    }
+    if (sensor_anomaly_eval(rule, &s_ctx[i], values[rule->channel])) {
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+/**
+ * @brief 重新学习基线
+ */
+void SensorAnomaly_Reset(SensorHandle_t sensor) {
+  for (uint8_t i = 0; i < s_rule_count; i++) {
+    if (s_rules[i].sensor == sensor) {
+      uint32_t count = s_ctx[i].pub.trigger_count;
+
+      memset(&s_ctx[i], 0, sizeof(s_ctx[i]));
+      s_ctx[i].pub.trigger_count = count;
+    }
+  }
+}
+
+/**
+ * @brief 当前处于异常的通道位图
+ */
+uint8_t SensorAnomaly_GetMask(SensorHandle_t sensor) {
+  uint8_t mask = 0;
+
+  for (uint8_t i = 0; i < s_rule_count; i++) {
+    if (s_rules[i].sensor == sensor && s_ctx[i].pub.direction != 0) {
+      mask |= (uint8_t)(1U << s_rules[i].channel);
+    }
+  }
+  return mask;
+}
+
+/**
+ * @brief 获取规则数
+ */
+uint8_t SensorAnomaly_GetRuleCount(void) { return s_rule_count; }
+
+/**
+ * @brief 获取规则及其状态
+ */
+bool SensorAnomaly_GetRule(uint8_t index, const SensorAnomalyRule_t **rule,
+                           SensorAnomalyState_t *state) {
+  if (index >= s_rule_count) {
+    return false;
+  }
+  if (rule != NULL) {
+    *rule = &s_rules[index];
+  }
+  if (state != NULL) {
+    *state = s_ctx[index].pub;
+  }
+  return true;
+}
@@ -0,0 +1,118 @@
+/**
+ ******************************************************************************
+ * @file    sensor_anomaly.h
+ * @brief   传感器通道异常检测头文件
+ * @details 固定阈值之外的统计检测，按声明式规则表在传感器任务中逐样本评估：
+ *            - Z-SCORE：样本与指数加权均值之差除以指数加权标准差，
+ *              |z| 超过限值即判为异常 (尖峰、跳变、读数掉零)；
+ *            - CUSUM：对同一 z 做双侧累积和 S+ = max(0, S+ + z - k)、
+ *              S- = max(0, S- - z - k)，任一侧超过限值 h 判为漂移
+ *              (基线缓慢抬升、传感器老化)，单个样本不足以触发。
+ *          两种方法都在评分降到限值的 SENSOR_ANOMALY_REARM 倍以下后解除。
+ *          每条规则只保存均值、方差与两个累积和，每个样本为常数次浮点
+ *          运算，与采样间隔无关，自适应采样加速时同样逐样本评估。
+ *          状态变化时传感器任务发布 SENSOR_EVENT_ANOMALY 事件，所有事件
+ *          快照带有当前异常通道的位图 (SensorSnapshot_t.anomaly)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_ANOMALY_H
+#define __SENSOR_ANOMALY_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_ANOMALY_MAX_RULES 6 // 规则表最大条数
+#define SENSOR_ANOMALY_REARM 0.5f  // 评分低于 限值 * 该系数 时解除
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 检测方法
+ */
+typedef enum {
+  SENSOR_ANOMALY_ZSCORE = 0, // 单个样本的 |z| > limit
+  SENSOR_ANOMALY_CUSUM       // z 的双侧累积和 > limit
+} SensorAnomalyMethod_t;
+
+/**
+ * @brief 一条检测规则 (对应传感器的一个通道)
+ */
+typedef struct {
+  const char *name;             // 规则名 (日志、命令行)
+  SensorHandle_t sensor;        // 传感器实例 (写类型即该类型的第一个实例)
+  uint8_t channel;              // 通道下标
+  SensorAnomalyMethod_t method; // 检测方法
+  float alpha;                  // 均值/方差的平滑系数 (越小基线越稳，漂移越易发现)
+  float limit;                  // z 限值，或 CUSUM 判决阈值 h (单位: 标准差)
+  float slack;                  // CUSUM 每个样本允许的偏移 k (单位: 标准差)，Z-SCORE 忽略
+  float min_sigma;              // 标准差下限 (与数值同单位)，恒定信号的量化跳动不算异常
+  uint16_t warmup;              // 学习多少个样本后开始判断
+} SensorAnomalyRule_t;
+
+/**
+ * @brief 规则运行状态
+ */
+typedef struct {
+  int8_t direction;       // 0: 正常，1: 偏高，-1: 偏低
+  float score;            // 最近一次评分 (z 或较大一侧的累积和，偏低为负)
+  float mean;             // 当前基线
+  float sigma;            // 当前标准差估计
+  uint32_t trigger_count; // 上电以来触发次数
+} SensorAnomalyState_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 设置规则表 (表须为静态存储) 并清空所有状态
+ * @param rules 规则数组
+ * @param count 条数，超过 SENSOR_ANOMALY_MAX_RULES 的部分忽略
+ * @note  在注册传感器之前调用
+ */
+void SensorAnomaly_SetRules(const SensorAnomalyRule_t *rules, uint8_t count);
+
+/**
+ * @brief 评估一个新样本 (由传感器任务在提交样本后调用)
+ * @param sensor 传感器实例句柄
+ * @param values 各通道数值 (按通道下标)
+ * @param count  通道数，规则通道超出范围时忽略
+ * @return true: 该传感器有规则的异常状态发生变化
+ */
+bool SensorAnomaly_Process(SensorHandle_t sensor, const float *values,
+                           uint8_t count);
+
+/**
+ * @brief 重新学习基线 (传感器重新初始化或恢复在线后调用)
+ */
+void SensorAnomaly_Reset(SensorHandle_t sensor);
+
+/**
+ * @brief 当前处于异常的通道位图 (bit n 对应通道 n)
+ */
+uint8_t SensorAnomaly_GetMask(SensorHandle_t sensor);
+
+/**
+ * @brief 获取规则数
+ */
+uint8_t SensorAnomaly_GetRuleCount(void);
+
+/**
+ * @brief 获取规则及其状态
+ * @return false: 下标越界
+ */
+bool SensorAnomaly_GetRule(uint8_t index, const SensorAnomalyRule_t **rule,
+                           SensorAnomalyState_t *state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_ANOMALY_H */
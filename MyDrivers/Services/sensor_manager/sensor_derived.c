@@ -0,0 +1,276 @@
+/**
+ ******************************************************************************
+ * @file    sensor_derived.c
+ * @brief   派生通道源文件
+ * @details 源数据经顺序锁无锁拷贝 (SensorTask_GetSensorData)，以样本的
+ *          微秒时间戳判断缓存是否过期。计算在临界区外进行，只有比较与
+ *          写回缓存在临界区内：两个读者同时遇到过期缓存时各算一次，结果
+ *          相同，不影响正确性。
+ *          近似函数：log 把 x 拆成 2^e * m (m 在 [√½, √2))，ln m 用
+ *          atanh 级数 2(s + s³/3 + s⁵/5 + s⁷/7)，s = (m-1)/(m+1)；exp 把 x
+ *          拆成 k ln2 + r (|r| <= ln2/2)，e^r 用 6 阶泰勒多项式，再直接写入
+ *          指数位；sqrt 用指数减半的初值加三次牛顿迭代。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_derived.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+#if SENSOR_DERIVED_USE_LIBM
+#include <math.h>
+#endif
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  uint64_t stamp_us; // 缓存值对应的源样本时间戳 (0 表示无缓存)
+  float value;
+  bool ok;           // 该样本上是否有派生值
+  SensorDerivedStats_t stats;
+} SensorDerivedCache_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static const SensorDerivedDesc_t *s_table;
+static uint8_t s_count;
+static SensorDerivedCache_t s_cache[SENSOR_DERIVED_MAX_CHANNELS];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+typedef union {
+  float f;
+  uint32_t u;
+} derived_bits_t;
+
+#if SENSOR_DERIVED_USE_LIBM
+#define derived_logf logf
+#define derived_expf expf
+#define derived_sqrtf sqrtf
+#else
+/* 自然对数 (x > 0) */
+static float derived_logf(float x) {
+  derived_bits_t v;
+  int32_t e;
+  float m, s, s2;
+
+  v.f = x;
+  e = (int32_t)((v.u >> 23) & 0xFFU) - 127;
+  v.u = (v.u & 0x007FFFFFU) | 0x3F800000U; // m 在 [1, 2)
+  m = v.f;
+  if (m > 1.41421356f) {
+    m *= 0.5f;
+    e++;
+  }
+  s = (m - 1.0f) / (m + 1.0f);
+  s2 = s * s;
+  return (float)e * 0.69314718f +
+         2.0f * s * (1.0f + s2 * (0.33333333f + s2 * (0.2f + s2 * 0.14285714f)));
+}
+
+/* 自然指数 (结果超出单精度范围时饱和) */
+static float derived_expf(float x) {
+  derived_bits_t v;
+  int32_t k;
+  float r, p;
+
+  if (x < -87.0f) {
+    return 0.0f;
+  }
+  if (x > 88.0f) {
+    x = 88.0f;
+  }
+  k = (int32_t)(x * 1.44269504f + (x >= 0.0f ? 0.5f : -0.5f));
+  r = x - (float)k * 0.69314718f;
+  p = 1.0f + r * (1.0f + r * (0.5f + r * (0.16666667f + r * (0.041666667f +
+                              r * (0.0083333333f + r * 0.0013888889f)))));
+  v.u = (uint32_t)(k + 127) << 23;
+  return p * v.f;
+}
+
+/* 平方根 (x >= 0) */
+static float derived_sqrtf(float x) {
+  derived_bits_t v;
+  float y;
+
+  if (x <= 0.0f) {
+    return 0.0f;
+  }
+  v.f = x;
+  v.u = (v.u >> 1) + 0x1FC00000U; // 指数减半，误差 < 6%
+  y = v.f;
+  y = 0.5f * (y + x / y);
+  y = 0.5f * (y + x / y);
+  y = 0.5f * (y + x / y);
+  return y;
+}
+#endif
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 设置派生通道表
+ */
+void SensorDerived_SetChannels(const SensorDerivedDesc_t *table, uint8_t count) {
+  taskENTER_CRITICAL();
+  memset(s_cache, 0, sizeof(s_cache));
+  s_table = table;
+  s_count = (table != NULL) ? count : 0;
+  if (s_count > SENSOR_DERIVED_MAX_CHANNELS) {
+    s_count = SENSOR_DERIVED_MAX_CHANNELS;
+  }
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 派生通道数
+ */
+uint8_t SensorDerived_GetCount(void) { return s_count; }
+
+/**
+ * @brief 获取描述
+ */
+const SensorDerivedDesc_t *SensorDerived_GetDesc(uint8_t index) {
+  return index < s_count ? &s_table[index] : NULL;
+}
+
+/**
+ * @brief 按名称查找
+ */
+int8_t SensorDerived_Find(const char *name) {
+  for (uint8_t i = 0; i < s_count; i++) {
+    if (strcmp(s_table[i].name, name) == 0) {
+      return (int8_t)i;
+    }
+  }
+  return -1;
+}
+
+/**
+ * @brief 读取派生值
+ */
+bool SensorDerived_Get(uint8_t index, float *value) {
+  const SensorDerivedDesc_t *desc = SensorDerived_GetDesc(index);
+  SensorDerivedCache_t *cache;
+  const SensorChannelDesc_t *channels;
+  float in[SENSOR_DERIVED_MAX_INPUTS];
+  SensorData_t data;
+  uint8_t channel_count;
+  bool ok;
+
+  if (desc == NULL || value == NULL ||
+      !SensorTask_GetSensorData(desc->sensor, &data) || !data.is_valid ||
+      data.timestamp_us == 0) {
+    return false;
+  }
+  cache = &s_cache[index];
+
+  taskENTER_CRITICAL();
+  if (cache->stamp_us == data.timestamp_us) {
+    cache->stats.hits++;
+    *value = cache->value;
+    ok = cache->ok;
+    taskEXIT_CRITICAL();
+    return ok;
+  }
+  taskEXIT_CRITICAL();
+
+  // 缓存过期：按本次拷贝的样本计算
+  channel_count = SensorTask_GetChannels(desc->sensor, &channels);
+  ok = desc->input_count <= SENSOR_DERIVED_MAX_INPUTS;
+  for (uint8_t i = 0; ok && i < desc->input_count; i++) {
+    if (desc->inputs[i] >= channel_count) {
+      ok = false;
+      break;
+    }
+    in[i] = SensorChannel_Value(&channels[desc->inputs[i]], &data);
+  }
+  if (ok) {
+    ok = desc->func(in, value);
+  }
+
+  taskENTER_CRITICAL();
+  cache->stats.computes++;
+  cache->stamp_us = data.timestamp_us;
+  cache->value = *value;
+  cache->ok = ok;
+  taskEXIT_CRITICAL();
+  return ok;
+}
+
+/**
+ * @brief 获取缓存统计
+ */
+bool SensorDerived_GetStats(uint8_t index, SensorDerivedStats_t *stats) {
+  if (index >= s_count || stats == NULL) {
+    return false;
+  }
+  taskENTER_CRITICAL();
+  *stats = s_cache[index].stats;
+  taskEXIT_CRITICAL();
+  return true;
+}
+
+/**
+ * @brief 露点 (Magnus 公式，Sonntag 系数，-45 ~ 60 °C 误差 < 0.35 °C)
+ */
+bool SensorDerived_DewPoint(const float *in, float *out) {
+  const float a = 17.62f;
+  const float b = 243.12f;
+  float t = in[0];
+  float rh = in[1];
+  float gamma;
+
+  if (rh <= 0.0f || t <= -b) {
+    return false;
+  }
+  if (rh > 100.0f) {
+    rh = 100.0f;
+  }
+  gamma = derived_logf(rh * 0.01f) + a * t / (b + t);
+  *out = b * gamma / (a - gamma);
+  return true;
+}
+
+/**
+ * @brief 体感温度 (NOAA：低温区用简化式，27 °C 以上用 Rothfusz 回归并修正)
+ */
+bool SensorDerived_HeatIndex(const float *in, float *out) {
+  float t = in[0] * 1.8f + 32.0f; // °F
+  float rh = in[1];
+  float hi;
+
+  if (rh < 0.0f || rh > 100.0f) {
+    return false;
+  }
+  hi = 0.5f * (t + 61.0f + (t - 68.0f) * 1.2f + rh * 0.094f);
+  if ((hi + t) * 0.5f >= 80.0f) {
+    hi = -42.379f + 2.04901523f * t + 10.14333127f * rh -
+         0.22475541f * t * rh - 0.00683783f * t * t -
+         0.05481717f * rh * rh + 0.00122874f * t * t * rh +
+         0.00085282f * t * rh * rh - 0.00000199f * t * t * rh * rh;
+    if (rh < 13.0f && t > 80.0f && t < 112.0f) {
+      float d = t > 95.0f ? t - 95.0f : 95.0f - t;
+      hi -= (13.0f - rh) * 0.25f * derived_sqrtf((17.0f - d) / 17.0f);
+    } else if (rh > 85.0f && t > 80.0f && t < 87.0f) {
+      hi += (rh - 85.0f) * 0.1f * (87.0f - t) * 0.2f;
+    }
+  }
+  *out = (hi - 32.0f) / 1.8f;
+  return true;
+}
+
+/**
+ * @brief 绝对湿度 (饱和水汽压按 Magnus 公式)
+ */
+bool SensorDerived_AbsHumidity(const float *in, float *out) {
+  float t = in[0];
+  float rh = in[1];
+
+  if (rh < 0.0f || t <= -243.5f) {
+    return false;
+  }
+  *out = 6.112f * derived_expf(17.67f * t / (t + 243.5f)) * rh * 2.1674f /
+         (273.15f + t);
+  return true;
+}
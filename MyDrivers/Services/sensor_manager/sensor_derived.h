@@ -0,0 +1,112 @@
+/**
+ ******************************************************************************
+ * @file    sensor_derived.h
+ * @brief   派生通道头文件 (露点、体感温度、绝对湿度等)
+ * @details 派生通道由应用层以声明式表给出：源传感器、若干源通道下标与
+ *          计算函数。传感器任务不计算派生值；读者 (界面、上行、命令行)
+ *          调用 SensorDerived_Get 时才按源数据计算，结果与源样本的时间戳
+ *          一起缓存，源数据更新之前重复读取直接返回缓存值。
+ *          内置的计算函数默认使用不依赖 libm 的近似 log/exp/sqrt (相对误差
+ *          约 1e-6，远小于传感器精度)，SENSOR_DERIVED_USE_LIBM 为 1 时改用
+ *          logf/expf/sqrtf。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_DERIVED_H
+#define __SENSOR_DERIVED_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_DERIVED_MAX_CHANNELS 8 // 派生通道表最大条数
+#define SENSOR_DERIVED_MAX_INPUTS 2   // 每个派生通道的源通道数上限
+#ifndef SENSOR_DERIVED_USE_LIBM
+#define SENSOR_DERIVED_USE_LIBM 0     // 1: 内置函数使用 libm
+#endif
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 计算函数
+ * @param in  源通道数值 (按 inputs 的顺序)
+ * @param out 派生值
+ * @return false: 输入超出公式的适用范围，无派生值
+ */
+typedef bool (*SensorDerivedFunc_t)(const float *in, float *out);
+
+/**
+ * @brief 一个派生通道
+ */
+typedef struct {
+  const char *name;        // 通道名 (命令行、界面)
+  const char *unit;        // 单位
+  SensorHandle_t sensor;   // 源传感器 (写类型即该类型的第一个实例)
+  uint8_t inputs[SENSOR_DERIVED_MAX_INPUTS]; // 源通道下标
+  uint8_t input_count;     // 源通道数
+  SensorDerivedFunc_t func; // 计算函数
+} SensorDerivedDesc_t;
+
+/**
+ * @brief 缓存统计
+ */
+typedef struct {
+  uint32_t computes; // 实际计算次数
+  uint32_t hits;     // 直接返回缓存的次数
+} SensorDerivedStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 设置派生通道表 (须为静态存储)，清空缓存
+ */
+void SensorDerived_SetChannels(const SensorDerivedDesc_t *table, uint8_t count);
+
+/**
+ * @brief 派生通道数
+ */
+uint8_t SensorDerived_GetCount(void);
+
+/**
+ * @brief 获取第 index 个派生通道的描述
+ * @return 描述，超出范围返回 NULL
+ */
+const SensorDerivedDesc_t *SensorDerived_GetDesc(uint8_t index);
+
+/**
+ * @brief 按名称查找派生通道
+ * @return 下标，找不到返回 -1
+ */
+int8_t SensorDerived_Find(const char *name);
+
+/**
+ * @brief 读取派生值 (源数据更新后的第一次读取时计算)
+ * @param index 派生通道下标
+ * @param value 输出派生值
+ * @return false: 源传感器无有效数据或输入超出适用范围
+ * @note  可在任意任务中调用，不可在中断中调用
+ */
+bool SensorDerived_Get(uint8_t index, float *value);
+
+/**
+ * @brief 获取缓存统计
+ */
+bool SensorDerived_GetStats(uint8_t index, SensorDerivedStats_t *stats);
+
+/* 内置计算函数 (in[0]: 温度 °C, in[1]: 相对湿度 %RH) */
+bool SensorDerived_DewPoint(const float *in, float *out);    // 露点 °C (Magnus)
+bool SensorDerived_HeatIndex(const float *in, float *out);   // 体感温度 °C (NOAA)
+bool SensorDerived_AbsHumidity(const float *in, float *out); // 绝对湿度 g/m³
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_DERIVED_H */
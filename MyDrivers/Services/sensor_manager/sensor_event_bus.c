@@ -0,0 +1,221 @@
+/**
+ ******************************************************************************
+ * @file    sensor_event_bus.c
+ * @brief   传感器事件总线源文件
+ * @details 记录池与订阅者表都是静态分配的，订阅可以早于 SensorTask_Init
+ *          (UI 在传感器系统之前初始化)。引用计数与池分配在临界区内修改；
+ *          发布者在投递期间自己持有一个引用，保证记录不会在投递途中被
+ *          订阅者释放回池。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_event_bus.h"
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+#include <stddef.h>
+#include <string.h>
+
+/* --------------------------- 调试配置 --------------------------- */
+#define LOG_MODULE "EventBus"
+#include "log.h"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  SensorSnapshot_t snapshot; // 必须是第一个成员 (Release 按地址换算记录)
+  uint8_t refs;              // 0 表示空闲
+} SensorEventRecord_t;
+
+typedef struct {
+  const char *name;
+  SensorEventCallback_t callback; // 回调订阅者
+  SensorEventNotify_t notify;     // 队列订阅者
+  QueueHandle_t queue;
+  StaticQueue_t queue_buf;
+  uint8_t queue_storage[SENSOR_EVENT_QUEUE_LEN * sizeof(SensorEventRecord_t *)];
+} SensorEventSubscriber_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static SensorEventRecord_t g_pool[SENSOR_EVENT_POOL_SIZE];
+static SensorEventSubscriber_t g_subs[SENSOR_EVENT_MAX_SUBSCRIBERS];
+static SensorEventBusStats_t g_stats = {.pool_min_free = SENSOR_EVENT_POOL_SIZE};
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static void SensorEventBus_Unref(SensorEventRecord_t *rec) {
+  taskENTER_CRITICAL();
+  if (rec->refs > 0) {
+    rec->refs--;
+  }
+  taskEXIT_CRITICAL();
+}
+
+static SensorEventSub_t SensorEventBus_Add(const char *name,
+                                           SensorEventCallback_t callback,
+                                           SensorEventNotify_t notify) {
+  SensorEventSub_t id = -1;
+
+  taskENTER_CRITICAL();
+  if (g_stats.subscriber_count < SENSOR_EVENT_MAX_SUBSCRIBERS) {
+    id = (SensorEventSub_t)g_stats.subscriber_count;
+    g_subs[id].name = name;
+    g_subs[id].callback = callback;
+    g_subs[id].notify = notify;
+  }
+  taskEXIT_CRITICAL();
+
+  if (id < 0) {
+    LOG_ERROR("订阅者已满，%s 订阅失败", name);
+    return -1;
+  }
+  if (callback == NULL) {
+    g_subs[id].queue = xQueueCreateStatic(
+        SENSOR_EVENT_QUEUE_LEN, sizeof(SensorEventRecord_t *),
+        g_subs[id].queue_storage, &g_subs[id].queue_buf);
+  }
+
+  // 队列就绪后才对发布者可见，避免投递到未创建的队列
+  taskENTER_CRITICAL();
+  g_stats.subscriber_count++;
+  taskEXIT_CRITICAL();
+  LOG_DEBUG("订阅者 %d: %s (%s)", id, name, callback ? "回调" : "队列");
+  return id;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 注册队列订阅者
+ */
+SensorEventSub_t SensorEventBus_Subscribe(const char *name,
+                                          SensorEventNotify_t notify) {
+  return SensorEventBus_Add(name, NULL, notify);
+}
+
+/**
+ * @brief 注册回调订阅者
+ */
+SensorEventSub_t SensorEventBus_SubscribeCallback(const char *name,
+                                                  SensorEventCallback_t callback) {
+  if (callback == NULL) {
+    return -1;
+  }
+  return SensorEventBus_Add(name, callback, NULL);
+}
+
+/**
+ * @brief 取出一条事件
+ */
+const SensorSnapshot_t *SensorEventBus_Receive(SensorEventSub_t sub,
+                                               uint32_t timeout_ms) {
+  SensorEventRecord_t *rec;
+
+  if (sub < 0 || sub >= (SensorEventSub_t)g_stats.subscriber_count ||
+      g_subs[sub].queue == NULL) {
+    return NULL;
+  }
+  if (xQueueReceive(g_subs[sub].queue, &rec, pdMS_TO_TICKS(timeout_ms)) !=
+      pdPASS) {
+    return NULL;
+  }
+  return &rec->snapshot;
+}
+
+/**
+ * @brief 释放事件
+ */
+void SensorEventBus_Release(const SensorSnapshot_t *snapshot) {
+  if (snapshot != NULL) {
+    SensorEventBus_Unref((SensorEventRecord_t *)snapshot);
+  }
+}
+
+/**
+ * @brief 从记录池取一条空记录
+ */
+SensorSnapshot_t *SensorEventBus_Alloc(void) {
+  SensorEventRecord_t *rec = NULL;
+  uint8_t free_count = 0;
+
+  taskENTER_CRITICAL();
+  for (int i = 0; i < SENSOR_EVENT_POOL_SIZE; i++) {
+    if (g_pool[i].refs == 0) {
+      if (rec == NULL) {
+        rec = &g_pool[i];
+        rec->refs = 1; // 发布者持有，Publish 结束时释放
+      } else {
+        free_count++;
+      }
+    }
+  }
+  if (rec == NULL) {
+    g_stats.pool_empty++;
+  } else if (free_count < g_stats.pool_min_free) {
+    g_stats.pool_min_free = free_count;
+  }
+  taskEXIT_CRITICAL();
+
+  if (rec == NULL) {
+    return NULL;
+  }
+  memset(&rec->snapshot, 0, sizeof(rec->snapshot));
+  return &rec->snapshot;
+}
+
+/**
+ * @brief 发布快照
+ */
+void SensorEventBus_Publish(SensorSnapshot_t *snapshot) {
+  SensorEventRecord_t *rec = (SensorEventRecord_t *)snapshot;
+  uint8_t count = g_stats.subscriber_count;
+
+  if (snapshot == NULL) {
+    return;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    SensorEventSubscriber_t *sub = &g_subs[i];
+
+    if (sub->callback != NULL) {
+      sub->callback(&snapshot->event);
+      continue;
+    }
+
+    taskENTER_CRITICAL();
+    rec->refs++;
+    taskEXIT_CRITICAL();
+
+    // 队列满时丢弃该订阅者最旧的一条，保证它拿到的总是最新数据
+    if (xQueueSend(sub->queue, &rec, 0) != pdPASS) {
+      SensorEventRecord_t *oldest;
+      if (xQueueReceive(sub->queue, &oldest, 0) == pdPASS) {
+        SensorEventBus_Unref(oldest);
+      }
+      g_stats.dropped[i]++;
+      if (xQueueSend(sub->queue, &rec, 0) != pdPASS) {
+        SensorEventBus_Unref(rec);
+      }
+    }
+
+    if (sub->notify != NULL) {
+      sub->notify();
+    }
+  }
+
+  g_stats.published++;
+  SensorEventBus_Unref(rec); // 释放发布者的引用
+}
+
+/**
+ * @brief 获取总线统计
+ */
+void SensorEventBus_GetStats(SensorEventBusStats_t *stats) {
+  if (stats == NULL) {
+    return;
+  }
+  taskENTER_CRITICAL();
+  *stats = g_stats;
+  taskEXIT_CRITICAL();
+}
@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ * @file    sensor_event_bus.h
+ * @brief   传感器事件总线头文件
+ * @details 传感器任务每产生一个事件，只在固定大小的记录池中填写一次快照，
+ *          再把记录指针投递给所有订阅者：
+ *            - 队列订阅者 (UI、告警、上行等) 各有一条指针队列，在自己的任务
+ *              中取出、读取、释放；慢的订阅者只会丢掉自己队列中最旧的事件，
+ *              不会阻塞采样，也不影响其他订阅者；
+ *            - 回调订阅者在传感器任务中同步调用，只适合不会阻塞的轻量处理
+ *              (如写异步日志)。
+ *          记录按引用计数回收，最后一个订阅者释放后回到池中。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_EVENT_BUS_H
+#define __SENSOR_EVENT_BUS_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_EVENT_MAX_SUBSCRIBERS 6 // 订阅者上限 (UI、日志、Flash 记录、上行、Modbus、CAN)
+#define SENSOR_EVENT_QUEUE_LEN 8       // 每个队列订阅者的深度 (满时丢弃最旧事件)
+// 事件记录池大小 (所有队列共享)。队列订阅者都积压满时最多占用
+// 订阅者数 x (队列深度 + 1) + 1 条，池耗尽时新事件被丢弃并计入 pool_empty
+#define SENSOR_EVENT_POOL_SIZE 20
+
+/* --------------------------- 数据结构 --------------------------- */
+typedef int8_t SensorEventSub_t; // 订阅者编号，< 0 表示无效
+
+typedef void (*SensorEventNotify_t)(void);
+
+/**
+ * @brief 总线统计
+ */
+typedef struct {
+  uint32_t published;  // 已发布的事件数
+  uint32_t pool_empty; // 记录池耗尽而未发布的事件数
+  uint32_t dropped[SENSOR_EVENT_MAX_SUBSCRIBERS]; // 各订阅者因队列满丢弃的事件
+  uint8_t pool_min_free;   // 记录池历史最少空闲数
+  uint8_t subscriber_count;
+} SensorEventBusStats_t;
+
+/* --------------------------- 订阅接口 --------------------------- */
+
+/**
+ * @brief 注册队列订阅者
+ * @param name   订阅者名称 (仅用于日志)
+ * @param notify 每投递一条事件调用一次 (传感器任务上下文，不得阻塞)，可为 NULL
+ * @return 订阅者编号，失败返回 -1
+ */
+SensorEventSub_t SensorEventBus_Subscribe(const char *name,
+                                          SensorEventNotify_t notify);
+
+/**
+ * @brief 注册回调订阅者 (在传感器任务中同步调用)
+ * @return 订阅者编号，失败返回 -1
+ */
+SensorEventSub_t SensorEventBus_SubscribeCallback(const char *name,
+                                                  SensorEventCallback_t callback);
+
+/**
+ * @brief 取出一条事件 (队列订阅者调用)
+ * @param sub        订阅者编号
+ * @param timeout_ms 等待时间，0 不等待
+ * @return 事件快照 (只读)，用完后必须调用 SensorEventBus_Release；无事件返回 NULL
+ */
+const SensorSnapshot_t *SensorEventBus_Receive(SensorEventSub_t sub,
+                                               uint32_t timeout_ms);
+
+/**
+ * @brief 释放 SensorEventBus_Receive 取出的事件
+ */
+void SensorEventBus_Release(const SensorSnapshot_t *snapshot);
+
+/* --------------------------- 发布接口 (传感器任务) --------------------------- */
+
+/**
+ * @brief 从记录池取一条空记录
+ * @return 待填写的快照，池耗尽时返回 NULL (事件被丢弃并计数)
+ */
+SensorSnapshot_t *SensorEventBus_Alloc(void);
+
+/**
+ * @brief 发布 SensorEventBus_Alloc 取得并填好的快照，调用后不能再访问它
+ */
+void SensorEventBus_Publish(SensorSnapshot_t *snapshot);
+
+/**
+ * @brief 获取总线统计
+ */
+void SensorEventBus_GetStats(SensorEventBusStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_EVENT_BUS_H */
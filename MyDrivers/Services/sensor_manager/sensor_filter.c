@@ -0,0 +1,244 @@
+/**
+ ******************************************************************************
+ * @file    sensor_filter.c
+ * @brief   传感器通道滤波链源文件
+ * @details 低通为直接 I 型二阶节：系数 Q24，输出状态保留 12 位小数 (int64)，
+ *          截止频率很低时也不会因舍入产生明显的死区；系数按 b0+b1+b2 =
+ *          1+a1+a2 取整，直流增益严格为 1。滑动平均状态保留 8 位小数。
+ *          第一个样本 (及配置修改、重新初始化之后) 以该读数填满全部状态，
+ *          滤波器从稳态开始，没有启动过渡过程。
+ *          状态只由传感器任务修改；其他任务修改配置时只写配置字节，
+ *          传感器任务发现与当前状态的配置不同时重新初始化。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_filter.h"
+#include <math.h>
+#include <string.h>
+
+#define LOG_MODULE "FILTER"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define FILTER_VALUE_LIMIT (1L << 20) // 定点读数上限 (防止运算溢出)
+#define FILTER_BIQUAD_Q 24            // 低通系数小数位
+#define FILTER_STATE_Q 12             // 低通输出状态小数位
+#define FILTER_EWMA_Q 8               // 滑动平均状态小数位
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  int32_t b0, b1, a1, a2; // b2 = b0
+} SensorFilterBiquad_t;
+
+typedef struct {
+  SensorFilterSpec_t active; // 状态对应的配置
+  bool primed;               // 状态已由第一个样本初始化
+  uint8_t med_pos;           // 中值窗口写入位置
+  int32_t med[SENSOR_FILTER_MEDIAN_MAX];
+  int32_t x1, x2; // 低通输入延迟
+  int64_t y1, y2; // 低通输出延迟 (Q12)
+  int32_t ewma;   // 滑动平均 (Q8)
+} SensorFilterCtx_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+
+/* 二阶 Butterworth 低通 (双线性变换)，下标 k-1 对应截止频率 fs / 2^(k+2) */
+static const SensorFilterBiquad_t s_lowpass[7] = {
+    {1637978, 3275954, -15817711, 5592405}, // fs/8
+    {502554, 1005110, -24398159, 9631161},  // fs/16
+    {141645, 283290, -28920165, 12709529},  // fs/32
+    {37775, 75551, -31228458, 14602343},    // fs/64
+    {9766, 19531, -32390201, 15652048},     // fs/128
+    {2484, 4966, -32972151, 16204869},      // fs/256
+    {626, 1253, -33263270, 16488559},       // fs/512
+};
+
+static const SensorFilterSlot_t *s_slots;
+static uint8_t s_slot_count;
+static volatile SensorFilterSpec_t s_spec[SENSOR_FILTER_MAX_SLOTS];
+static SensorFilterCtx_t s_ctx[SENSOR_FILTER_MAX_SLOTS];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static void sensor_filter_prime(SensorFilterCtx_t *ctx, SensorFilterSpec_t spec,
+                                int32_t x) {
+  for (uint8_t i = 0; i < SENSOR_FILTER_MEDIAN_MAX; i++) {
+    ctx->med[i] = x;
+  }
+  ctx->med_pos = 0;
+  ctx->x1 = x;
+  ctx->x2 = x;
+  ctx->y1 = (int64_t)x * (1 << FILTER_STATE_Q);
+  ctx->y2 = ctx->y1;
+  ctx->ewma = x * (1 << FILTER_EWMA_Q);
+  ctx->active = spec;
+  ctx->primed = true;
+}
+
+/* 推入窗口并返回中值 (插入排序，最多 7 点) */
+static int32_t sensor_filter_median(SensorFilterCtx_t *ctx, uint8_t n,
+                                    int32_t x) {
+  int32_t sorted[SENSOR_FILTER_MEDIAN_MAX];
+
+  ctx->med[ctx->med_pos] = x;
+  ctx->med_pos = (uint8_t)((ctx->med_pos + 1) % n);
+  for (uint8_t i = 0; i < n; i++) {
+    int32_t v = ctx->med[i];
+    uint8_t j = i;
+
+    while (j > 0 && sorted[j - 1] > v) {
+      sorted[j] = sorted[j - 1];
+      j--;
+    }
+    sorted[j] = v;
+  }
+  return sorted[n / 2];
+}
+
+static int32_t sensor_filter_lowpass(SensorFilterCtx_t *ctx,
+                                     const SensorFilterBiquad_t *c, int32_t x) {
+  int64_t acc;
+  int64_t y;
+
+  // 输入项换算到与输出状态相同的小数位 (Q36) 后累加
+  acc = ((int64_t)c->b0 * x + (int64_t)c->b1 * ctx->x1 +
+         (int64_t)c->b0 * ctx->x2) *
+        (1 << FILTER_STATE_Q);
+  acc -= (int64_t)c->a1 * ctx->y1 + (int64_t)c->a2 * ctx->y2;
+  y = (acc + (1LL << (FILTER_BIQUAD_Q - 1))) >> FILTER_BIQUAD_Q;
+
+  ctx->x2 = ctx->x1;
+  ctx->x1 = x;
+  ctx->y2 = ctx->y1;
+  ctx->y1 = y;
+  return (int32_t)((y + (1 << (FILTER_STATE_Q - 1))) >> FILTER_STATE_Q);
+}
+
+static int32_t sensor_filter_ewma(SensorFilterCtx_t *ctx, uint8_t k,
+                                  int32_t x) {
+  ctx->ewma += (x * (1 << FILTER_EWMA_Q) - ctx->ewma) >> k;
+  return (ctx->ewma + (1 << (FILTER_EWMA_Q - 1))) >> FILTER_EWMA_Q;
+}
+
+/* 把全部槽位的配置写入配置存储 (一个键) */
+static void sensor_filter_save(void) {
+  uint8_t value[SENSOR_FILTER_MAX_SLOTS] = {0};
+
+  for (uint8_t i = 0; i < s_slot_count; i++) {
+    value[i] = s_spec[i];
+  }
+  ConfigStore_Set(CONFIG_KEY_SENSOR_FILTER, value, sizeof(value));
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 设置槽位表
+ */
+void SensorFilter_SetSlots(const SensorFilterSlot_t *slots, uint8_t count) {
+  uint8_t saved[SENSOR_FILTER_MAX_SLOTS];
+  bool has_saved;
+
+  memset(s_ctx, 0, sizeof(s_ctx));
+  s_slots = slots;
+  s_slot_count = (slots != NULL) ? count : 0;
+  if (s_slot_count > SENSOR_FILTER_MAX_SLOTS) {
+    s_slot_count = SENSOR_FILTER_MAX_SLOTS;
+  }
+
+  has_saved = ConfigStore_Get(CONFIG_KEY_SENSOR_FILTER, saved, sizeof(saved));
+  for (uint8_t i = 0; i < s_slot_count; i++) {
+    s_spec[i] = has_saved ? saved[i] : s_slots[i].default_spec;
+  }
+}
+
+/**
+ * @brief 滤波一个新样本
+ */
+void SensorFilter_Apply(SensorHandle_t sensor, float *values, uint8_t rejected,
+                        uint8_t count) {
+  for (uint8_t i = 0; i < s_slot_count; i++) {
+    const SensorFilterSlot_t *slot = &s_slots[i];
+    SensorFilterCtx_t *ctx = &s_ctx[i];
+    SensorFilterSpec_t spec = s_spec[i];
+    uint8_t ch = slot->channel;
+    float scaled;
+    int32_t x;
+
+    if (slot->sensor != sensor || ch >= count || (rejected & (1U << ch)) ||
+        spec == SENSOR_FILTER_NONE) {
+      continue;
+    }
+
+    scaled = roundf(values[ch] * (float)slot->scale);
+    if (scaled > (float)FILTER_VALUE_LIMIT) {
+      scaled = (float)FILTER_VALUE_LIMIT;
+    } else if (scaled < -(float)FILTER_VALUE_LIMIT) {
+      scaled = -(float)FILTER_VALUE_LIMIT;
+    }
+    x = (int32_t)scaled;
+
+    if (!ctx->primed || ctx->active != spec) {
+      sensor_filter_prime(ctx, spec, x);
+    }
+    if (SENSOR_FILTER_MEDIAN_OF(spec) != 0) {
+      x = sensor_filter_median(ctx, 1 + 2 * SENSOR_FILTER_MEDIAN_OF(spec), x);
+    }
+    if (SENSOR_FILTER_LOWPASS_OF(spec) != 0) {
+      x = sensor_filter_lowpass(ctx,
+                                &s_lowpass[SENSOR_FILTER_LOWPASS_OF(spec) - 1], x);
+    }
+    if (SENSOR_FILTER_EWMA_OF(spec) != 0) {
+      x = sensor_filter_ewma(ctx, SENSOR_FILTER_EWMA_OF(spec), x);
+    }
+    values[ch] = (float)x / (float)slot->scale;
+  }
+}
+
+/**
+ * @brief 丢弃滤波状态
+ */
+void SensorFilter_Reset(SensorHandle_t sensor) {
+  for (uint8_t i = 0; i < s_slot_count; i++) {
+    if (s_slots[i].sensor == sensor) {
+      s_ctx[i].primed = false;
+    }
+  }
+}
+
+/**
+ * @brief 修改槽位的配置并保存
+ */
+bool SensorFilter_SetSpec(uint8_t index, SensorFilterSpec_t spec) {
+  if (index >= s_slot_count) {
+    return false;
+  }
+  s_spec[index] = spec;
+  sensor_filter_save();
+  LOG_INFO("槽位 %u 滤波配置改为 0x%02X", (unsigned)index, (unsigned)spec);
+  return true;
+}
+
+/**
+ * @brief 获取槽位数
+ */
+uint8_t SensorFilter_GetSlotCount(void) { return s_slot_count; }
+
+/**
+ * @brief 获取槽位及其当前配置
+ */
+bool SensorFilter_GetSlot(uint8_t index, const SensorFilterSlot_t **slot,
+                          SensorFilterSpec_t *spec) {
+  if (index >= s_slot_count) {
+    return false;
+  }
+  if (slot != NULL) {
+    *slot = &s_slots[index];
+  }
+  if (spec != NULL) {
+    *spec = s_spec[index];
+  }
+  return true;
+}
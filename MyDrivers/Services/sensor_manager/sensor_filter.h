@@ -0,0 +1,114 @@
+/**
+ ******************************************************************************
+ * @file    sensor_filter.h
+ * @brief   传感器通道滤波链头文件
+ * @details 在质量检查之后、写入历史之前，对配置了滤波的通道依次执行
+ *            1. 中值 (3/5/7 点)：去除孤立尖峰；
+ *            2. 二阶 Butterworth 低通 (截止频率为采样率的 1/8 ~ 1/512)；
+ *            3. 一阶指数滑动平均 (alpha = 2^-k)。
+ *          全部为定点运算：读数按槽位的 scale 换算为整数，每级为常数次整数
+ *          运算，状态为每个槽位固定大小的结构体 (不分配内存)。
+ *          驱动只需返回原始读数，不必在读取回调中多次采样求平均。
+ *          每个槽位的滤波配置为一个字节 (SensorFilterSpec_t)，四个槽位合并
+ *          保存在配置存储的 CONFIG_KEY_SENSOR_FILTER 中，未保存时使用槽位表
+ *          中的默认值；运行中修改后由传感器任务在下一个样本时重新初始化状态。
+ *          低通与滑动平均按样本计，截止频率随采样间隔 (含自适应采样) 变化；
+ *          告警依赖单个样本的通道 (烟雾) 默认不滤波。被剔除的样本不进入
+ *          滤波器。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_FILTER_H
+#define __SENSOR_FILTER_H
+
+#include "config_store.h"
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_FILTER_MAX_SLOTS CONFIG_STORE_VALUE_MAX // 槽位数 (每个槽位占配置键的一个字节)
+#define SENSOR_FILTER_MEDIAN_MAX 7                     // 中值窗口最大点数
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 滤波配置 (一个字节)
+ * @details bit 1:0 中值窗口 (0 关闭，1/2/3 = 3/5/7 点)
+ *          bit 4:2 低通档位 (0 关闭，k = 1~7: 截止频率 fs / 2^(k+2))
+ *          bit 7:5 滑动平均 (0 关闭，k = 1~7: alpha = 2^-k)
+ */
+typedef uint8_t SensorFilterSpec_t;
+
+#define SENSOR_FILTER_SPEC(median, lowpass, ewma)                              \
+  ((SensorFilterSpec_t)(((median)&0x03) | (((lowpass)&0x07) << 2) |            \
+                        (((ewma)&0x07) << 5)))
+#define SENSOR_FILTER_MEDIAN_OF(spec) ((spec)&0x03)
+#define SENSOR_FILTER_LOWPASS_OF(spec) (((spec) >> 2) & 0x07)
+#define SENSOR_FILTER_EWMA_OF(spec) (((spec) >> 5) & 0x07)
+#define SENSOR_FILTER_NONE ((SensorFilterSpec_t)0)
+
+/**
+ * @brief 一个滤波槽位 (对应传感器的一个通道)
+ */
+typedef struct {
+  SensorHandle_t sensor;           // 传感器实例 (写类型即该类型的第一个实例)
+  uint8_t channel;                 // 通道下标
+  uint16_t scale;                  // 定点换算系数 (整数值 = 实际值 * scale)，量程 * scale < 2^20
+  SensorFilterSpec_t default_spec; // 配置存储中没有保存时的默认配置
+} SensorFilterSlot_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 设置槽位表 (表须为静态存储)，并从配置存储读取各槽位的配置
+ * @param slots 槽位数组
+ * @param count 个数，超过 SENSOR_FILTER_MAX_SLOTS 的部分忽略
+ * @note  在注册传感器之前、配置存储初始化之后调用
+ */
+void SensorFilter_SetSlots(const SensorFilterSlot_t *slots, uint8_t count);
+
+/**
+ * @brief 滤波一个新样本 (由传感器任务在质量检查之后调用)
+ * @param sensor   传感器实例句柄
+ * @param values   各通道数值，输出为滤波后的值
+ * @param rejected 质量检查剔除的通道位图，这些通道不滤波
+ * @param count    通道数
+ */
+void SensorFilter_Apply(SensorHandle_t sensor, float *values, uint8_t rejected,
+                        uint8_t count);
+
+/**
+ * @brief 丢弃滤波状态 (传感器重新初始化后调用)，下一个样本重新初始化
+ */
+void SensorFilter_Reset(SensorHandle_t sensor);
+
+/**
+ * @brief 修改槽位的配置并保存到配置存储 (任意任务)
+ * @return false: 下标越界
+ */
+bool SensorFilter_SetSpec(uint8_t index, SensorFilterSpec_t spec);
+
+/**
+ * @brief 获取槽位数
+ */
+uint8_t SensorFilter_GetSlotCount(void);
+
+/**
+ * @brief 获取槽位及其当前配置
+ * @return false: 下标越界
+ */
+bool SensorFilter_GetSlot(uint8_t index, const SensorFilterSlot_t **slot,
+                          SensorFilterSpec_t *spec);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_FILTER_H */
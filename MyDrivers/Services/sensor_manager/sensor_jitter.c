@@ -0,0 +1,127 @@
+/**
+ ******************************************************************************
+ * @file    sensor_jitter.c
+ * @brief   采样抖动统计源文件
+ * @details 写者 (传感器任务) 优先级高于读者 (命令行任务)，读者在临界区内
+ *          拷贝，不会被写者打断，写者本身无需加锁。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_jitter.h"
+#include "FreeRTOS.h"
+#include "metrics.h"
+#include "task.h"
+#include <string.h>
+
+/* --------------------------- 私有变量 --------------------------- */
+static const uint32_t s_bounds_us[SENSOR_JITTER_BUCKETS - 1] = {
+    100,   250,   500,    1000,   2500,   5000,
+    10000, 25000, 50000, 100000, 250000, 500000};
+
+static SensorJitter_t s_jitter[SENSOR_TYPE_MAX][SENSOR_MAX_PER_TYPE];
+
+/* 句柄 -> 统计项，无效句柄返回 NULL */
+static SensorJitter_t *sensor_jitter_slot(SensorHandle_t sensor) {
+  SensorType_t type = SENSOR_HANDLE_TYPE(sensor);
+  uint8_t index = SENSOR_HANDLE_INDEX(sensor);
+
+  if (type <= SENSOR_TYPE_NONE || type >= SENSOR_TYPE_MAX ||
+      index >= SENSOR_MAX_PER_TYPE) {
+    return NULL;
+  }
+  return &s_jitter[type][index];
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 记录一轮成功的采样
+ */
+void SensorJitter_Record(SensorHandle_t sensor, uint32_t due_ms,
+                         uint64_t start_us, uint64_t end_us) {
+  SensorJitter_t *j = sensor_jitter_slot(sensor);
+  int32_t late_ms;
+  uint32_t late_us;
+
+  if (j == NULL) {
+    return;
+  }
+
+  // due_ms 是 32 位毫秒时基，与微秒时钟的低 32 位毫秒数比较
+  late_ms = (int32_t)((uint32_t)(start_us / 1000U) - due_ms);
+  late_us = late_ms < 0 ? 0
+                        : (uint32_t)late_ms * 1000U + (uint32_t)(start_us % 1000U);
+
+  SensorJitter_HistAdd(&j->lateness, late_us);
+  METRIC_OBSERVE(METRIC_SENSOR_LATENESS, late_us); // 所有实例合并
+  SensorJitter_HistAdd(&j->duration, (uint32_t)(end_us - start_us));
+}
+
+/**
+ * @brief 获取统计拷贝
+ */
+bool SensorJitter_Get(SensorHandle_t sensor, SensorJitter_t *out) {
+  const SensorJitter_t *j = sensor_jitter_slot(sensor);
+
+  if (j == NULL || out == NULL) {
+    return false;
+  }
+  taskENTER_CRITICAL();
+  *out = *j;
+  taskEXIT_CRITICAL();
+  return true;
+}
+
+/**
+ * @brief 清零统计
+ */
+void SensorJitter_Reset(SensorHandle_t sensor) {
+  SensorJitter_t *j = sensor_jitter_slot(sensor);
+
+  taskENTER_CRITICAL();
+  if (sensor == SENSOR_TYPE_NONE) {
+    memset(s_jitter, 0, sizeof(s_jitter));
+  } else if (j != NULL) {
+    memset(j, 0, sizeof(*j));
+  }
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 向直方图加入一个样本
+ */
+void SensorJitter_HistAdd(SensorJitterHist_t *hist, uint32_t us) {
+  uint8_t i = 0;
+
+  while (i < SENSOR_JITTER_BUCKETS - 1 && us > s_bounds_us[i]) {
+    i++;
+  }
+  hist->bins[i]++;
+  hist->count++;
+  if (us > hist->max_us) {
+    hist->max_us = us;
+  }
+}
+
+/**
+ * @brief 估计分位数
+ */
+uint32_t SensorJitter_Percentile(const SensorJitterHist_t *hist, uint8_t pct) {
+  uint32_t target;
+  uint32_t seen = 0;
+
+  if (hist->count == 0) {
+    return 0;
+  }
+  // 第 ceil(count * pct / 100) 个样本所在的桶
+  target = (uint32_t)(((uint64_t)hist->count * pct + 99U) / 100U);
+  for (uint8_t i = 0; i < SENSOR_JITTER_BUCKETS - 1; i++) {
+    seen += hist->bins[i];
+    if (seen >= target) {
+      return s_bounds_us[i] < hist->max_us ? s_bounds_us[i] : hist->max_us;
+    }
+  }
+  return hist->max_us;
+}
@@ -0,0 +1,91 @@
+/**
+ ******************************************************************************
+ * @file    sensor_jitter.h
+ * @brief   采样抖动统计头文件
+ * @details 每个传感器实例记录两组固定桶直方图：
+ *            - 启动延迟：本轮计划时刻 (cycle_due_time) 到实际开始转换的时间；
+ *            - 读取耗时：开始转换到样本提交的时间 (分阶段读取含转换等待)。
+ *          桶边界按 1-2.5-5 递增 (100 us ~ 500 ms)，分位数取所在桶的上界，
+ *          最大值单独精确记录。只统计成功的采样轮次。
+ *          由传感器任务写入，命令行 jitter 命令读取与清零。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_JITTER_H
+#define __SENSOR_JITTER_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_JITTER_BUCKETS 13 // 12 个边界 + 溢出桶
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 固定桶直方图 (单位: us)
+ */
+typedef struct {
+  uint32_t count;                        // 样本数
+  uint32_t max_us;                       // 最大值
+  uint32_t bins[SENSOR_JITTER_BUCKETS];  // 各桶计数
+} SensorJitterHist_t;
+
+/**
+ * @brief 单个传感器的抖动统计
+ */
+typedef struct {
+  SensorJitterHist_t lateness; // 启动延迟
+  SensorJitterHist_t duration; // 读取耗时
+} SensorJitter_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 记录一轮成功的采样 (传感器任务调用)
+ * @param sensor   实例句柄
+ * @param due_ms   计划时刻 (HAL_GetTick 时基)
+ * @param start_us 实际开始转换时刻 (SysClock_Micros)
+ * @param end_us   样本提交时刻 (SysClock_Micros)
+ */
+void SensorJitter_Record(SensorHandle_t sensor, uint32_t due_ms,
+                         uint64_t start_us, uint64_t end_us);
+
+/**
+ * @brief 获取统计拷贝
+ * @return false: 句柄无效
+ */
+bool SensorJitter_Get(SensorHandle_t sensor, SensorJitter_t *out);
+
+/**
+ * @brief 清零统计
+ * @param sensor 实例句柄，SENSOR_TYPE_NONE 表示全部
+ */
+void SensorJitter_Reset(SensorHandle_t sensor);
+
+/**
+ * @brief 估计分位数
+ * @param hist 直方图
+ * @param pct  百分位 (1~100)
+ * @return 所在桶的上界 (us)；落在溢出桶时返回最大值，无样本返回 0
+ */
+uint32_t SensorJitter_Percentile(const SensorJitterHist_t *hist, uint8_t pct);
+
+/**
+ * @brief 向直方图加入一个样本 (其他模块复用同一种直方图时调用)
+ * @note  不加锁，调用者保证与读者互斥
+ */
+void SensorJitter_HistAdd(SensorJitterHist_t *hist, uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_JITTER_H */
@@ -0,0 +1,128 @@
+/**
+ ******************************************************************************
+ * @file    sensor_latency.c
+ * @brief   端到端延迟统计源文件
+ * @details 写者分布在传感器任务、界面任务、输出控制任务与 DMA 中断中，
+ *          所有修改都在屏蔽中断的短临界区内完成 (taskENTER_CRITICAL_FROM_ISR
+ *          在任务中同样可用)；读者在同样的临界区内拷贝。
+ *          上屏分两步交接：控件更新时写入 pending，帧绘制完成时转入
+ *          in_flight，最后一段传输完成时记录并清零。同步刷屏时传输已在
+ *          绘制完成前结束，由调用者在绘制完成后补一次 FrameFlushed。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_latency.h"
+#include "FreeRTOS.h"
+#include "sys_clock.h"
+#include "task.h"
+#include <string.h>
+
+/* --------------------------- 私有变量 --------------------------- */
+static const char *const s_stage_names[SENSOR_LATENCY_STAGES] = {
+    "commit", "publish", "ui", "display", "alarm", "buzzer"};
+
+static SensorJitterHist_t s_hist[SENSOR_LATENCY_STAGES];
+static uint64_t s_display_pending;   // 已更新控件、尚未绘制的最早样本
+static uint64_t s_display_in_flight; // 已绘制、最后一段尚未传输完成的样本
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/* 在临界区内记录 (now_us 在临界区外取得) */
+static void sensor_latency_add(SensorLatencyStage_t stage, uint64_t sample_us,
+                               uint64_t now_us) {
+  uint64_t us = now_us > sample_us ? now_us - sample_us : 0;
+
+  SensorJitter_HistAdd(&s_hist[stage], us > UINT32_MAX ? UINT32_MAX : (uint32_t)us);
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 记录一个阶段的延迟
+ */
+void SensorLatency_Record(SensorLatencyStage_t stage, uint64_t sample_us) {
+  uint64_t now_us;
+  UBaseType_t mask;
+
+  if (sample_us == 0 || stage >= SENSOR_LATENCY_STAGES) {
+    return;
+  }
+  now_us = SysClock_Micros();
+  mask = taskENTER_CRITICAL_FROM_ISR();
+  sensor_latency_add(stage, sample_us, now_us);
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/**
+ * @brief 控件已更新，等待上屏
+ */
+void SensorLatency_DisplayQueued(uint64_t sample_us) {
+  UBaseType_t mask;
+
+  if (sample_us == 0) {
+    return;
+  }
+  mask = taskENTER_CRITICAL_FROM_ISR();
+  if (s_display_pending == 0 || sample_us < s_display_pending) {
+    s_display_pending = sample_us;
+  }
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/**
+ * @brief 帧绘制完成
+ */
+void SensorLatency_FrameRendered(void) {
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+  if (s_display_pending != 0) {
+    s_display_in_flight = s_display_pending;
+    s_display_pending = 0;
+  }
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/**
+ * @brief 最后一段传输完成
+ */
+void SensorLatency_FrameFlushed(void) {
+  uint64_t now_us = SysClock_Micros();
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+  if (s_display_in_flight != 0) {
+    sensor_latency_add(SENSOR_LATENCY_DISPLAY, s_display_in_flight, now_us);
+    s_display_in_flight = 0;
+  }
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/**
+ * @brief 获取直方图拷贝
+ */
+void SensorLatency_Get(SensorJitterHist_t out[SENSOR_LATENCY_STAGES]) {
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+  memcpy(out, s_hist, sizeof(s_hist));
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/**
+ * @brief 清零统计
+ */
+void SensorLatency_Reset(void) {
+  UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+  memset(s_hist, 0, sizeof(s_hist));
+  s_display_pending = 0;
+  s_display_in_flight = 0;
+  taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+/**
+ * @brief 阶段名称
+ */
+const char *SensorLatency_StageName(SensorLatencyStage_t stage) {
+  return stage < SENSOR_LATENCY_STAGES ? s_stage_names[stage] : "?";
+}
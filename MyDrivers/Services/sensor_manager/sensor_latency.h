@@ -0,0 +1,98 @@
+/**
+ ******************************************************************************
+ * @file    sensor_latency.h
+ * @brief   传感器到像素/蜂鸣器的端到端延迟统计头文件
+ * @details 每个样本的转换开始时刻 (SensorData_t.timestamp_us) 作为标签随
+ *          事件快照与告警输出传递，各阶段到达时以该标签为起点记录一次
+ *          延迟，因此每个直方图都是"从转换开始到本阶段"的累计时间：
+ *
+ *            COMMIT   样本提交 (转换与读取完成)
+ *            PUBLISH  事件投递到总线 (含数据更新的合并窗口)
+ *            UI       界面任务取出快照并更新控件
+ *            DISPLAY  其后第一帧绘制完成且最后一段传输到 LCD
+ *            ALARM    告警规则触发 (只记录激活，不记录解除)
+ *            BUZZER   输出控制任务让蜂鸣器开始鸣响
+ *
+ *          相邻阶段的分位数之差即该阶段的耗时。帧与控件更新不是一一对应：
+ *          一帧之前更新的多个样本只按最早的一个记录 (最坏情况)，熄屏期间
+ *          不记录。直方图与采样抖动统计相同 (见 sensor_jitter.h)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_LATENCY_H
+#define __SENSOR_LATENCY_H
+
+#include "sensor_jitter.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 延迟统计阶段
+ */
+typedef enum {
+  SENSOR_LATENCY_COMMIT = 0, // 样本提交
+  SENSOR_LATENCY_PUBLISH,    // 事件投递
+  SENSOR_LATENCY_UI,         // 界面更新控件
+  SENSOR_LATENCY_DISPLAY,    // 像素上屏
+  SENSOR_LATENCY_ALARM,      // 告警触发
+  SENSOR_LATENCY_BUZZER,     // 蜂鸣器鸣响
+  SENSOR_LATENCY_STAGES
+} SensorLatencyStage_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 记录一个阶段的延迟
+ * @param stage     阶段
+ * @param sample_us 样本的转换开始时刻 (SysClock_Micros)，0 表示无标签，忽略
+ * @note  可在任务和中断中调用
+ */
+void SensorLatency_Record(SensorLatencyStage_t stage, uint64_t sample_us);
+
+/**
+ * @brief 界面已按某个样本更新控件，等待下一帧上屏
+ * @note  界面任务调用；上一帧之前已有待上屏的样本时保留较早的一个
+ */
+void SensorLatency_DisplayQueued(uint64_t sample_us);
+
+/**
+ * @brief 一帧绘制完成 (最后一段可能仍在传输)，待上屏的样本转入传输中
+ * @note  LVGL 刷新完成回调中调用
+ */
+void SensorLatency_FrameRendered(void);
+
+/**
+ * @brief 一帧的最后一段已传输到 LCD，记录传输中样本的 DISPLAY 延迟
+ * @note  可在 DMA 完成中断中调用；没有传输中的样本时不做任何事
+ */
+void SensorLatency_FrameFlushed(void);
+
+/**
+ * @brief 获取各阶段直方图的拷贝
+ * @param out SENSOR_LATENCY_STAGES 个直方图
+ */
+void SensorLatency_Get(SensorJitterHist_t out[SENSOR_LATENCY_STAGES]);
+
+/**
+ * @brief 清零统计
+ */
+void SensorLatency_Reset(void);
+
+/**
+ * @brief 阶段名称 (命令行输出)
+ */
+const char *SensorLatency_StageName(SensorLatencyStage_t stage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_LATENCY_H */
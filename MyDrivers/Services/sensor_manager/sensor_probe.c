@@ -0,0 +1,154 @@
+/**
+ ******************************************************************************
+ * @file    sensor_probe.c
+ * @brief   I2C 传感器自动发现源文件
+ * @details 状态只由调用 Scan/Poll 的任务修改 (启动任务完成 Scan 后交给
+ *          监控任务)，GetStatus 的读者只读取单个字段，不需要加锁。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_probe.h"
+#include "i2c_bus_manager.h"
+#include "main.h"
+
+#define LOG_MODULE "PROBE"
+#include "log.h"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  SensorHandle_t handle; // 已注册的实例
+  uint8_t misses;        // 连续未应答次数
+  uint32_t next_ms;      // 下一次探测时刻 (HAL_GetTick 时基)
+} SensorProbeState_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static const SensorProbeCandidate_t *s_candidates;
+static uint8_t s_count;
+static SensorProbeState_t s_state[SENSOR_PROBE_MAX_CANDIDATES];
+static volatile bool s_scanned; // Scan 已完成，之后由 Poll 接管
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/* 下一次探测前的等待时间：BACKOFF_MIN << (misses - 1)，不超过 BACKOFF_MAX */
+static uint32_t sensor_probe_backoff(uint8_t misses) {
+  uint32_t backoff = SENSOR_PROBE_BACKOFF_MIN_MS;
+
+  while (--misses > 0 && backoff < SENSOR_PROBE_BACKOFF_MAX_MS / 2U) {
+    backoff *= 2U;
+  }
+  return backoff < SENSOR_PROBE_BACKOFF_MAX_MS ? backoff
+                                               : SENSOR_PROBE_BACKOFF_MAX_MS;
+}
+
+/* 探测一个候选，应答则注册；返回是否注册了新实例 */
+static bool sensor_probe_one(uint8_t i) {
+  const SensorProbeCandidate_t *c = &s_candidates[i];
+  SensorProbeState_t *st = &s_state[i];
+  I2C_Transaction_t xfer;
+  HAL_StatusTypeDef status;
+
+  // 不带数据的地址事务：只看从机是否应答
+  I2C_Transaction_Init(&xfer, c->addr);
+  xfer.timeout_ms = SENSOR_PROBE_TIMEOUT_MS;
+  status = I2C_Bus_Execute(&xfer);
+
+  if (status == HAL_OK) {
+    st->handle = c->attach(c->addr);
+    if (st->handle != SENSOR_HANDLE_INVALID) {
+      LOG_INFO("发现 %s (0x%02X)", SensorType_ToString(c->type), c->addr);
+      return true;
+    }
+    // 应答但注册失败 (实例已满)：按未应答处理，避免每次都重试
+  } else if (status != HAL_ERROR) {
+    // 总线忙或超时不代表设备缺失，下一轮再试
+    st->next_ms = HAL_GetTick() + SENSOR_PROBE_BACKOFF_MIN_MS;
+    return false;
+  }
+
+  if (st->misses < 0xFF) {
+    st->misses++;
+  }
+  st->next_ms = HAL_GetTick() + sensor_probe_backoff(st->misses);
+  if (st->misses == 1) {
+    LOG_INFO("%s (0x%02X) 未应答，将按退避间隔重新探测",
+             SensorType_ToString(c->type), c->addr);
+  }
+  return false;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 设置候选表
+ */
+void SensorProbe_SetCandidates(const SensorProbeCandidate_t *candidates,
+                               uint8_t count) {
+  if (count > SENSOR_PROBE_MAX_CANDIDATES) {
+    count = SENSOR_PROBE_MAX_CANDIDATES;
+  }
+  s_scanned = false;
+  for (uint8_t i = 0; i < SENSOR_PROBE_MAX_CANDIDATES; i++) {
+    s_state[i].handle = SENSOR_HANDLE_INVALID;
+    s_state[i].misses = 0;
+    s_state[i].next_ms = 0;
+  }
+  s_candidates = candidates;
+  s_count = (candidates != NULL) ? count : 0;
+}
+
+/**
+ * @brief 立即探测全部候选
+ */
+uint8_t SensorProbe_Scan(void) {
+  uint8_t attached = 0;
+
+  for (uint8_t i = 0; i < s_count; i++) {
+    if (s_state[i].handle == SENSOR_HANDLE_INVALID && sensor_probe_one(i)) {
+      attached++;
+    }
+  }
+  LOG_INFO("总线探测完成：%u/%u 个候选在线", attached, s_count);
+  s_scanned = true;
+  return attached;
+}
+
+/**
+ * @brief 重新探测已到期的未发现候选
+ */
+void SensorProbe_Poll(void) {
+  uint32_t now = HAL_GetTick();
+
+  if (!s_scanned) {
+    return;
+  }
+  for (uint8_t i = 0; i < s_count; i++) {
+    if (s_state[i].handle == SENSOR_HANDLE_INVALID &&
+        (int32_t)(now - s_state[i].next_ms) >= 0) {
+      sensor_probe_one(i);
+    }
+  }
+}
+
+/**
+ * @brief 获取候选设备的探测状态
+ */
+bool SensorProbe_GetStatus(uint8_t i, SensorProbeStatus_t *out) {
+  const SensorProbeState_t *st;
+  int32_t remain;
+
+  if (i >= s_count || out == NULL) {
+    return false;
+  }
+  st = &s_state[i];
+  out->type = s_candidates[i].type;
+  out->addr = s_candidates[i].addr;
+  out->handle = st->handle;
+  out->misses = st->misses;
+  remain = (int32_t)(st->next_ms - HAL_GetTick());
+  out->next_in_ms = (st->handle == SENSOR_HANDLE_INVALID && remain > 0)
+                        ? (uint32_t)remain
+                        : 0;
+  return true;
+}
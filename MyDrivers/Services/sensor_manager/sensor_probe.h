@@ -0,0 +1,100 @@
+/**
+ ******************************************************************************
+ * @file    sensor_probe.h
+ * @brief   I2C 传感器自动发现头文件
+ * @details 按声明式候选表 (类型 + 7 位地址 + 注册函数) 探测 I2C 总线：
+ *            - 启动时 SensorProbe_Scan() 探测全部候选，应答的地址立即
+ *              调用驱动的注册函数成为传感器实例；
+ *            - 未应答的地址按指数退避 (SENSOR_PROBE_BACKOFF_MIN_MS 起逐次
+ *              加倍，最长 SENSOR_PROBE_BACKOFF_MAX_MS) 由 SensorProbe_Poll()
+ *              重新探测，插上后自动注册；
+ *          探测是不带数据的地址事务 (只看 ACK)，经总线服务执行，与传感器
+ *          读取互不打断。已注册的设备之后掉线由传感器任务按同样的退避方式
+ *          重新初始化 (见 SENSOR_ERROR_ABSENT_COUNT)，这里不再探测。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_PROBE_H
+#define __SENSOR_PROBE_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_PROBE_MAX_CANDIDATES 6        // 候选表最大条数
+#define SENSOR_PROBE_TIMEOUT_MS 10           // 单次探测超时
+#define SENSOR_PROBE_BACKOFF_MIN_MS 5000     // 未应答后的首次重新探测间隔
+#define SENSOR_PROBE_BACKOFF_MAX_MS 600000   // 最长重新探测间隔 (10 分钟)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 驱动注册函数：按地址注册一个实例
+ * @return 实例句柄，失败返回 SENSOR_HANDLE_INVALID
+ */
+typedef SensorHandle_t (*SensorProbeAttach_t)(uint8_t addr);
+
+/**
+ * @brief 一个候选设备
+ */
+typedef struct {
+  SensorType_t type;          // 传感器类型 (仅用于显示)
+  uint8_t addr;               // 7 位 I2C 地址
+  SensorProbeAttach_t attach; // 应答后调用的注册函数
+} SensorProbeCandidate_t;
+
+/**
+ * @brief 候选设备的探测状态
+ */
+typedef struct {
+  SensorType_t type;     // 传感器类型
+  uint8_t addr;          // 7 位 I2C 地址
+  SensorHandle_t handle; // 已注册的实例，未发现时为 SENSOR_HANDLE_INVALID
+  uint8_t misses;        // 连续未应答次数
+  uint32_t next_in_ms;   // 距下一次探测的时间 (已注册时为 0)
+} SensorProbeStatus_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 设置候选表 (表须为静态存储) 并清空状态
+ * @param candidates 候选数组
+ * @param count      条数，超过 SENSOR_PROBE_MAX_CANDIDATES 的部分忽略
+ */
+void SensorProbe_SetCandidates(const SensorProbeCandidate_t *candidates,
+                               uint8_t count);
+
+/**
+ * @brief 立即探测全部候选 (启动时调用一次)
+ * @return 本次注册的实例数
+ * @note  须在其他传感器注册完成之后调用：此后只有 SensorProbe_Poll()
+ *        所在的任务会注册新实例
+ */
+uint8_t SensorProbe_Scan(void);
+
+/**
+ * @brief 重新探测已到期的未发现候选 (在低优先级任务中周期调用)
+ * @note  SensorProbe_Scan() 完成之前不做任何事
+ */
+void SensorProbe_Poll(void);
+
+/**
+ * @brief 获取候选设备的探测状态
+ * @param i   候选下标
+ * @param out 输出
+ * @return false: 下标越界
+ */
+bool SensorProbe_GetStatus(uint8_t i, SensorProbeStatus_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_PROBE_H */
@@ -0,0 +1,204 @@
+/**
+ ******************************************************************************
+ * @file    sensor_quality.c
+ * @brief   传感器数据质量检查源文件
+ * @details 每条规则保存最近两个原始读数 (尖峰滤波)、上一个有效值与候选的
+ *          新电平 (跳变确认)，每个样本为常数次比较。规则表与状态只由传感器
+ *          任务修改，命令行读取计数时不加锁。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_quality.h"
+#include <math.h>
+#include <string.h>
+
+#define LOG_MODULE "QUALITY"
+#include "log.h"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  SensorQualityStats_t pub;
+  float raw[2];      // 最近两个在范围内的原始读数 (raw[1] 较新)
+  uint8_t raw_count; // raw 中的读数个数
+  bool has_good;     // 已有有效值
+  float good;        // 上一个有效值
+  float candidate;   // 被剔除的跳变读数 (候选的新电平)
+  uint8_t pending;   // 连续落在候选电平附近的读数个数
+} SensorQualityCtx_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static const SensorQualityRule_t *s_rules;
+static uint8_t s_rule_count;
+static SensorQualityCtx_t s_ctx[SENSOR_QUALITY_MAX_RULES];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static float sensor_quality_median3(float a, float b, float c) {
+  if (a > b) {
+    float t = a;
+    a = b;
+    b = t;
+  }
+  // 此时 a <= b
+  if (c <= a)
+    return a;
+  if (c >= b)
+    return b;
+  return c;
+}
+
+/**
+ * @brief 检查单个通道
+ * @param value 输入读数，输出采用的值
+ * @param preset 驱动预先标记的标志
+ * @return 质量标志
+ */
+static uint8_t sensor_quality_eval(const SensorQualityRule_t *rule,
+                                   SensorQualityCtx_t *ctx, float *value,
+                                   uint8_t preset) {
+  float x = *value;
+  uint8_t flags = SENSOR_QUALITY_OK;
+
+  ctx->pub.checked++;
+
+  // 0. 驱动标记无效：不进入滤波窗口，也不作为跳变的候选电平
+  if (preset & SENSOR_QUALITY_INVALID) {
+    flags = SENSOR_QUALITY_INVALID;
+  } else if (!(x >= rule->min && x <= rule->max)) {
+    // 1. 合理范围 (NaN 同样剔除)
+    flags = SENSOR_QUALITY_RANGE;
+  } else {
+    // 2. 尖峰滤波：窗口保存原始读数，不保存滤波结果
+    if (rule->spike > 0.0f) {
+      if (ctx->raw_count == 2) {
+        float m = sensor_quality_median3(ctx->raw[0], ctx->raw[1], x);
+
+        ctx->raw[0] = ctx->raw[1];
+        ctx->raw[1] = x;
+        if (fabsf(x - m) > rule->spike) {
+          flags |= SENSOR_QUALITY_FILTERED;
+          x = m;
+        }
+      } else {
+        ctx->raw[ctx->raw_count++] = x;
+      }
+    }
+
+    // 3. 最大跳变：持续处于新电平的读数在确认后接受
+    if (rule->max_step > 0.0f && ctx->has_good &&
+        fabsf(x - ctx->good) > rule->max_step) {
+      if (ctx->pending > 0 && fabsf(x - ctx->candidate) <= rule->max_step) {
+        ctx->pending++;
+      } else {
+        ctx->pending = 1;
+      }
+      ctx->candidate = x;
+      if (ctx->pending < SENSOR_QUALITY_STEP_CONFIRM) {
+        flags = (uint8_t)((flags & ~SENSOR_QUALITY_FILTERED) |
+                          SENSOR_QUALITY_STEP);
+      }
+    }
+  }
+
+  if (flags & SENSOR_QUALITY_REJECTED) {
+    ctx->pub.rejected++;
+    // 保持上一个有效值；还没有有效值时取范围内最近的值
+    if (ctx->has_good) {
+      *value = ctx->good;
+    } else {
+      *value = (x > rule->max) ? rule->max : (x >= rule->min ? x : rule->min);
+    }
+    return flags;
+  }
+
+  ctx->pending = 0;
+  ctx->has_good = true;
+  ctx->good = x;
+  if (flags & SENSOR_QUALITY_FILTERED) {
+    ctx->pub.filtered++;
+  }
+  *value = x;
+  return flags;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 设置规则表
+ */
+void SensorQuality_SetRules(const SensorQualityRule_t *rules, uint8_t count) {
+  memset(s_ctx, 0, sizeof(s_ctx));
+  s_rules = rules;
+  s_rule_count = (rules != NULL) ? count : 0;
+  if (s_rule_count > SENSOR_QUALITY_MAX_RULES) {
+    s_rule_count = SENSOR_QUALITY_MAX_RULES;
+  }
+}
+
+/**
+ * @brief 检查一个新样本
+ */
+uint8_t SensorQuality_Check(SensorHandle_t sensor, float *values,
+                            uint8_t *quality, uint8_t count) {
+  uint8_t rejected = 0;
+
+  for (uint8_t ch = 0; ch < count; ch++) {
+    quality[ch] &= SENSOR_QUALITY_INVALID; // 只保留驱动标记
+    if (quality[ch] != SENSOR_QUALITY_OK) {
+      rejected |= (uint8_t)(1U << ch);
+    }
+  }
+  for (uint8_t i = 0; i < s_rule_count; i++) {
+    const SensorQualityRule_t *rule = &s_rules[i];
+    uint8_t ch = rule->channel;
+
+    if (rule->sensor != sensor || ch >= count) {
+      continue;
+    }
+    quality[ch] = sensor_quality_eval(rule, &s_ctx[i], &values[ch], quality[ch]);
+    if (quality[ch] & SENSOR_QUALITY_REJECTED) {
+      rejected |= (uint8_t)(1U << ch);
+      LOG_DEBUG("剔除读数: 通道 %u 标志 0x%02X", (unsigned)ch,
+                (unsigned)quality[ch]);
+    }
+  }
+  return rejected;
+}
+
+/**
+ * @brief 丢弃滤波与跳变状态
+ */
+void SensorQuality_Reset(SensorHandle_t sensor) {
+  for (uint8_t i = 0; i < s_rule_count; i++) {
+    if (s_rules[i].sensor == sensor) {
+      SensorQualityStats_t stats = s_ctx[i].pub;
+
+      memset(&s_ctx[i], 0, sizeof(s_ctx[i]));
+      s_ctx[i].pub = stats;
+    }
+  }
+}
+
+/**
+ * @brief 获取规则数
+ */
+uint8_t SensorQuality_GetRuleCount(void) { return s_rule_count; }
+
+/**
+ * @brief 获取规则及其计数
+ */
+bool SensorQuality_GetRule(uint8_t index, const SensorQualityRule_t **rule,
+                           SensorQualityStats_t *stats) {
+  if (index >= s_rule_count) {
+    return false;
+  }
+  if (rule != NULL) {
+    *rule = &s_rules[index];
+  }
+  if (stats != NULL) {
+    *stats = s_ctx[index].pub;
+  }
+  return true;
+}
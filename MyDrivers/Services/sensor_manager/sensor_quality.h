@@ -0,0 +1,115 @@
+/**
+ ******************************************************************************
+ * @file    sensor_quality.h
+ * @brief   传感器数据质量检查头文件
+ * @details 样本进入历史与统计之前，按声明式规则表逐通道检查：
+ *            1. 合理范围：超出 [min, max] 的读数剔除 (CRC 正确的错误帧、
+ *               ADC 毛刺)；
+ *            2. 尖峰滤波：与最近三个原始读数的中值相差超过 spike 的读数
+ *               以中值替换，单点尖峰被替换为相邻读数 (阶跃变化延迟一个
+ *               样本，平缓的变化不受影响)；
+ *            3. 最大跳变：与上一个有效值相差超过 max_step 的读数剔除，
+ *               连续 SENSOR_QUALITY_STEP_CONFIRM 个读数都在新电平附近时
+ *               接受为真实变化。
+ *          驱动可在取回读数时预先标记 SENSOR_QUALITY_INVALID (如 SHT30 加热器
+ *          脉冲及其恢复期间的读数)，这些通道不参与检查，同样按剔除处理。
+ *          结果以质量标志保存在样本中 (SensorData_t.quality) 与历史缓冲区
+ *          同槽位 (SensorHistorySpan_t.quality)：剔除的样本不计入统计与
+ *          汇总，图表显示为断点；数值保持上一个有效值，告警、日志与上行
+ *          等下游模块无需各自再做过滤。没有规则的通道不做检查。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_QUALITY_H
+#define __SENSOR_QUALITY_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_QUALITY_MAX_RULES 6     // 规则表最大条数
+#define SENSOR_QUALITY_STEP_CONFIRM 3  // 连续多少个一致的读数后接受跳变
+
+/* 质量标志 (SensorData_t.quality，可组合) */
+#define SENSOR_QUALITY_OK 0x00
+#define SENSOR_QUALITY_RANGE 0x01    // 超出合理范围，已剔除
+#define SENSOR_QUALITY_STEP 0x02     // 相对上一个有效值跳变过大，已剔除
+#define SENSOR_QUALITY_FILTERED 0x04 // 尖峰已被中值替换 (数值有效)
+#define SENSOR_QUALITY_INVALID 0x08  // 驱动标记的无效读数 (如加热器工作期间)，已剔除
+#define SENSOR_QUALITY_REJECTED                                                \
+  (SENSOR_QUALITY_RANGE | SENSOR_QUALITY_STEP | SENSOR_QUALITY_INVALID)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 一条检查规则 (对应传感器的一个通道)
+ */
+typedef struct {
+  SensorHandle_t sensor; // 传感器实例 (写类型即该类型的第一个实例)
+  uint8_t channel;       // 通道下标
+  float min;             // 合理范围下限
+  float max;             // 合理范围上限
+  float max_step;        // 相邻有效值的最大差值，0 不检查
+  float spike;           // 与三点中值相差超过该值时以中值替换，0 不滤波
+} SensorQualityRule_t;
+
+/**
+ * @brief 规则计数
+ */
+typedef struct {
+  uint32_t checked;  // 检查的样本数
+  uint32_t rejected; // 剔除的样本数
+  uint32_t filtered; // 以中值替换的样本数
+} SensorQualityStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 设置规则表 (表须为静态存储) 并清空状态
+ * @param rules 规则数组
+ * @param count 条数，超过 SENSOR_QUALITY_MAX_RULES 的部分忽略
+ * @note  在注册传感器之前调用
+ */
+void SensorQuality_SetRules(const SensorQualityRule_t *rules, uint8_t count);
+
+/**
+ * @brief 检查一个新样本 (由传感器任务在写入历史之前调用)
+ * @param sensor  传感器实例句柄
+ * @param values  各通道数值，输出为滤波后的值 (剔除时为上一个有效值)
+ * @param quality 各通道质量标志：输入为驱动标记的 SENSOR_QUALITY_INVALID
+ *                (传感器任务在每次转换开始时清零)，输出为检查结果
+ * @param count   通道数
+ * @return 剔除的通道位图 (bit n 对应通道 n)，包括没有规则的无效通道
+ */
+uint8_t SensorQuality_Check(SensorHandle_t sensor, float *values,
+                            uint8_t *quality, uint8_t count);
+
+/**
+ * @brief 丢弃滤波与跳变状态 (传感器重新初始化后调用)
+ */
+void SensorQuality_Reset(SensorHandle_t sensor);
+
+/**
+ * @brief 获取规则数
+ */
+uint8_t SensorQuality_GetRuleCount(void);
+
+/**
+ * @brief 获取规则及其计数
+ * @return false: 下标越界
+ */
+bool SensorQuality_GetRule(uint8_t index, const SensorQualityRule_t **rule,
+                           SensorQualityStats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_QUALITY_H */
@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ * @file    sensor_remote.c
+ * @brief   远端传感器实例源文件
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_remote.h"
+#include "sys_clock.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+/* --------------------------- 实例回调 --------------------------- */
+
+static bool SensorRemote_Init(SensorInstance_t *sensor) {
+  const SensorRemote_t *remote =
+      (const SensorRemote_t *)sensor->device_handle;
+  return remote->valid;
+}
+
+static bool SensorRemote_Start(SensorInstance_t *sensor, uint32_t *wait_ms) {
+  const SensorRemote_t *remote =
+      (const SensorRemote_t *)sensor->device_handle;
+  *wait_ms = 0;
+  return remote->valid;
+}
+
+/**
+ * @brief 取回远端样本：远端样本计数变化后才提交
+ */
+static SensorCollectResult_t SensorRemote_Collect(SensorInstance_t *sensor,
+                                                  uint32_t *wait_ms) {
+  SensorRemote_t *remote = (SensorRemote_t *)sensor->device_handle;
+  int16_t fixed[SENSOR_MAX_CHANNELS];
+  uint64_t rx_us;
+  bool valid;
+  bool fresh;
+
+  taskENTER_CRITICAL();
+  valid = remote->valid;
+  fresh = remote->samples != remote->consumed;
+  remote->consumed = remote->samples;
+  memcpy(fixed, remote->fixed, sizeof(fixed));
+  rx_us = remote->rx_us;
+  taskEXIT_CRITICAL();
+
+  if (!valid) {
+    return SENSOR_COLLECT_ERROR;
+  }
+  if (!fresh) {
+    *wait_ms = remote->poll_ms;
+    return SENSOR_COLLECT_PENDING;
+  }
+
+  // 节点运行同一固件，通道表一致，按本机的缩放系数换算
+  sensor->conversion_start_us = rx_us;
+  for (uint8_t ch = 0; ch < sensor->channel_count; ch++) {
+    float scale = sensor->channels[ch].fixed_scale;
+    SensorChannel_SetValue(&sensor->channels[ch], &sensor->data,
+                           (float)fixed[ch] / (scale > 0.0f ? scale : 1.0f));
+  }
+  return SENSOR_COLLECT_DONE;
+}
+
+static const SensorCallbacks_t s_remote_callbacks = {
+    .init_func = SensorRemote_Init,
+    .start_func = SensorRemote_Start,
+    .collect_func = SensorRemote_Collect,
+};
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 注册远端实例
+ */
+SensorHandle_t SensorRemote_Attach(SensorRemote_t *remote, SensorType_t type,
+                                   const char *name, uint32_t poll_ms) {
+  memset(remote, 0, sizeof(*remote));
+  remote->type = type;
+  remote->poll_ms = poll_ms;
+  strncpy(remote->name, name, sizeof(remote->name) - 1);
+  remote->handle = SensorTask_RegisterRemote(type, remote->name,
+                                             &s_remote_callbacks, remote);
+  return remote->handle;
+}
+
+/**
+ * @brief 写入远端的最新样本
+ */
+void SensorRemote_Update(SensorRemote_t *remote, bool valid, uint16_t samples,
+                         const int16_t *fixed, uint8_t count) {
+  uint64_t now_us = SysClock_Micros();
+
+  if (count > SENSOR_MAX_CHANNELS) {
+    count = SENSOR_MAX_CHANNELS;
+  }
+  taskENTER_CRITICAL();
+  remote->valid = valid;
+  remote->samples = samples;
+  remote->rx_us = now_us;
+  memcpy(remote->fixed, fixed, count * sizeof(fixed[0]));
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 节点离线
+ */
+void SensorRemote_SetOffline(SensorRemote_t *remote) { remote->valid = false; }
@@ -0,0 +1,83 @@
+/**
+ ******************************************************************************
+ * @file    sensor_remote.h
+ * @brief   远端传感器实例头文件
+ * @details 其他节点上的传感器经总线 (Modbus 网关轮询、CAN 广播) 送到本机后，
+ *          以 SensorTask_RegisterRemote 注册为本机实例，与本地传感器一样参与
+ *          调度、历史、统计、告警、界面与遥测上行：
+ *            - 传输层收到一个样本时调用 SensorRemote_Update() 写入缓存
+ *              (定点值，与通道表的缩放系数一致)；
+ *            - 实例的分阶段回调在远端样本计数变化后才提交样本，传感器
+ *              任务的采样间隔大于远端间隔时取最新值，不会重复记录同一个
+ *              样本；
+ *            - 传输层判定节点离线时调用 SensorRemote_SetOffline()，之后的
+ *              读取失败，按传感器任务的退避机制处理，恢复后自动重新上线。
+ *          缓存由传输层任务写入、传感器任务读取，读写都在临界区内进行。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_REMOTE_H
+#define __SENSOR_REMOTE_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_REMOTE_NAME_MAX 16 // 实例名称长度 (含结尾)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 一个远端实例的样本缓存 (由传输层静态分配)
+ */
+typedef struct {
+  SensorType_t type;                  // 注册时的类型
+  SensorHandle_t handle;              // 本机实例句柄
+  volatile bool valid;                // 节点在线且远端最近样本有效
+  uint16_t samples;                   // 远端样本计数 (只比较是否变化)
+  uint16_t consumed;                  // 已提交给传感器任务的样本计数
+  uint64_t rx_us;                     // 收到最近样本的时刻 (作为样本时间)
+  int16_t fixed[SENSOR_MAX_CHANNELS]; // 各通道定点值
+  uint32_t poll_ms;                   // 没有新样本时再次查看的间隔
+  char name[SENSOR_REMOTE_NAME_MAX];  // 实例名称
+} SensorRemote_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 注册远端实例
+ * @param remote  缓存 (须为静态存储)
+ * @param name    显示名称 (复制到缓存中)
+ * @param poll_ms 远端没有新样本时再次查看的间隔 (一般取传输层的更新周期)
+ * @return 实例句柄，注册表已满或类型未配置返回 SENSOR_HANDLE_INVALID
+ */
+SensorHandle_t SensorRemote_Attach(SensorRemote_t *remote, SensorType_t type,
+                                   const char *name, uint32_t poll_ms);
+
+/**
+ * @brief 写入远端的最新样本 (传输层任务调用)
+ * @param valid   远端传感器在线且样本有效
+ * @param samples 远端样本计数
+ * @param fixed   各通道定点值
+ * @param count   通道数 (超出 SENSOR_MAX_CHANNELS 的部分忽略)
+ */
+void SensorRemote_Update(SensorRemote_t *remote, bool valid, uint16_t samples,
+                         const int16_t *fixed, uint8_t count);
+
+/**
+ * @brief 节点离线：之后的读取失败，直到下一次 SensorRemote_Update()
+ */
+void SensorRemote_SetOffline(SensorRemote_t *remote);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_REMOTE_H */
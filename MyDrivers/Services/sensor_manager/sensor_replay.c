@@ -0,0 +1,198 @@
+/**
+ ******************************************************************************
+ * @file    sensor_replay.c
+ * @brief   传感器数据录制与回放源文件
+ * @details 每个实例一个单生产者/单消费者环形队列：命令行任务只写 tail，
+ *          传感器任务只写 head，下标为单字节，读写均为原子操作，不需要加锁。
+ *          回放开始前先清除 active，传感器任务不会在清空队列期间取样本。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_replay.h"
+#include "sensor_export.h"
+#include <string.h>
+
+#define LOG_MODULE "REPLAY"
+#include "log.h"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  float values[SENSOR_MAX_CHANNELS];
+  uint8_t count;
+} SensorReplaySample_t;
+
+typedef struct {
+  SensorReplaySample_t queue[SENSOR_REPLAY_QUEUE_DEPTH];
+  volatile uint8_t head; // 下一个要回放的样本 (传感器任务写)
+  volatile uint8_t tail; // 下一个写入位置 (命令行任务写)
+  volatile bool active;
+  uint32_t played;
+  uint32_t underruns;
+  uint32_t dropped;
+} SensorReplayQueue_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static SensorReplayQueue_t s_queue[SENSOR_TYPE_MAX][SENSOR_MAX_PER_TYPE];
+static volatile bool s_capture;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static SensorReplayQueue_t *sensor_replay_queue(SensorHandle_t sensor) {
+  SensorType_t type = SENSOR_HANDLE_TYPE(sensor);
+  uint8_t index = SENSOR_HANDLE_INDEX(sensor);
+
+  if (type <= SENSOR_TYPE_NONE || type >= SENSOR_TYPE_MAX ||
+      index >= SENSOR_MAX_PER_TYPE) {
+    return NULL;
+  }
+  return &s_queue[type][index];
+}
+
+static bool sensor_replay_init(SensorInstance_t *sensor) {
+  (void)sensor;
+  return true;
+}
+
+/* 取出一个样本写入 sensor->data；队列为空时保持上一个样本 */
+static bool sensor_replay_read(SensorInstance_t *sensor) {
+  SensorReplayQueue_t *q = sensor_replay_queue(sensor->handle);
+  const SensorReplaySample_t *sample;
+  uint8_t head;
+
+  if (q == NULL) {
+    return false;
+  }
+  head = q->head;
+  if (head == q->tail) {
+    q->underruns++;
+    return true;
+  }
+  sample = &q->queue[head];
+  for (uint8_t ch = 0; ch < sample->count && ch < sensor->channel_count;
+       ch++) {
+    SensorChannel_SetValue(&sensor->channels[ch], &sensor->data,
+                           sample->values[ch]);
+  }
+  q->head = (uint8_t)((head + 1U) % SENSOR_REPLAY_QUEUE_DEPTH);
+  q->played++;
+  return true;
+}
+
+static const SensorCallbacks_t s_replay_callbacks = {
+    .init_func = sensor_replay_init,
+    .read_func = sensor_replay_read,
+};
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 开启/关闭录制
+ */
+void SensorReplay_SetCapture(bool enable) {
+  s_capture = enable;
+  LOG_INFO("样本录制%s", enable ? "开启" : "关闭");
+}
+
+/**
+ * @brief 是否正在录制
+ */
+bool SensorReplay_IsCapturing(void) { return s_capture; }
+
+/**
+ * @brief 录制一个样本
+ */
+void SensorReplay_Capture(SensorHandle_t sensor, uint64_t time_us,
+                          const float *values, uint8_t count) {
+  if (!s_capture) {
+    return;
+  }
+  SensorExport_Sample(sensor, (uint32_t)(time_us / 1000U), values, count);
+}
+
+/**
+ * @brief 开始回放
+ */
+bool SensorReplay_Start(SensorHandle_t sensor) {
+  SensorReplayQueue_t *q = sensor_replay_queue(sensor);
+
+  if (q == NULL || SensorTask_GetChannels(sensor, NULL) == 0) {
+    return false;
+  }
+  q->active = false;
+  q->head = 0;
+  q->tail = 0;
+  q->played = 0;
+  q->underruns = 0;
+  q->dropped = 0;
+  q->active = true;
+  if (!SensorTask_OverrideCallbacks(sensor, &s_replay_callbacks)) {
+    q->active = false;
+    return false;
+  }
+  LOG_INFO("%s 开始回放", SensorTask_GetName(sensor));
+  return true;
+}
+
+/**
+ * @brief 停止回放
+ */
+bool SensorReplay_Stop(SensorHandle_t sensor) {
+  SensorReplayQueue_t *q = sensor_replay_queue(sensor);
+
+  if (q == NULL || !q->active) {
+    return false;
+  }
+  SensorTask_OverrideCallbacks(sensor, NULL);
+  q->active = false;
+  LOG_INFO("%s 停止回放：%lu 个样本，欠载 %lu 次", SensorTask_GetName(sensor),
+           (unsigned long)q->played, (unsigned long)q->underruns);
+  return true;
+}
+
+/**
+ * @brief 推入一个待回放样本
+ */
+bool SensorReplay_Push(SensorHandle_t sensor, const float *values,
+                       uint8_t count) {
+  SensorReplayQueue_t *q = sensor_replay_queue(sensor);
+  SensorReplaySample_t *sample;
+  uint8_t tail, next;
+
+  if (q == NULL || !q->active || values == NULL) {
+    return false;
+  }
+  tail = q->tail;
+  next = (uint8_t)((tail + 1U) % SENSOR_REPLAY_QUEUE_DEPTH);
+  if (next == q->head) {
+    q->dropped++;
+    return false;
+  }
+  if (count > SENSOR_MAX_CHANNELS) {
+    count = SENSOR_MAX_CHANNELS;
+  }
+  sample = &q->queue[tail];
+  memcpy(sample->values, values, count * sizeof(float));
+  sample->count = count;
+  q->tail = next; // 样本写完后才发布
+  return true;
+}
+
+/**
+ * @brief 获取实例的回放状态
+ */
+bool SensorReplay_GetStatus(SensorHandle_t sensor, SensorReplayStatus_t *out) {
+  const SensorReplayQueue_t *q = sensor_replay_queue(sensor);
+
+  if (q == NULL || out == NULL) {
+    return false;
+  }
+  out->active = q->active;
+  out->queued = (uint8_t)((q->tail + SENSOR_REPLAY_QUEUE_DEPTH - q->head) %
+                          SENSOR_REPLAY_QUEUE_DEPTH);
+  out->played = q->played;
+  out->underruns = q->underruns;
+  out->dropped = q->dropped;
+  return true;
+}
@@ -0,0 +1,101 @@
+/**
+ ******************************************************************************
+ * @file    sensor_replay.h
+ * @brief   传感器数据录制与回放头文件
+ * @details 录制：开启后每个成功读取的样本 (驱动解析出的各通道值) 以
+ *          SENSOR_EXPORT_FRAME_SAMPLE 帧经串口输出，由主机端
+ *          sensor_replay.py 保存为 CSV。
+ *          回放：以 SensorTask_OverrideCallbacks 把实例的驱动回调替换为
+ *          从队列取样本的回调，主机按录制时的时间间隔经命令行推入样本。
+ *          调度、告警、通风、自适应采样与界面看到的数据与录制时逐位相同，
+ *          可在没有真实刺激 (如烟雾事件) 的情况下重复比较性能。
+ *          队列空时保持上一个样本不变并计数 (欠载)，不触发错误处理。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_REPLAY_H
+#define __SENSOR_REPLAY_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_REPLAY_QUEUE_DEPTH 16 // 每个实例缓存的待回放样本数 (吸收主机发送抖动)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 一个实例的回放状态
+ */
+typedef struct {
+  bool active;        // 正在回放
+  uint8_t queued;     // 队列中的样本数
+  uint32_t played;    // 已回放的样本数
+  uint32_t underruns; // 到期时队列为空的次数
+  uint32_t dropped;   // 队列满时丢弃的样本数
+} SensorReplayStatus_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 开启/关闭录制
+ */
+void SensorReplay_SetCapture(bool enable);
+
+/**
+ * @brief 是否正在录制
+ */
+bool SensorReplay_IsCapturing(void);
+
+/**
+ * @brief 录制一个样本 (传感器任务提交样本时调用，未开启录制时立即返回)
+ * @param sensor  实例句柄
+ * @param time_us 样本时刻
+ * @param values  通道值
+ * @param count   通道数
+ */
+void SensorReplay_Capture(SensorHandle_t sensor, uint64_t time_us,
+                          const float *values, uint8_t count);
+
+/**
+ * @brief 开始回放：清空队列并替换实例的驱动回调
+ * @param sensor 实例句柄
+ * @return false: 实例未注册
+ */
+bool SensorReplay_Start(SensorHandle_t sensor);
+
+/**
+ * @brief 停止回放并恢复驱动回调
+ * @param sensor 实例句柄
+ * @return false: 实例未注册或未在回放
+ */
+bool SensorReplay_Stop(SensorHandle_t sensor);
+
+/**
+ * @brief 推入一个待回放样本 (单一生产者，通常为命令行任务)
+ * @param sensor 实例句柄
+ * @param values 通道值
+ * @param count  通道数 (多于实例通道数的部分忽略，缺少的通道保持原值)
+ * @return false: 未在回放或队列已满
+ */
+bool SensorReplay_Push(SensorHandle_t sensor, const float *values,
+                       uint8_t count);
+
+/**
+ * @brief 获取实例的回放状态
+ * @return false: 句柄无效
+ */
+bool SensorReplay_GetStatus(SensorHandle_t sensor, SensorReplayStatus_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_REPLAY_H */
@@ -0,0 +1,192 @@
+/**
+ ******************************************************************************
+ * @file    sensor_rollup.c
+ * @brief   传感器多分辨率历史存储源文件
+ * @details 每个样本同时累加进“当前分钟”和“当前小时”两个累积桶；
+ *          样本时间戳跨越分钟边界时封存分钟桶，跨越整点时封存小时桶。
+ *          中间缺失的时段写入空桶，保证图表横轴时间连续。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_rollup.h"
+#include <string.h>
+
+/* --------------------------- 私有宏 --------------------------- */
+#define ROLLUP_EMPTY INT16_MIN // 空桶标记，有效数据被限幅在 ±INT16_MAX 内
+// 间隔超过全部小时桶的覆盖范围时，旧数据已无意义，直接清空重来
+#define ROLLUP_MAX_GAP_MIN                                                     \
+  ((uint32_t)(SENSOR_ROLLUP_HOUR_SLOTS + 1) * SENSOR_ROLLUP_MINUTES_PER_HOUR)
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static int16_t rollup_to_fixed(float scale, float value) {
+  float v = value * scale;
+  v += (v >= 0.0f) ? 0.5f : -0.5f;
+  if (v > (float)INT16_MAX)
+    return INT16_MAX;
+  if (v < (float)-INT16_MAX)
+    return -INT16_MAX;
+  return (int16_t)v;
+}
+
+static void rollup_acc_reset(SensorBucketAcc_t *acc) {
+  acc->sum = 0;
+  acc->n = 0;
+  acc->min = INT16_MAX;
+  acc->max = -INT16_MAX;
+}
+
+static void rollup_acc_add(SensorBucketAcc_t *acc, int16_t q) {
+  acc->sum += q;
+  acc->n++;
+  if (q < acc->min)
+    acc->min = q;
+  if (q > acc->max)
+    acc->max = q;
+}
+
+/**
+ * @brief 把累积桶封存进环形缓冲区，并清空累积桶
+ */
+static void rollup_acc_flush(SensorBucketAcc_t *acc, SensorBucket_t *ring,
+                             uint16_t slots, uint16_t *head, uint16_t *count) {
+  SensorBucket_t *bucket = &ring[*head];
+
+  if (acc->n > 0) {
+    bucket->min = acc->min;
+    bucket->max = acc->max;
+    bucket->avg = (int16_t)(acc->sum / (int32_t)acc->n);
+  } else {
+    bucket->min = ROLLUP_EMPTY;
+    bucket->max = ROLLUP_EMPTY;
+    bucket->avg = ROLLUP_EMPTY;
+  }
+
+  *head = (*head + 1) % slots;
+  if (*count < slots)
+    (*count)++;
+
+  rollup_acc_reset(acc);
+}
+
+static void rollup_clear(SensorRollup_t *rollup) {
+  float scale = rollup->scale;
+  uint32_t offset = rollup->minute_offset;
+  memset(rollup, 0, sizeof(SensorRollup_t));
+  rollup->scale = scale;
+  rollup->minute_offset = offset;
+  rollup_acc_reset(&rollup->minute_acc);
+  rollup_acc_reset(&rollup->hour_acc);
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化单通道历史
+ */
+void SensorRollup_Init(SensorRollup_t *rollup, float scale) {
+  rollup->scale = (scale > 0.0f) ? scale : 1.0f;
+  rollup->minute_offset = 0;
+  rollup_clear(rollup);
+}
+
+void SensorRollup_Rebase(SensorRollup_t *rollup, uint64_t now_us) {
+  uint32_t index = (uint32_t)(now_us / SENSOR_ROLLUP_MINUTE_US);
+
+  // 无符号回绕：此后 index + minute_offset 从当前分钟序号起递增
+  rollup->minute_offset = rollup->started ? rollup->minute_index - index : 0;
+}
+
+/**
+ * @brief 插入一个样本
+ */
+void SensorRollup_Push(SensorRollup_t *rollup, uint64_t now_us, float value) {
+  uint32_t index =
+      (uint32_t)(now_us / SENSOR_ROLLUP_MINUTE_US) + rollup->minute_offset;
+
+  if (rollup->started) {
+    uint32_t elapsed = index - rollup->minute_index;
+
+    if (elapsed > ROLLUP_MAX_GAP_MIN) {
+      // 断档过久，清空后从当前分钟重新开始
+      rollup_clear(rollup);
+    } else {
+      while (rollup->minute_index != index) {
+        rollup_acc_flush(&rollup->minute_acc, rollup->minute,
+                         SENSOR_ROLLUP_MINUTE_SLOTS, &rollup->minute_head,
+                         &rollup->minute_count);
+        rollup->minute_index++;
+        if (rollup->minute_index % SENSOR_ROLLUP_MINUTES_PER_HOUR == 0) {
+          rollup_acc_flush(&rollup->hour_acc, rollup->hour,
+                           SENSOR_ROLLUP_HOUR_SLOTS, &rollup->hour_head,
+                           &rollup->hour_count);
+        }
+      }
+    }
+  }
+
+  if (!rollup->started) {
+    rollup->started = true;
+    rollup->minute_index = index;
+  }
+
+  int16_t q = rollup_to_fixed(rollup->scale, value);
+  rollup_acc_add(&rollup->minute_acc, q);
+  rollup_acc_add(&rollup->hour_acc, q);
+}
+
+/**
+ * @brief 按时间顺序读取已封存的汇总桶
+ */
+uint16_t SensorRollup_Read(const SensorRollup_t *rollup, SensorTier_t tier,
+                           SensorRollupPoint_t *out, uint16_t max_points) {
+  const SensorBucket_t *ring;
+  uint16_t slots, head, count;
+
+  if (rollup == NULL || out == NULL || max_points == 0)
+    return 0;
+
+  if (tier == SENSOR_TIER_MINUTE) {
+    ring = rollup->minute;
+    slots = SENSOR_ROLLUP_MINUTE_SLOTS;
+    head = rollup->minute_head;
+    count = rollup->minute_count;
+  } else if (tier == SENSOR_TIER_HOUR) {
+    ring = rollup->hour;
+    slots = SENSOR_ROLLUP_HOUR_SLOTS;
+    head = rollup->hour_head;
+    count = rollup->hour_count;
+  } else {
+    return 0;
+  }
+
+  // 只输出最新的 max_points 个点
+  uint16_t n = (count < max_points) ? count : max_points;
+  uint16_t read_idx = (head + slots - n) % slots;
+  float inv_scale = 1.0f / rollup->scale;
+
+  for (uint16_t i = 0; i < n; i++) {
+    const SensorBucket_t *bucket = &ring[read_idx];
+    out[i].valid = (bucket->avg != ROLLUP_EMPTY);
+    out[i].min = out[i].valid ? bucket->min * inv_scale : 0.0f;
+    out[i].max = out[i].valid ? bucket->max * inv_scale : 0.0f;
+    out[i].avg = out[i].valid ? bucket->avg * inv_scale : 0.0f;
+    read_idx = (read_idx + 1) % slots;
+  }
+
+  return n;
+}
+
+/**
+ * @brief 最新封存桶之后的绝对桶号
+ * @details 当前分钟 (小时) 尚未封存，其序号即为最新封存桶之后的序号
+ */
+uint32_t SensorRollup_End(const SensorRollup_t *rollup, SensorTier_t tier) {
+  if (rollup == NULL || !rollup->started)
+    return 0;
+  if (tier == SENSOR_TIER_HOUR)
+    return rollup->minute_index / SENSOR_ROLLUP_MINUTES_PER_HOUR;
+  return rollup->minute_index;
+}
@@ -0,0 +1,135 @@
+/**
+ ******************************************************************************
+ * @file    sensor_rollup.h
+ * @brief   传感器多分辨率历史存储头文件
+ * @details 在原始历史缓冲区之外，按 1 分钟和 1 小时两级降采样保存
+ *          最小/最大/平均值。数据以 int16 定点数存储（按通道缩放），
+ *          汇总在插入时增量完成，读取时无需再遍历原始数据。
+ *          与 sensor_stats 一样只依赖 C 标准库，时间由调用者传入。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_ROLLUP_H
+#define __SENSOR_ROLLUP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_ROLLUP_MINUTE_SLOTS 60 // 分钟级桶数 (覆盖最近 1 小时)
+#define SENSOR_ROLLUP_HOUR_SLOTS 24   // 小时级桶数 (覆盖最近 1 天)
+#define SENSOR_ROLLUP_MINUTE_US 60000000ULL
+#define SENSOR_ROLLUP_MINUTES_PER_HOUR 60
+
+/* --------------------------- 数据结构 --------------------------- */
+typedef enum {
+  SENSOR_TIER_MINUTE = 0, // 1 分钟分辨率
+  SENSOR_TIER_HOUR,       // 1 小时分辨率
+  SENSOR_TIER_MAX
+} SensorTier_t;
+
+/**
+ * @brief 定点存储的汇总桶 (avg == INT16_MIN 表示该时段无数据)
+ */
+typedef struct {
+  int16_t min;
+  int16_t max;
+  int16_t avg;
+} SensorBucket_t;
+
+/**
+ * @brief 正在累积中的汇总桶
+ */
+typedef struct {
+  int32_t sum;
+  uint32_t n;
+  int16_t min;
+  int16_t max;
+} SensorBucketAcc_t;
+
+/**
+ * @brief 单通道的多分辨率历史
+ */
+typedef struct {
+  float scale; // 定点缩放系数：存储值 = 实际值 * scale
+
+  SensorBucket_t minute[SENSOR_ROLLUP_MINUTE_SLOTS];
+  SensorBucket_t hour[SENSOR_ROLLUP_HOUR_SLOTS];
+  uint16_t minute_head, minute_count;
+  uint16_t hour_head, hour_count;
+
+  SensorBucketAcc_t minute_acc; // 当前分钟
+  SensorBucketAcc_t hour_acc;   // 当前小时 (由原始样本累积，保证平均值加权正确)
+  uint32_t minute_index;        // 当前分钟序号 (微秒时间 / 60000000 + minute_offset)
+  uint32_t minute_offset;       // 时间基准改变后的分钟序号修正 (见 SensorRollup_Rebase)
+  bool started;
+} SensorRollup_t;
+
+/**
+ * @brief 对外输出的汇总点 (已换算为实际值)
+ */
+typedef struct {
+  float min;
+  float max;
+  float avg;
+  bool valid; // 该时段是否有数据
+} SensorRollupPoint_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化单通道历史
+ * @param rollup 历史对象
+ * @param scale  定点缩放系数 (如温度 100 表示 0.01°C 分辨率)
+ */
+void SensorRollup_Init(SensorRollup_t *rollup, float scale);
+
+/**
+ * @brief 插入一个样本，跨越分钟/小时边界时自动封存汇总桶
+ * @param rollup 历史对象
+ * @param now_us 样本时间戳 (SysClock_Micros)
+ * @param value  样本值
+ */
+void SensorRollup_Push(SensorRollup_t *rollup, uint64_t now_us, float value);
+
+/**
+ * @brief 时间基准改变后 (热启动恢复历史) 接续当前分钟
+ * @details 新的时间戳从 now_us 起视为紧接在最后一个样本所在的分钟之后，
+ *          复位期间的空档不计入；分钟/小时边界的相位保持不变。
+ * @param rollup 历史对象
+ * @param now_us 新时间基准下的当前时间 (SysClock_Micros)
+ */
+void SensorRollup_Rebase(SensorRollup_t *rollup, uint64_t now_us);
+
+/**
+ * @brief 按时间顺序（从旧到新）读取已封存的汇总桶
+ * @param rollup     历史对象
+ * @param tier       分辨率
+ * @param out        输出缓冲区
+ * @param max_points 输出缓冲区容量
+ * @return uint16_t  实际输出的点数
+ */
+uint16_t SensorRollup_Read(const SensorRollup_t *rollup, SensorTier_t tier,
+                           SensorRollupPoint_t *out, uint16_t max_points);
+
+/**
+ * @brief 最新封存桶之后的绝对桶号 (分钟级为分钟序号，小时级为小时序号)
+ * @details 每封存一个桶加 1，已封存桶的内容不再改变；图表据此判断
+ *          有无新数据，并把桶对齐到固定的降采样分组。
+ * @param rollup 历史对象
+ * @param tier   分辨率
+ * @return uint32_t 绝对桶号 (Read 输出的最后一个点为该值 - 1)
+ */
+uint32_t SensorRollup_End(const SensorRollup_t *rollup, SensorTier_t tier);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_ROLLUP_H */
@@ -0,0 +1,369 @@
+/**
+ ******************************************************************************
+ * @file    sensor_series.c
+ * @brief   传感器压缩时间序列源文件
+ * @details 位流按字节内高位在前写入。每个样本依次为时间戳二阶差分、
+ *          各通道数值一阶差分，差分按绝对值大小选择编码：
+ *
+ *            时间二阶差分         数值一阶差分
+ *            0        0           0        0
+ *            10   + 7 位          10   + 6 位
+ *            110  + 12 位         110  + 12 位
+ *            1110 + 20 位         1110 + 20 位
+ *            1111 + 32 位         11110 + 32 位
+ *                                 11111       缺失
+ *
+ *          负数以补码截断保存，解码时符号扩展。写入样本之前按最坏情况
+ *          检查块剩余空间，不够时启用下一块，因此样本不会跨块。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_series.h"
+#include <string.h>
+
+/* --------------------------- 私有宏 --------------------------- */
+#define SERIES_DOD_MAX_ONES 4 // 时间二阶差分前缀中 1 的最大个数
+#define SERIES_VAL_MAX_ONES 5 // 数值差分前缀中 1 的最大个数 (5 个为缺失)
+#define SERIES_VAL_MISSING SERIES_VAL_MAX_ONES
+
+// 单个样本的最大位数：时间 4+32，每通道 5+32
+#define SERIES_SAMPLE_MAX_BITS(n) (36U + 37U * (n))
+#define SERIES_BLOCK_BITS (SENSOR_SERIES_BLOCK_BYTES * 8U)
+
+/* 按前缀中 1 的个数排列的负载位数 (0 个 1 表示差分为 0) */
+static const uint8_t s_dod_width[SERIES_DOD_MAX_ONES + 1] = {0, 7, 12, 20, 32};
+static const uint8_t s_val_width[SERIES_VAL_MAX_ONES] = {0, 6, 12, 20, 32};
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static int32_t series_quantize(float scale, float value) {
+  float v = value * scale;
+  v += (v >= 0.0f) ? 0.5f : -0.5f;
+  if (v >= 2147483520.0f)
+    return INT32_MAX;
+  if (v <= -2147483520.0f)
+    return -INT32_MAX;
+  return (int32_t)v;
+}
+
+static int16_t series_clamp16(int32_t v) {
+  if (v > INT16_MAX - 1)
+    return INT16_MAX - 1;
+  if (v < -INT16_MAX)
+    return -INT16_MAX;
+  return (int16_t)v;
+}
+
+static void series_put_bits(SensorSeriesBlock_t *blk, uint32_t value,
+                            uint8_t n) {
+  while (n > 0) {
+    uint8_t room = (uint8_t)(8U - (blk->bits & 7U));
+    uint8_t take = (n < room) ? n : room;
+    uint32_t chunk = (value >> (n - take)) & ((1UL << take) - 1U);
+
+    blk->data[blk->bits >> 3] |= (uint8_t)(chunk << (room - take));
+    blk->bits += take;
+    n -= take;
+  }
+}
+
+static uint32_t series_get_bits(const uint8_t *data, uint16_t *pos,
+                                uint8_t n) {
+  uint32_t value = 0;
+
+  while (n > 0) {
+    uint8_t room = (uint8_t)(8U - (*pos & 7U));
+    uint8_t take = (n < room) ? n : room;
+    uint32_t chunk = ((uint32_t)data[*pos >> 3] >> (room - take)) &
+                     ((1UL << take) - 1U);
+
+    value = (value << take) | chunk;
+    *pos += take;
+    n -= take;
+  }
+  return value;
+}
+
+/**
+ * @brief 写入一个分级编码的有符号差分
+ * @param width    按前缀中 1 的个数排列的负载位数
+ * @param max_ones 前缀中 1 的最大个数 (达到时省略结尾的 0)
+ */
+static void series_put_signed(SensorSeriesBlock_t *blk, int32_t v,
+                              const uint8_t *width, uint8_t classes,
+                              uint8_t max_ones) {
+  uint8_t ones = 0;
+
+  if (v != 0) {
+    for (ones = 1; ones < classes - 1; ones++) {
+      int32_t lim = (int32_t)(1L << (width[ones] - 1));
+      if (v >= -lim && v < lim)
+        break;
+    }
+  }
+  series_put_bits(blk, (1UL << ones) - 1U, ones);
+  if (ones < max_ones)
+    series_put_bits(blk, 0, 1);
+  if (ones > 0) {
+    uint8_t w = width[ones];
+    series_put_bits(blk, (w == 32) ? (uint32_t)v
+                                   : ((uint32_t)v & ((1UL << w) - 1U)),
+                    w);
+  }
+}
+
+/**
+ * @brief 读取前缀：连续 1 的个数 (最多 max_ones 个)
+ */
+static uint8_t series_get_prefix(const uint8_t *data, uint16_t *pos,
+                                 uint8_t max_ones) {
+  uint8_t ones = 0;
+
+  while (ones < max_ones && series_get_bits(data, pos, 1))
+    ones++;
+  return ones;
+}
+
+static int32_t series_get_payload(const uint8_t *data, uint16_t *pos,
+                                  uint8_t w) {
+  uint32_t raw = series_get_bits(data, pos, w);
+
+  if (w < 32 && (raw & (1UL << (w - 1))))
+    raw |= ~((1UL << w) - 1U); // 符号扩展
+  return (int32_t)raw;
+}
+
+/**
+ * @brief 启用下一个块 (已满时覆盖最旧的块)，编码状态从零开始
+ */
+static void series_new_block(SensorSeries_t *series, uint32_t time_ms) {
+  SensorSeriesBlock_t *blk;
+
+  if (series->used > 0) {
+    series->head = (uint8_t)((series->head + 1) % SENSOR_SERIES_BLOCKS);
+  }
+  blk = &series->block[series->head];
+  if (series->used == SENSOR_SERIES_BLOCKS) {
+    series->total -= blk->count;
+  } else {
+    series->used++;
+  }
+  memset(blk->data, 0, sizeof(blk->data));
+  blk->t0_ms = time_ms;
+  blk->count = 0;
+  blk->bits = 0;
+
+  series->last_ms = time_ms;
+  series->last_delta = 0;
+  memset(series->last_q, 0, sizeof(series->last_q));
+}
+
+/**
+ * @brief 迭代器进入下一块
+ */
+static void series_iter_load(SensorSeriesIter_t *it) {
+  const SensorSeriesBlock_t *blk = &it->series->block[it->block];
+
+  it->left = blk->count;
+  it->pos = 0;
+  it->t_ms = blk->t0_ms;
+  it->delta = 0;
+  memset(it->q, 0, sizeof(it->q));
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化序列
+ */
+void SensorSeries_Init(SensorSeries_t *series, const float *scale,
+                       uint8_t channel_count) {
+  memset(series, 0, sizeof(SensorSeries_t));
+  if (channel_count > SENSOR_SERIES_MAX_CHANNELS)
+    channel_count = SENSOR_SERIES_MAX_CHANNELS;
+  series->channel_count = channel_count;
+  for (uint8_t ch = 0; ch < channel_count; ch++) {
+    series->scale[ch] = (scale[ch] > 0.0f) ? scale[ch] : 1.0f;
+  }
+}
+
+/**
+ * @brief 追加一个样本
+ */
+void SensorSeries_Append(SensorSeries_t *series, uint32_t time_ms,
+                         const float *values, uint8_t missing) {
+  uint8_t n = series->channel_count;
+  SensorSeriesBlock_t *blk = &series->block[series->head];
+
+  if (series->used == 0 || blk->count == UINT16_MAX ||
+      blk->bits + SERIES_SAMPLE_MAX_BITS(n) > SERIES_BLOCK_BITS) {
+    series_new_block(series, time_ms);
+    blk = &series->block[series->head];
+  }
+
+  // 时间：二阶差分 (无符号相减，时间回绕时同样正确)
+  int32_t delta = (int32_t)(time_ms - series->last_ms);
+  series_put_signed(blk, (int32_t)((uint32_t)delta - (uint32_t)series->last_delta),
+                    s_dod_width, sizeof(s_dod_width), SERIES_DOD_MAX_ONES);
+  series->last_ms = time_ms;
+  series->last_delta = delta;
+
+  // 数值：一阶差分，缺失的通道保持上一个值
+  for (uint8_t ch = 0; ch < n; ch++) {
+    if (missing & (1U << ch)) {
+      series_put_bits(blk, (1UL << SERIES_VAL_MISSING) - 1U,
+                      SERIES_VAL_MISSING);
+      continue;
+    }
+    int32_t q = series_quantize(series->scale[ch], values[ch]);
+    series_put_signed(blk,
+                      (int32_t)((uint32_t)q - (uint32_t)series->last_q[ch]),
+                      s_val_width, sizeof(s_val_width), SERIES_VAL_MAX_ONES);
+    series->last_q[ch] = q;
+  }
+
+  blk->count++;
+  series->total++;
+}
+
+/**
+ * @brief 平移全部样本的时间
+ * @details 块内只记录相对 t0_ms 的差分，平移块头与编码状态即可
+ */
+void SensorSeries_Rebase(SensorSeries_t *series, uint32_t now_ms) {
+  uint32_t shift;
+
+  if (series->total == 0)
+    return;
+  shift = now_ms - series->last_ms; // 无符号回绕，向前平移同样正确
+  for (uint8_t i = 0; i < SENSOR_SERIES_BLOCKS; i++) {
+    series->block[i].t0_ms += shift;
+  }
+  series->last_ms += shift;
+}
+
+/**
+ * @brief 从最旧的样本开始迭代
+ */
+void SensorSeries_IterInit(const SensorSeries_t *series,
+                           SensorSeriesIter_t *it) {
+  memset(it, 0, sizeof(SensorSeriesIter_t));
+  it->series = series;
+  if (series->used == 0)
+    return;
+  it->blocks_left = series->used;
+  it->block = (uint8_t)((series->head + SENSOR_SERIES_BLOCKS + 1U -
+                         series->used) %
+                        SENSOR_SERIES_BLOCKS);
+  series_iter_load(it);
+}
+
+/**
+ * @brief 解码下一个样本
+ */
+bool SensorSeries_Next(SensorSeriesIter_t *it, SensorSeriesPoint_t *point) {
+  const SensorSeries_t *series = it->series;
+  const uint8_t *data;
+  uint8_t ones;
+
+  while (it->left == 0) {
+    if (it->blocks_left <= 1) {
+      it->blocks_left = 0;
+      return false;
+    }
+    it->blocks_left--;
+    it->block = (uint8_t)((it->block + 1) % SENSOR_SERIES_BLOCKS);
+    series_iter_load(it);
+  }
+  data = series->block[it->block].data;
+
+  ones = series_get_prefix(data, &it->pos, SERIES_DOD_MAX_ONES);
+  if (ones > 0) {
+    it->delta = (int32_t)((uint32_t)it->delta +
+                          (uint32_t)series_get_payload(data, &it->pos,
+                                                       s_dod_width[ones]));
+  }
+  it->t_ms += (uint32_t)it->delta;
+
+  point->time_ms = it->t_ms;
+  point->missing = 0;
+  for (uint8_t ch = 0; ch < series->channel_count; ch++) {
+    ones = series_get_prefix(data, &it->pos, SERIES_VAL_MAX_ONES);
+    if (ones == SERIES_VAL_MISSING) {
+      point->missing |= (uint8_t)(1U << ch);
+    } else if (ones > 0) {
+      it->q[ch] = (int32_t)((uint32_t)it->q[ch] +
+                            (uint32_t)series_get_payload(data, &it->pos,
+                                                         s_val_width[ones]));
+    }
+    point->value[ch] = it->q[ch];
+  }
+
+  it->left--;
+  return true;
+}
+
+/**
+ * @brief 按时间等分重采样一个通道
+ * @details 样本按时间顺序解码，段号单调不减，只需累积当前段。
+ */
+uint16_t SensorSeries_Resample(const SensorSeries_t *series, uint8_t channel,
+                               uint32_t window_ms, int16_t *out,
+                               uint16_t buckets) {
+  SensorSeriesIter_t it;
+  SensorSeriesPoint_t pt;
+  int64_t sum = 0;
+  uint32_t n = 0;
+  uint16_t cur = 0;
+  uint16_t filled = 0;
+
+  if (out == NULL || buckets == 0)
+    return 0;
+  for (uint16_t i = 0; i < buckets; i++)
+    out[i] = SENSOR_SERIES_EMPTY;
+  if (channel >= series->channel_count || series->total == 0 || window_ms == 0)
+    return 0;
+
+  SensorSeries_IterInit(series, &it);
+  while (SensorSeries_Next(&it, &pt)) {
+    uint32_t age = series->last_ms - pt.time_ms;
+    uint16_t idx;
+
+    if (age > window_ms || (pt.missing & (1U << channel)))
+      continue;
+    idx = (uint16_t)((uint64_t)(window_ms - age) * buckets / window_ms);
+    if (idx >= buckets)
+      idx = buckets - 1;
+
+    if (idx != cur && n > 0) {
+      out[cur] = series_clamp16((int32_t)(sum / (int32_t)n));
+      filled++;
+      sum = 0;
+      n = 0;
+    }
+    cur = idx;
+    sum += pt.value[channel];
+    n++;
+  }
+  if (n > 0) {
+    out[cur] = series_clamp16((int32_t)(sum / (int32_t)n));
+    filled++;
+  }
+  return filled;
+}
+
+/**
+ * @brief 压缩数据占用的字节数
+ */
+uint32_t SensorSeries_UsedBytes(const SensorSeries_t *series) {
+  uint32_t bytes = 0;
+
+  for (uint8_t i = 0; i < series->used; i++) {
+    uint8_t b = (uint8_t)((series->head + SENSOR_SERIES_BLOCKS - i) %
+                          SENSOR_SERIES_BLOCKS);
+    bytes += (series->block[b].bits + 7U) / 8U;
+  }
+  return bytes;
+}
@@ -0,0 +1,165 @@
+/**
+ ******************************************************************************
+ * @file    sensor_series.h
+ * @brief   传感器压缩时间序列头文件
+ * @details 在原始历史环形缓冲区 (SENSOR_HISTORY_SIZE 个 float 点) 与
+ *          分钟/小时级汇总之间，以压缩形式保存最近的全部原始样本。
+ *          环境数据变化缓慢，相邻样本高度相关：
+ *            - 时间戳 (ms) 记录二阶差分，采样间隔不变时只占 1 位；
+ *            - 各通道按通道表的定点系数量化后记录一阶差分，数值不变时
+ *              只占 1 位，剔除的样本记为缺失 (5 位)。
+ *          差分按大小分级编码 (Gorilla 的可变长前缀)，每点两个通道平常
+ *          只需 2~4 字节，而 float 历史加时间戳每点需要 12 字节。
+ *          样本写入固定大小的块，块写满后启用下一块并覆盖最旧的块；每块
+ *          从零开始编码、可独立解码，追加为 O(1)，读取按时间顺序向前解码。
+ *          与 sensor_rollup 一样只依赖 C 标准库，时间由调用者传入。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_SERIES_H
+#define __SENSOR_SERIES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#ifndef SENSOR_SERIES_MAX_CHANNELS
+#define SENSOR_SERIES_MAX_CHANNELS 2 // 单个序列的最大通道数 (不小于 SENSOR_MAX_CHANNELS)
+#endif
+#ifndef SENSOR_SERIES_BLOCK_BYTES
+#define SENSOR_SERIES_BLOCK_BYTES 256 // 单个块的数据区大小
+#endif
+#ifndef SENSOR_SERIES_BLOCKS
+#define SENSOR_SERIES_BLOCKS 4 // 块数 (覆盖最旧块时丢弃 1/块数 的历史)
+#endif
+
+#if SENSOR_SERIES_BLOCK_BYTES > 4096
+#error "SENSOR_SERIES_BLOCK_BYTES 超过块内位偏移 (uint16_t) 的范围"
+#endif
+#if SENSOR_SERIES_BLOCKS < 2
+#error "SENSOR_SERIES_BLOCKS 至少为 2 (覆盖时保留上一块)"
+#endif
+
+#define SENSOR_SERIES_EMPTY INT16_MIN // 重采样输出中无数据的时段
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 压缩块 (块内第一个样本的时间作为时间差分的起点)
+ */
+typedef struct {
+  uint32_t t0_ms; // 第一个样本的时间
+  uint16_t count; // 样本数
+  uint16_t bits;  // 已写入的位数
+  uint8_t data[SENSOR_SERIES_BLOCK_BYTES];
+} SensorSeriesBlock_t;
+
+/**
+ * @brief 单个实例的压缩序列 (各通道共用时间戳)
+ */
+typedef struct {
+  float scale[SENSOR_SERIES_MAX_CHANNELS]; // 定点系数：存储值 = 实际值 * scale
+  uint8_t channel_count;
+
+  SensorSeriesBlock_t block[SENSOR_SERIES_BLOCKS];
+  uint8_t head;   // 正在写入的块
+  uint8_t used;   // 有数据的块数 (含正在写入的块)
+  uint32_t total; // 当前保存的样本数
+
+  // 编码状态 (正在写入的块中最后一个样本)
+  uint32_t last_ms;
+  int32_t last_delta;
+  int32_t last_q[SENSOR_SERIES_MAX_CHANNELS];
+} SensorSeries_t;
+
+/**
+ * @brief 解码出的样本
+ */
+typedef struct {
+  uint32_t time_ms;
+  int32_t value[SENSOR_SERIES_MAX_CHANNELS]; // 定点值 (缺失的通道为上一个值)
+  uint8_t missing;                           // 缺失通道位图
+} SensorSeriesPoint_t;
+
+/**
+ * @brief 向前解码的迭代器
+ */
+typedef struct {
+  const SensorSeries_t *series;
+  uint8_t block;       // 当前块下标
+  uint8_t blocks_left; // 尚未读完的块数 (含当前块)
+  uint16_t left;       // 当前块剩余样本数
+  uint16_t pos;        // 当前块的读取位置 (位)
+  uint32_t t_ms;
+  int32_t delta;
+  int32_t q[SENSOR_SERIES_MAX_CHANNELS];
+} SensorSeriesIter_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化序列
+ * @param series        序列对象
+ * @param scale         各通道的定点系数
+ * @param channel_count 通道数 (1 ~ SENSOR_SERIES_MAX_CHANNELS)
+ */
+void SensorSeries_Init(SensorSeries_t *series, const float *scale,
+                       uint8_t channel_count);
+
+/**
+ * @brief 追加一个样本 (O(1)，块写满时覆盖最旧的块)
+ * @param series  序列对象
+ * @param time_ms 样本时间 (ms，单调递增，允许回绕)
+ * @param values  各通道的实际值
+ * @param missing 缺失通道位图 (如质量检查剔除的通道)，对应 values 不使用
+ */
+void SensorSeries_Append(SensorSeries_t *series, uint32_t time_ms,
+                         const float *values, uint8_t missing);
+
+/**
+ * @brief 时间基准改变后 (热启动恢复历史) 平移全部样本的时间
+ * @details 最新样本移到 now_ms，其余样本保持相对间隔；复位期间的空档不计入。
+ * @param series 序列对象
+ * @param now_ms 新时间基准下的当前时间 (ms)
+ */
+void SensorSeries_Rebase(SensorSeries_t *series, uint32_t now_ms);
+
+/**
+ * @brief 从最旧的样本开始迭代
+ */
+void SensorSeries_IterInit(const SensorSeries_t *series,
+                           SensorSeriesIter_t *it);
+
+/**
+ * @brief 解码下一个样本
+ * @return false 已没有更多样本
+ */
+bool SensorSeries_Next(SensorSeriesIter_t *it, SensorSeriesPoint_t *point);
+
+/**
+ * @brief 把最近 window_ms 内的一个通道按时间等分为 buckets 段求平均
+ * @details 一次向前解码完成，不需要额外的缓冲区；窗口以最新样本为终点。
+ * @param out 输出 buckets 个定点值 (限幅到 int16)，无数据的段为
+ *            SENSOR_SERIES_EMPTY
+ * @return uint16_t 有数据的段数
+ */
+uint16_t SensorSeries_Resample(const SensorSeries_t *series, uint8_t channel,
+                               uint32_t window_ms, int16_t *out,
+                               uint16_t buckets);
+
+/**
+ * @brief 压缩数据占用的字节数 (不含块头)，用于估算压缩率
+ */
+uint32_t SensorSeries_UsedBytes(const SensorSeries_t *series);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_SERIES_H */
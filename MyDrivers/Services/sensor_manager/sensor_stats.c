@@ -0,0 +1,215 @@
+/**
+ ******************************************************************************
+ * @file    sensor_stats.c
+ * @brief   传感器增量统计引擎源文件
+ * @details 滑动窗口：累加和/平方和在样本被淘汰时减去旧值，最小/最大值
+ *          使用单调队列维护；全局统计使用 Welford 算法在线更新均值与方差。
+ *          所有操作均为均摊 O(1)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_stats.h"
+#include <math.h>
+#include <string.h>
+
+/* --------------------------- 私有宏 --------------------------- */
+#define DQ_AT(head, i) (((head) + (i)) % SENSOR_HISTORY_SIZE)
+#define SKIPPED(engine, slot) ((engine)->skipped[(slot) >> 3] & (1U << ((slot) & 7U)))
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 为 slot 上的新样本腾出位置：窗口已满时淘汰 ring[slot] 中最旧的样本
+ */
+static void stats_evict(SensorStatsEngine_t *engine, const float *ring,
+                        uint16_t slot) {
+  if (engine->filled < SENSOR_HISTORY_SIZE) {
+    engine->filled++;
+    return;
+  }
+  if (SKIPPED(engine, slot)) {
+    return; // 被剔除的样本没有计入窗口
+  }
+
+  float old = ring[slot];
+  engine->sum -= old;
+  engine->sum_sq -= (double)old * old;
+  engine->count--;
+
+  // 最旧的样本若仍在队列中，一定位于队首
+  if (engine->min_len > 0 && engine->min_dq[engine->min_head] == slot) {
+    engine->min_head = DQ_AT(engine->min_head, 1);
+    engine->min_len--;
+  }
+  if (engine->max_len > 0 && engine->max_dq[engine->max_head] == slot) {
+    engine->max_head = DQ_AT(engine->max_head, 1);
+    engine->max_len--;
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 复位统计引擎
+ */
+void SensorStats_Reset(SensorStatsEngine_t *engine) {
+  memset(engine, 0, sizeof(SensorStatsEngine_t));
+}
+
+/**
+ * @brief 推入一个新样本
+ */
+void SensorStats_Push(SensorStatsEngine_t *engine, const float *ring,
+                      uint16_t slot, float value) {
+  // 1. 窗口已满：淘汰 ring[slot] 中最旧的样本
+  stats_evict(engine, ring, slot);
+  engine->skipped[slot >> 3] &= (uint8_t)~(1U << (slot & 7U));
+
+  // 2. 窗口累加
+  engine->count++;
+  engine->sum += value;
+  engine->sum_sq += (double)value * value;
+
+  // 3. 单调队列：从队尾弹出所有不可能再成为最值的样本
+  while (engine->min_len > 0 &&
+         ring[engine->min_dq[DQ_AT(engine->min_head, engine->min_len - 1)]] >=
+             value) {
+    engine->min_len--;
+  }
+  engine->min_dq[DQ_AT(engine->min_head, engine->min_len)] = slot;
+  engine->min_len++;
+
+  while (engine->max_len > 0 &&
+         ring[engine->max_dq[DQ_AT(engine->max_head, engine->max_len - 1)]] <=
+             value) {
+    engine->max_len--;
+  }
+  engine->max_dq[DQ_AT(engine->max_head, engine->max_len)] = slot;
+  engine->max_len++;
+
+  // 4. 全局统计 (Welford)
+  engine->total++;
+  if (engine->total == 1) {
+    engine->global_min = value;
+    engine->global_max = value;
+  } else {
+    if (value < engine->global_min)
+      engine->global_min = value;
+    if (value > engine->global_max)
+      engine->global_max = value;
+  }
+  double delta = value - engine->mean;
+  engine->mean += delta / engine->total;
+  engine->m2 += delta * (value - engine->mean);
+}
+
+/**
+ * @brief 跳过一个被剔除的样本
+ */
+void SensorStats_Skip(SensorStatsEngine_t *engine, const float *ring,
+                      uint16_t slot) {
+  stats_evict(engine, ring, slot);
+  engine->skipped[slot >> 3] |= (uint8_t)(1U << (slot & 7U));
+}
+
+/**
+ * @brief 导出当前统计结果
+ */
+void SensorStats_Export(const SensorStatsEngine_t *engine, const float *ring,
+                        SensorStats_t *stats) {
+  if (engine->total == 0) {
+    memset(stats, 0, sizeof(SensorStats_t));
+    return;
+  }
+
+  stats->min = engine->global_min;
+  stats->max = engine->global_max;
+  stats->avg = (float)engine->mean;
+  stats->count = engine->total;
+  stats->stddev =
+      (engine->total > 1) ? sqrtf((float)(engine->m2 / (engine->total - 1)))
+                          : 0.0f;
+
+  uint16_t n = engine->count;
+  if (n == 0) {
+    // 窗口内的样本全部被剔除
+    stats->local_min = stats->local_max = stats->local_avg = 0.0f;
+    stats->local_stddev = 0.0f;
+    return;
+  }
+  stats->local_min = ring[engine->min_dq[engine->min_head]];
+  stats->local_max = ring[engine->max_dq[engine->max_head]];
+  stats->local_avg = (float)(engine->sum / n);
+  if (n > 1) {
+    // 平方和法可能因舍入略小于 0，截断处理
+    double var = (engine->sum_sq - engine->sum * engine->sum / n) / (n - 1);
+    stats->local_stddev = (var > 0.0) ? sqrtf((float)var) : 0.0f;
+  } else {
+    stats->local_stddev = 0.0f;
+  }
+}
+
+/**
+ * @brief 复位窗口累加器
+ */
+void SensorStats_AccReset(SensorStatsAcc_t *acc) {
+  memset(acc, 0, sizeof(SensorStatsAcc_t));
+}
+
+/**
+ * @brief 窗口累加器推入一个样本
+ */
+void SensorStats_AccPush(SensorStatsAcc_t *acc, float value) {
+  acc->count++;
+  if (acc->count == 1) {
+    acc->min = value;
+    acc->max = value;
+  } else {
+    if (value < acc->min)
+      acc->min = value;
+    if (value > acc->max)
+      acc->max = value;
+  }
+  double delta = value - acc->mean;
+  acc->mean += delta / acc->count;
+  acc->m2 += delta * (value - acc->mean);
+}
+
+/**
+ * @brief 窗口内的样本标准差
+ */
+float SensorStats_AccStddev(const SensorStatsAcc_t *acc) {
+  return (acc->count > 1) ? sqrtf((float)(acc->m2 / (acc->count - 1))) : 0.0f;
+}
+
+/**
+ * @brief EWMA 推入一个样本并返回其 z-score
+ * @details 方差按 var = (1 - a) * (var + a * d^2) 递推 (d 为与旧均值之差)，
+ *          首个样本只初始化均值。
+ */
+float SensorStats_EwmaPush(SensorStatsEwma_t *ewma, float value, float alpha,
+                           float min_sigma, uint16_t warmup) {
+  float z = 0.0f;
+  float delta;
+
+  if (ewma->n == 0) {
+    ewma->mean = value;
+    ewma->var = 0.0f;
+    ewma->n = 1;
+    return 0.0f;
+  }
+
+  delta = value - ewma->mean;
+  if (ewma->n >= warmup) {
+    float sigma = sqrtf(ewma->var);
+    z = delta / (sigma > min_sigma ? sigma : min_sigma);
+  }
+  ewma->mean += alpha * delta;
+  ewma->var = (1.0f - alpha) * (ewma->var + alpha * delta * delta);
+  if (ewma->n < UINT16_MAX) {
+    ewma->n++;
+  }
+  return z;
+}
@@ -0,0 +1,160 @@
+/**
+ ******************************************************************************
+ * @file    sensor_stats.h
+ * @brief   传感器增量统计引擎头文件
+ * @details 针对历史循环缓冲区提供 O(1) 的滑动窗口统计（累加和、单调队列
+ *          最小/最大值、方差）以及自启动以来的全局统计（Welford 算法）。
+ *          每个样本的处理开销与窗口长度无关。
+ *          另提供两个不依赖历史缓冲区的单通道累加器：按时间窗口复位的
+ *          汇总累加器 (Welford) 与指数加权均值/方差 (EWMA) 异常检测。
+ *          本模块只依赖 C 标准库，可以连同 sensor_rollup.c 直接用主机编译器
+ *          编译，以合成数据对算法做基准测试与检查。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_STATS_H
+#define __SENSOR_STATS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+// 历史数据缓冲区（即统计滑动窗口）的长度，可放大到数百个点而不影响单次开销
+// (可在编译选项中覆盖，用于比较不同窗口长度)
+#ifndef SENSOR_HISTORY_SIZE
+#define SENSOR_HISTORY_SIZE 20
+#endif
+
+/* --------------------------- 统计数据结构 --------------------------- */
+typedef struct {
+  // 全局统计数据 (自启动以来)
+  float min;
+  float max;
+  float avg;
+  float stddev;   // 样本标准差
+  uint32_t count; // 累计样本数
+
+  // 局部统计数据 (仅基于当前历史缓冲区)
+  float local_min;
+  float local_max;
+  float local_avg;
+  float local_stddev;
+} SensorStats_t;
+
+/**
+ * @brief 增量统计引擎
+ * @details 单调队列中保存的是历史缓冲区的槽位下标，数值直接从缓冲区读取，
+ *          因此引擎本身不重复保存样本。
+ */
+typedef struct {
+  // 滑动窗口
+  double sum;     // 窗口内累加和 (淘汰时减去旧值)
+  double sum_sq;  // 窗口内平方和
+  uint16_t count; // 窗口内有效样本数
+  uint16_t filled; // 窗口已占用的槽位数 (含剔除的样本)
+  uint8_t skipped[(SENSOR_HISTORY_SIZE + 7) / 8]; // 剔除样本的槽位位图
+  uint16_t min_dq[SENSOR_HISTORY_SIZE]; // 单调递增队列 (队首为最小值)
+  uint16_t max_dq[SENSOR_HISTORY_SIZE]; // 单调递减队列 (队首为最大值)
+  uint16_t min_head, min_len;
+  uint16_t max_head, max_len;
+
+  // 全局 (Welford)
+  uint32_t total;
+  double mean;
+  double m2;
+  float global_min;
+  float global_max;
+} SensorStatsEngine_t;
+
+/**
+ * @brief 时间窗口汇总累加器 (Welford，窗口结束时导出并复位)
+ */
+typedef struct {
+  uint32_t count;
+  double mean;
+  double m2;
+  float min;
+  float max;
+} SensorStatsAcc_t;
+
+/**
+ * @brief 指数加权均值/方差 (每个样本先与当前估计比较，再更新估计)
+ */
+typedef struct {
+  float mean;
+  float var;
+  uint16_t n; // 已学习的样本数 (饱和计数)
+} SensorStatsEwma_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 复位统计引擎
+ * @param engine 引擎指针
+ */
+void SensorStats_Reset(SensorStatsEngine_t *engine);
+
+/**
+ * @brief 推入一个新样本
+ * @note  必须在把 value 写入 ring[slot] 之前调用：窗口已满时，
+ *        ring[slot] 中仍是即将被淘汰的旧值。
+ * @param engine 引擎指针
+ * @param ring   历史循环缓冲区 (长度 SENSOR_HISTORY_SIZE)
+ * @param slot   新样本将要写入的槽位
+ * @param value  新样本值
+ */
+void SensorStats_Push(SensorStatsEngine_t *engine, const float *ring,
+                      uint16_t slot, float value);
+
+/**
+ * @brief 跳过一个被剔除的样本：占用槽位 (淘汰最旧的样本) 但不计入统计
+ * @note  调用时机与 SensorStats_Push 相同，ring[slot] 之后写入什么值都不影响统计
+ */
+void SensorStats_Skip(SensorStatsEngine_t *engine, const float *ring,
+                      uint16_t slot);
+
+/**
+ * @brief 导出当前统计结果
+ * @param engine 引擎指针
+ * @param ring   历史循环缓冲区 (此时应已写入最新样本)
+ * @param stats  输出统计数据
+ */
+void SensorStats_Export(const SensorStatsEngine_t *engine, const float *ring,
+                        SensorStats_t *stats);
+
+/**
+ * @brief 复位窗口累加器
+ */
+void SensorStats_AccReset(SensorStatsAcc_t *acc);
+
+/**
+ * @brief 窗口累加器推入一个样本
+ */
+void SensorStats_AccPush(SensorStatsAcc_t *acc, float value);
+
+/**
+ * @brief 窗口内的样本标准差 (少于 2 个样本时为 0)
+ */
+float SensorStats_AccStddev(const SensorStatsAcc_t *acc);
+
+/**
+ * @brief EWMA 推入一个样本并返回其 z-score
+ * @param alpha     平滑系数 (0 ~ 1，越小基线越稳)
+ * @param min_sigma 标准差下限 (与样本同单位)，避免恒定信号的微小变化被判为异常
+ * @param warmup    学习的样本数少于该值时返回 0
+ * @return (value - 均值) / 标准差，按更新前的估计计算
+ */
+float SensorStats_EwmaPush(SensorStatsEwma_t *ewma, float value, float alpha,
+                           float min_sigma, uint16_t warmup);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_STATS_H */
@@ -9,6 +9,26 @@
  */
 
 #include "sensor_task.h"
+#include "adc_manager.h"
+#include "sensor_alarm.h"
+#include "sensor_anomaly.h"
+#include "sensor_filter.h"
+#include "sensor_quality.h"
+#include "sensor_vent.h"
+#include "sensor_jitter.h"
+#include "sensor_latency.h"
+#include "sensor_adapt.h"
+#include "sensor_replay.h"
+#include "mem_section.h"
+#include "sensor_event_bus.h"
+#include "profiler.h"
+#include "rtc_clock.h"
+#include "runtime_config.h"
+#include "sys_clock.h"
+#include "task_wdt.h"
+#include "warm_start.h"
+#include "semphr.h"
+#include "checksum.h"
 #include <stdio.h>
 #include <string.h>
 
@@ -18,19 +38,82 @@
 #include "log.h"
 
 /* --------------------------- 私有变量 --------------------------- */
-static SensorManager_t g_sensor_manager = {0};        // 全局传感器管理器
-static SensorEventCallback_t g_event_callback = NULL; // 事件回调函数
+static CCM_RAM SensorManager_t g_sensor_manager;     // 全局传感器管理器 (CCM)
 static osThreadId sensor_task_handle = NULL;          // 任务句柄
+static uint8_t s_recovery_left;                       // 本轮主循环剩余的恢复初始化次数
+static uint32_t s_backoff_rand;                       // 退避抖动的伪随机状态
+static SemaphoreHandle_t s_register_mutex;            // 实例注册互斥
+static StaticSemaphore_t s_register_mutex_buf;
+static RuntimeConfigSub_t s_config_sub = -1;          // 运行时配置订阅
+
+// 采样帧 (由 ADC 数据块中断写入，任务按 s_frame_seq 重读避免撕裂)
+#define SENSOR_FRAME_MS (SENSOR_FRAME_BLOCKS * ADC_MANAGER_BLOCK_MS)
+static volatile uint32_t s_frame_seq;  // 帧序号，0 表示尚未收到帧
+static volatile uint32_t s_frame_tick; // 最近一帧的时刻 (ms)
+static volatile uint64_t s_frame_us;   // 最近一帧的时刻 (us)
+static volatile bool s_frame_armed;    // 有传感器在等待下一帧，帧中断须唤醒任务
+static uint32_t s_frame_seen;          // 任务已处理过的帧序号
+static bool s_frame_live;              // 帧在按时到达，按帧触发
+static bool s_frame_pass;              // 本轮主循环处理一个新帧
+static uint32_t s_pass_frame_tick;     // 本轮处理的帧时刻 (ms)
+static uint64_t s_pass_frame_us;       // 本轮处理的帧时刻 (us)
+
+// 任务静态分配 (不占用 FreeRTOS 堆)
+// 热启动保留的汇总与压缩历史 (复位时保持，与注册槽位同下标，见 warm_start.h)
+#define SENSOR_RETAIN_MAGIC 0x52544E53U // "SNTR"
+typedef struct {
+  uint32_t magic; // 0 表示正在改写
+  uint32_t crc;   // [type, 末尾) 的 CRC-32
+  uint8_t type;
+  uint8_t index;
+  uint8_t channel_count;
+  SensorRollup_t rollup[SENSOR_MAX_CHANNELS];
+  SensorSeries_t series;
+} SensorRetained_t;
+static NOINIT_RAM SensorRetained_t s_retained[SENSOR_MAX_INSTANCES];
+
+static uint32_t g_sensor_task_stack[SENSOR_TASK_STACK_SIZE];
+static osStaticThreadDef_t g_sensor_task_tcb;
 
 /* --------------------------- 私有函数声明 --------------------------- */
 static void SensorTask_MainLoop(void const *argument);
 static bool SensorTask_InitializeSensor(SensorInstance_t *sensor);
 static bool SensorTask_UpdateSensor(SensorInstance_t *sensor);
 static void SensorTask_HandleSensorError(SensorInstance_t *sensor);
+static uint32_t SensorTask_BackoffMs(const SensorInstance_t *sensor);
 static void SensorTask_NotifyEvent(SensorEventType_t event_type,
-                                   SensorType_t sensor_type,
+                                   SensorInstance_t *sensor,
                                    const SensorData_t *data,
                                    SensorStatus_t status);
+static int32_t SensorTask_FlushEvents(void);
+static bool SensorTask_PublishEvent(SensorInstance_t *sensor,
+                                    SensorEventType_t event_type);
+static SensorInstance_t *SensorTask_Lookup(SensorHandle_t handle);
+static const SensorCallbacks_t *SensorTask_Callbacks(const SensorInstance_t *sensor);
+static void SensorTask_SortByDeadline(void);
+static void SensorTask_WriteBegin(SensorInstance_t *sensor);
+static void SensorTask_WriteEnd(SensorInstance_t *sensor);
+static uint32_t SensorTask_ReadBegin(const SensorInstance_t *sensor);
+static bool SensorTask_ReadRetry(const SensorInstance_t *sensor, uint32_t seq);
+static void SensorTask_ProcessSensor(SensorInstance_t *sensor);
+static int16_t SensorTask_FixedValue(float scale, float value);
+static void SensorTask_ProcessSplitPhase(SensorInstance_t *sensor,
+                                         const SensorCallbacks_t *callbacks);
+static bool SensorTask_CommitSample(SensorInstance_t *sensor, bool result);
+static void SensorTask_FinishCycle(SensorInstance_t *sensor, bool success);
+static uint32_t SensorTask_AlignDue(const SensorInstance_t *sensor, uint32_t due);
+static void SensorTask_Wakeup(void);
+static bool SensorTask_HasPowerGate(const SensorInstance_t *sensor);
+static void SensorTask_PowerSet(const SensorInstance_t *sensor, bool on);
+static void SensorTask_PowerGate(SensorInstance_t *sensor);
+static bool SensorTask_PowerResume(SensorInstance_t *sensor);
+static void SensorTask_FrameHook(uint32_t block);
+static void SensorTask_FrameBegin(uint32_t tick);
+static bool SensorTask_FrameGated(const SensorInstance_t *sensor);
+static void SensorTask_CycleStart(SensorInstance_t *sensor);
+static void SensorTask_RetainSave(const SensorInstance_t *sensor);
+static bool SensorTask_RetainRestore(SensorInstance_t *sensor);
+static void SensorTask_ApplyConfig(void);
 
 /* --------------------------- 公共函数实现 --------------------------- */
 
@@ -44,27 +127,20 @@ bool SensorTask_Init(void) {
   LOG_INFO("初始化传感器任务管理系统...");
   memset(&g_sensor_manager, 0, sizeof(SensorManager_t));
 
-  // [新增] 创建全局互斥锁
-  osMutexDef(GlobalSensorMutex);
-  g_sensor_manager.global_data_mutex =
-      osMutexCreate(osMutex(GlobalSensorMutex));
+  s_register_mutex = xSemaphoreCreateMutexStatic(&s_register_mutex_buf);
+  s_config_sub = RuntimeConfig_Subscribe(SensorTask_Wakeup);
 
-  if (g_sensor_manager.global_data_mutex == NULL) {
-    LOG_ERROR("全局互斥锁创建失败");
-    return false;
-  }
-
-  // 初始化所有传感器实例
-  for (int i = 0; i < SENSOR_TYPE_MAX; i++) {
-    g_sensor_manager.sensors[i].type = (SensorType_t)i;
+  // 注册表为空：所有句柄都未映射到实例
+  memset(g_sensor_manager.slot, 0xFF, sizeof(g_sensor_manager.slot));
+  for (int i = 0; i < SENSOR_MAX_INSTANCES; i++) {
     g_sensor_manager.sensors[i].status = SENSOR_STATUS_OFFLINE;
-    snprintf(g_sensor_manager.sensors[i].name, SENSOR_MAX_NAME_LEN, "Sensor_%d",
-             i);
+    g_sensor_manager.sensors[i].handle = SENSOR_HANDLE_INVALID;
   }
 
   // 创建传感器任务
-  osThreadDef(sensorTask, SensorTask_MainLoop, SENSOR_TASK_PRIORITY, 0,
-              SENSOR_TASK_STACK_SIZE);
+  osThreadStaticDef(sensorTask, SensorTask_MainLoop, SENSOR_TASK_PRIORITY, 0,
+                    SENSOR_TASK_STACK_SIZE, g_sensor_task_stack,
+                    &g_sensor_task_tcb);
   sensor_task_handle = osThreadCreate(osThread(sensorTask), NULL);
 
   if (sensor_task_handle == NULL) {
@@ -74,65 +150,250 @@ bool SensorTask_Init(void) {
 
   g_sensor_manager.is_initialized = true;
   g_sensor_manager.active_sensor_count = 0;
+#if SENSOR_FRAME_SYNC
+  ADC_Manager_SetBlockHook(SensorTask_FrameHook);
+#endif
   LOG_INFO("传感器任务创建成功");
 
   return true;
 }
 
 /**
- * @brief 注册传感器
+ * @brief 检查一条驱动配置
  */
-bool SensorTask_RegisterSensor(SensorType_t type, const char *name,
-                               const SensorCallbacks_t *callbacks,
-                               void *device_handle,
-                               uint32_t update_interval_ms) {
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      type == SENSOR_TYPE_NONE || callbacks == NULL ||
-      callbacks->init_func == NULL || callbacks->read_func == NULL) {
-    LOG_ERROR("注册传感器失败：参数无效 (type: %d)", type);
-    return false;
+static bool SensorTask_DriverValid(const SensorDriverDesc_t *driver) {
+  const SensorCallbacks_t *callbacks = driver->callbacks;
+
+  return driver->type > SENSOR_TYPE_NONE && driver->type < SENSOR_TYPE_MAX &&
+         driver->name != NULL && callbacks != NULL &&
+         driver->channels != NULL && driver->channel_count > 0 &&
+         driver->channel_count <= SENSOR_MAX_CHANNELS &&
+         callbacks->init_func != NULL &&
+         (callbacks->read_func != NULL ||
+          (callbacks->start_func != NULL && callbacks->collect_func != NULL));
+}
+
+/**
+ * @brief 设置驱动配置表
+ */
+bool SensorTask_SetDrivers(const SensorDriverDesc_t *drivers, uint8_t count) {
+  for (uint8_t i = 0; i < count; i++) {
+    if (!SensorTask_DriverValid(&drivers[i])) {
+      LOG_ERROR("驱动配置表第 %u 条无效 (type: %d)", i, drivers[i].type);
+      return false;
+    }
+  }
+  g_sensor_manager.drivers = drivers;
+  g_sensor_manager.driver_count = count;
+  return true;
+}
+
+/**
+ * @brief 查找类型的驱动配置
+ */
+static const SensorDriverDesc_t *SensorTask_FindDriver(SensorType_t type) {
+  for (uint8_t i = 0; i < g_sensor_manager.driver_count; i++) {
+    if (g_sensor_manager.drivers[i].type == type) {
+      return &g_sensor_manager.drivers[i];
+    }
   }
+  return NULL;
+}
 
-  SensorInstance_t *sensor = &g_sensor_manager.sensors[type];
-  strncpy(sensor->name, name, SENSOR_MAX_NAME_LEN - 1);
-  sensor->name[SENSOR_MAX_NAME_LEN - 1] = '\0';
+/**
+ * @brief 分配槽位并发布实例 (名称与回调可替换驱动配置中的值)
+ */
+static SensorHandle_t SensorTask_Register(const SensorDriverDesc_t *driver,
+                                          const char *name,
+                                          const SensorCallbacks_t *callbacks,
+                                          void *device_handle, bool remote) {
+  SensorType_t type = driver->type;
+
+  // 启动后探测与网关任务都可能注册，槽位分配须互斥
+  xSemaphoreTake(s_register_mutex, portMAX_DELAY);
+
+  // 分配同类型中的序号与注册表槽位
+  uint8_t index = 0;
+  while (index < SENSOR_MAX_PER_TYPE &&
+         g_sensor_manager.slot[type][index] != 0xFF) {
+    index++;
+  }
+  uint8_t slot = g_sensor_manager.sensor_count;
+  if (index >= SENSOR_MAX_PER_TYPE || slot >= SENSOR_MAX_INSTANCES) {
+    xSemaphoreGive(s_register_mutex);
+    LOG_ERROR("注册传感器失败：注册表已满 (type: %d)", type);
+    return SENSOR_HANDLE_INVALID;
+  }
+
+  // 名称、通道表与回调均指向静态存储，不做拷贝
+  SensorInstance_t *sensor = &g_sensor_manager.sensors[slot];
+  sensor->type = type;
+  sensor->index = index;
+  sensor->handle = SENSOR_HANDLE(type, index);
+  sensor->name = name;
   sensor->device_handle = device_handle;
-  sensor->update_interval_ms = update_interval_ms;
+  sensor->channels = driver->channels;
+  sensor->channel_count = driver->channel_count;
+  sensor->update_interval_ms = driver->update_interval_ms;
+  sensor->sample_interval_ms = driver->update_interval_ms;
+  sensor->phase_offset_ms = (uint32_t)slot * SENSOR_PHASE_STEP_MS;
   sensor->error_count = 0;
+  sensor->power = remote ? NULL : &driver->power;
+  sensor->power_state = SENSOR_POWER_STATE_ON; // 引脚默认上电
   sensor->is_enabled = false;
+  sensor->is_remote = remote;
+  g_sensor_manager.callbacks[slot] = callbacks;
+
+  // 初始化分钟/小时级历史 (定点缩放系数按通道量程选取)
+  float scale[SENSOR_MAX_CHANNELS];
+  for (uint8_t ch = 0; ch < driver->channel_count; ch++) {
+    SensorRollup_Init(&sensor->rollup[ch], driver->channels[ch].fixed_scale);
+    scale[ch] = driver->channels[ch].fixed_scale;
+  }
+  SensorSeries_Init(&sensor->series, scale, driver->channel_count);
+  bool restored = SensorTask_RetainRestore(sensor);
 
-  // 复制回调函数
-  g_sensor_manager.callbacks[type] = *callbacks;
+  // 实例完整后再发布：传感器任务只遍历 sensor_count 之内的槽位
+  g_sensor_manager.order[slot] = slot;
+  g_sensor_manager.slot[type][index] = slot;
+  __DMB();
+  g_sensor_manager.sensor_count = slot + 1;
+  xSemaphoreGive(s_register_mutex);
 
   // 启用传感器
-  SensorTask_EnableSensor(type);
+  SensorTask_EnableSensor(sensor->handle);
 
-  LOG_INFO("传感器 '%s' (类型: %d) 注册完成", sensor->name, type);
-  return true;
+  LOG_INFO("传感器 '%s' (类型: %d, 序号: %u) 注册完成%s", sensor->name, type,
+           index, restored ? "，已恢复热启动前的历史" : "");
+  return sensor->handle;
+}
+
+/**
+ * @brief 注册传感器实例
+ */
+SensorHandle_t SensorTask_RegisterInstance(SensorType_t type,
+                                           void *device_handle) {
+  const SensorDriverDesc_t *driver = SensorTask_FindDriver(type);
+
+  if (!g_sensor_manager.is_initialized || driver == NULL) {
+    LOG_ERROR("注册传感器失败：类型未配置 (type: %d)", type);
+    return SENSOR_HANDLE_INVALID;
+  }
+  return SensorTask_Register(driver, driver->name, driver->callbacks,
+                             device_handle, false);
+}
+
+/**
+ * @brief 注册远端传感器实例
+ */
+SensorHandle_t SensorTask_RegisterRemote(SensorType_t type, const char *name,
+                                         const SensorCallbacks_t *callbacks,
+                                         void *device_handle) {
+  const SensorDriverDesc_t *driver = SensorTask_FindDriver(type);
+  SensorDriverDesc_t check;
+
+  if (!g_sensor_manager.is_initialized || driver == NULL || name == NULL) {
+    LOG_ERROR("注册远端传感器失败：类型未配置 (type: %d)", type);
+    return SENSOR_HANDLE_INVALID;
+  }
+  check = *driver;
+  check.callbacks = callbacks;
+  if (!SensorTask_DriverValid(&check)) {
+    LOG_ERROR("注册远端传感器失败：回调无效 (%s)", name);
+    return SENSOR_HANDLE_INVALID;
+  }
+  return SensorTask_Register(driver, name, callbacks, device_handle, true);
+}
+
+/**
+ * @brief 是否为远端实例
+ */
+bool SensorTask_IsRemote(SensorHandle_t handle) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  return sensor != NULL && sensor->is_remote;
+}
+
+/**
+ * @brief 注册传感器
+ */
+bool SensorTask_RegisterSensor(SensorType_t type, void *device_handle) {
+  return SensorTask_RegisterInstance(type, device_handle) !=
+         SENSOR_HANDLE_INVALID;
+}
+
+/**
+ * @brief 已注册的实例数
+ */
+uint8_t SensorTask_GetSensorCount(void) { return g_sensor_manager.sensor_count; }
+
+/**
+ * @brief 按注册顺序获取实例句柄
+ */
+SensorHandle_t SensorTask_GetHandleAt(uint8_t i) {
+  if (i >= g_sensor_manager.sensor_count) {
+    return SENSOR_HANDLE_INVALID;
+  }
+  return g_sensor_manager.sensors[i].handle;
+}
+
+/**
+ * @brief 查找实例
+ */
+SensorHandle_t SensorTask_Find(SensorType_t type, uint8_t index) {
+  SensorInstance_t *sensor = SensorTask_Lookup(SENSOR_HANDLE(type, index));
+  return sensor != NULL ? sensor->handle : SENSOR_HANDLE_INVALID;
+}
+
+/**
+ * @brief 获取实例名称
+ */
+const char *SensorTask_GetName(SensorHandle_t handle) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  return sensor != NULL ? sensor->name : "?";
 }
 
 /**
  * @brief 启用传感器
  */
-bool SensorTask_EnableSensor(SensorType_t type) {
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      type == SENSOR_TYPE_NONE) {
+bool SensorTask_EnableSensor(SensorHandle_t handle) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  if (sensor == NULL) {
     return false;
   }
 
-  SensorInstance_t *sensor = &g_sensor_manager.sensors[type];
+  // 已判定缺失的传感器：重新启用即立即重新探测，不必等待退避
+  if (sensor->is_enabled && sensor->status == SENSOR_STATUS_ERROR) {
+    sensor->status = SENSOR_STATUS_INITIALIZING;
+    sensor->error_count = 0;
+    sensor->next_due_time = HAL_GetTick();
+    SensorTask_Wakeup();
+  }
 
   if (!sensor->is_enabled) {
     sensor->is_enabled = true;
     sensor->status = SENSOR_STATUS_INITIALIZING;
     sensor->error_count = 0;
+    sensor->is_converting = false;
+    sensor->next_due_time = HAL_GetTick() + sensor->phase_offset_ms;
+    if (SensorTask_HasPowerGate(sensor) &&
+        sensor->power_state != SENSOR_POWER_STATE_ON) {
+      // 禁用时已断电：上电预热后再初始化
+      SensorTask_PowerSet(sensor, true);
+      sensor->power_state = SENSOR_POWER_STATE_ON;
+      if (sensor->phase_offset_ms < sensor->power->warmup_ms) {
+        sensor->next_due_time = HAL_GetTick() + sensor->power->warmup_ms;
+      }
+    }
     g_sensor_manager.active_sensor_count++;
 
     LOG_INFO("启用传感器: %s", sensor->name);
 
     // 通知状态变化事件
-    SensorTask_NotifyEvent(SENSOR_EVENT_STATUS_CHANGE, type, NULL,
+    SensorTask_NotifyEvent(SENSOR_EVENT_STATUS_CHANGE, sensor, NULL,
                            SENSOR_STATUS_INITIALIZING);
+
+    // 唤醒调度器重新计算截止时间
+    SensorTask_Wakeup();
   }
   return true;
 }
@@ -140,18 +401,22 @@ bool SensorTask_EnableSensor(SensorType_t type) {
 /**
  * @brief 禁用传感器
  */
-bool SensorTask_DisableSensor(SensorType_t type) {
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      type == SENSOR_TYPE_NONE) {
+bool SensorTask_DisableSensor(SensorHandle_t handle) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  if (sensor == NULL) {
     return false;
   }
 
-  SensorInstance_t *sensor = &g_sensor_manager.sensors[type];
-
   if (sensor->is_enabled) {
     // 调用反初始化函数
-    if (g_sensor_manager.callbacks[type].deinit_func != NULL) {
-      g_sensor_manager.callbacks[type].deinit_func(sensor);
+    const SensorCallbacks_t *callbacks = SensorTask_Callbacks(sensor);
+    if (callbacks->deinit_func != NULL &&
+        sensor->power_state == SENSOR_POWER_STATE_ON) {
+      callbacks->deinit_func(sensor);
+    }
+    if (SensorTask_HasPowerGate(sensor)) {
+      SensorTask_PowerSet(sensor, false);
+      sensor->power_state = SENSOR_POWER_STATE_OFF;
     }
 
     sensor->is_enabled = false;
@@ -161,7 +426,7 @@ bool SensorTask_DisableSensor(SensorType_t type) {
     LOG_INFO("禁用传感器: %s", sensor->name);
 
     // 通知状态变化事件
-    SensorTask_NotifyEvent(SENSOR_EVENT_STATUS_CHANGE, type, NULL,
+    SensorTask_NotifyEvent(SENSOR_EVENT_STATUS_CHANGE, sensor, NULL,
                            SENSOR_STATUS_OFFLINE);
   }
 
@@ -171,69 +436,92 @@ bool SensorTask_DisableSensor(SensorType_t type) {
 /**
  * @brief 获取传感器数据
  */
-bool SensorTask_GetSensorData(SensorType_t type, SensorData_t *data) {
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      type == SENSOR_TYPE_NONE || data == NULL) {
+bool SensorTask_GetSensorData(SensorHandle_t handle, SensorData_t *data) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+
+  if (sensor == NULL || data == NULL || !sensor->is_enabled) {
     return false;
   }
 
-  SensorInstance_t *sensor = &g_sensor_manager.sensors[type];
+  uint32_t seq;
+  do {
+    seq = SensorTask_ReadBegin(sensor);
+    *data = sensor->shared_data;
+  } while (SensorTask_ReadRetry(sensor, seq));
 
-  if (sensor->is_enabled && sensor->data.is_valid) {
-    if (osMutexWait(g_sensor_manager.global_data_mutex, 100) == osOK) {
-      *data = sensor->data;
-      osMutexRelease(g_sensor_manager.global_data_mutex);
-      return true;
-    }
-  }
-
-  return false;
+  return data->is_valid;
 }
 
 /**
  * @brief [新增] 获取指定传感器的状态
- * @param type 传感器类型
+ * @param handle 实例句柄
  * @param status 输出状态的指针
  * @return true: 成功, false: 失败
  */
-bool SensorTask_GetSensorStatus(SensorType_t type, SensorStatus_t *status) {
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      status == NULL) {
+bool SensorTask_GetSensorStatus(SensorHandle_t handle, SensorStatus_t *status) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+
+  if (sensor == NULL || status == NULL) {
     return false;
   }
 
-  SensorInstance_t *sensor = &g_sensor_manager.sensors[type];
+  // 状态为单个字，读取本身是原子的
+  *status = sensor->status;
+  return true;
+}
 
-  if (osMutexWait(g_sensor_manager.global_data_mutex, 100) == osOK) {
-    *status = sensor->status;
-    osMutexRelease(g_sensor_manager.global_data_mutex);
-    return true;
-  }
+/**
+ * @brief 获取传感器当前的实际采样间隔
+ */
+uint32_t SensorTask_GetSampleInterval(SensorHandle_t handle) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  return sensor != NULL ? sensor->sample_interval_ms : 0;
+}
 
-  return false;
+/**
+ * @brief 获取传感器配置的更新间隔
+ */
+uint32_t SensorTask_GetUpdateInterval(SensorHandle_t handle) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  return sensor != NULL ? sensor->update_interval_ms : 0;
 }
 
 /**
  * @brief 设置传感器更新间隔
  */
-bool SensorTask_SetUpdateInterval(SensorType_t type, uint32_t interval_ms) {
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      type == SENSOR_TYPE_NONE || interval_ms < 100) {
+bool SensorTask_SetUpdateInterval(SensorHandle_t handle, uint32_t interval_ms) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  if (sensor == NULL || interval_ms < 100) {
     return false;
   }
 
-  g_sensor_manager.sensors[type].update_interval_ms = interval_ms;
-  LOG_INFO("设置传感器 %s 更新间隔为 %d ms",
-           g_sensor_manager.sensors[type].name, interval_ms);
+  sensor->update_interval_ms = interval_ms;
+  sensor->sample_interval_ms = interval_ms;
+  if (sensor->status == SENSOR_STATUS_ONLINE && !sensor->is_converting &&
+      sensor->power_state != SENSOR_POWER_STATE_WARMUP) {
+    sensor->next_due_time = sensor->last_update_time + interval_ms;
+    if (sensor->power_state == SENSOR_POWER_STATE_OFF) {
+      // 断电期间：按新的采样时刻提前上电
+      sensor->power_due_time = sensor->next_due_time;
+      sensor->next_due_time -= sensor->power->warmup_ms;
+    }
+  }
+  LOG_INFO("设置传感器 %s 更新间隔为 %d ms", sensor->name, interval_ms);
 
+  SensorTask_Wakeup();
   return true;
 }
 
 /**
- * @brief 注册传感器事件回调函数
+ * @brief 设置传感器相位偏移
  */
-bool SensorTask_RegisterEventCallback(SensorEventCallback_t callback) {
-  g_event_callback = callback;
+bool SensorTask_SetPhaseOffset(SensorHandle_t handle, uint32_t offset_ms) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  if (sensor == NULL) {
+    return false;
+  }
+
+  sensor->phase_offset_ms = offset_ms;
   return true;
 }
 
@@ -241,67 +529,412 @@ bool SensorTask_RegisterEventCallback(SensorEventCallback_t callback) {
 
 /**
  * @brief 传感器任务主循环
+ * @details 截止时间调度：实例按截止时间排序，依次处理已到期的传感器
+ *          (遇到第一个未到期的即停止)，然后睡眠到最近的截止时间。启用传感器或修改间隔时通过任务
+ *          通知提前唤醒，空闲时除状态日志外不再有周期性唤醒。
+ *          支持分阶段读取的传感器在转换期间也以截止时间的形式挂起，
+ *          因此多个传感器的转换可以相互重叠。
+ *          采样帧按时到达时，新一轮采样只在帧时刻开始 (见 SENSOR_FRAME_SYNC)：
+ *          截止时间前半帧起不再按时间唤醒，而是等待帧中断。
  */
 static void SensorTask_MainLoop(void const *argument) {
-  osDelay(1000); // 等待系统稳定
+  // 传感器上电稳定：从复位开始计时，启动阶段耗时已经足够时不再等待
+  if (HAL_GetTick() < SENSOR_POWERUP_SETTLE_MS) {
+    osDelay(SENSOR_POWERUP_SETTLE_MS - HAL_GetTick());
+  }
 
-  uint8_t loop_count = 0;
+  uint32_t last_log_time = HAL_GetTick();
 
+  TaskWdt_Register(TASK_WDT_DEADLINE_SENSOR_MS);
   for (;;) {
-    uint32_t loop_start_time = HAL_GetTick();
-
-    // 遍历所有传感器
-    for (int i = 1; i < SENSOR_TYPE_MAX; i++) { // 跳过SENSOR_TYPE_NONE
-      SensorInstance_t *sensor = &g_sensor_manager.sensors[i];
+    TaskWdt_CheckIn();
+    SensorTask_ApplyConfig(); // 新配置在两轮采样之间整体生效
+    s_recovery_left = SENSOR_RECOVERY_PER_PASS;
+    // 按截止时间顺序处理已到期的传感器
+    SensorTask_SortByDeadline();
+    uint32_t tick = HAL_GetTick();
+    SensorTask_FrameBegin(tick);
+    uint8_t count = g_sensor_manager.sensor_count;
+    for (uint8_t i = 0; i < count; i++) {
+      SensorInstance_t *sensor =
+          &g_sensor_manager.sensors[g_sensor_manager.order[i]];
 
       if (!sensor->is_enabled) {
         continue; // 跳过未启用的传感器
       }
-
-      // 检查是否需要初始化
-      if (sensor->status == SENSOR_STATUS_INITIALIZING) {
-        if (SensorTask_InitializeSensor(sensor)) {
-          sensor->status = SENSOR_STATUS_ONLINE;
-          sensor->last_update_time = HAL_GetTick();
-          LOG_INFO("传感器 %s 初始化成功", sensor->name);
-
-          // 通知状态变化事件
-          SensorTask_NotifyEvent(SENSOR_EVENT_STATUS_CHANGE, (SensorType_t)i,
-                                 NULL, SENSOR_STATUS_ONLINE);
-        } else {
-          SensorTask_HandleSensorError(sensor);
+      if (SensorTask_FrameGated(sensor)) {
+        // 新一轮采样：截止时间落在本帧 ±半帧内才开始
+        if (!s_frame_pass ||
+            (int32_t)(sensor->next_due_time - s_pass_frame_tick) >
+                SENSOR_FRAME_MS / 2) {
           continue;
         }
+      } else if ((int32_t)(sensor->next_due_time - tick) > 0) {
+        if (!s_frame_live) {
+          break; // 其后的传感器都尚未到期
+        }
+        continue; // 其后可能有按帧触发的传感器
+      }
+      SensorTask_ProcessSensor(sensor);
+    }
+    s_frame_pass = false;
+
+    // 投递本轮合并后的事件
+    int32_t flush_ms = SensorTask_FlushEvents();
+    uint32_t now = HAL_GetTick();
+
+    // 定期打印一次状态
+    if ((now - last_log_time) >= SENSOR_STATUS_LOG_INTERVAL_MS) {
+      last_log_time = now;
+      SensorEventBusStats_t bus;
+      LOG_INFO("传感器任务运行正常，系统运行时间:%d ms 活跃传感器: %d "
+               "合并事件: %lu",
+               now, g_sensor_manager.active_sensor_count,
+               (unsigned long)g_sensor_manager.events_coalesced);
+      SensorEventBus_GetStats(&bus);
+      if (bus.pool_empty > 0) {
+        LOG_WARN("事件记录池耗尽 %lu 次 (最少空闲 %u)",
+                 (unsigned long)bus.pool_empty, bus.pool_min_free);
       }
+    }
 
-      // 检查是否需要更新数据
-      uint32_t current_time = HAL_GetTick();
-      if ((current_time - sensor->last_update_time) >=
-          sensor->update_interval_ms) {
-        if (SensorTask_UpdateSensor(sensor)) {
-          sensor->last_update_time = current_time;
-
-          // 通知数据更新事件
-          SensorTask_NotifyEvent(SENSOR_EVENT_DATA_UPDATE, (SensorType_t)i,
-                                 &sensor->data, sensor->status);
-        } else {
-          SensorTask_HandleSensorError(sensor);
+    // 计算最近的截止时间 (以状态日志间隔为上限)
+    int32_t wait_ms =
+        (int32_t)(last_log_time + SENSOR_STATUS_LOG_INTERVAL_MS - now);
+    if (flush_ms >= 0 && flush_ms < wait_ms) {
+      wait_ms = flush_ms; // 仍有事件等待合并窗口结束或重新投递
+    }
+    SensorTask_SortByDeadline();
+    count = g_sensor_manager.sensor_count;
+    for (uint8_t i = 0; i < count; i++) {
+      SensorInstance_t *sensor =
+          &g_sensor_manager.sensors[g_sensor_manager.order[i]];
+      if (!sensor->is_enabled) {
+        continue;
+      }
+      int32_t remain = (int32_t)(sensor->next_due_time - now);
+      if (SensorTask_FrameGated(sensor)) {
+        // 截止时间前半帧起由帧中断唤醒；帧停止时最多等两帧后退回按时调度
+        remain -= SENSOR_FRAME_MS / 2;
+        if (remain <= 0) {
+          s_frame_armed = true;
+          remain = 2 * SENSOR_FRAME_MS;
         }
       }
+      if (remain < wait_ms)
+        wait_ms = remain;
+      if (!s_frame_live) {
+        break; // 第一个启用的即为最近的截止时间
+      }
     }
 
-    // 每100个循环打印一次状态（约10秒）一个循环大概100ms
-    if (++loop_count % 100 == 0) {
-      loop_count = 0;
-      LOG_INFO("传感器任务运行正常，系统运行时间:%d ms 活跃传感器: %d",
-               HAL_GetTick(), g_sensor_manager.active_sensor_count);
+    if (wait_ms > 0) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms));
     }
+  }
+}
+
+/**
+ * @brief 处理一个已到期的传感器 (初始化或读取)，并安排下次截止时间
+ */
+static void SensorTask_ProcessSensor(SensorInstance_t *sensor) {
+  // 两次采样之间断电：先上电预热，预热结束后重新初始化
+  if (sensor->power_state != SENSOR_POWER_STATE_ON &&
+      !SensorTask_PowerResume(sensor)) {
+    return;
+  }
+
+  // 检查是否需要初始化 (缺失的传感器按退避间隔重新探测)
+  if (sensor->status == SENSOR_STATUS_INITIALIZING ||
+      sensor->status == SENSOR_STATUS_ERROR) {
+    bool absent = (sensor->status == SENSOR_STATUS_ERROR);
+    // 故障后的恢复初始化每轮限次，其余顺延 (首次初始化不受限)
+    if (sensor->error_count > 0) {
+      if (s_recovery_left == 0) {
+        sensor->next_due_time = HAL_GetTick() + SENSOR_RETRY_INTERVAL_MS;
+        return;
+      }
+      s_recovery_left--;
+    }
+    if (SensorTask_InitializeSensor(sensor)) {
+      sensor->status = SENSOR_STATUS_ONLINE;
+      sensor->last_update_time = HAL_GetTick();
+      sensor->next_due_time = sensor->last_update_time; // 立即进行首次采样
+      LOG_INFO("传感器 %s %s", sensor->name, absent ? "重新上线" : "初始化成功");
+
+      // 通知状态变化事件
+      SensorTask_NotifyEvent(SENSOR_EVENT_STATUS_CHANGE, sensor, NULL,
+                             SENSOR_STATUS_ONLINE);
+    } else {
+      SensorTask_HandleSensorError(sensor);
+    }
+    return;
+  }
+
+  const SensorCallbacks_t *callbacks = SensorTask_Callbacks(sensor);
+
+  // 分阶段读取：触发与取回分开处理，转换期间不阻塞其他传感器
+  if (callbacks->start_func != NULL && callbacks->collect_func != NULL) {
+    SensorTask_ProcessSplitPhase(sensor, callbacks);
+    return;
+  }
+
+  // 阻塞读取 (回调被替换时放弃正在进行的分阶段转换)
+  sensor->is_converting = false;
+  SensorTask_CycleStart(sensor);
+  SensorTask_FinishCycle(sensor, SensorTask_UpdateSensor(sensor));
+}
+
+/**
+ * @brief 分阶段读取：到期时触发转换，转换完成后再取回结果
+ * @details 触发后把截止时间改为转换完成时刻并立即返回，主循环在此期间
+ *          继续处理其他传感器；取回时若驱动仍需时间 (如多次采样)，
+ *          则按驱动给出的等待时间再次安排。
+ */
+static void SensorTask_ProcessSplitPhase(SensorInstance_t *sensor,
+                                         const SensorCallbacks_t *callbacks) {
+  uint32_t wait_ms = 0;
+
+  // 1. 触发转换
+  if (!sensor->is_converting) {
+    SensorTask_CycleStart(sensor);
+    memset(sensor->data.quality, SENSOR_QUALITY_OK, sizeof(sensor->data.quality));
+    if (!callbacks->start_func(sensor, &wait_ms)) {
+      SensorTask_FinishCycle(sensor, SensorTask_CommitSample(sensor, false));
+      return;
+    }
+    sensor->is_converting = true;
+    if (wait_ms > 0) {
+      sensor->next_due_time = HAL_GetTick() + wait_ms;
+      return;
+    }
+  }
+
+  // 2. 取回结果
+  SensorCollectResult_t result = callbacks->collect_func(sensor, &wait_ms);
+  if (result == SENSOR_COLLECT_PENDING) {
+    sensor->next_due_time = HAL_GetTick() + wait_ms;
+    return;
+  }
+
+  sensor->is_converting = false;
+  SensorTask_FinishCycle(
+      sensor, SensorTask_CommitSample(sensor, result == SENSOR_COLLECT_DONE));
+}
 
-    // 动态调整循环间隔
-    uint32_t loop_duration = HAL_GetTick() - loop_start_time;
-    uint32_t sleep_time = (loop_duration < 100) ? (100 - loop_duration) : 10;
+/**
+ * @brief 结束一轮采样：安排下次截止时间并分发事件
+ */
+static void SensorTask_FinishCycle(SensorInstance_t *sensor, bool success) {
+  if (success) {
+    sensor->last_update_time = HAL_GetTick();
+    SensorJitter_Record(sensor->handle, sensor->cycle_due_time,
+                        sensor->conversion_start_us, SysClock_Micros());
+    SensorLatency_Record(SENSOR_LATENCY_COMMIT, sensor->data.timestamp_us);
+
+    // 按固定节拍推进截止时间，保持相位；落后太多时从当前时刻重新对齐
+    sensor->next_due_time =
+        sensor->cycle_due_time + sensor->sample_interval_ms;
+    if ((int32_t)(sensor->next_due_time - HAL_GetTick()) <= 0) {
+      sensor->next_due_time = HAL_GetTick() + sensor->sample_interval_ms;
+    }
+    sensor->next_due_time = SensorTask_AlignDue(sensor, sensor->next_due_time);
+    SensorTask_PowerGate(sensor);
+
+    // 通知数据更新事件
+    SensorTask_NotifyEvent(SENSOR_EVENT_DATA_UPDATE, sensor, &sensor->data,
+                           sensor->status);
+  } else {
+    SensorTask_HandleSensorError(sensor);
+  }
+}
 
-    osDelay(sleep_time);
+/**
+ * @brief 把截止时间移到最近的墙上时钟对齐时刻 (间隔的整数倍 + 相位偏移)
+ * @details 多个节点校时后在同一时刻采样，服务器按时间合并无需插值；
+ *          同一节点的传感器仍按相位偏移错开，不会同时占用总线。
+ *          RTC 平滑校准时每轮只需微调，首次校时后的一轮可能缩短或延长
+ *          不超过半个间隔。
+ */
+static uint32_t SensorTask_AlignDue(const SensorInstance_t *sensor, uint32_t due) {
+  uint32_t interval = sensor->sample_interval_ms;
+  uint32_t tick;
+  uint32_t err;
+  uint64_t at;
+
+  if (!SENSOR_ALIGN_TO_CLOCK || !RtcClock_IsSet() || interval == 0) {
+    return due;
+  }
+  tick = HAL_GetTick();
+  at = RtcClock_NowMillis() + (uint32_t)(due - tick); // 截止时刻的墙上时钟
+  err = (uint32_t)((at + interval - sensor->phase_offset_ms % interval) % interval);
+  if (err <= interval / 2) {
+    due -= err;
+  } else {
+    due += interval - err;
+  }
+  if ((int32_t)(due - tick) <= 0) {
+    due += interval;
+  }
+  return due;
+}
+
+/**
+ * @brief 唤醒传感器任务重新计算截止时间
+ */
+static void SensorTask_Wakeup(void) {
+  if (sensor_task_handle != NULL && osThreadGetId() != sensor_task_handle) {
+    xTaskNotifyGive((TaskHandle_t)sensor_task_handle);
+  }
+}
+
+/**
+ * @brief 是否为可断电的传感器
+ */
+static bool SensorTask_HasPowerGate(const SensorInstance_t *sensor) {
+  return sensor->power != NULL && sensor->power->port != NULL;
+}
+
+/**
+ * @brief 设置电源开关
+ */
+static void SensorTask_PowerSet(const SensorInstance_t *sensor, bool on) {
+  GPIO_PinState on_level = (GPIO_PinState)sensor->power->on_level;
+  GPIO_PinState off_level =
+      (on_level == GPIO_PIN_SET) ? GPIO_PIN_RESET : GPIO_PIN_SET;
+
+  HAL_GPIO_WritePin(sensor->power->port, sensor->power->pin,
+                    on ? on_level : off_level);
+}
+
+/**
+ * @brief 采样完成后断电 (空闲时间足够长时)
+ * @details 截止时间改为下次采样前 warmup_ms，原定的采样时刻保存在
+ *          power_due_time；断电前反初始化，使上电后重新配置芯片。
+ */
+static void SensorTask_PowerGate(SensorInstance_t *sensor) {
+  if (!SensorTask_HasPowerGate(sensor) ||
+      sensor->power_state != SENSOR_POWER_STATE_ON) {
+    return;
+  }
+
+  // 按帧触发时采样可能提前半帧，上电也相应提前
+  uint32_t warmup_ms =
+      sensor->power->warmup_ms + (s_frame_live ? SENSOR_FRAME_MS / 2 : 0);
+  int32_t idle_ms = (int32_t)(sensor->next_due_time - HAL_GetTick());
+  if (idle_ms < (int32_t)(warmup_ms + SENSOR_POWER_MIN_OFF_MS)) {
+    return; // 断电时间太短，不值得重新预热
+  }
+
+  const SensorCallbacks_t *callbacks = SensorTask_Callbacks(sensor);
+  if (callbacks->deinit_func != NULL) {
+    callbacks->deinit_func(sensor);
+  }
+  SensorTask_PowerSet(sensor, false);
+  sensor->power_state = SENSOR_POWER_STATE_OFF;
+  sensor->power_due_time = sensor->next_due_time;
+  sensor->next_due_time -= warmup_ms;
+}
+
+/**
+ * @brief 断电的传感器到期：上电并等待预热，预热结束后重新初始化
+ * @return true 已可以采样 (继续本次处理)
+ */
+static bool SensorTask_PowerResume(SensorInstance_t *sensor) {
+  if (sensor->power_state == SENSOR_POWER_STATE_OFF) {
+    uint32_t ready = HAL_GetTick() + sensor->power->warmup_ms;
+
+    SensorTask_PowerSet(sensor, true);
+    sensor->power_state = SENSOR_POWER_STATE_WARMUP;
+    // 正常情况下预热恰好在原定的采样时刻结束；上电被推迟时顺延
+    sensor->next_due_time = sensor->power_due_time;
+    if ((int32_t)(ready - sensor->next_due_time) > 0) {
+      sensor->next_due_time = ready;
+    }
+    sensor->power_due_time = ready;
+    return false;
+  }
+
+  // 按帧触发时帧可能早于预热结束，推迟到之后的帧
+  if ((int32_t)(HAL_GetTick() - sensor->power_due_time) < 0) {
+    sensor->next_due_time = sensor->power_due_time;
+    return false;
+  }
+
+  sensor->power_state = SENSOR_POWER_STATE_ON;
+  if (!SensorTask_InitializeSensor(sensor)) {
+    sensor->status = SENSOR_STATUS_INITIALIZING; // 之后按故障恢复流程重试
+    SensorTask_HandleSensorError(sensor);
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief ADC 数据块钩子 (DMA 中断)：每 SENSOR_FRAME_BLOCKS 块记录一帧
+ */
+static void SensorTask_FrameHook(uint32_t block) {
+  BaseType_t woken = pdFALSE;
+
+  if (block % SENSOR_FRAME_BLOCKS != 0) {
+    return;
+  }
+  s_frame_us = SysClock_Micros();
+  s_frame_tick = HAL_GetTick();
+  s_frame_seq++;
+  if (s_frame_armed && sensor_task_handle != NULL) {
+    s_frame_armed = false;
+    vTaskNotifyGiveFromISR((TaskHandle_t)sensor_task_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+  }
+}
+
+/**
+ * @brief 主循环每轮开始时取出新到达的帧
+ * @details 最近一帧距今超过两帧 (ADC 未启动或 TIM2 被停止) 时不按帧触发
+ */
+static void SensorTask_FrameBegin(uint32_t tick) {
+  uint32_t seq;
+  uint32_t frame_tick;
+  uint64_t frame_us;
+
+  do {
+    seq = s_frame_seq;
+    frame_tick = s_frame_tick;
+    frame_us = s_frame_us;
+  } while (seq != s_frame_seq);
+
+  s_frame_live = SENSOR_FRAME_SYNC && seq != 0 &&
+                 (uint32_t)(tick - frame_tick) < 2U * SENSOR_FRAME_MS;
+  s_frame_pass = s_frame_live && seq != s_frame_seen;
+  s_frame_seen = seq;
+  s_pass_frame_tick = frame_tick;
+  s_pass_frame_us = frame_us;
+}
+
+/**
+ * @brief 传感器的下一轮采样是否要等到帧时刻才开始
+ * @details 只有在线、未在转换中且未断电的实例按帧触发；初始化、重试与
+ *          取回结果仍按各自的截止时间处理
+ */
+static bool SensorTask_FrameGated(const SensorInstance_t *sensor) {
+  return s_frame_live && !sensor->is_remote &&
+         sensor->status == SENSOR_STATUS_ONLINE && !sensor->is_converting &&
+         sensor->power_state != SENSOR_POWER_STATE_OFF;
+}
+
+/**
+ * @brief 开始一轮采样：记录计划时间点与转换开始时刻
+ * @details 按帧触发时两者都取帧时刻，同一帧中的样本共用一个时间戳，
+ *          下一轮的截止时间也从帧时刻推进
+ */
+static void SensorTask_CycleStart(SensorInstance_t *sensor) {
+  if (s_frame_pass && SensorTask_FrameGated(sensor)) {
+    sensor->cycle_due_time = s_pass_frame_tick;
+    sensor->conversion_start_us = s_pass_frame_us;
+  } else {
+    sensor->cycle_due_time = sensor->next_due_time;
+    sensor->conversion_start_us = SysClock_Micros();
   }
 }
 
@@ -313,7 +946,7 @@ static bool SensorTask_InitializeSensor(SensorInstance_t *sensor) {
     return false;
   }
 
-  SensorCallbacks_t *callbacks = &g_sensor_manager.callbacks[sensor->type];
+  const SensorCallbacks_t *callbacks = SensorTask_Callbacks(sensor);
 
   if (callbacks->init_func != NULL) {
     return callbacks->init_func(sensor);
@@ -323,326 +956,887 @@ static bool SensorTask_InitializeSensor(SensorInstance_t *sensor) {
 }
 
 /**
- * @brief 更新传感器数据，并记录历史和统计信息
+ * @brief 阻塞读取传感器数据，并记录历史和统计信息
  */
 static bool SensorTask_UpdateSensor(SensorInstance_t *sensor) {
   if (sensor == NULL || sensor->type >= SENSOR_TYPE_MAX) {
     return false;
   }
 
-  SensorCallbacks_t *callbacks = &g_sensor_manager.callbacks[sensor->type];
+  const SensorCallbacks_t *callbacks = SensorTask_Callbacks(sensor);
+  bool result = false;
 
   if (callbacks->read_func != NULL) {
-    // 调用底层驱动的读取函数
-    bool result = callbacks->read_func(sensor);
-
-    if (result) {
-      if (osMutexWait(g_sensor_manager.global_data_mutex, osWaitForever) ==
-          osOK) {
-        sensor->data.timestamp = HAL_GetTick();
-        sensor->data.is_valid = true;
-        sensor->error_count = 0;
-
-        // [NEW] --- 开始更新历史和统计数据 ---
-
-        // 1. 提取当前读数 (统一为 float 类型处理)
-        float primary_value = 0.0f;
-        float secondary_value = 0.0f;
-        switch (sensor->type) {
-        case SENSOR_TYPE_SHT30:
-          primary_value = sensor->data.values.sht30.temp;
-          secondary_value = sensor->data.values.sht30.humi;
-          break;
-        case SENSOR_TYPE_GY30:
-          primary_value = sensor->data.values.gy30.lux;
-          break;
-        case SENSOR_TYPE_SMOKE:
-          primary_value = (float)sensor->data.values.smoke.ppm;
-          break;
-        default:
-          break;
-        }
+    PROF_BEGIN(PROF_ZONE_SENSOR_UPDATE);
+    // 调用底层驱动的读取函数 (各传感器单独计时)
+    uint32_t read_start = PROF_NOW();
+    memset(sensor->data.quality, SENSOR_QUALITY_OK, sizeof(sensor->data.quality));
+    bool read_ok = callbacks->read_func(sensor);
+    PROF_RECORD(PROF_ZONE_READ_GY30 + (sensor->type - SENSOR_TYPE_GY30),
+                read_start);
+
+    result = SensorTask_CommitSample(sensor, read_ok);
+    PROF_END(PROF_ZONE_SENSOR_UPDATE);
+  }
 
-        // 2. 更新历史数据 (循环缓冲区)
-        sensor->history[sensor->history_head] = primary_value;
-        if (sensor->type == SENSOR_TYPE_SHT30) {
-          sensor->secondary_history[sensor->history_head] = secondary_value;
-        }
-        sensor->history_head = (sensor->history_head + 1) % SENSOR_HISTORY_SIZE;
-        if (sensor->history_count < SENSOR_HISTORY_SIZE) {
-          sensor->history_count++;
-        }
+  return result;
+}
 
-        // 3. 更新统计数据
-        if (sensor->history_count == 1) { // 如果是第一个数据点
-          sensor->stats.min = primary_value;
-          sensor->stats.max = primary_value;
-          sensor->stats.avg = primary_value;
-          if (sensor->type == SENSOR_TYPE_SHT30) { // SHT30有第二组数据
-            sensor->secondary_stats.min = secondary_value;
-            sensor->secondary_stats.max = secondary_value;
-            sensor->secondary_stats.avg = secondary_value;
-          }
-        } else {
-          // 更新最大/最小值
-          if (primary_value < sensor->stats.min)
-            sensor->stats.min = primary_value;
-          if (primary_value > sensor->stats.max)
-            sensor->stats.max = primary_value;
-          if (sensor->type == SENSOR_TYPE_SHT30) {
-            if (secondary_value < sensor->secondary_stats.min)
-              sensor->secondary_stats.min = secondary_value;
-            if (secondary_value > sensor->secondary_stats.max)
-              sensor->secondary_stats.max = secondary_value;
-          }
+/**
+ * @brief 提交一次读取结果：记录历史和统计信息，并通过顺序锁发布
+ * @param result 驱动是否已把有效数据写入 sensor->data
+ */
+static bool SensorTask_CommitSample(SensorInstance_t *sensor, bool result) {
+  float values[SENSOR_MAX_CHANNELS] = {0.0f};
+  float raw[SENSOR_MAX_CHANNELS] = {0.0f};
+  uint8_t n = sensor->channel_count;
+  uint8_t rejected = 0;
+
+  SensorTask_WriteBegin(sensor);
+  if (result) {
+    // 以转换开始时刻为样本时间，不含总线传输与转换等待的延迟
+    sensor->data.timestamp_us = sensor->conversion_start_us;
+    sensor->data.timestamp = (uint32_t)(sensor->conversion_start_us / 1000U);
+    sensor->data.is_valid = true;
+    sensor->error_count = 0;
 
-          // 重新计算平均值 (对于少量数据，直接重算最准确)
-          int start_idx = (sensor->history_head - sensor->history_count +
-                           SENSOR_HISTORY_SIZE) %
-                          SENSOR_HISTORY_SIZE;
-          float p_sum = 0.0f, p_min = sensor->history[start_idx],
-                p_max = sensor->history[start_idx];
-          float s_sum = 0.0f, s_min = 0.0f, s_max = 0.0f;
-          if (sensor->type == SENSOR_TYPE_SHT30) {
-            s_min = sensor->secondary_history[start_idx];
-            s_max = sensor->secondary_history[start_idx];
-          }
+    // [NEW] --- 开始更新历史和统计数据 ---
 
-          for (int i = 0; i < sensor->history_count; i++) {
-            int read_idx = (start_idx + i) % SENSOR_HISTORY_SIZE;
-            float p_val = sensor->history[read_idx];
-            p_sum += p_val;
-            if (p_val < p_min)
-              p_min = p_val;
-            if (p_val > p_max)
-              p_max = p_val;
-
-            if (sensor->type == SENSOR_TYPE_SHT30) {
-              float s_val = sensor->secondary_history[read_idx];
-              s_sum += s_val;
-              if (s_val < s_min)
-                s_min = s_val;
-              if (s_val > s_max)
-                s_max = s_val;
-            }
-          }
+    // 1. 按通道表提取当前读数 (统一为 float 类型处理)
+    for (uint8_t ch = 0; ch < n; ch++) {
+      values[ch] = SensorChannel_Value(&sensor->channels[ch], &sensor->data);
+      raw[ch] = values[ch];
+    }
 
-          // 更新所有局部统计值和平均值
-          sensor->stats.local_min = p_min;
-          sensor->stats.local_max = p_max;
-          sensor->stats.local_avg = p_sum / sensor->history_count;
-          sensor->stats.avg =
-              sensor->stats.local_avg; // 全局平均值也更新为局部平均值
-
-          if (sensor->type == SENSOR_TYPE_SHT30) {
-            sensor->secondary_stats.local_min = s_min;
-            sensor->secondary_stats.local_max = s_max;
-            sensor->secondary_stats.local_avg = s_sum / sensor->history_count;
-            sensor->secondary_stats.avg = sensor->secondary_stats.local_avg;
-          }
-        }
-        osMutexRelease(g_sensor_manager.global_data_mutex);
-      } // end if(osMutexWait
+    // 质量检查：滤波后的值写回样本，剔除的通道保持上一个有效值
+    rejected = SensorQuality_Check(sensor->handle, values, sensor->data.quality,
+                                   n);
+    // 通道滤波链 (中值/低通/滑动平均)，剔除的通道不进入滤波器
+    SensorFilter_Apply(sensor->handle, values, rejected, n);
+    for (uint8_t ch = 0; ch < n; ch++) {
+      if (values[ch] != raw[ch]) {
+        SensorChannel_SetValue(&sensor->channels[ch], &sensor->data,
+                               values[ch]);
+      }
+    }
+
+    // 2. 增量更新统计 (须在覆盖历史槽位之前推入，以便淘汰旧值)
+    uint16_t slot = sensor->history_head;
+    for (uint8_t ch = 0; ch < n; ch++) {
+      if (rejected & (1U << ch)) {
+        SensorStats_Skip(&sensor->engine[ch], sensor->history[ch], slot);
+      } else {
+        SensorStats_Push(&sensor->engine[ch], sensor->history[ch], slot,
+                         values[ch]);
+      }
+    }
+
+    // 3. 更新历史数据 (循环缓冲区)
+    for (uint8_t ch = 0; ch < n; ch++) {
+      sensor->history[ch][slot] = values[ch];
+      sensor->chart_history[ch][slot] = SensorTask_FixedValue(
+          sensor->channels[ch].fixed_scale, values[ch]);
+      sensor->history_quality[ch][slot] = sensor->data.quality[ch];
+    }
+    sensor->history_head = (slot + 1) % SENSOR_HISTORY_SIZE;
+    if (sensor->history_count < SENSOR_HISTORY_SIZE) {
+      sensor->history_count++;
+    }
+
+    // 4. 分钟/小时级汇总
+    for (uint8_t ch = 0; ch < n; ch++) {
+      if (!(rejected & (1U << ch))) {
+        SensorRollup_Push(&sensor->rollup[ch], sensor->data.timestamp_us,
+                          values[ch]);
+      }
+    }
 
-    } // end if(result)
+    // 压缩的原始历史 (剔除的通道记为缺失)
+    SensorSeries_Append(&sensor->series,
+                        (uint32_t)(sensor->data.timestamp_us / 1000U), values,
+                        rejected);
 
-    return result;
+    // 5. 导出统计结果
+    for (uint8_t ch = 0; ch < n; ch++) {
+      SensorStats_Export(&sensor->engine[ch], sensor->history[ch],
+                         &sensor->stats[ch]);
+    }
+  } // end if(result)
+
+  // 发布数据副本（读取失败时同样发布，以便读者看到 is_valid = false）
+  sensor->shared_data = sensor->data;
+  SensorTask_WriteEnd(sensor);
+
+  // 告警规则与通风曲线在发布之后评估，设备动作不延长写入窗口
+  if (result) {
+    SensorTask_RetainSave(sensor);
+    // 捕获原始读数，回放时重新经过质量检查
+    SensorReplay_Capture(sensor->handle, sensor->data.timestamp_us, raw, n);
+    SensorAlarm_Process(sensor->handle, sensor->data.timestamp_us, values, n);
+    SensorVent_Process(sensor->handle, values, n);
+    sensor->sample_interval_ms =
+        SensorAdapt_Process(sensor->handle, sensor->data.timestamp_us, values,
+                            n, sensor->update_interval_ms);
+    if (SensorAnomaly_Process(sensor->handle, values, n)) {
+      SensorTask_NotifyEvent(SENSOR_EVENT_ANOMALY, sensor, &sensor->data,
+                             sensor->status);
+    }
   }
 
-  return false;
+  return result;
 }
 
 /**
- * @brief 获取指定传感器的统计数据
- * @param type 传感器类型
- * @param stats 输出统计数据的指针
- * @return true: 成功, false: 失败或无数据
+ * @brief 替换实例的驱动回调
  */
-bool SensorTask_GetStats(SensorType_t type, SensorStats_t *stats) {
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      stats == NULL) {
+bool SensorTask_OverrideCallbacks(SensorHandle_t handle,
+                                  const SensorCallbacks_t *callbacks) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+
+  if (sensor == NULL || (callbacks != NULL && (callbacks->init_func == NULL ||
+                                               callbacks->read_func == NULL))) {
     return false;
   }
+  // 指针写入是原子的，传感器任务下一次取回调时生效
+  g_sensor_manager.override[sensor - g_sensor_manager.sensors] = callbacks;
+  SensorTask_Wakeup();
+  return true;
+}
+
+/**
+ * @brief 获取传感器的通道表
+ */
+uint8_t SensorTask_GetChannels(SensorHandle_t handle,
+                               const SensorChannelDesc_t **channels) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  if (sensor == NULL) {
+    return 0;
+  }
+  if (channels != NULL) {
+    *channels = sensor->channels;
+  }
+  return sensor->channel_count;
+}
 
-  SensorInstance_t *sensor = &g_sensor_manager.sensors[type];
+/**
+ * @brief 按通道描述从数据中取出数值
+ */
+float SensorChannel_Value(const SensorChannelDesc_t *channel,
+                          const SensorData_t *data) {
+  const uint8_t *p = (const uint8_t *)data + channel->offset;
 
-  // 确保传感器已启用且至少有一个数据点
-  if (sensor->is_enabled && sensor->history_count > 0) {
-    // TODO: 考虑线程安全，可以加锁
-    if (osMutexWait(g_sensor_manager.global_data_mutex, 100) == osOK) {
-      *stats = sensor->stats;
-      osMutexRelease(g_sensor_manager.global_data_mutex);
-      return true;
-    }
+  if (channel->kind == SENSOR_CHANNEL_KIND_INT) {
+    return (float)*(const int *)p;
   }
+  return *(const float *)p;
+}
 
-  return false;
+/**
+ * @brief 按通道描述把数值写入数据
+ */
+void SensorChannel_SetValue(const SensorChannelDesc_t *channel,
+                            SensorData_t *data, float value) {
+  uint8_t *p = (uint8_t *)data + channel->offset;
+
+  if (channel->kind == SENSOR_CHANNEL_KIND_INT) {
+    *(int *)p = (int)(value + (value >= 0.0f ? 0.5f : -0.5f));
+    return;
+  }
+  *(float *)p = value;
 }
 
 /**
- * @brief 获取指定传感器的次要统计数据 (如湿度)
- * @param type 传感器类型
- * @param stats 输出统计数据的指针
- * @return true: 成功, false: 失败或无数据
+ * @brief 按名称查找通道
  */
-bool SensorTask_GetSecondaryStats(SensorType_t type, SensorStats_t *stats) {
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      stats == NULL) {
-    return false;
+int8_t SensorTask_FindChannel(SensorHandle_t handle, const char *name) {
+  const SensorChannelDesc_t *channels;
+  uint8_t n = SensorTask_GetChannels(handle, &channels);
+
+  for (uint8_t ch = 0; ch < n; ch++) {
+    if (strcmp(channels[ch].name, name) == 0) {
+      return (int8_t)ch;
+    }
   }
+  return -1;
+}
 
-  // 只有SHT30有次要统计数据
-  if (type != SENSOR_TYPE_SHT30) {
+/**
+ * @brief 获取指定通道的统计数据
+ */
+bool SensorTask_GetChannelStats(SensorHandle_t handle, uint8_t channel,
+                                SensorStats_t *stats) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+
+  if (sensor == NULL || stats == NULL || !sensor->is_enabled ||
+      channel >= sensor->channel_count) {
     return false;
   }
 
-  SensorInstance_t *sensor = &g_sensor_manager.sensors[type];
+  uint32_t seq;
+  uint16_t count;
+  do {
+    seq = SensorTask_ReadBegin(sensor);
+    count = sensor->history_count;
+    *stats = sensor->stats[channel];
+  } while (SensorTask_ReadRetry(sensor, seq));
+
+  // 至少有一个数据点才有意义
+  return count > 0;
+}
 
-  // 确保传感器已启用且至少有一个数据点
-  if (sensor->is_enabled && sensor->history_count > 0) {
-    // 加锁读取次要统计数据
-    if (osMutexWait(g_sensor_manager.global_data_mutex, 100) == osOK) {
-      *stats = sensor->secondary_stats;
-      osMutexRelease(g_sensor_manager.global_data_mutex);
-      return true;
+bool SensorTask_GetStats(SensorHandle_t handle, SensorStats_t *stats) {
+  return SensorTask_GetChannelStats(handle, 0, stats);
+}
+
+bool SensorTask_GetSecondaryStats(SensorHandle_t handle, SensorStats_t *stats) {
+  return SensorTask_GetChannelStats(handle, 1, stats);
+}
+
+/**
+ * @brief 一次取得全部实例的一致快照
+ * @details 全局序号与各实例的序号同时递增，只有传感器任务写入；拷贝前后
+ *          全局序号相同 (且为偶数) 说明期间没有任何实例被写入。
+ *          读者优先级更高，写入过程中被抢占时同 SensorTask_ReadBegin 让出 1 个 tick。
+ */
+uint32_t SensorTask_GetSnapshot(SensorSystemSnapshot_t *snap) {
+  struct {
+    SensorHandle_t handle;
+    SensorStatus_t status;
+    bool is_enabled;
+    uint32_t version;
+  } prev[SENSOR_MAX_INSTANCES];
+  uint8_t prev_count;
+  uint32_t generation;
+  uint32_t changed = 0;
+
+  if (snap == NULL) {
+    return 0;
+  }
+  prev_count = snap->count;
+  for (uint8_t i = 0; i < prev_count && i < SENSOR_MAX_INSTANCES; i++) {
+    prev[i].handle = snap->entry[i].handle;
+    prev[i].status = snap->entry[i].status;
+    prev[i].is_enabled = snap->entry[i].is_enabled;
+    prev[i].version = snap->entry[i].version;
+  }
+
+  do {
+    while ((generation = g_sensor_manager.commit_seq) & 1u) {
+      osDelay(1);
+    }
+    __DMB();
+    snap->count = g_sensor_manager.sensor_count;
+    for (uint8_t i = 0; i < snap->count; i++) {
+      const SensorInstance_t *sensor = &g_sensor_manager.sensors[i];
+      SensorSnapshotEntry_t *e = &snap->entry[i];
+
+      e->handle = sensor->handle;
+      e->status = sensor->status; // 状态为单个字，不受顺序锁保护
+      e->is_enabled = sensor->is_enabled;
+      e->channel_count = sensor->channel_count;
+      e->history_count = sensor->history_count;
+      e->version = sensor->seq;
+      e->data = sensor->shared_data;
+      memcpy(e->stats, sensor->stats, sizeof(e->stats));
+    }
+    __DMB();
+  } while (g_sensor_manager.commit_seq != generation);
+  snap->generation = generation;
+
+  for (uint8_t i = 0; i < snap->count; i++) {
+    const SensorSnapshotEntry_t *e = &snap->entry[i];
+
+    if (i >= prev_count || e->handle != prev[i].handle ||
+        e->version != prev[i].version || e->status != prev[i].status ||
+        e->is_enabled != prev[i].is_enabled) {
+      changed |= 1UL << i;
     }
   }
+  snap->changed = changed;
+  return changed;
+}
 
-  return false;
+/**
+ * @brief 在快照中查找实例
+ */
+const SensorSnapshotEntry_t *
+SensorTask_SnapshotFind(const SensorSystemSnapshot_t *snap,
+                        SensorHandle_t handle) {
+  if (snap == NULL) {
+    return NULL;
+  }
+  for (uint8_t i = 0; i < snap->count; i++) {
+    if (snap->entry[i].handle == handle) {
+      return &snap->entry[i];
+    }
+  }
+  return NULL;
 }
 
 /**
- * @brief 获取指定传感器的主要历史数据 (已按时间排好序)
- * @param type 传感器类型
- * @param history_data 输出一个指向有序历史数据的指针的指针
- * @return uint16_t 有效的历史数据点数量
+ * @brief 获取历史环形缓冲区的原地视图
+ * @details 缓冲区未满时数据从下标 0 开始只有一段；已满时最旧的数据位于
+ *          history_head，第一段为 [head, SIZE)，第二段为 [0, head)。
  */
-uint16_t SensorTask_GetPrimaryHistory(SensorType_t type,
-                                      const float **history_data) {
-  // 使用静态数组作为临时缓冲区，避免在栈上分配大数组
-  static float ordered_primary_history[SENSOR_HISTORY_SIZE];
+uint16_t SensorTask_GetHistorySpan(SensorHandle_t handle, uint8_t channel,
+                                   SensorHistorySpan_t *span) {
+  if (span == NULL) {
+    return 0;
+  }
+  memset(span, 0, sizeof(SensorHistorySpan_t));
+  span->sensor = SENSOR_HANDLE_INVALID;
 
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      history_data == NULL) {
-    *history_data = NULL;
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  if (sensor == NULL || !sensor->is_enabled ||
+      channel >= sensor->channel_count) {
     return 0;
   }
 
-  SensorInstance_t *sensor = &g_sensor_manager.sensors[type];
+  const float *ring = sensor->history[channel];
+  const int16_t *fixed = sensor->chart_history[channel];
+  const uint8_t *quality = sensor->history_quality[channel];
+  uint16_t count;
+  uint16_t head;
+  uint32_t seq;
+  do {
+    seq = SensorTask_ReadBegin(sensor);
+    count = sensor->history_count;
+    head = sensor->history_head;
+  } while (SensorTask_ReadRetry(sensor, seq));
+
+  span->version = seq;
+  span->sensor = sensor->handle;
+  span->channel = channel;
+  if (count < SENSOR_HISTORY_SIZE) {
+    span->seg[0] = ring;
+    span->fixed[0] = fixed;
+    span->quality[0] = quality;
+    span->len[0] = count;
+  } else {
+    span->seg[0] = &ring[head];
+    span->fixed[0] = &fixed[head];
+    span->quality[0] = &quality[head];
+    span->len[0] = SENSOR_HISTORY_SIZE - head;
+    span->seg[1] = ring;
+    span->fixed[1] = fixed;
+    span->quality[1] = quality;
+    span->len[1] = head;
+  }
+  return count;
+}
 
-  if (sensor->is_enabled && sensor->history_count > 0) {
-    // 加锁读取历史数据
-    if (osMutexWait(g_sensor_manager.global_data_mutex, 100) == osOK) {
-      // --- 核心逻辑：将循环缓冲区的数据“展开”为按时间排序的线性数组 ---
-      // 缓冲区未满：从索引0开始读取 / 缓冲区已满：从 history_head
-      // 的下一个位置开始（最旧的数据）
-      int read_idx = (sensor->history_count < SENSOR_HISTORY_SIZE)
-                         ? 0
-                         : sensor->history_head;
+/**
+ * @brief 检查视图取得之后是否有新样本写入
+ */
+bool SensorTask_HistorySpanValid(const SensorHistorySpan_t *span) {
+  const SensorInstance_t *sensor;
 
-      // 按时间顺序（从旧到新）复制数据
-      for (int i = 0; i < sensor->history_count; i++) {
-        ordered_primary_history[i] = sensor->history[read_idx];
-        read_idx = (read_idx + 1) % SENSOR_HISTORY_SIZE;
-      }
-      osMutexRelease(g_sensor_manager.global_data_mutex);
-      *history_data = ordered_primary_history;
-      return sensor->history_count;
-    }
+  if (span == NULL || (sensor = SensorTask_Lookup(span->sensor)) == NULL) {
+    return false;
   }
+  return !SensorTask_ReadRetry(sensor, span->version);
+}
 
-  *history_data = NULL;
-  return 0;
+/**
+ * @brief 顺序锁写入开始（仅传感器任务调用）
+ */
+static void SensorTask_WriteBegin(SensorInstance_t *sensor) {
+  g_sensor_manager.commit_seq++;
+  sensor->seq++; // 变为奇数
+  __DMB();
 }
+
 /**
- * @brief 获取指定传感器的第二组历史数据 (已按时间排好序)
- * @details 主要用于获取SHT30的湿度历史数据。
- * @param type 传感器类型
- * @param history_data 输出一个指向有序历史数据的指针的指针
- * @return uint16_t 有效的历史数据点数量
+ * @brief 顺序锁写入结束
  */
-uint16_t SensorTask_GetSecondaryHistory(SensorType_t type,
-                                        const float **history_data) {
-  static float ordered_secondary_history[SENSOR_HISTORY_SIZE];
+static void SensorTask_WriteEnd(SensorInstance_t *sensor) {
+  __DMB();
+  sensor->seq++; // 恢复为偶数
+  g_sensor_manager.commit_seq++;
+}
+
+/**
+ * @brief 顺序锁读取开始，返回读到的偶数序号
+ * @details 读者(如 LVGL 任务)优先级高于传感器任务，若恰好在写入过程中
+ *          抢占了写者，原地自旋永远等不到写者完成，因此让出 1 个 tick。
+ */
+static uint32_t SensorTask_ReadBegin(const SensorInstance_t *sensor) {
+  uint32_t seq;
+
+  while ((seq = sensor->seq) & 1u) {
+    osDelay(1);
+  }
+  __DMB();
+  return seq;
+}
+
+/**
+ * @brief 顺序锁读取结束，期间有写入发生则返回 true 表示需要重试
+ */
+static bool SensorTask_ReadRetry(const SensorInstance_t *sensor, uint32_t seq) {
+  __DMB();
+  return sensor->seq != seq;
+}
 
-  if (!g_sensor_manager.is_initialized || type >= SENSOR_TYPE_MAX ||
-      history_data == NULL) {
-    *history_data = NULL;
+/**
+ * @brief 获取分钟/小时级汇总历史
+ */
+uint16_t SensorTask_GetRollupHistory(SensorHandle_t handle, uint8_t channel,
+                                     SensorTier_t tier,
+                                     SensorRollupPoint_t *out,
+                                     uint16_t max_points) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+
+  if (sensor == NULL || out == NULL || !sensor->is_enabled ||
+      channel >= sensor->channel_count) {
     return 0;
   }
+  const SensorRollup_t *rollup = &sensor->rollup[channel];
+
+  uint32_t seq;
+  uint16_t count;
+  do {
+    seq = SensorTask_ReadBegin(sensor);
+    count = SensorRollup_Read(rollup, tier, out, max_points);
+  } while (SensorTask_ReadRetry(sensor, seq));
+
+  return count;
+}
+
+/**
+ * @brief 获取汇总历史最新封存桶之后的绝对桶号
+ */
+uint32_t SensorTask_GetRollupEnd(SensorHandle_t handle, uint8_t channel,
+                                 SensorTier_t tier) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  uint32_t seq, end;
 
-  // 只有SHT30传感器有第二组历史数据
-  if (type != SENSOR_TYPE_SHT30) {
-    *history_data = NULL;
+  if (sensor == NULL || !sensor->is_enabled ||
+      channel >= sensor->channel_count) {
     return 0;
   }
+  do {
+    seq = SensorTask_ReadBegin(sensor);
+    end = SensorRollup_End(&sensor->rollup[channel], tier);
+  } while (SensorTask_ReadRetry(sensor, seq));
 
-  SensorInstance_t *sensor = &g_sensor_manager.sensors[type];
+  return end;
+}
 
-  if (sensor->is_enabled && sensor->history_count > 0) {
-    // 加锁读取次要历史数据
-    if (osMutexWait(g_sensor_manager.global_data_mutex, 100) == osOK) {
-      // 缓冲区未满：从索引0开始读取 / 缓冲区已满：从 history_head
-      // 的下一个位置开始（最旧的数据）
-      int read_idx = (sensor->history_count < SENSOR_HISTORY_SIZE)
-                         ? 0
-                         : sensor->history_head;
+/**
+ * @brief 获取最近一段时间的原始历史
+ */
+uint16_t SensorTask_GetRecentHistory(SensorHandle_t handle, uint8_t channel,
+                                     uint32_t window_ms, int16_t *out,
+                                     uint16_t buckets) {
+  SensorInstance_t *sensor = SensorTask_Lookup(handle);
+  uint32_t seq;
+  uint16_t filled;
+
+  if (sensor == NULL || out == NULL || !sensor->is_enabled ||
+      channel >= sensor->channel_count) {
+    return 0;
+  }
+  do {
+    seq = SensorTask_ReadBegin(sensor);
+    filled = SensorSeries_Resample(&sensor->series, channel, window_ms, out,
+                                   buckets);
+  } while (SensorTask_ReadRetry(sensor, seq));
 
-      // 按时间顺序（从旧到新）复制数据
-      for (int i = 0; i < sensor->history_count; i++) {
-        ordered_secondary_history[i] = sensor->secondary_history[read_idx];
-        read_idx = (read_idx + 1) % SENSOR_HISTORY_SIZE;
-      }
+  return filled;
+}
+
+/**
+ * @brief 通道定点数据的缩放系数
+ */
+float SensorTask_FixedScale(SensorHandle_t handle, uint8_t channel) {
+  const SensorChannelDesc_t *channels;
+
+  if (channel >= SensorTask_GetChannels(handle, &channels)) {
+    return 1.0f;
+  }
+  return channels[channel].fixed_scale;
+}
+
+/**
+ * @brief 实际值 -> 定点值
+ */
+int16_t SensorTask_ToFixed(SensorHandle_t handle, uint8_t channel, float value) {
+  return SensorTask_FixedValue(SensorTask_FixedScale(handle, channel), value);
+}
+
+/**
+ * @brief 按缩放系数换算定点值 (四舍五入并限幅)
+ */
+static int16_t SensorTask_FixedValue(float scale, float value) {
+  float v = value * scale;
+  v += (v >= 0.0f) ? 0.5f : -0.5f;
+  if (v > (float)(INT16_MAX - 1))
+    return INT16_MAX - 1;
+  if (v < (float)-INT16_MAX)
+    return -INT16_MAX;
+  return (int16_t)v;
+}
+
+/**
+ * @brief 应用新发布的运行时配置
+ * @details 在传感器任务中、两轮采样之间执行，采样与告警评估不会看到
+ *          一半新一半旧的设置。告警规则直接引用配置中的规则表 (在下一次
+ *          取得新配置之前一直有效)，重新加载时各规则的状态清零。
+ */
+static void SensorTask_ApplyConfig(void) {
+  const RuntimeConfig_t *cfg = RuntimeConfig_Poll(s_config_sub);
+
+  if (cfg == NULL) {
+    return;
+  }
+  for (uint8_t i = 0; i < g_sensor_manager.sensor_count; i++) {
+    SensorInstance_t *sensor = &g_sensor_manager.sensors[i];
+    if (cfg->changed & RUNTIME_CONFIG_CHG_INTERVAL(sensor->type)) {
+      SensorTask_SetUpdateInterval(sensor->handle,
+                                   cfg->interval_ms[sensor->type]);
+    }
+  }
+  if (cfg->changed & RUNTIME_CONFIG_CHG_ALARMS) {
+    SensorAlarm_SetRules(cfg->alarm_rules, cfg->alarm_count);
+  }
+}
+
+/**
+ * @brief 保存实例的汇总与压缩历史，供热启动恢复
+ * @details 只有传感器任务写历史，拷贝无需读者锁。先清除魔数再改写，
+ *          拷贝中途复位时记录无效；每次提交约 2 KB 的拷贝与 CRC。
+ */
+static void SensorTask_RetainSave(const SensorInstance_t *sensor) {
+  SensorRetained_t *r = &s_retained[sensor - g_sensor_manager.sensors];
+
+  r->magic = 0;
+  __DMB();
+  r->type = (uint8_t)sensor->type;
+  r->index = sensor->index;
+  r->channel_count = sensor->channel_count;
+  memcpy(r->rollup, sensor->rollup, sizeof(r->rollup));
+  r->series = sensor->series;
+  r->crc = CRC32_Compute(&r->type, sizeof(SensorRetained_t) -
+                                       offsetof(SensorRetained_t, type));
+  __DMB();
+  r->magic = SENSOR_RETAIN_MAGIC;
+}
+
+/**
+ * @brief 热启动时恢复实例的汇总与压缩历史 (注册时调用)
+ * @details 注册顺序可能与上次不同，按类型与序号查找；通道数或定点系数
+ *          不一致 (固件已更新) 时放弃。恢复后把时间接到当前时刻。
+ */
+static bool SensorTask_RetainRestore(SensorInstance_t *sensor) {
+  if (!WarmStart_IsValid()) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < SENSOR_MAX_INSTANCES; i++) {
+    const SensorRetained_t *r = &s_retained[i];
+    bool match = r->magic == SENSOR_RETAIN_MAGIC &&
+                 r->type == (uint8_t)sensor->type &&
+                 r->index == sensor->index &&
+                 r->channel_count == sensor->channel_count &&
+                 r->series.channel_count == sensor->series.channel_count;
+
+    for (uint8_t ch = 0; match && ch < sensor->channel_count; ch++) {
+      match = r->rollup[ch].scale == sensor->rollup[ch].scale &&
+              r->series.scale[ch] == sensor->series.scale[ch];
+    }
+    if (!match ||
+        r->crc != CRC32_Compute(&r->type, sizeof(SensorRetained_t) -
+                                              offsetof(SensorRetained_t, type))) {
+      continue;
+    }
+
+    uint64_t now_us = SysClock_Micros();
+    memcpy(sensor->rollup, r->rollup, sizeof(sensor->rollup));
+    sensor->series = r->series;
+    for (uint8_t ch = 0; ch < sensor->channel_count; ch++) {
+      SensorRollup_Rebase(&sensor->rollup[ch], now_us);
+    }
+    SensorSeries_Rebase(&sensor->series, (uint32_t)(now_us / 1000U));
+    return true;
+  }
+  return false;
+}
+
+/**
+ * @brief 句柄 -> 实例
+ * @return 未注册返回 NULL
+ */
+static SensorInstance_t *SensorTask_Lookup(SensorHandle_t handle) {
+  SensorType_t type = SENSOR_HANDLE_TYPE(handle);
+  uint8_t index = SENSOR_HANDLE_INDEX(handle);
+  uint8_t slot;
+
+  if (!g_sensor_manager.is_initialized || type <= SENSOR_TYPE_NONE ||
+      type >= SENSOR_TYPE_MAX || index >= SENSOR_MAX_PER_TYPE) {
+    return NULL;
+  }
+  slot = g_sensor_manager.slot[type][index];
+  if (slot >= g_sensor_manager.sensor_count) {
+    return NULL;
+  }
+  return &g_sensor_manager.sensors[slot];
+}
+
+/**
+ * @brief 实例的回调函数 (与实例同下标，被替换时返回替换的回调)
+ */
+static const SensorCallbacks_t *SensorTask_Callbacks(const SensorInstance_t *sensor) {
+  uint8_t slot = (uint8_t)(sensor - g_sensor_manager.sensors);
+  const SensorCallbacks_t *override = g_sensor_manager.override[slot];
+
+  return override != NULL ? override : g_sensor_manager.callbacks[slot];
+}
 
-      osMutexRelease(g_sensor_manager.global_data_mutex);
-      *history_data = ordered_secondary_history;
-      return sensor->history_count;
+/**
+ * @brief 按截止时间对调度顺序做插入排序 (仅传感器任务调用)
+ * @details 每轮只有刚处理过的少数实例改变截止时间，序列基本有序，
+ *          插入排序接近 O(n)；截止时间用有符号差比较，跨越 tick 回绕仍正确。
+ */
+static void SensorTask_SortByDeadline(void) {
+  uint8_t *order = g_sensor_manager.order;
+  uint8_t count = g_sensor_manager.sensor_count;
+
+  for (uint8_t i = 1; i < count; i++) {
+    uint8_t slot = order[i];
+    uint32_t due = g_sensor_manager.sensors[slot].next_due_time;
+    uint8_t j = i;
+
+    while (j > 0 &&
+           (int32_t)(g_sensor_manager.sensors[order[j - 1]].next_due_time -
+                     due) > 0) {
+      order[j] = order[j - 1];
+      j--;
     }
+    order[j] = slot;
   }
+}
 
-  *history_data = NULL;
-  return 0;
+/**
+ * @brief 计算下一次重试的退避间隔 (含抖动)
+ * @details 缺失前从 SENSOR_RETRY_INTERVAL_MS 起逐次加倍，不超过
+ *          SENSOR_REPROBE_MIN_MS；判定缺失后从 SENSOR_REPROBE_MIN_MS 起逐次加倍，
+ *          不超过 SENSOR_REPROBE_MAX_MS。抖动使用 xorshift32，首次调用时以
+ *          微秒计数播种。
+ */
+static uint32_t SensorTask_BackoffMs(const SensorInstance_t *sensor) {
+  uint32_t base = SENSOR_RETRY_INTERVAL_MS;
+  uint32_t cap = SENSOR_REPROBE_MIN_MS;
+  uint32_t shift = sensor->error_count - 1;
+  uint32_t backoff, span;
+
+  if (sensor->status == SENSOR_STATUS_ERROR) {
+    base = SENSOR_REPROBE_MIN_MS;
+    cap = SENSOR_REPROBE_MAX_MS;
+    shift = sensor->error_count - SENSOR_ERROR_ABSENT_COUNT;
+  }
+  backoff = cap;
+  if (shift < 16 && (base << shift) < cap) {
+    backoff = base << shift;
+  }
+
+  if (s_backoff_rand == 0) {
+    s_backoff_rand = (uint32_t)SysClock_Micros() | 1U;
+  }
+  s_backoff_rand ^= s_backoff_rand << 13;
+  s_backoff_rand ^= s_backoff_rand >> 17;
+  s_backoff_rand ^= s_backoff_rand << 5;
+  span = backoff * SENSOR_BACKOFF_JITTER_PCT / 100U;
+  return backoff - span + s_backoff_rand % (2U * span + 1U);
 }
 
 /**
- * @brief 处理传感器错误
+ * @brief 处理传感器错误，并按退避间隔安排下一次重试
  */
 static void SensorTask_HandleSensorError(SensorInstance_t *sensor) {
+  const SensorCallbacks_t *callbacks = SensorTask_Callbacks(sensor);
+
   sensor->error_count++;
 
-  LOG_WARN("传感器 %s 错误，错误次数: %lu", sensor->name, sensor->error_count);
+  // 已判定缺失：按指数退避安排下一次探测，不再输出日志
+  if (sensor->status == SENSOR_STATUS_ERROR) {
+    uint32_t backoff = SensorTask_BackoffMs(sensor);
+    sensor->next_due_time = HAL_GetTick() + backoff;
+    LOG_DEBUG("传感器 %s 仍未响应，%lu ms 后重新探测", sensor->name,
+              (unsigned long)backoff);
+    return;
+  }
+
+  if (sensor->error_count == 1) {
+    LOG_WARN("传感器 %s 错误", sensor->name);
+  } else {
+    LOG_DEBUG("传感器 %s 错误，错误次数: %lu", sensor->name,
+              sensor->error_count);
+  }
 
-  // 错误次数到达5次，将传感器标记为初始化中等待重新初始化
-  if (sensor->error_count == 5) {
+  // 连续失败到达重新初始化次数：先反初始化，使初始化回调真正访问设备
+  if (sensor->error_count == SENSOR_ERROR_REINIT_COUNT) {
     LOG_WARN("尝试重新初始化传感器 %s", sensor->name);
+    if (callbacks->deinit_func != NULL) {
+      callbacks->deinit_func(sensor);
+    }
+    sensor->is_converting = false;
     sensor->status = SENSOR_STATUS_INITIALIZING;
+    SensorAnomaly_Reset(sensor->handle); // 重新初始化后的读数重新学习基线
+    SensorQuality_Reset(sensor->handle);
+    SensorFilter_Reset(sensor->handle);
   }
-  // 错误次数到达10次，将传感器标记为错误状态,并禁用传感器
-  if (sensor->error_count == 10) {
-    SensorTask_DisableSensor(sensor->type);
+  // 连续失败到达缺失次数：标记为错误状态，之后只按退避间隔重新探测
+  if (sensor->error_count >= SENSOR_ERROR_ABSENT_COUNT) {
+    LOG_WARN("传感器 %s 无响应，改为每 %lu~%lu ms 重新探测", sensor->name,
+             (unsigned long)SENSOR_REPROBE_MIN_MS,
+             (unsigned long)SENSOR_REPROBE_MAX_MS);
+    if (callbacks->deinit_func != NULL) {
+      callbacks->deinit_func(sensor);
+    }
+    sensor->is_converting = false;
     sensor->status = SENSOR_STATUS_ERROR;
-    SensorTask_NotifyEvent(SENSOR_EVENT_STATUS_CHANGE, sensor->type, NULL,
+    sensor->error_count = SENSOR_ERROR_ABSENT_COUNT;
+    SensorTask_NotifyEvent(SENSOR_EVENT_STATUS_CHANGE, sensor, NULL,
                            SENSOR_STATUS_ERROR);
   }
+  sensor->next_due_time = HAL_GetTick() + SensorTask_BackoffMs(sensor);
 }
 
 /**
  * @brief 通知传感器事件
+ * @details 只记录到实例的待投递位图，由主循环在本轮处理结束后按优先级
+ *          投递 (SensorTask_FlushEvents)。同一类型尚未投递时新事件覆盖旧事件：
+ *          故障风暴中反复的状态切换只投递最后一次，记录池不会被占满。
+ *          启用/禁用可能在其他任务中调用，位图与状态在临界区内更新。
  */
 static void SensorTask_NotifyEvent(SensorEventType_t event_type,
-                                   SensorType_t sensor_type,
+                                   SensorInstance_t *sensor,
                                    const SensorData_t *data,
                                    SensorStatus_t status) {
-  if (g_event_callback != NULL) {
-    SensorEvent_t event = {
-        .event_type = event_type, .sensor_type = sensor_type, .status = status};
+  uint8_t bit = (uint8_t)(1U << event_type);
 
-    if (data != NULL) {
-      event.data = *data;
+  if (data != NULL) {
+    sensor->event_data = *data; // 只由传感器任务传入
+  }
+  taskENTER_CRITICAL();
+  if (sensor->event_pending & bit) {
+    g_sensor_manager.events_coalesced++;
+  }
+  sensor->event_pending |= bit;
+  if (event_type == SENSOR_EVENT_STATUS_CHANGE) {
+    sensor->event_status = status;
+  }
+  taskEXIT_CRITICAL();
+
+  SensorTask_Wakeup(); // 其他任务中调用时由传感器任务尽快投递
+}
+
+/**
+ * @brief 按优先级投递待投递的事件
+ * @details 先投递所有传感器的异常/错误事件，再投递数据更新，最后投递状态
+ *          变化；每轮最多投递 SENSOR_EVENT_FLUSH_BUDGET 条。数据更新距上次
+ *          投递不足 SENSOR_EVENT_DATA_WINDOW_MS 时留到窗口结束 (期间的更新
+ *          合并为最新一次)。超出预算或记录池耗尽时事件留在位图中继续合并，
+ *          稍后重新投递，不会丢失最新状态。
+ * @return 仍有事件待投递时距下次投递的等待时间 (ms)，没有时返回 -1
+ */
+static int32_t SensorTask_FlushEvents(void) {
+  static const SensorEventType_t order[] = {
+      SENSOR_EVENT_ANOMALY, SENSOR_EVENT_ERROR, SENSOR_EVENT_DATA_UPDATE,
+      SENSOR_EVENT_STATUS_CHANGE};
+  uint8_t count = g_sensor_manager.sensor_count;
+  uint8_t budget = SENSOR_EVENT_FLUSH_BUDGET;
+  int32_t wait_ms = -1;
+
+  for (uint8_t p = 0; p < sizeof(order) / sizeof(order[0]); p++) {
+    uint8_t bit = (uint8_t)(1U << order[p]);
+
+    for (uint8_t i = 0; i < count; i++) {
+      SensorInstance_t *sensor = &g_sensor_manager.sensors[i];
+      int32_t remain = 0;
+
+      if (!(sensor->event_pending & bit)) {
+        continue;
+      }
+      if (order[p] == SENSOR_EVENT_DATA_UPDATE) {
+        remain = (int32_t)(sensor->event_data_time +
+                           SENSOR_EVENT_DATA_WINDOW_MS - HAL_GetTick());
+        if (remain > SENSOR_EVENT_DATA_WINDOW_MS) {
+          remain = 0; // 上次投递已过去很久 (计数回绕)
+        }
+      }
+      if (remain <= 0) {
+        if (budget > 0 && SensorTask_PublishEvent(sensor, order[p])) {
+          budget--;
+          if (order[p] == SENSOR_EVENT_DATA_UPDATE) {
+            sensor->event_data_time = HAL_GetTick();
+          }
+          continue;
+        }
+        remain = SENSOR_EVENT_RETRY_MS;
+      }
+      if (wait_ms < 0 || remain < wait_ms) {
+        wait_ms = remain;
+      }
     }
+  }
+  return wait_ms;
+}
 
-    g_event_callback(&event);
+/**
+ * @brief 生成一条事件快照并发布到事件总线
+ * @return false 记录池耗尽，事件保持待投递
+ */
+static bool SensorTask_PublishEvent(SensorInstance_t *sensor,
+                                    SensorEventType_t event_type) {
+  // 快照直接写进事件总线的记录池，所有订阅者共享同一份，发送方永不阻塞
+  SensorSnapshot_t *snapshot = SensorEventBus_Alloc();
+  const SensorData_t *data = NULL;
+
+  if (snapshot == NULL) {
+    return false; // 记录池耗尽 (订阅者积压)，已由总线计数
+  }
+
+  snapshot->event.event_type = event_type;
+  snapshot->event.sensor_type = sensor->type;
+  snapshot->event.sensor = sensor->handle;
+  taskENTER_CRITICAL();
+  sensor->event_pending &= (uint8_t)~(1U << event_type);
+  snapshot->event.status = event_type == SENSOR_EVENT_STATUS_CHANGE
+                               ? sensor->event_status
+                               : sensor->status;
+  taskEXIT_CRITICAL();
+  if (event_type == SENSOR_EVENT_DATA_UPDATE ||
+      event_type == SENSOR_EVENT_ANOMALY) {
+    data = &sensor->event_data;
+    snapshot->event.data = *data;
+  }
+
+  // 统计数据只由本任务写入，这里在锁外读取是安全的
+  snapshot->channel_count = sensor->channel_count;
+  snapshot->anomaly = SensorAnomaly_GetMask(sensor->handle);
+  if (event_type == SENSOR_EVENT_DATA_UPDATE && sensor->history_count > 0) {
+    memcpy(snapshot->stats, sensor->stats,
+           sensor->channel_count * sizeof(SensorStats_t));
+    snapshot->has_stats = true;
   }
+
+  // 最新样本的定点值：最近一次 CommitSample 写入 head 之前的槽位
+  if (event_type == SENSOR_EVENT_DATA_UPDATE && data != NULL &&
+      data->is_valid && sensor->history_count > 0) {
+    uint16_t last =
+        (sensor->history_head + SENSOR_HISTORY_SIZE - 1) % SENSOR_HISTORY_SIZE;
+    for (uint8_t ch = 0; ch < sensor->channel_count; ch++) {
+      snapshot->fixed[ch] = sensor->chart_history[ch][last];
+    }
+  }
+
+  SensorEventBus_Publish(snapshot);
+  if (event_type == SENSOR_EVENT_DATA_UPDATE && data != NULL) {
+    SensorLatency_Record(SENSOR_LATENCY_PUBLISH, data->timestamp_us);
+  }
+  return true;
 }
 
 /**
@@ -694,6 +1888,8 @@ const char *SensorEventType_ToString(SensorEventType_t event) {
     return "STATUS_CHANGE";
   case SENSOR_EVENT_ERROR:
     return "ERROR";
+  case SENSOR_EVENT_ANOMALY:
+    return "ANOMALY";
   default:
     return "UNKNOWN_EVENT";
   }
@@ -13,7 +13,12 @@
 
 #include "cmsis_os.h"
 #include "main.h"
+#include "sensor_rollup.h"
+#include "sensor_series.h"
+#include "sensor_stats.h"
+#include "task_plan.h"
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 
@@ -23,9 +28,58 @@ extern "C" {
 
 /* --------------------------- 系统配置 --------------------------- */
 #define SENSOR_TASK_STACK_SIZE 512 // 传感器任务栈大小
-#define SENSOR_TASK_PRIORITY osPriorityBelowNormal
+#define SENSOR_TASK_PRIORITY TASK_PLAN_OS_PRIO(TASK_PRIO_SAMPLING) // 高于界面
 #define SENSOR_UPDATE_INTERVAL_MS 2000 // 默认传感器更新间隔 (2秒)
-#define SENSOR_MAX_NAME_LEN 32         // 传感器名称最大长度
+/*
+ * 故障恢复状态机 (status + error_count)：
+ *   ONLINE --读取失败--> ONLINE (重试间隔从 SENSOR_RETRY_INTERVAL_MS 起逐次加倍，
+ *                               不超过 SENSOR_REPROBE_MIN_MS)
+ *          --连续 SENSOR_ERROR_REINIT_COUNT 次--> INITIALIZING (反初始化后重新初始化)
+ *          --连续 SENSOR_ERROR_ABSENT_COUNT 次--> ERROR (判定缺失，按
+ *                               SENSOR_REPROBE_MIN_MS ~ MAX_MS 指数退避重新探测)
+ *   INITIALIZING / ERROR --初始化成功--> ONLINE (error_count 清零)
+ * 所有退避间隔叠加 ±SENSOR_BACKOFF_JITTER_PCT 的随机抖动，避免共用总线的
+ * 多个故障传感器同时重试；每轮主循环最多进行 SENSOR_RECOVERY_PER_PASS 次
+ * 恢复初始化，其余顺延，失效的传感器不会让一轮调度阻塞数百毫秒。
+ */
+#define SENSOR_RETRY_INTERVAL_MS 100   // 初始化/读取失败后的首次重试间隔 (之后逐次加倍)
+#define SENSOR_ERROR_REINIT_COUNT 5    // 连续失败多少次后重新初始化
+#define SENSOR_ERROR_ABSENT_COUNT 10   // 连续失败多少次后判定设备缺失
+#define SENSOR_REPROBE_MIN_MS 1000     // 缺失设备的首次重新探测间隔 (之后逐次加倍)
+#define SENSOR_REPROBE_MAX_MS 60000    // 缺失设备的最长重新探测间隔
+#define SENSOR_BACKOFF_JITTER_PCT 25   // 退避间隔的随机抖动幅度 (±%)
+#define SENSOR_RECOVERY_PER_PASS 1     // 每轮主循环最多进行的恢复初始化次数
+/*
+ * 采样帧：ADC 每 SENSOR_FRAME_BLOCKS 个数据块 (由 TIM2 TRGO 计时) 构成一帧，
+ * 帧中断唤醒传感器任务，截止时间落在该帧 ±半帧内的传感器在同一时刻依次
+ * 触发转换，样本共用帧的时间戳，采样间隔按帧取整。ADC 未运行 (或 TIM2
+ * 被停止) 时自动退回按各自截止时间调度。
+ */
+#ifndef SENSOR_FRAME_SYNC
+#define SENSOR_FRAME_SYNC 1            // 是否按采样帧同步触发
+#endif
+#define SENSOR_FRAME_BLOCKS 8          // 每帧的 ADC 数据块数
+#if SENSOR_FRAME_SYNC
+#define SENSOR_PHASE_STEP_MS 0         // 同一帧内触发，不再错开相位
+#else
+#define SENSOR_PHASE_STEP_MS 150       // 默认相位错开步长 (按类型递增)
+#endif
+#ifndef SENSOR_ALIGN_TO_CLOCK
+#define SENSOR_ALIGN_TO_CLOCK 1        // RTC 已校时时采样时刻对齐到墙上时钟的间隔整数倍 (加相位偏移)
+#endif
+#define SENSOR_POWERUP_SETTLE_MS 50    // 上电到首次访问传感器的最短时间
+#define SENSOR_POWER_MIN_OFF_MS 1000   // 有电源开关的传感器两次采样之间至少能关断多久才断电
+#define SENSOR_STATUS_LOG_INTERVAL_MS 10000 // 运行状态日志间隔
+#define SENSOR_EVENT_DATA_WINDOW_MS 250 // 同一传感器两次数据更新事件的最短间隔 (窗口内的更新合并为最新一次)
+#define SENSOR_EVENT_FLUSH_BUDGET 8     // 主循环每轮最多投递的事件数
+#define SENSOR_EVENT_RETRY_MS 20        // 记录池耗尽或超出预算时的重新投递间隔
+#define SENSOR_MAX_CHANNELS 2          // 单个传感器的最大通道数 (决定历史缓冲区占用)
+#ifndef SENSOR_MAX_INSTANCES
+#define SENSOR_MAX_INSTANCES 5         // 注册表容量 (所有类型的实例总数，网关模式下含远端实例)
+#endif
+#ifndef SENSOR_MAX_PER_TYPE
+#define SENSOR_MAX_PER_TYPE 2          // 同一类型的最大实例数 (如 0x44/0x45 两个 SHT30，不超过 16)
+#endif
 
 /* --------------------------- 传感器类型枚举 --------------------------- */
 typedef enum {
@@ -36,6 +90,21 @@ typedef enum {
   SENSOR_TYPE_MAX       // 传感器类型最大值
 } SensorType_t;
 
+/* --------------------------- 传感器句柄 --------------------------- */
+/**
+ * @brief 传感器实例句柄 = 类型 (低 4 位) | 同类型中的序号 (高 4 位)
+ * @details 序号 0 的句柄数值上等于类型本身，因此以 SensorType_t 调用
+ *          按句柄操作的接口时访问的是该类型的第一个实例。
+ *          句柄经 [类型][序号] 表直接换算为注册表下标 (O(1))。
+ */
+typedef uint8_t SensorHandle_t;
+
+#define SENSOR_HANDLE(type, index)                                             \
+  ((SensorHandle_t)((uint8_t)(type) | (uint8_t)((index) << 4)))
+#define SENSOR_HANDLE_TYPE(handle) ((SensorType_t)((handle) & 0x0FU))
+#define SENSOR_HANDLE_INDEX(handle) ((uint8_t)((handle) >> 4))
+#define SENSOR_HANDLE_INVALID ((SensorHandle_t)0xFFU)
+
 /* --------------------------- 传感器状态枚举 --------------------------- */
 typedef enum {
   SENSOR_STATUS_OFFLINE = 0, // 传感器离线
@@ -65,80 +134,207 @@ typedef struct {
     SensorSmokeData_t smoke; // 用于MQ-2烟雾传感器
                              //... 可以继续扩展
   } values;
-  uint32_t timestamp; // 时间戳
-  bool is_valid;      // 数据是否有效
+  uint64_t timestamp_us; // 转换开始时刻 (SysClock_Micros)
+  uint32_t timestamp;    // 转换开始时刻 (ms，与 HAL_GetTick 同一时基)
+  bool is_valid;         // 数据是否有效
+  uint8_t quality[SENSOR_MAX_CHANNELS]; // 各通道质量标志 (SENSOR_QUALITY_*，见 sensor_quality.h)
 } SensorData_t;
 
-/* --------------------------- 传感器实例结构体 --------------------------- */
-// [NEW] 1. 定义历史数据缓冲区的大小 (例如，存储最近60个点)
-#define SENSOR_HISTORY_SIZE 20
+/* --------------------------- 通道描述 --------------------------- */
+typedef enum {
+  SENSOR_CHANNEL_KIND_FLOAT = 0, // float 成员
+  SENSOR_CHANNEL_KIND_INT        // int 成员
+} SensorChannelKind_t;
 
-// [NEW] 2. 定义用于存放统计数据的结构体
+/**
+ * @brief 传感器的一个数据通道
+ * @details 驱动为每个传感器声明一张通道表 (静态存储)，注册时传入。
+ *          传感器任务按 offset 从 SensorData_t 中取出各通道的数值，
+ *          历史、统计、汇总、告警与日志都按通道下标处理，不区分传感器类型。
+ */
+typedef struct {
+  const char *name;  // 通道名 (命令行与日志使用，如 "temp")
+  const char *unit;  // 单位
+  uint16_t offset;   // 数值在 SensorData_t 中的偏移
+  uint8_t kind;      // SensorChannelKind_t
+  float fixed_scale; // 定点缩放系数 (定点值 = 实际值 * scale)，须保证 量程 * scale < 32767
+} SensorChannelDesc_t;
+
+/* 通道描述初始化宏，member 为 SensorData_t.values 下的成员路径 (如 sht30.temp) */
+#define SENSOR_CHANNEL_FLOAT(name, unit, member, scale)                        \
+  {(name), (unit), (uint16_t)offsetof(SensorData_t, values.member),            \
+   SENSOR_CHANNEL_KIND_FLOAT, (scale)}
+#define SENSOR_CHANNEL_INT(name, unit, member, scale)                          \
+  {(name), (unit), (uint16_t)offsetof(SensorData_t, values.member),            \
+   SENSOR_CHANNEL_KIND_INT, (scale)}
+
+/* --------------------------- 电源域 --------------------------- */
+/**
+ * @brief 传感器的电源开关 (GPIO 控制)
+ * @details 引脚由 MX_GPIO_Init 配置为推挽输出并默认上电。两次采样之间的
+ *          空闲时间超过 warmup_ms + SENSOR_POWER_MIN_OFF_MS 时，调度器在采样
+ *          后反初始化并断电，在下一个截止时间之前 warmup_ms 重新上电，
+ *          预热结束 (即原定的采样时刻) 后重新初始化并采样，节拍与相位不变。
+ *          自适应采样拉长间隔时，断电时间随之变长。
+ */
 typedef struct {
-  // 全局统计数据 (自启动以来)
-  float min;
-  float max;
-  float avg;
+  GPIO_TypeDef *port; // 开关引脚所在端口，NULL 表示常供电
+  uint16_t pin;       // 开关引脚
+  uint8_t on_level;   // 上电时的引脚电平 (GPIO_PinState)
+  uint32_t warmup_ms; // 上电到可以初始化并得到有效数据的时间
+} SensorPowerDesc_t;
+
+/* 电源域初始化宏 (sensor_config.h 中使用) */
+#define SENSOR_POWER_NONE {NULL, 0, 0, 0}
+#define SENSOR_POWER_GPIO(port, pin, on_level, warmup_ms)                      \
+  {(port), (pin), (on_level), (warmup_ms)}
 
-  // 局部统计数据 (仅基于当前历史缓冲区)
-  float local_min;
-  float local_max;
-  float local_avg;
-} SensorStats_t;
+typedef enum {
+  SENSOR_POWER_STATE_ON = 0, // 已上电 (含常供电)
+  SENSOR_POWER_STATE_OFF,    // 两次采样之间已断电
+  SENSOR_POWER_STATE_WARMUP  // 已重新上电，等待预热结束
+} SensorPowerState_t;
+
+/* --------------------------- 传感器实例结构体 --------------------------- */
+// 历史缓冲区大小 SENSOR_HISTORY_SIZE 及统计结构体 SensorStats_t 见 sensor_stats.h
 
 typedef struct {
   SensorType_t type;              // 传感器类型
-  char name[SENSOR_MAX_NAME_LEN]; // 传感器名称
+  SensorHandle_t handle;          // 实例句柄
+  uint8_t index;                  // 同类型中的序号
+  const char *name;               // 传感器名称 (指向驱动配置表中的常量)
   SensorStatus_t status;          // 传感器状态
   SensorData_t data;              // 传感器数据
-  uint32_t update_interval_ms;    // 更新间隔
+  uint32_t update_interval_ms;    // 更新间隔 (配置值，平稳状态下的基准)
+  uint32_t sample_interval_ms;    // 实际采样间隔 (由 sensor_adapt 按信号活跃程度调整)
   uint32_t last_update_time;      // 上次更新时间
+  uint32_t next_due_time;         // 下次需要处理的时间点 (调度截止时间)
+  uint32_t phase_offset_ms;       // 相位偏移，避免多个传感器挤在同一 tick
+  uint32_t cycle_due_time;        // 本轮采样的计划时间点 (用于推进节拍)
+  bool is_converting;             // 分阶段读取：已触发转换，等待取回
+  uint64_t conversion_start_us;   // 本轮转换开始时刻，提交样本时写入时间戳
   uint32_t error_count;           // 错误计数
+  const SensorPowerDesc_t *power; // 电源域 (指向驱动配置表，远端实例为 NULL)
+  uint8_t power_state;            // SensorPowerState_t
+  uint32_t power_due_time;        // 断电期间为原定的采样时间点，预热期间为预热结束时刻
   bool is_enabled;                // 是否启用
+  bool is_remote;                 // 远端实例 (见 SensorTask_RegisterRemote)
+  volatile uint8_t event_pending; // 待投递事件位图 (1 << SensorEventType_t)，见 SensorTask_FlushEvents
+  SensorStatus_t event_status;    // 待投递的最新状态 (STATUS_CHANGE)
+  SensorData_t event_data;        // 待投递的最新数据 (DATA_UPDATE / ANOMALY)
+  uint32_t event_data_time;       // 上次投递数据更新事件的时刻
   void *device_handle;            // 设备句柄指针
 
-  // [NEW] 3. 为每个传感器实例添加以下成员
-  SensorStats_t stats;                // 统计数据 (最大/最小/平均值)
-  SensorStats_t secondary_stats;      // 备用统计数据 (如湿度)
-  float history[SENSOR_HISTORY_SIZE]; // 历史数据循环缓冲区
-  float secondary_history
-      [SENSOR_HISTORY_SIZE]; // 备用历史数据循环缓冲区（如湿度）
+  // 通道数据 (按通道下标排列的数组，各通道共用 history_head/history_count)
+  const SensorChannelDesc_t *channels; // 通道表 (注册时传入)
+  uint8_t channel_count;               // 通道数 (1 ~ SENSOR_MAX_CHANNELS)
+  SensorStats_t stats[SENSOR_MAX_CHANNELS]; // 统计数据 (最大/最小/平均值)
+  float history[SENSOR_MAX_CHANNELS][SENSOR_HISTORY_SIZE]; // 历史数据循环缓冲区
+  int16_t chart_history[SENSOR_MAX_CHANNELS]
+                       [SENSOR_HISTORY_SIZE]; // 定点历史，与 history 同槽位
+  uint8_t history_quality[SENSOR_MAX_CHANNELS]
+                         [SENSOR_HISTORY_SIZE]; // 质量标志，与 history 同槽位
   uint16_t history_head;     // 缓冲区的当前头部索引
   uint16_t history_count;    // 记录已有的历史数据点数量
+  SensorStatsEngine_t engine[SENSOR_MAX_CHANNELS]; // 增量统计引擎
+  SensorRollup_t rollup[SENSOR_MAX_CHANNELS];      // 分钟/小时级历史
+  SensorSeries_t series;                           // 压缩的原始历史 (最近数百个样本)
+
+  // 顺序锁：只有传感器任务写入，读者无锁拷贝并在读到撕裂数据时重试
+  volatile uint32_t seq;    // 序号，奇数表示正在写入
+  SensorData_t shared_data; // 对外发布的数据副本 (受 seq 保护)
 } SensorInstance_t;
 
 /* --------------------------- 传感器回调函数类型 --------------------------- */
+typedef enum {
+  SENSOR_COLLECT_DONE = 0, // 结果已写入 sensor->data
+  SENSOR_COLLECT_PENDING,  // 转换尚未完成，稍后再取
+  SENSOR_COLLECT_ERROR     // 读取失败
+} SensorCollectResult_t;
+
+/**
+ * @brief 传感器驱动回调
+ * @details start_func/collect_func 为可选的分阶段接口：调度器先触发转换，
+ *          在转换期间去处理其他传感器，到时间后再取回结果，使各传感器的
+ *          转换时间相互重叠。两者都提供时优先使用，否则使用阻塞的 read_func。
+ */
 typedef struct {
   bool (*init_func)(SensorInstance_t *sensor);   // 初始化函数
-  bool (*read_func)(SensorInstance_t *sensor);   // 读取函数
+  bool (*read_func)(SensorInstance_t *sensor);   // 读取函数 (阻塞)
   bool (*deinit_func)(SensorInstance_t *sensor); // 反初始化函数
   const char *(*get_unit)(void);                 // 获取单位字符串
+  // 触发转换 (可选)，输出距离可取回结果的等待时间
+  bool (*start_func)(SensorInstance_t *sensor, uint32_t *wait_ms);
+  // 取回结果 (可选)，返回 PENDING 时输出下次再取的等待时间
+  SensorCollectResult_t (*collect_func)(SensorInstance_t *sensor,
+                                        uint32_t *wait_ms);
 } SensorCallbacks_t;
 
-/* --------------------------- 传感器管理器结构体 --------------------------- */
+/**
+ * @brief 驱动配置 (每种传感器一条，整张表为 const，由应用层以 X 宏生成)
+ * @details 实例只保存指向表中名称、回调与通道表的指针，注册时不复制字符串
+ *          或回调结构体。
+ */
 typedef struct {
-  SensorInstance_t sensors[SENSOR_TYPE_MAX];    // 传感器实例数组
-  SensorCallbacks_t callbacks[SENSOR_TYPE_MAX]; // 回调函数数组
-  bool is_initialized;                          // 管理器是否已初始化
-  uint32_t active_sensor_count;                 // 活跃传感器数量
+  SensorType_t type;                   // 传感器类型
+  const char *name;                    // 传感器名称
+  const SensorCallbacks_t *callbacks;  // 驱动回调
+  const SensorChannelDesc_t *channels; // 通道表
+  uint8_t channel_count;               // 通道数 (1 ~ SENSOR_MAX_CHANNELS)
+  uint32_t update_interval_ms;         // 默认更新间隔
+  SensorPowerDesc_t power;             // 电源域 (port 为 NULL 表示常供电)
+} SensorDriverDesc_t;
 
-  osMutexId global_data_mutex; // [新增] 数据访问互斥锁
+/* --------------------------- 传感器管理器结构体 --------------------------- */
+typedef struct {
+  SensorInstance_t sensors[SENSOR_MAX_INSTANCES];    // 传感器实例 (按注册顺序)
+  const SensorDriverDesc_t *drivers;                  // 驱动配置表 (Flash 中的常量表)
+  uint8_t driver_count;
+  const SensorCallbacks_t *callbacks[SENSOR_MAX_INSTANCES]; // 驱动回调 (指向配置表，与实例同下标)
+  const SensorCallbacks_t *volatile override[SENSOR_MAX_INSTANCES]; // 替换的回调 (NULL 使用注册的回调)
+  uint8_t slot[SENSOR_TYPE_MAX][SENSOR_MAX_PER_TYPE]; // 句柄 -> 实例下标 (0xFF 未注册)
+  uint8_t order[SENSOR_MAX_INSTANCES]; // 按截止时间排序的实例下标 (传感器任务维护)
+  volatile uint8_t sensor_count;       // 已注册实例数
+  bool is_initialized;                 // 管理器是否已初始化
+  uint32_t active_sensor_count;        // 活跃传感器数量
+  uint32_t events_coalesced;           // 投递前被更新的事件覆盖而合并的次数
+  volatile uint32_t commit_seq;        // 全局顺序锁：任一实例写入期间为奇数 (见 SensorTask_GetSnapshot)
 } SensorManager_t;
 
 /* --------------------------- 传感器事件结构体 --------------------------- */
 typedef enum {
   SENSOR_EVENT_DATA_UPDATE = 0, // 数据更新事件
   SENSOR_EVENT_STATUS_CHANGE,   // 状态变化事件
-  SENSOR_EVENT_ERROR            // 错误事件
+  SENSOR_EVENT_ERROR,           // 错误事件
+  SENSOR_EVENT_ANOMALY          // 通道异常状态变化 (见 sensor_anomaly.h)
 } SensorEventType_t;
 
 typedef struct {
   SensorEventType_t event_type; // 事件类型
   SensorType_t sensor_type;     // 传感器类型
+  SensorHandle_t sensor;        // 实例句柄
   SensorData_t data;            // 相关数据
   SensorStatus_t status;        // 相关状态
 } SensorEvent_t;
 
+/**
+ * @brief 通过事件总线投递的传感器快照
+ * @details 由传感器任务在投递时在记录池中生成一次，所有订阅者共享，
+ *          订阅者无需再读取传感器实例即可拿到数据与统计值 (见 sensor_event_bus.h)。
+ *          事件按传感器合并：同一类型尚未投递时只保留最新的一次 (状态取最新
+ *          值，数据更新在 SENSOR_EVENT_DATA_WINDOW_MS 内合并)，投递按异常/错误、
+ *          数据更新、状态变化的优先级进行，因此同一传感器的状态变化可能晚于
+ *          随后的数据更新到达，订阅者以快照中的 status 为准。
+ */
+typedef struct {
+  SensorEvent_t event;                      // 事件本体 (含最新数据)
+  SensorStats_t stats[SENSOR_MAX_CHANNELS]; // 各通道统计数据
+  bool has_stats;                           // 统计数据是否有效
+  uint8_t channel_count;                    // 通道数
+  uint8_t anomaly;                          // 处于异常的通道位图 (所有事件都有效)
+  int16_t fixed[SENSOR_MAX_CHANNELS]; // 最新样本的各通道定点值，DATA_UPDATE 且读取成功时有效
+} SensorSnapshot_t;
+
 /* --------------------------- 公共函数声明 --------------------------- */
 
 /**
@@ -148,63 +344,328 @@ typedef struct {
 bool SensorTask_Init(void);
 
 /**
- * @brief 注册传感器
+ * @brief 设置驱动配置表 (在注册任何实例之前调用)
+ * @param drivers 配置表 (须为静态存储)，每种类型至多一条
+ * @param count   条数
+ * @return false: 表中有无效条目 (整张表不生效)
+ */
+bool SensorTask_SetDrivers(const SensorDriverDesc_t *drivers, uint8_t count);
+
+/**
+ * @brief 注册传感器实例
+ * @details 名称、回调、通道表与默认间隔取自驱动配置表中该类型的条目。
+ *          同一类型可以注册多次 (最多 SENSOR_MAX_PER_TYPE 个)，
+ *          依次分配序号 0、1...
  * @param type 传感器类型
- * @param name 传感器名称
- * @param callbacks 回调函数结构体
  * @param device_handle 设备句柄
- * @param update_interval_ms 更新间隔(毫秒)
+ * @return 实例句柄，失败返回 SENSOR_HANDLE_INVALID
+ */
+SensorHandle_t SensorTask_RegisterInstance(SensorType_t type,
+                                           void *device_handle);
+
+/**
+ * @brief 注册远端传感器实例 (如 Modbus 网关轮询的其他节点)
+ * @details 通道表与默认间隔取自驱动配置表中该类型的条目，名称与回调由
+ *          调用者提供；实例与本地传感器一样参与调度、统计与事件分发。
+ * @param name      显示名称 (须为静态存储)
+ * @param callbacks 驱动回调 (须为静态存储)，要求同驱动配置表
+ * @return 实例句柄，失败返回 SENSOR_HANDLE_INVALID
+ * @note  注册可以在任意任务中进行，多个任务同时注册时依次完成
+ */
+SensorHandle_t SensorTask_RegisterRemote(SensorType_t type, const char *name,
+                                         const SensorCallbacks_t *callbacks,
+                                         void *device_handle);
+
+/**
+ * @brief 是否为远端实例 (转发本机样本的传输层据此避免回传)
+ */
+bool SensorTask_IsRemote(SensorHandle_t sensor);
+
+/**
+ * @brief 注册传感器 (同 SensorTask_RegisterInstance，只返回是否成功)
  * @return true: 成功, false: 失败
  */
-bool SensorTask_RegisterSensor(SensorType_t type, const char *name,
-                               const SensorCallbacks_t *callbacks,
-                               void *device_handle,
-                               uint32_t update_interval_ms);
+bool SensorTask_RegisterSensor(SensorType_t type, void *device_handle);
+
+/**
+ * @brief 已注册的实例数
+ */
+uint8_t SensorTask_GetSensorCount(void);
+
+/**
+ * @brief 按注册顺序获取实例句柄 (用于遍历)
+ * @return 句柄，i 超出范围返回 SENSOR_HANDLE_INVALID
+ */
+SensorHandle_t SensorTask_GetHandleAt(uint8_t i);
+
+/**
+ * @brief 查找实例
+ * @param type  传感器类型
+ * @param index 同类型中的序号
+ * @return 句柄，未注册返回 SENSOR_HANDLE_INVALID
+ */
+SensorHandle_t SensorTask_Find(SensorType_t type, uint8_t index);
+
+/**
+ * @brief 获取实例名称
+ * @return 注册时的名称，未注册返回 "?"
+ */
+const char *SensorTask_GetName(SensorHandle_t sensor);
 
 /**
  * @brief 启用传感器
- * @param type 传感器类型
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
  * @return true: 成功, false: 失败
  */
-bool SensorTask_EnableSensor(SensorType_t type);
+bool SensorTask_EnableSensor(SensorHandle_t sensor);
 
 /**
  * @brief 禁用传感器
- * @param type 传感器类型
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
  * @return true: 成功, false: 失败
  */
-bool SensorTask_DisableSensor(SensorType_t type);
+bool SensorTask_DisableSensor(SensorHandle_t sensor);
 
 /**
  * @brief 获取传感器数据
- * @param type 传感器类型
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
  * @param data 输出数据指针
  * @return true: 成功, false: 失败
  */
-bool SensorTask_GetSensorData(SensorType_t type, SensorData_t *data);
+bool SensorTask_GetSensorData(SensorHandle_t sensor, SensorData_t *data);
 
 /**
  * @brief 获取传感器状态
- * @param type 传感器类型
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
  * @param status 输出状态指针
  * @return true: 成功, false: 失败
  */
-bool SensorTask_GetSensorStatus(SensorType_t type, SensorStatus_t *status);
+bool SensorTask_GetSensorStatus(SensorHandle_t sensor, SensorStatus_t *status);
+
+/**
+ * @brief 获取传感器当前的实际采样间隔 (自适应调整后)
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
+ * @return 间隔 (ms)，类型无效返回 0
+ */
+uint32_t SensorTask_GetSampleInterval(SensorHandle_t sensor);
+
+/**
+ * @brief 获取传感器配置的更新间隔 (自适应调整之前)
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
+ * @return 间隔 (ms)，类型无效返回 0
+ */
+uint32_t SensorTask_GetUpdateInterval(SensorHandle_t sensor);
 
 /**
  * @brief 设置传感器更新间隔
- * @param type 传感器类型
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
  * @param interval_ms 更新间隔(毫秒)
  * @return true: 成功, false: 失败
  */
-bool SensorTask_SetUpdateInterval(SensorType_t type, uint32_t interval_ms);
+bool SensorTask_SetUpdateInterval(SensorHandle_t sensor, uint32_t interval_ms);
+
+/**
+ * @brief 设置传感器相位偏移 (启用后首次处理相对启用时刻的延迟)
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
+ * @param offset_ms 相位偏移(毫秒)
+ * @return true: 成功, false: 失败
+ */
+bool SensorTask_SetPhaseOffset(SensorHandle_t sensor, uint32_t offset_ms);
+
+/**
+ * @brief 替换实例的驱动回调 (如数据回放)
+ * @param sensor    实例句柄 (或传感器类型，表示该类型的第一个实例)
+ * @param callbacks 替换的回调 (须为静态存储，须提供 init_func 与 read_func)，
+ *                  NULL 恢复注册时的驱动回调
+ * @return true: 成功, false: 未注册或回调无效
+ * @note  从下一次处理起生效；替换时正在进行的分阶段转换被放弃
+ */
+bool SensorTask_OverrideCallbacks(SensorHandle_t sensor,
+                                  const SensorCallbacks_t *callbacks);
+
+/**
+ * @brief 获取传感器的通道表
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
+ * @param channels 输出通道表指针 (可为 NULL)
+ * @return 通道数，未注册返回 0
+ */
+uint8_t SensorTask_GetChannels(SensorHandle_t sensor,
+                               const SensorChannelDesc_t **channels);
+
+/**
+ * @brief 按通道描述从数据中取出数值
+ */
+float SensorChannel_Value(const SensorChannelDesc_t *channel,
+                          const SensorData_t *data);
+
+/**
+ * @brief 按通道描述把数值写入数据 (整数通道四舍五入)
+ */
+void SensorChannel_SetValue(const SensorChannelDesc_t *channel,
+                            SensorData_t *data, float value);
+
+/**
+ * @brief 按名称查找通道
+ * @return 通道下标，找不到返回 -1
+ */
+int8_t SensorTask_FindChannel(SensorHandle_t sensor, const char *name);
+
+/**
+ * @brief 获取指定通道的统计数据
+ * @return true: 成功, false: 失败或无数据
+ */
+bool SensorTask_GetChannelStats(SensorHandle_t sensor, uint8_t channel,
+                                SensorStats_t *stats);
+
+/* 通道 0 / 通道 1 的统计数据 (兼容旧接口) */
+bool SensorTask_GetStats(SensorHandle_t sensor, SensorStats_t *stats);
+bool SensorTask_GetSecondaryStats(SensorHandle_t sensor, SensorStats_t *stats);
+
+/**
+ * @brief 全部实例的一致快照中的一项
+ * @details version 为取得快照时该实例顺序锁的序号，每提交一个样本加 2；
+ *          stats 在 history_count 为 0 时没有意义。
+ */
+typedef struct {
+  SensorHandle_t handle;                    // 实例句柄
+  SensorStatus_t status;                    // 状态
+  bool is_enabled;                          // 是否启用
+  uint8_t channel_count;                    // 通道数
+  uint16_t history_count;                   // 历史点数
+  uint32_t version;                         // 顺序锁序号
+  SensorData_t data;                        // 最新数据
+  SensorStats_t stats[SENSOR_MAX_CHANNELS]; // 各通道统计数据
+} SensorSnapshotEntry_t;
+
+#if SENSOR_MAX_INSTANCES > 32
+#error "SENSOR_MAX_INSTANCES 超过快照变化位图的位数 (32)"
+#endif
+#if SENSOR_SERIES_MAX_CHANNELS < SENSOR_MAX_CHANNELS
+#error "SENSOR_SERIES_MAX_CHANNELS 小于 SENSOR_MAX_CHANNELS"
+#endif
+
+/**
+ * @brief 全部实例的一致快照 (按注册顺序)
+ * @details 由调用者静态分配并在多次调用之间保留：SensorTask_GetSnapshot
+ *          以其中上一次的内容为基准计算 changed。
+ */
+typedef struct {
+  uint8_t count;                                 // 实例数
+  uint32_t changed;                              // 与上一次相比有变化的项 (位图，下标同 entry)
+  uint32_t generation;                           // 取得快照时的全局顺序锁序号
+  SensorSnapshotEntry_t entry[SENSOR_MAX_INSTANCES];
+} SensorSystemSnapshot_t;
+
+/**
+ * @brief 一次取得全部实例的数据、状态与统计
+ * @details 以全局顺序锁保证各实例之间的一致：拷贝期间传感器任务提交了
+ *          任何样本则整体重读，结果对应同一时刻的全部实例。代替逐个实例
+ *          调用 GetSensorData / GetStats / GetSecondaryStats。
+ *          某项的版本、状态、启用状态或句柄与 snap 中原有的内容不同时，
+ *          该项在 changed 中置位；snap 首次使用前清零即可 (首次全部置位)。
+ * @param snap 快照 (输入为上一次的结果，输出为本次结果)
+ * @return changed 位图
+ */
+uint32_t SensorTask_GetSnapshot(SensorSystemSnapshot_t *snap);
+
+/**
+ * @brief 在快照中查找实例
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
+ * @return 快照项，未注册返回 NULL
+ */
+const SensorSnapshotEntry_t *
+SensorTask_SnapshotFind(const SensorSystemSnapshot_t *snap,
+                        SensorHandle_t sensor);
+
+/**
+ * @brief 历史环形缓冲区的原地视图 (零拷贝)
+ * @details 按时间从旧到新依次为 seg[0][0..len[0]) 和 seg[1][0..len[1])。
+ *          指针直接指向传感器实例中的环形缓冲区，传感器任务之后写入新样本时
+ *          会覆盖最旧的点；读者用完后以 SensorTask_HistorySpanValid 检查
+ *          version，失效则重新获取。各读者互不影响，可并发使用。
+ *          fixed 与 seg 一一对应，是按通道 fixed_scale 换算好的定点值，
+ *          图表可直接使用，无需再做浮点运算。quality 为同位置的质量标志，
+ *          被剔除的点 (SENSOR_QUALITY_REJECTED) 数值为上一个有效值，
+ *          图表应显示为断点。
+ */
+typedef struct {
+  const float *seg[2];     // 两段连续数据
+  const int16_t *fixed[2]; // 同位置的定点数据
+  const uint8_t *quality[2]; // 同位置的质量标志
+  uint16_t len[2];     // 各段点数
+  uint32_t version;    // 取得视图时的顺序锁序号
+  SensorHandle_t sensor; // 所属实例
+  uint8_t channel;     // 所属通道
+} SensorHistorySpan_t;
+
+/**
+ * @brief 获取历史环形缓冲区的原地视图
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
+ * @param channel 通道下标
+ * @param span 输出视图，无数据时两段长度均为 0
+ * @return uint16_t 有效的历史数据点数量
+ */
+uint16_t SensorTask_GetHistorySpan(SensorHandle_t sensor, uint8_t channel,
+                                   SensorHistorySpan_t *span);
+
+/**
+ * @brief 视图是否仍然有效 (取得之后没有新样本写入)
+ */
+bool SensorTask_HistorySpanValid(const SensorHistorySpan_t *span);
 
-bool SensorTask_GetStats(SensorType_t type, SensorStats_t *stats);
-bool SensorTask_GetSecondaryStats(SensorType_t type, SensorStats_t *stats);
-uint16_t SensorTask_GetPrimaryHistory(SensorType_t type,
-                                      const float **history_data);
-uint16_t SensorTask_GetSecondaryHistory(SensorType_t type,
-                                        const float **history_data);
+/**
+ * @brief 通道定点数据的缩放系数 (定点值 = 实际值 * scale)
+ * @details 定点历史、事件快照、分钟/小时级汇总与 Flash 日志共用通道表中的
+ *          系数；未注册的传感器或通道返回 1
+ */
+float SensorTask_FixedScale(SensorHandle_t sensor, uint8_t channel);
+
+/**
+ * @brief 实际值 -> 定点值 (四舍五入并限幅)
+ * @note  结果不会等于 INT16_MAX，可与 LV_CHART_POINT_NONE 区分
+ */
+int16_t SensorTask_ToFixed(SensorHandle_t sensor, uint8_t channel, float value);
+
+/**
+ * @brief 获取分钟/小时级汇总历史 (已按时间排好序，从旧到新)
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
+ * @param channel 通道下标
+ * @param tier 分辨率
+ * @param out 输出缓冲区
+ * @param max_points 输出缓冲区容量
+ * @return uint16_t 有效的汇总点数量
+ */
+uint16_t SensorTask_GetRollupHistory(SensorHandle_t sensor, uint8_t channel,
+                                     SensorTier_t tier,
+                                     SensorRollupPoint_t *out,
+                                     uint16_t max_points);
+
+/**
+ * @brief 获取汇总历史最新封存桶之后的绝对桶号 (见 SensorRollup_End)
+ * @details 值不变说明汇总历史没有新的桶，无需重新读取
+ * @param sensor 实例句柄 (或传感器类型)
+ * @param channel 通道下标
+ * @param tier 分辨率
+ * @return uint32_t 绝对桶号，无效参数返回 0
+ */
+uint32_t SensorTask_GetRollupEnd(SensorHandle_t sensor, uint8_t channel,
+                                 SensorTier_t tier);
+
+/**
+ * @brief 获取最近一段时间的原始历史 (由压缩序列按时间等分求平均)
+ * @details 覆盖范围比 history 环形缓冲区长得多、比分钟级汇总细；
+ *          解码需要遍历整个序列，适合在切换显示范围等场合调用
+ * @param sensor 实例句柄 (或传感器类型)
+ * @param channel 通道下标
+ * @param window_ms 时间窗口 (以最新样本为终点)
+ * @param out 输出 buckets 个定点值 (缩放系数见 SensorTask_FixedScale)，
+ *            无数据的时段为 SENSOR_SERIES_EMPTY
+ * @param buckets 时段数
+ * @return uint16_t 有数据的时段数，无效参数返回 0
+ */
+uint16_t SensorTask_GetRecentHistory(SensorHandle_t sensor, uint8_t channel,
+                                     uint32_t window_ms, int16_t *out,
+                                     uint16_t buckets);
 
 /**
  * @brief 获取传感器状态字符串
@@ -215,7 +676,7 @@ const char *SensorStatus_ToString(SensorStatus_t status);
 
 /**
  * @brief 获取传感器类型字符串
- * @param type 传感器类型
+ * @param sensor 实例句柄 (或传感器类型，表示该类型的第一个实例)
  * @return const char* 传感器类型字符串
  */
 const char *SensorType_ToString(SensorType_t type);
@@ -236,19 +697,17 @@ osThreadId SensorTask_GetHandle(void);
 /* --------------------------- 事件通知相关 --------------------------- */
 
 /**
- * @brief 注册传感器事件回调函数
- * @param callback 事件回调函数指针
- * @return true: 成功, false: 失败
+ * @brief 传感器事件回调 (事件总线的回调订阅者，见 SensorEventBus_SubscribeCallback)
  */
 typedef void (*SensorEventCallback_t)(const SensorEvent_t *event);
-bool SensorTask_RegisterEventCallback(SensorEventCallback_t callback);
 
 /* --------------------------- 便利宏定义 --------------------------- */
 #define SENSOR_DATA_IS_FRESH(sensor, max_age_ms)                               \
   ((HAL_GetTick() - (sensor)->data.timestamp) <= (max_age_ms))
 
 #define SENSOR_IS_HEALTHY(sensor)                                              \
-  ((sensor)->status == SENSOR_STATUS_ONLINE && (sensor)->error_count < 5)
+  ((sensor)->status == SENSOR_STATUS_ONLINE &&                                 \
+   (sensor)->error_count < SENSOR_ERROR_REINIT_COUNT)
 
 #define SENSOR_GET_AGE_MS(sensor) (HAL_GetTick() - (sensor)->data.timestamp)
 
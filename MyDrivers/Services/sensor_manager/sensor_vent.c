@@ -0,0 +1,116 @@
+/**
+ ******************************************************************************
+ * @file    sensor_vent.c
+ * @brief   空气质量通风联动源文件
+ * @details 回差以"有效值"实现：样本高于有效值时有效值跟随上升，低于
+ *          有效值减回差时有效值回落到 样本 + 回差，曲线按有效值查表。
+ *          状态只由传感器任务修改。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sensor_vent.h"
+#include "devices_manager.h"
+
+#define LOG_MODULE "VENT"
+#include "log.h"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  bool valid;      // 已收到样本
+  float effective; // 回差处理后的有效值
+  uint16_t speed;  // 曲线输出
+} SensorVentCtx_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static const SensorVentCurve_t *s_curves;
+static uint8_t s_curve_count;
+static SensorVentCtx_t s_ctx[SENSOR_VENT_MAX_CURVES];
+static uint16_t s_speed;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 分段线性查表
+ */
+static uint16_t sensor_vent_lookup(const SensorVentCurve_t *curve, float x) {
+  const SensorVentPoint_t *pt = curve->points;
+  uint8_t n = curve->point_count;
+
+  if (x <= pt[0].value) {
+    return pt[0].speed;
+  }
+  for (uint8_t i = 1; i < n; i++) {
+    if (x < pt[i].value) {
+      float k = (x - pt[i - 1].value) / (pt[i].value - pt[i - 1].value);
+      return (uint16_t)((float)pt[i - 1].speed +
+                        k * ((float)pt[i].speed - (float)pt[i - 1].speed));
+    }
+  }
+  return pt[n - 1].speed;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 设置曲线表
+ */
+void SensorVent_SetCurves(const SensorVentCurve_t *curves, uint8_t count) {
+  if (count > SENSOR_VENT_MAX_CURVES) {
+    count = SENSOR_VENT_MAX_CURVES;
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    s_ctx[i].valid = false;
+    s_ctx[i].speed = 0;
+  }
+  s_curves = curves;
+  s_curve_count = (curves != NULL) ? count : 0;
+  s_speed = 0;
+}
+
+/**
+ * @brief 处理一个样本
+ */
+void SensorVent_Process(SensorHandle_t sensor, const float *values,
+                        uint8_t count) {
+  bool touched = false;
+  uint16_t speed = 0;
+
+  for (uint8_t i = 0; i < s_curve_count; i++) {
+    const SensorVentCurve_t *curve = &s_curves[i];
+    SensorVentCtx_t *ctx = &s_ctx[i];
+
+    if (curve->sensor == sensor && curve->channel < count &&
+        curve->point_count > 0) {
+      float x = values[curve->channel];
+
+      if (!ctx->valid || x > ctx->effective) {
+        ctx->effective = x;
+      } else if (x < ctx->effective - curve->hysteresis) {
+        ctx->effective = x + curve->hysteresis;
+      }
+      ctx->valid = true;
+      ctx->speed = sensor_vent_lookup(curve, ctx->effective);
+      touched = true;
+    }
+    if (ctx->valid && ctx->speed > speed) {
+      speed = ctx->speed;
+    }
+  }
+
+  if (!touched) {
+    return;
+  }
+  // 设备管理器保存最近的风速，切换到通风模式时立即使用，这里只下发变化
+  if (speed != s_speed) {
+    LOG_DEBUG("通风风速 %u -> %u", s_speed, speed);
+    s_speed = speed;
+    Drivers_Motor_SetVentSpeed(speed);
+  }
+}
+
+/**
+ * @brief 当前请求的风速
+ */
+uint16_t SensorVent_GetSpeed(void) { return s_speed; }
@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file    sensor_vent.h
+ * @brief   空气质量通风联动头文件
+ * @details 电机处于通风模式 (MOTOR_MODE_VENT) 时，按分段线性曲线把烟雾
+ *          浓度 (及可选的湿度) 映射为风扇速度：
+ *            - 每条曲线对应一个传感器通道，多条曲线取最大速度；
+ *            - 回差：数值上升时立即提速，下降超过回差后才降速，
+ *              避免在拐点附近反复调速；
+ *            - 在传感器任务中逐样本评估 (与告警规则相同位置)，响应时间
+ *              不超过一个采样周期，与当前页面无关。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SENSOR_VENT_H
+#define __SENSOR_VENT_H
+
+#include "sensor_task.h"
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SENSOR_VENT_MAX_CURVES 4 // 曲线最大条数
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 曲线上的一点
+ */
+typedef struct {
+  float value;    // 传感器数值 (ppm、%RH 等)
+  uint16_t speed; // 风扇速度 (0-999)
+} SensorVentPoint_t;
+
+/**
+ * @brief 一条风速曲线
+ * @note  点按 value 升序排列；低于第一点取第一点速度，高于最后一点取
+ *        最后一点速度，中间线性插值
+ */
+typedef struct {
+  SensorHandle_t sensor;           // 传感器实例 (写类型即该类型的第一个实例)
+  uint8_t channel;                 // 通道下标 (如 SHT30 1: 湿度)
+  float hysteresis;                // 回差 (与 value 同单位，>= 0)
+  const SensorVentPoint_t *points; // 曲线点 (静态存储)
+  uint8_t point_count;             // 点数 (>= 1)
+} SensorVentCurve_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 设置曲线表 (表须为静态存储)
+ * @param curves 曲线数组
+ * @param count  条数，超过 SENSOR_VENT_MAX_CURVES 的部分忽略
+ * @note  在注册传感器之前调用
+ */
+void SensorVent_SetCurves(const SensorVentCurve_t *curves, uint8_t count);
+
+/**
+ * @brief 用一个新样本更新对应曲线并输出合成风速 (传感器任务中调用)
+ * @param sensor    传感器实例句柄
+ * @param values    各通道数值 (按通道下标)
+ * @param count     通道数，曲线通道超出范围时忽略
+ */
+void SensorVent_Process(SensorHandle_t sensor, const float *values,
+                        uint8_t count);
+
+/**
+ * @brief 当前请求的风速 (0-999)
+ */
+uint16_t SensorVent_GetSpeed(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SENSOR_VENT_H */
@@ -0,0 +1,1907 @@
+/**
+ ******************************************************************************
+ * @file    shell.c
+ * @brief   串口命令行实现文件
+ * @details 接收 DMA 工作在循环模式，HAL 在半满、全满和空闲线时回调并给出
+ *          DMA 写入位置，中断中只记录位置并通知命令行任务，不逐字节中断。
+ *          命令行任务在环形缓冲区中查找行结束符，未跨越缓冲区末尾的行直接
+ *          在缓冲区内切分参数 (零拷贝)，只有跨越末尾的行才拷贝到行缓冲区。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "shell.h"
+#include "FreeRTOS.h"
+#include "boot_graph.h"
+#include "can_bus.h"
+#include "can_net.h"
+#include "checksum.h"
+#include "config_store.h"
+#include "crash_dump.h"
+#include "devices_manager.h"
+#include "energy_meter.h"
+#include "esp_at.h"
+#include "eth_mac.h"
+#include "fmt_fixed.h"
+#include "frame_stats.h"
+#include "i2c_bus_manager.h"
+#include "log_flash.h"
+#include "mem_section.h"
+#include "metrics.h"
+#include "modbus_gateway.h"
+#include "modbus_slave.h"
+#include "net_udp.h"
+#include "ota_update.h"
+#include "norflash.h"
+#include "power_manager.h"
+#include "printf_redirect.h"
+#include "profiler.h"
+#include "rs485.h"
+#include "rtc_clock.h"
+#include "rtos_trace.h"
+#include "runtime_config.h"
+#include "sd_archive.h"
+#include "sdcard.h"
+#include "sensor_alarm.h"
+#include "sensor_anomaly.h"
+#include "sensor_quality.h"
+#include "sensor_export.h"
+#include "sensor_filter.h"
+#include "sensor_jitter.h"
+#include "sensor_latency.h"
+#include "sensor_derived.h"
+#include "sensor_log.h"
+#include "sensor_probe.h"
+#include "sensor_replay.h"
+#include "sensor_task.h"
+#include "sys_monitor.h"
+#include "task.h"
+#include "task_wdt.h"
+#include "telemetry.h"
+#include "telemetry_edge.h"
+#include "test.h"
+#include "ui_manager.h"
+#include "usb_cdc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* --------------------------- 调试配置 --------------------------- */
+#define LOG_MODULE "SHELL"
+#include "log.h"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef void (*shell_handler_t)(int argc, char **argv);
+
+typedef struct {
+  const char *name;
+  const char *usage;
+  shell_handler_t handler;
+  uint8_t min_args; // 最少参数个数 (含命令名)
+} shell_command_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static UART_HandleTypeDef *g_shell_uart = NULL;
+
+static uint8_t g_rx_buf[SHELL_RX_BUFFER_SIZE];
+static volatile uint16_t g_rx_head = 0;  // DMA 写入位置 (由接收回调更新)
+static volatile uint8_t g_rx_resync = 0; // 接收重启后 DMA 从头写入
+static uint16_t g_rx_tail = 0;           // 下一个待扫描的位置
+static uint16_t g_line_start = 0;        // 当前行起始位置
+static uint16_t g_line_len = 0;          // 当前行已接收长度
+static bool g_line_overflow = false;     // 当前行超长，整行丢弃
+
+static char g_line_buf[SHELL_LINE_MAX + 1]; // 跨越缓冲区末尾的行
+
+// 其他输入通道：中断写入环形缓冲区，命令行任务逐字节拼接到独立的行缓冲区
+static uint8_t g_in_buf[SHELL_INPUT_BUFFER_SIZE];
+static volatile uint16_t g_in_head = 0;
+static volatile uint16_t g_in_tail = 0;
+static char g_in_line[SHELL_LINE_MAX + 1];
+static uint16_t g_in_len = 0;
+static bool g_in_overflow = false;
+static SensorRollupPoint_t g_history_buf[SENSOR_ROLLUP_MINUTE_SLOTS];
+
+static TaskHandle_t g_shell_task = NULL;
+static StaticTask_t g_shell_task_tcb;
+static CCM_RAM StackType_t g_shell_task_stack[SHELL_TASK_STACK_SIZE]; // 栈上无 DMA 缓冲区
+
+static const char *g_level_names[] = {"trace", "debug", "info", "warn",
+                                      "error", "fatal", "off"};
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static bool shell_streq(const char *a, const char *b) {
+  while (*a && *b) {
+    char ca = (*a >= 'A' && *a <= 'Z') ? (char)(*a + 32) : *a;
+    char cb = (*b >= 'A' && *b <= 'Z') ? (char)(*b + 32) : *b;
+    if (ca != cb)
+      return false;
+    a++;
+    b++;
+  }
+  return *a == *b;
+}
+
+static bool shell_parse_uint(const char *str, uint32_t *value) {
+  char *end;
+  unsigned long v = strtoul(str, &end, 0);
+  if (end == str || *end != '\0')
+    return false;
+  *value = (uint32_t)v;
+  return true;
+}
+
+/* <名称>[:序号]，如 sht30:1 为第二个 SHT30；失败返回 SENSOR_TYPE_NONE */
+static SensorHandle_t shell_parse_sensor(const char *arg) {
+  char name[8];
+  const char *colon = strchr(arg, ':');
+  size_t len = colon != NULL ? (size_t)(colon - arg) : strlen(arg);
+  uint32_t index = 0;
+  SensorType_t type = SENSOR_TYPE_NONE;
+  SensorHandle_t sensor;
+
+  if (len < sizeof(name)) {
+    memcpy(name, arg, len);
+    name[len] = '\0';
+    if (shell_streq(name, "gy30") || shell_streq(name, "light"))
+      type = SENSOR_TYPE_GY30;
+    else if (shell_streq(name, "sht30") || shell_streq(name, "temp"))
+      type = SENSOR_TYPE_SHT30;
+    else if (shell_streq(name, "mq2") || shell_streq(name, "smoke"))
+      type = SENSOR_TYPE_SMOKE;
+  }
+  if (type == SENSOR_TYPE_NONE ||
+      (colon != NULL && !shell_parse_uint(colon + 1, &index))) {
+    printf("unknown sensor '%s' (gy30/sht30/mq2[:n])\r\n", arg);
+    return SENSOR_TYPE_NONE;
+  }
+  sensor = SensorTask_Find(type, index < SENSOR_MAX_PER_TYPE ? (uint8_t)index
+                                                              : 0xFF);
+  if (sensor == SENSOR_HANDLE_INVALID) {
+    printf("sensor '%s' not registered\r\n", arg);
+    return SENSOR_TYPE_NONE;
+  }
+  return sensor;
+}
+
+/* 实例显示名：类型名，第二个及以后的实例带 :序号 */
+static void shell_print_sensor(SensorHandle_t sensor, int width) {
+  char label[12];
+
+  if (SENSOR_HANDLE_INDEX(sensor) == 0) {
+    snprintf(label, sizeof(label), "%s",
+             SensorType_ToString(SENSOR_HANDLE_TYPE(sensor)));
+  } else {
+    snprintf(label, sizeof(label), "%s:%u",
+             SensorType_ToString(SENSOR_HANDLE_TYPE(sensor)),
+             SENSOR_HANDLE_INDEX(sensor));
+  }
+  printf("%-*s", width, label);
+}
+
+/* --------------------------- 命令实现 --------------------------- */
+
+static void shell_cmd_help(int argc, char **argv);
+
+static void shell_cmd_status(int argc, char **argv) {
+  for (uint8_t i = 0; i < SensorTask_GetSensorCount(); i++) {
+    SensorHandle_t sensor = SensorTask_GetHandleAt(i);
+    SensorStatus_t status;
+    SensorData_t data;
+
+    if (!SensorTask_GetSensorStatus(sensor, &status))
+      continue;
+    shell_print_sensor(sensor, 8);
+    printf(" %-12s", SensorStatus_ToString(status));
+
+    if (SensorTask_GetSensorData(sensor, &data) && data.is_valid) {
+      const SensorChannelDesc_t *channels;
+      uint8_t n = SensorTask_GetChannels(sensor, &channels);
+
+      for (uint8_t ch = 0; ch < n; ch++) {
+        char text[FMT_FIXED_BUF_SIZE];
+        printf(" %s %s",
+               fmt_q2(SensorChannel_Value(&channels[ch], &data), text),
+               channels[ch].unit);
+      }
+    }
+    printf("\r\n");
+  }
+  printf("log level: %s\r\n", g_level_names[log_get_level()]);
+}
+
+// 派生通道：读取时才计算 (源样本未更新时命中缓存)
+static void shell_cmd_derived(int argc, char **argv) {
+  (void)argc;
+  (void)argv;
+  for (uint8_t i = 0; i < SensorDerived_GetCount(); i++) {
+    const SensorDerivedDesc_t *desc = SensorDerived_GetDesc(i);
+    SensorDerivedStats_t st;
+    char text[FMT_FIXED_BUF_SIZE];
+    float value;
+
+    printf("  %-10s ", desc->name);
+    if (SensorDerived_Get(i, &value)) {
+      printf("%8s %-5s", fmt_q2(value, text), desc->unit);
+    } else {
+      printf("%8s %-5s", "--", desc->unit);
+    }
+    SensorDerived_GetStats(i, &st);
+    printf(" (");
+    shell_print_sensor(desc->sensor, 0);
+    printf(", computed %lu, cached %lu)\r\n", (unsigned long)st.computes,
+           (unsigned long)st.hits);
+  }
+}
+
+static void shell_cmd_interval(int argc, char **argv) {
+  uint32_t ms;
+  SensorHandle_t sensor = shell_parse_sensor(argv[1]);
+
+  if (sensor == SENSOR_TYPE_NONE)
+    return;
+  if (!shell_parse_uint(argv[2], &ms) ||
+      !SensorTask_SetUpdateInterval(sensor, ms)) {
+    printf("invalid interval (>= 100 ms)\r\n");
+    return;
+  }
+  // 配置按类型保存，只持久化各类型第一个实例的间隔
+  if (SENSOR_HANDLE_INDEX(sensor) == 0) {
+    ConfigStore_Set(CONFIG_KEY_SENSOR_INTERVAL(SENSOR_HANDLE_TYPE(sensor)), &ms,
+                    sizeof(ms));
+  }
+  printf("ok\r\n");
+}
+
+static void shell_cmd_enable(int argc, char **argv) {
+  SensorHandle_t sensor = shell_parse_sensor(argv[1]);
+  if (sensor == SENSOR_TYPE_NONE)
+    return;
+
+  bool ok = shell_streq(argv[0], "enable") ? SensorTask_EnableSensor(sensor)
+                                           : SensorTask_DisableSensor(sensor);
+  printf(ok ? "ok\r\n" : "failed\r\n");
+}
+
+static void shell_cmd_history(int argc, char **argv) {
+  SensorHandle_t sensor = shell_parse_sensor(argv[1]);
+  SensorTier_t tier = SENSOR_TIER_MINUTE;
+  uint8_t channel = 0;
+
+  if (sensor == SENSOR_TYPE_NONE)
+    return;
+  for (int i = 2; i < argc; i++) {
+    int8_t ch = SensorTask_FindChannel(sensor, argv[i]);
+    if (shell_streq(argv[i], "hour"))
+      tier = SENSOR_TIER_HOUR;
+    else if (ch >= 0)
+      channel = (uint8_t)ch;
+  }
+
+  uint16_t n = SensorTask_GetRollupHistory(sensor, channel, tier,
+                                           g_history_buf,
+                                           SENSOR_ROLLUP_MINUTE_SLOTS);
+  shell_print_sensor(sensor, 0);
+  printf(" %s history, %u points (oldest first):\r\n",
+         (tier == SENSOR_TIER_HOUR) ? "hourly" : "per-minute", n);
+  for (uint16_t i = 0; i < n; i++) {
+    if (g_history_buf[i].valid) {
+      char t[3][FMT_FIXED_BUF_SIZE];
+      printf("%3u min=%s avg=%s max=%s\r\n", i,
+             fmt_q2(g_history_buf[i].min, t[0]),
+             fmt_q2(g_history_buf[i].avg, t[1]),
+             fmt_q2(g_history_buf[i].max, t[2]));
+    } else {
+      printf("%3u -\r\n", i);
+    }
+  }
+}
+
+static void shell_cmd_loglevel(int argc, char **argv) {
+  if (argc < 2) {
+    const char *module;
+    log_level_t level;
+    printf("global: %s\r\n", g_level_names[log_get_level()]);
+    for (uint8_t i = 0; log_get_module(i, &module, &level); i++) {
+      printf("  %-14s %s\r\n", module, g_level_names[level]);
+    }
+    return;
+  }
+
+  if (shell_streq(argv[1], "reset") && argc >= 3) {
+    printf(log_clear_module_level(argv[2]) ? "ok\r\n" : "unknown module\r\n");
+    return;
+  }
+
+  for (int i = 0; i <= LOG_LEVEL_OFF; i++) {
+    if (shell_streq(argv[1], g_level_names[i])) {
+      if (argc >= 3) {
+        printf(log_set_module_level(argv[2], (log_level_t)i)
+                   ? "ok\r\n"
+                   : "unknown module\r\n");
+      } else {
+        log_set_level((log_level_t)i);
+        printf("ok\r\n");
+      }
+      return;
+    }
+  }
+  printf("levels: trace debug info warn error fatal off\r\n");
+}
+
+static void shell_cmd_prof(int argc, char **argv) {
+  if (argc >= 2 && shell_streq(argv[1], "reset")) {
+    prof_reset();
+    printf("ok\r\n");
+    return;
+  }
+  // 通过日志输出 (INFO 级别)
+  prof_dump(false);
+}
+
+/* 逐帧抓取：frames start [n] 开始，frames 查看进度，frames csv 输出 */
+static void shell_cmd_frames(int argc, char **argv) {
+  FrameStatsFrame_t f;
+  uint32_t n = 0;
+  uint16_t target;
+  uint16_t count;
+
+  if (argc >= 2 && shell_streq(argv[1], "start")) {
+    if (argc >= 3 && !shell_parse_uint(argv[2], &n)) {
+      printf("usage: frames start [n]\r\n");
+      return;
+    }
+    FrameStats_CaptureStart((uint16_t)(n > 0xFFFF ? 0xFFFF : n));
+    FrameStats_CaptureCount(&target);
+    printf("capturing %u frames\r\n", target);
+    return;
+  }
+  if (argc >= 2 && shell_streq(argv[1], "csv")) {
+    printf("frame,time_ms,screen,render_us,wait_us,px,inv_areas,inv_px\r\n");
+    for (uint16_t i = 0; FrameStats_CaptureGet(i, &f); i++) {
+      printf("%u,%lu,%u,%lu,%lu,%lu,%u,%lu\r\n", i, (unsigned long)f.time_ms,
+             f.tag, (unsigned long)f.render_us, (unsigned long)f.wait_us,
+             (unsigned long)f.px, f.inv_areas, (unsigned long)f.inv_px);
+    }
+    return;
+  }
+  count = FrameStats_CaptureCount(&target);
+  printf("captured %u/%u frames\r\n", count, target);
+}
+
+static void shell_cmd_sleep(int argc, char **argv) {
+  PowerStats_t stats;
+  uint32_t now = HAL_GetTick();
+
+  Power_GetStats(&stats);
+  printf("sleeps=%lu aborted=%lu slept=%lums (%lu%% of uptime) longest=%lums\r\n",
+         (unsigned long)stats.sleeps, (unsigned long)stats.aborted,
+         (unsigned long)stats.slept_ms,
+         (unsigned long)(now ? (uint64_t)stats.slept_ms * 100U / now : 0),
+         (unsigned long)stats.longest_ms);
+}
+
+// 按电荷量 (uA*ms) 输出一项：mAh 与统计期内的平均电流
+static void shell_energy_item(const char *name, uint64_t charge,
+                              uint32_t elapsed_ms) {
+  uint64_t uah = charge / 3600000U;
+
+  printf("  %-12s %5lu.%03lu mAh  avg %5lu uA\r\n", name,
+         (unsigned long)(uah / 1000U), (unsigned long)(uah % 1000U),
+         (unsigned long)(elapsed_ms ? charge / elapsed_ms : 0));
+}
+
+// 分子系统能耗估算 (配置表中的近似电流 x 各状态时间) / 清零重新累计
+static void shell_cmd_energy(int argc, char **argv) {
+  static EnergyStats_t st; // 较大，放静态区避免占用 shell 任务栈
+
+  if (argc > 1 && shell_streq(argv[1], "reset")) {
+    Energy_Reset();
+    printf("ok\r\n");
+    return;
+  }
+  Energy_GetStats(&st);
+  printf("elapsed=%lus\r\nloads (level 0.1%%):\r\n",
+         (unsigned long)(st.elapsed_ms / 1000U));
+  for (int r = 0; r < ENERGY_RAIL_COUNT; r++) {
+    printf("  [%4u]", (unsigned)st.rails[r].level);
+    shell_energy_item(st.rails[r].name, st.rails[r].charge, st.elapsed_ms);
+  }
+  printf("cpu:\r\n");
+  for (uint8_t i = 0; i < st.task_count; i++) {
+    shell_energy_item(st.tasks[i].name, st.tasks[i].charge, st.elapsed_ms);
+  }
+  shell_energy_item("(sleep)", st.cpu_sleep, st.elapsed_ms);
+  shell_energy_item("(other)", st.cpu_other, st.elapsed_ms);
+  printf("total:\r\n");
+  shell_energy_item("", st.total, st.elapsed_ms);
+}
+
+static void shell_cmd_boot(int argc, char **argv) {
+  static const char *state_names[] = {"pending", "running", "ok", "FAILED"};
+  const char *name;
+  BootStageInfo_t info;
+
+  for (uint8_t i = 0; BootGraph_GetStage(i, &name, &info); i++) {
+    if (info.state >= BOOT_STAGE_DONE) {
+      printf("  %-8s %-7s %5lu ~ %5lu ms (%lu ms)\r\n", name,
+             state_names[info.state], (unsigned long)info.start_ms,
+             (unsigned long)info.end_ms,
+             (unsigned long)(info.end_ms - info.start_ms));
+    } else {
+      printf("  %-8s %s\r\n", name, state_names[info.state]);
+    }
+  }
+}
+
+/* 平均值 (us)，n 为 0 时为 0 */
+static unsigned long shell_avg_us(uint64_t total_us, uint32_t n) {
+  return n != 0 ? (unsigned long)(total_us / n) : 0UL;
+}
+
+static void shell_cmd_locks(int argc, char **argv) {
+  TaskPlan_MutexStats_t st;
+  TaskPlan_CallerStats_t cs;
+
+  if (argc >= 2 && shell_streq(argv[1], "reset")) {
+    TaskPlan_ResetMutexStats();
+    printf("ok\r\n");
+    return;
+  }
+  if (argc >= 2 && shell_streq(argv[1], "tasks")) {
+    printf("  %-10s %-16s %7s %5s %4s %9s %9s %9s %9s\r\n", "mutex", "task",
+           "takes", "wait", "tmo", "maxw(us)", "avgw(us)", "maxh(us)",
+           "avgh(us)");
+    for (uint8_t i = 0; TaskPlan_GetCallerStats(i, &cs); i++) {
+      printf("  %-10s %-16.16s %7lu %5lu %4lu %9lu %9lu %9lu %9lu\r\n",
+             cs.mutex != NULL ? cs.mutex : "?", cs.task,
+             (unsigned long)cs.takes, (unsigned long)cs.waits,
+             (unsigned long)cs.timeouts, (unsigned long)cs.max_wait_us,
+             shell_avg_us(cs.wait_total_us, cs.waits),
+             (unsigned long)cs.max_hold_us,
+             shell_avg_us(cs.hold_total_us, cs.takes));
+    }
+    return;
+  }
+
+  printf("  %-10s %7s %5s %4s %5s %5s %9s %9s %9s %6s\r\n", "mutex", "takes",
+         "wait", "tmo", "inh", "over", "maxw(us)", "avgw(us)", "maxh(us)",
+         "warn");
+  for (uint8_t i = 0; TaskPlan_GetMutexStats(i, &st); i++) {
+    printf("  %-10s %7lu %5lu %4lu %5lu %5lu %9lu %9lu %9lu %6lu  %s\r\n",
+           st.name != NULL ? st.name : "?", (unsigned long)st.takes,
+           (unsigned long)st.waits, (unsigned long)st.timeouts,
+           (unsigned long)st.inherits, (unsigned long)st.over,
+           (unsigned long)st.max_wait_us,
+           shell_avg_us(st.wait_total_us, st.waits),
+           (unsigned long)st.max_hold_us, (unsigned long)(st.warn_us / 1000U),
+           st.max_holder != NULL ? pcTaskGetName((TaskHandle_t)st.max_holder)
+                                 : "-");
+  }
+}
+
+static void shell_cmd_i2c(int argc, char **argv) {
+  I2C_BusStats_t st;
+
+  (void)argc;
+  (void)argv;
+  I2C_Bus_GetStats(&st);
+  printf("  ok=%lu fail=%lu last=%lu ms max=%lu/%lu ms (normal/high)\r\n",
+         (unsigned long)st.completed, (unsigned long)st.failed,
+         (unsigned long)st.last_latency_ms,
+         (unsigned long)st.max_latency_ms[I2C_PRIORITY_NORMAL],
+         (unsigned long)st.max_latency_ms[I2C_PRIORITY_HIGH]);
+  printf("  recoveries=%lu failed=%lu retried_ok=%lu\r\n",
+         (unsigned long)st.recoveries, (unsigned long)st.recovery_failed,
+         (unsigned long)st.recovery_retried_ok);
+}
+
+static void shell_jitter_print(const char *label, const SensorJitterHist_t *h) {
+  printf("    %-8s n=%-6lu p50<=%-7lu p99<=%-7lu max=%lu us\r\n", label,
+         (unsigned long)h->count,
+         (unsigned long)SensorJitter_Percentile(h, 50),
+         (unsigned long)SensorJitter_Percentile(h, 99),
+         (unsigned long)h->max_us);
+}
+
+static void shell_cmd_jitter(int argc, char **argv) {
+  SensorJitter_t j;
+
+  if (argc >= 2 && shell_streq(argv[1], "reset")) {
+    SensorJitter_Reset(SENSOR_TYPE_NONE);
+    printf("ok\r\n");
+    return;
+  }
+  for (uint8_t i = 0; i < SensorTask_GetSensorCount(); i++) {
+    SensorHandle_t sensor = SensorTask_GetHandleAt(i);
+
+    if (!SensorJitter_Get(sensor, &j))
+      continue;
+    printf("  ");
+    shell_print_sensor(sensor, 0);
+    printf(" (interval %lu ms)\r\n",
+           (unsigned long)SensorTask_GetSampleInterval(sensor));
+    shell_jitter_print("late", &j.lateness);
+    shell_jitter_print("read", &j.duration);
+  }
+}
+
+// 端到端延迟：各阶段均从样本转换开始计时 (见 sensor_latency.h)
+static void shell_cmd_latency(int argc, char **argv) {
+  static SensorJitterHist_t hist[SENSOR_LATENCY_STAGES]; // 约 360 字节，不占用命令行任务栈
+
+  if (argc >= 2 && shell_streq(argv[1], "reset")) {
+    SensorLatency_Reset();
+    printf("ok\r\n");
+    return;
+  }
+  SensorLatency_Get(hist);
+  printf("  from conversion start:\r\n");
+  for (uint8_t i = 0; i < SENSOR_LATENCY_STAGES; i++) {
+    shell_jitter_print(SensorLatency_StageName((SensorLatencyStage_t)i), &hist[i]);
+  }
+}
+
+// 再次导出上次崩溃的记录 (二进制帧，由 crash_decode.py 解析) / 清除记录
+static void shell_cmd_crash(int argc, char **argv) {
+  if (argc > 1 && shell_streq(argv[1], "clear")) {
+    CrashDump_Clear();
+    printf("ok\r\n");
+    return;
+  }
+  if (!CrashDump_Export()) {
+    printf("no crash record\r\n");
+  }
+}
+
+// 运行日志区状态 / 按时间顺序导出最近 n 页 (记录帧由 log_decode.py 解析) / 立即写出
+static void shell_cmd_logflash(int argc, char **argv) {
+  LogFlashStats_t st;
+  uint32_t pages = 0;
+
+  if (argc > 1 && shell_streq(argv[1], "dump")) {
+    if (argc > 2 && !shell_parse_uint(argv[2], &pages)) {
+      printf("invalid page count\r\n");
+      return;
+    }
+    printf("\r\n%lu pages\r\n", (unsigned long)LogFlash_Dump(pages));
+    return;
+  }
+  if (argc > 1 && shell_streq(argv[1], "flush")) {
+    printf("%s\r\n", LogFlash_Flush() ? "ok" : "failed");
+  }
+  LogFlash_GetStats(&st);
+  printf("area=%s boot=%u next_seq=%lu pending=%u bytes\r\n",
+         st.ready ? "mounted" : "off", (unsigned)st.boot,
+         (unsigned long)st.next_seq, (unsigned)st.pending);
+  printf("records=%lu dropped=%lu pages=%lu erased=%lu errors=%lu\r\n",
+         (unsigned long)st.records, (unsigned long)st.dropped,
+         (unsigned long)st.pages_written, (unsigned long)st.sectors_erased,
+         (unsigned long)st.errors);
+}
+
+// RTOS 事件跟踪：开始/停止记录，导出为二进制帧 (由 trace_convert.py 转换)
+static void shell_cmd_trace(int argc, char **argv) {
+  RtosTraceStatus_t st;
+
+  if (argc > 1 && shell_streq(argv[1], "start")) {
+    RtosTrace_Start(argc > 2 && shell_streq(argv[2], "ring"));
+  } else if (argc > 1 && shell_streq(argv[1], "stop")) {
+    RtosTrace_Stop();
+  } else if (argc > 1 && shell_streq(argv[1], "dump")) {
+    RtosTrace_Dump();
+    return;
+  } else if (argc > 1) {
+    printf("usage: trace [start [ring]|stop|dump]\r\n");
+    return;
+  }
+  RtosTrace_GetStatus(&st);
+  printf("%s%s events=%lu/%u lost=%lu\r\n",
+         st.recording ? "recording" : "stopped", st.ring ? " (ring)" : "",
+         (unsigned long)st.count, RTOS_TRACE_EVENTS, (unsigned long)st.lost);
+}
+
+// 每行一个任务：STACK <任务名> free=<历史最小剩余字节>，由 stack_report.py 解析
+static void shell_cmd_stacks(int argc, char **argv) {
+  static SysMonitor_Snapshot_t snap; // 约 300 字节，不占用命令行任务栈
+
+  (void)argc;
+  (void)argv;
+  if (!SysMonitor_GetSnapshot(&snap)) {
+    printf("no snapshot yet\r\n");
+    return;
+  }
+  for (uint8_t i = 0; i < snap.task_count; i++) {
+    printf("STACK %s free=%u\r\n", snap.tasks[i].name,
+           snap.tasks[i].stack_free_words * 4u);
+  }
+}
+
+static void shell_cmd_probe(int argc, char **argv) {
+  SensorProbeStatus_t st;
+  SensorStatus_t status;
+
+  (void)argc;
+  (void)argv;
+  for (uint8_t i = 0; SensorProbe_GetStatus(i, &st); i++) {
+    printf("  %-6s 0x%02X  ", SensorType_ToString(st.type), st.addr);
+    if (st.handle != SENSOR_HANDLE_INVALID) {
+      shell_print_sensor(st.handle, 0);
+      printf(" %s\r\n", SensorTask_GetSensorStatus(st.handle, &status)
+                             ? SensorStatus_ToString(status)
+                             : "?");
+    } else {
+      printf("absent, %u misses, retry in %lu s\r\n", st.misses,
+             (unsigned long)(st.next_in_ms / 1000U));
+    }
+  }
+}
+
+static void shell_cmd_bench(int argc, char **argv) {
+  uint32_t suites = BENCH_SUITE_ALL;
+
+  if (argc >= 2) {
+    suites = Bench_ParseSuite(argv[1]);
+    if (suites == 0) {
+      printf("usage: bench [lcd|lvgl|i2c|log|sensor|eeprom|all]\r\n");
+      return;
+    }
+  }
+  Bench_Run(suites);
+}
+
+#define SHELL_REPLAY_USAGE                                                     \
+  "capture on|off|<sensor> start|stop|<sensor> push <v0> [v1]"
+
+static void shell_cmd_replay(int argc, char **argv) {
+  SensorReplayStatus_t st;
+  SensorHandle_t sensor;
+
+  if (argc == 1) {
+    printf("capture=%s\r\n", SensorReplay_IsCapturing() ? "on" : "off");
+    for (uint8_t i = 0; i < SensorTask_GetSensorCount(); i++) {
+      sensor = SensorTask_GetHandleAt(i);
+      if (!SensorReplay_GetStatus(sensor, &st) || !st.active)
+        continue;
+      printf("  ");
+      shell_print_sensor(sensor, 8);
+      printf(" queued=%u played=%lu underruns=%lu dropped=%lu\r\n", st.queued,
+             (unsigned long)st.played, (unsigned long)st.underruns,
+             (unsigned long)st.dropped);
+    }
+    return;
+  }
+  if (shell_streq(argv[1], "capture") && argc >= 3) {
+    SensorReplay_SetCapture(shell_streq(argv[2], "on"));
+    printf("ok\r\n");
+    return;
+  }
+
+  sensor = shell_parse_sensor(argv[1]);
+  if (sensor == SENSOR_TYPE_NONE || argc < 3) {
+    printf("usage: replay " SHELL_REPLAY_USAGE "\r\n");
+    return;
+  }
+  if (shell_streq(argv[2], "push")) {
+    float values[SENSOR_MAX_CHANNELS];
+    uint8_t n = 0;
+
+    for (int i = 3; i < argc && n < SENSOR_MAX_CHANNELS; i++) {
+      char *end;
+      values[n] = strtof(argv[i], &end);
+      if (end == argv[i] || *end != '\0') {
+        printf("bad value '%s'\r\n", argv[i]);
+        return;
+      }
+      n++;
+    }
+    // 成功时不回复，主机可以按录制节奏连续发送
+    if (n == 0 || !SensorReplay_Push(sensor, values, n)) {
+      printf("push rejected\r\n");
+    }
+    return;
+  }
+  if (shell_streq(argv[2], "start") ? SensorReplay_Start(sensor)
+      : shell_streq(argv[2], "stop") ? SensorReplay_Stop(sensor)
+                                     : false) {
+    printf("ok\r\n");
+  } else {
+    printf("failed\r\n");
+  }
+}
+
+static void shell_cmd_led(int argc, char **argv) {
+  uint32_t r, g, b;
+
+  if (shell_streq(argv[1], "off")) {
+    Drivers_RGBLED_SetMode(LED_MODE_MANUAL);
+    Drivers_RGBLED_Off();
+  } else if (shell_streq(argv[1], "auto")) {
+    Drivers_RGBLED_SetMode(LED_MODE_AUTO);
+  } else if (argc >= 4 && shell_parse_uint(argv[1], &r) &&
+             shell_parse_uint(argv[2], &g) && shell_parse_uint(argv[3], &b) &&
+             r <= 255 && g <= 255 && b <= 255) {
+    Drivers_RGBLED_SetMode(LED_MODE_MANUAL);
+    Drivers_RGBLED_SetColor((RGB_Color){(uint8_t)r, (uint8_t)g, (uint8_t)b});
+  } else {
+    printf("usage: led off|auto|<r> <g> <b>\r\n");
+    return;
+  }
+  printf("ok\r\n");
+}
+
+static void shell_cmd_motor(int argc, char **argv) {
+  uint32_t speed;
+
+  if (shell_streq(argv[1], "auto")) {
+    Drivers_Motor_SetMode(MOTOR_MODE_AUTO);
+  } else if (shell_streq(argv[1], "vent")) {
+    Drivers_Motor_SetMode(MOTOR_MODE_VENT);
+  } else if (shell_parse_uint(argv[1], &speed) && speed <= 999) {
+    Drivers_Motor_SetMode(MOTOR_MODE_MANUAL);
+    Drivers_Motor_SetSpeed((uint16_t)speed);
+  } else {
+    printf("usage: motor auto|vent|<0-999>\r\n");
+    return;
+  }
+  printf("ok\r\n");
+}
+
+static void shell_cmd_buzzer(int argc, char **argv) {
+  uint32_t freq;
+
+  if (shell_streq(argv[1], "off")) {
+    Drivers_Buzzer_Off();
+  } else if (shell_streq(argv[1], "beep")) {
+    Drivers_Buzzer_Beep();
+  } else if (shell_parse_uint(argv[1], &freq) && freq <= 20000) {
+    Drivers_Buzzer_On((uint16_t)freq);
+  } else {
+    printf("usage: buzzer off|beep|<hz>\r\n");
+    return;
+  }
+  printf("ok\r\n");
+}
+
+static int shell_hex_nibble(char ch) {
+  if (ch >= '0' && ch <= '9')
+    return ch - '0';
+  if (ch >= 'a' && ch <= 'f')
+    return ch - 'a' + 10;
+  if (ch >= 'A' && ch <= 'F')
+    return ch - 'A' + 10;
+  return -1;
+}
+
+/* 十六进制字符串转字节，返回字节数；含非法字符、奇数长度或超长时返回 0 */
+static uint32_t shell_parse_hex(const char *hex, uint8_t *buf, uint32_t cap) {
+  uint32_t n = 0;
+  while (hex[0] && hex[1] && n < cap) {
+    int hi = shell_hex_nibble(hex[0]), lo = shell_hex_nibble(hex[1]);
+    if (hi < 0 || lo < 0)
+      return 0;
+    buf[n++] = (uint8_t)((hi << 4) | lo);
+    hex += 2;
+  }
+  return *hex == '\0' ? n : 0;
+}
+
+/**
+ * @brief 外部 SPI Flash 读写 (供 asset_pack.py 烧写图片资源包)
+ * @note  一行最多 SHELL_LINE_MAX 字符，write 每次写 16 字节；
+ *        erase 按 4 KB 扇区擦除覆盖 [addr, addr + len) 的全部扇区
+ */
+#define SHELL_FLASH_USAGE "id|read|erase|crc <addr> [len]|write <addr> <hex>"
+
+static void shell_cmd_flash(int argc, char **argv) {
+  static uint8_t buf[32];
+  uint32_t addr = 0, len = 1;
+
+  if (!norflash_is_ready()) {
+    printf("flash not ready\r\n");
+    return;
+  }
+  if (shell_streq(argv[1], "id")) {
+    printf("id=0x%06lX size=%lu\r\n", (unsigned long)norflash_read_id(),
+           (unsigned long)norflash_get_size());
+    return;
+  }
+  if (argc < 3 || !shell_parse_uint(argv[2], &addr) ||
+      (argc >= 4 && !shell_streq(argv[1], "write") &&
+       !shell_parse_uint(argv[3], &len))) {
+    printf("usage: flash " SHELL_FLASH_USAGE "\r\n");
+    return;
+  }
+
+  if (shell_streq(argv[1], "read")) {
+    if (len > sizeof(buf))
+      len = sizeof(buf);
+    if (norflash_read(addr, buf, len) != 0) {
+      printf("error\r\n");
+      return;
+    }
+    for (uint32_t i = 0; i < len; i++)
+      printf("%02X", buf[i]);
+    printf("\r\n");
+  } else if (shell_streq(argv[1], "erase")) {
+    uint32_t end = addr + len;
+    for (addr &= ~(uint32_t)(NORFLASH_SECTOR_SIZE - 1); addr < end;
+         addr += NORFLASH_SECTOR_SIZE) {
+      if (norflash_erase_sector(addr) != 0) {
+        printf("error at 0x%06lX\r\n", (unsigned long)addr);
+        return;
+      }
+      TaskWdt_CheckIn(); // 大范围擦除可持续数十秒
+    }
+    printf("ok\r\n");
+  } else if (shell_streq(argv[1], "write") && argc >= 4) {
+    uint32_t n = shell_parse_hex(argv[3], buf, sizeof(buf));
+    if (n == 0) {
+      printf("invalid hex\r\n");
+      return;
+    }
+    printf(norflash_write(addr, buf, n) == 0 ? "ok\r\n" : "error\r\n");
+  } else if (shell_streq(argv[1], "crc")) {
+    uint32_t crc = 0, chunk;
+    while (len > 0) {
+      chunk = (len > sizeof(buf)) ? sizeof(buf) : len;
+      if (norflash_read(addr, buf, chunk) != 0) {
+        printf("error\r\n");
+        return;
+      }
+      crc = CRC32_Update(crc, buf, chunk);
+      addr += chunk;
+      len -= chunk;
+    }
+    printf("crc=0x%08lX\r\n", (unsigned long)crc);
+  } else {
+    printf("usage: flash " SHELL_FLASH_USAGE "\r\n");
+  }
+}
+
+/**
+ * @brief 外部 Flash 中的传感器记录：统计或按区间聚合输出
+ */
+#define SHELL_DATALOG_USAGE "stats|flush|<sensor> <minutes> [res_s]"
+
+static bool shell_datalog_point(const SensorLogPoint_t *point, void *user) {
+  uint32_t now = *(const uint32_t *)user;
+  char t[3][FMT_FIXED_BUF_SIZE];
+
+  printf("-%lus n=%u min=%s avg=%s max=%s",
+         (unsigned long)(now - point->time), point->samples,
+         fmt_q2(point->value[0].min, t[0]), fmt_q2(point->value[0].avg, t[1]),
+         fmt_q2(point->value[0].max, t[2]));
+  if (point->value[1].valid) {
+    printf(" | %s/%s/%s", fmt_q2(point->value[1].min, t[0]),
+           fmt_q2(point->value[1].avg, t[1]),
+           fmt_q2(point->value[1].max, t[2]));
+  }
+  printf("\r\n");
+  return true;
+}
+
+static void shell_cmd_datalog(int argc, char **argv) {
+  SensorLogStats_t stats;
+  uint32_t minutes, res = 60, now, n;
+  SensorHandle_t sensor;
+
+  if (shell_streq(argv[1], "stats")) {
+    SensorLog_GetStats(&stats);
+    if (!stats.ready) {
+      printf("datalog not ready\r\n");
+      return;
+    }
+    printf("now=%lus oldest=%lus batch=%u records=%lu pages=%lu erased=%lu "
+           "errors=%lu\r\n",
+           (unsigned long)stats.now, (unsigned long)stats.oldest_time,
+           stats.batch_count, (unsigned long)stats.records,
+           (unsigned long)stats.pages_written,
+           (unsigned long)stats.sectors_erased, (unsigned long)stats.errors);
+    printf("mirror=%u sectors, mapped=%lu read=%lu pages\r\n",
+           stats.mirror_sectors, (unsigned long)stats.mapped_pages,
+           (unsigned long)stats.read_pages);
+    return;
+  }
+  if (shell_streq(argv[1], "flush")) {
+    printf(SensorLog_Flush() ? "ok\r\n" : "error\r\n");
+    return;
+  }
+
+  if (argc < 3) {
+    printf("usage: datalog " SHELL_DATALOG_USAGE "\r\n");
+    return;
+  }
+  sensor = shell_parse_sensor(argv[1]);
+  if (sensor == SENSOR_TYPE_NONE)
+    return;
+  if (!shell_parse_uint(argv[2], &minutes) || minutes == 0 ||
+      (argc > 3 && !shell_parse_uint(argv[3], &res))) {
+    printf("usage: datalog " SHELL_DATALOG_USAGE "\r\n");
+    return;
+  }
+
+  now = SensorLog_Now();
+  n = SensorLog_Query(sensor, minutes * 60 < now ? now - minutes * 60 : 0, now,
+                      res, shell_datalog_point, &now);
+  printf("%lu points\r\n", (unsigned long)n);
+}
+
+/**
+ * @brief 二进制导出传感器记录 (由 sensor_export.py 调用并解码为 CSV)
+ * @note  时间为日志时间 (s)，可先用 datalog stats 查询 now/oldest；
+ *        续传时保持相同区间，seq 为第一个缺失的数据帧序号
+ */
+static void shell_cmd_export(int argc, char **argv) {
+  SensorHandle_t sensor = SENSOR_TYPE_NONE;
+  uint32_t t_start, t_end, seq = 0;
+
+  if (!shell_streq(argv[1], "all")) {
+    sensor = shell_parse_sensor(argv[1]);
+    if (sensor == SENSOR_TYPE_NONE)
+      return;
+  }
+  if (!shell_parse_uint(argv[2], &t_start) || !shell_parse_uint(argv[3], &t_end) ||
+      (argc > 4 && (!shell_parse_uint(argv[4], &seq) || seq > UINT16_MAX))) {
+    printf("usage: export <sensor|all> <t_start> <t_end> [seq]\r\n");
+    return;
+  }
+  SensorExport_Run(sensor, t_start, t_end, (uint16_t)seq);
+}
+
+/**
+ * @brief 遥测上行状态 / 立即封存并发送当前批次
+ */
+static void shell_cmd_telemetry(int argc, char **argv) {
+  TelemetryStats_t stats;
+  EspAtStats_t at;
+
+  if (argc > 1 && shell_streq(argv[1], "flush")) {
+    Telemetry_Flush();
+    printf("ok\r\n");
+    return;
+  }
+  Telemetry_GetStats(&stats);
+  EspAt_GetStats(&at);
+  printf("state=%s pending=%u building=%u retry_in=%lus schema=%08lX\r\n",
+         Telemetry_StateName(stats.state), stats.pending, stats.building,
+         (unsigned long)stats.retry_in_s, (unsigned long)stats.schema_id);
+  printf("sent batches=%lu records=%lu bytes=%lu dropped batches=%lu "
+         "records=%lu\r\n",
+         (unsigned long)stats.batches_sent, (unsigned long)stats.records_sent,
+         (unsigned long)stats.bytes_sent, (unsigned long)stats.batches_dropped,
+         (unsigned long)stats.records_dropped);
+  printf("failures=%lu reconnects=%lu sntp=%lu/%lu at: cmds=%lu timeouts=%lu "
+         "errors=%lu uart=%lu ip=%d link=%d\r\n",
+         (unsigned long)stats.send_failures, (unsigned long)stats.reconnects,
+         (unsigned long)stats.sntp_syncs,
+         (unsigned long)(stats.sntp_syncs + stats.sntp_failures),
+         (unsigned long)at.commands, (unsigned long)at.timeouts,
+         (unsigned long)at.errors, (unsigned long)at.uart_errors, at.has_ip,
+         at.linked);
+  if (stats.outbox) {
+    printf("outbox=%lus ack=%lu replayed batches=%lu records=%lu order=%s\r\n",
+           (unsigned long)stats.outbox_s, (unsigned long)stats.ack_time,
+           (unsigned long)stats.replay_batches,
+           (unsigned long)stats.replay_records,
+           TELEMETRY_OUTBOX_ORDER == TELEMETRY_OUTBOX_NEWEST_FIRST ? "newest"
+                                                                   : "oldest");
+  }
+  if (TELEMETRY_METRICS_INTERVAL_S != 0) {
+    printf("metrics every %us sent=%lu\r\n",
+           (unsigned)TELEMETRY_METRICS_INTERVAL_S,
+           (unsigned long)stats.metrics_sent);
+  }
+  if (TELEMETRY_MODE == TELEMETRY_MODE_EDGE) {
+    printf("edge window=%us summaries=%lu events=%lu\r\n",
+           (unsigned)TELEMETRY_EDGE_WINDOW_S,
+           (unsigned long)stats.edge_summaries,
+           (unsigned long)stats.edge_events);
+  }
+}
+
+/**
+ * @brief Modbus 网关统计与各节点状态
+ */
+static void shell_print_gateway(void) {
+  ModbusGatewayStats_t stats;
+  ModbusGatewayNode_t node;
+
+  ModbusGateway_GetStats(&stats);
+  printf("gateway baud=%lu cycles=%lu requests=%lu responses=%lu "
+         "timeouts=%lu crc_errors=%lu exceptions=%lu stray=%lu\r\n",
+         (unsigned long)MODBUS_BAUDRATE, (unsigned long)stats.cycles,
+         (unsigned long)stats.requests, (unsigned long)stats.responses,
+         (unsigned long)stats.timeouts, (unsigned long)stats.crc_errors,
+         (unsigned long)stats.exceptions, (unsigned long)stats.stray);
+  printf("nodes_online=%u remotes=%u cycle_max=%lums\r\n",
+         (unsigned)stats.nodes_online, (unsigned)stats.remotes,
+         (unsigned long)stats.cycle_ms_max);
+  for (uint8_t i = 0; ModbusGateway_GetNode(i, &node); i++) {
+    printf("  node %3u %-7s sensors=%u imported=%u requests=%lu misses=%lu\r\n",
+           (unsigned)node.addr, node.online ? "online" : "offline",
+           (unsigned)node.sensors, (unsigned)node.imported,
+           (unsigned long)node.requests, (unsigned long)node.misses);
+  }
+}
+
+/**
+ * @brief Modbus 从站 (或网关) 统计
+ */
+static void shell_cmd_modbus(int argc, char **argv) {
+  ModbusSlaveStats_t stats;
+  RS485_Stats_t bus;
+
+  (void)argc;
+  (void)argv;
+  if (MODBUS_GATEWAY_NODE_COUNT > 0) {
+    shell_print_gateway();
+  } else {
+    ModbusSlave_GetStats(&stats);
+    printf("addr=%u baud=%lu requests=%lu exceptions=%lu crc_errors=%lu "
+           "foreign=%lu updates=%lu\r\n",
+           (unsigned)MODBUS_SLAVE_ADDRESS, (unsigned long)MODBUS_BAUDRATE,
+           (unsigned long)stats.requests, (unsigned long)stats.exceptions,
+           (unsigned long)stats.crc_errors, (unsigned long)stats.foreign,
+           (unsigned long)stats.updates);
+  }
+  RS485_GetStats(&bus);
+  printf("rs485: rx=%lu tx=%lu overruns=%lu uart_errors=%lu\r\n",
+         (unsigned long)bus.rx_frames, (unsigned long)bus.tx_frames,
+         (unsigned long)bus.rx_overruns, (unsigned long)bus.uart_errors);
+}
+
+/**
+ * @brief USB 虚拟串口状态
+ */
+static void shell_cmd_usb(int argc, char **argv) {
+  UsbCdc_Stats_t stats;
+
+  (void)argc;
+  (void)argv;
+  UsbCdc_GetStats(&stats);
+  printf("port=%s line_rate=%lu resets=%lu suspends=%lu\r\n",
+         UsbCdc_IsOpen() ? "open" : "closed",
+         (unsigned long)UsbCdc_GetLineRate(), (unsigned long)stats.bus_resets,
+         (unsigned long)stats.suspends);
+  printf("tx=%lu bytes in %lu transfers aborted=%lu rx=%lu bytes\r\n",
+         (unsigned long)stats.tx_bytes, (unsigned long)stats.tx_transfers,
+         (unsigned long)stats.tx_aborted, (unsigned long)stats.rx_bytes);
+}
+
+/**
+ * @brief 以太网上行状态
+ */
+static void shell_cmd_net(int argc, char **argv) {
+  NetUdp_Stats_t net;
+  EthMac_Stats_t mac;
+
+  (void)argc;
+  (void)argv;
+  NetUdp_GetStats(&net);
+  EthMac_GetStats(&mac);
+  printf("link=%s next_hop=%s sent=%lu (%lu bytes) failures=%lu\r\n",
+         net.link ? "up" : "down", net.resolved ? "resolved" : "-",
+         (unsigned long)net.datagrams_sent, (unsigned long)net.bytes_sent,
+         (unsigned long)net.send_failures);
+  printf("arp req=%lu reply=%lu ping=%lu\r\n", (unsigned long)net.arp_requests,
+         (unsigned long)net.arp_replies, (unsigned long)net.icmp_echoes);
+  printf("mac tx=%lu err=%lu rx=%lu err=%lu missed=%lu link_changes=%lu\r\n",
+         (unsigned long)mac.tx_frames, (unsigned long)mac.tx_errors,
+         (unsigned long)mac.rx_frames, (unsigned long)mac.rx_errors,
+         (unsigned long)mac.rx_missed, (unsigned long)mac.link_changes);
+}
+
+/**
+ * @brief CAN 传感器网络状态
+ */
+static void shell_cmd_can(int argc, char **argv) {
+  CanNetStats_t net;
+  CanBus_Stats_t bus;
+
+  (void)argc;
+  (void)argv;
+  if (CAN_NET_NODE_ID == 0) {
+    printf("can network disabled\r\n");
+    return;
+  }
+  CanNet_GetStats(&net);
+  CanBus_GetStats(&bus);
+  printf("node=%u sent=%lu heartbeats=%lu retries=%lu\r\n",
+         (unsigned)CAN_NET_NODE_ID, (unsigned long)net.frames_sent,
+         (unsigned long)net.heartbeats_sent, (unsigned long)net.send_retries);
+  printf("received=%lu ignored=%lu remotes=%u online=%u\r\n",
+         (unsigned long)net.frames_received, (unsigned long)net.frames_ignored,
+         (unsigned)net.remotes, (unsigned)net.remotes_online);
+  printf("bus rx=%lu dropped=%lu overruns=%lu tec=%u rec=%u lec=%u%s\r\n",
+         (unsigned long)bus.rx_frames, (unsigned long)bus.rx_dropped,
+         (unsigned long)bus.fifo_overruns, (unsigned)bus.tx_errors,
+         (unsigned)bus.rx_errors, (unsigned)bus.last_error,
+         bus.bus_off ? " bus-off" : "");
+}
+
+/**
+ * @brief SD 卡归档状态 (flush: 立即写出未满的批)
+ */
+static void shell_cmd_archive(int argc, char **argv) {
+  SdArchive_Stats_t stats;
+  SdCard_Stats_t card;
+
+  if (argc > 1 && strcmp(argv[1], "flush") == 0) {
+    SdArchive_RequestFlush();
+  }
+  SdArchive_GetStats(&stats);
+  SdCard_GetStats(&card);
+  printf("card=%s %luMB file=%s batches=%u/%u created=%lu\r\n",
+         stats.mounted ? "mounted" : "off",
+         (unsigned long)(SdCard_GetSectorCount() / 2048U),
+         stats.file[0] != '\0' ? stats.file : "-", stats.batches_used,
+         stats.batches_total, (unsigned long)stats.files_created);
+  printf("pages in=%lu written=%lu dropped=%lu batches=%lu partial=%lu\r\n",
+         (unsigned long)stats.pages_appended, (unsigned long)stats.pages_written,
+         (unsigned long)stats.pages_dropped, (unsigned long)stats.batches_written,
+         (unsigned long)stats.partial_flushes);
+  printf("write_max=%lums errors=%lu sd: reads=%lu writes=%lu sectors=%lu "
+         "erases=%lu errors=%lu\r\n",
+         (unsigned long)stats.write_ms_max, (unsigned long)stats.errors,
+         (unsigned long)card.reads, (unsigned long)card.writes,
+         (unsigned long)card.sectors_written, (unsigned long)card.erases,
+         (unsigned long)card.errors);
+}
+
+/**
+ * @brief 在线升级 (供 ota_pack.py 通过命令行传输镜像)
+ * @note  write 每行一个分块 (最多 64 字节)，末尾为该分块的 CRC-32；
+ *        分块写入外部 Flash 暂存槽，期间采样与界面照常运行
+ */
+#define SHELL_OTA_USAGE                                                        \
+  "[begin <size> <crc> <ver>|write <off> <hex> <crc>|commit|abort|reboot]"
+
+static void shell_cmd_ota(int argc, char **argv) {
+  static uint8_t chunk[64];
+  OtaStatus_t status;
+  uint32_t a = 0, b = 0, c = 0;
+  bool ok;
+
+  if (argc == 1) {
+    OtaUpdate_GetStatus(&status);
+    printf("state=%s version=%lu size=%lu received=%lu trial_boots=%u "
+           "rolled_back=%d\r\n",
+           OtaUpdate_StateName(status.state), (unsigned long)status.version,
+           (unsigned long)status.size, (unsigned long)status.received,
+           (unsigned)status.trial_boots, status.rolled_back);
+    return;
+  }
+
+  if (shell_streq(argv[1], "begin") && argc >= 5 &&
+      shell_parse_uint(argv[2], &a) && shell_parse_uint(argv[3], &b) &&
+      shell_parse_uint(argv[4], &c)) {
+    ok = OtaUpdate_Begin(a, b, c);
+  } else if (shell_streq(argv[1], "write") && argc >= 5 &&
+             shell_parse_uint(argv[2], &a) && shell_parse_uint(argv[4], &c)) {
+    uint32_t n = shell_parse_hex(argv[3], chunk, sizeof(chunk));
+    if (n == 0 || CRC32_Compute(chunk, n) != c) {
+      printf("invalid chunk\r\n"); // 主机重发该分块
+      return;
+    }
+    ok = OtaUpdate_Write(a, chunk, n);
+  } else if (shell_streq(argv[1], "commit")) {
+    ok = OtaUpdate_Commit();
+  } else if (shell_streq(argv[1], "abort")) {
+    OtaUpdate_Abort();
+    ok = true;
+  } else if (shell_streq(argv[1], "reboot")) {
+    printf("rebooting\r\n");
+    SensorLog_Flush();
+    ConfigStore_Flush();
+    vTaskDelay(pdMS_TO_TICKS(50)); // 等待应答发送完
+    NVIC_SystemReset();
+    return;
+  } else {
+    printf("usage: ota " SHELL_OTA_USAGE "\r\n");
+    return;
+  }
+  printf(ok ? "ok\r\n" : "error\r\n");
+}
+
+/* 波特率切换：切换后须在新波特率下收到 "baud ok"，否则超时恢复原值 */
+static const uint32_t g_baud_rates[] = {115200, 230400, 460800, 921600,
+                                        1000000, 2000000};
+static bool g_baud_pending = false;
+static uint32_t g_baud_prev;
+static uint32_t g_baud_deadline;
+
+static bool shell_baud_supported(uint32_t rate) {
+  for (uint32_t i = 0; i < sizeof(g_baud_rates) / sizeof(g_baud_rates[0]); i++) {
+    if (g_baud_rates[i] == rate)
+      return true;
+  }
+  return false;
+}
+
+/**
+ * @brief 修改命令行串口波特率
+ * @note  先以原波特率回复，缓冲区发完后切换；主机须在 SHELL_BAUD_CONFIRM_MS 内
+ *        以新波特率发送 "baud ok"，确认后写入配置存储，否则自动恢复原波特率。
+ *        USART1 挂在 APB2 (84 MHz)，16 倍过采样下 2 Mbps 以内误差均小于 1%
+ */
+static void shell_cmd_baud(int argc, char **argv) {
+  uint32_t rate = 0;
+
+  if (argc < 2) {
+    printf("baud=%lu\r\n", (unsigned long)g_shell_uart->Init.BaudRate);
+    return;
+  }
+  if (shell_streq(argv[1], "ok")) {
+    if (g_baud_pending) {
+      g_baud_pending = false;
+      rate = g_shell_uart->Init.BaudRate;
+      ConfigStore_Set(CONFIG_KEY_UART_BAUD, &rate, sizeof(rate));
+      printf("baud %lu saved\r\n", (unsigned long)rate);
+    }
+    return;
+  }
+  if (!shell_parse_uint(argv[1], &rate) || !shell_baud_supported(rate)) {
+    printf("supported: 115200 230400 460800 921600 1000000 2000000\r\n");
+    return;
+  }
+
+  printf("ok, send 'baud ok' at %lu within %u ms\r\n", (unsigned long)rate,
+         SHELL_BAUD_CONFIRM_MS);
+  if (!g_baud_pending) {
+    g_baud_prev = g_shell_uart->Init.BaudRate; // 连续切换时恢复到最初的值
+  }
+  if (printf_set_baudrate(rate)) {
+    g_baud_pending = true;
+    g_baud_deadline = HAL_GetTick() + SHELL_BAUD_CONFIRM_MS;
+  }
+}
+
+/* 未确认的波特率超时后恢复 */
+static void shell_baud_check_timeout(void) {
+  if (g_baud_pending && (int32_t)(HAL_GetTick() - g_baud_deadline) >= 0) {
+    g_baud_pending = false;
+    printf_set_baudrate(g_baud_prev);
+    LOG_WARN("波特率切换未确认，恢复 %lu", (unsigned long)g_baud_prev);
+  }
+}
+
+static void shell_cmd_date(int argc, char **argv) {
+  RtcDateTime_t dt;
+  RtcClockSyncStats_t sync;
+  unsigned y, mo, d, h, mi, sec;
+
+  if (argc >= 3) {
+    if (sscanf(argv[1], "%u-%u-%u", &y, &mo, &d) != 3 ||
+        sscanf(argv[2], "%u:%u:%u", &h, &mi, &sec) != 3) {
+      printf("usage: date YYYY-MM-DD HH:MM:SS\r\n");
+      return;
+    }
+    dt.year = (uint16_t)y;
+    dt.month = (uint8_t)mo;
+    dt.day = (uint8_t)d;
+    dt.hour = (uint8_t)h;
+    dt.minute = (uint8_t)mi;
+    dt.second = (uint8_t)sec;
+    if (!RtcClock_Set(&dt)) {
+      printf("invalid time or RTC not running\r\n");
+      return;
+    }
+  }
+
+  RtcClock_ToDateTime(RtcClock_Now(), &dt);
+  printf("%04u-%02u-%02u %02u:%02u:%02u%s\r\n", dt.year, dt.month, dt.day,
+         dt.hour, dt.minute, dt.second, RtcClock_IsSet() ? "" : " (not set)");
+  RtcClock_GetSyncStats(&sync);
+  if (sync.syncs != 0) {
+    printf("sync: syncs=%lu steps=%lu offset=%ldms slew=%ldms trim=%dppm\r\n",
+           (unsigned long)sync.syncs, (unsigned long)sync.steps,
+           (long)sync.last_offset_ms, (long)sync.slew_ms, (int)sync.trim_ppm);
+  }
+}
+
+static void shell_cmd_alarm(int argc, char **argv) {
+  static const char *cond_names[] = {">", "<", "rise", "fall"};
+  uint8_t count = SensorAlarm_GetRuleCount();
+
+  for (uint8_t i = 0; i < count; i++) {
+    const SensorAlarmRule_t *rule;
+    SensorAlarmState_t state;
+    char t[2][FMT_FIXED_BUF_SIZE];
+
+    if (!SensorAlarm_GetRule(i, &rule, &state))
+      continue;
+    printf("%-10s %-6s %-4s %s %-7s last=%s count=%lu\r\n", rule->name,
+           SensorType_ToString(rule->sensor), cond_names[rule->cond],
+           fmt_q2(rule->threshold, t[0]),
+           state.active ? "ACTIVE" : (state.pending ? "pending" : "idle"),
+           fmt_q2(state.last_value, t[1]), (unsigned long)state.trigger_count);
+  }
+}
+
+/* 指标注册表：上电以来的累计值 (直方图分位数为所在桶的上界) */
+static void shell_cmd_metrics(int argc, char **argv) {
+  MetricSnapshot_t snap;
+  char line[METRICS_LINE_MAX];
+
+  if (argc > 1 && shell_streq(argv[1], "reset")) {
+    Metrics_Reset();
+    printf("ok\r\n");
+    return;
+  }
+  for (int id = 0; id < METRIC_MAX; id++) {
+    if (Metrics_Read((MetricId_t)id, &snap)) {
+      Metrics_Format(&snap, line, sizeof(line));
+      printf("%s\r\n", line);
+    }
+  }
+}
+
+#define SHELL_CONFIG_USAGE                                                     \
+  "[begin|commit|abort|interval <sensor> <ms>|slot <1-3> <r> <g> <b>|"          \
+  "log <level>|alarm <n> <threshold> [hyst]]"
+
+static RuntimeConfig_t *g_config_draft; // config begin 之后累积修改的草稿
+
+static void shell_config_show(void) {
+  const RuntimeConfig_t *cfg = RuntimeConfig_Current();
+  char t[2][FMT_FIXED_BUF_SIZE];
+
+  if (cfg == NULL) {
+    printf("not published (module defaults)\r\n");
+    return;
+  }
+  printf("version %lu%s\r\n", (unsigned long)cfg->version,
+         g_config_draft != NULL ? " (editing)" : "");
+  for (int type = SENSOR_TYPE_GY30; type < SENSOR_TYPE_MAX; type++) {
+    if (cfg->interval_ms[type] != 0) {
+      printf("interval %-6s %lu ms\r\n", SensorType_ToString((SensorType_t)type),
+             (unsigned long)cfg->interval_ms[type]);
+    }
+  }
+  for (uint8_t i = 0; i < RUNTIME_CONFIG_LED_SLOTS; i++) {
+    printf("slot %u %u %u %u\r\n", i + 1, cfg->led_slots[i].R,
+           cfg->led_slots[i].G, cfg->led_slots[i].B);
+  }
+  printf("log %s\r\n", g_level_names[cfg->log_level]);
+  for (uint8_t i = 0; i < cfg->alarm_count; i++) {
+    printf("alarm %u %-10s %s hyst %s\r\n", i, cfg->alarm_names[i],
+           fmt_q2(cfg->alarm_rules[i].threshold, t[0]),
+           fmt_q2(cfg->alarm_rules[i].hysteresis, t[1]));
+  }
+}
+
+/* 把一项修改写入草稿，参数错误时返回 false */
+static bool shell_config_set(RuntimeConfig_t *cfg, int argc, char **argv) {
+  uint32_t n, r, g, b;
+  char *end;
+
+  if (shell_streq(argv[1], "interval") && argc >= 4) {
+    SensorHandle_t sensor = shell_parse_sensor(argv[2]);
+    if (sensor == SENSOR_TYPE_NONE)
+      return false;
+    if (!shell_parse_uint(argv[3], &n))
+      return false;
+    cfg->interval_ms[SENSOR_HANDLE_TYPE(sensor)] = n; // 范围在发布时校验
+    return true;
+  }
+  if (shell_streq(argv[1], "slot") && argc >= 6) {
+    if (!shell_parse_uint(argv[2], &n) || n < 1 ||
+        n > RUNTIME_CONFIG_LED_SLOTS || !shell_parse_uint(argv[3], &r) ||
+        !shell_parse_uint(argv[4], &g) || !shell_parse_uint(argv[5], &b) ||
+        r > 255 || g > 255 || b > 255)
+      return false;
+    cfg->led_slots[n - 1] = (RGB_Color){(uint8_t)r, (uint8_t)g, (uint8_t)b};
+    return true;
+  }
+  if (shell_streq(argv[1], "log") && argc >= 3) {
+    for (uint8_t i = 0; i <= LOG_LEVEL_OFF; i++) {
+      if (shell_streq(argv[2], g_level_names[i])) {
+        cfg->log_level = i;
+        return true;
+      }
+    }
+    return false;
+  }
+  if (shell_streq(argv[1], "alarm") && argc >= 4) {
+    if (!shell_parse_uint(argv[2], &n) || n >= cfg->alarm_count)
+      return false;
+    cfg->alarm_rules[n].threshold = strtof(argv[3], &end);
+    if (end == argv[3] || *end != '\0')
+      return false;
+    if (argc >= 5) {
+      cfg->alarm_rules[n].hysteresis = strtof(argv[4], &end);
+      if (end == argv[4] || *end != '\0')
+        return false;
+    }
+    return true;
+  }
+  return false;
+}
+
+static void shell_config_publish(void) {
+  const char *error = NULL;
+
+  if (RuntimeConfig_Publish(&error)) {
+    printf("ok\r\n");
+  } else {
+    printf("rejected: %s\r\n", error);
+  }
+}
+
+/* 运行时配置：单项修改立即发布；begin 之后的修改累积到 commit 时一次发布 */
+static void shell_cmd_config(int argc, char **argv) {
+  RuntimeConfig_t *cfg;
+
+  if (argc < 2) {
+    shell_config_show();
+    return;
+  }
+  if (shell_streq(argv[1], "begin")) {
+    if (g_config_draft == NULL)
+      g_config_draft = RuntimeConfig_Edit();
+    printf(g_config_draft != NULL ? "editing\r\n" : "busy, try again\r\n");
+    return;
+  }
+  if (shell_streq(argv[1], "commit") || shell_streq(argv[1], "abort")) {
+    if (g_config_draft == NULL) {
+      printf("not editing\r\n");
+      return;
+    }
+    g_config_draft = NULL;
+    if (shell_streq(argv[1], "commit")) {
+      shell_config_publish();
+    } else {
+      RuntimeConfig_Cancel();
+      printf("ok\r\n");
+    }
+    return;
+  }
+
+  cfg = g_config_draft != NULL ? g_config_draft : RuntimeConfig_Edit();
+  if (cfg == NULL) {
+    printf("busy, try again\r\n");
+    return;
+  }
+  if (!shell_config_set(cfg, argc, argv)) {
+    printf("usage: config " SHELL_CONFIG_USAGE "\r\n");
+    if (g_config_draft == NULL)
+      RuntimeConfig_Cancel();
+    return;
+  }
+  if (g_config_draft == NULL) {
+    shell_config_publish();
+  } else {
+    printf("pending\r\n");
+  }
+}
+
+static void shell_cmd_anomaly(int argc, char **argv) {
+  static const char *method_names[] = {"z", "cusum"};
+  uint8_t count = SensorAnomaly_GetRuleCount();
+
+  for (uint8_t i = 0; i < count; i++) {
+    const SensorAnomalyRule_t *rule;
+    SensorAnomalyState_t state;
+    char t[4][FMT_FIXED_BUF_SIZE];
+
+    if (!SensorAnomaly_GetRule(i, &rule, &state))
+      continue;
+    printf("%-11s %-6s %-5s >%s %-4s score=%s mean=%s sigma=%s count=%lu\r\n",
+           rule->name, SensorType_ToString(rule->sensor),
+           method_names[rule->method], fmt_q1(rule->limit, t[0]),
+           state.direction > 0 ? "HIGH" : (state.direction < 0 ? "LOW" : "ok"),
+           fmt_q2(state.score, t[1]), fmt_q2(state.mean, t[2]),
+           fmt_q2(state.sigma, t[3]), (unsigned long)state.trigger_count);
+  }
+}
+
+static void shell_cmd_quality(int argc, char **argv) {
+  uint8_t count = SensorQuality_GetRuleCount();
+
+  for (uint8_t i = 0; i < count; i++) {
+    const SensorQualityRule_t *rule;
+    SensorQualityStats_t stats;
+    const SensorChannelDesc_t *channels;
+    char t[4][FMT_FIXED_BUF_SIZE];
+
+    if (!SensorQuality_GetRule(i, &rule, &stats))
+      continue;
+    printf("%-6s %-5s range=[%s,%s] step=%s spike=%s checked=%lu "
+           "rejected=%lu filtered=%lu\r\n",
+           SensorType_ToString(rule->sensor),
+           rule->channel < SensorTask_GetChannels(rule->sensor, &channels)
+               ? channels[rule->channel].name
+               : "?",
+           fmt_q1(rule->min, t[0]), fmt_q1(rule->max, t[1]),
+           fmt_q1(rule->max_step, t[2]), fmt_q1(rule->spike, t[3]),
+           (unsigned long)stats.checked, (unsigned long)stats.rejected,
+           (unsigned long)stats.filtered);
+  }
+}
+
+// 通道滤波链：列出槽位 / 修改并保存 (中值 0~3 = 关/3/5/7 点，低通与滑动平均 0~7)
+static void shell_cmd_filter(int argc, char **argv) {
+  uint8_t count = SensorFilter_GetSlotCount();
+  uint32_t arg[4];
+
+  if (argc > 1) {
+    if (argc < 5) {
+      printf("usage: filter <slot> <median 0-3> <lowpass 0-7> <ewma 0-7>\r\n");
+      return;
+    }
+    for (int i = 0; i < 4; i++) {
+      if (!shell_parse_uint(argv[i + 1], &arg[i])) {
+        printf("invalid argument: %s\r\n", argv[i + 1]);
+        return;
+      }
+    }
+    if (arg[1] > 3 || arg[2] > 7 || arg[3] > 7 ||
+        !SensorFilter_SetSpec((uint8_t)arg[0],
+                              SENSOR_FILTER_SPEC(arg[1], arg[2], arg[3]))) {
+      printf("invalid slot or stage\r\n");
+      return;
+    }
+  }
+  for (uint8_t i = 0; i < count; i++) {
+    const SensorFilterSlot_t *slot;
+    const SensorChannelDesc_t *channels;
+    SensorFilterSpec_t spec;
+    uint8_t median, lowpass, ewma;
+
+    if (!SensorFilter_GetSlot(i, &slot, &spec))
+      continue;
+    median = SENSOR_FILTER_MEDIAN_OF(spec);
+    lowpass = SENSOR_FILTER_LOWPASS_OF(spec);
+    ewma = SENSOR_FILTER_EWMA_OF(spec);
+    printf("%u: %-6s %-5s median=%u lowpass=", (unsigned)i,
+           SensorType_ToString(slot->sensor),
+           slot->channel < SensorTask_GetChannels(slot->sensor, &channels)
+               ? channels[slot->channel].name
+               : "?",
+           median ? 1U + 2U * median : 0U);
+    if (lowpass) {
+      printf("fs/%u", 1U << (lowpass + 2));
+    } else {
+      printf("off");
+    }
+    if (ewma) {
+      printf(" ewma=1/%u\r\n", 1U << ewma);
+    } else {
+      printf(" ewma=off\r\n");
+    }
+  }
+}
+
+/* 屏幕方向：切换由界面任务在两次刷新之间执行，并保存到配置 */
+static void shell_cmd_rotate(int argc, char **argv) {
+  uint32_t deg;
+
+  if (argc < 2) {
+    printf("Rotation: %u\r\n", (unsigned)lcd_orient_get() * 90U);
+    return;
+  }
+  if (!shell_parse_uint(argv[1], &deg) || deg % 90U != 0 || deg >= 360U) {
+    printf("Rotation must be 0, 90, 180 or 270\r\n");
+    return;
+  }
+  ui_request_rotation((lcd_rotation_t)(deg / 90U));
+  printf("Rotation: %lu\r\n", (unsigned long)deg);
+}
+
+static void shell_cmd_render(int argc, char **argv) {
+  static const char *const names[UI_RENDER_COUNT] = {"full", "fast"};
+
+  if (argc < 2) {
+    printf("Render: %s\r\n", names[ui_styles_get_render_profile()]);
+    return;
+  }
+  for (uint32_t i = 0; i < UI_RENDER_COUNT; i++) {
+    if (shell_streq(argv[1], names[i])) {
+      ui_request_render_profile((ui_render_profile_t)i);
+      printf("Render: %s\r\n", names[i]);
+      return;
+    }
+  }
+  printf("Render must be full or fast\r\n");
+}
+
+// 命令表 (参数个数在 shell_execute 中统一检查，各命令无需再判断)
+static const shell_command_t g_commands[] = {
+    {"help", "", shell_cmd_help, 1},
+    {"status", "", shell_cmd_status, 1},
+    {"derived", "", shell_cmd_derived, 1},
+    {"interval", "<sensor[:n]> <ms>", shell_cmd_interval, 3},
+    {"enable", "<sensor>", shell_cmd_enable, 2},
+    {"disable", "<sensor>", shell_cmd_enable, 2},
+    {"history", "<sensor> [hour] [channel]", shell_cmd_history, 2},
+    {"loglevel", "[<level>|reset] [module]", shell_cmd_loglevel, 1},
+    {"prof", "[reset]", shell_cmd_prof, 1},
+    {"frames", "[start [n]|csv]", shell_cmd_frames, 1},
+    {"sleep", "", shell_cmd_sleep, 1},
+    {"energy", "[reset]", shell_cmd_energy, 1},
+    {"boot", "", shell_cmd_boot, 1},
+    {"locks", "[tasks|reset]", shell_cmd_locks, 1},
+    {"i2c", "", shell_cmd_i2c, 1},
+    {"jitter", "[reset]", shell_cmd_jitter, 1},
+    {"latency", "[reset]", shell_cmd_latency, 1},
+    {"probe", "", shell_cmd_probe, 1},
+    {"stacks", "", shell_cmd_stacks, 1},
+    {"crash", "[clear]", shell_cmd_crash, 1},
+    {"logflash", "[dump [pages]|flush]", shell_cmd_logflash, 1},
+    {"trace", "[start [ring]|stop|dump]", shell_cmd_trace, 1},
+    {"replay", SHELL_REPLAY_USAGE, shell_cmd_replay, 1},
+    {"bench", "[lcd|lvgl|i2c|log|sensor|eeprom|all]", shell_cmd_bench, 1},
+    {"led", "off|auto|<r> <g> <b>", shell_cmd_led, 2},
+    {"motor", "auto|vent|<0-999>", shell_cmd_motor, 2},
+    {"buzzer", "off|beep|<hz>", shell_cmd_buzzer, 2},
+    {"flash", SHELL_FLASH_USAGE, shell_cmd_flash, 2},
+    {"datalog", SHELL_DATALOG_USAGE, shell_cmd_datalog, 2},
+    {"export", "<sensor|all> <t_start> <t_end> [seq]", shell_cmd_export, 4},
+    {"telemetry", "[flush]", shell_cmd_telemetry, 1},
+    {"modbus", "", shell_cmd_modbus, 1},
+    {"usb", "", shell_cmd_usb, 1},
+    {"archive", "[flush]", shell_cmd_archive, 1},
+    {"net", "", shell_cmd_net, 1},
+    {"can", "", shell_cmd_can, 1},
+    {"ota", SHELL_OTA_USAGE, shell_cmd_ota, 1},
+    {"baud", "[<rate>|ok]", shell_cmd_baud, 1},
+    {"date", "[YYYY-MM-DD HH:MM:SS]", shell_cmd_date, 1},
+    {"alarm", "", shell_cmd_alarm, 1},
+    {"config", SHELL_CONFIG_USAGE, shell_cmd_config, 1},
+    {"metrics", "[reset]", shell_cmd_metrics, 1},
+    {"anomaly", "", shell_cmd_anomaly, 1},
+    {"quality", "", shell_cmd_quality, 1},
+    {"filter", "[slot median lowpass ewma]", shell_cmd_filter, 1},
+    {"rotate", "[0|90|180|270]", shell_cmd_rotate, 1},
+    {"render", "[full|fast]", shell_cmd_render, 1},
+};
+
+#define SHELL_COMMAND_COUNT (sizeof(g_commands) / sizeof(g_commands[0]))
+
+static void shell_cmd_help(int argc, char **argv) {
+  for (uint32_t i = 0; i < SHELL_COMMAND_COUNT; i++) {
+    printf("  %-9s %s\r\n", g_commands[i].name, g_commands[i].usage);
+  }
+}
+
+/**
+ * @brief 在行内原地切分参数并执行命令
+ */
+static void shell_execute(char *line) {
+  char *argv[SHELL_MAX_ARGS];
+  int argc = 0;
+  char *p = line;
+
+  while (*p && argc < SHELL_MAX_ARGS) {
+    while (*p == ' ' || *p == '\t')
+      *p++ = '\0';
+    if (*p == '\0')
+      break;
+    argv[argc++] = p;
+    while (*p && *p != ' ' && *p != '\t')
+      p++;
+  }
+  if (argc == 0)
+    return;
+
+  for (uint32_t i = 0; i < SHELL_COMMAND_COUNT; i++) {
+    if (shell_streq(argv[0], g_commands[i].name)) {
+      if (argc < g_commands[i].min_args) {
+        printf("usage: %s %s\r\n", g_commands[i].name,
+               g_commands[i].usage);
+        return;
+      }
+      g_commands[i].handler(argc, argv);
+      return;
+    }
+  }
+  printf("unknown command '%s', try 'help'\r\n", argv[0]);
+}
+
+/**
+ * @brief 处理一行完整的命令
+ * @param start 行在环形缓冲区中的起始位置
+ * @param len   行长度 (不含行结束符)
+ */
+static void shell_handle_line(uint16_t start, uint16_t len) {
+  char *line;
+
+  if (start + len < SHELL_RX_BUFFER_SIZE) {
+    // 行结束符已被扫描过，直接改写为字符串结束符
+    line = (char *)&g_rx_buf[start];
+    line[len] = '\0';
+  } else {
+    uint16_t first = SHELL_RX_BUFFER_SIZE - start;
+    memcpy(g_line_buf, &g_rx_buf[start], first);
+    memcpy(g_line_buf + first, g_rx_buf, len - first);
+    g_line_buf[len] = '\0';
+    line = g_line_buf;
+  }
+
+  shell_execute(line);
+}
+
+/**
+ * @brief 扫描新收到的数据，遇到 CR/LF 即执行一行
+ */
+static void shell_process(void) {
+  if (g_rx_resync) {
+    g_rx_resync = 0;
+    g_rx_tail = 0;
+    g_line_start = 0;
+    g_line_len = 0;
+    g_line_overflow = false;
+  }
+
+  uint16_t head = g_rx_head;
+
+  // 接收被错误回调重启时剩余数据作废
+  while (g_rx_tail != head && !g_rx_resync) {
+    uint8_t c = g_rx_buf[g_rx_tail];
+    g_rx_tail = (g_rx_tail + 1) % SHELL_RX_BUFFER_SIZE;
+
+    if (c == '\r' || c == '\n') {
+      if (g_line_overflow)
+        printf("line too long\r\n");
+      else if (g_line_len > 0)
+        shell_handle_line(g_line_start, g_line_len);
+      g_line_start = g_rx_tail;
+      g_line_len = 0;
+      g_line_overflow = false;
+    } else if (g_line_len < SHELL_LINE_MAX) {
+      g_line_len++;
+    } else {
+      g_line_overflow = true;
+    }
+  }
+}
+
+/**
+ * @brief 处理其他输入通道收到的数据
+ */
+static void shell_process_input(void) {
+  while (g_in_tail != g_in_head) {
+    char c = (char)g_in_buf[g_in_tail];
+    g_in_tail = (uint16_t)((g_in_tail + 1) % SHELL_INPUT_BUFFER_SIZE);
+
+    if (c == '\r' || c == '\n') {
+      if (g_in_overflow) {
+        printf("line too long\r\n");
+      } else if (g_in_len > 0) {
+        g_in_line[g_in_len] = '\0';
+        shell_execute(g_in_line);
+      }
+      g_in_len = 0;
+      g_in_overflow = false;
+    } else if (g_in_len < SHELL_LINE_MAX) {
+      g_in_line[g_in_len++] = c;
+    } else {
+      g_in_overflow = true;
+    }
+  }
+}
+
+static void shell_task(void *argument) {
+  (void)argument;
+
+  TaskWdt_Register(TASK_WDT_DEADLINE_SHELL_MS);
+#if BENCH_RUN_AT_BOOT
+  Bench_RunAtBoot();
+#endif
+  for (;;) {
+    // 等待波特率确认期间定时醒来检查超时
+    TaskWdt_Idle();
+    ulTaskNotifyTake(pdTRUE, g_baud_pending ? pdMS_TO_TICKS(100) : portMAX_DELAY);
+    TaskWdt_CheckIn();
+    shell_process();
+    shell_process_input();
+    shell_baud_check_timeout();
+  }
+}
+
+static bool shell_start_rx(void) {
+  return HAL_UARTEx_ReceiveToIdle_DMA(g_shell_uart, g_rx_buf,
+                                      SHELL_RX_BUFFER_SIZE) == HAL_OK;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化命令行
+ */
+bool Shell_Init(UART_HandleTypeDef *huart) {
+  if (huart == NULL)
+    return false;
+
+  g_shell_uart = huart;
+  g_rx_head = 0;
+  g_rx_tail = 0;
+  g_line_start = 0;
+  g_line_len = 0;
+
+  if (g_shell_task == NULL) {
+    g_shell_task = xTaskCreateStatic(shell_task, "shell", SHELL_TASK_STACK_SIZE,
+                                     NULL, SHELL_TASK_PRIORITY,
+                                     g_shell_task_stack, &g_shell_task_tcb);
+  }
+
+  if (!shell_start_rx()) {
+    LOG_ERROR("串口命令行接收启动失败");
+    return false;
+  }
+
+  LOG_INFO("串口命令行已启动，输入 help 查看命令");
+  return true;
+}
+
+/**
+ * @brief 恢复保存的波特率
+ */
+void Shell_RestoreBaudRate(void) {
+  uint32_t rate;
+
+  if (ConfigStore_Get(CONFIG_KEY_UART_BAUD, &rate, sizeof(rate)) &&
+      shell_baud_supported(rate) && rate != 115200) {
+    LOG_INFO("串口切换到保存的波特率 %lu", (unsigned long)rate);
+    printf_set_baudrate(rate);
+  }
+}
+
+/**
+ * @brief 接收事件回调 (中断上下文)
+ */
+void Shell_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size) {
+  if (huart != g_shell_uart || g_shell_task == NULL)
+    return;
+
+  g_rx_head = size % SHELL_RX_BUFFER_SIZE;
+
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(g_shell_task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 其他输入通道收到的数据 (中断上下文)
+ */
+void Shell_Input(const uint8_t *data, uint16_t len) {
+  uint16_t head = g_in_head;
+
+  if (g_shell_task == NULL)
+    return;
+
+  for (uint16_t i = 0; i < len; i++) {
+    uint16_t next = (uint16_t)((head + 1) % SHELL_INPUT_BUFFER_SIZE);
+    if (next == g_in_tail)
+      break;
+    g_in_buf[head] = data[i];
+    head = next;
+  }
+  g_in_head = head;
+
+  BaseType_t woken = pdFALSE;
+  vTaskNotifyGiveFromISR(g_shell_task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 串口错误回调 (中断上下文)
+ */
+void Shell_ErrorCallback(UART_HandleTypeDef *huart) {
+  if (huart != g_shell_uart || huart->RxState != HAL_UART_STATE_READY)
+    return;
+
+  // 溢出等错误会中止接收 DMA，重新启动后从缓冲区开头写入
+  g_rx_head = 0;
+  g_rx_resync = 1;
+  shell_start_rx();
+
+  if (g_shell_task != NULL) {
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(g_shell_task, &woken);
+    portYIELD_FROM_ISR(woken);
+  }
+}
@@ -0,0 +1,72 @@
+/**
+ ******************************************************************************
+ * @file    shell.h
+ * @brief   串口命令行头文件
+ * @details USART1 接收使用循环 DMA + 空闲线检测，按行解析命令，
+ *          用于现场调整传感器间隔、查看历史、修改日志级别、控制外设。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SHELL_H
+#define __SHELL_H
+
+#include "main.h"
+#include "task_plan.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SHELL_RX_BUFFER_SIZE 256  // 循环接收缓冲区大小
+#define SHELL_LINE_MAX 160        // 单行命令最大长度 (ota write 一行 64 字节分块；仅跨越缓冲区末尾时需要拷贝)
+#define SHELL_MAX_ARGS 6          // 单条命令最多参数个数 (含命令名)
+#define SHELL_TASK_STACK_SIZE 320 // 命令行任务栈大小 (单位: 字)
+#define SHELL_TASK_PRIORITY TASK_PRIO_SHELL // 命令行任务的 FreeRTOS 优先级 (即 osPriorityLow)
+#define SHELL_BAUD_CONFIRM_MS 3000 // 切换波特率后等待主机确认的时间，超时恢复原值
+#define SHELL_INPUT_BUFFER_SIZE 256 // 其他输入通道 (USB 虚拟串口) 的接收缓冲区大小
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 初始化命令行：启动 DMA 接收并创建命令行任务
+ * @note  应在传感器系统与设备管理器初始化之后调用
+ * @param huart 命令行所用串口 (与 printf 输出共用)
+ * @return true: 成功, false: 启动接收失败
+ */
+bool Shell_Init(UART_HandleTypeDef *huart);
+
+/**
+ * @brief 恢复配置存储中保存的波特率 (默认 115200 由 MX_USART1_UART_Init 设置)
+ * @note  须在 ConfigStore_Init 之后调用，越早调用，按旧波特率输出的启动日志越少
+ */
+void Shell_RestoreBaudRate(void);
+
+/**
+ * @brief 接收事件回调 (DMA 半满/全满/空闲线)，需在 HAL_UARTEx_RxEventCallback 中调用
+ * @param huart 串口句柄
+ * @param size  DMA 当前写入位置
+ */
+void Shell_RxEventCallback(UART_HandleTypeDef *huart, uint16_t size);
+
+/**
+ * @brief 其他输入通道收到的数据 (如 USB 虚拟串口)，中断中调用
+ * @note  与串口输入各自按行拼接，互不打断；缓冲区满时丢弃多余字节
+ */
+void Shell_Input(const uint8_t *data, uint16_t len);
+
+/**
+ * @brief 串口错误回调，需在 HAL_UART_ErrorCallback 中调用 (重新启动接收)
+ * @param huart 串口句柄
+ */
+void Shell_ErrorCallback(UART_HandleTypeDef *huart);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SHELL_H */
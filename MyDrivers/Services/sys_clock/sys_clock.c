@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ * @file    sys_clock.c
+ * @brief   64 位单调微秒时钟源文件
+ * @details 读取时关中断取毫秒数与 TIM6 计数值；若此时更新标志已置位，说明
+ *          计数器刚回绕而中断尚未处理，重新读取计数值并补上 1 ms。
+ *          TIM6 中断优先级最低，HAL 先清更新标志再调用回调，高优先级中断
+ *          恰好在这两步之间读取时会少算 1 ms，因此再与上次的读数比较，
+ *          保证返回值单调不减。
+ *          vPortSetupTimerInterrupt 代替移植层的默认实现 (SysTick)，由
+ *          xPortStartScheduler 在关中断状态下调用；TIM6 优先级为最低
+ *          (TICK_INT_PRIORITY)，满足 xPortSysTickHandler 的要求。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sys_clock.h"
+#include "FreeRTOS.h"
+#include "main.h"
+#include "task.h"
+#include <stdbool.h>
+
+/* --------------------------- 私有宏 --------------------------- */
+#define SYS_CLOCK_TIMER TIM6          // HAL 时基定时器 (见 stm32f4xx_hal_timebase_tim.c)
+#define SYS_CLOCK_US_PER_MS 1000U      // 计数频率 1 MHz (计数值即微秒)
+
+/* --------------------------- 私有变量 --------------------------- */
+static volatile uint64_t s_ms;  // 时基中断累加的毫秒数
+static uint64_t s_last_us;      // 上次返回的微秒数
+static bool s_rtos_tick;        // 调度器已启动，时基中断同时产生 RTOS 节拍
+
+/* FreeRTOS 移植层的节拍处理函数 (port.c) */
+extern void xPortSysTickHandler(void);
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 时基中断钩子
+ */
+void SysClock_IncTick(void) {
+  s_ms += (uint32_t)HAL_GetTickFreq();
+  if (s_rtos_tick) {
+    xPortSysTickHandler();
+  }
+}
+
+/**
+ * @brief RTOS 节拍定时器配置 (代替 port.c 中基于 SysTick 的弱定义)
+ * @note  TIM6 已由 HAL_InitTick 启动；RTOS 节拍数从 0 对齐到 HAL_GetTick()，
+ *        此时 xNextTaskUnblockTime 为 portMAX_DELAY，vTaskStepTick 的断言成立
+ */
+void vPortSetupTimerInterrupt(void) {
+  SysTick->CTRL = 0;
+  vTaskStepTick((TickType_t)HAL_GetTick());
+  s_rtos_tick = true;
+}
+
+/**
+ * @brief 补上时基中断暂停期间的毫秒数
+ */
+void SysClock_StepTick(uint32_t ms) {
+  uwTick += ms;
+  s_ms += ms;
+}
+
+/**
+ * @brief 上电以来的微秒数
+ */
+uint64_t SysClock_Micros(void) {
+  uint32_t primask = __get_PRIMASK();
+  uint64_t ms;
+  uint32_t cnt;
+  uint64_t now;
+
+  __disable_irq();
+  ms = s_ms;
+  cnt = SYS_CLOCK_TIMER->CNT;
+  if (SYS_CLOCK_TIMER->SR & TIM_SR_UIF) {
+    // 计数器已回绕但中断尚未处理
+    cnt = SYS_CLOCK_TIMER->CNT;
+    ms += (uint32_t)HAL_GetTickFreq();
+  }
+  now = ms * SYS_CLOCK_US_PER_MS + cnt;
+  if (now < s_last_us) {
+    now = s_last_us;
+  }
+  s_last_us = now;
+  __set_PRIMASK(primask);
+
+  return now;
+}
+
+/**
+ * @brief 上电以来的毫秒数
+ */
+uint64_t SysClock_Millis(void) {
+  uint32_t primask = __get_PRIMASK();
+  uint64_t ms;
+
+  __disable_irq();
+  ms = s_ms;
+  __set_PRIMASK(primask);
+
+  return ms;
+}
+
+/**
+ * @brief 上电以来的秒数
+ */
+uint32_t SysClock_Seconds(void) { return (uint32_t)(SysClock_Millis() / 1000U); }
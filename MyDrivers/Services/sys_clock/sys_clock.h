@@ -0,0 +1,63 @@
+/**
+ ******************************************************************************
+ * @file    sys_clock.h
+ * @brief   64 位单调微秒时钟头文件
+ * @details 复用 HAL 时基定时器 TIM6 (计数频率 1 MHz，每 1000 个计数产生一次
+ *          更新中断)：在更新中断里累加 64 位毫秒数，读取时再加上计数器的
+ *          当前值，得到不回绕的微秒时间，不占用额外的定时器。
+ *          TIM6 同时是 FreeRTOS 的节拍源 (SysTick 不再使用)：调度器启动时
+ *          把 RTOS 节拍数对齐到 HAL_GetTick()，之后在同一中断中递增，
+ *          HAL_GetTick()、xTaskGetTickCount() 与 SysClock_Millis() 的低 32 位
+ *          始终相等，HAL 超时、LVGL、日志与传感器时间戳只有一个时间源，
+ *          每毫秒也只有一次时基中断。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SYS_CLOCK_H
+#define __SYS_CLOCK_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 时基中断钩子，在 HAL_TIM_PeriodElapsedCallback 中紧随 HAL_IncTick 调用
+ * @note  调度器启动后在这里产生 RTOS 节拍
+ */
+void SysClock_IncTick(void);
+
+/**
+ * @brief 补上时基中断暂停期间经过的毫秒数 (HAL_GetTick 与本模块同时前进)
+ * @param ms 暂停的毫秒数
+ * @note  由无节拍空闲在关中断状态下、恢复 TIM6 中断前调用，
+ *        RTOS 节拍由调用方用 vTaskStepTick 补上相同的数值
+ */
+void SysClock_StepTick(uint32_t ms);
+
+/**
+ * @brief 上电以来的微秒数 (单调递增，约 58 万年回绕)
+ * @note  可在任务和中断中调用，内部短暂关中断
+ */
+uint64_t SysClock_Micros(void);
+
+/**
+ * @brief 上电以来的毫秒数 (64 位，低 32 位等于 HAL_GetTick)
+ */
+uint64_t SysClock_Millis(void);
+
+/**
+ * @brief 上电以来的秒数
+ */
+uint32_t SysClock_Seconds(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYS_CLOCK_H */
@@ -0,0 +1,280 @@
+/**
+ ******************************************************************************
+ * @file    sys_monitor.c
+ * @brief   系统资源监控源文件
+ * @details uxTaskGetSystemState 返回的是各任务累计运行时间，这里保存上一次的
+ *          计数值，按差值计算每个采样周期的占用率。计数器为 32 位 DWT 周期数，
+ *          无符号减法可跨越一次回绕，因此采样周期必须小于回绕周期。
+ *          快照在调度器锁内拷贝；不使用顺序锁，因为读者 (LVGL 任务) 优先级
+ *          高于写者 (监控任务)，抢占后自旋重试会饿死写者。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "sys_monitor.h"
+#include "adc_manager.h"
+#include "main.h"
+#include "metrics.h"
+#include "task.h"
+#include <string.h>
+
+#define LOG_MODULE "SYSMON"
+#include "log.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+static TaskStatus_t g_task_status[SYS_MONITOR_MAX_TASKS];
+
+// 上一次采样时各任务的累计运行时间 (按任务编号匹配)
+static struct {
+  UBaseType_t number;
+  uint32_t runtime;
+} g_prev_runtime[SYS_MONITOR_MAX_TASKS];
+static uint8_t g_prev_count = 0;
+static uint32_t g_prev_total = 0;
+static bool g_has_baseline = false;
+
+static SysMonitor_Snapshot_t g_work;     // 仅监控任务访问
+static SysMonitor_Snapshot_t g_snapshot; // 对外发布 (调度器锁保护)
+static bool g_snapshot_valid = false;
+static SysMonitor_GuiHeap_t g_gui_heap;  // LVGL 任务上报 (调度器锁保护)
+static SysMonitor_ResetCause_t g_reset_cause = SYS_RESET_POWER_ON;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static char monitor_state_char(eTaskState state) {
+  switch (state) {
+  case eRunning:
+  case eReady:
+    return 'R';
+  case eBlocked:
+    return 'B';
+  case eSuspended:
+    return 'S';
+  default:
+    return 'D';
+  }
+}
+
+static uint32_t monitor_prev_runtime(UBaseType_t number, bool *found) {
+  for (uint8_t i = 0; i < g_prev_count; i++) {
+    if (g_prev_runtime[i].number == number) {
+      *found = true;
+      return g_prev_runtime[i].runtime;
+    }
+  }
+  *found = false;
+  return 0;
+}
+
+static uint16_t monitor_permille(uint32_t part, uint32_t total) {
+  if (total == 0)
+    return 0;
+  uint64_t v = ((uint64_t)part * 1000u + total / 2) / total;
+  return (uint16_t)(v > 1000u ? 1000u : v);
+}
+
+/**
+ * @brief 按任务编号排序，使显示顺序与创建顺序一致、不随任务状态跳动
+ */
+static void monitor_sort_by_number(UBaseType_t n) {
+  for (UBaseType_t i = 1; i < n; i++) {
+    TaskStatus_t key = g_task_status[i];
+    UBaseType_t j = i;
+    while (j > 0 && g_task_status[j - 1].xTaskNumber > key.xTaskNumber) {
+      g_task_status[j] = g_task_status[j - 1];
+      j--;
+    }
+    g_task_status[j] = key;
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 采样一次并刷新快照
+ */
+void SysMonitor_Update(void) {
+  uint32_t total_now = 0;
+  UBaseType_t n =
+      uxTaskGetSystemState(g_task_status, SYS_MONITOR_MAX_TASKS, &total_now);
+
+  // 任务数超过缓冲区时 uxTaskGetSystemState 返回 0，仍发布堆信息
+  uint32_t total_delta = total_now - g_prev_total;
+  uint32_t idle_delta = 0;
+  TaskHandle_t idle = xTaskGetIdleTaskHandle();
+
+  monitor_sort_by_number(n);
+  memset(&g_work, 0, sizeof(g_work));
+
+  for (UBaseType_t i = 0; i < n; i++) {
+    const TaskStatus_t *ts = &g_task_status[i];
+    SysMonitor_Task_t *out = &g_work.tasks[i];
+    bool found;
+    uint32_t prev = monitor_prev_runtime(ts->xTaskNumber, &found);
+    // 本周期新建的任务以 0 为基准
+    uint32_t delta = ts->ulRunTimeCounter - (found ? prev : 0);
+
+    strncpy(out->name, ts->pcTaskName, sizeof(out->name) - 1);
+    out->cpu_permille = monitor_permille(delta, total_delta);
+    out->stack_free_words = (uint16_t)ts->usStackHighWaterMark;
+    out->priority = (uint8_t)ts->uxCurrentPriority;
+    out->state = monitor_state_char(ts->eCurrentState);
+
+    if (ts->xHandle == idle)
+      idle_delta += delta;
+  }
+
+  for (UBaseType_t i = 0; i < n; i++) {
+    g_prev_runtime[i].number = g_task_status[i].xTaskNumber;
+    g_prev_runtime[i].runtime = g_task_status[i].ulRunTimeCounter;
+  }
+  g_prev_count = (uint8_t)n;
+  g_prev_total = total_now;
+
+  g_work.task_count = (uint8_t)n;
+  g_work.task_total = (uint8_t)uxTaskGetNumberOfTasks();
+  g_work.cpu_load_permille =
+      (uint16_t)(1000u - monitor_permille(idle_delta, total_delta));
+  g_work.heap_total = configTOTAL_HEAP_SIZE;
+  g_work.heap_free = xPortGetFreeHeapSize();
+  g_work.heap_min_free = xPortGetMinimumEverFreeHeapSize();
+  g_work.vdda_mv = ADC_Manager_GetVddaMv();
+  g_work.die_temp_c10 = ADC_Manager_GetDieTempC10();
+  g_work.timestamp = HAL_GetTick();
+
+  vTaskSuspendAll();
+  g_work.gui_heap = g_gui_heap;
+  (void)xTaskResumeAll();
+
+  // 首次调用时累计值覆盖的是启动以来的整段时间，只作为基准
+  if (!g_has_baseline) {
+    g_has_baseline = true;
+    return;
+  }
+
+  METRIC_SET(METRIC_CPU_LOAD, g_work.cpu_load_permille);
+  METRIC_SET(METRIC_HEAP_FREE, (uint32_t)g_work.heap_free);
+  METRIC_SET(METRIC_HEAP_MIN_FREE, (uint32_t)g_work.heap_min_free);
+
+  vTaskSuspendAll();
+  g_snapshot = g_work;
+  g_snapshot_valid = true;
+  (void)xTaskResumeAll();
+}
+
+/**
+ * @brief 获取最近一次的快照拷贝
+ */
+bool SysMonitor_GetSnapshot(SysMonitor_Snapshot_t *out) {
+  bool valid;
+
+  if (out == NULL)
+    return false;
+
+  vTaskSuspendAll();
+  valid = g_snapshot_valid;
+  if (valid)
+    *out = g_snapshot;
+  (void)xTaskResumeAll();
+
+  return valid;
+}
+
+/**
+ * @brief 上报 LVGL 内存池统计
+ */
+void SysMonitor_SetGuiHeap(const SysMonitor_GuiHeap_t *heap) {
+  if (heap == NULL)
+    return;
+
+  vTaskSuspendAll();
+  g_gui_heap = *heap;
+  g_gui_heap.valid = true;
+  (void)xTaskResumeAll();
+
+  METRIC_SET(METRIC_LV_MEM_FREE, heap->free);
+  METRIC_SET(METRIC_LV_MEM_FRAG, heap->frag_pct);
+}
+
+/**
+ * @brief 读取并清除 RCC 复位标志
+ * @details 看门狗与软件复位时复位引脚标志也会置位，因此最后判断引脚；
+ *          上电复位同时置位欠压标志，两者都视为冷启动。
+ */
+void SysMonitor_CaptureResetCause(void) {
+  uint32_t csr = RCC->CSR;
+
+  if (csr & RCC_CSR_LPWRRSTF) {
+    g_reset_cause = SYS_RESET_LOW_POWER;
+  } else if (csr & RCC_CSR_IWDGRSTF) {
+    g_reset_cause = SYS_RESET_IWDG;
+  } else if (csr & RCC_CSR_WWDGRSTF) {
+    g_reset_cause = SYS_RESET_WWDG;
+  } else if (csr & RCC_CSR_SFTRSTF) {
+    g_reset_cause = SYS_RESET_SOFTWARE;
+  } else if (csr & (RCC_CSR_PORRSTF | RCC_CSR_BORRSTF)) {
+    g_reset_cause = SYS_RESET_POWER_ON;
+  } else if (csr & RCC_CSR_PINRSTF) {
+    g_reset_cause = SYS_RESET_PIN;
+  }
+  RCC->CSR |= RCC_CSR_RMVF;
+}
+
+/**
+ * @brief 本次启动的复位原因
+ */
+SysMonitor_ResetCause_t SysMonitor_GetResetCause(void) { return g_reset_cause; }
+
+/**
+ * @brief 是否为热启动
+ */
+bool SysMonitor_IsWarmReset(void) { return g_reset_cause != SYS_RESET_POWER_ON; }
+
+/**
+ * @brief 复位原因名称
+ */
+const char *SysMonitor_ResetCauseName(SysMonitor_ResetCause_t cause) {
+  static const char *names[] = {"power-on", "pin",  "software",
+                                "iwdg",     "wwdg", "low-power"};
+  return (uint32_t)cause < sizeof(names) / sizeof(names[0]) ? names[cause]
+                                                             : "unknown";
+}
+
+/**
+ * @brief 通过日志输出最近一次的快照
+ */
+void SysMonitor_LogReport(void) {
+  // 只由监控任务调用，直接读取工作副本，省去一次快照拷贝
+  const SysMonitor_Snapshot_t *s = &g_work;
+
+  if (!g_snapshot_valid)
+    return;
+
+  LOG_INFO("CPU %u.%u%%, heap free %u / %u B, min ever %u B, tasks %u",
+           s->cpu_load_permille / 10, s->cpu_load_permille % 10,
+           (unsigned)s->heap_free, (unsigned)s->heap_total,
+           (unsigned)s->heap_min_free, s->task_total);
+  LOG_INFO("VDDA %u mV, die %d C", s->vdda_mv, s->die_temp_c10 / 10);
+
+  if (s->gui_heap.valid) {
+    const SysMonitor_GuiHeap_t *g = &s->gui_heap;
+    LOG_INFO("LVGL mem used %lu / %lu B, peak %lu B, biggest free %lu B, "
+             "frag %u%%",
+             (unsigned long)(g->total - g->free), (unsigned long)g->total,
+             (unsigned long)g->max_used, (unsigned long)g->biggest_free,
+             g->frag_pct);
+    if (g->frag_pct >= SYS_MONITOR_GUI_FRAG_WARN ||
+        g->biggest_free < SYS_MONITOR_GUI_BIGGEST_WARN) {
+      LOG_WARN("LVGL 内存池碎片化: 最大空闲块 %lu B, 碎片率 %u%%",
+               (unsigned long)g->biggest_free, g->frag_pct);
+    }
+  }
+
+  for (uint8_t i = 0; i < s->task_count; i++) {
+    const SysMonitor_Task_t *t = &s->tasks[i];
+    LOG_INFO("  %-12s %c P%u  cpu %2u.%u%%  stack free %u B", t->name,
+             t->state, t->priority, t->cpu_permille / 10,
+             t->cpu_permille % 10, t->stack_free_words * 4u);
+  }
+}
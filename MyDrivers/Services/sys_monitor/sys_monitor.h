@@ -0,0 +1,141 @@
+/**
+ ******************************************************************************
+ * @file    sys_monitor.h
+ * @brief   系统资源监控头文件
+ * @details 基于 FreeRTOS 运行时统计 (DWT 周期计数器) 周期性采样各任务的
+ *          CPU 占用率、栈剩余高水位，以及 heap_4 的当前/历史最小空闲堆。
+ *          LVGL 内存池 (TLSF) 不是线程安全的，由 LVGL 任务自己统计后通过
+ *          SysMonitor_SetGuiHeap 交给监控任务，随下一次采样进入快照。
+ *          快照同时带有 ADC 服务换算的 VDDA 与芯片温度 (诊断用)。
+ *          采样结果以快照形式提供给日志、命令行与 LVGL 诊断页面。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __SYS_MONITOR_H
+#define __SYS_MONITOR_H
+
+#include "FreeRTOS.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define SYS_MONITOR_MAX_TASKS 12     // 快照最多记录的任务数
+#define SYS_MONITOR_PERIOD_MS 5000   // 推荐采样周期 (须远小于 DWT 回绕周期 ~25 s)
+#define SYS_MONITOR_GUI_FRAG_WARN 50             // LVGL 内存池碎片率告警阈值 (%)
+#define SYS_MONITOR_GUI_BIGGEST_WARN (4 * 1024)  // 最大空闲块告警阈值 (字节)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 复位原因 (RCC_CSR 复位标志)
+ */
+typedef enum {
+  SYS_RESET_POWER_ON = 0, // 上电/欠压复位 (冷启动)
+  SYS_RESET_PIN,          // 复位引脚
+  SYS_RESET_SOFTWARE,     // NVIC_SystemReset
+  SYS_RESET_IWDG,         // 独立看门狗
+  SYS_RESET_WWDG,         // 窗口看门狗
+  SYS_RESET_LOW_POWER     // 低功耗复位
+} SysMonitor_ResetCause_t;
+
+/**
+ * @brief 单个任务的统计信息
+ */
+typedef struct {
+  char name[configMAX_TASK_NAME_LEN];
+  uint16_t cpu_permille;     // 上一采样周期内的 CPU 占用 (0.1%)
+  uint16_t stack_free_words; // 栈剩余高水位 (单位: 字)
+  uint8_t priority;          // 当前优先级
+  char state;                // R/B/S/D (运行/阻塞/挂起/已删除)
+} SysMonitor_Task_t;
+
+/**
+ * @brief LVGL 内存池统计 (lv_mem_monitor 的结果)
+ */
+typedef struct {
+  uint32_t total;        // LV_MEM_SIZE
+  uint32_t free;         // 空闲字节
+  uint32_t biggest_free; // 最大空闲块
+  uint32_t max_used;     // 启动以来的峰值占用
+  uint8_t frag_pct;      // 碎片率 (100 - 最大空闲块 / 空闲总量)
+  bool valid;            // LVGL 任务已上报过
+} SysMonitor_GuiHeap_t;
+
+/**
+ * @brief 系统资源快照
+ */
+typedef struct {
+  SysMonitor_Task_t tasks[SYS_MONITOR_MAX_TASKS];
+  uint8_t task_count;         // 已记录的任务数
+  uint8_t task_total;         // 系统中实际任务数 (可能大于 task_count)
+  uint16_t cpu_load_permille; // 总 CPU 负载 (1000 - 空闲任务占比)
+  size_t heap_total;          // configTOTAL_HEAP_SIZE
+  size_t heap_free;           // 当前空闲堆
+  size_t heap_min_free;       // 历史最小空闲堆
+  SysMonitor_GuiHeap_t gui_heap; // LVGL 内存池 (最近一次上报)
+  uint16_t vdda_mv;           // 模拟电源电压 (mV，由 VREFINT 换算)
+  int16_t die_temp_c10;       // 芯片温度 (0.1 °C)
+  uint32_t timestamp;         // 采样时刻 (ms)
+} SysMonitor_Snapshot_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 读取并清除 RCC 复位标志
+ * @note  在 main 中 HAL_Init 之后尽早调用；不清除时标志会跨复位累积，
+ *        冷启动的上电标志会一直保留
+ */
+void SysMonitor_CaptureResetCause(void);
+
+/**
+ * @brief 本次启动的复位原因
+ */
+SysMonitor_ResetCause_t SysMonitor_GetResetCause(void);
+
+/**
+ * @brief 是否为热启动 (备份域与外设保持供电，除上电/欠压以外的复位)
+ */
+bool SysMonitor_IsWarmReset(void);
+
+/**
+ * @brief 复位原因名称
+ */
+const char *SysMonitor_ResetCauseName(SysMonitor_ResetCause_t cause);
+
+/**
+ * @brief 采样一次：计算上一周期的任务 CPU 占用并刷新快照
+ * @note  只能由单个任务周期调用 (SystemMonitorTask)，首次调用只建立基准
+ */
+void SysMonitor_Update(void);
+
+/**
+ * @brief 获取最近一次的快照拷贝 (任意任务可调用)
+ * @param out 输出快照
+ * @return true: 成功, false: 尚无有效采样
+ */
+bool SysMonitor_GetSnapshot(SysMonitor_Snapshot_t *out);
+
+/**
+ * @brief 上报 LVGL 内存池统计 (由 LVGL 任务调用)
+ * @param heap 统计结果，下一次 SysMonitor_Update 时进入快照
+ */
+void SysMonitor_SetGuiHeap(const SysMonitor_GuiHeap_t *heap);
+
+/**
+ * @brief 将最近一次的快照通过日志输出
+ * @note  LVGL 内存池碎片率或最大空闲块越过阈值时另外输出告警
+ */
+void SysMonitor_LogReport(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __SYS_MONITOR_H */
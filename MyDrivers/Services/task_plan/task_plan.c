@@ -0,0 +1,330 @@
+/**
+ ******************************************************************************
+ * @file    task_plan.c
+ * @brief   互斥锁持有时间检查实现
+ * @details 获取与释放钩子在 queue.c 的临界区内执行，只做查表与计时
+ *          (DWT 周期计数器)，不调用会阻塞或输出的接口；统计表只在这些
+ *          临界区中修改，日志由监控任务在临界区外输出。
+ *          统计表按互斥锁指针匹配，登记或第一次获取时加入，不会移除。
+ *          等待时间记在 (互斥锁, 任务) 组合上：第一次阻塞时记下时刻，获取
+ *          成功或超时时结算 (一次获取中被抢先再次阻塞不重复计数)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "task_plan.h"
+#include "FreeRTOS.h"
+#include "main.h"
+#include "metrics.h"
+#include "queue.h"
+#include "task.h"
+#include <stddef.h>
+#include <string.h>
+
+#define LOG_MODULE "TASKPLAN"
+#include "log.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+typedef struct {
+  void *mutex;                 // 0 表示空闲
+  void *task;                  // TaskHandle_t
+  uint8_t index;               // 所属 s_mutexes 下标
+  uint32_t block_cycles;       // 第一次阻塞的时刻 (0 表示未在等待)
+  TaskPlan_CallerStats_t stats;
+} TaskPlan_Caller_t;
+
+typedef struct {
+  void *mutex;
+  uint32_t take_cycles;     // 本次获取时刻
+  TaskPlan_Caller_t *holder; // 本次获取者
+  uint32_t reported_over;   // 上次报告时的 over
+  uint32_t reported_inherits;
+  TaskPlan_MutexStats_t stats;
+} TaskPlan_Mutex_t;
+
+static TaskPlan_Mutex_t s_mutexes[TASK_PLAN_MAX_MUTEXES];
+static uint8_t s_mutex_count;
+static TaskPlan_Caller_t s_callers[TASK_PLAN_MAX_CALLERS];
+static uint8_t s_caller_count;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/* 查找互斥锁，add 为 true 时不存在则加入 (调用者已进入临界区) */
+static TaskPlan_Mutex_t *task_plan_find(void *mutex, bool add) {
+  for (uint8_t i = 0; i < s_mutex_count; i++) {
+    if (s_mutexes[i].mutex == mutex) {
+      return &s_mutexes[i];
+    }
+  }
+  if (!add || s_mutex_count >= TASK_PLAN_MAX_MUTEXES) {
+    return NULL;
+  }
+  TaskPlan_Mutex_t *m = &s_mutexes[s_mutex_count++];
+  m->mutex = mutex;
+  m->stats.warn_us = TASK_PLAN_HOLD_WARN_MS * 1000U;
+  return m;
+}
+
+/* 查找当前任务在 m 上的组合，add 为 true 时不存在则加入 (调用者已进入临界区) */
+static TaskPlan_Caller_t *task_plan_caller(TaskPlan_Mutex_t *m, bool add) {
+  void *task = xTaskGetCurrentTaskHandle();
+  const char *name;
+  TaskPlan_Caller_t *c;
+
+  for (uint8_t i = 0; i < s_caller_count; i++) {
+    if (s_callers[i].mutex == m->mutex && s_callers[i].task == task) {
+      return &s_callers[i];
+    }
+  }
+  if (!add || s_caller_count >= TASK_PLAN_MAX_CALLERS || task == NULL) {
+    return NULL;
+  }
+  c = &s_callers[s_caller_count++];
+  c->mutex = m->mutex;
+  c->task = task;
+  c->index = (uint8_t)(m - s_mutexes);
+  name = pcTaskGetName((TaskHandle_t)task);
+  for (uint8_t i = 0; i < TASK_PLAN_TASK_NAME_LEN - 1U && name[i] != '\0'; i++) {
+    c->stats.task[i] = name[i];
+  }
+  return c;
+}
+
+static uint32_t task_plan_cycles_to_us(uint32_t cycles) {
+  return cycles / (SystemCoreClock / 1000000U);
+}
+
+static const char *task_plan_name(const TaskPlan_MutexStats_t *s) {
+  return s->name != NULL ? s->name : "?";
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 登记互斥锁
+ */
+void TaskPlan_WatchMutex(void *mutex, const char *name, uint32_t hold_warn_ms) {
+  TaskPlan_Mutex_t *m;
+
+  if (mutex == NULL) {
+    return;
+  }
+  vQueueAddToRegistry((QueueHandle_t)mutex, name);
+
+  taskENTER_CRITICAL();
+  m = task_plan_find(mutex, true);
+  if (m != NULL) {
+    m->stats.name = name;
+    m->stats.warn_us = hold_warn_ms * 1000U;
+  }
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 获取统计
+ */
+bool TaskPlan_GetMutexStats(uint8_t index, TaskPlan_MutexStats_t *out) {
+  bool ok = false;
+
+  taskENTER_CRITICAL();
+  if (index < s_mutex_count) {
+    *out = s_mutexes[index].stats;
+    ok = true;
+  }
+  taskEXIT_CRITICAL();
+  return ok;
+}
+
+/**
+ * @brief 获取 (互斥锁, 任务) 组合的统计
+ */
+bool TaskPlan_GetCallerStats(uint8_t index, TaskPlan_CallerStats_t *out) {
+  bool ok = false;
+
+  taskENTER_CRITICAL();
+  if (index < s_caller_count) {
+    *out = s_callers[index].stats;
+    out->mutex = s_mutexes[s_callers[index].index].stats.name;
+    ok = true;
+  }
+  taskEXIT_CRITICAL();
+  return ok;
+}
+
+/**
+ * @brief 清零计数与时间
+ * @note  正在等待或持有的锁保留计时起点，结算时照常计入
+ */
+void TaskPlan_ResetMutexStats(void) {
+  taskENTER_CRITICAL();
+  for (uint8_t i = 0; i < s_mutex_count; i++) {
+    TaskPlan_MutexStats_t *s = &s_mutexes[i].stats;
+    const char *name = s->name;
+    uint32_t warn_us = s->warn_us;
+
+    memset(s, 0, sizeof(*s));
+    s->name = name;
+    s->warn_us = warn_us;
+    s_mutexes[i].reported_over = 0;
+    s_mutexes[i].reported_inherits = 0;
+  }
+  for (uint8_t i = 0; i < s_caller_count; i++) {
+    TaskPlan_CallerStats_t *s = &s_callers[i].stats;
+
+    memset(&s->takes, 0, sizeof(*s) - offsetof(TaskPlan_CallerStats_t, takes));
+  }
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 输出新出现的超时持有与优先级继承
+ */
+void TaskPlan_LogReport(void) {
+  for (uint8_t i = 0; i < s_mutex_count; i++) {
+    TaskPlan_Mutex_t *m = &s_mutexes[i];
+    TaskPlan_MutexStats_t s;
+    uint32_t over, inherits;
+
+    taskENTER_CRITICAL();
+    s = m->stats;
+    over = s.over - m->reported_over;
+    inherits = s.inherits - m->reported_inherits;
+    m->reported_over = s.over;
+    m->reported_inherits = s.inherits;
+    taskEXIT_CRITICAL();
+
+    if (over != 0) {
+      LOG_WARN("互斥锁 %s 持有超过 %lu ms %lu 次，最长 %lu.%03lu ms (%s)",
+               task_plan_name(&s), (unsigned long)(s.warn_us / 1000U),
+               (unsigned long)over, (unsigned long)(s.max_hold_us / 1000U),
+               (unsigned long)(s.max_hold_us % 1000U),
+               s.max_holder != NULL ? pcTaskGetName((TaskHandle_t)s.max_holder)
+                                    : "-");
+    }
+    if (inherits != 0) {
+      LOG_INFO("互斥锁 %s 发生优先级继承 %lu 次", task_plan_name(&s),
+               (unsigned long)inherits);
+    }
+  }
+}
+
+/**
+ * @brief 互斥锁被获取 (xQueueSemaphoreTake 成功分支)
+ */
+void TaskPlan_TraceMutexTake(void *mutex) {
+  TaskPlan_Mutex_t *m = task_plan_find(mutex, true);
+  TaskPlan_Caller_t *c;
+  uint32_t now = DWT->CYCCNT;
+
+  if (m == NULL) {
+    return;
+  }
+  m->take_cycles = now;
+  m->stats.takes++;
+
+  c = task_plan_caller(m, true);
+  m->holder = c;
+  if (c == NULL) {
+    return;
+  }
+  c->stats.takes++;
+  if (c->block_cycles != 0) {
+    uint32_t wait_us = task_plan_cycles_to_us(now - c->block_cycles);
+
+    c->block_cycles = 0;
+    c->stats.wait_total_us += wait_us;
+    m->stats.wait_total_us += wait_us;
+    if (wait_us > c->stats.max_wait_us) {
+      c->stats.max_wait_us = wait_us;
+    }
+    if (wait_us > m->stats.max_wait_us) {
+      m->stats.max_wait_us = wait_us;
+    }
+    METRIC_OBSERVE(METRIC_MUTEX_WAIT, wait_us);
+  }
+}
+
+/**
+ * @brief 互斥锁被释放 (xQueueGenericSend)
+ */
+void TaskPlan_TraceMutexGive(void *mutex) {
+  TaskPlan_Mutex_t *m = task_plan_find(mutex, false);
+  uint32_t hold_us;
+
+  // 创建互斥锁时的首次释放没有对应的获取
+  if (m == NULL || m->take_cycles == 0) {
+    return;
+  }
+  hold_us = task_plan_cycles_to_us(DWT->CYCCNT - m->take_cycles);
+  m->take_cycles = 0;
+
+  m->stats.hold_total_us += hold_us;
+  if (m->holder != NULL) {
+    m->holder->stats.hold_total_us += hold_us;
+    if (hold_us > m->holder->stats.max_hold_us) {
+      m->holder->stats.max_hold_us = hold_us;
+    }
+    m->holder = NULL;
+  }
+
+  if (hold_us > m->stats.max_hold_us) {
+    m->stats.max_hold_us = hold_us;
+    m->stats.max_holder = xTaskGetCurrentTaskHandle();
+  }
+  if (m->stats.warn_us != 0 && hold_us > m->stats.warn_us) {
+    m->stats.over++;
+  }
+}
+
+/**
+ * @brief 获取互斥锁时需要阻塞等待 (调度器已挂起)
+ */
+void TaskPlan_TraceMutexBlock(void *mutex, void *holder) {
+  TaskPlan_Mutex_t *m;
+  TaskPlan_Caller_t *c;
+
+  taskENTER_CRITICAL();
+  m = task_plan_find(mutex, false);
+  c = (m != NULL) ? task_plan_caller(m, true) : NULL;
+  // 被唤醒后锁又被抢走时会再次阻塞，只有第一次计为一次等待
+  if (m != NULL && (c == NULL || c->block_cycles == 0)) {
+    m->stats.waits++;
+    if (c != NULL) {
+      c->stats.waits++;
+      c->block_cycles = DWT->CYCCNT | 1U;
+    }
+    if (holder != NULL &&
+        uxTaskPriorityGet(NULL) > uxTaskPriorityGet((TaskHandle_t)holder)) {
+      m->stats.inherits++;
+    }
+  }
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 获取互斥锁失败 (xQueueSemaphoreTake 超时或不等待)
+ */
+void TaskPlan_TraceMutexTimeout(void *mutex) {
+  TaskPlan_Mutex_t *m;
+  TaskPlan_Caller_t *c;
+
+  taskENTER_CRITICAL();
+  m = task_plan_find(mutex, false);
+  c = (m != NULL) ? task_plan_caller(m, false) : NULL;
+  if (m != NULL) {
+    m->stats.timeouts++;
+    METRIC_INC(METRIC_MUTEX_TIMEOUTS);
+  }
+  if (c != NULL) {
+    c->stats.timeouts++;
+    if (c->block_cycles != 0) {
+      uint32_t wait_us = task_plan_cycles_to_us(DWT->CYCCNT - c->block_cycles);
+
+      c->block_cycles = 0;
+      c->stats.wait_total_us += wait_us;
+      m->stats.wait_total_us += wait_us;
+    }
+  }
+  taskEXIT_CRITICAL();
+}
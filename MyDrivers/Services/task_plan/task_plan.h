@@ -0,0 +1,152 @@
+/**
+ ******************************************************************************
+ * @file    task_plan.h
+ * @brief   任务优先级规划与互斥锁持有时间检查
+ * @details 所有任务的优先级都在这里统一规定 (FreeRTOS 数值，0 最低)，
+ *          各模块头文件中的 xxx_TASK_PRIORITY 引用这里的定义
+ *          (本头文件不依赖 FreeRTOS 头文件，可被任意模块头文件包含)：
+ *
+ *            6 掉电写入       监控任务收到 PVD 预警时临时提升 (osPriorityRealtime)
+ *            5 I2C 总线服务   高于所有总线使用者，事务在提交后立即执行
+ *            4 传感器采样     只等待截止时间与总线，采样时刻不受界面负载影响
+ *            3 输出控制       电机闭环、自动调光 (10 ms 周期)
+ *              触摸服务       读取触摸芯片，为界面提供输入
+ *              Modbus 从站     应答只读 RAM 映像，主站等待应答有超时
+ *            2 LVGL 界面      渲染耗时最长，低于所有实时工作
+ *              启动工作任务   只在启动期间存在，与界面的启动阶段轮流执行
+ *            1 日志/命令行/传感器记录/遥测上行   后台输出、Flash 写入与
+ *                             Wi-Fi 上行，可以被推迟
+ *            0 系统监控       资源采样、配置写回、看门狗
+ *
+ *          共享资源只通过互斥锁访问 (FreeRTOS 互斥锁带优先级继承)：
+ *          低优先级任务持有锁时，等待它的高优先级任务会把持有者临时提升，
+ *          因此持有时间越长，高优先级任务的延迟就越大。互斥锁的获取与释放
+ *          通过 FreeRTOS 跟踪宏 (FreeRTOSConfig.h) 计时，持有时间超过阈值
+ *          或等待者触发优先级继承时计数，由监控任务周期输出告警。
+ *
+ *          除持有时间外还统计争用：从第一次阻塞到获取成功 (或超时) 的等待
+ *          时间按互斥锁与"互斥锁 + 调用任务"两级累计，持有时间也记到获取
+ *          它的任务名下，命令行 locks 与诊断界面据此找出谁在等、谁在占。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __TASK_PLAN_H
+#define __TASK_PLAN_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 优先级规划 --------------------------- */
+#define TASK_PRIO_MONITOR 0  // 系统监控 (与空闲任务相同)
+#define TASK_PRIO_LOG 1      // 日志输出
+#define TASK_PRIO_SHELL 1    // 命令行
+#define TASK_PRIO_DATALOG 1  // 传感器记录写入 Flash
+#define TASK_PRIO_ARCHIVE 1  // 传感器记录归档到 SD 卡
+#define TASK_PRIO_TELEMETRY 1 // 遥测上行 (Wi-Fi 模块)
+#define TASK_PRIO_NET 1      // 以太网接收 (ARP、ICMP) 与链路检测
+#define TASK_PRIO_UI 2       // LVGL 界面
+#define TASK_PRIO_BOOT 2     // 启动工作任务
+#define TASK_PRIO_OUTPUT 3   // 输出控制
+#define TASK_PRIO_TOUCH 3    // 触摸服务
+#define TASK_PRIO_MODBUS 3   // Modbus RTU 从站 / 网关主站 (二者共用 RS-485，只启用其一)
+#define TASK_PRIO_CAN 3      // CAN 传感器网络收发
+#define TASK_PRIO_SAMPLING 4 // 传感器采样
+#define TASK_PRIO_I2C_BUS 5  // I2C 总线服务
+#define TASK_PRIO_POWER_FAIL 6 // 掉电写入 (临时)
+
+/* FreeRTOS 数值优先级转换为 CMSIS-RTOS 优先级 (osThreadDef 使用) */
+#define TASK_PLAN_OS_PRIO(prio) ((osPriority)((int)(prio) + (int)osPriorityIdle))
+
+/* --------------------------- 系统配置 --------------------------- */
+#define TASK_PLAN_MAX_MUTEXES 10       // 可统计的互斥锁数
+#define TASK_PLAN_HOLD_WARN_MS 5       // 未登记互斥锁的持有时间告警阈值
+#define TASK_PLAN_MAX_CALLERS 32       // 可统计的 (互斥锁, 任务) 组合数
+#define TASK_PLAN_TASK_NAME_LEN 16     // 任务名长度 (与 configMAX_TASK_NAME_LEN 一致)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 单个互斥锁的持有时间统计
+ */
+typedef struct {
+  const char *name;       // 登记的名称 (未登记为 NULL)
+  uint32_t takes;         // 获取次数
+  uint32_t over;          // 持有时间超过阈值的次数
+  uint32_t waits;         // 获取时锁已被持有、需要阻塞等待的次数
+  uint32_t inherits;      // 其中等待者优先级高于持有者 (发生优先级继承) 的次数
+  uint32_t max_hold_us;   // 最长持有时间
+  uint32_t warn_us;       // 告警阈值
+  void *max_holder;       // 最长一次的持有者 (TaskHandle_t)
+  uint32_t timeouts;      // 等待超时 (获取失败) 的次数
+  uint32_t max_wait_us;   // 最长等待时间
+  uint64_t wait_total_us; // 累计等待时间
+  uint64_t hold_total_us; // 累计持有时间
+} TaskPlan_MutexStats_t;
+
+/**
+ * @brief 某个任务使用某个互斥锁的统计
+ */
+typedef struct {
+  const char *mutex;                  // 互斥锁名称 (未登记为 NULL)
+  char task[TASK_PLAN_TASK_NAME_LEN]; // 任务名 (加入时复制，任务删除后仍有效)
+  uint32_t takes;                     // 获取次数
+  uint32_t waits;                     // 需要阻塞等待的次数
+  uint32_t timeouts;                  // 等待超时的次数
+  uint32_t max_wait_us;               // 最长等待时间
+  uint32_t max_hold_us;               // 最长持有时间
+  uint64_t wait_total_us;             // 累计等待时间
+  uint64_t hold_total_us;             // 累计持有时间
+} TaskPlan_CallerStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 登记互斥锁的名称与持有时间阈值
+ * @param mutex       互斥锁 (SemaphoreHandle_t)
+ * @param name        名称 (同时加入 FreeRTOS 队列注册表，调试器可见)
+ * @param hold_warn_ms 允许的最长持有时间 (如 Flash 擦除期间持有的锁取擦除时间)，
+ *                     0 表示按设计长时间持有 (只统计等待与优先级继承)
+ * @note  在创建互斥锁后调用；未登记的互斥锁第一次被获取时自动加入统计
+ */
+void TaskPlan_WatchMutex(void *mutex, const char *name, uint32_t hold_warn_ms);
+
+/**
+ * @brief 获取第 index 个互斥锁的统计
+ * @return false: 没有该项
+ */
+bool TaskPlan_GetMutexStats(uint8_t index, TaskPlan_MutexStats_t *out);
+
+/**
+ * @brief 获取第 index 个 (互斥锁, 任务) 组合的统计
+ * @return false: 没有该项
+ */
+bool TaskPlan_GetCallerStats(uint8_t index, TaskPlan_CallerStats_t *out);
+
+/**
+ * @brief 清零所有计数与时间 (保留登记的名称与阈值)
+ */
+void TaskPlan_ResetMutexStats(void);
+
+/**
+ * @brief 输出上次调用以来新出现的超时持有与优先级继承
+ * @note  由监控任务周期调用
+ */
+void TaskPlan_LogReport(void);
+
+/* 跟踪宏钩子 (由 queue.c 在临界区或调度器挂起时调用，不要直接调用) */
+void TaskPlan_TraceMutexTake(void *mutex);
+void TaskPlan_TraceMutexGive(void *mutex);
+void TaskPlan_TraceMutexBlock(void *mutex, void *holder);
+void TaskPlan_TraceMutexTimeout(void *mutex);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TASK_PLAN_H */
@@ -0,0 +1,234 @@
+/**
+ ******************************************************************************
+ * @file    task_wdt.c
+ * @brief   任务健康监督 (独立看门狗) 实现
+ * @details 报到时间与等待标志由各任务写、监控任务读，都是单字访问；
+ *          报到时先写时间再清等待标志，监控任务不会看到旧时间。
+ *          卡死记录写入 RTC 备份寄存器 (BKP0R/BKP1R/BKP8R 由 rtc_clock 使用)：
+ *            BKP2R  标记 | 编号，BKP3R 超时时长，BKP4R~BKP7R 任务名称。
+ *          备份域在 IWDG 复位时保持，只有备份域掉电 (无 VBAT) 时丢失。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "task_wdt.h"
+#include "FreeRTOS.h"
+#include "main.h"
+#include "sys_monitor.h"
+#include "task.h"
+#include <string.h>
+
+#define LOG_MODULE "WDT"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define TASK_WDT_LSI_HZ 32000U      // LSI 标称频率 (实际 17~47 kHz)
+#define TASK_WDT_PRESCALER_DIV 64U  // IWDG_PR = 4
+#define TASK_WDT_RELOAD \
+  (TASK_WDT_IWDG_TIMEOUT_MS * (TASK_WDT_LSI_HZ / TASK_WDT_PRESCALER_DIV) / 1000U)
+
+#define TASK_WDT_MAGIC 0xD06A0000U  // BKP2R 高 16 位: 有卡死记录
+#define TASK_WDT_MAGIC_MASK 0xFFFF0000U
+#define TASK_WDT_NAME_WORDS 4       // BKP4R~BKP7R
+
+/* --------------------------- 私有变量 --------------------------- */
+typedef struct {
+  TaskHandle_t handle;
+  uint32_t deadline_ms;
+  volatile uint32_t last_ms; // 上次报到时刻
+  volatile bool idle;        // 正在无限期等待事件
+} TaskWdt_Slot_t;
+
+static TaskWdt_Slot_t s_slots[TASK_WDT_MAX_TASKS];
+static uint8_t s_count;
+static bool s_started;
+static bool s_stalled; // 已判定超时，停止喂狗等待复位
+static TaskWdt_Stall_t s_last_stall;
+static bool s_last_stall_valid;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static TaskWdt_Slot_t *task_wdt_current(void) {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+
+  for (uint8_t i = 0; i < s_count; i++) {
+    if (s_slots[i].handle == self) {
+      return &s_slots[i];
+    }
+  }
+  return NULL;
+}
+
+static volatile uint32_t *task_wdt_bkp(uint8_t index) {
+  return &RTC->BKP0R + index;
+}
+
+/* 把卡死任务写入备份寄存器 */
+static void task_wdt_save_stall(uint8_t id, uint32_t overdue_ms) {
+  const char *name = pcTaskGetName(s_slots[id].handle);
+  uint32_t words[TASK_WDT_NAME_WORDS];
+
+  memset(words, 0, sizeof(words));
+  strncpy((char *)words, name, sizeof(words) - 1);
+
+  __HAL_RCC_PWR_CLK_ENABLE();
+  HAL_PWR_EnableBkUpAccess();
+  for (uint8_t i = 0; i < TASK_WDT_NAME_WORDS; i++) {
+    *task_wdt_bkp(4 + i) = words[i];
+  }
+  *task_wdt_bkp(3) = overdue_ms;
+  *task_wdt_bkp(2) = TASK_WDT_MAGIC | id; // 最后写标记，记录总是完整的
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 登记当前任务
+ */
+int8_t TaskWdt_Register(uint32_t deadline_ms) {
+  TaskHandle_t self = xTaskGetCurrentTaskHandle();
+  int8_t id = -1;
+
+  taskENTER_CRITICAL();
+  if (s_count < TASK_WDT_MAX_TASKS) {
+    id = (int8_t)s_count;
+    s_slots[id].handle = self;
+    s_slots[id].deadline_ms = deadline_ms;
+    s_slots[id].last_ms = HAL_GetTick();
+    s_slots[id].idle = false;
+    s_count++; // 槽位填好后才对监控任务可见
+  }
+  taskEXIT_CRITICAL();
+
+  if (id < 0) {
+    LOG_ERROR("登记表已满，任务 %s 不受监督", pcTaskGetName(self));
+  }
+  return id;
+}
+
+/**
+ * @brief 当前任务报到
+ */
+void TaskWdt_CheckIn(void) {
+  TaskWdt_Slot_t *slot = task_wdt_current();
+
+  if (slot == NULL) {
+    return;
+  }
+  slot->last_ms = HAL_GetTick();
+  __DMB();
+  slot->idle = false;
+}
+
+/**
+ * @brief 当前任务进入无限期等待
+ */
+void TaskWdt_Idle(void) {
+  TaskWdt_Slot_t *slot = task_wdt_current();
+
+  if (slot != NULL) {
+    slot->idle = true;
+  }
+}
+
+/**
+ * @brief 启动独立看门狗
+ */
+void TaskWdt_Start(void) {
+  if (s_started) {
+    return;
+  }
+  s_started = true;
+#if TASK_WDT_ENABLE
+  DBGMCU->APB1FZ |= DBGMCU_APB1_FZ_DBG_IWDG_STOP;
+
+  IWDG->KR = 0xCCCC; // 启动 (同时打开 LSI)
+  IWDG->KR = 0x5555; // 解锁 PR/RLR
+  IWDG->PR = 4;      // 64 分频
+  IWDG->RLR = TASK_WDT_RELOAD;
+  while (IWDG->SR != 0) {
+  }
+  IWDG->KR = 0xAAAA;
+  LOG_INFO("看门狗已启动，超时 %u ms，监督 %u 个任务",
+           (unsigned)TASK_WDT_IWDG_TIMEOUT_MS, s_count);
+#endif
+}
+
+/**
+ * @brief 检查截止时间并喂狗
+ */
+bool TaskWdt_Supervise(void) {
+  uint32_t now = HAL_GetTick();
+  uint8_t count = s_count;
+
+  if (s_stalled) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < count; i++) {
+    TaskWdt_Slot_t *slot = &s_slots[i];
+    uint32_t elapsed;
+
+    if (slot->idle) {
+      continue;
+    }
+    // 报到时刻可能晚于 now (读取 now 之后被抢占)，按有符号比较
+    elapsed = now - slot->last_ms;
+    if ((int32_t)elapsed > (int32_t)slot->deadline_ms) {
+      s_stalled = true;
+      task_wdt_save_stall(i, elapsed);
+      LOG_ERROR("任务 %s 已 %lu ms 未报到 (截止 %lu ms)，等待看门狗复位",
+                pcTaskGetName(slot->handle), (unsigned long)elapsed,
+                (unsigned long)slot->deadline_ms);
+      return false;
+    }
+  }
+
+#if TASK_WDT_ENABLE
+  if (s_started) {
+    IWDG->KR = 0xAAAA;
+  }
+#endif
+  return true;
+}
+
+/**
+ * @brief 读取上次复位前记录的卡死任务
+ */
+bool TaskWdt_GetLastStall(TaskWdt_Stall_t *stall) {
+  if (s_last_stall_valid && stall != NULL) {
+    *stall = s_last_stall;
+  }
+  return s_last_stall_valid;
+}
+
+/**
+ * @brief 输出上次复位的看门狗信息并清除记录
+ */
+void TaskWdt_ReportLastReset(void) {
+  uint32_t tag = *task_wdt_bkp(2);
+  uint32_t words[TASK_WDT_NAME_WORDS];
+
+  if ((tag & TASK_WDT_MAGIC_MASK) == TASK_WDT_MAGIC) {
+    for (uint8_t i = 0; i < TASK_WDT_NAME_WORDS; i++) {
+      words[i] = *task_wdt_bkp(4 + i);
+    }
+    memcpy(s_last_stall.name, words, sizeof(s_last_stall.name));
+    s_last_stall.name[sizeof(s_last_stall.name) - 1] = '\0';
+    s_last_stall.id = (uint8_t)(tag & 0xFFU);
+    s_last_stall.overdue_ms = *task_wdt_bkp(3);
+    s_last_stall_valid = true;
+
+    __HAL_RCC_PWR_CLK_ENABLE();
+    HAL_PWR_EnableBkUpAccess();
+    *task_wdt_bkp(2) = 0;
+
+    LOG_ERROR("上次复位 (%s): 任务 #%u %s 超过 %lu ms 未报到",
+              SysMonitor_ResetCauseName(SysMonitor_GetResetCause()),
+              s_last_stall.id, s_last_stall.name,
+              (unsigned long)s_last_stall.overdue_ms);
+  } else if (SysMonitor_GetResetCause() == SYS_RESET_IWDG) {
+    LOG_ERROR("上次复位: 看门狗超时，无卡死记录 (监控任务未能运行)");
+  }
+}
@@ -0,0 +1,106 @@
+/**
+ ******************************************************************************
+ * @file    task_wdt.h
+ * @brief   任务健康监督 (独立看门狗) 头文件
+ * @details 需要监督的任务启动后登记一个截止时间，之后每轮工作调用
+ *          TaskWdt_CheckIn() 报到。监控任务周期调用 TaskWdt_Supervise()，
+ *          只有全部任务都在截止时间内报到时才喂独立看门狗 (IWDG)：
+ *            - 某个任务超时 (卡在 I2C 总线锁、等待 DMA 发送等) 时，把任务
+ *              编号、名称与超时时长写入 RTC 备份寄存器后停止喂狗，
+ *              IWDG 在 TASK_WDT_IWDG_TIMEOUT_MS 内复位系统；
+ *            - 更高优先级的任务死循环使监控任务得不到运行时同样停止喂狗，
+ *              这种情况没有卡死记录，下次启动按看门狗复位报告。
+ *          任务在无限期等待事件 (命令、日志、串口输入) 之前调用
+ *          TaskWdt_Idle()，等待期间不计截止时间，下一次报到时恢复监督。
+ *          下次启动时 TaskWdt_ReportLastReset() 输出复位原因与卡死任务。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __TASK_WDT_H
+#define __TASK_WDT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define TASK_WDT_ENABLE 1             // 0: 不启动 IWDG，只做超时检测与日志
+#define TASK_WDT_MAX_TASKS 8          // 可登记的任务数
+#define TASK_WDT_IWDG_TIMEOUT_MS 4000 // IWDG 超时 (须大于监控任务周期 500 ms)
+
+/* 各任务的报到截止时间 (大于各自最长的正常睡眠时间) */
+#define TASK_WDT_DEADLINE_UI_MS 10000     // LVGL 任务 (熄屏时每 5 s 醒来)
+#define TASK_WDT_DEADLINE_SENSOR_MS 15000 // 传感器任务 (最长睡到状态日志 10 s)
+#define TASK_WDT_DEADLINE_OUTPUT_MS 2000  // 输出控制任务 (周期工作时 10 ms)
+#define TASK_WDT_DEADLINE_LOG_MS 5000     // 日志任务 (等待 DMA 发送)
+#define TASK_WDT_DEADLINE_SHELL_MS 10000  // 命令行任务 (长命令在循环中报到)
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 上次复位前记录的卡死任务 (RTC 备份寄存器)
+ */
+typedef struct {
+  uint8_t id;           // 登记编号 (按登记顺序)
+  char name[16];        // 任务名称
+  uint32_t overdue_ms;  // 判定时距上次报到的时间
+} TaskWdt_Stall_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 登记当前任务
+ * @param deadline_ms 两次报到之间允许的最长间隔
+ * @return 登记编号，登记表已满时返回 -1
+ * @note  在任务函数中调用，登记即视为一次报到
+ */
+int8_t TaskWdt_Register(uint32_t deadline_ms);
+
+/**
+ * @brief 当前任务报到 (未登记的任务调用无效)
+ * @note  耗时较长的操作 (批量导出、擦除) 在循环中调用以延续截止时间
+ */
+void TaskWdt_CheckIn(void);
+
+/**
+ * @brief 当前任务即将无限期等待事件，等待期间不检查截止时间
+ * @note  可能卡住的操作 (总线锁、DMA 发送) 必须发生在下一次
+ *        TaskWdt_CheckIn() 之后，否则不受监督
+ */
+void TaskWdt_Idle(void);
+
+/**
+ * @brief 启动独立看门狗 (启动后无法停止)
+ * @note  在所有启动阶段完成后由监控任务调用；调试器暂停内核时 IWDG 同时暂停
+ */
+void TaskWdt_Start(void);
+
+/**
+ * @brief 检查所有任务的截止时间，全部正常时喂狗
+ * @return true: 全部正常, false: 有任务超时 (已停止喂狗)
+ * @note  只由监控任务周期调用，周期须远小于 TASK_WDT_IWDG_TIMEOUT_MS
+ */
+bool TaskWdt_Supervise(void);
+
+/**
+ * @brief 读取上次复位前记录的卡死任务
+ * @return true: 上次复位由任务超时引起
+ */
+bool TaskWdt_GetLastStall(TaskWdt_Stall_t *stall);
+
+/**
+ * @brief 输出上次复位的看门狗信息并清除备份寄存器中的记录
+ * @note  在日志初始化之后、看门狗启动之前调用一次
+ */
+void TaskWdt_ReportLastReset(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TASK_WDT_H */
@@ -0,0 +1,1007 @@
+/**
+ ******************************************************************************
+ * @file    telemetry.c
+ * @brief   遥测上行服务实现
+ * @details 批次缓冲区按环形队列使用：s_first 为最旧的待发批次，其后
+ *          s_pending 个为已封存的批次，再下一个为正在攒的批次。封存时队列
+ *          已满则正在攒的位置与最旧的待发批次重合，丢弃后者。
+ *          记录在到达时即编码进正在攒的批次，封存时只需填写帧头与 CRC。
+ *          离线缓存按日志时间记账：[s_ack, s_gap_end) 为 Flash 中待补发的
+ *          区间，批次被移出队列时区间向后延伸到该批次的末尾，本次上电之前
+ *          未送达的记录在启动时并入区间。从旧到新补发时 s_ack 随每批前移；
+ *          从新到旧补发时每次取区间顶部的一段 [s_seg_lo, s_gap_end)，段内
+ *          从 s_seg_cur 向后补发，段发完后区间顶部下移到 s_seg_lo。
+ *          补发批次只在同一秒的记录之间切分 (批次写满时回退到本秒开始处)，
+ *          下一批从切分处的秒开始。
+ *          实时批次开始时记下墙上时钟与上电时间的毫秒差，记录时间按该差值
+ *          的秒内部分换算后取整秒，基准时间加上整秒部分，记录落在墙上时钟
+ *          的整秒上 (与 RTC 秒对齐的采样不会因取整偏到相邻的秒)。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "telemetry.h"
+#include "checksum.h"
+#include "telemetry_codec.h"
+#include "telemetry_edge.h"
+#include "esp_at.h"
+#include "net_udp.h"
+#include "config_store.h"
+#include "rtc_clock.h"
+#include "sensor_event_bus.h"
+#include "sensor_log.h"
+#include "sys_clock.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOG_MODULE "TELEM"
+#include "log.h"
+
+/* --------------------------- 私有宏 --------------------------- */
+#define TELEMETRY_CRC_LEN 4
+#define TELEMETRY_SEND_TIMEOUT_MS 5000 // 发送后等待 SEND OK 的时间
+#define TELEMETRY_JOIN_TIMEOUT_MS 20000
+#define TELEMETRY_CONNECT_TIMEOUT_MS 10000
+#define TELEMETRY_SNTP_QUERY_MS 500     // 单次查询模块时间的超时
+#define TELEMETRY_SNTP_WINDOW_MS 1500   // 捕捉秒跳变的最长时间
+#define TELEMETRY_SNTP_MIN_YEAR 2024    // 早于该年份说明模块尚未取得网络时间
+#define TELEMETRY_EDGE_GRACE_MS 2000    // 窗口结束后等待迟到样本的时间
+
+typedef struct {
+  TelemetryHeader_t header;
+  uint8_t payload[TELEMETRY_PAYLOAD_MAX + TELEMETRY_CRC_LEN]; // CRC 紧跟负载
+  uint8_t count;   // 记录数 (不发送)
+  uint32_t t_last; // 最后一条记录的时间 (上电秒数，不发送)
+} TelemetryFrame_t;
+
+typedef struct {
+  TelemetryHeader_t header;
+  uint8_t payload[TELEMETRY_CODEC_SCHEMA_MAX + TELEMETRY_CRC_LEN];
+} TelemetrySchemaFrame_t;
+
+typedef struct {
+  TelemetryHeader_t header;
+  uint8_t payload[TELEMETRY_CODEC_METRICS_MAX + TELEMETRY_CRC_LEN];
+} TelemetryMetricsFrame_t;
+
+/* 补发批次的编码上下文 */
+typedef struct {
+  uint32_t t_base; // 日志时间 - 帧内时间
+  uint32_t t_cur;  // 当前所在的秒
+  uint32_t t_cut;  // 下一批的起始日志时间
+} TelemetryReplay_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static TelemetryFrame_t s_frames[TELEMETRY_BATCH_QUEUE];
+static uint8_t s_first = 0;       // 最旧的待发批次
+static uint8_t s_pending = 0;     // 待发批次数
+static uint32_t s_build_start;    // 正在攒的批次第一条记录的帧内时间
+static uint32_t s_build_last;     // 正在攒的批次最晚一条样本的时间 (上电秒数)
+static uint32_t s_build_seal_at;  // 正在攒的批次的封存时刻 (上电秒数)
+static uint64_t s_build_clock_ms; // 正在攒的批次的墙上时钟 - 上电时间 (ms)
+static uint8_t s_build_flags;     // 正在攒的批次的时基标志
+static uint16_t s_seq = 0;
+static uint32_t s_unit_id;
+static TelemetryEncoder_t s_enc;  // 正在攒的批次的编码状态
+static TelemetrySchemaFrame_t s_schema;
+static bool s_schema_sent = false; // 当前链路上已发送模式描述
+static uint8_t s_schema_sensors = 0; // 模式描述包含的传感器数
+static uint32_t s_retry_at = 0;   // 下一次允许连接/发送的时间 (上电秒数)
+static uint32_t s_backoff_s = 0;
+static volatile bool s_flush_req = false;
+static uint64_t s_edge_start_ms;  // 当前汇总窗口的起点 (上电毫秒)
+static uint64_t s_edge_end_ms;    // 当前汇总窗口的终点
+static bool s_sntp = false;       // 模块已配置 SNTP
+static uint32_t s_sntp_at = 0;    // 下一次校时的时间 (上电秒数)
+static TelemetryMetricsFrame_t s_metrics;
+static uint32_t s_metrics_at = TELEMETRY_METRICS_INTERVAL_S; // 下一次发送指标快照的时间
+static TelemetryStats_t s_stats;
+
+/* 离线缓存 (日志时间，只由上行任务访问) */
+static bool s_outbox = false;
+static uint32_t s_boot_log;       // 本次上电时的日志时间
+static uint32_t s_log_offset;     // 日志时间 - 上电秒数
+static uint32_t s_ack;            // 此前的记录均已送达
+static uint32_t s_gap_end;        // [s_ack, s_gap_end) 待补发
+static uint32_t s_sent_hi;        // 已送达记录的最大日志时间 + 1
+static uint32_t s_seg_lo;         // 从新到旧补发时当前段的起点
+static uint32_t s_seg_cur;        // 当前段内下一批的起点
+static uint32_t s_ack_saved;      // 配置存储中的游标
+static uint32_t s_ack_saved_at;   // 上次保存游标的时间 (上电秒数)
+static TickType_t s_replay_at;    // 下一批补发的最早时刻
+static uint32_t s_replay_cut;     // 已编码的补发批次送达后的游标
+static TelemetryFrame_t s_replay; // 补发批次 (count 非 0 表示已编码待发)
+static TelemetryEncoder_t s_replay_enc;
+static TelemetryEncoder_t s_replay_mark; // 当前秒开始前的编码状态
+
+static SensorEventSub_t s_sub = -1;
+static TaskHandle_t s_task = NULL;
+static StaticTask_t s_task_tcb;
+static StackType_t s_task_stack[TELEMETRY_TASK_STACK_SIZE];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static TelemetryFrame_t *telemetry_building(void) {
+  return &s_frames[(s_first + s_pending) % TELEMETRY_BATCH_QUEUE];
+}
+
+static uint16_t telemetry_frame_len(const TelemetryHeader_t *h) {
+  return (uint16_t)(sizeof(TelemetryHeader_t) + h->length + TELEMETRY_CRC_LEN);
+}
+
+/**
+ * @brief 填写帧头的公共字段并在负载后追加 CRC
+ */
+static void telemetry_finish(TelemetryHeader_t *h, uint16_t length) {
+  uint32_t crc;
+
+  h->magic[0] = TELEMETRY_FRAME_MAGIC0;
+  h->magic[1] = TELEMETRY_FRAME_MAGIC1;
+  h->version = TELEMETRY_FRAME_VERSION;
+  h->unit_id = s_unit_id;
+  h->length = length;
+  h->schema_id = s_stats.schema_id;
+
+  crc = CRC32_Compute((const uint8_t *)h, sizeof(TelemetryHeader_t) + length);
+  memcpy((uint8_t *)(h + 1) + length, &crc, TELEMETRY_CRC_LEN);
+}
+
+/**
+ * @brief 上电时间到墙上时钟的偏移 (ms)，并设置时基标志
+ */
+static uint64_t telemetry_clock_ms(uint8_t *flags) {
+  if (RtcClock_IsSet()) {
+    *flags |= TELEMETRY_FLAG_RTC;
+    return RtcClock_NowMillis() - SysClock_Millis();
+  }
+  return 0;
+}
+
+/**
+ * @brief 帧内时间 (上电秒数) 到基准时间的偏移 (取整到秒)，并设置时基标志
+ */
+static uint32_t telemetry_clock(uint8_t *flags) {
+  return (uint32_t)((telemetry_clock_ms(flags) + 500U) / 1000U);
+}
+
+/**
+ * @brief 生成模式描述帧
+ */
+static bool telemetry_build_schema(void) {
+  TelemetryHeader_t *h = &s_schema.header;
+  uint16_t len = TelemetryCodec_BuildSchema(
+      s_schema.payload, TELEMETRY_CODEC_SCHEMA_MAX, &s_schema_sensors);
+
+  if (len == 0) {
+    return false;
+  }
+  s_stats.schema_id = CRC32_Compute(s_schema.payload, len);
+  h->flags = TELEMETRY_FLAG_SCHEMA;
+  h->seq = 0;
+  h->base_time = 0;
+  telemetry_finish(h, len);
+  return true;
+}
+
+/**
+ * @brief 新注册了传感器 (热插拔探测)：重新生成模式描述
+ * @details 新实例追加在注册表末尾，新模式是旧模式的超集，已编码的记录
+ *          仍按新模式解码，待发批次只需改写模式 ID 与 CRC。
+ */
+static void telemetry_update_schema(void) {
+  if (!telemetry_build_schema()) {
+    s_schema_sensors = SensorTask_GetSensorCount(); // 不再重试
+    LOG_ERROR("模式描述超出 %u 字节", (unsigned)TELEMETRY_CODEC_SCHEMA_MAX);
+    return;
+  }
+  for (uint8_t i = 0; i < s_pending; i++) {
+    TelemetryFrame_t *frame = &s_frames[(s_first + i) % TELEMETRY_BATCH_QUEUE];
+    telemetry_finish(&frame->header, frame->header.length);
+  }
+  if (s_replay.count != 0) {
+    telemetry_finish(&s_replay.header, s_replay.header.length);
+  }
+  s_schema_sent = false;
+  LOG_INFO("模式描述已更新: %u 个传感器", (unsigned)s_schema_sensors);
+}
+
+/**
+ * @brief 开始攒下一个批次：记下时基并安排封存时刻
+ * @param t_up 第一条样本的上电秒数
+ */
+static void telemetry_begin(uint32_t t_up) {
+  TelemetryFrame_t *frame = telemetry_building();
+  uint32_t wait = TELEMETRY_PUBLISH_INTERVAL_S;
+
+  s_build_flags =
+      TELEMETRY_MODE == TELEMETRY_MODE_EDGE ? TELEMETRY_FLAG_EDGE : 0;
+  s_build_clock_ms = telemetry_clock_ms(&s_build_flags);
+  if (s_build_flags & TELEMETRY_FLAG_RTC) {
+    /* 在墙上时钟按设备号错开的秒封存，各节点不在同一时刻发送 */
+    uint32_t wall = t_up + (uint32_t)(s_build_clock_ms / 1000U);
+    wait = (s_unit_id % TELEMETRY_PUBLISH_INTERVAL_S +
+            TELEMETRY_PUBLISH_INTERVAL_S -
+            wall % TELEMETRY_PUBLISH_INTERVAL_S) %
+           TELEMETRY_PUBLISH_INTERVAL_S;
+    if (wait == 0) {
+      wait = TELEMETRY_PUBLISH_INTERVAL_S;
+    }
+  }
+
+  frame->count = 0;
+  s_build_start = t_up;
+  s_build_last = t_up;
+  s_build_seal_at = t_up + wait;
+  TelemetryCodec_Begin(&s_enc, frame->payload, TELEMETRY_PAYLOAD_MAX, t_up);
+}
+
+/* --------------------------- 离线缓存 --------------------------- */
+
+static bool telemetry_outbox_empty(void) {
+  return !s_outbox || s_gap_end <= s_ack;
+}
+
+/**
+ * @brief 待补发的记录全部送达：游标前移到已送达的最大时间
+ */
+static void telemetry_outbox_close(void) {
+  if (s_sent_hi > s_ack) {
+    s_ack = s_sent_hi;
+  }
+  s_gap_end = s_ack;
+  LOG_INFO("离线缓存已补发完毕");
+}
+
+/**
+ * @brief 一批记录已送达 (实时批次或补发批次)
+ * @param end 该批次最后一条记录的日志时间 + 1
+ */
+static void telemetry_outbox_sent(uint32_t end) {
+  if (end > s_sent_hi) {
+    s_sent_hi = end;
+  }
+  if (s_gap_end <= s_ack) {
+    s_ack = s_sent_hi; // 没有待补发的记录：游标跟随实时批次
+  }
+}
+
+/**
+ * @brief 批次被移出 RAM 队列：补发区间延伸到该批次的末尾
+ */
+static void telemetry_outbox_defer(const TelemetryFrame_t *frame) {
+  uint32_t end = frame->t_last + s_log_offset + 1;
+
+  if (s_gap_end <= s_ack) {
+    s_gap_end = s_ack;
+    s_seg_lo = s_seg_cur = end; // 从新到旧补发时从新的顶部重新分段
+  }
+  if (end > s_gap_end) {
+    s_gap_end = end;
+  }
+}
+
+/**
+ * @brief 补发编码回调：按秒记下回退位置，写满时在秒边界切分
+ */
+static bool telemetry_replay_record(uint32_t t, const SensorLogRecord_t *rec,
+                                    void *user) {
+  TelemetryReplay_t *r = (TelemetryReplay_t *)user;
+  SensorHandle_t sensor = (SensorHandle_t)rec->type;
+  uint8_t channels = SensorTask_GetChannels(sensor, NULL);
+
+  if (t != r->t_cur) {
+    s_replay_mark = s_replay_enc; // 此前各秒的记录都已完整写入
+    r->t_cur = t;
+  }
+  if (channels == 0 ||
+      channels != ((rec->flags & SENSOR_LOG_FLAG_SECONDARY) ? 2 : 1)) {
+    return true; // 已不存在或通道数不同的传感器：模式描述中没有该传感器
+  }
+  if (TelemetryCodec_Put(&s_replay_enc, t - r->t_base, sensor, rec->value,
+                         channels)) {
+    return true;
+  }
+
+  if (s_replay_mark.count != 0) {
+    s_replay_enc = s_replay_mark; // 本秒的记录留给下一批
+    r->t_cut = t;
+  } else {
+    r->t_cut = t + 1; // 一秒内的记录超过一批 (不应出现)：丢弃该秒其余记录
+  }
+  return false;
+}
+
+/**
+ * @brief 从 Flash 读出 [lo, hi) 内的记录编码为一个补发批次
+ * @return 批次送达后下一批的起始日志时间
+ */
+static uint32_t telemetry_replay_build(uint32_t lo, uint32_t hi) {
+  TelemetryHeader_t *h = &s_replay.header;
+  TelemetryReplay_t r;
+  uint8_t flags = TELEMETRY_FLAG_REPLAY;
+  uint32_t offset = 0;
+
+  if (lo >= s_boot_log) {
+    r.t_base = s_log_offset; // 本次上电的记录与实时批次使用同一时基
+    offset = telemetry_clock(&flags);
+  } else {
+    r.t_base = 0;
+    flags |= TELEMETRY_FLAG_LOGTIME;
+  }
+  r.t_cur = lo;
+  r.t_cut = hi;
+  TelemetryCodec_Begin(&s_replay_enc, s_replay.payload, TELEMETRY_PAYLOAD_MAX,
+                       lo - r.t_base);
+  s_replay_mark = s_replay_enc;
+  (void)SensorLog_ForEach(lo, hi - 1, telemetry_replay_record, &r);
+
+  s_replay.count = s_replay_enc.count;
+  if (s_replay.count != 0) {
+    h->flags = flags;
+    h->seq = s_seq++;
+    h->base_time = lo - r.t_base + offset;
+    telemetry_finish(h, s_replay_enc.len);
+  }
+  return r.t_cut;
+}
+
+/**
+ * @brief 按限速周期保存送达游标
+ */
+static void telemetry_outbox_save(uint32_t now) {
+  if (!s_outbox || s_ack == s_ack_saved ||
+      now - s_ack_saved_at < TELEMETRY_OUTBOX_SAVE_S) {
+    return;
+  }
+  if (ConfigStore_Set(CONFIG_KEY_UPLINK_ACK, &s_ack, sizeof(s_ack))) {
+    s_ack_saved = s_ack;
+  }
+  s_ack_saved_at = now;
+}
+
+/**
+ * @brief 挂载离线缓存：恢复送达游标，本次上电之前未送达的记录待补发
+ * @return false: 日志区不可用
+ */
+static bool telemetry_outbox_init(void) {
+  SensorLogStats_t log;
+  uint32_t ack;
+
+  SensorLog_GetStats(&log);
+  if (!log.ready) {
+    return false;
+  }
+  s_boot_log = log.now;
+  s_log_offset = s_boot_log - SysClock_Seconds();
+
+  if (!ConfigStore_Get(CONFIG_KEY_UPLINK_ACK, &ack, sizeof(ack)) ||
+      ack > s_boot_log) {
+    ack = s_boot_log; // 首次启用或日志区已重建：不补发启用之前的记录
+  }
+  if (ack < log.oldest_time) {
+    ack = log.oldest_time; // 更早的记录已被覆盖
+  }
+  s_ack = s_ack_saved = s_sent_hi = ack;
+  s_gap_end = s_seg_lo = s_seg_cur = s_boot_log;
+  s_ack_saved_at = SysClock_Seconds();
+
+  if (s_gap_end > s_ack) {
+    LOG_INFO("离线缓存: %lus 内的记录待补发",
+             (unsigned long)(s_gap_end - s_ack));
+  }
+  return true;
+}
+
+/* --------------------------- 批次与发送 --------------------------- */
+
+/**
+ * @brief 封存正在攒的批次：填写帧头与 CRC 并移入待发队列
+ */
+static void telemetry_seal(void) {
+  TelemetryFrame_t *frame = telemetry_building();
+  TelemetryHeader_t *h = &frame->header;
+
+  frame->count = s_enc.count;
+  if (frame->count == 0) {
+    return;
+  }
+  frame->t_last = s_build_last;
+
+  h->flags = s_build_flags;
+  h->seq = s_seq++;
+  h->base_time = s_build_start + (uint32_t)(s_build_clock_ms / 1000U);
+  telemetry_finish(h, s_enc.len);
+
+  if (++s_pending == TELEMETRY_BATCH_QUEUE) {
+    /* 队列已满：下一个攒批位置就是最旧的待发批次，其记录改由补发送达 */
+    s_stats.batches_dropped++;
+    s_stats.records_dropped += s_frames[s_first].count;
+    if (s_outbox) {
+      telemetry_outbox_defer(&s_frames[s_first]);
+    }
+    s_first = (uint8_t)((s_first + 1) % TELEMETRY_BATCH_QUEUE);
+    s_pending--;
+  }
+  s_enc.count = 0;
+}
+
+/**
+ * @brief 追加一条样本
+ */
+static void telemetry_append(const SensorSnapshot_t *snapshot) {
+  const SensorEvent_t *event = &snapshot->event;
+  uint32_t t_up = (uint32_t)(event->data.timestamp_us / 1000000U);
+  uint32_t t;
+
+  if (SensorTask_GetSensorCount() != s_schema_sensors) {
+    telemetry_update_schema();
+  }
+  if (s_enc.count == 0) {
+    telemetry_begin(t_up);
+  }
+  if ((int32_t)(t_up - s_build_last) > 0) {
+    s_build_last = t_up;
+  }
+  /* 墙上时钟的整秒 - 基准时间的整秒部分 (不小于 t_up，至多大 1) */
+  t = (uint32_t)((event->data.timestamp_us / 1000U + s_build_clock_ms % 1000U) /
+                 1000U);
+  (void)TelemetryCodec_Put(&s_enc, t, event->sensor, snapshot->fixed,
+                           snapshot->channel_count);
+  if (TelemetryCodec_Full(&s_enc)) {
+    telemetry_seal();
+  }
+}
+
+/* --------------------------- 边缘汇总 --------------------------- */
+
+/**
+ * @brief 从 start_ms 开始一个汇总窗口 (RTC 已校时时在墙上时钟的窗口整数倍结束)
+ */
+static void telemetry_edge_schedule(uint64_t start_ms, uint64_t now_ms) {
+  const uint64_t window_ms = TELEMETRY_EDGE_WINDOW_S * 1000ULL;
+  uint8_t flags = 0;
+  uint64_t clock_ms = telemetry_clock_ms(&flags);
+
+  s_edge_start_ms = start_ms;
+  if (flags & TELEMETRY_FLAG_RTC) {
+    s_edge_end_ms = ((now_ms + clock_ms) / window_ms + 1U) * window_ms - clock_ms;
+  } else {
+    s_edge_end_ms = now_ms + window_ms;
+  }
+}
+
+/**
+ * @brief 帧内时间：上电毫秒按正在攒的批次的时基取整到墙上时钟的秒
+ */
+static uint32_t telemetry_edge_time(uint64_t ms) {
+  return (uint32_t)((ms + s_build_clock_ms % 1000U + 500U) / 1000U);
+}
+
+/**
+ * @brief 窗口结束：各传感器的汇总写入正在攒的批次，开始下一个窗口
+ * @details 汇总记录的时间为窗口起点；批次按正常的封存时刻发送。
+ */
+static void telemetry_edge_close(uint64_t now_ms) {
+  uint32_t t_end = (uint32_t)(s_edge_end_ms / 1000U);
+  TelemetrySummary_t summary;
+  SensorHandle_t sensor;
+  uint8_t channels;
+
+  for (uint8_t i = 0;
+       TelemetryEdge_TakeSummary(i, &sensor, &summary, &channels); i++) {
+    if (summary.count == 0) {
+      continue;
+    }
+    if (s_enc.count == 0) {
+      telemetry_begin(t_end - 1U);
+    }
+    if (!TelemetryCodec_PutSummary(&s_enc, telemetry_edge_time(s_edge_start_ms),
+                                   sensor, &summary, channels)) {
+      telemetry_seal();
+      telemetry_begin(t_end - 1U);
+      (void)TelemetryCodec_PutSummary(&s_enc,
+                                      telemetry_edge_time(s_edge_start_ms),
+                                      sensor, &summary, channels);
+    }
+    s_stats.edge_summaries++;
+  }
+  /* 窗口内的样本都已汇总：批次覆盖到窗口终点之前的整秒 (离线缓存据此记账) */
+  if (s_enc.count != 0 && (int32_t)(t_end - 1U - s_build_last) > 0) {
+    s_build_last = t_end - 1U;
+  }
+  telemetry_edge_schedule(s_edge_end_ms,
+                          now_ms > s_edge_end_ms ? now_ms : s_edge_end_ms);
+}
+
+/**
+ * @brief 边缘汇总模式下处理一个样本：累积窗口统计，检出事件时立即封存
+ * @details 事件不代表窗口内的样本已送达，批次的覆盖范围不因事件前移。
+ */
+static void telemetry_edge_append(const SensorSnapshot_t *snapshot) {
+  const SensorEvent_t *event = &snapshot->event;
+  uint64_t ms = event->data.timestamp_us / 1000U;
+  TelemetryEdgeEvent_t events[TELEMETRY_EDGE_MAX_EVENTS];
+  uint8_t n;
+
+  if (SensorTask_GetSensorCount() != s_schema_sensors) {
+    telemetry_update_schema();
+  }
+  if (ms >= s_edge_end_ms) {
+    telemetry_edge_close(ms);
+  }
+  n = TelemetryEdge_Push(snapshot, events);
+  for (uint8_t i = 0; i < n; i++) {
+    if (s_enc.count == 0) {
+      telemetry_begin((uint32_t)(s_edge_start_ms / 1000U));
+    }
+    if (!TelemetryCodec_PutEvent(&s_enc, telemetry_edge_time(ms), events[i].kind,
+                                 events[i].arg, event->sensor, snapshot->fixed,
+                                 snapshot->channel_count)) {
+      telemetry_seal();
+      telemetry_begin((uint32_t)(s_edge_start_ms / 1000U));
+      (void)TelemetryCodec_PutEvent(&s_enc, telemetry_edge_time(ms),
+                                    events[i].kind, events[i].arg, event->sensor,
+                                    snapshot->fixed, snapshot->channel_count);
+    }
+    s_stats.edge_events++;
+  }
+  if (n > 0) {
+    telemetry_seal(); // 事件不等封存时刻，本轮即发送
+  }
+}
+
+/**
+ * @brief 链路是否可用 (Wi-Fi: TCP 已连接；以太网: 网线已连接且下一跳已解析)
+ */
+static bool telemetry_link_up(void) {
+  return TELEMETRY_LINK == TELEMETRY_LINK_ETH ? NetUdp_IsUp() : EspAt_IsLinked();
+}
+
+/**
+ * @brief 发送一帧 (以太网为一个数据报，直接从帧缓冲区发出)
+ */
+static bool telemetry_link_send(const void *frame, uint16_t len) {
+  if (TELEMETRY_LINK == TELEMETRY_LINK_ETH) {
+    return NetUdp_Send(frame, len);
+  }
+  return EspAt_Send((const uint8_t *)frame, len, TELEMETRY_SEND_TIMEOUT_MS);
+}
+
+/**
+ * @brief 唤醒模块、加入 Wi-Fi 并建立 TCP 链路 (以太网只需解析下一跳)
+ */
+static bool telemetry_connect(void) {
+  bool alive = false;
+
+  s_stats.state = TELEMETRY_STATE_CONNECTING;
+  s_stats.reconnects++;
+
+  if (TELEMETRY_LINK == TELEMETRY_LINK_ETH) {
+    if (!NetUdp_Resolve()) {
+      LOG_WARN("以太网未连接或下一跳无 ARP 应答");
+      return false;
+    }
+    return true;
+  }
+
+  for (uint8_t i = 0; i < 3 && !alive; i++) {
+    alive = EspAt_Command(500, NULL, "AT");
+  }
+  if (!alive) {
+    LOG_WARN("Wi-Fi 模块无应答");
+    return false;
+  }
+  if (!EspAt_Command(500, NULL, "ATE0") ||
+      !EspAt_Command(1000, NULL, "AT+CWMODE=1") ||
+      !EspAt_Command(500, NULL, "AT+CIPMODE=0")) {
+    return false;
+  }
+  if (TELEMETRY_SNTP_SERVER[0] != '\0' && !s_sntp) {
+    /* 模块联网后自行同步，之后查询即可；不支持时只是不校时 */
+    s_sntp = EspAt_Command(1000, NULL, "AT+CIPSNTPCFG=1,%d,\"%s\"",
+                           (int)TELEMETRY_SNTP_TIMEZONE, TELEMETRY_SNTP_SERVER);
+    if (!s_sntp) {
+      LOG_WARN("模块不支持 SNTP，不进行网络校时");
+    }
+  }
+  if (!EspAt_HasIp() &&
+      !EspAt_Command(TELEMETRY_JOIN_TIMEOUT_MS, NULL, "AT+CWJAP=\"%s\",\"%s\"",
+                     TELEMETRY_WIFI_SSID, TELEMETRY_WIFI_PASSWORD)) {
+    LOG_WARN("加入 Wi-Fi \"%s\" 失败", TELEMETRY_WIFI_SSID);
+    return false;
+  }
+  if (!EspAt_IsLinked() &&
+      !EspAt_Command(TELEMETRY_CONNECT_TIMEOUT_MS, NULL,
+                     "AT+CIPSTART=\"TCP\",\"%s\",%u", TELEMETRY_SERVER_HOST,
+                     (unsigned)TELEMETRY_SERVER_PORT)) {
+    LOG_WARN("连接服务器 %s:%u 失败", TELEMETRY_SERVER_HOST,
+             (unsigned)TELEMETRY_SERVER_PORT);
+    return false;
+  }
+  if (EspAt_IsLinked()) {
+    LOG_INFO("已连接服务器 %s:%u", TELEMETRY_SERVER_HOST,
+             (unsigned)TELEMETRY_SERVER_PORT);
+  }
+  return EspAt_IsLinked();
+}
+
+/**
+ * @brief 查询模块的 SNTP 时间 ("Thu Aug 04 14:48:05 2016" 格式)
+ * @param t 本地 Unix 秒
+ * @return false: 查询失败或模块尚未取得网络时间
+ */
+static bool telemetry_sntp_read(uint32_t *t) {
+  static const char months[] = "JanFebMarAprMayJunJulAugSepOctNovDec";
+  char reply[40];
+  char mon[4];
+  unsigned d, h, mi, sec, y;
+  const char *p;
+  RtcDateTime_t dt;
+
+  if (!EspAt_Query(TELEMETRY_SNTP_QUERY_MS, "+CIPSNTPTIME:", reply,
+                   sizeof(reply), "AT+CIPSNTPTIME?") ||
+      sscanf(reply, "%*s %3s %u %u:%u:%u %u", mon, &d, &h, &mi, &sec, &y) != 6 ||
+      y < TELEMETRY_SNTP_MIN_YEAR || y > 2099) {
+    return false;
+  }
+  p = strstr(months, mon);
+  if (p == NULL || (p - months) % 3 != 0) {
+    return false;
+  }
+  dt.year = (uint16_t)y;
+  dt.month = (uint8_t)((p - months) / 3 + 1);
+  dt.day = (uint8_t)d;
+  dt.hour = (uint8_t)h;
+  dt.minute = (uint8_t)mi;
+  dt.second = (uint8_t)sec;
+  *t = RtcClock_FromDateTime(&dt);
+  return true;
+}
+
+/**
+ * @brief 网络校时：连续查询模块时间，捕捉秒跳变的时刻后校准 RTC
+ * @details 模块只给出整秒，跳变发生在前后两次查询之间，取两次查询的
+ *          中点作为整秒时刻，误差不超过查询间隔的一半加单次查询的耗时。
+ */
+static void telemetry_sntp(uint32_t now) {
+  uint32_t first;
+  uint32_t t;
+  uint64_t start = SysClock_Micros();
+  uint64_t prev;
+  uint64_t cur;
+
+  s_sntp_at = now + TELEMETRY_SNTP_RETRY_S;
+  if (!telemetry_sntp_read(&first)) {
+    s_stats.sntp_failures++;
+    return;
+  }
+  prev = (start + SysClock_Micros()) / 2U;
+
+  while (SysClock_Micros() - start < TELEMETRY_SNTP_WINDOW_MS * 1000ULL) {
+    vTaskDelay(pdMS_TO_TICKS(TELEMETRY_SNTP_PROBE_MS));
+    start = SysClock_Micros();
+    if (!telemetry_sntp_read(&t)) {
+      break;
+    }
+    cur = (start + SysClock_Micros()) / 2U;
+    if (t != first) {
+      if (t == first + 1 && RtcClock_Sync(t, (prev + cur) / 2U)) {
+        s_stats.sntp_syncs++;
+        s_sntp_at = now + TELEMETRY_SNTP_INTERVAL_S;
+        return;
+      }
+      break; // 模块时间在查询期间跳变 (刚完成同步)
+    }
+    prev = cur;
+  }
+  s_stats.sntp_failures++;
+}
+
+/**
+ * @brief 连接或发送失败：指数退避
+ */
+static void telemetry_backoff(uint32_t now) {
+  if (s_backoff_s == 0) {
+    s_backoff_s = TELEMETRY_RETRY_MIN_S;
+  } else if (s_backoff_s < TELEMETRY_RETRY_MAX_S) {
+    s_backoff_s *= 2;
+    if (s_backoff_s > TELEMETRY_RETRY_MAX_S) {
+      s_backoff_s = TELEMETRY_RETRY_MAX_S;
+    }
+  }
+  s_retry_at = now + s_backoff_s;
+  s_stats.state = TELEMETRY_STATE_BACKOFF;
+  LOG_WARN("上行失败，%lus 后重试 (待发 %u 批)", (unsigned long)s_backoff_s,
+           (unsigned)s_pending);
+}
+
+/**
+ * @brief 发送一帧 (必要时先建立链路并发送模式描述)，失败时关闭链路并退避
+ */
+static bool telemetry_send(const TelemetryFrame_t *frame, uint32_t now) {
+  uint16_t len = telemetry_frame_len(&frame->header);
+  bool ok;
+
+  if (!telemetry_link_up()) {
+    s_schema_sent = false;
+    if (!telemetry_connect()) {
+      telemetry_backoff(now);
+      return false;
+    }
+  }
+  s_stats.state = TELEMETRY_STATE_ONLINE;
+
+  /* 服务器重启后不再有模式缓存，每条新链路先发送模式描述 */
+  ok = s_schema_sent ||
+       telemetry_link_send(&s_schema, telemetry_frame_len(&s_schema.header));
+  s_schema_sent = ok;
+  if (ok) {
+    ok = telemetry_link_send(frame, len);
+  }
+  if (!ok) {
+    s_stats.send_failures++;
+    if (TELEMETRY_LINK == TELEMETRY_LINK_WIFI && EspAt_IsLinked()) {
+      /* 链路状态不确定：关闭后重建，服务器按序号去重 */
+      (void)EspAt_Command(1000, NULL, "AT+CIPCLOSE");
+    }
+    telemetry_backoff(now);
+    return false;
+  }
+
+  s_stats.batches_sent++;
+  s_stats.records_sent += frame->count;
+  s_stats.bytes_sent += len;
+  s_backoff_s = 0;
+  return true;
+}
+
+/**
+ * @brief 按顺序发送所有待发批次，失败时保留在队列中
+ */
+static void telemetry_publish(uint32_t now) {
+  while (s_pending > 0) {
+    TelemetryFrame_t *frame = &s_frames[s_first];
+
+    if (!telemetry_send(frame, now)) {
+      return;
+    }
+    if (s_outbox) {
+      telemetry_outbox_sent(frame->t_last + s_log_offset + 1);
+    }
+    s_first = (uint8_t)((s_first + 1) % TELEMETRY_BATCH_QUEUE);
+    s_pending--;
+  }
+}
+
+/**
+ * @brief 补发一批离线缓存中的记录 (实时批次都已发出之后)
+ */
+static void telemetry_replay(uint32_t now) {
+  uint32_t lo;
+  uint32_t hi;
+
+  if (s_replay.count == 0) {
+    if (TELEMETRY_OUTBOX_ORDER == TELEMETRY_OUTBOX_NEWEST_FIRST) {
+      if (s_seg_cur >= s_gap_end) {
+        /* 当前段已发完：区间顶部下移，取下一段 */
+        s_gap_end = s_seg_lo;
+        if (s_gap_end <= s_ack) {
+          telemetry_outbox_close();
+          return;
+        }
+        s_seg_lo = s_gap_end - s_ack > TELEMETRY_OUTBOX_SEGMENT_S
+                       ? s_gap_end - TELEMETRY_OUTBOX_SEGMENT_S
+                       : s_ack;
+        s_seg_cur = s_seg_lo;
+      }
+      lo = s_seg_cur;
+    } else {
+      lo = s_ack;
+    }
+    hi = s_gap_end;
+    if (lo < s_boot_log && s_boot_log < hi) {
+      hi = s_boot_log; // 上电前后的记录时基不同，不放在同一批
+    }
+    s_replay_cut = telemetry_replay_build(lo, hi);
+  }
+
+  if (s_replay.count != 0) {
+    if (!telemetry_send(&s_replay, now)) {
+      return; // 已编码的批次保留，下次原样重发
+    }
+    s_stats.replay_batches++;
+    s_stats.replay_records += s_replay.count;
+    s_replay.count = 0;
+    telemetry_outbox_sent(s_replay_cut);
+  }
+
+  if (TELEMETRY_OUTBOX_ORDER == TELEMETRY_OUTBOX_NEWEST_FIRST) {
+    s_seg_cur = s_replay_cut;
+  } else {
+    s_ack = s_replay_cut;
+    if (s_ack >= s_gap_end) {
+      telemetry_outbox_close();
+    }
+  }
+}
+
+/**
+ * @brief 发送一帧指标快照 (只使用已建立的链路，失败不重发)
+ */
+static void telemetry_metrics(uint32_t now) {
+  TelemetryHeader_t *h = &s_metrics.header;
+  uint8_t flags = TELEMETRY_FLAG_METRICS;
+  uint16_t len;
+
+  if (!telemetry_link_up()) {
+    return;
+  }
+  len = TelemetryCodec_BuildMetrics(s_metrics.payload,
+                                    TELEMETRY_CODEC_METRICS_MAX);
+  if (len == 0) {
+    LOG_ERROR("指标快照超出 %u 字节", (unsigned)TELEMETRY_CODEC_METRICS_MAX);
+    return;
+  }
+  h->base_time = now + telemetry_clock(&flags);
+  h->flags = flags;
+  h->seq = 0; // 不占用批次序号
+  telemetry_finish(h, len);
+
+  if (telemetry_link_send(&s_metrics, telemetry_frame_len(h))) {
+    s_stats.metrics_sent++;
+    s_stats.bytes_sent += telemetry_frame_len(h);
+  }
+}
+
+/**
+ * @brief 上行任务：取出数据更新事件打包，到期封存并发送，空闲时限速补发
+ */
+static void telemetry_task(void *argument) {
+  (void)argument;
+
+  for (;;) {
+    const SensorSnapshot_t *snapshot = SensorEventBus_Receive(
+        s_sub, telemetry_outbox_empty() ? 1000 : TELEMETRY_OUTBOX_INTERVAL_MS);
+    uint32_t now;
+
+    if (snapshot != NULL) {
+      if (snapshot->event.event_type == SENSOR_EVENT_DATA_UPDATE &&
+          snapshot->event.data.is_valid) {
+        if (TELEMETRY_MODE == TELEMETRY_MODE_EDGE) {
+          telemetry_edge_append(snapshot);
+        } else {
+          telemetry_append(snapshot);
+        }
+      }
+      SensorEventBus_Release(snapshot);
+    }
+
+    now = SysClock_Seconds();
+    if (TELEMETRY_MODE == TELEMETRY_MODE_EDGE &&
+        SysClock_Millis() >= s_edge_end_ms + TELEMETRY_EDGE_GRACE_MS) {
+      telemetry_edge_close(SysClock_Millis());
+    }
+    if (s_enc.count != 0 &&
+        (s_flush_req || (int32_t)(now - s_build_seal_at) >= 0)) {
+      telemetry_seal();
+    }
+    s_flush_req = false;
+
+    if (s_sntp && EspAt_HasIp() && (int32_t)(now - s_sntp_at) >= 0) {
+      telemetry_sntp(now);
+    }
+
+    if (s_pending > 0 && (int32_t)(now - s_retry_at) >= 0) {
+      telemetry_publish(now);
+    }
+
+    if (TELEMETRY_METRICS_INTERVAL_S != 0 && s_pending == 0 &&
+        s_schema_sent && (int32_t)(now - s_metrics_at) >= 0) {
+      s_metrics_at = now + TELEMETRY_METRICS_INTERVAL_S;
+      telemetry_metrics(now);
+    }
+
+    /* 实时批次优先；补发按固定间隔一批，不会集中占用 Flash 与 CPU */
+    if (s_pending == 0 && !telemetry_outbox_empty() &&
+        (int32_t)(now - s_retry_at) >= 0 &&
+        (int32_t)(xTaskGetTickCount() - s_replay_at) >= 0) {
+      s_replay_at =
+          xTaskGetTickCount() + pdMS_TO_TICKS(TELEMETRY_OUTBOX_INTERVAL_MS);
+      telemetry_replay(now);
+    }
+    telemetry_outbox_save(now);
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 初始化
+ */
+bool Telemetry_Init(void) {
+  if (s_task != NULL) {
+    return true;
+  }
+  if (TELEMETRY_LINK == TELEMETRY_LINK_WIFI && TELEMETRY_WIFI_SSID[0] == '\0') {
+    LOG_INFO("未配置 Wi-Fi，遥测上行关闭");
+    return false;
+  }
+  if (TELEMETRY_LINK == TELEMETRY_LINK_ETH
+          ? !NetUdp_Init(TELEMETRY_SERVER_HOST, TELEMETRY_SERVER_PORT)
+          : !EspAt_Init()) {
+    return false;
+  }
+
+  s_unit_id = CRC32_Compute((const uint8_t *)UID_BASE, 12);
+  if (!telemetry_build_schema()) {
+    LOG_ERROR("模式描述超出 %u 字节", (unsigned)TELEMETRY_CODEC_SCHEMA_MAX);
+    return false;
+  }
+  s_outbox = telemetry_outbox_init();
+  if (TELEMETRY_MODE == TELEMETRY_MODE_EDGE) {
+    TelemetryEdge_Reset();
+    telemetry_edge_schedule(SysClock_Millis(), SysClock_Millis());
+  }
+  s_sub = SensorEventBus_Subscribe("uplink", NULL);
+  if (s_sub < 0) {
+    LOG_ERROR("订阅传感器事件失败");
+    return false;
+  }
+
+  s_task = xTaskCreateStatic(telemetry_task, "telemetry",
+                             TELEMETRY_TASK_STACK_SIZE, NULL,
+                             TELEMETRY_TASK_PRIORITY, s_task_stack,
+                             &s_task_tcb);
+  s_stats.state = TELEMETRY_STATE_CONNECTING;
+
+  LOG_INFO("遥测上行已启动: 设备号 %08lX -> %s:%u", (unsigned long)s_unit_id,
+           TELEMETRY_SERVER_HOST, (unsigned)TELEMETRY_SERVER_PORT);
+  return true;
+}
+
+/**
+ * @brief 请求封存正在攒的批次 (上行任务下一次醒来时执行，最迟 1 秒)
+ */
+void Telemetry_Flush(void) {
+  s_flush_req = true;
+  s_retry_at = SysClock_Seconds();
+}
+
+/**
+ * @brief 获取上行统计
+ */
+void Telemetry_GetStats(TelemetryStats_t *stats) {
+  uint32_t now = SysClock_Seconds();
+
+  taskENTER_CRITICAL();
+  *stats = s_stats;
+  stats->pending = s_pending;
+  stats->building = s_enc.count;
+  stats->outbox = s_outbox;
+  stats->outbox_s = telemetry_outbox_empty() ? 0 : s_gap_end - s_ack;
+  stats->ack_time = s_ack;
+  stats->retry_in_s =
+      ((int32_t)(s_retry_at - now) > 0) ? s_retry_at - now : 0;
+  taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 状态名称
+ */
+const char *Telemetry_StateName(TelemetryState_t state) {
+  switch (state) {
+  case TELEMETRY_STATE_CONNECTING:
+    return "connecting";
+  case TELEMETRY_STATE_ONLINE:
+    return "online";
+  case TELEMETRY_STATE_BACKOFF:
+    return "backoff";
+  case TELEMETRY_STATE_OFF:
+  default:
+    return "off";
+  }
+}
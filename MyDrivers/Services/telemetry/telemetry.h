@@ -0,0 +1,204 @@
+/**
+ ******************************************************************************
+ * @file    telemetry.h
+ * @brief   遥测上行服务 (ESP-AT Wi-Fi 模块 TCP，或以太网 UDP)
+ * @details 订阅传感器事件总线，把数据更新按批打包后经 Wi-Fi 模块发往汇聚服务器：
+ *            - 样本以定点值差分 + 变长整数编码 (见 telemetry_codec.h)，
+ *              双通道记录通常 4 字节；
+ *            - 批次写满 TELEMETRY_PAYLOAD_MAX 字节或距第一条样本超过
+ *              TELEMETRY_PUBLISH_INTERVAL_S 时封存，一批只发一次 AT+CIPSEND，
+ *              模块唤醒与命令开销按批摊薄；
+ *            - 封存的批次在 RAM 中排队 (TELEMETRY_BATCH_QUEUE - 1 个)，链路
+ *              断开或发送失败时按指数退避重连，队列满时移出最旧的批次；
+ *            - 离线缓存：所有样本同时由数据记录服务写入 Flash (sensor_log.h)，
+ *              移出 RAM 的批次不再另存，只记下送达游标 (日志时间，此前的
+ *              记录均已送达)。链路恢复后在实时批次之外从 Flash 读出游标之后
+ *              的记录补发，每 TELEMETRY_OUTBOX_INTERVAL_MS 最多一批，离线
+ *              多久都只占固定的一个补发缓冲区；补发顺序由
+ *              TELEMETRY_OUTBOX_ORDER 选择。游标每 TELEMETRY_OUTBOX_SAVE_S
+ *              保存一次到配置存储，重启后补发上次保存以来的记录，同一条
+ *              记录可能送达不止一次 (服务器按传感器与时间去重)；
+ *            - 发送与重连在本任务中阻塞执行，期间到达的事件暂存在事件总线的
+ *              订阅队列中，积压过多时由总线丢弃最旧的事件 (计入总线统计)。
+ *          帧格式 (小端)：
+ *            帧头 20 字节 [魔数 "ET" | 版本 | 标志 | 设备号 (UID 的 CRC-32) |
+ *                          序号 | 负载长度 | 基准时间 (s) | 模式 ID]
+ *            负载 编码后的记录，或模式描述 (TELEMETRY_FLAG_SCHEMA)
+ *            CRC-32 (帧头与负载)
+ *          每次建立链路后先发送一帧模式描述，服务器按模式 ID 缓存。
+ *          RTC 已校时时基准时间为本地 Unix 秒 (TELEMETRY_FLAG_RTC)，否则为上电秒数；
+ *          补发本次上电之前的记录时为日志时间 (TELEMETRY_FLAG_LOGTIME)。
+ *          网络校时：模块联网后按 TELEMETRY_SNTP_INTERVAL_S 查询模块的 SNTP
+ *          时间，连续查询捕捉秒跳变的时刻 (精度约 TELEMETRY_SNTP_PROBE_MS)，
+ *          经 RtcClock_Sync 平滑校准 RTC；所有节点的记录时间因此落在同一
+ *          时间轴上，服务器可直接按秒合并。RTC 已校时时批次在按设备号
+ *          错开的墙上时钟秒封存，各节点不会在同一时刻集中发送。
+ *          边缘汇总模式 (TELEMETRY_MODE_EDGE，见 telemetry_edge.h)：实时批次
+ *          只含每 TELEMETRY_EDGE_WINDOW_S 一条的窗口汇总，以及带原值的告警与
+ *          异常事件 (TELEMETRY_FLAG_EDGE)，含事件的批次立即封存发送；原始
+ *          样本仍写入 Flash，移出 RAM 队列的批次照常以原始记录补发。
+ *          指标帧 (TELEMETRY_FLAG_METRICS)：链路已建立且没有待发批次时，每
+ *          TELEMETRY_METRICS_INTERVAL_S 发送一帧指标注册表快照 (metrics.h)，
+ *          基准时间为快照时刻；不为它单独建立链路，发送失败不重发。
+ *          SSID 为空时服务不启动。
+ *          有线链路 (TELEMETRY_LINK_ETH，见 net_udp.h)：每帧一个 UDP 数据报发往
+ *          同一服务器地址 (须为点分十进制)，负载由 MAC 直接从批次缓冲区读取，
+ *          不经过 AT 命令与模块串口。UDP 没有送达确认，交给网卡即视为送达，
+ *          丢失的批次由服务器按序号发现；有线链路不进行网络校时。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __TELEMETRY_H
+#define __TELEMETRY_H
+
+#include "task_plan.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define TELEMETRY_LINK_WIFI 0            // ESP-AT 模块 (UART5)
+#define TELEMETRY_LINK_ETH 1             // 板载以太网 (RMII)
+#ifndef TELEMETRY_LINK
+#define TELEMETRY_LINK TELEMETRY_LINK_WIFI
+#endif
+#ifndef TELEMETRY_WIFI_SSID
+#define TELEMETRY_WIFI_SSID ""          // 为空时不启动 Wi-Fi 上行
+#endif
+#ifndef TELEMETRY_WIFI_PASSWORD
+#define TELEMETRY_WIFI_PASSWORD ""
+#endif
+#ifndef TELEMETRY_SERVER_HOST
+#define TELEMETRY_SERVER_HOST "192.168.1.10"
+#endif
+#ifndef TELEMETRY_SERVER_PORT
+#define TELEMETRY_SERVER_PORT 9000      // Wi-Fi 为 TCP 端口，以太网为 UDP 端口
+#endif
+#ifndef TELEMETRY_SNTP_SERVER
+#define TELEMETRY_SNTP_SERVER "pool.ntp.org" // 为空时不校时
+#endif
+#ifndef TELEMETRY_SNTP_TIMEZONE
+#define TELEMETRY_SNTP_TIMEZONE 8       // 本地时区 (小时，RTC 保存本地时间)
+#endif
+#define TELEMETRY_SNTP_INTERVAL_S 3600  // 校时间隔
+#define TELEMETRY_SNTP_RETRY_S 60       // 模块尚未取得网络时间或校时失败时的重试间隔
+#define TELEMETRY_SNTP_PROBE_MS 20      // 捕捉秒跳变时的查询间隔
+#define TELEMETRY_PUBLISH_INTERVAL_S 30 // 批次最长等待时间
+#define TELEMETRY_MODE_RAW 0            // 上报每个样本
+#define TELEMETRY_MODE_EDGE 1           // 只上报窗口汇总与告警/异常事件
+#ifndef TELEMETRY_MODE
+#define TELEMETRY_MODE TELEMETRY_MODE_RAW
+#endif
+#define TELEMETRY_PAYLOAD_MAX 384       // 每批负载上限 (字节，约 90 条双通道记录)
+#define TELEMETRY_BATCH_QUEUE 3         // 批次缓冲区数 (1 个正在攒 + 其余排队待发)
+#define TELEMETRY_RETRY_MIN_S 5         // 重连退避的初始间隔
+#define TELEMETRY_RETRY_MAX_S 300       // 重连退避的最大间隔
+#define TELEMETRY_OUTBOX_OLDEST_FIRST 0 // 补发顺序：从最旧的记录开始
+#define TELEMETRY_OUTBOX_NEWEST_FIRST 1 // 补发顺序：按时间段从最新往回，段内从旧到新
+#ifndef TELEMETRY_OUTBOX_ORDER
+#define TELEMETRY_OUTBOX_ORDER TELEMETRY_OUTBOX_OLDEST_FIRST
+#endif
+#ifndef TELEMETRY_OUTBOX_INTERVAL_MS
+#define TELEMETRY_OUTBOX_INTERVAL_MS 250 // 补发限速：两批之间的最短间隔
+#endif
+#define TELEMETRY_OUTBOX_SEGMENT_S 3600 // 从新到旧补发时每段的时间跨度
+#define TELEMETRY_OUTBOX_SAVE_S 600     // 送达游标的保存间隔 (限制 EEPROM 写入)
+#ifndef TELEMETRY_METRICS_INTERVAL_S
+#define TELEMETRY_METRICS_INTERVAL_S 300 // 指标快照的发送间隔，0 不发送
+#endif
+#define TELEMETRY_TASK_STACK_SIZE 256   // 上行任务栈大小 (单位: 字)
+#define TELEMETRY_TASK_PRIORITY TASK_PRIO_TELEMETRY // 上行任务的 FreeRTOS 优先级
+
+/* --------------------------- 数据结构 --------------------------- */
+#define TELEMETRY_FRAME_MAGIC0 'E'
+#define TELEMETRY_FRAME_MAGIC1 'T'
+#define TELEMETRY_FRAME_VERSION 4
+#define TELEMETRY_FLAG_RTC 0x01    // 基准时间为 RTC 时间 (否则为上电秒数)
+#define TELEMETRY_FLAG_SCHEMA 0x02 // 负载为模式描述
+#define TELEMETRY_FLAG_REPLAY 0x04 // 从离线缓存补发的批次
+#define TELEMETRY_FLAG_LOGTIME 0x08 // 基准时间为日志时间 (本次上电之前的记录)
+#define TELEMETRY_FLAG_EDGE 0x10   // 负载为汇总与事件记录 (边缘汇总模式)
+#define TELEMETRY_FLAG_METRICS 0x20 // 负载为指标快照
+
+/**
+ * @brief 帧头 (20 字节，无填充)
+ */
+typedef struct {
+  uint8_t magic[2];   // "ET"
+  uint8_t version;    // TELEMETRY_FRAME_VERSION
+  uint8_t flags;      // TELEMETRY_FLAG_*
+  uint32_t unit_id;   // 设备号 (96 位 UID 的 CRC-32)
+  uint16_t seq;       // 帧序号 (每封存一批加 1，服务器据此发现丢失的批次)
+  uint16_t length;    // 负载长度 (字节)
+  uint32_t base_time; // 记录时间差的起点 (s)
+  uint32_t schema_id; // 模式描述的 CRC-32
+} TelemetryHeader_t;
+
+typedef enum {
+  TELEMETRY_STATE_OFF = 0,  // 未配置或模块初始化失败
+  TELEMETRY_STATE_CONNECTING,
+  TELEMETRY_STATE_ONLINE,
+  TELEMETRY_STATE_BACKOFF,  // 连接或发送失败，等待重试
+} TelemetryState_t;
+
+/**
+ * @brief 上行统计
+ */
+typedef struct {
+  TelemetryState_t state;
+  uint8_t pending;          // 排队待发的批次数
+  uint8_t building;         // 正在攒的批次中的记录数
+  uint32_t batches_sent;
+  uint32_t records_sent;
+  uint32_t bytes_sent;
+  uint32_t schema_id;       // 当前模式 ID
+  uint32_t batches_dropped; // 队列满时移出的批次数 (启用离线缓存时由补发送达)
+  uint32_t records_dropped;
+  bool outbox;              // 离线缓存可用 (日志区已挂载)
+  uint32_t outbox_s;        // 待补发记录的时间跨度 (s)
+  uint32_t ack_time;        // 送达游标 (日志时间)
+  uint32_t replay_batches;  // 补发的批次数
+  uint32_t replay_records;
+  uint32_t send_failures;
+  uint32_t reconnects;
+  uint32_t edge_summaries;  // 上报的窗口汇总数 (边缘汇总模式)
+  uint32_t edge_events;     // 上报的告警与异常事件数
+  uint32_t sntp_syncs;      // 网络校时成功次数
+  uint32_t sntp_failures;   // 模块未取得网络时间或未捕捉到秒跳变的次数
+  uint32_t metrics_sent;    // 发出的指标帧数
+  uint32_t retry_in_s;      // 距下一次重试的时间 (BACKOFF 时有效)
+} TelemetryStats_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 订阅传感器事件并创建上行任务 (模块连接在任务中进行，不阻塞启动)
+ * @return false: 未配置 SSID (Wi-Fi 链路)、网卡不可用或资源不足
+ */
+bool Telemetry_Init(void);
+
+/**
+ * @brief 立即封存正在攒的批次并尽快发送
+ */
+void Telemetry_Flush(void);
+
+/**
+ * @brief 获取上行统计
+ */
+void Telemetry_GetStats(TelemetryStats_t *stats);
+
+/**
+ * @brief 状态名称
+ */
+const char *Telemetry_StateName(TelemetryState_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TELEMETRY_H */
@@ -0,0 +1,271 @@
+/**
+ ******************************************************************************
+ * @file    telemetry_codec.c
+ * @brief   遥测批次编码实现
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "telemetry_codec.h"
+#include "metrics.h"
+#include <string.h>
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static uint32_t codec_zigzag(int32_t v) {
+  return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+/**
+ * @brief 写入一个 LEB128 变长整数，返回写入的字节数
+ */
+static uint8_t codec_put_varint(uint8_t *dst, uint32_t v) {
+  uint8_t n = 0;
+
+  while (v >= 0x80U) {
+    dst[n++] = (uint8_t)(v | 0x80U);
+    v >>= 7;
+  }
+  dst[n++] = (uint8_t)v;
+  return n;
+}
+
+/**
+ * @brief 写入一个 64 位 LEB128 变长整数，返回写入的字节数
+ */
+static uint8_t codec_put_varint64(uint8_t *dst, uint64_t v) {
+  uint8_t n = 0;
+
+  while (v >= 0x80U) {
+    dst[n++] = (uint8_t)(v | 0x80U);
+    v >>= 7;
+  }
+  dst[n++] = (uint8_t)v;
+  return n;
+}
+
+/**
+ * @brief 写入字符串 (含结尾 0)，空间不足返回 false
+ */
+static bool codec_put_str(uint8_t *buf, uint16_t cap, uint16_t *len,
+                          const char *s) {
+  size_t n = strlen(s != NULL ? s : "") + 1;
+
+  if (*len + n > cap) {
+    return false;
+  }
+  memcpy(&buf[*len], s != NULL ? s : "", n);
+  *len = (uint16_t)(*len + n);
+  return true;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 开始一个批次
+ */
+void TelemetryCodec_Begin(TelemetryEncoder_t *enc, uint8_t *buf, uint16_t cap,
+                          uint32_t base_time) {
+  enc->buf = buf;
+  enc->cap = cap;
+  enc->len = 0;
+  enc->count = 0;
+  enc->t_prev = base_time;
+  enc->seen = 0;
+}
+
+/**
+ * @brief 缓冲区是否已满
+ */
+bool TelemetryCodec_Full(const TelemetryEncoder_t *enc) {
+  return enc->count == UINT8_MAX ||
+         enc->cap - enc->len < TELEMETRY_CODEC_RECORD_MAX;
+}
+
+/**
+ * @brief 追加一条记录
+ */
+bool TelemetryCodec_Put(TelemetryEncoder_t *enc, uint32_t t,
+                        SensorHandle_t sensor, const int16_t *fixed,
+                        uint8_t channels) {
+  uint8_t *p;
+  int16_t *prev = NULL;
+
+  if (channels > SENSOR_MAX_CHANNELS || TelemetryCodec_Full(enc)) {
+    return false;
+  }
+
+  for (uint8_t i = 0; i < enc->seen; i++) {
+    if (enc->last[i].handle == sensor) {
+      prev = enc->last[i].prev;
+      break;
+    }
+  }
+  if (prev == NULL) {
+    if (enc->seen == SENSOR_MAX_INSTANCES) {
+      return false;
+    }
+    enc->last[enc->seen].handle = sensor;
+    prev = enc->last[enc->seen].prev;
+    memset(prev, 0, sizeof(enc->last[0].prev));
+    enc->seen++;
+  }
+
+  /* 各传感器的事件按读取完成的顺序到达，时间可能比上一条略早，时间差也用 zig-zag */
+  p = &enc->buf[enc->len];
+  p += codec_put_varint(p, codec_zigzag((int32_t)(t - enc->t_prev)));
+  *p++ = (uint8_t)sensor;
+  for (uint8_t ch = 0; ch < channels; ch++) {
+    p += codec_put_varint(p, codec_zigzag((int32_t)fixed[ch] - prev[ch]));
+    prev[ch] = fixed[ch];
+  }
+
+  enc->t_prev = t;
+  enc->len = (uint16_t)(p - enc->buf);
+  enc->count++;
+  return true;
+}
+
+/**
+ * @brief 写入边缘汇总模式记录的公共开头 [时间差 | 类型 | 句柄]
+ */
+static uint8_t *codec_put_edge_head(TelemetryEncoder_t *enc, uint32_t t,
+                                    uint8_t kind, SensorHandle_t sensor) {
+  uint8_t *p = &enc->buf[enc->len];
+
+  p += codec_put_varint(p, codec_zigzag((int32_t)(t - enc->t_prev)));
+  *p++ = kind;
+  *p++ = (uint8_t)sensor;
+  enc->t_prev = t;
+  return p;
+}
+
+/**
+ * @brief 追加一条汇总记录
+ */
+bool TelemetryCodec_PutSummary(TelemetryEncoder_t *enc, uint32_t t,
+                               SensorHandle_t sensor,
+                               const TelemetrySummary_t *summary,
+                               uint8_t channels) {
+  uint8_t *p;
+
+  if (channels > SENSOR_MAX_CHANNELS || enc->count == UINT8_MAX ||
+      enc->cap - enc->len < TELEMETRY_CODEC_SUMMARY_MAX) {
+    return false;
+  }
+  p = codec_put_edge_head(enc, t, TELEMETRY_REC_SUMMARY, sensor);
+  p += codec_put_varint(p, summary->count);
+  for (uint8_t ch = 0; ch < channels; ch++) {
+    int32_t mean = summary->mean[ch];
+
+    p += codec_put_varint(p, codec_zigzag(mean));
+    p += codec_put_varint(p, codec_zigzag((int32_t)summary->min[ch] - mean));
+    p += codec_put_varint(p, codec_zigzag((int32_t)summary->max[ch] - mean));
+    p += codec_put_varint(p, summary->stddev[ch]);
+  }
+  enc->len = (uint16_t)(p - enc->buf);
+  enc->count++;
+  return true;
+}
+
+/**
+ * @brief 追加一条事件记录
+ */
+bool TelemetryCodec_PutEvent(TelemetryEncoder_t *enc, uint32_t t, uint8_t kind,
+                             uint8_t arg, SensorHandle_t sensor,
+                             const int16_t *fixed, uint8_t channels) {
+  uint8_t *p;
+
+  if (channels > SENSOR_MAX_CHANNELS || enc->count == UINT8_MAX ||
+      enc->cap - enc->len < TELEMETRY_CODEC_EVENT_MAX) {
+    return false;
+  }
+  p = codec_put_edge_head(enc, t, kind, sensor);
+  *p++ = arg;
+  for (uint8_t ch = 0; ch < channels; ch++) {
+    p += codec_put_varint(p, codec_zigzag(fixed[ch]));
+  }
+  enc->len = (uint16_t)(p - enc->buf);
+  enc->count++;
+  return true;
+}
+
+/**
+ * @brief 生成模式描述
+ */
+uint16_t TelemetryCodec_BuildSchema(uint8_t *buf, uint16_t cap,
+                                    uint8_t *count) {
+  uint16_t len = 0;
+  uint8_t n = SensorTask_GetSensorCount();
+
+  for (uint8_t i = 0; i < n; i++) {
+    SensorHandle_t sensor = SensorTask_GetHandleAt(i);
+    const SensorChannelDesc_t *channels;
+    uint8_t channel_count = SensorTask_GetChannels(sensor, &channels);
+
+    if (len + 2 > cap) {
+      return 0;
+    }
+    buf[len++] = (uint8_t)sensor;
+    buf[len++] = channel_count;
+    for (uint8_t ch = 0; ch < channel_count; ch++) {
+      if (len + sizeof(float) > cap) {
+        return 0;
+      }
+      memcpy(&buf[len], &channels[ch].fixed_scale, sizeof(float));
+      len += sizeof(float);
+      if (!codec_put_str(buf, cap, &len, channels[ch].name) ||
+          !codec_put_str(buf, cap, &len, channels[ch].unit)) {
+        return 0;
+      }
+    }
+  }
+  if (count != NULL) {
+    *count = n;
+  }
+  return len;
+}
+
+/**
+ * @brief 生成指标快照
+ */
+uint16_t TelemetryCodec_BuildMetrics(uint8_t *buf, uint16_t cap) {
+  MetricSnapshot_t snap;
+  uint16_t len = 0;
+
+  for (int id = 0; id < METRIC_MAX; id++) {
+    if (!Metrics_Read((MetricId_t)id, &snap) || len + 2 > cap) {
+      return 0;
+    }
+    buf[len++] = (uint8_t)id;
+    buf[len++] = (uint8_t)snap.kind;
+    if (!codec_put_str(buf, cap, &len, snap.name) ||
+        !codec_put_str(buf, cap, &len, snap.unit)) {
+      return 0;
+    }
+
+    // 按最长编码检查剩余空间：32 位 5 字节，总和 10 字节
+    if (snap.kind != METRIC_HISTOGRAM) {
+      if (len + 5 > cap) {
+        return 0;
+      }
+      len += codec_put_varint(&buf[len], snap.value);
+      continue;
+    }
+    if (len + 21 + 5 * (2 * snap.bound_count + 1) > cap) {
+      return 0;
+    }
+    len += codec_put_varint(&buf[len], snap.value);
+    len += codec_put_varint64(&buf[len], snap.sum);
+    len += codec_put_varint(&buf[len], snap.max);
+    buf[len++] = snap.bound_count;
+    for (uint8_t i = 0; i < snap.bound_count; i++) {
+      len += codec_put_varint(&buf[len], snap.bounds[i]);
+    }
+    for (uint8_t i = 0; i <= snap.bound_count; i++) {
+      len += codec_put_varint(&buf[len], snap.bins[i]);
+    }
+  }
+  return len;
+}
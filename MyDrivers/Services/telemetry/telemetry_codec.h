@@ -0,0 +1,159 @@
+/**
+ ******************************************************************************
+ * @file    telemetry_codec.h
+ * @brief   遥测批次的紧凑二进制编码 (差分 + zig-zag 变长整数)
+ * @details 每条记录按到达顺序编码为：
+ *            [时间差 | 传感器句柄 | 通道 0 差值 | 通道 1 差值 ...]
+ *            - 时间差：与上一条记录 (首条为帧头基准时间) 的秒数之差；
+ *            - 通道差值：与同一传感器在本批次中上一条记录的定点值之差，
+ *              本批次首次出现时与 0 相比；
+ *            - 有符号数经 zig-zag 映射后按 LEB128 变长编码 (每字节 7 位，
+ *              最高位表示后面还有字节)。
+ *          通道数不随记录发送，由模式描述给出：模式描述列出所有已注册的
+ *          传感器及其通道 (名称、单位、定点缩放系数)，模式 ID 为其 CRC-32，
+ *          数据帧携带模式 ID，服务器按 ID 缓存模式并据此解码。
+ *          环境数据变化缓慢，通道差值与时间差多数落在 1 字节内，一条双通道
+ *          记录通常 4 字节 (Flash 日志格式为 8 字节，JSON 文本约 60 字节)。
+ *          边缘汇总模式 (TELEMETRY_FLAG_EDGE) 的帧中每条记录带类型：
+ *            [时间差 | 类型 | 传感器句柄 | ...]
+ *            - 汇总 (窗口起点)：[样本数 | 每通道: 均值 | 最小值 - 均值 |
+ *              最大值 - 均值 | 标准差 (无符号)]，均为定点值；
+ *            - 事件 (告警触发/解除、异常)：[参数 | 每通道定点值]，参数为
+ *              告警规则下标或异常的通道下标，通道值为触发样本的原值。
+ *          指标帧 (TELEMETRY_FLAG_METRICS) 的负载为指标注册表 (metrics.h)
+ *          的快照，自带名称，不依赖模式描述，见 TelemetryCodec_BuildMetrics。
+ *          服务器端解码见 telemetry_decode.py。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __TELEMETRY_CODEC_H
+#define __TELEMETRY_CODEC_H
+
+#include "sensor_task.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define TELEMETRY_CODEC_SCHEMA_MAX 192 // 模式描述的最大长度 (字节)
+#define TELEMETRY_CODEC_METRICS_MAX 768 // 指标快照的最大长度 (字节)
+
+// 单条记录编码后的最大长度：时间差 5 + 句柄 1 + 每通道 3
+#define TELEMETRY_CODEC_RECORD_MAX (6 + 3 * SENSOR_MAX_CHANNELS)
+// 汇总记录的最大长度：时间差 5 + 类型 1 + 句柄 1 + 样本数 3 + 每通道 4 * 3
+#define TELEMETRY_CODEC_SUMMARY_MAX (10 + 12 * SENSOR_MAX_CHANNELS)
+// 事件记录的最大长度：时间差 5 + 类型 1 + 句柄 1 + 参数 1 + 每通道 3
+#define TELEMETRY_CODEC_EVENT_MAX (8 + 3 * SENSOR_MAX_CHANNELS)
+
+/* 边缘汇总模式的记录类型 */
+#define TELEMETRY_REC_SUMMARY 0     // 窗口汇总
+#define TELEMETRY_REC_ALARM 1       // 告警规则触发
+#define TELEMETRY_REC_ALARM_CLEAR 2 // 告警规则解除
+#define TELEMETRY_REC_ANOMALY 3     // 通道数值偏离基线
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 编码器状态 (对应一个正在攒的批次)
+ */
+typedef struct {
+  uint8_t *buf;     // 输出缓冲区
+  uint16_t cap;     // 缓冲区容量
+  uint16_t len;     // 已编码字节数
+  uint8_t count;    // 已编码记录数
+  uint32_t t_prev;  // 上一条记录的时间 (s)
+  uint8_t seen;     // 本批次出现过的传感器数
+  struct {
+    SensorHandle_t handle;
+    int16_t prev[SENSOR_MAX_CHANNELS];
+  } last[SENSOR_MAX_INSTANCES]; // 各传感器上一条记录的定点值
+} TelemetryEncoder_t;
+
+/**
+ * @brief 一个传感器在一个窗口内的汇总 (定点值)
+ */
+typedef struct {
+  uint16_t count;                      // 样本数
+  int16_t mean[SENSOR_MAX_CHANNELS];
+  int16_t min[SENSOR_MAX_CHANNELS];
+  int16_t max[SENSOR_MAX_CHANNELS];
+  uint16_t stddev[SENSOR_MAX_CHANNELS];
+} TelemetrySummary_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 开始一个批次
+ * @param base_time 基准时间 (s)，首条记录的时间差相对于它
+ */
+void TelemetryCodec_Begin(TelemetryEncoder_t *enc, uint8_t *buf, uint16_t cap,
+                          uint32_t base_time);
+
+/**
+ * @brief 追加一条记录
+ * @param t        记录时间 (s，与基准时间同一时基)
+ * @param fixed    各通道定点值
+ * @param channels 通道数 (须与模式描述一致)
+ * @return false: 缓冲区剩余空间不足，记录未写入
+ */
+bool TelemetryCodec_Put(TelemetryEncoder_t *enc, uint32_t t,
+                        SensorHandle_t sensor, const int16_t *fixed,
+                        uint8_t channels);
+
+/**
+ * @brief 追加一条汇总记录 (边缘汇总模式)
+ * @param t 窗口起点 (s)
+ * @return false: 缓冲区剩余空间不足，记录未写入
+ */
+bool TelemetryCodec_PutSummary(TelemetryEncoder_t *enc, uint32_t t,
+                               SensorHandle_t sensor,
+                               const TelemetrySummary_t *summary,
+                               uint8_t channels);
+
+/**
+ * @brief 追加一条事件记录 (边缘汇总模式)
+ * @param kind  TELEMETRY_REC_ALARM / ALARM_CLEAR / ANOMALY
+ * @param arg   告警规则下标或异常的通道下标
+ * @param fixed 触发样本的各通道定点值
+ * @return false: 缓冲区剩余空间不足，记录未写入
+ */
+bool TelemetryCodec_PutEvent(TelemetryEncoder_t *enc, uint32_t t, uint8_t kind,
+                             uint8_t arg, SensorHandle_t sensor,
+                             const int16_t *fixed, uint8_t channels);
+
+/**
+ * @brief 缓冲区是否已放不下一条最长的记录
+ */
+bool TelemetryCodec_Full(const TelemetryEncoder_t *enc);
+
+/**
+ * @brief 按当前已注册的传感器生成模式描述
+ * @details 格式：按注册顺序每个传感器一项
+ *            [句柄 | 通道数 | 每通道: 缩放系数 (float) | 名称\0 | 单位\0]
+ * @param count 输出传感器数 (可为 NULL)
+ * @return 描述长度；缓冲区不足时返回 0
+ */
+uint16_t TelemetryCodec_BuildSchema(uint8_t *buf, uint16_t cap,
+                                    uint8_t *count);
+
+/**
+ * @brief 生成指标快照 (按注册表顺序读取所有指标)
+ * @details 格式：每个指标一项 [序号 | 类型 | 名称\0 | 单位\0 | 数值]
+ *            - 计数器/仪表：值；
+ *            - 直方图：[样本数 | 总和 | 最大值 | 边界数 n | n 个边界 |
+ *              n + 1 个桶计数]；
+ *          数值均为 LEB128 变长无符号整数 (总和最多 10 字节)。
+ * @return 快照长度；缓冲区不足时返回 0
+ */
+uint16_t TelemetryCodec_BuildMetrics(uint8_t *buf, uint16_t cap);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TELEMETRY_CODEC_H */
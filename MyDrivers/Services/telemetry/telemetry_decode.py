@@ -0,0 +1,316 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+@file    telemetry_decode.py
+@brief   遥测上行帧的接收与解码工具 (与 telemetry.c / telemetry_codec.c 配套)
+@details 作为 TCP 服务器 (或 UDP 接收端) 接收设备的上行帧，或解码抓包文件，输出 CSV。
+         帧格式见 telemetry.h，记录编码与模式描述见 telemetry_codec.h。
+         模式描述按 (设备号, 模式 ID) 缓存；收到引用未知模式的数据帧时跳过并提示。
+         序号不连续时提示缺失的批次数 (队列满时设备移出最旧的批次，设备有
+         离线缓存时这些记录稍后以补发批次送达)。
+         时基一列为 rtc (Unix 秒)、uptime (上电秒数) 或 log (日志时间，补发
+         本次上电之前的记录)；补发的记录可能与已收到的重复，按
+         (设备号, 传感器, 时基, 时间) 去重。
+         边缘汇总帧 (FLAG_EDGE) 中的记录输出为 kind 列：mean/min/max/stddev
+         (detail 为窗口内样本数)，或 alarm/alarm_clear (detail 为规则下标)、
+         anomaly (detail 为通道下标)，事件行的值为触发样本的原值；
+         原始样本的 kind 为 sample。
+         指标帧 (FLAG_METRICS) 输出为传感器列 metrics、通道列为指标名的行，
+         时间为快照时刻：计数器/仪表的 kind 为 counter/gauge；直方图输出
+         count/sum/max 各一行，以及每个桶一行 (kind 为 bucket，detail 为
+         桶上界，最后一个桶为 inf)。数值均为上电以来的累计值。
+
+用法:
+    python telemetry_decode.py --listen 9000 -o data.csv     # 接收多个设备
+    python telemetry_decode.py --listen 9000 --udp -o data.csv  # 以太网链路 (UDP)
+    python telemetry_decode.py capture.bin -o data.csv       # 解码抓包文件
+
+@author  MmsY
+@time    2025/11/23
+"""
+
+import argparse
+import csv
+import socket
+import struct
+import sys
+import threading
+import zlib
+
+HEADER = struct.Struct("<2sBBIHHII")
+MAGIC = b"ET"
+VERSIONS = (2, 3, 4)
+FLAG_RTC, FLAG_SCHEMA, FLAG_REPLAY, FLAG_LOGTIME = 0x01, 0x02, 0x04, 0x08
+FLAG_EDGE, FLAG_METRICS = 0x10, 0x20
+METRIC_KINDS = ("counter", "gauge", "histogram")
+REC_SUMMARY, REC_ALARM, REC_ALARM_CLEAR, REC_ANOMALY = 0, 1, 2, 3
+EVENT_KINDS = {REC_ALARM: "alarm", REC_ALARM_CLEAR: "alarm_clear", REC_ANOMALY: "anomaly"}
+SENSOR_NAMES = {1: "gy30", 2: "sht30", 3: "mq2"}
+
+
+def read_varint(buf, pos):
+    value = shift = 0
+    while True:
+        b = buf[pos]
+        pos += 1
+        value |= (b & 0x7F) << shift
+        shift += 7
+        if b < 0x80:
+            return value, pos
+
+
+def unzigzag(v):
+    return (v >> 1) ^ -(v & 1)
+
+
+def sensor_name(handle):
+    kind, index = handle & 0x0F, handle >> 4
+    name = SENSOR_NAMES.get(kind, str(kind))
+    return name + (":%d" % index if index else "")
+
+
+def parse_schema(payload):
+    """返回 {句柄: [(通道名, 单位, 缩放系数), ...]}"""
+    schema, pos = {}, 0
+    while pos < len(payload):
+        handle, count = payload[pos], payload[pos + 1]
+        pos += 2
+        channels = []
+        for _ in range(count):
+            scale = struct.unpack_from("<f", payload, pos)[0]
+            pos += 4
+            name_end = payload.index(0, pos)
+            unit_end = payload.index(0, name_end + 1)
+            channels.append((payload[pos:name_end].decode("utf-8", "replace"),
+                             payload[name_end + 1:unit_end].decode("utf-8", "replace"),
+                             scale))
+            pos = unit_end + 1
+        schema[handle] = channels
+    return schema
+
+
+def read_cstr(buf, pos):
+    end = buf.index(0, pos)
+    return buf[pos:end].decode("utf-8", "replace"), end + 1
+
+
+def parse_metrics(payload):
+    """逐项产出 (指标名, 单位, [(kind, detail, 值)...])"""
+    pos = 0
+    while pos < len(payload):
+        kind = payload[pos + 1]
+        name, pos = read_cstr(payload, pos + 2)
+        unit, pos = read_cstr(payload, pos)
+        if kind != 2:
+            value, pos = read_varint(payload, pos)
+            yield name, unit, [(METRIC_KINDS[kind], "", value)]
+            continue
+        rows = []
+        for field in ("count", "sum", "max"):
+            value, pos = read_varint(payload, pos)
+            rows.append((field, "", value))
+        n = payload[pos]
+        pos += 1
+        bounds = []
+        for _ in range(n):
+            bound, pos = read_varint(payload, pos)
+            bounds.append(str(bound))
+        for bound in bounds + ["inf"]:
+            value, pos = read_varint(payload, pos)
+            rows.append(("bucket", bound, value))
+        yield name, unit, rows
+
+
+def decode_records(payload, base_time, schema):
+    """逐条产出 (时间, 句柄, [实际值...])"""
+    t, last, pos = base_time, {}, 0
+    while pos < len(payload):
+        dt, pos = read_varint(payload, pos)
+        t += unzigzag(dt)
+        handle = payload[pos]
+        pos += 1
+        channels = schema[handle]
+        prev = last.setdefault(handle, [0] * len(channels))
+        values = []
+        for ch, (_name, _unit, scale) in enumerate(channels):
+            d, pos = read_varint(payload, pos)
+            prev[ch] += unzigzag(d)
+            values.append(prev[ch] / scale if scale else prev[ch])
+        yield t, handle, values
+
+
+def decode_edge_records(payload, base_time, schema):
+    """逐条产出 (时间, 句柄, kind, detail, [(kind, 实际值)...] 按通道)"""
+    t, pos = base_time, 0
+    while pos < len(payload):
+        dt, pos = read_varint(payload, pos)
+        t += unzigzag(dt)
+        kind, handle = payload[pos], payload[pos + 1]
+        pos += 2
+        channels = schema[handle]
+        rows = []
+        if kind == REC_SUMMARY:
+            count, pos = read_varint(payload, pos)
+            for _name, _unit, scale in channels:
+                fields = []
+                for _ in range(3):
+                    v, pos = read_varint(payload, pos)
+                    fields.append(unzigzag(v))
+                sd, pos = read_varint(payload, pos)
+                mean = fields[0]
+                div = scale if scale else 1
+                rows.append([("mean", mean / div), ("min", (mean + fields[1]) / div),
+                             ("max", (mean + fields[2]) / div), ("stddev", sd / div)])
+            yield t, handle, "summary", count, rows
+        else:
+            arg = payload[pos]
+            pos += 1
+            for _name, _unit, scale in channels:
+                v, pos = read_varint(payload, pos)
+                rows.append([(EVENT_KINDS.get(kind, str(kind)),
+                              unzigzag(v) / scale if scale else unzigzag(v))])
+            yield t, handle, EVENT_KINDS.get(kind, str(kind)), arg, rows
+
+
+class Decoder:
+    """按流解析帧，同一个 Decoder 可服务多个设备"""
+
+    def __init__(self, writer):
+        self.writer = writer
+        self.schemas = {}  # (unit_id, schema_id) -> schema
+        self.last_seq = {}  # unit_id -> seq
+        self.lock = threading.Lock()
+
+    def feed(self, buf):
+        """解析 buf 中的完整帧，返回已消耗的字节数"""
+        pos = 0
+        while True:
+            start = buf.find(MAGIC, pos)
+            if start < 0:
+                return max(pos, len(buf) - 1)
+            if len(buf) - start < HEADER.size:
+                return start
+            (_magic, version, flags, unit, seq, length,
+             base_time, schema_id) = HEADER.unpack_from(buf, start)
+            end = start + HEADER.size + length
+            if version not in VERSIONS or length > 4096:
+                pos = start + 1
+                continue
+            if len(buf) < end + 4:
+                return start
+            crc = struct.unpack_from("<I", buf, end)[0]
+            if zlib.crc32(bytes(buf[start:end])) & 0xFFFFFFFF != crc:
+                pos = start + 1
+                continue
+            self.frame(unit, seq, flags, base_time, schema_id,
+                       bytes(buf[start + HEADER.size:end]))
+            pos = end + 4
+
+    def frame(self, unit, seq, flags, base_time, schema_id, payload):
+        with self.lock:
+            if flags & FLAG_SCHEMA:
+                self.schemas[(unit, schema_id)] = parse_schema(payload)
+                return
+            if flags & FLAG_METRICS:
+                # 自带名称，不依赖模式描述，也不占用批次序号
+                clock = "rtc" if flags & FLAG_RTC else "uptime"
+                for name, unit_str, rows in parse_metrics(payload):
+                    for kind, detail, v in rows:
+                        self.writer.writerow(["%08X" % unit, clock, base_time,
+                                              "metrics", name, v, unit_str,
+                                              kind, detail])
+                return
+            schema = self.schemas.get((unit, schema_id))
+            if schema is None:
+                print("%08X: unknown schema %08X, frame %d skipped"
+                      % (unit, schema_id, seq), file=sys.stderr)
+                return
+            prev = self.last_seq.get(unit)
+            if prev is not None and (seq - prev) & 0xFFFF > 1:
+                print("%08X: %d batches missing before %d"
+                      % (unit, ((seq - prev) & 0xFFFF) - 1, seq), file=sys.stderr)
+            self.last_seq[unit] = seq
+            if flags & FLAG_LOGTIME:
+                clock = "log"
+            else:
+                clock = "rtc" if flags & FLAG_RTC else "uptime"
+            if flags & FLAG_EDGE:
+                for t, handle, _kind, detail, rows in decode_edge_records(
+                        payload, base_time, schema):
+                    for (name, unit_str, _scale), fields in zip(schema[handle], rows):
+                        for kind, v in fields:
+                            self.writer.writerow(["%08X" % unit, clock, t,
+                                                  sensor_name(handle), name, "%g" % v,
+                                                  unit_str, kind, detail])
+                return
+            for t, handle, values in decode_records(payload, base_time, schema):
+                for (name, unit_str, _scale), v in zip(schema[handle], values):
+                    self.writer.writerow(["%08X" % unit, clock, t, sensor_name(handle),
+                                          name, "%g" % v, unit_str, "sample", ""])
+
+
+def serve(port, decoder):
+    srv = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind(("", port))
+    srv.listen(16)
+
+    def client(conn, addr):
+        buf = bytearray()
+        with conn:
+            while True:
+                data = conn.recv(4096)
+                if not data:
+                    break
+                buf += data
+                del buf[:decoder.feed(buf)]
+        print("%s:%d closed" % addr, file=sys.stderr)
+
+    while True:
+        conn, addr = srv.accept()
+        print("%s:%d connected" % addr, file=sys.stderr)
+        threading.Thread(target=client, args=(conn, addr), daemon=True).start()
+
+
+def serve_udp(port, decoder):
+    # 以太网链路：每个数据报正好是一帧
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+    sock.bind(("", port))
+    while True:
+        data, _addr = sock.recvfrom(2048)
+        decoder.feed(bytearray(data))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="EnviroSense telemetry decoder")
+    ap.add_argument("source", nargs="?", help="抓包文件 (与 --listen 二选一)")
+    ap.add_argument("--listen", type=int, help="监听的 TCP 端口")
+    ap.add_argument("--udp", action="store_true", help="--listen 端口改为接收 UDP (以太网链路)")
+    ap.add_argument("-o", "--output", help="CSV 输出文件，缺省为 stdout")
+    opts = ap.parse_args()
+    if not opts.source and not opts.listen:
+        ap.error("需要抓包文件或 --listen")
+
+    out = open(opts.output, "a" if opts.listen else "w", newline="") \
+        if opts.output else sys.stdout
+    writer = csv.writer(out)
+    writer.writerow(["unit", "clock", "time_s", "sensor", "channel", "value", "unit_str",
+                     "kind", "detail"])
+    decoder = Decoder(writer)
+
+    if opts.listen:
+        try:
+            if opts.udp:
+                serve_udp(opts.listen, decoder)
+            else:
+                serve(opts.listen, decoder)
+        except KeyboardInterrupt:
+            pass
+    else:
+        with open(opts.source, "rb") as f:
+            decoder.feed(bytearray(f.read()))
+    out.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,178 @@
+/**
+ ******************************************************************************
+ * @file    telemetry_edge.c
+ * @brief   遥测边缘汇总实现
+ * @details 统计直接在定点值上进行 (与上行编码同一单位)，汇总导出时四舍五入
+ *          回定点。传感器按首次出现的顺序占用槽位。告警规则的状态按规则
+ *          下标记住上次看到的激活状态与触发次数，两次样本之间触发又解除
+ *          也能检出。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "telemetry_edge.h"
+#include "sensor_alarm.h"
+#include "sensor_stats.h"
+#include <math.h>
+#include <string.h>
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  SensorHandle_t sensor;
+  uint8_t channels;
+  uint8_t anomalous; // 正处于异常的通道 (位图)
+  SensorStatsAcc_t acc[SENSOR_MAX_CHANNELS];
+  SensorStatsEwma_t ewma[SENSOR_MAX_CHANNELS];
+} TelemetryEdgeSensor_t;
+
+typedef struct {
+  bool active;
+  uint32_t triggers;
+} TelemetryEdgeAlarm_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static TelemetryEdgeSensor_t s_sensors[SENSOR_MAX_INSTANCES];
+static uint8_t s_count = 0;
+static TelemetryEdgeAlarm_t s_alarms[SENSOR_ALARM_MAX_RULES];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static TelemetryEdgeSensor_t *telemetry_edge_find(SensorHandle_t sensor,
+                                                  uint8_t channels) {
+  for (uint8_t i = 0; i < s_count; i++) {
+    if (s_sensors[i].sensor == sensor) {
+      return &s_sensors[i];
+    }
+  }
+  if (s_count == SENSOR_MAX_INSTANCES) {
+    return NULL;
+  }
+  memset(&s_sensors[s_count], 0, sizeof(s_sensors[0]));
+  s_sensors[s_count].sensor = sensor;
+  s_sensors[s_count].channels = channels;
+  return &s_sensors[s_count++];
+}
+
+static int16_t telemetry_edge_round(double v) {
+  v = v < 0 ? v - 0.5 : v + 0.5;
+  if (v > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (v < INT16_MIN) {
+    return INT16_MIN;
+  }
+  return (int16_t)v;
+}
+
+/**
+ * @brief 检出该传感器的告警规则状态变化
+ */
+static uint8_t telemetry_edge_alarms(SensorHandle_t sensor,
+                                     TelemetryEdgeEvent_t *events, uint8_t n) {
+  uint8_t rules = SensorAlarm_GetRuleCount();
+  const SensorAlarmRule_t *rule;
+  SensorAlarmState_t state;
+
+  for (uint8_t i = 0; i < rules && i < SENSOR_ALARM_MAX_RULES; i++) {
+    TelemetryEdgeAlarm_t *last = &s_alarms[i];
+    bool raised;
+
+    if (!SensorAlarm_GetRule(i, &rule, &state) || rule->sensor != sensor) {
+      continue;
+    }
+    raised = state.trigger_count != last->triggers;
+    if (raised && n < TELEMETRY_EDGE_MAX_EVENTS) {
+      events[n].kind = TELEMETRY_REC_ALARM;
+      events[n++].arg = i;
+    }
+    if (!state.active && (last->active || raised) &&
+        n < TELEMETRY_EDGE_MAX_EVENTS) {
+      events[n].kind = TELEMETRY_REC_ALARM_CLEAR;
+      events[n++].arg = i;
+    }
+    last->active = state.active;
+    last->triggers = state.trigger_count;
+  }
+  return n;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 清空所有窗口与基线
+ */
+void TelemetryEdge_Reset(void) {
+  const SensorAlarmRule_t *rule;
+  SensorAlarmState_t state;
+
+  s_count = 0;
+  memset(s_alarms, 0, sizeof(s_alarms));
+  for (uint8_t i = 0; i < SensorAlarm_GetRuleCount() && i < SENSOR_ALARM_MAX_RULES;
+       i++) {
+    if (SensorAlarm_GetRule(i, &rule, &state)) {
+      s_alarms[i].active = state.active; // 已激活的告警不重复上报
+      s_alarms[i].triggers = state.trigger_count;
+    }
+  }
+}
+
+/**
+ * @brief 处理一个有效样本
+ */
+uint8_t TelemetryEdge_Push(const SensorSnapshot_t *snapshot,
+                           TelemetryEdgeEvent_t *events) {
+  TelemetryEdgeSensor_t *s =
+      telemetry_edge_find(snapshot->event.sensor, snapshot->channel_count);
+  uint8_t n = 0;
+
+  if (s == NULL || s->channels != snapshot->channel_count) {
+    return 0;
+  }
+  for (uint8_t ch = 0; ch < s->channels; ch++) {
+    float value = snapshot->fixed[ch];
+    float z = SensorStats_EwmaPush(&s->ewma[ch], value, TELEMETRY_EDGE_EWMA_ALPHA,
+                                   TELEMETRY_EDGE_MIN_SIGMA_LSB,
+                                   TELEMETRY_EDGE_WARMUP);
+    uint8_t bit = (uint8_t)(1U << ch);
+
+    SensorStats_AccPush(&s->acc[ch], value);
+    if (fabsf(z) >= TELEMETRY_EDGE_Z_THRESHOLD) {
+      if (!(s->anomalous & bit) && n < TELEMETRY_EDGE_MAX_EVENTS) {
+        events[n].kind = TELEMETRY_REC_ANOMALY;
+        events[n++].arg = ch;
+      }
+      s->anomalous |= bit;
+    } else if (fabsf(z) < TELEMETRY_EDGE_Z_REARM) {
+      s->anomalous &= (uint8_t)~bit;
+    }
+  }
+  return telemetry_edge_alarms(s->sensor, events, n);
+}
+
+/**
+ * @brief 导出第 i 个传感器的窗口汇总并复位其窗口
+ */
+bool TelemetryEdge_TakeSummary(uint8_t i, SensorHandle_t *sensor,
+                               TelemetrySummary_t *summary, uint8_t *channels) {
+  TelemetryEdgeSensor_t *s;
+
+  if (i >= s_count) {
+    return false;
+  }
+  s = &s_sensors[i];
+  *sensor = s->sensor;
+  *channels = s->channels;
+  summary->count = (uint16_t)(s->acc[0].count > UINT16_MAX ? UINT16_MAX
+                                                           : s->acc[0].count);
+  for (uint8_t ch = 0; ch < s->channels; ch++) {
+    SensorStatsAcc_t *acc = &s->acc[ch];
+
+    summary->mean[ch] = telemetry_edge_round(acc->mean);
+    summary->min[ch] = telemetry_edge_round(acc->min);
+    summary->max[ch] = telemetry_edge_round(acc->max);
+    summary->stddev[ch] = (uint16_t)telemetry_edge_round(SensorStats_AccStddev(acc));
+    SensorStats_AccReset(acc);
+  }
+  return true;
+}
@@ -0,0 +1,77 @@
+/**
+ ******************************************************************************
+ * @file    telemetry_edge.h
+ * @brief   遥测边缘汇总：窗口统计、告警变化与异常检测
+ * @details 边缘汇总模式 (TELEMETRY_MODE_EDGE) 下上行不再发送每个样本：
+ *            - 每个通道按 TELEMETRY_EDGE_WINDOW_S 的时间窗口累积最小/最大/
+ *              均值/标准差 (sensor_stats 的窗口累加器)，窗口结束时导出；
+ *            - 每个通道维护 EWMA 基线，样本的 z-score 超过
+ *              TELEMETRY_EDGE_Z_THRESHOLD 时判为异常，回落到
+ *              TELEMETRY_EDGE_Z_REARM 以下后才会再次上报；
+ *            - 告警规则引擎的规则状态变化 (触发、解除) 随该传感器的样本检出。
+ *          异常与告警事件带触发样本的原值立即上报。
+ *          只由上行任务调用，不加锁。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __TELEMETRY_EDGE_H
+#define __TELEMETRY_EDGE_H
+
+#include "sensor_task.h"
+#include "telemetry_codec.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define TELEMETRY_EDGE_WINDOW_S 300        // 汇总窗口 (RTC 已校时时对齐墙上时钟)
+#define TELEMETRY_EDGE_EWMA_ALPHA 0.05f    // 基线平滑系数 (约 20 个样本的记忆)
+#define TELEMETRY_EDGE_WARMUP 30           // 基线学习的样本数，此前不判定异常
+#define TELEMETRY_EDGE_Z_THRESHOLD 4.0f    // 判为异常的 z-score
+#define TELEMETRY_EDGE_Z_REARM 2.0f        // 回落到该 z-score 以下后重新允许上报
+#define TELEMETRY_EDGE_MIN_SIGMA_LSB 2.0f  // 基线标准差下限 (定点 LSB)
+#define TELEMETRY_EDGE_MAX_EVENTS 4        // 一个样本最多检出的事件数
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 一个样本检出的事件
+ */
+typedef struct {
+  uint8_t kind; // TELEMETRY_REC_ALARM / ALARM_CLEAR / ANOMALY
+  uint8_t arg;  // 告警规则下标或异常的通道下标
+} TelemetryEdgeEvent_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 清空所有窗口与基线
+ */
+void TelemetryEdge_Reset(void);
+
+/**
+ * @brief 处理一个有效样本：累积窗口统计并检测事件
+ * @param events 输出事件 (容量 TELEMETRY_EDGE_MAX_EVENTS)
+ * @return 事件数
+ */
+uint8_t TelemetryEdge_Push(const SensorSnapshot_t *snapshot,
+                           TelemetryEdgeEvent_t *events);
+
+/**
+ * @brief 导出第 i 个传感器的窗口汇总并复位其窗口
+ * @param i 从 0 开始依次调用，直到返回 false (窗口内无样本时 count 为 0)
+ * @return false: 没有更多传感器
+ */
+bool TelemetryEdge_TakeSummary(uint8_t i, SensorHandle_t *sensor,
+                               TelemetrySummary_t *summary, uint8_t *channels);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TELEMETRY_EDGE_H */
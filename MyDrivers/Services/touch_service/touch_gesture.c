@@ -0,0 +1,265 @@
+/**
+ ******************************************************************************
+ * @file    touch_gesture.c
+ * @brief   多点触摸手势识别源文件
+ * @details 状态机：空闲 -> 单指跟踪 -> (滑动/长按 -> 已消费) 或 (第二指按下 ->
+ *          缩放 -> 已消费)，全部手指抬起后回到空闲。每次按下最多识别出一个
+ *          滑动或长按，避免一次拖动触发多次翻页。
+ *          速度取触点历史环中最旧与最新样本的差分，比相邻两帧差分更能抵抗
+ *          单个样本的坐标抖动；两指间距用整数平方根计算。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "touch_gesture.h"
+#include <string.h>
+
+/* --------------------------- 私有宏 --------------------------- */
+#define GESTURE_STATE_IDLE 0  // 无触摸
+#define GESTURE_STATE_TRACK 1 // 单指跟踪中
+#define GESTURE_STATE_PINCH 2 // 双指缩放中
+#define GESTURE_STATE_DONE 3  // 本次按下已产生手势，等待全部抬起
+
+#define GESTURE_ABS(v) (((v) < 0) ? -(v) : (v))
+#define GESTURE_RING_MASK (TOUCH_GESTURE_RING_SIZE - 1)
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 32 位整数平方根 (逐位试商)
+ */
+static uint32_t gesture_isqrt(uint32_t v) {
+  uint32_t res = 0;
+  uint32_t bit = 1UL << 30;
+
+  while (bit > v)
+    bit >>= 2;
+
+  while (bit != 0) {
+    if (v >= res + bit) {
+      v -= res + bit;
+      res = (res >> 1) + bit;
+    } else {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+  return res;
+}
+
+static void gesture_ring_push(TouchPointRing_t *ring, int16_t x, int16_t y,
+                              uint32_t t) {
+  ring->x[ring->head] = x;
+  ring->y[ring->head] = y;
+  ring->t[ring->head] = t;
+  ring->head = (ring->head + 1) & GESTURE_RING_MASK;
+  if (ring->count < TOUCH_GESTURE_RING_SIZE)
+    ring->count++;
+}
+
+/**
+ * @brief 由历史环估计速度 (px/s)，样本不足或时间差为 0 时返回 0
+ */
+static void gesture_ring_velocity(const TouchPointRing_t *ring, int32_t *vx,
+                                  int32_t *vy) {
+  uint8_t newest, oldest;
+  uint32_t dt;
+
+  *vx = 0;
+  *vy = 0;
+  if (ring->count < 2)
+    return;
+
+  newest = (ring->head - 1) & GESTURE_RING_MASK;
+  oldest = (ring->head - ring->count) & GESTURE_RING_MASK;
+  dt = ring->t[newest] - ring->t[oldest];
+  if (dt == 0)
+    return;
+
+  *vx = ((int32_t)ring->x[newest] - ring->x[oldest]) * 1000 / (int32_t)dt;
+  *vy = ((int32_t)ring->y[newest] - ring->y[oldest]) * 1000 / (int32_t)dt;
+}
+
+static uint32_t gesture_distance(const TouchSample_t *sample) {
+  int32_t dx = (int32_t)sample->x[1] - sample->x[0];
+  int32_t dy = (int32_t)sample->y[1] - sample->y[0];
+  return gesture_isqrt((uint32_t)(dx * dx + dy * dy));
+}
+
+static void gesture_fill(TouchGesture_t *out, TouchGestureType_t type,
+                         int16_t x, int16_t y) {
+  memset(out, 0, sizeof(TouchGesture_t));
+  out->type = type;
+  out->x = x;
+  out->y = y;
+  out->scale_q8 = 256;
+}
+
+static void gesture_fill_pinch(TouchGestureEngine_t *engine,
+                               const TouchSample_t *sample,
+                               TouchGesture_t *out, TouchGestureType_t type) {
+  gesture_fill(out, type,
+               (int16_t)(((int32_t)sample->x[0] + sample->x[1]) / 2),
+               (int16_t)(((int32_t)sample->y[0] + sample->y[1]) / 2));
+  out->scale_q8 = engine->pinch_last_q8;
+}
+
+/**
+ * @brief 单指跟踪：检查滑动与长按
+ */
+static bool gesture_track(TouchGestureEngine_t *engine,
+                          const TouchSample_t *sample, uint32_t now_ms,
+                          TouchGesture_t *out) {
+  int32_t dx = (int32_t)sample->x[0] - engine->start_x;
+  int32_t dy = (int32_t)sample->y[0] - engine->start_y;
+  int32_t vx, vy;
+
+  if (!engine->moved && (GESTURE_ABS(dx) > TOUCH_GESTURE_SLOP_PX ||
+                         GESTURE_ABS(dy) > TOUCH_GESTURE_SLOP_PX)) {
+    engine->moved = true;
+  }
+
+  if (!engine->moved) {
+    if (now_ms - engine->start_tick < TOUCH_GESTURE_LONG_PRESS_MS)
+      return false;
+    gesture_fill(out, TOUCH_GESTURE_LONG_PRESS, engine->start_x,
+                 engine->start_y);
+    engine->state = GESTURE_STATE_DONE;
+    return true;
+  }
+
+  // 主方向位移至少是另一方向的 2 倍，且沿主方向达到速度门限
+  gesture_ring_velocity(&engine->ring[0], &vx, &vy);
+  if (GESTURE_ABS(dx) >= TOUCH_GESTURE_SWIPE_MIN_PX &&
+      GESTURE_ABS(dx) >= 2 * GESTURE_ABS(dy) &&
+      GESTURE_ABS(vx) >= TOUCH_GESTURE_SWIPE_MIN_SPEED) {
+    gesture_fill(out, (dx < 0) ? TOUCH_GESTURE_SWIPE_LEFT
+                               : TOUCH_GESTURE_SWIPE_RIGHT,
+                 (int16_t)sample->x[0], (int16_t)sample->y[0]);
+  } else if (GESTURE_ABS(dy) >= TOUCH_GESTURE_SWIPE_MIN_PX &&
+             GESTURE_ABS(dy) >= 2 * GESTURE_ABS(dx) &&
+             GESTURE_ABS(vy) >= TOUCH_GESTURE_SWIPE_MIN_SPEED) {
+    gesture_fill(out, (dy < 0) ? TOUCH_GESTURE_SWIPE_UP
+                               : TOUCH_GESTURE_SWIPE_DOWN,
+                 (int16_t)sample->x[0], (int16_t)sample->y[0]);
+  } else {
+    return false;
+  }
+
+  out->vx = vx;
+  out->vy = vy;
+  engine->state = GESTURE_STATE_DONE;
+  return true;
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 复位识别器
+ */
+void TouchGesture_Init(TouchGestureEngine_t *engine) {
+  memset(engine, 0, sizeof(TouchGestureEngine_t));
+  engine->state = GESTURE_STATE_IDLE;
+  engine->pinch_last_q8 = 256;
+}
+
+/**
+ * @brief 输入一个样本并推进识别
+ */
+bool TouchGesture_Feed(TouchGestureEngine_t *engine,
+                       const TouchSample_t *sample, uint32_t now_ms,
+                       TouchGesture_t *out) {
+  bool new_sample;
+
+  if (engine == NULL || sample == NULL || out == NULL)
+    return false;
+
+  if (!sample->pressed) {
+    uint8_t state = engine->state;
+    TouchSample_t last = *sample;
+
+    engine->state = GESTURE_STATE_IDLE;
+    engine->last_seq = sample->seq;
+    if (state != GESTURE_STATE_PINCH)
+      return false;
+    // 两指同时抬起：用历史环中最后的位置作为结束点
+    for (uint8_t i = 0; i < TOUCH_GESTURE_TRACK_POINTS; i++) {
+      const TouchPointRing_t *ring = &engine->ring[i];
+      uint8_t newest = (ring->head - 1) & GESTURE_RING_MASK;
+      last.x[i] = (uint16_t)ring->x[newest];
+      last.y[i] = (uint16_t)ring->y[newest];
+    }
+    gesture_fill_pinch(engine, &last, out, TOUCH_GESTURE_PINCH_END);
+    return true;
+  }
+
+  new_sample = (engine->state == GESTURE_STATE_IDLE) ||
+               (sample->seq != engine->last_seq);
+  engine->last_seq = sample->seq;
+
+  if (engine->state == GESTURE_STATE_IDLE) {
+    memset(engine->ring, 0, sizeof(engine->ring));
+    engine->start_x = (int16_t)sample->x[0];
+    engine->start_y = (int16_t)sample->y[0];
+    engine->start_tick = sample->timestamp;
+    engine->moved = false;
+    engine->state = GESTURE_STATE_TRACK;
+  }
+
+  if (new_sample) {
+    for (uint8_t i = 0; i < TOUCH_GESTURE_TRACK_POINTS; i++) {
+      if (sample->point_mask & (1u << i)) {
+        gesture_ring_push(&engine->ring[i], (int16_t)sample->x[i],
+                          (int16_t)sample->y[i], sample->timestamp);
+      } else {
+        engine->ring[i].count = 0;
+      }
+    }
+  }
+
+  switch (engine->state) {
+  case GESTURE_STATE_TRACK:
+    if ((sample->point_mask & 0x03) == 0x03) {
+      uint32_t dist = gesture_distance(sample);
+      if (dist >= TOUCH_GESTURE_PINCH_MIN_DIST_PX) {
+        engine->pinch_start_dist = dist;
+        engine->pinch_last_q8 = 256;
+        engine->state = GESTURE_STATE_PINCH;
+        gesture_fill_pinch(engine, sample, out, TOUCH_GESTURE_PINCH_BEGIN);
+        return true;
+      }
+      return false;
+    }
+    return gesture_track(engine, sample, now_ms, out);
+
+  case GESTURE_STATE_PINCH:
+    if ((sample->point_mask & 0x03) != 0x03) {
+      // 抬起一指即结束缩放，剩下的手指不再触发滑动
+      engine->state = GESTURE_STATE_DONE;
+      gesture_fill(out, TOUCH_GESTURE_PINCH_END, (int16_t)sample->x[0],
+                   (int16_t)sample->y[0]);
+      out->scale_q8 = engine->pinch_last_q8;
+      return true;
+    }
+    if (new_sample) {
+      uint32_t scale = gesture_distance(sample) * 256 /
+                       engine->pinch_start_dist;
+      int32_t diff;
+
+      if (scale > UINT16_MAX)
+        scale = UINT16_MAX;
+      diff = (int32_t)scale - engine->pinch_last_q8;
+      if (GESTURE_ABS(diff) >= TOUCH_GESTURE_PINCH_STEP_Q8) {
+        engine->pinch_last_q8 = (uint16_t)scale;
+        gesture_fill_pinch(engine, sample, out, TOUCH_GESTURE_PINCH);
+        return true;
+      }
+    }
+    return false;
+
+  case GESTURE_STATE_DONE:
+  default:
+    return false;
+  }
+}
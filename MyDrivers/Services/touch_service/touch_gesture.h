@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * @file    touch_gesture.h
+ * @brief   多点触摸手势识别头文件
+ * @details 以触摸服务缓存的样本 (全部触点) 为输入，为每个触点维护一个
+ *          小的历史环，用最近几次样本估计速度，识别滑动、双指缩放和长按。
+ *          全部使用整数运算：速度单位 px/s，缩放比例为 Q8 定点数 (256 = 1.0)。
+ *          不依赖 LVGL，由调用者决定如何把手势映射到界面操作。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __TOUCH_GESTURE_H
+#define __TOUCH_GESTURE_H
+
+#include "touch_service.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define TOUCH_GESTURE_RING_SIZE 4            // 每个触点保存的历史样本数 (2 的幂)
+#define TOUCH_GESTURE_TRACK_POINTS 2         // 参与识别的触点数 (单指 + 双指缩放)
+#define TOUCH_GESTURE_SWIPE_MIN_PX 80        // 滑动的最小位移
+#define TOUCH_GESTURE_SWIPE_MIN_SPEED 300    // 滑动的最小速度 (px/s)
+#define TOUCH_GESTURE_LONG_PRESS_MS 600      // 长按时间
+#define TOUCH_GESTURE_SLOP_PX 12             // 长按允许的抖动范围
+#define TOUCH_GESTURE_PINCH_MIN_DIST_PX 40   // 双指起始间距下限 (过近时比例不稳定)
+#define TOUCH_GESTURE_PINCH_STEP_Q8 8        // 缩放比例变化超过该值才上报 (约 3%)
+
+/* --------------------------- 数据结构 --------------------------- */
+typedef enum {
+  TOUCH_GESTURE_NONE = 0,
+  TOUCH_GESTURE_SWIPE_LEFT,  // 向左滑 (手指从右往左)
+  TOUCH_GESTURE_SWIPE_RIGHT, // 向右滑
+  TOUCH_GESTURE_SWIPE_UP,    // 向上滑
+  TOUCH_GESTURE_SWIPE_DOWN,  // 向下滑
+  TOUCH_GESTURE_PINCH_BEGIN, // 第二根手指按下，开始缩放
+  TOUCH_GESTURE_PINCH,       // 缩放比例变化
+  TOUCH_GESTURE_PINCH_END,   // 缩放结束 (任一手指抬起)
+  TOUCH_GESTURE_LONG_PRESS   // 单指按住不动超过长按时间
+} TouchGestureType_t;
+
+#define TOUCH_GESTURE_IS_SWIPE(type)                                           \
+  ((type) >= TOUCH_GESTURE_SWIPE_LEFT && (type) <= TOUCH_GESTURE_SWIPE_DOWN)
+
+/**
+ * @brief 识别出的手势 (坐标为屏幕坐标，未做旋转)
+ */
+typedef struct {
+  TouchGestureType_t type;
+  int16_t x, y;       // 手势位置 (缩放时为两指中点)
+  int32_t vx, vy;     // 触发时的速度估计 (px/s)
+  uint16_t scale_q8;  // 缩放比例 (当前间距 / 起始间距，Q8)
+} TouchGesture_t;
+
+/**
+ * @brief 单个触点的历史环
+ */
+typedef struct {
+  int16_t x[TOUCH_GESTURE_RING_SIZE];
+  int16_t y[TOUCH_GESTURE_RING_SIZE];
+  uint32_t t[TOUCH_GESTURE_RING_SIZE];
+  uint8_t head;  // 下一个写入位置
+  uint8_t count; // 有效样本数
+} TouchPointRing_t;
+
+/**
+ * @brief 识别器状态 (每个输入设备一份)
+ */
+typedef struct {
+  TouchPointRing_t ring[TOUCH_GESTURE_TRACK_POINTS];
+  uint8_t state;          // 内部状态机
+  uint32_t last_seq;      // 最近处理的样本序号
+  int16_t start_x, start_y;
+  uint32_t start_tick;
+  bool moved;             // 已超出长按抖动范围
+  uint32_t pinch_start_dist;
+  uint16_t pinch_last_q8;
+} TouchGestureEngine_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 复位识别器
+ */
+void TouchGesture_Init(TouchGestureEngine_t *engine);
+
+/**
+ * @brief 输入一个样本并推进识别，在每次读取触摸状态时调用
+ * @note  样本序号未变化时只检查长按计时，因此按住不动时也要继续调用
+ * @param engine 识别器
+ * @param sample 最新缓存样本
+ * @param now_ms 当前时刻 (HAL_GetTick，与样本时间戳同源)
+ * @param out    输出手势
+ * @return true: 识别出一个手势
+ */
+bool TouchGesture_Feed(TouchGestureEngine_t *engine,
+                       const TouchSample_t *sample, uint32_t now_ms,
+                       TouchGesture_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TOUCH_GESTURE_H */
@@ -0,0 +1,159 @@
+/**
+ ******************************************************************************
+ * @file    touch_service.c
+ * @brief   中断驱动的触摸采样服务源文件
+ * @details 中断中只发送任务通知；触摸任务被唤醒后调用一次 tp_dev.scan()，
+ *          并跳过驱动内部的空闲节流 (TP_SCAN_NOW)，保证每个 INT 事件都能
+ *          读到坐标。按下期间任务以 TOUCH_SERVICE_TRACK_PERIOD_MS 为超时继续
+ *          跟踪，即使部分控制器在按住不动时不再产生边沿也能检测到松开。
+ *          样本在短临界区内整体拷贝，读取方拿到的坐标与状态总是一致的。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "touch_service.h"
+#include "FreeRTOS.h"
+#include "profiler.h"
+#include "task.h"
+#include "touch.h"
+#include <string.h>
+
+/* --------------------------- 调试配置 --------------------------- */
+#define LOG_MODULE "TOUCH"
+#include "log.h"
+
+/* --------------------------- 私有变量 --------------------------- */
+static TaskHandle_t g_touch_task = NULL;
+static StaticTask_t g_touch_task_tcb;
+// 触摸驱动把栈上的读缓冲区交给 I2C DMA，栈必须留在 SRAM (不能放 CCM)
+static StackType_t g_touch_task_stack[TOUCH_SERVICE_TASK_STACK_SIZE];
+
+static TouchSample_t g_sample;        // 最新样本 (临界区内读写)
+static TouchSampleNotify_t g_notify = NULL;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+/**
+ * @brief 读取一次控制器并更新缓存样本
+ * @return true: 当前有触点按下
+ */
+static bool touch_service_scan(void) {
+  TouchSample_t sample;
+  uint32_t primask;
+  bool changed;
+
+  PROF_BEGIN(PROF_ZONE_TOUCH_READ);
+  tp_dev.scan(TP_SCAN_NOW);
+  PROF_END(PROF_ZONE_TOUCH_READ);
+
+  memset(&sample, 0, sizeof(sample));
+  sample.pressed = (tp_dev.sta & TP_PRES_DOWN) != 0;
+  if (sample.pressed) {
+    for (uint8_t i = 0; i < TOUCH_SERVICE_MAX_POINTS; i++) {
+      if (tp_dev.sta & (1u << i)) {
+        sample.point_mask |= (uint16_t)(1u << i);
+        sample.x[i] = tp_dev.x[i];
+        sample.y[i] = tp_dev.y[i];
+      }
+    }
+    // 电阻屏只置 TP_PRES_DOWN，坐标固定在 x[0]/y[0]
+    if (sample.point_mask == 0) {
+      sample.point_mask = 0x01;
+      sample.x[0] = tp_dev.x[0];
+      sample.y[0] = tp_dev.y[0];
+    }
+  }
+  sample.timestamp = HAL_GetTick();
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  changed = (sample.pressed != g_sample.pressed) ||
+            (sample.point_mask != g_sample.point_mask) ||
+            (memcmp(sample.x, g_sample.x, sizeof(sample.x)) != 0) ||
+            (memcmp(sample.y, g_sample.y, sizeof(sample.y)) != 0);
+  sample.seq = g_sample.seq + (changed ? 1u : 0u);
+  g_sample = sample;
+  __set_PRIMASK(primask);
+
+  if (changed && g_notify != NULL)
+    g_notify();
+
+  return sample.pressed;
+}
+
+/**
+ * @brief 触摸任务主循环：空闲时无限期等待中断，按下期间周期跟踪
+ */
+static void touch_service_task(void *argument) {
+  bool pressed;
+
+  (void)argument;
+  pressed = touch_service_scan(); // 上电时可能已经按下
+
+  for (;;) {
+    ulTaskNotifyTake(pdTRUE, pressed
+                                 ? pdMS_TO_TICKS(TOUCH_SERVICE_TRACK_PERIOD_MS)
+                                 : portMAX_DELAY);
+    pressed = touch_service_scan();
+  }
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 创建触摸任务
+ */
+bool TouchService_Init(void) {
+  if (g_touch_task != NULL)
+    return true;
+
+  memset(&g_sample, 0, sizeof(g_sample));
+  g_touch_task = xTaskCreateStatic(
+      touch_service_task, "touch", TOUCH_SERVICE_TASK_STACK_SIZE, NULL,
+      TOUCH_SERVICE_TASK_PRIORITY, g_touch_task_stack, &g_touch_task_tcb);
+  if (g_touch_task == NULL) {
+    LOG_ERROR("触摸任务创建失败");
+    return false;
+  }
+
+  LOG_INFO("触摸服务已启动 (INT 引脚中断驱动)");
+  return true;
+}
+
+/**
+ * @brief 触摸中断处理 (中断上下文)
+ */
+void TouchService_IrqHandler(void) {
+  BaseType_t woken = pdFALSE;
+
+  if (g_touch_task == NULL)
+    return;
+
+  vTaskNotifyGiveFromISR(g_touch_task, &woken);
+  portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief 获取最新缓存的触摸样本
+ */
+bool TouchService_GetSample(TouchSample_t *out) {
+  uint32_t primask;
+
+  if (out == NULL || g_touch_task == NULL)
+    return false;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  *out = g_sample;
+  __set_PRIMASK(primask);
+  return true;
+}
+
+/**
+ * @brief 注册新样本通知
+ */
+bool TouchService_RegisterNotify(TouchSampleNotify_t notify) {
+  g_notify = notify;
+  return true;
+}
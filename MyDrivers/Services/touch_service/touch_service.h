@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file    touch_service.h
+ * @brief   中断驱动的触摸采样服务头文件
+ * @details 触摸控制器的 INT 引脚 (PB1) 下降/上升沿唤醒触摸任务，任务只在
+ *          有事件时通过 I2C 读取一次坐标并缓存；按下期间按固定周期跟踪，
+ *          松开后无限期阻塞。LVGL 的读取回调只拷贝缓存的样本，不再访问总线。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __TOUCH_SERVICE_H
+#define __TOUCH_SERVICE_H
+
+#include "main.h"
+#include "task_plan.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define TOUCH_SERVICE_MAX_POINTS 5        // 缓存的触点数 (电容屏多点)
+#define TOUCH_SERVICE_TRACK_PERIOD_MS 10  // 按下期间的跟踪周期 (兼顾松开检测)
+#define TOUCH_SERVICE_TASK_STACK_SIZE 192 // 触摸任务栈大小 (单位: 字)
+#define TOUCH_SERVICE_TASK_PRIORITY TASK_PRIO_TOUCH // 触摸任务优先级 (高于界面)
+
+/* --------------------------- 数据结构 --------------------------- */
+/**
+ * @brief 缓存的触摸样本 (屏幕坐标，未做旋转)
+ */
+typedef struct {
+  uint16_t x[TOUCH_SERVICE_MAX_POINTS];
+  uint16_t y[TOUCH_SERVICE_MAX_POINTS];
+  uint16_t point_mask; // b0~b4: 对应触点有效
+  bool pressed;        // 是否有触点按下
+  uint32_t timestamp;  // 采样时刻 (HAL_GetTick)
+  uint32_t seq;        // 样本序号，内容变化时递增
+} TouchSample_t;
+
+/**
+ * @brief 新样本通知 (在触摸任务上下文中调用，不得阻塞)
+ */
+typedef void (*TouchSampleNotify_t)(void);
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 创建触摸任务并读取一次初始状态
+ * @note  须在 tp_dev.init() 与 INT 引脚中断配置完成之后调用
+ * @return true: 成功, false: 任务创建失败
+ */
+bool TouchService_Init(void);
+
+/**
+ * @brief 触摸中断处理 (中断上下文)，在 INT 引脚的 EXTI 回调中调用
+ */
+void TouchService_IrqHandler(void);
+
+/**
+ * @brief 获取最新缓存的触摸样本
+ * @param out 输出样本
+ * @return true: 已有有效样本, false: 服务未启动
+ */
+bool TouchService_GetSample(TouchSample_t *out);
+
+/**
+ * @brief 注册新样本通知，样本内容变化时调用
+ * @param notify 回调函数 (NULL 取消注册)
+ * @return true: 成功
+ */
+bool TouchService_RegisterNotify(TouchSampleNotify_t notify);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TOUCH_SERVICE_H */
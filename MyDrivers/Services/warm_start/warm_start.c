@@ -0,0 +1,124 @@
+/**
+ ******************************************************************************
+ * @file    warm_start.c
+ * @brief   热启动记录实现
+ * @details 记录只有几十字节，每次修改都在关中断状态下整体重算 CRC，任何
+ *          时刻复位都只会留下旧记录或新记录；写到一半时复位则 CRC 不符，
+ *          下次按冷启动处理。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#include "warm_start.h"
+#include "checksum.h"
+#include "main.h"
+#include "mem_section.h"
+#include "sys_monitor.h"
+#include <string.h>
+
+/* --------------------------- 私有宏 --------------------------- */
+#define WARM_START_MAGIC 0x5741524DU // "WARM"
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  uint32_t magic;
+  uint16_t version; // WARM_START_VERSION
+  uint16_t size;    // sizeof(WarmStart_State_t)，固件改变布局时不会误用
+  uint32_t crc;     // state 的 CRC-32
+  WarmStart_State_t state;
+} WarmStart_Record_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static NOINIT_RAM WarmStart_Record_t s_record; // 复位时保持
+static WarmStart_State_t s_boot;               // 启动时校验通过的状态
+static bool s_valid;
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static uint32_t warm_start_crc(const WarmStart_Record_t *record) {
+  return CRC32_Compute((const uint8_t *)&record->state, sizeof(record->state));
+}
+
+/* 在关中断状态下调用 */
+static void warm_start_seal(void) {
+  s_record.magic = WARM_START_MAGIC;
+  s_record.version = WARM_START_VERSION;
+  s_record.size = (uint16_t)sizeof(WarmStart_State_t);
+  s_record.crc = warm_start_crc(&s_record);
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 校验上次运行留下的记录
+ */
+void WarmStart_Init(void) {
+  s_valid = SysMonitor_IsWarmReset() && s_record.magic == WARM_START_MAGIC &&
+            s_record.version == WARM_START_VERSION &&
+            s_record.size == sizeof(WarmStart_State_t) &&
+            s_record.crc == warm_start_crc(&s_record);
+
+  if (s_valid) {
+    // 记录继续沿用：本次运行没有更新的项在下一次热启动时仍然有效
+    s_boot = s_record.state;
+  } else {
+    memset(&s_record, 0, sizeof(s_record));
+    warm_start_seal();
+  }
+}
+
+/**
+ * @brief 本次启动是否为热启动
+ */
+bool WarmStart_IsValid(void) { return s_valid; }
+
+/**
+ * @brief 启动时校验通过的状态
+ */
+const WarmStart_State_t *WarmStart_Get(void) {
+  return s_valid ? &s_boot : NULL;
+}
+
+/**
+ * @brief 记录当前显示的屏幕
+ */
+void WarmStart_SetScreen(uint8_t screen, uint8_t sensor_type,
+                         uint8_t device_type) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  s_record.state.screen = screen;
+  s_record.state.sensor_type = sensor_type;
+  s_record.state.device_type = device_type;
+  warm_start_seal();
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 记录设备状态
+ */
+void WarmStart_SetDevices(const WarmStart_Devices_t *devices) {
+  uint32_t primask = __get_PRIMASK();
+
+  if (devices == NULL) {
+    return;
+  }
+  __disable_irq();
+  s_record.state.devices = *devices;
+  s_record.state.devices_valid = true;
+  warm_start_seal();
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 记录 MQ-2 的 R0
+ */
+void WarmStart_SetMq2R0(float r0) {
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  s_record.state.mq2_r0 = r0;
+  warm_start_seal();
+  __set_PRIMASK(primask);
+}
@@ -0,0 +1,101 @@
+/**
+ ******************************************************************************
+ * @file    warm_start.h
+ * @brief   热启动记录头文件
+ * @details 看门狗复位、软件复位 (含 OTA 后的重启) 之后，系统不必像冷启动
+ *          那样从头开始：运行期间把少量需要恢复的状态写入复位时保持的 RAM
+ *          (NOINIT_RAM，见 mem_section.h)：
+ *            - 最后显示的屏幕及其上下文 (详情页的传感器/设备类型)；
+ *            - 设备状态 (LED 模式/槽位/亮度、电机模式/手动速度)，其中尚未
+ *              到达配置存储写回时间的修改也不会丢失；
+ *            - MQ-2 的 R0，EEPROM 中没有记录时也不必重新预热校准。
+ *          传感器的分钟/小时级汇总与压缩原始历史由传感器任务按实例保存在
+ *          同一区域 (见 sensor_task.c)。
+ *          记录带魔数、版本、长度与 CRC-32；只有复位原因不是上电/欠压
+ *          (SysMonitor_IsWarmReset) 且校验通过时，本次启动才视为热启动，
+ *          各模块才使用其中的内容。备份 SRAM 已被崩溃转储与日志页缓冲占满，
+ *          因此使用 SRAM2 末尾的 RW_NOINIT 执行区，掉电后不保持。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
+
+#ifndef __WARM_START_H
+#define __WARM_START_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define WARM_START_VERSION 1
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 设备状态 (取值与 devices_manager.h 中的枚举相同)
+ */
+typedef struct {
+  uint8_t led_mode;         // led_control_mode_t
+  uint8_t led_manual_state; // led_manual_state_t
+  uint8_t led_brightness;   // 用户设置的亮度
+  uint8_t motor_mode;       // Motor_Control_Mode_t
+  uint16_t motor_speed;     // 手动模式速度
+} WarmStart_Devices_t;
+
+/**
+ * @brief 热启动时恢复的状态
+ */
+typedef struct {
+  uint8_t screen;       // 最后显示的屏幕 (ui_screen_t)，0 表示未记录
+  uint8_t sensor_type;  // 传感器详情页的传感器类型
+  uint8_t device_type;  // 设备详情页的设备类型
+  bool devices_valid;   // devices 已记录
+  WarmStart_Devices_t devices;
+  float mq2_r0;         // MQ-2 的 R0 (kΩ)，0 表示未记录
+} WarmStart_State_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 校验上次运行留下的记录，决定本次是否为热启动
+ * @note  在 main 中 SysMonitor_CaptureResetCause 之后、其他模块初始化之前
+ *        调用一次；冷启动或校验失败时清空记录
+ */
+void WarmStart_Init(void);
+
+/**
+ * @brief 本次启动是否为热启动 (复位原因与记录校验均通过)
+ */
+bool WarmStart_IsValid(void);
+
+/**
+ * @brief 启动时校验通过的状态
+ * @return 冷启动时返回 NULL；返回的内容在本次运行中不再变化
+ */
+const WarmStart_State_t *WarmStart_Get(void);
+
+/**
+ * @brief 记录当前显示的屏幕及其上下文 (LVGL 任务切换屏幕时调用)
+ */
+void WarmStart_SetScreen(uint8_t screen, uint8_t sensor_type,
+                         uint8_t device_type);
+
+/**
+ * @brief 记录设备状态 (设备状态发布时调用)
+ */
+void WarmStart_SetDevices(const WarmStart_Devices_t *devices);
+
+/**
+ * @brief 记录 MQ-2 的 R0 (校准完成或从 EEPROM 恢复时调用)
+ */
+void WarmStart_SetMq2R0(float r0);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __WARM_START_H */
@@ -1 +1,444 @@
+/**
+ ******************************************************************************
+ * @file    test.c
+ * @brief   板上性能基准源文件
+ * @details 每项测量记录 次数/最小/最大/总和 (CPU 周期)，输出时换算为 us。
+ *          测量期间不关中断，结果包含被更高优先级任务与中断打断的时间，
+ *          因此同时给出最小值作为无干扰时的开销。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
 
+#include "test.h"
+#include "24cxx.h"
+#include "boot_graph.h"
+#include "cmsis_os.h"
+#include "i2c_bus_manager.h"
+#include "lcd.h"
+#include "log.h"
+#include "lvgl.h"
+#include "main.h"
+#include "profiler.h"
+#include "sensor_probe.h"
+#include "sensor_stats.h"
+#include "sensor_task.h"
+#include "task_wdt.h"
+#include "ui_manager.h"
+#include <stdio.h>
+#include <string.h>
+
+/* --------------------------- 私有类型 --------------------------- */
+typedef struct {
+  uint32_t n;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+} Bench_Stat_t;
+
+typedef struct {
+  ui_screen_t screen;
+  const char *name;
+} Bench_Screen_t;
+
+/* --------------------------- 私有变量 --------------------------- */
+static const struct {
+  const char *name;
+  uint32_t mask;
+} s_suite_names[] = {
+    {"lcd", BENCH_SUITE_LCD},       {"lvgl", BENCH_SUITE_LVGL},
+    {"i2c", BENCH_SUITE_I2C},       {"log", BENCH_SUITE_LOG},
+    {"sensor", BENCH_SUITE_SENSOR}, {"eeprom", BENCH_SUITE_EEPROM},
+    {"all", BENCH_SUITE_ALL},
+};
+
+// GUI_APP 中已实现的屏幕 (启动页只显示一次，设置页尚未实现)
+static const Bench_Screen_t s_screens[] = {
+    {UI_SCREEN_LOGIN, "login"},
+    {UI_SCREEN_DASHBOARD, "dashboard"},
+    {UI_SCREEN_SENSORS_DETAILS, "sensors_details"},
+    {UI_SCREEN_SENSORS_LISTS, "sensors_lists"},
+    {UI_SCREEN_DEVICE_DETAILS, "device_details"},
+    {UI_SCREEN_DIAGNOSTICS, "diagnostics"},
+};
+
+static volatile uint32_t s_ui_request; // 待 LVGL 任务执行的套件
+static volatile bool s_ui_done;
+
+static SensorStatsEngine_t s_engine; // 统计引擎测试用 (与实例无关)
+static float s_ring[SENSOR_HISTORY_SIZE];
+
+/* --------------------------- 私有函数 --------------------------- */
+
+static void bench_stat_reset(Bench_Stat_t *s) {
+  memset(s, 0, sizeof(*s));
+  s->min = 0xFFFFFFFFU;
+}
+
+static void bench_stat_add(Bench_Stat_t *s, uint32_t cycles) {
+  s->n++;
+  s->sum += cycles;
+  if (cycles < s->min) {
+    s->min = cycles;
+  }
+  if (cycles > s->max) {
+    s->max = cycles;
+  }
+}
+
+static uint32_t bench_mhz(void) { return SystemCoreClock / 1000000U; }
+
+/* 以 us 输出周期数，保留两位小数 */
+static void bench_print_us(const char *key, uint64_t cycles) {
+  uint64_t centi = cycles * 100U / bench_mhz();
+  printf(" %s=%lu.%02lu", key, (unsigned long)(centi / 100U),
+         (unsigned long)(centi % 100U));
+}
+
+static void bench_print_stat(const char *suite, const char *name,
+                             const Bench_Stat_t *s) {
+  printf("BENCH %s %s n=%lu", suite, name, (unsigned long)s->n);
+  if (s->n != 0) {
+    bench_print_us("min_us", s->min);
+    bench_print_us("avg_us", s->sum / s->n);
+    bench_print_us("max_us", s->max);
+  }
+}
+
+/* 输出一次传输的吞吐量 (字节数 / 周期数 -> MB/s) */
+static void bench_print_rate(const char *suite, const char *name,
+                             uint32_t pixels, uint32_t cycles) {
+  uint32_t bytes = pixels * sizeof(lv_color_t);
+  uint64_t centi =
+      cycles != 0 ? (uint64_t)bytes * 100U * bench_mhz() / cycles : 0;
+
+  printf("BENCH %s %s px=%lu", suite, name, (unsigned long)pixels);
+  bench_print_us("us", cycles);
+  printf(" MBps=%lu.%02lu\r\n", (unsigned long)(centi / 100U),
+         (unsigned long)(centi % 100U));
+}
+
+/* 输出剖析区段的现有统计 (自上一个剖析窗口开始) */
+static void bench_print_zone(const char *suite, const char *name,
+                             prof_zone_t zone) {
+  prof_stat_t p;
+  Bench_Stat_t s;
+
+  bench_stat_reset(&s);
+  if (prof_get(zone, &p) && p.count != 0) {
+    s.n = p.count;
+    s.min = p.min;
+    s.max = p.max;
+    s.sum = p.sum;
+  }
+  bench_print_stat(suite, name, &s);
+  printf("\r\n");
+}
+
+/* 等待 disp_flush 启动的 DMA 传输完成 */
+static void bench_wait_flush(lv_disp_t *disp) {
+  while (disp->driver->draw_buf->flushing) {
+  }
+}
+
+/**
+ * @brief LCD 吞吐量：纯色与彩色填充、disp_flush (LVGL 任务中执行)
+ */
+static void bench_lcd(void) {
+  lv_disp_t *disp = lv_disp_get_default();
+  lv_disp_draw_buf_t *draw_buf = disp->driver->draw_buf;
+  uint16_t w = lcddev.width;
+  uint16_t h = lcddev.height;
+  uint16_t rows = (uint16_t)(draw_buf->size / w);
+  lv_area_t area;
+  uint32_t t0;
+
+  if (rows > h) {
+    rows = h;
+  }
+  bench_wait_flush(disp);
+
+  t0 = prof_now();
+  lcd_fill(0, 0, w - 1, h - 1, 0x001F);
+  bench_print_rate("lcd", "lcd_fill", (uint32_t)w * h, prof_now() - t0);
+
+  t0 = prof_now();
+  lcd_fill_window(0, 0, w, h, 0x07E0);
+  bench_print_rate("lcd", "lcd_fill_window", (uint32_t)w * h, prof_now() - t0);
+
+  // 彩色填充与 disp_flush 使用 LVGL 绘制缓冲区 (两次重绘之间空闲)
+  memset(draw_buf->buf1, 0x5A, (size_t)w * rows * sizeof(lv_color_t));
+  t0 = prof_now();
+  lcd_color_fill(0, 0, w - 1, rows - 1, (uint16_t *)draw_buf->buf1);
+  bench_print_rate("lcd", "lcd_color_fill", (uint32_t)w * rows,
+                   prof_now() - t0);
+
+  area.x1 = 0;
+  area.y1 = 0;
+  area.x2 = (lv_coord_t)(w - 1);
+  area.y2 = (lv_coord_t)(rows - 1);
+  t0 = prof_now();
+  draw_buf->flushing = 1;
+  disp->driver->flush_cb(disp->driver, &area, (lv_color_t *)draw_buf->buf1);
+  bench_wait_flush(disp);
+  bench_print_rate("lcd", "disp_flush", (uint32_t)w * rows, prof_now() - t0);
+
+  // 恢复界面
+  lv_obj_invalidate(lv_scr_act());
+}
+
+/**
+ * @brief 各屏幕整屏重绘耗时 (LVGL 任务中执行)
+ */
+static void bench_lvgl(void) {
+  lv_disp_t *disp = lv_disp_get_default();
+  ui_screen_t restore = ui_get_current_screen();
+
+  for (uint32_t i = 0; i < sizeof(s_screens) / sizeof(s_screens[0]); i++) {
+    Bench_Stat_t s;
+    uint32_t t0;
+
+    // 首帧含控件创建与布局，单独输出
+    t0 = prof_now();
+    ui_load_screen(s_screens[i].screen);
+    lv_refr_now(disp);
+    bench_wait_flush(disp);
+    printf("BENCH lvgl %s_first", s_screens[i].name);
+    bench_print_us("us", prof_now() - t0);
+    printf("\r\n");
+
+    bench_stat_reset(&s);
+    for (int f = 0; f < BENCH_LVGL_FRAMES; f++) {
+      lv_obj_invalidate(lv_scr_act());
+      t0 = prof_now();
+      lv_refr_now(disp);
+      bench_wait_flush(disp);
+      bench_stat_add(&s, prof_now() - t0);
+    }
+    bench_print_stat("lvgl", s_screens[i].name, &s);
+    printf("\r\n");
+    TaskWdt_CheckIn();
+  }
+
+  if (restore != UI_SCREEN_NONE) {
+    ui_load_screen(restore);
+  }
+  lv_obj_invalidate(lv_scr_act());
+}
+
+/**
+ * @brief I2C 往返耗时 (每个候选地址) 与各传感器读取耗时
+ */
+static void bench_i2c(void) {
+  SensorProbeStatus_t st;
+  char name[16];
+
+  for (uint8_t i = 0; SensorProbe_GetStatus(i, &st); i++) {
+    Bench_Stat_t s;
+    uint32_t fails = 0;
+
+    bench_stat_reset(&s);
+    for (int r = 0; r < BENCH_I2C_ROUNDS; r++) {
+      I2C_Transaction_t xfer;
+      uint32_t t0;
+
+      I2C_Transaction_Init(&xfer, st.addr);
+      t0 = prof_now();
+      if (I2C_Bus_Execute(&xfer) == HAL_OK) {
+        bench_stat_add(&s, prof_now() - t0);
+      } else {
+        fails++;
+      }
+    }
+    snprintf(name, sizeof(name), "probe_0x%02X", st.addr);
+    bench_print_stat("i2c", name, &s);
+    printf(" sensor=%s fail=%lu\r\n", SensorType_ToString(st.type),
+           (unsigned long)fails);
+  }
+
+  // 驱动读取回调 (含转换等待) 由传感器任务持续计时
+  bench_print_zone("i2c", "read_gy30", PROF_ZONE_READ_GY30);
+  bench_print_zone("i2c", "read_sht30", PROF_ZONE_READ_SHT30);
+  bench_print_zone("i2c", "read_smoke", PROF_ZONE_READ_SMOKE);
+}
+
+/**
+ * @brief log_write 每行耗时 (格式化并入队)
+ */
+static void bench_log(void) {
+  Bench_Stat_t s;
+
+  bench_stat_reset(&s);
+  for (int i = 0; i < BENCH_LOG_LINES; i++) {
+    uint32_t t0 = prof_now();
+    log_write(LOG_LEVEL_INFO, "BENCH", __FILE__, __LINE__,
+              "bench line %d/%d value=%lu", i + 1, BENCH_LOG_LINES,
+              (unsigned long)t0);
+    bench_stat_add(&s, prof_now() - t0);
+  }
+  bench_print_stat("log", "log_write", &s);
+  printf("\r\n");
+}
+
+/**
+ * @brief 每样本统计耗时随历史填充程度的变化
+ * @details SensorTask_UpdateSensor 中与历史长度相关的部分是统计引擎：
+ *          按窗口填充的四分位与填满后的稳态分别输出，修改
+ *          SENSOR_HISTORY_SIZE 后重新运行即可比较不同窗口长度。
+ */
+static void bench_sensor(void) {
+  static const char *const names[] = {"stats_fill_0_25", "stats_fill_25_50",
+                                      "stats_fill_50_75", "stats_fill_75_100",
+                                      "stats_full"};
+  Bench_Stat_t s[5];
+  SensorStats_t stats;
+  uint32_t seed = 12345;
+  uint16_t slot = 0;
+
+  for (int b = 0; b < 5; b++) {
+    bench_stat_reset(&s[b]);
+  }
+  SensorStats_Reset(&s_engine);
+  memset(s_ring, 0, sizeof(s_ring));
+
+  for (uint32_t i = 0; i < 4U * SENSOR_HISTORY_SIZE; i++) {
+    uint32_t bucket = s_engine.count < SENSOR_HISTORY_SIZE
+                          ? (uint32_t)s_engine.count * 4U / SENSOR_HISTORY_SIZE
+                          : 4U;
+    float value;
+    uint32_t t0;
+
+    // 伪随机样本，使单调队列有进有出
+    seed = seed * 1103515245U + 12345U;
+    value = (float)((seed >> 16) & 0x3FF) * 0.1f;
+
+    t0 = prof_now();
+    SensorStats_Push(&s_engine, s_ring, slot, value);
+    s_ring[slot] = value;
+    SensorStats_Export(&s_engine, s_ring, &stats);
+    bench_stat_add(&s[bucket], prof_now() - t0);
+    slot = (uint16_t)((slot + 1U) % SENSOR_HISTORY_SIZE);
+  }
+
+  for (int b = 0; b < 5; b++) {
+    bench_print_stat("sensor", names[b], &s[b]);
+    printf(" history_size=%u\r\n", (unsigned)SENSOR_HISTORY_SIZE);
+  }
+  bench_print_zone("sensor", "update_sensor", PROF_ZONE_SENSOR_UPDATE);
+}
+
+/**
+ * @brief EEPROM 页写入与页读取耗时 (写回原有内容)
+ */
+static void bench_eeprom(void) {
+  uint8_t page[EE_PAGE_SIZE];
+  Bench_Stat_t wr, rd;
+
+  bench_stat_reset(&wr);
+  bench_stat_reset(&rd);
+  for (int r = 0; r < BENCH_EEPROM_ROUNDS; r++) {
+    uint32_t t0 = prof_now();
+    at24cxx_read(BENCH_EEPROM_ADDR, page, EE_PAGE_SIZE);
+    bench_stat_add(&rd, prof_now() - t0);
+
+    t0 = prof_now();
+    at24cxx_write(BENCH_EEPROM_ADDR, page, EE_PAGE_SIZE);
+    bench_stat_add(&wr, prof_now() - t0);
+  }
+  bench_print_stat("eeprom", "page_read", &rd);
+  printf(" bytes=%u\r\n", (unsigned)EE_PAGE_SIZE);
+  bench_print_stat("eeprom", "page_write", &wr);
+  printf(" bytes=%u\r\n", (unsigned)EE_PAGE_SIZE);
+}
+
+/* --------------------------- 公共函数实现 --------------------------- */
+
+/**
+ * @brief 按名称解析套件
+ */
+uint32_t Bench_ParseSuite(const char *name) {
+  for (uint32_t i = 0; i < sizeof(s_suite_names) / sizeof(s_suite_names[0]);
+       i++) {
+    if (strcmp(name, s_suite_names[i].name) == 0) {
+      return s_suite_names[i].mask;
+    }
+  }
+  return 0;
+}
+
+/**
+ * @brief 运行指定套件并输出结果
+ */
+void Bench_Run(uint32_t suites) {
+  uint32_t ui = suites & (BENCH_SUITE_LCD | BENCH_SUITE_LVGL);
+
+  printf("BENCH begin suites=0x%02lX cpu_mhz=%lu\r\n", (unsigned long)suites,
+         (unsigned long)bench_mhz());
+
+  if (ui != 0) {
+    uint32_t start = HAL_GetTick();
+
+    s_ui_done = false;
+    s_ui_request = ui;
+    ui_wake(UI_WAKE_SENSOR);
+    while (!s_ui_done && HAL_GetTick() - start < BENCH_UI_TIMEOUT_MS) {
+      TaskWdt_CheckIn();
+      osDelay(20);
+    }
+    if (!s_ui_done) {
+      printf("BENCH ui error=timeout\r\n");
+    }
+  }
+  if (suites & BENCH_SUITE_I2C) {
+    bench_i2c();
+    TaskWdt_CheckIn();
+  }
+  if (suites & BENCH_SUITE_LOG) {
+    bench_log();
+  }
+  if (suites & BENCH_SUITE_SENSOR) {
+    bench_sensor();
+  }
+  if (suites & BENCH_SUITE_EEPROM) {
+    bench_eeprom();
+    TaskWdt_CheckIn();
+  }
+
+  printf("BENCH end\r\n");
+}
+
+/**
+ * @brief 执行挂起的 lcd/lvgl 套件
+ */
+void Bench_UiPoll(void) {
+  uint32_t request = s_ui_request;
+
+  if (request == 0) {
+    return;
+  }
+  s_ui_request = 0;
+  if (request & BENCH_SUITE_LCD) {
+    bench_lcd();
+    TaskWdt_CheckIn();
+  }
+  if (request & BENCH_SUITE_LVGL) {
+    bench_lvgl();
+  }
+  s_ui_done = true;
+}
+
+/**
+ * @brief 等待启动完成后运行全部套件
+ */
+void Bench_RunAtBoot(void) {
+  uint8_t done, total;
+
+  do {
+    TaskWdt_CheckIn();
+    osDelay(100);
+    BootGraph_GetProgress(&done, &total);
+  } while (done != total);
+
+  osDelay(1000); // 等待首轮采样与界面稳定
+  Bench_Run(BENCH_SUITE_ALL);
+}
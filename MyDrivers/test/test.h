@@ -1 +1,87 @@
+/**
+ ******************************************************************************
+ * @file    test.h
+ * @brief   板上性能基准头文件
+ * @details 以 DWT 周期计数器测量各热点路径，结果按固定格式逐行输出，
+ *          便于主机端脚本解析与前后对比：
+ *            BENCH <套件> <项目> key=value ...
+ *          时间单位为 us (保留两位小数)，吞吐量为 MB/s。套件：
+ *            - lcd:    lcd_fill / lcd_fill_window / lcd_color_fill / disp_flush 吞吐量
+ *            - lvgl:   各屏幕整屏重绘 (含刷新到 LCD) 的耗时
+ *            - i2c:    各候选地址的空事务往返耗时，以及各传感器读取耗时
+ *            - log:    log_write 每行耗时
+ *            - sensor: 统计引擎每样本耗时随历史填充程度的变化
+ *            - eeprom: 24Cxx 页写入与页读取耗时
+ *          lcd/lvgl 与界面共用 LCD 和 LVGL 对象，由 LVGL 任务在两次
+ *          lv_task_handler 之间执行；其余套件在调用者任务中执行。
+ *          从命令行 bench 命令调用，或置 BENCH_RUN_AT_BOOT 在启动完成后运行一次。
+ * @author  MmsY
+ * @time    2025/11/23
+ ******************************************************************************
+ */
 
+#ifndef __TEST_H
+#define __TEST_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* --------------------------- 系统配置 --------------------------- */
+#define BENCH_RUN_AT_BOOT 0           // 1: 启动完成后由命令行任务运行全部套件
+#define BENCH_LVGL_FRAMES 5           // 每个屏幕的重绘次数
+#define BENCH_I2C_ROUNDS 16           // 每个地址的探测次数
+#define BENCH_LOG_LINES 16            // log_write 调用次数
+#define BENCH_EEPROM_ADDR 248         // 页写入测试地址 (配置存储区之后的空闲页，原样写回)
+#define BENCH_EEPROM_ROUNDS 4         // 页写入次数
+#define BENCH_UI_TIMEOUT_MS 30000     // 等待 LVGL 任务完成的最长时间
+
+/* --------------------------- 数据结构 --------------------------- */
+
+/**
+ * @brief 套件位掩码
+ */
+typedef enum {
+  BENCH_SUITE_LCD = 1U << 0,
+  BENCH_SUITE_LVGL = 1U << 1,
+  BENCH_SUITE_I2C = 1U << 2,
+  BENCH_SUITE_LOG = 1U << 3,
+  BENCH_SUITE_SENSOR = 1U << 4,
+  BENCH_SUITE_EEPROM = 1U << 5,
+  BENCH_SUITE_ALL = 0x3FU
+} Bench_Suite_t;
+
+/* --------------------------- 公共函数声明 --------------------------- */
+
+/**
+ * @brief 按名称解析套件
+ * @param name 套件名 (lcd/lvgl/i2c/log/sensor/eeprom/all)
+ * @return 套件掩码，未知名称返回 0
+ */
+uint32_t Bench_ParseSuite(const char *name);
+
+/**
+ * @brief 运行指定套件并输出结果 (阻塞到全部完成)
+ * @param suites 套件掩码
+ * @note  不能在 LVGL 任务中调用；lcd/lvgl 套件交给 LVGL 任务执行并等待
+ */
+void Bench_Run(uint32_t suites);
+
+/**
+ * @brief 执行挂起的 lcd/lvgl 套件 (在 LVGL 任务主循环中调用)
+ */
+void Bench_UiPoll(void);
+
+/**
+ * @brief 等待启动完成后运行全部套件 (BENCH_RUN_AT_BOOT 为 1 时由命令行任务调用)
+ */
+void Bench_RunAtBoot(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TEST_H */